@@ -1,8 +1,8 @@
 #include "core/adc_camera_description.h"
+#include "imaging/api/strict_json.h"
 
 #include <algorithm>
 #include <charconv>
-#include <cctype>
 #include <cmath>
 #include <cstdint>
 #include <locale>
@@ -33,314 +33,10 @@ void set_error(LoadResult& out, LoadErrorKind kind, std::string message) {
   out.state = {};
 }
 
-struct JsonValue {
-  enum class Type : std::uint8_t { Null, Bool, Number, String, Array, Object };
-  Type type = Type::Null;
-  bool bool_value = false;
-  std::string number_lexeme;
-  std::string string_value;
-  std::vector<JsonValue> array_value;
-  std::vector<std::pair<std::string, JsonValue>> object_value;
-};
-
-class JsonParser final {
- public:
-  explicit JsonParser(const std::string& text) : text_(text) {}
-
-  bool parse(JsonValue& out, std::string* error) {
-    if (text_.size() > kMaxInputBytes) {
-      *error = "input exceeds byte limit";
-      return false;
-    }
-    pos_ = 0;
-    if (!parse_value(out, error, 0)) return false;
-    skip_ws();
-    if (pos_ != text_.size()) {
-      *error = "unexpected trailing input at byte " + std::to_string(pos_);
-      return false;
-    }
-    return true;
-  }
-
- private:
-  void skip_ws() {
-    while (pos_ < text_.size() && std::isspace(static_cast<unsigned char>(text_[pos_]))) ++pos_;
-  }
-
-  bool consume(char expected) {
-    if (pos_ < text_.size() && text_[pos_] == expected) {
-      ++pos_;
-      return true;
-    }
-    return false;
-  }
-
-  bool match_literal(const char* text) {
-    std::size_t length = 0;
-    while (text[length] != '\0') ++length;
-    if (pos_ + length > text_.size() || text_.compare(pos_, length, text) != 0) return false;
-    pos_ += length;
-    return true;
-  }
-
-  bool parse_value(JsonValue& out, std::string* error, std::size_t depth) {
-    skip_ws();
-    if (pos_ >= text_.size()) {
-      *error = "unexpected end of json";
-      return false;
-    }
-    const char c = text_[pos_];
-    if (c == '{') return parse_object(out, error, depth + 1);
-    if (c == '[') return parse_array(out, error, depth + 1);
-    if (c == '"') {
-      out.type = JsonValue::Type::String;
-      return parse_string(out.string_value, error);
-    }
-    if (c == '-' || std::isdigit(static_cast<unsigned char>(c))) {
-      out.type = JsonValue::Type::Number;
-      return parse_number(out.number_lexeme, error);
-    }
-    if (match_literal("true")) {
-      out.type = JsonValue::Type::Bool;
-      out.bool_value = true;
-      return true;
-    }
-    if (match_literal("false")) {
-      out.type = JsonValue::Type::Bool;
-      out.bool_value = false;
-      return true;
-    }
-    if (match_literal("null")) return true;
-    *error = "unexpected token at byte " + std::to_string(pos_);
-    return false;
-  }
-
-  bool parse_string(std::string& out, std::string* error) {
-    if (!consume('"')) {
-      *error = "expected string at byte " + std::to_string(pos_);
-      return false;
-    }
-    std::string value;
-    while (pos_ < text_.size()) {
-      const char c = text_[pos_++];
-      if (c == '"') {
-        out = std::move(value);
-        return true;
-      }
-      if (c == '\\') {
-        if (pos_ >= text_.size()) {
-          *error = "unterminated escape in string";
-          return false;
-        }
-        const char escape = text_[pos_++];
-        switch (escape) {
-          case '"': value.push_back('"'); break;
-          case '\\': value.push_back('\\'); break;
-          case '/': value.push_back('/'); break;
-          case 'b': value.push_back('\b'); break;
-          case 'f': value.push_back('\f'); break;
-          case 'n': value.push_back('\n'); break;
-          case 'r': value.push_back('\r'); break;
-          case 't': value.push_back('\t'); break;
-          case 'u': {
-            const auto codepoint = decode_unicode_escape(error);
-            if (!codepoint) return false;
-            append_utf8(*codepoint, value);
-            break;
-          }
-          default:
-            *error = "invalid escape sequence in string";
-            return false;
-        }
-      } else {
-        if (static_cast<unsigned char>(c) < 0x20) {
-          *error = "control character in string";
-          return false;
-        }
-        value.push_back(c);
-      }
-      if (value.size() > kMaxStringBytes) {
-        *error = "string exceeds byte limit";
-        return false;
-      }
-    }
-    *error = "unterminated string";
-    return false;
-  }
-
-  std::optional<std::uint32_t> decode_unicode_escape(std::string* error) {
-    const auto first = parse_hex_escape(error);
-    if (!first) return std::nullopt;
-    std::uint32_t codepoint = *first;
-    if (codepoint >= 0xD800u && codepoint <= 0xDBFFu) {
-      if (pos_ + 6 > text_.size() || text_[pos_] != '\\' || text_[pos_ + 1] != 'u') {
-        *error = "missing low surrogate after high surrogate escape";
-        return std::nullopt;
-      }
-      pos_ += 2;
-      const auto low = parse_hex_escape(error);
-      if (!low || *low < 0xDC00u || *low > 0xDFFFu) {
-        *error = "invalid low surrogate escape in string";
-        return std::nullopt;
-      }
-      codepoint = 0x10000u + ((codepoint - 0xD800u) << 10) + (*low - 0xDC00u);
-    } else if (codepoint >= 0xDC00u && codepoint <= 0xDFFFu) {
-      *error = "unexpected low surrogate escape in string";
-      return std::nullopt;
-    }
-    return codepoint;
-  }
-
-  std::optional<std::uint32_t> parse_hex_escape(std::string* error) {
-    if (pos_ + 4 > text_.size()) {
-      *error = "incomplete unicode escape in string";
-      return std::nullopt;
-    }
-    std::uint32_t value = 0;
-    for (int i = 0; i < 4; ++i) {
-      const char c = text_[pos_++];
-      value <<= 4;
-      if (c >= '0' && c <= '9') value |= static_cast<std::uint32_t>(c - '0');
-      else if (c >= 'a' && c <= 'f') value |= static_cast<std::uint32_t>(c - 'a' + 10);
-      else if (c >= 'A' && c <= 'F') value |= static_cast<std::uint32_t>(c - 'A' + 10);
-      else {
-        *error = "invalid unicode escape in string";
-        return std::nullopt;
-      }
-    }
-    return value;
-  }
-
-  static void append_utf8(std::uint32_t codepoint, std::string& out) {
-    if (codepoint <= 0x7Fu) out.push_back(static_cast<char>(codepoint));
-    else if (codepoint <= 0x7FFu) {
-      out.push_back(static_cast<char>(0xC0u | (codepoint >> 6)));
-      out.push_back(static_cast<char>(0x80u | (codepoint & 0x3Fu)));
-    } else if (codepoint <= 0xFFFFu) {
-      out.push_back(static_cast<char>(0xE0u | (codepoint >> 12)));
-      out.push_back(static_cast<char>(0x80u | ((codepoint >> 6) & 0x3Fu)));
-      out.push_back(static_cast<char>(0x80u | (codepoint & 0x3Fu)));
-    } else {
-      out.push_back(static_cast<char>(0xF0u | (codepoint >> 18)));
-      out.push_back(static_cast<char>(0x80u | ((codepoint >> 12) & 0x3Fu)));
-      out.push_back(static_cast<char>(0x80u | ((codepoint >> 6) & 0x3Fu)));
-      out.push_back(static_cast<char>(0x80u | (codepoint & 0x3Fu)));
-    }
-  }
-
-  bool parse_number(std::string& out, std::string* error) {
-    const std::size_t start = pos_;
-    if (consume('-') && pos_ >= text_.size()) return invalid_number(start, error);
-    if (pos_ >= text_.size() || !std::isdigit(static_cast<unsigned char>(text_[pos_]))) {
-      return invalid_number(start, error);
-    }
-    if (text_[pos_] == '0') {
-      ++pos_;
-      if (pos_ < text_.size() && std::isdigit(static_cast<unsigned char>(text_[pos_]))) {
-        *error = "leading zero is not allowed for numbers";
-        return false;
-      }
-    } else {
-      while (pos_ < text_.size() && std::isdigit(static_cast<unsigned char>(text_[pos_]))) ++pos_;
-    }
-    if (pos_ < text_.size() && text_[pos_] == '.') {
-      ++pos_;
-      if (pos_ >= text_.size() || !std::isdigit(static_cast<unsigned char>(text_[pos_]))) {
-        return invalid_number(start, error);
-      }
-      while (pos_ < text_.size() && std::isdigit(static_cast<unsigned char>(text_[pos_]))) ++pos_;
-    }
-    if (pos_ < text_.size() && (text_[pos_] == 'e' || text_[pos_] == 'E')) {
-      ++pos_;
-      if (pos_ < text_.size() && (text_[pos_] == '+' || text_[pos_] == '-')) ++pos_;
-      if (pos_ >= text_.size() || !std::isdigit(static_cast<unsigned char>(text_[pos_]))) {
-        return invalid_number(start, error);
-      }
-      while (pos_ < text_.size() && std::isdigit(static_cast<unsigned char>(text_[pos_]))) ++pos_;
-    }
-    out.assign(text_.data() + start, pos_ - start);
-    return true;
-  }
-
-  bool invalid_number(std::size_t start, std::string* error) {
-    *error = "invalid number at byte " + std::to_string(start);
-    return false;
-  }
-
-  bool parse_array(JsonValue& out, std::string* error, std::size_t depth) {
-    if (depth > kMaxNestingDepth) {
-      *error = "json nesting exceeds depth limit";
-      return false;
-    }
-    if (!consume('[')) {
-      *error = "expected '[' at byte " + std::to_string(pos_);
-      return false;
-    }
-    out = {};
-    out.type = JsonValue::Type::Array;
-    skip_ws();
-    if (consume(']')) return true;
-    for (;;) {
-      JsonValue value;
-      if (!parse_value(value, error, depth)) return false;
-      out.array_value.push_back(std::move(value));
-      skip_ws();
-      if (consume(']')) return true;
-      if (!consume(',')) {
-        *error = "expected ',' or ']' in array at byte " + std::to_string(pos_);
-        return false;
-      }
-    }
-  }
-
-  bool parse_object(JsonValue& out, std::string* error, std::size_t depth) {
-    if (depth > kMaxNestingDepth) {
-      *error = "json nesting exceeds depth limit";
-      return false;
-    }
-    if (!consume('{')) {
-      *error = "expected '{' at byte " + std::to_string(pos_);
-      return false;
-    }
-    out = {};
-    out.type = JsonValue::Type::Object;
-    skip_ws();
-    if (consume('}')) return true;
-    std::unordered_set<std::string> seen_keys;
-    for (;;) {
-      std::string key;
-      skip_ws();
-      if (!parse_string(key, error)) return false;
-      if (!seen_keys.emplace(key).second) {
-        *error = "duplicate object key: " + key;
-        return false;
-      }
-      skip_ws();
-      if (!consume(':')) {
-        *error = "expected ':' after key '" + key + "'";
-        return false;
-      }
-      JsonValue value;
-      if (!parse_value(value, error, depth)) return false;
-      out.object_value.emplace_back(std::move(key), std::move(value));
-      skip_ws();
-      if (consume('}')) return true;
-      if (!consume(',')) {
-        *error = "expected ',' or '}' in object at byte " + std::to_string(pos_);
-        return false;
-      }
-    }
-  }
-
-  const std::string& text_;
-  std::size_t pos_ = 0;
-};
+using JsonValue = strict_json::Value;
 
 const JsonValue* field(const JsonValue& object, std::string_view name) {
-  for (const auto& [key, value] : object.object_value) {
-    if (key == name) return &value;
-  }
-  return nullptr;
+  return object.find(name);
 }
 
 bool require_type(const JsonValue* value, JsonValue::Type type, std::string_view name, LoadResult& out) {
@@ -356,21 +52,21 @@ bool require_type(const JsonValue* value, JsonValue::Type type, std::string_view
 }
 
 bool parse_non_empty_string(const JsonValue& value, std::string_view name, std::string& parsed, LoadResult& out) {
-  if (value.type != JsonValue::Type::String || value.string_value.empty()) {
+  if (value.type != JsonValue::Type::String || value.text.empty()) {
     set_error(out, LoadErrorKind::Validation, "field '" + std::string(name) + "' must be non-empty string");
     return false;
   }
-  parsed = value.string_value;
+  parsed.assign(value.text);
   return true;
 }
 
 bool parse_uint32(const JsonValue& value, std::string_view name, std::uint32_t& parsed, LoadResult& out) {
-  if (value.type != JsonValue::Type::Number || value.number_lexeme.find_first_of(".eE-") != std::string::npos) {
+  if (value.type != JsonValue::Type::Number || value.text.find_first_of(".eE-") != std::string::npos) {
     set_error(out, LoadErrorKind::Validation, "field '" + std::string(name) + "' must be uint32 integer");
     return false;
   }
-  const char* begin = value.number_lexeme.data();
-  const char* end = begin + value.number_lexeme.size();
+  const char* begin = value.text.data();
+  const char* end = begin + value.text.size();
   const auto result = std::from_chars(begin, end, parsed);
   if (result.ec != std::errc{} || result.ptr != end) {
     set_error(out, LoadErrorKind::Validation, "field '" + std::string(name) + "' must be uint32 integer");
@@ -384,11 +80,11 @@ bool parse_finite_number(const JsonValue& value, std::string_view name, double&
     set_error(out, LoadErrorKind::Validation, "field '" + std::string(name) + "' must be number");
     return false;
   }
-  std::istringstream input(value.number_lexeme);
+  std::istringstream input{std::string(value.text)};
   input.imbue(std::locale::classic());
   input >> std::noskipws >> parsed;
   const bool lexeme_has_non_zero_digit =
-      value.number_lexeme.find_first_of("123456789") != std::string::npos;
+      value.text.find_first_of("123456789") != std::string::npos;
   if (input.fail() || input.peek() != std::char_traits<char>::eof() ||
       !std::isfinite(parsed) || (parsed == 0.0 && lexeme_has_non_zero_digit)) {
     set_error(out, LoadErrorKind::Validation, "field '" + std::string(name) + "' must be finite number");
@@ -416,27 +112,27 @@ bool parse_coordinate_domain(const JsonValue& object, CoordinateDomain& domain,
   const JsonValue* value = field(object, "coordinate_domain");
   if (!require_type(value, JsonValue::Type::String, "coordinate_domain", out)) return false;
   const JsonValue* platform_token = field(object, "platform_defined_domain");
-  if (value->string_value == "android_sensor_pre_correction_active_array") {
+  if (value->text == "android_sensor_pre_correction_active_array") {
     if (platform_token) {
       set_error(out, LoadErrorKind::Validation, "platform_defined_domain is forbidden for known coordinate domain");
       return false;
     }
     domain = CoordinateDomainAndroidSensorPreCorrectionActiveArray{};
-  } else if (value->string_value == "android_sensor_active_array") {
+  } else if (value->text == "android_sensor_active_array") {
     if (platform_token) {
       set_error(out, LoadErrorKind::Validation, "platform_defined_domain is forbidden for known coordinate domain");
       return false;
     }
     domain = CoordinateDomainAndroidSensorActiveArray{};
-  } else if (value->string_value == "delivered_image") {
+  } else if (value->text == "delivered_image") {
     if (platform_token) {
       set_error(out, LoadErrorKind::Validation, "platform_defined_domain is forbidden for known coordinate domain");
       return false;
     }
     domain = CoordinateDomainDeliveredImage{};
-  } else if (value->string_value == "platform_defined") {
+  } else if (value->text == "platform_defined") {
     if (!require_type(platform_token, JsonValue::Type::String, "platform_defined_domain", out)) return false;
-    const auto checked = CoordinateDomainPlatformDefined::create(platform_token->string_value);
+    const auto checked = CoordinateDomainPlatformDefined::create(std::string(platform_token->text));
     if (!checked) {
       set_error(out, LoadErrorKind::Validation, "platform_defined_domain must not be empty");
       return false;
@@ -454,9 +150,9 @@ bool parse_image_state(const JsonValue& value, DistortionImageState& state, Load
     set_error(out, LoadErrorKind::Validation, "image_state has wrong type");
     return false;
   }
-  if (value.string_value == "distorted") state = DistortionImageState::DISTORTED;
-  else if (value.string_value == "rectified") state = DistortionImageState::RECTIFIED;
-  else if (value.string_value == "unknown") state = DistortionImageState::UNKNOWN;
+  if (value.text == "distorted") state = DistortionImageState::DISTORTED;
+  else if (value.text == "rectified") state = DistortionImageState::RECTIFIED;
+  else if (value.text == "unknown") state = DistortionImageState::UNKNOWN;
   else {
     set_error(out, LoadErrorKind::Validation, "image_state has unknown token");
     return false;
@@ -472,10 +168,10 @@ bool parse_facing(const JsonValue& object, std::optional<SourcedFact<CameraFacin
   FactOrigin origin;
   if (!parse_origin(*source, "facing.source", origin, out)) return false;
   CameraFacing facing;
-  if (value->string_value == "front") facing = CameraFacing::FRONT;
-  else if (value->string_value == "back") facing = CameraFacing::BACK;
-  else if (value->string_value == "external") facing = CameraFacing::EXTERNAL;
-  else if (value->string_value == "unknown") facing = CameraFacing::UNKNOWN;
+  if (value->text == "front") facing = CameraFacing::FRONT;
+  else if (value->text == "back") facing = CameraFacing::BACK;
+  else if (value->text == "external") facing = CameraFacing::EXTERNAL;
+  else if (value->text == "unknown") facing = CameraFacing::UNKNOWN;
   else {
     set_error(out, LoadErrorKind::Validation, "facing.value has unknown token");
     return false;
@@ -492,10 +188,10 @@ bool parse_nature(const JsonValue& object, std::optional<SourcedFact<CameraNatur
   FactOrigin origin;
   if (!parse_origin(*source, "camera_nature.source", origin, out)) return false;
   CameraNature nature;
-  if (value->string_value == "physical") nature = CameraNature::PHYSICAL;
-  else if (value->string_value == "virtual") nature = CameraNature::VIRTUAL;
-  else if (value->string_value == "hybrid") nature = CameraNature::HYBRID;
-  else if (value->string_value == "unknown") nature = CameraNature::UNKNOWN;
+  if (value->text == "physical") nature = CameraNature::PHYSICAL;
+  else if (value->text == "virtual") nature = CameraNature::VIRTUAL;
+  else if (value->text == "hybrid") nature = CameraNature::HYBRID;
+  else if (value->text == "unknown") nature = CameraNature::UNKNOWN;
   else {
     set_error(out, LoadErrorKind::Validation, "camera_nature.value has unknown token");
     return false;
@@ -583,7 +279,7 @@ bool parse_distortion(const JsonValue& object, std::optional<SourcedFact<Distort
   FactOrigin origin;
   DistortionImageState state;
   if (!parse_origin(*source, "distortion.source", origin, out) || !parse_image_state(*image_state, state, out)) return false;
-  if (model->string_value == "none") {
+  if (model->text == "none") {
     for (const char* forbidden : {"radial_k1", "radial_k2", "radial_k3", "tangential_p1", "tangential_p2", "reference_width_px", "reference_height_px", "coordinate_domain", "platform_defined_domain"}) {
       if (has_field(object, forbidden)) {
         set_error(out, LoadErrorKind::Validation, "distortion.none contains model-specific field");
@@ -593,7 +289,7 @@ bool parse_distortion(const JsonValue& object, std::optional<SourcedFact<Distort
     result = SourcedFact<Distortion>{NoDistortion{state}, origin};
     return true;
   }
-  if (model->string_value != "brown_conrady_5") {
+  if (model->text != "brown_conrady_5") {
     set_error(out, LoadErrorKind::Validation, "distortion.model has unknown token");
     return false;
   }
@@ -632,24 +328,24 @@ bool parse_distortion(const JsonValue& object, std::optional<SourcedFact<Distort
 }
 
 bool parse_vec3(const JsonValue& value, std::string_view name, Vec3Meters& parsed, LoadResult& out) {
-  if (value.type != JsonValue::Type::Array || value.array_value.size() != 3) {
+  if (value.type != JsonValue::Type::Array || value.items().size() != 3) {
     set_error(out, LoadErrorKind::Validation, "field '" + std::string(name) + "' must be three finite numbers");
     return false;
   }
-  return parse_finite_number(value.array_value[0], std::string(name) + "[0]", parsed.x, out) &&
-         parse_finite_number(value.array_value[1], std::string(name) + "[1]", parsed.y, out) &&
-         parse_finite_number(value.array_value[2], std::string(name) + "[2]", parsed.z, out);
+  return parse_finite_number(value.items()[0], std::string(name) + "[0]", parsed.x, out) &&
+         parse_finite_number(value.items()[1], std::string(name) + "[1]", parsed.y, out) &&
+         parse_finite_number(value.items()[2], std::string(name) + "[2]", parsed.z, out);
 }
 
 bool parse_quaternion(const JsonValue& value, QuaternionXyzw& parsed, LoadResult& out) {
-  if (value.type != JsonValue::Type::Array || value.array_value.size() != 4) {
+  if (value.type != JsonValue::Type::Array || value.items().size() != 4) {
     set_error(out, LoadErrorKind::Validation, "rotation_xyzw must be four finite numbers");
     return false;
   }
-  return parse_finite_number(value.array_value[0], "rotation_xyzw[0]", parsed.x, out) &&
-         parse_finite_number(value.array_value[1], "rotation_xyzw[1]", parsed.y, out) &&
-         parse_finite_number(value.array_value[2], "rotation_xyzw[2]", parsed.z, out) &&
-         parse_finite_number(value.array_value[3], "rotation_xyzw[3]", parsed.w, out);
+  return parse_finite_number(value.items()[0], "rotation_xyzw[0]", parsed.x, out) &&
+         parse_finite_number(value.items()[1], "rotation_xyzw[1]", parsed.y, out) &&
+         parse_finite_number(value.items()[2], "rotation_xyzw[2]", parsed.z, out) &&
+         parse_finite_number(value.items()[3], "rotation_xyzw[3]", parsed.w, out);
 }
 
 bool require_absent(const JsonValue& object, std::string_view name, LoadResult& out) {
@@ -677,28 +373,28 @@ bool parse_pose(const JsonValue& object, const std::string& camera_id, std::opti
   const JsonValue* camera_reference = field(object, "reference_camera_id");
   const JsonValue* custom_reference = field(object, "reference_id");
   const JsonValue* platform_reference = field(object, "platform_defined_reference");
-  if (reference_kind->string_value == "camera") {
+  if (reference_kind->text == "camera") {
     if (!require_type(camera_reference, JsonValue::Type::String, "pose.reference_camera_id", out) ||
         !require_absent(object, "reference_id", out) || !require_absent(object, "platform_defined_reference", out)) return false;
-    const auto checked = PoseReferenceCamera::create(camera_reference->string_value);
+    const auto checked = PoseReferenceCamera::create(std::string(camera_reference->text));
     if (!checked || checked->camera_id() == camera_id) {
       set_error(out, LoadErrorKind::Validation, "pose camera reference must be non-empty and not self");
       return false;
     }
     reference = *checked;
-  } else if (reference_kind->string_value == "custom_reference") {
+  } else if (reference_kind->text == "custom_reference") {
     if (!require_type(custom_reference, JsonValue::Type::String, "pose.reference_id", out) ||
         !require_absent(object, "reference_camera_id", out) || !require_absent(object, "platform_defined_reference", out)) return false;
-    const auto checked = PoseReferenceCustom::create(custom_reference->string_value);
+    const auto checked = PoseReferenceCustom::create(std::string(custom_reference->text));
     if (!checked) {
       set_error(out, LoadErrorKind::Validation, "pose reference_id must not be empty");
       return false;
     }
     reference = *checked;
-  } else if (reference_kind->string_value == "platform_defined") {
+  } else if (reference_kind->text == "platform_defined") {
     if (!require_type(platform_reference, JsonValue::Type::String, "pose.platform_defined_reference", out) ||
         !require_absent(object, "reference_camera_id", out) || !require_absent(object, "reference_id", out)) return false;
-    const auto checked = PoseReferencePlatformDefined::create(platform_reference->string_value);
+    const auto checked = PoseReferencePlatformDefined::create(std::string(platform_reference->text));
     if (!checked) {
       set_error(out, LoadErrorKind::Validation, "pose platform_defined_reference must not be empty");
       return false;
@@ -707,10 +403,10 @@ bool parse_pose(const JsonValue& object, const std::string& camera_id, std::opti
   } else {
     if (!require_absent(object, "reference_camera_id", out) ||
         !require_absent(object, "reference_id", out) || !require_absent(object, "platform_defined_reference", out)) return false;
-    if (reference_kind->string_value == "primary_camera") reference = PoseReferencePrimaryCamera{};
-    else if (reference_kind->string_value == "device_motion_sensor") reference = PoseReferenceDeviceMotionSensor{};
-    else if (reference_kind->string_value == "automotive_reference") reference = PoseReferenceAutomotive{};
-    else if (reference_kind->string_value == "unknown") reference = PoseReferenceUnknown{};
+    if (reference_kind->text == "primary_camera") reference = PoseReferencePrimaryCamera{};
+    else if (reference_kind->text == "device_motion_sensor") reference = PoseReferenceDeviceMotionSensor{};
+    else if (reference_kind->text == "automotive_reference") reference = PoseReferenceAutomotive{};
+    else if (reference_kind->text == "unknown") reference = PoseReferenceUnknown{};
     else {
       set_error(out, LoadErrorKind::Validation, "pose.reference_kind has unknown token");
       return false;
@@ -718,21 +414,21 @@ bool parse_pose(const JsonValue& object, const std::string& camera_id, std::opti
   }
   PoseConvention parsed_convention;
   const JsonValue* platform_convention = field(object, "platform_defined_convention");
-  if (convention->string_value == "android_camera2") {
+  if (convention->text == "android_camera2") {
     if (platform_convention) {
       set_error(out, LoadErrorKind::Validation, "platform_defined_convention is forbidden for known convention");
       return false;
     }
     parsed_convention = PoseConventionAndroidCamera2{};
-  } else if (convention->string_value == "camera_optical_frame") {
+  } else if (convention->text == "camera_optical_frame") {
     if (platform_convention) {
       set_error(out, LoadErrorKind::Validation, "platform_defined_convention is forbidden for known convention");
       return false;
     }
     parsed_convention = PoseConventionCameraOpticalFrame{};
-  } else if (convention->string_value == "platform_defined") {
+  } else if (convention->text == "platform_defined") {
     if (!require_type(platform_convention, JsonValue::Type::String, "pose.platform_defined_convention", out)) return false;
-    const auto checked = PoseConventionPlatformDefined::create(platform_convention->string_value);
+    const auto checked = PoseConventionPlatformDefined::create(std::string(platform_convention->text));
     if (!checked) {
       set_error(out, LoadErrorKind::Validation, "pose platform_defined_convention must not be empty");
       return false;
@@ -793,7 +489,7 @@ bool parse_focus_state(const JsonValue& object,
   FactOrigin origin;
   if (!parse_origin(*source, "focus_state.source", origin, out)) return false;
   const JsonValue* distance = field(object, "distance_m");
-  if (state->string_value == "at_distance") {
+  if (state->text == "at_distance") {
     if (!require_type(distance, JsonValue::Type::Number, "focus_state.distance_m", out)) return false;
     double distance_value = 0.0;
     if (!parse_finite_number(*distance, "focus_state.distance_m", distance_value, out)) return false;
@@ -810,11 +506,11 @@ bool parse_focus_state(const JsonValue& object,
               "focus_state.distance_m is only valid when state is at_distance");
     return false;
   }
-  if (state->string_value == "infinity") {
+  if (state->text == "infinity") {
     result = SourcedFact<FocusState>{FocusState{FocusAtInfinity{}}, origin};
     return true;
   }
-  if (state->string_value == "unknown") {
+  if (state->text == "unknown") {
     result = SourcedFact<FocusState>{FocusState{FocusStateUnknown{}}, origin};
     return true;
   }
@@ -828,11 +524,11 @@ bool parse_camera(const JsonValue& value, ExternalCameraDescriptionEntry& entry,
     return false;
   }
   const JsonValue* id = field(value, "camera_id");
-  if (!require_type(id, JsonValue::Type::String, "camera_id", out) || id->string_value.empty()) {
+  if (!require_type(id, JsonValue::Type::String, "camera_id", out) || id->text.empty()) {
     if (out.error_message.empty()) set_error(out, LoadErrorKind::Validation, "camera_id must not be empty");
     return false;
   }
-  entry.camera_id = id->string_value;
+  entry.camera_id = id->text;
   if (const JsonValue* facing = field(value, "facing")) {
     if (facing->type != JsonValue::Type::Object || !parse_facing(*facing, entry.facts.facing, out)) return false;
   }
@@ -894,29 +590,29 @@ bool parse_concurrency(const JsonValue& value,
   if (!require_type(supported, JsonValue::Type::Bool, "concurrent_camera_support.supported", out)) return false;
   const JsonValue* combinations = field(value, "camera_id_combinations");
   if (!supported->bool_value) {
-    if (combinations && (combinations->type != JsonValue::Type::Array || !combinations->array_value.empty())) {
+    if (combinations && (combinations->type != JsonValue::Type::Array || !combinations->items().empty())) {
       set_error(out, LoadErrorKind::Validation, "supported=false contradicts camera_id_combinations");
       return false;
     }
-    result = camera_concurrency::Truth{camera_concurrency::TruthKind::Unsupported, {}};
+    result = camera_concurrency::Truth{camera_concurrency::TruthKind::Unsupported, {}, {}};
     return true;
   }
   if (!require_type(combinations, JsonValue::Type::Array, "concurrent_camera_support.camera_id_combinations", out) ||
-      combinations->array_value.empty() || combinations->array_value.size() > kMaxCombinationCount) {
+      combinations->items().empty() || combinations->items().size() > kMaxCombinationCount) {
     if (out.error_message.empty()) set_error(out, LoadErrorKind::Validation, "camera_id_combinations has invalid count");
     return false;
   }
   std::vector<std::vector<std::string>> normalized;
   std::unordered_set<std::string> seen_combinations;
-  for (const JsonValue& combination : combinations->array_value) {
-    if (combination.type != JsonValue::Type::Array || combination.array_value.size() < 2 ||
-        combination.array_value.size() > kMaxCombinationMembers) {
+  for (const JsonValue& combination : combinations->items()) {
+    if (combination.type != JsonValue::Type::Array || combination.items().size() < 2 ||
+        combination.items().size() > kMaxCombinationMembers) {
       set_error(out, LoadErrorKind::Validation, "camera_id combination has invalid member count");
       return false;
     }
     std::vector<std::string> ids;
     std::unordered_set<std::string> seen_ids;
-    for (const JsonValue& member : combination.array_value) {
+    for (const JsonValue& member : combination.items()) {
       std::string id;
       if (!parse_non_empty_string(member, "camera_id_combinations member", id, out)) return false;
       if (entries.find(id) == entries.end()) {
@@ -938,7 +634,8 @@ bool parse_concurrency(const JsonValue& value,
     }
     normalized.push_back(std::move(ids));
   }
-  result = camera_concurrency::Truth{camera_concurrency::TruthKind::Supported, std::move(normalized)};
+  result = camera_concurrency::Truth{camera_concurrency::TruthKind::Supported, std::move(normalized), {}};
+  camera_concurrency::index_allowed_camera_id_combinations(*result);
   return true;
 }
 
@@ -951,7 +648,7 @@ bool validate_provenance(const JsonValue& root, LoadResult& out) {
   }
   if (const JsonValue* timestamp = field(root, "timestamp_ms")) {
     if (timestamp->type != JsonValue::Type::Number ||
-        timestamp->number_lexeme.find_first_of(".eE-") != std::string::npos) {
+        timestamp->text.find_first_of(".eE-") != std::string::npos) {
       set_error(out, LoadErrorKind::Validation, "field 'timestamp_ms' must be non-negative integer");
       return false;
     }
@@ -968,15 +665,19 @@ std::size_t max_supported_camera_records() noexcept { return kMaxCameraRecords;
 std::size_t max_supported_combination_count() noexcept { return kMaxCombinationCount; }
 std::size_t max_supported_combination_members() noexcept { return kMaxCombinationMembers; }
 
-LoadResult load_replacement_from_json_text(const std::string& text) {
+LoadResult load_replacement_from_json_text(std::string_view text) {
   LoadResult out;
-  JsonValue root;
-  JsonParser parser(text);
+  strict_json::ParseOptions options;
+  options.max_input_bytes = kMaxInputBytes;
+  options.max_nesting_depth = kMaxNestingDepth;
+  options.max_string_bytes = kMaxStringBytes;
+  strict_json::Document document;
   std::string parse_error;
-  if (!parser.parse(root, &parse_error)) {
+  if (!document.parse(text, options, &parse_error)) {
     set_error(out, LoadErrorKind::Parse, std::move(parse_error));
     return out;
   }
+  const JsonValue& root = document.root();
   if (root.type != JsonValue::Type::Object) {
     set_error(out, LoadErrorKind::Validation, "root must be object");
     return out;
@@ -991,13 +692,13 @@ LoadResult load_replacement_from_json_text(const std::string& text) {
   }
   if (!validate_provenance(root, out)) return out;
   const JsonValue* cameras = field(root, "cameras");
-  if (!require_type(cameras, JsonValue::Type::Array, "cameras", out) || cameras->array_value.size() > kMaxCameraRecords) {
+  if (!require_type(cameras, JsonValue::Type::Array, "cameras", out) || cameras->items().size() > kMaxCameraRecords) {
     if (out.error_message.empty()) set_error(out, LoadErrorKind::Validation, "cameras exceeds supported count limit");
     return out;
   }
   ExternalCameraDescriptionState::Entries entries;
-  entries.reserve(cameras->array_value.size());
-  for (const JsonValue& camera : cameras->array_value) {
+  entries.reserve(cameras->items().size());
+  for (const JsonValue& camera : cameras->items()) {
     ExternalCameraDescriptionEntry entry;
     if (!parse_camera(camera, entry, out)) return out;
     const std::string id = entry.camera_id;
@@ -3,6 +3,7 @@
 #include <cstddef>
 #include <cstdint>
 #include <string>
+#include <string_view>
 
 #include "core/external_camera_description_state.h"
 
@@ -33,6 +34,6 @@ std::size_t max_supported_camera_records() noexcept;
 std::size_t max_supported_combination_count() noexcept;
 std::size_t max_supported_combination_members() noexcept;
 
-LoadResult load_replacement_from_json_text(const std::string& text);
+LoadResult load_replacement_from_json_text(std::string_view text);
 
 } // namespace cambang::adc_camera_description
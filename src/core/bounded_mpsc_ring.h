@@ -0,0 +1,125 @@
+// src/core/bounded_mpsc_ring.h
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace cambang {
+
+// Bounded lock-free multi-producer / single-consumer FIFO ring.
+//
+// Cells are allocated once at construction; try_push() and try_pop() never
+// allocate. Each cell carries a sequence number (Vyukov bounded queue):
+// producers claim a position with one CAS on the tail and publish the cell by
+// storing pos + 1; the single consumer takes the cell once it sees that value
+// and recycles it by storing pos + capacity.
+//
+// Ordering: positions a single producer claims are strictly increasing and the
+// consumer takes positions in order, so FIFO holds per producer thread. Two
+// producers racing still have an undefined relative order, exactly as with a
+// mutex-protected queue.
+//
+// Threading: try_push() from any thread. try_pop(), head_ready() and clear()
+// only from the one consumer thread (clear() also when no consumer runs).
+// reset() only while no producer or consumer runs.
+template <typename T>
+class BoundedMpscRing final {
+  static_assert(std::is_nothrow_move_assignable_v<T>,
+                "ring cells are filled after the position is claimed; a throwing move would strand it");
+  static_assert(std::is_nothrow_default_constructible_v<T>,
+                "consumed cells are reset to release captured state promptly");
+
+public:
+  // capacity must be a power of two.
+  explicit BoundedMpscRing(size_t capacity)
+      : mask_(capacity - 1), cells_(new Cell[capacity]) {
+    for (size_t i = 0; i < capacity; ++i) {
+      cells_[i].seq.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  // Reallocates to `capacity` cells (a power of two), dropping every entry.
+  // Throws std::bad_alloc and leaves the ring unchanged on failure.
+  void reset(size_t capacity) {
+    std::unique_ptr<Cell[]> cells(new Cell[capacity]);
+    for (size_t i = 0; i < capacity; ++i) {
+      cells[i].seq.store(i, std::memory_order_relaxed);
+    }
+    cells_ = std::move(cells);
+    mask_ = capacity - 1;
+    tail_.store(0, std::memory_order_relaxed);
+    head_ = 0;
+  }
+
+  BoundedMpscRing(const BoundedMpscRing&) = delete;
+  BoundedMpscRing& operator=(const BoundedMpscRing&) = delete;
+
+  size_t capacity() const noexcept { return mask_ + 1; }
+
+  // Returns false (value untouched) when every cell is occupied.
+  bool try_push(T&& value) noexcept {
+    size_t pos = tail_.load(std::memory_order_relaxed);
+    Cell* cell = nullptr;
+    for (;;) {
+      cell = &cells_[pos & mask_];
+      const size_t seq = cell->seq.load(std::memory_order_acquire);
+      const intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+      if (diff == 0) {
+        if (tail_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (diff < 0) {
+        return false;
+      } else {
+        pos = tail_.load(std::memory_order_relaxed);
+      }
+    }
+    cell->value = std::move(value);
+    cell->seq.store(pos + 1, std::memory_order_release);
+    return true;
+  }
+
+  // Consumer only. Returns false when the head cell is not yet published.
+  bool try_pop(T& out) noexcept {
+    Cell& cell = cells_[head_ & mask_];
+    if (cell.seq.load(std::memory_order_acquire) != head_ + 1) {
+      return false;
+    }
+    out = std::move(cell.value);
+    cell.value = T{};
+    cell.seq.store(head_ + mask_ + 1, std::memory_order_release);
+    ++head_;
+    return true;
+  }
+
+  // Consumer only: true when try_pop() would succeed.
+  bool head_ready() const noexcept {
+    return cells_[head_ & mask_].seq.load(std::memory_order_acquire) == head_ + 1;
+  }
+
+  // Consumer only: drops every published entry.
+  void clear() noexcept {
+    T discard{};
+    while (try_pop(discard)) {
+      discard = T{};
+    }
+  }
+
+private:
+  struct Cell {
+    std::atomic<size_t> seq{0};
+    T value{};
+  };
+
+  size_t mask_;
+  std::unique_ptr<Cell[]> cells_;
+  // Producers contend on tail_; keep it off the consumer's line.
+  alignas(64) std::atomic<size_t> tail_{0};
+  alignas(64) size_t head_ = 0;
+};
+
+} // namespace cambang
@@ -1,11 +1,13 @@
 #include "core/camera_concurrency_adc.h"
+#include "imaging/api/strict_json.h"
 
 #include <algorithm>
+#include <array>
 #include <cctype>
 #include <cstdint>
 #include <limits>
-#include <optional>
 #include <string>
+#include <string_view>
 #include <unordered_set>
 #include <utility>
 
@@ -31,466 +33,10 @@ void set_error(LoadResult& out,
   out.truth = {};
 }
 
-struct JsonValue {
-  enum class Type : std::uint8_t {
-    Null = 0,
-    Bool,
-    Number,
-    String,
-    Array,
-    Object,
-  };
-
-  Type type = Type::Null;
-  bool bool_value = false;
-  std::string number_lexeme{};
-  std::string string_value{};
-  std::vector<JsonValue> array_value{};
-  std::vector<std::pair<std::string, JsonValue>> object_value{};
-};
-
-class JsonParser final {
-public:
-  explicit JsonParser(const std::string& text) : text_(text) {}
-
-  bool parse(JsonValue& out, std::string* error) {
-    if (text_.size() > kMaxInputBytes) {
-      if (error) {
-        *error = "input exceeds byte limit";
-      }
-      return false;
-    }
-    pos_ = 0;
-    if (!parse_value(out, error, 0)) {
-      return false;
-    }
-    skip_ws();
-    if (pos_ != text_.size()) {
-      if (error) {
-        *error = "unexpected trailing input at byte " + std::to_string(pos_);
-      }
-      return false;
-    }
-    return true;
-  }
-
-private:
-  void skip_ws() {
-    while (pos_ < text_.size() &&
-           std::isspace(static_cast<unsigned char>(text_[pos_]))) {
-      ++pos_;
-    }
-  }
-
-  bool consume(char c) {
-    if (pos_ < text_.size() && text_[pos_] == c) {
-      ++pos_;
-      return true;
-    }
-    return false;
-  }
-
-  bool match_literal(const char* lit) {
-    std::size_t i = 0;
-    while (lit[i] != '\0') {
-      if (pos_ + i >= text_.size() || text_[pos_ + i] != lit[i]) {
-        return false;
-      }
-      ++i;
-    }
-    pos_ += i;
-    return true;
-  }
-
-  bool parse_value(JsonValue& out, std::string* error, std::size_t depth) {
-    skip_ws();
-    if (pos_ >= text_.size()) {
-      if (error) {
-        *error = "unexpected end of json";
-      }
-      return false;
-    }
-
-    const char c = text_[pos_];
-    if (c == '{') {
-      return parse_object(out, error, depth + 1);
-    }
-    if (c == '[') {
-      return parse_array(out, error, depth + 1);
-    }
-    if (c == '"') {
-      out.type = JsonValue::Type::String;
-      return parse_string(out.string_value, error);
-    }
-    if (c == '-' || (c >= '0' && c <= '9')) {
-      out.type = JsonValue::Type::Number;
-      return parse_number(out.number_lexeme, error);
-    }
-    if (match_literal("true")) {
-      out.type = JsonValue::Type::Bool;
-      out.bool_value = true;
-      return true;
-    }
-    if (match_literal("false")) {
-      out.type = JsonValue::Type::Bool;
-      out.bool_value = false;
-      return true;
-    }
-    if (match_literal("null")) {
-      out.type = JsonValue::Type::Null;
-      return true;
-    }
-
-    if (error) {
-      *error = "unexpected token at byte " + std::to_string(pos_);
-    }
-    return false;
-  }
-
-  bool parse_string(std::string& out, std::string* error) {
-    if (!consume('"')) {
-      if (error) {
-        *error = "expected string at byte " + std::to_string(pos_);
-      }
-      return false;
-    }
-
-    std::string value;
-    while (pos_ < text_.size()) {
-      const char c = text_[pos_++];
-      if (c == '"') {
-        out = std::move(value);
-        return true;
-      }
-      if (c == '\\') {
-        if (pos_ >= text_.size()) {
-          if (error) {
-            *error = "unterminated escape in string";
-          }
-          return false;
-        }
-        const char e = text_[pos_++];
-        switch (e) {
-          case '"': value.push_back('"'); break;
-          case '\\': value.push_back('\\'); break;
-          case '/': value.push_back('/'); break;
-          case 'b': value.push_back('\b'); break;
-          case 'f': value.push_back('\f'); break;
-          case 'n': value.push_back('\n'); break;
-          case 'r': value.push_back('\r'); break;
-          case 't': value.push_back('\t'); break;
-          case 'u': {
-            const std::optional<std::uint32_t> decoded =
-                decode_unicode_escape(error);
-            if (!decoded.has_value()) {
-              return false;
-            }
-            append_utf8(*decoded, value);
-            break;
-          }
-          default:
-            if (error) {
-              *error = "invalid escape sequence in string";
-            }
-            return false;
-        }
-      } else {
-        if (static_cast<unsigned char>(c) < 0x20) {
-          if (error) {
-            *error = "control character in string";
-          }
-          return false;
-        }
-        value.push_back(c);
-      }
-      if (value.size() > kMaxStringBytes) {
-        if (error) {
-          *error = "string exceeds byte limit";
-        }
-        return false;
-      }
-    }
-
-    if (error) {
-      *error = "unterminated string";
-    }
-    return false;
-  }
-
-  std::optional<std::uint32_t> decode_unicode_escape(std::string* error) {
-    const std::optional<std::uint32_t> first = parse_hex_escape(error);
-    if (!first.has_value()) {
-      return std::nullopt;
-    }
-    std::uint32_t codepoint = *first;
-    if (codepoint >= 0xD800u && codepoint <= 0xDBFFu) {
-      if (pos_ + 6 > text_.size() || text_[pos_] != '\\' ||
-          text_[pos_ + 1] != 'u') {
-        if (error) {
-          *error = "missing low surrogate after high surrogate escape";
-        }
-        return std::nullopt;
-      }
-      pos_ += 2;
-      const std::optional<std::uint32_t> low = parse_hex_escape(error);
-      if (!low.has_value()) {
-        return std::nullopt;
-      }
-      if (*low < 0xDC00u || *low > 0xDFFFu) {
-        if (error) {
-          *error = "invalid low surrogate escape in string";
-        }
-        return std::nullopt;
-      }
-      codepoint = 0x10000u + ((codepoint - 0xD800u) << 10) +
-                  (*low - 0xDC00u);
-    } else if (codepoint >= 0xDC00u && codepoint <= 0xDFFFu) {
-      if (error) {
-        *error = "unexpected low surrogate escape in string";
-      }
-      return std::nullopt;
-    }
-    return codepoint;
-  }
-
-  std::optional<std::uint32_t> parse_hex_escape(std::string* error) {
-    if (pos_ + 4 > text_.size()) {
-      if (error) {
-        *error = "incomplete unicode escape in string";
-      }
-      return std::nullopt;
-    }
-    std::uint32_t code = 0;
-    for (int i = 0; i < 4; ++i) {
-      const char h = text_[pos_++];
-      code <<= 4;
-      if (h >= '0' && h <= '9') {
-        code |= static_cast<std::uint32_t>(h - '0');
-      } else if (h >= 'a' && h <= 'f') {
-        code |= static_cast<std::uint32_t>(h - 'a' + 10);
-      } else if (h >= 'A' && h <= 'F') {
-        code |= static_cast<std::uint32_t>(h - 'A' + 10);
-      } else {
-        if (error) {
-          *error = "invalid unicode escape in string";
-        }
-        return std::nullopt;
-      }
-    }
-    return code;
-  }
-
-  static void append_utf8(std::uint32_t codepoint, std::string& out) {
-    if (codepoint <= 0x7Fu) {
-      out.push_back(static_cast<char>(codepoint));
-      return;
-    }
-    if (codepoint <= 0x7FFu) {
-      out.push_back(static_cast<char>(0xC0u | ((codepoint >> 6) & 0x1Fu)));
-      out.push_back(static_cast<char>(0x80u | (codepoint & 0x3Fu)));
-      return;
-    }
-    if (codepoint <= 0xFFFFu) {
-      out.push_back(static_cast<char>(0xE0u | ((codepoint >> 12) & 0x0Fu)));
-      out.push_back(static_cast<char>(0x80u | ((codepoint >> 6) & 0x3Fu)));
-      out.push_back(static_cast<char>(0x80u | (codepoint & 0x3Fu)));
-      return;
-    }
-    out.push_back(static_cast<char>(0xF0u | ((codepoint >> 18) & 0x07u)));
-    out.push_back(static_cast<char>(0x80u | ((codepoint >> 12) & 0x3Fu)));
-    out.push_back(static_cast<char>(0x80u | ((codepoint >> 6) & 0x3Fu)));
-    out.push_back(static_cast<char>(0x80u | (codepoint & 0x3Fu)));
-  }
-
-  bool parse_number(std::string& out, std::string* error) {
-    const std::size_t start = pos_;
-    if (consume('-') && pos_ >= text_.size()) {
-      if (error) {
-        *error = "invalid number at byte " + std::to_string(start);
-      }
-      return false;
-    }
-
-    if (pos_ >= text_.size() ||
-        !std::isdigit(static_cast<unsigned char>(text_[pos_]))) {
-      if (error) {
-        *error = "invalid number at byte " + std::to_string(start);
-      }
-      return false;
-    }
-
-    if (text_[pos_] == '0') {
-      ++pos_;
-      if (pos_ < text_.size() &&
-          std::isdigit(static_cast<unsigned char>(text_[pos_]))) {
-        if (error) {
-          *error = "leading zero is not allowed for numbers";
-        }
-        return false;
-      }
-    } else {
-      while (pos_ < text_.size() &&
-             std::isdigit(static_cast<unsigned char>(text_[pos_]))) {
-        ++pos_;
-      }
-    }
-
-    if (pos_ < text_.size() && text_[pos_] == '.') {
-      ++pos_;
-      if (pos_ >= text_.size() ||
-          !std::isdigit(static_cast<unsigned char>(text_[pos_]))) {
-        if (error) {
-          *error = "invalid fractional number at byte " +
-                   std::to_string(start);
-        }
-        return false;
-      }
-      while (pos_ < text_.size() &&
-             std::isdigit(static_cast<unsigned char>(text_[pos_]))) {
-        ++pos_;
-      }
-    }
-
-    if (pos_ < text_.size() && (text_[pos_] == 'e' || text_[pos_] == 'E')) {
-      ++pos_;
-      if (pos_ < text_.size() &&
-          (text_[pos_] == '+' || text_[pos_] == '-')) {
-        ++pos_;
-      }
-      if (pos_ >= text_.size() ||
-          !std::isdigit(static_cast<unsigned char>(text_[pos_]))) {
-        if (error) {
-          *error = "invalid exponent number at byte " +
-                   std::to_string(start);
-        }
-        return false;
-      }
-      while (pos_ < text_.size() &&
-             std::isdigit(static_cast<unsigned char>(text_[pos_]))) {
-        ++pos_;
-      }
-    }
-
-    out.assign(text_.data() + start, pos_ - start);
-    return true;
-  }
-
-  bool parse_array(JsonValue& out, std::string* error, std::size_t depth) {
-    if (depth > kMaxNestingDepth) {
-      if (error) {
-        *error = "json nesting exceeds depth limit";
-      }
-      return false;
-    }
-    if (!consume('[')) {
-      if (error) {
-        *error = "expected '[' at byte " + std::to_string(pos_);
-      }
-      return false;
-    }
-
-    out = {};
-    out.type = JsonValue::Type::Array;
-
-    skip_ws();
-    if (consume(']')) {
-      return true;
-    }
-
-    for (;;) {
-      JsonValue element{};
-      if (!parse_value(element, error, depth)) {
-        return false;
-      }
-      out.array_value.push_back(std::move(element));
-
-      skip_ws();
-      if (consume(']')) {
-        return true;
-      }
-      if (!consume(',')) {
-        if (error) {
-          *error = "expected ',' or ']' in array at byte " +
-                   std::to_string(pos_);
-        }
-        return false;
-      }
-    }
-  }
-
-  bool parse_object(JsonValue& out, std::string* error, std::size_t depth) {
-    if (depth > kMaxNestingDepth) {
-      if (error) {
-        *error = "json nesting exceeds depth limit";
-      }
-      return false;
-    }
-    if (!consume('{')) {
-      if (error) {
-        *error = "expected '{' at byte " + std::to_string(pos_);
-      }
-      return false;
-    }
-
-    out = {};
-    out.type = JsonValue::Type::Object;
-
-    skip_ws();
-    if (consume('}')) {
-      return true;
-    }
-
-    std::unordered_set<std::string> seen_keys;
-    for (;;) {
-      std::string key;
-      skip_ws();
-      if (!parse_string(key, error)) {
-        return false;
-      }
-      if (!seen_keys.emplace(key).second) {
-        if (error) {
-          *error = "duplicate object key: " + key;
-        }
-        return false;
-      }
-      skip_ws();
-      if (!consume(':')) {
-        if (error) {
-          *error = "expected ':' after key '" + key + "'";
-        }
-        return false;
-      }
-      JsonValue value{};
-      if (!parse_value(value, error, depth)) {
-        return false;
-      }
-      out.object_value.emplace_back(std::move(key), std::move(value));
-
-      skip_ws();
-      if (consume('}')) {
-        return true;
-      }
-      if (!consume(',')) {
-        if (error) {
-          *error = "expected ',' or '}' in object at byte " +
-                   std::to_string(pos_);
-        }
-        return false;
-      }
-    }
-  }
-
-  const std::string& text_;
-  std::size_t pos_ = 0;
-};
+using JsonValue = strict_json::Value;
 
 const JsonValue* find_field(const JsonValue& obj, const char* name) {
-  for (const auto& [key, value] : obj.object_value) {
-    if (key == name) {
-      return &value;
-    }
-  }
-  return nullptr;
+  return obj.find(name);
 }
 
 bool require_type(const JsonValue* value,
@@ -512,13 +58,13 @@ bool parse_u32(const JsonValue& value,
                const std::string& field,
                std::uint32_t& out_value,
                LoadResult& out) {
-  if (value.type != JsonValue::Type::Number || value.number_lexeme.empty()) {
+  if (value.type != JsonValue::Type::Number || value.text.empty()) {
     set_error(out,
               LoadErrorKind::Validation,
               "field '" + field + "' must be uint32 integer");
     return false;
   }
-  if (value.number_lexeme.find_first_of(".eE-") != std::string::npos) {
+  if (value.text.find_first_of(".eE-") != std::string::npos) {
     set_error(out,
               LoadErrorKind::Validation,
               "field '" + field + "' must be uint32 integer");
@@ -526,7 +72,7 @@ bool parse_u32(const JsonValue& value,
   }
 
   std::uint64_t parsed = 0;
-  for (const char c : value.number_lexeme) {
+  for (const char c : value.text) {
     if (!std::isdigit(static_cast<unsigned char>(c))) {
       set_error(out,
                 LoadErrorKind::Validation,
@@ -553,17 +99,86 @@ bool parse_non_empty_string(const JsonValue& value,
     set_error(out, LoadErrorKind::Validation, "field '" + field + "' has wrong type");
     return false;
   }
-  if (value.string_value.empty()) {
+  if (value.text.empty()) {
     set_error(out, LoadErrorKind::Validation, "field '" + field + "' must not be empty");
     return false;
   }
-  out_value = value.string_value;
+  out_value.assign(value.text);
   return true;
 }
 
+void append_source_key_text(std::string& key, std::string_view text) {
+  key += std::to_string(text.size());
+  key.push_back(':');
+  key.append(text.data(), text.size());
+}
+
+// Appends an unambiguous encoding of value: its type, then its scalar text or
+// its members in document order (object members with their names).
+void append_source_key_value(std::string& key, const JsonValue& value) {
+  key.push_back(static_cast<char>('0' + static_cast<int>(value.type)));
+  switch (value.type) {
+    case JsonValue::Type::Null:
+      break;
+    case JsonValue::Type::Bool:
+      key.push_back(value.bool_value ? 't' : 'f');
+      break;
+    case JsonValue::Type::Number:
+    case JsonValue::Type::String:
+      append_source_key_text(key, value.text);
+      break;
+    case JsonValue::Type::Array:
+    case JsonValue::Type::Object:
+      key += std::to_string(value.items().size());
+      key.push_back('[');
+      for (const JsonValue& item : value.items()) {
+        if (value.type == JsonValue::Type::Object) {
+          append_source_key_text(key, item.key);
+        }
+        append_source_key_value(key, item);
+      }
+      key.push_back(']');
+      break;
+  }
+}
+
+void append_source_key_member(std::string& key, const JsonValue& obj, const char* name) {
+  if (const JsonValue* value = find_field(obj, name)) {
+    append_source_key_value(key, *value);
+  } else {
+    key.push_back('-');
+  }
+}
+
+// Everything load_truth_from_adc_json_text() reads from the root: other
+// camera facts do not affect the concurrency truth.
+std::string make_source_key(const JsonValue& root) {
+  std::string key;
+  append_source_key_member(key, root, "schema_version");
+  append_source_key_member(key, root, "generator");
+  const JsonValue* cameras_value = find_field(root, "cameras");
+  if (cameras_value == nullptr || cameras_value->type != JsonValue::Type::Array) {
+    append_source_key_member(key, root, "cameras");
+  } else {
+    key += std::to_string(cameras_value->items().size());
+    key.push_back('[');
+    for (const JsonValue& camera : cameras_value->items()) {
+      if (camera.type != JsonValue::Type::Object) {
+        append_source_key_value(key, camera);
+        continue;
+      }
+      key.push_back('{');
+      append_source_key_member(key, camera, "camera_id");
+    }
+    key.push_back(']');
+  }
+  append_source_key_member(key, root, "concurrent_camera_support");
+  return key;
+}
+
 std::vector<std::string> normalize_combination(
     const JsonValue& combination_value,
-    const std::unordered_set<std::string>& known_camera_ids,
+    const std::unordered_set<std::string_view>& known_camera_ids,
     const std::string& field,
     LoadResult& out) {
   std::vector<std::string> normalized{};
@@ -573,17 +188,17 @@ std::vector<std::string> normalize_combination(
               "field '" + field + "' must be array");
     return normalized;
   }
-  if (combination_value.array_value.size() > kMaxCombinationMembers) {
+  if (combination_value.items().size() > kMaxCombinationMembers) {
     set_error(out,
               LoadErrorKind::Validation,
               "field '" + field + "' exceeds supported member limit");
     return normalized;
   }
 
-  normalized.reserve(combination_value.array_value.size());
+  normalized.reserve(combination_value.items().size());
   std::unordered_set<std::string> seen_members;
-  for (std::size_t i = 0; i < combination_value.array_value.size(); ++i) {
-    const JsonValue& member = combination_value.array_value[i];
+  for (std::size_t i = 0; i < combination_value.items().size(); ++i) {
+    const JsonValue& member = combination_value.items()[i];
     std::string camera_id;
     if (!parse_non_empty_string(
             member,
@@ -628,19 +243,31 @@ std::size_t max_supported_camera_records() noexcept { return kMaxCameraRecords;
 std::size_t max_supported_combination_count() noexcept { return kMaxCombinationCount; }
 std::size_t max_supported_combination_members() noexcept { return kMaxCombinationMembers; }
 
-LoadResult load_truth_from_adc_json_text(const std::string& text) {
+LoadResult load_truth_from_adc_json_text(
+    std::string_view text,
+    std::string_view retained_source_key) {
   LoadResult out{};
-  JsonValue root{};
-  JsonParser parser(text);
+  strict_json::ParseOptions options{};
+  options.max_input_bytes = kMaxInputBytes;
+  options.max_nesting_depth = kMaxNestingDepth;
+  options.max_string_bytes = kMaxStringBytes;
+  strict_json::Document document;
   std::string parse_error;
-  if (!parser.parse(root, &parse_error)) {
+  if (!document.parse(text, options, &parse_error)) {
     set_error(out, LoadErrorKind::Parse, parse_error);
     return out;
   }
+  const JsonValue& root = document.root();
   if (root.type != JsonValue::Type::Object) {
     set_error(out, LoadErrorKind::Validation, "root must be object");
     return out;
   }
+  std::string source_key = make_source_key(root);
+  if (!retained_source_key.empty() && source_key == retained_source_key) {
+    out.ok = true;
+    out.unchanged = true;
+    return out;
+  }
 
   const JsonValue* schema_version_value = find_field(root, "schema_version");
   if (!require_type(
@@ -673,19 +300,19 @@ LoadResult load_truth_from_adc_json_text(const std::string& text) {
   if (!require_type(cameras_value, JsonValue::Type::Array, "cameras", out)) {
     return out;
   }
-  if (cameras_value->array_value.empty()) {
+  if (cameras_value->items().empty()) {
     set_error(out, LoadErrorKind::Validation, "field 'cameras' must not be empty");
     return out;
   }
-  if (cameras_value->array_value.size() > kMaxCameraRecords) {
+  if (cameras_value->items().size() > kMaxCameraRecords) {
     set_error(out, LoadErrorKind::Validation, "field 'cameras' exceeds supported count limit");
     return out;
   }
 
-  std::unordered_set<std::string> known_camera_ids;
-  known_camera_ids.reserve(cameras_value->array_value.size());
-  for (std::size_t i = 0; i < cameras_value->array_value.size(); ++i) {
-    const JsonValue& camera = cameras_value->array_value[i];
+  std::unordered_set<std::string_view> known_camera_ids;
+  known_camera_ids.reserve(cameras_value->items().size());
+  for (std::size_t i = 0; i < cameras_value->items().size(); ++i) {
+    const JsonValue& camera = cameras_value->items()[i];
     if (camera.type != JsonValue::Type::Object) {
       set_error(out,
                 LoadErrorKind::Validation,
@@ -700,18 +327,18 @@ LoadResult load_truth_from_adc_json_text(const std::string& text) {
             out)) {
       return out;
     }
-    if (camera_id_value->string_value.empty()) {
+    if (camera_id_value->text.empty()) {
       set_error(out,
                 LoadErrorKind::Validation,
                 "field 'cameras[" + std::to_string(i) +
                     "].camera_id' must not be empty");
       return out;
     }
-    if (!known_camera_ids.emplace(camera_id_value->string_value).second) {
+    if (!known_camera_ids.emplace(camera_id_value->text).second) {
       set_error(out,
                 LoadErrorKind::Validation,
                 "duplicate cameras[].camera_id='" +
-                    camera_id_value->string_value + "'");
+                    std::string(camera_id_value->text) + "'");
       return out;
     }
   }
@@ -778,7 +405,7 @@ LoadResult load_truth_from_adc_json_text(const std::string& text) {
                   "field 'concurrent_camera_support.camera_id_combinations' has wrong type");
         return out;
       }
-      if (!combinations_value->array_value.empty()) {
+      if (!combinations_value->items().empty()) {
         set_error(out,
                   LoadErrorKind::Validation,
                   "concurrent_camera_support.supported=false contradicts camera_id_combinations");
@@ -787,6 +414,7 @@ LoadResult load_truth_from_adc_json_text(const std::string& text) {
     }
     out.ok = true;
     out.truth.kind = TruthKind::Unsupported;
+    out.truth.source_key = std::move(source_key);
     return out;
   }
 
@@ -797,13 +425,13 @@ LoadResult load_truth_from_adc_json_text(const std::string& text) {
           out)) {
     return out;
   }
-  if (combinations_value->array_value.empty()) {
+  if (combinations_value->items().empty()) {
     set_error(out,
               LoadErrorKind::Validation,
               "field 'concurrent_camera_support.camera_id_combinations' must not be empty");
     return out;
   }
-  if (combinations_value->array_value.size() > kMaxCombinationCount) {
+  if (combinations_value->items().size() > kMaxCombinationCount) {
     set_error(out,
               LoadErrorKind::Validation,
               "field 'concurrent_camera_support.camera_id_combinations' exceeds supported count limit");
@@ -812,10 +440,10 @@ LoadResult load_truth_from_adc_json_text(const std::string& text) {
 
   std::unordered_set<std::string> seen_normalized_combinations;
   std::vector<std::vector<std::string>> normalized_combinations;
-  normalized_combinations.reserve(combinations_value->array_value.size());
-  for (std::size_t i = 0; i < combinations_value->array_value.size(); ++i) {
+  normalized_combinations.reserve(combinations_value->items().size());
+  for (std::size_t i = 0; i < combinations_value->items().size(); ++i) {
     std::vector<std::string> normalized = normalize_combination(
-        combinations_value->array_value[i],
+        combinations_value->items()[i],
         known_camera_ids,
         "concurrent_camera_support.camera_id_combinations[" +
             std::to_string(i) + "]",
@@ -850,46 +478,110 @@ LoadResult load_truth_from_adc_json_text(const std::string& text) {
   out.truth.kind = TruthKind::Supported;
   out.truth.allowed_camera_id_combinations =
       std::move(normalized_combinations);
+  index_allowed_camera_id_combinations(out.truth);
+  out.truth.source_key = std::move(source_key);
   return out;
 }
 
-LoadResult load_truth_from_adc_json_payload(SpecPatchView payload) {
+LoadResult load_truth_from_adc_json_payload(
+    SpecPatchView payload,
+    std::string_view retained_source_key) {
   if (payload.size_bytes != 0 && payload.data == nullptr) {
     LoadResult out{};
     set_error(out, LoadErrorKind::Validation, "payload view is invalid");
     return out;
   }
-  const auto* chars = static_cast<const char*>(payload.data);
-  const std::string text = payload.size_bytes == 0
-                               ? std::string{}
-                               : std::string(chars, chars + payload.size_bytes);
-  return load_truth_from_adc_json_text(text);
+  if (payload.size_bytes == 0) {
+    return load_truth_from_adc_json_text({}, retained_source_key);
+  }
+  return load_truth_from_adc_json_text(
+      std::string_view(static_cast<const char*>(payload.data), payload.size_bytes),
+      retained_source_key);
+}
+
+void index_allowed_camera_id_combinations(Truth& truth) {
+  CombinationIndex& index = truth.combination_index;
+  index = {};
+  const auto& combinations = truth.allowed_camera_id_combinations;
+  if (combinations.empty()) {
+    return;
+  }
+
+  CoreStringInterner& interner = global_hardware_id_interner();
+  for (const auto& combination : combinations) {
+    for (const std::string& camera_id : combination) {
+      index.camera_keys.push_back(interner.intern(camera_id));
+    }
+  }
+  std::sort(index.camera_keys.begin(), index.camera_keys.end());
+  index.camera_keys.erase(
+      std::unique(index.camera_keys.begin(), index.camera_keys.end()),
+      index.camera_keys.end());
+
+  index.words_per_row = (combinations.size() + 63) / 64;
+  index.containing_combinations.assign(
+      index.camera_keys.size() * index.words_per_row, 0);
+  for (std::size_t c = 0; c < combinations.size(); ++c) {
+    for (const std::string& camera_id : combinations[c]) {
+      const std::size_t row = static_cast<std::size_t>(
+          std::lower_bound(index.camera_keys.begin(),
+                           index.camera_keys.end(),
+                           interner.find(camera_id)) -
+          index.camera_keys.begin());
+      index.containing_combinations[row * index.words_per_row + c / 64] |=
+          std::uint64_t{1} << (c % 64);
+    }
+  }
 }
 
 bool requested_camera_id_set_is_allowed(
     const Truth& truth,
     const std::vector<std::string>& requested_camera_ids) noexcept {
-  if (truth.kind != TruthKind::Supported || requested_camera_ids.size() < 2) {
+  if (truth.kind != TruthKind::Supported || requested_camera_ids.size() < 2 ||
+      requested_camera_ids.size() > kMaxCombinationMembers) {
     return false;
   }
+  std::vector<CoreStringId> keys;
+  keys.reserve(requested_camera_ids.size());
+  const CoreStringInterner& interner = global_hardware_id_interner();
+  for (const std::string& camera_id : requested_camera_ids) {
+    keys.push_back(interner.find(camera_id));
+  }
+  return requested_camera_key_set_is_allowed(truth, keys);
+}
 
-  std::vector<std::string> normalized_requested = requested_camera_ids;
-  std::sort(normalized_requested.begin(), normalized_requested.end());
-  if (std::adjacent_find(
-          normalized_requested.begin(),
-          normalized_requested.end()) != normalized_requested.end()) {
+bool requested_camera_key_set_is_allowed(
+    const Truth& truth,
+    const std::vector<CoreStringId>& requested_camera_keys) noexcept {
+  // No allowed combination holds more than kMaxCombinationMembers cameras.
+  if (truth.kind != TruthKind::Supported || requested_camera_keys.size() < 2 ||
+      requested_camera_keys.size() > kMaxCombinationMembers) {
+    return false;
+  }
+
+  const CombinationIndex& index = truth.combination_index;
+  std::array<std::size_t, kMaxCombinationMembers> rows{};
+  const std::size_t count = requested_camera_keys.size();
+  for (std::size_t i = 0; i < count; ++i) {
+    const CoreStringId key = requested_camera_keys[i];
+    const auto it = std::lower_bound(index.camera_keys.begin(), index.camera_keys.end(), key);
+    if (key == 0 || it == index.camera_keys.end() || *it != key) {
+      return false;
+    }
+    rows[i] = static_cast<std::size_t>(it - index.camera_keys.begin());
+  }
+  std::sort(rows.begin(), rows.begin() + count);
+  if (std::adjacent_find(rows.begin(), rows.begin() + count) !=
+      rows.begin() + count) {
     return false;
   }
 
-  for (const auto& allowed : truth.allowed_camera_id_combinations) {
-    if (allowed.size() < normalized_requested.size()) {
-      continue;
+  for (std::size_t w = 0; w < index.words_per_row; ++w) {
+    std::uint64_t common = ~std::uint64_t{0};
+    for (std::size_t i = 0; i < count && common != 0; ++i) {
+      common &= index.containing_combinations[rows[i] * index.words_per_row + w];
     }
-    if (std::includes(
-            allowed.begin(),
-            allowed.end(),
-            normalized_requested.begin(),
-            normalized_requested.end())) {
+    if (common != 0) {
       return true;
     }
   }
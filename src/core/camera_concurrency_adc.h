@@ -3,8 +3,10 @@
 #include <cstddef>
 #include <cstdint>
 #include <string>
+#include <string_view>
 #include <vector>
 
+#include "core/core_string_interner.h"
 #include "imaging/api/provider_contract_datatypes.h"
 
 namespace cambang::camera_concurrency {
@@ -20,9 +22,26 @@ enum class TruthKind : std::uint8_t {
   Supported = 2,
 };
 
+// Admission lookup over Truth::allowed_camera_id_combinations, built once by
+// index_allowed_camera_id_combinations() when a truth is loaded.
+struct CombinationIndex {
+  // global_hardware_id_interner() id of every camera_id named by some
+  // allowed combination, sorted by id.
+  std::vector<CoreStringId> camera_keys{};
+  // One row of words_per_row words per camera_keys entry: bit c is set when
+  // allowed combination c contains that camera.
+  std::vector<std::uint64_t> containing_combinations{};
+  std::size_t words_per_row = 0;
+};
+
 struct Truth {
   TruthKind kind = TruthKind::Unavailable;
   std::vector<std::vector<std::string>> allowed_camera_id_combinations{};
+  CombinationIndex combination_index{};
+  // Canonical encoding of the ADC members this truth was derived from
+  // (schema_version, generator, each camera's camera_id, and
+  // concurrent_camera_support). Empty for a truth assembled by hand.
+  std::string source_key{};
 };
 
 enum class LoadErrorKind : std::uint8_t {
@@ -36,6 +55,9 @@ struct LoadResult {
   LoadErrorKind error_kind = LoadErrorKind::None;
   std::string error_message;
   Truth truth{};
+  // The payload's source key matched the retained one passed to the loader:
+  // truth is left empty and the caller's retained truth still holds.
+  bool unchanged = false;
 };
 
 std::size_t max_supported_input_bytes() noexcept;
@@ -45,11 +67,28 @@ std::size_t max_supported_camera_records() noexcept;
 std::size_t max_supported_combination_count() noexcept;
 std::size_t max_supported_combination_members() noexcept;
 
-LoadResult load_truth_from_adc_json_text(const std::string& text);
-LoadResult load_truth_from_adc_json_payload(SpecPatchView payload);
+// With a non-empty retained_source_key, the document is still parsed in
+// full, but the truth is only re-derived when the members it depends on
+// differ from the ones that key was taken from.
+LoadResult load_truth_from_adc_json_text(
+    std::string_view text,
+    std::string_view retained_source_key = {});
+LoadResult load_truth_from_adc_json_payload(
+    SpecPatchView payload,
+    std::string_view retained_source_key = {});
 
+// Rebuilds truth.combination_index from allowed_camera_id_combinations.
+// Loaders call this; a Truth assembled by hand must too before lookups.
+void index_allowed_camera_id_combinations(Truth& truth);
+
+// True when the requested ids are distinct and all belong to one allowed
+// combination: a binary search per id and an AND across their index rows.
 bool requested_camera_id_set_is_allowed(
     const Truth& truth,
     const std::vector<std::string>& requested_camera_ids) noexcept;
+// Same, over global_hardware_id_interner() ids (0 matches nothing).
+bool requested_camera_key_set_is_allowed(
+    const Truth& truth,
+    const std::vector<CoreStringId>& requested_camera_keys) noexcept;
 
 } // namespace cambang::camera_concurrency
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <array>
 #include <cmath>
 #include <cstdint>
 #include <limits>
@@ -565,6 +566,27 @@ class ImageAcquisitionTiming {
   ImageAcquisitionComparability comparability_;
 };
 
+// acquisition_mark * tick period, without overflowing for any mark whose
+// nanosecond value fits. False when it does not fit.
+inline bool image_acquisition_time_ns(const ImageAcquisitionTiming& timing, int64_t& out) noexcept {
+  const int64_t mark = timing.acquisition_mark();
+  const int64_t num = timing.tick_period().numerator_ns();
+  const int64_t den = timing.tick_period().denominator();
+  const int64_t max = std::numeric_limits<int64_t>::max();
+  const int64_t whole = mark / den;
+  const int64_t rest = mark % den;
+  if (whole > max / num || rest > max / num) {
+    return false;
+  }
+  const int64_t whole_ns = whole * num;
+  const int64_t rest_ns = rest * num / den;
+  if (whole_ns > max - rest_ns) {
+    return false;
+  }
+  out = whole_ns + rest_ns;
+  return true;
+}
+
 class FocusAtDistance {
  public:
   static std::optional<FocusAtDistance> create(double distance_m) {
@@ -678,6 +700,54 @@ struct RealizedImageTransform {
   bool pixels_already_transformed;
 };
 
+// Colour filter over the sensor, naming the top-left 2x2 Bayer tile in row
+// order. RGB, MONO and NIR sensors have no Bayer tile.
+enum class ColorFilterArrangement : uint8_t {
+  RGGB = 0,
+  GRBG = 1,
+  GBRG = 2,
+  BGGR = 3,
+  RGB = 4,
+  MONO = 5,
+  NIR = 6,
+  UNKNOWN = 7,
+};
+
+// What it takes to read the samples of a RAW capture (FOURCC_RAW16 /
+// FOURCC_RAW10): the colour filter each sample sits under, the black level
+// of each of the four Bayer channels in the tile's row order, and the white
+// (saturation) level. Levels are in sample units; every black level is below
+// the white level.
+class RawSensorLayout {
+ public:
+  static std::optional<RawSensorLayout> create(
+      ColorFilterArrangement color_filter,
+      std::array<uint32_t, 4> black_levels,
+      uint32_t white_level) {
+    if (white_level == 0) {
+      return std::nullopt;
+    }
+    for (uint32_t black : black_levels) {
+      if (black >= white_level) {
+        return std::nullopt;
+      }
+    }
+    return RawSensorLayout(color_filter, black_levels, white_level);
+  }
+
+  ColorFilterArrangement color_filter() const noexcept { return color_filter_; }
+  const std::array<uint32_t, 4>& black_levels() const noexcept { return black_levels_; }
+  uint32_t white_level() const noexcept { return white_level_; }
+
+ private:
+  RawSensorLayout(ColorFilterArrangement color_filter, std::array<uint32_t, 4> black_levels, uint32_t white_level)
+      : color_filter_(color_filter), black_levels_(black_levels), white_level_(white_level) {}
+
+  ColorFilterArrangement color_filter_;
+  std::array<uint32_t, 4> black_levels_;
+  uint32_t white_level_;
+};
+
 // These containers deliberately separate static camera description, Core
 // admission context, and image-time facts. No provider or interchange shape is
 // implied by this source-neutral Core model.
@@ -698,6 +768,7 @@ struct CameraStaticFacts {
   std::optional<SourcedFact<SensorSensitivityIso>> sensor_sensitivity_iso;
   std::optional<SourcedFact<ApertureFNumber>> aperture_f_number;
   std::optional<SourcedFact<FocalLengthMm>> focal_length_mm;
+  std::optional<SourcedFact<RawSensorLayout>> raw_sensor_layout;
 };
 
 struct CaptureAdmissionFacts {
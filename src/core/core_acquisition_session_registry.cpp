@@ -45,6 +45,7 @@ bool CoreAcquisitionSessionRegistry::on_native_object_created(uint64_t native_id
                                                               uint32_t capture_format,
                                                               uint64_t capture_profile_version,
                                                               const CaptureStillImageBundle& capture_still_image_bundle) {
+  revision_ = next_core_registry_revision();
   if (native_id == 0 || type != static_cast<uint32_t>(NativeObjectType::AcquisitionSession)) {
     return false;
   }
@@ -108,6 +109,7 @@ bool CoreAcquisitionSessionRegistry::on_native_object_created(uint64_t native_id
 }
 
 bool CoreAcquisitionSessionRegistry::on_native_object_destroyed(uint64_t native_id, uint64_t destroyed_ns) {
+  revision_ = next_core_registry_revision();
   if (native_id == 0) {
     return false;
   }
@@ -138,6 +140,7 @@ bool CoreAcquisitionSessionRegistry::on_capture_started(uint64_t device_instance
                                                         uint32_t capture_format,
                                                         uint64_t capture_profile_version,
                                                         const CaptureStillImageBundle& capture_still_image_bundle) {
+  revision_ = next_core_registry_revision();
   if (device_instance_id == 0 || capture_id == 0) {
     return false;
   }
@@ -193,6 +196,7 @@ bool CoreAcquisitionSessionRegistry::on_capture_started(uint64_t device_instance
 bool CoreAcquisitionSessionRegistry::on_capture_completed(uint64_t device_instance_id,
                                                           uint64_t capture_id,
                                                           uint64_t completed_ns) {
+  revision_ = next_core_registry_revision();
   if (device_instance_id == 0 || capture_id == 0) {
     return false;
   }
@@ -228,6 +232,7 @@ bool CoreAcquisitionSessionRegistry::on_capture_failed(uint64_t device_instance_
                                                        uint64_t capture_id,
                                                        uint32_t error_code,
                                                        uint64_t failed_ns) {
+  revision_ = next_core_registry_revision();
   if (device_instance_id == 0 || capture_id == 0) {
     return false;
   }
@@ -417,6 +422,7 @@ void CoreAcquisitionSessionRegistry::rebuild_device_live_index_(uint64_t device_
 }
 
 void CoreAcquisitionSessionRegistry::clear() {
+  revision_ = next_core_registry_revision();
   sessions_.clear();
   device_live_session_id_.clear();
   device_live_session_count_.clear();
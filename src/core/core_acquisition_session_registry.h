@@ -4,6 +4,7 @@
 #include <map>
 #include <unordered_map>
 
+#include "core/core_registry_revision.h"
 #include "core/snapshot/state_snapshot.h"
 #include "imaging/api/provider_contract_datatypes.h"
 
@@ -76,6 +77,8 @@ public:
 
   const AcquisitionSessionEntry* find(uint64_t acquisition_session_id) const noexcept;
   const std::map<uint64_t, AcquisitionSessionEntry>& all() const noexcept { return sessions_; }
+  // Snapshot dirty-tracking stamp (see core_registry_revision.h).
+  uint64_t revision() const noexcept { return revision_; }
   uint64_t resolve_live_session_id_for_device(uint64_t device_instance_id) const noexcept;
   bool has_capture_in_flight_for_device(uint64_t device_instance_id) const noexcept;
   uint64_t resolve_session_id_for_capture(uint64_t device_instance_id,
@@ -97,6 +100,7 @@ private:
   std::unordered_map<uint64_t, uint32_t> device_live_session_count_;
   std::unordered_map<uint64_t, CaptureInFlight> captures_in_flight_;
   uint64_t next_capture_access_posture_epoch_ = 1;
+  uint64_t revision_ = 0;
 };
 
 } // namespace cambang
@@ -6,7 +6,7 @@ namespace cambang {
 
 namespace {
 CoreCaptureAssemblyRegistry::DeviceCaptureAssembly& get_or_create_assembly(
-    std::map<uint64_t, std::map<uint64_t, CoreCaptureAssemblyRegistry::DeviceCaptureAssembly>>& by_capture,
+    CoreIdMap<CoreIdMap<CoreCaptureAssemblyRegistry::DeviceCaptureAssembly>>& by_capture,
     uint64_t capture_id,
     uint64_t device_instance_id) {
   auto& assembly = by_capture[capture_id][device_instance_id];
@@ -21,6 +21,7 @@ void CoreCaptureAssemblyRegistry::mark_default_image_retained(uint64_t capture_i
     return;
   }
   std::lock_guard<std::mutex> lock(mutex_);
+  revision_ = next_core_registry_revision();
   DeviceCaptureAssembly& assembly =
       get_or_create_assembly(assemblies_by_capture_id_, capture_id, device_instance_id);
   assembly.has_default_image_retained = true;
@@ -36,16 +37,13 @@ void CoreCaptureAssemblyRegistry::record_admission_context(
     return;
   }
   std::lock_guard<std::mutex> lock(mutex_);
+  revision_ = next_core_registry_revision();
   DeviceCaptureAssembly& assembly =
       get_or_create_assembly(assemblies_by_capture_id_, capture_id, device_instance_id);
   assembly.admission_context = std::move(context);
   assembly.has_admission_context = true;
   assembly.admitted_ns = admitted_ns;
-  assembly.expected_image_member_indices.clear();
-  assembly.expected_image_member_indices.reserve(still_image_bundle.members.size());
-  for (const CaptureStillImageMember& member : still_image_bundle.members) {
-    assembly.expected_image_member_indices.push_back(member.image_member_index);
-  }
+  assembly.expected_image_member_count = static_cast<uint32_t>(still_image_bundle.members.size());
 }
 
 bool CoreCaptureAssemblyRegistry::has_admitted_capture_member(
@@ -57,8 +55,7 @@ bool CoreCaptureAssemblyRegistry::has_admitted_capture_member(
   if (capture_it == assemblies_by_capture_id_.end()) return false;
   const auto device_it = capture_it->second.find(device_instance_id);
   if (device_it == capture_it->second.end()) return false;
-  const auto& members = device_it->second.expected_image_member_indices;
-  return std::find(members.begin(), members.end(), image_member_index) != members.end();
+  return image_member_index < device_it->second.expected_image_member_count;
 }
 
 std::optional<CaptureAdmissionContext> CoreCaptureAssemblyRegistry::admission_context_for(
@@ -78,8 +75,12 @@ void CoreCaptureAssemblyRegistry::mark_capture_completed(uint64_t capture_id, ui
     return;
   }
   std::lock_guard<std::mutex> lock(mutex_);
+  revision_ = next_core_registry_revision();
   DeviceCaptureAssembly& assembly =
       get_or_create_assembly(assemblies_by_capture_id_, capture_id, device_instance_id);
+  if (assembly.terminal_state == TerminalState::NONE) {
+    newly_terminal_.emplace_back(capture_id, device_instance_id);
+  }
   assembly.terminal_state = TerminalState::COMPLETED;
   assembly.has_failure_error_code = false;
   assembly.failure_error_code = 0;
@@ -92,8 +93,12 @@ void CoreCaptureAssemblyRegistry::mark_capture_failed(uint64_t capture_id,
     return;
   }
   std::lock_guard<std::mutex> lock(mutex_);
+  revision_ = next_core_registry_revision();
   DeviceCaptureAssembly& assembly =
       get_or_create_assembly(assemblies_by_capture_id_, capture_id, device_instance_id);
+  if (assembly.terminal_state == TerminalState::NONE) {
+    newly_terminal_.emplace_back(capture_id, device_instance_id);
+  }
   assembly.terminal_state = TerminalState::FAILED;
   assembly.has_failure_error_code = true;
   assembly.failure_error_code = error_code;
@@ -138,6 +143,7 @@ std::vector<CoreCaptureAssemblyRegistry::TimedOutAssembly>
 CoreCaptureAssemblyRegistry::sweep_admission_timeouts(uint64_t now_ns, uint64_t timeout_ns) {
   std::vector<TimedOutAssembly> timed_out;
   std::lock_guard<std::mutex> lock(mutex_);
+  revision_ = next_core_registry_revision();
   for (auto& [capture_id, by_device] : assemblies_by_capture_id_) {
     for (auto& [device_instance_id, assembly] : by_device) {
       if (!assembly.has_admission_context ||
@@ -151,6 +157,7 @@ CoreCaptureAssemblyRegistry::sweep_admission_timeouts(uint64_t now_ns, uint64_t
       assembly.has_failure_error_code = true;
       assembly.failure_error_code = static_cast<uint32_t>(ProviderError::ERR_TIMEOUT);
       timed_out.push_back(TimedOutAssembly{capture_id, device_instance_id});
+      newly_terminal_.emplace_back(capture_id, device_instance_id);
     }
   }
   return timed_out;
@@ -186,25 +193,18 @@ CoreCaptureAssemblyRegistry::retire_terminal_older_than(
     uint64_t now_ns, uint64_t retention_window_ns) {
   std::vector<RetiredAssembly> retired;
   std::lock_guard<std::mutex> lock(mutex_);
-  for (auto capture_it = assemblies_by_capture_id_.begin();
-       capture_it != assemblies_by_capture_id_.end();) {
-    for (auto device_it = capture_it->second.begin();
-         device_it != capture_it->second.end();) {
-      const DeviceCaptureAssembly& assembly = device_it->second;
+  revision_ = next_core_registry_revision();
+  assemblies_by_capture_id_.erase_if([&](uint64_t capture_id, CoreIdMap<DeviceCaptureAssembly>& by_device) {
+    by_device.erase_if([&](uint64_t device_instance_id, const DeviceCaptureAssembly& assembly) {
       if (assembly.terminal_state == TerminalState::NONE ||
           now_ns < assembly.admitted_ns + retention_window_ns) {
-        ++device_it;
-        continue;
+        return false;
       }
-      retired.push_back(RetiredAssembly{capture_it->first, device_it->first});
-      device_it = capture_it->second.erase(device_it);
-    }
-    if (capture_it->second.empty()) {
-      capture_it = assemblies_by_capture_id_.erase(capture_it);
-    } else {
-      ++capture_it;
-    }
-  }
+      retired.push_back(RetiredAssembly{capture_id, device_instance_id});
+      return true;
+    });
+    return by_device.empty();
+  });
   return retired;
 }
 
@@ -234,21 +234,23 @@ std::optional<uint64_t> CoreCaptureAssemblyRegistry::next_terminal_retirement_de
 
 
 std::vector<std::pair<uint64_t, uint64_t>>
-CoreCaptureAssemblyRegistry::terminal_capture_device_pairs() const {
+CoreCaptureAssemblyRegistry::take_newly_terminal_capture_device_pairs() {
   std::vector<std::pair<uint64_t, uint64_t>> pairs;
   std::lock_guard<std::mutex> lock(mutex_);
-  for (const auto& [capture_id, by_device] : assemblies_by_capture_id_) {
-    for (const auto& [device_instance_id, assembly] : by_device) {
-      if (assembly.terminal_state != TerminalState::NONE) {
-        pairs.emplace_back(capture_id, device_instance_id);
-      }
-    }
-  }
+  pairs.swap(newly_terminal_);
+  pairs.erase(std::remove_if(pairs.begin(), pairs.end(),
+                             [this](const std::pair<uint64_t, uint64_t>& pair) {
+                               const auto capture_it = assemblies_by_capture_id_.find(pair.first);
+                               return capture_it == assemblies_by_capture_id_.end() ||
+                                      capture_it->second.count(pair.second) == 0;
+                             }),
+              pairs.end());
   return pairs;
 }
 
 void CoreCaptureAssemblyRegistry::remove_assembly(uint64_t capture_id, uint64_t device_instance_id) {
   std::lock_guard<std::mutex> lock(mutex_);
+  revision_ = next_core_registry_revision();
   auto capture_it = assemblies_by_capture_id_.find(capture_id);
   if (capture_it == assemblies_by_capture_id_.end()) {
     return;
@@ -259,9 +261,26 @@ void CoreCaptureAssemblyRegistry::remove_assembly(uint64_t capture_id, uint64_t
   }
 }
 
+uint64_t CoreCaptureAssemblyRegistry::revision() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return revision_;
+}
+
+size_t CoreCaptureAssemblyRegistry::assembly_count() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  size_t count = 0;
+  for (const auto& [capture_id, by_device] : assemblies_by_capture_id_) {
+    (void)capture_id;
+    count += by_device.size();
+  }
+  return count;
+}
+
 void CoreCaptureAssemblyRegistry::clear() {
   std::lock_guard<std::mutex> lock(mutex_);
+  revision_ = next_core_registry_revision();
   assemblies_by_capture_id_.clear();
+  newly_terminal_.clear();
 }
 
 #if defined(CAMBANG_INTERNAL_SMOKE)
@@ -1,13 +1,14 @@
 #pragma once
 
 #include <cstdint>
-#include <map>
 #include <mutex>
 #include <optional>
 #include <utility>
 #include <vector>
 
 #include "core/capture_admission_context.h"
+#include "core/core_id_map.h"
+#include "core/core_registry_revision.h"
 #include "imaging/api/provider_contract_datatypes.h"
 
 namespace cambang {
@@ -29,7 +30,9 @@ public:
     uint64_t device_instance_id = 0;
     bool has_admission_context = false;
     CaptureAdmissionContext admission_context{};
-    std::vector<uint32_t> expected_image_member_indices{};
+    // Admitted bundle members are indexed 0..count-1
+    // (is_valid_capture_still_image_bundle()), so the count is the set.
+    uint32_t expected_image_member_count = 0;
     bool has_default_image_retained = false;
     TerminalState terminal_state = TerminalState::NONE;
     bool has_failure_error_code = false;
@@ -116,32 +119,36 @@ public:
   // bookkeeping consistent with that decision.
   void remove_assembly(uint64_t capture_id, uint64_t device_instance_id);
 
-  // Queried by CoreRuntime to build the is_evictable predicate it passes to
-  // CoreResultStore::evict_over_byte_budget() (ledger #53): only entries
-  // already in a terminal state (COMPLETED or FAILED) may be evicted for
-  // size, for the same reason terminal state gates
-  // retire_terminal_older_than() -- a still-pending (NONE) assembly must
-  // never have its result data dropped out from under it (that data is still
-  // being actively appended to / finalized by the capture pipeline itself,
-  // not merely retained for later lookup).
+  // Drained by CoreRuntime into CoreResultStore::mark_capture_results_evictable()
+  // before each byte-budget pass (ledger #53): only entries already in a
+  // terminal state (COMPLETED or FAILED) may be evicted for size, for the
+  // same reason terminal state gates retire_terminal_older_than() -- a
+  // still-pending (NONE) assembly must never have its result data dropped
+  // out from under it (that data is still being actively appended to /
+  // finalized by the capture pipeline itself, not merely retained for later
+  // lookup).
   //
-  // Returns a snapshot (not a live predicate) so CoreRuntime can take this
-  // registry's lock, copy out the answer, and release it BEFORE ever taking
-  // CoreResultStore::mutex_ for the eviction walk. Every other cross-registry
-  // access in this codebase (e.g. get_capture_result_set()'s assembly-then-
-  // result reads) locks the two registries sequentially, never nested; a
-  // live per-candidate predicate here would instead nest
-  // CoreCaptureAssemblyRegistry::mutex_ inside CoreResultStore::mutex_,
-  // the one cross-registry lock order this codebase does not otherwise use.
-  // The snapshot cannot go stale between being taken and the eviction walk
-  // that consults it: terminal_state only ever moves one way (NONE ->
-  // COMPLETED/FAILED), both this snapshot and the eviction it feeds run
-  // synchronously within the same core-thread timer tick with no
-  // interleaving work, and only the core thread ever mutates terminal_state.
-  std::vector<std::pair<uint64_t, uint64_t>> terminal_capture_device_pairs() const;
+  // Returns the (capture_id, device_instance_id) pairs that moved NONE ->
+  // COMPLETED/FAILED since the last call and still have an assembly, so the
+  // result store's evictable list is maintained incrementally instead of
+  // being rebuilt from every terminal assembly on each pass. CoreRuntime
+  // takes this registry's lock, copies the pairs out and releases it BEFORE
+  // taking CoreResultStore::mutex_: every cross-registry access in this
+  // codebase (e.g. get_capture_result_set()'s assembly-then-result reads)
+  // locks the two registries sequentially, never nested. terminal_state only
+  // ever moves one way and only the core thread mutates it, so a pair once
+  // handed out stays terminal until its assembly is removed.
+  std::vector<std::pair<uint64_t, uint64_t>> take_newly_terminal_capture_device_pairs();
 
   void clear();
 
+  // Assemblies held, across every capture.
+  size_t assembly_count() const;
+
+  // Mutation stamp (see core_registry_revision.h); CoreRuntime's deadline
+  // table skips this registry's sweeps while it is unchanged.
+  uint64_t revision() const;
+
 #if defined(CAMBANG_INTERNAL_SMOKE)
   std::optional<DeviceCaptureAssembly> find_for_smoke(uint64_t capture_id,
                                                       uint64_t device_instance_id) const;
@@ -149,7 +156,10 @@ public:
 
 private:
   mutable std::mutex mutex_;
-  std::map<uint64_t, std::map<uint64_t, DeviceCaptureAssembly>> assemblies_by_capture_id_;
+  CoreIdMap<CoreIdMap<DeviceCaptureAssembly>> assemblies_by_capture_id_;
+  // NONE -> terminal transitions not yet taken; may name removed assemblies.
+  std::vector<std::pair<uint64_t, uint64_t>> newly_terminal_;
+  uint64_t revision_ = 0;
 };
 
 } // namespace cambang
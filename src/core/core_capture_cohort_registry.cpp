@@ -6,6 +6,7 @@ namespace cambang {
 
 void CoreCaptureCohortRegistry::clear() noexcept {
   std::lock_guard<std::mutex> lock(mutex_);
+  revision_ = next_core_registry_revision();
   cohorts_.clear();
 }
 
@@ -19,6 +20,7 @@ bool CoreCaptureCohortRegistry::insert(CohortRecord record) {
   record.failure_error_code = 0;
   record.has_failure_error_code = false;
   std::lock_guard<std::mutex> lock(mutex_);
+  revision_ = next_core_registry_revision();
   auto [it, inserted] = cohorts_.emplace(record.capture_id, std::move(record));
   (void)it;
   return inserted;
@@ -27,6 +29,7 @@ bool CoreCaptureCohortRegistry::insert(CohortRecord record) {
 bool CoreCaptureCohortRegistry::set_admission_context(
     uint64_t capture_id, CaptureAdmissionContext context) noexcept {
   std::lock_guard<std::mutex> lock(mutex_);
+  revision_ = next_core_registry_revision();
   const auto it = cohorts_.find(capture_id);
   if (it == cohorts_.end() || it->second.has_admission_context) {
     return false;
@@ -36,11 +39,25 @@ bool CoreCaptureCohortRegistry::set_admission_context(
   return true;
 }
 
+bool CoreCaptureCohortRegistry::set_acquisition_skew_ns(
+    uint64_t capture_id, uint64_t skew_ns) noexcept {
+  std::lock_guard<std::mutex> lock(mutex_);
+  revision_ = next_core_registry_revision();
+  const auto it = cohorts_.find(capture_id);
+  if (it == cohorts_.end()) {
+    return false;
+  }
+  it->second.acquisition_skew_ns = skew_ns;
+  it->second.has_acquisition_skew_ns = true;
+  return true;
+}
+
 bool CoreCaptureCohortRegistry::mark_failed(uint64_t capture_id,
                                             uint64_t failed_device_instance_id,
                                             uint32_t failure_error_code,
                                             CohortFailurePhase phase) noexcept {
   std::lock_guard<std::mutex> lock(mutex_);
+  revision_ = next_core_registry_revision();
   const auto it = cohorts_.find(capture_id);
   if (it == cohorts_.end()) {
     return false;
@@ -68,10 +85,16 @@ std::optional<CoreCaptureCohortRegistry::CohortRecord> CoreCaptureCohortRegistry
   return it->second;
 }
 
+size_t CoreCaptureCohortRegistry::cohort_count() const noexcept {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return cohorts_.size();
+}
+
 size_t CoreCaptureCohortRegistry::retire_expired_cohorts(
     uint64_t now_ns, uint64_t retention_window_ns) {
   size_t retired = 0;
   std::lock_guard<std::mutex> lock(mutex_);
+  revision_ = next_core_registry_revision();
   for (auto it = cohorts_.begin(); it != cohorts_.end();) {
     if (now_ns < it->second.created_ns + retention_window_ns) {
       ++it;
@@ -101,4 +124,9 @@ std::optional<uint64_t> CoreCaptureCohortRegistry::next_cohort_expiry_delay_ns(
   return min_delay;
 }
 
+uint64_t CoreCaptureCohortRegistry::revision() const noexcept {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return revision_;
+}
+
 } // namespace cambang
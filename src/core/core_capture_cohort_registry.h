@@ -10,6 +10,7 @@
 #include <vector>
 
 #include "core/capture_admission_context.h"
+#include "core/core_registry_revision.h"
 
 namespace cambang {
 
@@ -55,18 +56,25 @@ public:
     // set by the caller before insert(); drives retire_expired_cohorts()
     // (ledger #52). Not reset by insert().
     uint64_t created_ns = 0;
+    // Sensor-clock spread of the members' frames, known up front when the
+    // cohort was captured from a matched stream frame set; the rig's
+    // sync_skew then reports it instead of the capture_started arrival spread.
+    bool has_acquisition_skew_ns = false;
+    uint64_t acquisition_skew_ns = 0;
   };
 
   void clear() noexcept;
 
   bool insert(CohortRecord record);
   bool set_admission_context(uint64_t capture_id, CaptureAdmissionContext context) noexcept;
+  bool set_acquisition_skew_ns(uint64_t capture_id, uint64_t skew_ns) noexcept;
   bool mark_failed(uint64_t capture_id,
                    uint64_t failed_device_instance_id,
                    uint32_t failure_error_code,
                    CohortFailurePhase phase) noexcept;
   bool contains(uint64_t capture_id) const noexcept;
   std::optional<CohortRecord> find(uint64_t capture_id) const noexcept;
+  size_t cohort_count() const noexcept;
 
   // Retention (ledger #52): this registry holds no payload/image data (see
   // class doc comment), so unlike CoreCaptureAssemblyRegistry/CoreResultStore
@@ -80,9 +88,14 @@ public:
   std::optional<uint64_t> next_cohort_expiry_delay_ns(
       uint64_t now_ns, uint64_t retention_window_ns) const;
 
+  // Mutation stamp (see core_registry_revision.h); CoreRuntime's deadline
+  // table skips this registry's sweeps while it is unchanged.
+  uint64_t revision() const noexcept;
+
 private:
   mutable std::mutex mutex_;
   std::map<uint64_t, CohortRecord> cohorts_;
+  uint64_t revision_ = 0;
 };
 
 } // namespace cambang
@@ -0,0 +1,200 @@
+// src/core/core_capture_fusion.cpp
+#include "core/core_capture_fusion.h"
+
+#include <algorithm>
+#include <array>
+#include <vector>
+
+#include "imaging/api/thread_policy.h"
+#include "pixels/fusion/exposure_fusion.h"
+
+namespace cambang {
+
+namespace {
+
+std::shared_ptr<const CoreDerivedPayload> build_exposure_fusion(const CoreCaptureResultData& data) {
+  const uint32_t count = data.image_member_count();
+  std::array<const CoreResultPayloadCpuPacked*, kMaxExposureFusionImages> payloads{};
+  for (uint32_t k = 0; k < count; ++k) {
+    payloads[k] = &data.image_member_at(k)->payload;
+  }
+  const uint32_t width = payloads[0]->width;
+  const uint32_t height = payloads[0]->height;
+
+  // Weights, from every member scaled down by the same factor.
+  PackedTransform coarse{};
+  coarse.downscale = std::max<uint32_t>(
+      1, (std::max(width, height) + CoreCaptureFusionSlot::kCoarseLongestSide - 1) /
+             CoreCaptureFusionSlot::kCoarseLongestSide);
+  PackedTransformGeometry coarse_geometry{};
+  if (!resolve_packed_transform(coarse, width, height, coarse_geometry)) {
+    return nullptr;
+  }
+  std::vector<std::vector<uint8_t>> coarse_images(count);
+  std::array<const uint8_t*, kMaxExposureFusionImages> coarse_rows{};
+  for (uint32_t k = 0; k < count; ++k) {
+    coarse_images[k].resize(coarse_geometry.tight_size_bytes());
+    if (!copy_retained_cpu_payload_transformed(*payloads[k], coarse, coarse_images[k].data(),
+                                               coarse_images[k].size())) {
+      return nullptr;
+    }
+    coarse_rows[k] = coarse_images[k].data();
+  }
+  ExposureFusionWeights weights;
+  if (!compute_exposure_fusion_weights(coarse_rows.data(), count, coarse_geometry.width, coarse_geometry.height,
+                                       static_cast<size_t>(coarse_geometry.width) * 4u, weights)) {
+    return nullptr;
+  }
+
+  auto fused = std::make_shared<CoreDerivedPayload>();
+  fused->width = width;
+  fused->height = height;
+  fused->stride_bytes = width * 4u;
+  fused->bytes.resize(static_cast<size_t>(fused->stride_bytes) * height);
+
+  // Blend, a band of full-resolution rows of every member at a time.
+  constexpr uint32_t kBandRows = CoreCaptureFusionSlot::kBandRows;
+  const size_t row_bytes = fused->stride_bytes;
+  std::vector<std::vector<uint8_t>> bands(count, std::vector<uint8_t>(row_bytes * kBandRows));
+  std::vector<std::vector<uint16_t>> weight_rows(count, std::vector<uint16_t>(row_bytes));
+  std::array<uint16_t*, kMaxExposureFusionImages> weight_out{};
+  std::array<const uint16_t*, kMaxExposureFusionImages> weight_in{};
+  std::array<const uint8_t*, kMaxExposureFusionImages> band_in{};
+  for (uint32_t k = 0; k < count; ++k) {
+    weight_out[k] = weight_rows[k].data();
+    weight_in[k] = weight_rows[k].data();
+  }
+  for (uint32_t y0 = 0; y0 < height; y0 += kBandRows) {
+    const uint32_t rows = std::min(kBandRows, height - y0);
+    PackedTransform band{};
+    band.crop_y = y0;
+    band.crop_width = width;
+    band.crop_height = rows;
+    for (uint32_t k = 0; k < count; ++k) {
+      if (!copy_retained_cpu_payload_transformed(*payloads[k], band, bands[k].data(), row_bytes * rows)) {
+        return nullptr;
+      }
+    }
+    for (uint32_t r = 0; r < rows; ++r) {
+      expand_exposure_fusion_weight_row(weights, width, height, y0 + r, weight_out.data());
+      for (uint32_t k = 0; k < count; ++k) {
+        band_in[k] = bands[k].data() + r * row_bytes;
+      }
+      blend_weighted_rgba8(band_in.data(), weight_in.data(), count, row_bytes,
+                           fused->bytes.data() + (y0 + r) * row_bytes);
+    }
+  }
+  return fused;
+}
+
+} // namespace
+
+bool can_fuse_capture_exposures(const CoreCaptureResultData& data) noexcept {
+  const uint32_t count = data.image_member_count();
+  if (count < 2 || count > kMaxExposureFusionImages) {
+    return false;
+  }
+  bool has_bracket = false;
+  for (uint32_t k = 0; k < count; ++k) {
+    const CoreCaptureResultData::ImageMemberData& member = *data.image_member_at(k);
+    if (!has_valid_retained_cpu_payload_layout(member.payload) ||
+        member.payload.width != data.default_image.payload.width ||
+        member.payload.height != data.default_image.payload.height) {
+      return false;
+    }
+    has_bracket = has_bracket || member.role == CoreCaptureResultData::ImageMemberRole::ADDITIONAL_BRACKET;
+  }
+  return has_bracket;
+}
+
+std::shared_ptr<const CoreDerivedPayload> obtain_capture_exposure_fusion(const CoreCaptureResultData& data) {
+  const std::shared_ptr<CoreCaptureFusionSlot>& slot = data.exposure_fusion;
+  if (!slot) {
+    return nullptr;
+  }
+  std::unique_lock<std::mutex> lock(slot->mutex);
+  if (slot->state != CoreCaptureFusionSlot::State::PENDING) {
+    slot->done_cv.wait(lock, [&] { return slot->state == CoreCaptureFusionSlot::State::DONE; });
+    return slot->fused;
+  }
+  slot->state = CoreCaptureFusionSlot::State::BUILDING;
+  lock.unlock();
+
+  std::shared_ptr<const CoreDerivedPayload> fused =
+      can_fuse_capture_exposures(data) ? build_exposure_fusion(data) : nullptr;
+
+  lock.lock();
+  slot->fused = fused;
+  slot->state = CoreCaptureFusionSlot::State::DONE;
+  lock.unlock();
+  slot->done_cv.notify_all();
+  return fused;
+}
+
+bool capture_exposure_fusion_done(const CoreCaptureResultData& data) {
+  const std::shared_ptr<CoreCaptureFusionSlot>& slot = data.exposure_fusion;
+  if (!slot) {
+    return false;
+  }
+  std::lock_guard<std::mutex> lock(slot->mutex);
+  return slot->state == CoreCaptureFusionSlot::State::DONE;
+}
+
+CoreCaptureFusionPool::~CoreCaptureFusionPool() {
+  stop();
+}
+
+bool CoreCaptureFusionPool::submit(SharedCaptureResultData data) {
+  if (!data || !data->exposure_fusion) {
+    return false;
+  }
+  {
+    std::lock_guard<std::mutex> lock(mu_);
+    if (queue_.size() >= kMaxQueuedCaptures) {
+      return false;
+    }
+    if (!worker_.joinable()) {
+      stop_requested_ = false;
+      try {
+        worker_ = std::thread([this] { worker_main_(); });
+      } catch (...) {
+        return false;
+      }
+    }
+    queue_.push_back(std::move(data));
+  }
+  work_cv_.notify_one();
+  return true;
+}
+
+void CoreCaptureFusionPool::stop() noexcept {
+  std::deque<SharedCaptureResultData> dropped;
+  {
+    std::lock_guard<std::mutex> lock(mu_);
+    stop_requested_ = true;
+    dropped.swap(queue_);
+  }
+  work_cv_.notify_all();
+  if (worker_.joinable()) {
+    worker_.join();
+  }
+}
+
+void CoreCaptureFusionPool::worker_main_() noexcept {
+  apply_current_thread_policy(CBThreadRole::Background, "cambang-fusion");
+  for (;;) {
+    SharedCaptureResultData data;
+    {
+      std::unique_lock<std::mutex> lock(mu_);
+      work_cv_.wait(lock, [this] { return stop_requested_ || !queue_.empty(); });
+      if (stop_requested_) {
+        return;
+      }
+      data = std::move(queue_.front());
+      queue_.pop_front();
+    }
+    (void)obtain_capture_exposure_fusion(*data);
+  }
+}
+
+} // namespace cambang
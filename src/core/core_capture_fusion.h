@@ -0,0 +1,95 @@
+// src/core/core_capture_fusion.h
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include "core/core_derived_payload.h"
+#include "core/core_result_store.h"
+
+namespace cambang {
+
+// Exposure fusion of bracketed captures (see pixels/fusion/exposure_fusion.h).
+//
+// CoreResultStore::finalize_capture_facts() gives a capture whose members
+// can be fused -- a default member and at least one ADDITIONAL_BRACKET
+// member, every one retaining a valid CPU payload of the same size -- a
+// CoreCaptureFusionSlot, shared by every copy of the capture. CoreRuntime
+// then hands the finalized capture to CoreCaptureFusionPool, which fuses it
+// off the core and main threads. As for thumbnails, whoever reaches the
+// capture first builds the fusion -- the pool worker, or a caller that got
+// there before it -- and later callers wait for that build, then share it.
+//
+// The fusion reads each member twice: once scaled down to
+// kCoarseLongestSide for the weights, then kBandRows rows at a time at full
+// resolution for the blend, so beyond the output it holds only those bands.
+struct CoreCaptureFusionSlot {
+  // Longest side of the level the weights are computed on.
+  static constexpr uint32_t kCoarseLongestSide = 256;
+  static constexpr uint32_t kBandRows = 32;
+
+  enum class State : uint8_t {
+    PENDING = 0,
+    BUILDING,
+    DONE,
+  };
+
+  std::mutex mutex;
+  std::condition_variable done_cv;
+  State state = State::PENDING;
+  // Set once DONE: tightly packed RGBA8 at the members' size, or nullptr
+  // when a payload could not be read.
+  std::shared_ptr<const CoreDerivedPayload> fused;
+};
+
+// True when data's members can be fused (see above).
+bool can_fuse_capture_exposures(const CoreCaptureResultData& data) noexcept;
+
+// The fused image of data: the cached one, or built on this thread if
+// nobody has claimed the build yet, or waited for if somebody has. nullptr
+// when data has no slot or the fusion failed.
+std::shared_ptr<const CoreDerivedPayload> obtain_capture_exposure_fusion(const CoreCaptureResultData& data);
+
+// True once the fusion is DONE, so obtaining it will not wait.
+bool capture_exposure_fusion_done(const CoreCaptureResultData& data);
+
+// Bounded background fuser for finalized captures, kept apart from the
+// thumbnail and encoded-image pools so a fusion never delays either. One
+// worker thread, started on first submit, and at most kMaxQueuedCaptures
+// captures waiting for it; a refused capture stays PENDING and is fused by
+// its first caller instead.
+//
+// Threading: submit() from the core thread; stop() from the owner with no
+// concurrent submit(). stop() drops queued captures (they stay PENDING) and
+// waits for the one in progress.
+class CoreCaptureFusionPool final {
+public:
+  static constexpr size_t kMaxQueuedCaptures = 2;
+
+  CoreCaptureFusionPool() = default;
+  ~CoreCaptureFusionPool();
+
+  CoreCaptureFusionPool(const CoreCaptureFusionPool&) = delete;
+  CoreCaptureFusionPool& operator=(const CoreCaptureFusionPool&) = delete;
+
+  // True when the capture was queued. False if it has no slot, the queue is
+  // full, or the worker could not be started.
+  bool submit(SharedCaptureResultData data);
+  void stop() noexcept;
+
+private:
+  void worker_main_() noexcept;
+
+  std::mutex mu_;
+  std::condition_variable work_cv_;
+  std::deque<SharedCaptureResultData> queue_;
+  bool stop_requested_ = false;
+  std::thread worker_;
+};
+
+} // namespace cambang
@@ -0,0 +1,48 @@
+// src/core/core_capture_latency_stats.cpp
+
+#include "core/core_capture_latency_stats.h"
+
+#include "core/core_registry_revision.h"
+
+namespace cambang {
+
+void CoreCaptureLatencyStats::record_device(uint64_t device_instance_id, Metric metric, uint64_t value_ns) {
+  if (device_instance_id == 0) {
+    return;
+  }
+  revision_ = next_core_registry_revision();
+  devices_[device_instance_id].metrics[static_cast<size_t>(metric)].record(value_ns);
+}
+
+void CoreCaptureLatencyStats::record_rig(uint64_t rig_id, Metric metric, uint64_t value_ns) {
+  if (rig_id == 0) {
+    return;
+  }
+  revision_ = next_core_registry_revision();
+  rigs_[rig_id].metrics[static_cast<size_t>(metric)].record(value_ns);
+}
+
+const CoreCaptureLatencyStats::Histograms* CoreCaptureLatencyStats::device(
+    uint64_t device_instance_id) const noexcept {
+  const auto it = devices_.find(device_instance_id);
+  return it == devices_.end() ? nullptr : &it->second;
+}
+
+const CoreCaptureLatencyStats::Histograms* CoreCaptureLatencyStats::rig(uint64_t rig_id) const noexcept {
+  const auto it = rigs_.find(rig_id);
+  return it == rigs_.end() ? nullptr : &it->second;
+}
+
+void CoreCaptureLatencyStats::forget_device(uint64_t device_instance_id) {
+  if (devices_.erase(device_instance_id) != 0) {
+    revision_ = next_core_registry_revision();
+  }
+}
+
+void CoreCaptureLatencyStats::clear() noexcept {
+  devices_.clear();
+  rigs_.clear();
+  revision_ = next_core_registry_revision();
+}
+
+} // namespace cambang
@@ -0,0 +1,68 @@
+// src/core/core_capture_latency_stats.h
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+
+#include "core/core_hdr_histogram.h"
+
+namespace cambang {
+
+// Streaming latency histograms for completed still captures, kept per device
+// instance and per rig.
+//
+// Stages of one device's capture (Core steady clock):
+//   Admission      trigger request entered Core -> provider accepted it
+//   ProviderStart  accepted -> capture-started fact ingested
+//   ImageArrival   started -> default image ingested
+//   Finalization   default image -> capture-completed fact ingested
+//   Capture        trigger -> completed (end to end)
+// A rig keeps the same stages over its members' captures, except that its
+// Capture runs to the last member's completion, plus SyncSkew: the spread of
+// the members' capture-started ingest times. Failed captures are not
+// recorded.
+//
+// Threading: core thread only.
+class CoreCaptureLatencyStats final {
+public:
+  enum class Metric : uint8_t {
+    Admission = 0,
+    ProviderStart = 1,
+    ImageArrival = 2,
+    Finalization = 3,
+    Capture = 4,
+    SyncSkew = 5,
+  };
+  static constexpr size_t kMetricCount = 6;
+
+  struct Histograms {
+    std::array<CoreHdrHistogram, kMetricCount> metrics{};
+
+    const CoreHdrHistogram& operator[](Metric m) const noexcept {
+      return metrics[static_cast<size_t>(m)];
+    }
+  };
+
+  void record_device(uint64_t device_instance_id, Metric metric, uint64_t value_ns);
+  void record_rig(uint64_t rig_id, Metric metric, uint64_t value_ns);
+
+  // Null when nothing was recorded for the id since the last reset.
+  const Histograms* device(uint64_t device_instance_id) const noexcept;
+  const Histograms* rig(uint64_t rig_id) const noexcept;
+
+  void forget_device(uint64_t device_instance_id);
+  // Drops every histogram (reset_capture_latency_histograms(), runtime start).
+  void clear() noexcept;
+
+  // Snapshot dirty-tracking stamp (see core_registry_revision.h).
+  uint64_t revision() const noexcept { return revision_; }
+
+private:
+  std::map<uint64_t, Histograms> devices_;
+  std::map<uint64_t, Histograms> rigs_;
+  uint64_t revision_ = 0;
+};
+
+} // namespace cambang
@@ -0,0 +1,568 @@
+// src/core/core_capture_spill_store.cpp
+#include "core/core_capture_spill_store.h"
+
+#include "imaging/api/thread_policy.h"
+#include "pixels/encode/lz_block.h"
+
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <limits>
+#include <string>
+#include <system_error>
+
+#if defined(_WIN32)
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#include <sddl.h>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <unistd.h>
+#endif
+
+namespace cambang {
+
+namespace {
+
+constexpr char kSpillDirectoryPrefix[] = "cambang-capture-spill-";
+
+uint64_t current_process_id() noexcept {
+#if defined(_WIN32)
+  return static_cast<uint64_t>(GetCurrentProcessId());
+#else
+  return static_cast<uint64_t>(::getpid());
+#endif
+}
+
+// True when pid may still be running (a process we may not inspect counts
+// as running, so its directory is left alone).
+bool process_running(uint64_t pid) noexcept {
+#if defined(_WIN32)
+  HANDLE h = OpenProcess(PROCESS_QUERY_LIMITED_INFORMATION, FALSE, static_cast<DWORD>(pid));
+  if (!h) {
+    return GetLastError() == ERROR_ACCESS_DENIED;
+  }
+  DWORD code = 0;
+  const bool running = GetExitCodeProcess(h, &code) && code == STILL_ACTIVE;
+  CloseHandle(h);
+  return running;
+#else
+  if (pid == 0 || pid > static_cast<uint64_t>(std::numeric_limits<pid_t>::max())) {
+    return false;
+  }
+  return ::kill(static_cast<pid_t>(pid), 0) == 0 || errno == EPERM;
+#endif
+}
+
+// Creates dir readable by its owner only. False if it exists or cannot be
+// created.
+bool create_owner_only_directory(const std::filesystem::path& dir) noexcept {
+#if defined(_WIN32)
+  // Protected DACL granting the owner full access, inherited by the files.
+  PSECURITY_DESCRIPTOR descriptor = nullptr;
+  if (!ConvertStringSecurityDescriptorToSecurityDescriptorW(
+          L"D:P(A;OICI;FA;;;OW)", SDDL_REVISION_1, &descriptor, nullptr)) {
+    return false;
+  }
+  SECURITY_ATTRIBUTES attributes{};
+  attributes.nLength = sizeof(attributes);
+  attributes.lpSecurityDescriptor = descriptor;
+  attributes.bInheritHandle = FALSE;
+  const bool created = CreateDirectoryW(dir.c_str(), &attributes) != 0;
+  LocalFree(descriptor);
+  return created;
+#else
+  if (::mkdir(dir.c_str(), 0700) != 0) {
+    return false;
+  }
+  // mkdir's mode is narrowed by the umask, never widened; this only pins it.
+  std::error_code ec;
+  std::filesystem::permissions(dir, std::filesystem::perms::owner_all, std::filesystem::perm_options::replace, ec);
+  return true;
+#endif
+}
+
+SharedCaptureResultData read_spilled_result(const SharedCaptureResultData& skeleton,
+                                            const std::filesystem::path& path,
+                                            const std::vector<size_t>& member_bytes) noexcept try {
+  std::ifstream in(path, std::ios::in | std::ios::binary);
+  if (!in) {
+    return nullptr;
+  }
+  auto result = std::make_shared<CoreCaptureResultData>(*skeleton);
+  for (uint32_t i = 0; i < result->image_member_count(); ++i) {
+    auto bytes = std::make_shared<CpuPayloadBytes>(member_bytes[i]);
+    if (!in.read(reinterpret_cast<char*>(bytes->data()), static_cast<std::streamsize>(bytes->size()))) {
+      return nullptr;
+    }
+    result->image_member_at(i)->payload.retained_bytes = std::move(bytes);
+  }
+  return result;
+} catch (...) {
+  return nullptr;
+}
+
+SharedCaptureResultData inflate_spilled_result(const SharedCaptureResultData& skeleton,
+                                               const std::vector<uint8_t>& compressed,
+                                               const std::vector<size_t>& member_bytes,
+                                               const std::vector<size_t>& member_compressed_bytes) noexcept try {
+  auto result = std::make_shared<CoreCaptureResultData>(*skeleton);
+  size_t at = 0;
+  for (uint32_t i = 0; i < result->image_member_count(); ++i) {
+    auto bytes = std::make_shared<CpuPayloadBytes>(member_bytes[i]);
+    if (member_compressed_bytes[i] > compressed.size() - at ||
+        !lz_block_decompress(compressed.data() + at, member_compressed_bytes[i], bytes->data(), bytes->size())) {
+      return nullptr;
+    }
+    at += member_compressed_bytes[i];
+    result->image_member_at(i)->payload.retained_bytes = std::move(bytes);
+  }
+  return result;
+} catch (...) {
+  return nullptr;
+}
+
+// False when the members do not compress smaller than they are.
+bool compress_spilled_result(const CoreCaptureResultData& result,
+                             std::shared_ptr<const std::vector<uint8_t>>& out,
+                             std::vector<size_t>& member_compressed_bytes) noexcept try {
+  auto compressed = std::make_shared<std::vector<uint8_t>>();
+  uint64_t raw_bytes = 0;
+  for (uint32_t i = 0; i < result.image_member_count(); ++i) {
+    const CoreResultPayloadCpuPacked& payload = result.image_member_at(i)->payload;
+    const size_t before = compressed->size();
+    lz_block_compress(payload.data(), payload.size_bytes(), *compressed);
+    member_compressed_bytes.push_back(compressed->size() - before);
+    raw_bytes += payload.size_bytes();
+  }
+  if (compressed->size() >= raw_bytes) {
+    return false;
+  }
+  compressed->shrink_to_fit();
+  out = std::move(compressed);
+  return true;
+} catch (...) {
+  return false;
+}
+
+bool write_spilled_result(const CoreCaptureResultData& result, const std::filesystem::path& path) noexcept {
+#if defined(_WIN32)
+  // The file inherits the directory's owner-only ACL.
+  std::ofstream out(path, std::ios::out | std::ios::binary | std::ios::trunc);
+  if (!out) {
+    return false;
+  }
+  for (uint32_t i = 0; i < result.image_member_count(); ++i) {
+    const CoreResultPayloadCpuPacked& payload = result.image_member_at(i)->payload;
+    out.write(reinterpret_cast<const char*>(payload.data()), static_cast<std::streamsize>(payload.size_bytes()));
+  }
+  out.close();
+  return static_cast<bool>(out);
+#else
+  const int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_EXCL | O_CLOEXEC, 0600);
+  if (fd < 0) {
+    return false;
+  }
+  bool ok = true;
+  for (uint32_t i = 0; ok && i < result.image_member_count(); ++i) {
+    const CoreResultPayloadCpuPacked& payload = result.image_member_at(i)->payload;
+    const uint8_t* p = payload.data();
+    size_t left = payload.size_bytes();
+    while (left > 0) {
+      const ssize_t n = ::write(fd, p, left);
+      if (n < 0 && errno == EINTR) {
+        continue;
+      }
+      if (n <= 0) {
+        ok = false;
+        break;
+      }
+      p += n;
+      left -= static_cast<size_t>(n);
+    }
+  }
+  return ::close(fd) == 0 && ok;
+#endif
+}
+
+} // namespace
+
+CoreCaptureSpillStore::~CoreCaptureSpillStore() {
+  clear();
+}
+
+bool CoreCaptureSpillStore::is_spillable_(const CoreCaptureResultData& result) noexcept {
+  for (uint32_t i = 0; i < result.image_member_count(); ++i) {
+    const CoreCaptureResultData::ImageMemberData& member = *result.image_member_at(i);
+    if (!is_cpu_payload_kind(member.payload_kind) || member.retained_gpu_backing ||
+        !has_valid_retained_cpu_payload_layout(member.payload)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool CoreCaptureSpillStore::ensure_directory_locked_() {
+  if (!directory_.empty() || directory_unavailable_) {
+    return !directory_.empty();
+  }
+  if (!base_directory_.empty()) {
+    std::error_code ec;
+    if (!std::filesystem::exists(base_directory_, ec) && !ec) {
+      // A base we create is owner-only as well; an existing one is left as
+      // the caller set it up.
+      std::filesystem::create_directories(base_directory_.parent_path(), ec);
+      ec.clear();
+      (void)create_owner_only_directory(base_directory_);
+    }
+    char name[96];
+    std::snprintf(name,
+                  sizeof(name),
+                  "%s%llu-%llx-%llx",
+                  kSpillDirectoryPrefix,
+                  static_cast<unsigned long long>(current_process_id()),
+                  static_cast<unsigned long long>(
+                      std::chrono::steady_clock::now().time_since_epoch().count()),
+                  static_cast<unsigned long long>(reinterpret_cast<uintptr_t>(this)));
+    std::filesystem::path dir = base_directory_ / name;
+    if (create_owner_only_directory(dir)) {
+      directory_ = std::move(dir);
+      return true;
+    }
+  }
+  directory_unavailable_ = true;
+  return false;
+}
+
+size_t CoreCaptureSpillStore::sweep_stale_directories(const std::filesystem::path& base) noexcept try {
+  if (base.empty()) {
+    return 0;
+  }
+  const std::string prefix = kSpillDirectoryPrefix;
+  const uint64_t self = current_process_id();
+  std::vector<std::filesystem::path> stale;
+  std::error_code ec;
+  for (std::filesystem::directory_iterator it(base, ec), end; !ec && it != end; it.increment(ec)) {
+    const std::string name = it->path().filename().string();
+    if (name.compare(0, prefix.size(), prefix) != 0 || !it->is_directory(ec)) {
+      continue;
+    }
+    uint64_t pid = 0;
+    size_t at = prefix.size();
+    while (at < name.size() && name[at] >= '0' && name[at] <= '9') {
+      pid = pid * 10 + static_cast<uint64_t>(name[at] - '0');
+      ++at;
+    }
+    if (at == prefix.size() || at >= name.size() || name[at] != '-') {
+      continue;
+    }
+    if (pid != self && !process_running(pid)) {
+      stale.push_back(it->path());
+    }
+  }
+  size_t removed = 0;
+  for (const std::filesystem::path& dir : stale) {
+    std::error_code remove_ec;
+    if (std::filesystem::remove_all(dir, remove_ec) != static_cast<std::uintmax_t>(-1) && !remove_ec) {
+      ++removed;
+    }
+  }
+  return removed;
+} catch (...) {
+  return 0;
+}
+
+void CoreCaptureSpillStore::erase_locked_(std::map<Key, Entry>::iterator it,
+                                          std::vector<SharedCaptureResultData>& released) {
+  Entry& entry = it->second;
+  total_bytes_ = entry.bytes <= total_bytes_ ? total_bytes_ - entry.bytes : 0;
+  if (entry.pending) {
+    // The worker removes the file of a write it finds orphaned.
+    released.push_back(std::move(entry.pending));
+  } else if (!entry.path.empty()) {
+    std::error_code ec;
+    std::filesystem::remove(entry.path, ec);
+  }
+  entries_.erase(it);
+}
+
+void CoreCaptureSpillStore::evict_to_fit_locked_(uint64_t incoming_bytes,
+                                                 std::vector<SharedCaptureResultData>& released) {
+  while (!entries_.empty() && total_bytes_ + incoming_bytes > byte_budget_) {
+    auto oldest = entries_.begin();
+    for (auto it = entries_.begin(); it != entries_.end(); ++it) {
+      if (it->second.last_use < oldest->second.last_use) {
+        oldest = it;
+      }
+    }
+    erase_locked_(oldest, released);
+  }
+}
+
+bool CoreCaptureSpillStore::spill(SharedCaptureResultData result) {
+  if (!result || !is_spillable_(*result)) {
+    return false;
+  }
+  {
+    std::lock_guard<std::mutex> lock(mu_);
+    if (medium_ == Medium::OFF) {
+      return false;
+    }
+  }
+  std::vector<size_t> member_bytes;
+  member_bytes.reserve(result->image_member_count());
+  uint64_t bytes = 0;
+  auto skeleton = std::make_shared<CoreCaptureResultData>(*result);
+  for (uint32_t i = 0; i < skeleton->image_member_count(); ++i) {
+    CoreResultPayloadCpuPacked& payload = skeleton->image_member_at(i)->payload;
+    member_bytes.push_back(payload.size_bytes());
+    bytes += payload.size_bytes();
+    payload.bytes = {};
+    payload.retained_bytes.reset();
+  }
+  if (bytes > byte_budget_) {
+    return false;
+  }
+
+  std::vector<SharedCaptureResultData> released;
+  {
+    std::lock_guard<std::mutex> lock(mu_);
+    if (medium_ == Medium::OFF || write_queue_.size() >= kMaxQueuedWrites ||
+        (medium_ == Medium::TEMP_FILE && !ensure_directory_locked_())) {
+      return false;
+    }
+    if (!worker_.joinable()) {
+      stop_requested_ = false;
+      try {
+        worker_ = std::thread([this] { worker_main_(); });
+      } catch (...) {
+        return false;
+      }
+    }
+    const Key key{result->capture_id, result->device_instance_id};
+    if (const auto existing = entries_.find(key); existing != entries_.end()) {
+      erase_locked_(existing, released);
+    }
+    evict_to_fit_locked_(bytes, released);
+
+    Entry entry{};
+    entry.last_use = ++use_clock_;
+    if (medium_ == Medium::TEMP_FILE) {
+      char name[80];
+      std::snprintf(name,
+                    sizeof(name),
+                    "%llu-%llu-%llu.bin",
+                    static_cast<unsigned long long>(key.first),
+                    static_cast<unsigned long long>(key.second),
+                    static_cast<unsigned long long>(entry.last_use));
+      entry.path = directory_ / name;
+    }
+    entry.skeleton = std::move(skeleton);
+    entry.pending = std::move(result);
+    entry.member_bytes = std::move(member_bytes);
+    entry.bytes = bytes;
+    entries_.emplace(key, std::move(entry));
+    write_queue_.push_back(key);
+    total_bytes_ += bytes;
+  }
+  work_cv_.notify_one();
+  return true;
+}
+
+SharedCaptureResultData CoreCaptureSpillStore::load_locked_(std::unique_lock<std::mutex>& lock,
+                                                           std::map<Key, Entry>::iterator it) {
+  Entry& entry = it->second;
+  entry.last_use = ++use_clock_;
+  if (entry.pending) {
+    return entry.pending;
+  }
+  if (SharedCaptureResultData reloaded = entry.reloaded.lock()) {
+    return reloaded;
+  }
+  const Key key = it->first;
+  const SharedCaptureResultData skeleton = entry.skeleton;
+  const std::filesystem::path path = entry.path;
+  const std::shared_ptr<const std::vector<uint8_t>> compressed = entry.compressed;
+  const std::vector<size_t> member_bytes = entry.member_bytes;
+  const std::vector<size_t> member_compressed_bytes = entry.member_compressed_bytes;
+
+  // The read runs unlocked: other loads and the core thread's spills proceed.
+  lock.unlock();
+  SharedCaptureResultData result =
+      compressed ? inflate_spilled_result(skeleton, *compressed, member_bytes, member_compressed_bytes)
+                 : read_spilled_result(skeleton, path, member_bytes);
+  lock.lock();
+
+  const auto again = entries_.find(key);
+  if (again == entries_.end() || again->second.skeleton != skeleton) {
+    return result;
+  }
+  if (!result) {
+    std::vector<SharedCaptureResultData> released;
+    erase_locked_(again, released);
+    return nullptr;
+  }
+  if (SharedCaptureResultData raced = again->second.reloaded.lock()) {
+    return raced;
+  }
+  again->second.reloaded = result;
+  return result;
+}
+
+SharedCaptureResultData CoreCaptureSpillStore::load(uint64_t capture_id, uint64_t device_instance_id) {
+  std::unique_lock<std::mutex> lock(mu_);
+  const auto it = entries_.find(Key{capture_id, device_instance_id});
+  if (it == entries_.end()) {
+    return nullptr;
+  }
+  return load_locked_(lock, it);
+}
+
+std::vector<SharedCaptureResultData> CoreCaptureSpillStore::load_capture_set(uint64_t capture_id) {
+  std::vector<uint64_t> device_instance_ids;
+  {
+    std::lock_guard<std::mutex> lock(mu_);
+    for (auto it = entries_.lower_bound(Key{capture_id, 0});
+         it != entries_.end() && it->first.first == capture_id;
+         ++it) {
+      device_instance_ids.push_back(it->first.second);
+    }
+  }
+  std::vector<SharedCaptureResultData> out;
+  out.reserve(device_instance_ids.size());
+  for (const uint64_t device_instance_id : device_instance_ids) {
+    if (SharedCaptureResultData result = load(capture_id, device_instance_id)) {
+      out.push_back(std::move(result));
+    }
+  }
+  return out;
+}
+
+void CoreCaptureSpillStore::remove(uint64_t capture_id, uint64_t device_instance_id) {
+  std::vector<SharedCaptureResultData> released;
+  std::lock_guard<std::mutex> lock(mu_);
+  const auto it = entries_.find(Key{capture_id, device_instance_id});
+  if (it != entries_.end()) {
+    erase_locked_(it, released);
+  }
+}
+
+void CoreCaptureSpillStore::set_medium(Medium medium,
+                                       uint64_t byte_budget,
+                                       std::filesystem::path directory) noexcept {
+  clear();
+  if (medium == Medium::TEMP_FILE) {
+    (void)sweep_stale_directories(directory);
+  }
+  std::lock_guard<std::mutex> lock(mu_);
+  medium_ = medium;
+  byte_budget_ = byte_budget;
+  base_directory_ = medium == Medium::TEMP_FILE ? std::move(directory) : std::filesystem::path{};
+  directory_unavailable_ = false;
+}
+
+CoreCaptureSpillStore::Medium CoreCaptureSpillStore::medium() const noexcept {
+  std::lock_guard<std::mutex> lock(mu_);
+  return medium_;
+}
+
+void CoreCaptureSpillStore::clear() noexcept {
+  stop_worker_();
+  std::map<Key, Entry> dropped;
+  std::lock_guard<std::mutex> lock(mu_);
+  dropped.swap(entries_);
+  write_queue_.clear();
+  total_bytes_ = 0;
+  if (!directory_.empty()) {
+    std::error_code ec;
+    std::filesystem::remove_all(directory_, ec);
+    directory_.clear();
+  }
+}
+
+uint64_t CoreCaptureSpillStore::total_spilled_bytes() const {
+  std::lock_guard<std::mutex> lock(mu_);
+  return total_bytes_;
+}
+
+size_t CoreCaptureSpillStore::spilled_result_count() const {
+  std::lock_guard<std::mutex> lock(mu_);
+  return entries_.size();
+}
+
+void CoreCaptureSpillStore::stop_worker_() noexcept {
+  {
+    std::lock_guard<std::mutex> lock(mu_);
+    stop_requested_ = true;
+  }
+  work_cv_.notify_all();
+  if (worker_.joinable()) {
+    worker_.join();
+  }
+}
+
+void CoreCaptureSpillStore::worker_main_() noexcept {
+  apply_current_thread_policy(CBThreadRole::Background, "cambang-spill");
+  for (;;) {
+    SharedCaptureResultData pending;
+    std::filesystem::path path;
+    Key key{};
+    {
+      std::unique_lock<std::mutex> lock(mu_);
+      work_cv_.wait(lock, [this] { return stop_requested_ || !write_queue_.empty(); });
+      if (stop_requested_) {
+        return;
+      }
+      key = write_queue_.front();
+      write_queue_.pop_front();
+      const auto it = entries_.find(key);
+      if (it == entries_.end() || !it->second.pending) {
+        continue;
+      }
+      pending = it->second.pending;
+      path = it->second.path;
+    }
+
+    // No path: COMPRESSED_MEMORY.
+    std::shared_ptr<const std::vector<uint8_t>> compressed;
+    std::vector<size_t> member_compressed_bytes;
+    const bool written = path.empty()
+        ? compress_spilled_result(*pending, compressed, member_compressed_bytes)
+        : write_spilled_result(*pending, path);
+
+    std::vector<SharedCaptureResultData> released;
+    std::lock_guard<std::mutex> lock(mu_);
+    const auto it = entries_.find(key);
+    if (it != entries_.end() && it->second.pending == pending) {
+      if (written) {
+        Entry& entry = it->second;
+        if (compressed) {
+          // The budget counts what the tier now holds.
+          total_bytes_ -= entry.bytes - compressed->size();
+          entry.bytes = compressed->size();
+          entry.compressed = std::move(compressed);
+          entry.member_compressed_bytes = std::move(member_compressed_bytes);
+        }
+        // The payload bytes go with the last reference, after the unlock.
+        released.push_back(std::move(entry.pending));
+        continue;
+      }
+      erase_locked_(it, released);
+    }
+    if (!path.empty()) {
+      std::error_code ec;
+      std::filesystem::remove(path, ec);
+    }
+  }
+}
+
+} // namespace cambang
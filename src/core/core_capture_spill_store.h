@@ -0,0 +1,145 @@
+// src/core/core_capture_spill_store.h
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "core/core_result_store.h"
+
+namespace cambang {
+
+// Second retention tier for capture results evicted by
+// CoreResultStore::evict_over_byte_budget().
+//
+// An evicted result whose every image member is a CPU payload (no GPU
+// backing) keeps its metadata here in memory while a background I/O thread
+// writes its member payload bytes to a spill file; once written the bytes are
+// released. load() answers for a spilled result: straight from memory while
+// the write is still queued, otherwise by reading the file back into a fresh
+// result on the calling thread, never the core thread. The reloaded result is
+// remembered while any caller holds it, so repeated loads share one copy.
+//
+// The tier has its own byte budget over spilled payload bytes: spilling past
+// it drops the least recently spilled-or-loaded results first, and a result
+// larger than the whole budget is not spilled. Results still leave with their
+// capture assembly (time-based retirement calls remove()).
+//
+// The tier is off (Medium::OFF) until set_medium() selects a medium; an off
+// tier spills nothing, which is the single-tier behaviour.
+//
+// Medium::TEMP_FILE writes raw capture pixels, so it needs a directory from
+// the caller: spill files live in a per-instance
+// "cambang-capture-spill-<pid>-..." directory under it, created on first
+// spill owner-only (0700 directory and 0600 files on POSIX; an owner-only,
+// inherited ACL on Windows) and removed by clear()/the destructor. A crashed
+// process leaves its directory behind; set_medium() sweeps such directories
+// (whose process is gone) from the base directory. Without a directory, or
+// when it cannot be created, nothing is spilled.
+//
+// Medium::COMPRESSED_MEMORY keeps the payload bytes in memory instead,
+// compressed by the same background thread (lz_block.h), and counts the
+// compressed bytes against the budget. It needs no directory and reloads
+// without I/O. A result that does not compress smaller is dropped rather than
+// held at full size.
+//
+// Threading: spill()/remove()/clear()/set_medium() from the core thread (or
+// the owner with the core thread stopped); load()/load_capture_set() from any
+// thread.
+class CoreCaptureSpillStore final {
+public:
+  enum class Medium : uint8_t {
+    OFF,
+    TEMP_FILE,
+    COMPRESSED_MEMORY,
+  };
+
+  static constexpr uint64_t kDefaultByteBudget = 2048ull * 1024ull * 1024ull; // 2 GiB
+  // Results waiting for their write still hold their payload bytes, so the
+  // queue is short; a result refused because it is full is not spilled.
+  static constexpr size_t kMaxQueuedWrites = 8;
+
+  explicit CoreCaptureSpillStore(uint64_t byte_budget = kDefaultByteBudget) noexcept
+      : byte_budget_(byte_budget) {}
+  ~CoreCaptureSpillStore();
+
+  CoreCaptureSpillStore(const CoreCaptureSpillStore&) = delete;
+  CoreCaptureSpillStore& operator=(const CoreCaptureSpillStore&) = delete;
+
+  // Drops every spilled result (as clear()), then holds later ones on medium
+  // within byte_budget. TEMP_FILE spills under `directory` (see above) and
+  // first sweeps stale spill directories from it; other media ignore it.
+  void set_medium(Medium medium, uint64_t byte_budget, std::filesystem::path directory = {}) noexcept;
+  Medium medium() const noexcept;
+
+  // Removes every "cambang-capture-spill-<pid>-..." directory under base
+  // whose process no longer runs. Returns how many were removed.
+  static size_t sweep_stale_directories(const std::filesystem::path& base) noexcept;
+
+  // True when result is now held by this tier.
+  bool spill(SharedCaptureResultData result);
+  SharedCaptureResultData load(uint64_t capture_id, uint64_t device_instance_id);
+  // Every spilled result of capture_id, ascending device_instance_id.
+  std::vector<SharedCaptureResultData> load_capture_set(uint64_t capture_id);
+  void remove(uint64_t capture_id, uint64_t device_instance_id);
+  // Drops every spilled result, waits for an in-progress write and removes
+  // the spill directory.
+  void clear() noexcept;
+
+  uint64_t total_spilled_bytes() const;
+  size_t spilled_result_count() const;
+
+private:
+  using Key = std::pair<uint64_t, uint64_t>; // (capture_id, device_instance_id)
+
+  struct Entry {
+    // The result with its member payload bytes stripped.
+    SharedCaptureResultData skeleton;
+    // The complete result until its file is written.
+    SharedCaptureResultData pending;
+    std::weak_ptr<const CoreCaptureResultData> reloaded;
+    // TEMP_FILE: the spill file. COMPRESSED_MEMORY: every member's block,
+    // back to back, once compressed.
+    std::filesystem::path path;
+    std::shared_ptr<const std::vector<uint8_t>> compressed;
+    std::vector<size_t> member_bytes;
+    std::vector<size_t> member_compressed_bytes;
+    uint64_t bytes = 0;
+    uint64_t last_use = 0;
+  };
+
+  static bool is_spillable_(const CoreCaptureResultData& result) noexcept;
+  bool ensure_directory_locked_();
+  // Both hand results whose payload bytes may die with them to `released`,
+  // for the caller to drop after unlocking.
+  void evict_to_fit_locked_(uint64_t incoming_bytes, std::vector<SharedCaptureResultData>& released);
+  void erase_locked_(std::map<Key, Entry>::iterator it, std::vector<SharedCaptureResultData>& released);
+  SharedCaptureResultData load_locked_(std::unique_lock<std::mutex>& lock, std::map<Key, Entry>::iterator it);
+  void stop_worker_() noexcept;
+  void worker_main_() noexcept;
+
+  uint64_t byte_budget_;
+  Medium medium_ = Medium::OFF;
+  // Caller-supplied parent of directory_ (TEMP_FILE).
+  std::filesystem::path base_directory_;
+  mutable std::mutex mu_;
+  std::condition_variable work_cv_;
+  std::map<Key, Entry> entries_;
+  std::deque<Key> write_queue_;
+  uint64_t total_bytes_ = 0;
+  uint64_t use_clock_ = 0;
+  std::filesystem::path directory_;
+  bool directory_unavailable_ = false;
+  bool stop_requested_ = false;
+  std::thread worker_;
+};
+
+} // namespace cambang
@@ -0,0 +1,188 @@
+// src/core/core_capture_thumbnails.cpp
+#include "core/core_capture_thumbnails.h"
+
+#include <algorithm>
+
+#include "imaging/api/thread_policy.h"
+
+namespace cambang {
+
+namespace {
+
+// Output size of the level with longest side `side` of a width x height
+// image, keeping its aspect ratio.
+void level_size(uint32_t width, uint32_t height, uint32_t side, uint32_t& out_width, uint32_t& out_height) noexcept {
+  const uint64_t w = width;
+  const uint64_t h = height;
+  if (w >= h) {
+    out_width = side;
+    out_height = static_cast<uint32_t>(std::max<uint64_t>(1, (h * side + w / 2) / w));
+  } else {
+    out_height = side;
+    out_width = static_cast<uint32_t>(std::max<uint64_t>(1, (w * side + h / 2) / h));
+  }
+}
+
+std::shared_ptr<const CoreCaptureThumbnails> build_member_thumbnails(
+    const CoreCaptureResultData::ImageMemberData& member) noexcept try {
+  const CoreResultPayloadCpuPacked& payload = member.payload;
+  if (!has_valid_retained_cpu_payload_layout(payload)) {
+    return nullptr;
+  }
+  const uint32_t longest = std::max(payload.width, payload.height);
+  auto thumbnails = std::make_shared<CoreCaptureThumbnails>();
+  uint32_t prior_side = 0;
+  for (const uint32_t level_side : CoreCaptureThumbnails::kLevelLongestSides) {
+    const uint32_t side = std::min(level_side, longest);
+    if (side == prior_side) {
+      continue;
+    }
+    prior_side = side;
+    PackedTransform transform{};
+    level_size(payload.width, payload.height, side, transform.target_width, transform.target_height);
+    auto level = std::make_shared<CoreDerivedPayload>();
+    level->output = PackedTransformOutput::RGBA8;
+    level->width = transform.target_width;
+    level->height = transform.target_height;
+    level->stride_bytes = level->width * 4u;
+    level->bytes.resize(static_cast<size_t>(level->stride_bytes) * level->height);
+
+    if (thumbnails->levels.empty()) {
+      if (!copy_retained_cpu_payload_transformed(payload, transform, level->bytes.data(), level->bytes.size())) {
+        return nullptr;
+      }
+    } else {
+      // Downscale the level before, not the full-resolution payload.
+      const CoreDerivedPayload& prior = *thumbnails->levels.back();
+      transform.target_width = std::min(transform.target_width, prior.width);
+      transform.target_height = std::min(transform.target_height, prior.height);
+      PackedTransformGeometry geometry{};
+      if (!resolve_packed_transform(transform, prior.width, prior.height, geometry)) {
+        return nullptr;
+      }
+      level->width = geometry.width;
+      level->height = geometry.height;
+      level->stride_bytes = geometry.width * 4u;
+      level->bytes.resize(geometry.tight_size_bytes());
+      apply_packed_transform_rows(transform,
+                                  geometry,
+                                  prior.bytes.data(),
+                                  prior.stride_bytes,
+                                  0,
+                                  /*bgra_source=*/false,
+                                  0,
+                                  geometry.height,
+                                  level->bytes.data(),
+                                  level->stride_bytes);
+    }
+    thumbnails->levels.push_back(std::move(level));
+  }
+  return thumbnails;
+} catch (...) {
+  return nullptr;
+}
+
+} // namespace
+
+const CoreDerivedPayload* CoreCaptureThumbnails::level_for(uint32_t longest_side) const noexcept {
+  const CoreDerivedPayload* chosen = nullptr;
+  for (const auto& level : levels) {
+    if (!chosen || std::max(level->width, level->height) >= longest_side) {
+      chosen = level.get();
+    }
+  }
+  return chosen;
+}
+
+std::shared_ptr<const CoreCaptureThumbnails> obtain_capture_member_thumbnails(
+    const CoreCaptureResultData::ImageMemberData& member) {
+  const std::shared_ptr<CoreCaptureThumbnailSlot>& slot = member.thumbnails;
+  if (!slot) {
+    return nullptr;
+  }
+  std::unique_lock<std::mutex> lock(slot->mutex);
+  if (slot->state != CoreCaptureThumbnailSlot::State::PENDING) {
+    slot->done_cv.wait(lock, [&] { return slot->state == CoreCaptureThumbnailSlot::State::DONE; });
+    return slot->thumbnails;
+  }
+  slot->state = CoreCaptureThumbnailSlot::State::BUILDING;
+  lock.unlock();
+
+  std::shared_ptr<const CoreCaptureThumbnails> thumbnails = build_member_thumbnails(member);
+
+  lock.lock();
+  slot->thumbnails = thumbnails;
+  slot->state = CoreCaptureThumbnailSlot::State::DONE;
+  lock.unlock();
+  slot->done_cv.notify_all();
+  return thumbnails;
+}
+
+CoreCaptureThumbnailPool::~CoreCaptureThumbnailPool() {
+  stop();
+}
+
+bool CoreCaptureThumbnailPool::submit(SharedCaptureResultData data) {
+  if (!data) {
+    return false;
+  }
+  bool has_slot = false;
+  for (uint32_t i = 0; i < data->image_member_count(); ++i) {
+    has_slot = has_slot || static_cast<bool>(data->image_member_at(i)->thumbnails);
+  }
+  if (!has_slot) {
+    return false;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(mu_);
+    if (queue_.size() >= kMaxQueuedCaptures) {
+      return false;
+    }
+    if (!worker_.joinable()) {
+      stop_requested_ = false;
+      try {
+        worker_ = std::thread([this] { worker_main_(); });
+      } catch (...) {
+        return false;
+      }
+    }
+    queue_.push_back(std::move(data));
+  }
+  work_cv_.notify_one();
+  return true;
+}
+
+void CoreCaptureThumbnailPool::stop() noexcept {
+  std::deque<SharedCaptureResultData> dropped;
+  {
+    std::lock_guard<std::mutex> lock(mu_);
+    stop_requested_ = true;
+    dropped.swap(queue_);
+  }
+  work_cv_.notify_all();
+  if (worker_.joinable()) {
+    worker_.join();
+  }
+}
+
+void CoreCaptureThumbnailPool::worker_main_() noexcept {
+  apply_current_thread_policy(CBThreadRole::Background, "cambang-thumbs");
+  for (;;) {
+    SharedCaptureResultData data;
+    {
+      std::unique_lock<std::mutex> lock(mu_);
+      work_cv_.wait(lock, [this] { return stop_requested_ || !queue_.empty(); });
+      if (stop_requested_) {
+        return;
+      }
+      data = std::move(queue_.front());
+      queue_.pop_front();
+    }
+    for (uint32_t i = 0; i < data->image_member_count(); ++i) {
+      (void)obtain_capture_member_thumbnails(*data->image_member_at(i));
+    }
+  }
+}
+
+} // namespace cambang
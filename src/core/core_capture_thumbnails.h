@@ -0,0 +1,102 @@
+// src/core/core_capture_thumbnails.h
+#pragma once
+
+#include <array>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "core/core_derived_payload.h"
+#include "core/core_result_store.h"
+
+namespace cambang {
+
+// Thumbnail pyramids for retained capture image members.
+//
+// CoreResultStore::finalize_capture_facts() gives every capture member that
+// retains a valid CPU payload a CoreCaptureThumbnailSlot, shared by every
+// copy of the member like its CoreEncodedImageSlot. CoreRuntime then hands
+// the finalized capture to CoreCaptureThumbnailPool, which builds each
+// member's pyramid off the core and main threads, so a gallery showing a
+// fresh capture reads small RGBA8 images instead of scaling full-resolution
+// payloads itself. As for encoded bytes, whoever reaches a member first
+// builds its pyramid -- the pool worker, or a caller that got there before
+// it -- and later callers wait for that build, then share it.
+//
+// Only the first level reads the full-resolution payload; each further level
+// is an area downscale of the one before it.
+struct CoreCaptureThumbnails {
+  // Longest side of each level, largest first. A level never exceeds the
+  // image, and levels that would repeat the one before are dropped, so a
+  // small image has fewer levels.
+  static constexpr std::array<uint32_t, 3> kLevelLongestSides = {512, 256, 128};
+
+  // Tightly packed RGBA8, largest first, aspect ratio kept.
+  std::vector<std::shared_ptr<const CoreDerivedPayload>> levels;
+
+  // The smallest level whose longest side is at least longest_side, or the
+  // largest level when none is that big; nullptr when there are no levels.
+  const CoreDerivedPayload* level_for(uint32_t longest_side) const noexcept;
+};
+
+struct CoreCaptureThumbnailSlot {
+  enum class State : uint8_t {
+    PENDING = 0,
+    BUILDING,
+    DONE,
+  };
+
+  std::mutex mutex;
+  std::condition_variable done_cv;
+  State state = State::PENDING;
+  // Set once DONE; nullptr when the payload could not be scaled.
+  std::shared_ptr<const CoreCaptureThumbnails> thumbnails;
+};
+
+// Thumbnails of member: the cached pyramid, or built on this thread if
+// nobody has claimed the build yet, or waited for if somebody has. nullptr
+// when the member has no slot (no retained CPU payload) or its payload could
+// not be scaled.
+std::shared_ptr<const CoreCaptureThumbnails> obtain_capture_member_thumbnails(
+    const CoreCaptureResultData::ImageMemberData& member);
+
+// Bounded background builder for finalized captures, kept apart from
+// CoreEncodedImagePool so thumbnails never queue behind full-size PNG
+// encodes. One worker thread, started on first submit, and at most
+// kMaxQueuedCaptures captures waiting for it; a refused capture stays
+// PENDING and is built by its first caller instead.
+//
+// Threading: submit() from the core thread; stop() from the owner with no
+// concurrent submit(). stop() drops queued captures (they stay PENDING) and
+// waits for the one in progress.
+class CoreCaptureThumbnailPool final {
+public:
+  static constexpr size_t kMaxQueuedCaptures = 8;
+
+  CoreCaptureThumbnailPool() = default;
+  ~CoreCaptureThumbnailPool();
+
+  CoreCaptureThumbnailPool(const CoreCaptureThumbnailPool&) = delete;
+  CoreCaptureThumbnailPool& operator=(const CoreCaptureThumbnailPool&) = delete;
+
+  // True when the capture was queued. False if it has no member to build,
+  // the queue is full, or the worker could not be started.
+  bool submit(SharedCaptureResultData data);
+  void stop() noexcept;
+
+private:
+  void worker_main_() noexcept;
+
+  std::mutex mu_;
+  std::condition_variable work_cv_;
+  std::deque<SharedCaptureResultData> queue_;
+  bool stop_requested_ = false;
+  std::thread worker_;
+};
+
+} // namespace cambang
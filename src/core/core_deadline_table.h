@@ -0,0 +1,109 @@
+// src/core/core_deadline_table.h
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <optional>
+
+namespace cambang {
+
+// Core-thread deadlines for the retention/watchdog sweeps run from
+// CoreRuntime::on_core_timer_tick().
+//
+// Each timed subsystem owns one entry holding its next absolute deadline and
+// the revision of the registry it was computed from. A tick only runs a
+// subsystem's sweep (and its next-deadline scan) when that deadline has passed
+// or the registry changed since; otherwise the cached deadline stands, so an
+// idle tick costs one entry compare per subsystem however many records are
+// retained.
+//
+// An entry may also carry a slack: how late its deadline may be served. The
+// timer re-arms for the earliest deadline-plus-slack, the latest wake that
+// still meets every entry, so deadlines falling inside that span share one
+// wake instead of each waking the core thread.
+//
+// Entries start (and after invalidate()) due, so the first tick always runs.
+class CoreDeadlineTable final {
+public:
+  enum class Kind : uint8_t {
+    WARM_HOLD = 0,
+    PENDING_CAPTURE_OBSERVATION,
+    NATIVE_OBJECT_RETENTION,
+    TELEMETRY_RETENTION,
+    RETAINED_PLAN_ORPHAN_RETENTION,
+    CAPTURE_ADMISSION_WATCHDOG,
+    CAPTURE_COHORT_RETENTION,
+    CAPTURE_ASSEMBLY_RETENTION,
+    // Wake for a counter-only snapshot publish held back by CorePublishPacer.
+    SNAPSHOT_PUBLISH,
+    // Next stream QoS load sample (CoreStreamQosController).
+    STREAM_QOS,
+    COUNT,
+  };
+
+  // True when `kind` must be swept this tick.
+  bool due(Kind kind, uint64_t now_ns, uint64_t source_revision) const noexcept {
+    const Entry& e = entries_[index(kind)];
+    return !e.valid || e.source_revision != source_revision || e.deadline_ns <= now_ns;
+  }
+
+  // Records the subsystem's next deadline (nullopt: nothing pending) as of
+  // `source_revision`.
+  void set(Kind kind, uint64_t now_ns, std::optional<uint64_t> delay_ns, uint64_t source_revision = 0) noexcept {
+    Entry& e = entries_[index(kind)];
+    e.valid = true;
+    e.source_revision = source_revision;
+    if (!delay_ns.has_value()) {
+      e.deadline_ns = kNever;
+    } else {
+      e.deadline_ns = (*delay_ns > kNever - now_ns) ? kNever - 1 : now_ns + *delay_ns;
+    }
+  }
+
+  // Lateness `kind` tolerates from now on; kept across set() and invalidate().
+  void set_slack(Kind kind, uint64_t slack_ns) noexcept { entries_[index(kind)].slack_ns = slack_ns; }
+
+  void invalidate(Kind kind) noexcept { entries_[index(kind)].valid = false; }
+  void invalidate_all() noexcept {
+    for (Entry& e : entries_) {
+      e.valid = false;
+    }
+  }
+
+  // Delay until the earliest recorded deadline plus its slack; nullopt when
+  // none is pending.
+  std::optional<uint64_t> next_delay_ns(uint64_t now_ns) const noexcept {
+    uint64_t wake_ns = kNever;
+    for (const Entry& e : entries_) {
+      if (!e.valid || e.deadline_ns == kNever) {
+        continue;
+      }
+      const uint64_t latest_ns = (e.slack_ns > kNever - 1 - e.deadline_ns) ? kNever - 1 : e.deadline_ns + e.slack_ns;
+      if (latest_ns < wake_ns) {
+        wake_ns = latest_ns;
+      }
+    }
+    if (wake_ns == kNever) {
+      return std::nullopt;
+    }
+    return wake_ns > now_ns ? wake_ns - now_ns : 0;
+  }
+
+private:
+  static constexpr uint64_t kNever = std::numeric_limits<uint64_t>::max();
+
+  struct Entry {
+    bool valid = false;
+    uint64_t source_revision = 0;
+    uint64_t deadline_ns = kNever;
+    uint64_t slack_ns = 0;
+  };
+
+  static constexpr size_t index(Kind kind) noexcept { return static_cast<size_t>(kind); }
+
+  std::array<Entry, static_cast<size_t>(Kind::COUNT)> entries_{};
+};
+
+} // namespace cambang
@@ -0,0 +1,189 @@
+// src/core/core_derived_payload.cpp
+#include "core/core_derived_payload.h"
+
+#include <array>
+
+#include "pixels/convert/yuv420_to_rgba.h"
+
+namespace cambang {
+
+namespace {
+
+bool resolve_for_payload(const CoreResultPayloadCpuPacked& payload,
+                         const PackedTransform& transform,
+                         PackedTransformGeometry& geometry) noexcept {
+  return has_valid_retained_cpu_payload_layout(payload) &&
+         resolve_packed_transform(transform, payload.width, payload.height, geometry);
+}
+
+Yuv420Source yuv420_source_of(const CoreResultPayloadCpuPacked& payload) noexcept {
+  const uint8_t* src = payload.data();
+  Yuv420Source yuv{};
+  yuv.y = src + payload.planes[0].offset_bytes;
+  yuv.y_row_stride = payload.planes[0].row_stride_bytes;
+  yuv.uv_row_stride = payload.planes[1].row_stride_bytes;
+  if (payload.format_fourcc == FOURCC_I420) {
+    yuv.u = src + payload.planes[1].offset_bytes;
+    yuv.v = src + payload.planes[2].offset_bytes;
+    yuv.uv_pixel_stride = 1;
+  } else {
+    const uint8_t* chroma = src + payload.planes[1].offset_bytes;
+    yuv.u = payload.format_fourcc == FOURCC_NV12 ? chroma : chroma + 1;
+    yuv.v = payload.format_fourcc == FOURCC_NV12 ? chroma + 1 : chroma;
+    yuv.uv_pixel_stride = 2;
+  }
+  return yuv;
+}
+
+// What convert_yuv420_rows_to_packed() then LUMA8 give for a grey pixel,
+// (298 (Y - 16) + 128) >> 8 clamped, applied to the Y sample directly.
+const std::array<uint8_t, 256>& limited_to_full_luma() noexcept {
+  static const std::array<uint8_t, 256> table = [] {
+    std::array<uint8_t, 256> t{};
+    for (int32_t y = 0; y < 256; ++y) {
+      const int32_t v = (298 * (y - 16) + 128) >> 8;
+      t[static_cast<size_t>(y)] = static_cast<uint8_t>(v < 0 ? 0 : (v > 255 ? 255 : v));
+    }
+    return t;
+  }();
+  return table;
+}
+
+void transform_payload(const CoreResultPayloadCpuPacked& payload,
+                       const PackedTransform& transform,
+                       const PackedTransformGeometry& geometry,
+                       uint8_t* dst) {
+  const size_t dst_stride = static_cast<size_t>(geometry.width) * geometry.bytes_per_pixel;
+  if (!payload.is_planar()) {
+    apply_packed_transform_rows(transform,
+                                geometry,
+                                payload.data(),
+                                payload.stride_bytes,
+                                0,
+                                payload.format_fourcc == FOURCC_BGRA,
+                                0,
+                                geometry.height,
+                                dst,
+                                dst_stride);
+    return;
+  }
+
+  // Unscaled luma needs only the Y plane: the chroma planes are never read.
+  if (transform.output == PackedTransformOutput::LUMA8 && !transform.use_lut &&
+      geometry.width == geometry.crop_width && geometry.height == geometry.crop_height) {
+    const std::array<uint8_t, 256>& expand = limited_to_full_luma();
+    const uint8_t* y_plane = payload.data() + payload.planes[0].offset_bytes;
+    const size_t y_stride = payload.planes[0].row_stride_bytes;
+    for (uint32_t oy = 0; oy < geometry.height; ++oy) {
+      const uint8_t* in = y_plane + static_cast<size_t>(geometry.crop_y + oy) * y_stride + geometry.crop_x;
+      uint8_t* out = dst + static_cast<size_t>(oy) * dst_stride;
+      for (uint32_t ox = 0; ox < geometry.width; ++ox) {
+        out[ox] = expand[in[ox]];
+      }
+    }
+    return;
+  }
+
+  // One output row's source rows at a time: the RGBA band stays cache-sized
+  // and is reused, instead of a full-frame RGBA intermediate. The source view
+  // starts on the even row at or above the band, so chroma rows still pair
+  // with luma rows, and the band has one spare row for that offset.
+  const Yuv420Source yuv = yuv420_source_of(payload);
+  const size_t band_stride = static_cast<size_t>(payload.width) * 4u;
+  std::vector<uint8_t> band(band_stride * (static_cast<size_t>(geometry.max_source_rows) + 1u));
+  for (uint32_t oy = 0; oy < geometry.height; ++oy) {
+    uint32_t sy0 = 0;
+    uint32_t sy1 = 0;
+    packed_transform_source_rows(transform, geometry, oy, sy0, sy1);
+    const uint32_t base = sy0 & ~1u;
+    Yuv420Source rows = yuv;
+    rows.y += static_cast<size_t>(base) * yuv.y_row_stride;
+    rows.u += static_cast<size_t>(base / 2u) * yuv.uv_row_stride;
+    rows.v += static_cast<size_t>(base / 2u) * yuv.uv_row_stride;
+    convert_yuv420_rows_to_packed(rows, payload.width, sy0 - base, sy1 - base, true, band.data(), band_stride);
+    apply_packed_transform_rows(transform, geometry, band.data(), band_stride, base, false, oy, oy + 1,
+                                dst, dst_stride);
+  }
+}
+
+std::shared_ptr<const CoreDerivedPayload> obtain_derived_payload(
+    const std::shared_ptr<CoreDerivedPayloadCache>& cache,
+    const CoreResultPayloadCpuPacked& payload,
+    const PackedTransform& transform) {
+  if (!cache) {
+    return nullptr;
+  }
+  const auto find_locked = [&]() -> std::shared_ptr<const CoreDerivedPayload> {
+    for (auto it = cache->entries.begin(); it != cache->entries.end(); ++it) {
+      if (it->transform == transform) {
+        cache->entries.splice(cache->entries.begin(), cache->entries, it);
+        return cache->entries.front().payload;
+      }
+    }
+    return nullptr;
+  };
+  {
+    std::lock_guard<std::mutex> lock(cache->mutex);
+    if (std::shared_ptr<const CoreDerivedPayload> hit = find_locked()) {
+      return hit;
+    }
+  }
+
+  PackedTransformGeometry geometry{};
+  if (!resolve_for_payload(payload, transform, geometry)) {
+    return nullptr;
+  }
+  auto derived = std::make_shared<CoreDerivedPayload>();
+  derived->output = transform.output;
+  derived->width = geometry.width;
+  derived->height = geometry.height;
+  derived->stride_bytes = geometry.width * geometry.bytes_per_pixel;
+  derived->bytes.resize(geometry.tight_size_bytes());
+  transform_payload(payload, transform, geometry, derived->bytes.data());
+
+  std::shared_ptr<const CoreDerivedPayload> dropped;
+  std::lock_guard<std::mutex> lock(cache->mutex);
+  if (std::shared_ptr<const CoreDerivedPayload> raced = find_locked()) {
+    return raced;
+  }
+  cache->entries.push_front(CoreDerivedPayloadCache::Entry{transform, derived});
+  if (cache->entries.size() > CoreDerivedPayloadCache::kMaxEntries) {
+    dropped = std::move(cache->entries.back().payload);
+    cache->entries.pop_back();
+  }
+  return derived;
+}
+
+} // namespace
+
+size_t retained_cpu_payload_transformed_size(const CoreResultPayloadCpuPacked& payload,
+                                             const PackedTransform& transform) noexcept {
+  PackedTransformGeometry geometry{};
+  return resolve_for_payload(payload, transform, geometry) ? geometry.tight_size_bytes() : 0;
+}
+
+bool copy_retained_cpu_payload_transformed(const CoreResultPayloadCpuPacked& payload,
+                                           const PackedTransform& transform,
+                                           uint8_t* dst,
+                                           size_t dst_size) {
+  PackedTransformGeometry geometry{};
+  if (!dst || !resolve_for_payload(payload, transform, geometry) || dst_size < geometry.tight_size_bytes()) {
+    return false;
+  }
+  transform_payload(payload, transform, geometry, dst);
+  return true;
+}
+
+std::shared_ptr<const CoreDerivedPayload> obtain_capture_member_derived_payload(
+    const CoreCaptureResultData::ImageMemberData& member,
+    const PackedTransform& transform) {
+  return obtain_derived_payload(member.derived_payloads, member.payload, transform);
+}
+
+std::shared_ptr<const CoreDerivedPayload> obtain_stream_result_derived_payload(
+    const CoreStreamResultData& result,
+    const PackedTransform& transform) {
+  return obtain_derived_payload(result.derived_payloads, result.payload, transform);
+}
+
+} // namespace cambang
@@ -0,0 +1,79 @@
+// src/core/core_derived_payload.h
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "core/core_result_store.h"
+#include "pixels/convert/packed_transform.h"
+
+namespace cambang {
+
+// Post-processed reads of retained CPU payloads, for native consumers that
+// would otherwise crop, scale, convert and tone-map a copy themselves, one
+// full-frame pass per step.
+//
+// A PackedTransform describes the whole chain and runs as one fused pass over
+// the payload. Planar YUV payloads are converted to RGBA a band of source rows
+// at a time, feeding the same pass, so no full-frame RGBA copy is made; an
+// unscaled LUMA8 read of a planar payload reads only its Y plane.
+// Capture members and stream results cache their derived payloads
+// (CoreDerivedPayloadCache), so every consumer asking for the same chain --
+// a grid of thumbnails, say -- shares one result. A stream result is one
+// retained frame, so its cache lives exactly as long as that frame.
+
+struct CoreDerivedPayload {
+  PackedTransformOutput output = PackedTransformOutput::RGBA8;
+  uint32_t width = 0;
+  uint32_t height = 0;
+  // Tightly packed: width * bytes per pixel.
+  uint32_t stride_bytes = 0;
+  std::vector<uint8_t> bytes;
+};
+
+// Output byte size of transform over payload; 0 when the payload has no
+// valid CPU layout or the transform does not fit it.
+size_t retained_cpu_payload_transformed_size(const CoreResultPayloadCpuPacked& payload,
+                                             const PackedTransform& transform) noexcept;
+
+// Writes transform of payload, tightly packed, into dst. Returns false on an
+// invalid payload, a transform that does not fit it, or a short dst.
+bool copy_retained_cpu_payload_transformed(const CoreResultPayloadCpuPacked& payload,
+                                           const PackedTransform& transform,
+                                           uint8_t* dst,
+                                           size_t dst_size);
+
+// Derived payloads of one capture member or stream result, shared by every
+// copy of it like a member's CoreEncodedImageSlot. At most kMaxEntries chains are kept, least
+// recently used dropped first; callers keep the payloads they hold alive.
+struct CoreDerivedPayloadCache {
+  static constexpr size_t kMaxEntries = 4;
+
+  struct Entry {
+    PackedTransform transform;
+    std::shared_ptr<const CoreDerivedPayload> payload;
+  };
+
+  std::mutex mutex;
+  // Most recently used first.
+  std::list<Entry> entries;
+};
+
+// transform of member: the cached derived payload, or computed on this thread
+// and cached. Concurrent first callers may each compute it; the first to
+// finish is kept and returned to all. nullptr when the member has no cache
+// (no retained CPU payload) or the transform does not fit it.
+std::shared_ptr<const CoreDerivedPayload> obtain_capture_member_derived_payload(
+    const CoreCaptureResultData::ImageMemberData& member,
+    const PackedTransform& transform);
+
+// The same for a stream result's retained frame.
+std::shared_ptr<const CoreDerivedPayload> obtain_stream_result_derived_payload(
+    const CoreStreamResultData& result,
+    const PackedTransform& transform);
+
+} // namespace cambang
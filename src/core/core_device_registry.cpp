@@ -29,6 +29,7 @@ bool CoreDeviceRegistry::note_device_identity(uint64_t device_instance_id, const
   auto& rec = devices_[device_instance_id];
   rec.device_instance_id = device_instance_id;
   rec.hardware_id = hardware_id;
+  rec.hardware_key = global_hardware_id_interner().intern(hardware_id);
   return true;
 }
 
@@ -2,8 +2,10 @@
 #pragma once
 
 #include <cstdint>
-#include <map>
 #include <string>
+
+#include "core/core_id_map.h"
+#include "core/core_string_interner.h"
 #include "imaging/api/provider_contract_datatypes.h"
 
 namespace cambang {
@@ -21,6 +23,8 @@ public:
   struct DeviceRecord {
     uint64_t device_instance_id = 0;
     std::string hardware_id;
+    // global_hardware_id_interner() id of hardware_id, for comparisons.
+    CoreStringId hardware_key = 0;
     uint64_t camera_spec_version = 0;
     uint64_t capture_profile_version = 0;
     uint64_t capture_access_posture_epoch = 0;
@@ -74,12 +78,12 @@ public:
   bool on_device_error(uint64_t device_instance_id, uint32_t error_code);
 
   const DeviceRecord* find(uint64_t device_instance_id) const noexcept;
-  const std::map<uint64_t, DeviceRecord>& all() const noexcept { return devices_; }
+  const CoreIdMap<DeviceRecord>& all() const noexcept { return devices_; }
 
 private:
   uint64_t allocate_capture_access_posture_epoch() noexcept;
 
-  std::map<uint64_t, DeviceRecord> devices_; // key: device_instance_id
+  CoreIdMap<DeviceRecord> devices_; // key: device_instance_id
   uint64_t next_capture_access_posture_epoch_ = 1;
 };
 
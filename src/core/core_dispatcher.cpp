@@ -1,6 +1,7 @@
 ﻿// src/core/core_dispatcher.cpp
 #include "core/core_dispatcher.h"
 #include "core/resource_aggregate_telemetry.h"
+#include "imaging/api/frame_latency_trace.h"
 
 #include <chrono>
 #include <variant>
@@ -9,6 +10,8 @@ namespace cambang {
 
 namespace {
 
+using OpKind = CoreOperationRegistry::Kind;
+
 // Fallback monotonic timestamp source when no now_ns_ override is injected.
 // Feeds ingest_steady_ns (CoreCaptureLifecycleIngressEvent) and
 // CoreStreamRegistry::on_frame_received()'s integrated_ts_ns; not diagnostic.
@@ -39,6 +42,7 @@ void CoreDispatcher::dispatch(ProviderToCoreCommand&& cmd) {
     if (devices_) {
       devices_->on_device_opened(p.device_instance_id);
     }
+    resolve_operations_(OpKind::DeviceOpen, p.device_instance_id, CoreOperationOutcome::Succeeded);
     relevant_state_changed_ = true;
     break;
   }
@@ -52,6 +56,11 @@ void CoreDispatcher::dispatch(ProviderToCoreCommand&& cmd) {
     if (provider_camera_fact_state_) {
       provider_camera_fact_state_->erase_device(p.device_instance_id);
     }
+    if (result_store_) {
+      result_store_->retire_device_access_postures(p.device_instance_id);
+    }
+    resolve_operations_(OpKind::DeviceClose, p.device_instance_id, CoreOperationOutcome::Succeeded);
+    resolve_operations_(OpKind::DeviceOpen, p.device_instance_id, CoreOperationOutcome::Failed);
     // Retention (ledger #52) deliberately does NOT hook device close: a
     // caller may legitimately report a retained-to-image access observation
     // for a capture on an already-closed device (Core's own
@@ -83,6 +92,8 @@ void CoreDispatcher::dispatch(ProviderToCoreCommand&& cmd) {
     if (result_store_) {
       result_store_->remove_stream_result(p.stream_id);
     }
+    resolve_operations_(OpKind::StreamStart, p.stream_id, CoreOperationOutcome::Cancelled);
+    resolve_operations_(OpKind::StreamStop, p.stream_id, CoreOperationOutcome::Cancelled);
     relevant_state_changed_ = true;
     break;
   }
@@ -93,6 +104,7 @@ void CoreDispatcher::dispatch(ProviderToCoreCommand&& cmd) {
     if (streams_) {
       streams_->on_provider_stream_started(p.stream_id);
     }
+    resolve_operations_(OpKind::StreamStart, p.stream_id, CoreOperationOutcome::Succeeded);
     relevant_state_changed_ = true;
     break;
   }
@@ -103,6 +115,10 @@ void CoreDispatcher::dispatch(ProviderToCoreCommand&& cmd) {
     if (streams_) {
       streams_->on_provider_stream_stopped(p.stream_id, p.error_code);
     }
+    resolve_operations_(OpKind::StreamStop, p.stream_id, CoreOperationOutcome::Succeeded);
+    if (p.error_code != 0) {
+      resolve_operations_(OpKind::StreamStart, p.stream_id, CoreOperationOutcome::Failed, p.error_code);
+    }
     relevant_state_changed_ = true;
     break;
   }
@@ -113,6 +129,7 @@ void CoreDispatcher::dispatch(ProviderToCoreCommand&& cmd) {
     if (streams_) {
       streams_->on_stream_error(p.stream_id, p.error_code);
     }
+    resolve_operations_(OpKind::StreamStart, p.stream_id, CoreOperationOutcome::Failed, p.error_code);
     relevant_state_changed_ = true;
     break;
   }
@@ -123,6 +140,7 @@ void CoreDispatcher::dispatch(ProviderToCoreCommand&& cmd) {
     if (devices_) {
       devices_->on_device_error(p.device_instance_id, p.error_code);
     }
+    resolve_operations_(OpKind::DeviceOpen, p.device_instance_id, CoreOperationOutcome::Failed, p.error_code);
     relevant_state_changed_ = true;
     break;
   }
@@ -202,6 +220,21 @@ case ProviderToCoreCommandType::PROVIDER_NATIVE_OBJECT_DESTROYED: {
   break;
 }
 
+case ProviderToCoreCommandType::PROVIDER_NATIVE_OBJECT_COUNTERS: {
+  stats_.commands_handled++;
+  const auto& p = std::get<CmdProviderNativeObjectCounters>(cmd.payload);
+  bool state_changed = false;
+  if (native_objects_) {
+    for (const NativeObjectCountersUpdate& u : p.updates) {
+      state_changed =
+          native_objects_->on_native_object_counters(u.native_id, u.bytes_allocated, u.buffers_in_use) ||
+          state_changed;
+    }
+  }
+  relevant_state_changed_ = relevant_state_changed_ || state_changed;
+  break;
+}
+
   case ProviderToCoreCommandType::PROVIDER_CAPTURE_STARTED: {
     const uint64_t dispatch_begin_ns = dispatcher_monotonic_now_ns();
     stats_.commands_handled++;
@@ -275,6 +308,7 @@ case ProviderToCoreCommandType::PROVIDER_NATIVE_OBJECT_DESTROYED: {
     if (!acquisition_sessions_ && capture_assembly_registry_) {
       capture_assembly_registry_->mark_capture_completed(p.capture_id, p.device_instance_id);
     }
+    resolve_operations_(OpKind::Capture, p.capture_id, CoreOperationOutcome::Succeeded);
     relevant_state_changed_ = relevant_state_changed_ || state_changed;
     break;
   }
@@ -303,6 +337,7 @@ case ProviderToCoreCommandType::PROVIDER_NATIVE_OBJECT_DESTROYED: {
     if (capture_assembly_registry_) {
       capture_assembly_registry_->mark_capture_failed(p.capture_id, p.device_instance_id, p.error_code);
     }
+    resolve_operations_(OpKind::Capture, p.capture_id, CoreOperationOutcome::Failed, p.error_code);
     relevant_state_changed_ = relevant_state_changed_ || state_changed;
     break;
   }
@@ -345,6 +380,7 @@ case ProviderToCoreCommandType::PROVIDER_NATIVE_OBJECT_DESTROYED: {
     stats_.frames_received++;
 
     const uint64_t sid = p.frame.stream_id;
+    frame_latency_trace_record(FrameLatencyHop::CoreDispatch, sid, p.frame.trace_id);
     const uint64_t asid = p.frame.acquisition_session_id;
     std::optional<StreamIntent> stream_intent;
     bool retained_for_result = false;
@@ -356,9 +392,11 @@ case ProviderToCoreCommandType::PROVIDER_NATIVE_OBJECT_DESTROYED: {
     CoreRetainedProductionPlan capture_requested_retained_plan{};
     if (streams_) {
       integrated_ts_ns = now_ns_ ? now_ns_() : dispatcher_monotonic_now_ns();
-      if (!streams_->on_frame_received(sid, integrated_ts_ns)) {
+      if (!streams_->on_frame_received(sid, integrated_ts_ns, p.frame)) {
         stats_.frames_unknown_stream++;
       }
+      (void)streams_->on_frame_geometry(
+          sid, p.frame.width, p.frame.height, p.frame.format_fourcc, integrated_ts_ns);
       if (const CoreStreamRegistry::StreamRecord* stream_rec = streams_->find(sid); stream_rec != nullptr) {
         stream_intent = stream_rec->intent;
         stream_access_posture_epoch = stream_rec->access_posture_epoch;
@@ -416,6 +454,27 @@ case ProviderToCoreCommandType::PROVIDER_NATIVE_OBJECT_DESTROYED: {
     const int32_t frame_member_applied_ev = p.frame.capture_image.applied_exposure_compensation_milli_ev;
     const bool frame_member_has_realized_ev = p.frame.capture_image.has_realized_exposure_compensation_milli_ev;
     const int32_t frame_member_realized_ev = p.frame.capture_image.realized_exposure_compensation_milli_ev;
+    if (frame_shards_ && frame_shards_->running() && frame_sink_ == nullptr && result_store_ &&
+        sid != 0 && p.frame.capture_id == 0 && !is_additional_bracket && has_stream_record &&
+        (result_retention_allowed_ ? result_retention_allowed_() : true)) {
+      // Retention and release move to the device's shard; the rest of this
+      // frame's dispatch runs when its completion comes back.
+      CoreFrameShardJob job;
+      job.frame = std::move(p.frame);
+      p.frame.release = nullptr;
+      p.frame.release_user = nullptr;
+      job.lease_telemetry = p.lease_telemetry;
+      job.stream_intent = stream_intent;
+      job.stream_access_posture_epoch = stream_access_posture_epoch;
+      job.stream_requested_retained_plan = stream_requested_retained_plan;
+      if (!frame_shards_->try_post(job)) {
+        job.frame.release_now();
+        stats_.frames_released++;
+        framebuffer_lease_released(p.lease_telemetry, sid, asid);
+        streams_->on_frame_dropped(sid);
+      }
+      break;
+    }
     if (result_store_) {
       const bool lifecycle_allows_retention =
           result_retention_allowed_ ? result_retention_allowed_() : true;
@@ -463,12 +522,33 @@ case ProviderToCoreCommandType::PROVIDER_NATIVE_OBJECT_DESTROYED: {
           if (retained_for_result && sid != 0 && !stream_result_existed) {
             relevant_state_changed_ = true;
           }
+          if (retained_for_result) {
+            frame_latency_trace_record(FrameLatencyHop::RetainFrame, sid, p.frame.trace_id);
+          }
+          if (retained_for_result && sid != 0 && rig_stream_frame_sets_ &&
+              rig_stream_frame_sets_->is_rig_member(p.frame.device_instance_id)) {
+            rig_stream_frame_sets_->on_stream_result(result_store_->get_latest_stream_result(sid));
+          }
+          if (retained_for_result && sid != 0 && stream_recorder_ && stream_recorder_->has_recordings()) {
+            stream_recorder_->on_stream_result(result_store_->get_latest_stream_result(sid));
+          }
+          if (retained_for_result && sid != 0 && stream_exporter_ && stream_exporter_->has_exports()) {
+            stream_exporter_->on_stream_result(result_store_->get_latest_stream_result(sid));
+          }
         }
       }
     }
     if (capture_assembly_registry_ && retained_for_result && p.frame.capture_id != 0 && !is_additional_bracket) {
       capture_assembly_registry_->mark_default_image_retained(p.frame.capture_id, p.frame.device_instance_id);
     }
+    if (capture_lifecycle_ingress_sink_ && p.frame.capture_id != 0 && !is_additional_bracket) {
+      capture_lifecycle_ingress_sink_(CoreCaptureLifecycleIngressEvent{
+          CoreCaptureLifecycleIngressEvent::Kind::ImageArrived,
+          p.frame.capture_id,
+          p.frame.device_instance_id,
+          resolved_capture_session_id,
+          dispatcher_monotonic_now_ns()});
+    }
 
     if (frame_sink_) {
       // Delivered means handed off to the configured frame sink.
@@ -477,9 +557,7 @@ case ProviderToCoreCommandType::PROVIDER_NATIVE_OBJECT_DESTROYED: {
       p.frame.release_user = nullptr;
       const CoreVisibilityPath visibility_path = frame_sink_->on_frame(std::move(frame));
       stats_.frames_released++;
-      global_resource_aggregate_telemetry().lease_released(make_framebuffer_lease_scoped_resource_telemetry_key(
-          sid,
-          asid));
+      framebuffer_lease_released(p.lease_telemetry, sid, asid);
       if (streams_) {
         streams_->on_frame_released(sid);
         if (streams_->on_visibility_path(sid, visibility_path)) {
@@ -491,9 +569,7 @@ case ProviderToCoreCommandType::PROVIDER_NATIVE_OBJECT_DESTROYED: {
       // If result retention already accepted this frame, it is not counted as dropped.
       p.frame.release_now();
       stats_.frames_released++;
-      global_resource_aggregate_telemetry().lease_released(make_framebuffer_lease_scoped_resource_telemetry_key(
-          sid,
-          asid));
+      framebuffer_lease_released(p.lease_telemetry, sid, asid);
       p.frame.release = nullptr;
       p.frame.release_user = nullptr;
       if (streams_) {
@@ -513,4 +589,31 @@ case ProviderToCoreCommandType::PROVIDER_NATIVE_OBJECT_DESTROYED: {
   }
 }
 
+void CoreDispatcher::integrate_frame_shard_completion(const CoreFrameShardCompletion& completion) {
+  const uint64_t sid = completion.stream_id;
+  stats_.frames_released++;
+  if (streams_) {
+    if (completion.retained) {
+      streams_->on_frame_released(sid);
+    } else {
+      streams_->on_frame_dropped(sid);
+    }
+  }
+  if (!completion.retained) {
+    return;
+  }
+  if (completion.first_stream_result) {
+    relevant_state_changed_ = true;
+  }
+  if (rig_stream_frame_sets_ && rig_stream_frame_sets_->is_rig_member(completion.device_instance_id)) {
+    rig_stream_frame_sets_->on_stream_result(completion.result);
+  }
+  if (stream_recorder_ && stream_recorder_->has_recordings()) {
+    stream_recorder_->on_stream_result(completion.result);
+  }
+  if (stream_exporter_ && stream_exporter_->has_exports()) {
+    stream_exporter_->on_stream_result(completion.result);
+  }
+}
+
 } // namespace cambang
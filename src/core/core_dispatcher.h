@@ -9,9 +9,14 @@
 #include "core/core_device_registry.h"
 #include "core/core_native_object_registry.h"
 #include "core/core_stream_registry.h"
+#include "core/core_frame_shards.h"
 #include "core/core_frame_sink.h"
+#include "core/core_operation.h"
 #include "core/core_capture_assembly_registry.h"
 #include "core/core_result_store.h"
+#include "core/core_rig_stream_frame_sets.h"
+#include "core/core_stream_exporter.h"
+#include "core/core_stream_recorder.h"
 #include "core/provider_camera_fact_state.h"
 
 namespace cambang {
@@ -36,6 +41,8 @@ struct CoreCaptureLifecycleIngressEvent final {
     Started = 0,
     Completed = 1,
     Failed = 2,
+    // A default (non-bracket) capture image was dispatched.
+    ImageArrived = 3,
   };
 
   Kind kind = Kind::Started;
@@ -75,6 +82,11 @@ public:
   // Must be called ONLY on the core thread.
   void dispatch(ProviderToCoreCommand&& cmd);
 
+  // Applies the core-thread half of a sharded frame's dispatch: release
+  // accounting, first-result publication and the retained-result hooks.
+  // Must be called ONLY on the core thread, in completion order.
+  void integrate_frame_shard_completion(const CoreFrameShardCompletion& completion);
+
   // Must be called ONLY on the core thread.
   [[nodiscard]] CoreDispatchStats stats() const noexcept { return stats_; }
 
@@ -93,9 +105,21 @@ public:
   // Must be called before the core thread starts, or from the core thread.
   void set_frame_sink(ICoreFrameSink* sink) noexcept { frame_sink_ = sink; }
   void set_result_store(CoreResultStore* result_store) noexcept { result_store_ = result_store; }
+  // While these shards are running, retained repeating stream frames go to
+  // their device's shard instead of being retained inline; the core thread
+  // then hands each completion to integrate_frame_shard_completion().
+  void set_frame_shards(CoreFrameShards* frame_shards) noexcept { frame_shards_ = frame_shards; }
+  void set_rig_stream_frame_sets(CoreRigStreamFrameSets* rig_stream_frame_sets) noexcept {
+    rig_stream_frame_sets_ = rig_stream_frame_sets;
+  }
+  void set_stream_recorder(CoreStreamRecorder* stream_recorder) noexcept { stream_recorder_ = stream_recorder; }
+  void set_stream_exporter(CoreStreamExporter* stream_exporter) noexcept { stream_exporter_ = stream_exporter; }
   void set_capture_assembly_registry(CoreCaptureAssemblyRegistry* capture_assembly_registry) noexcept {
     capture_assembly_registry_ = capture_assembly_registry;
   }
+  // Operations waiting on lifecycle facts are resolved as those facts are
+  // dispatched (see CoreRuntime::open_device_async()).
+  void set_operation_registry(CoreOperationRegistry* operations) noexcept { operations_ = operations; }
   void set_provider_camera_fact_state(ProviderCameraFactState* provider_camera_fact_state) noexcept {
     provider_camera_fact_state_ = provider_camera_fact_state;
   }
@@ -105,6 +129,15 @@ public:
   }
 
 private:
+  void resolve_operations_(CoreOperationRegistry::Kind kind,
+                           uint64_t id,
+                           CoreOperationOutcome outcome,
+                           uint32_t error_code = 0) {
+    if (operations_ && operations_->waiting() != 0) {
+      (void)operations_->resolve(kind, id, outcome, error_code);
+    }
+  }
+
   CoreStreamRegistry* streams_ = nullptr; // non-owning; core-thread-only
   CoreAcquisitionSessionRegistry* acquisition_sessions_ = nullptr; // non-owning; core-thread-only
   CoreDeviceRegistry* devices_ = nullptr; // non-owning; core-thread-only
@@ -116,8 +149,13 @@ private:
   bool relevant_state_changed_ = false;
   ICoreFrameSink* frame_sink_ = nullptr; // non-owning; core-thread-only
   CoreResultStore* result_store_ = nullptr; // non-owning; core-thread-only
+  CoreFrameShards* frame_shards_ = nullptr; // non-owning; core-thread-only
+  CoreRigStreamFrameSets* rig_stream_frame_sets_ = nullptr; // non-owning; core-thread-only
+  CoreStreamRecorder* stream_recorder_ = nullptr; // non-owning; core-thread-only
+  CoreStreamExporter* stream_exporter_ = nullptr; // non-owning; core-thread-only
   CoreCaptureAssemblyRegistry* capture_assembly_registry_ = nullptr; // non-owning; core-thread-only
   ProviderCameraFactState* provider_camera_fact_state_ = nullptr; // non-owning; core-thread-only
+  CoreOperationRegistry* operations_ = nullptr; // non-owning; core-thread-only
   std::function<void(const CoreCaptureLifecycleIngressEvent&)>
       capture_lifecycle_ingress_sink_{};
   CoreDispatchStats stats_{};
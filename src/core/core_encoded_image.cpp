@@ -0,0 +1,124 @@
+// src/core/core_encoded_image.cpp
+#include "core/core_encoded_image.h"
+
+#include "imaging/api/thread_policy.h"
+#include "pixels/encode/png_encoder.h"
+
+namespace cambang {
+
+namespace {
+
+std::shared_ptr<const std::vector<uint8_t>> encode_member_png(
+    const CoreCaptureResultData::ImageMemberData& member) noexcept try {
+  const CoreResultPayloadCpuPacked& payload = member.payload;
+  std::vector<uint8_t> rgba(static_cast<size_t>(payload.width) * payload.height * 4u);
+  if (!copy_retained_cpu_payload_as_rgba(payload, rgba.data(), rgba.size())) {
+    return nullptr;
+  }
+  auto png = std::make_shared<std::vector<uint8_t>>();
+  if (!encode_png_rgba8(rgba.data(), payload.width, payload.height, *png)) {
+    return nullptr;
+  }
+  return png;
+} catch (...) {
+  return nullptr;
+}
+
+} // namespace
+
+std::shared_ptr<const std::vector<uint8_t>> obtain_capture_member_encoded_bytes(
+    const CoreCaptureResultData::ImageMemberData& member) {
+  const std::shared_ptr<CoreEncodedImageSlot>& slot = member.encoded_image;
+  if (!slot) {
+    return nullptr;
+  }
+  std::unique_lock<std::mutex> lock(slot->mutex);
+  if (slot->state != CoreEncodedImageSlot::State::PENDING) {
+    slot->done_cv.wait(lock, [&] { return slot->state == CoreEncodedImageSlot::State::DONE; });
+    return slot->bytes;
+  }
+  slot->state = CoreEncodedImageSlot::State::ENCODING;
+  lock.unlock();
+
+  std::shared_ptr<const std::vector<uint8_t>> bytes = encode_member_png(member);
+  refine_result_access_classification(
+      member.access_classification,
+      CoreResultAccessOperation::ENCODED_BYTES,
+      bytes ? ResultCapability::READY : ResultCapability::UNSUPPORTED);
+
+  lock.lock();
+  slot->bytes = bytes;
+  slot->state = CoreEncodedImageSlot::State::DONE;
+  lock.unlock();
+  slot->done_cv.notify_all();
+  return bytes;
+}
+
+CoreEncodedImagePool::~CoreEncodedImagePool() {
+  stop();
+}
+
+bool CoreEncodedImagePool::submit(SharedCaptureResultData data) {
+  if (!data) {
+    return false;
+  }
+  bool has_slot = false;
+  for (uint32_t i = 0; i < data->image_member_count(); ++i) {
+    has_slot = has_slot || static_cast<bool>(data->image_member_at(i)->encoded_image);
+  }
+  if (!has_slot) {
+    return false;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(mu_);
+    if (queue_.size() >= kMaxQueuedCaptures) {
+      return false;
+    }
+    if (!worker_.joinable()) {
+      stop_requested_ = false;
+      try {
+        worker_ = std::thread([this] { worker_main_(); });
+      } catch (...) {
+        return false;
+      }
+    }
+    queue_.push_back(std::move(data));
+  }
+  work_cv_.notify_one();
+  return true;
+}
+
+void CoreEncodedImagePool::stop() noexcept {
+  std::deque<SharedCaptureResultData> dropped;
+  {
+    std::lock_guard<std::mutex> lock(mu_);
+    stop_requested_ = true;
+    dropped.swap(queue_);
+  }
+  work_cv_.notify_all();
+  if (worker_.joinable()) {
+    worker_.join();
+  }
+}
+
+void CoreEncodedImagePool::worker_main_() noexcept {
+  apply_current_thread_policy(CBThreadRole::Background, "cambang-encode");
+  for (;;) {
+    SharedCaptureResultData data;
+    {
+      std::unique_lock<std::mutex> lock(mu_);
+      work_cv_.wait(lock, [this] { return stop_requested_ || !queue_.empty(); });
+      if (stop_requested_) {
+        return;
+      }
+      data = std::move(queue_.front());
+      queue_.pop_front();
+    }
+    for (uint32_t i = 0; i < data->image_member_count(); ++i) {
+      (void)obtain_capture_member_encoded_bytes(*data->image_member_at(i));
+    }
+  }
+}
+
+} // namespace cambang
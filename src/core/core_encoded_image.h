@@ -0,0 +1,88 @@
+// src/core/core_encoded_image.h
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "core/core_result_store.h"
+
+namespace cambang {
+
+// Encoded-bytes (PNG) producer for retained capture image members.
+//
+// CoreResultStore::finalize_capture_facts() gives every capture member that
+// retains a valid CPU payload a CoreEncodedImageSlot -- the encoded-bytes
+// cache for that member's retained_frame_id, shared by every copy of the
+// member -- and rates encoded_bytes EXPENSIVE. CoreRuntime then hands the
+// finalized capture to CoreEncodedImagePool, which encodes it off the core
+// and main threads. Whoever reaches a member first does its encode: the pool
+// worker, or a caller asking for the bytes before the worker got there (the
+// pool was full or stopped). Later callers wait for that encode, then read the
+// cache. A finished encode refines the member's ENCODED_BYTES classification
+// to READY (UNSUPPORTED if it failed), so can_get_encoded_bytes() tells a
+// caller when get_encoded_bytes() will not block.
+//
+// Stream results have no slot: their retained frame is replaced every frame,
+// so eager encoding would mostly be thrown away.
+struct CoreEncodedImageSlot {
+  enum class State : uint8_t {
+    PENDING = 0,
+    ENCODING,
+    DONE,
+  };
+
+  std::mutex mutex;
+  std::condition_variable done_cv;
+  State state = State::PENDING;
+  // Set once DONE; nullptr when the encode failed.
+  std::shared_ptr<const std::vector<uint8_t>> bytes;
+};
+
+// PNG bytes of member: the cached result, or produced on this thread if
+// nobody has claimed the encode yet, or waited for if somebody has. nullptr
+// when the member has no slot or its payload could not be encoded.
+std::shared_ptr<const std::vector<uint8_t>> obtain_capture_member_encoded_bytes(
+    const CoreCaptureResultData::ImageMemberData& member);
+
+// Bounded background encoder for finalized captures. One worker thread,
+// started on first submit, and at most kMaxQueuedCaptures captures waiting
+// for it; a capture refused because the queue is full stays PENDING and is
+// encoded by its first caller instead. A queued capture keeps its result data
+// alive until encoded, so the bound also caps how far encoding can extend
+// result memory past retention.
+//
+// Threading: submit() from the core thread; stop() from the owner with no
+// concurrent submit(). stop() drops queued captures (they stay PENDING) and
+// waits for the one in progress.
+class CoreEncodedImagePool final {
+public:
+  static constexpr size_t kMaxQueuedCaptures = 4;
+
+  CoreEncodedImagePool() = default;
+  ~CoreEncodedImagePool();
+
+  CoreEncodedImagePool(const CoreEncodedImagePool&) = delete;
+  CoreEncodedImagePool& operator=(const CoreEncodedImagePool&) = delete;
+
+  // True when the capture was queued. False if it has nothing to encode, the
+  // queue is full, or the worker could not be started.
+  bool submit(SharedCaptureResultData data);
+  void stop() noexcept;
+
+private:
+  void worker_main_() noexcept;
+
+  std::mutex mu_;
+  std::condition_variable work_cv_;
+  std::deque<SharedCaptureResultData> queue_;
+  bool stop_requested_ = false;
+  std::thread worker_;
+};
+
+} // namespace cambang
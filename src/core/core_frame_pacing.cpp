@@ -0,0 +1,49 @@
+// src/core/core_frame_pacing.cpp
+
+#include "core/core_frame_pacing.h"
+
+#include <cmath>
+
+namespace cambang {
+
+void CoreFramePacing::record(uint64_t time_ns, uint32_t source) noexcept {
+  const bool chained = has_last_ && source == last_source_ && time_ns > last_ns_;
+  const uint64_t interval_ns = chained ? time_ns - last_ns_ : 0;
+  has_last_ = true;
+  last_ns_ = time_ns;
+  last_source_ = source;
+  if (!chained) {
+    return;
+  }
+
+  const uint64_t n = intervals_.count();
+  if (n != 0 && static_cast<double>(interval_ns) * kGapDenominator > mean_ns_ * kGapNumerator) {
+    ++gaps_;
+  }
+  intervals_.record(interval_ns);
+  const double value = static_cast<double>(interval_ns);
+  const double delta = value - mean_ns_;
+  mean_ns_ += delta / static_cast<double>(n + 1);
+  m2_ += delta * (value - mean_ns_);
+}
+
+void CoreFramePacing::reset() noexcept {
+  *this = CoreFramePacing{};
+}
+
+CoreFramePacing::Summary CoreFramePacing::summary() const noexcept {
+  Summary out;
+  out.intervals = intervals_.count();
+  if (out.intervals == 0) {
+    return out;
+  }
+  const CoreHdrHistogram::Summary histogram = intervals_.summary();
+  out.mean_interval_ns = static_cast<uint64_t>(std::llround(mean_ns_));
+  out.interval_p50_ns = histogram.p50_ns;
+  out.interval_p99_ns = histogram.p99_ns;
+  out.jitter_ns = static_cast<uint64_t>(std::llround(std::sqrt(m2_ / static_cast<double>(out.intervals))));
+  out.gaps = gaps_;
+  return out;
+}
+
+} // namespace cambang
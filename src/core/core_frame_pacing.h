@@ -0,0 +1,55 @@
+// src/core/core_frame_pacing.h
+#pragma once
+
+#include <cstdint>
+
+#include "core/core_hdr_histogram.h"
+
+namespace cambang {
+
+// Constant-memory inter-frame interval statistics for one sequence of frame
+// times (a stream's arrivals, or its display pickups).
+//
+// Each time fed to record() closes an interval with the previous one, if both
+// came from the same time source; a source change, or a time not after the
+// previous one, starts a new chain instead, so two clocks (or a stream
+// restart, see restart()) are never measured across. Per interval it keeps a
+// CoreHdrHistogram, a running mean and variance (jitter is the standard
+// deviation of the interval), and a gap count: intervals longer than
+// kGapNumerator / kGapDenominator times the mean interval before them.
+//
+// Not thread-safe.
+class CoreFramePacing final {
+public:
+  static constexpr uint64_t kGapNumerator = 3;
+  static constexpr uint64_t kGapDenominator = 2;
+
+  struct Summary {
+    uint64_t intervals = 0;
+    uint64_t mean_interval_ns = 0;
+    uint64_t interval_p50_ns = 0;
+    uint64_t interval_p99_ns = 0;
+    uint64_t jitter_ns = 0;
+    uint64_t gaps = 0;
+  };
+
+  // source tells clocks apart; any value the caller keeps stable per clock.
+  void record(uint64_t time_ns, uint32_t source) noexcept;
+  // Ends the current chain; the next record() starts a new one.
+  void restart() noexcept { has_last_ = false; }
+  void reset() noexcept;
+
+  Summary summary() const noexcept;
+
+private:
+  CoreHdrHistogram intervals_;
+  // Welford running mean and sum of squared deviations.
+  double mean_ns_ = 0.0;
+  double m2_ = 0.0;
+  uint64_t gaps_ = 0;
+  uint64_t last_ns_ = 0;
+  uint32_t last_source_ = 0;
+  bool has_last_ = false;
+};
+
+} // namespace cambang
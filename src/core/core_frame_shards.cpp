@@ -0,0 +1,154 @@
+// src/core/core_frame_shards.cpp
+#include "core/core_frame_shards.h"
+
+#include "imaging/api/frame_latency_trace.h"
+#include "imaging/api/thread_policy.h"
+
+namespace cambang {
+
+CoreFrameShards::~CoreFrameShards() {
+  stop();
+}
+
+bool CoreFrameShards::start(size_t shard_count, CoreResultStore* store, std::function<void()> wake) {
+  if (running() || shard_count == 0 || shard_count > kMaxShards || store == nullptr) {
+    return false;
+  }
+  store_ = store;
+  wake_ = std::move(wake);
+  try {
+    shards_.reserve(shard_count);
+    for (size_t i = 0; i < shard_count; ++i) {
+      auto shard = std::make_unique<Shard>();
+      Shard& s = *shard;
+      shards_.push_back(std::move(shard));
+      s.worker = std::thread([this, &s] { worker_main_(s); });
+    }
+  } catch (...) {
+    stop();
+    return false;
+  }
+  return true;
+}
+
+void CoreFrameShards::stop() noexcept {
+  for (const std::unique_ptr<Shard>& shard : shards_) {
+    {
+      std::lock_guard<std::mutex> lock(shard->mu);
+      shard->stop_requested = true;
+    }
+    shard->work_cv.notify_all();
+  }
+  for (const std::unique_ptr<Shard>& shard : shards_) {
+    if (shard->worker.joinable()) {
+      shard->worker.join();
+    }
+  }
+  shards_.clear();
+  store_ = nullptr;
+  wake_ = nullptr;
+}
+
+bool CoreFrameShards::try_post(CoreFrameShardJob& job) {
+  if (!running()) {
+    return false;
+  }
+  Shard& shard = *shards_[shard_for_device(job.frame.device_instance_id)];
+  {
+    std::lock_guard<std::mutex> lock(shard.mu);
+    if (shard.queue.size() >= kMaxQueuedFramesPerShard) {
+      frames_rejected_full_.fetch_add(1, std::memory_order_relaxed);
+      return false;
+    }
+    shard.queue.push_back(std::move(job));
+  }
+  // The queued copy owns the release now.
+  job.frame.release = nullptr;
+  job.frame.release_user = nullptr;
+  frames_posted_.fetch_add(1, std::memory_order_relaxed);
+  shard.work_cv.notify_one();
+  return true;
+}
+
+void CoreFrameShards::wait_idle() noexcept {
+  for (const std::unique_ptr<Shard>& shard : shards_) {
+    std::unique_lock<std::mutex> lock(shard->mu);
+    shard->idle_cv.wait(lock, [&shard] { return shard->queue.empty() && !shard->busy; });
+  }
+}
+
+void CoreFrameShards::take_completions(std::vector<CoreFrameShardCompletion>& out) {
+  std::lock_guard<std::mutex> lock(completions_mu_);
+  if (out.empty()) {
+    out.swap(completions_);
+    return;
+  }
+  for (CoreFrameShardCompletion& c : completions_) {
+    out.push_back(std::move(c));
+  }
+  completions_.clear();
+}
+
+CoreFrameShards::Stats CoreFrameShards::stats() const noexcept {
+  Stats s;
+  s.frames_posted = frames_posted_.load(std::memory_order_relaxed);
+  s.frames_retained = frames_retained_.load(std::memory_order_relaxed);
+  s.frames_rejected_full = frames_rejected_full_.load(std::memory_order_relaxed);
+  return s;
+}
+
+CoreFrameShardCompletion CoreFrameShards::run_job_(CoreFrameShardJob& job) noexcept {
+  CoreFrameShardCompletion c;
+  c.stream_id = job.frame.stream_id;
+  c.device_instance_id = job.frame.device_instance_id;
+  c.first_stream_result = store_->get_latest_stream_result(c.stream_id) == nullptr;
+  c.retained = store_->retain_frame(job.frame,
+                                    job.stream_intent,
+                                    job.stream_access_posture_epoch,
+                                    0,
+                                    job.stream_requested_retained_plan,
+                                    CoreRetainedProductionPlan{});
+  if (c.retained) {
+    frame_latency_trace_record(FrameLatencyHop::RetainFrame, c.stream_id, job.frame.trace_id);
+    c.result = store_->get_latest_stream_result(c.stream_id);
+    frames_retained_.fetch_add(1, std::memory_order_relaxed);
+  } else {
+    c.first_stream_result = false;
+  }
+  job.frame.release_now();
+  framebuffer_lease_released(job.lease_telemetry, c.stream_id, job.frame.acquisition_session_id);
+  return c;
+}
+
+void CoreFrameShards::worker_main_(Shard& shard) noexcept {
+  apply_current_thread_policy(CBThreadRole::Core, "cambang-fshard");
+  for (;;) {
+    CoreFrameShardJob job;
+    {
+      std::unique_lock<std::mutex> lock(shard.mu);
+      shard.work_cv.wait(lock, [&shard] { return shard.stop_requested || !shard.queue.empty(); });
+      // Queued frames hold provider buffers: run them even when stopping.
+      if (shard.queue.empty()) {
+        return;
+      }
+      job = std::move(shard.queue.front());
+      shard.queue.pop_front();
+      shard.busy = true;
+    }
+    CoreFrameShardCompletion c = run_job_(job);
+    {
+      std::lock_guard<std::mutex> lock(completions_mu_);
+      completions_.push_back(std::move(c));
+    }
+    if (wake_) {
+      wake_();
+    }
+    {
+      std::lock_guard<std::mutex> lock(shard.mu);
+      shard.busy = false;
+    }
+    shard.idle_cv.notify_all();
+  }
+}
+
+} // namespace cambang
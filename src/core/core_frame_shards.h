@@ -0,0 +1,130 @@
+// src/core/core_frame_shards.h
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+#include "core/core_result_store.h"
+#include "core/resource_aggregate_telemetry.h"
+#include "imaging/api/provider_contract_datatypes.h"
+
+namespace cambang {
+
+// One repeating stream frame handed from the dispatcher to its device's
+// shard, with the stream record fields retain_frame() needs (read on the
+// core thread when the frame was dispatched).
+struct CoreFrameShardJob {
+  FrameView frame{};
+  ResourceAggregateTelemetry::Handle lease_telemetry{};
+  std::optional<StreamIntent> stream_intent{};
+  uint64_t stream_access_posture_epoch = 0;
+  CoreRetainedProductionPlan stream_requested_retained_plan{};
+};
+
+// What a shard reports back to the core thread for one job.
+struct CoreFrameShardCompletion {
+  uint64_t stream_id = 0;
+  uint64_t device_instance_id = 0;
+  bool retained = false;
+  // The stream had no retained result before this frame.
+  bool first_stream_result = false;
+  // The stream's latest result straight after this frame was retained
+  // (nullptr when it was not). Exact: the shard is the stream's only writer.
+  SharedStreamResultData result{};
+};
+
+// Opt-in per-device executor shards for repeating stream frame retention
+// (CoreRuntime::set_frame_shard_count()).
+//
+// Each device maps to one fixed shard (device_instance_id % shard count), so
+// a device's frames are retained in dispatch order on a single worker while
+// different devices' frames retain in parallel. A worker runs
+// CoreResultStore::retain_frame() (already safe for concurrent writers),
+// releases the provider frame and its lease, and queues a completion; the
+// core thread takes completions on its next tick and applies everything
+// that touches core-thread-only state (stream frame counters, rig frame
+// sets, recorder, exporter, publication). A shard whose queue holds
+// kMaxQueuedFramesPerShard frames refuses more, and the dispatcher drops the
+// frame as it would under ingress backpressure.
+//
+// Threading: start()/stop()/try_post()/wait_idle()/take_completions() from
+// the core thread; stats() from any thread.
+class CoreFrameShards final {
+public:
+  static constexpr size_t kMaxShards = 8;
+  static constexpr size_t kMaxQueuedFramesPerShard = 4;
+
+  struct Stats {
+    uint64_t frames_posted = 0;
+    uint64_t frames_retained = 0;
+    // Refused because the device's shard queue was full.
+    uint64_t frames_rejected_full = 0;
+  };
+
+  CoreFrameShards() = default;
+  ~CoreFrameShards();
+
+  CoreFrameShards(const CoreFrameShards&) = delete;
+  CoreFrameShards& operator=(const CoreFrameShards&) = delete;
+
+  // Starts shard_count workers retaining into store (which must outlive
+  // stop()). wake is called from a worker after each completion is queued.
+  // False if already running, shard_count is 0 or above kMaxShards, or a
+  // worker could not be started.
+  bool start(size_t shard_count, CoreResultStore* store, std::function<void()> wake);
+  // Runs every queued job, then joins the workers. Completions not yet
+  // taken stay queued.
+  void stop() noexcept;
+
+  bool running() const noexcept { return !shards_.empty(); }
+  size_t shard_count() const noexcept { return shards_.size(); }
+  size_t shard_for_device(uint64_t device_instance_id) const noexcept {
+    return shards_.empty() ? 0 : static_cast<size_t>(device_instance_id % shards_.size());
+  }
+
+  // Moves job onto its device's shard. False, leaving job untouched, when
+  // not running or that shard is full.
+  bool try_post(CoreFrameShardJob& job);
+  // Blocks until every shard has run all of its queued jobs.
+  void wait_idle() noexcept;
+  // Appends queued completions to out: each device's in retention order.
+  void take_completions(std::vector<CoreFrameShardCompletion>& out);
+
+  Stats stats() const noexcept;
+
+private:
+  struct Shard {
+    std::mutex mu;
+    std::condition_variable work_cv;
+    std::condition_variable idle_cv;
+    std::deque<CoreFrameShardJob> queue;
+    bool busy = false;
+    bool stop_requested = false;
+    std::thread worker;
+  };
+
+  void worker_main_(Shard& shard) noexcept;
+  CoreFrameShardCompletion run_job_(CoreFrameShardJob& job) noexcept;
+
+  std::vector<std::unique_ptr<Shard>> shards_;
+  CoreResultStore* store_ = nullptr;
+  std::function<void()> wake_{};
+
+  std::mutex completions_mu_;
+  std::vector<CoreFrameShardCompletion> completions_;
+
+  std::atomic<uint64_t> frames_posted_{0};
+  std::atomic<uint64_t> frames_retained_{0};
+  std::atomic<uint64_t> frames_rejected_full_{0};
+};
+
+} // namespace cambang
@@ -0,0 +1,125 @@
+// src/core/core_hdr_histogram.cpp
+
+#include "core/core_hdr_histogram.h"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <limits>
+
+namespace cambang {
+
+namespace {
+
+// Number of recorded values at or below which `percentile` is met.
+uint64_t percentile_rank(double percentile, uint64_t count) noexcept {
+  if (!(percentile > 0.0)) {
+    return 1;
+  }
+  if (percentile >= 100.0) {
+    return count;
+  }
+  const double rank = std::ceil(percentile / 100.0 * static_cast<double>(count));
+  return std::clamp<uint64_t>(static_cast<uint64_t>(rank), 1, count);
+}
+
+} // namespace
+
+size_t CoreHdrHistogram::bucket_index(uint64_t value_ns) noexcept {
+  if (value_ns < kSubBucketCount) {
+    return static_cast<size_t>(value_ns);
+  }
+  const uint32_t exponent = static_cast<uint32_t>(std::bit_width(value_ns)) - 1;
+  if (exponent >= kMaxExponent) {
+    return kBucketCount - 1;
+  }
+  const uint32_t shift = exponent - kSubBucketBits;
+  const uint64_t sub_bucket = (value_ns >> shift) - kSubBucketCount;
+  return kSubBucketCount + static_cast<size_t>(shift) * kSubBucketCount +
+         static_cast<size_t>(sub_bucket);
+}
+
+uint64_t CoreHdrHistogram::bucket_top_ns(size_t index) noexcept {
+  if (index < kSubBucketCount) {
+    return index;
+  }
+  const size_t k = index - kSubBucketCount;
+  const uint32_t shift = static_cast<uint32_t>(k / kSubBucketCount);
+  const uint64_t sub_bucket = kSubBucketCount + k % kSubBucketCount;
+  return ((sub_bucket + 1) << shift) - 1;
+}
+
+void CoreHdrHistogram::record(uint64_t value_ns) noexcept {
+  uint32_t& bucket = counts_[bucket_index(value_ns)];
+  if (bucket != std::numeric_limits<uint32_t>::max()) {
+    ++bucket;
+  }
+  if (count_ == 0 || value_ns < min_ns_) {
+    min_ns_ = value_ns;
+  }
+  max_ns_ = std::max(max_ns_, value_ns);
+  sum_ns_ = value_ns > std::numeric_limits<uint64_t>::max() - sum_ns_
+      ? std::numeric_limits<uint64_t>::max()
+      : sum_ns_ + value_ns;
+  ++count_;
+}
+
+void CoreHdrHistogram::reset() noexcept {
+  counts_.fill(0);
+  count_ = 0;
+  min_ns_ = 0;
+  max_ns_ = 0;
+  sum_ns_ = 0;
+}
+
+uint64_t CoreHdrHistogram::value_at_percentile(double percentile) const noexcept {
+  if (count_ == 0) {
+    return 0;
+  }
+  const uint64_t rank = percentile_rank(percentile, count_);
+  uint64_t seen = 0;
+  for (size_t i = 0; i < kBucketCount; ++i) {
+    seen += counts_[i];
+    if (seen >= rank) {
+      return i == kBucketCount - 1 ? max_ns_ : std::min(bucket_top_ns(i), max_ns_);
+    }
+  }
+  return max_ns_;
+}
+
+CoreHdrHistogram::Summary CoreHdrHistogram::summary() const noexcept {
+  Summary out{};
+  if (count_ == 0) {
+    return out;
+  }
+  out.count = count_;
+  out.min_ns = min_ns_;
+  out.max_ns = max_ns_;
+  out.mean_ns = sum_ns_ / count_;
+
+  uint64_t* const targets[] = {&out.p50_ns, &out.p90_ns, &out.p99_ns, &out.p999_ns};
+  const uint64_t ranks[] = {
+      percentile_rank(50.0, count_),
+      percentile_rank(90.0, count_),
+      percentile_rank(99.0, count_),
+      percentile_rank(99.9, count_),
+  };
+  size_t next = 0;
+  uint64_t seen = 0;
+  for (size_t i = 0; i < kBucketCount && next < 4; ++i) {
+    if (counts_[i] == 0) {
+      continue;
+    }
+    seen += counts_[i];
+    const uint64_t value = i == kBucketCount - 1 ? max_ns_ : std::min(bucket_top_ns(i), max_ns_);
+    while (next < 4 && seen >= ranks[next]) {
+      *targets[next++] = value;
+    }
+  }
+  while (next < 4) {
+    *targets[next++] = max_ns_;
+  }
+  return out;
+}
+
+} // namespace cambang
@@ -0,0 +1,63 @@
+// src/core/core_hdr_histogram.h
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace cambang {
+
+// Constant-memory streaming histogram of nanosecond durations, bucketed the
+// way HdrHistogram does it: each power-of-two range [2^e, 2^(e+1)) is split
+// into kSubBucketCount equal buckets, and values below kSubBucketCount get a
+// bucket each. A reported percentile is the top of its bucket (clamped to the
+// exact maximum), so it is never below the true value and never more than
+// 1/kSubBucketCount (about 3%) above it.
+//
+// Values of 2^kMaxExponent ns (about 18 minutes) or more share the top
+// bucket; max_ns() stays exact.
+//
+// Not thread-safe.
+class CoreHdrHistogram final {
+public:
+  static constexpr uint32_t kSubBucketBits = 5;
+  static constexpr uint32_t kSubBucketCount = 1u << kSubBucketBits;
+  static constexpr uint32_t kMaxExponent = 40;
+  static constexpr size_t kBucketCount =
+      static_cast<size_t>(kSubBucketCount) * (kMaxExponent - kSubBucketBits + 1);
+
+  struct Summary {
+    uint64_t count = 0;
+    uint64_t min_ns = 0;
+    uint64_t max_ns = 0;
+    uint64_t mean_ns = 0;
+    uint64_t p50_ns = 0;
+    uint64_t p90_ns = 0;
+    uint64_t p99_ns = 0;
+    uint64_t p999_ns = 0;
+  };
+
+  void record(uint64_t value_ns) noexcept;
+  void reset() noexcept;
+
+  uint64_t count() const noexcept { return count_; }
+  uint64_t min_ns() const noexcept { return count_ ? min_ns_ : 0; }
+  uint64_t max_ns() const noexcept { return max_ns_; }
+  // Smallest bucket top at or above `percentile` percent of the recorded
+  // values (0 when empty).
+  uint64_t value_at_percentile(double percentile) const noexcept;
+  // All of the above in one pass over the buckets.
+  Summary summary() const noexcept;
+
+  static size_t bucket_index(uint64_t value_ns) noexcept;
+  static uint64_t bucket_top_ns(size_t index) noexcept;
+
+private:
+  std::array<uint32_t, kBucketCount> counts_{};
+  uint64_t count_ = 0;
+  uint64_t min_ns_ = 0;
+  uint64_t max_ns_ = 0;
+  uint64_t sum_ns_ = 0;
+};
+
+} // namespace cambang
@@ -0,0 +1,110 @@
+// src/core/core_id_map.h
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace cambang {
+
+// Contiguous uint64_t-keyed map for core registries.
+//
+// Records live in one vector sorted by key, so lookup is a binary search over
+// contiguous memory and iteration stays in ascending key order (the order
+// snapshot building relies on). Core-issued ids arrive mostly ascending, so
+// inserts normally append.
+//
+// Unlike std::map, inserting or erasing a key invalidates every iterator,
+// pointer and reference into the map. Registries hand out `const Record*`
+// from find(); callers must not hold one across a create/destroy of the same
+// registry. Mutating a found value in place is fine.
+template <typename V>
+class CoreIdMap final {
+public:
+  using value_type = std::pair<uint64_t, V>;
+  using iterator = typename std::vector<value_type>::iterator;
+  using const_iterator = typename std::vector<value_type>::const_iterator;
+
+  iterator begin() noexcept { return entries_.begin(); }
+  iterator end() noexcept { return entries_.end(); }
+  const_iterator begin() const noexcept { return entries_.begin(); }
+  const_iterator end() const noexcept { return entries_.end(); }
+
+  size_t size() const noexcept { return entries_.size(); }
+  bool empty() const noexcept { return entries_.empty(); }
+  void clear() noexcept { entries_.clear(); }
+  void reserve(size_t n) { entries_.reserve(n); }
+
+  iterator find(uint64_t key) noexcept {
+    const iterator it = lower_bound(key);
+    return (it != entries_.end() && it->first == key) ? it : entries_.end();
+  }
+  const_iterator find(uint64_t key) const noexcept {
+    const const_iterator it = lower_bound(key);
+    return (it != entries_.end() && it->first == key) ? it : entries_.end();
+  }
+  size_t count(uint64_t key) const noexcept { return find(key) != end() ? 1 : 0; }
+
+  // std::map::try_emplace semantics: constructs V from `args` only when
+  // `key` is absent.
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(uint64_t key, Args&&... args) {
+    iterator it = lower_bound(key);
+    if (it != entries_.end() && it->first == key) {
+      return {it, false};
+    }
+    it = entries_.emplace(it,
+                          std::piecewise_construct,
+                          std::forward_as_tuple(key),
+                          std::forward_as_tuple(std::forward<Args>(args)...));
+    return {it, true};
+  }
+  std::pair<iterator, bool> emplace(uint64_t key, V value) { return try_emplace(key, std::move(value)); }
+
+  V& operator[](uint64_t key) { return try_emplace(key).first->second; }
+
+  iterator erase(const_iterator it) { return entries_.erase(it); }
+  size_t erase(uint64_t key) {
+    const const_iterator it = find(key);
+    if (it == entries_.end()) {
+      return 0;
+    }
+    entries_.erase(it);
+    return 1;
+  }
+
+  // Removes every entry for which pred(key, value) holds in one compaction
+  // pass, preserving order. Returns the number removed.
+  template <typename Pred>
+  size_t erase_if(Pred&& pred) {
+    const auto first = std::remove_if(entries_.begin(), entries_.end(), [&](value_type& e) {
+      return pred(e.first, e.second);
+    });
+    const size_t removed = static_cast<size_t>(entries_.end() - first);
+    entries_.erase(first, entries_.end());
+    return removed;
+  }
+
+private:
+  iterator lower_bound(uint64_t key) noexcept {
+    if (entries_.empty() || entries_.back().first < key) {
+      return entries_.end();
+    }
+    return std::lower_bound(entries_.begin(), entries_.end(), key,
+                            [](const value_type& e, uint64_t k) { return e.first < k; });
+  }
+  const_iterator lower_bound(uint64_t key) const noexcept {
+    if (entries_.empty() || entries_.back().first < key) {
+      return entries_.end();
+    }
+    return std::lower_bound(entries_.begin(), entries_.end(), key,
+                            [](const value_type& e, uint64_t k) { return e.first < k; });
+  }
+
+  std::vector<value_type> entries_;
+};
+
+} // namespace cambang
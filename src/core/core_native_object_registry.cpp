@@ -2,6 +2,85 @@
 
 namespace cambang {
 
+const CoreNativeObjectRegistry::Record* CoreNativeObjectRegistry::find(uint64_t native_id) const noexcept {
+  const auto it = index_.find(native_id);
+  if (it == index_.end()) {
+    return nullptr;
+  }
+  const Slot& slot = slots_[it->second.slot];
+  if (!slot.live || slot.generation != it->second.generation) {
+    return nullptr;
+  }
+  return &slot.record;
+}
+
+uint32_t CoreNativeObjectRegistry::find_or_allocate(uint64_t native_id) {
+  auto [it, inserted] = index_.try_emplace(native_id);
+  if (!inserted) {
+    return it->second.slot;
+  }
+  uint32_t slot = free_head_;
+  if (slot != kNoSlot) {
+    free_head_ = slots_[slot].next_free;
+  } else {
+    slot = static_cast<uint32_t>(slots_.size());
+    slots_.emplace_back();
+  }
+  Slot& s = slots_[slot];
+  s.live = true;
+  s.next_free = kNoSlot;
+  it->second.slot = slot;
+  it->second.generation = s.generation;
+  s.record.native_id = native_id;
+  return slot;
+}
+
+// Caller drops the index entry (immediately or via drop_released_index_entries()).
+void CoreNativeObjectRegistry::release_slot(uint32_t slot) noexcept {
+  Slot& s = slots_[slot];
+  unlink_retiring(slot);
+  s.record = Record{};
+  s.live = false;
+  ++s.generation;
+  s.next_free = free_head_;
+  free_head_ = slot;
+}
+
+void CoreNativeObjectRegistry::link_retiring(uint32_t slot) noexcept {
+  Slot& s = slots_[slot];
+  const uint64_t at_ns = s.record.destroyed_integration_ns;
+  // Integration time is the core clock, so destroys normally append.
+  uint32_t prev = retire_tail_;
+  while (prev != kNoSlot && slots_[prev].record.destroyed_integration_ns > at_ns) {
+    prev = slots_[prev].retire_prev;
+  }
+  const uint32_t next = (prev == kNoSlot) ? retire_head_ : slots_[prev].retire_next;
+  s.retire_prev = prev;
+  s.retire_next = next;
+  (prev == kNoSlot ? retire_head_ : slots_[prev].retire_next) = slot;
+  (next == kNoSlot ? retire_tail_ : slots_[next].retire_prev) = slot;
+  s.retiring = true;
+}
+
+void CoreNativeObjectRegistry::unlink_retiring(uint32_t slot) noexcept {
+  Slot& s = slots_[slot];
+  if (!s.retiring) {
+    return;
+  }
+  (s.retire_prev == kNoSlot ? retire_head_ : slots_[s.retire_prev].retire_next) = s.retire_next;
+  (s.retire_next == kNoSlot ? retire_tail_ : slots_[s.retire_next].retire_prev) = s.retire_prev;
+  s.retire_prev = kNoSlot;
+  s.retire_next = kNoSlot;
+  s.retiring = false;
+}
+
+size_t CoreNativeObjectRegistry::drop_released_index_entries() {
+  return index_.erase_if([this](uint64_t, const Handle& h) {
+    const Slot& s = slots_[h.slot];
+    return !s.live || s.generation != h.generation;
+  });
+}
+
 void CoreNativeObjectRegistry::on_native_object_created(uint64_t native_id,
                                                        uint32_t type,
                                                        uint64_t root_id,
@@ -14,11 +93,11 @@ void CoreNativeObjectRegistry::on_native_object_created(uint64_t native_id,
                                                        uint32_t buffers_in_use,
                                                        uint64_t creation_gen,
                                                        uint64_t created_ns) {
+  revision_ = next_core_registry_revision();
   if (native_id == 0) {
     return;
   }
-  Record& r = records_[native_id];
-  r.native_id = native_id;
+  Record& r = slots_[find_or_allocate(native_id)].record;
   r.type = type;
   r.root_id = root_id;
   r.owner_device_instance_id = owner_device_instance_id;
@@ -45,82 +124,77 @@ void CoreNativeObjectRegistry::on_native_object_created(uint64_t native_id,
 void CoreNativeObjectRegistry::on_native_object_destroyed(uint64_t native_id,
                                                           uint64_t destroyed_ns,
                                                           uint64_t destroyed_integration_ns) {
+  revision_ = next_core_registry_revision();
   if (native_id == 0) {
     return;
   }
-  auto it = records_.find(native_id);
-  if (it == records_.end()) {
-    // Truth surface should reflect reality, including orphan destroys.
-    // Create an entry so the snapshot can represent the orphan.
-    Record r;
-    r.native_id = native_id;
-    r.destroyed = true;
-    r.destroyed_ns = destroyed_ns;
-    r.destroyed_integration_ns = destroyed_integration_ns;
-    records_.emplace(native_id, r);
-    return;
+  // Truth surface should reflect reality, including orphan destroys:
+  // an unknown id gets an entry so the snapshot can represent the orphan.
+  const uint32_t slot = find_or_allocate(native_id);
+  Record& r = slots_[slot].record;
+  r.destroyed = true;
+  r.destroyed_ns = destroyed_ns;
+  r.destroyed_integration_ns = destroyed_integration_ns;
+  unlink_retiring(slot);
+  link_retiring(slot);
+}
+
+bool CoreNativeObjectRegistry::on_native_object_counters(uint64_t native_id,
+                                                         uint64_t bytes_allocated,
+                                                         uint32_t buffers_in_use) {
+  const auto it = index_.find(native_id);
+  if (it == index_.end()) {
+    return false;
+  }
+  Slot& slot = slots_[it->second.slot];
+  if (!slot.live || slot.generation != it->second.generation) {
+    return false;
   }
-  it->second.destroyed = true;
-  it->second.destroyed_ns = destroyed_ns;
-  it->second.destroyed_integration_ns = destroyed_integration_ns;
+  Record& r = slot.record;
+  if (!r.created || r.destroyed ||
+      (r.bytes_allocated == bytes_allocated && r.buffers_in_use == buffers_in_use)) {
+    return false;
+  }
+  r.bytes_allocated = bytes_allocated;
+  r.buffers_in_use = buffers_in_use;
+  revision_ = next_core_registry_revision();
+  return true;
 }
 
 size_t CoreNativeObjectRegistry::clear_destroyed() {
-  size_t retired = 0;
-  for (auto it = records_.begin(); it != records_.end();) {
-    if (!it->second.destroyed) {
-      ++it;
-      continue;
-    }
-    it = records_.erase(it);
-    ++retired;
+  revision_ = next_core_registry_revision();
+  if (retire_head_ == kNoSlot) {
+    return 0;
   }
-  return retired;
+  while (retire_head_ != kNoSlot) {
+    release_slot(retire_head_);
+  }
+  return drop_released_index_entries();
 }
 
 size_t CoreNativeObjectRegistry::retire_destroyed_older_than(uint64_t now_ns,
                                                              uint64_t retention_window_ns) {
-  size_t retired = 0;
-  for (auto it = records_.begin(); it != records_.end();) {
-    const Record& r = it->second;
-    if (!r.destroyed) {
-      ++it;
-      continue;
-    }
-    if (r.destroyed_integration_ns > now_ns) {
-      ++it;
-      continue;
+  revision_ = next_core_registry_revision();
+  bool any = false;
+  while (retire_head_ != kNoSlot) {
+    const uint64_t at_ns = slots_[retire_head_].record.destroyed_integration_ns;
+    if (at_ns > now_ns || now_ns - at_ns < retention_window_ns) {
+      break;
     }
-    const uint64_t age_ns = now_ns - r.destroyed_integration_ns;
-    if (age_ns < retention_window_ns) {
-      ++it;
-      continue;
-    }
-    it = records_.erase(it);
-    ++retired;
+    release_slot(retire_head_);
+    any = true;
   }
-  return retired;
+  return any ? drop_released_index_entries() : 0;
 }
 
 std::optional<uint64_t> CoreNativeObjectRegistry::next_retirement_delay_ns(
     uint64_t now_ns,
     uint64_t retention_window_ns) const {
-  std::optional<uint64_t> min_delay;
-  for (const auto& [native_id, r] : records_) {
-    (void)native_id;
-    if (!r.destroyed) {
-      continue;
-    }
-    const uint64_t retire_at_ns = r.destroyed_integration_ns + retention_window_ns;
-    uint64_t delay = 0;
-    if (retire_at_ns > now_ns) {
-      delay = retire_at_ns - now_ns;
-    }
-    if (!min_delay.has_value() || delay < *min_delay) {
-      min_delay = delay;
-    }
+  if (retire_head_ == kNoSlot) {
+    return std::nullopt;
   }
-  return min_delay;
+  const uint64_t retire_at_ns = slots_[retire_head_].record.destroyed_integration_ns + retention_window_ns;
+  return retire_at_ns > now_ns ? retire_at_ns - now_ns : 0;
 }
 
 } // namespace cambang
@@ -2,8 +2,12 @@
 
 #include <cstddef>
 #include <cstdint>
-#include <map>
 #include <optional>
+#include <utility>
+#include <vector>
+
+#include "core/core_id_map.h"
+#include "core/core_registry_revision.h"
 
 namespace cambang {
 
@@ -12,6 +16,13 @@ namespace cambang {
 // Maintains the core-truth view of provider-reported native objects.
 // This is the authoritative source for CamBANGStateSnapshot.native_objects.
 //
+// Frame-buffer leases and GPU backings churn per frame, so records live in a
+// slab of reusable slots (free list, generation-tagged so a stale index entry
+// can never resolve to a reused slot) behind a native_id-ordered index.
+// Destroyed records are additionally threaded onto a list ordered by
+// destroyed_integration_ns: retirement pops expired records off its head and
+// the next retirement deadline is the head, so neither scans live records.
+//
 class CoreNativeObjectRegistry final {
 public:
   struct Record {
@@ -50,15 +61,90 @@ public:
   void on_native_object_destroyed(uint64_t native_id,
                                   uint64_t destroyed_ns,
                                   uint64_t destroyed_integration_ns);
+  // Updates a created, not yet destroyed record's counters in place. False
+  // (and no revision bump) when there is no such record or nothing changed.
+  bool on_native_object_counters(uint64_t native_id, uint64_t bytes_allocated, uint32_t buffers_in_use);
 
   size_t retire_destroyed_older_than(uint64_t now_ns, uint64_t retention_window_ns);
   size_t clear_destroyed();
   std::optional<uint64_t> next_retirement_delay_ns(uint64_t now_ns, uint64_t retention_window_ns) const;
 
-  const std::map<uint64_t, Record>& all() const noexcept { return records_; }
+private:
+  struct Handle {
+    uint32_t slot = 0;
+    uint32_t generation = 0;
+  };
+
+public:
+  // Ascending native_id view over the records; elements are
+  // std::pair<uint64_t, const Record&>.
+  class RecordsView final {
+  public:
+    class const_iterator final {
+    public:
+      std::pair<uint64_t, const Record&> operator*() const {
+        return {it_->first, registry_->slots_[it_->second.slot].record};
+      }
+      const_iterator& operator++() {
+        ++it_;
+        return *this;
+      }
+      bool operator==(const const_iterator& o) const { return it_ == o.it_; }
+      bool operator!=(const const_iterator& o) const { return it_ != o.it_; }
+
+    private:
+      friend class RecordsView;
+      const_iterator(const CoreNativeObjectRegistry* registry, CoreIdMap<Handle>::const_iterator it)
+          : registry_(registry), it_(it) {}
+
+      const CoreNativeObjectRegistry* registry_;
+      CoreIdMap<Handle>::const_iterator it_;
+    };
+
+    const_iterator begin() const { return {registry_, registry_->index_.begin()}; }
+    const_iterator end() const { return {registry_, registry_->index_.end()}; }
+    size_t size() const noexcept { return registry_->index_.size(); }
+    bool empty() const noexcept { return registry_->index_.empty(); }
+
+  private:
+    friend class CoreNativeObjectRegistry;
+    explicit RecordsView(const CoreNativeObjectRegistry* registry) : registry_(registry) {}
+
+    const CoreNativeObjectRegistry* registry_;
+  };
+
+  RecordsView all() const noexcept { return RecordsView(this); }
+  // Valid until the next create/destroy/retire on this registry.
+  const Record* find(uint64_t native_id) const noexcept;
+  // Snapshot dirty-tracking stamp (see core_registry_revision.h).
+  uint64_t revision() const noexcept { return revision_; }
 
 private:
-  std::map<uint64_t, Record> records_;
+  static constexpr uint32_t kNoSlot = UINT32_MAX;
+
+  struct Slot {
+    Record record;
+    uint32_t generation = 0;
+    bool live = false;
+    uint32_t next_free = kNoSlot;
+    // Destroyed-record list links (ascending destroyed_integration_ns).
+    bool retiring = false;
+    uint32_t retire_prev = kNoSlot;
+    uint32_t retire_next = kNoSlot;
+  };
+
+  uint32_t find_or_allocate(uint64_t native_id);
+  void release_slot(uint32_t slot) noexcept;
+  void link_retiring(uint32_t slot) noexcept;
+  void unlink_retiring(uint32_t slot) noexcept;
+  size_t drop_released_index_entries();
+
+  std::vector<Slot> slots_;
+  uint32_t free_head_ = kNoSlot;
+  uint32_t retire_head_ = kNoSlot;
+  uint32_t retire_tail_ = kNoSlot;
+  CoreIdMap<Handle> index_; // native_id -> slot
+  uint64_t revision_ = 0;
 };
 
 } // namespace cambang
@@ -0,0 +1,161 @@
+// src/core/core_operation.cpp
+#include "core/core_operation.h"
+
+#include <condition_variable>
+#include <mutex>
+#include <utility>
+
+namespace cambang {
+
+struct CoreOperation::State {
+  mutable std::mutex mu;
+  std::condition_variable resolved_cv;
+  CoreOperationOutcome outcome = CoreOperationOutcome::Pending;
+  uint32_t error_code = 0;
+  std::vector<Callback> callbacks;
+};
+
+CoreOperation CoreOperation::make_pending() {
+  return CoreOperation(std::make_shared<State>());
+}
+
+bool CoreOperation::done() const noexcept {
+  return outcome() != CoreOperationOutcome::Pending;
+}
+
+CoreOperationOutcome CoreOperation::outcome() const noexcept {
+  if (!state_) {
+    return CoreOperationOutcome::Cancelled;
+  }
+  std::lock_guard<std::mutex> lock(state_->mu);
+  return state_->outcome;
+}
+
+uint32_t CoreOperation::error_code() const noexcept {
+  if (!state_) {
+    return 0;
+  }
+  std::lock_guard<std::mutex> lock(state_->mu);
+  return state_->error_code;
+}
+
+CoreOperationOutcome CoreOperation::wait_for(std::chrono::nanoseconds timeout) const {
+  if (!state_) {
+    return CoreOperationOutcome::Cancelled;
+  }
+  std::unique_lock<std::mutex> lock(state_->mu);
+  state_->resolved_cv.wait_for(lock, timeout, [this] {
+    return state_->outcome != CoreOperationOutcome::Pending;
+  });
+  return state_->outcome;
+}
+
+void CoreOperation::on_done(Callback fn) const {
+  if (!fn) {
+    return;
+  }
+  if (!state_) {
+    fn(CoreOperationOutcome::Cancelled, 0);
+    return;
+  }
+  CoreOperationOutcome outcome;
+  uint32_t error_code;
+  {
+    std::lock_guard<std::mutex> lock(state_->mu);
+    if (state_->outcome == CoreOperationOutcome::Pending) {
+      state_->callbacks.push_back(std::move(fn));
+      return;
+    }
+    outcome = state_->outcome;
+    error_code = state_->error_code;
+  }
+  fn(outcome, error_code);
+}
+
+bool CoreOperation::resolve(CoreOperationOutcome outcome, uint32_t error_code) const {
+  if (!state_ || outcome == CoreOperationOutcome::Pending) {
+    return false;
+  }
+  if (outcome != CoreOperationOutcome::Failed) {
+    error_code = 0;
+  }
+  std::vector<Callback> callbacks;
+  {
+    std::lock_guard<std::mutex> lock(state_->mu);
+    if (state_->outcome != CoreOperationOutcome::Pending) {
+      return false;
+    }
+    state_->outcome = outcome;
+    state_->error_code = error_code;
+    callbacks.swap(state_->callbacks);
+  }
+  state_->resolved_cv.notify_all();
+  for (Callback& fn : callbacks) {
+    fn(outcome, error_code);
+  }
+  return true;
+}
+
+bool CoreOperation::await_suspend(std::coroutine_handle<> handle) const {
+  if (!state_) {
+    return false;
+  }
+  std::lock_guard<std::mutex> lock(state_->mu);
+  if (state_->outcome != CoreOperationOutcome::Pending) {
+    return false;
+  }
+  state_->callbacks.push_back([handle](CoreOperationOutcome, uint32_t) { handle.resume(); });
+  return true;
+}
+
+void CoreOperationRegistry::add(Kind kind, uint64_t id, CoreOperation op, uint32_t facts_ahead) {
+  if (!op.valid() || op.done()) {
+    return;
+  }
+  ops_[Key{kind, id}].push_back(Waiter{std::move(op), facts_ahead});
+  ++waiting_;
+}
+
+size_t CoreOperationRegistry::resolve(Kind kind, uint64_t id, CoreOperationOutcome outcome, uint32_t error_code) {
+  const auto it = ops_.find(Key{kind, id});
+  if (it == ops_.end()) {
+    return 0;
+  }
+  // Detach the ones being resolved first: a callback may register another
+  // operation on this key.
+  std::vector<CoreOperation> due;
+  std::vector<Waiter>& waiters = it->second;
+  for (auto w = waiters.begin(); w != waiters.end();) {
+    if (outcome == CoreOperationOutcome::Succeeded && w->facts_ahead > 0) {
+      --w->facts_ahead;
+      ++w;
+      continue;
+    }
+    due.push_back(std::move(w->op));
+    w = waiters.erase(w);
+  }
+  if (waiters.empty()) {
+    ops_.erase(it);
+  }
+  waiting_ -= due.size();
+  size_t resolved = 0;
+  for (const CoreOperation& op : due) {
+    if (op.resolve(outcome, error_code)) {
+      ++resolved;
+    }
+  }
+  return resolved;
+}
+
+void CoreOperationRegistry::resolve_all(CoreOperationOutcome outcome) {
+  std::map<Key, std::vector<Waiter>> ops;
+  ops.swap(ops_);
+  waiting_ = 0;
+  for (const auto& [key, waiters] : ops) {
+    for (const Waiter& w : waiters) {
+      (void)w.op.resolve(outcome);
+    }
+  }
+}
+
+} // namespace cambang
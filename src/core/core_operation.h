@@ -0,0 +1,123 @@
+// src/core/core_operation.h
+#pragma once
+
+#include <chrono>
+#include <coroutine>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <vector>
+
+namespace cambang {
+
+enum class CoreOperationOutcome : uint8_t {
+  Pending = 0,
+  Succeeded = 1,
+  // The provider reported an error fact for the target, the command was
+  // refused, or the target went away first (error_code() says which when
+  // the provider supplied one).
+  Failed = 2,
+  // The runtime stopped, or the stream was destroyed, before any fact.
+  Cancelled = 3,
+};
+
+// Completion handle for an asynchronous CoreRuntime command (the *_async()
+// variants of try_open_device() etc.). The try_* methods report admission
+// only; a CoreOperation resolves when Core integrates the provider fact that
+// finishes the command, so a caller need not poll snapshots for it.
+//
+// Handles are cheap shared references: copies observe the same operation.
+// Resolution happens once, on the core thread. on_done() callbacks and
+// awaiting coroutines then run on the core thread too, like
+// IStateSnapshotPublisher::publish(): keep them short, and hand work off
+// before blocking or issuing a synchronous try_* command (which refuses on
+// the core thread).
+//
+// A default-constructed handle is invalid and reports Cancelled.
+class CoreOperation final {
+public:
+  using Callback = std::function<void(CoreOperationOutcome outcome, uint32_t error_code)>;
+
+  CoreOperation() = default;
+
+  // A new pending operation.
+  static CoreOperation make_pending();
+
+  bool valid() const noexcept { return state_ != nullptr; }
+  bool done() const noexcept;
+  CoreOperationOutcome outcome() const noexcept;
+  // Provider error code of a Failed operation; 0 otherwise.
+  uint32_t error_code() const noexcept;
+
+  // Blocks until resolved or timeout; returns the outcome (Pending on
+  // timeout). Never call from the core thread.
+  CoreOperationOutcome wait_for(std::chrono::nanoseconds timeout) const;
+
+  // Runs fn once with the outcome: now on this thread when already resolved,
+  // otherwise on the thread that resolves it.
+  void on_done(Callback fn) const;
+
+  // First resolution wins; later ones are ignored. Returns whether this call
+  // resolved it. outcome must not be Pending.
+  bool resolve(CoreOperationOutcome outcome, uint32_t error_code = 0) const;
+
+  // co_await support: `CoreOperationOutcome o = co_await op;`.
+  bool await_ready() const noexcept { return done(); }
+  bool await_suspend(std::coroutine_handle<> handle) const;
+  CoreOperationOutcome await_resume() const noexcept { return outcome(); }
+
+private:
+  struct State;
+  explicit CoreOperation(std::shared_ptr<State> state) : state_(std::move(state)) {}
+
+  std::shared_ptr<State> state_;
+};
+
+// Core-thread-only table of operations waiting for a provider fact. The
+// dispatcher resolves them as facts are integrated; CoreRuntime registers
+// them from inside the command's core-thread task, so no fact for the
+// command can be integrated before its operation is waiting.
+class CoreOperationRegistry final {
+public:
+  enum class Kind : uint8_t {
+    DeviceOpen = 0,
+    DeviceClose = 1,
+    StreamStart = 2,
+    StreamStop = 3,
+    Capture = 4,
+  };
+
+  // id: device instance id for device kinds, stream id for stream kinds,
+  // capture id for Capture. facts_ahead counts success facts for earlier
+  // commands on the same target that are still to arrive (e.g. a stream's
+  // pending_core_start_facts beyond this command's own); op lets them pass.
+  void add(Kind kind, uint64_t id, CoreOperation op, uint32_t facts_ahead = 0);
+  // A fact for (kind, id). Succeeded resolves the operations with no facts
+  // ahead and counts one off the rest; Failed and Cancelled resolve all of
+  // them. Returns how many this call resolved.
+  size_t resolve(Kind kind, uint64_t id, CoreOperationOutcome outcome, uint32_t error_code = 0);
+  // Resolves everything still waiting (runtime stop).
+  void resolve_all(CoreOperationOutcome outcome);
+
+  size_t waiting() const noexcept { return waiting_; }
+
+private:
+  struct Key {
+    Kind kind;
+    uint64_t id;
+    bool operator<(const Key& o) const noexcept {
+      return kind != o.kind ? kind < o.kind : id < o.id;
+    }
+  };
+
+  struct Waiter {
+    CoreOperation op;
+    uint32_t facts_ahead = 0;
+  };
+
+  std::map<Key, std::vector<Waiter>> ops_;
+  size_t waiting_ = 0;
+};
+
+} // namespace cambang
@@ -0,0 +1,48 @@
+// src/core/core_publish_pacer.cpp
+
+#include "core/core_publish_pacer.h"
+
+#include <algorithm>
+
+namespace cambang {
+
+void CorePublishPacer::configure(uint32_t max_counter_publishes_per_s) noexcept {
+  max_per_s_ = max_counter_publishes_per_s;
+  reset();
+}
+
+void CorePublishPacer::reset() noexcept {
+  has_last_ = false;
+  last_publish_ns_ = 0;
+  last_build_ns_ = 0;
+  backoff_shift_ = 0;
+}
+
+uint64_t CorePublishPacer::interval_ns() const noexcept {
+  if (max_per_s_ == 0) {
+    return 0;
+  }
+  const uint64_t base_ns = 1000000000ull / max_per_s_;
+  return std::max(base_ns << backoff_shift_, last_build_ns_ * kBuildShareDivisor);
+}
+
+uint64_t CorePublishPacer::delay_ns(uint64_t now_ns) const noexcept {
+  if (!has_last_ || max_per_s_ == 0) {
+    return 0;
+  }
+  const uint64_t due_ns = last_publish_ns_ + interval_ns();
+  return due_ns > now_ns ? due_ns - now_ns : 0;
+}
+
+void CorePublishPacer::note_published(uint64_t now_ns, uint64_t build_ns, bool core_busy) noexcept {
+  has_last_ = true;
+  last_publish_ns_ = now_ns;
+  last_build_ns_ = build_ns;
+  if (!core_busy) {
+    backoff_shift_ = 0;
+  } else if (backoff_shift_ < kMaxBackoffShift) {
+    ++backoff_shift_;
+  }
+}
+
+} // namespace cambang
@@ -0,0 +1,53 @@
+// src/core/core_publish_pacer.h
+#pragma once
+
+#include <cstdint>
+
+namespace cambang {
+
+// Rate policy for snapshot publishes that only move counters.
+//
+// A publish that changes topology (or is the generation's baseline, or part
+// of shutdown) is built on the tick that requested it; CoreRuntime does not
+// consult the pacer for those. Counter-only publishes are spaced at least
+// interval_ns() apart, where the interval is the larger of
+//   - the configured minimum (1 s / max_counter_publishes_per_s), doubled
+//     for every consecutive publish made while the core thread still had
+//     queued work, up to kMaxBackoffShift doublings, and
+//   - kBuildShareDivisor times the last snapshot build's duration, so
+//     snapshot builds take at most about 1/kBuildShareDivisor of the thread.
+// A publish made with the thread idle drops the backoff again.
+// max_counter_publishes_per_s == 0 disables pacing altogether.
+//
+// Threading: core thread only (configure() while the core thread is stopped).
+class CorePublishPacer final {
+public:
+  static constexpr uint32_t kDefaultMaxCounterPublishesPerS = 60;
+  static constexpr uint32_t kMaxBackoffShift = 3;
+  static constexpr uint64_t kBuildShareDivisor = 8;
+
+  void configure(uint32_t max_counter_publishes_per_s) noexcept;
+  uint32_t max_counter_publishes_per_s() const noexcept { return max_per_s_; }
+
+  // Forgets the last publish and the backoff (generation start).
+  void reset() noexcept;
+
+  // Delay before a counter-only publish may be built; 0 = build now.
+  uint64_t delay_ns(uint64_t now_ns) const noexcept;
+
+  // Records a publish that was built at now_ns and took build_ns.
+  // core_busy: the core thread had queued work when it was built.
+  void note_published(uint64_t now_ns, uint64_t build_ns, bool core_busy) noexcept;
+
+  // Current minimum spacing of counter-only publishes.
+  uint64_t interval_ns() const noexcept;
+
+private:
+  uint32_t max_per_s_ = kDefaultMaxCounterPublishesPerS;
+  bool has_last_ = false;
+  uint64_t last_publish_ns_ = 0;
+  uint64_t last_build_ns_ = 0;
+  uint32_t backoff_shift_ = 0;
+};
+
+} // namespace cambang
@@ -0,0 +1,62 @@
+// src/core/core_recycling_allocator.cpp
+
+#include "core/core_recycling_allocator.h"
+
+namespace cambang {
+
+CoreRecyclingBlockPool::~CoreRecyclingBlockPool() {
+  for (void* block : free_) {
+    ::operator delete(block);
+  }
+}
+
+void* CoreRecyclingBlockPool::allocate(size_t bytes) {
+  {
+    std::lock_guard<std::mutex> lock(mu_);
+    if (block_bytes_ == 0) {
+      block_bytes_ = bytes;
+      free_.reserve(kMaxFreeBlocks);
+    }
+    if (bytes == block_bytes_) {
+      if (!free_.empty()) {
+        void* block = free_.back();
+        free_.pop_back();
+        stats_.reused++;
+        return block;
+      }
+      stats_.allocated++;
+    } else {
+      stats_.unpooled++;
+    }
+  }
+  return ::operator new(bytes);
+}
+
+void CoreRecyclingBlockPool::deallocate(void* block, size_t bytes) noexcept {
+  if (!block) {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(mu_);
+    if (bytes == block_bytes_ && free_.size() < kMaxFreeBlocks) {
+      free_.push_back(block);
+      return;
+    }
+    if (bytes == block_bytes_) {
+      stats_.unpooled++;
+    }
+  }
+  ::operator delete(block);
+}
+
+CoreRecyclingBlockPool::Stats CoreRecyclingBlockPool::stats_copy() const noexcept {
+  std::lock_guard<std::mutex> lock(mu_);
+  return stats_;
+}
+
+size_t CoreRecyclingBlockPool::free_block_count() const noexcept {
+  std::lock_guard<std::mutex> lock(mu_);
+  return free_.size();
+}
+
+} // namespace cambang
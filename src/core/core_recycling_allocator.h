@@ -0,0 +1,91 @@
+// src/core/core_recycling_allocator.h
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <vector>
+
+namespace cambang {
+
+// Free list of equally sized heap blocks, for objects allocated once per
+// frame (see CoreRecyclingAllocator).
+//
+// The first allocation fixes the block size; requests of any other size go
+// straight to the global heap. At most kMaxFreeBlocks freed blocks are kept
+// for reuse, the rest are returned to the heap. The pool is reference-counted
+// by its allocators, so a block freed after its store has gone still has a
+// pool to return to.
+//
+// Threading: allocate()/deallocate()/stats_copy() from any thread.
+class CoreRecyclingBlockPool final {
+public:
+  static constexpr size_t kMaxFreeBlocks = 64;
+
+  struct Stats {
+    uint64_t reused = 0;
+    uint64_t allocated = 0;
+    // Wrong size, or freed while the free list was full.
+    uint64_t unpooled = 0;
+  };
+
+  CoreRecyclingBlockPool() = default;
+  ~CoreRecyclingBlockPool();
+
+  CoreRecyclingBlockPool(const CoreRecyclingBlockPool&) = delete;
+  CoreRecyclingBlockPool& operator=(const CoreRecyclingBlockPool&) = delete;
+
+  // Throws std::bad_alloc like operator new.
+  void* allocate(size_t bytes);
+  void deallocate(void* block, size_t bytes) noexcept;
+
+  Stats stats_copy() const noexcept;
+  size_t free_block_count() const noexcept;
+
+private:
+  mutable std::mutex mu_;
+  size_t block_bytes_ = 0;
+  std::vector<void*> free_;
+  Stats stats_{};
+};
+
+// Standard allocator over a shared CoreRecyclingBlockPool, for
+// std::allocate_shared: the object and its control block become one pooled
+// block, and the control block's copy of the allocator keeps the pool alive
+// until the last reference is dropped, on whatever thread that happens.
+template <typename T>
+class CoreRecyclingAllocator final {
+public:
+  using value_type = T;
+
+  explicit CoreRecyclingAllocator(std::shared_ptr<CoreRecyclingBlockPool> pool) noexcept
+      : pool_(std::move(pool)) {}
+  template <typename U>
+  CoreRecyclingAllocator(const CoreRecyclingAllocator<U>& other) noexcept : pool_(other.pool_) {}
+
+  T* allocate(size_t n) {
+    static_assert(alignof(T) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__,
+                  "pooled blocks carry operator new's default alignment");
+    return static_cast<T*>(pool_->allocate(n * sizeof(T)));
+  }
+  void deallocate(T* p, size_t n) noexcept { pool_->deallocate(p, n * sizeof(T)); }
+
+  template <typename U>
+  bool operator==(const CoreRecyclingAllocator<U>& other) const noexcept {
+    return pool_ == other.pool_;
+  }
+  template <typename U>
+  bool operator!=(const CoreRecyclingAllocator<U>& other) const noexcept {
+    return pool_ != other.pool_;
+  }
+
+private:
+  template <typename U>
+  friend class CoreRecyclingAllocator;
+
+  std::shared_ptr<CoreRecyclingBlockPool> pool_;
+};
+
+} // namespace cambang
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+namespace cambang {
+
+// Snapshot dirty-tracking stamp for Core registries.
+//
+// Registries whose snapshot section SnapshotBuilder caches bump their
+// revision() from every mutator that can change a snapshot-visible field.
+// Stamps come from one process-wide counter, so two registry states never
+// share a non-zero stamp, even across registry reassignment at a generation
+// boundary; 0 is only ever an untouched registry.
+// Bumping without a visible change is harmless (the section is rebuilt);
+// missing a bump yields a stale section, so those mutators bump on entry.
+// The capture assembly/cohort registries stamp the same way so
+// CoreDeadlineTable can tell when their retention deadlines need rescanning.
+inline uint64_t next_core_registry_revision() noexcept {
+  static std::atomic<uint64_t> counter{0};
+  return counter.fetch_add(1, std::memory_order_relaxed) + 1;
+}
+
+} // namespace cambang
@@ -1,11 +1,24 @@
 #include "core/core_result_store.h"
-
+#include <algorithm>
+#include <array>
+#include <chrono>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
+#include <iterator>
 #include <limits>
 #include <numeric>
 #include <utility>
+#include <vector>
+
+#include "core/core_capture_fusion.h"
+#include "core/core_capture_thumbnails.h"
+#include "core/core_derived_payload.h"
+#include "core/core_encoded_image.h"
+#include "core/resource_aggregate_telemetry.h"
+#include "imaging/api/async_log.h"
+#include "pixels/convert/packed_swizzle.h"
+#include "pixels/convert/yuv420_to_rgba.h"
 
 namespace cambang {
 
@@ -34,13 +47,23 @@ bool checked_add_size_t(size_t a, size_t b, size_t& out) {
 }
 
 uint32_t infer_bit_depth(uint32_t format_fourcc) {
-  if (format_fourcc == FOURCC_RGBA || format_fourcc == FOURCC_BGRA) {
+  if (format_fourcc == FOURCC_RGBA || format_fourcc == FOURCC_BGRA ||
+      is_planar_yuv420_fourcc(format_fourcc)) {
     return 8;
   }
+  if (format_fourcc == FOURCC_RAW16) {
+    return 16;
+  }
+  if (format_fourcc == FOURCC_RAW10) {
+    return 10;
+  }
   return 0;
 }
 
-CoreImageFactBundle build_default_facts(uint32_t width, uint32_t height, uint32_t format_fourcc) {
+CoreImageFactBundle build_default_facts(uint32_t width,
+                                        uint32_t height,
+                                        uint32_t format_fourcc,
+                                        uint32_t row_stride_bytes) {
   CoreImageFactBundle facts{};
   facts.has_image_properties = true;
   facts.image_properties.width = width;
@@ -48,12 +71,15 @@ CoreImageFactBundle build_default_facts(uint32_t width, uint32_t height, uint32_
   facts.image_properties.format = format_fourcc;
   facts.image_properties.orientation = 0;
   facts.image_properties.bit_depth = infer_bit_depth(format_fourcc);
+  facts.image_properties.row_stride_bytes = row_stride_bytes;
 
   facts.image_properties_provenance.width = ResultFactProvenance::HARDWARE_REPORTED;
   facts.image_properties_provenance.height = ResultFactProvenance::HARDWARE_REPORTED;
   facts.image_properties_provenance.format = ResultFactProvenance::HARDWARE_REPORTED;
   facts.image_properties_provenance.orientation = ResultFactProvenance::UNKNOWN;
   facts.image_properties_provenance.bit_depth = ResultFactProvenance::PROVIDER_DERIVED;
+  facts.image_properties_provenance.row_stride_bytes =
+      row_stride_bytes != 0 ? ResultFactProvenance::PROVIDER_DERIVED : ResultFactProvenance::UNKNOWN;
   return facts;
 }
 
@@ -61,7 +87,8 @@ bool has_valid_result_image_description(const FrameView& frame) {
   if (frame.width == 0 || frame.height == 0) {
     return false;
   }
-  return frame.format_fourcc == FOURCC_RGBA || frame.format_fourcc == FOURCC_BGRA;
+  return frame.format_fourcc == FOURCC_RGBA || frame.format_fourcc == FOURCC_BGRA ||
+         is_planar_yuv420_fourcc(frame.format_fourcc);
 }
 
 bool has_valid_retained_cpu_packed_access_payload(
@@ -77,13 +104,7 @@ bool has_valid_retained_cpu_packed_access_payload(
       payload.format_fourcc != expected_format_fourcc) {
     return false;
   }
-  if (payload.format_fourcc != FOURCC_RGBA && payload.format_fourcc != FOURCC_BGRA) {
-    return false;
-  }
-  const size_t expected_size =
-      static_cast<size_t>(payload.width) * static_cast<size_t>(payload.height) * 4u;
-  return payload.stride_bytes == payload.width * 4u &&
-         payload.size_bytes() >= expected_size;
+  return has_valid_retained_cpu_payload_layout(payload);
 }
 
 CoreRetainedAccessTruth build_stream_retained_access_truth(const CoreStreamResultData& result) {
@@ -108,7 +129,7 @@ CoreRetainedAccessTruth build_stream_retained_access_truth(const CoreStreamResul
     return truth;
   }
 
-  if (result.payload_kind == ResultPayloadKind::CPU_PACKED && has_current_cpu_payload) {
+  if (is_cpu_payload_kind(result.payload_kind) && has_current_cpu_payload) {
     truth.display_view = ResultCapability::CHEAP;
     truth.to_image = ResultCapability::CHEAP;
   }
@@ -139,6 +160,11 @@ CoreRetainedBackingPlan build_retained_backing_plan_from_requested(
     const FrameView& frame,
     bool has_cpu_payload) {
   CoreRetainedBackingPlan plan{};
+  if (is_planar_yuv420_fourcc(frame.format_fourcc)) {
+    plan.primary_kind = ResultPayloadKind::CPU_PLANAR;
+  } else if (is_raw_bayer_fourcc(frame.format_fourcc)) {
+    plan.primary_kind = ResultPayloadKind::RAW_IMAGE;
+  }
   if (!requested.valid) {
     const bool gpu_primary =
         frame.primary_backing_kind == ProducerBackingKind::GPU &&
@@ -295,6 +321,197 @@ uint64_t compute_capture_result_bytes(const CoreCaptureResultData& data) noexcep
   return bytes;
 }
 
+// Capture results are copy-on-write: appending a member or finalizing facts
+// copies a result that may already be handed out. Member payloads therefore
+// keep their bytes behind a shared owner, so those copies share the image
+// bytes instead of duplicating every member while mutex_ is held.
+void share_capture_payload_bytes(CoreResultPayloadCpuPacked& payload) {
+  if (payload.retained_bytes || payload.bytes.empty()) {
+    return;
+  }
+  payload.retained_bytes = std::make_shared<const CpuPayloadBytes>(std::move(payload.bytes));
+  payload.bytes = {};
+}
+
+uint64_t held_gpu_backing_bytes(const std::shared_ptr<void>& backing,
+                                const RetainedGpuBackingDescriptor& descriptor) noexcept {
+  if (!backing || !descriptor.valid) {
+    return 0;
+  }
+  return static_cast<uint64_t>(descriptor.stride_bytes) * static_cast<uint64_t>(descriptor.height);
+}
+
+// Retained-result byte gauges of the resource telemetry: a stream result
+// counts against its stream, a capture result against its acquisition session
+// (or its device when it has none). Changes are gathered while mutex_ is held
+// and published when this goes out of scope -- callers declare it ahead of
+// their lock_guard -- so the telemetry mutex is never taken under mutex_.
+class RetainedByteGaugeChanges final {
+public:
+  RetainedByteGaugeChanges() = default;
+  RetainedByteGaugeChanges(const RetainedByteGaugeChanges&) = delete;
+  RetainedByteGaugeChanges& operator=(const RetainedByteGaugeChanges&) = delete;
+
+  ~RetainedByteGaugeChanges() {
+    ResourceAggregateTelemetry& telemetry = global_resource_aggregate_telemetry();
+    for (size_t i = 0; i < count_; ++i) {
+      publish_(telemetry, inline_[i]);
+    }
+    for (const Change& change : overflow_) {
+      publish_(telemetry, change);
+    }
+  }
+
+  void add(const CoreStreamResultData* result, int64_t sign) noexcept {
+    if (!result || result->stream_id == 0) {
+      return;
+    }
+    record_(TelemetryScope::STREAM,
+            result->stream_id,
+            sign * static_cast<int64_t>(result->payload.size_bytes()),
+            sign * static_cast<int64_t>(held_gpu_backing_bytes(result->retained_gpu_backing,
+                                                                result->retained_gpu_backing_descriptor)));
+  }
+
+  void add(const CoreCaptureResultData* result, int64_t sign) noexcept {
+    if (!result) {
+      return;
+    }
+    int64_t cpu = 0;
+    int64_t gpu = 0;
+    for (uint32_t i = 0; i < result->image_member_count(); ++i) {
+      accumulate_member_(*result->image_member_at(i), sign, cpu, gpu);
+    }
+    record_capture_(*result, cpu, gpu);
+  }
+
+  void add_member(const CoreCaptureResultData& result,
+                  const CoreCaptureResultData::ImageMemberData& member,
+                  int64_t sign) noexcept {
+    int64_t cpu = 0;
+    int64_t gpu = 0;
+    accumulate_member_(member, sign, cpu, gpu);
+    record_capture_(result, cpu, gpu);
+  }
+
+private:
+  struct Change {
+    TelemetryScope scope = TelemetryScope::UNKNOWN;
+    uint64_t owner_id = 0;
+    int64_t cpu_payload_bytes = 0;
+    int64_t gpu_backing_bytes = 0;
+  };
+
+  static void accumulate_member_(const CoreCaptureResultData::ImageMemberData& member,
+                                 int64_t sign,
+                                 int64_t& cpu,
+                                 int64_t& gpu) noexcept {
+    cpu += sign * static_cast<int64_t>(member.payload.size_bytes());
+    gpu += sign * static_cast<int64_t>(held_gpu_backing_bytes(member.retained_gpu_backing,
+                                                               member.retained_gpu_backing_descriptor));
+  }
+
+  void record_capture_(const CoreCaptureResultData& result, int64_t cpu, int64_t gpu) noexcept {
+    if (result.acquisition_session_id != 0) {
+      record_(TelemetryScope::ACQUISITION_SESSION, result.acquisition_session_id, cpu, gpu);
+    } else if (result.device_instance_id != 0) {
+      record_(TelemetryScope::DEVICE, result.device_instance_id, cpu, gpu);
+    }
+  }
+
+  void record_(TelemetryScope scope, uint64_t owner_id, int64_t cpu, int64_t gpu) noexcept {
+    if (cpu == 0 && gpu == 0) {
+      return;
+    }
+    for (size_t i = 0; i < count_; ++i) {
+      if (inline_[i].scope == scope && inline_[i].owner_id == owner_id) {
+        inline_[i].cpu_payload_bytes += cpu;
+        inline_[i].gpu_backing_bytes += gpu;
+        return;
+      }
+    }
+    const Change change{scope, owner_id, cpu, gpu};
+    if (count_ < inline_.size()) {
+      inline_[count_++] = change;
+      return;
+    }
+    // Only the whole-store paths (clear, eviction) get here.
+    try {
+      overflow_.push_back(change);
+    } catch (...) {
+    }
+  }
+
+  static void publish_(ResourceAggregateTelemetry& telemetry, const Change& change) noexcept {
+    ScopedResourceTelemetryKey key;
+    switch (change.scope) {
+      case TelemetryScope::STREAM:
+        key = make_stream_scoped_resource_telemetry(change.owner_id);
+        break;
+      case TelemetryScope::ACQUISITION_SESSION:
+        key = make_acquisition_session_scoped_resource_telemetry(change.owner_id);
+        break;
+      default:
+        key = make_device_scoped_resource_telemetry(change.owner_id);
+        break;
+    }
+    const auto apply = [&](ResourceByteGauge gauge, int64_t delta) {
+      if (delta > 0) {
+        telemetry.bytes_retained(key, gauge, static_cast<uint64_t>(delta));
+      } else if (delta < 0) {
+        telemetry.bytes_released(key, gauge, static_cast<uint64_t>(-delta));
+      }
+    };
+    apply(ResourceByteGauge::RETAINED_CPU_PAYLOAD, change.cpu_payload_bytes);
+    apply(ResourceByteGauge::RETAINED_GPU_BACKING, change.gpu_backing_bytes);
+  }
+
+  std::array<Change, 4> inline_{};
+  size_t count_ = 0;
+  std::vector<Change> overflow_;
+};
+
+uint64_t steady_now_ns() noexcept {
+  return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+// Nanosecond acquisition time of result, when its timing can be compared
+// with a reference in clock_domain.
+bool stream_history_time_ns(const CoreStreamResultData& result,
+                            ImageAcquisitionClockDomain clock_domain,
+                            int64_t& out) noexcept {
+  const auto& timing = result.image_facts.acquisition_timing;
+  if (!timing || timing->value.clock_domain() != clock_domain) {
+    return false;
+  }
+  switch (timing->value.comparability()) {
+    case ImageAcquisitionComparability::SAME_IMAGE_ONLY:
+    case ImageAcquisitionComparability::ORDERING_ONLY:
+      return false;
+    default:
+      return image_acquisition_time_ns(timing->value, out);
+  }
+}
+
+// Packed payloads are summarised across all four channels, planar YUV ones
+// from the Y plane.
+void compute_payload_content_signature(const CoreResultPayloadCpuPacked& payload, ContentSignature& out) noexcept {
+  if (!has_valid_retained_cpu_payload_layout(payload)) {
+    return;
+  }
+  if (payload.is_planar()) {
+    compute_content_signature(payload.data() + payload.planes[0].offset_bytes,
+                              payload.width,
+                              payload.height,
+                              payload.planes[0].row_stride_bytes,
+                              1,
+                              out);
+  } else {
+    compute_content_signature(payload.data(), payload.width, payload.height, payload.stride_bytes, 4, out);
+  }
+}
+
 } // namespace
 
 ResultCapability resolve_result_access_classification(
@@ -404,13 +621,20 @@ bool CoreResultStore::retain_frame(const FrameView& frame,
       frame.capture_id != 0 ? std::make_optional(build_retained_backing_plan_from_requested(capture_requested_retained_plan, frame, has_cpu_payload)) : std::nullopt;
   CoreResultPayloadCpuPacked payload{};
   CoreImageFactBundle facts{};
+  ContentSignature stream_content_signature{};
   if (has_cpu_payload) {
-    if (!CoreResultStore::try_copy_cpu_packed_payload(frame, payload)) {
+    if (!CoreResultStore::try_copy_cpu_packed_payload(frame, payload, cpu_payload_buffer_pool_)) {
       return false;
     }
+    if (frame.stream_id != 0) {
+      // Before taking mutex_: this reads a few dozen payload rows.
+      compute_payload_content_signature(payload, stream_content_signature);
+    }
   }
 
+  RetainedByteGaugeChanges byte_gauges;
   SharedStreamResultData replaced_stream_result;
+  std::vector<SharedStreamResultData> released_stream_history;
   std::lock_guard<std::mutex> lock(mutex_);
   std::shared_ptr<CoreStreamResultData> stream_result;
   MutableCaptureResultData capture_result;
@@ -424,7 +648,7 @@ bool CoreResultStore::retain_frame(const FrameView& frame,
     if (!frame_matches_requested_retained_plan(frame, plan, stream_requested_retained_plan, has_cpu_payload)) {
       return false;
     }
-    if (plan.primary_kind == ResultPayloadKind::CPU_PACKED && !has_cpu_payload) {
+    if (is_cpu_payload_kind(plan.primary_kind) && !has_cpu_payload) {
       return false;
     }
     std::shared_ptr<void> retained_gpu_backing =
@@ -432,7 +656,8 @@ bool CoreResultStore::retain_frame(const FrameView& frame,
     RetainedGpuBackingDescriptor retained_gpu_backing_descriptor =
         build_retained_gpu_backing_descriptor(frame, gpu_primary);
 
-    auto mutable_stream_result = std::make_shared<CoreStreamResultData>();
+    auto mutable_stream_result = std::allocate_shared<CoreStreamResultData>(
+        CoreRecyclingAllocator<CoreStreamResultData>(stream_result_block_pool_));
     mutable_stream_result->stream_id = frame.stream_id;
     mutable_stream_result->device_instance_id = frame.device_instance_id;
     mutable_stream_result->intent = stream_intent.value_or(StreamIntent::PREVIEW);
@@ -442,7 +667,7 @@ bool CoreResultStore::retain_frame(const FrameView& frame,
     mutable_stream_result->payload_kind = plan.primary_kind;
     mutable_stream_result->retained_gpu_backing = std::move(retained_gpu_backing);
     mutable_stream_result->retained_gpu_backing_descriptor = retained_gpu_backing_descriptor;
-    if (plan.primary_kind == ResultPayloadKind::CPU_PACKED || plan.retain_cpu_sidecar) {
+    if (is_cpu_payload_kind(plan.primary_kind) || plan.retain_cpu_sidecar) {
       if (frame.capture_id == 0) {
         mutable_stream_result->payload = std::move(payload);
       } else {
@@ -452,24 +677,43 @@ bool CoreResultStore::retain_frame(const FrameView& frame,
         // route.
         mutable_stream_result->payload = payload;
       }
+      mutable_stream_result->content_signature = stream_content_signature;
     }
     mutable_stream_result->retained_access_truth = build_stream_retained_access_truth(*mutable_stream_result);
-    mutable_stream_result->access_classification =
-        std::make_shared<CoreResultAccessClassificationRecord>();
+    // A reduced CPU sidecar is retained as the payload but is not this
+    // result's image: to_image(), derived payloads, the access posture and the
+    // row-stride fact all see a GPU-primary result without a CPU sidecar.
     const bool stream_has_current_cpu_payload =
-        mutable_stream_result->payload.uses_retained_bytes() || !mutable_stream_result->payload.empty();
-    mutable_stream_result->access_posture = build_stream_access_posture_key(
-        *mutable_stream_result,
-        stream_has_current_cpu_payload,
-        resolve_stream_access_posture_id(
-            *mutable_stream_result, stream_has_current_cpu_payload, stream_applied_access_posture_epoch));
+        (mutable_stream_result->payload.uses_retained_bytes() || !mutable_stream_result->payload.empty()) &&
+        mutable_stream_result->payload.width == mutable_stream_result->image_width &&
+        mutable_stream_result->payload.height == mutable_stream_result->image_height;
+    if (display_only_streams_.count(frame.stream_id) != 0) {
+      // Display-only fast path (set_stream_display_only()): no derived-payload
+      // cache and no access posture (posture_id 0, no classification record),
+      // which also keeps the stream out of access calibration. Retention,
+      // payload lifetime and tracing are unchanged.
+      mutable_stream_result->access_posture = build_stream_access_posture_key(
+          *mutable_stream_result, stream_has_current_cpu_payload, 0);
+    } else {
+      if (stream_has_current_cpu_payload && has_valid_retained_cpu_payload_layout(mutable_stream_result->payload)) {
+        mutable_stream_result->derived_payloads = std::make_shared<CoreDerivedPayloadCache>();
+      }
+      const StreamAccessPosture& stream_posture = resolve_stream_access_posture(
+          *mutable_stream_result, stream_has_current_cpu_payload, stream_applied_access_posture_epoch);
+      mutable_stream_result->access_classification = stream_posture.access_classification;
+      mutable_stream_result->access_posture = build_stream_access_posture_key(
+          *mutable_stream_result,
+          stream_has_current_cpu_payload,
+          stream_posture.posture_id);
+    }
     // Derive from the already-assigned top-level fields (not frame.* again)
     // so image_properties cannot structurally drift from get_width()/
     // get_height()/get_format().
     facts = build_default_facts(
         mutable_stream_result->image_width,
         mutable_stream_result->image_height,
-        mutable_stream_result->image_format_fourcc);
+        mutable_stream_result->image_format_fourcc,
+        stream_has_current_cpu_payload ? mutable_stream_result->payload.stride_bytes : 0);
     mutable_stream_result->image_facts.acquisition_timing = frame.acquisition_timing;
     mutable_stream_result->facts = facts;
     stream_result = std::move(mutable_stream_result);
@@ -480,7 +724,7 @@ bool CoreResultStore::retain_frame(const FrameView& frame,
     if (!frame_matches_requested_retained_plan(frame, plan, capture_requested_retained_plan, has_cpu_payload)) {
       return false;
     }
-    if (plan.primary_kind == ResultPayloadKind::CPU_PACKED && !has_cpu_payload) {
+    if (is_cpu_payload_kind(plan.primary_kind) && !has_cpu_payload) {
       return false;
     }
     if (plan.primary_kind == ResultPayloadKind::GPU_SURFACE && !frame.primary_backing_artifact) {
@@ -521,14 +765,20 @@ bool CoreResultStore::retain_frame(const FrameView& frame,
   }
   // Prepare every container slot before issuing an identity. Afterwards the
   // pointer assignments are the non-throwing retained-truth commit.
+  using StreamSlotTable = LatestResultSlotTable<CoreStreamResultData>;
+  size_t stream_table_slot = StreamSlotTable::kNoSlot;
+  bool claimed_stream_table_slot = false;
   SharedStreamResultData* stream_slot = nullptr;
   MutableCaptureResultData* capture_slot = nullptr;
   bool inserted_stream_slot = false;
   bool inserted_capture_bucket = false;
   bool inserted_capture_slot = false;
   const auto rollback_prepared_slots = [&]() noexcept {
+    if (claimed_stream_table_slot) {
+      latest_stream_results_.release_claim(stream_table_slot);
+    }
     if (inserted_stream_slot) {
-      latest_stream_results_.erase(frame.stream_id);
+      overflow_stream_results_.erase(frame.stream_id);
     }
     if (inserted_capture_slot) {
       auto capture_it = capture_results_by_capture_id_.find(frame.capture_id);
@@ -545,9 +795,17 @@ bool CoreResultStore::retain_frame(const FrameView& frame,
   };
   try {
     if (stream_result) {
-      auto [it, inserted] = latest_stream_results_.try_emplace(frame.stream_id);
-      stream_slot = &it->second;
-      inserted_stream_slot = inserted;
+      // A stream already in the overflow map stays there, so it never has
+      // two homes once a table slot frees up.
+      if (overflow_stream_results_.find(frame.stream_id) == overflow_stream_results_.end()) {
+        stream_table_slot =
+            latest_stream_results_.find_or_claim(frame.stream_id, claimed_stream_table_slot);
+      }
+      if (stream_table_slot == StreamSlotTable::kNoSlot) {
+        auto [it, inserted] = overflow_stream_results_.try_emplace(frame.stream_id);
+        stream_slot = &it->second;
+        inserted_stream_slot = inserted;
+      }
     }
     if (capture_result) {
       auto [capture_it, bucket_inserted] =
@@ -569,21 +827,49 @@ bool CoreResultStore::retain_frame(const FrameView& frame,
   }
   if (stream_result) {
     stream_result->retained_frame_id = retained_frame_id;
+    stream_result->trace_id = frame.trace_id;
+    stream_result->retained_steady_ns = steady_now_ns();
     if (!stream_result->payload.empty()) {
       stream_result->payload_retained_frame_id = retained_frame_id;
     }
     stream_result->retained_access_truth = build_stream_retained_access_truth(*stream_result);
-    replaced_stream_result = std::move(*stream_slot);
-    *stream_slot = std::move(stream_result);
+    byte_gauges.add(stream_result.get(), 1);
+    if (stream_slot) {
+      replaced_stream_result = std::move(*stream_slot);
+      *stream_slot = std::move(stream_result);
+      if (inserted_stream_slot) {
+        overflow_stream_result_count_.fetch_add(1, std::memory_order_release);
+      }
+    } else {
+      replaced_stream_result = latest_stream_results_.exchange(stream_table_slot, std::move(stream_result));
+    }
+    bool kept_in_history = false;
+    if (replaced_stream_result && !stream_histories_.empty()) {
+      const auto history = stream_histories_.find(frame.stream_id);
+      if (history != stream_histories_.end()) {
+        kept_in_history =
+            push_stream_history_locked_(history->second, replaced_stream_result, released_stream_history);
+      }
+    }
+    if (!kept_in_history) {
+      byte_gauges.add(replaced_stream_result.get(), -1);
+    }
+    for (const SharedStreamResultData& released : released_stream_history) {
+      byte_gauges.add(released.get(), -1);
+    }
+    stream_result_revision_.fetch_add(1, std::memory_order_release);
   }
   if (capture_result) {
     capture_result->default_image.retained_frame_id = retained_frame_id;
     const uint64_t old_capture_bytes =
         *capture_slot ? compute_capture_result_bytes(**capture_slot) : 0;
     const uint64_t new_capture_bytes = compute_capture_result_bytes(*capture_result);
+    byte_gauges.add(capture_slot->get(), -1);
+    byte_gauges.add(capture_result.get(), 1);
     *capture_slot = std::move(capture_result);
     total_estimated_capture_bytes_ =
         total_estimated_capture_bytes_ - old_capture_bytes + new_capture_bytes;
+    capture_result_revision_.fetch_add(1, std::memory_order_release);
   }
   const bool retained = frame.stream_id != 0 || frame.capture_id != 0;
   return retained;
@@ -611,6 +897,8 @@ bool CoreResultStore::append_additional_capture_image(
   if (!capture_requested_retained_plan.valid) {
     return false;
   }
+  share_capture_payload_bytes(image_member.payload);
+  RetainedByteGaugeChanges byte_gauges;
   std::lock_guard<std::mutex> lock(mutex_);
   auto cap_it = capture_results_by_capture_id_.find(capture_id);
   if (cap_it == capture_results_by_capture_id_.end()) {
@@ -670,13 +958,19 @@ bool CoreResultStore::append_additional_capture_image(
     // public terminal-gated result API. In the ordinary assembly path the store
     // owns the only reference here, so additional members append without
     // copy-constructing already-retained image payloads.
-    result = std::make_shared<CoreCaptureResultData>(*result);
+    result = make_capture_result_(*result);
+  }
+  // Grown geometrically ahead of the push_back, which then cannot throw
+  // after the retained frame id is issued.
+  if (result->additional_images.size() == result->additional_images.capacity()) {
+    result->additional_images.reserve(std::max<size_t>(4, result->additional_images.size() * 2));
   }
-  result->additional_images.reserve(result->additional_images.size() + 1);
   if (!try_issue_retained_frame_id(image_member.retained_frame_id)) return false;
   const uint64_t added_member_bytes = effective_member_bytes(image_member);
+  byte_gauges.add_member(*result, image_member, 1);
   result->additional_images.push_back(std::move(image_member));
   total_estimated_capture_bytes_ += added_member_bytes;
+  capture_result_revision_.fetch_add(1, std::memory_order_release);
   return true;
 }
 
@@ -690,34 +984,68 @@ bool CoreResultStore::finalize_capture_facts(
     return false;
   }
 
-  std::lock_guard<std::mutex> lock(mutex_);
-  const auto capture_it = capture_results_by_capture_id_.find(capture_id);
-  if (capture_it == capture_results_by_capture_id_.end()) {
-    return false;
-  }
-  const auto device_it = capture_it->second.find(device_instance_id);
-  if (device_it == capture_it->second.end() || !device_it->second ||
-      device_it->second->capture_image_facts_finalized) {
-    return false;
+  // Fact resolution runs outside mutex_ on a private copy of the result, so
+  // stream and capture readers are not held up behind it; the lock is taken
+  // only to read the current result and to publish the finalized one.
+  // share_capture_payload_bytes() keeps that copy free of image bytes.
+  const auto find_result = [&]() -> MutableCaptureResultData* {
+    const auto capture_it = capture_results_by_capture_id_.find(capture_id);
+    if (capture_it == capture_results_by_capture_id_.end()) {
+      return nullptr;
+    }
+    const auto device_it = capture_it->second.find(device_instance_id);
+    if (device_it == capture_it->second.end() || !device_it->second) {
+      return nullptr;
+    }
+    return &device_it->second;
+  };
+  MutableCaptureResultData current;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    MutableCaptureResultData* slot = find_result();
+    if (!slot || (*slot)->capture_image_facts_finalized) {
+      return false;
+    }
+    current = *slot;
   }
 
-  MutableCaptureResultData& result = device_it->second;
-  if (result.use_count() != 1) {
-    result = std::make_shared<CoreCaptureResultData>(*result);
-  }
+  auto result = make_capture_result_(*current);
   result->has_admission_context = admission_context.has_value();
   if (admission_context) {
     result->admission_context = std::move(*admission_context);
   }
-  result->default_image.resolved_image_facts =
-      resolve_image_facts(result->default_image.image_member_index);
-  result->default_image.resolved_image_facts.image.acquisition_timing =
-      result->default_image.acquisition_timing;
-  for (CoreCaptureResultData::ImageMemberData& member : result->additional_images) {
+  for (uint32_t i = 0; i < result->image_member_count(); ++i) {
+    CoreCaptureResultData::ImageMemberData& member = *result->image_member_at(i);
     member.resolved_image_facts = resolve_image_facts(member.image_member_index);
     member.resolved_image_facts.image.acquisition_timing = member.acquisition_timing;
+    // Encoding is a full pass over the image, so it is never CHEAP until the
+    // encoded-image pool (or a first caller) has produced it.
+    if (!member.encoded_image && has_valid_retained_cpu_payload_layout(member.payload)) {
+      member.encoded_image = std::make_shared<CoreEncodedImageSlot>();
+      member.retained_access_truth.encoded_bytes = ResultCapability::EXPENSIVE;
+    }
+    if (!member.derived_payloads && has_valid_retained_cpu_payload_layout(member.payload)) {
+      member.derived_payloads = std::make_shared<CoreDerivedPayloadCache>();
+    }
+    if (!member.thumbnails && has_valid_retained_cpu_payload_layout(member.payload)) {
+      member.thumbnails = std::make_shared<CoreCaptureThumbnailSlot>();
+    }
+  }
+  if (!result->exposure_fusion && can_fuse_capture_exposures(*result)) {
+    result->exposure_fusion = std::make_shared<CoreCaptureFusionSlot>();
   }
   result->capture_image_facts_finalized = true;
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  MutableCaptureResultData* slot = find_result();
+  // A result appended to or removed meanwhile is left as it is.
+  if (!slot || *slot != current) {
+    return false;
+  }
+  // The copy holds the same payloads, so the byte total is unchanged. The
+  // replaced result is released with `current`, after the lock.
+  *slot = std::move(result);
+  capture_result_revision_.fetch_add(1, std::memory_order_release);
   return true;
 }
 
@@ -733,7 +1061,7 @@ bool CoreResultStore::try_build_capture_image_member_data_from_frame(
   if (!frame_matches_requested_retained_plan(frame, plan, requested_retained_plan, has_cpu_payload)) {
     return false;
   }
-  if (plan.primary_kind == ResultPayloadKind::CPU_PACKED) {
+  if (is_cpu_payload_kind(plan.primary_kind)) {
     if (!try_build_capture_image_member_data_from_frame(frame, out_member.payload)) {
       return false;
     }
@@ -769,6 +1097,7 @@ bool CoreResultStore::try_build_capture_image_member_data_from_frame(const Frame
   if (!try_copy_cpu_packed_payload(frame, out_payload)) {
     return false;
   }
+  share_capture_payload_bytes(out_payload);
   const bool valid = has_valid_capture_image_member_payload(out_payload);
   return valid;
 }
@@ -783,7 +1112,7 @@ MutableCaptureResultData CoreResultStore::build_default_image_capture_result(
       frame.capture_image.image_member_index != 0u) {
     return nullptr;
   }
-  auto capture_result = std::make_shared<CoreCaptureResultData>();
+  auto capture_result = make_capture_result_();
   capture_result->capture_id = frame.capture_id;
   capture_result->device_instance_id = frame.device_instance_id;
   capture_result->acquisition_session_id = frame.acquisition_session_id;
@@ -807,17 +1136,19 @@ MutableCaptureResultData CoreResultStore::build_default_image_capture_result(
   }
   capture_result->default_image.acquisition_timing = frame.acquisition_timing;
 
+  capture_result->default_image.payload_kind = plan.primary_kind;
+  if (is_cpu_payload_kind(plan.primary_kind) || plan.retain_cpu_sidecar) {
+    capture_result->default_image.payload = std::move(payload);
+    share_capture_payload_bytes(capture_result->default_image.payload);
+  }
   // Derive from the already-assigned top-level fields (not frame.* again) so
   // image_properties cannot structurally drift from get_width()/get_height()/
   // get_format().
   CoreImageFactBundle facts = build_default_facts(
       capture_result->image_width,
       capture_result->image_height,
-      capture_result->image_format_fourcc);
-  capture_result->default_image.payload_kind = plan.primary_kind;
-  if (plan.primary_kind == ResultPayloadKind::CPU_PACKED || plan.retain_cpu_sidecar) {
-    capture_result->default_image.payload = std::move(payload);
-  }
+      capture_result->image_format_fourcc,
+      capture_result->default_image.payload.empty() ? 0 : capture_result->default_image.payload.stride_bytes);
   capture_result->default_image.retained_gpu_backing = std::move(retained_gpu_backing);
   capture_result->default_image.retained_gpu_backing_descriptor = retained_gpu_backing_descriptor;
   capture_result->default_image.retained_access_truth =
@@ -838,7 +1169,8 @@ bool CoreResultStore::has_valid_capture_image_member_payload(const CoreResultPay
   if (payload.width == 0 || payload.height == 0) {
     return false;
   }
-  if (payload.format_fourcc != FOURCC_RGBA && payload.format_fourcc != FOURCC_BGRA) {
+  if (payload.format_fourcc != FOURCC_RGBA && payload.format_fourcc != FOURCC_BGRA &&
+      !is_planar_yuv420_fourcc(payload.format_fourcc) && !is_raw_bayer_fourcc(payload.format_fourcc)) {
     return false;
   }
   if (payload.empty()) {
@@ -848,55 +1180,97 @@ bool CoreResultStore::has_valid_capture_image_member_payload(const CoreResultPay
 }
 
 
-bool CoreResultStore::StreamAccessPostureDomainKey::operator<(
-    const StreamAccessPostureDomainKey& other) const noexcept {
-  if (stream_id != other.stream_id) return stream_id < other.stream_id;
-  if (applied_epoch != other.applied_epoch) return applied_epoch < other.applied_epoch;
-  if (width != other.width) return width < other.width;
-  if (height != other.height) return height < other.height;
-  if (format_fourcc != other.format_fourcc) return format_fourcc < other.format_fourcc;
-  if (payload_kind != other.payload_kind) return payload_kind < other.payload_kind;
-  if (has_retained_cpu_payload != other.has_retained_cpu_payload) {
-    return has_retained_cpu_payload < other.has_retained_cpu_payload;
-  }
-  if (has_retained_gpu_backing != other.has_retained_gpu_backing) {
-    return has_retained_gpu_backing < other.has_retained_gpu_backing;
-  }
-  if (gpu_materialization_available != other.gpu_materialization_available) {
-    return gpu_materialization_available < other.gpu_materialization_available;
-  }
-  return gpu_materialization_requires_readback < other.gpu_materialization_requires_readback;
+namespace {
+
+uint64_t mix_posture_key_word(uint64_t h, uint64_t word) noexcept {
+  h ^= word + 0x9e3779b97f4a7c15ull + (h << 6) + (h >> 2);
+  return h;
 }
 
-bool CoreResultStore::CaptureAccessPostureDomainKey::operator<(
-    const CaptureAccessPostureDomainKey& other) const noexcept {
-  if (device_instance_id != other.device_instance_id) return device_instance_id < other.device_instance_id;
-  if (applied_epoch != other.applied_epoch) return applied_epoch < other.applied_epoch;
-  if (width != other.width) return width < other.width;
-  if (height != other.height) return height < other.height;
-  if (format_fourcc != other.format_fourcc) return format_fourcc < other.format_fourcc;
-  if (payload_kind != other.payload_kind) return payload_kind < other.payload_kind;
-  if (has_retained_cpu_payload != other.has_retained_cpu_payload) {
-    return has_retained_cpu_payload < other.has_retained_cpu_payload;
-  }
-  if (has_retained_gpu_backing != other.has_retained_gpu_backing) {
-    return has_retained_gpu_backing < other.has_retained_gpu_backing;
+// Postures one stream or device keeps. A member of a capture admitted
+// before a reconfiguration still arrives under the older epoch and must get
+// that epoch's id, so recent epochs stay; only the owner's oldest epochs go
+// once it exceeds this.
+constexpr size_t kMaxAccessPosturesPerOwner = 16;
+
+// Only runs when the posture `kept` is first seen, so scanning the
+// (owner-bounded) table is fine. `kept` itself always stays.
+template <typename Table, typename Key>
+void retire_surplus_access_postures(Table& table, const Key& kept) {
+  for (;;) {
+    size_t owned = 0;
+    uint64_t oldest_epoch = std::numeric_limits<uint64_t>::max();
+    uint64_t newest_epoch = kept.applied_epoch;
+    for (const auto& [key, value] : table) {
+      if (key.owner_id != kept.owner_id) {
+        continue;
+      }
+      ++owned;
+      newest_epoch = std::max(newest_epoch, key.applied_epoch);
+      if (!(key == kept)) {
+        oldest_epoch = std::min(oldest_epoch, key.applied_epoch);
+      }
+    }
+    // Never retire the newest epoch: a posture flood within one epoch is
+    // left alone rather than churning live ids.
+    if (owned <= kMaxAccessPosturesPerOwner || oldest_epoch >= newest_epoch) {
+      return;
+    }
+    for (auto it = table.begin(); it != table.end();) {
+      if (it->first.owner_id == kept.owner_id && it->first.applied_epoch == oldest_epoch &&
+          !(it->first == kept)) {
+        it = table.erase(it);
+      } else {
+        ++it;
+      }
+    }
   }
-  if (gpu_materialization_available != other.gpu_materialization_available) {
-    return gpu_materialization_available < other.gpu_materialization_available;
+}
+
+template <typename Table>
+void retire_owner_access_postures(Table& table, uint64_t owner_id) {
+  for (auto it = table.begin(); it != table.end();) {
+    if (it->first.owner_id == owner_id) {
+      it = table.erase(it);
+    } else {
+      ++it;
+    }
   }
-  return gpu_materialization_requires_readback < other.gpu_materialization_requires_readback;
 }
 
-uint64_t CoreResultStore::resolve_stream_access_posture_id(
+} // namespace
+
+void CoreResultStore::AccessPostureDomainKey::seal() noexcept {
+  uint64_t h = mix_posture_key_word(0, owner_id);
+  h = mix_posture_key_word(h, applied_epoch);
+  h = mix_posture_key_word(h, (uint64_t(width) << 32) | height);
+  h = mix_posture_key_word(
+      h,
+      (uint64_t(format_fourcc) << 32) | (uint64_t(static_cast<uint8_t>(payload_kind)) << 8) |
+          (uint64_t(has_retained_cpu_payload) << 3) | (uint64_t(has_retained_gpu_backing) << 2) |
+          (uint64_t(gpu_materialization_available) << 1) | uint64_t(gpu_materialization_requires_readback));
+  hash = static_cast<size_t>(h);
+}
+
+bool CoreResultStore::AccessPostureDomainKey::operator==(
+    const AccessPostureDomainKey& other) const noexcept {
+  return hash == other.hash && owner_id == other.owner_id && applied_epoch == other.applied_epoch &&
+         width == other.width && height == other.height && format_fourcc == other.format_fourcc &&
+         payload_kind == other.payload_kind && has_retained_cpu_payload == other.has_retained_cpu_payload &&
+         has_retained_gpu_backing == other.has_retained_gpu_backing &&
+         gpu_materialization_available == other.gpu_materialization_available &&
+         gpu_materialization_requires_readback == other.gpu_materialization_requires_readback;
+}
+
+const CoreResultStore::StreamAccessPosture& CoreResultStore::resolve_stream_access_posture(
     const CoreStreamResultData& result,
     bool has_current_cpu_payload,
     uint64_t applied_epoch) {
   if (applied_epoch == 0) {
     applied_epoch = 1;
   }
-  StreamAccessPostureDomainKey key{};
-  key.stream_id = result.stream_id;
+  AccessPostureDomainKey key{};
+  key.owner_id = result.stream_id;
   key.applied_epoch = applied_epoch;
   key.width = result.image_width;
   key.height = result.image_height;
@@ -908,9 +1282,12 @@ uint64_t CoreResultStore::resolve_stream_access_posture_id(
                                       result.retained_gpu_backing_descriptor.materialization_available;
   key.gpu_materialization_requires_readback = result.retained_gpu_backing_descriptor.valid &&
                                              result.retained_gpu_backing_descriptor.materialization_requires_gpu_readback;
-  auto [it, inserted] = stream_access_posture_ids_.emplace(key, 0);
+  key.seal();
+  auto [it, inserted] = stream_access_posture_ids_.try_emplace(key);
   if (inserted) {
-    it->second = next_posture_id(next_result_access_posture_id_);
+    retire_surplus_access_postures(stream_access_posture_ids_, it->first);
+    it->second.posture_id = next_posture_id(next_result_access_posture_id_);
+    it->second.access_classification = std::make_shared<CoreResultAccessClassificationRecord>();
   }
   return it->second;
 }
@@ -923,8 +1300,8 @@ uint64_t CoreResultStore::resolve_capture_member_access_posture_id(
   if (applied_epoch == 0) {
     applied_epoch = 1;
   }
-  CaptureAccessPostureDomainKey key{};
-  key.device_instance_id = device_instance_id;
+  AccessPostureDomainKey key{};
+  key.owner_id = device_instance_id;
   key.applied_epoch = applied_epoch;
   key.width = member.payload.width != 0 ? member.payload.width : member.retained_gpu_backing_descriptor.width;
   key.height = member.payload.height != 0 ? member.payload.height : member.retained_gpu_backing_descriptor.height;
@@ -938,17 +1315,25 @@ uint64_t CoreResultStore::resolve_capture_member_access_posture_id(
                                       member.retained_gpu_backing_descriptor.materialization_available;
   key.gpu_materialization_requires_readback = member.retained_gpu_backing_descriptor.valid &&
                                              member.retained_gpu_backing_descriptor.materialization_requires_gpu_readback;
+  key.seal();
   auto [it, inserted] = capture_access_posture_ids_.emplace(key, 0);
   if (inserted) {
+    retire_surplus_access_postures(capture_access_posture_ids_, it->first);
     it->second = next_posture_id(next_result_access_posture_id_);
   }
   return it->second;
 }
 
 SharedStreamResultData CoreResultStore::get_latest_stream_result(uint64_t stream_id) const {
+  if (SharedStreamResultData result = latest_stream_results_.find(stream_id)) {
+    return result;
+  }
+  if (overflow_stream_result_count_.load(std::memory_order_acquire) == 0) {
+    return nullptr;
+  }
   std::lock_guard<std::mutex> lock(mutex_);
-  auto it = latest_stream_results_.find(stream_id);
-  if (it == latest_stream_results_.end()) {
+  auto it = overflow_stream_results_.find(stream_id);
+  if (it == overflow_stream_results_.end()) {
     return nullptr;
   }
   return it->second;
@@ -981,30 +1366,296 @@ std::vector<SharedCaptureResultData> CoreResultStore::get_capture_result_set(uin
   return out;
 }
 
+bool CoreResultStore::is_stream_history_eligible(const CoreStreamResultData& result) noexcept {
+  return !result.retained_gpu_backing && !result.payload.empty() &&
+         result.payload_retained_frame_id == result.retained_frame_id &&
+         has_valid_retained_cpu_payload_layout(result.payload);
+}
+
+bool CoreResultStore::push_stream_history_locked_(StreamHistory& history,
+                                                  const SharedStreamResultData& result,
+                                                  std::vector<SharedStreamResultData>& released) {
+  if (!result || !is_stream_history_eligible(*result) ||
+      result->payload.size_bytes() > history.max_bytes) {
+    return false;
+  }
+  try {
+    history.frames.push_back(result);
+    released.reserve(history.frames.size());
+  } catch (...) {
+    if (!history.frames.empty() && history.frames.back() == result) {
+      history.frames.pop_back();
+    }
+    return false;
+  }
+  history.bytes += result->payload.size_bytes();
+  trim_stream_history_locked_(history, released);
+  return true;
+}
+
+void CoreResultStore::trim_stream_history_locked_(StreamHistory& history,
+                                                  std::vector<SharedStreamResultData>& released) {
+  while (!history.frames.empty() &&
+         (history.frames.size() > history.max_frames || history.bytes > history.max_bytes)) {
+    const uint64_t bytes = history.frames.front()->payload.size_bytes();
+    history.bytes = bytes <= history.bytes ? history.bytes - bytes : 0;
+    // reserve() above / in the callers keeps this push from allocating.
+    released.push_back(std::move(history.frames.front()));
+    history.frames.pop_front();
+  }
+}
+
+void CoreResultStore::apply_stream_history_limits_locked_(uint64_t stream_id,
+                                                          size_t history_max_frames,
+                                                          uint64_t history_max_bytes,
+                                                          uint64_t jitter_latency_ns,
+                                                          std::vector<SharedStreamResultData>& released) {
+  if (history_max_frames == 0 || history_max_bytes == 0) {
+    history_max_frames = 0;
+    history_max_bytes = 0;
+  }
+  auto it = stream_histories_.find(stream_id);
+  if (history_max_frames == 0 && jitter_latency_ns == 0) {
+    if (it != stream_histories_.end()) {
+      released.assign(std::make_move_iterator(it->second.frames.begin()),
+                      std::make_move_iterator(it->second.frames.end()));
+      stream_histories_.erase(it);
+    }
+    return;
+  }
+  if (it == stream_histories_.end()) {
+    it = stream_histories_.try_emplace(stream_id).first;
+  }
+  StreamHistory& history = it->second;
+  history.history_max_frames = history_max_frames;
+  history.history_max_bytes = history_max_bytes;
+  history.jitter_latency_ns = jitter_latency_ns;
+  history.max_frames = history_max_frames;
+  history.max_bytes = history_max_bytes;
+  if (jitter_latency_ns != 0) {
+    history.max_frames = std::max(history.max_frames, kJitterBufferFrames);
+    history.max_bytes = std::max(history.max_bytes, kJitterBufferMaxBytes);
+  }
+  released.reserve(history.frames.size());
+  trim_stream_history_locked_(history, released);
+}
+
+void CoreResultStore::set_stream_history_limits(uint64_t stream_id, size_t max_frames, uint64_t max_bytes) {
+  if (stream_id == 0) {
+    return;
+  }
+  RetainedByteGaugeChanges byte_gauges;
+  std::vector<SharedStreamResultData> released;
+  std::lock_guard<std::mutex> lock(mutex_);
+  const auto it = stream_histories_.find(stream_id);
+  const uint64_t jitter_latency_ns = it == stream_histories_.end() ? 0 : it->second.jitter_latency_ns;
+  apply_stream_history_limits_locked_(stream_id, max_frames, max_bytes, jitter_latency_ns, released);
+  for (const SharedStreamResultData& result : released) {
+    byte_gauges.add(result.get(), -1);
+  }
+}
+
+void CoreResultStore::set_stream_jitter_buffer_latency(uint64_t stream_id, uint64_t latency_ns) {
+  if (stream_id == 0) {
+    return;
+  }
+  RetainedByteGaugeChanges byte_gauges;
+  std::vector<SharedStreamResultData> released;
+  std::lock_guard<std::mutex> lock(mutex_);
+  const auto it = stream_histories_.find(stream_id);
+  const bool has_history = it != stream_histories_.end();
+  apply_stream_history_limits_locked_(stream_id,
+                                      has_history ? it->second.history_max_frames : 0,
+                                      has_history ? it->second.history_max_bytes : 0,
+                                      latency_ns,
+                                      released);
+  for (const SharedStreamResultData& result : released) {
+    byte_gauges.add(result.get(), -1);
+  }
+}
+
+uint64_t CoreResultStore::stream_jitter_buffer_latency_ns(uint64_t stream_id) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  const auto it = stream_histories_.find(stream_id);
+  return it == stream_histories_.end() ? 0 : it->second.jitter_latency_ns;
+}
+
+void CoreResultStore::set_stream_display_only(uint64_t stream_id, bool enabled) {
+  if (stream_id == 0) {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (enabled) {
+    display_only_streams_.insert(stream_id);
+  } else {
+    display_only_streams_.erase(stream_id);
+  }
+}
+
+bool CoreResultStore::stream_display_only(uint64_t stream_id) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return display_only_streams_.count(stream_id) != 0;
+}
+
+SharedStreamResultData CoreResultStore::select_stream_result_for_display(uint64_t stream_id,
+                                                                         uint64_t display_steady_ns) const {
+  SharedStreamResultData latest = get_latest_stream_result(stream_id);
+  if (!latest) {
+    return nullptr;
+  }
+  std::vector<SharedStreamResultData> candidates;
+  uint64_t latency_ns = 0;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const auto it = stream_histories_.find(stream_id);
+    if (it == stream_histories_.end() || it->second.jitter_latency_ns == 0) {
+      return latest;
+    }
+    latency_ns = it->second.jitter_latency_ns;
+    candidates.reserve(it->second.frames.size() + 1);
+    candidates.assign(it->second.frames.begin(), it->second.frames.end());
+  }
+  candidates.push_back(latest);
+
+  // Acquisition times comparable with the latest result's; the offset to
+  // steady_clock is the smallest seen, the frame that arrived soonest after
+  // acquisition.
+  const auto& latest_timing = latest->image_facts.acquisition_timing;
+  const bool has_clock = latest_timing && latest_timing->value.clock_domain() != ImageAcquisitionClockDomain::DOMAIN_OPAQUE;
+  std::vector<int64_t> acquired_ns(candidates.size(), 0);
+  std::vector<bool> has_acquired(candidates.size(), false);
+  bool has_offset = false;
+  int64_t offset_ns = 0;
+  for (size_t i = 0; has_clock && i < candidates.size(); ++i) {
+    int64_t time_ns = 0;
+    if (!stream_history_time_ns(*candidates[i], latest_timing->value.clock_domain(), time_ns)) {
+      continue;
+    }
+    acquired_ns[i] = time_ns;
+    has_acquired[i] = true;
+    const int64_t offset = static_cast<int64_t>(candidates[i]->retained_steady_ns) - time_ns;
+    if (!has_offset || offset < offset_ns) {
+      offset_ns = offset;
+      has_offset = true;
+    }
+  }
+  const int64_t target_ns = static_cast<int64_t>(display_steady_ns) - static_cast<int64_t>(latency_ns);
+  SharedStreamResultData best;
+  int64_t best_ns = 0;
+  for (size_t i = 0; i < candidates.size(); ++i) {
+    const int64_t shown_ns = has_acquired[i] ? acquired_ns[i] + offset_ns
+                                             : static_cast<int64_t>(candidates[i]->retained_steady_ns);
+    if (shown_ns <= target_ns && (!best || shown_ns >= best_ns)) {
+      best = candidates[i];
+      best_ns = shown_ns;
+    }
+  }
+  // Every candidate is still in the future: show the oldest.
+  return best ? best : candidates.front();
+}
+
+SharedStreamResultData CoreResultStore::find_stream_history_result(
+    uint64_t stream_id,
+    const ImageAcquisitionTiming& reference) const {
+  int64_t reference_ns = 0;
+  if (stream_id == 0 || reference.clock_domain() == ImageAcquisitionClockDomain::DOMAIN_OPAQUE ||
+      !image_acquisition_time_ns(reference, reference_ns)) {
+    return nullptr;
+  }
+  SharedStreamResultData best;
+  uint64_t best_distance = 0;
+  const auto consider = [&](const SharedStreamResultData& result) {
+    int64_t time_ns = 0;
+    if (!result || !is_stream_history_eligible(*result) ||
+        !stream_history_time_ns(*result, reference.clock_domain(), time_ns)) {
+      return;
+    }
+    // Both times are non-negative, so the difference cannot overflow.
+    const uint64_t distance = time_ns >= reference_ns
+        ? static_cast<uint64_t>(time_ns - reference_ns)
+        : static_cast<uint64_t>(reference_ns - time_ns);
+    if (!best || distance < best_distance) {
+      best = result;
+      best_distance = distance;
+    }
+  };
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const auto it = stream_histories_.find(stream_id);
+    if (it == stream_histories_.end()) {
+      return nullptr;
+    }
+    for (const SharedStreamResultData& result : it->second.frames) {
+      consider(result);
+    }
+  }
+  // Newer than every kept frame, so it is considered last.
+  consider(get_latest_stream_result(stream_id));
+  return best;
+}
+
+size_t CoreResultStore::stream_history_frame_count(uint64_t stream_id) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  const auto it = stream_histories_.find(stream_id);
+  return it == stream_histories_.end() ? 0 : it->second.frames.size();
+}
+
+size_t CoreResultStore::stream_history_max_frames(uint64_t stream_id) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  const auto it = stream_histories_.find(stream_id);
+  return it == stream_histories_.end() ? 0 : it->second.max_frames;
+}
+
 void CoreResultStore::remove_stream_result(uint64_t stream_id) {
   if (stream_id == 0) {
     return;
   }
+  RetainedByteGaugeChanges byte_gauges;
   SharedStreamResultData removed_stream_result;
+  StreamHistory removed_history;
   {
     std::lock_guard<std::mutex> lock(mutex_);
-    auto it = latest_stream_results_.find(stream_id);
-    if (it != latest_stream_results_.end()) {
+    if (auto history = stream_histories_.find(stream_id); history != stream_histories_.end()) {
+      removed_history = std::move(history->second);
+      stream_histories_.erase(history);
+    }
+    display_only_streams_.erase(stream_id);
+    removed_stream_result = latest_stream_results_.erase(stream_id);
+    auto it = overflow_stream_results_.find(stream_id);
+    if (it != overflow_stream_results_.end()) {
       removed_stream_result = std::move(it->second);
-      latest_stream_results_.erase(it);
+      overflow_stream_results_.erase(it);
+      overflow_stream_result_count_.fetch_sub(1, std::memory_order_release);
     }
-    stream_display_demand_last_seen_ns_.erase(stream_id);
-    stream_display_demand_refcounts_.erase(stream_id);
+    if (removed_stream_result) {
+      stream_result_revision_.fetch_add(1, std::memory_order_release);
+    }
+    byte_gauges.add(removed_stream_result.get(), -1);
+    retire_owner_access_postures(stream_access_posture_ids_, stream_id);
+  }
+  remove_stream_display_demand_(stream_id);
+  for (const SharedStreamResultData& result : removed_history.frames) {
+    byte_gauges.add(result.get(), -1);
   }
 }
 
+void CoreResultStore::retire_device_access_postures(uint64_t device_instance_id) {
+  if (device_instance_id == 0) {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  retire_owner_access_postures(capture_access_posture_ids_, device_instance_id);
+}
+
 void CoreResultStore::remove_capture_result(uint64_t capture_id, uint64_t device_instance_id) {
   if (capture_id == 0 || device_instance_id == 0) {
     return;
   }
+  RetainedByteGaugeChanges byte_gauges;
   MutableCaptureResultData removed;
   {
     std::lock_guard<std::mutex> lock(mutex_);
+    evictable_capture_results_.erase(std::make_pair(capture_id, device_instance_id));
     auto capture_it = capture_results_by_capture_id_.find(capture_id);
     if (capture_it == capture_results_by_capture_id_.end()) {
       return;
@@ -1014,6 +1665,7 @@ void CoreResultStore::remove_capture_result(uint64_t capture_id, uint64_t device
       return;
     }
     removed = std::move(device_it->second);
+    byte_gauges.add(removed.get(), -1);
     if (removed) {
       const uint64_t removed_bytes = compute_capture_result_bytes(*removed);
       total_estimated_capture_bytes_ =
@@ -1023,101 +1675,283 @@ void CoreResultStore::remove_capture_result(uint64_t capture_id, uint64_t device
     if (capture_it->second.empty()) {
       capture_results_by_capture_id_.erase(capture_it);
     }
+    capture_result_revision_.fetch_add(1, std::memory_order_release);
   }
   // removed's destructor (releasing any retained CPU/GPU payload) runs here,
   // outside the lock.
 }
 
 std::vector<CoreResultStore::EvictedCaptureResult> CoreResultStore::evict_over_byte_budget(
-    uint64_t byte_budget,
-    const std::function<bool(uint64_t capture_id, uint64_t device_instance_id)>& is_evictable) {
-  std::vector<MutableCaptureResultData> released;
+    uint64_t byte_budget) {
+  RetainedByteGaugeChanges byte_gauges;
   std::vector<EvictedCaptureResult> evicted;
-  {
-    std::lock_guard<std::mutex> lock(mutex_);
-    auto capture_it = capture_results_by_capture_id_.begin();
-    while (total_estimated_capture_bytes_ > byte_budget &&
-           capture_it != capture_results_by_capture_id_.end()) {
-      auto device_it = capture_it->second.begin();
-      while (total_estimated_capture_bytes_ > byte_budget &&
-             device_it != capture_it->second.end()) {
-        if (!is_evictable || !is_evictable(capture_it->first, device_it->first)) {
-          ++device_it;
-          continue;
-        }
-        MutableCaptureResultData& entry = device_it->second;
-        if (entry) {
-          const uint64_t entry_bytes = compute_capture_result_bytes(*entry);
-          total_estimated_capture_bytes_ =
-              entry_bytes <= total_estimated_capture_bytes_ ? total_estimated_capture_bytes_ - entry_bytes : 0;
-        }
-        evicted.push_back(EvictedCaptureResult{capture_it->first, device_it->first});
-        released.push_back(std::move(entry));
-        device_it = capture_it->second.erase(device_it);
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (const bool unreferenced_only : {true, false}) {
+    auto key_it = evictable_capture_results_.begin();
+    while (total_estimated_capture_bytes_ > byte_budget && key_it != evictable_capture_results_.end()) {
+      const auto [capture_id, device_instance_id] = *key_it;
+      const auto capture_it = capture_results_by_capture_id_.find(capture_id);
+      if (capture_it == capture_results_by_capture_id_.end()) {
+        ++key_it;
+        continue;
+      }
+      const auto device_it = capture_it->second.find(device_instance_id);
+      if (device_it == capture_it->second.end()) {
+        ++key_it;
+        continue;
+      }
+      MutableCaptureResultData& entry = device_it->second;
+      // Readers only copy entries under mutex_, so use_count() is stable here.
+      if (unreferenced_only && entry && entry.use_count() != 1) {
+        ++key_it;
+        continue;
       }
+      byte_gauges.add(entry.get(), -1);
+      if (entry) {
+        const uint64_t entry_bytes = compute_capture_result_bytes(*entry);
+        total_estimated_capture_bytes_ =
+            entry_bytes <= total_estimated_capture_bytes_ ? total_estimated_capture_bytes_ - entry_bytes : 0;
+      }
+      evicted.push_back(EvictedCaptureResult{capture_id, device_instance_id, std::move(entry)});
+      capture_it->second.erase(device_it);
       if (capture_it->second.empty()) {
-        capture_it = capture_results_by_capture_id_.erase(capture_it);
-      } else {
-        ++capture_it;
+        capture_results_by_capture_id_.erase(capture_it);
       }
+      key_it = evictable_capture_results_.erase(key_it);
     }
   }
-  // released's destructor (freeing every evicted entry's CPU/GPU payload)
-  // runs here, outside the lock, so a concurrent get_latest_stream_result()/
-  // get_capture_result() reader is never blocked behind deallocation work.
+  if (!evicted.empty()) {
+    capture_result_revision_.fetch_add(1, std::memory_order_release);
+  }
+  // The evicted results (and every payload only they hold) travel in the
+  // returned vector, so they are freed by the caller after this lock is
+  // released and a concurrent get_latest_stream_result()/get_capture_result()
+  // reader is never blocked behind deallocation work.
   return evicted;
 }
 
+void CoreResultStore::mark_capture_results_evictable(
+    const std::vector<std::pair<uint64_t, uint64_t>>& pairs) {
+  if (pairs.empty()) {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (const auto& pair : pairs) {
+    if (pair.first != 0 && pair.second != 0) {
+      evictable_capture_results_.insert(pair);
+    }
+  }
+}
+
 uint64_t CoreResultStore::total_estimated_capture_bytes() const {
   std::lock_guard<std::mutex> lock(mutex_);
   return total_estimated_capture_bytes_;
 }
 
+CoreResultStore::TableSizes CoreResultStore::table_sizes() const {
+  TableSizes out;
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (const auto& [capture_id, by_device] : capture_results_by_capture_id_) {
+    (void)capture_id;
+    out.capture_results += by_device.size();
+  }
+  out.evictable_capture_results = evictable_capture_results_.size();
+  out.stream_histories = stream_histories_.size();
+  out.stream_access_postures = stream_access_posture_ids_.size();
+  out.capture_access_postures = capture_access_posture_ids_.size();
+  return out;
+}
+
 
 void CoreResultStore::clear() {
-  std::map<uint64_t, SharedStreamResultData> old_stream_results;
+  std::vector<SharedStreamResultData> old_stream_results;
+  std::map<uint64_t, SharedStreamResultData> old_overflow_stream_results;
   std::map<uint64_t, std::map<uint64_t, MutableCaptureResultData>> old_capture_results;
+  std::map<uint64_t, StreamHistory> old_stream_histories;
+  old_stream_results.reserve(LatestResultSlotTable<CoreStreamResultData>::kSlots);
+  RetainedByteGaugeChanges byte_gauges;
   {
     std::lock_guard<std::mutex> lock(mutex_);
-    old_stream_results.swap(latest_stream_results_);
+    latest_stream_results_.clear([&old_stream_results](SharedStreamResultData&& result) {
+      old_stream_results.push_back(std::move(result));
+    });
+    old_overflow_stream_results.swap(overflow_stream_results_);
+    overflow_stream_result_count_.store(0, std::memory_order_release);
     old_capture_results.swap(capture_results_by_capture_id_);
+    old_stream_histories.swap(stream_histories_);
+    display_only_streams_.clear();
     total_estimated_capture_bytes_ = 0;
-    stream_display_demand_last_seen_ns_.clear();
-    stream_display_demand_refcounts_.clear();
+    evictable_capture_results_.clear();
     stream_access_posture_ids_.clear();
     capture_access_posture_ids_.clear();
+    stream_result_revision_.fetch_add(1, std::memory_order_release);
+    capture_result_revision_.fetch_add(1, std::memory_order_release);
+  }
+  {
+    std::lock_guard<std::mutex> lock(display_demand_mutex_);
+    for (DisplayDemandSlot& slot : display_demand_slots_) {
+      slot.refcount.store(0, std::memory_order_relaxed);
+      slot.last_seen_ns.store(kNoDisplayDemandSeen, std::memory_order_relaxed);
+      slot.stream_id.store(0, std::memory_order_release);
+    }
+    stream_display_demand_last_seen_ns_.clear();
+    stream_display_demand_refcounts_.clear();
+    stream_deliveries_.clear();
+    overflow_display_demand_count_.store(0, std::memory_order_release);
+  }
+  for (const SharedStreamResultData& result : old_stream_results) {
+    byte_gauges.add(result.get(), -1);
+  }
+  for (const auto& [stream_id, result] : old_overflow_stream_results) {
+    byte_gauges.add(result.get(), -1);
+  }
+  for (const auto& [stream_id, history] : old_stream_histories) {
+    for (const SharedStreamResultData& result : history.frames) {
+      byte_gauges.add(result.get(), -1);
+    }
+  }
+  for (const auto& [capture_id, by_device] : old_capture_results) {
+    for (const auto& [device_instance_id, result] : by_device) {
+      byte_gauges.add(result.get(), -1);
+    }
   }
 }
 
-void CoreResultStore::mark_stream_display_demand(uint64_t stream_id, uint64_t now_ns) {
-  if (stream_id == 0) {
-    return;
+bool CoreResultStore::has_latest_stream_result_(uint64_t stream_id) const {
+  if (latest_stream_results_.contains(stream_id)) {
+    return true;
+  }
+  if (overflow_stream_result_count_.load(std::memory_order_acquire) == 0) {
+    return false;
   }
   std::lock_guard<std::mutex> lock(mutex_);
-  const auto result_it = latest_stream_results_.find(stream_id);
-  if (result_it == latest_stream_results_.end()) {
-    stream_display_demand_last_seen_ns_.erase(stream_id);
+  return overflow_stream_results_.find(stream_id) != overflow_stream_results_.end();
+}
+
+CoreResultStore::DisplayDemandSlot* CoreResultStore::find_display_demand_slot_(uint64_t stream_id) const noexcept {
+  for (DisplayDemandSlot& slot : display_demand_slots_) {
+    if (slot.stream_id.load(std::memory_order_acquire) == stream_id) {
+      return &slot;
+    }
+  }
+  return nullptr;
+}
+
+CoreResultStore::DisplayDemandSlot* CoreResultStore::find_or_claim_display_demand_slot_locked_(
+    uint64_t stream_id) noexcept {
+  if (DisplayDemandSlot* slot = find_display_demand_slot_(stream_id)) {
+    return slot;
+  }
+  // A stream already in the overflow maps stays there, so it never has two
+  // homes once a slot frees up.
+  if (stream_display_demand_last_seen_ns_.count(stream_id) != 0 ||
+      stream_display_demand_refcounts_.count(stream_id) != 0) {
+    return nullptr;
+  }
+  for (DisplayDemandSlot& slot : display_demand_slots_) {
+    if (slot.stream_id.load(std::memory_order_relaxed) == 0) {
+      slot.last_seen_ns.store(kNoDisplayDemandSeen, std::memory_order_relaxed);
+      slot.refcount.store(0, std::memory_order_relaxed);
+      slot.stream_id.store(stream_id, std::memory_order_release);
+      return &slot;
+    }
+  }
+  return nullptr;
+}
+
+void CoreResultStore::remove_stream_display_demand_(uint64_t stream_id) {
+  std::lock_guard<std::mutex> lock(display_demand_mutex_);
+  if (DisplayDemandSlot* slot = find_display_demand_slot_(stream_id)) {
+    slot->refcount.store(0, std::memory_order_relaxed);
+    slot->last_seen_ns.store(kNoDisplayDemandSeen, std::memory_order_relaxed);
+    slot->stream_id.store(0, std::memory_order_release);
+  }
+  stream_display_demand_last_seen_ns_.erase(stream_id);
+  stream_display_demand_refcounts_.erase(stream_id);
+  stream_deliveries_.erase(stream_id);
+  overflow_display_demand_count_.store(
+      stream_display_demand_last_seen_ns_.size() + stream_display_demand_refcounts_.size(),
+      std::memory_order_release);
+}
+
+void CoreResultStore::note_stream_result_displayed(const CoreStreamResultData& result) {
+  if (result.stream_id == 0 || result.retained_frame_id == 0 ||
+      !has_latest_stream_result_(result.stream_id)) {
+    return;
+  }
+  const uint64_t now_ns = steady_now_ns();
+  std::lock_guard<std::mutex> lock(display_demand_mutex_);
+  StreamDelivery& delivery = stream_deliveries_[result.stream_id];
+  if (delivery.last_retained_frame_id == result.retained_frame_id) {
     return;
   }
-  stream_display_demand_last_seen_ns_[stream_id] = now_ns;
+  delivery.last_retained_frame_id = result.retained_frame_id;
+  delivery.pacing.record(now_ns, 0);
+  delivery.latency.record(now_ns > result.retained_steady_ns ? now_ns - result.retained_steady_ns : 0);
 }
 
-void CoreResultStore::retain_stream_display_demand(uint64_t stream_id) {
+bool CoreResultStore::get_stream_delivery_stats(uint64_t stream_id, StreamDeliveryStats& out) const {
+  std::lock_guard<std::mutex> lock(display_demand_mutex_);
+  const auto it = stream_deliveries_.find(stream_id);
+  if (it == stream_deliveries_.end()) {
+    return false;
+  }
+  out.pacing = it->second.pacing.summary();
+  out.latency = it->second.latency.summary();
+  return true;
+}
+
+void CoreResultStore::mark_stream_display_demand(uint64_t stream_id, uint64_t now_ns) {
   if (stream_id == 0) {
     return;
   }
-  std::lock_guard<std::mutex> lock(mutex_);
-  if (latest_stream_results_.find(stream_id) == latest_stream_results_.end()) {
+  const bool has_result = has_latest_stream_result_(stream_id);
+  if (DisplayDemandSlot* slot = find_display_demand_slot_(stream_id)) {
+    slot->last_seen_ns.store(has_result ? now_ns : kNoDisplayDemandSeen, std::memory_order_release);
     return;
   }
-  uint32_t& refs = stream_display_demand_refcounts_[stream_id];
-  if (refs != std::numeric_limits<uint32_t>::max()) {
-    refs += 1u;
+  if (!has_result && overflow_display_demand_count_.load(std::memory_order_acquire) == 0) {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(display_demand_mutex_);
+  if (!has_result) {
+    stream_display_demand_last_seen_ns_.erase(stream_id);
+  } else if (DisplayDemandSlot* slot = find_or_claim_display_demand_slot_locked_(stream_id)) {
+    slot->last_seen_ns.store(now_ns, std::memory_order_release);
+  } else {
+    stream_display_demand_last_seen_ns_[stream_id] = now_ns;
+  }
+  overflow_display_demand_count_.store(
+      stream_display_demand_last_seen_ns_.size() + stream_display_demand_refcounts_.size(),
+      std::memory_order_release);
+}
+
+void CoreResultStore::retain_stream_display_demand(uint64_t stream_id) {
+  if (stream_id == 0 || !has_latest_stream_result_(stream_id)) {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(display_demand_mutex_);
+  uint32_t refs = 0;
+  if (DisplayDemandSlot* slot = find_or_claim_display_demand_slot_locked_(stream_id)) {
+    refs = slot->refcount.load(std::memory_order_relaxed);
+    if (refs != std::numeric_limits<uint32_t>::max()) {
+      refs += 1u;
+    }
+    slot->refcount.store(refs, std::memory_order_release);
+  } else {
+    uint32_t& overflow_refs = stream_display_demand_refcounts_[stream_id];
+    if (overflow_refs != std::numeric_limits<uint32_t>::max()) {
+      overflow_refs += 1u;
+    }
+    refs = overflow_refs;
+    overflow_display_demand_count_.store(
+        stream_display_demand_last_seen_ns_.size() + stream_display_demand_refcounts_.size(),
+        std::memory_order_release);
   }
   if (display_demand_trace_enabled()) {
-    std::printf("[CamBANG][DemandTrace] retain stream_id=%llu refcount=%u\n",
-                static_cast<unsigned long long>(stream_id),
-                refs);
+    async_log_printf(stdout, "[CamBANG][DemandTrace] retain stream_id=%llu refcount=%u\n",
+                     static_cast<unsigned long long>(stream_id),
+                     refs);
   }
 }
 
@@ -1125,24 +1959,32 @@ void CoreResultStore::release_stream_display_demand(uint64_t stream_id) {
   if (stream_id == 0) {
     return;
   }
-  std::lock_guard<std::mutex> lock(mutex_);
-  auto it = stream_display_demand_refcounts_.find(stream_id);
-  if (it == stream_display_demand_refcounts_.end()) {
-    return;
-  }
-  if (it->second <= 1u) {
-    if (display_demand_trace_enabled()) {
-      std::printf("[CamBANG][DemandTrace] release stream_id=%llu refcount=0\n",
-                  static_cast<unsigned long long>(stream_id));
+  std::lock_guard<std::mutex> lock(display_demand_mutex_);
+  uint32_t refs = 0;
+  if (DisplayDemandSlot* slot = find_display_demand_slot_(stream_id)) {
+    refs = slot->refcount.load(std::memory_order_relaxed);
+    if (refs == 0u) {
+      return;
+    }
+    slot->refcount.store(--refs, std::memory_order_release);
+  } else {
+    auto it = stream_display_demand_refcounts_.find(stream_id);
+    if (it == stream_display_demand_refcounts_.end()) {
+      return;
+    }
+    if (it->second <= 1u) {
+      stream_display_demand_refcounts_.erase(it);
+      overflow_display_demand_count_.store(
+          stream_display_demand_last_seen_ns_.size() + stream_display_demand_refcounts_.size(),
+          std::memory_order_release);
+    } else {
+      refs = --it->second;
     }
-    stream_display_demand_refcounts_.erase(it);
-    return;
   }
-  it->second -= 1u;
   if (display_demand_trace_enabled()) {
-    std::printf("[CamBANG][DemandTrace] release stream_id=%llu refcount=%u\n",
-                static_cast<unsigned long long>(stream_id),
-                it->second);
+    async_log_printf(stdout, "[CamBANG][DemandTrace] release stream_id=%llu refcount=%u\n",
+                     static_cast<unsigned long long>(stream_id),
+                     refs);
   }
 }
 
@@ -1157,19 +1999,37 @@ CoreResultStore::DisplayDemandState CoreResultStore::get_stream_display_demand_s
   if (stream_id == 0) {
     return state;
   }
-  std::lock_guard<std::mutex> lock(mutex_);
-  const auto ref_it = stream_display_demand_refcounts_.find(stream_id);
-  if (ref_it != stream_display_demand_refcounts_.end() && ref_it->second > 0u) {
+  uint32_t refcount = 0;
+  uint64_t last_seen_ns = kNoDisplayDemandSeen;
+  bool found = false;
+  if (const DisplayDemandSlot* slot = find_display_demand_slot_(stream_id)) {
+    refcount = slot->refcount.load(std::memory_order_acquire);
+    last_seen_ns = slot->last_seen_ns.load(std::memory_order_acquire);
+    found = slot->stream_id.load(std::memory_order_acquire) == stream_id;
+    if (!found) {
+      return state;
+    }
+  }
+  if (!found && overflow_display_demand_count_.load(std::memory_order_acquire) != 0) {
+    std::lock_guard<std::mutex> lock(display_demand_mutex_);
+    if (const auto ref_it = stream_display_demand_refcounts_.find(stream_id);
+        ref_it != stream_display_demand_refcounts_.end()) {
+      refcount = ref_it->second;
+    }
+    if (const auto it = stream_display_demand_last_seen_ns_.find(stream_id);
+        it != stream_display_demand_last_seen_ns_.end()) {
+      last_seen_ns = it->second;
+    }
+  }
+  if (refcount > 0u) {
     state.active = true;
     state.reason = DisplayDemandReason::PERSISTENT_REFCOUNT;
-    state.refcount = ref_it->second;
+    state.refcount = refcount;
     return state;
   }
-  const auto it = stream_display_demand_last_seen_ns_.find(stream_id);
-  if (it == stream_display_demand_last_seen_ns_.end()) {
+  if (last_seen_ns == kNoDisplayDemandSeen) {
     return state;
   }
-  const uint64_t last_seen_ns = it->second;
   if (now_ns < last_seen_ns) {
     state.active = true;
     state.reason = DisplayDemandReason::LEASE;
@@ -1180,27 +2040,76 @@ CoreResultStore::DisplayDemandState CoreResultStore::get_stream_display_demand_s
   return state;
 }
 
-bool CoreResultStore::try_copy_cpu_packed_payload(const FrameView& frame, CoreResultPayloadCpuPacked& out) {
-  if (!has_cpu_packed_payload(frame)) {
-    return false;
+uint8_t* CoreResultStore::prepare_copied_payload_storage(CoreResultPayloadCpuPacked& out,
+                                                        size_t dst_size,
+                                                        CpuPayloadBufferPool* pool) {
+  if (pool) {
+    CpuPayloadBufferKey key{};
+    key.width = out.width;
+    key.height = out.height;
+    key.stride_bytes = out.stride_bytes;
+    key.format_fourcc = out.format_fourcc;
+    key.size_bytes = dst_size;
+    if (std::shared_ptr<CpuPayloadBytes> pooled = pool->acquire(key)) {
+      uint8_t* dst = pooled->data();
+      out.bytes.clear();
+      out.retained_bytes = std::move(pooled);
+      return dst;
+    }
   }
+  if (dst_size > out.bytes.max_size()) {
+    return nullptr;
+  }
+  out.retained_bytes.reset();
+  out.bytes.resize(dst_size);
+  return out.bytes.data();
+}
 
-  if (!(frame.format_fourcc == FOURCC_RGBA || frame.format_fourcc == FOURCC_BGRA)) {
+bool CoreResultStore::try_copy_cpu_packed_payload(const FrameView& frame,
+                                                  CoreResultPayloadCpuPacked& out,
+                                                  CpuPayloadBufferPool* pool) {
+  if (!has_cpu_packed_payload(frame)) {
     return false;
   }
-  if (frame.width > (std::numeric_limits<uint32_t>::max() / 4u)) {
+  // A reduced CPU sidecar rides on a GPU-primary RGBA/BGRA frame; the bytes
+  // are the sidecar image, smaller than the frame's width/height.
+  const bool reduced_sidecar = frame.cpu_sidecar_width != 0 || frame.cpu_sidecar_height != 0;
+  if (is_planar_yuv420_fourcc(frame.format_fourcc)) {
+    return !reduced_sidecar && try_copy_cpu_planar_payload(frame, out, pool);
+  }
+  if (reduced_sidecar &&
+      (frame.primary_backing_kind != ProducerBackingKind::GPU || is_raw_bayer_fourcc(frame.format_fourcc) ||
+       frame.cpu_sidecar_width == 0 || frame.cpu_sidecar_height == 0 ||
+       frame.cpu_sidecar_width > frame.width || frame.cpu_sidecar_height > frame.height)) {
     return false;
   }
+  const uint32_t width = reduced_sidecar ? frame.cpu_sidecar_width : frame.width;
+  const uint32_t height = reduced_sidecar ? frame.cpu_sidecar_height : frame.height;
 
+  // RAW formats take the same single-plane path: their rows are copied (or
+  // adopted) byte for byte, never unpacked.
   size_t row_bytes = 0;
-  if (!checked_mul_size_t(static_cast<size_t>(frame.width), 4u, row_bytes)) {
-    return false;
+  if (is_raw_bayer_fourcc(frame.format_fourcc)) {
+    row_bytes = raw_bayer_row_bytes(frame.format_fourcc, width);
+    if (row_bytes == 0) {
+      return false;
+    }
+  } else {
+    if (!(frame.format_fourcc == FOURCC_RGBA || frame.format_fourcc == FOURCC_BGRA)) {
+      return false;
+    }
+    if (width > (std::numeric_limits<uint32_t>::max() / 4u)) {
+      return false;
+    }
+    if (!checked_mul_size_t(static_cast<size_t>(width), 4u, row_bytes)) {
+      return false;
+    }
   }
   const size_t src_stride = (frame.stride_bytes == 0) ? row_bytes : static_cast<size_t>(frame.stride_bytes);
   if (src_stride < row_bytes) {
     return false;
   }
-  const size_t h = static_cast<size_t>(frame.height);
+  const size_t h = static_cast<size_t>(height);
   size_t stride_span = 0;
   if (h > 1u && !checked_mul_size_t(h - 1u, src_stride, stride_span)) {
     return false;
@@ -1216,30 +2125,32 @@ bool CoreResultStore::try_copy_cpu_packed_payload(const FrameView& frame, CoreRe
   }
 
   out.format_fourcc = frame.format_fourcc;
-  out.width = frame.width;
-  out.height = frame.height;
+  out.width = width;
+  out.height = height;
   out.stride_bytes = static_cast<uint32_t>(row_bytes);
 
-  const bool can_adopt_tightly_packed_owner =
+  // An owner whose bytes start at the frame is adopted as is. RGBA/BGRA
+  // keeps the provider's row stride (padded rows included); RAW stays
+  // tightly packed, so a padded RAW owner is still packed below.
+  const bool keeps_source_stride = !is_raw_bayer_fourcc(frame.format_fourcc);
+  const bool can_adopt_owner =
       frame.cpu_payload_owner &&
-      src_stride == row_bytes &&
+      (src_stride == row_bytes || keeps_source_stride) &&
       frame.data == frame.cpu_payload_owner->data() &&
-      frame.cpu_payload_owner->size() >= dst_size &&
-      frame.size_bytes >= dst_size;
-  if (can_adopt_tightly_packed_owner) {
+      frame.cpu_payload_owner->size() >= needed;
+  if (can_adopt_owner) {
+    out.stride_bytes = static_cast<uint32_t>(src_stride);
     out.bytes.clear();
     out.retained_bytes = frame.cpu_payload_owner;
     return true;
   }
 
-  if (dst_size > out.bytes.max_size()) {
+  uint8_t* dst = prepare_copied_payload_storage(out, dst_size, pool);
+  if (!dst) {
     return false;
   }
-  out.retained_bytes.reset();
-  out.bytes.resize(dst_size);
 
   const uint8_t* src = frame.data;
-  uint8_t* dst = out.bytes.data();
   for (size_t y = 0; y < h; ++y) {
     std::memcpy(dst, src, row_bytes);
     src += src_stride;
@@ -1249,6 +2160,84 @@ bool CoreResultStore::try_copy_cpu_packed_payload(const FrameView& frame, CoreRe
   return true;
 }
 
+bool CoreResultStore::try_copy_cpu_planar_payload(const FrameView& frame,
+                                                  CoreResultPayloadCpuPacked& out,
+                                                  CpuPayloadBufferPool* pool) {
+  const uint32_t plane_count = planar_yuv420_plane_count(frame.format_fourcc);
+  if (plane_count == 0 || frame.plane_count != plane_count) {
+    return false;
+  }
+  CoreResultPayloadPlane layout[kMaxFramePlanes]{};
+  uint32_t rows[kMaxFramePlanes]{};
+  const size_t dst_size =
+      planar_yuv420_tight_layout(frame.format_fourcc, frame.width, frame.height, layout, rows);
+  if (dst_size == 0) {
+    return false;
+  }
+
+  bool owner_backs_tight_layout = static_cast<bool>(frame.cpu_payload_owner) &&
+                                  frame.cpu_payload_owner->size() >= dst_size;
+  for (uint32_t i = 0; i < plane_count; ++i) {
+    const FramePlaneView& plane = frame.planes[i];
+    const size_t row_bytes = layout[i].row_stride_bytes;
+    const size_t src_stride =
+        plane.row_stride_bytes == 0 ? row_bytes : static_cast<size_t>(plane.row_stride_bytes);
+    if (!plane.data || src_stride < row_bytes) {
+      return false;
+    }
+    size_t stride_span = 0;
+    size_t needed = 0;
+    if (!checked_mul_size_t(static_cast<size_t>(rows[i] - 1u), src_stride, stride_span) ||
+        !checked_add_size_t(stride_span, row_bytes, needed) ||
+        plane.size_bytes < needed) {
+      return false;
+    }
+    if (owner_backs_tight_layout &&
+        (src_stride != row_bytes ||
+         plane.data != frame.cpu_payload_owner->data() + layout[i].offset_bytes)) {
+      owner_backs_tight_layout = false;
+    }
+  }
+
+  out.format_fourcc = frame.format_fourcc;
+  out.width = frame.width;
+  out.height = frame.height;
+  out.stride_bytes = layout[0].row_stride_bytes;
+  out.plane_count = plane_count;
+  for (uint32_t i = 0; i < kMaxFramePlanes; ++i) {
+    out.planes[i] = layout[i];
+  }
+
+  if (owner_backs_tight_layout) {
+    out.bytes.clear();
+    out.retained_bytes = frame.cpu_payload_owner;
+    return true;
+  }
+
+  uint8_t* const base = prepare_copied_payload_storage(out, dst_size, pool);
+  if (!base) {
+    return false;
+  }
+  for (uint32_t i = 0; i < plane_count; ++i) {
+    const FramePlaneView& plane = frame.planes[i];
+    const size_t row_bytes = layout[i].row_stride_bytes;
+    const size_t src_stride =
+        plane.row_stride_bytes == 0 ? row_bytes : static_cast<size_t>(plane.row_stride_bytes);
+    const uint8_t* src = plane.data;
+    uint8_t* dst = base + layout[i].offset_bytes;
+    if (src_stride == row_bytes) {
+      std::memcpy(dst, src, row_bytes * rows[i]);
+      continue;
+    }
+    for (uint32_t y = 0; y < rows[i]; ++y) {
+      std::memcpy(dst, src, row_bytes);
+      src += src_stride;
+      dst += row_bytes;
+    }
+  }
+  return true;
+}
+
 bool CoreResultStore::has_cpu_packed_payload(const FrameView& frame) {
   return frame.width != 0 &&
          frame.height != 0 &&
@@ -1256,4 +2245,150 @@ bool CoreResultStore::has_cpu_packed_payload(const FrameView& frame) {
          frame.size_bytes != 0;
 }
 
+size_t planar_yuv420_tight_layout(
+    uint32_t format_fourcc,
+    uint32_t width,
+    uint32_t height,
+    CoreResultPayloadPlane (&out_planes)[kMaxFramePlanes],
+    uint32_t (&out_rows)[kMaxFramePlanes]) noexcept {
+  for (uint32_t i = 0; i < kMaxFramePlanes; ++i) {
+    out_planes[i] = CoreResultPayloadPlane{};
+    out_rows[i] = 0;
+  }
+  const uint32_t plane_count = planar_yuv420_plane_count(format_fourcc);
+  if (plane_count == 0 || width == 0 || height == 0 ||
+      width > std::numeric_limits<uint32_t>::max() - 1u) {
+    return 0;
+  }
+  const uint32_t chroma_width = (width + 1u) / 2u;
+  const uint32_t chroma_height = (height + 1u) / 2u;
+  const uint32_t chroma_row_bytes = plane_count == 2 ? chroma_width * 2u : chroma_width;
+  size_t total = 0;
+  for (uint32_t i = 0; i < plane_count; ++i) {
+    const uint32_t row_bytes = i == 0 ? width : chroma_row_bytes;
+    const uint32_t rows = i == 0 ? height : chroma_height;
+    size_t plane_size = 0;
+    if (!checked_mul_size_t(row_bytes, rows, plane_size)) {
+      return 0;
+    }
+    out_planes[i].offset_bytes = total;
+    out_planes[i].row_stride_bytes = row_bytes;
+    out_rows[i] = rows;
+    if (!checked_add_size_t(total, plane_size, total)) {
+      return 0;
+    }
+  }
+  return total;
+}
+
+bool has_current_cpu_payload(const CoreStreamResultData& result) noexcept {
+  if (result.payload.empty() || !has_valid_retained_cpu_payload_layout(result.payload)) {
+    return false;
+  }
+  return is_cpu_payload_kind(result.payload_kind) ||
+         (result.payload_retained_frame_id != 0 && result.payload_retained_frame_id == result.retained_frame_id);
+}
+
+bool has_reduced_cpu_sidecar(const CoreStreamResultData& result) noexcept {
+  return result.payload_kind == ResultPayloadKind::GPU_SURFACE && has_current_cpu_payload(result) &&
+         (result.payload.width != result.image_width || result.payload.height != result.image_height);
+}
+
+bool has_valid_retained_raw_payload_layout(const CoreResultPayloadCpuPacked& payload) noexcept {
+  if (payload.width == 0 || payload.height == 0 || payload.empty() || payload.is_planar()) {
+    return false;
+  }
+  const uint32_t row_bytes = raw_bayer_row_bytes(payload.format_fourcc, payload.width);
+  return row_bytes != 0 && payload.stride_bytes == row_bytes &&
+         payload.size_bytes() >= static_cast<size_t>(row_bytes) * static_cast<size_t>(payload.height);
+}
+
+bool has_valid_retained_cpu_payload_layout(const CoreResultPayloadCpuPacked& payload) noexcept {
+  if (payload.width == 0 || payload.height == 0 || payload.empty()) {
+    return false;
+  }
+  if (payload.format_fourcc == FOURCC_RGBA || payload.format_fourcc == FOURCC_BGRA) {
+    // The last row needs only its pixels, not the padding after them.
+    const size_t row_bytes = static_cast<size_t>(payload.width) * 4u;
+    const size_t expected_size =
+        static_cast<size_t>(payload.stride_bytes) * (static_cast<size_t>(payload.height) - 1u) + row_bytes;
+    return !payload.is_planar() &&
+           payload.stride_bytes >= row_bytes &&
+           payload.size_bytes() >= expected_size;
+  }
+  if (!is_planar_yuv420_fourcc(payload.format_fourcc) ||
+      payload.plane_count != planar_yuv420_plane_count(payload.format_fourcc)) {
+    return false;
+  }
+  CoreResultPayloadPlane layout[kMaxFramePlanes]{};
+  uint32_t rows[kMaxFramePlanes]{};
+  const size_t expected_size =
+      planar_yuv420_tight_layout(payload.format_fourcc, payload.width, payload.height, layout, rows);
+  if (expected_size == 0 || payload.size_bytes() < expected_size) {
+    return false;
+  }
+  for (uint32_t i = 0; i < payload.plane_count; ++i) {
+    if (payload.planes[i].offset_bytes != layout[i].offset_bytes ||
+        payload.planes[i].row_stride_bytes != layout[i].row_stride_bytes) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool copy_retained_cpu_payload_as_rgba(
+    const CoreResultPayloadCpuPacked& payload,
+    uint8_t* dst,
+    size_t dst_size) noexcept {
+  if (!dst || !has_valid_retained_cpu_payload_layout(payload)) {
+    return false;
+  }
+  const size_t required =
+      static_cast<size_t>(payload.width) * static_cast<size_t>(payload.height) * 4u;
+  if (dst_size < required) {
+    return false;
+  }
+  const uint8_t* src = payload.data();
+  if (!payload.is_planar()) {
+    const size_t row_bytes = static_cast<size_t>(payload.width) * 4u;
+    const bool bgra = payload.format_fourcc == FOURCC_BGRA;
+    if (payload.stride_bytes == row_bytes) {
+      if (bgra) {
+        swizzle_bgra_to_rgba_opaque(src, dst, required / 4u);
+      } else {
+        std::memcpy(dst, src, required);
+      }
+      return true;
+    }
+    for (uint32_t y = 0; y < payload.height; ++y) {
+      if (bgra) {
+        swizzle_bgra_to_rgba_opaque(src, dst, payload.width);
+      } else {
+        std::memcpy(dst, src, row_bytes);
+      }
+      src += payload.stride_bytes;
+      dst += row_bytes;
+    }
+    return true;
+  }
+
+  Yuv420Source yuv{};
+  yuv.y = src + payload.planes[0].offset_bytes;
+  yuv.y_row_stride = payload.planes[0].row_stride_bytes;
+  yuv.uv_row_stride = payload.planes[1].row_stride_bytes;
+  if (payload.format_fourcc == FOURCC_I420) {
+    yuv.u = src + payload.planes[1].offset_bytes;
+    yuv.v = src + payload.planes[2].offset_bytes;
+    yuv.uv_pixel_stride = 1;
+  } else {
+    const uint8_t* chroma = src + payload.planes[1].offset_bytes;
+    yuv.u = payload.format_fourcc == FOURCC_NV12 ? chroma : chroma + 1;
+    yuv.v = payload.format_fourcc == FOURCC_NV12 ? chroma + 1 : chroma;
+    yuv.uv_pixel_stride = 2;
+  }
+  convert_yuv420_rows_to_packed(
+      yuv, payload.width, 0, payload.height, true, dst, static_cast<size_t>(payload.width) * 4u);
+  return true;
+}
+
 } // namespace cambang
@@ -3,19 +3,29 @@
 #include <cstddef>
 #include <cstdint>
 #include <atomic>
+#include <deque>
 #include <functional>
 #include <map>
 #include <memory>
 #include <mutex>
 #include <optional>
+#include <set>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include "core/camera_fact_types.h"
 #include "core/capture_admission_context.h"
+#include "core/core_frame_pacing.h"
+#include "core/core_hdr_histogram.h"
+#include "core/core_recycling_allocator.h"
+#include "core/latest_result_slot_table.h"
 #include "core/result_fact_types.h"
 #include "core/result_payload_kind.h"
 #include "core/result_capability.h"
+#include "imaging/api/cpu_payload_buffer_pool.h"
 #include "imaging/api/provider_contract_datatypes.h"
+#include "pixels/signature/content_signature.h"
 
 namespace cambang {
 
@@ -25,16 +35,30 @@ namespace cambang {
 // helper code.
 constexpr uint64_t kResultAccessCheapWithinBestMultiplier = 2;
 
+struct CoreResultPayloadPlane {
+  size_t offset_bytes = 0;
+  uint32_t row_stride_bytes = 0;
+};
+
 struct CoreResultPayloadCpuPacked {
   uint32_t format_fourcc = 0;
   uint32_t width = 0;
   uint32_t height = 0;
+  // Packed formats: row stride of the single plane. An adopted RGBA/BGRA
+  // provider buffer keeps its source stride, so rows may carry padding past
+  // width * 4; copied payloads are tight. Planar formats: luma row stride
+  // (mirrors planes[0]).
   uint32_t stride_bytes = 0;
+  // Planar YUV layout within the byte storage, in FourCC plane order. Zero
+  // planes for packed RGBA/BGRA. Retained planar payloads are always tightly
+  // packed (see planar_yuv420_tight_layout()).
+  CoreResultPayloadPlane planes[kMaxFramePlanes]{};
+  uint32_t plane_count = 0;
   // Legacy/self-owned byte storage. New retained-result paths may instead keep
   // immutable provider-owned bytes alive through retained_bytes to avoid an
   // extra full-frame copy. Use data()/size_bytes()/empty() for reads.
-  std::vector<uint8_t> bytes;
-  std::shared_ptr<const std::vector<uint8_t>> retained_bytes{};
+  CpuPayloadBytes bytes;
+  std::shared_ptr<const CpuPayloadBytes> retained_bytes{};
 
   const uint8_t* data() const noexcept {
     return retained_bytes ? retained_bytes->data() : bytes.data();
@@ -44,8 +68,41 @@ struct CoreResultPayloadCpuPacked {
   }
   bool empty() const noexcept { return size_bytes() == 0; }
   bool uses_retained_bytes() const noexcept { return static_cast<bool>(retained_bytes); }
+  bool is_planar() const noexcept { return plane_count != 0; }
 };
 
+// Fills the tightly packed plane layout Core uses for a retained planar
+// YUV 4:2:0 payload and returns its total byte size, or 0 for a non-planar
+// FourCC or an overflowing geometry. Each plane's row_stride_bytes is its
+// row byte count; plane row counts are written to out_rows.
+size_t planar_yuv420_tight_layout(
+    uint32_t format_fourcc,
+    uint32_t width,
+    uint32_t height,
+    CoreResultPayloadPlane (&out_planes)[kMaxFramePlanes],
+    uint32_t (&out_rows)[kMaxFramePlanes]) noexcept;
+
+// True when payload is a well-formed retained CPU image: RGBA/BGRA with a
+// row stride of at least width * 4, or a planar YUV payload laid out by
+// planar_yuv420_tight_layout().
+// RAW payloads are not images in this sense -- nothing derives RGBA from
+// them -- and fail this check.
+bool has_valid_retained_cpu_payload_layout(const CoreResultPayloadCpuPacked& payload) noexcept;
+
+// True when payload is a well-formed retained RAW capture: one plane of
+// tightly packed rows of raw_bayer_row_bytes(), exactly as the sensor
+// delivered them.
+bool has_valid_retained_raw_payload_layout(const CoreResultPayloadCpuPacked& payload) noexcept;
+
+// Writes payload as tightly packed width*height RGBA8 into dst, dropping any
+// row padding. Planar payloads are converted here, on demand, so retention
+// never pays for RGBA.
+// Returns false on an invalid payload or a short dst.
+bool copy_retained_cpu_payload_as_rgba(
+    const CoreResultPayloadCpuPacked& payload,
+    uint8_t* dst,
+    size_t dst_size) noexcept;
+
 struct CoreResultAccessPostureKey {
   // Stable internal calibration epoch for a concrete applied production
   // posture/access domain. This is not retained artifact identity, frame
@@ -63,6 +120,11 @@ struct CoreResultAccessPostureKey {
   bool gpu_materialization_requires_readback = false;
 };
 
+struct CoreEncodedImageSlot;
+struct CoreCaptureThumbnailSlot;
+struct CoreCaptureFusionSlot;
+struct CoreDerivedPayloadCache;
+
 struct CoreRetainedAccessTruth {
   ResultCapability display_view = ResultCapability::UNSUPPORTED;
   ResultCapability to_image = ResultCapability::UNSUPPORTED;
@@ -123,7 +185,10 @@ struct CoreImageFactBundle {
 // remain separate from the legacy flattened result facts above until a public
 // result surface is explicitly approved.
 struct CoreResolvedCaptureImageFacts {
-  CameraStaticFacts camera;
+  // Shared by every member of a device while its provider facts and the
+  // external description are unchanged; a private copy only when provider
+  // per-image intrinsics, distortion or pose apply. Null until resolved.
+  std::shared_ptr<const CameraStaticFacts> camera;
   CaptureImageFacts image;
 };
 
@@ -132,6 +197,11 @@ struct CoreStreamResultData {
   uint64_t device_instance_id = 0;
   StreamIntent intent = StreamIntent::PREVIEW;
   uint64_t retained_frame_id = 0;
+  // FrameView::trace_id of the retained frame (frame latency trace); 0 if untraced.
+  uint64_t trace_id = 0;
+  // steady_clock time retain_frame() retained this result, for
+  // retain-to-display latency (see note_stream_result_displayed()).
+  uint64_t retained_steady_ns = 0;
   uint32_t image_width = 0;
   uint32_t image_height = 0;
   uint32_t image_format_fourcc = 0;
@@ -146,6 +216,8 @@ struct CoreStreamResultData {
   // current for the same retained frame, classify the result as
   // GPU-primary with CPU sidecar data rather than GPU-only.
   RetainedGpuBackingDescriptor retained_gpu_backing_descriptor{};
+  // On a GPU-primary result whose plan reduces the CPU sidecar, payload is
+  // smaller than image_width x image_height (see has_reduced_cpu_sidecar()).
   CoreResultPayloadCpuPacked payload{};
   CoreRetainedAccessTruth retained_access_truth{};
   SharedResultAccessClassificationRecord access_classification{};
@@ -154,10 +226,28 @@ struct CoreStreamResultData {
   // retained stream result. Used to distinguish current CPU materialization
   // from unsupported GPU-only readback.
   uint64_t payload_retained_frame_id = 0;
+  // Post-processed payloads of this frame (see core_derived_payload.h).
+  // Attached by retain_frame() when payload is a current CPU payload.
+  std::shared_ptr<CoreDerivedPayloadCache> derived_payloads{};
+  // Coarse summary of payload's pixels, computed by retain_frame() when the
+  // frame carried a CPU payload; invalid otherwise. Compare two results'
+  // signatures with content_signature_difference() to skip work on frames
+  // that did not change.
+  ContentSignature content_signature{};
   CaptureImageFacts image_facts{};
   CoreImageFactBundle facts{};
 };
 
+// True when result carries CPU bytes of its own frame: a CPU-primary
+// result, or a GPU-primary one whose CPU sidecar was copied from the same
+// frame. What stream recording, export and native leases hand out.
+bool has_current_cpu_payload(const CoreStreamResultData& result) noexcept;
+
+// True when result's current CPU payload is a reduced-resolution sidecar of a
+// GPU-primary frame. It serves consumers that want the small image; it is
+// not the result's image, so to_image() materializes the GPU backing.
+bool has_reduced_cpu_sidecar(const CoreStreamResultData& result) noexcept;
+
 struct CoreCaptureResultData {
   enum class ImageMemberRole : uint8_t {
     DEFAULT_METERED = 0,
@@ -182,6 +272,15 @@ struct CoreCaptureResultData {
     CoreRetainedAccessTruth retained_access_truth{};
     SharedResultAccessClassificationRecord access_classification{};
     CoreResultAccessPostureKey access_posture{};
+    // Encoded-bytes cache for this member (see core_encoded_image.h). Attached
+    // by finalize_capture_facts() when the member retains a CPU payload.
+    std::shared_ptr<CoreEncodedImageSlot> encoded_image{};
+    // Post-processed payloads of this member (see core_derived_payload.h).
+    // Attached alongside encoded_image.
+    std::shared_ptr<CoreDerivedPayloadCache> derived_payloads{};
+    // Thumbnail pyramid of this member (see core_capture_thumbnails.h).
+    // Attached alongside encoded_image.
+    std::shared_ptr<CoreCaptureThumbnailSlot> thumbnails{};
 
     CoreResolvedCaptureImageFacts resolved_image_facts{};
   };
@@ -216,6 +315,9 @@ struct CoreCaptureResultData {
   bool has_admission_context = false;
   CaptureAdmissionContext admission_context{};
   bool capture_image_facts_finalized = false;
+  // Exposure fusion of the members (see core_capture_fusion.h). Attached by
+  // finalize_capture_facts() when they can be fused.
+  std::shared_ptr<CoreCaptureFusionSlot> exposure_fusion{};
 };
 
 using SharedStreamResultData = std::shared_ptr<const CoreStreamResultData>;
@@ -248,6 +350,12 @@ public:
   CoreResultStore() = default;
   ~CoreResultStore() = default;
 
+  // Pool retain_frame() copies non-adoptable CPU payloads into, so a stream
+  // result that cannot adopt the provider's owner still recycles its bytes.
+  // nullptr (default) copies into per-result storage. Set before first use;
+  // the pool must outlive the store (its buffers outlive the pool on their own).
+  void set_cpu_payload_buffer_pool(CpuPayloadBufferPool* pool) noexcept { cpu_payload_buffer_pool_ = pool; }
+
   bool retain_frame(const FrameView& frame,
                     std::optional<StreamIntent> stream_intent,
                     uint64_t stream_applied_access_posture_epoch = 0,
@@ -272,11 +380,89 @@ public:
   static bool try_build_capture_image_member_data_from_frame(const FrameView& frame,
                                                               CoreResultPayloadCpuPacked& out_payload);
 
+  // Lock-free for streams held in the slot table (see latest_stream_results_);
+  // safe to poll from any thread while retention/eviction hold mutex_.
   SharedStreamResultData get_latest_stream_result(uint64_t stream_id) const;
   SharedCaptureResultData get_capture_result(uint64_t capture_id, uint64_t device_instance_id) const;
   std::vector<SharedCaptureResultData> get_capture_result_set(uint64_t capture_id) const;
   void remove_stream_result(uint64_t stream_id);
 
+  // Recycling of the per-frame stream result blocks retain_frame() allocates,
+  // and of the capture result blocks (one per device and per copy-on-write
+  // revision of a capture's result).
+  CoreRecyclingBlockPool::Stats stream_result_pool_stats() const noexcept {
+    return stream_result_block_pool_->stats_copy();
+  }
+  CoreRecyclingBlockPool::Stats capture_result_pool_stats() const noexcept {
+    return capture_result_block_pool_->stats_copy();
+  }
+
+  // Change counters for callers that would otherwise re-read every result
+  // each frame: the stream revision advances after any stream's latest
+  // result is published or removed, the capture revision after any capture
+  // result is retained, appended to, finalized or removed. Both start at 1
+  // (0 is free for "never observed"), only grow, and are wait-free to read
+  // from any thread; results read after observing a revision are at least
+  // that new.
+  uint64_t stream_result_revision() const noexcept {
+    return stream_result_revision_.load(std::memory_order_acquire);
+  }
+  uint64_t capture_result_revision() const noexcept {
+    return capture_result_revision_.load(std::memory_order_acquire);
+  }
+
+  // Opt-in per-stream history of recent results, for zero-shutter-lag
+  // capture. While enabled, each result the stream's latest result replaces
+  // joins a ring of at most max_frames results and max_bytes payload bytes,
+  // oldest dropped first. Only results whose retained CPU payload is their
+  // own current frame and that hold no GPU backing (stream backings are live
+  // and updated in place, so they are not per-frame) are kept; the ring holds
+  // the results themselves, so it shares their payload buffers rather than
+  // copying them. max_frames == 0 disables the ring and drops its frames. The
+  // ring and its limits go with remove_stream_result().
+  void set_stream_history_limits(uint64_t stream_id, size_t max_frames, uint64_t max_bytes);
+  // The kept result (or the current latest result, under the same rules)
+  // whose acquisition timing is nearest reference; an earlier frame wins a
+  // tie. Only timings in reference's non-opaque clock domain with a metric
+  // comparability qualify. nullptr when none does.
+  SharedStreamResultData find_stream_history_result(uint64_t stream_id,
+                                                    const ImageAcquisitionTiming& reference) const;
+  size_t stream_history_frame_count(uint64_t stream_id) const;
+  // The ring's effective frame limit (history request or jitter window,
+  // whichever is larger); 0 while the ring is off.
+  size_t stream_history_max_frames(uint64_t stream_id) const;
+
+  // Opt-in jitter-buffer mode for display. While latency_ns != 0 the
+  // stream's history ring is on (at least kJitterBufferFrames frames and
+  // kJitterBufferMaxBytes bytes; set_stream_history_limits() may ask for
+  // more), and select_stream_result_for_display() chooses from it instead of
+  // returning the newest result. latency_ns == 0 turns the mode off; the
+  // ring then keeps only what set_stream_history_limits() asked for.
+  static constexpr size_t kJitterBufferFrames = 6;
+  static constexpr uint64_t kJitterBufferMaxBytes = 64ull * 1024ull * 1024ull;
+  void set_stream_jitter_buffer_latency(uint64_t stream_id, uint64_t latency_ns);
+  uint64_t stream_jitter_buffer_latency_ns(uint64_t stream_id) const;
+  // Opt-in display-only mode. While on, the stream's results are retained,
+  // published and displayable as usual, but retain_frame() resolves no access
+  // posture for them (posture_id 0, no classification record, so they are
+  // never calibrated) and attaches no derived-payload cache. Cleared with the
+  // stream's result by remove_stream_result() and clear().
+  void set_stream_display_only(uint64_t stream_id, bool enabled);
+  bool stream_display_only(uint64_t stream_id) const;
+  // The result to show at display_steady_ns (steady_clock): with the mode
+  // on, the newest kept result (the latest result included) acquired at or
+  // before display_steady_ns - latency, else the oldest; the latest result
+  // with the mode off. Acquisition times are placed on steady_clock by the
+  // smallest retained_steady_ns - acquisition offset among the candidates,
+  // i.e. by the least-delayed delivery, so delivery jitter does not move
+  // them; candidates whose timing is missing, opaque, ordering-only or in
+  // another clock domain than the latest result's use retained_steady_ns.
+  SharedStreamResultData select_stream_result_for_display(uint64_t stream_id,
+                                                          uint64_t display_steady_ns) const;
+  // Whether result may be kept by a history ring (and so re-ingested as a
+  // capture): its own current CPU frame, no GPU backing.
+  static bool is_stream_history_eligible(const CoreStreamResultData& result) noexcept;
+
   // Retention (unbounded-growth fix, ledger #52); mirrors
   // CoreCaptureAssemblyRegistry::retire_terminal_older_than() -- see that
   // header's doc comment for why retirement is time-based only (not tied to
@@ -287,10 +473,16 @@ public:
   // Called once per entry CoreRuntime retires via
   // CoreCaptureAssemblyRegistry::retire_terminal_older_than().
   void remove_capture_result(uint64_t capture_id, uint64_t device_instance_id);
+  // Drops the capture access postures of a closed device; its retained
+  // results keep their ids.
+  void retire_device_access_postures(uint64_t device_instance_id);
 
   struct EvictedCaptureResult {
     uint64_t capture_id = 0;
     uint64_t device_instance_id = 0;
+    // The evicted result, for the caller to hand to a spill tier (see
+    // CoreCaptureSpillStore) or simply drop, in either case outside mutex_.
+    SharedCaptureResultData result;
   };
   // Byte-budget retention (ledger #53), complementary to the time-based
   // retire_terminal_older_than() sweep above: bounds total retained capture
@@ -299,38 +491,65 @@ public:
   // the opaque retained_gpu_backing handle itself) so a long-running,
   // multi-camera repeated-capture session cannot grow result memory without
   // bound even while individual captures remain within the time window.
-  // Walks capture_results_by_capture_id_ in ascending capture_id order
-  // (already oldest-first), skipping any (capture_id, device_instance_id)
-  // for which is_evictable returns false, evicting the rest until
-  // at-or-under byte_budget or no evictable candidates remain. The caller
-  // (CoreRuntime) must supply is_evictable backed by
-  // CoreCaptureAssemblyRegistry::terminal_capture_device_pairs() so a
-  // still-in-flight capture (its result data actively being appended to /
-  // finalized by the capture pipeline) is never evicted merely for being
-  // byte-heavy or old -- only already-terminal (COMPLETED/FAILED) entries
-  // are eligible, mirroring retire_terminal_older_than()'s own restriction.
+  // Walks the evictable list (mark_capture_results_evictable()) in
+  // ascending (capture_id, device_instance_id) order -- already
+  // oldest-first -- evicting until at-or-under byte_budget or no evictable
+  // entries remain, so a pass costs the entries it evicts (plus any it must
+  // skip), not the whole store. A first pass takes only results nobody
+  // outside the store holds, since evicting a result a caller still
+  // references frees none of its memory; a second pass takes the rest in
+  // the same order if that was not enough. Only entries the caller has
+  // marked evictable are ever considered: CoreRuntime marks exactly the
+  // ones CoreCaptureAssemblyRegistry reports terminal, so a still-in-flight
+  // capture (its result data actively being appended to / finalized by the
+  // capture pipeline) is never evicted merely for being byte-heavy or old
+  // -- only already-terminal (COMPLETED/FAILED) entries are eligible,
+  // mirroring retire_terminal_older_than()'s own restriction.
   //
-  // is_evictable MUST NOT itself acquire any other registry's lock: it runs
-  // while mutex_ is held, and CoreCaptureAssemblyRegistry::mutex_ (or any
-  // other registry lock) must never be nested inside mutex_ here -- every
-  // cross-registry access elsewhere in this codebase locks registries
-  // sequentially, never nested, and this predicate must keep that invariant
-  // (build it from a snapshot taken before calling in, e.g.
-  // terminal_capture_device_pairs(), not a live cross-registry query).
   // Evicted entries are moved into the returned vector while mutex_ is
   // held, and the lock is released before that vector (and the payloads/
   // GPU backing shared_ptrs it holds) is destroyed, so freeing memory never
   // blocks a concurrent get_latest_stream_result()/get_capture_result() read.
-  std::vector<EvictedCaptureResult> evict_over_byte_budget(
-      uint64_t byte_budget,
-      const std::function<bool(uint64_t capture_id, uint64_t device_instance_id)>& is_evictable);
+  std::vector<EvictedCaptureResult> evict_over_byte_budget(uint64_t byte_budget);
+  // Adds pairs to the evictable list. A pair may be marked before its
+  // result is retained; it leaves the list when the result is removed,
+  // evicted or cleared. Takes only mutex_, so callers pass a list copied out
+  // of CoreCaptureAssemblyRegistry after releasing its lock.
+  void mark_capture_results_evictable(const std::vector<std::pair<uint64_t, uint64_t>>& pairs);
   uint64_t total_estimated_capture_bytes() const;
 
+  // Entry counts of the store's keyed tables, for soak and leak tooling.
+  struct TableSizes {
+    size_t capture_results = 0;
+    size_t evictable_capture_results = 0;
+    size_t stream_histories = 0;
+    size_t stream_access_postures = 0;
+    size_t capture_access_postures = 0;
+  };
+  TableSizes table_sizes() const;
+
+  // Display demand per stream: a short lease renewed by mark, or a
+  // persistent refcount. Demand is only recorded for a stream with a latest
+  // result and goes with remove_stream_result(). Marks and state reads are
+  // lock-free for streams held in a demand slot (see DisplayDemandSlot), so
+  // the per-frame provider query and Godot mark never wait on retention.
   void mark_stream_display_demand(uint64_t stream_id, uint64_t now_ns);
   void retain_stream_display_demand(uint64_t stream_id);
   void release_stream_display_demand(uint64_t stream_id);
   bool is_stream_display_demand_active(uint64_t stream_id, uint64_t now_ns) const;
   DisplayDemandState get_stream_display_demand_state(uint64_t stream_id, uint64_t now_ns) const;
+
+  // Delivery side of a stream's frame pacing: a display refresh took up
+  // result. Each retained frame counts once, timed on steady_clock at the
+  // first call; the stream's pickup intervals and retain-to-pickup latency
+  // are kept in constant memory and go with remove_stream_result(). Any
+  // thread.
+  struct StreamDeliveryStats {
+    CoreFramePacing::Summary pacing{};
+    CoreHdrHistogram::Summary latency{};
+  };
+  void note_stream_result_displayed(const CoreStreamResultData& result);
+  bool get_stream_delivery_stats(uint64_t stream_id, StreamDeliveryStats& out) const;
   void clear();
 
 private:
@@ -338,17 +557,98 @@ private:
   friend struct CoreResultStoreSmokeAccess;
 #endif
   static bool has_cpu_packed_payload(const FrameView& frame);
-  static bool try_copy_cpu_packed_payload(const FrameView& frame, CoreResultPayloadCpuPacked& out);
+  static bool try_copy_cpu_packed_payload(const FrameView& frame,
+                                          CoreResultPayloadCpuPacked& out,
+                                          CpuPayloadBufferPool* pool = nullptr);
+  static bool try_copy_cpu_planar_payload(const FrameView& frame,
+                                          CoreResultPayloadCpuPacked& out,
+                                          CpuPayloadBufferPool* pool = nullptr);
+  static uint8_t* prepare_copied_payload_storage(CoreResultPayloadCpuPacked& out,
+                                                 size_t dst_size,
+                                                 CpuPayloadBufferPool* pool);
   static bool has_valid_capture_image_member_payload(const CoreResultPayloadCpuPacked& payload);
   bool try_issue_retained_frame_id(uint64_t& out_id) noexcept;
-  static MutableCaptureResultData build_default_image_capture_result(const FrameView& frame,
-                                                                     CoreRetainedBackingPlan plan,
-                                                                     CoreResultPayloadCpuPacked payload,
-                                                                     std::shared_ptr<void> retained_gpu_backing,
-                                                                     RetainedGpuBackingDescriptor retained_gpu_backing_descriptor);
-
+  MutableCaptureResultData build_default_image_capture_result(const FrameView& frame,
+                                                              CoreRetainedBackingPlan plan,
+                                                              CoreResultPayloadCpuPacked payload,
+                                                              std::shared_ptr<void> retained_gpu_backing,
+                                                              RetainedGpuBackingDescriptor retained_gpu_backing_descriptor);
+  // New or copied capture result in a capture_result_block_pool_ block.
+  template <typename... Args>
+  MutableCaptureResultData make_capture_result_(Args&&... args) const {
+    return std::allocate_shared<CoreCaptureResultData>(
+        CoreRecyclingAllocator<CoreCaptureResultData>(capture_result_block_pool_),
+        std::forward<Args>(args)...);
+  }
+  bool has_latest_stream_result_(uint64_t stream_id) const;
+
+  // One stream's display demand, readable without a lock. A slot is claimed
+  // and freed, and its refcount changed, only under display_demand_mutex_;
+  // last_seen_ns is also stored by lock-free marks. A reader re-checks
+  // stream_id after reading the values, so a slot freed meanwhile reads as
+  // no demand. A mark racing the removal of its stream can at worst leave
+  // one lease on the slot's next stream, which expires like any other.
+  static constexpr uint64_t kNoDisplayDemandSeen = ~0ull;
+  struct DisplayDemandSlot {
+    std::atomic<uint64_t> stream_id{0};
+    std::atomic<uint64_t> last_seen_ns{kNoDisplayDemandSeen};
+    std::atomic<uint32_t> refcount{0};
+  };
+  static constexpr size_t kDisplayDemandSlots = LatestResultSlotTable<CoreStreamResultData>::kSlots;
+  DisplayDemandSlot* find_display_demand_slot_(uint64_t stream_id) const noexcept;
+  DisplayDemandSlot* find_or_claim_display_demand_slot_locked_(uint64_t stream_id) noexcept;
+  void remove_stream_display_demand_(uint64_t stream_id);
+
+  struct StreamHistory {
+    // Effective limits: the larger of the history request and, while the
+    // jitter buffer is on, its window.
+    size_t max_frames = 0;
+    uint64_t max_bytes = 0;
+    size_t history_max_frames = 0;
+    uint64_t history_max_bytes = 0;
+    uint64_t jitter_latency_ns = 0;
+    // Oldest first.
+    std::deque<SharedStreamResultData> frames;
+    uint64_t bytes = 0;
+  };
+  // Both hand dropped results to `released`, for the caller to drop after
+  // unlocking. False when result was not kept.
+  static bool push_stream_history_locked_(StreamHistory& history,
+                                          const SharedStreamResultData& result,
+                                          std::vector<SharedStreamResultData>& released);
+  static void trim_stream_history_locked_(StreamHistory& history,
+                                          std::vector<SharedStreamResultData>& released);
+  // Recomputes the effective limits of stream_id's ring (creating it when
+  // either mode wants one) and trims it, or drops it when neither does.
+  void apply_stream_history_limits_locked_(uint64_t stream_id,
+                                           size_t history_max_frames,
+                                           uint64_t history_max_bytes,
+                                           uint64_t jitter_latency_ns,
+                                           std::vector<SharedStreamResultData>& released);
+
+  CpuPayloadBufferPool* cpu_payload_buffer_pool_ = nullptr; // non-owning
+  // Stream results are allocate_shared() from here (one block per result,
+  // control block included); shared with every result's control block.
+  std::shared_ptr<CoreRecyclingBlockPool> stream_result_block_pool_ =
+      std::make_shared<CoreRecyclingBlockPool>();
+  std::shared_ptr<CoreRecyclingBlockPool> capture_result_block_pool_ =
+      std::make_shared<CoreRecyclingBlockPool>();
   mutable std::mutex mutex_;
-  std::map<uint64_t, SharedStreamResultData> latest_stream_results_;
+  // Latest retained result per stream. Written under mutex_, read without it.
+  // Streams beyond the table's fixed capacity fall back to
+  // overflow_stream_results_, which readers consult under mutex_ only while
+  // it is non-empty.
+  LatestResultSlotTable<CoreStreamResultData> latest_stream_results_;
+  std::map<uint64_t, SharedStreamResultData> overflow_stream_results_;
+  std::atomic<size_t> overflow_stream_result_count_{0};
+  // Advanced under mutex_ after the change they report.
+  std::atomic<uint64_t> stream_result_revision_{1};
+  std::atomic<uint64_t> capture_result_revision_{1};
+  // Streams with an enabled history ring (set_stream_history_limits() or
+  // set_stream_jitter_buffer_latency()).
+  std::map<uint64_t, StreamHistory> stream_histories_;
+  // Streams in display-only mode (set_stream_display_only()).
+  std::set<uint64_t> display_only_streams_;
   std::map<uint64_t, std::map<uint64_t, MutableCaptureResultData>> capture_results_by_capture_id_;
   // Running total of compute_capture_result_bytes() across every entry
   // currently in capture_results_by_capture_id_; kept incrementally in sync
@@ -356,9 +656,15 @@ private:
   // (add)/remove_capture_result()/evict_over_byte_budget() (subtract) so
   // evict_over_byte_budget() never has to re-walk+recompute the whole store.
   uint64_t total_estimated_capture_bytes_ = 0;
+  // (capture_id, device_instance_id) of terminal captures, oldest first:
+  // the only entries evict_over_byte_budget() walks.
+  std::set<std::pair<uint64_t, uint64_t>> evictable_capture_results_;
   uint64_t next_retained_frame_id_ = 1;
-  struct StreamAccessPostureDomainKey {
-    uint64_t stream_id = 0;
+  // One access posture: owner_id is the stream_id for stream postures and
+  // the device_instance_id for capture postures. hash is computed once when
+  // the key is built (seal()), so a lookup hashes nothing per field.
+  struct AccessPostureDomainKey {
+    uint64_t owner_id = 0;
     uint64_t applied_epoch = 0;
     uint32_t width = 0;
     uint32_t height = 0;
@@ -368,37 +674,55 @@ private:
     bool has_retained_gpu_backing = false;
     bool gpu_materialization_available = false;
     bool gpu_materialization_requires_readback = false;
+    size_t hash = 0;
 
-    bool operator<(const StreamAccessPostureDomainKey& other) const noexcept;
+    void seal() noexcept;
+    bool operator==(const AccessPostureDomainKey& other) const noexcept;
   };
-
-  struct CaptureAccessPostureDomainKey {
-    uint64_t device_instance_id = 0;
-    uint64_t applied_epoch = 0;
-    uint32_t width = 0;
-    uint32_t height = 0;
-    uint32_t format_fourcc = 0;
-    ResultPayloadKind payload_kind = ResultPayloadKind::CPU_PACKED;
-    bool has_retained_cpu_payload = false;
-    bool has_retained_gpu_backing = false;
-    bool gpu_materialization_available = false;
-    bool gpu_materialization_requires_readback = false;
-
-    bool operator<(const CaptureAccessPostureDomainKey& other) const noexcept;
+  struct AccessPostureDomainKeyHash {
+    size_t operator()(const AccessPostureDomainKey& key) const noexcept { return key.hash; }
+  };
+  template <typename V>
+  using AccessPostureTable = std::unordered_map<AccessPostureDomainKey, V, AccessPostureDomainKeyHash>;
+
+  // A stream posture's classification record is shared by every result of
+  // the posture: refinement is keyed by posture_id evidence anyway, and a
+  // new applied epoch or backing change is a new posture with a fresh record.
+  struct StreamAccessPosture {
+    uint64_t posture_id = 0;
+    SharedResultAccessClassificationRecord access_classification{};
   };
 
-  uint64_t resolve_stream_access_posture_id(const CoreStreamResultData& result,
-                                            bool has_current_cpu_payload,
-                                            uint64_t applied_epoch);
+  const StreamAccessPosture& resolve_stream_access_posture(const CoreStreamResultData& result,
+                                                           bool has_current_cpu_payload,
+                                                           uint64_t applied_epoch);
   uint64_t resolve_capture_member_access_posture_id(uint64_t device_instance_id,
                                                     const CoreCaptureResultData::ImageMemberData& member,
                                                     bool has_cpu_payload,
                                                     uint64_t applied_epoch);
 
+  mutable DisplayDemandSlot display_demand_slots_[kDisplayDemandSlots];
+  // Serializes demand writers other than slot marks, and guards the maps of
+  // streams beyond the slots, which readers consult only while non-empty.
+  // Never taken together with mutex_.
+  mutable std::mutex display_demand_mutex_;
   std::map<uint64_t, uint64_t> stream_display_demand_last_seen_ns_;
   std::map<uint64_t, uint32_t> stream_display_demand_refcounts_;
-  std::map<StreamAccessPostureDomainKey, uint64_t> stream_access_posture_ids_;
-  std::map<CaptureAccessPostureDomainKey, uint64_t> capture_access_posture_ids_;
+  std::atomic<size_t> overflow_display_demand_count_{0};
+  struct StreamDelivery {
+    CoreFramePacing pacing;
+    CoreHdrHistogram latency;
+    uint64_t last_retained_frame_id = 0;
+  };
+  // Guarded by display_demand_mutex_.
+  std::map<uint64_t, StreamDelivery> stream_deliveries_;
+  // Bounded by live owners: an owner past its posture limit loses its oldest
+  // epoch's postures, remove_stream_result() retires a stream's, and
+  // retire_device_access_postures() a closed device's. Results keep the ids
+  // they were stamped with; only later lookups mint fresh ones. Node-based,
+  // so resolve_stream_access_posture()'s reference survives later inserts.
+  AccessPostureTable<StreamAccessPosture> stream_access_posture_ids_;
+  AccessPostureTable<uint64_t> capture_access_posture_ids_;
   uint64_t next_result_access_posture_id_ = 1;
 };
 
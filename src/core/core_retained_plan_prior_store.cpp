@@ -0,0 +1,190 @@
+// src/core/core_retained_plan_prior_store.cpp
+#include "core/core_retained_plan_prior_store.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <system_error>
+#include <vector>
+
+namespace cambang {
+
+namespace {
+
+constexpr const char* kHeader = "cambang-retained-plan-priors 1";
+// Key fields, tab separated: provider, hardware_id, primary function, width,
+// height, fourcc, image member count, runtime caps, parent-context caps.
+constexpr size_t kKeyFieldCount = 9;
+
+unsigned capability_bits(ProducerBackingCapabilities caps) noexcept {
+  return (caps.cpu_backed_available ? 1u : 0u) |
+         (caps.gpu_backed_available ? 2u : 0u) |
+         (caps.gpu_with_cpu_sidecar_available ? 4u : 0u);
+}
+
+bool usable_key_text(const std::string& text) noexcept {
+  return text.find_first_of("\t\r\n") == std::string::npos;
+}
+
+bool parse_posture(char c, CoreProductionPostureShape& out) noexcept {
+  switch (c) {
+    case '0':
+      out = CoreProductionPostureShape::CpuPrimary;
+      return true;
+    case '1':
+      out = CoreProductionPostureShape::GpuPrimaryNoCpuSidecar;
+      return true;
+    case '2':
+      out = CoreProductionPostureShape::GpuPrimaryWithCpuSidecar;
+      return true;
+  }
+  return false;
+}
+
+} // namespace
+
+bool CoreRetainedPlanPriorStore::encode_key_(const Key& key, std::string& out) {
+  if (key.provider_name.empty() || key.hardware_id.empty() ||
+      !usable_key_text(key.provider_name) || !usable_key_text(key.hardware_id)) {
+    return false;
+  }
+  char numbers[96];
+  std::snprintf(numbers,
+                sizeof(numbers),
+                "\t%u\t%u\t%u\t%u\t%u\t%u\t%u",
+                static_cast<unsigned>(key.primary_function),
+                static_cast<unsigned>(key.width),
+                static_cast<unsigned>(key.height),
+                static_cast<unsigned>(key.format_fourcc),
+                static_cast<unsigned>(key.image_member_count),
+                capability_bits(key.runtime_backing_capabilities),
+                capability_bits(key.parent_context_backing_capabilities));
+  out = key.provider_name;
+  out += '\t';
+  out += key.hardware_id;
+  out += numbers;
+  return true;
+}
+
+void CoreRetainedPlanPriorStore::load() noexcept try {
+  priors_.clear();
+  remembered_.clear();
+  if (path_.empty()) {
+    return;
+  }
+  std::ifstream in(path_);
+  std::string line;
+  if (!in || !std::getline(in, line) || line != kHeader) {
+    return;
+  }
+  while (priors_.size() < kMaxPriors && std::getline(in, line)) {
+    // "<posture>\t<key>"
+    CoreProductionPostureShape posture{};
+    if (line.size() < 3 || line[1] != '\t' || !parse_posture(line[0], posture)) {
+      continue;
+    }
+    std::string key = line.substr(2);
+    size_t fields = 1;
+    for (const char c : key) {
+      fields += c == '\t' ? 1u : 0u;
+    }
+    if (fields != kKeyFieldCount) {
+      continue;
+    }
+    priors_[std::move(key)] = Entry{posture, ++use_clock_};
+  }
+} catch (...) {
+  priors_.clear();
+}
+
+void CoreRetainedPlanPriorStore::flush() noexcept try {
+  if (remembered_.empty()) {
+    return;
+  }
+  for (auto& [key, entry] : remembered_) {
+    priors_[key] = entry;
+  }
+  remembered_.clear();
+  while (priors_.size() > kMaxPriors) {
+    auto oldest = priors_.begin();
+    for (auto it = priors_.begin(); it != priors_.end(); ++it) {
+      if (it->second.last_use < oldest->second.last_use) {
+        oldest = it;
+      }
+    }
+    priors_.erase(oldest);
+  }
+  if (path_.empty()) {
+    return;
+  }
+
+  // Oldest first, so a reload keeps the same recency order.
+  std::vector<const std::pair<const std::string, Entry>*> ordered;
+  ordered.reserve(priors_.size());
+  for (const auto& kv : priors_) {
+    ordered.push_back(&kv);
+  }
+  std::sort(ordered.begin(), ordered.end(), [](const auto* a, const auto* b) {
+    return a->second.last_use < b->second.last_use;
+  });
+
+  std::error_code ec;
+  if (path_.has_parent_path()) {
+    std::filesystem::create_directories(path_.parent_path(), ec);
+  }
+  std::filesystem::path staging = path_;
+  staging += ".tmp";
+  {
+    std::ofstream out(staging, std::ios::out | std::ios::trunc);
+    if (!out) {
+      return;
+    }
+    out << kHeader << '\n';
+    for (const auto* kv : ordered) {
+      out << static_cast<unsigned>(kv->second.posture) << '\t' << kv->first << '\n';
+    }
+    out.close();
+    if (!out) {
+      std::filesystem::remove(staging, ec);
+      return;
+    }
+  }
+  // The rename replaces the previous file whole: a reader never sees a
+  // partial write.
+  std::filesystem::rename(staging, path_, ec);
+  if (ec) {
+    std::filesystem::remove(staging, ec);
+  }
+} catch (...) {
+}
+
+void CoreRetainedPlanPriorStore::clear() noexcept {
+  priors_.clear();
+  remembered_.clear();
+}
+
+bool CoreRetainedPlanPriorStore::find(const Key& key, CoreRetainedProductionPlan& out) {
+  std::string encoded;
+  if (priors_.empty() || !encode_key_(key, encoded)) {
+    return false;
+  }
+  const auto it = priors_.find(encoded);
+  if (it == priors_.end()) {
+    return false;
+  }
+  it->second.last_use = ++use_clock_;
+  out = CoreRetainedProductionPlan{};
+  out.valid = true;
+  out.posture = it->second.posture;
+  return true;
+}
+
+void CoreRetainedPlanPriorStore::remember(const Key& key, CoreRetainedProductionPlan selected) {
+  std::string encoded;
+  if (path_.empty() || !selected.valid || !encode_key_(key, encoded)) {
+    return;
+  }
+  remembered_[std::move(encoded)] = Entry{selected.posture, ++use_clock_};
+}
+
+} // namespace cambang
@@ -0,0 +1,85 @@
+// src/core/core_retained_plan_prior_store.h
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <string>
+#include <utility>
+
+#include "imaging/api/provider_contract_datatypes.h"
+
+namespace cambang {
+
+// Converged retained-plan decisions carried across runtime generations.
+//
+// Every generation otherwise re-derives each stream's and capture parent's
+// retained production plan by evaluating the viable candidates in turn, each
+// over a backing-plan settle window. The plan a completed evaluation selects
+// (one candidate timed against the others through the access calibration
+// observations) is remembered here under the identity it was measured for:
+// provider, hardware_id, primary function, profile geometry and the backing
+// capabilities that bounded the candidates. At the next start those
+// decisions are priors: a matching stream or capture parent settles on its
+// prior directly instead of evaluating again.
+//
+// Priors are read once by load() (runtime start) and written by flush()
+// (runtime stop). Decisions remembered during a generation only become priors
+// for the next one, so in-generation re-evaluation is unchanged. Without a
+// path, or when the file cannot be read or written, nothing persists, which
+// is the behaviour before priors existed.
+//
+// Threading: core thread only (set_path() with the core thread stopped).
+class CoreRetainedPlanPriorStore final {
+public:
+  static constexpr size_t kMaxPriors = 256;
+
+  struct Key {
+    std::string provider_name;
+    std::string hardware_id;
+    // BackingPlanEvaluationPrimaryFunction.
+    uint8_t primary_function = 0;
+    uint32_t width = 0;
+    uint32_t height = 0;
+    uint32_t format_fourcc = 0;
+    // Capture parents: still-image bundle member count; 0 for streams.
+    uint32_t image_member_count = 0;
+    ProducerBackingCapabilities runtime_backing_capabilities{};
+    ProducerBackingCapabilities parent_context_backing_capabilities{};
+  };
+
+  void set_path(std::filesystem::path path) { path_ = std::move(path); }
+  const std::filesystem::path& path() const noexcept { return path_; }
+
+  // Replaces the priors with the file's; a missing or unreadable file (or
+  // one from another format version) leaves none.
+  void load() noexcept;
+  // Writes the loaded priors overlaid with this generation's decisions when
+  // any were remembered, then starts the next generation from that set.
+  void flush() noexcept;
+  // Drops priors and remembered decisions without touching the file.
+  void clear() noexcept;
+
+  // A hit counts as a use: flush() keeps the most recently used priors.
+  bool find(const Key& key, CoreRetainedProductionPlan& out);
+  void remember(const Key& key, CoreRetainedProductionPlan selected);
+
+  size_t prior_count() const noexcept { return priors_.size(); }
+  size_t remembered_count() const noexcept { return remembered_.size(); }
+
+private:
+  struct Entry {
+    CoreProductionPostureShape posture = CoreProductionPostureShape::CpuPrimary;
+    uint64_t last_use = 0;
+  };
+
+  static bool encode_key_(const Key& key, std::string& out);
+
+  std::filesystem::path path_;
+  std::map<std::string, Entry> priors_;
+  std::map<std::string, Entry> remembered_;
+  uint64_t use_clock_ = 0;
+};
+
+} // namespace cambang
@@ -9,6 +9,7 @@ bool CoreRigRegistry::retain_capture_profile(uint64_t rig_id,
                                              uint32_t height,
                                              uint32_t format,
                                              uint64_t capture_profile_version) {
+  revision_ = next_core_registry_revision();
   if (rig_id == 0) {
     return false;
   }
@@ -24,16 +25,37 @@ bool CoreRigRegistry::retain_capture_profile(uint64_t rig_id,
 }
 
 bool CoreRigRegistry::retain_member_hardware_ids(uint64_t rig_id, std::vector<std::string> member_hardware_ids) {
+  revision_ = next_core_registry_revision();
   if (rig_id == 0) {
     return false;
   }
   auto& rec = rigs_[rig_id];
   rec.rig_id = rig_id;
   rec.member_hardware_ids = std::move(member_hardware_ids);
+  rec.member_hardware_keys.clear();
+  rec.member_hardware_keys.reserve(rec.member_hardware_ids.size());
+  for (const std::string& hardware_id : rec.member_hardware_ids) {
+    rec.member_hardware_keys.push_back(global_hardware_id_interner().intern(hardware_id));
+  }
   rec.live = true;
   return true;
 }
 
+bool CoreRigRegistry::note_capture_completed(uint64_t rig_id,
+                                             uint64_t capture_id,
+                                             uint64_t capture_latency_ns,
+                                             uint64_t sync_skew_ns) {
+  const auto it = rigs_.find(rig_id);
+  if (it == rigs_.end()) {
+    return false;
+  }
+  revision_ = next_core_registry_revision();
+  it->second.last_capture_id = capture_id;
+  it->second.last_capture_latency_ns = capture_latency_ns;
+  it->second.last_sync_skew_ns = sync_skew_ns;
+  return true;
+}
+
 const CoreRigRegistry::RigRecord* CoreRigRegistry::find(uint64_t rig_id) const noexcept {
   const auto it = rigs_.find(rig_id);
   if (it == rigs_.end()) {
@@ -6,6 +6,9 @@
 #include <string>
 #include <vector>
 
+#include "core/core_registry_revision.h"
+#include "core/core_string_interner.h"
+
 namespace cambang {
 
 class CoreRigRegistry final {
@@ -14,6 +17,8 @@ public:
     uint64_t rig_id = 0;
     std::string name;
     std::vector<std::string> member_hardware_ids;
+    // global_hardware_id_interner() ids, parallel to member_hardware_ids.
+    std::vector<CoreStringId> member_hardware_keys;
 
     uint64_t active_capture_id = 0;
     uint64_t capture_profile_version = 0;
@@ -39,14 +44,25 @@ public:
                               uint32_t format,
                               uint64_t capture_profile_version);
   bool retain_member_hardware_ids(uint64_t rig_id, std::vector<std::string> member_hardware_ids);
+  // A rig capture whose members all completed. False for an unknown rig.
+  bool note_capture_completed(uint64_t rig_id,
+                              uint64_t capture_id,
+                              uint64_t capture_latency_ns,
+                              uint64_t sync_skew_ns);
 
-  void clear() noexcept { rigs_.clear(); }
+  void clear() noexcept {
+    rigs_.clear();
+    revision_ = next_core_registry_revision();
+  }
 
   const RigRecord* find(uint64_t rig_id) const noexcept;
   const std::map<uint64_t, RigRecord>& all() const noexcept { return rigs_; }
+  // Snapshot dirty-tracking stamp (see core_registry_revision.h).
+  uint64_t revision() const noexcept { return revision_; }
 
 private:
   std::map<uint64_t, RigRecord> rigs_;
+  uint64_t revision_ = 0;
 };
 
 } // namespace cambang
@@ -0,0 +1,227 @@
+// src/core/core_rig_stream_frame_sets.cpp
+#include "core/core_rig_stream_frame_sets.h"
+
+#include <utility>
+
+#include "core/core_device_registry.h"
+#include "core/core_rig_registry.h"
+
+namespace cambang {
+
+namespace {
+
+bool comparable_across_devices(const ImageAcquisitionTiming& timing) noexcept {
+  if (timing.clock_domain() == ImageAcquisitionClockDomain::DOMAIN_OPAQUE) {
+    return false;
+  }
+  switch (timing.comparability()) {
+    case ImageAcquisitionComparability::SAME_PROVIDER:
+    case ImageAcquisitionComparability::CROSS_DEVICE_SYNCHRONIZED:
+    case ImageAcquisitionComparability::CORE_TIMELINE:
+      return true;
+    default:
+      return false;
+  }
+}
+
+} // namespace
+
+void CoreRigStreamFrameSets::sync_with_rig_registry_() {
+  if (synced_ && rigs_->revision() == synced_rig_revision_) {
+    return;
+  }
+  synced_ = true;
+  synced_rig_revision_ = rigs_->revision();
+  memberships_.clear();
+  for (auto it = rig_states_.begin(); it != rig_states_.end();) {
+    const CoreRigRegistry::RigRecord* rec = rigs_->find(it->first);
+    if (rec && rec->member_hardware_keys == it->second.member_hardware_keys) {
+      ++it;
+      continue;
+    }
+    (void)latest_.erase(it->first);
+    it = rig_states_.erase(it);
+  }
+}
+
+const CoreRigStreamFrameSets::Membership* CoreRigStreamFrameSets::resolve_membership_(
+    uint64_t device_instance_id) {
+  if (!rigs_ || !devices_ || device_instance_id == 0) {
+    return nullptr;
+  }
+  sync_with_rig_registry_();
+  const auto cached = memberships_.find(device_instance_id);
+  if (cached != memberships_.end()) {
+    return &cached->second;
+  }
+  const CoreDeviceRegistry::DeviceRecord* device = devices_->find(device_instance_id);
+  if (!device || device->hardware_key == 0) {
+    // Identity not known yet; resolve again on a later frame.
+    return nullptr;
+  }
+
+  if (memberships_.size() >= kMaxCachedMemberships) {
+    memberships_.clear();
+  }
+  Membership membership{};
+  for (const auto& [rig_id, rec] : rigs_->all()) {
+    if (rec.member_hardware_keys.size() < 2) {
+      continue;
+    }
+    for (size_t i = 0; i < rec.member_hardware_keys.size(); ++i) {
+      if (rec.member_hardware_keys[i] == device->hardware_key) {
+        membership.rig_id = rig_id;
+        membership.member_index = i;
+        break;
+      }
+    }
+    if (membership.rig_id != 0) {
+      break;
+    }
+  }
+  if (membership.rig_id != 0) {
+    auto [it, inserted] = rig_states_.try_emplace(membership.rig_id);
+    if (inserted) {
+      const CoreRigRegistry::RigRecord* rec = rigs_->find(membership.rig_id);
+      it->second.member_hardware_keys = rec->member_hardware_keys;
+      it->second.members.resize(rec->member_hardware_keys.size());
+    }
+  }
+  return &memberships_.emplace(device_instance_id, membership).first->second;
+}
+
+bool CoreRigStreamFrameSets::is_rig_member(uint64_t device_instance_id) {
+  const Membership* membership = resolve_membership_(device_instance_id);
+  return membership && membership->rig_id != 0;
+}
+
+void CoreRigStreamFrameSets::on_stream_result(const SharedStreamResultData& result) {
+  if (!result || result->stream_id == 0) {
+    return;
+  }
+  const Membership* membership = resolve_membership_(result->device_instance_id);
+  if (!membership || membership->rig_id == 0) {
+    return;
+  }
+  const uint64_t rig_id = membership->rig_id;
+  RigState& rig = rig_states_.at(rig_id);
+  MemberState& member = rig.members[membership->member_index];
+
+  if (member.stream_id != result->stream_id) {
+    rig.stats.frames_dropped_unmatched += member.count;
+    member = MemberState{};
+    member.stream_id = result->stream_id;
+  }
+
+  const auto& timing = result->image_facts.acquisition_timing;
+  int64_t time_ns = 0;
+  if (!timing || !comparable_across_devices(timing->value) ||
+      (rig.has_clock_domain && timing->value.clock_domain() != rig.clock_domain) ||
+      !image_acquisition_time_ns(timing->value, time_ns) ||
+      (member.has_last_time && time_ns <= member.last_time_ns)) {
+    ++rig.stats.frames_unmatchable;
+    return;
+  }
+  if (!rig.has_clock_domain) {
+    rig.has_clock_domain = true;
+    rig.clock_domain = timing->value.clock_domain();
+  }
+  if (member.has_last_time) {
+    const int64_t interval = time_ns - member.last_time_ns;
+    if (member.min_interval_ns == 0 || interval < member.min_interval_ns) {
+      member.min_interval_ns = interval;
+    }
+  }
+  member.has_last_time = true;
+  member.last_time_ns = time_ns;
+
+  if (member.count == kPendingFramesPerMember) {
+    member.ring[member.head] = PendingFrame{};
+    member.head = (member.head + 1) % kPendingFramesPerMember;
+    --member.count;
+    ++rig.stats.frames_dropped_unmatched;
+  }
+  member.ring[(member.head + member.count) % kPendingFramesPerMember] = PendingFrame{result, time_ns};
+  ++member.count;
+
+  try_assemble_(rig_id, rig);
+}
+
+void CoreRigStreamFrameSets::try_assemble_(uint64_t rig_id, RigState& rig) {
+  int64_t window_ns = 0;
+  for (const MemberState& member : rig.members) {
+    if (member.min_interval_ns == 0) {
+      return;
+    }
+    if (window_ns == 0 || member.min_interval_ns < window_ns) {
+      window_ns = member.min_interval_ns;
+    }
+  }
+  window_ns /= 2;
+
+  const auto pop_head = [](MemberState& member) {
+    member.ring[member.head] = PendingFrame{};
+    member.head = (member.head + 1) % kPendingFramesPerMember;
+    --member.count;
+  };
+
+  for (;;) {
+    size_t earliest = 0;
+    int64_t earliest_ns = 0;
+    int64_t latest_ns = 0;
+    for (size_t i = 0; i < rig.members.size(); ++i) {
+      const MemberState& member = rig.members[i];
+      if (member.count == 0) {
+        return;
+      }
+      const int64_t head_ns = member.ring[member.head].time_ns;
+      if (i == 0 || head_ns < earliest_ns) {
+        earliest = i;
+        earliest_ns = head_ns;
+      }
+      if (i == 0 || head_ns > latest_ns) {
+        latest_ns = head_ns;
+      }
+    }
+    if (latest_ns - earliest_ns > window_ns) {
+      pop_head(rig.members[earliest]);
+      ++rig.stats.frames_dropped_unmatched;
+      continue;
+    }
+
+    const uint64_t skew_ns = static_cast<uint64_t>(latest_ns - earliest_ns);
+    auto set = std::make_shared<CoreRigStreamFrameSet>();
+    set->rig_id = rig_id;
+    set->set_sequence = rig.next_set_sequence++;
+    set->skew_ns = skew_ns;
+    set->members.reserve(rig.members.size());
+    for (MemberState& member : rig.members) {
+      set->members.push_back(std::move(member.ring[member.head].result));
+      pop_head(member);
+    }
+    ++rig.stats.sets_completed;
+    rig.stats.last_skew_ns = skew_ns;
+    set->frames_dropped_unmatched = rig.stats.frames_dropped_unmatched;
+    set->frames_unmatchable = rig.stats.frames_unmatchable;
+
+    bool claimed = false;
+    const size_t slot = latest_.find_or_claim(rig_id, claimed);
+    if (slot != decltype(latest_)::kNoSlot) {
+      (void)latest_.exchange(slot, std::move(set));
+    }
+  }
+}
+
+CoreRigStreamFrameSets::Stats CoreRigStreamFrameSets::stats(uint64_t rig_id) const {
+  const auto it = rig_states_.find(rig_id);
+  return it == rig_states_.end() ? Stats{} : it->second.stats;
+}
+
+void CoreRigStreamFrameSets::clear() {
+  rig_states_.clear();
+  memberships_.clear();
+  synced_ = false;
+  latest_.clear([](SharedRigStreamFrameSet&&) {});
+}
+
+} // namespace cambang
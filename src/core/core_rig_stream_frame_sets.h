@@ -0,0 +1,139 @@
+// src/core/core_rig_stream_frame_sets.h
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "core/core_result_store.h"
+#include "core/core_string_interner.h"
+#include "core/latest_result_slot_table.h"
+
+namespace cambang {
+
+class CoreDeviceRegistry;
+class CoreRigRegistry;
+
+// One time-aligned frame per rig member, in member_hardware_ids order.
+struct CoreRigStreamFrameSet {
+  uint64_t rig_id = 0;
+  // Increments per completed set of this rig, starting at 1.
+  uint64_t set_sequence = 0;
+  // Latest minus earliest member acquisition time, in nanoseconds.
+  uint64_t skew_ns = 0;
+  // Rig totals at the time this set completed (see Stats).
+  uint64_t frames_dropped_unmatched = 0;
+  uint64_t frames_unmatchable = 0;
+  std::vector<SharedStreamResultData> members;
+};
+
+using SharedRigStreamFrameSet = std::shared_ptr<const CoreRigStreamFrameSet>;
+
+// Groups the repeating-stream results of each rig's member devices into
+// time-aligned frame sets.
+//
+// Frames are matched on ImageAcquisitionTiming. Only timings in one
+// non-opaque clock domain whose comparability holds across devices
+// (SAME_PROVIDER, CROSS_DEVICE_SYNCHRONIZED or CORE_TIMELINE) can be matched;
+// any other frame of a rig member is counted as unmatchable and skipped.
+//
+// Each member keeps at most kPendingFramesPerMember unmatched frames. When
+// every member has one, the oldest pending frames form a set if they span no
+// more than the rig's matching window: half the shortest member frame
+// interval seen so far, so no frame can match two neighbours. Otherwise the
+// earliest of them can no longer match anything (every other member's later
+// frames are later still) and is dropped as unmatched, as is the oldest
+// frame of a member whose pending ring overflows. Matching starts once every
+// member has delivered two frames and so has a frame interval.
+//
+// A member is its device's stream; a frame of another stream of the same
+// device restarts that member, and a device listed by several rigs feeds the
+// lowest rig_id. Rig membership is re-resolved whenever the rig registry
+// changes; a rig whose members change starts over and its former latest set
+// is withdrawn.
+//
+// Threading: on_stream_result()/is_rig_member()/clear() on the core thread;
+// find_latest() from any thread, lock-free (LatestResultSlotTable). Rigs
+// beyond the table's capacity are matched but their sets are not published.
+class CoreRigStreamFrameSets final {
+public:
+  static constexpr size_t kPendingFramesPerMember = 4;
+
+  struct Stats {
+    uint64_t sets_completed = 0;
+    uint64_t frames_dropped_unmatched = 0;
+    uint64_t frames_unmatchable = 0;
+    uint64_t last_skew_ns = 0;
+  };
+
+  CoreRigStreamFrameSets(const CoreRigRegistry* rigs, const CoreDeviceRegistry* devices) noexcept
+      : rigs_(rigs), devices_(devices) {}
+
+  CoreRigStreamFrameSets(const CoreRigStreamFrameSets&) = delete;
+  CoreRigStreamFrameSets& operator=(const CoreRigStreamFrameSets&) = delete;
+
+  // Cheap per-frame pre-check: whether device_instance_id is a member of a
+  // rig with at least two members.
+  bool is_rig_member(uint64_t device_instance_id);
+  void on_stream_result(const SharedStreamResultData& result);
+
+  SharedRigStreamFrameSet find_latest(uint64_t rig_id) const noexcept { return latest_.find(rig_id); }
+  // Core thread. Zeroed stats for an unknown rig.
+  Stats stats(uint64_t rig_id) const;
+
+  // Drops all matching state and published sets.
+  void clear();
+
+private:
+  struct PendingFrame {
+    SharedStreamResultData result;
+    int64_t time_ns = 0;
+  };
+
+  struct MemberState {
+    uint64_t stream_id = 0;
+    bool has_last_time = false;
+    int64_t last_time_ns = 0;
+    // Smallest positive interval between consecutive frames; 0 until known.
+    int64_t min_interval_ns = 0;
+    std::array<PendingFrame, kPendingFramesPerMember> ring{};
+    size_t head = 0;
+    size_t count = 0;
+  };
+
+  struct RigState {
+    std::vector<CoreStringId> member_hardware_keys;
+    std::vector<MemberState> members;
+    bool has_clock_domain = false;
+    ImageAcquisitionClockDomain clock_domain = ImageAcquisitionClockDomain::PROVIDER_MONOTONIC;
+    uint64_t next_set_sequence = 1;
+    Stats stats{};
+  };
+
+  struct Membership {
+    uint64_t rig_id = 0;
+    size_t member_index = 0;
+  };
+
+  void sync_with_rig_registry_();
+  const Membership* resolve_membership_(uint64_t device_instance_id);
+  void try_assemble_(uint64_t rig_id, RigState& rig);
+
+  const CoreRigRegistry* rigs_;      // non-owning; core-thread-only
+  const CoreDeviceRegistry* devices_; // non-owning; core-thread-only
+  uint64_t synced_rig_revision_ = 0;
+  bool synced_ = false;
+  std::map<uint64_t, RigState> rig_states_;
+  // device_instance_id -> membership; rig_id 0 caches "not a rig member".
+  // Device instance ids are not reused, so entries only go stale; the cache
+  // is simply dropped when it reaches kMaxCachedMemberships.
+  static constexpr size_t kMaxCachedMemberships = 64;
+  std::map<uint64_t, Membership> memberships_;
+  LatestResultSlotTable<CoreRigStreamFrameSet, &CoreRigStreamFrameSet::rig_id> latest_;
+};
+
+} // namespace cambang
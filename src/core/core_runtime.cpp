@@ -5,6 +5,7 @@
 #include "core/camera_concurrency_adc.h"
 #include "core/adc_camera_description.h"
 
+#include <algorithm>
 #include <cassert>
 #include <chrono>
 #include <cstddef>
@@ -19,7 +20,10 @@
 
 #include <utility>
 
+#include "imaging/api/async_log.h"
+#include "imaging/api/mapped_file.h"
 #include "imaging/broker/banner_info.h"
+#include "pixels/pixel_simd.h"
 #include "core/resource_aggregate_telemetry.h"
 #include "imaging/api/timeline_teardown_trace.h"
 
@@ -319,7 +323,7 @@ bool CoreRuntime::infer_stream_result_posture_shape_(
               : CoreProductionPostureShape::GpuPrimaryNoCpuSidecar;
     return true;
   }
-  if (result->payload_kind == ResultPayloadKind::CPU_PACKED) {
+  if (is_cpu_payload_kind(result->payload_kind)) {
     out = CoreProductionPostureShape::CpuPrimary;
     return true;
   }
@@ -336,7 +340,7 @@ bool CoreRuntime::infer_capture_member_posture_shape_(
               : CoreProductionPostureShape::GpuPrimaryNoCpuSidecar;
     return true;
   }
-  if (member.payload_kind == ResultPayloadKind::CPU_PACKED) {
+  if (is_cpu_payload_kind(member.payload_kind)) {
     out = CoreProductionPostureShape::CpuPrimary;
     return true;
   }
@@ -648,6 +652,8 @@ struct RetainedPlanResetDecision {
   CoreRetainedProductionPlan requested{};
   CoreRetainedProductionPlan steady{};
   bool evaluation_active = false;
+  // Settled on persisted_prior instead of evaluating.
+  bool from_persisted_prior = false;
   uint8_t candidate_count = 0;
   CoreProductionPostureShape candidate_sequence[3]{};
 };
@@ -655,7 +661,8 @@ struct RetainedPlanResetDecision {
 RetainedPlanResetDecision build_retained_plan_reset_decision(
     BackingPlanEvaluationPrimaryFunction primary_function,
     const ProducerBackingCapabilities& caps,
-    CoreRetainedProductionPlan preferred_requested) noexcept;
+    CoreRetainedProductionPlan preferred_requested,
+    CoreRetainedProductionPlan persisted_prior = {}) noexcept;
 
 size_t build_viable_candidate_order(
     BackingPlanEvaluationPrimaryFunction primary_function,
@@ -685,17 +692,11 @@ size_t build_viable_candidate_order(
   return count;
 }
 
-RetainedPlanResetDecision build_retained_plan_reset_decision(
-    BackingPlanEvaluationPrimaryFunction primary_function,
-    const ProducerBackingCapabilities& caps) noexcept {
-  return build_retained_plan_reset_decision(
-      primary_function, caps, CoreRetainedProductionPlan{});
-}
-
 RetainedPlanResetDecision build_retained_plan_reset_decision(
     BackingPlanEvaluationPrimaryFunction primary_function,
     const ProducerBackingCapabilities& caps,
-    CoreRetainedProductionPlan preferred_requested) noexcept {
+    CoreRetainedProductionPlan preferred_requested,
+    CoreRetainedProductionPlan persisted_prior) noexcept {
   RetainedPlanResetDecision decision{};
   CoreProductionPostureShape ordered[3]{};
   const size_t ordered_count =
@@ -703,6 +704,11 @@ RetainedPlanResetDecision build_retained_plan_reset_decision(
   if (ordered_count == 0u) {
     return decision;
   }
+  const bool settle_on_prior = ordered_count > 1u && persisted_prior.valid &&
+                               caps.viable(persisted_prior.posture);
+  if (settle_on_prior) {
+    preferred_requested = persisted_prior;
+  }
   if (preferred_requested.valid &&
       caps.viable(preferred_requested.posture)) {
     for (size_t i = 0; i < ordered_count; ++i) {
@@ -721,8 +727,9 @@ RetainedPlanResetDecision build_retained_plan_reset_decision(
   for (size_t i = 0; i < ordered_count; ++i) {
     decision.candidate_sequence[i] = ordered[i];
   }
-  if (ordered_count == 1u) {
+  if (ordered_count == 1u || settle_on_prior) {
     decision.steady = decision.requested;
+    decision.from_persisted_prior = settle_on_prior;
     return decision;
   }
 
@@ -738,6 +745,12 @@ RetainedPlanResetDecision build_retained_plan_reset_decision(
 constexpr size_t kMaxProviderFactsPerCoreTurn = 64;
 constexpr size_t kMaxProviderFactsBeforeRequestWhenRequestsPending = 1;
 
+// Provider ingress tasks only move a fact into provider_facts_, so CoreThread
+// may run a batch of them per pump (still yielding at the first command or
+// essential arrival). A frame burst then reaches one timer tick together and
+// Stage C retires its superseded frames in one pass.
+constexpr size_t kOrdinaryIngressTasksPerCoreThreadTurn = 32;
+
 // Monotonic timestamp for CoreStreamRegistry::on_frame_received()'s
 // integrated_ts_ns, which frame-cadence accounting depends on. Not a
 // diagnostic value.
@@ -931,6 +944,7 @@ ProviderFactSummary summarize_provider_fact(const ProviderToCoreCommand& cmd,
       break;
     }
     case ProviderToCoreCommandType::PROVIDER_NATIVE_OBJECT_DESTROYED:
+    case ProviderToCoreCommandType::PROVIDER_NATIVE_OBJECT_COUNTERS:
       out.fact_class = ProviderFactClass::CriticalNonLossy;
       break;
     case ProviderToCoreCommandType::TIMER_TICK:
@@ -966,78 +980,125 @@ bool promote_capture_fact_over_repeating_stream_prefix(
   return false;
 }
 
-bool has_newer_repeating_stream_frame_before_barrier(
-    const std::deque<ProviderToCoreCommand>& provider_facts,
-    const ProviderFactSummary& front_summary,
-    const CoreCaptureCohortRegistry& capture_cohorts) {
-  if (front_summary.fact_class != ProviderFactClass::RepeatingStreamFrame ||
-      front_summary.stream_id == 0) {
-    return false;
-  }
+// Frames of the leading repeating-frame run examined for a higher-priority
+// stream; bounds the per-fact cost of a long run.
+constexpr size_t kMaxPriorityPromotionScan = 64;
 
-  bool skipped_front = false;
-  for (const ProviderToCoreCommand& cmd : provider_facts) {
-    if (!skipped_front) {
-      skipped_front = true;
-      continue;
-    }
+StreamPriority registered_stream_priority(const CoreStreamRegistry& streams, uint64_t stream_id) {
+  const CoreStreamRegistry::StreamRecord* rec = streams.find(stream_id);
+  return rec ? rec->priority : StreamPriority::NORMAL;
+}
 
-    const ProviderFactSummary summary = summarize_provider_fact(cmd, capture_cohorts);
+// Within the leading run of repeating stream frames, moves the first frame of
+// the highest-priority stream found to the front when the front frame's
+// stream is of a lower class. Only a stream's first frame in the run moves,
+// so each stream's own frames keep their order.
+bool promote_priority_stream_frame_over_repeating_prefix(
+    std::deque<ProviderToCoreCommand>& provider_facts,
+    const CoreCaptureCohortRegistry& capture_cohorts,
+    const CoreStreamRegistry& streams) {
+  if (provider_facts.size() < 2) {
+    return false;
+  }
+  const ProviderFactSummary front = summarize_provider_fact(provider_facts.front(), capture_cohorts);
+  if (front.fact_class != ProviderFactClass::RepeatingStreamFrame) {
+    return false;
+  }
+  StreamPriority best_priority = registered_stream_priority(streams, front.stream_id);
+  size_t best_index = 0;
+  const size_t scan_end = std::min(provider_facts.size(), kMaxPriorityPromotionScan);
+  for (size_t i = 1; i < scan_end && best_priority != StreamPriority::HIGH; ++i) {
+    const ProviderFactSummary summary = summarize_provider_fact(provider_facts[i], capture_cohorts);
     if (summary.fact_class != ProviderFactClass::RepeatingStreamFrame) {
-      return false;
+      break;
     }
-    if (summary.stream_id == front_summary.stream_id &&
-        summary.acquisition_session_id == front_summary.acquisition_session_id) {
-      return true;
+    const StreamPriority priority = registered_stream_priority(streams, summary.stream_id);
+    if (priority > best_priority) {
+      best_priority = priority;
+      best_index = i;
     }
   }
-
-  return false;
+  if (best_index == 0) {
+    return false;
+  }
+  ProviderToCoreCommand promoted = std::move(provider_facts[best_index]);
+  provider_facts.erase(provider_facts.begin() + static_cast<std::ptrdiff_t>(best_index));
+  provider_facts.push_front(std::move(promoted));
+  return true;
 }
 
 struct StreamFrameCoalesceResult {
   bool coalesced = false;
-  bool stream_counters_changed = false;
+  size_t frames_released = 0;
 };
 
-StreamFrameCoalesceResult coalesce_front_repeating_stream_frame_if_superseded(
+// Batched Stage C: within the leading run of repeating stream frames (up to
+// the first non-lossy barrier), every frame for the front frame's
+// stream/session except the newest is superseded. Release them all in one
+// pass and compact the run in place, so a burst for one stream costs one
+// scan and a single erase instead of one front-pop per stale frame. Frames
+// for other streams keep their relative order.
+StreamFrameCoalesceResult coalesce_superseded_repeating_stream_frames(
     std::deque<ProviderToCoreCommand>& provider_facts,
     const ProviderFactSummary& front_summary,
     const CoreCaptureCohortRegistry& capture_cohorts,
     CoreStreamRegistry& streams) {
   StreamFrameCoalesceResult out{};
-  if (!has_newer_repeating_stream_frame_before_barrier(provider_facts, front_summary, capture_cohorts)) {
+  if (front_summary.fact_class != ProviderFactClass::RepeatingStreamFrame ||
+      front_summary.stream_id == 0) {
+    return out;
+  }
+
+  auto is_front_stream_frame = [&front_summary](const ProviderFactSummary& summary) {
+    return summary.stream_id == front_summary.stream_id &&
+        summary.acquisition_session_id == front_summary.acquisition_session_id;
+  };
+
+  size_t run_end = 1;
+  size_t newest_index = 0;
+  for (; run_end < provider_facts.size(); ++run_end) {
+    const ProviderFactSummary summary = summarize_provider_fact(provider_facts[run_end], capture_cohorts);
+    if (summary.fact_class != ProviderFactClass::RepeatingStreamFrame) {
+      break;
+    }
+    if (is_front_stream_frame(summary)) {
+      newest_index = run_end;
+    }
+  }
+  if (newest_index == 0) {
     return out;
   }
 
-  ProviderToCoreCommand cmd = std::move(provider_facts.front());
-  provider_facts.pop_front();
-  auto& frame = std::get<CmdProviderFrame>(cmd.payload).frame;
   const uint64_t integrated_ts_ns = frame_integration_now_ns();
-  const bool received_counted = streams.on_frame_received(frame.stream_id, integrated_ts_ns);
-  const bool dropped_counted = streams.on_frame_dropped(frame.stream_id);
-  frame.release_now();
-  global_resource_aggregate_telemetry().lease_released(make_framebuffer_lease_scoped_resource_telemetry_key(
-      frame.stream_id,
-      frame.acquisition_session_id));
-  frame.release = nullptr;
-  frame.release_user = nullptr;
+  size_t write = 0;
+  for (size_t read = 0; read < run_end; ++read) {
+    ProviderToCoreCommand& cmd = provider_facts[read];
+    auto& payload = std::get<CmdProviderFrame>(cmd.payload);
+    auto& frame = payload.frame;
+    if (read != newest_index &&
+        frame.stream_id == front_summary.stream_id &&
+        frame.acquisition_session_id == front_summary.acquisition_session_id) {
+      (void)streams.on_frame_received(frame.stream_id, integrated_ts_ns, frame);
+      (void)streams.on_frame_dropped(frame.stream_id);
+      frame.release_now();
+      framebuffer_lease_released(payload.lease_telemetry, frame.stream_id, frame.acquisition_session_id);
+      frame.release = nullptr;
+      frame.release_user = nullptr;
+      ++out.frames_released;
+      continue;
+    }
+    if (write != read) {
+      provider_facts[write] = std::move(cmd);
+    }
+    ++write;
+  }
+  provider_facts.erase(provider_facts.begin() + static_cast<std::ptrdiff_t>(write),
+                       provider_facts.begin() + static_cast<std::ptrdiff_t>(run_end));
 
   out.coalesced = true;
-  out.stream_counters_changed = received_counted || dropped_counted;
   return out;
 }
 
-uint64_t warm_delay_ns(uint32_t warm_hold_ms) {
-  if (warm_hold_ms == 0) {
-    return 0;
-  }
-  if (warm_hold_ms >= (std::numeric_limits<uint64_t>::max() / kNsPerMs)) {
-    return std::numeric_limits<uint64_t>::max();
-  }
-  return static_cast<uint64_t>(warm_hold_ms) * kNsPerMs;
-}
-
 bool seed_retained_device_still_profile_from_template(CoreDeviceRegistry& devices,
                                                       uint64_t device_instance_id,
                                                       const CaptureTemplate& capture_tmpl) {
@@ -1220,6 +1281,69 @@ void CoreRuntime::remember_capture_priming_seed_(
       CapturePrimingSeed{signature, selected};
 }
 
+bool CoreRuntime::build_retained_plan_prior_key_(
+    const std::string& hardware_id,
+    BackingPlanEvaluationPrimaryFunction primary_function,
+    uint32_t width,
+    uint32_t height,
+    uint32_t format_fourcc,
+    uint32_t image_member_count,
+    ProducerBackingCapabilities runtime_backing_capabilities,
+    ProducerBackingCapabilities parent_context_backing_capabilities,
+    CoreRetainedPlanPriorStore::Key& out) const {
+  const ICameraProvider* prov = provider_.load(std::memory_order_acquire);
+  if (!prov || hardware_id.empty() || retained_plan_priors_.path().empty()) {
+    return false;
+  }
+  const char* provider_name = prov->provider_name();
+  out = CoreRetainedPlanPriorStore::Key{};
+  out.provider_name = provider_name ? provider_name : "";
+  out.hardware_id = hardware_id;
+  out.primary_function = static_cast<uint8_t>(primary_function);
+  out.width = width;
+  out.height = height;
+  out.format_fourcc = format_fourcc;
+  out.image_member_count = image_member_count;
+  out.runtime_backing_capabilities = runtime_backing_capabilities;
+  out.parent_context_backing_capabilities = parent_context_backing_capabilities;
+  return true;
+}
+
+bool CoreRuntime::build_stream_retained_plan_prior_key_(
+    uint64_t device_instance_id,
+    const CaptureProfile& profile,
+    ProducerBackingCapabilities runtime_backing_capabilities,
+    ProducerBackingCapabilities parent_context_backing_capabilities,
+    CoreRetainedPlanPriorStore::Key& out) const {
+  const CoreDeviceRegistry::DeviceRecord* device = devices_.find(device_instance_id);
+  return device &&
+         build_retained_plan_prior_key_(
+             device->hardware_id,
+             BackingPlanEvaluationPrimaryFunction::StreamDisplayView,
+             profile.width,
+             profile.height,
+             profile.format_fourcc,
+             0,
+             runtime_backing_capabilities,
+             parent_context_backing_capabilities,
+             out);
+}
+
+bool CoreRuntime::build_capture_retained_plan_prior_key_(
+    const CapturePrimingSeedSignature& signature,
+    CoreRetainedPlanPriorStore::Key& out) const {
+  return build_retained_plan_prior_key_(
+      signature.hardware_id,
+      BackingPlanEvaluationPrimaryFunction::CaptureReadyAndMaterialize,
+      signature.width,
+      signature.height,
+      signature.format_fourcc,
+      static_cast<uint32_t>(signature.still_image_bundle.members.size()),
+      signature.runtime_backing_capabilities,
+      signature.parent_context_backing_capabilities,
+      out);
+}
+
 void CoreRuntime::release_capture_parent_priming_(uint64_t device_instance_id) {
   if (device_instance_id == 0) {
     return;
@@ -1350,6 +1474,9 @@ CoreRuntime::CoreRuntime()
       }, [this]() -> bool {
         return state_.load(std::memory_order_acquire) == CoreRuntimeState::LIVE;
       }),
+#if CAMBANG_PROVIDER_BOUND
+      ingress_(&core_thread_, this) {
+#else
       ingress_(&core_thread_, [this](ProviderToCoreCommand&& cmd) {
         // This lambda is executed ONLY on the core thread (posted by ingress).
         // Provider callbacks are "facts"; we enqueue them and process them before requests
@@ -1361,54 +1488,63 @@ CoreRuntime::CoreRuntime()
         // IProviderCallbacks::core_monotonic_now_ns is documented safe to call from
         // any provider thread; ns_since_epoch_() honors that (epoch_steady_ns_ is atomic).
         return ns_since_epoch_();
-      }, [this,
-          demand_last = std::make_shared<std::map<uint64_t, bool>>(),
-          demand_last_mu = std::make_shared<std::mutex>()](uint64_t stream_id) -> bool {
-        // IProviderCallbacks::is_stream_display_demand_active is documented safe to
-        // call from any provider thread. demand_last is trace-only bookkeeping (not
-        // the functional return value) but was previously captured as bare mutable
-        // lambda state with no synchronization, which is a real data race the moment
-        // more than one provider thread calls this concurrently. Protect it explicitly
-        // via a shared mutex rather than relying on single-caller-thread luck.
-        const uint64_t now_ns = ns_since_epoch_();
-        const auto state = result_store_.get_stream_display_demand_state(stream_id, now_ns);
-        if (display_demand_trace_enabled()) {
-          bool changed = false;
-          {
-            std::lock_guard<std::mutex> lock(*demand_last_mu);
-            bool& prev = (*demand_last)[stream_id];
-            changed = prev != state.active;
-            if (changed) {
-              prev = state.active;
-            }
-          }
-          if (changed) {
-            const char* reason = "none";
-            if (state.reason == CoreResultStore::DisplayDemandReason::PERSISTENT_REFCOUNT) {
-              reason = "persistent_refcount";
-            } else if (state.reason == CoreResultStore::DisplayDemandReason::LEASE) {
-              reason = "lease";
-            }
-            std::printf("[CamBANG][DemandTrace] demand_transition stream_id=%llu active=%d reason=%s refcount=%u\n",
-                        static_cast<unsigned long long>(stream_id),
-                        state.active ? 1 : 0,
-                        reason,
-                        state.refcount);
-          }
-        }
-        return state.active;
+      }, [this](uint64_t stream_id) -> bool {
+        return provider_stream_display_demand_active_(stream_id);
       }, [this]() -> uint64_t {
         return applying_stream_retained_plan_for_stream_id_.load(std::memory_order_acquire);
       }) {
+#endif
+  core_thread_.set_ordinary_tasks_per_turn(kOrdinaryIngressTasksPerCoreThreadTurn);
+  ingress_.set_latest_wins_frames_per_stream(kLiveFramesQueuedPerStream);
+  ingress_.set_cpu_payload_buffer_pool(&cpu_payload_buffer_pool_);
+  result_store_.set_cpu_payload_buffer_pool(&cpu_payload_buffer_pool_);
   dispatcher_.set_result_store(&result_store_);
+  dispatcher_.set_frame_shards(&frame_shards_);
+  dispatcher_.set_rig_stream_frame_sets(&rig_stream_frame_sets_);
+  dispatcher_.set_stream_recorder(&stream_recorder_);
+  dispatcher_.set_stream_exporter(&stream_exporter_);
   dispatcher_.set_capture_assembly_registry(&capture_assembly_registry_);
   dispatcher_.set_provider_camera_fact_state(&provider_camera_fact_state_);
+  dispatcher_.set_operation_registry(&operations_);
   dispatcher_.set_capture_lifecycle_ingress_sink(
       [this](const CoreCaptureLifecycleIngressEvent& event) {
         note_capture_lifecycle_ingress_(event);
       });
 }
 
+bool CoreRuntime::provider_stream_display_demand_active_(uint64_t stream_id) {
+  // IProviderCallbacks::is_stream_display_demand_active is documented safe to
+  // call from any provider thread. The trace bookkeeping is shared by every
+  // caller, so it stays under its own mutex.
+  const uint64_t now_ns = ns_since_epoch_();
+  const auto state = result_store_.get_stream_display_demand_state(stream_id, now_ns);
+  if (display_demand_trace_enabled()) {
+    bool changed = false;
+    {
+      std::lock_guard<std::mutex> lock(display_demand_trace_mu_);
+      bool& prev = display_demand_trace_last_[stream_id];
+      changed = prev != state.active;
+      if (changed) {
+        prev = state.active;
+      }
+    }
+    if (changed) {
+      const char* reason = "none";
+      if (state.reason == CoreResultStore::DisplayDemandReason::PERSISTENT_REFCOUNT) {
+        reason = "persistent_refcount";
+      } else if (state.reason == CoreResultStore::DisplayDemandReason::LEASE) {
+        reason = "lease";
+      }
+      async_log_printf(stdout, "[CamBANG][DemandTrace] demand_transition stream_id=%llu active=%d reason=%s refcount=%u\n",
+                       static_cast<unsigned long long>(stream_id),
+                       state.active ? 1 : 0,
+                       reason,
+                       state.refcount);
+    }
+  }
+  return state.active;
+}
+
 CoreRuntime::~CoreRuntime() {
   stop();
 }
@@ -1418,7 +1554,10 @@ SharedCaptureResultData CoreRuntime::get_capture_result(uint64_t capture_id, uin
           capture_id, device_instance_id)) {
     return nullptr;
   }
-  return result_store_.get_capture_result(capture_id, device_instance_id);
+  if (SharedCaptureResultData result = result_store_.get_capture_result(capture_id, device_instance_id)) {
+    return result;
+  }
+  return capture_spill_store_.load(capture_id, device_instance_id);
 }
 
 void CoreRuntime::report_stream_retained_to_image_observation(
@@ -1630,10 +1769,18 @@ bool CoreRuntime::refresh_stream_retained_plan_state_(
   }
   (void)streams_.set_backing_capabilities(
       stream_id, runtime_caps, parent_context_caps);
+  CoreRetainedPlanPriorStore::Key prior_key;
+  CoreRetainedProductionPlan prior{};
+  if (build_stream_retained_plan_prior_key_(
+          rec->device_instance_id, rec->profile, runtime_caps, parent_context_caps, prior_key)) {
+    (void)retained_plan_priors_.find(prior_key, prior);
+  }
   const RetainedPlanResetDecision decision =
       build_retained_plan_reset_decision(
           BackingPlanEvaluationPrimaryFunction::StreamDisplayView,
-          parent_context_caps);
+          parent_context_caps,
+          CoreRetainedProductionPlan{},
+          prior);
   if (!decision.requested.valid) {
     (void)streams_.set_requested_retained_plan(
         stream_id, CoreRetainedProductionPlan{}, requested_bump_access_posture_epoch);
@@ -1683,6 +1830,10 @@ bool CoreRuntime::refresh_stream_retained_plan_state_(
             decision.steady,
             decision.candidate_count,
             candidate_sequence);
+    if (decision.from_persisted_prior) {
+      provenance.completion_reason =
+          BackingPlanEvaluationCompletionReason::PersistedPrior;
+    }
     stream_retained_plan_decisions_[stream_id] = provenance;
   }
 
@@ -1690,7 +1841,7 @@ bool CoreRuntime::refresh_stream_retained_plan_state_(
       !same_retained_plan(previous_requested, decision.requested)) {
     applying_stream_retained_plan_for_stream_id_.store(stream_id, std::memory_order_release);
     const bool ok = prov->update_stream_retained_production_plan(
-               stream_id, decision.requested)
+               stream_id, rec->requested_retained_plan)
         .ok();
     applying_stream_retained_plan_for_stream_id_.store(0, std::memory_order_release);
     (void)refresh_capture_retained_plan_state_(
@@ -1877,7 +2028,8 @@ bool CoreRuntime::integrate_pending_provider_facts_before_capture_request_() {
       capture_parent_device_instance_id = summary.device_instance_id;
     }
 
-    dispatcher_.dispatch(std::move(cmd));
+    dispatch_provider_fact_timed_(
+        std::move(cmd), summary.fact_class == ProviderFactClass::RepeatingStreamFrame);
     if (capture_parent_device_instance_id != 0 &&
         rehome_capture_retained_plan_parent_state_(
             capture_parent_device_instance_id,
@@ -2269,12 +2421,20 @@ bool CoreRuntime::refresh_capture_retained_plan_state_(
       build_capture_priming_seed_signature_(
           device_instance_id, effective, runtime_caps, parent_context_caps);
   CoreRetainedProductionPlan preferred_requested{};
-  (void)try_find_capture_priming_seed_(seed_signature, preferred_requested);
+  // An in-generation seed means this generation has evaluated already; the
+  // persisted prior only stands in for that.
+  CoreRetainedPlanPriorStore::Key prior_key;
+  CoreRetainedProductionPlan prior{};
+  if (!try_find_capture_priming_seed_(seed_signature, preferred_requested) &&
+      build_capture_retained_plan_prior_key_(seed_signature, prior_key)) {
+    (void)retained_plan_priors_.find(prior_key, prior);
+  }
   const RetainedPlanResetDecision decision =
       build_retained_plan_reset_decision(
           BackingPlanEvaluationPrimaryFunction::CaptureReadyAndMaterialize,
           parent_context_caps,
-          preferred_requested);
+          preferred_requested,
+          prior);
   auto preserved_evaluator_matches_decision =
       [&](const RetainedPlanEvaluatorState& state) noexcept {
         if (!state.active || !decision.evaluation_active ||
@@ -2658,6 +2818,10 @@ bool CoreRuntime::refresh_capture_retained_plan_state_(
             candidate_sequence);
     provenance.orphan_retire_after_ns = 0;
     provenance.capture_priming_seed_signature = seed_signature;
+    if (decision.from_persisted_prior) {
+      provenance.completion_reason =
+          BackingPlanEvaluationCompletionReason::PersistedPrior;
+    }
     capture_retained_plan_decisions_[parent.key] = provenance;
     if (parent.acquisition_session_id == 0 &&
         !same_non_evaluated_decision_already_installed) {
@@ -2803,12 +2967,24 @@ void CoreRuntime::handle_stream_retained_display_view_observation_(
           (void)streams_.set_requested_retained_plan(stream_id, chosen, true);
           if (ICameraProvider* prov = provider_.load(std::memory_order_acquire)) {
             applying_stream_retained_plan_for_stream_id_.store(stream_id, std::memory_order_release);
-            (void)prov->update_stream_retained_production_plan(stream_id, chosen);
+            (void)prov->update_stream_retained_production_plan(stream_id, rec->requested_retained_plan);
             applying_stream_retained_plan_for_stream_id_.store(0, std::memory_order_release);
           }
         }
         (void)streams_.set_steady_retained_plan(stream_id, chosen);
         state.completion_reason = completion_reason;
+        if (completion_reason ==
+            BackingPlanEvaluationCompletionReason::AllViableCandidatesEvaluated) {
+          CoreRetainedPlanPriorStore::Key prior_key;
+          if (build_stream_retained_plan_prior_key_(
+                  rec->device_instance_id,
+                  rec->profile,
+                  rec->runtime_backing_capabilities,
+                  rec->parent_context_backing_capabilities,
+                  prior_key)) {
+            retained_plan_priors_.remember(prior_key, chosen);
+          }
+        }
         RetainedPlanDecisionProvenance provenance =
             build_decision_provenance_(state, chosen);
         stream_retained_plan_decisions_[stream_id] = provenance;
@@ -2848,7 +3024,7 @@ void CoreRuntime::handle_stream_retained_display_view_observation_(
                 provider_.load(std::memory_order_acquire)) {
           applying_stream_retained_plan_for_stream_id_.store(stream_id, std::memory_order_release);
           (void)prov->update_stream_retained_production_plan(
-              stream_id, next_plan);
+              stream_id, rec->requested_retained_plan);
           applying_stream_retained_plan_for_stream_id_.store(0, std::memory_order_release);
         }
         (void)refresh_capture_retained_plan_state_(
@@ -2899,21 +3075,27 @@ void CoreRuntime::process_pending_capture_observations_(
     uint64_t& next_delay_ns) {
   assert(core_thread_.is_core_thread());
 
-  std::deque<PendingCaptureObservation> due;
-  for (auto it = pending_capture_observations_.begin();
-       it != pending_capture_observations_.end();) {
-    if (it->not_before_ns <= now_ns) {
-      due.push_back(*it);
-      it = pending_capture_observations_.erase(it);
-      continue;
-    }
-    const uint64_t remaining_ns = it->not_before_ns - now_ns;
+  // One pass splits due observations from waiting ones (erasing from the
+  // middle of the deque made each tick quadratic in the backlog).
+  auto note_delay = [&](const PendingCaptureObservation& pending) {
+    const uint64_t remaining_ns = pending.not_before_ns - now_ns;
     if (!has_next_delay || remaining_ns < next_delay_ns) {
       has_next_delay = true;
       next_delay_ns = remaining_ns;
     }
-    ++it;
+  };
+  std::deque<PendingCaptureObservation> due;
+  std::deque<PendingCaptureObservation> waiting;
+  for (const PendingCaptureObservation& pending : pending_capture_observations_) {
+    if (pending.not_before_ns <= now_ns) {
+      due.push_back(pending);
+      continue;
+    }
+    note_delay(pending);
+    waiting.push_back(pending);
   }
+  pending_capture_observations_.swap(waiting);
+  const size_t carried = pending_capture_observations_.size();
 
   while (!due.empty()) {
     PendingCaptureObservation pending = due.front();
@@ -2932,14 +3114,11 @@ void CoreRuntime::process_pending_capture_observations_(
         pending.deferred_retries_remaining);
   }
 
-  for (const PendingCaptureObservation& pending : pending_capture_observations_) {
-    if (pending.not_before_ns <= now_ns) {
-      continue;
-    }
-    const uint64_t remaining_ns = pending.not_before_ns - now_ns;
-    if (!has_next_delay || remaining_ns < next_delay_ns) {
-      has_next_delay = true;
-      next_delay_ns = remaining_ns;
+  // Observations the handlers deferred again.
+  for (size_t i = carried; i < pending_capture_observations_.size(); ++i) {
+    const PendingCaptureObservation& pending = pending_capture_observations_[i];
+    if (pending.not_before_ns > now_ns) {
+      note_delay(pending);
     }
   }
 }
@@ -2967,6 +3146,34 @@ void CoreRuntime::mark_capture_retained_plan_state_orphaned_for_device_(
   }
 }
 
+void CoreRuntime::publish_unknown_scope_byte_gauge_(ResourceByteGauge gauge,
+                                                    uint64_t bytes,
+                                                    uint64_t& published) noexcept {
+  if (bytes == published) {
+    return;
+  }
+  const ScopedResourceTelemetryKey key = make_unknown_scoped_resource_telemetry();
+  if (bytes > published) {
+    global_resource_aggregate_telemetry().bytes_retained(key, gauge, bytes - published);
+  } else {
+    global_resource_aggregate_telemetry().bytes_released(key, gauge, published - bytes);
+  }
+  published = bytes;
+}
+
+void CoreRuntime::publish_payload_buffer_telemetry_(bool withdraw) noexcept {
+  const CpuPayloadAllocationStats alloc = withdraw ? CpuPayloadAllocationStats{} : cpu_payload_allocation_stats();
+  publish_unknown_scope_byte_gauge_(ResourceByteGauge::POOLED_BUFFER,
+                                    withdraw ? 0 : cpu_payload_buffer_pool_.free_pooled_bytes(),
+                                    published_pooled_buffer_bytes_);
+  publish_unknown_scope_byte_gauge_(ResourceByteGauge::LARGE_PAGE_BUFFER,
+                                    alloc.large_page_bytes_current,
+                                    published_large_page_buffer_bytes_);
+  publish_unknown_scope_byte_gauge_(ResourceByteGauge::LARGE_PAGE_FALLBACK,
+                                    alloc.fallback_bytes_current,
+                                    published_large_page_fallback_bytes_);
+}
+
 size_t CoreRuntime::retire_expired_capture_retained_plan_orphans_(
     uint64_t now_ns) {
   assert(core_thread_.is_core_thread());
@@ -3358,6 +3565,11 @@ void CoreRuntime::handle_capture_retained_to_image_observation_(
       session != nullptr && session->phase == CBLifecyclePhase::LIVE;
   remember_capture_priming_seed_(
       state.capture_priming_seed_signature, chosen);
+  CoreRetainedPlanPriorStore::Key prior_key;
+  if (build_capture_retained_plan_prior_key_(
+          state.capture_priming_seed_signature, prior_key)) {
+    retained_plan_priors_.remember(prior_key, chosen);
+  }
   RetainedPlanDecisionProvenance provenance =
       build_decision_provenance_(state, chosen);
   if (!session_still_live) {
@@ -3452,23 +3664,33 @@ CoreRuntime::imaging_spec_retained_state_for_smoke() const {
   return completed.get();
 }
 
-std::optional<ExternalCameraDescriptionEntry>
-CoreRuntime::active_external_camera_description_for_smoke(const std::string& camera_id) const {
-  if (camera_id.empty()) {
-    return std::nullopt;
-  }
+std::optional<CoreRuntime::ResourceFootprintForSmoke>
+CoreRuntime::resource_footprint_for_smoke() const {
+  const auto collect = [this]() {
+    ResourceFootprintForSmoke out{};
+    out.devices = devices_.all().size();
+    out.streams = streams_.all().size();
+    out.acquisition_sessions = acquisition_sessions_.all().size();
+    out.rigs = rigs_.all().size();
+    out.native_objects = native_objects_.all().size();
+    out.capture_assemblies = capture_assembly_registry_.assembly_count();
+    out.capture_cohorts = capture_cohort_registry_.cohort_count();
+    out.pending_capture_observations = pending_capture_observations_.size();
+    out.capture_stream_preemption_devices = capture_stream_preemptions_by_device_.size();
+    out.telemetry_buckets = global_resource_aggregate_telemetry().bucket_count();
+    out.estimated_capture_bytes = result_store_.total_estimated_capture_bytes();
+    out.result_store = result_store_.table_sizes();
+    return out;
+  };
   if (core_thread_.is_core_thread()) {
-    const auto* entry = active_external_camera_description_.find_exact(camera_id);
-    return entry ? std::optional<ExternalCameraDescriptionEntry>(*entry) : std::nullopt;
+    return collect();
   }
-  auto completion =
-      std::make_shared<std::promise<std::optional<ExternalCameraDescriptionEntry>>>();
-  std::future<std::optional<ExternalCameraDescriptionEntry>> completed = completion->get_future();
+
+  auto completion = std::make_shared<std::promise<std::optional<ResourceFootprintForSmoke>>>();
+  std::future<std::optional<ResourceFootprintForSmoke>> completed = completion->get_future();
   CoreRuntime* self = const_cast<CoreRuntime*>(this);
-  const CoreThread::PostResult pr = self->try_post([this, camera_id, completion]() {
-    const auto* entry = active_external_camera_description_.find_exact(camera_id);
-    completion->set_value(entry ? std::optional<ExternalCameraDescriptionEntry>(*entry)
-                                : std::nullopt);
+  const CoreThread::PostResult pr = self->try_post([collect, completion]() {
+    completion->set_value(collect());
   });
   if (pr != CoreThread::PostResult::Enqueued) {
     return std::nullopt;
@@ -3479,42 +3701,22 @@ CoreRuntime::active_external_camera_description_for_smoke(const std::string& cam
   return completed.get();
 }
 
-size_t CoreRuntime::active_external_camera_description_count_for_smoke() const {
-  if (core_thread_.is_core_thread()) {
-    return active_external_camera_description_.entries().size();
-  }
-  auto completion = std::make_shared<std::promise<size_t>>();
-  std::future<size_t> completed = completion->get_future();
-  CoreRuntime* self = const_cast<CoreRuntime*>(this);
-  const CoreThread::PostResult pr = self->try_post([this, completion]() {
-    completion->set_value(active_external_camera_description_.entries().size());
-  });
-  if (pr != CoreThread::PostResult::Enqueued) {
-    return 0;
-  }
-  if (completed.wait_for(std::chrono::seconds(2)) != std::future_status::ready) {
-    return 0;
+std::optional<ExternalCameraDescriptionEntry>
+CoreRuntime::active_external_camera_description_for_smoke(const std::string& camera_id) const {
+  if (camera_id.empty()) {
+    return std::nullopt;
   }
-  return completed.get();
+  const SharedExternalCameraDescription active = active_external_camera_description();
+  const auto* entry = active->state.find_exact(camera_id);
+  return entry ? std::optional<ExternalCameraDescriptionEntry>(*entry) : std::nullopt;
+}
+
+size_t CoreRuntime::active_external_camera_description_count_for_smoke() const {
+  return active_external_camera_description()->state.entries().size();
 }
 
 uint64_t CoreRuntime::active_external_camera_description_version_for_smoke() const {
-  if (core_thread_.is_core_thread()) {
-    return active_camera_description_version_;
-  }
-  auto completion = std::make_shared<std::promise<uint64_t>>();
-  std::future<uint64_t> completed = completion->get_future();
-  CoreRuntime* self = const_cast<CoreRuntime*>(this);
-  const CoreThread::PostResult pr = self->try_post([this, completion]() {
-    completion->set_value(active_camera_description_version_);
-  });
-  if (pr != CoreThread::PostResult::Enqueued) {
-    return 0;
-  }
-  if (completed.wait_for(std::chrono::seconds(2)) != std::future_status::ready) {
-    return 0;
-  }
-  return completed.get();
+  return active_external_camera_description()->version;
 }
 #endif
 
@@ -3792,16 +3994,15 @@ CoreRuntime::recent_capture_lifecycle_timing_reports_on_core_thread_() const {
   return out;
 }
 
-void CoreRuntime::note_capture_lifecycle_ingress_(
-    const CoreCaptureLifecycleIngressEvent& event) {
+CoreCaptureLifecycleTimingReport* CoreRuntime::capture_lifecycle_timing_report_(
+    uint64_t capture_id, uint64_t device_instance_id) {
   assert(core_thread_.is_core_thread());
-  const std::pair<uint64_t, uint64_t> key{
-      event.capture_id, event.device_instance_id};
+  const std::pair<uint64_t, uint64_t> key{capture_id, device_instance_id};
   auto it = recent_capture_lifecycle_timing_reports_.find(key);
   if (it == recent_capture_lifecycle_timing_reports_.end()) {
     CoreCaptureLifecycleTimingReport report{};
-    report.capture_id = event.capture_id;
-    report.device_instance_id = event.device_instance_id;
+    report.capture_id = capture_id;
+    report.device_instance_id = device_instance_id;
     it = recent_capture_lifecycle_timing_reports_
              .emplace(key, std::move(report))
              .first;
@@ -3816,12 +4017,40 @@ void CoreRuntime::note_capture_lifecycle_ingress_(
       recent_capture_lifecycle_timing_reports_.erase(oldest);
       it = recent_capture_lifecycle_timing_reports_.find(key);
       if (it == recent_capture_lifecycle_timing_reports_.end()) {
-        return;
+        return nullptr;
       }
     }
   }
+  return &it->second;
+}
+
+void CoreRuntime::note_capture_trigger_timing_(uint64_t capture_id,
+                                               uint64_t device_instance_id,
+                                               uint64_t rig_id,
+                                               uint64_t triggered_steady_ns,
+                                               uint64_t admitted_steady_ns) {
+  CoreCaptureLifecycleTimingReport* report =
+      capture_lifecycle_timing_report_(capture_id, device_instance_id);
+  if (!report) {
+    return;
+  }
+  report->rig_id = rig_id;
+  report->has_capture_triggered_steady_ns = true;
+  report->capture_triggered_steady_ns = triggered_steady_ns;
+  report->has_capture_admitted_steady_ns = true;
+  report->capture_admitted_steady_ns = admitted_steady_ns;
+}
+
+void CoreRuntime::note_capture_lifecycle_ingress_(
+    const CoreCaptureLifecycleIngressEvent& event) {
+  assert(core_thread_.is_core_thread());
+  CoreCaptureLifecycleTimingReport* found =
+      capture_lifecycle_timing_report_(event.capture_id, event.device_instance_id);
+  if (!found) {
+    return;
+  }
 
-  CoreCaptureLifecycleTimingReport& report = it->second;
+  CoreCaptureLifecycleTimingReport& report = *found;
   report.capture_id = event.capture_id;
   report.device_instance_id = event.device_instance_id;
   if (event.acquisition_session_id != 0) {
@@ -3832,11 +4061,22 @@ void CoreRuntime::note_capture_lifecycle_ingress_(
       report.has_capture_started_ingested_steady_ns = true;
       report.capture_started_ingested_steady_ns = event.ingest_steady_ns;
       break;
-    case CoreCaptureLifecycleIngressEvent::Kind::Completed:
+    case CoreCaptureLifecycleIngressEvent::Kind::ImageArrived:
+      if (!report.has_capture_image_ingested_steady_ns) {
+        report.has_capture_image_ingested_steady_ns = true;
+        report.capture_image_ingested_steady_ns = event.ingest_steady_ns;
+      }
+      break;
+    case CoreCaptureLifecycleIngressEvent::Kind::Completed: {
+      const bool first_completion = !report.has_capture_completed_ingested_steady_ns;
       report.has_capture_completed_ingested_steady_ns = true;
       report.capture_completed_ingested_steady_ns = event.ingest_steady_ns;
       finalize_completed_capture_facts_(event.capture_id, event.device_instance_id);
+      if (first_completion) {
+        record_capture_latency_(report);
+      }
       break;
+    }
     case CoreCaptureLifecycleIngressEvent::Kind::Failed:
       report.has_capture_failed_ingested_steady_ns = true;
       report.capture_failed_ingested_steady_ns = event.ingest_steady_ns;
@@ -3844,72 +4084,189 @@ void CoreRuntime::note_capture_lifecycle_ingress_(
   }
 }
 
-CoreResolvedCaptureImageFacts CoreRuntime::resolve_capture_image_facts_(
-    uint64_t capture_id,
-    uint64_t device_instance_id,
-    uint32_t image_member_index) const {
+void CoreRuntime::record_capture_latency_(const CoreCaptureLifecycleTimingReport& report) {
+  assert(core_thread_.is_core_thread());
+  using Metric = CoreCaptureLatencyStats::Metric;
+  // A capture completing after its device closed feeds only its rig.
+  const bool device_known = devices_.find(report.device_instance_id) != nullptr;
+  const auto record = [&](Metric metric, bool has_from, uint64_t from_ns, bool has_to, uint64_t to_ns, bool rig) {
+    if (!has_from || !has_to || to_ns < from_ns) {
+      return;
+    }
+    if (device_known) {
+      capture_latency_stats_.record_device(report.device_instance_id, metric, to_ns - from_ns);
+    }
+    if (rig) {
+      capture_latency_stats_.record_rig(report.rig_id, metric, to_ns - from_ns);
+    }
+  };
+  record(Metric::Admission,
+         report.has_capture_triggered_steady_ns, report.capture_triggered_steady_ns,
+         report.has_capture_admitted_steady_ns, report.capture_admitted_steady_ns, true);
+  record(Metric::ProviderStart,
+         report.has_capture_admitted_steady_ns, report.capture_admitted_steady_ns,
+         report.has_capture_started_ingested_steady_ns, report.capture_started_ingested_steady_ns, true);
+  record(Metric::ImageArrival,
+         report.has_capture_started_ingested_steady_ns, report.capture_started_ingested_steady_ns,
+         report.has_capture_image_ingested_steady_ns, report.capture_image_ingested_steady_ns, true);
+  record(Metric::Finalization,
+         report.has_capture_image_ingested_steady_ns, report.capture_image_ingested_steady_ns,
+         report.has_capture_completed_ingested_steady_ns, report.capture_completed_ingested_steady_ns, true);
+  // A rig's end-to-end latency runs to its last member (below).
+  record(Metric::Capture,
+         report.has_capture_triggered_steady_ns, report.capture_triggered_steady_ns,
+         report.has_capture_completed_ingested_steady_ns, report.capture_completed_ingested_steady_ns, false);
+  if (report.rig_id != 0) {
+    record_rig_capture_latency_(report.capture_id, report.rig_id);
+  }
+}
+
+void CoreRuntime::record_rig_capture_latency_(uint64_t capture_id, uint64_t rig_id) {
+  assert(core_thread_.is_core_thread());
+  const std::optional<CoreCaptureCohortRegistry::CohortRecord> cohort =
+      capture_cohort_registry_.find(capture_id);
+  if (!cohort || cohort->rig_id != rig_id || cohort->expected_participants.empty()) {
+    return;
+  }
+  uint64_t first_triggered_ns = UINT64_MAX;
+  uint64_t last_completed_ns = 0;
+  uint64_t first_started_ns = UINT64_MAX;
+  uint64_t last_started_ns = 0;
+  for (const CoreCaptureCohortRegistry::Participant& participant : cohort->expected_participants) {
+    const auto it = recent_capture_lifecycle_timing_reports_.find({capture_id, participant.device_instance_id});
+    if (it == recent_capture_lifecycle_timing_reports_.end()) {
+      return;
+    }
+    const CoreCaptureLifecycleTimingReport& member = it->second;
+    // Recorded once, by the last member to complete.
+    if (!member.has_capture_completed_ingested_steady_ns ||
+        !member.has_capture_started_ingested_steady_ns ||
+        !member.has_capture_triggered_steady_ns) {
+      return;
+    }
+    first_triggered_ns = std::min(first_triggered_ns, member.capture_triggered_steady_ns);
+    last_completed_ns = std::max(last_completed_ns, member.capture_completed_ingested_steady_ns);
+    first_started_ns = std::min(first_started_ns, member.capture_started_ingested_steady_ns);
+    last_started_ns = std::max(last_started_ns, member.capture_started_ingested_steady_ns);
+  }
+  const uint64_t capture_latency_ns =
+      last_completed_ns >= first_triggered_ns ? last_completed_ns - first_triggered_ns : 0;
+  const uint64_t sync_skew_ns =
+      cohort->has_acquisition_skew_ns ? cohort->acquisition_skew_ns : last_started_ns - first_started_ns;
+  capture_latency_stats_.record_rig(rig_id, CoreCaptureLatencyStats::Metric::Capture, capture_latency_ns);
+  capture_latency_stats_.record_rig(rig_id, CoreCaptureLatencyStats::Metric::SyncSkew, sync_skew_ns);
+  (void)rigs_.note_capture_completed(rig_id, capture_id, capture_latency_ns, sync_skew_ns);
+}
+
+const CoreRuntime::ResolvedCameraStaticFacts& CoreRuntime::resolve_camera_static_facts_(
+    uint64_t device_instance_id) {
   assert(core_thread_.is_core_thread());
   const CoreDeviceRegistry::DeviceRecord* device = devices_.find(device_instance_id);
+  const CoreStringId hardware_key = device ? device->hardware_key : 0;
+  const uint64_t provider_revision = provider_camera_fact_state_.static_revision(device_instance_id);
+  const ExternalCameraDescriptionState* external_state =
+      active_external_camera_description_core_ ? &active_external_camera_description_core_->state : nullptr;
+  const uint64_t external_revision = external_state ? external_state->revision() : 0;
+  ResolvedCameraStaticFacts& cached = resolved_camera_static_facts_[device_instance_id];
+  if (cached.facts && cached.hardware_key == hardware_key &&
+      cached.provider_revision == provider_revision &&
+      cached.external_revision == external_revision) {
+    return cached;
+  }
+
   const ExternalCameraDescriptionEntry* external =
-      device ? active_external_camera_description_.find_exact(device->hardware_id) : nullptr;
+      device && external_state ? external_state->find_exact(device->hardware_id) : nullptr;
   const ProviderCameraFacts* provider_static =
       provider_camera_fact_state_.find_static(device_instance_id);
+  const CameraStaticFacts* external_facts = external ? &external->facts : nullptr;
+  const CameraStaticFacts* static_facts =
+      provider_static ? &provider_static->static_facts : nullptr;
+  auto merged = std::make_shared<CameraStaticFacts>();
+  const auto merge = [&](auto CameraStaticFacts::*field) {
+    merged.get()->*field = external_facts && external_facts->*field
+        ? external_facts->*field
+        : static_facts ? static_facts->*field : std::nullopt;
+  };
+  merge(&CameraStaticFacts::facing);
+  merge(&CameraStaticFacts::nature);
+  merge(&CameraStaticFacts::sensor_orientation);
+  merge(&CameraStaticFacts::intrinsics);
+  merge(&CameraStaticFacts::distortion);
+  merge(&CameraStaticFacts::pose);
+  merge(&CameraStaticFacts::focus_state);
+  merge(&CameraStaticFacts::exposure_time);
+  merge(&CameraStaticFacts::sensor_sensitivity_iso);
+  merge(&CameraStaticFacts::aperture_f_number);
+  merge(&CameraStaticFacts::focal_length_mm);
+  merge(&CameraStaticFacts::raw_sensor_layout);
+
+  cached.hardware_key = hardware_key;
+  cached.provider_revision = provider_revision;
+  cached.external_revision = external_revision;
+  cached.facts = std::move(merged);
+  cached.external = external_facts ? std::make_shared<const CameraStaticFacts>(*external_facts) : nullptr;
+  return cached;
+}
+
+CoreResolvedCaptureImageFacts CoreRuntime::resolve_capture_image_facts_(
+    uint64_t capture_id,
+    uint64_t device_instance_id,
+    uint32_t image_member_index) {
+  assert(core_thread_.is_core_thread());
+  const ResolvedCameraStaticFacts& camera = resolve_camera_static_facts_(device_instance_id);
   const ProviderCameraFactState::CaptureImageKey image_key{
       capture_id, device_instance_id, image_member_index};
   const ProviderCaptureImageFacts* provider_image =
       provider_camera_fact_state_.find_capture_image(image_key);
 
   CoreResolvedCaptureImageFacts resolved{};
-  const CameraStaticFacts* external_facts = external ? &external->facts : nullptr;
-  const CameraStaticFacts* static_facts =
-      provider_static ? &provider_static->static_facts : nullptr;
-  resolved.camera.facing = external_facts && external_facts->facing
-      ? external_facts->facing
-      : static_facts ? static_facts->facing : std::nullopt;
-  resolved.camera.nature = external_facts && external_facts->nature
-      ? external_facts->nature
-      : static_facts ? static_facts->nature : std::nullopt;
-  resolved.camera.sensor_orientation = external_facts && external_facts->sensor_orientation
-      ? external_facts->sensor_orientation
-      : static_facts ? static_facts->sensor_orientation : std::nullopt;
-  resolved.camera.intrinsics = external_facts && external_facts->intrinsics
-      ? external_facts->intrinsics
-      : provider_image && provider_image->intrinsics ? provider_image->intrinsics
-      : static_facts ? static_facts->intrinsics : std::nullopt;
-  resolved.camera.distortion = external_facts && external_facts->distortion
-      ? external_facts->distortion
-      : provider_image && provider_image->distortion ? provider_image->distortion
-      : static_facts ? static_facts->distortion : std::nullopt;
-  resolved.camera.pose = external_facts && external_facts->pose
-      ? external_facts->pose
-      : provider_image && provider_image->pose ? provider_image->pose
-      : static_facts ? static_facts->pose : std::nullopt;
+  resolved.camera = camera.facts;
+  const CameraStaticFacts* external_facts = camera.external.get();
+  const CameraStaticFacts& static_facts = *camera.facts;
+  if (provider_image) {
+    // Provider per-image intrinsics/distortion/pose outrank provider-static
+    // facts but not external ones; only then does this member need its own
+    // copy of the camera facts.
+    const bool image_intrinsics =
+        provider_image->intrinsics && !(external_facts && external_facts->intrinsics);
+    const bool image_distortion =
+        provider_image->distortion && !(external_facts && external_facts->distortion);
+    const bool image_pose = provider_image->pose && !(external_facts && external_facts->pose);
+    if (image_intrinsics || image_distortion || image_pose) {
+      auto own = std::make_shared<CameraStaticFacts>(static_facts);
+      if (image_intrinsics) own->intrinsics = provider_image->intrinsics;
+      if (image_distortion) own->distortion = provider_image->distortion;
+      if (image_pose) own->pose = provider_image->pose;
+      resolved.camera = std::move(own);
+    }
+  }
   // These five are device-constant on some hardware and per-capture on other
   // hardware, so they resolve through the same three-tier chain as intrinsics/
-  // distortion/pose rather than being provider-per-image only.
-  resolved.image.focus_state = external_facts && external_facts->focus_state
-      ? external_facts->focus_state
-      : provider_image && provider_image->focus_state ? provider_image->focus_state
-      : static_facts ? static_facts->focus_state : std::nullopt;
-  resolved.image.exposure_time = external_facts && external_facts->exposure_time
-      ? external_facts->exposure_time
-      : provider_image && provider_image->exposure_time ? provider_image->exposure_time
-      : static_facts ? static_facts->exposure_time : std::nullopt;
-  resolved.image.sensor_sensitivity_iso =
-      external_facts && external_facts->sensor_sensitivity_iso
-      ? external_facts->sensor_sensitivity_iso
-      : provider_image && provider_image->sensor_sensitivity_iso
-          ? provider_image->sensor_sensitivity_iso
-      : static_facts ? static_facts->sensor_sensitivity_iso : std::nullopt;
-  resolved.image.aperture_f_number = external_facts && external_facts->aperture_f_number
-      ? external_facts->aperture_f_number
-      : provider_image && provider_image->aperture_f_number
-          ? provider_image->aperture_f_number
-      : static_facts ? static_facts->aperture_f_number : std::nullopt;
-  resolved.image.focal_length_mm = external_facts && external_facts->focal_length_mm
-      ? external_facts->focal_length_mm
-      : provider_image && provider_image->focal_length_mm ? provider_image->focal_length_mm
-      : static_facts ? static_facts->focal_length_mm : std::nullopt;
+  // distortion/pose rather than being provider-per-image only. The cached
+  // static merge already holds the external-or-provider-static value.
+  const auto resolve_image = [&](auto CaptureImageFacts::*image_field,
+                                 auto ProviderCaptureImageFacts::*provider_field,
+                                 auto CameraStaticFacts::*static_field) {
+    resolved.image.*image_field = !(external_facts && external_facts->*static_field) &&
+            provider_image && provider_image->*provider_field
+        ? provider_image->*provider_field
+        : static_facts.*static_field;
+  };
+  resolve_image(&CaptureImageFacts::focus_state,
+                &ProviderCaptureImageFacts::focus_state,
+                &CameraStaticFacts::focus_state);
+  resolve_image(&CaptureImageFacts::exposure_time,
+                &ProviderCaptureImageFacts::exposure_time,
+                &CameraStaticFacts::exposure_time);
+  resolve_image(&CaptureImageFacts::sensor_sensitivity_iso,
+                &ProviderCaptureImageFacts::sensor_sensitivity_iso,
+                &CameraStaticFacts::sensor_sensitivity_iso);
+  resolve_image(&CaptureImageFacts::aperture_f_number,
+                &ProviderCaptureImageFacts::aperture_f_number,
+                &CameraStaticFacts::aperture_f_number);
+  resolve_image(&CaptureImageFacts::focal_length_mm,
+                &ProviderCaptureImageFacts::focal_length_mm,
+                &CameraStaticFacts::focal_length_mm);
   // realized_image_transform stays provider-per-image only: it describes what
   // this provider did to the delivered pixels, which no external source can
   // assert on the provider's behalf.
@@ -3924,7 +4281,7 @@ void CoreRuntime::finalize_completed_capture_facts_(
   assert(core_thread_.is_core_thread());
   const std::optional<CaptureAdmissionContext> context =
       capture_assembly_registry_.admission_context_for(capture_id, device_instance_id);
-  (void)result_store_.finalize_capture_facts(
+  const bool finalized = result_store_.finalize_capture_facts(
       capture_id,
       device_instance_id,
       context,
@@ -3932,6 +4289,12 @@ void CoreRuntime::finalize_completed_capture_facts_(
         return resolve_capture_image_facts_(
             capture_id, device_instance_id, image_member_index);
       });
+  if (finalized) {
+    SharedCaptureResultData finalized_result = result_store_.get_capture_result(capture_id, device_instance_id);
+    (void)capture_thumbnail_pool_.submit(finalized_result);
+    (void)capture_fusion_pool_.submit(finalized_result);
+    (void)encoded_image_pool_.submit(std::move(finalized_result));
+  }
 }
 
 void CoreRuntime::begin_capture_stream_preemption_(uint64_t capture_id, uint64_t device_instance_id) {
@@ -3939,6 +4302,12 @@ void CoreRuntime::begin_capture_stream_preemption_(uint64_t capture_id, uint64_t
   if (capture_id == 0 || device_instance_id == 0) {
     return;
   }
+  // The provider runs this capture as one more output of the live session, so
+  // the preview has nothing to yield to and keeps flowing.
+  if (ICameraProvider* prov = provider_.load(std::memory_order_acquire);
+      prov && prov->supports_capture_alongside_streams(device_instance_id)) {
+    return;
+  }
 
   auto& by_capture = capture_stream_preemptions_by_device_[device_instance_id];
   by_capture[capture_id] = CaptureStreamPreemptionRecord{capture_id, device_instance_id};
@@ -3997,14 +4366,13 @@ bool CoreRuntime::suppress_repeating_stream_frame_for_capture_(ProviderToCoreCom
     return false;
   }
 
-  auto& frame = std::get<CmdProviderFrame>(cmd.payload).frame;
+  auto& payload = std::get<CmdProviderFrame>(cmd.payload);
+  auto& frame = payload.frame;
   const uint64_t integrated_ts_ns = frame_integration_now_ns();
-  const bool received_counted = streams_.on_frame_received(frame.stream_id, integrated_ts_ns);
+  const bool received_counted = streams_.on_frame_received(frame.stream_id, integrated_ts_ns, frame);
   const bool dropped_counted = streams_.on_frame_dropped(frame.stream_id);
   frame.release_now();
-  global_resource_aggregate_telemetry().lease_released(make_framebuffer_lease_scoped_resource_telemetry_key(
-      frame.stream_id,
-      frame.acquisition_session_id));
+  framebuffer_lease_released(payload.lease_telemetry, frame.stream_id, frame.acquisition_session_id);
   frame.release = nullptr;
   frame.release_user = nullptr;
 
@@ -4048,6 +4416,9 @@ std::vector<SharedCaptureResultData> CoreRuntime::get_capture_result_set(uint64_
         continue;
       }
       SharedCaptureResultData result = result_store_.get_capture_result(capture_id, device_instance_id);
+      if (!result) {
+        result = capture_spill_store_.load(capture_id, device_instance_id);
+      }
       if (!result) {
         continue;
       }
@@ -4057,6 +4428,9 @@ std::vector<SharedCaptureResultData> CoreRuntime::get_capture_result_set(uint64_
   }
 
   std::vector<SharedCaptureResultData> candidates = result_store_.get_capture_result_set(capture_id);
+  for (SharedCaptureResultData& spilled : capture_spill_store_.load_capture_set(capture_id)) {
+    candidates.push_back(std::move(spilled));
+  }
   std::vector<SharedCaptureResultData> assembly_successful;
   assembly_successful.reserve(candidates.size());
   for (auto& candidate : candidates) {
@@ -4099,8 +4473,22 @@ bool CoreRuntime::start() noexcept try {
   }
 
   publish_pending_.store(false, std::memory_order_relaxed);
+  publish_requested_ns_ = 0;
   publish_requests_coalesced_.store(0, std::memory_order_relaxed);
+  picture_updates_coalesced_.store(0, std::memory_order_relaxed);
+  snapshot_publishes_paced_.store(0, std::memory_order_relaxed);
+  publish_pacer_.reset();
+  publish_paced_ = false;
+  snapshot_publish_interval_ns_.store(publish_pacer_.interval_ns(), std::memory_order_relaxed);
   publish_requests_dropped_full_.store(0, std::memory_order_relaxed);
+  memory_trims_.store(0, std::memory_order_relaxed);
+  memory_trim_bytes_released_.store(0, std::memory_order_relaxed);
+  stream_pool_depth_hints_sent_.store(0, std::memory_order_relaxed);
+  stream_qos_.reset();
+  stream_qos_sampling_ = false;
+  stream_qos_level_.store(0, std::memory_order_relaxed);
+  stream_qos_level_changes_.store(0, std::memory_order_relaxed);
+  stream_qos_reconfigurations_.store(0, std::memory_order_relaxed);
   publish_requests_dropped_closed_.store(0, std::memory_order_relaxed);
   publish_requests_dropped_allocfail_.store(0, std::memory_order_relaxed);
   display_demand_release_async_dropped_full_.store(0, std::memory_order_relaxed);
@@ -4120,6 +4508,9 @@ bool CoreRuntime::start() noexcept try {
 
   // Reset core-thread-only pump state.
   rigs_.clear();
+  rig_stream_frame_sets_.clear();
+  warm_pool_.start_generation();
+  capture_latency_stats_.clear();
   capture_assembly_registry_.clear();
   capture_cohort_registry_.clear();
   capture_stream_preemptions_by_device_.clear();
@@ -4155,23 +4546,74 @@ std::vector<SharedCaptureResultData> CoreRuntime::curate_capture_result_set_acce
   return candidates;
 }
 
-void CoreRuntime::stop() {
-  // Serialize the whole call: a second concurrent caller blocks here until
-  // the first caller's teardown (including core_thread_.join() below) has
-  // fully completed. It then observes state_ == STOPPED via its own
-  // exchange() below and returns via the idempotent early-return path,
-  // instead of racing the first caller into its own join() on the same
-  // std::thread. See stop_mutex_'s doc comment.
-  std::lock_guard<std::mutex> lifecycle_lock(lifecycle_mutex_);
+bool CoreRuntime::set_snapshot_publish_rate_limit(uint32_t max_counter_publishes_per_s) noexcept {
+  if (core_thread_.is_running()) {
+    return false;
+  }
+  publish_pacer_.configure(max_counter_publishes_per_s);
+  return true;
+}
 
-  // Idempotent stop.
-  const CoreRuntimeState st0 = state_.exchange(CoreRuntimeState::TEARING_DOWN, std::memory_order_acq_rel);
-  if (st0 == CoreRuntimeState::STOPPED || st0 == CoreRuntimeState::CREATED) {
-    state_.store(st0, std::memory_order_release);
+bool CoreRuntime::set_snapshot_publish_offload(bool enabled) noexcept {
+  if (core_thread_.is_running()) {
+    return false;
+  }
+  snapshot_publish_offload_.store(enabled, std::memory_order_release);
+  return true;
+}
+
+bool CoreRuntime::set_frame_shard_count(size_t shard_count) noexcept {
+  if (core_thread_.is_running() || shard_count > CoreFrameShards::kMaxShards) {
+    return false;
+  }
+  frame_shard_count_ = shard_count;
+  return true;
+}
+
+void CoreRuntime::set_stream_qos_enabled(bool enabled) noexcept {
+  if (stream_qos_enabled_.exchange(enabled, std::memory_order_acq_rel) == enabled) {
     return;
   }
+  if (core_thread_.is_running()) {
+    core_thread_.request_timer_tick();
+  }
+}
 
-  // Deterministic shutdown request:
+bool CoreRuntime::set_retained_plan_prior_path(std::filesystem::path path) {
+  if (core_thread_.is_running()) {
+    return false;
+  }
+  retained_plan_priors_.set_path(std::move(path));
+  return true;
+}
+
+bool CoreRuntime::set_capture_spill_medium(CoreCaptureSpillStore::Medium medium,
+                                           uint64_t byte_budget,
+                                           std::filesystem::path directory) {
+  if (core_thread_.is_running()) {
+    return false;
+  }
+  capture_spill_store_.set_medium(medium, byte_budget, std::move(directory));
+  return true;
+}
+
+void CoreRuntime::stop() {
+  // Serialize the whole call: a second concurrent caller blocks here until
+  // the first caller's teardown (including core_thread_.join() below) has
+  // fully completed. It then observes state_ == STOPPED via its own
+  // exchange() below and returns via the idempotent early-return path,
+  // instead of racing the first caller into its own join() on the same
+  // std::thread. See stop_mutex_'s doc comment.
+  std::lock_guard<std::mutex> lifecycle_lock(lifecycle_mutex_);
+
+  // Idempotent stop.
+  const CoreRuntimeState st0 = state_.exchange(CoreRuntimeState::TEARING_DOWN, std::memory_order_acq_rel);
+  if (st0 == CoreRuntimeState::STOPPED || st0 == CoreRuntimeState::CREATED) {
+    state_.store(st0, std::memory_order_release);
+    return;
+  }
+
+  // Deterministic shutdown request:
   // - Stop accepting new external requests immediately (state == TEARING_DOWN).
   // - Keep provider fact ingestion best-effort until the core thread closes.
   // - Core thread executes a deterministic shutdown pump and requests stop only at the end.
@@ -4188,12 +4630,12 @@ void CoreRuntime::stop() {
       // owns, and the attached provider for the remainder of the process.
       // The owner (CamBANGServer) must likewise skip provider destruction
       // after observing core_thread_failed().
-      std::fprintf(stderr,
-                   "[CamBANG][CoreRuntime] stop() on a FAILED runtime: "
-                   "abandoning the wedged core thread (deliberate leak of the "
-                   "thread, core state, and attached provider). In-process "
-                   "restart is unsupported after this condition.\n");
-      std::fflush(stderr);
+      async_log_printf(stderr,
+                       "[CamBANG][CoreRuntime] stop() on a FAILED runtime: "
+                       "abandoning the wedged core thread (deliberate leak of the "
+                       "thread, core state, and attached provider). In-process "
+                       "restart is unsupported after this condition.\n");
+      async_log_flush();
       core_thread_.abandon_wedged_thread();
     } else {
       shutdown_requested_from_stop_.store(true, std::memory_order_release);
@@ -4201,6 +4643,11 @@ void CoreRuntime::stop() {
       core_thread_.join();
     }
   }
+  capture_thumbnail_pool_.stop();
+  capture_fusion_pool_.stop();
+  encoded_image_pool_.stop();
+  stream_recorder_.stop();
+  stream_exporter_.stop_all();
 
   state_.store(CoreRuntimeState::STOPPED, std::memory_order_release);
 }
@@ -4258,16 +4705,15 @@ void CoreRuntime::check_core_thread_liveness() {
   core_thread_stale_detections_.fetch_add(1, std::memory_order_relaxed);
 
   const double stuck_s = static_cast<double>(now_ns - started_ns) / 1e9;
-  std::fprintf(stderr,
-               "[CamBANG][CoreThread] stale task detected: the core thread has "
-               "been inside a single posted task or the timer-tick hook for "
-               "%.1fs (>= %.1fs threshold). This means a provider call did not "
-               "honor the documented prompt/bounded contract (see "
-               "provider_architecture.md Section 8.1 and "
-               "docs/provider_implementation_brief.md).\n",
-               stuck_s,
-               static_cast<double>(kCoreThreadStaleTaskThresholdNs) / 1e9);
-  std::fflush(stderr);
+  async_log_printf(stderr,
+                   "[CamBANG][CoreThread] stale task detected: the core thread has "
+                   "been inside a single posted task or the timer-tick hook for "
+                   "%.1fs (>= %.1fs threshold). This means a provider call did not "
+                   "honor the documented prompt/bounded contract (see "
+                   "provider_architecture.md Section 8.1 and "
+                   "docs/provider_implementation_brief.md).\n",
+                   stuck_s,
+                   static_cast<double>(kCoreThreadStaleTaskThresholdNs) / 1e9);
 
 #if defined(CAMBANG_INTERNAL_SMOKE)
   // Maintainer/compliance-verify builds only -- never defined for a
@@ -4277,6 +4723,7 @@ void CoreRuntime::check_core_thread_liveness() {
   // The failed-latch death test suppresses this abort via the smoke hook so
   // the production latch path below is exercisable in a maintainer build.
   if (!smoke_suppress_liveness_abort_.load(std::memory_order_acquire)) {
+    async_log_flush();
     std::abort();
   }
 #endif
@@ -4288,17 +4735,16 @@ void CoreRuntime::check_core_thread_liveness() {
   // promptness").
   if (now_ns - started_ns >= kCoreThreadFailedThresholdNs &&
       !core_thread_failed_.exchange(true, std::memory_order_acq_rel)) {
-    std::fprintf(stderr,
-                 "[CamBANG][CoreThread] runtime declared FAILED: the wedged "
-                 "provider call has exceeded the %.0fs hard threshold. Blocked "
-                 "synchronous callers now return their fallback status, new "
-                 "commands are refused, and stop() will abandon (detach and "
-                 "deliberately leak) the wedged core thread and provider. "
-                 "In-process restart after this condition is unsupported; the "
-                 "hosting application should surface an error and exit or "
-                 "relaunch.\n",
-                 static_cast<double>(kCoreThreadFailedThresholdNs) / 1e9);
-    std::fflush(stderr);
+    async_log_printf(stderr,
+                     "[CamBANG][CoreThread] runtime declared FAILED: the wedged "
+                     "provider call has exceeded the %.0fs hard threshold. Blocked "
+                     "synchronous callers now return their fallback status, new "
+                     "commands are refused, and stop() will abandon (detach and "
+                     "deliberately leak) the wedged core thread and provider. "
+                     "In-process restart after this condition is unsupported; the "
+                     "hosting application should surface an error and exit or "
+                     "relaunch.\n",
+                     static_cast<double>(kCoreThreadFailedThresholdNs) / 1e9);
   }
 }
 
@@ -4311,56 +4757,68 @@ void CoreRuntime::on_core_start() {
       std::memory_order_release);
   // Do not carry retained result artifacts across generation boundaries.
   result_store_.clear();
+  capture_spill_store_.clear();
   global_resource_aggregate_telemetry().clear();
   acquisition_sessions_.clear();
   provider_camera_fact_state_.clear();
+  resolved_camera_static_facts_.clear();
   {
     const std::lock_guard<std::mutex> lock(configured_capture_geolocation_mutex_);
     active_capture_geolocation_ = configured_capture_geolocation_;
   }
-  uint64_t configured_camera_description_version = 0;
   uint64_t configured_imaging_spec_version = 0;
   std::vector<uint8_t> configured_imaging_spec_payload{};
-  std::optional<ExternalCameraDescriptionState> configured_external_camera_description{};
+  camera_concurrency::Truth configured_imaging_spec_concurrency{};
+  SharedExternalCameraDescription configured_external_camera_description{};
   {
     const std::lock_guard<std::mutex> lock(configured_imaging_spec_mutex_);
-    configured_camera_description_version = configured_camera_description_version_;
     configured_imaging_spec_version = configured_imaging_spec_version_;
     configured_imaging_spec_payload = configured_imaging_spec_payload_;
+    configured_imaging_spec_concurrency = configured_imaging_spec_concurrency_;
     configured_external_camera_description = configured_external_camera_description_;
   }
   spec_state_.reset_for_generation(configured_imaging_spec_version);
-  active_external_camera_description_ = configured_external_camera_description.value_or(
-      ExternalCameraDescriptionState{});
-  active_camera_description_version_ = configured_external_camera_description.has_value()
-      ? configured_camera_description_version
-      : 0;
-  if (configured_external_camera_description.has_value()) {
+  // The configured set is immutable, so the generation shares it rather
+  // than copying every entry.
+  active_external_camera_description_core_ = configured_external_camera_description;
+  active_external_camera_description_.publish(configured_external_camera_description);
+  if (configured_external_camera_description) {
     spec_state_.set_imaging_spec_concurrency(
         configured_imaging_spec_version,
-        configured_external_camera_description->concurrency().value_or(camera_concurrency::Truth{}));
+        configured_external_camera_description->state.concurrency().value_or(camera_concurrency::Truth{}));
   } else if (!configured_imaging_spec_payload.empty()) {
-    const SpecPatchView configured_payload{
-        configured_imaging_spec_payload.data(),
-        configured_imaging_spec_payload.size()};
-    const bool retained = spec_state_.retain_imaging_spec_replace(
+    // Parsed at ingest; not parsed again per generation.
+    spec_state_.retain_imaging_spec_replace(
         configured_imaging_spec_version,
-        configured_payload);
-    assert(retained);
-    (void)retained;
+        std::move(configured_imaging_spec_payload),
+        std::move(configured_imaging_spec_concurrency));
   }
   stream_retained_plan_evaluators_.clear();
   capture_retained_plan_evaluators_.clear();
   stream_retained_plan_decisions_.clear();
   capture_retained_plan_decisions_.clear();
+  stream_pool_depth_hints_.clear();
   capture_priming_seeds_.clear();
   capture_parent_priming_states_.clear();
   pending_capture_observations_.clear();
+  retained_plan_priors_.load();
+  if (frame_shard_count_ != 0 &&
+      !frame_shards_.start(frame_shard_count_, &result_store_, [this] { core_thread_.request_timer_tick(); })) {
+    // Retention stays inline on the core thread (frame_shards_ not running).
+    async_log_printf(stderr, "[CamBANG][Core] frame shards could not start; retaining frames inline\n");
+  }
+  if (snapshot_publish_offload_.load(std::memory_order_acquire) &&
+      !snapshot_publish_worker_.start(
+          [this] { published_seq_.fetch_add(1, std::memory_order_acq_rel); },
+          [this] { core_thread_.request_timer_tick(); })) {
+    async_log_printf(stderr, "[CamBANG][Core] snapshot publish worker could not start; publishing inline\n");
+  }
   state_.store(CoreRuntimeState::LIVE, std::memory_order_release);
 
   // Start "dirty": publish an initial baseline snapshot (version=0, topology_version=0)
   // via the normal coalesced publish path.
   publish_pending_.store(true, std::memory_order_release);
+  publish_requested_ns_ = CoreThread::steady_now_ns();
   core_thread_.request_timer_tick();
 }
 
@@ -4376,6 +4834,8 @@ void CoreRuntime::on_core_timer_tick() {
 
   const auto now = std::chrono::steady_clock::now();
   const uint64_t now_ns = ns_since_epoch_(now);
+  const uint64_t shortest_started_frame_period_ns = streams_.shortest_started_frame_period_ns();
+  core_thread_.set_performance_hint_target_ns(shortest_started_frame_period_ns);
 
   // Banner 2: Core-loop provider attachment (effective runtime attachment).
   // Printed once per CoreRuntime session, the first time Core observes a non-null provider.
@@ -4389,22 +4849,20 @@ void CoreRuntime::on_core_timer_tick() {
       } else {
         const ProviderBannerInfo bi = describe_provider_for_banner(prov);
         const int n = std::snprintf(core_banner_line_, sizeof(core_banner_line_),
-                                    "[CamBANG][Core] provider attached: %s / %s",
-                                    bi.provider_mode, bi.provider_name);
+                                    "[CamBANG][Core] provider attached: %s / %s (pixel kernels: %s)",
+                                    bi.provider_mode, bi.provider_name, pixel_kernel_isa());
         (void)n;
-        std::fprintf(stdout, "%s\n", core_banner_line_);
-        std::fflush(stdout);
+        async_log_printf(stdout, "%s\n", core_banner_line_);
         core_banner_line_pending_.store(true, std::memory_order_release);
         provider_banner_printed_ = true;
       }
 #else
       const ProviderBannerInfo bi = describe_provider_for_banner(prov);
       const int n = std::snprintf(core_banner_line_, sizeof(core_banner_line_),
-                                  "[CamBANG][Core] provider attached: %s / %s",
-                                  bi.provider_mode, bi.provider_name);
+                                  "[CamBANG][Core] provider attached: %s / %s (pixel kernels: %s)",
+                                  bi.provider_mode, bi.provider_name, pixel_kernel_isa());
       (void)n;
-      std::fprintf(stdout, "%s\n", core_banner_line_);
-      std::fflush(stdout);
+      async_log_printf(stdout, "%s\n", core_banner_line_);
       core_banner_line_pending_.store(true, std::memory_order_release);
 #endif
       provider_banner_printed_ = true;
@@ -4412,6 +4870,10 @@ void CoreRuntime::on_core_timer_tick() {
   }
 
 
+  // Frames retained on a device shard since the last tick finish their
+  // dispatch here, ahead of newer provider facts.
+  integrate_frame_shard_completions_();
+
   // 1) Drain provider facts ("what happened") first, but only for a
   // deterministic fairness slice. Conservative/non-lossy provider facts remain
   // FIFO and non-dropping; when backlog remains, the next requested tick
@@ -4421,7 +4883,8 @@ void CoreRuntime::on_core_timer_tick() {
   // of lower-priority repeating stream frames, and repeating stream frames yield
   // to already-pending command/request work. Stage C coalesces stale repeating
   // stream frames only when a newer frame for the same stream/session is queued
-  // before any non-lossy barrier.
+  // before any non-lossy barrier; all of that stream's stale frames in the run
+  // are released together, and only the newest reaches the dispatcher.
   const bool requests_pending_before_provider_drain = !requests_.empty();
   bool command_or_request_waiting_for_stream_frame = false;
   {
@@ -4434,6 +4897,10 @@ void CoreRuntime::on_core_timer_tick() {
       if (provider_capture_facts_queued_ != 0) {
         (void)promote_capture_fact_over_repeating_stream_prefix(provider_facts_, capture_cohort_registry_);
       }
+      if (streams_.has_mixed_stream_priorities()) {
+        (void)promote_priority_stream_frame_over_repeating_prefix(
+            provider_facts_, capture_cohort_registry_, streams_);
+      }
       const ProviderFactSummary summary =
           summarize_provider_fact(provider_facts_.front(), capture_cohort_registry_);
       const bool command_or_request_pending = requests_pending_before_provider_drain ||
@@ -4448,7 +4915,7 @@ void CoreRuntime::on_core_timer_tick() {
       }
       if (summary.fact_class == ProviderFactClass::RepeatingStreamFrame) {
         const StreamFrameCoalesceResult coalesce_result =
-            coalesce_front_repeating_stream_frame_if_superseded(
+            coalesce_superseded_repeating_stream_frames(
                 provider_facts_, summary, capture_cohort_registry_, streams_);
         if (coalesce_result.coalesced) {
           request_publish_from_core_unchecked();
@@ -4494,7 +4961,8 @@ void CoreRuntime::on_core_timer_tick() {
                      ProviderToCoreCommandType::PROVIDER_CAPTURE_FAILED) {
         capture_parent_device_instance_id = summary.device_instance_id;
       }
-      dispatcher_.dispatch(std::move(cmd));
+      dispatch_provider_fact_timed_(
+          std::move(cmd), summary.fact_class == ProviderFactClass::RepeatingStreamFrame);
       if (capture_parent_device_instance_id != 0 &&
           rehome_capture_retained_plan_parent_state_(
               capture_parent_device_instance_id,
@@ -4546,6 +5014,11 @@ void CoreRuntime::on_core_timer_tick() {
       now_ns,
       has_next_pending_capture_observation_delay,
       next_pending_capture_observation_delay_ns);
+  timer_deadlines_.set(CoreDeadlineTable::Kind::PENDING_CAPTURE_OBSERVATION,
+                       now_ns,
+                       has_next_pending_capture_observation_delay
+                           ? std::optional<uint64_t>(next_pending_capture_observation_delay_ns)
+                           : std::nullopt);
 
   if (provider_facts_remain_after_fairness_slice) {
     core_thread_.request_timer_tick();
@@ -4556,6 +5029,8 @@ void CoreRuntime::on_core_timer_tick() {
   {
     uint64_t next_warm_delay_ns = 0;
     bool has_next_warm_delay = false;
+    std::vector<CoreWarmPool::IdleDevice>& idle = warm_pool_idle_scratch_;
+    idle.clear();
     for (const auto& [device_id, rec] : devices_.all()) {
       (void)device_id;
       if (!rec.open) {
@@ -4565,6 +5040,7 @@ void CoreRuntime::on_core_timer_tick() {
       const bool active_use = streams_.has_flowing_stream_for_device(rec.device_instance_id);
 
       if (active_use) {
+        warm_pool_.note_in_use(rec.device_instance_id, rec.hardware_id, now_ns);
         (void)devices_.set_warm_was_in_use(rec.device_instance_id, true);
         if (rec.warm_deadline_active || rec.warm_expired_close_requested) {
           (void)devices_.clear_warm_deadline(rec.device_instance_id);
@@ -4586,35 +5062,64 @@ void CoreRuntime::on_core_timer_tick() {
         continue;
       }
 
-      if (!rec.warm_deadline_active) {
-        const uint64_t hold_ns = warm_delay_ns(rec.warm_hold_ms);
-        const uint64_t deadline_ns = (hold_ns > (std::numeric_limits<uint64_t>::max() - now_ns))
-            ? std::numeric_limits<uint64_t>::max()
-            : (now_ns + hold_ns);
-        if (devices_.arm_warm_deadline(rec.device_instance_id, deadline_ns)) {
+      CoreWarmPool::IdleDevice d{};
+      d.device_instance_id = rec.device_instance_id;
+      d.hardware_id = &rec.hardware_id;
+      d.warm_hold_ms = rec.warm_hold_ms;
+      idle.push_back(d);
+    }
+
+    // The pool extends configured holds for devices it predicts are reused
+    // soon (within its budget) and for pre-warmed devices.
+    warm_pool_.plan(now_ns, idle);
+
+    for (const CoreWarmPool::IdleDevice& d : idle) {
+      const CoreDeviceRegistry::DeviceRecord* rec = devices_.find(d.device_instance_id);
+      if (!rec) {
+        continue;
+      }
+
+      // Once the close is requested the deadline stays put until the
+      // provider reports the device closed.
+      if (!rec->warm_expired_close_requested &&
+          (!rec->warm_deadline_active || rec->warm_deadline_ns != d.deadline_ns)) {
+        if (devices_.arm_warm_deadline(d.device_instance_id, d.deadline_ns)) {
           request_publish_from_core_unchecked();
         }
-        continue;
       }
 
-      if (rec.warm_deadline_active && now_ns >= rec.warm_deadline_ns) {
-        if (!rec.warm_expired_close_requested && prov) {
-          (void)devices_.mark_warm_expired_close_requested(rec.device_instance_id, true);
-          (void)prov->close_device(rec.device_instance_id);
+      if (now_ns >= rec->warm_deadline_ns) {
+        if (!rec->warm_expired_close_requested && prov) {
+          (void)devices_.mark_warm_expired_close_requested(d.device_instance_id, true);
+          drain_frame_shards_();
+          (void)prov->close_device(d.device_instance_id);
           request_publish_from_core_unchecked();
         }
         continue;
       }
 
-      const uint64_t remaining_ns = rec.warm_deadline_ns - now_ns;
+      const uint64_t remaining_ns = rec->warm_deadline_ns - now_ns;
       if (!has_next_warm_delay || remaining_ns < next_warm_delay_ns) {
         has_next_warm_delay = true;
         next_warm_delay_ns = remaining_ns;
       }
     }
 
-    const size_t retired_count =
-        native_objects_.retire_destroyed_older_than(now_ns, kDestroyedNativeObjectRetentionWindowNs);
+    timer_deadlines_.set(CoreDeadlineTable::Kind::WARM_HOLD,
+                         now_ns,
+                         has_next_warm_delay ? std::optional<uint64_t>(next_warm_delay_ns) : std::nullopt);
+
+    // Registry-backed sweeps below consult timer_deadlines_ and are skipped
+    // entirely (sweep and next-deadline scan) while their registry is
+    // unchanged and its recorded deadline has not passed.
+    using DeadlineKind = CoreDeadlineTable::Kind;
+    size_t retired_count = 0;
+    const bool sweep_native_objects =
+        timer_deadlines_.due(DeadlineKind::NATIVE_OBJECT_RETENTION, now_ns, native_objects_.revision());
+    if (sweep_native_objects) {
+      retired_count =
+          native_objects_.retire_destroyed_older_than(now_ns, kDestroyedNativeObjectRetentionWindowNs);
+    }
     const size_t retired_capture_orphan_count =
         retire_expired_capture_retained_plan_orphans_(now_ns);
     global_resource_aggregate_telemetry().reconcile_lifecycle(
@@ -4637,37 +5142,57 @@ void CoreRuntime::on_core_timer_tick() {
     size_t timed_out_capture_count = 0;
     uint64_t capture_admission_watchdog_timeout_ns = 0;
     bool has_capture_admission_watchdog_timeout = false;
+    bool sweep_capture_admission_watchdog = false;
     if (ICameraProvider* prov = provider_.load(std::memory_order_acquire)) {
       capture_admission_watchdog_timeout_ns = prov->capture_admission_watchdog_timeout_ns();
       has_capture_admission_watchdog_timeout = true;
+      if (capture_admission_watchdog_timeout_ns != timer_deadlines_admission_timeout_ns_) {
+        timer_deadlines_admission_timeout_ns_ = capture_admission_watchdog_timeout_ns;
+        timer_deadlines_.invalidate(DeadlineKind::CAPTURE_ADMISSION_WATCHDOG);
+      }
+      sweep_capture_admission_watchdog = timer_deadlines_.due(
+          DeadlineKind::CAPTURE_ADMISSION_WATCHDOG, now_ns, capture_assembly_registry_.revision());
+    }
+    if (sweep_capture_admission_watchdog) {
       const auto timed_out = capture_assembly_registry_.sweep_admission_timeouts(
           now_ns, capture_admission_watchdog_timeout_ns);
       timed_out_capture_count = timed_out.size();
       for (const auto& t : timed_out) {
-        std::fprintf(stderr,
-                     "[CamBANG][CaptureAdmissionWatchdog] capture_id=%llu device_instance_id=%llu "
-                     "timed out after %llu ns with no terminal provider fact; marked FAILED(ERR_TIMEOUT).\n",
-                     static_cast<unsigned long long>(t.capture_id),
-                     static_cast<unsigned long long>(t.device_instance_id),
-                     static_cast<unsigned long long>(capture_admission_watchdog_timeout_ns));
+        async_log_printf(stderr,
+                         "[CamBANG][CaptureAdmissionWatchdog] capture_id=%llu device_instance_id=%llu "
+                         "timed out after %llu ns with no terminal provider fact; marked FAILED(ERR_TIMEOUT).\n",
+                         static_cast<unsigned long long>(t.capture_id),
+                         static_cast<unsigned long long>(t.device_instance_id),
+                         static_cast<unsigned long long>(capture_admission_watchdog_timeout_ns));
       }
     }
 
     // Cohort metadata retention (ledger #52): see
     // CoreCaptureCohortRegistry::retire_expired_cohorts()'s doc comment for
     // why a flat time-since-creation window is sufficient here.
-    const size_t retired_cohort_count =
-        capture_cohort_registry_.retire_expired_cohorts(now_ns, kCaptureCohortRetentionWindowNs);
+    size_t retired_cohort_count = 0;
+    const bool sweep_capture_cohorts = timer_deadlines_.due(
+        DeadlineKind::CAPTURE_COHORT_RETENTION, now_ns, capture_cohort_registry_.revision());
+    if (sweep_capture_cohorts) {
+      retired_cohort_count =
+          capture_cohort_registry_.retire_expired_cohorts(now_ns, kCaptureCohortRetentionWindowNs);
+    }
 
     // Capture assembly/result retention (ledger #52): time-based, not
     // supersession-based -- see CoreCaptureAssemblyRegistry::
     // retire_terminal_older_than()'s doc comment.
-    const auto retired_assemblies = capture_assembly_registry_.retire_terminal_older_than(
-        now_ns, kCaptureResultRetentionWindowNs);
-    for (const auto& retired : retired_assemblies) {
-      result_store_.remove_capture_result(retired.capture_id, retired.device_instance_id);
+    size_t retired_assembly_count = 0;
+    const bool sweep_capture_assemblies = timer_deadlines_.due(
+        DeadlineKind::CAPTURE_ASSEMBLY_RETENTION, now_ns, capture_assembly_registry_.revision());
+    if (sweep_capture_assemblies) {
+      const auto retired_assemblies = capture_assembly_registry_.retire_terminal_older_than(
+          now_ns, kCaptureResultRetentionWindowNs);
+      for (const auto& retired : retired_assemblies) {
+        result_store_.remove_capture_result(retired.capture_id, retired.device_instance_id);
+        capture_spill_store_.remove(retired.capture_id, retired.device_instance_id);
+      }
+      retired_assembly_count = retired_assemblies.size();
     }
-    const size_t retired_assembly_count = retired_assemblies.size();
 
     // Capture-result byte-budget retention (ledger #53): complementary to the
     // flat time-based retention immediately above. Bounds total retained
@@ -4676,29 +5201,21 @@ void CoreRuntime::on_core_timer_tick() {
     // without bound even while individual captures stay within
     // kCaptureResultRetentionWindowNs. Runs on this same decoupled
     // timer-tick sweep, never on the capture/frame-delivery hot path.
-    // Only evicts entries CoreCaptureAssemblyRegistry confirms are terminal,
-    // via a snapshot taken here, BEFORE result_store_'s lock is ever
-    // acquired (see CoreResultStore::evict_over_byte_budget()'s doc
-    // comment): this keeps the two registries' locking strictly sequential,
-    // never nested -- the same pattern every other cross-registry access in
-    // this file already uses -- and still means an in-flight capture's
-    // result data is never pulled out from under the pipeline still
-    // assembling it. The snapshot is only built when actually over budget,
-    // so the common (under-budget) case costs a single cheap counter read.
+    // Only evicts entries CoreCaptureAssemblyRegistry has reported terminal:
+    // the assemblies that turned terminal since the last tick are copied out
+    // of that registry BEFORE result_store_'s lock is ever acquired and added
+    // to the store's evictable list (see CoreResultStore::
+    // evict_over_byte_budget()'s doc comment). This keeps the two registries'
+    // locking strictly sequential, never nested -- the same pattern every
+    // other cross-registry access in this file already uses -- and still
+    // means an in-flight capture's result data is never pulled out from
+    // under the pipeline still assembling it. The eviction walk only runs
+    // when actually over budget, and then costs what it evicts.
     size_t byte_budget_evicted_count = 0;
+    result_store_.mark_capture_results_evictable(
+        capture_assembly_registry_.take_newly_terminal_capture_device_pairs());
     if (result_store_.total_estimated_capture_bytes() > kCaptureResultByteBudgetBytes) {
-      const auto terminal_pairs = capture_assembly_registry_.terminal_capture_device_pairs();
-      const std::set<std::pair<uint64_t, uint64_t>> terminal_set(
-          terminal_pairs.begin(), terminal_pairs.end());
-      const auto byte_budget_evicted = result_store_.evict_over_byte_budget(
-          kCaptureResultByteBudgetBytes,
-          [&terminal_set](uint64_t capture_id, uint64_t device_instance_id) {
-            return terminal_set.count(std::make_pair(capture_id, device_instance_id)) != 0;
-          });
-      for (const auto& evicted : byte_budget_evicted) {
-        capture_assembly_registry_.remove_assembly(evicted.capture_id, evicted.device_instance_id);
-      }
-      byte_budget_evicted_count = byte_budget_evicted.size();
+      byte_budget_evicted_count = evict_capture_results_over_budget_(kCaptureResultByteBudgetBytes);
     }
 
     if (retired_count > 0 || retired_capture_orphan_count > 0 ||
@@ -4708,77 +5225,93 @@ void CoreRuntime::on_core_timer_tick() {
       request_publish_from_core_unchecked();
     }
 
-    uint64_t next_deadline_delay_ns = 0;
-    bool has_next_deadline_delay = false;
-    if (const auto next_retirement_delay_ns =
-            native_objects_.next_retirement_delay_ns(now_ns, kDestroyedNativeObjectRetentionWindowNs);
-        next_retirement_delay_ns.has_value()) {
-      has_next_deadline_delay = true;
-      next_deadline_delay_ns = *next_retirement_delay_ns;
-    }
-    if (const auto next_telemetry_retirement_delay_ns =
-            global_resource_aggregate_telemetry().next_retirement_delay_ns(now_ns, kDestroyedNativeObjectRetentionWindowNs);
-        next_telemetry_retirement_delay_ns.has_value()) {
-      if (!has_next_deadline_delay || *next_telemetry_retirement_delay_ns < next_deadline_delay_ns) {
-        has_next_deadline_delay = true;
-        next_deadline_delay_ns = *next_telemetry_retirement_delay_ns;
-      }
-    }
-    if (has_next_warm_delay && (!has_next_deadline_delay || next_warm_delay_ns < next_deadline_delay_ns)) {
-      has_next_deadline_delay = true;
-      next_deadline_delay_ns = next_warm_delay_ns;
-    }
-    if (has_next_pending_capture_observation_delay &&
-        (!has_next_deadline_delay ||
-         next_pending_capture_observation_delay_ns < next_deadline_delay_ns)) {
-      has_next_deadline_delay = true;
-      next_deadline_delay_ns = next_pending_capture_observation_delay_ns;
-    }
-    next_capture_retained_plan_orphan_retirement_delay_(
-        now_ns, has_next_deadline_delay, next_deadline_delay_ns);
-    if (has_capture_admission_watchdog_timeout) {
-      if (const auto next_admission_timeout_delay_ns =
-              capture_assembly_registry_.next_admission_timeout_delay_ns(
-                  now_ns, capture_admission_watchdog_timeout_ns);
-          next_admission_timeout_delay_ns.has_value()) {
-        if (!has_next_deadline_delay || *next_admission_timeout_delay_ns < next_deadline_delay_ns) {
-          has_next_deadline_delay = true;
-          next_deadline_delay_ns = *next_admission_timeout_delay_ns;
-        }
-      }
-    }
-    if (const auto next_cohort_expiry_delay_ns =
-            capture_cohort_registry_.next_cohort_expiry_delay_ns(
-                now_ns, kCaptureCohortRetentionWindowNs);
-        next_cohort_expiry_delay_ns.has_value()) {
-      if (!has_next_deadline_delay || *next_cohort_expiry_delay_ns < next_deadline_delay_ns) {
-        has_next_deadline_delay = true;
-        next_deadline_delay_ns = *next_cohort_expiry_delay_ns;
-      }
+    // Re-record deadlines (after every mutation above, so the stored
+    // revisions are current) for each subsystem that swept or changed.
+    if (sweep_native_objects ||
+        timer_deadlines_.due(DeadlineKind::NATIVE_OBJECT_RETENTION, now_ns, native_objects_.revision())) {
+      timer_deadlines_.set(
+          DeadlineKind::NATIVE_OBJECT_RETENTION,
+          now_ns,
+          native_objects_.next_retirement_delay_ns(now_ns, kDestroyedNativeObjectRetentionWindowNs),
+          native_objects_.revision());
     }
-    if (const auto next_assembly_retirement_delay_ns =
-            capture_assembly_registry_.next_terminal_retirement_delay_ns(
-                now_ns, kCaptureResultRetentionWindowNs);
-        next_assembly_retirement_delay_ns.has_value()) {
-      if (!has_next_deadline_delay || *next_assembly_retirement_delay_ns < next_deadline_delay_ns) {
-        has_next_deadline_delay = true;
-        next_deadline_delay_ns = *next_assembly_retirement_delay_ns;
-      }
-    }
-
-    if (has_next_deadline_delay) {
-      core_thread_.set_timer_deadline_ns(next_deadline_delay_ns);
+    timer_deadlines_.set(
+        DeadlineKind::TELEMETRY_RETENTION,
+        now_ns,
+        global_resource_aggregate_telemetry().next_retirement_delay_ns(now_ns, kDestroyedNativeObjectRetentionWindowNs));
+    {
+      bool has_orphan_delay = false;
+      uint64_t orphan_delay_ns = 0;
+      next_capture_retained_plan_orphan_retirement_delay_(now_ns, has_orphan_delay, orphan_delay_ns);
+      timer_deadlines_.set(DeadlineKind::RETAINED_PLAN_ORPHAN_RETENTION,
+                           now_ns,
+                           has_orphan_delay ? std::optional<uint64_t>(orphan_delay_ns) : std::nullopt);
+    }
+    const uint64_t capture_assembly_revision = capture_assembly_registry_.revision();
+    if (!has_capture_admission_watchdog_timeout) {
+      timer_deadlines_.invalidate(DeadlineKind::CAPTURE_ADMISSION_WATCHDOG);
+    } else if (sweep_capture_admission_watchdog ||
+               timer_deadlines_.due(DeadlineKind::CAPTURE_ADMISSION_WATCHDOG, now_ns, capture_assembly_revision)) {
+      timer_deadlines_.set(
+          DeadlineKind::CAPTURE_ADMISSION_WATCHDOG,
+          now_ns,
+          capture_assembly_registry_.next_admission_timeout_delay_ns(now_ns, capture_admission_watchdog_timeout_ns),
+          capture_assembly_revision);
+    }
+    const uint64_t capture_cohort_revision = capture_cohort_registry_.revision();
+    if (sweep_capture_cohorts ||
+        timer_deadlines_.due(DeadlineKind::CAPTURE_COHORT_RETENTION, now_ns, capture_cohort_revision)) {
+      timer_deadlines_.set(
+          DeadlineKind::CAPTURE_COHORT_RETENTION,
+          now_ns,
+          capture_cohort_registry_.next_cohort_expiry_delay_ns(now_ns, kCaptureCohortRetentionWindowNs),
+          capture_cohort_revision);
+    }
+    if (sweep_capture_assemblies ||
+        timer_deadlines_.due(DeadlineKind::CAPTURE_ASSEMBLY_RETENTION, now_ns, capture_assembly_revision)) {
+      timer_deadlines_.set(
+          DeadlineKind::CAPTURE_ASSEMBLY_RETENTION,
+          now_ns,
+          capture_assembly_registry_.next_terminal_retirement_delay_ns(now_ns, kCaptureResultRetentionWindowNs),
+          capture_assembly_revision);
+    }
+
+    // Stream QoS samples once per period while enabled; the tick that sees
+    // it toggled runs one step at once (a disabling step restores streams).
+    const bool stream_qos_enabled = stream_qos_enabled_.load(std::memory_order_acquire);
+    if (stream_qos_enabled != stream_qos_sampling_) {
+      stream_qos_sampling_ = stream_qos_enabled;
+      timer_deadlines_.invalidate(DeadlineKind::STREAM_QOS);
+    }
+    if (timer_deadlines_.due(DeadlineKind::STREAM_QOS, now_ns, 0)) {
+      run_stream_qos_(now_ns);
+      timer_deadlines_.set(DeadlineKind::STREAM_QOS,
+                           now_ns,
+                           stream_qos_enabled ? std::optional<uint64_t>(CoreStreamQosController::kSamplePeriodNs)
+                                              : std::nullopt);
+    }
+
+    const uint64_t retention_sweep_slack_ns =
+        (shortest_started_frame_period_ns != 0) ? kRetentionSweepSlackNs : kIdleRetentionSweepSlackNs;
+    for (DeadlineKind kind : {DeadlineKind::NATIVE_OBJECT_RETENTION, DeadlineKind::TELEMETRY_RETENTION,
+                              DeadlineKind::RETAINED_PLAN_ORPHAN_RETENTION,
+                              DeadlineKind::CAPTURE_COHORT_RETENTION, DeadlineKind::CAPTURE_ASSEMBLY_RETENTION}) {
+      timer_deadlines_.set_slack(kind, retention_sweep_slack_ns);
+    }
+    timer_deadlines_.set_slack(DeadlineKind::STREAM_QOS, kRetentionSweepSlackNs);
+    if (const auto next_deadline_delay_ns = timer_deadlines_.next_delay_ns(now_ns);
+        next_deadline_delay_ns.has_value()) {
+      core_thread_.set_timer_deadline_ns(*next_deadline_delay_ns);
     } else {
       core_thread_.clear_timer_deadline();
     }
 
   }
 
-  // 4) Snapshot publish (coalesced).
+  // 4) Snapshot publish (coalesced). Counter-only publishes are paced
+  // (CorePublishPacer); topology changes, the baseline and shutdown publishes
+  // are built on the tick that requested them.
   if (publish_pending_.load(std::memory_order_acquire)) {
-    // Clear pending first so a new request can enqueue even if publish work is heavy.
-    publish_pending_.store(false, std::memory_order_release);
-
     SnapshotBuilder::Inputs in;
     in.rigs = &rigs_;
     in.devices = &devices_;
@@ -4787,42 +5320,98 @@ void CoreRuntime::on_core_timer_tick() {
     in.ingress = &ingress_;
     in.native_objects = &native_objects_;
     in.spec_state = &spec_state_;
+    in.capture_latency = &capture_latency_stats_;
+    in.results = &result_store_;
     in.scoped_resource_telemetry = &global_resource_aggregate_telemetry();
 
     const uint64_t topo_sig = snapshot_builder_.compute_topology_signature(in);
+    const bool topology_changed = !has_topology_sig_ || topo_sig != last_topology_sig_;
+    const bool shutting_down =
+        shutdown_requested_ || shutdown_requested_from_stop_.load(std::memory_order_acquire);
+    const uint64_t pace_delay_ns = topology_changed || shutting_down
+        ? 0
+        : publish_pacer_.delay_ns(CoreThread::steady_now_ns());
+    if (pace_delay_ns != 0) {
+      if (!publish_paced_) {
+        publish_paced_ = true;
+        snapshot_publishes_paced_.fetch_add(1, std::memory_order_relaxed);
+      }
+      timer_deadlines_.set(CoreDeadlineTable::Kind::SNAPSHOT_PUBLISH, now_ns, pace_delay_ns);
+      if (const auto next_delay_ns = timer_deadlines_.next_delay_ns(now_ns); next_delay_ns.has_value()) {
+        core_thread_.set_timer_deadline_ns(*next_delay_ns);
+      }
+    } else if (snapshot_publish_worker_.running() && !snapshot_publish_worker_.can_submit()) {
+      // The worker still holds an unpublished view. The publish stays
+      // pending and absorbs later changes; the worker requests a tick when
+      // it takes that view.
+    } else {
+      publish_paced_ = false;
+      timer_deadlines_.set(CoreDeadlineTable::Kind::SNAPSHOT_PUBLISH, now_ns, std::nullopt);
+      // Clear pending first so a new request can enqueue even if publish work is heavy.
+      publish_pending_.store(false, std::memory_order_release);
+      const uint64_t snapshot_build_started_ns = CoreThread::steady_now_ns();
+      if (publish_requested_ns_ != 0) {
+        core_thread_.task_timing().record_wait(
+            CoreTaskKind::SNAPSHOT_BUILD,
+            snapshot_build_started_ns > publish_requested_ns_ ? snapshot_build_started_ns - publish_requested_ns_ : 0);
+        publish_requested_ns_ = 0;
+      }
+      publish_payload_buffer_telemetry_(false);
+
+      // Publish-side topology signature for boundary diffing (Godot-facing).
+      // This is updated on every successful snapshot build/publish.
+      published_topology_sig_.store(topo_sig, std::memory_order_release);
+
+      // topology_version is zero-indexed within each gen.
+      // The first published snapshot establishes the baseline topology_version=0.
+      if (!has_topology_sig_) {
+        has_topology_sig_ = true;
+        last_topology_sig_ = topo_sig;
+      } else if (topo_sig != last_topology_sig_) {
+        last_topology_sig_ = topo_sig;
+        ++topology_version_;
+      }
 
-    // Publish-side topology signature for boundary diffing (Godot-facing).
-    // This is updated on every successful snapshot build/publish.
-    published_topology_sig_.store(topo_sig, std::memory_order_release);
-
-    // topology_version is zero-indexed within each gen.
-    // The first published snapshot establishes the baseline topology_version=0.
-    if (!has_topology_sig_) {
-      has_topology_sig_ = true;
-      last_topology_sig_ = topo_sig;
-    } else if (topo_sig != last_topology_sig_) {
-      last_topology_sig_ = topo_sig;
-      ++topology_version_;
-    }
-
-    const uint64_t gen_out = current_gen_;
-    const uint64_t ver_out = version_;
-    const uint64_t topo_out = topology_version_;
-    const uint64_t timestamp_ns = ns_since_epoch_(now);
+      const uint64_t gen_out = current_gen_;
+      const uint64_t ver_out = version_;
+      const uint64_t topo_out = topology_version_;
+      const uint64_t timestamp_ns = ns_since_epoch_(now);
+
+      IStateSnapshotPublisher* pub = snapshot_publisher_.load(std::memory_order_acquire);
+      const uint32_t sections = pub ? pub->wanted_snapshot_sections() : kCBSnapshotSectionsAll;
+      if (snapshot_publish_worker_.running()) {
+        CoreSnapshotPublishWorker::Job job;
+        job.view = snapshot_builder_.capture(in, gen_out, ver_out, topo_out, timestamp_ns, sections);
+        job.publisher = pub;
+        job.sections = sections;
+        ++version_;
+        // The slot was free above and only this thread fills it. The worker
+        // advances published_seq_ once the snapshot is visible.
+        const bool submitted = snapshot_publish_worker_.try_submit(job);
+        assert(submitted);
+        (void)submitted;
+      } else {
+        CamBANGStateSnapshot snap =
+            snapshot_builder_.build(in, gen_out, ver_out, topo_out, timestamp_ns, sections);
+        std::shared_ptr<const CamBANGStateSnapshot> shared = std::make_shared<CamBANGStateSnapshot>(std::move(snap));
 
-    CamBANGStateSnapshot snap = snapshot_builder_.build(in, gen_out, ver_out, topo_out, timestamp_ns);
-    auto shared = std::make_shared<CamBANGStateSnapshot>(std::move(snap));
+        // Advance per-generation publish counter only after snapshot assembly succeeds.
+        ++version_;
 
-    // Advance per-generation publish counter only after snapshot assembly succeeds.
-    ++version_;
+        publish_state_snapshot(pub, sections, std::move(shared), snapshot_delta_base_);
 
-    if (IStateSnapshotPublisher* pub = snapshot_publisher_.load(std::memory_order_acquire)) {
-      pub->publish(std::move(shared));
+        // published_seq_ must not become visible before the corresponding snapshot
+        // is visible to boundary consumers.
+        published_seq_.fetch_add(1, std::memory_order_acq_rel);
+      }
+      const uint64_t snapshot_build_ns = CoreThread::steady_now_ns() - snapshot_build_started_ns;
+      core_thread_.task_timing().record_exec(CoreTaskKind::SNAPSHOT_BUILD, snapshot_build_ns);
+      publish_pacer_.note_published(
+          snapshot_build_started_ns,
+          snapshot_build_ns,
+          !provider_facts_.empty() || core_thread_.ordinary_lane_pending() != 0);
+      snapshot_publish_interval_ns_.store(publish_pacer_.interval_ns(), std::memory_order_relaxed);
     }
-
-    // published_seq_ must not become visible before the corresponding snapshot
-    // is visible to boundary consumers.
-    published_seq_.fetch_add(1, std::memory_order_acq_rel);
   }
 
   if (shutdown_requested_from_stop_.exchange(false, std::memory_order_acq_rel)) {
@@ -4883,6 +5472,7 @@ void CoreRuntime::on_core_timer_tick() {
               started_stream_ids.push_back(rec.stream_id);
             }
           }
+          drain_frame_shards_();
           for (const uint64_t stream_id : started_stream_ids) {
             (void)streams_.mark_stop_requested_by_core(stream_id);
             const ProviderResult sr = prov->stop_stream(stream_id);
@@ -4923,6 +5513,7 @@ void CoreRuntime::on_core_timer_tick() {
               created_stream_ids.push_back(rec.stream_id);
             }
           }
+          drain_frame_shards_();
           for (const uint64_t stream_id : created_stream_ids) {
             const ProviderResult dr = prov->destroy_stream(stream_id);
             if (dr.ok()) {
@@ -4930,6 +5521,7 @@ void CoreRuntime::on_core_timer_tick() {
               result_store_.remove_stream_result(stream_id);
               stream_retained_plan_evaluators_.erase(stream_id);
               stream_retained_plan_decisions_.erase(stream_id);
+              stream_pool_depth_hints_.erase(stream_id);
             }
           }
         }
@@ -4951,6 +5543,7 @@ void CoreRuntime::on_core_timer_tick() {
       }
 
       case ShutdownPhase::CLOSE_DEVICES: {
+        drain_frame_shards_();
         if (prov) {
           for (const auto& kv : devices_.all()) {
             const auto& rec = kv.second;
@@ -4977,6 +5570,7 @@ void CoreRuntime::on_core_timer_tick() {
 
       case ShutdownPhase::PROVIDER_SHUTDOWN: {
         // Step 5: request provider shutdown (idempotent).
+        drain_frame_shards_();
         if (prov) {
           (void)prov->shutdown();
         }
@@ -5020,6 +5614,8 @@ void CoreRuntime::on_core_timer_tick() {
         // They remain truthfully retained while the generation is live and through
         // final prior-generation publication, then are quarantined before exit.
         (void)native_objects_.clear_destroyed();
+        // Unpin the ingress's per-stream buckets so clear() can drop them.
+        ingress_.release_lease_telemetry_handles();
         global_resource_aggregate_telemetry().clear();
         set_phase(ShutdownPhase::EXIT);
         shutdown_wait_ticks_ = 0;
@@ -5054,23 +5650,38 @@ void CoreRuntime::on_core_stop() {
   // stranded here and merely clear()ed would leak its multi-MB payload and
   // permanently pin its provider pool slot.
   release_queued_provider_frame_facts_(provider_facts_);
+  // Shards run out their queues (releasing every frame) before the results
+  // they retain into are cleared; completions left over are moot now.
+  frame_shards_.stop();
+  frame_shards_.take_completions(frame_shard_completions_);
+  frame_shard_completions_.clear();
+  // Publishes a snapshot still waiting (possibly this generation's last).
+  snapshot_publish_worker_.stop();
+  // No further facts will be integrated for this generation.
+  operations_.resolve_all(CoreOperationOutcome::Cancelled);
   // Runtime is no longer live; clear retained results so stop/start boundaries
   // cannot expose stale prior-generation result truth.
   result_store_.clear();
+  capture_spill_store_.clear();
   provider_camera_fact_state_.clear();
+  resolved_camera_static_facts_.clear();
+  publish_payload_buffer_telemetry_(true);
+  ingress_.release_lease_telemetry_handles();
   global_resource_aggregate_telemetry().clear();
   stream_retained_plan_evaluators_.clear();
   capture_retained_plan_evaluators_.clear();
   stream_retained_plan_decisions_.clear();
   capture_retained_plan_decisions_.clear();
+  stream_pool_depth_hints_.clear();
   capture_priming_seeds_.clear();
   capture_parent_priming_states_.clear();
   pending_capture_observations_.clear();
+  retained_plan_priors_.flush();
   // Core thread is exiting. Ensure external gating sees STOPPED promptly.
   state_.store(CoreRuntimeState::STOPPED, std::memory_order_release);
 }
 
-void CoreRuntime::post(CoreThread::Task task) {
+void CoreRuntime::post(RequestTask task) {
   // Best-effort compatibility shim for disposable work only; retained runtime
   // truth must call an admission-returning path and handle the result.
   (void)try_post(std::move(task));
@@ -5088,7 +5699,7 @@ CoreThread::PostResult CoreRuntime::retain_device_identity(uint64_t device_insta
     has_capture_template = true;
   }
 
-  return try_post([this, device_instance_id, hardware_id, capture_tmpl, has_capture_template]() {
+  return try_post([this, device_instance_id, hardware_id = hardware_id, capture_tmpl, has_capture_template]() {
     if (!devices_.note_device_identity(device_instance_id, hardware_id)) {
       return;
     }
@@ -5108,10 +5719,11 @@ CoreThread::PostResult CoreRuntime::retain_camera_spec_version(const std::string
     return CoreThread::PostResult::Closed;
   }
 
-  return try_post([this, hardware_id, camera_spec_version]() {
+  return try_post([this, hardware_id = hardware_id, camera_spec_version]() {
     spec_state_.set_camera_spec_version(hardware_id, camera_spec_version);
+    const CoreStringId hardware_key = global_hardware_id_interner().find(hardware_id);
     for (const auto& [device_instance_id, rec] : devices_.all()) {
-      if (rec.hardware_id == hardware_id) {
+      if (hardware_key != 0 && rec.hardware_key == hardware_key) {
         (void)devices_.set_camera_spec_version(device_instance_id, camera_spec_version);
       }
     }
@@ -5168,11 +5780,8 @@ CoreThread::PostResult CoreRuntime::retain_imaging_spec_replace(
   }
   std::vector<uint8_t> owned_payload = copy_spec_patch_payload(effective_spec);
 
-  return try_post([this, imaging_spec_version, owned_payload = std::move(owned_payload)]() {
-    const SpecPatchView retained_payload{
-        owned_payload.empty() ? nullptr : owned_payload.data(),
-        owned_payload.size()};
-    if (!spec_state_.retain_imaging_spec_replace(imaging_spec_version, retained_payload)) {
+  return try_post([this, imaging_spec_version, owned_payload = std::move(owned_payload)]() mutable {
+    if (!spec_state_.retain_imaging_spec_replace(imaging_spec_version, std::move(owned_payload))) {
       return;
     }
     request_publish_from_core_unchecked();
@@ -5187,18 +5796,15 @@ CoreThread::PostResult CoreRuntime::retain_imaging_spec_patch(
   }
   std::vector<uint8_t> owned_payload = copy_spec_patch_payload(effective_spec);
 
-  return try_post([this, imaging_spec_version, owned_payload = std::move(owned_payload)]() {
-    const SpecPatchView retained_payload{
-        owned_payload.empty() ? nullptr : owned_payload.data(),
-        owned_payload.size()};
-    if (!spec_state_.retain_imaging_spec_patch(imaging_spec_version, retained_payload)) {
+  return try_post([this, imaging_spec_version, owned_payload = std::move(owned_payload)]() mutable {
+    if (!spec_state_.retain_imaging_spec_patch(imaging_spec_version, std::move(owned_payload))) {
       return;
     }
     request_publish_from_core_unchecked();
   });
 }
 
-CoreThread::PostResult CoreRuntime::try_post(CoreThread::Task task) {
+CoreThread::PostResult CoreRuntime::try_post(RequestTask task) {
   const CoreRuntimeState st = state_.load(std::memory_order_acquire);
   if (st != CoreRuntimeState::LIVE) {
     return core_thread_.reject_closed();
@@ -5225,7 +5831,8 @@ TryCreateStreamStatus CoreRuntime::try_create_stream(
     StreamIntent intent,
     const CaptureProfile* request_profile,
     const PictureConfig* request_picture,
-    uint64_t profile_version) noexcept try {
+    uint64_t profile_version,
+    StreamPriority priority) noexcept try {
   if (stream_id == 0 || device_instance_id == 0) {
     return TryCreateStreamStatus::InvalidArgument;
   }
@@ -5252,97 +5859,136 @@ TryCreateStreamStatus CoreRuntime::try_create_stream(
        has_request_profile,
        request_profile_copy,
        has_request_picture,
-       request_picture_copy]() -> TryCreateStreamStatus {
-    ICameraProvider* p = provider_.load(std::memory_order_acquire);
-    if (!p) {
-      return TryCreateStreamStatus::Busy;
-    }
+       request_picture_copy,
+       priority]() -> TryCreateStreamStatus {
+    return create_stream_on_core_(stream_id,
+                                  device_instance_id,
+                                  intent,
+                                  profile_version,
+                                  tmpl,
+                                  has_request_profile ? &request_profile_copy : nullptr,
+                                  has_request_picture ? &request_picture_copy : nullptr,
+                                  priority);
+  });
+} catch (...) {
+  return TryCreateStreamStatus::Busy;
+}
+
+TryCreateStreamStatus CoreRuntime::create_stream_on_core_(
+    uint64_t stream_id,
+    uint64_t device_instance_id,
+    StreamIntent intent,
+    uint64_t profile_version,
+    const StreamTemplate& tmpl,
+    const CaptureProfile* request_profile,
+    const PictureConfig* request_picture,
+    StreamPriority priority) {
+  ICameraProvider* p = provider_.load(std::memory_order_acquire);
+  if (!p) {
+    return TryCreateStreamStatus::Busy;
+  }
 
-    const uint64_t effective_profile_version =
-        (profile_version != 0)
-            ? profile_version
-            : create_stream_profile_version_seq_.fetch_add(1, std::memory_order_relaxed);
+  const uint64_t effective_profile_version =
+      (profile_version != 0)
+          ? profile_version
+          : create_stream_profile_version_seq_.fetch_add(1, std::memory_order_relaxed);
 
-    StreamRequest effective{};
-    effective.stream_id = stream_id;
-    effective.device_instance_id = device_instance_id;
-    effective.intent = intent;
-    effective.profile_version = effective_profile_version;
-    effective.profile = has_request_profile ? request_profile_copy : tmpl.profile;
-    effective.picture = has_request_picture ? request_picture_copy : tmpl.picture;
-    ProducerBackingCapabilities runtime_caps{};
-    ProducerBackingCapabilities parent_context_caps{};
-    if (!resolve_stream_backing_capabilities_(
-            effective.device_instance_id,
-            effective.stream_id,
-            effective.intent,
-            effective.profile,
-            effective.picture,
-            runtime_caps,
-            parent_context_caps)) {
-      return TryCreateStreamStatus::ProviderRejected;
+  StreamRequest effective{};
+  effective.stream_id = stream_id;
+  effective.device_instance_id = device_instance_id;
+  effective.intent = intent;
+  effective.priority = priority;
+  effective.profile_version = effective_profile_version;
+  effective.profile = request_profile ? *request_profile : tmpl.profile;
+  effective.picture = request_picture ? *request_picture : tmpl.picture;
+  ProducerBackingCapabilities runtime_caps{};
+  ProducerBackingCapabilities parent_context_caps{};
+  if (!resolve_stream_backing_capabilities_(
+          effective.device_instance_id,
+          effective.stream_id,
+          effective.intent,
+          effective.profile,
+          effective.picture,
+          runtime_caps,
+          parent_context_caps)) {
+    return TryCreateStreamStatus::ProviderRejected;
+  }
+  CoreRetainedPlanPriorStore::Key prior_key;
+  CoreRetainedProductionPlan prior{};
+  if (build_stream_retained_plan_prior_key_(
+          device_instance_id, effective.profile, runtime_caps, parent_context_caps, prior_key)) {
+    (void)retained_plan_priors_.find(prior_key, prior);
+  }
+  const RetainedPlanResetDecision retained_plan_decision =
+      build_retained_plan_reset_decision(
+          BackingPlanEvaluationPrimaryFunction::StreamDisplayView,
+          parent_context_caps,
+          CoreRetainedProductionPlan{},
+          prior);
+  effective.requested_retained_plan =
+      stream_retained_plan_for_profile(retained_plan_decision.requested, effective.profile);
+
+  // Declare before calling into the provider so any synchronous callbacks
+  // can resolve the record deterministically.
+  (void)streams_.declare_stream_effective(
+      effective, retained_plan_decision.steady);
+  (void)streams_.set_backing_capabilities(
+      effective.stream_id, runtime_caps, parent_context_caps);
+  if (retained_plan_decision.evaluation_active) {
+    RetainedPlanEvaluatorState state;
+    state.device_instance_id = effective.device_instance_id;
+    state.primary_function =
+        BackingPlanEvaluationPrimaryFunction::StreamDisplayView;
+    state.completion_reason = BackingPlanEvaluationCompletionReason::None;
+    state.active = true;
+    state.candidate_count = retained_plan_decision.candidate_count;
+    for (uint8_t i = 0; i < retained_plan_decision.candidate_count; ++i) {
+      state.candidate_sequence[i] = make_retained_plan(
+          retained_plan_decision.candidate_sequence[i]);
     }
-    const RetainedPlanResetDecision retained_plan_decision =
-        build_retained_plan_reset_decision(
-            BackingPlanEvaluationPrimaryFunction::StreamDisplayView,
-            parent_context_caps);
-    effective.requested_retained_plan = retained_plan_decision.requested;
-
-    // Declare before calling into the provider so any synchronous callbacks
-    // can resolve the record deterministically.
-    (void)streams_.declare_stream_effective(
-        effective, retained_plan_decision.steady);
-    (void)streams_.set_backing_capabilities(
-        effective.stream_id, runtime_caps, parent_context_caps);
-    if (retained_plan_decision.evaluation_active) {
-      RetainedPlanEvaluatorState state;
-      state.device_instance_id = effective.device_instance_id;
-      state.primary_function =
-          BackingPlanEvaluationPrimaryFunction::StreamDisplayView;
-      state.completion_reason = BackingPlanEvaluationCompletionReason::None;
-      state.active = true;
-      state.candidate_count = retained_plan_decision.candidate_count;
-      for (uint8_t i = 0; i < retained_plan_decision.candidate_count; ++i) {
-        state.candidate_sequence[i] = make_retained_plan(
-            retained_plan_decision.candidate_sequence[i]);
-      }
-      stream_retained_plan_evaluators_[stream_id] = state;
-      stream_retained_plan_decisions_.erase(stream_id);
-    } else {
-      stream_retained_plan_evaluators_.erase(stream_id);
-      CoreRetainedProductionPlan candidate_sequence[3]{};
-      for (uint8_t i = 0; i < retained_plan_decision.candidate_count; ++i) {
-        candidate_sequence[i] =
-            make_retained_plan(retained_plan_decision.candidate_sequence[i]);
-      }
-      RetainedPlanDecisionProvenance provenance =
-          build_non_evaluated_decision_provenance_(
-              BackingPlanEvaluationPrimaryFunction::StreamDisplayView,
-              device_instance_id,
-              0,
-              retained_plan_decision.requested,
-              retained_plan_decision.steady,
-              retained_plan_decision.candidate_count,
-              candidate_sequence);
-      stream_retained_plan_decisions_[stream_id] = provenance;
-    }
-
-    const ProviderResult r = p->create_stream(effective);
-    if (!r.ok()) {
-      // Best-effort rollback; create_stream failure must not leave a ghost record.
-      (void)streams_.forget_stream(effective.stream_id);
-      stream_retained_plan_evaluators_.erase(stream_id);
-      stream_retained_plan_decisions_.erase(stream_id);
-      request_publish_from_core_unchecked();
-      return TryCreateStreamStatus::ProviderRejected;
+    stream_retained_plan_evaluators_[stream_id] = state;
+    stream_retained_plan_decisions_.erase(stream_id);
+  } else {
+    stream_retained_plan_evaluators_.erase(stream_id);
+    CoreRetainedProductionPlan candidate_sequence[3]{};
+    for (uint8_t i = 0; i < retained_plan_decision.candidate_count; ++i) {
+      candidate_sequence[i] =
+          make_retained_plan(retained_plan_decision.candidate_sequence[i]);
     }
-    if (streams_.on_stream_created(effective.stream_id)) {
-      request_publish_from_core_unchecked();
+    RetainedPlanDecisionProvenance provenance =
+        build_non_evaluated_decision_provenance_(
+            BackingPlanEvaluationPrimaryFunction::StreamDisplayView,
+            device_instance_id,
+            0,
+            retained_plan_decision.requested,
+            retained_plan_decision.steady,
+            retained_plan_decision.candidate_count,
+            candidate_sequence);
+    if (retained_plan_decision.from_persisted_prior) {
+      provenance.completion_reason =
+          BackingPlanEvaluationCompletionReason::PersistedPrior;
     }
-    return TryCreateStreamStatus::OK;
-  });
-} catch (...) {
-  return TryCreateStreamStatus::Busy;
+    stream_retained_plan_decisions_[stream_id] = provenance;
+  }
+
+  // Before the provider can produce frames, so its strand and ingress shed
+  // them by the stream's class from the first one.
+  ingress_.set_stream_priority(effective.stream_id, priority);
+  const ProviderResult r = p->create_stream(effective);
+  if (!r.ok()) {
+    // Best-effort rollback; create_stream failure must not leave a ghost record.
+    (void)streams_.forget_stream(effective.stream_id);
+    ingress_.forget_stream_priority(effective.stream_id);
+    stream_retained_plan_evaluators_.erase(stream_id);
+    stream_retained_plan_decisions_.erase(stream_id);
+    request_publish_from_core_unchecked();
+    return TryCreateStreamStatus::ProviderRejected;
+  }
+  if (streams_.on_stream_created(effective.stream_id)) {
+    request_publish_from_core_unchecked();
+  }
+  refresh_stream_pool_depth_hint_(effective.stream_id);
+  return TryCreateStreamStatus::OK;
 }
 
 TryStartStreamStatus CoreRuntime::try_start_stream(uint64_t stream_id) noexcept try {
@@ -5357,48 +6003,54 @@ TryStartStreamStatus CoreRuntime::try_start_stream(uint64_t stream_id) noexcept
 
   return run_synchronous_command_(TryStartStreamStatus::Busy,
       [this, stream_id]() -> TryStartStreamStatus {
-    ICameraProvider* prov_local = provider_.load(std::memory_order_acquire);
-    if (!prov_local) {
-      return TryStartStreamStatus::Busy;
-    }
+    return start_stream_on_core_(stream_id);
+  });
+} catch (...) {
+  return TryStartStreamStatus::Busy;
+}
 
-    const CoreStreamRegistry::StreamRecord* rec = streams_.find(stream_id);
-    if (!rec) {
-      return TryStartStreamStatus::InvalidArgument;
-    }
-    if (rec->started) {
-      return TryStartStreamStatus::OK;
-    }
-    const uint64_t owner_device_instance_id = rec->device_instance_id;
-    for (const auto& kv : streams_.all()) {
-      const auto& other = kv.second;
-      if (other.stream_id == stream_id) {
-        continue;
-      }
-      if (other.device_instance_id == owner_device_instance_id && other.created && other.started) {
-        return TryStartStreamStatus::Busy;
-      }
-    }
+TryStartStreamStatus CoreRuntime::start_stream_on_core_(uint64_t stream_id) {
+  ICameraProvider* prov_local = provider_.load(std::memory_order_acquire);
+  if (!prov_local) {
+    return TryStartStreamStatus::Busy;
+  }
 
-    const ProviderResult sr = prov_local->start_stream(stream_id, rec->profile, rec->picture);
-    if (!sr.ok()) {
-      timeline_teardown_trace_emit("fail StartStream stream_id=%llu reason=provider_rc_%u",
-                                   static_cast<unsigned long long>(stream_id),
-                                   static_cast<unsigned>(sr.code));
-      (void)streams_.on_stream_error(stream_id, static_cast<uint32_t>(sr.code));
-      return TryStartStreamStatus::ProviderRejected;
+  const CoreStreamRegistry::StreamRecord* rec = streams_.find(stream_id);
+  if (!rec) {
+    return TryStartStreamStatus::InvalidArgument;
+  }
+  if (rec->started) {
+    return TryStartStreamStatus::OK;
+  }
+  const uint64_t owner_device_instance_id = rec->device_instance_id;
+  const uint32_t reported_max_active = prov_local->max_active_streams_per_device();
+  const uint32_t max_active = reported_max_active == 0 ? 1u : reported_max_active;
+  uint32_t active_on_device = 0;
+  for (const auto& kv : streams_.all()) {
+    const auto& other = kv.second;
+    if (other.stream_id == stream_id) {
+      continue;
     }
-    const bool state_changed = streams_.on_core_stream_started(stream_id);
-    (void)refresh_capture_retained_plan_state_(
-        owner_device_instance_id,
-        /*requested_bump_access_posture_epoch=*/false);
-    if (state_changed) {
-      request_publish_from_core_unchecked();
+    if (other.device_instance_id == owner_device_instance_id && other.created && other.started &&
+        ++active_on_device >= max_active) {
+      return TryStartStreamStatus::Busy;
     }
-    return TryStartStreamStatus::OK;
-  });
-} catch (...) {
-  return TryStartStreamStatus::Busy;
+  }
+
+  const ProviderResult sr = prov_local->start_stream(stream_id, rec->profile, rec->picture);
+  if (!sr.ok()) {
+    timeline_teardown_trace_emit("fail StartStream stream_id=%llu reason=provider_rc_%u",
+                                 static_cast<unsigned long long>(stream_id),
+                                 static_cast<unsigned>(sr.code));
+    (void)streams_.on_stream_error(stream_id, static_cast<uint32_t>(sr.code));
+    return TryStartStreamStatus::ProviderRejected;
+  }
+  const bool state_changed = streams_.on_core_stream_started(stream_id);
+  refresh_capture_retained_plan_state_or_defer_(owner_device_instance_id);
+  if (state_changed) {
+    request_publish_from_core_unchecked();
+  }
+  return TryStartStreamStatus::OK;
 }
 
 TryStopStreamStatus CoreRuntime::try_stop_stream(uint64_t stream_id) noexcept try {
@@ -5413,37 +6065,213 @@ TryStopStreamStatus CoreRuntime::try_stop_stream(uint64_t stream_id) noexcept tr
 
   return run_synchronous_command_(TryStopStreamStatus::Busy,
       [this, stream_id]() -> TryStopStreamStatus {
-    ICameraProvider* prov_local = provider_.load(std::memory_order_acquire);
-    if (!prov_local) {
-      return TryStopStreamStatus::Busy;
+    return stop_stream_on_core_(stream_id);
+  });
+} catch (...) {
+  return TryStopStreamStatus::Busy;
+}
+
+TryStopStreamStatus CoreRuntime::stop_stream_on_core_(uint64_t stream_id) {
+  ICameraProvider* prov_local = provider_.load(std::memory_order_acquire);
+  if (!prov_local) {
+    return TryStopStreamStatus::Busy;
+  }
+  const CoreStreamRegistry::StreamRecord* rec = streams_.find(stream_id);
+  if (!rec) {
+    return TryStopStreamStatus::InvalidArgument;
+  }
+  if (!rec->started) {
+    return TryStopStreamStatus::OK;
+  }
+  (void)streams_.mark_stop_requested_by_core(stream_id);
+  drain_frame_shards_();
+  const ProviderResult sr = prov_local->stop_stream(stream_id);
+  if (!sr.ok()) {
+    timeline_teardown_trace_emit("fail StopStream stream_id=%llu reason=provider_rc_%u",
+                                 static_cast<unsigned long long>(stream_id),
+                                 static_cast<unsigned>(sr.code));
+    return TryStopStreamStatus::ProviderRejected;
+  }
+  const bool state_changed =
+      streams_.on_core_stream_stopped(stream_id, /*error_code=*/0);
+  (void)refresh_capture_retained_plan_state_(
+      rec->device_instance_id,
+      /*requested_bump_access_posture_epoch=*/false);
+  if (state_changed) {
+    request_publish_from_core_unchecked();
+  }
+  return TryStopStreamStatus::OK;
+}
+
+TryReconfigureStreamStatus CoreRuntime::try_reconfigure_stream(
+    uint64_t stream_id,
+    const CaptureProfile& profile) noexcept try {
+  if (stream_id == 0 || profile.width == 0 || profile.height == 0 || profile.format_fourcc == 0) {
+    return TryReconfigureStreamStatus::InvalidArgument;
+  }
+
+  ICameraProvider* prov = provider_.load(std::memory_order_acquire);
+  if (!prov) {
+    return TryReconfigureStreamStatus::Busy;
+  }
+
+  return run_synchronous_command_(TryReconfigureStreamStatus::Busy,
+      [this, stream_id, profile]() -> TryReconfigureStreamStatus {
+    const TryReconfigureStreamStatus status = reconfigure_stream_on_core_(stream_id, profile);
+    if (status == TryReconfigureStreamStatus::OK) {
+      // The caller's profile is the one stream QoS lowers from; the next
+      // sample applies the current level to it.
+      const CoreStreamRegistry::StreamRecord* rec = streams_.find(stream_id);
+      if (rec && rec->qos_level != 0) {
+        request_publish_from_core_unchecked();
+      }
+      (void)streams_.set_qos_state(stream_id, 0, 0, profile);
     }
+    return status;
+  });
+} catch (...) {
+  return TryReconfigureStreamStatus::Busy;
+}
+
+TryReconfigureStreamStatus CoreRuntime::reconfigure_stream_on_core_(
+    uint64_t stream_id,
+    const CaptureProfile& profile) {
+  ICameraProvider* p = provider_.load(std::memory_order_acquire);
+  if (!p) {
+    return TryReconfigureStreamStatus::Busy;
+  }
+  const CoreStreamRegistry::StreamRecord* rec = streams_.find(stream_id);
+  if (!rec || !rec->created) {
+    return TryReconfigureStreamStatus::InvalidArgument;
+  }
+  const CaptureProfile& current = rec->profile;
+  if (current.width == profile.width && current.height == profile.height &&
+      current.format_fourcc == profile.format_fourcc &&
+      current.target_fps_min == profile.target_fps_min &&
+      current.target_fps_max == profile.target_fps_max &&
+      current.cpu_sidecar_downscale == profile.cpu_sidecar_downscale) {
+    return TryReconfigureStreamStatus::OK;
+  }
+
+  drain_frame_shards_();
+  const ProviderResult rr = p->reconfigure_stream(stream_id, profile);
+  if (rr.code == ProviderError::ERR_NOT_SUPPORTED) {
+    return TryReconfigureStreamStatus::NotSupported;
+  }
+  if (!rr.ok()) {
+    timeline_teardown_trace_emit("fail ReconfigureStream stream_id=%llu reason=provider_rc_%u",
+                                 static_cast<unsigned long long>(stream_id),
+                                 static_cast<unsigned>(rr.code));
+    return TryReconfigureStreamStatus::ProviderRejected;
+  }
+  // The stream result is deliberately left in place: it stays the latest
+  // result until the first frame at the new profile replaces it.
+  (void)streams_.on_stream_reconfigured(
+      stream_id,
+      profile,
+      create_stream_profile_version_seq_.fetch_add(1, std::memory_order_relaxed),
+      ns_since_epoch_());
+  (void)refresh_stream_retained_plan_state_(
+      stream_id,
+      /*apply_to_provider=*/true,
+      /*requested_bump_access_posture_epoch=*/false);
+  request_publish_from_core_unchecked();
+  return TryReconfigureStreamStatus::OK;
+}
+
+TryStreamRecordingStatus CoreRuntime::try_start_stream_recording(
+    uint64_t stream_id,
+    const std::filesystem::path& path) noexcept try {
+  if (stream_id == 0 || path.empty()) {
+    return TryStreamRecordingStatus::InvalidArgument;
+  }
+  return run_synchronous_command_(TryStreamRecordingStatus::Busy,
+      [this, stream_id, path]() -> TryStreamRecordingStatus {
     const CoreStreamRegistry::StreamRecord* rec = streams_.find(stream_id);
-    if (!rec) {
-      return TryStopStreamStatus::InvalidArgument;
-    }
-    if (!rec->started) {
-      return TryStopStreamStatus::OK;
+    if (!rec || stream_recorder_.recording(stream_id)) {
+      return TryStreamRecordingStatus::InvalidArgument;
     }
-    (void)streams_.mark_stop_requested_by_core(stream_id);
-    const ProviderResult sr = prov_local->stop_stream(stream_id);
-    if (!sr.ok()) {
-      timeline_teardown_trace_emit("fail StopStream stream_id=%llu reason=provider_rc_%u",
-                                   static_cast<unsigned long long>(stream_id),
-                                   static_cast<unsigned>(sr.code));
-      return TryStopStreamStatus::ProviderRejected;
+    if (!stream_recorder_.start(stream_id, rec->device_instance_id, path)) {
+      return TryStreamRecordingStatus::IoError;
     }
-    const bool state_changed =
-        streams_.on_core_stream_stopped(stream_id, /*error_code=*/0);
-    (void)refresh_capture_retained_plan_state_(
-        rec->device_instance_id,
-        /*requested_bump_access_posture_epoch=*/false);
-    if (state_changed) {
-      request_publish_from_core_unchecked();
+    refresh_stream_pool_depth_hint_(stream_id);
+    return TryStreamRecordingStatus::OK;
+  });
+} catch (...) {
+  return TryStreamRecordingStatus::Busy;
+}
+
+TryStreamRecordingStatus CoreRuntime::try_stop_stream_recording(
+    uint64_t stream_id,
+    CoreStreamRecorder::Stats* out) noexcept try {
+  if (stream_id == 0) {
+    return TryStreamRecordingStatus::InvalidArgument;
+  }
+  // Held by value: a command abandoned to a wedged core thread must not
+  // write through a dangling reference.
+  auto detached = std::make_shared<CoreStreamRecorder::SharedRecording>();
+  const TryStreamRecordingStatus status = run_synchronous_command_(TryStreamRecordingStatus::Busy,
+      [this, stream_id, detached]() -> TryStreamRecordingStatus {
+    *detached = stream_recorder_.detach(stream_id);
+    if (!*detached) {
+      return TryStreamRecordingStatus::InvalidArgument;
+    }
+    refresh_stream_pool_depth_hint_(stream_id);
+    return TryStreamRecordingStatus::OK;
+  });
+  if (status != TryStreamRecordingStatus::OK) {
+    return status;
+  }
+  // The I/O thread completes the file; the caller waits, not the core thread.
+  const CoreStreamRecorder::Stats stats = stream_recorder_.wait_finished(*detached);
+  if (out) {
+    *out = stats;
+  }
+  return stats.io_error ? TryStreamRecordingStatus::IoError : TryStreamRecordingStatus::OK;
+} catch (...) {
+  return TryStreamRecordingStatus::Busy;
+}
+
+TryStreamExportStatus CoreRuntime::try_start_stream_export(
+    uint64_t stream_id,
+    const std::string& name,
+    size_t max_payload_bytes) noexcept try {
+  if (stream_id == 0 || name.empty() || max_payload_bytes == 0) {
+    return TryStreamExportStatus::InvalidArgument;
+  }
+  return run_synchronous_command_(TryStreamExportStatus::Busy,
+      [this, stream_id, name, max_payload_bytes]() -> TryStreamExportStatus {
+    const CoreStreamRegistry::StreamRecord* rec = streams_.find(stream_id);
+    if (!rec || stream_exporter_.exporting(stream_id)) {
+      return TryStreamExportStatus::InvalidArgument;
     }
-    return TryStopStreamStatus::OK;
+    return stream_exporter_.start(stream_id, rec->device_instance_id, name, max_payload_bytes)
+        ? TryStreamExportStatus::OK
+        : TryStreamExportStatus::Unavailable;
   });
 } catch (...) {
-  return TryStopStreamStatus::Busy;
+  return TryStreamExportStatus::Busy;
+}
+
+TryStreamExportStatus CoreRuntime::try_stop_stream_export(
+    uint64_t stream_id,
+    CoreStreamExporter::Stats* out) noexcept try {
+  if (stream_id == 0) {
+    return TryStreamExportStatus::InvalidArgument;
+  }
+  // Held by value, as in try_stop_stream_recording().
+  auto stats = std::make_shared<CoreStreamExporter::Stats>();
+  const TryStreamExportStatus status = run_synchronous_command_(TryStreamExportStatus::Busy,
+      [this, stream_id, stats]() -> TryStreamExportStatus {
+    return stream_exporter_.stop(stream_id, stats.get()) ? TryStreamExportStatus::OK
+                                                        : TryStreamExportStatus::InvalidArgument;
+  });
+  if (status == TryStreamExportStatus::OK && out) {
+    *out = *stats;
+  }
+  return status;
+} catch (...) {
+  return TryStreamExportStatus::Busy;
 }
 
 TryDestroyStreamStatus CoreRuntime::try_destroy_stream(uint64_t stream_id) noexcept try {
@@ -5474,6 +6302,7 @@ TryDestroyStreamStatus CoreRuntime::try_destroy_stream(uint64_t stream_id) noexc
     }
 
     const uint64_t owner_device_instance_id = rec->device_instance_id;
+    drain_frame_shards_();
     const ProviderResult dr = p->destroy_stream(stream_id);
     if (!dr.ok()) {
       timeline_teardown_trace_emit("fail DestroyStream stream_id=%llu reason=provider_rc_%u",
@@ -5487,6 +6316,7 @@ TryDestroyStreamStatus CoreRuntime::try_destroy_stream(uint64_t stream_id) noexc
     }
     stream_retained_plan_evaluators_.erase(stream_id);
     stream_retained_plan_decisions_.erase(stream_id);
+    stream_pool_depth_hints_.erase(stream_id);
     (void)refresh_capture_retained_plan_state_(
         owner_device_instance_id,
         /*requested_bump_access_posture_epoch=*/false);
@@ -5515,38 +6345,44 @@ TryOpenDeviceStatus CoreRuntime::try_open_device(
   const CaptureTemplate capture_tmpl = prov->capture_template();
   return run_synchronous_command_(TryOpenDeviceStatus::Busy,
       [this, hardware_id, device_instance_id, root_id, capture_tmpl]() -> TryOpenDeviceStatus {
-    ICameraProvider* p = provider_.load(std::memory_order_acquire);
-    if (!p) {
-      return TryOpenDeviceStatus::Busy;
-    }
-
-    const ProviderResult open_result = p->open_device(hardware_id, device_instance_id, root_id);
-    if (!open_result.ok()) {
-      timeline_teardown_trace_emit("fail OpenDevice device_instance_id=%llu reason=provider_rc_%u",
-                                   static_cast<unsigned long long>(device_instance_id),
-                                   static_cast<unsigned>(open_result.code));
-      return TryOpenDeviceStatus::ProviderRejected;
-    }
-
-    // Retain core-owned device identity/profile truth only after provider open
-    // submission was accepted. A provider-refused open must not publish a
-    // speculative CREATED device record.
-    (void)devices_.note_device_identity(device_instance_id, hardware_id);
-    (void)seed_retained_device_still_profile_from_template(devices_, device_instance_id, capture_tmpl);
-    (void)devices_.set_capture_picture(device_instance_id, capture_tmpl.picture);
-    const bool state_changed = devices_.on_device_opened(device_instance_id);
-    (void)refresh_capture_retained_plan_state_(
-        device_instance_id,
-        /*requested_bump_access_posture_epoch=*/false);
-    if (state_changed) {
-      request_publish_from_core_unchecked();
-    }
-    return TryOpenDeviceStatus::OK;
+    return open_device_on_core_(hardware_id, device_instance_id, root_id, capture_tmpl);
   });
 } catch (...) {
   return TryOpenDeviceStatus::Busy;
 }
 
+TryOpenDeviceStatus CoreRuntime::open_device_on_core_(
+    const std::string& hardware_id,
+    uint64_t device_instance_id,
+    uint64_t root_id,
+    const CaptureTemplate& capture_tmpl) {
+  ICameraProvider* p = provider_.load(std::memory_order_acquire);
+  if (!p) {
+    return TryOpenDeviceStatus::Busy;
+  }
+
+  const ProviderResult open_result = p->open_device(hardware_id, device_instance_id, root_id);
+  if (!open_result.ok()) {
+    timeline_teardown_trace_emit("fail OpenDevice device_instance_id=%llu reason=provider_rc_%u",
+                                 static_cast<unsigned long long>(device_instance_id),
+                                 static_cast<unsigned>(open_result.code));
+    return TryOpenDeviceStatus::ProviderRejected;
+  }
+
+  // Retain core-owned device identity/profile truth only after provider open
+  // submission was accepted. A provider-refused open must not publish a
+  // speculative CREATED device record.
+  (void)devices_.note_device_identity(device_instance_id, hardware_id);
+  (void)seed_retained_device_still_profile_from_template(devices_, device_instance_id, capture_tmpl);
+  (void)devices_.set_capture_picture(device_instance_id, capture_tmpl.picture);
+  const bool state_changed = devices_.on_device_opened(device_instance_id);
+  refresh_capture_retained_plan_state_or_defer_(device_instance_id);
+  if (state_changed) {
+    request_publish_from_core_unchecked();
+  }
+  return TryOpenDeviceStatus::OK;
+}
+
 TryCloseDeviceStatus CoreRuntime::try_close_device(uint64_t device_instance_id) noexcept try {
   if (device_instance_id == 0) {
     return TryCloseDeviceStatus::InvalidArgument;
@@ -5559,73 +6395,407 @@ TryCloseDeviceStatus CoreRuntime::try_close_device(uint64_t device_instance_id)
 
   return run_synchronous_command_(TryCloseDeviceStatus::Busy,
       [this, device_instance_id]() -> TryCloseDeviceStatus {
-    ICameraProvider* p = provider_.load(std::memory_order_acquire);
-    if (!p) {
-      return TryCloseDeviceStatus::Busy;
-    }
-    const ProviderResult cr = p->close_device(device_instance_id);
-    if (!cr.ok()) {
-      timeline_teardown_trace_emit("fail CloseDevice device_instance_id=%llu reason=provider_rc_%u",
-                                   static_cast<unsigned long long>(device_instance_id),
-                                   static_cast<unsigned>(cr.code));
-      return TryCloseDeviceStatus::ProviderRejected;
-    }
-    const uint64_t now_ns = ns_since_epoch_();
-    bool retain_capture_orphans = false;
-    for (const auto& [key, state] : capture_retained_plan_evaluators_) {
-      if (state.device_instance_id == device_instance_id ||
-          (key.kind ==
-               CaptureRetainedPlanParentKey::Kind::CapturePriming &&
-           key.id == device_instance_id)) {
+    return close_device_on_core_(device_instance_id);
+  });
+} catch (...) {
+  return TryCloseDeviceStatus::Busy;
+}
+
+TryCloseDeviceStatus CoreRuntime::close_device_on_core_(uint64_t device_instance_id) {
+  ICameraProvider* p = provider_.load(std::memory_order_acquire);
+  if (!p) {
+    return TryCloseDeviceStatus::Busy;
+  }
+  drain_frame_shards_();
+  const ProviderResult cr = p->close_device(device_instance_id);
+  if (!cr.ok()) {
+    timeline_teardown_trace_emit("fail CloseDevice device_instance_id=%llu reason=provider_rc_%u",
+                                 static_cast<unsigned long long>(device_instance_id),
+                                 static_cast<unsigned>(cr.code));
+    return TryCloseDeviceStatus::ProviderRejected;
+  }
+  if (retire_closed_device_(device_instance_id)) {
+    request_publish_from_core_unchecked();
+  }
+  return TryCloseDeviceStatus::OK;
+}
+
+CoreOperation CoreRuntime::open_device_async(
+    const std::string& hardware_id,
+    uint64_t device_instance_id,
+    uint64_t root_id,
+    TryOpenDeviceStatus* out_status) noexcept try {
+  ICameraProvider* prov = provider_.load(std::memory_order_acquire);
+  const bool invalid = hardware_id.empty() || device_instance_id == 0 || root_id == 0;
+  if (invalid || !prov) {
+    if (out_status) {
+      *out_status = invalid ? TryOpenDeviceStatus::InvalidArgument : TryOpenDeviceStatus::Busy;
+    }
+    CoreOperation op = CoreOperation::make_pending();
+    (void)op.resolve(CoreOperationOutcome::Failed);
+    return op;
+  }
+  const CaptureTemplate capture_tmpl = prov->capture_template();
+  return run_async_command_(TryOpenDeviceStatus::Busy, out_status,
+      [this, hardware_id, device_instance_id, root_id, capture_tmpl]() {
+        return open_device_on_core_(hardware_id, device_instance_id, root_id, capture_tmpl);
+      },
+      [this, device_instance_id](const CoreOperation& op) {
+        operations_.add(CoreOperationRegistry::Kind::DeviceOpen, device_instance_id, op);
+      });
+} catch (...) {
+  if (out_status) {
+    *out_status = TryOpenDeviceStatus::Busy;
+  }
+  return CoreOperation{};
+}
+
+CoreOperation CoreRuntime::close_device_async(uint64_t device_instance_id,
+                                              TryCloseDeviceStatus* out_status) noexcept {
+  if (device_instance_id == 0) {
+    if (out_status) {
+      *out_status = TryCloseDeviceStatus::InvalidArgument;
+    }
+    CoreOperation op = CoreOperation::make_pending();
+    (void)op.resolve(CoreOperationOutcome::Failed);
+    return op;
+  }
+  return run_async_command_(TryCloseDeviceStatus::Busy, out_status,
+      [this, device_instance_id]() { return close_device_on_core_(device_instance_id); },
+      [this, device_instance_id](const CoreOperation& op) {
+        operations_.add(CoreOperationRegistry::Kind::DeviceClose, device_instance_id, op);
+      });
+}
+
+CoreOperation CoreRuntime::start_stream_async(uint64_t stream_id, TryStartStreamStatus* out_status) noexcept {
+  if (stream_id == 0) {
+    if (out_status) {
+      *out_status = TryStartStreamStatus::InvalidArgument;
+    }
+    CoreOperation op = CoreOperation::make_pending();
+    (void)op.resolve(CoreOperationOutcome::Failed);
+    return op;
+  }
+  return run_async_command_(TryStartStreamStatus::Busy, out_status,
+      [this, stream_id]() { return start_stream_on_core_(stream_id); },
+      [this, stream_id](const CoreOperation& op) {
+        // The start fact still owed for this command (or, for an already
+        // started stream, the last one owed) finishes it.
+        const CoreStreamRegistry::StreamRecord* rec = streams_.find(stream_id);
+        if (!rec || rec->pending_core_start_facts == 0) {
+          (void)op.resolve(CoreOperationOutcome::Succeeded);
+          return;
+        }
+        operations_.add(CoreOperationRegistry::Kind::StreamStart, stream_id, op,
+                        rec->pending_core_start_facts - 1);
+      });
+}
+
+CoreOperation CoreRuntime::stop_stream_async(uint64_t stream_id, TryStopStreamStatus* out_status) noexcept {
+  if (stream_id == 0) {
+    if (out_status) {
+      *out_status = TryStopStreamStatus::InvalidArgument;
+    }
+    CoreOperation op = CoreOperation::make_pending();
+    (void)op.resolve(CoreOperationOutcome::Failed);
+    return op;
+  }
+  return run_async_command_(TryStopStreamStatus::Busy, out_status,
+      [this, stream_id]() { return stop_stream_on_core_(stream_id); },
+      [this, stream_id](const CoreOperation& op) {
+        const CoreStreamRegistry::StreamRecord* rec = streams_.find(stream_id);
+        if (!rec || rec->pending_core_stop_facts == 0) {
+          (void)op.resolve(CoreOperationOutcome::Succeeded);
+          return;
+        }
+        operations_.add(CoreOperationRegistry::Kind::StreamStop, stream_id, op,
+                        rec->pending_core_stop_facts - 1);
+      });
+}
+
+bool CoreRuntime::retire_closed_device_(uint64_t device_instance_id) {
+  const uint64_t now_ns = ns_since_epoch_();
+  bool retain_capture_orphans = false;
+  for (const auto& [key, state] : capture_retained_plan_evaluators_) {
+    if (state.device_instance_id == device_instance_id ||
+        (key.kind ==
+             CaptureRetainedPlanParentKey::Kind::CapturePriming &&
+         key.id == device_instance_id)) {
+      retain_capture_orphans = true;
+      break;
+    }
+  }
+  if (!retain_capture_orphans) {
+    for (const PendingCaptureObservation& pending :
+         pending_capture_observations_) {
+      if (pending.device_instance_id == device_instance_id) {
         retain_capture_orphans = true;
         break;
       }
     }
-    if (!retain_capture_orphans) {
-      for (const PendingCaptureObservation& pending :
-           pending_capture_observations_) {
-        if (pending.device_instance_id == device_instance_id) {
-          retain_capture_orphans = true;
-          break;
-        }
+  }
+  const bool state_changed = devices_.on_device_closed(device_instance_id);
+  capture_latency_stats_.forget_device(device_instance_id);
+  capture_parent_priming_states_.erase(device_instance_id);
+  if (retain_capture_orphans) {
+    mark_capture_retained_plan_state_orphaned_for_device_(
+        device_instance_id,
+        now_ns + kCaptureRetainedPlanOrphanRetentionWindowNs);
+  } else {
+    for (auto it = capture_retained_plan_evaluators_.begin();
+         it != capture_retained_plan_evaluators_.end();) {
+      if (it->second.device_instance_id == device_instance_id) {
+        it = capture_retained_plan_evaluators_.erase(it);
+      } else {
+        ++it;
       }
     }
-    const bool state_changed = devices_.on_device_closed(device_instance_id);
-    capture_parent_priming_states_.erase(device_instance_id);
-    if (retain_capture_orphans) {
-      mark_capture_retained_plan_state_orphaned_for_device_(
-          device_instance_id,
-          now_ns + kCaptureRetainedPlanOrphanRetentionWindowNs);
-    } else {
-      for (auto it = capture_retained_plan_evaluators_.begin();
-           it != capture_retained_plan_evaluators_.end();) {
-        if (it->second.device_instance_id == device_instance_id) {
-          it = capture_retained_plan_evaluators_.erase(it);
-        } else {
-          ++it;
-        }
+    for (auto it = capture_retained_plan_decisions_.begin();
+         it != capture_retained_plan_decisions_.end();) {
+      const bool same_device =
+          it->second.device_instance_id == device_instance_id ||
+          (it->first.kind ==
+               CaptureRetainedPlanParentKey::Kind::CapturePriming &&
+           it->first.id == device_instance_id);
+      if (same_device) {
+        it = capture_retained_plan_decisions_.erase(it);
+      } else {
+        ++it;
       }
-      for (auto it = capture_retained_plan_decisions_.begin();
-           it != capture_retained_plan_decisions_.end();) {
-        const bool same_device =
-            it->second.device_instance_id == device_instance_id ||
-            (it->first.kind ==
-                 CaptureRetainedPlanParentKey::Kind::CapturePriming &&
-             it->first.id == device_instance_id);
-        if (same_device) {
-          it = capture_retained_plan_decisions_.erase(it);
+    }
+  }
+  return state_changed;
+}
+
+TrySwapProviderStatus CoreRuntime::try_swap_provider(
+    const std::function<ProviderResult()>& swap) noexcept try {
+  if (!swap) {
+    return TrySwapProviderStatus::InvalidArgument;
+  }
+
+  ICameraProvider* prov = provider_.load(std::memory_order_acquire);
+  if (!prov) {
+    return TrySwapProviderStatus::Busy;
+  }
+
+  return run_synchronous_command_(TrySwapProviderStatus::Busy,
+      [this, swap]() -> TrySwapProviderStatus {
+    ICameraProvider* p = provider_.load(std::memory_order_acquire);
+    if (!p) {
+      return TrySwapProviderStatus::Busy;
+    }
+
+    drain_frame_shards_();
+    std::vector<uint64_t> stream_ids;
+    stream_ids.reserve(streams_.all().size());
+    for (const auto& kv : streams_.all()) {
+      if (kv.second.started) {
+        stream_ids.push_back(kv.second.stream_id);
+      }
+    }
+    for (const uint64_t stream_id : stream_ids) {
+      (void)streams_.mark_stop_requested_by_core(stream_id);
+      if (p->stop_stream(stream_id).ok()) {
+        (void)streams_.on_core_stream_stopped(stream_id, /*error_code=*/0);
+      }
+    }
+
+    stream_ids.clear();
+    for (const auto& kv : streams_.all()) {
+      if (kv.second.created) {
+        stream_ids.push_back(kv.second.stream_id);
+      }
+    }
+    for (const uint64_t stream_id : stream_ids) {
+      if (p->destroy_stream(stream_id).ok()) {
+        (void)streams_.on_stream_destroyed(stream_id);
+        result_store_.remove_stream_result(stream_id);
+        stream_retained_plan_evaluators_.erase(stream_id);
+        stream_retained_plan_decisions_.erase(stream_id);
+        stream_pool_depth_hints_.erase(stream_id);
+      }
+    }
+
+    std::vector<uint64_t> device_ids;
+    device_ids.reserve(devices_.all().size());
+    for (const auto& kv : devices_.all()) {
+      if (kv.second.open) {
+        device_ids.push_back(kv.second.device_instance_id);
+      }
+    }
+    for (const uint64_t device_instance_id : device_ids) {
+      if (p->close_device(device_instance_id).ok()) {
+        (void)retire_closed_device_(device_instance_id);
+      }
+    }
+
+    const ProviderResult sr = swap();
+    request_publish_from_core_unchecked();
+    core_thread_.request_timer_tick();
+    return sr.ok() ? TrySwapProviderStatus::OK : TrySwapProviderStatus::ProviderRejected;
+  });
+} catch (...) {
+  return TrySwapProviderStatus::Busy;
+}
+
+TryRunSetupBatchStatus CoreRuntime::try_run_setup_batch(
+    const std::vector<SetupCommand>& commands,
+    std::vector<SetupCommandStatus>& statuses) noexcept try {
+  statuses.assign(commands.size(), SetupCommandStatus{});
+
+  ICameraProvider* prov = provider_.load(std::memory_order_acquire);
+  if (!prov) {
+    return TryRunSetupBatchStatus::Busy;
+  }
+  const bool supports_multi_image = prov->supports_multi_image_still_sequence();
+
+  // The same argument checks the try_* calls make before posting.
+  bool valid = true;
+  for (size_t i = 0; i < commands.size(); ++i) {
+    const SetupCommand& command = commands[i];
+    if (const auto* open = std::get_if<SetupOpenDevice>(&command)) {
+      if (open->hardware_id.empty() || open->device_instance_id == 0 || open->root_id == 0) {
+        statuses[i] = TryOpenDeviceStatus::InvalidArgument;
+        valid = false;
+      }
+    } else if (const auto* create = std::get_if<SetupCreateStream>(&command)) {
+      if (create->stream_id == 0 || create->device_instance_id == 0) {
+        statuses[i] = TryCreateStreamStatus::InvalidArgument;
+        valid = false;
+      }
+    } else if (const auto* still = std::get_if<SetupSetStillCaptureProfile>(&command)) {
+      if (still->device_instance_id == 0 || still->profile.width == 0 || still->profile.height == 0 ||
+          still->profile.format_fourcc == 0) {
+        statuses[i] = TrySetStillCaptureProfileStatus::InvalidArgument;
+        valid = false;
+      } else if (!is_valid_capture_still_image_bundle(still->still_image_bundle, supports_multi_image)) {
+        statuses[i] = supports_multi_image
+            ? TrySetStillCaptureProfileStatus::InvalidArgument
+            : TrySetStillCaptureProfileStatus::NotSupported;
+        valid = false;
+      }
+    } else if (const auto* start = std::get_if<SetupStartStream>(&command)) {
+      if (start->stream_id == 0) {
+        statuses[i] = TryStartStreamStatus::InvalidArgument;
+        valid = false;
+      }
+    }
+  }
+  if (!valid) {
+    return TryRunSetupBatchStatus::InvalidArgument;
+  }
+  if (commands.empty()) {
+    return TryRunSetupBatchStatus::OK;
+  }
+
+  const CaptureTemplate capture_tmpl = prov->capture_template();
+  const StreamTemplate stream_tmpl = prov->stream_template();
+  SetupBatchOutcome outcome = run_synchronous_command_(SetupBatchOutcome{},
+      [this, commands, capture_tmpl, stream_tmpl]() -> SetupBatchOutcome {
+    SetupBatchOutcome out;
+    out.status = TryRunSetupBatchStatus::OK;
+    out.statuses.assign(commands.size(), SetupCommandStatus{});
+    // A failed command fails the device or stream it targets; later commands
+    // on either are skipped, commands on other devices still run.
+    std::set<uint64_t> failed_devices;
+    std::set<uint64_t> failed_streams;
+    std::vector<uint64_t> deferred;
+    setup_batch_deferred_refreshes_ = &deferred;
+    try {
+      for (size_t i = 0; i < commands.size(); ++i) {
+        const SetupCommand& command = commands[i];
+        uint64_t device_instance_id = 0;
+        uint64_t stream_id = 0;
+        if (const auto* open = std::get_if<SetupOpenDevice>(&command)) {
+          device_instance_id = open->device_instance_id;
+        } else if (const auto* create = std::get_if<SetupCreateStream>(&command)) {
+          device_instance_id = create->device_instance_id;
+          stream_id = create->stream_id;
+        } else if (const auto* still = std::get_if<SetupSetStillCaptureProfile>(&command)) {
+          device_instance_id = still->device_instance_id;
         } else {
-          ++it;
+          stream_id = std::get<SetupStartStream>(command).stream_id;
+        }
+        if (failed_devices.count(device_instance_id) != 0 || failed_streams.count(stream_id) != 0) {
+          out.status = TryRunSetupBatchStatus::CommandFailed;
+          continue;
+        }
+        if (!run_setup_command_on_core_(command, capture_tmpl, stream_tmpl, out.statuses[i])) {
+          out.status = TryRunSetupBatchStatus::CommandFailed;
+          if (stream_id != 0) {
+            failed_streams.insert(stream_id);
+          } else {
+            failed_devices.insert(device_instance_id);
+          }
         }
       }
+    } catch (...) {
+      setup_batch_deferred_refreshes_ = nullptr;
+      throw;
     }
-    if (state_changed) {
-      request_publish_from_core_unchecked();
+    setup_batch_deferred_refreshes_ = nullptr;
+
+    std::sort(deferred.begin(), deferred.end());
+    deferred.erase(std::unique(deferred.begin(), deferred.end()), deferred.end());
+    for (uint64_t device_instance_id : deferred) {
+      (void)refresh_capture_retained_plan_state_(
+          device_instance_id,
+          /*requested_bump_access_posture_epoch=*/false);
     }
-    return TryCloseDeviceStatus::OK;
+    return out;
   });
+  if (outcome.statuses.size() == statuses.size()) {
+    statuses = std::move(outcome.statuses);
+  }
+  return outcome.status;
 } catch (...) {
-  return TryCloseDeviceStatus::Busy;
+  return TryRunSetupBatchStatus::Busy;
+}
+
+bool CoreRuntime::run_setup_command_on_core_(
+    const SetupCommand& command,
+    const CaptureTemplate& capture_tmpl,
+    const StreamTemplate& stream_tmpl,
+    SetupCommandStatus& status) {
+  if (const auto* open = std::get_if<SetupOpenDevice>(&command)) {
+    const TryOpenDeviceStatus s =
+        open_device_on_core_(open->hardware_id, open->device_instance_id, open->root_id, capture_tmpl);
+    status = s;
+    return s == TryOpenDeviceStatus::OK;
+  }
+  if (const auto* create = std::get_if<SetupCreateStream>(&command)) {
+    const TryCreateStreamStatus s = create_stream_on_core_(
+        create->stream_id,
+        create->device_instance_id,
+        create->intent,
+        create->profile_version,
+        stream_tmpl,
+        create->profile ? &*create->profile : nullptr,
+        create->picture ? &*create->picture : nullptr,
+        create->priority);
+    status = s;
+    return s == TryCreateStreamStatus::OK;
+  }
+  if (const auto* still = std::get_if<SetupSetStillCaptureProfile>(&command)) {
+    const TrySetStillCaptureProfileStatus s = set_device_still_capture_profile_on_core_(
+        still->device_instance_id, still->profile, still->still_image_bundle);
+    status = s;
+    return s == TrySetStillCaptureProfileStatus::OK;
+  }
+  const auto& start = std::get<SetupStartStream>(command);
+  const TryStartStreamStatus s = start_stream_on_core_(start.stream_id);
+  status = s;
+  return s == TryStartStreamStatus::OK;
+}
+
+void CoreRuntime::refresh_capture_retained_plan_state_or_defer_(uint64_t device_instance_id) {
+  if (setup_batch_deferred_refreshes_ != nullptr) {
+    setup_batch_deferred_refreshes_->push_back(device_instance_id);
+    return;
+  }
+  (void)refresh_capture_retained_plan_state_(
+      device_instance_id,
+      /*requested_bump_access_posture_epoch=*/false);
 }
 
 TrySetStreamPictureStatus CoreRuntime::try_set_stream_picture_config(
@@ -5643,8 +6813,16 @@ TrySetStreamPictureStatus CoreRuntime::try_set_stream_picture_config(
     return TrySetStreamPictureStatus::NotSupported;
   }
 
+  uint64_t seq = 0;
+  std::shared_ptr<void> ticket;
+  if (!queue_picture_update_(queued_stream_pictures_, stream_id, seq, ticket)) {
+    return TrySetStreamPictureStatus::Busy;
+  }
   return run_synchronous_command_(TrySetStreamPictureStatus::Busy,
-      [this, stream_id, picture]() -> TrySetStreamPictureStatus {
+      [this, stream_id, picture, seq, ticket]() -> TrySetStreamPictureStatus {
+    if (!is_newest_picture_update_(queued_stream_pictures_, stream_id, seq)) {
+      return TrySetStreamPictureStatus::OK;
+    }
     ICameraProvider* p = provider_.load(std::memory_order_acquire);
     if (!p) {
       return TrySetStreamPictureStatus::Busy;
@@ -5683,8 +6861,16 @@ TrySetCapturePictureStatus CoreRuntime::try_set_capture_picture_config(
     return TrySetCapturePictureStatus::NotSupported;
   }
 
+  uint64_t seq = 0;
+  std::shared_ptr<void> ticket;
+  if (!queue_picture_update_(queued_capture_pictures_, device_instance_id, seq, ticket)) {
+    return TrySetCapturePictureStatus::Busy;
+  }
   return run_synchronous_command_(TrySetCapturePictureStatus::Busy,
-      [this, device_instance_id, picture]() -> TrySetCapturePictureStatus {
+      [this, device_instance_id, picture, seq, ticket]() -> TrySetCapturePictureStatus {
+    if (!is_newest_picture_update_(queued_capture_pictures_, device_instance_id, seq)) {
+      return TrySetCapturePictureStatus::OK;
+    }
     ICameraProvider* p = provider_.load(std::memory_order_acquire);
     if (!p) {
       return TrySetCapturePictureStatus::Busy;
@@ -5705,6 +6891,47 @@ TrySetCapturePictureStatus CoreRuntime::try_set_capture_picture_config(
   return TrySetCapturePictureStatus::Busy;
 }
 
+bool CoreRuntime::queue_picture_update_(
+    std::map<uint64_t, QueuedPictureUpdates>& lane,
+    uint64_t key,
+    uint64_t& out_seq,
+    std::shared_ptr<void>& out_ticket) noexcept {
+  try {
+    {
+      std::lock_guard<std::mutex> lock(picture_update_mutex_);
+      QueuedPictureUpdates& queued = lane[key];
+      out_seq = ++picture_update_seq_;
+      queued.newest_seq = out_seq;
+      ++queued.queued;
+    }
+    // The deleter runs with the last copy of the command, or at once if the
+    // control block cannot be allocated.
+    out_ticket = std::shared_ptr<void>(nullptr, [this, &lane, key](void*) {
+      std::lock_guard<std::mutex> lock(picture_update_mutex_);
+      const auto it = lane.find(key);
+      if (it != lane.end() && --it->second.queued == 0) {
+        lane.erase(it);
+      }
+    });
+    return true;
+  } catch (...) {
+    return false;
+  }
+}
+
+bool CoreRuntime::is_newest_picture_update_(
+    const std::map<uint64_t, QueuedPictureUpdates>& lane,
+    uint64_t key,
+    uint64_t seq) noexcept {
+  std::lock_guard<std::mutex> lock(picture_update_mutex_);
+  const auto it = lane.find(key);
+  if (it == lane.end() || it->second.newest_seq == seq) {
+    return true;
+  }
+  picture_updates_coalesced_.fetch_add(1, std::memory_order_relaxed);
+  return false;
+}
+
 TrySetStillCaptureProfileStatus CoreRuntime::try_set_device_still_capture_profile(
     uint64_t device_instance_id,
     const CaptureProfile& profile,
@@ -5726,49 +6953,54 @@ TrySetStillCaptureProfileStatus CoreRuntime::try_set_device_still_capture_profil
 
   return run_synchronous_command_(TrySetStillCaptureProfileStatus::Busy,
       [this, device_instance_id, profile, still_image_bundle]() -> TrySetStillCaptureProfileStatus {
-    uint64_t next_version = 1;
-    if (const auto* rec = devices_.find(device_instance_id)) {
-      bool same_sequence = (rec->capture_still_image_bundle.members.size() == still_image_bundle.members.size());
-      if (same_sequence) {
-        for (size_t i = 0; i < rec->capture_still_image_bundle.members.size(); ++i) {
-          const auto& a = rec->capture_still_image_bundle.members[i];
-          const auto& b = still_image_bundle.members[i];
-          if (a.image_member_index != b.image_member_index ||
-              a.role != b.role ||
-              a.intended_exposure_compensation_milli_ev != b.intended_exposure_compensation_milli_ev) {
-            same_sequence = false;
-            break;
-          }
-        }
-      }
-      const bool unchanged =
-          rec->capture_width == profile.width &&
-          rec->capture_height == profile.height &&
-          rec->capture_format == profile.format_fourcc &&
-          same_sequence;
-      if (unchanged) {
-        return TrySetStillCaptureProfileStatus::OK;
-      }
-      next_version = rec->capture_profile_version + 1;
-      if (next_version == 0) next_version = 1;
-    }
-    (void)devices_.retain_capture_profile(
-        device_instance_id,
-        profile.width,
-        profile.height,
-        profile.format_fourcc,
-        next_version);
-    (void)devices_.set_capture_still_image_bundle(device_instance_id, still_image_bundle, next_version);
-    (void)refresh_capture_retained_plan_state_(
-        device_instance_id,
-        /*requested_bump_access_posture_epoch=*/false);
-    request_publish_from_core_unchecked();
-    return TrySetStillCaptureProfileStatus::OK;
+    return set_device_still_capture_profile_on_core_(device_instance_id, profile, still_image_bundle);
   });
 } catch (...) {
   return TrySetStillCaptureProfileStatus::Busy;
 }
 
+TrySetStillCaptureProfileStatus CoreRuntime::set_device_still_capture_profile_on_core_(
+    uint64_t device_instance_id,
+    const CaptureProfile& profile,
+    const CaptureStillImageBundle& still_image_bundle) {
+  uint64_t next_version = 1;
+  if (const auto* rec = devices_.find(device_instance_id)) {
+    bool same_sequence = (rec->capture_still_image_bundle.members.size() == still_image_bundle.members.size());
+    if (same_sequence) {
+      for (size_t i = 0; i < rec->capture_still_image_bundle.members.size(); ++i) {
+        const auto& a = rec->capture_still_image_bundle.members[i];
+        const auto& b = still_image_bundle.members[i];
+        if (a.image_member_index != b.image_member_index ||
+            a.role != b.role ||
+            a.intended_exposure_compensation_milli_ev != b.intended_exposure_compensation_milli_ev) {
+          same_sequence = false;
+          break;
+        }
+      }
+    }
+    const bool unchanged =
+        rec->capture_width == profile.width &&
+        rec->capture_height == profile.height &&
+        rec->capture_format == profile.format_fourcc &&
+        same_sequence;
+    if (unchanged) {
+      return TrySetStillCaptureProfileStatus::OK;
+    }
+    next_version = rec->capture_profile_version + 1;
+    if (next_version == 0) next_version = 1;
+  }
+  (void)devices_.retain_capture_profile(
+      device_instance_id,
+      profile.width,
+      profile.height,
+      profile.format_fourcc,
+      next_version);
+  (void)devices_.set_capture_still_image_bundle(device_instance_id, still_image_bundle, next_version);
+  refresh_capture_retained_plan_state_or_defer_(device_instance_id);
+  request_publish_from_core_unchecked();
+  return TrySetStillCaptureProfileStatus::OK;
+}
+
 TrySetWarmHoldStatus CoreRuntime::try_set_device_warm_hold_ms(
     uint64_t device_instance_id,
     uint32_t warm_hold_ms) noexcept try {
@@ -5789,6 +7021,169 @@ TrySetWarmHoldStatus CoreRuntime::try_set_device_warm_hold_ms(
   return TrySetWarmHoldStatus::Busy;
 }
 
+TrySetWarmHoldStatus CoreRuntime::try_set_warm_pool_budget(const CoreWarmPool::Budget& budget) noexcept try {
+  return run_synchronous_command_(TrySetWarmHoldStatus::Busy,
+      [this, budget]() -> TrySetWarmHoldStatus {
+    warm_pool_.set_budget(budget);
+    // Re-plan the open idle devices against the new budget.
+    core_thread_.request_timer_tick();
+    return TrySetWarmHoldStatus::OK;
+  });
+} catch (...) {
+  return TrySetWarmHoldStatus::Busy;
+}
+
+bool CoreRuntime::reset_capture_latency_histograms() noexcept try {
+  return run_synchronous_command_(false, [this]() {
+    capture_latency_stats_.clear();
+    request_publish_from_core_unchecked();
+    return true;
+  });
+} catch (...) {
+  return false;
+}
+
+size_t CoreRuntime::evict_capture_results_over_budget_(uint64_t byte_budget) {
+  auto evicted_results = result_store_.evict_over_byte_budget(byte_budget);
+  // A successful result the spill tier keeps stays reachable, so its
+  // assembly stays too; the rest are gone as before.
+  for (auto& evicted : evicted_results) {
+    const bool spilled =
+        capture_assembly_registry_.is_assembly_successful(evicted.capture_id, evicted.device_instance_id) &&
+        capture_spill_store_.spill(std::move(evicted.result));
+    if (!spilled) {
+      capture_assembly_registry_.remove_assembly(evicted.capture_id, evicted.device_instance_id);
+    }
+  }
+  return evicted_results.size();
+}
+
+void CoreRuntime::run_stream_qos_(uint64_t now_ns) {
+  ICameraProvider* prov = provider_.load(std::memory_order_acquire);
+  const uint64_t changes_before = stream_qos_.level_changes();
+  uint8_t level = 0;
+  if (stream_qos_enabled_.load(std::memory_order_acquire)) {
+    CoreStreamQosController::LoadCounters load{};
+    load.ingress_frames_dropped = ingress_.stats_copy().frames_dropped_full;
+    load.producer_frames_dropped = prov ? prov->producer_frames_dropped_total() : 0;
+    // Top-level task kinds only: frame dispatch and snapshot builds run
+    // inside a timer tick and are already in its time.
+    const CoreTaskTimingStats timing = core_thread_.task_timing_copy();
+    for (CoreTaskKind kind : {CoreTaskKind::ESSENTIAL, CoreTaskKind::COMMAND,
+                              CoreTaskKind::ORDINARY, CoreTaskKind::TIMER_TICK}) {
+      load.core_busy_ns += timing.exec[static_cast<size_t>(kind)].total_ns;
+    }
+    level = stream_qos_.sample(now_ns, load);
+  } else {
+    stream_qos_.reset();
+  }
+  stream_qos_level_.store(level, std::memory_order_relaxed);
+  bool changed = stream_qos_.level_changes() != changes_before;
+  if (changed) {
+    stream_qos_level_changes_.fetch_add(stream_qos_.level_changes() - changes_before,
+                                        std::memory_order_relaxed);
+  }
+
+  if (prov) {
+    // Reconfiguration does not add or remove records, but collect first so
+    // the walk does not depend on that.
+    std::vector<uint64_t> pending;
+    for (const auto& [stream_id, rec] : streams_.all()) {
+      if (!rec.created || rec.qos_level == level || rec.qos_attempted_level == level) {
+        continue;
+      }
+      // Only flowing streams are lowered; any stream is restored.
+      if (level > rec.qos_level && !rec.started) {
+        continue;
+      }
+      pending.push_back(stream_id);
+    }
+    for (uint64_t stream_id : pending) {
+      const CoreStreamRegistry::StreamRecord* rec = streams_.find(stream_id);
+      if (!rec) {
+        continue;
+      }
+      const uint8_t from_level = rec->qos_level;
+      const CaptureProfile baseline = from_level == 0 ? rec->profile : rec->qos_baseline_profile;
+      const TryReconfigureStreamStatus status =
+          reconfigure_stream_on_core_(stream_id, stream_qos_profile(baseline, level));
+      const bool applied = status == TryReconfigureStreamStatus::OK;
+      // A refused level is remembered and not retried until the level moves.
+      (void)streams_.set_qos_state(stream_id, applied ? level : from_level, level, baseline);
+      if (applied) {
+        stream_qos_reconfigurations_.fetch_add(1, std::memory_order_relaxed);
+        changed = true;
+      }
+    }
+  }
+
+  if (changed) {
+    request_publish_from_core_unchecked();
+  }
+}
+
+uint64_t CoreRuntime::trim_memory(MemoryTrimLevel level) noexcept try {
+  return run_synchronous_command_(uint64_t{0}, [this, level]() {
+    uint64_t released = cpu_payload_buffer_pool_.trim();
+
+    result_store_.mark_capture_results_evictable(
+        capture_assembly_registry_.take_newly_terminal_capture_device_pairs());
+    const uint64_t floor_bytes =
+        (level == MemoryTrimLevel::Critical) ? 0 : kCaptureResultTrimModerateFloorBytes;
+    const uint64_t retained_before = result_store_.total_estimated_capture_bytes();
+    if (retained_before > floor_bytes && evict_capture_results_over_budget_(floor_bytes) > 0) {
+      const uint64_t retained_after = result_store_.total_estimated_capture_bytes();
+      released += (retained_before > retained_after) ? retained_before - retained_after : 0;
+      request_publish_from_core_unchecked();
+    }
+
+    if (ICameraProvider* prov = provider_.load(std::memory_order_acquire)) {
+      released += prov->trim_memory(level);
+    }
+    memory_trims_.fetch_add(1, std::memory_order_relaxed);
+    memory_trim_bytes_released_.fetch_add(released, std::memory_order_relaxed);
+    return released;
+  });
+} catch (...) {
+  return 0;
+}
+
+TryPrewarmRigStatus CoreRuntime::try_prewarm_rig(uint64_t rig_id, uint32_t hold_ms) noexcept try {
+  if (rig_id == 0 || hold_ms == 0) {
+    return TryPrewarmRigStatus::InvalidArgument;
+  }
+  return run_synchronous_command_(TryPrewarmRigStatus::Busy,
+      [this, rig_id, hold_ms]() -> TryPrewarmRigStatus {
+    const CoreRigRegistry::RigRecord* rig = rigs_.find(rig_id);
+    if (rig == nullptr) {
+      return TryPrewarmRigStatus::RigNotFound;
+    }
+    std::vector<uint64_t> members;
+    members.reserve(rig->member_hardware_keys.size());
+    for (const CoreStringId hardware_key : rig->member_hardware_keys) {
+      uint64_t resolved = 0;
+      for (const auto& [device_instance_id, rec] : devices_.all()) {
+        if (rec.open && rec.hardware_key == hardware_key) {
+          resolved = device_instance_id;
+          break;
+        }
+      }
+      if (resolved == 0) {
+        return TryPrewarmRigStatus::MemberNotOpen;
+      }
+      members.push_back(resolved);
+    }
+    const uint64_t until_ns = ns_since_epoch_() + static_cast<uint64_t>(hold_ms) * kNsPerMs;
+    for (const uint64_t device_instance_id : members) {
+      warm_pool_.prewarm(device_instance_id, until_ns);
+    }
+    core_thread_.request_timer_tick();
+    return TryPrewarmRigStatus::OK;
+  });
+} catch (...) {
+  return TryPrewarmRigStatus::Busy;
+}
+
 bool CoreRuntime::materialize_capture_request_for_server(uint64_t device_instance_id, CaptureRequest& out) const {
   out = CaptureRequest{};
   if (device_instance_id == 0) {
@@ -5905,6 +7300,7 @@ TryTriggerDeviceCaptureStatus CoreRuntime::trigger_device_capture_with_capture_i
   if (device_instance_id == 0 || capture_id == 0) {
     return TryTriggerDeviceCaptureStatus::InvalidArgument;
   }
+  const uint64_t triggered_steady_ns = CoreThread::steady_now_ns();
 
   (void)integrate_pending_provider_facts_before_capture_request_();
 
@@ -5951,6 +7347,8 @@ TryTriggerDeviceCaptureStatus CoreRuntime::trigger_device_capture_with_capture_i
   if (!pr.ok()) {
     return TryTriggerDeviceCaptureStatus::ProviderRejected;
   }
+  note_capture_trigger_timing_(
+      capture_id, device_instance_id, 0, triggered_steady_ns, CoreThread::steady_now_ns());
   capture_assembly_registry_.record_admission_context(
       capture_id, device_instance_id, req.admission_context, req.still_image_bundle,
       ns_since_epoch_());
@@ -5979,6 +7377,130 @@ TryTriggerDeviceCaptureStatus CoreRuntime::try_trigger_device_capture_with_captu
   return TryTriggerDeviceCaptureStatus::Busy;
 }
 
+CoreOperation CoreRuntime::trigger_device_capture_async_for_server(
+    uint64_t device_instance_id,
+    uint64_t capture_id,
+    TryTriggerDeviceCaptureStatus* out_status) noexcept {
+  if (device_instance_id == 0 || capture_id == 0) {
+    if (out_status) {
+      *out_status = TryTriggerDeviceCaptureStatus::InvalidArgument;
+    }
+    CoreOperation op = CoreOperation::make_pending();
+    (void)op.resolve(CoreOperationOutcome::Failed);
+    return op;
+  }
+  return run_async_command_(TryTriggerDeviceCaptureStatus::Busy, out_status,
+      [this, device_instance_id, capture_id]() {
+        return trigger_device_capture_with_capture_id_(device_instance_id, capture_id);
+      },
+      [this, capture_id](const CoreOperation& op) {
+        operations_.add(CoreOperationRegistry::Kind::Capture, capture_id, op);
+      });
+}
+
+TryTriggerDeviceCaptureStatus CoreRuntime::trigger_device_capture_from_stream_history_(
+    uint64_t device_instance_id,
+    uint64_t capture_id,
+    uint64_t stream_id,
+    const ImageAcquisitionTiming& reference) {
+  assert(core_thread_.is_core_thread());
+
+  if (device_instance_id == 0 || capture_id == 0 || stream_id == 0) {
+    return TryTriggerDeviceCaptureStatus::InvalidArgument;
+  }
+  const CoreStreamRegistry::StreamRecord* stream = streams_.find(stream_id);
+  if (!stream || stream->device_instance_id != device_instance_id) {
+    return TryTriggerDeviceCaptureStatus::InvalidArgument;
+  }
+
+  (void)integrate_pending_provider_facts_before_capture_request_();
+
+  const SharedStreamResultData source = result_store_.find_stream_history_result(stream_id, reference);
+  if (!source) {
+    return TryTriggerDeviceCaptureStatus::Unavailable;
+  }
+  CaptureRequest req{};
+  if (!materialize_capture_request_(device_instance_id, req)) {
+    return TryTriggerDeviceCaptureStatus::Busy;
+  }
+  if (!req.requested_retained_plan.valid || !req.requested_retained_plan.primary_cpu()) {
+    return TryTriggerDeviceCaptureStatus::Unavailable;
+  }
+
+  (void)devices_.set_requested_retained_plan(
+      device_instance_id,
+      req.requested_retained_plan,
+      /*bump_capture_access_posture_epoch=*/false);
+  capture_assembly_registry_.record_admission_context(
+      capture_id, device_instance_id, make_capture_admission_context_(), req.still_image_bundle,
+      ns_since_epoch_());
+  ingest_stream_result_as_capture_(*source, capture_id, device_instance_id, req.requested_retained_plan);
+  return TryTriggerDeviceCaptureStatus::OK;
+}
+
+void CoreRuntime::ingest_stream_result_as_capture_(
+    const CoreStreamResultData& source,
+    uint64_t capture_id,
+    uint64_t device_instance_id,
+    const CoreRetainedProductionPlan& requested_retained_plan) {
+  assert(core_thread_.is_core_thread());
+
+  // A view of the kept frame whose owner is the result's own shared payload
+  // storage, so retention adopts it without a copy. A payload in per-result
+  // storage is copied once here instead.
+  const CoreResultPayloadCpuPacked& payload = source.payload;
+  std::shared_ptr<const CpuPayloadBytes> owner = payload.retained_bytes;
+  if (!owner) {
+    owner = std::make_shared<const CpuPayloadBytes>(payload.bytes);
+  }
+  FrameView frame{};
+  frame.device_instance_id = device_instance_id;
+  frame.capture_id = capture_id;
+  frame.width = payload.width;
+  frame.height = payload.height;
+  frame.format_fourcc = payload.format_fourcc;
+  frame.primary_backing_kind = ProducerBackingKind::CPU;
+  frame.acquisition_timing = source.image_facts.acquisition_timing;
+  frame.data = owner->data();
+  frame.size_bytes = owner->size();
+  frame.stride_bytes = payload.stride_bytes;
+  frame.plane_count = payload.plane_count;
+  for (uint32_t i = 0; i < payload.plane_count; ++i) {
+    const size_t end = i + 1 < payload.plane_count ? payload.planes[i + 1].offset_bytes : owner->size();
+    frame.planes[i].data = owner->data() + payload.planes[i].offset_bytes;
+    frame.planes[i].size_bytes = end - payload.planes[i].offset_bytes;
+    frame.planes[i].row_stride_bytes = payload.planes[i].row_stride_bytes;
+  }
+  frame.cpu_payload_owner = std::move(owner);
+  frame.requested_retained_plan = requested_retained_plan;
+  frame.trace_id = source.trace_id;
+
+  ingress_.on_capture_started(capture_id, device_instance_id);
+  ingress_.on_frame(frame);
+  ingress_.on_capture_completed(capture_id, device_instance_id);
+}
+
+TryTriggerDeviceCaptureStatus CoreRuntime::try_trigger_device_capture_from_stream_history_for_server(
+    uint64_t device_instance_id,
+    uint64_t capture_id,
+    uint64_t stream_id,
+    const ImageAcquisitionTiming& reference) noexcept try {
+  if (device_instance_id == 0 || capture_id == 0 || stream_id == 0) {
+    return TryTriggerDeviceCaptureStatus::InvalidArgument;
+  }
+
+  if (core_thread_.is_core_thread()) {
+    return trigger_device_capture_from_stream_history_(device_instance_id, capture_id, stream_id, reference);
+  }
+
+  return run_synchronous_command_(TryTriggerDeviceCaptureStatus::Busy,
+      [this, device_instance_id, capture_id, stream_id, reference]() {
+    return trigger_device_capture_from_stream_history_(device_instance_id, capture_id, stream_id, reference);
+  });
+} catch (...) {
+  return TryTriggerDeviceCaptureStatus::Busy;
+}
+
 CoreRuntime::RigPreflightResult CoreRuntime::preflight_rig_participants_materialize_(uint64_t rig_id) const {
   assert(core_thread_.is_core_thread());
 
@@ -6000,10 +7522,11 @@ CoreRuntime::RigPreflightResult CoreRuntime::preflight_rig_participants_material
 
   for (size_t i = 0; i < rig->member_hardware_ids.size(); ++i) {
     const std::string& hardware_id = rig->member_hardware_ids[i];
+    const CoreStringId hardware_key = rig->member_hardware_keys[i];
     uint64_t resolved_device_id = 0;
     size_t matches = 0;
     for (const auto& [device_instance_id, rec] : devices_.all()) {
-      if (rec.hardware_id == hardware_id && rec.open) {
+      if (rec.hardware_key == hardware_key && rec.open) {
         ++matches;
         resolved_device_id = device_instance_id;
       }
@@ -6126,7 +7649,7 @@ CoreRuntime::grouped_rig_imaging_spec_admission_failure_(
     return RigCohortAdmissionFailure::None;
   }
 
-  const CoreSpecState::ImagingSpecInterpretation imaging_spec =
+  const CoreSpecState::ImagingSpecInterpretation& imaging_spec =
       spec_state_.interpret_imaging_spec();
   switch (imaging_spec.camera_concurrency.kind) {
     case camera_concurrency::TruthKind::Unavailable:
@@ -6137,14 +7660,15 @@ CoreRuntime::grouped_rig_imaging_spec_admission_failure_(
       break;
   }
 
-  std::vector<std::string> requested_camera_ids;
-  requested_camera_ids.reserve(preflight.participants.size());
+  std::vector<CoreStringId> requested_camera_keys;
+  requested_camera_keys.reserve(preflight.participants.size());
+  const CoreStringInterner& hardware_ids = global_hardware_id_interner();
   for (const auto& participant : preflight.participants) {
-    requested_camera_ids.push_back(participant.hardware_id);
+    requested_camera_keys.push_back(hardware_ids.find(participant.hardware_id));
   }
-  if (camera_concurrency::requested_camera_id_set_is_allowed(
+  if (camera_concurrency::requested_camera_key_set_is_allowed(
           imaging_spec.camera_concurrency,
-          requested_camera_ids)) {
+          requested_camera_keys)) {
     return RigCohortAdmissionFailure::None;
   }
   return RigCohortAdmissionFailure::ImagingSpecRejected;
@@ -6243,7 +7767,8 @@ CoreRuntime::RigSubmissionResult CoreRuntime::submit_admitted_rig_bundle_(
 CoreRuntime::RigTriggerOrchestrationResult CoreRuntime::orchestrate_rig_capture_from_preflight_(
     uint64_t rig_id,
     uint64_t capture_id,
-    const RigPreflightResult& preflight) {
+    const RigPreflightResult& preflight,
+    uint64_t triggered_steady_ns) {
   assert(core_thread_.is_core_thread());
 
   if (!preflight.ok) {
@@ -6265,6 +7790,11 @@ CoreRuntime::RigTriggerOrchestrationResult CoreRuntime::orchestrate_rig_capture_
   if (!submitted.ok) {
     return make_rig_orchestration_submission_failure(submitted);
   }
+  const uint64_t admitted_steady_ns = CoreThread::steady_now_ns();
+  for (const auto& participant : admitted.participants) {
+    note_capture_trigger_timing_(capture_id, participant.request.device_instance_id, rig_id,
+                                 triggered_steady_ns, admitted_steady_ns);
+  }
 
   return make_rig_orchestration_success(
       rig_id, capture_id, submitted.submitted_count);
@@ -6275,8 +7805,65 @@ CoreRuntime::RigTriggerOrchestrationResult CoreRuntime::orchestrate_rig_capture_
     uint64_t capture_id) {
   assert(core_thread_.is_core_thread());
 
+  const uint64_t triggered_steady_ns = CoreThread::steady_now_ns();
   const RigPreflightResult preflight = preflight_rig_participants_materialize_(rig_id);
-  return orchestrate_rig_capture_from_preflight_(rig_id, capture_id, preflight);
+  return orchestrate_rig_capture_from_preflight_(rig_id, capture_id, preflight, triggered_steady_ns);
+}
+
+CoreRuntime::RigTriggerOrchestrationResult CoreRuntime::orchestrate_rig_capture_from_stream_frame_set_(
+    uint64_t rig_id,
+    uint64_t capture_id) {
+  assert(core_thread_.is_core_thread());
+
+  const uint64_t triggered_steady_ns = CoreThread::steady_now_ns();
+  (void)integrate_pending_provider_facts_before_capture_request_();
+  const RigPreflightResult preflight = preflight_rig_participants_materialize_(rig_id);
+  if (!preflight.ok) {
+    return make_rig_orchestration_preflight_failure(rig_id, capture_id, preflight.failure);
+  }
+  if (capture_id == 0) {
+    return make_rig_orchestration_invalid_capture_id(rig_id, capture_id);
+  }
+
+  // Resolved before admission, so a rig whose frames are not usable leaves
+  // no cohort behind. Set members are in member_hardware_ids order, as are
+  // the preflight participants.
+  const SharedRigStreamFrameSet set = rig_stream_frame_sets_.find_latest(rig_id);
+  bool set_usable = set && set->members.size() == preflight.participants.size();
+  for (size_t i = 0; set_usable && i < preflight.participants.size(); ++i) {
+    const RigPreflightParticipant& participant = preflight.participants[i];
+    const SharedStreamResultData& member = set->members[i];
+    set_usable = member && member->device_instance_id == participant.device_instance_id &&
+                 CoreResultStore::is_stream_history_eligible(*member) &&
+                 participant.request.requested_retained_plan.valid &&
+                 participant.request.requested_retained_plan.primary_cpu();
+  }
+  if (!set_usable) {
+    RigSubmissionResult unavailable = make_rig_submission_failure(
+        rig_id, capture_id, RigSubmissionFailure::FrameSetUnavailable);
+    return make_rig_orchestration_submission_failure(unavailable);
+  }
+
+  const RigAdmittedRequestBundle admitted = admit_rig_cohort_from_preflight_(rig_id, capture_id, preflight);
+  if (!admitted.ok) {
+    return make_rig_orchestration_admission_failure(rig_id, capture_id, admitted.failure);
+  }
+  (void)capture_cohort_registry_.set_acquisition_skew_ns(capture_id, set->skew_ns);
+
+  const uint64_t admitted_steady_ns = CoreThread::steady_now_ns();
+  for (size_t i = 0; i < admitted.participants.size(); ++i) {
+    const CaptureRequest& req = admitted.participants[i].request;
+    (void)devices_.set_requested_retained_plan(
+        req.device_instance_id,
+        req.requested_retained_plan,
+        /*bump_capture_access_posture_epoch=*/false);
+    note_capture_trigger_timing_(capture_id, req.device_instance_id, rig_id,
+                                 triggered_steady_ns, admitted_steady_ns);
+    ingest_stream_result_as_capture_(*set->members[i], capture_id, req.device_instance_id,
+                                     req.requested_retained_plan);
+  }
+
+  return make_rig_orchestration_success(rig_id, capture_id, admitted.participants.size());
 }
 
 #if defined(CAMBANG_INTERNAL_SMOKE)
@@ -6340,14 +7927,16 @@ CoreRuntime::RigTriggerOrchestrationResult CoreRuntime::smoke_orchestrate_rig_ca
     uint64_t capture_id,
     const RigPreflightResult& preflight) {
   if (core_thread_.is_core_thread()) {
-    return orchestrate_rig_capture_from_preflight_(rig_id, capture_id, preflight);
+    return orchestrate_rig_capture_from_preflight_(
+        rig_id, capture_id, preflight, CoreThread::steady_now_ns());
   }
 
   RigTriggerOrchestrationResult fallback = make_rig_orchestration_preflight_failure(
       rig_id, capture_id, RigPreflightFailure::RigNotFound);
   return run_synchronous_command_(fallback,
       [this, rig_id, capture_id, preflight]() {
-    return orchestrate_rig_capture_from_preflight_(rig_id, capture_id, preflight);
+    return orchestrate_rig_capture_from_preflight_(
+        rig_id, capture_id, preflight, CoreThread::steady_now_ns());
   });
 }
 
@@ -6399,6 +7988,30 @@ CoreRuntime::RigTriggerOrchestrationResult CoreRuntime::orchestrate_rig_capture_
           static_cast<uint32_t>(ProviderError::ERR_BAD_STATE)));
 }
 
+CoreRuntime::RigTriggerOrchestrationResult CoreRuntime::orchestrate_rig_capture_from_stream_frame_set_for_server(
+    uint64_t rig_id,
+    uint64_t capture_id) noexcept try {
+  if (core_thread_.is_core_thread()) {
+    return orchestrate_rig_capture_from_stream_frame_set_(rig_id, capture_id);
+  }
+
+  RigTriggerOrchestrationResult fallback =
+      make_rig_orchestration_submission_failure(
+          make_rig_submission_provider_unavailable(
+              rig_id,
+              capture_id,
+              static_cast<uint32_t>(ProviderError::ERR_BAD_STATE)));
+  return run_synchronous_command_(fallback, [this, rig_id, capture_id]() {
+    return orchestrate_rig_capture_from_stream_frame_set_(rig_id, capture_id);
+  });
+} catch (...) {
+  return make_rig_orchestration_submission_failure(
+      make_rig_submission_provider_unavailable(
+          rig_id,
+          capture_id,
+          static_cast<uint32_t>(ProviderError::ERR_BAD_STATE)));
+}
+
 bool CoreRuntime::retain_rig_member_hardware_ids(
     uint64_t rig_id,
     const std::vector<std::string>& member_hardware_ids) noexcept try {
@@ -6426,7 +8039,7 @@ bool CoreRuntime::create_rig_from_hardware_ids(
     // does not authorize this exact combination, forms no rig. This mirrors the
     // trigger-time gate in grouped_rig_imaging_spec_admission_failure_ so a rig
     // that create_rig admits will also pass rig-capture admission.
-    const CoreSpecState::ImagingSpecInterpretation imaging_spec =
+    const CoreSpecState::ImagingSpecInterpretation& imaging_spec =
         spec_state_.interpret_imaging_spec();
     if (imaging_spec.camera_concurrency.kind !=
         camera_concurrency::TruthKind::Supported) {
@@ -6449,6 +8062,12 @@ bool CoreRuntime::create_rig_from_hardware_ids(
 CoreRuntime::IngestCameraConcurrencyResult
 CoreRuntime::ingest_camera_concurrency_json_for_server(
     const std::string& json_text) {
+  return ingest_camera_concurrency_text_(json_text);
+}
+
+CoreRuntime::IngestCameraConcurrencyResult
+CoreRuntime::ingest_camera_concurrency_json_file_for_server(
+    const std::string& path) {
   const CoreRuntimeState state = state_.load(std::memory_order_acquire);
   if (state == CoreRuntimeState::LIVE ||
       state == CoreRuntimeState::TEARING_DOWN) {
@@ -6456,8 +8075,27 @@ CoreRuntime::ingest_camera_concurrency_json_for_server(
     out.status = IngestCameraConcurrencyStatus::Busy;
     return out;
   }
+  CBMappedFile file;
+  if (!file.open(path)) {
+    IngestCameraConcurrencyResult out{};
+    out.status = IngestCameraConcurrencyStatus::IoError;
+    out.error_message = "cannot map file: " + path;
+    return out;
+  }
+  return ingest_camera_concurrency_text_(file.text());
+}
 
-  const camera_concurrency::LoadResult load =
+CoreRuntime::IngestCameraConcurrencyResult
+CoreRuntime::ingest_camera_concurrency_text_(std::string_view json_text) {
+  const CoreRuntimeState state = state_.load(std::memory_order_acquire);
+  if (state == CoreRuntimeState::LIVE ||
+      state == CoreRuntimeState::TEARING_DOWN) {
+    IngestCameraConcurrencyResult out{};
+    out.status = IngestCameraConcurrencyStatus::Busy;
+    return out;
+  }
+
+  camera_concurrency::LoadResult load =
       camera_concurrency::load_truth_from_adc_json_text(json_text);
   if (!load.ok) {
     IngestCameraConcurrencyResult out{};
@@ -6468,6 +8106,11 @@ CoreRuntime::ingest_camera_concurrency_json_for_server(
     return out;
   }
 
+  // The retained payload is copied out before taking the lock, so a mapped
+  // file is released without holding it.
+  std::vector<uint8_t> payload(
+      reinterpret_cast<const uint8_t*>(json_text.data()),
+      reinterpret_cast<const uint8_t*>(json_text.data()) + json_text.size());
   IngestCameraConcurrencyResult out{};
   out.status = IngestCameraConcurrencyStatus::Ok;
   {
@@ -6475,9 +8118,8 @@ CoreRuntime::ingest_camera_concurrency_json_for_server(
     configured_imaging_spec_version_ = next_configured_imaging_spec_version_++;
     configured_external_camera_description_.reset();
     configured_camera_description_version_ = 0;
-    configured_imaging_spec_payload_.assign(
-        reinterpret_cast<const uint8_t*>(json_text.data()),
-        reinterpret_cast<const uint8_t*>(json_text.data()) + json_text.size());
+    configured_imaging_spec_payload_.swap(payload);
+    configured_imaging_spec_concurrency_ = std::move(load.truth);
     out.imaging_spec_version = configured_imaging_spec_version_;
   }
   return out;
@@ -6486,12 +8128,33 @@ CoreRuntime::ingest_camera_concurrency_json_for_server(
 CoreRuntime::ReplaceExternalCameraDescriptionResult
 CoreRuntime::replace_external_camera_description_json_for_internal(
     const std::string& json_text) {
+  return replace_external_camera_description_text_(json_text);
+}
+
+CoreRuntime::ReplaceExternalCameraDescriptionResult
+CoreRuntime::replace_external_camera_description_json_file_for_internal(
+    const std::string& path) {
   const CoreRuntimeState state = state_.load(std::memory_order_acquire);
   if (state == CoreRuntimeState::LIVE || state == CoreRuntimeState::TEARING_DOWN) {
     return ReplaceExternalCameraDescriptionResult{
         ReplaceExternalCameraDescriptionStatus::Busy, {}, 0, 0};
   }
-  const adc_camera_description::LoadResult load =
+  CBMappedFile file;
+  if (!file.open(path)) {
+    return ReplaceExternalCameraDescriptionResult{
+        ReplaceExternalCameraDescriptionStatus::IoError, "cannot map file: " + path, 0, 0};
+  }
+  return replace_external_camera_description_text_(file.text());
+}
+
+CoreRuntime::ReplaceExternalCameraDescriptionResult
+CoreRuntime::replace_external_camera_description_text_(std::string_view json_text) {
+  const CoreRuntimeState state = state_.load(std::memory_order_acquire);
+  if (state == CoreRuntimeState::LIVE || state == CoreRuntimeState::TEARING_DOWN) {
+    return ReplaceExternalCameraDescriptionResult{
+        ReplaceExternalCameraDescriptionStatus::Busy, {}, 0, 0};
+  }
+  adc_camera_description::LoadResult load =
       adc_camera_description::load_replacement_from_json_text(json_text);
   if (!load.ok) {
     return ReplaceExternalCameraDescriptionResult{
@@ -6502,15 +8165,19 @@ CoreRuntime::replace_external_camera_description_json_for_internal(
         0,
         0};
   }
+  // Built once here; every later generation shares it (see start()).
+  const bool has_concurrency = load.state.concurrency().has_value();
+  auto publication = std::make_shared<ExternalCameraDescriptionPublication>();
+  publication->state = std::move(load.state);
   ReplaceExternalCameraDescriptionResult out{};
   {
     const std::lock_guard<std::mutex> lock(configured_imaging_spec_mutex_);
     configured_camera_description_version_ = next_configured_camera_description_version_++;
-    configured_imaging_spec_version_ = load.state.concurrency().has_value()
-        ? next_configured_imaging_spec_version_++
-        : 0;
+    configured_imaging_spec_version_ = has_concurrency ? next_configured_imaging_spec_version_++ : 0;
     configured_imaging_spec_payload_.clear();
-    configured_external_camera_description_ = load.state;
+    configured_imaging_spec_concurrency_ = {};
+    publication->version = configured_camera_description_version_;
+    configured_external_camera_description_ = std::move(publication);
     out.camera_description_version = configured_camera_description_version_;
     out.imaging_spec_version = configured_imaging_spec_version_;
   }
@@ -6531,6 +8198,49 @@ void CoreRuntime::release_stream_display_demand_async(uint64_t stream_id) {
   account_display_demand_release_async_post_failure_(pr);
 }
 
+void CoreRuntime::post_stream_pool_depth_hint_refresh_(uint64_t stream_id) noexcept try {
+  if (stream_id == 0) {
+    return;
+  }
+  // Advisory: a hint lost to a full or closed queue is superseded by the
+  // next retention change, and a provider without one keeps its own sizing.
+  (void)core_thread_.try_post([this, stream_id]() { refresh_stream_pool_depth_hint_(stream_id); });
+} catch (...) {
+}
+
+void CoreRuntime::refresh_stream_pool_depth_hint_(uint64_t stream_id) {
+  const CoreStreamRegistry::StreamRecord* rec = streams_.find(stream_id);
+  ICameraProvider* prov = provider_.load(std::memory_order_acquire);
+  if (!rec || !rec->created || !prov) {
+    stream_pool_depth_hints_.erase(stream_id);
+    return;
+  }
+  StreamPoolDepthHint hint{};
+  // The frame being dispatched, the stream's latest-wins parking and, with
+  // retention sharded, a full shard queue ahead of it.
+  hint.in_flight_frames = 1u + kLiveFramesQueuedPerStream;
+  if (frame_shards_.running()) {
+    hint.in_flight_frames += static_cast<uint32_t>(CoreFrameShards::kMaxQueuedFramesPerShard);
+  }
+  // The latest result, the history ring (jitter window included) and, while
+  // recording, as much of the recorder queue as one stream can fill.
+  size_t retained = 1 + result_store_.stream_history_max_frames(stream_id);
+  if (stream_recorder_.recording(stream_id)) {
+    retained += CoreStreamRecorder::kMaxQueuedFrames;
+  }
+  hint.retained_frames = static_cast<uint32_t>(std::min<size_t>(retained, UINT32_MAX));
+
+  const auto [it, inserted] = stream_pool_depth_hints_.try_emplace(stream_id, hint);
+  if (!inserted) {
+    if (it->second == hint) {
+      return;
+    }
+    it->second = hint;
+  }
+  prov->set_stream_pool_depth_hint(stream_id, hint);
+  stream_pool_depth_hints_sent_.fetch_add(1, std::memory_order_relaxed);
+}
+
 void CoreRuntime::account_display_demand_release_async_post_failure_(CoreThread::PostResult result) noexcept {
   switch (result) {
     case CoreThread::PostResult::QueueFull:
@@ -6550,6 +8260,9 @@ void CoreRuntime::account_display_demand_release_async_post_failure_(CoreThread:
 CoreRuntime::Stats CoreRuntime::stats_copy() const noexcept {
   Stats s;
   s.publish_requests_coalesced = publish_requests_coalesced_.load(std::memory_order_relaxed);
+  s.picture_updates_coalesced = picture_updates_coalesced_.load(std::memory_order_relaxed);
+  s.snapshot_publishes_paced = snapshot_publishes_paced_.load(std::memory_order_relaxed);
+  s.snapshot_publish_interval_ns = snapshot_publish_interval_ns_.load(std::memory_order_relaxed);
   s.publish_requests_dropped_full = publish_requests_dropped_full_.load(std::memory_order_relaxed);
   s.publish_requests_dropped_closed = publish_requests_dropped_closed_.load(std::memory_order_relaxed);
   s.publish_requests_dropped_allocfail = publish_requests_dropped_allocfail_.load(std::memory_order_relaxed);
@@ -6559,6 +8272,17 @@ CoreRuntime::Stats CoreRuntime::stats_copy() const noexcept {
       display_demand_release_async_dropped_closed_.load(std::memory_order_relaxed);
   s.display_demand_release_async_dropped_allocfail =
       display_demand_release_async_dropped_allocfail_.load(std::memory_order_relaxed);
+  s.memory_trims = memory_trims_.load(std::memory_order_relaxed);
+  s.memory_trim_bytes_released = memory_trim_bytes_released_.load(std::memory_order_relaxed);
+  s.stream_pool_depth_hints_sent = stream_pool_depth_hints_sent_.load(std::memory_order_relaxed);
+  s.stream_qos_level = stream_qos_level_.load(std::memory_order_relaxed);
+  s.stream_qos_level_changes = stream_qos_level_changes_.load(std::memory_order_relaxed);
+  s.stream_qos_reconfigurations = stream_qos_reconfigurations_.load(std::memory_order_relaxed);
+  const CoreFrameShards::Stats shard_stats = frame_shards_.stats();
+  s.frame_shard_frames_posted = shard_stats.frames_posted;
+  s.frame_shard_frames_retained = shard_stats.frames_retained;
+  s.frame_shard_frames_rejected_full = shard_stats.frames_rejected_full;
+  s.task_timing = core_thread_.task_timing_copy();
   return s;
 }
 
@@ -6589,6 +8313,9 @@ void CoreRuntime::request_publish() {
   // routing this through the requests_ queue.
   const CoreThread::PostResult r = core_thread_.try_post([this]() {
     assert(core_thread_.is_core_thread());
+    if (publish_requested_ns_ == 0) {
+      publish_requested_ns_ = CoreThread::steady_now_ns();
+    }
     core_thread_.request_timer_tick();
   });
 
@@ -6644,7 +8371,48 @@ void CoreRuntime::enqueue_provider_fact(ProviderToCoreCommand&& cmd) {
   core_thread_.request_timer_tick();
 }
 
-void CoreRuntime::enqueue_request(CoreThread::Task task) {
+void CoreRuntime::dispatch_provider_fact_timed_(ProviderToCoreCommand&& cmd, bool repeating_stream_frame) {
+  if (!repeating_stream_frame) {
+    const uint64_t closed_device_instance_id =
+        cmd.type == ProviderToCoreCommandType::PROVIDER_DEVICE_CLOSED
+            ? std::get<CmdProviderDeviceClosed>(cmd.payload).device_instance_id
+            : 0;
+    dispatcher_.dispatch(std::move(cmd));
+    if (closed_device_instance_id != 0) {
+      capture_latency_stats_.forget_device(closed_device_instance_id);
+    }
+    return;
+  }
+  const uint64_t started_ns = CoreThread::steady_now_ns();
+  dispatcher_.dispatch(std::move(cmd));
+  core_thread_.task_timing().record_exec(CoreTaskKind::FRAME_DISPATCH, CoreThread::steady_now_ns() - started_ns);
+}
+
+void CoreRuntime::integrate_frame_shard_completions_() {
+  assert(core_thread_.is_core_thread());
+  if (!frame_shards_.running()) {
+    return;
+  }
+  frame_shards_.take_completions(frame_shard_completions_);
+  for (const CoreFrameShardCompletion& completion : frame_shard_completions_) {
+    dispatcher_.integrate_frame_shard_completion(completion);
+  }
+  frame_shard_completions_.clear();
+}
+
+void CoreRuntime::drain_frame_shards_() {
+  assert(core_thread_.is_core_thread());
+  if (!frame_shards_.running()) {
+    return;
+  }
+  frame_shards_.wait_idle();
+  integrate_frame_shard_completions_();
+  if (dispatcher_.consume_relevant_state_changed()) {
+    request_publish_from_core_unchecked();
+  }
+}
+
+void CoreRuntime::enqueue_request(RequestTask task) {
   assert(core_thread_.is_core_thread());
   requests_.push_back(std::move(task));
   // Requests also wake the core pump; any snapshot publication remains a
@@ -6656,7 +8424,14 @@ void CoreRuntime::enqueue_request(CoreThread::Task task) {
 void CoreRuntime::request_publish_from_core_unchecked() {
   assert(core_thread_.is_core_thread());
   // Coalesce naturally: if already pending, keep it pending.
-  publish_pending_.store(true, std::memory_order_release);
+  if (publish_pending_.load(std::memory_order_relaxed)) {
+    publish_requests_coalesced_.fetch_add(1, std::memory_order_relaxed);
+  } else {
+    publish_pending_.store(true, std::memory_order_release);
+  }
+  if (publish_requested_ns_ == 0) {
+    publish_requested_ns_ = CoreThread::steady_now_ns();
+  }
 }
 
 } // namespace cambang
@@ -6,28 +6,48 @@
 #include <condition_variable>
 #include <cstring>
 #include <deque>
+#include <filesystem>
+#include <functional>
 #include <map>
 #include <memory>
 #include <mutex>
 #include <optional>
 #include <string>
+#include <string_view>
 #include <utility>
+#include <variant>
 #include <vector>
 
 #include "core/core_dispatcher.h"
 #include "core/core_acquisition_session_registry.h"
 #include "core/core_capture_assembly_registry.h"
+#include "core/core_capture_latency_stats.h"
 #include "core/core_capture_cohort_registry.h"
+#include "core/core_capture_spill_store.h"
+#include "core/core_capture_fusion.h"
+#include "core/core_capture_thumbnails.h"
+#include "core/core_deadline_table.h"
 #include "core/core_device_registry.h"
+#include "core/core_encoded_image.h"
+#include "core/core_frame_shards.h"
 #include "core/core_native_object_registry.h"
+#include "core/core_operation.h"
+#include "core/core_publish_pacer.h"
 #include "core/core_result_store.h"
+#include "core/core_retained_plan_prior_store.h"
 #include "core/core_rig_registry.h"
+#include "core/core_rig_stream_frame_sets.h"
 #include "core/core_runtime_state.h"
+#include "core/core_snapshot_publish_worker.h"
 #include "core/core_spec_state.h"
 #include "core/external_camera_description_state.h"
 #include "core/provider_camera_fact_state.h"
+#include "core/core_stream_exporter.h"
+#include "core/core_stream_qos.h"
+#include "core/core_stream_recorder.h"
 #include "core/core_stream_registry.h"
 #include "core/core_thread.h"
+#include "core/core_warm_pool.h"
 #include "core/core_frame_sink.h"
 #include "core/i_state_snapshot_publisher.h"
 #include "core/provider_callback_ingress.h"
@@ -53,6 +73,9 @@ enum class BackingPlanEvaluationCompletionReason : uint8_t {
   AllViableCandidatesEvaluated = 1,
   LiveDisplayDemandFamilyCrossing = 2,
   SingleViableCandidate = 3,
+  // Settled on a decision a completed evaluation made in an earlier runtime
+  // generation (CoreRetainedPlanPriorStore); no candidates were evaluated.
+  PersistedPrior = 4,
 };
 
 enum class CaptureEvidenceIncompleteReason : uint8_t {
@@ -141,8 +164,17 @@ struct CoreCaptureLifecycleTimingReport {
   uint64_t capture_id = 0;
   uint64_t device_instance_id = 0;
   uint64_t acquisition_session_id = 0;
+  uint64_t rig_id = 0;
+  // Trigger request entered Core, and the provider accepted it.
+  bool has_capture_triggered_steady_ns = false;
+  uint64_t capture_triggered_steady_ns = 0;
+  bool has_capture_admitted_steady_ns = false;
+  uint64_t capture_admitted_steady_ns = 0;
   bool has_capture_started_ingested_steady_ns = false;
   uint64_t capture_started_ingested_steady_ns = 0;
+  // First default image.
+  bool has_capture_image_ingested_steady_ns = false;
+  uint64_t capture_image_ingested_steady_ns = 0;
   bool has_capture_completed_ingested_steady_ns = false;
   uint64_t capture_completed_ingested_steady_ns = 0;
   bool has_capture_failed_ingested_steady_ns = false;
@@ -178,6 +210,31 @@ enum class TrySetWarmHoldStatus : uint8_t {
   InvalidArgument = 2,
 };
 
+enum class TryPrewarmRigStatus : uint8_t {
+  OK = 0,
+  Busy = 1,
+  InvalidArgument = 2,
+  RigNotFound = 3,
+  // A member hardware_id has no open device; nothing was pre-warmed.
+  MemberNotOpen = 4,
+};
+
+enum class TryStreamRecordingStatus : uint8_t {
+  OK = 0,
+  Busy = 1,
+  InvalidArgument = 2,
+  // The file could not be created or written.
+  IoError = 3,
+};
+
+enum class TryStreamExportStatus : uint8_t {
+  OK = 0,
+  Busy = 1,
+  InvalidArgument = 2,
+  // The shared-memory region could not be created (or the platform has none).
+  Unavailable = 3,
+};
+
 enum class TryTriggerDeviceCaptureStatus : uint8_t {
   OK = 0,
   Busy = 1,
@@ -207,6 +264,14 @@ enum class TryStopStreamStatus : uint8_t {
   ProviderRejected = 3,
 };
 
+enum class TryReconfigureStreamStatus : uint8_t {
+  OK = 0,
+  NotSupported = 1,
+  Busy = 2,
+  InvalidArgument = 3,
+  ProviderRejected = 4,
+};
+
 enum class TryDestroyStreamStatus : uint8_t {
   OK = 0,
   Busy = 1,
@@ -229,19 +294,107 @@ enum class TryCloseDeviceStatus : uint8_t {
   ProviderRejected = 3,
 };
 
+enum class TrySwapProviderStatus : uint8_t {
+  OK = 0,
+  Busy = 1,
+  InvalidArgument = 2,
+  // The swap callable failed. The old provider's streams and devices are
+  // already retired either way.
+  ProviderRejected = 3,
+};
+
+enum class TryRunSetupBatchStatus : uint8_t {
+  // Every command ran and succeeded.
+  OK = 0,
+  // Nothing ran.
+  Busy = 1,
+  // A command failed validation (its status says which); nothing ran.
+  InvalidArgument = 2,
+  // A command failed on the core thread, or was skipped because an earlier
+  // one on its device or stream failed; the statuses say which.
+  CommandFailed = 3,
+};
+
+// Commands of a setup batch (CoreRuntime::try_run_setup_batch()). Each
+// mirrors the arguments of its try_* counterpart.
+struct SetupOpenDevice {
+  std::string hardware_id;
+  uint64_t device_instance_id = 0;
+  uint64_t root_id = 0;
+};
+
+struct SetupCreateStream {
+  uint64_t stream_id = 0;
+  uint64_t device_instance_id = 0;
+  StreamIntent intent = StreamIntent::PREVIEW;
+  // Provider template when unset.
+  std::optional<CaptureProfile> profile;
+  std::optional<PictureConfig> picture;
+  uint64_t profile_version = 0;
+  StreamPriority priority = StreamPriority::NORMAL;
+};
+
+struct SetupSetStillCaptureProfile {
+  uint64_t device_instance_id = 0;
+  CaptureProfile profile{};
+  CaptureStillImageBundle still_image_bundle{};
+};
+
+struct SetupStartStream {
+  uint64_t stream_id = 0;
+};
+
+using SetupCommand = std::variant<SetupOpenDevice,
+                                  SetupCreateStream,
+                                  SetupSetStillCaptureProfile,
+                                  SetupStartStream>;
+
+// Outcome of one setup command, in its try_* counterpart's status enum;
+// std::monostate when the command did not run.
+using SetupCommandStatus = std::variant<std::monostate,
+                                        TryOpenDeviceStatus,
+                                        TryCreateStreamStatus,
+                                        TrySetStillCaptureProfileStatus,
+                                        TryStartStreamStatus>;
+
   class CoreRuntime final : private CoreThread::IHooks {
   private:
     enum class ShutdownPhase : uint8_t;  // forward declaration
 
   public:
     struct Stats {
+    // Publish requests absorbed by one already pending (external and Core's own).
     uint64_t publish_requests_coalesced = 0;
+    // Stream and capture picture updates superseded by a newer one for the
+    // same stream or device before Core applied them.
+    uint64_t picture_updates_coalesced = 0;
+    // Counter-only publishes held back by the rate limit, and its current
+    // adaptive interval (CorePublishPacer).
+    uint64_t snapshot_publishes_paced = 0;
+    uint64_t snapshot_publish_interval_ns = 0;
     uint64_t publish_requests_dropped_full = 0;
     uint64_t publish_requests_dropped_closed = 0;
     uint64_t publish_requests_dropped_allocfail = 0;
     uint64_t display_demand_release_async_dropped_full = 0;
     uint64_t display_demand_release_async_dropped_closed = 0;
     uint64_t display_demand_release_async_dropped_allocfail = 0;
+    // trim_memory() calls that ran, and the bytes they released in total.
+    uint64_t memory_trims = 0;
+    uint64_t memory_trim_bytes_released = 0;
+    // ICameraProvider::set_stream_pool_depth_hint() calls made.
+    uint64_t stream_pool_depth_hints_sent = 0;
+    // Stream QoS (set_stream_qos_enabled()): the current level, how often it
+    // changed, and the stream reconfigurations made to follow it.
+    uint64_t stream_qos_level = 0;
+    uint64_t stream_qos_level_changes = 0;
+    uint64_t stream_qos_reconfigurations = 0;
+    // Frame retention shards (set_frame_shard_count()): frames handed to a
+    // shard, retained there, and dropped because the device's shard was full.
+    uint64_t frame_shard_frames_posted = 0;
+    uint64_t frame_shard_frames_retained = 0;
+    uint64_t frame_shard_frames_rejected_full = 0;
+    // Core-thread queue wait / execution histograms (core_task_timing.h).
+    CoreTaskTimingStats task_timing{};
   };
 
   CoreRuntime();
@@ -255,6 +408,76 @@ enum class TryCloseDeviceStatus : uint8_t {
 
   bool is_running() const { return core_thread_.is_running(); }
 
+  // Core-thread mailbox sizing (CoreThread::set_lane_capacities()): pending
+  // ordinary (provider/frame ingress) and command tasks; 0 keeps a lane's
+  // value. Call while stopped; returns false otherwise. The ordinary lane's
+  // fill level also drives provider backpressure
+  // (IProviderCallbacks::is_stream_ingress_congested()).
+  bool set_core_lane_capacities(size_t ordinary_tasks, size_t command_tasks) noexcept {
+    return core_thread_.set_lane_capacities(ordinary_tasks, command_tasks);
+  }
+
+  // File for retained-plan priors (CoreRetainedPlanPriorStore): loaded at
+  // start, so streams and capture parents matching an earlier generation's
+  // completed evaluation settle on its plan at once, and rewritten at stop
+  // with this generation's. Empty (the default) disables persistence. Call
+  // while stopped; returns false otherwise.
+  bool set_retained_plan_prior_path(std::filesystem::path path);
+
+  // Where successful capture results evicted over the byte budget are kept
+  // (CoreCaptureSpillStore): nowhere (OFF, the default: evicted results are
+  // gone), owner-only spill files under `directory` (TEMP_FILE; nothing is
+  // spilled without one) or compressed in memory (COMPRESSED_MEMORY), within
+  // byte_budget bytes of what the tier holds. Call while stopped; returns
+  // false otherwise.
+  bool set_capture_spill_medium(CoreCaptureSpillStore::Medium medium,
+                                uint64_t byte_budget = CoreCaptureSpillStore::kDefaultByteBudget,
+                                std::filesystem::path directory = {});
+
+  // Highest rate of snapshot publishes that only move counters
+  // (CorePublishPacer; default kDefaultMaxCounterPublishesPerS, 0 =
+  // unlimited). Topology changes publish on the tick that made them. Call
+  // while stopped; returns false otherwise.
+  bool set_snapshot_publish_rate_limit(uint32_t max_counter_publishes_per_s) noexcept;
+
+  // Builds published snapshots off the core thread (CoreSnapshotPublishWorker),
+  // off by default. The core thread then only captures a view per publish:
+  // devices and streams are rebuilt, and every other section is a shared
+  // immutable copy reused while its registry is unchanged, so its cost no
+  // longer grows with native objects, rigs or sessions. A helper thread
+  // copies the view into the snapshot, computes the delta and calls the
+  // publisher, in order; published_seq() advances once it has. Call while
+  // stopped; returns false otherwise.
+  bool set_snapshot_publish_offload(bool enabled) noexcept;
+  bool snapshot_publish_offload() const noexcept {
+    return snapshot_publish_offload_.load(std::memory_order_acquire);
+  }
+
+  // Load-adaptive stream quality of service (CoreStreamQosController), off
+  // by default. While enabled, sustained overload (ingress or provider frame
+  // drops, or a saturated core thread) lowers started streams' frame rate
+  // and then resolution through in-place reconfiguration, and sustained calm
+  // restores them a step at a time. Each stream's level is published as
+  // StreamState::qos_level. Disabling restores every stream's own profile.
+  // try_reconfigure_stream() sets the profile a stream is lowered from.
+  // Any thread.
+  void set_stream_qos_enabled(bool enabled) noexcept;
+  bool stream_qos_enabled() const noexcept {
+    return stream_qos_enabled_.load(std::memory_order_acquire);
+  }
+
+  // Per-device frame retention shards (CoreFrameShards), off (0) by
+  // default. With shard_count workers, retaining a repeating stream frame
+  // (the payload copy and result build) and releasing it back to the
+  // provider run on the worker its device maps to, so several devices'
+  // streams retain in parallel while each device's frames keep their order.
+  // Registries, captures and everything crossing devices stay on the core
+  // thread, which takes each shard's completions by message on its next
+  // tick. Call while stopped; returns false otherwise or when shard_count
+  // exceeds CoreFrameShards::kMaxShards.
+  bool set_frame_shard_count(size_t shard_count) noexcept;
+  size_t frame_shard_count() const noexcept { return frame_shard_count_; }
+
   // Watchdog policy layer over CoreThread::current_task_started_ns(). Call
   // periodically (e.g. once per Godot tick, or from a maintainer-tool
   // polling loop) to detect a core thread wedged inside a single posted
@@ -323,12 +546,16 @@ enum class TryCloseDeviceStatus : uint8_t {
     return state_.load(std::memory_order_acquire);
   }
 
+  // Request tasks ride inside a command-lane CoreThread::Task (see try_post()),
+  // so their inline budget leaves room for that wrapper's own capture.
+  using RequestTask = InlineTask<CoreThread::kTaskInlineBytes - 64>;
+
   // Best-effort compatibility shim for disposable work only; drops are intentionally
   // not surfaced. Retained runtime truth must use a [[nodiscard]] admission-returning
   // path instead.
-  void post(CoreThread::Task task);
+  void post(RequestTask task);
 
-  CoreThread::PostResult try_post(CoreThread::Task task);
+  CoreThread::PostResult try_post(RequestTask task);
 
   // Dev/internal stream lifecycle surfaces.
   // Defaulting is performed by core using provider->stream_template().
@@ -343,14 +570,60 @@ enum class TryCloseDeviceStatus : uint8_t {
       StreamIntent intent,
       const CaptureProfile* request_profile,
       const PictureConfig* request_picture,
-      uint64_t profile_version) noexcept;
+      uint64_t profile_version,
+      StreamPriority priority = StreamPriority::NORMAL) noexcept;
 
   TryStartStreamStatus try_start_stream(uint64_t stream_id) noexcept;
 
   TryStopStreamStatus try_stop_stream(uint64_t stream_id) noexcept;
 
+  // Replaces a created stream's profile without the stop/destroy/create/start
+  // round trip; a started stream stays started and its latest result stays
+  // readable until a frame at the new profile replaces it. The record's
+  // profile_version moves to a new core-assigned lineage, and
+  // last_reconfigure_latency_ns reports the time to that first frame.
+  // NotSupported when the provider cannot reconfigure in place; the caller
+  // then falls back to the teardown path.
+  TryReconfigureStreamStatus try_reconfigure_stream(uint64_t stream_id,
+                                                    const CaptureProfile& profile) noexcept;
+
   TryDestroyStreamStatus try_destroy_stream(uint64_t stream_id) noexcept;
 
+  // Records the stream's retained CPU results, with their acquisition timing
+  // and image facts, to path (see CoreStreamRecorder for the container).
+  // InvalidArgument for an unknown stream or one already recording.
+  TryStreamRecordingStatus try_start_stream_recording(uint64_t stream_id,
+                                                      const std::filesystem::path& path) noexcept;
+  // Detaches the recording and returns once the file is complete; out (when
+  // given) receives its final counts. IoError when a write failed. Runtime
+  // stop also completes every recording.
+  TryStreamRecordingStatus try_stop_stream_recording(uint64_t stream_id,
+                                                     CoreStreamRecorder::Stats* out = nullptr) noexcept;
+  // Live counts of an attached recording; any thread.
+  bool stream_recording_stats(uint64_t stream_id, CoreStreamRecorder::Stats& out) const {
+    return stream_recorder_.stats(stream_id, out);
+  }
+
+  // Publishes the stream's retained CPU results into a shared-memory ring
+  // for another process (see CoreStreamExporter for the layout and
+  // CBSharedMemoryRegion for how a consumer opens name). Slots hold payloads
+  // up to max_payload_bytes; larger frames are skipped and counted.
+  // InvalidArgument for an unknown stream or one already exporting.
+  TryStreamExportStatus try_start_stream_export(uint64_t stream_id,
+                                                const std::string& name,
+                                                size_t max_payload_bytes) noexcept;
+  // Detaches and closes the region; a consumer's mapping stays valid until
+  // it unmaps. Runtime stop also closes every export.
+  TryStreamExportStatus try_stop_stream_export(uint64_t stream_id,
+                                               CoreStreamExporter::Stats* out = nullptr) noexcept;
+  // Live counts and consumer handles of an attached export; any thread.
+  bool stream_export_stats(uint64_t stream_id, CoreStreamExporter::Stats& out) const {
+    return stream_exporter_.stats(stream_id, out);
+  }
+  bool stream_export_handles(uint64_t stream_id, CoreStreamExporter::Handles& out) const {
+    return stream_exporter_.handles(stream_id, out);
+  }
+
   TryOpenDeviceStatus try_open_device(
       const std::string& hardware_id,
       uint64_t device_instance_id,
@@ -360,22 +633,94 @@ enum class TryCloseDeviceStatus : uint8_t {
 
   // Stream-scoped picture update path. Success reflects provider acceptance
   // and committed core truth, not merely queue admission.
+  //
+  // Latest-wins: when a newer update for the same stream is queued behind
+  // this one, this one is superseded and returns OK without reaching the
+  // provider, so a burst of updates (a UI slider) applies only its newest
+  // value. Counted in Stats::picture_updates_coalesced.
   TrySetStreamPictureStatus try_set_stream_picture_config(uint64_t stream_id, const PictureConfig& picture) noexcept;
-  // Device-scoped capture-picture update path.
+  // Device-scoped capture-picture update path. Latest-wins per device, as
+  // above.
   TrySetCapturePictureStatus try_set_capture_picture_config(uint64_t device_instance_id, const PictureConfig& picture) noexcept;
   TrySetStillCaptureProfileStatus try_set_device_still_capture_profile(
       uint64_t device_instance_id,
       const CaptureProfile& profile,
       const CaptureStillImageBundle& still_image_bundle) noexcept;
   TrySetWarmHoldStatus try_set_device_warm_hold_ms(uint64_t device_instance_id, uint32_t warm_hold_ms) noexcept;
+  // Budget for the usage-driven extension of warm holds (see CoreWarmPool).
+  // max_extended_devices == 0 turns prediction off.
+  TrySetWarmHoldStatus try_set_warm_pool_budget(const CoreWarmPool::Budget& budget) noexcept;
+  // Ahead of a scheduled rig capture: holds every member device open for at
+  // least hold_ms from now, past its own warm hold and outside the pool
+  // budget. Members must already be open; core cannot open a device itself
+  // (the host assigns device instance ids).
+  TryPrewarmRigStatus try_prewarm_rig(uint64_t rig_id, uint32_t hold_ms) noexcept;
+  // Provider hot-swap while the runtime stays LIVE. On the core thread: stops
+  // every started stream, destroys every created stream and closes every open
+  // device through the attached provider (reflecting each accepted call
+  // locally, as the shutdown choreography does), then runs swap, which must
+  // shut the attached provider down and bring its replacement up behind the
+  // same ICameraProvider (ProviderBroker::swap_provider()). Late
+  // facts from the old provider retire its native objects through ordinary
+  // ingress; rigs, specs and retained results are kept.
+  TrySwapProviderStatus try_swap_provider(const std::function<ProviderResult()>& swap) noexcept;
+
+  // Runs commands in order in one core-thread task, so bringing up a rig
+  // scene costs one core slice and one snapshot publish instead of one per
+  // call. Capture retained-plan refreshes the commands trigger are deferred
+  // and run once per touched device after the last command. statuses
+  // (resized to commands.size()) receives each command's outcome.
+  //
+  // Commands are validated up front as their try_* counterparts do; one
+  // invalid command refuses the whole batch. A command failing on the core
+  // thread fails its target: a stream command its stream, otherwise its
+  // device. Later commands on a failed target are skipped (std::monostate);
+  // commands on other devices still run. Commands that succeeded are not
+  // rolled back.
+  TryRunSetupBatchStatus try_run_setup_batch(const std::vector<SetupCommand>& commands,
+                                             std::vector<SetupCommandStatus>& statuses) noexcept;
 
   // Server-facing synchronous wrappers. They marshal registry/provider access onto
   // the core thread and only return success after the work was accepted/submitted.
   TryTriggerDeviceCaptureStatus try_trigger_device_capture_with_capture_id_for_server(
       uint64_t device_instance_id,
       uint64_t capture_id) noexcept;
+  // Zero-shutter-lag variant: resolves the capture to the frame of
+  // stream_id's history ring nearest reference (see
+  // CoreResultStore::find_stream_history_result()) instead of asking the
+  // provider for a new image. The frame is re-ingested as the capture's
+  // default image, sharing its payload bytes, through the ordinary capture
+  // lifecycle and result path. Unavailable when no kept frame qualifies or the
+  // device's capture posture is not CPU-primary.
+  TryTriggerDeviceCaptureStatus try_trigger_device_capture_from_stream_history_for_server(
+      uint64_t device_instance_id,
+      uint64_t capture_id,
+      uint64_t stream_id,
+      const ImageAcquisitionTiming& reference) noexcept;
   bool materialize_capture_request_for_server(uint64_t device_instance_id, CaptureRequest& out) const;
 
+  // Completion-handle variants of the lifecycle commands. Each admits and
+  // runs exactly as its try_* counterpart (whose status lands in out_status
+  // when given), then returns a CoreOperation that resolves when Core
+  // integrates the provider fact finishing the command: device opened or
+  // closed, stream started or stopped, capture completed. Error facts for
+  // the target resolve it Failed; a refused command returns it already
+  // Failed; runtime stop resolves whatever is left Cancelled. A command with
+  // nothing left to do (a started stream whose start fact has arrived)
+  // returns it already Succeeded.
+  CoreOperation open_device_async(const std::string& hardware_id,
+                                  uint64_t device_instance_id,
+                                  uint64_t root_id,
+                                  TryOpenDeviceStatus* out_status = nullptr) noexcept;
+  CoreOperation close_device_async(uint64_t device_instance_id,
+                                   TryCloseDeviceStatus* out_status = nullptr) noexcept;
+  CoreOperation start_stream_async(uint64_t stream_id, TryStartStreamStatus* out_status = nullptr) noexcept;
+  CoreOperation stop_stream_async(uint64_t stream_id, TryStopStreamStatus* out_status = nullptr) noexcept;
+  CoreOperation trigger_device_capture_async_for_server(
+      uint64_t device_instance_id,
+      uint64_t capture_id,
+      TryTriggerDeviceCaptureStatus* out_status = nullptr) noexcept;
+
   // Compatibility alias for smoke/internal callers; still marshals to the core thread.
   bool materialize_capture_request(uint64_t device_instance_id, CaptureRequest& out) const;
 
@@ -433,6 +778,9 @@ enum class TryCloseDeviceStatus : uint8_t {
     InvalidBundle = 1,
     ProviderUnavailable = 2,
     TriggerFailed = 3,
+    // Stream-frame-set capture: the rig has no completed set whose members
+    // are the participants' re-ingestable frames.
+    FrameSetUnavailable = 4,
   };
 
   struct RigSubmissionResult {
@@ -505,6 +853,13 @@ enum class TryCloseDeviceStatus : uint8_t {
   };
 
   std::optional<ImagingSpecRetainedStateForSmoke> imaging_spec_retained_state_for_smoke() const;
+  // The external camera descriptions of the current generation, published
+  // whole at start(). Any thread, lock-free; lookups on the result need no
+  // lock either, and the set stays valid while the pointer is held. Never
+  // null (an empty set with version 0 when none is configured).
+  SharedExternalCameraDescription active_external_camera_description() const noexcept {
+    return active_external_camera_description_.load();
+  }
   std::optional<ExternalCameraDescriptionEntry>
   active_external_camera_description_for_smoke(const std::string& camera_id) const;
   size_t active_external_camera_description_count_for_smoke() const;
@@ -516,6 +871,24 @@ enum class TryCloseDeviceStatus : uint8_t {
       uint64_t device_instance_id,
       uint32_t image_member_index) const;
 
+  // Sizes of Core's long-lived keyed state, read together on the core
+  // thread, so a soak run can watch each for unbounded growth.
+  struct ResourceFootprintForSmoke {
+    size_t devices = 0;
+    size_t streams = 0;
+    size_t acquisition_sessions = 0;
+    size_t rigs = 0;
+    size_t native_objects = 0;
+    size_t capture_assemblies = 0;
+    size_t capture_cohorts = 0;
+    size_t pending_capture_observations = 0;
+    size_t capture_stream_preemption_devices = 0;
+    size_t telemetry_buckets = 0;
+    uint64_t estimated_capture_bytes = 0;
+    CoreResultStore::TableSizes result_store{};
+  };
+  std::optional<ResourceFootprintForSmoke> resource_footprint_for_smoke() const;
+
 #endif
 
   bool retain_rig_member_hardware_ids(
@@ -536,6 +909,8 @@ enum class TryCloseDeviceStatus : uint8_t {
     Busy = 1,
     ParseError = 2,
     Invalid = 3,
+    // The file could not be opened, was empty or could not be mapped.
+    IoError = 4,
   };
 
   struct IngestCameraConcurrencyResult {
@@ -546,12 +921,24 @@ enum class TryCloseDeviceStatus : uint8_t {
 
   IngestCameraConcurrencyResult ingest_camera_concurrency_json_for_server(
       const std::string& json_text);
+  // As above, reading the JSON from a file (UTF-8 path). The file is
+  // memory-mapped and parsed in place, so a large ADC file is never copied
+  // into a string first.
+  //
+  // Both ingests parse on the calling thread and hold no Core lock while
+  // parsing: they may run on a background thread. Only the parsed result is
+  // handed over (under a short lock), and the next start() applies it
+  // without parsing again.
+  IngestCameraConcurrencyResult ingest_camera_concurrency_json_file_for_server(
+      const std::string& path);
 
   enum class ReplaceExternalCameraDescriptionStatus : uint8_t {
     Ok = 0,
     Busy = 1,
     ParseError = 2,
     Invalid = 3,
+    // The file could not be opened, was empty or could not be mapped.
+    IoError = 4,
   };
 
   struct ReplaceExternalCameraDescriptionResult {
@@ -565,11 +952,28 @@ enum class TryCloseDeviceStatus : uint8_t {
   // Internal seam; it deliberately has no Godot binding until Tranche 3.
   ReplaceExternalCameraDescriptionResult replace_external_camera_description_json_for_internal(
       const std::string& json_text);
+  // File-path form, memory-mapped and parsed in place; callable from any
+  // thread, like ingest_camera_concurrency_json_file_for_server().
+  ReplaceExternalCameraDescriptionResult replace_external_camera_description_json_file_for_internal(
+      const std::string& path);
 
   // Server-internal adapter: caller supplies capture_id (no allocation here).
   RigTriggerOrchestrationResult orchestrate_rig_capture_with_capture_id_for_server(
       uint64_t rig_id,
       uint64_t capture_id) noexcept;
+  // Zero-shutter-lag rig capture: instead of asking the provider for new
+  // stills, resolves every member to its frame of the rig's latest
+  // time-aligned stream frame set (see CoreRigStreamFrameSets), so members
+  // are at most half a frame interval apart on the sensor clock and no
+  // capture latency is added. Each frame is re-ingested as that member's
+  // default image through the ordinary cohort, lifecycle and result path,
+  // as try_trigger_device_capture_from_stream_history_for_server() does for
+  // one device; the rig's sync_skew records the set's acquisition skew.
+  // FrameSetUnavailable when no set has completed, a member frame is not
+  // re-ingestable, or a member's capture posture is not CPU-primary.
+  RigTriggerOrchestrationResult orchestrate_rig_capture_from_stream_frame_set_for_server(
+      uint64_t rig_id,
+      uint64_t capture_id) noexcept;
 
 #if defined(CAMBANG_INTERNAL_SMOKE)
   CoreThread::PostResult try_post_core_thread_unchecked(CoreThread::Task task) {
@@ -582,6 +986,9 @@ enum class TryCloseDeviceStatus : uint8_t {
   Stats stats_copy() const noexcept;
 
   ProviderCallbackIngress::Stats ingress_stats_copy() const noexcept { return ingress_.stats_copy(); }
+  CpuPayloadBufferPool::Stats cpu_payload_buffer_pool_stats_copy() const noexcept {
+    return cpu_payload_buffer_pool_.stats_copy();
+  }
 
   struct ShutdownDiag {
     uint8_t phase_code = 0;
@@ -641,6 +1048,18 @@ enum class TryCloseDeviceStatus : uint8_t {
   std::vector<CoreBackingPlanEvaluationReport> backing_plan_evaluation_reports() const;
   std::vector<CoreCaptureLifecycleTimingReport>
   recent_capture_lifecycle_timing_reports() const;
+  // Drops the per-device and per-rig capture latency histograms that
+  // snapshots report (see CoreCaptureLatencyStats). False when the runtime
+  // is not running.
+  bool reset_capture_latency_histograms() noexcept;
+
+  // Memory pressure: frees memory Core and the active provider keep only for
+  // reuse. Moderate empties the payload buffer pool and evicts terminal
+  // capture results down to kCaptureResultTrimModerateFloorBytes; Critical
+  // evicts every terminal result. Evicted successful results go to the spill
+  // tier exactly as byte-budget eviction sends them. Returns the bytes
+  // released (0 when the runtime is not running).
+  uint64_t trim_memory(MemoryTrimLevel level) noexcept;
 
   // Narrow internal backing-plan evaluation handoff. Godot-side retained-result
   // calibration reports structural/support truth plus measured public-operation
@@ -677,6 +1096,48 @@ enum class TryCloseDeviceStatus : uint8_t {
   SharedStreamResultData get_latest_stream_result(uint64_t stream_id) const {
     return result_store_.get_latest_stream_result(stream_id);
   }
+  // Wait-free change counters over retained results (see
+  // CoreResultStore::stream_result_revision()): a poller that saw the same
+  // value last time has nothing new to read.
+  uint64_t stream_result_revision() const noexcept { return result_store_.stream_result_revision(); }
+  uint64_t capture_result_revision() const noexcept { return result_store_.capture_result_revision(); }
+  // Opt-in history ring of stream_id's recent results, for
+  // try_trigger_device_capture_from_stream_history_for_server(); see
+  // CoreResultStore::set_stream_history_limits(). Any thread.
+  void set_stream_history_limits(uint64_t stream_id, size_t max_frames, uint64_t max_bytes) {
+    result_store_.set_stream_history_limits(stream_id, max_frames, max_bytes);
+    post_stream_pool_depth_hint_refresh_(stream_id);
+  }
+  // Opt-in jitter-buffer mode (CoreResultStore::set_stream_jitter_buffer_latency());
+  // 0 turns it off. Any thread.
+  void set_stream_jitter_buffer_latency(uint64_t stream_id, uint64_t latency_ns) {
+    result_store_.set_stream_jitter_buffer_latency(stream_id, latency_ns);
+    post_stream_pool_depth_hint_refresh_(stream_id);
+  }
+  uint64_t stream_jitter_buffer_latency_ns(uint64_t stream_id) const {
+    return result_store_.stream_jitter_buffer_latency_ns(stream_id);
+  }
+  // Opt-in display-only results (CoreResultStore::set_stream_display_only()).
+  // Any thread.
+  void set_stream_display_only(uint64_t stream_id, bool enabled) {
+    result_store_.set_stream_display_only(stream_id, enabled);
+  }
+  bool stream_display_only(uint64_t stream_id) const {
+    return result_store_.stream_display_only(stream_id);
+  }
+  // The result to show display_delay_ns from now: the jitter-buffer choice
+  // while the mode is on, else the latest result. Any thread.
+  SharedStreamResultData get_stream_result_for_display(uint64_t stream_id, uint64_t display_delay_ns) const {
+    const uint64_t now_steady_ns = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+    return result_store_.select_stream_result_for_display(stream_id, now_steady_ns + display_delay_ns);
+  }
+
+  // Latest complete time-aligned set of rig_id's member stream results (see
+  // core_rig_stream_frame_sets.h); nullptr until one completes. Lock-free.
+  SharedRigStreamFrameSet get_latest_rig_stream_frame_set(uint64_t rig_id) const noexcept {
+    return rig_stream_frame_sets_.find_latest(rig_id);
+  }
 
   SharedCaptureResultData get_capture_result(uint64_t capture_id, uint64_t device_instance_id) const;
   std::vector<SharedCaptureResultData> get_capture_result_set(uint64_t capture_id) const;
@@ -693,6 +1154,11 @@ enum class TryCloseDeviceStatus : uint8_t {
     return result_store_.is_stream_display_demand_active(stream_id, ns_since_epoch_());
   }
   void release_stream_display_demand_async(uint64_t stream_id);
+  // Delivery side of stream frame pacing: the display took up result (see
+  // CoreResultStore::note_stream_result_displayed()). Any thread.
+  void note_stream_result_displayed(const CoreStreamResultData& result) {
+    result_store_.note_stream_result_displayed(result);
+  }
 
 
   void attach_provider(ICameraProvider* provider) noexcept {
@@ -767,6 +1233,9 @@ private:
     explicit SynchronousCommandCompletion(Status fallback)
         : fallback_(fallback), result_(fallback) {}
 
+    // Immutable after construction; readable without mutex_.
+    const Status& fallback() const { return fallback_; }
+
     bool try_begin() {
       std::lock_guard<std::mutex> lock(mutex_);
       if (phase_ != Phase::Pending) {
@@ -852,16 +1321,20 @@ private:
 
       auto completion =
           std::make_shared<SynchronousCommandCompletion<Status>>(fallback);
+      // Operations may capture whole requests (profiles, rig bundles), so they
+      // are boxed rather than held in the task's fixed inline capture; this
+      // path already allocates the completion and blocks on it.
+      auto boxed_operation = std::make_unique<Operation>(std::move(operation));
       const CoreThread::PostResult post_result = try_post(
-          [completion, operation = std::move(operation), fallback]() mutable {
+          [completion, operation = std::move(boxed_operation)]() mutable {
             if (!completion->try_begin()) {
               return;
             }
-            Status result = fallback;
+            Status result = completion->fallback();
             try {
-              result = operation();
+              result = (*operation)();
             } catch (...) {
-              result = fallback;
+              result = completion->fallback();
             }
             completion->complete(result);
           });
@@ -875,6 +1348,39 @@ private:
     }
   }
 
+  // Runs operation as run_synchronous_command_() does; when it returns OK,
+  // still inside the core-thread task, hands the new CoreOperation to
+  // await_fact so no fact can be integrated before it is waiting.
+  template <typename Status, typename Operation, typename AwaitFact>
+  CoreOperation run_async_command_(Status fallback,
+                                   Status* out_status,
+                                   Operation operation,
+                                   AwaitFact await_fact) noexcept {
+    try {
+      CoreOperation op = CoreOperation::make_pending();
+      const Status status = run_synchronous_command_(fallback,
+          [op, operation = std::move(operation), await_fact = std::move(await_fact)]() mutable -> Status {
+        const Status s = operation();
+        if (s == Status::OK) {
+          await_fact(op);
+        }
+        return s;
+      });
+      if (out_status) {
+        *out_status = status;
+      }
+      if (status != Status::OK) {
+        (void)op.resolve(CoreOperationOutcome::Failed);
+      }
+      return op;
+    } catch (...) {
+      if (out_status) {
+        *out_status = fallback;
+      }
+      return CoreOperation{};
+    }
+  }
+
   void on_core_start() override;
   void on_core_timer_tick() override;
   void on_core_stop() override;
@@ -886,8 +1392,25 @@ private:
   // provider buffer-pool slots. Core-thread-only.
   static void release_queued_provider_frame_facts_(
       std::deque<ProviderToCoreCommand>& facts) noexcept;
-  void enqueue_request(CoreThread::Task task);
+  // dispatcher_.dispatch(), timing repeating stream frames as FRAME_DISPATCH.
+  void dispatch_provider_fact_timed_(ProviderToCoreCommand&& cmd, bool repeating_stream_frame);
+  // Hands queued frame shard completions to dispatcher_. Core-thread-only.
+  void integrate_frame_shard_completions_();
+  // Waits for every frame shard to go idle, then integrates what they
+  // finished. Called before any provider call that may free stream buffers
+  // (stop/destroy/reconfigure a stream, close a device, shut down), so no
+  // shard releases a frame into a buffer pool the provider has torn down.
+  // Core-thread-only; a no-op while sharding is off.
+  void drain_frame_shards_();
+  void enqueue_request(RequestTask task);
   void request_publish_from_core_unchecked();
+  // Evicts terminal capture results over byte_budget (spilling the successful
+  // ones) and returns how many left result_store_. Core-thread-only.
+  size_t evict_capture_results_over_budget_(uint64_t byte_budget);
+  // Core-side bookkeeping after the provider accepted close_device(): marks
+  // the device closed and drops or orphans its capture planning state.
+  // Returns whether the device record changed. Core-thread-only.
+  bool retire_closed_device_(uint64_t device_instance_id);
   void begin_capture_stream_preemption_(uint64_t capture_id, uint64_t device_instance_id);
   void begin_capture_stream_preemption_for_bundle_(const RigAdmittedRequestBundle& bundle);
   void release_result_safe_capture_stream_preemptions_();
@@ -899,6 +1422,21 @@ private:
   TryTriggerDeviceCaptureStatus trigger_device_capture_with_capture_id_(
       uint64_t device_instance_id,
       uint64_t capture_id);
+  // Re-ingests source as capture_id's default image on device_instance_id:
+  // capture_started, the frame (sharing source's payload bytes) and
+  // capture_completed. Core-thread-only.
+  void ingest_stream_result_as_capture_(const CoreStreamResultData& source,
+                                        uint64_t capture_id,
+                                        uint64_t device_instance_id,
+                                        const CoreRetainedProductionPlan& requested_retained_plan);
+  RigTriggerOrchestrationResult orchestrate_rig_capture_from_stream_frame_set_(
+      uint64_t rig_id,
+      uint64_t capture_id);
+  TryTriggerDeviceCaptureStatus trigger_device_capture_from_stream_history_(
+      uint64_t device_instance_id,
+      uint64_t capture_id,
+      uint64_t stream_id,
+      const ImageAcquisitionTiming& reference);
   RigPreflightResult preflight_rig_participants_materialize_(uint64_t rig_id) const;
   RigAdmittedRequestBundle admit_rig_cohort_from_preflight_(
       uint64_t rig_id,
@@ -907,7 +1445,8 @@ private:
   RigTriggerOrchestrationResult orchestrate_rig_capture_from_preflight_(
       uint64_t rig_id,
       uint64_t capture_id,
-      const RigPreflightResult& preflight);
+      const RigPreflightResult& preflight,
+      uint64_t triggered_steady_ns);
   RigCohortAdmissionFailure grouped_rig_imaging_spec_admission_failure_(
       const RigPreflightResult& preflight) const noexcept;
   RigSubmissionResult submit_admitted_rig_bundle_(const RigAdmittedRequestBundle& bundle);
@@ -915,9 +1454,20 @@ private:
       uint64_t rig_id,
       uint64_t capture_id);
   CaptureAdmissionContext make_capture_admission_context_() const;
+  // external > provider-static merge of a device's camera facts, cached in
+  // resolved_camera_static_facts_.
+  struct ResolvedCameraStaticFacts {
+    CoreStringId hardware_key = 0;
+    uint64_t provider_revision = 0;
+    uint64_t external_revision = 0;
+    std::shared_ptr<const CameraStaticFacts> facts;
+    // The matching external description's facts; null when none matches.
+    std::shared_ptr<const CameraStaticFacts> external;
+  };
+  const ResolvedCameraStaticFacts& resolve_camera_static_facts_(uint64_t device_instance_id);
   CoreResolvedCaptureImageFacts resolve_capture_image_facts_(
       uint64_t capture_id, uint64_t device_instance_id,
-      uint32_t image_member_index) const;
+      uint32_t image_member_index);
   void finalize_completed_capture_facts_(
       uint64_t capture_id, uint64_t device_instance_id);
   bool build_effective_capture_request_without_retained_plan_(
@@ -943,6 +1493,46 @@ private:
   bool refresh_capture_retained_plan_state_(
       uint64_t device_instance_id,
       bool requested_bump_access_posture_epoch);
+  // refresh_capture_retained_plan_state_() without an epoch bump, or queued
+  // for the end of the running setup batch.
+  void refresh_capture_retained_plan_state_or_defer_(uint64_t device_instance_id);
+  // Bodies of the matching try_* commands; core thread only.
+  TryOpenDeviceStatus open_device_on_core_(const std::string& hardware_id,
+                                           uint64_t device_instance_id,
+                                           uint64_t root_id,
+                                           const CaptureTemplate& capture_tmpl);
+  TryCreateStreamStatus create_stream_on_core_(uint64_t stream_id,
+                                               uint64_t device_instance_id,
+                                               StreamIntent intent,
+                                               uint64_t profile_version,
+                                               const StreamTemplate& tmpl,
+                                               const CaptureProfile* request_profile,
+                                               const PictureConfig* request_picture,
+                                               StreamPriority priority);
+  TryStartStreamStatus start_stream_on_core_(uint64_t stream_id);
+  TryStopStreamStatus stop_stream_on_core_(uint64_t stream_id);
+  TryCloseDeviceStatus close_device_on_core_(uint64_t device_instance_id);
+  TryReconfigureStreamStatus reconfigure_stream_on_core_(uint64_t stream_id,
+                                                         const CaptureProfile& profile);
+  // One stream QoS step from on_core_timer_tick(): samples load (or, while
+  // disabled, resets the controller) and moves every stream to the level.
+  void run_stream_qos_(uint64_t now_ns);
+  TrySetStillCaptureProfileStatus set_device_still_capture_profile_on_core_(
+      uint64_t device_instance_id,
+      const CaptureProfile& profile,
+      const CaptureStillImageBundle& still_image_bundle);
+  // Devices whose plan refresh the running setup batch deferred; null
+  // outside a batch. Core thread only.
+  std::vector<uint64_t>* setup_batch_deferred_refreshes_ = nullptr;
+  struct SetupBatchOutcome {
+    TryRunSetupBatchStatus status = TryRunSetupBatchStatus::Busy;
+    std::vector<SetupCommandStatus> statuses;
+  };
+  // Runs one validated setup command; true when it succeeded.
+  bool run_setup_command_on_core_(const SetupCommand& command,
+                                  const CaptureTemplate& capture_tmpl,
+                                  const StreamTemplate& stream_tmpl,
+                                  SetupCommandStatus& status);
   bool sync_capture_parent_priming_(
       uint64_t device_instance_id,
       const CaptureRequest& effective,
@@ -1030,11 +1620,23 @@ private:
       uint64_t device_instance_id,
       uint64_t retire_after_ns);
   size_t retire_expired_capture_retained_plan_orphans_(uint64_t now_ns);
+  // Moves an UNKNOWN-scope byte gauge to bytes, tracking what was last
+  // published. Core thread.
+  void publish_unknown_scope_byte_gauge_(ResourceByteGauge gauge, uint64_t bytes, uint64_t& published) noexcept;
+  // Publishes the pool's free bytes and the process-wide large-page /
+  // fallback payload bytes on the UNKNOWN scope; withdraw moves all three to
+  // zero. Core thread.
+  void publish_payload_buffer_telemetry_(bool withdraw) noexcept;
   void next_capture_retained_plan_orphan_retirement_delay_(
       uint64_t now_ns,
       bool& has_next_delay,
       uint64_t& next_delay_ns) const;
   void account_display_demand_release_async_post_failure_(CoreThread::PostResult result) noexcept;
+  // Recomputes stream_id's StreamPoolDepthHint and sends it to the provider
+  // when it changed. The post_ variant is for the any-thread retention
+  // setters. Core thread / any thread respectively.
+  void refresh_stream_pool_depth_hint_(uint64_t stream_id);
+  void post_stream_pool_depth_hint_refresh_(uint64_t stream_id) noexcept;
   std::vector<SharedCaptureResultData> curate_capture_result_set_accept_all_assembly_successful_(
       std::vector<SharedCaptureResultData> candidates) const;
 
@@ -1055,9 +1657,61 @@ private:
   // by the members above: get_capture_result[_set]() read them directly from
   // the calling (e.g. Godot) thread, so each provides its own internal lock.
   // See the threading-model note on CoreResultStore for the full rationale.
+  // Recyclable full-frame CPU payload buffers. Offered to providers through
+  // ingress_ (acquire_cpu_payload_buffer) and used by result_store_ for
+  // payloads it must copy. Internally locked; declared ahead of both users.
+  CpuPayloadBufferPool cpu_payload_buffer_pool_;
+  // Gauge values last published to the resource telemetry.
+  uint64_t published_pooled_buffer_bytes_ = 0;
+  uint64_t published_large_page_buffer_bytes_ = 0;
+  uint64_t published_large_page_fallback_bytes_ = 0;
   CoreResultStore result_store_;
+  // Background PNG encoder for finalized captures; fed from
+  // finalize_completed_capture_facts_(), stopped after the core thread joins.
+  CoreEncodedImagePool encoded_image_pool_;
+  // Background thumbnail builder, fed and stopped alongside
+  // encoded_image_pool_ (and fed first, so thumbnails are ready soonest).
+  CoreCaptureThumbnailPool capture_thumbnail_pool_;
+  // Background exposure fusion of bracketed captures, fed and stopped
+  // alongside capture_thumbnail_pool_.
+  CoreCaptureFusionPool capture_fusion_pool_;
+  // Second tier for capture results the byte budget evicts; get_capture_result
+  // [_set]() fall back to it. Internally locked, like result_store_; mutable
+  // because a load refreshes its LRU order.
+  mutable CoreCaptureSpillStore capture_spill_store_;
+  // Time-aligned rig stream frame sets, fed by dispatcher_ after stream
+  // retention. Core-thread writer; find_latest() is lock-free for any thread.
+  CoreRigStreamFrameSets rig_stream_frame_sets_{&rigs_, &devices_};
+  // Usage history and pre-warm state behind the warm-hold deadlines (core
+  // thread only); the scratch list is reused across timer ticks.
+  CoreWarmPool warm_pool_;
+  // Capture latency histograms behind the device/rig snapshot sections,
+  // fed from the capture lifecycle timing reports (core thread only).
+  CoreCaptureLatencyStats capture_latency_stats_;
+  // Stream recordings; its I/O thread is stopped after the core thread joins.
+  CoreStreamRecorder stream_recorder_;
+  // Shared-memory stream exports; written on the core thread, closed after
+  // it joins.
+  CoreStreamExporter stream_exporter_;
+  // Per-device frame retention shards (set_frame_shard_count()), started in
+  // on_core_start() and stopped in on_core_stop(); the shard count and the
+  // completion scratch list are core-thread state once running.
+  CoreFrameShards frame_shards_;
+  size_t frame_shard_count_ = 0;
+  // Operations from the *_async() commands waiting on provider facts; the
+  // dispatcher resolves them (core thread only).
+  CoreOperationRegistry operations_;
+  std::vector<CoreFrameShardCompletion> frame_shard_completions_;
+  std::vector<CoreWarmPool::IdleDevice> warm_pool_idle_scratch_;
   CoreCaptureAssemblyRegistry capture_assembly_registry_;
   CoreCaptureCohortRegistry capture_cohort_registry_;
+  // Retention/watchdog deadlines for on_core_timer_tick() (core thread only).
+  CoreDeadlineTable timer_deadlines_;
+  uint64_t timer_deadlines_admission_timeout_ns_ = 0;
+  // Stream QoS (set_stream_qos_enabled()); controller state is core-thread.
+  std::atomic<bool> stream_qos_enabled_{false};
+  CoreStreamQosController stream_qos_;
+  bool stream_qos_sampling_ = false;
 
   // Snapshot header counters (schema v1).
   // gen: core generation counter, monotonic across app/server lifetime.
@@ -1095,6 +1749,14 @@ private:
   // maintainer-tool harness) owns the publisher and must outlive this
   // CoreRuntime instance.
   std::atomic<IStateSnapshotPublisher*> snapshot_publisher_{nullptr};
+  // Core-thread only. Last snapshot handed to a publisher that
+  // wants_snapshot_delta(), when published on the core thread.
+  CoreSnapshotDeltaBase snapshot_delta_base_{};
+  // Snapshot materialization/publication off the core thread
+  // (set_snapshot_publish_offload()); started in on_core_start(), stopped in
+  // on_core_stop().
+  std::atomic<bool> snapshot_publish_offload_{false};
+  CoreSnapshotPublishWorker snapshot_publish_worker_;
 
   // Core-defined epoch for snapshot timestamp_ns (session-relative monotonic).
   // Stored as an atomic nanosecond count (steady_clock::time_since_epoch())
@@ -1135,6 +1797,23 @@ private:
   // frame asynchronously through CBProviderStrand's own thread).
   std::atomic<uint64_t> applying_stream_retained_plan_for_stream_id_{0};
 
+  // IProviderCallbacks::is_stream_display_demand_active() as the ingress
+  // answers it; any thread. CAMBANG_DEV_DISPLAY_DEMAND_TRACE logs each
+  // stream's transitions.
+  bool provider_stream_display_demand_active_(uint64_t stream_id);
+  std::mutex display_demand_trace_mu_;
+  std::map<uint64_t, bool> display_demand_trace_last_;
+
+#if CAMBANG_PROVIDER_BOUND
+  // The bound ingress calls the hooks above and enqueue_provider_fact()
+  // directly (imaging/api/provider_binding.h).
+  friend class ProviderCallbackIngress;
+#endif
+
+  // Live preview wants the newest frame: ingress keeps at most this many
+  // repeating frames queued per stream and supersedes the oldest beyond it.
+  static constexpr uint32_t kLiveFramesQueuedPerStream = 2;
+
   CoreDispatcher dispatcher_;
   ProviderCallbackIngress ingress_;
 
@@ -1295,6 +1974,15 @@ private:
   recent_capture_lifecycle_timing_reports_on_core_thread_() const;
   void note_capture_lifecycle_ingress_(
       const CoreCaptureLifecycleIngressEvent& event);
+  CoreCaptureLifecycleTimingReport* capture_lifecycle_timing_report_(
+      uint64_t capture_id, uint64_t device_instance_id);
+  void note_capture_trigger_timing_(uint64_t capture_id,
+                                    uint64_t device_instance_id,
+                                    uint64_t rig_id,
+                                    uint64_t triggered_steady_ns,
+                                    uint64_t admitted_steady_ns);
+  void record_capture_latency_(const CoreCaptureLifecycleTimingReport& report);
+  void record_rig_capture_latency_(uint64_t capture_id, uint64_t rig_id);
   static RetainedPlanDecisionProvenance build_decision_provenance_(
       const RetainedPlanEvaluatorState& state,
       CoreRetainedProductionPlan selected) noexcept;
@@ -1317,14 +2005,38 @@ private:
   void remember_capture_priming_seed_(
       const CapturePrimingSeedSignature& signature,
       CoreRetainedProductionPlan selected);
+  bool build_retained_plan_prior_key_(
+      const std::string& hardware_id,
+      BackingPlanEvaluationPrimaryFunction primary_function,
+      uint32_t width,
+      uint32_t height,
+      uint32_t format_fourcc,
+      uint32_t image_member_count,
+      ProducerBackingCapabilities runtime_backing_capabilities,
+      ProducerBackingCapabilities parent_context_backing_capabilities,
+      CoreRetainedPlanPriorStore::Key& out) const;
+  bool build_stream_retained_plan_prior_key_(
+      uint64_t device_instance_id,
+      const CaptureProfile& profile,
+      ProducerBackingCapabilities runtime_backing_capabilities,
+      ProducerBackingCapabilities parent_context_backing_capabilities,
+      CoreRetainedPlanPriorStore::Key& out) const;
+  bool build_capture_retained_plan_prior_key_(
+      const CapturePrimingSeedSignature& signature,
+      CoreRetainedPlanPriorStore::Key& out) const;
 
   std::map<uint64_t, RetainedPlanEvaluatorState> stream_retained_plan_evaluators_;
   std::map<CaptureRetainedPlanParentKey, RetainedPlanEvaluatorState>
       capture_retained_plan_evaluators_;
   std::map<uint64_t, RetainedPlanDecisionProvenance> stream_retained_plan_decisions_;
+  // Last ICameraProvider::set_stream_pool_depth_hint() sent per created
+  // stream; a hint goes out only when it changes. Core thread only.
+  std::map<uint64_t, StreamPoolDepthHint> stream_pool_depth_hints_;
   std::map<CaptureRetainedPlanParentKey, RetainedPlanDecisionProvenance>
       capture_retained_plan_decisions_;
   std::map<std::string, CapturePrimingSeed> capture_priming_seeds_;
+  // Loaded in on_core_start(), flushed in on_core_stop().
+  CoreRetainedPlanPriorStore retained_plan_priors_;
   std::map<uint64_t, CaptureParentPrimingState> capture_parent_priming_states_;
 
   struct CaptureStreamPreemptionRecord {
@@ -1351,7 +2063,7 @@ private:
       recent_capture_lifecycle_timing_reports_;
   std::vector<std::pair<uint64_t, uint64_t>>
       recent_capture_lifecycle_timing_order_;
-  std::deque<CoreThread::Task> requests_;
+  std::deque<RequestTask> requests_;
 
   enum class ShutdownPhase : uint8_t {
     NONE = 0,
@@ -1386,6 +2098,12 @@ private:
   char core_banner_line_[192] = {0};
 
   std::atomic<bool> publish_pending_{false};
+  // First publish request since the last build (core thread only); 0 = none.
+  uint64_t publish_requested_ns_ = 0;
+  // Core thread only (configured while stopped).
+  CorePublishPacer publish_pacer_;
+  // The pending publish has already been held back once.
+  bool publish_paced_ = false;
 
   // Publish markers (core thread writes; any thread reads).
   // These do not redefine the snapshot schema; they exist to support the
@@ -1395,20 +2113,66 @@ private:
   std::atomic<uint64_t> create_stream_profile_version_seq_{1};
 
   std::atomic<uint64_t> publish_requests_coalesced_{0};
+  std::atomic<uint64_t> picture_updates_coalesced_{0};
+  std::atomic<uint64_t> snapshot_publishes_paced_{0};
+  std::atomic<uint64_t> snapshot_publish_interval_ns_{0};
   std::atomic<uint64_t> publish_requests_dropped_full_{0};
   std::atomic<uint64_t> publish_requests_dropped_closed_{0};
   std::atomic<uint64_t> publish_requests_dropped_allocfail_{0};
   std::atomic<uint64_t> display_demand_release_async_dropped_full_{0};
   std::atomic<uint64_t> display_demand_release_async_dropped_closed_{0};
   std::atomic<uint64_t> display_demand_release_async_dropped_allocfail_{0};
+  std::atomic<uint64_t> memory_trims_{0};
+  std::atomic<uint64_t> memory_trim_bytes_released_{0};
+  std::atomic<uint64_t> stream_pool_depth_hints_sent_{0};
+  std::atomic<uint64_t> stream_qos_level_{0};
+  std::atomic<uint64_t> stream_qos_level_changes_{0};
+  std::atomic<uint64_t> stream_qos_reconfigurations_{0};
+  // Newest queued picture update per stream / per device, by request seq
+  // (see try_set_stream_picture_config()). An entry lives while any update
+  // for its key is queued: each queued command holds a ticket from
+  // queue_picture_update_() that drops the entry with the last of them,
+  // whether the command ran or was never posted. Guarded by
+  // picture_update_mutex_.
+  struct QueuedPictureUpdates {
+    uint64_t newest_seq = 0;
+    uint32_t queued = 0;
+  };
+  std::mutex picture_update_mutex_;
+  uint64_t picture_update_seq_ = 0;
+  std::map<uint64_t, QueuedPictureUpdates> queued_stream_pictures_;
+  std::map<uint64_t, QueuedPictureUpdates> queued_capture_pictures_;
+  // False on allocation failure, with nothing left queued.
+  bool queue_picture_update_(std::map<uint64_t, QueuedPictureUpdates>& lane,
+                             uint64_t key,
+                             uint64_t& out_seq,
+                             std::shared_ptr<void>& out_ticket) noexcept;
+  // False (and counted as coalesced) when a newer update for key is queued.
+  bool is_newest_picture_update_(const std::map<uint64_t, QueuedPictureUpdates>& lane,
+                                 uint64_t key,
+                                 uint64_t seq) noexcept;
+  // Shared by the text and file ingests; json_text need only outlive the call.
+  IngestCameraConcurrencyResult ingest_camera_concurrency_text_(std::string_view json_text);
+  ReplaceExternalCameraDescriptionResult replace_external_camera_description_text_(
+      std::string_view json_text);
   mutable std::mutex configured_imaging_spec_mutex_;
   uint64_t configured_camera_description_version_ = 0;
   uint64_t configured_imaging_spec_version_ = 0;
   std::vector<uint8_t> configured_imaging_spec_payload_{};
-  std::optional<ExternalCameraDescriptionState> configured_external_camera_description_{};
-  ExternalCameraDescriptionState active_external_camera_description_{};
+  // configured_imaging_spec_payload_ as parsed at ingest.
+  camera_concurrency::Truth configured_imaging_spec_concurrency_{};
+  // Built once per replace; start() publishes the same pointer. Null when
+  // none is configured.
+  SharedExternalCameraDescription configured_external_camera_description_{};
+  ExternalCameraDescriptionSlot active_external_camera_description_{};
+  // The core thread's own reference to what it last published, so fact
+  // resolution reads it without touching the slot.
+  SharedExternalCameraDescription active_external_camera_description_core_{};
   ProviderCameraFactState provider_camera_fact_state_{};
-  uint64_t active_camera_description_version_ = 0;
+  // Keyed by device_instance_id; an entry is rebuilt when the device's
+  // provider static facts or the active external description move. Cleared
+  // with provider_camera_fact_state_.
+  CoreIdMap<ResolvedCameraStaticFacts> resolved_camera_static_facts_{};
   uint64_t next_configured_camera_description_version_ = 1;
   uint64_t next_configured_imaging_spec_version_ = 1;
   mutable std::mutex configured_capture_geolocation_mutex_;
@@ -1436,6 +2200,13 @@ private:
   // kCaptureCohortRetentionWindowNs.
   static constexpr uint64_t kCaptureResultRetentionWindowNs =
       300ull * 1000ull * 1000ull * 1000ull; // 5 minutes
+  // How late the retention sweeps above may run (CoreDeadlineTable slack).
+  // Their windows are seconds to minutes, so a late sweep only holds
+  // retired records a little longer, and one wake serves several sweeps.
+  // While no started stream paces the core thread nothing else wakes it,
+  // so the sweeps wait longer and idle wakeups stay rare.
+  static constexpr uint64_t kRetentionSweepSlackNs = 100ull * 1000ull * 1000ull;       // 100 ms
+  static constexpr uint64_t kIdleRetentionSweepSlackNs = 1000ull * 1000ull * 1000ull;  // 1 s
 
   // Total retained-capture-result byte budget (ledger #53), covering the sum
   // of literal CPU-packed bytes plus an *estimated* GPU-backed footprint
@@ -1454,6 +2225,10 @@ private:
   // exceeded budget is fine here -- see CoreResultStore::evict_over_byte_budget().
   static constexpr uint64_t kCaptureResultByteBudgetBytes =
       500ull * 1024ull * 1024ull; // 500 MiB
+  // Retained capture bytes a MemoryTrimLevel::Moderate trim leaves, so the
+  // most recent results stay in memory while older ones spill.
+  static constexpr uint64_t kCaptureResultTrimModerateFloorBytes =
+      64ull * 1024ull * 1024ull; // 64 MiB
 };
 
 } // namespace cambang
@@ -0,0 +1,115 @@
+// src/core/core_snapshot_publish_worker.cpp
+#include "core/core_snapshot_publish_worker.h"
+
+#include <utility>
+
+#include "core/snapshot/snapshot_delta.h"
+#include "imaging/api/thread_policy.h"
+
+namespace cambang {
+
+void publish_state_snapshot(IStateSnapshotPublisher* pub,
+                            uint32_t sections,
+                            std::shared_ptr<const CamBANGStateSnapshot> snapshot,
+                            CoreSnapshotDeltaBase& base) {
+  if (pub && pub->wants_snapshot_delta()) {
+    // A section coming or going is not a record change; restart the stream.
+    std::shared_ptr<const CamBANGStateSnapshot> from =
+        pub == base.publisher && sections == base.sections ? std::move(base.snapshot) : nullptr;
+    base.snapshot = snapshot;
+    base.publisher = pub;
+    base.sections = sections;
+    pub->publish(std::move(snapshot));
+    if (from) {
+      pub->publish_delta(compute_snapshot_delta(*from, *base.snapshot));
+    }
+    return;
+  }
+  base = CoreSnapshotDeltaBase{};
+  if (pub) {
+    pub->publish(std::move(snapshot));
+  }
+}
+
+CoreSnapshotPublishWorker::~CoreSnapshotPublishWorker() {
+  stop();
+}
+
+bool CoreSnapshotPublishWorker::start(std::function<void()> on_published, std::function<void()> on_slot_free) {
+  if (running()) {
+    return false;
+  }
+  on_published_ = std::move(on_published);
+  on_slot_free_ = std::move(on_slot_free);
+  stop_requested_ = false;
+  try {
+    worker_ = std::thread([this] { worker_main_(); });
+  } catch (...) {
+    return false;
+  }
+  return true;
+}
+
+void CoreSnapshotPublishWorker::stop() noexcept {
+  {
+    std::lock_guard<std::mutex> lock(mu_);
+    stop_requested_ = true;
+  }
+  work_cv_.notify_all();
+  if (worker_.joinable()) {
+    worker_.join();
+  }
+  delta_base_ = CoreSnapshotDeltaBase{};
+}
+
+bool CoreSnapshotPublishWorker::can_submit() noexcept {
+  if (!running()) {
+    return false;
+  }
+  std::lock_guard<std::mutex> lock(mu_);
+  return !waiting_.has_value();
+}
+
+bool CoreSnapshotPublishWorker::try_submit(Job& job) {
+  if (!running()) {
+    return false;
+  }
+  {
+    std::lock_guard<std::mutex> lock(mu_);
+    if (waiting_.has_value()) {
+      return false;
+    }
+    waiting_.emplace(std::move(job));
+  }
+  work_cv_.notify_one();
+  return true;
+}
+
+void CoreSnapshotPublishWorker::worker_main_() noexcept {
+  apply_current_thread_policy(CBThreadRole::Core, "cambang-snappub");
+  for (;;) {
+    Job job;
+    {
+      std::unique_lock<std::mutex> lock(mu_);
+      work_cv_.wait(lock, [this] { return stop_requested_ || waiting_.has_value(); });
+      // A waiting snapshot is still published when stopping: it may be the
+      // final one of the generation.
+      if (!waiting_.has_value()) {
+        return;
+      }
+      job = std::move(*waiting_);
+      waiting_.reset();
+    }
+    if (on_slot_free_) {
+      on_slot_free_();
+    }
+    std::shared_ptr<const CamBANGStateSnapshot> snapshot =
+        std::make_shared<CamBANGStateSnapshot>(SnapshotBuilder::materialize(std::move(job.view)));
+    publish_state_snapshot(job.publisher, job.sections, std::move(snapshot), delta_base_);
+    if (on_published_) {
+      on_published_();
+    }
+  }
+}
+
+} // namespace cambang
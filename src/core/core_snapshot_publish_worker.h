@@ -0,0 +1,91 @@
+// src/core/core_snapshot_publish_worker.h
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+
+#include "core/i_state_snapshot_publisher.h"
+#include "core/snapshot/snapshot_builder.h"
+
+namespace cambang {
+
+// The snapshot a publisher's delta stream continues from (see
+// IStateSnapshotPublisher::wants_snapshot_delta()).
+struct CoreSnapshotDeltaBase {
+  std::shared_ptr<const CamBANGStateSnapshot> snapshot;
+  IStateSnapshotPublisher* publisher = nullptr;
+  uint32_t sections = 0;
+};
+
+// Hands snapshot to pub (may be null), followed by the delta from base when
+// pub wants deltas and base was published to pub with the same sections;
+// then makes snapshot the new base.
+void publish_state_snapshot(IStateSnapshotPublisher* pub,
+                            uint32_t sections,
+                            std::shared_ptr<const CamBANGStateSnapshot> snapshot,
+                            CoreSnapshotDeltaBase& base);
+
+// Opt-in helper thread that materializes and publishes snapshots
+// (CoreRuntime::set_snapshot_publish_offload()).
+//
+// The core thread only captures a SnapshotBuilder::View -- devices and
+// streams rebuilt, every other section an immutable shared vector reused
+// while its registry is unchanged -- and submits it. The worker copies the
+// view into a CamBANGStateSnapshot, computes the delta and calls the
+// publisher, in submission order. One view may wait while another is being
+// published; try_submit() refuses a third, and Core keeps its publish
+// pending until the worker calls on_slot_free, so no version is skipped.
+//
+// Threading: start()/stop()/can_submit()/try_submit() from the core thread;
+// the publisher and the callbacks run on the worker.
+class CoreSnapshotPublishWorker final {
+public:
+  struct Job {
+    SnapshotBuilder::View view;
+    IStateSnapshotPublisher* publisher = nullptr;
+    uint32_t sections = kCBSnapshotSectionsAll;
+  };
+
+  CoreSnapshotPublishWorker() = default;
+  ~CoreSnapshotPublishWorker();
+
+  CoreSnapshotPublishWorker(const CoreSnapshotPublishWorker&) = delete;
+  CoreSnapshotPublishWorker& operator=(const CoreSnapshotPublishWorker&) = delete;
+
+  // on_published runs after each publish (e.g. to advance a sequence
+  // number); on_slot_free when the worker takes the waiting job, so another
+  // may be submitted. False if already running or the thread could not be
+  // started.
+  bool start(std::function<void()> on_published, std::function<void()> on_slot_free);
+  // Publishes the waiting job, if any, then joins the worker. The delta base
+  // is dropped: the next start() begins a new delta stream.
+  void stop() noexcept;
+  bool running() const noexcept { return worker_.joinable(); }
+
+  // Whether try_submit() would accept a job now. Only the submitting thread
+  // fills the slot, so a true answer holds until it submits.
+  bool can_submit() noexcept;
+  // False, leaving job untouched, when not running or a job is already
+  // waiting.
+  bool try_submit(Job& job);
+
+private:
+  void worker_main_() noexcept;
+
+  std::mutex mu_;
+  std::condition_variable work_cv_;
+  std::optional<Job> waiting_;
+  bool stop_requested_ = false;
+  std::thread worker_;
+  std::function<void()> on_published_{};
+  std::function<void()> on_slot_free_{};
+  // Worker-thread only.
+  CoreSnapshotDeltaBase delta_base_{};
+};
+
+} // namespace cambang
@@ -11,14 +11,14 @@ void CoreSpecState::set_camera_spec_version(const std::string& hardware_id, uint
   if (hardware_id.empty()) {
     return;
   }
-  camera_spec_versions_[hardware_id] = camera_spec_version;
+  camera_spec_versions_[global_hardware_id_interner().intern(hardware_id)] = camera_spec_version;
 }
 
 uint64_t CoreSpecState::camera_spec_version(const std::string& hardware_id) const noexcept {
   if (hardware_id.empty()) {
     return 0;
   }
-  const auto it = camera_spec_versions_.find(hardware_id);
+  const auto it = camera_spec_versions_.find(global_hardware_id_interner().find(hardware_id));
   if (it == camera_spec_versions_.end()) {
     return 0;
   }
@@ -39,21 +39,60 @@ void CoreSpecState::set_imaging_spec_concurrency(
   imaging_spec_interpretation_.camera_concurrency = std::move(camera_concurrency);
 }
 
+namespace {
+
+bool copy_effective_spec(SpecPatchView effective_spec, std::vector<uint8_t>& out) {
+  if (effective_spec.size_bytes != 0 && effective_spec.data == nullptr) {
+    return false;
+  }
+  const auto* bytes = static_cast<const uint8_t*>(effective_spec.data);
+  out.assign(bytes, bytes + effective_spec.size_bytes);
+  return true;
+}
+
+} // namespace
+
 bool CoreSpecState::retain_imaging_spec_replace(
     uint64_t imaging_spec_version,
     SpecPatchView effective_spec) {
+  std::vector<uint8_t> payload;
+  return copy_effective_spec(effective_spec, payload) &&
+         retain_imaging_spec_replace(imaging_spec_version, std::move(payload));
+}
+
+bool CoreSpecState::retain_imaging_spec_replace(
+    uint64_t imaging_spec_version,
+    std::vector<uint8_t>&& effective_spec) {
   return retain_imaging_spec_payload_(
       imaging_spec_version,
-      effective_spec,
+      std::move(effective_spec),
       ImagingSpecRetentionKind::Replace);
 }
 
+void CoreSpecState::retain_imaging_spec_replace(
+    uint64_t imaging_spec_version,
+    std::vector<uint8_t>&& effective_spec,
+    camera_concurrency::Truth camera_concurrency) noexcept {
+  imaging_spec_version_ = imaging_spec_version;
+  imaging_spec_retention_kind_ = ImagingSpecRetentionKind::Replace;
+  imaging_spec_payload_ = std::move(effective_spec);
+  imaging_spec_interpretation_.camera_concurrency = std::move(camera_concurrency);
+}
+
 bool CoreSpecState::retain_imaging_spec_patch(
     uint64_t imaging_spec_version,
     SpecPatchView effective_spec) {
+  std::vector<uint8_t> payload;
+  return copy_effective_spec(effective_spec, payload) &&
+         retain_imaging_spec_patch(imaging_spec_version, std::move(payload));
+}
+
+bool CoreSpecState::retain_imaging_spec_patch(
+    uint64_t imaging_spec_version,
+    std::vector<uint8_t>&& effective_spec) {
   return retain_imaging_spec_payload_(
       imaging_spec_version,
-      effective_spec,
+      std::move(effective_spec),
       ImagingSpecRetentionKind::Patch);
 }
 
@@ -71,36 +110,36 @@ std::vector<uint8_t> CoreSpecState::imaging_spec_payload_copy() const {
   return imaging_spec_payload_;
 }
 
-CoreSpecState::ImagingSpecInterpretation
+const CoreSpecState::ImagingSpecInterpretation&
 CoreSpecState::interpret_imaging_spec() const noexcept {
   return imaging_spec_interpretation_;
 }
 
 bool CoreSpecState::retain_imaging_spec_payload_(
     uint64_t imaging_spec_version,
-    SpecPatchView effective_spec,
+    std::vector<uint8_t>&& effective_spec,
     ImagingSpecRetentionKind retention_kind) {
-  if (effective_spec.size_bytes != 0 && effective_spec.data == nullptr) {
-    return false;
+  if (effective_spec.empty()) {
+    imaging_spec_version_ = imaging_spec_version;
+    imaging_spec_retention_kind_ = retention_kind;
+    imaging_spec_payload_.clear();
+    imaging_spec_interpretation_ = {};
+    return true;
   }
 
-  ImagingSpecInterpretation next_interpretation{};
-  std::vector<uint8_t> next_payload{};
-  if (effective_spec.size_bytes != 0) {
-    const camera_concurrency::LoadResult load =
-        camera_concurrency::load_truth_from_adc_json_payload(effective_spec);
-    if (!load.ok) {
-      return false;
-    }
-    next_interpretation.camera_concurrency = load.truth;
-    const auto* bytes = static_cast<const uint8_t*>(effective_spec.data);
-    next_payload.assign(bytes, bytes + effective_spec.size_bytes);
+  camera_concurrency::LoadResult load = camera_concurrency::load_truth_from_adc_json_payload(
+      SpecPatchView{effective_spec.data(), effective_spec.size()},
+      imaging_spec_interpretation_.camera_concurrency.source_key);
+  if (!load.ok) {
+    return false;
   }
 
   imaging_spec_version_ = imaging_spec_version;
   imaging_spec_retention_kind_ = retention_kind;
-  imaging_spec_payload_ = std::move(next_payload);
-  imaging_spec_interpretation_ = std::move(next_interpretation);
+  imaging_spec_payload_ = std::move(effective_spec);
+  if (!load.unchanged) {
+    imaging_spec_interpretation_.camera_concurrency = std::move(load.truth);
+  }
   return true;
 }
 
@@ -3,10 +3,11 @@
 #include <cstdint>
 #include <optional>
 #include <string>
-#include <unordered_map>
 #include <vector>
 
 #include "core/camera_concurrency_adc.h"
+#include "core/core_id_map.h"
+#include "core/core_string_interner.h"
 #include "imaging/api/provider_contract_datatypes.h"
 
 namespace cambang {
@@ -32,12 +33,24 @@ public:
       uint64_t imaging_spec_version,
       camera_concurrency::Truth camera_concurrency) noexcept;
   uint64_t imaging_spec_version() const noexcept { return imaging_spec_version_; }
+  // A patch re-derives the interpretation only when the members it depends
+  // on changed; otherwise the retained interpretation carries over and only
+  // the payload and version move. The vector overloads take the payload
+  // without copying it.
   bool retain_imaging_spec_replace(uint64_t imaging_spec_version, SpecPatchView effective_spec);
+  bool retain_imaging_spec_replace(uint64_t imaging_spec_version, std::vector<uint8_t>&& effective_spec);
+  // A replace whose payload the caller has already interpreted (e.g. parsed
+  // off the core thread at ingest): takes both without parsing again.
+  void retain_imaging_spec_replace(
+      uint64_t imaging_spec_version,
+      std::vector<uint8_t>&& effective_spec,
+      camera_concurrency::Truth camera_concurrency) noexcept;
   bool retain_imaging_spec_patch(uint64_t imaging_spec_version, SpecPatchView effective_spec);
+  bool retain_imaging_spec_patch(uint64_t imaging_spec_version, std::vector<uint8_t>&& effective_spec);
   bool has_imaging_spec_payload() const noexcept { return !imaging_spec_payload_.empty(); }
   SpecPatchView imaging_spec_payload() const noexcept;
   std::vector<uint8_t> imaging_spec_payload_copy() const;
-  ImagingSpecInterpretation interpret_imaging_spec() const noexcept;
+  const ImagingSpecInterpretation& interpret_imaging_spec() const noexcept;
   ImagingSpecRetentionKind imaging_spec_retention_kind() const noexcept {
     return imaging_spec_retention_kind_;
   }
@@ -45,10 +58,11 @@ public:
 private:
   bool retain_imaging_spec_payload_(
       uint64_t imaging_spec_version,
-      SpecPatchView effective_spec,
+      std::vector<uint8_t>&& effective_spec,
       ImagingSpecRetentionKind retention_kind);
 
-  std::unordered_map<std::string, uint64_t> camera_spec_versions_;
+  // Keyed by global_hardware_id_interner() id.
+  CoreIdMap<uint64_t> camera_spec_versions_;
   uint64_t imaging_spec_version_ = 0;
   std::vector<uint8_t> imaging_spec_payload_{};
   ImagingSpecRetentionKind imaging_spec_retention_kind_ = ImagingSpecRetentionKind::None;
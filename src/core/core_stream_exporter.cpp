@@ -0,0 +1,255 @@
+// src/core/core_stream_exporter.cpp
+#include "core/core_stream_exporter.h"
+
+#include "imaging/api/shared_memory.h"
+
+#include <atomic>
+#include <cstring>
+#include <limits>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace cambang {
+
+namespace {
+
+constexpr char kRegionMagic[8] = {'C', 'B', 'S', 'H', 'M', 'F', 'R', '\0'};
+constexpr int64_t kNoAcquisitionTime = std::numeric_limits<int64_t>::min();
+
+// Ring header field offsets.
+constexpr size_t kRhPublished = 56;
+
+// Slot header field offsets.
+constexpr size_t kSlSequence = 0;
+constexpr size_t kSlRetainedFrameId = 8;
+constexpr size_t kSlPayloadBytes = 16;
+constexpr size_t kSlWidth = 24;
+constexpr size_t kSlHeight = 28;
+constexpr size_t kSlFourcc = 32;
+constexpr size_t kSlStride = 36;
+constexpr size_t kSlPlaneCount = 40;
+constexpr size_t kSlFlags = 44;          // bit 0: acquisition timing present
+constexpr size_t kSlPlaneOffsets = 48;   // u64 x kMaxFramePlanes
+constexpr size_t kSlPlaneStrides = 72;   // u32 x kMaxFramePlanes
+constexpr size_t kSlAcquisitionTime = 88;
+constexpr size_t kSlTiming = 96;         // mark, tick numerator, tick denominator (i64)
+constexpr size_t kSlTimingEnums = 120;   // clock domain, reference event, comparability, origin (u8)
+
+static_assert(kSlTimingEnums + 4 <= CoreStreamExporter::kSlotHeaderBytes);
+static_assert(kSlPlaneOffsets + 8 * kMaxFramePlanes <= kSlPlaneStrides);
+static_assert(kSlPlaneStrides + 4 * kMaxFramePlanes <= kSlAcquisitionTime);
+// The publish counter and slot sequences are std::atomic objects living in
+// the region, so they must be address-free for a reader in another process.
+static_assert(std::atomic<uint64_t>::is_always_lock_free);
+
+template <typename T>
+void put(uint8_t* buf, size_t offset, T value) noexcept {
+  static_assert(std::is_integral_v<T>);
+  using U = std::make_unsigned_t<T>;
+  U v = static_cast<U>(value);
+  for (size_t i = 0; i < sizeof(T); ++i) {
+    buf[offset + i] = static_cast<uint8_t>(v >> (8 * i));
+  }
+}
+
+uint64_t aligned(uint64_t offset) noexcept {
+  const uint64_t a = CoreStreamExporter::kAlignment;
+  return (offset + a - 1) / a * a;
+}
+
+std::atomic<uint64_t>& atomic_at(uint8_t* base, size_t offset) noexcept {
+  return *std::launder(reinterpret_cast<std::atomic<uint64_t>*>(base + offset));
+}
+
+// Everything in the slot header but the sequence.
+void encode_slot_header(const CoreStreamResultData& result, uint8_t* slot) noexcept {
+  std::memset(slot + 8, 0, CoreStreamExporter::kSlotHeaderBytes - 8);
+  const CoreResultPayloadCpuPacked& payload = result.payload;
+  put(slot, kSlRetainedFrameId, result.retained_frame_id);
+  put(slot, kSlPayloadBytes, static_cast<uint64_t>(payload.size_bytes()));
+  put(slot, kSlWidth, payload.width);
+  put(slot, kSlHeight, payload.height);
+  put(slot, kSlFourcc, payload.format_fourcc);
+  put(slot, kSlStride, payload.stride_bytes);
+  put(slot, kSlPlaneCount, payload.plane_count);
+  for (uint32_t i = 0; i < kMaxFramePlanes; ++i) {
+    put(slot, kSlPlaneOffsets + 8 * i, static_cast<uint64_t>(payload.planes[i].offset_bytes));
+    put(slot, kSlPlaneStrides + 4 * i, payload.planes[i].row_stride_bytes);
+  }
+
+  int64_t time_ns = kNoAcquisitionTime;
+  const CaptureImageFacts& facts = result.image_facts;
+  if (facts.acquisition_timing) {
+    const ImageAcquisitionTiming& timing = facts.acquisition_timing->value;
+    put(slot, kSlFlags, uint32_t{1});
+    put(slot, kSlTiming, timing.acquisition_mark());
+    put(slot, kSlTiming + 8, timing.tick_period().numerator_ns());
+    put(slot, kSlTiming + 16, timing.tick_period().denominator());
+    slot[kSlTimingEnums] = static_cast<uint8_t>(timing.clock_domain());
+    slot[kSlTimingEnums + 1] = static_cast<uint8_t>(timing.reference_event());
+    slot[kSlTimingEnums + 2] = static_cast<uint8_t>(timing.comparability());
+    slot[kSlTimingEnums + 3] = static_cast<uint8_t>(facts.acquisition_timing->origin);
+    int64_t ns = 0;
+    if (image_acquisition_time_ns(timing, ns)) {
+      time_ns = ns;
+    }
+  }
+  put(slot, kSlAcquisitionTime, time_ns);
+}
+
+} // namespace
+
+struct CoreStreamExporter::Export {
+  std::string name;
+  CBSharedMemoryRegion region;
+  uint64_t slot_stride = 0;
+  uint64_t payload_capacity = 0;
+  // Core thread only.
+  uint64_t published = 0;
+  // Guarded by the exporter's mu_.
+  Stats stats{};
+
+  uint8_t* slot(uint64_t frame_number) const noexcept {
+    return region.data() + kRingHeaderBytes + slot_stride * ((frame_number - 1) % kSlotCount);
+  }
+};
+
+CoreStreamExporter::CoreStreamExporter() = default;
+
+CoreStreamExporter::~CoreStreamExporter() {
+  stop_all();
+}
+
+bool CoreStreamExporter::start(uint64_t stream_id,
+                               uint64_t device_instance_id,
+                               const std::string& name,
+                               size_t max_payload_bytes) {
+  if (stream_id == 0 || max_payload_bytes == 0 || active_.count(stream_id) != 0) {
+    return false;
+  }
+  auto exp = std::make_unique<Export>();
+  exp->name = name;
+  exp->payload_capacity = aligned(max_payload_bytes);
+  exp->slot_stride = kSlotHeaderBytes + exp->payload_capacity;
+  const uint64_t region_bytes = kRingHeaderBytes + exp->slot_stride * kSlotCount;
+  if (region_bytes > std::numeric_limits<size_t>::max() ||
+      !exp->region.open(name, static_cast<size_t>(region_bytes))) {
+    return false;
+  }
+
+  uint8_t* base = exp->region.data();
+  std::memcpy(base, kRegionMagic, sizeof(kRegionMagic));
+  put(base, 8, kFormatVersion);
+  put(base, 12, kRingHeaderBytes);
+  put(base, 16, stream_id);
+  put(base, 24, device_instance_id);
+  put(base, 32, kSlotCount);
+  put(base, 36, kSlotHeaderBytes);
+  put(base, 40, exp->slot_stride);
+  put(base, 48, exp->payload_capacity);
+  new (base + kRhPublished) std::atomic<uint64_t>(0);
+  for (uint64_t n = 1; n <= kSlotCount; ++n) {
+    new (exp->slot(n) + kSlSequence) std::atomic<uint64_t>(0);
+  }
+
+  std::lock_guard<std::mutex> lock(mu_);
+  active_.emplace(stream_id, std::move(exp));
+  return true;
+}
+
+bool CoreStreamExporter::stop(uint64_t stream_id, Stats* out) {
+  std::unique_ptr<Export> exp;
+  {
+    std::lock_guard<std::mutex> lock(mu_);
+    const auto it = active_.find(stream_id);
+    if (it == active_.end()) {
+      return false;
+    }
+    exp = std::move(it->second);
+    active_.erase(it);
+  }
+  if (out) {
+    *out = exp->stats;
+  }
+  return true;
+}
+
+bool CoreStreamExporter::stats(uint64_t stream_id, Stats& out) const {
+  std::lock_guard<std::mutex> lock(mu_);
+  const auto it = active_.find(stream_id);
+  if (it == active_.end()) {
+    return false;
+  }
+  out = it->second->stats;
+  return true;
+}
+
+bool CoreStreamExporter::handles(uint64_t stream_id, Handles& out) const {
+  std::lock_guard<std::mutex> lock(mu_);
+  const auto it = active_.find(stream_id);
+  if (it == active_.end()) {
+    return false;
+  }
+  const Export& exp = *it->second;
+  out.name = exp.name;
+  out.region_bytes = exp.region.size();
+  out.memory_fd = exp.region.memory_fd();
+  out.event_fd = exp.region.event_fd();
+  return true;
+}
+
+bool CoreStreamExporter::exporting(uint64_t stream_id) const noexcept {
+  std::lock_guard<std::mutex> lock(mu_);
+  return active_.count(stream_id) != 0;
+}
+
+void CoreStreamExporter::on_stream_result(const SharedStreamResultData& result) {
+  // Only the core thread changes active_, so this unlocked lookup is safe.
+  if (!has_exports() || !result) {
+    return;
+  }
+  const auto it = active_.find(result->stream_id);
+  if (it == active_.end()) {
+    return;
+  }
+  Export& exp = *it->second;
+  const CoreResultPayloadCpuPacked& payload = result->payload;
+  if (!has_current_cpu_payload(*result)) {
+    std::lock_guard<std::mutex> lock(mu_);
+    ++exp.stats.frames_skipped_no_cpu_payload;
+    return;
+  }
+  if (payload.size_bytes() > exp.payload_capacity) {
+    std::lock_guard<std::mutex> lock(mu_);
+    ++exp.stats.frames_skipped_too_large;
+    return;
+  }
+
+  const uint64_t n = exp.published + 1;
+  uint8_t* slot = exp.slot(n);
+  std::atomic<uint64_t>& sequence = atomic_at(slot, kSlSequence);
+  sequence.store(2 * n - 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  encode_slot_header(*result, slot);
+  // The one copy: retained payload straight into the slot.
+  std::memcpy(slot + kSlotHeaderBytes, payload.data(), payload.size_bytes());
+  sequence.store(2 * n, std::memory_order_release);
+  atomic_at(exp.region.data(), kRhPublished).store(n, std::memory_order_release);
+  exp.published = n;
+  exp.region.signal();
+
+  std::lock_guard<std::mutex> lock(mu_);
+  ++exp.stats.frames_exported;
+  exp.stats.bytes_exported += payload.size_bytes();
+}
+
+void CoreStreamExporter::stop_all() noexcept {
+  std::map<uint64_t, std::unique_ptr<Export>> closing;
+  {
+    std::lock_guard<std::mutex> lock(mu_);
+    closing.swap(active_);
+  }
+}
+
+} // namespace cambang
@@ -0,0 +1,105 @@
+// src/core/core_stream_exporter.h
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "core/core_result_store.h"
+
+namespace cambang {
+
+class CBSharedMemoryRegion;
+
+// Publishes a stream's retained CPU results into a shared-memory ring that
+// another process (an inference worker, say) maps and reads in place.
+//
+// While an export is attached, every stream result Core retains for the
+// stream is copied once, straight from the retained buffer, into the next
+// ring slot, and the region's event is signalled. The copy happens on the
+// core thread as the result is retained, so a consumer sees the frame as
+// soon as Core does. Results with no current CPU payload and payloads
+// larger than the slot capacity are skipped and counted.
+//
+// Region layout (little-endian, 64-byte aligned; offsets in bytes):
+//
+//   ring header  kRingHeaderBytes: "CBSHMFR\0", version, header size,
+//                stream_id, device_instance_id, slot count, slot header
+//                size, slot stride, payload capacity, then at 56 the u64
+//                publish counter (frames published so far)
+//   slots        kSlotCount x slot stride, each a kSlotHeaderBytes header
+//                (u64 sequence at 0, then retained_frame_id, payload size,
+//                geometry, plane layout, acquisition timing) and the payload
+//
+// Frame n (1-based) goes to slot (n - 1) % kSlotCount. Its slot sequence is
+// 2n - 1 while it is written and 2n once complete, so a reader loads the
+// publish counter n, checks the slot sequence is 2n, copies what it needs,
+// and accepts the copy only if the sequence is still 2n (seqlock). A
+// reader kSlotCount frames behind simply sees a newer frame.
+//
+// Threading: start()/stop()/on_stream_result() from the core thread;
+// stats()/handles() from any thread.
+class CoreStreamExporter final {
+public:
+  static constexpr uint32_t kSlotCount = 3;
+  static constexpr uint32_t kAlignment = 64;
+  static constexpr uint32_t kRingHeaderBytes = 64;
+  static constexpr uint32_t kSlotHeaderBytes = 128;
+  static constexpr uint32_t kFormatVersion = 1;
+
+  struct Stats {
+    uint64_t frames_exported = 0;
+    uint64_t bytes_exported = 0;
+    // No current CPU payload on the retained result.
+    uint64_t frames_skipped_no_cpu_payload = 0;
+    // Payload larger than the slot capacity.
+    uint64_t frames_skipped_too_large = 0;
+  };
+
+  // How a consumer reaches an export's region (see CBSharedMemoryRegion).
+  struct Handles {
+    std::string name;
+    size_t region_bytes = 0;
+    // Linux/Android descriptors in this process; -1 elsewhere.
+    int memory_fd = -1;
+    int event_fd = -1;
+  };
+
+  CoreStreamExporter();
+  ~CoreStreamExporter();
+
+  CoreStreamExporter(const CoreStreamExporter&) = delete;
+  CoreStreamExporter& operator=(const CoreStreamExporter&) = delete;
+
+  // Creates the region name with slots for payloads of up to
+  // max_payload_bytes and attaches it to stream_id. False if an export is
+  // already attached or the region could not be created.
+  bool start(uint64_t stream_id,
+             uint64_t device_instance_id,
+             const std::string& name,
+             size_t max_payload_bytes);
+  // Detaches and closes stream_id's region; out (when given) receives its
+  // final counts. False when none is attached.
+  bool stop(uint64_t stream_id, Stats* out = nullptr);
+  bool stats(uint64_t stream_id, Stats& out) const;
+  bool handles(uint64_t stream_id, Handles& out) const;
+  bool exporting(uint64_t stream_id) const noexcept;
+  // Core thread only.
+  bool has_exports() const noexcept { return !active_.empty(); }
+
+  void on_stream_result(const SharedStreamResultData& result);
+
+  void stop_all() noexcept;
+
+private:
+  struct Export;
+
+  mutable std::mutex mu_;
+  // Core-thread lookup; guarded by mu_ for stats()/handles() readers.
+  std::map<uint64_t, std::unique_ptr<Export>> active_;
+};
+
+} // namespace cambang
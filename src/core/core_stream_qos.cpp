@@ -0,0 +1,91 @@
+// src/core/core_stream_qos.cpp
+
+#include "core/core_stream_qos.h"
+
+#include <algorithm>
+
+namespace cambang {
+
+namespace {
+
+uint32_t scaled_fps(uint32_t fps, uint32_t divisor) noexcept {
+  return fps == 0 ? 0 : std::max<uint32_t>(1, fps / divisor);
+}
+
+uint32_t halved_dimension(uint32_t v) noexcept {
+  return std::max<uint32_t>(2, (v / 2) & ~1u);
+}
+
+} // namespace
+
+uint8_t CoreStreamQosController::sample(uint64_t now_ns, const LoadCounters& counters) noexcept {
+  const bool went_backwards = counters.ingress_frames_dropped < last_.ingress_frames_dropped ||
+                              counters.producer_frames_dropped < last_.producer_frames_dropped ||
+                              counters.core_busy_ns < last_.core_busy_ns;
+  if (!primed_ || went_backwards || now_ns <= last_sample_ns_) {
+    primed_ = true;
+    last_sample_ns_ = now_ns;
+    last_ = counters;
+    return level_;
+  }
+
+  const uint64_t period_ns = now_ns - last_sample_ns_;
+  const bool dropped = counters.ingress_frames_dropped != last_.ingress_frames_dropped ||
+                       counters.producer_frames_dropped != last_.producer_frames_dropped;
+  const uint64_t busy_ns = counters.core_busy_ns - last_.core_busy_ns;
+  // busy / period in permille without overflowing on long periods.
+  const uint64_t busy_permille = busy_ns >= period_ns ? 1000 : (busy_ns * 1000) / period_ns;
+  last_sample_ns_ = now_ns;
+  last_ = counters;
+
+  if (dropped || busy_permille >= kBusyHighPermille) {
+    calm_run_ = 0;
+    if (++overloaded_run_ >= kDegradeAfterSamples && level_ < kMaxLevel) {
+      ++level_;
+      ++level_changes_;
+      overloaded_run_ = 0;
+    }
+  } else if (busy_permille < kBusyLowPermille) {
+    overloaded_run_ = 0;
+    if (++calm_run_ >= kRestoreAfterSamples && level_ > 0) {
+      --level_;
+      ++level_changes_;
+      calm_run_ = 0;
+    }
+  } else {
+    // Between the thresholds: hold the level and restart both runs.
+    overloaded_run_ = 0;
+    calm_run_ = 0;
+  }
+  return level_;
+}
+
+void CoreStreamQosController::reset() noexcept {
+  primed_ = false;
+  last_sample_ns_ = 0;
+  last_ = {};
+  if (level_ != 0) {
+    ++level_changes_;
+  }
+  level_ = 0;
+  overloaded_run_ = 0;
+  calm_run_ = 0;
+}
+
+CaptureProfile stream_qos_profile(const CaptureProfile& baseline, uint8_t level) noexcept {
+  CaptureProfile p = baseline;
+  level = std::min(level, CoreStreamQosController::kMaxLevel);
+  if (level == 0) {
+    return p;
+  }
+  const uint32_t fps_divisor = level >= 3 ? 4 : 2;
+  p.target_fps_min = scaled_fps(baseline.target_fps_min, fps_divisor);
+  p.target_fps_max = scaled_fps(baseline.target_fps_max, fps_divisor);
+  if (level >= 2) {
+    p.width = halved_dimension(baseline.width);
+    p.height = halved_dimension(baseline.height);
+  }
+  return p;
+}
+
+} // namespace cambang
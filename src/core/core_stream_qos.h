@@ -0,0 +1,70 @@
+// src/core/core_stream_qos.h
+#pragma once
+
+#include <cstdint>
+
+#include "imaging/api/provider_contract_datatypes.h"
+
+namespace cambang {
+
+// Opt-in load-adaptive quality of service for repeating streams
+// (CoreRuntime::set_stream_qos_enabled()).
+//
+// Once per sample period Core feeds the controller cumulative load counters:
+// frames dropped at provider->core ingress because it was full, frames the
+// provider dropped before handing them over
+// (ICameraProvider::producer_frames_dropped_total()) and core-thread busy
+// time. A sample is overloaded when either drop counter moved or the core
+// thread was busy for at least kBusyHighPermille of the period, and calm when
+// neither counter moved and busy time stayed under kBusyLowPermille.
+// kDegradeAfterSamples overloaded samples in a row step the level up;
+// kRestoreAfterSamples calm samples in a row step it back down. The gap
+// between the two thresholds and the longer restore run keep a load that
+// hovers near capacity from flapping the streams.
+//
+// Each level maps a stream's own profile to a cheaper one
+// (stream_qos_profile()); Core applies it through in-place reconfiguration.
+//
+// Not thread-safe (core thread).
+class CoreStreamQosController final {
+public:
+  static constexpr uint8_t kMaxLevel = 3;
+  static constexpr uint64_t kSamplePeriodNs = 1'000'000'000ull;
+  static constexpr uint32_t kBusyHighPermille = 850;
+  static constexpr uint32_t kBusyLowPermille = 500;
+  static constexpr uint32_t kDegradeAfterSamples = 2;
+  static constexpr uint32_t kRestoreAfterSamples = 5;
+
+  struct LoadCounters {
+    uint64_t ingress_frames_dropped = 0;
+    uint64_t producer_frames_dropped = 0;
+    uint64_t core_busy_ns = 0;
+  };
+
+  // Returns the level after this sample. The first sample after reset(), or
+  // after a counter went backwards (provider swap), only records the counters
+  // the next sample is measured against.
+  uint8_t sample(uint64_t now_ns, const LoadCounters& counters) noexcept;
+  void reset() noexcept;
+
+  uint8_t level() const noexcept { return level_; }
+  uint64_t level_changes() const noexcept { return level_changes_; }
+
+private:
+  bool primed_ = false;
+  uint64_t last_sample_ns_ = 0;
+  LoadCounters last_{};
+  uint8_t level_ = 0;
+  uint32_t overloaded_run_ = 0;
+  uint32_t calm_run_ = 0;
+  uint64_t level_changes_ = 0;
+};
+
+// `baseline` lowered to `level`: 1 halves the frame rate, 2 also halves both
+// dimensions, 3 quarters the frame rate at half size. An unbounded rate
+// (target_fps_max == 0) stays unbounded; halved dimensions stay even and
+// non-zero. Level 0 (or above kMaxLevel, clamped) returns `baseline`
+// unchanged apart from the clamp.
+CaptureProfile stream_qos_profile(const CaptureProfile& baseline, uint8_t level) noexcept;
+
+} // namespace cambang
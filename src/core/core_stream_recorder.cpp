@@ -0,0 +1,530 @@
+// src/core/core_stream_recorder.cpp
+#include "core/core_stream_recorder.h"
+
+#include "imaging/api/thread_policy.h"
+
+#include <array>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+namespace cambang {
+
+namespace {
+
+constexpr char kFileMagic[8] = {'C', 'B', 'S', 'T', 'R', 'E', 'C', '\0'};
+constexpr char kTrailerMagic[8] = {'C', 'B', 'S', 'T', 'E', 'N', 'D', '\0'};
+constexpr uint32_t kFrameMagic = 0x52464243u; // "CBFR"
+constexpr uint32_t kIndexMagic = 0x58494243u; // "CBIX"
+constexpr uint32_t kIndexHeaderBytes = 16;
+constexpr uint32_t kIndexEntryBytes = 16;
+constexpr int64_t kNoAcquisitionTime = std::numeric_limits<int64_t>::min();
+
+// Frame header field offsets.
+constexpr size_t kFrPayloadBytes = 8;
+constexpr size_t kFrFrameIndex = 16;
+constexpr size_t kFrRetainedFrameId = 24;
+constexpr size_t kFrWidth = 32;
+constexpr size_t kFrHeight = 36;
+constexpr size_t kFrFourcc = 40;
+constexpr size_t kFrStride = 44;
+constexpr size_t kFrPlaneCount = 48;
+constexpr size_t kFrFactFlags = 52;
+constexpr size_t kFrPlaneOffsets = 56;  // u64 x kMaxFramePlanes
+constexpr size_t kFrPlaneStrides = 80;  // u32 x kMaxFramePlanes
+constexpr size_t kFrTiming = 96;        // mark, tick numerator, tick denominator (i64)
+constexpr size_t kFrTimingEnums = 120;  // clock domain, reference event, comparability, origin (u8)
+constexpr size_t kFrAcquisitionTime = 128;
+constexpr size_t kFrValues = 136;       // exposure ns, ISO, f-number, focal mm, focus m (f64)
+constexpr size_t kFrFocusKind = 176;
+constexpr size_t kFrTransform = 177;    // rotation / 90, mirrored, pixels transformed (u8)
+constexpr size_t kFrOrigins = 180;      // exposure, ISO, aperture, focal, focus, transform (u8)
+
+enum FactFlag : uint32_t {
+  kHasTiming = 1u << 0,
+  kHasExposure = 1u << 1,
+  kHasIso = 1u << 2,
+  kHasAperture = 1u << 3,
+  kHasFocalLength = 1u << 4,
+  kHasFocus = 1u << 5,
+  kHasTransform = 1u << 6,
+};
+
+static_assert(kFrOrigins + 6 <= CoreStreamRecorder::kFrameHeaderBytes);
+static_assert(kFrPlaneOffsets + 8 * kMaxFramePlanes <= kFrPlaneStrides);
+static_assert(kFrPlaneStrides + 4 * kMaxFramePlanes <= kFrTiming);
+
+template <typename T>
+void put(uint8_t* buf, size_t offset, T value) noexcept {
+  static_assert(std::is_integral_v<T>);
+  using U = std::make_unsigned_t<T>;
+  U v = static_cast<U>(value);
+  for (size_t i = 0; i < sizeof(T); ++i) {
+    buf[offset + i] = static_cast<uint8_t>(v >> (8 * i));
+  }
+}
+
+void put_f64(uint8_t* buf, size_t offset, double value) noexcept {
+  uint64_t bits = 0;
+  std::memcpy(&bits, &value, sizeof(bits));
+  put(buf, offset, bits);
+}
+
+template <typename T>
+T get(const uint8_t* buf, size_t offset) noexcept {
+  using U = std::make_unsigned_t<T>;
+  U v = 0;
+  for (size_t i = 0; i < sizeof(T); ++i) {
+    v |= static_cast<U>(static_cast<U>(buf[offset + i]) << (8 * i));
+  }
+  return static_cast<T>(v);
+}
+
+uint64_t aligned(uint64_t offset) noexcept {
+  const uint64_t a = CoreStreamRecorder::kAlignment;
+  return (offset + a - 1) / a * a;
+}
+
+void put_fact(uint8_t* header, FactOrigin origin, size_t value_offset, size_t origin_offset, double value) noexcept {
+  put_f64(header, value_offset, value);
+  header[origin_offset] = static_cast<uint8_t>(origin);
+}
+
+// Returns the acquisition time written (kNoAcquisitionTime when unknown).
+int64_t encode_frame_header(const CoreStreamResultData& result, uint64_t frame_index, uint8_t* header) noexcept {
+  std::memset(header, 0, CoreStreamRecorder::kFrameHeaderBytes);
+  const CoreResultPayloadCpuPacked& payload = result.payload;
+  put(header, 0, kFrameMagic);
+  put(header, 4, CoreStreamRecorder::kFrameHeaderBytes);
+  put(header, kFrPayloadBytes, static_cast<uint64_t>(payload.size_bytes()));
+  put(header, kFrFrameIndex, frame_index);
+  put(header, kFrRetainedFrameId, result.retained_frame_id);
+  put(header, kFrWidth, payload.width);
+  put(header, kFrHeight, payload.height);
+  put(header, kFrFourcc, payload.format_fourcc);
+  put(header, kFrStride, payload.stride_bytes);
+  put(header, kFrPlaneCount, payload.plane_count);
+  for (uint32_t i = 0; i < kMaxFramePlanes; ++i) {
+    put(header, kFrPlaneOffsets + 8 * i, static_cast<uint64_t>(payload.planes[i].offset_bytes));
+    put(header, kFrPlaneStrides + 4 * i, payload.planes[i].row_stride_bytes);
+  }
+
+  const CaptureImageFacts& facts = result.image_facts;
+  uint32_t flags = 0;
+  int64_t time_ns = kNoAcquisitionTime;
+  if (facts.acquisition_timing) {
+    const ImageAcquisitionTiming& timing = facts.acquisition_timing->value;
+    flags |= kHasTiming;
+    put(header, kFrTiming, timing.acquisition_mark());
+    put(header, kFrTiming + 8, timing.tick_period().numerator_ns());
+    put(header, kFrTiming + 16, timing.tick_period().denominator());
+    header[kFrTimingEnums] = static_cast<uint8_t>(timing.clock_domain());
+    header[kFrTimingEnums + 1] = static_cast<uint8_t>(timing.reference_event());
+    header[kFrTimingEnums + 2] = static_cast<uint8_t>(timing.comparability());
+    header[kFrTimingEnums + 3] = static_cast<uint8_t>(facts.acquisition_timing->origin);
+    int64_t ns = 0;
+    if (image_acquisition_time_ns(timing, ns)) {
+      time_ns = ns;
+    }
+  }
+  put(header, kFrAcquisitionTime, time_ns);
+
+  if (facts.exposure_time) {
+    flags |= kHasExposure;
+    put_fact(header, facts.exposure_time->origin, kFrValues, kFrOrigins, facts.exposure_time->value.nanoseconds());
+  }
+  if (facts.sensor_sensitivity_iso) {
+    flags |= kHasIso;
+    put_fact(header, facts.sensor_sensitivity_iso->origin, kFrValues + 8, kFrOrigins + 1,
+             facts.sensor_sensitivity_iso->value.iso_equivalent());
+  }
+  if (facts.aperture_f_number) {
+    flags |= kHasAperture;
+    put_fact(header, facts.aperture_f_number->origin, kFrValues + 16, kFrOrigins + 2,
+             facts.aperture_f_number->value.f_number());
+  }
+  if (facts.focal_length_mm) {
+    flags |= kHasFocalLength;
+    put_fact(header, facts.focal_length_mm->origin, kFrValues + 24, kFrOrigins + 3,
+             facts.focal_length_mm->value.millimetres());
+  }
+  if (facts.focus_state) {
+    // 1: at distance, 2: at infinity, 3: unknown.
+    double distance_m = 0.0;
+    if (const auto* at = std::get_if<FocusAtDistance>(&facts.focus_state->value)) {
+      distance_m = at->distance_m();
+    }
+    flags |= kHasFocus;
+    put_fact(header, facts.focus_state->origin, kFrValues + 32, kFrOrigins + 4, distance_m);
+    header[kFrFocusKind] = static_cast<uint8_t>(facts.focus_state->value.index() + 1);
+  }
+  if (facts.realized_image_transform) {
+    const RealizedImageTransform& t = facts.realized_image_transform->value;
+    flags |= kHasTransform;
+    header[kFrTransform] = static_cast<uint8_t>(static_cast<uint16_t>(t.rotation) / 90);
+    header[kFrTransform + 1] = t.mirrored ? 1 : 0;
+    header[kFrTransform + 2] = t.pixels_already_transformed ? 1 : 0;
+    header[kFrOrigins + 5] = static_cast<uint8_t>(facts.realized_image_transform->origin);
+  }
+  put(header, kFrFactFlags, flags);
+  return time_ns;
+}
+
+} // namespace
+
+class CoreStreamRecorder::Recording {
+public:
+  uint64_t stream_id = 0;
+  std::ofstream out;
+  uint64_t next_offset = 0;
+  uint64_t next_frame_index = 0;
+  uint64_t last_index_offset = 0;
+  // (record offset, acquisition time) of the frames since the last index.
+  std::vector<std::pair<uint64_t, int64_t>> chunk;
+  // Guarded by the recorder's mu_.
+  Stats stats{};
+
+  bool write(const void* data, size_t size) {
+    out.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+    next_offset += size;
+    return static_cast<bool>(out);
+  }
+
+  bool pad() {
+    static constexpr std::array<uint8_t, kAlignment> zeros{};
+    const uint64_t to = aligned(next_offset);
+    return to == next_offset || write(zeros.data(), static_cast<size_t>(to - next_offset));
+  }
+
+  bool write_chunk_index() {
+    std::vector<uint8_t> block(kIndexHeaderBytes + kIndexEntryBytes * chunk.size());
+    put(block.data(), 0, kIndexMagic);
+    put(block.data(), 4, static_cast<uint32_t>(chunk.size()));
+    put(block.data(), 8, last_index_offset);
+    for (size_t i = 0; i < chunk.size(); ++i) {
+      put(block.data(), kIndexHeaderBytes + kIndexEntryBytes * i, chunk[i].first);
+      put(block.data(), kIndexHeaderBytes + kIndexEntryBytes * i + 8, chunk[i].second);
+    }
+    const uint64_t offset = next_offset;
+    if (!write(block.data(), block.size()) || !pad()) {
+      return false;
+    }
+    last_index_offset = offset;
+    chunk.clear();
+    return true;
+  }
+};
+
+CoreStreamRecorder::~CoreStreamRecorder() {
+  stop();
+}
+
+bool CoreStreamRecorder::start(uint64_t stream_id,
+                               uint64_t device_instance_id,
+                               const std::filesystem::path& path) {
+  if (stream_id == 0 || path.empty() || active_.count(stream_id) != 0) {
+    return false;
+  }
+  auto recording = std::make_shared<Recording>();
+  recording->stream_id = stream_id;
+  recording->out.open(path, std::ios::out | std::ios::binary | std::ios::trunc);
+  if (!recording->out) {
+    return false;
+  }
+  uint8_t header[kFileHeaderBytes]{};
+  std::memcpy(header, kFileMagic, sizeof(kFileMagic));
+  put(header, 8, kFormatVersion);
+  put(header, 12, kFileHeaderBytes);
+  put(header, 16, stream_id);
+  put(header, 24, device_instance_id);
+  put(header, 32, kAlignment);
+  put(header, 36, kFramesPerChunk);
+  if (!recording->write(header, sizeof(header))) {
+    return false;
+  }
+
+  std::lock_guard<std::mutex> lock(mu_);
+  if (!worker_.joinable()) {
+    stop_requested_ = false;
+    try {
+      worker_ = std::thread([this] { worker_main_(); });
+    } catch (...) {
+      return false;
+    }
+  }
+  active_.emplace(stream_id, std::move(recording));
+  return true;
+}
+
+CoreStreamRecorder::SharedRecording CoreStreamRecorder::detach(uint64_t stream_id) {
+  SharedRecording recording;
+  {
+    std::lock_guard<std::mutex> lock(mu_);
+    const auto it = active_.find(stream_id);
+    if (it == active_.end()) {
+      return nullptr;
+    }
+    recording = std::move(it->second);
+    active_.erase(it);
+    queue_.push_back(Job{recording, nullptr, true});
+  }
+  work_cv_.notify_one();
+  return recording;
+}
+
+CoreStreamRecorder::Stats CoreStreamRecorder::wait_finished(const SharedRecording& recording) {
+  std::unique_lock<std::mutex> lock(mu_);
+  finished_cv_.wait(lock, [&] { return recording->stats.finished; });
+  return recording->stats;
+}
+
+bool CoreStreamRecorder::stats(uint64_t stream_id, Stats& out) const {
+  std::lock_guard<std::mutex> lock(mu_);
+  const auto it = active_.find(stream_id);
+  if (it == active_.end()) {
+    return false;
+  }
+  out = it->second->stats;
+  return true;
+}
+
+bool CoreStreamRecorder::recording(uint64_t stream_id) const noexcept {
+  std::lock_guard<std::mutex> lock(mu_);
+  return active_.count(stream_id) != 0;
+}
+
+void CoreStreamRecorder::on_stream_result(const SharedStreamResultData& result) {
+  // Only the core thread changes active_, so this unlocked check is safe.
+  if (!has_recordings() || !result) {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(mu_);
+    const auto it = active_.find(result->stream_id);
+    if (it == active_.end()) {
+      return;
+    }
+    Stats& stats = it->second->stats;
+    if (!has_current_cpu_payload(*result)) {
+      ++stats.frames_skipped_no_cpu_payload;
+      return;
+    }
+    if (stats.io_error) {
+      ++stats.frames_dropped_io_error;
+      return;
+    }
+    if (queued_frames_ >= kMaxQueuedFrames) {
+      ++stats.frames_dropped_queue_full;
+      return;
+    }
+    queue_.push_back(Job{it->second, result, false});
+    ++queued_frames_;
+  }
+  work_cv_.notify_one();
+}
+
+void CoreStreamRecorder::stop() noexcept {
+  {
+    std::lock_guard<std::mutex> lock(mu_);
+    for (auto& [stream_id, recording] : active_) {
+      (void)stream_id;
+      queue_.push_back(Job{std::move(recording), nullptr, true});
+    }
+    active_.clear();
+    stop_requested_ = true;
+  }
+  work_cv_.notify_one();
+  if (worker_.joinable()) {
+    worker_.join();
+  }
+}
+
+void CoreStreamRecorder::worker_main_() noexcept {
+  apply_current_thread_policy(CBThreadRole::Background, "cambang-record");
+  std::unique_lock<std::mutex> lock(mu_);
+  for (;;) {
+    work_cv_.wait(lock, [this] { return stop_requested_ || !queue_.empty(); });
+    if (queue_.empty()) {
+      return;
+    }
+    Job job = std::move(queue_.front());
+    queue_.pop_front();
+    Recording& rec = *job.recording;
+    const bool failed = rec.stats.io_error;
+
+    if (job.finish) {
+      lock.unlock();
+      bool ok = !failed;
+      if (ok) {
+        ok = rec.write_chunk_index();
+      }
+      if (ok) {
+        uint8_t trailer[kTrailerBytes]{};
+        std::memcpy(trailer, kTrailerMagic, sizeof(kTrailerMagic));
+        put(trailer, 8, rec.last_index_offset);
+        put(trailer, 16, rec.next_frame_index);
+        lock.lock();
+        const Stats s = rec.stats;
+        lock.unlock();
+        put(trailer, 24, s.frames_dropped_queue_full + s.frames_dropped_io_error);
+        put(trailer, 32, s.frames_skipped_no_cpu_payload);
+        ok = rec.write(trailer, sizeof(trailer));
+      }
+      rec.out.close();
+      lock.lock();
+      rec.stats.io_error = rec.stats.io_error || !ok || !rec.out;
+      rec.stats.finished = true;
+      finished_cv_.notify_all();
+      continue;
+    }
+
+    --queued_frames_;
+    if (failed) {
+      ++rec.stats.frames_dropped_io_error;
+      continue;
+    }
+    lock.unlock();
+    // Written from the retained payload itself; the job's reference keeps
+    // the bytes alive until the write returns.
+    const CoreResultPayloadCpuPacked& payload = job.frame->payload;
+    const uint64_t record_offset = rec.next_offset;
+    uint8_t header[kFrameHeaderBytes];
+    const int64_t time_ns = encode_frame_header(*job.frame, rec.next_frame_index, header);
+    bool ok = rec.write(header, sizeof(header)) && rec.write(payload.data(), payload.size_bytes()) && rec.pad();
+    if (ok) {
+      ++rec.next_frame_index;
+      rec.chunk.emplace_back(record_offset, time_ns);
+      if (rec.chunk.size() >= kFramesPerChunk) {
+        ok = rec.write_chunk_index();
+      }
+    }
+    const uint64_t bytes = payload.size_bytes();
+    job.frame.reset();
+    lock.lock();
+    if (ok) {
+      ++rec.stats.frames_written;
+      rec.stats.bytes_written += bytes;
+    } else {
+      rec.stats.io_error = true;
+      ++rec.stats.frames_dropped_io_error;
+    }
+  }
+}
+
+namespace {
+
+bool read_at(std::ifstream& in, uint64_t offset, uint8_t* out, size_t size) {
+  in.clear();
+  in.seekg(static_cast<std::streamoff>(offset));
+  return static_cast<bool>(in.read(reinterpret_cast<char*>(out), static_cast<std::streamsize>(size)));
+}
+
+bool read_frame(std::ifstream& in, uint64_t offset, StreamRecordingIndexEntry& out) {
+  uint8_t header[CoreStreamRecorder::kFrameHeaderBytes];
+  if (!read_at(in, offset, header, sizeof(header)) || get<uint32_t>(header, 0) != kFrameMagic ||
+      get<uint32_t>(header, 4) != CoreStreamRecorder::kFrameHeaderBytes) {
+    return false;
+  }
+  out = StreamRecordingIndexEntry{};
+  out.record_offset = offset;
+  out.payload_offset = offset + CoreStreamRecorder::kFrameHeaderBytes;
+  out.payload_bytes = get<uint64_t>(header, kFrPayloadBytes);
+  out.frame_index = get<uint64_t>(header, kFrFrameIndex);
+  out.retained_frame_id = get<uint64_t>(header, kFrRetainedFrameId);
+  out.width = get<uint32_t>(header, kFrWidth);
+  out.height = get<uint32_t>(header, kFrHeight);
+  out.format_fourcc = get<uint32_t>(header, kFrFourcc);
+  const int64_t time_ns = get<int64_t>(header, kFrAcquisitionTime);
+  out.has_acquisition_time = time_ns != kNoAcquisitionTime;
+  out.acquisition_time_ns = out.has_acquisition_time ? time_ns : 0;
+  return true;
+}
+
+} // namespace
+
+bool read_stream_recording_index(const std::filesystem::path& path, StreamRecordingIndex& out) try {
+  out = StreamRecordingIndex{};
+  std::ifstream in(path, std::ios::in | std::ios::binary);
+  uint8_t header[CoreStreamRecorder::kFileHeaderBytes];
+  if (!in || !read_at(in, 0, header, sizeof(header)) ||
+      std::memcmp(header, kFileMagic, sizeof(kFileMagic)) != 0 ||
+      get<uint32_t>(header, 8) != CoreStreamRecorder::kFormatVersion) {
+    return false;
+  }
+  out.stream_id = get<uint64_t>(header, 16);
+  out.device_instance_id = get<uint64_t>(header, 24);
+
+  std::error_code ec;
+  const uint64_t file_bytes = std::filesystem::file_size(path, ec);
+  if (ec) {
+    return false;
+  }
+
+  uint8_t trailer[CoreStreamRecorder::kTrailerBytes];
+  if (file_bytes >= CoreStreamRecorder::kFileHeaderBytes + CoreStreamRecorder::kTrailerBytes &&
+      read_at(in, file_bytes - sizeof(trailer), trailer, sizeof(trailer)) &&
+      std::memcmp(trailer, kTrailerMagic, sizeof(kTrailerMagic)) == 0) {
+    // Walk the chunk indexes back from the last one.
+    std::vector<std::vector<uint64_t>> chunks;
+    for (uint64_t index_offset = get<uint64_t>(trailer, 8); index_offset != 0;) {
+      uint8_t index_header[kIndexHeaderBytes];
+      if (index_offset >= file_bytes || !read_at(in, index_offset, index_header, sizeof(index_header)) ||
+          get<uint32_t>(index_header, 0) != kIndexMagic) {
+        return false;
+      }
+      const uint32_t count = get<uint32_t>(index_header, 4);
+      std::vector<uint8_t> entries(static_cast<size_t>(count) * kIndexEntryBytes);
+      if (!entries.empty() && !read_at(in, index_offset + kIndexHeaderBytes, entries.data(), entries.size())) {
+        return false;
+      }
+      std::vector<uint64_t> offsets(count);
+      for (uint32_t i = 0; i < count; ++i) {
+        offsets[i] = get<uint64_t>(entries.data(), static_cast<size_t>(i) * kIndexEntryBytes);
+      }
+      chunks.push_back(std::move(offsets));
+      const uint64_t previous = get<uint64_t>(index_header, 8);
+      if (previous >= index_offset) {
+        return false;
+      }
+      index_offset = previous;
+    }
+    for (auto chunk = chunks.rbegin(); chunk != chunks.rend(); ++chunk) {
+      for (const uint64_t offset : *chunk) {
+        StreamRecordingIndexEntry entry{};
+        if (!read_frame(in, offset, entry)) {
+          return false;
+        }
+        out.frames.push_back(entry);
+      }
+    }
+    out.frames_dropped = get<uint64_t>(trailer, 24);
+    out.complete = true;
+    return true;
+  }
+
+  // No trailer: scan frame records, stepping over chunk indexes.
+  for (uint64_t offset = CoreStreamRecorder::kFileHeaderBytes; offset + 8 <= file_bytes;) {
+    uint8_t block[kIndexHeaderBytes];
+    if (!read_at(in, offset, block, sizeof(block))) {
+      break;
+    }
+    if (get<uint32_t>(block, 0) == kIndexMagic) {
+      offset = aligned(offset + kIndexHeaderBytes + uint64_t{kIndexEntryBytes} * get<uint32_t>(block, 4));
+      continue;
+    }
+    StreamRecordingIndexEntry entry{};
+    if (!read_frame(in, offset, entry) || entry.payload_offset + entry.payload_bytes > file_bytes) {
+      break;
+    }
+    out.frames.push_back(entry);
+    offset = aligned(entry.payload_offset + entry.payload_bytes);
+  }
+  return true;
+} catch (...) {
+  return false;
+}
+
+} // namespace cambang
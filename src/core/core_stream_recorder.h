@@ -0,0 +1,146 @@
+// src/core/core_stream_recorder.h
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "core/core_result_store.h"
+
+namespace cambang {
+
+// Records a stream's retained CPU results to disk for offline analysis.
+//
+// While a recording is attached, every stream result Core retains for the
+// stream is queued, holding the result itself: its payload bytes are kept
+// alive by reference and written straight from the retained buffer by a
+// dedicated I/O thread, never copied first. The queue is bounded
+// (kMaxQueuedFrames over all recordings, each entry pinning one frame);
+// a frame arriving while it is full is dropped and counted. Results with
+// no current CPU payload (GPU-only postures) are skipped and counted.
+//
+// Container (little-endian, every block starting at a kAlignment boundary,
+// so the file can be memory-mapped and a payload read in place):
+//
+//   file header   kFileHeaderBytes: "CBSTREC\0", version, header size,
+//                 stream_id, device_instance_id, alignment, frames per chunk
+//   frame record  kFrameHeaderBytes header (geometry, plane layout,
+//                 acquisition timing, CaptureImageFacts), then the payload
+//   chunk index   after every kFramesPerChunk frames and at finish: "CBIX",
+//                 entry count, the previous chunk index's offset, then each
+//                 frame's record offset and acquisition time
+//   trailer       kTrailerBytes at finish: "CBSTEND\0", offset of the last
+//                 chunk index, frame and drop counts
+//
+// Frame records are self-describing, so a file cut short (no trailer) can
+// still be read by scanning them; read_stream_recording_index() does both.
+//
+// Threading: start()/detach()/on_stream_result() from the core thread;
+// wait_finished()/stats() from any thread; stop() from the owner with the
+// core thread stopped.
+class CoreStreamRecorder final {
+public:
+  static constexpr size_t kMaxQueuedFrames = 32;
+  static constexpr uint32_t kFramesPerChunk = 64;
+  static constexpr uint32_t kAlignment = 64;
+  static constexpr uint32_t kFileHeaderBytes = 64;
+  static constexpr uint32_t kFrameHeaderBytes = 192;
+  static constexpr uint32_t kTrailerBytes = 64;
+  static constexpr uint32_t kFormatVersion = 1;
+
+  struct Stats {
+    uint64_t frames_written = 0;
+    uint64_t bytes_written = 0;
+    // Queue full when the frame arrived.
+    uint64_t frames_dropped_queue_full = 0;
+    // No current CPU payload on the retained result.
+    uint64_t frames_skipped_no_cpu_payload = 0;
+    // Lost to a write error; the recording stops writing at the first one.
+    uint64_t frames_dropped_io_error = 0;
+    bool io_error = false;
+    bool finished = false;
+  };
+
+  class Recording;
+  using SharedRecording = std::shared_ptr<Recording>;
+
+  CoreStreamRecorder() = default;
+  ~CoreStreamRecorder();
+
+  CoreStreamRecorder(const CoreStreamRecorder&) = delete;
+  CoreStreamRecorder& operator=(const CoreStreamRecorder&) = delete;
+
+  // Creates path (replacing any file there) and attaches a recording to
+  // stream_id. False if one is already attached or the file or I/O thread
+  // could not be created.
+  bool start(uint64_t stream_id, uint64_t device_instance_id, const std::filesystem::path& path);
+  // Detaches stream_id's recording; the I/O thread writes what is queued,
+  // then the index and trailer. Null when none is attached.
+  SharedRecording detach(uint64_t stream_id);
+  // Blocks until a detached recording is complete on disk.
+  Stats wait_finished(const SharedRecording& recording);
+  bool stats(uint64_t stream_id, Stats& out) const;
+  bool recording(uint64_t stream_id) const noexcept;
+  // Core thread only.
+  bool has_recordings() const noexcept { return !active_.empty(); }
+
+  void on_stream_result(const SharedStreamResultData& result);
+
+  // Finishes every recording, queued frames included, and joins the thread.
+  void stop() noexcept;
+
+private:
+  struct Job {
+    SharedRecording recording;
+    SharedStreamResultData frame;
+    // Write the index and trailer and close.
+    bool finish = false;
+  };
+
+  void worker_main_() noexcept;
+
+  mutable std::mutex mu_;
+  std::condition_variable work_cv_;
+  std::condition_variable finished_cv_;
+  // Core-thread lookup; guarded by mu_ for stats() readers.
+  std::map<uint64_t, SharedRecording> active_;
+  std::deque<Job> queue_;
+  size_t queued_frames_ = 0;
+  bool stop_requested_ = false;
+  std::thread worker_;
+};
+
+// One frame of a recording, as read back from its index.
+struct StreamRecordingIndexEntry {
+  uint64_t record_offset = 0;
+  uint64_t payload_offset = 0;
+  uint64_t payload_bytes = 0;
+  uint64_t frame_index = 0;
+  uint64_t retained_frame_id = 0;
+  uint32_t width = 0;
+  uint32_t height = 0;
+  uint32_t format_fourcc = 0;
+  bool has_acquisition_time = false;
+  int64_t acquisition_time_ns = 0;
+};
+
+struct StreamRecordingIndex {
+  uint64_t stream_id = 0;
+  uint64_t device_instance_id = 0;
+  // False when the file has no trailer and was read by scanning.
+  bool complete = false;
+  uint64_t frames_dropped = 0;
+  std::vector<StreamRecordingIndexEntry> frames;
+};
+
+// False when path is not a stream recording.
+bool read_stream_recording_index(const std::filesystem::path& path, StreamRecordingIndex& out);
+
+} // namespace cambang
@@ -9,7 +9,8 @@ namespace cambang {
 namespace {
 bool same_retained_plan(CoreRetainedProductionPlan a,
                         CoreRetainedProductionPlan b) noexcept {
-  return a.valid == b.valid && (!a.valid || a.posture == b.posture);
+  return a.valid == b.valid &&
+         (!a.valid || (a.posture == b.posture && a.cpu_sidecar_downscale == b.cpu_sidecar_downscale));
 }
 
 void apply_stream_started(CoreStreamRegistry::StreamRecord& rec, uint64_t access_posture_epoch) noexcept {
@@ -34,6 +35,28 @@ void apply_stream_stopped(CoreStreamRegistry::StreamRecord& rec,
       : CoreStreamRegistry::StopOrigin::Provider;
   rec.stop_requested_by_core = false;
   rec.access_posture_epoch = 0;
+  rec.reconfigure_pending_since_ns = 0;
+  rec.arrival_pacing.restart();
+}
+
+// Pacing source for integration-time arrivals; acquisition times use
+// 1 + their clock domain.
+constexpr uint32_t kPacingSourceIntegration = 0;
+
+uint64_t arrival_pacing_time_ns(const FrameView& frame, uint64_t integrated_ts_ns, uint32_t& out_source) noexcept {
+  out_source = kPacingSourceIntegration;
+  if (!frame.acquisition_timing) {
+    return integrated_ts_ns;
+  }
+  const ImageAcquisitionTiming& timing = frame.acquisition_timing->value;
+  int64_t time_ns = 0;
+  if (timing.comparability() == ImageAcquisitionComparability::SAME_IMAGE_ONLY ||
+      timing.comparability() == ImageAcquisitionComparability::ORDERING_ONLY ||
+      !image_acquisition_time_ns(timing, time_ns)) {
+    return integrated_ts_ns;
+  }
+  out_source = 1u + static_cast<uint32_t>(timing.clock_domain());
+  return static_cast<uint64_t>(time_ns);
 }
 
 void increment_saturating(uint32_t& value) noexcept {
@@ -60,12 +83,15 @@ bool CoreStreamRegistry::declare_stream_effective(
   rec.stream_id = effective.stream_id;
   rec.device_instance_id = effective.device_instance_id;
   rec.intent = effective.intent;
+  rec.priority = effective.priority;
   rec.profile_version = effective.profile_version;
   rec.access_posture_epoch = allocate_access_posture_epoch();
   rec.profile = effective.profile;
   rec.picture = effective.picture;
-  rec.requested_retained_plan = effective.requested_retained_plan;
+  rec.requested_retained_plan =
+      stream_retained_plan_for_profile(effective.requested_retained_plan, effective.profile);
   rec.steady_retained_plan = steady_retained_plan;
+  note_stream_set_changed_();
   // created/started are driven by provider callbacks and core-directed
   // synchronous lifecycle reconciliation.
   return true;
@@ -84,6 +110,7 @@ bool CoreStreamRegistry::on_stream_created(uint64_t stream_id) {
       return false;
     }
     it = streams_.emplace(stream_id, StreamRecord{}).first;
+    note_stream_set_changed_();
   }
   auto& rec = it->second;
   if (rec.created) {
@@ -108,6 +135,7 @@ bool CoreStreamRegistry::on_stream_created(uint64_t stream_id) {
 
 bool CoreStreamRegistry::on_stream_destroyed(uint64_t stream_id) {
   destroyed_stream_tombstones_.insert(stream_id);
+  note_stream_set_changed_();
   return streams_.erase(stream_id) > 0;
 }
 
@@ -116,6 +144,7 @@ bool CoreStreamRegistry::on_core_stream_started(uint64_t stream_id) {
   if (it == streams_.end()) return false;
   apply_stream_started(it->second, allocate_access_posture_epoch());
   increment_saturating(it->second.pending_core_start_facts);
+  note_frame_period_inputs_changed_();
   return true;
 }
 
@@ -134,6 +163,7 @@ bool CoreStreamRegistry::on_provider_stream_started(uint64_t stream_id) {
     return true;
   }
   apply_stream_started(rec, allocate_access_posture_epoch());
+  note_frame_period_inputs_changed_();
   return true;
 }
 
@@ -142,6 +172,7 @@ bool CoreStreamRegistry::on_core_stream_stopped(uint64_t stream_id, uint32_t err
   if (it == streams_.end()) return false;
   apply_stream_stopped(it->second, error_code, StopOrigin::User);
   increment_saturating(it->second.pending_core_stop_facts);
+  note_frame_period_inputs_changed_();
   return true;
 }
 
@@ -155,6 +186,7 @@ bool CoreStreamRegistry::on_provider_stream_stopped(uint64_t stream_id, uint32_t
     return true;
   }
   apply_stream_stopped(rec, error_code, StopOrigin::Provider);
+  note_frame_period_inputs_changed_();
   return true;
 }
 
@@ -165,11 +197,35 @@ bool CoreStreamRegistry::mark_stop_requested_by_core(uint64_t stream_id) {
   return true;
 }
 
-bool CoreStreamRegistry::on_frame_received(uint64_t stream_id, uint64_t integrated_ts_ns) {
+bool CoreStreamRegistry::on_frame_received(uint64_t stream_id,
+                                           uint64_t integrated_ts_ns,
+                                           const FrameView& frame) {
   auto it = streams_.find(stream_id);
   if (it == streams_.end()) return false;
   it->second.frames_received++;
   it->second.last_frame_ts_ns = integrated_ts_ns;
+  uint32_t pacing_source = kPacingSourceIntegration;
+  const uint64_t pacing_time_ns = arrival_pacing_time_ns(frame, integrated_ts_ns, pacing_source);
+  it->second.arrival_pacing.record(pacing_time_ns, pacing_source);
+  return true;
+}
+
+bool CoreStreamRegistry::on_frame_geometry(uint64_t stream_id,
+                                           uint32_t width,
+                                           uint32_t height,
+                                           uint32_t format_fourcc,
+                                           uint64_t integrated_ts_ns) {
+  auto it = streams_.find(stream_id);
+  if (it == streams_.end() || it->second.reconfigure_pending_since_ns == 0) return false;
+  StreamRecord& rec = it->second;
+  if (width != rec.profile.width || height != rec.profile.height ||
+      (rec.profile.format_fourcc != 0 && format_fourcc != rec.profile.format_fourcc)) {
+    return false;
+  }
+  rec.last_reconfigure_latency_ns = integrated_ts_ns > rec.reconfigure_pending_since_ns
+      ? integrated_ts_ns - rec.reconfigure_pending_since_ns
+      : 0;
+  rec.reconfigure_pending_since_ns = 0;
   return true;
 }
 
@@ -218,6 +274,38 @@ bool CoreStreamRegistry::set_picture(uint64_t stream_id, const PictureConfig& pi
   return true;
 }
 
+bool CoreStreamRegistry::on_stream_reconfigured(uint64_t stream_id,
+                                                const CaptureProfile& profile,
+                                                uint64_t profile_version,
+                                                uint64_t now_ns) {
+  auto it = streams_.find(stream_id);
+  if (it == streams_.end()) return false;
+  StreamRecord& rec = it->second;
+  rec.profile = profile;
+  rec.profile_version = profile_version;
+  rec.requested_retained_plan = stream_retained_plan_for_profile(rec.requested_retained_plan, profile);
+  rec.access_posture_epoch = allocate_access_posture_epoch();
+  rec.reconfigurations++;
+  note_frame_period_inputs_changed_();
+  // A stopped stream has no frame to wait for; its next start is not a
+  // reconfiguration.
+  rec.reconfigure_pending_since_ns = rec.started ? (now_ns != 0 ? now_ns : 1) : 0;
+  return true;
+}
+
+bool CoreStreamRegistry::set_qos_state(uint64_t stream_id,
+                                       uint8_t qos_level,
+                                       uint8_t qos_attempted_level,
+                                       const CaptureProfile& qos_baseline_profile) {
+  auto it = streams_.find(stream_id);
+  if (it == streams_.end()) return false;
+  StreamRecord& rec = it->second;
+  rec.qos_level = qos_level;
+  rec.qos_attempted_level = qos_attempted_level;
+  rec.qos_baseline_profile = qos_baseline_profile;
+  return true;
+}
+
 bool CoreStreamRegistry::set_backing_capabilities(
     uint64_t stream_id,
     ProducerBackingCapabilities runtime_backing_capabilities,
@@ -239,6 +327,7 @@ bool CoreStreamRegistry::set_requested_retained_plan(
   auto it = streams_.find(stream_id);
   if (it == streams_.end()) return false;
   auto& rec = it->second;
+  requested_retained_plan = stream_retained_plan_for_profile(requested_retained_plan, rec.profile);
   const bool changed = !same_retained_plan(rec.requested_retained_plan,
                                            requested_retained_plan);
   rec.requested_retained_plan = requested_retained_plan;
@@ -266,6 +355,7 @@ bool CoreStreamRegistry::clear_steady_retained_plan(uint64_t stream_id) {
 
 bool CoreStreamRegistry::forget_stream(uint64_t stream_id) {
   destroyed_stream_tombstones_.insert(stream_id);
+  note_stream_set_changed_();
   return streams_.erase(stream_id) != 0;
 }
 
@@ -310,4 +400,44 @@ bool CoreStreamRegistry::has_error_stream_for_device(uint64_t device_instance_id
   return false;
 }
 
+uint64_t CoreStreamRegistry::shortest_started_frame_period_ns() const noexcept {
+  if (!frame_period_dirty_) {
+    return shortest_started_frame_period_ns_;
+  }
+  uint64_t shortest = 0;
+  for (const auto& [stream_id, rec] : streams_) {
+    (void)stream_id;
+    if (!rec.created || !rec.started || rec.profile.target_fps_max == 0) {
+      continue;
+    }
+    const uint64_t period_ns = 1'000'000'000ull / rec.profile.target_fps_max;
+    if (shortest == 0 || period_ns < shortest) {
+      shortest = period_ns;
+    }
+  }
+  shortest_started_frame_period_ns_ = shortest;
+  frame_period_dirty_ = false;
+  return shortest;
+}
+
+bool CoreStreamRegistry::has_mixed_stream_priorities() const noexcept {
+  if (!priority_mix_dirty_) {
+    return mixed_stream_priorities_;
+  }
+  bool mixed = false;
+  const StreamRecord* first = nullptr;
+  for (const auto& [stream_id, rec] : streams_) {
+    (void)stream_id;
+    if (!first) {
+      first = &rec;
+    } else if (rec.priority != first->priority) {
+      mixed = true;
+      break;
+    }
+  }
+  mixed_stream_priorities_ = mixed;
+  priority_mix_dirty_ = false;
+  return mixed;
+}
+
 } // namespace cambang
@@ -3,9 +3,10 @@
 
 #include <cstdint>
 #include <set>
-#include <map>
 
+#include "core/core_frame_pacing.h"
 #include "core/core_frame_sink.h"
+#include "core/core_id_map.h"
 #include "imaging/api/provider_contract_datatypes.h"
 
 namespace cambang {
@@ -32,6 +33,7 @@ public:
 
     uint64_t device_instance_id = 0;
     StreamIntent intent = StreamIntent::PREVIEW;
+    StreamPriority priority = StreamPriority::NORMAL;
     uint64_t profile_version = 0;
     uint64_t access_posture_epoch = 0;
     CoreRetainedProductionPlan requested_retained_plan{};
@@ -56,6 +58,26 @@ public:
     // including Stage C repeating stream-frame coalescing before expensive dispatch.
     uint64_t frames_dropped = 0;
     uint64_t last_frame_ts_ns = 0;
+    // Inter-arrival timing of every received frame, dropped ones included,
+    // by acquisition time where the frame has one comparable across frames,
+    // else by integration time. The chain restarts when the stream stops.
+    CoreFramePacing arrival_pacing{};
+
+    // Live reconfiguration (CoreRuntime::try_reconfigure_stream()): set when
+    // a reconfiguration of a started stream commits, cleared by the first
+    // frame at the new geometry, whose integration time gives the latency.
+    uint64_t reconfigure_pending_since_ns = 0;
+    uint64_t reconfigurations = 0;
+    uint64_t last_reconfigure_latency_ns = 0;
+
+    // Stream QoS (CoreStreamQosController): the level `profile` is lowered
+    // to, and the profile asked for through try_reconfigure_stream() /
+    // creation that it was lowered from (meaningful while qos_level > 0).
+    // qos_attempted_level is the last level applied or refused, so a level
+    // the provider refused is not retried on every sample.
+    uint8_t qos_level = 0;
+    uint8_t qos_attempted_level = 0;
+    CaptureProfile qos_baseline_profile{};
 
     uint64_t visibility_frames_presented = 0;
     uint64_t visibility_frames_rejected_unsupported = 0;
@@ -85,16 +107,32 @@ public:
   bool mark_stop_requested_by_core(uint64_t stream_id);
 
   // Frame accounting (stream must exist).
-  bool on_frame_received(uint64_t stream_id, uint64_t integrated_ts_ns);
+  bool on_frame_received(uint64_t stream_id, uint64_t integrated_ts_ns, const FrameView& frame);
   bool on_frame_released(uint64_t stream_id);
   bool on_frame_dropped(uint64_t stream_id);
+  // Closes a pending reconfiguration when the frame matches the new profile.
+  bool on_frame_geometry(uint64_t stream_id,
+                         uint32_t width,
+                         uint32_t height,
+                         uint32_t format_fourcc,
+                         uint64_t integrated_ts_ns);
   bool on_visibility_path(uint64_t stream_id, CoreVisibilityPath path);
 
   // Mutable config updates (stream should exist).
   bool set_picture(uint64_t stream_id, const PictureConfig& picture);
+  bool on_stream_reconfigured(uint64_t stream_id,
+                              const CaptureProfile& profile,
+                              uint64_t profile_version,
+                              uint64_t now_ns);
+  bool set_qos_state(uint64_t stream_id,
+                     uint8_t qos_level,
+                     uint8_t qos_attempted_level,
+                     const CaptureProfile& qos_baseline_profile);
   bool set_backing_capabilities(uint64_t stream_id,
                                 ProducerBackingCapabilities runtime_backing_capabilities,
                                 ProducerBackingCapabilities parent_context_backing_capabilities);
+  // Stamps the sidecar downscale from the stream's profile
+  // (stream_retained_plan_for_profile) before recording the plan.
   bool set_requested_retained_plan(uint64_t stream_id,
                                    CoreRetainedProductionPlan requested_retained_plan,
                                    bool bump_access_posture_epoch = true);
@@ -112,16 +150,32 @@ public:
   const StreamRecord* find(uint64_t stream_id) const noexcept;
 
   // For future snapshot/publisher. Core-thread-only.
-  const std::map<uint64_t, StreamRecord>& all() const noexcept { return streams_; }
+  const CoreIdMap<StreamRecord>& all() const noexcept { return streams_; }
   bool has_flowing_stream_for_device(uint64_t device_instance_id) const noexcept;
   bool has_error_stream_for_device(uint64_t device_instance_id) const noexcept;
+  // Shortest requested frame period (1 / target_fps_max) over started
+  // streams that bound their rate; 0 when there is none. Recomputed only
+  // after a start, stop, reconfiguration or removal. Core-thread-only.
+  uint64_t shortest_started_frame_period_ns() const noexcept;
+  // True while the streams do not all share one StreamPriority. Recomputed
+  // only after a stream is declared or removed. Core-thread-only.
+  bool has_mixed_stream_priorities() const noexcept;
 
 private:
   uint64_t allocate_access_posture_epoch() noexcept;
+  void note_frame_period_inputs_changed_() noexcept { frame_period_dirty_ = true; }
+  void note_stream_set_changed_() noexcept {
+    frame_period_dirty_ = true;
+    priority_mix_dirty_ = true;
+  }
 
-  std::map<uint64_t, StreamRecord> streams_; // key: stream_id
+  CoreIdMap<StreamRecord> streams_; // key: stream_id
   std::set<uint64_t> destroyed_stream_tombstones_;
   uint64_t next_access_posture_epoch_ = 1;
+  mutable uint64_t shortest_started_frame_period_ns_ = 0;
+  mutable bool frame_period_dirty_ = false;
+  mutable bool mixed_stream_priorities_ = false;
+  mutable bool priority_mix_dirty_ = false;
 };
 
 } // namespace cambang
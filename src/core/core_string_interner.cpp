@@ -0,0 +1,50 @@
+// src/core/core_string_interner.cpp
+
+#include "core/core_string_interner.h"
+
+namespace cambang {
+
+CoreStringId CoreStringInterner::intern(std::string_view s) {
+  if (s.empty()) {
+    return 0;
+  }
+  std::lock_guard<std::mutex> lock(mu_);
+  const auto it = ids_.find(s);
+  if (it != ids_.end()) {
+    return it->second;
+  }
+  strings_.emplace_back(s);
+  const CoreStringId id = static_cast<CoreStringId>(strings_.size());
+  ids_.emplace(std::string_view(strings_.back()), id);
+  return id;
+}
+
+CoreStringId CoreStringInterner::find(std::string_view s) const noexcept {
+  if (s.empty()) {
+    return 0;
+  }
+  std::lock_guard<std::mutex> lock(mu_);
+  const auto it = ids_.find(s);
+  return it != ids_.end() ? it->second : 0;
+}
+
+const std::string& CoreStringInterner::str(CoreStringId id) const noexcept {
+  static const std::string kEmpty;
+  std::lock_guard<std::mutex> lock(mu_);
+  if (id == 0 || id > strings_.size()) {
+    return kEmpty;
+  }
+  return strings_[id - 1];
+}
+
+size_t CoreStringInterner::size() const noexcept {
+  std::lock_guard<std::mutex> lock(mu_);
+  return strings_.size();
+}
+
+CoreStringInterner& global_hardware_id_interner() noexcept {
+  static CoreStringInterner interner;
+  return interner;
+}
+
+} // namespace cambang
@@ -0,0 +1,50 @@
+// src/core/core_string_interner.h
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace cambang {
+
+// Small stable id for an interned string; 0 is "none".
+using CoreStringId = uint32_t;
+
+// Interns strings that Core compares over and over but that come from a
+// small, fixed set: hardware ids and camera ids. Registries keep the id
+// beside the string and compare ids on admission paths; the string is kept
+// for snapshots and diagnostics.
+//
+// Ids are stable for the life of the process and never reused. Nothing is
+// ever removed, so the table must only see identifiers, not user text.
+//
+// Threading: any thread.
+class CoreStringInterner final {
+public:
+  CoreStringInterner() = default;
+  CoreStringInterner(const CoreStringInterner&) = delete;
+  CoreStringInterner& operator=(const CoreStringInterner&) = delete;
+
+  // 0 for the empty string.
+  CoreStringId intern(std::string_view s);
+  // 0 when s was never interned (so it equals no interned id).
+  CoreStringId find(std::string_view s) const noexcept;
+  // Empty for 0 or an unknown id. The reference stays valid for the
+  // interner's lifetime.
+  const std::string& str(CoreStringId id) const noexcept;
+  size_t size() const noexcept;
+
+private:
+  mutable std::mutex mu_;
+  // Deque elements never move, so ids_ keys can view them.
+  std::deque<std::string> strings_;
+  std::unordered_map<std::string_view, CoreStringId> ids_;
+};
+
+// Process-wide table for hardware and camera ids.
+CoreStringInterner& global_hardware_id_interner() noexcept;
+
+} // namespace cambang
@@ -0,0 +1,142 @@
+// src/core/core_task_timing.h
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace cambang {
+
+// Core-thread CPU budget / lateness instrumentation.
+//
+// For each kind of core work, two log2 histograms: queue wait (posted or
+// requested until it started running) and execution time. Together they tell
+// whether core latency comes from queueing behind other work (size the
+// mailbox, split work) or from the work itself (optimize that path).
+//
+// Recording happens only on the core thread; copies may be taken from any
+// thread. Always on: one clock read per task on top of the liveness mark.
+enum class CoreTaskKind : uint8_t {
+  ESSENTIAL = 0,
+  COMMAND,
+  ORDINARY,
+  TIMER_TICK,
+  // Measured inside a timer tick; execution only (their queueing is the
+  // ORDINARY ingress task that carried the fact).
+  FRAME_DISPATCH,
+  // Wait runs from the first publish request to the build.
+  SNAPSHOT_BUILD,
+  COUNT,
+};
+
+inline constexpr size_t kCoreTaskKindCount = static_cast<size_t>(CoreTaskKind::COUNT);
+
+inline const char* to_string(CoreTaskKind kind) noexcept {
+  switch (kind) {
+    case CoreTaskKind::ESSENTIAL: return "essential";
+    case CoreTaskKind::COMMAND: return "command";
+    case CoreTaskKind::ORDINARY: return "ordinary";
+    case CoreTaskKind::TIMER_TICK: return "timer_tick";
+    case CoreTaskKind::FRAME_DISPATCH: return "frame_dispatch";
+    case CoreTaskKind::SNAPSHOT_BUILD: return "snapshot_build";
+    case CoreTaskKind::COUNT: break;
+  }
+  return "unknown";
+}
+
+struct CoreLatencyHistogram final {
+  // Bucket 0 holds < 1024 ns; bucket i (0 < i < kBuckets - 1) holds
+  // [2^(9+i), 2^(10+i)) ns; the last bucket holds everything from ~268 ms up.
+  static constexpr size_t kBuckets = 20;
+
+  uint64_t count = 0;
+  uint64_t total_ns = 0;
+  uint64_t max_ns = 0;
+  std::array<uint64_t, kBuckets> buckets{};
+
+  static size_t bucket_for(uint64_t ns) noexcept {
+    size_t b = 0;
+    for (uint64_t v = ns >> 10; v != 0 && b + 1 < kBuckets; v >>= 1) {
+      ++b;
+    }
+    return b;
+  }
+  // Exclusive upper bound of bucket b in ns; 0 for the open-ended last bucket.
+  static uint64_t bucket_upper_ns(size_t b) noexcept {
+    return b + 1 < kBuckets ? (uint64_t{1} << (10 + b)) : 0;
+  }
+};
+
+struct CoreTaskTimingStats final {
+  std::array<CoreLatencyHistogram, kCoreTaskKindCount> queue_wait{};
+  std::array<CoreLatencyHistogram, kCoreTaskKindCount> exec{};
+};
+
+// Single-writer (core thread) recorder; readers use copy().
+class CoreTaskTimingRecorder final {
+public:
+  void record_wait(CoreTaskKind kind, uint64_t ns) noexcept { wait_[index(kind)].record(ns); }
+  void record_exec(CoreTaskKind kind, uint64_t ns) noexcept { exec_[index(kind)].record(ns); }
+
+  CoreTaskTimingStats copy() const noexcept {
+    CoreTaskTimingStats s;
+    for (size_t k = 0; k < kCoreTaskKindCount; ++k) {
+      wait_[k].copy_to(s.queue_wait[k]);
+      exec_[k].copy_to(s.exec[k]);
+    }
+    return s;
+  }
+
+  // Not concurrent with recording (runtime start, before the core thread runs).
+  void reset() noexcept {
+    for (size_t k = 0; k < kCoreTaskKindCount; ++k) {
+      wait_[k].reset();
+      exec_[k].reset();
+    }
+  }
+
+private:
+  struct Histogram {
+    std::atomic<uint64_t> count{0};
+    std::atomic<uint64_t> total_ns{0};
+    std::atomic<uint64_t> max_ns{0};
+    std::array<std::atomic<uint64_t>, CoreLatencyHistogram::kBuckets> buckets{};
+
+    // Single writer: plain load + store instead of RMW.
+    void record(uint64_t ns) noexcept {
+      bump(count, 1);
+      bump(total_ns, ns);
+      if (ns > max_ns.load(std::memory_order_relaxed)) {
+        max_ns.store(ns, std::memory_order_relaxed);
+      }
+      bump(buckets[CoreLatencyHistogram::bucket_for(ns)], 1);
+    }
+    void copy_to(CoreLatencyHistogram& out) const noexcept {
+      out.count = count.load(std::memory_order_relaxed);
+      out.total_ns = total_ns.load(std::memory_order_relaxed);
+      out.max_ns = max_ns.load(std::memory_order_relaxed);
+      for (size_t b = 0; b < CoreLatencyHistogram::kBuckets; ++b) {
+        out.buckets[b] = buckets[b].load(std::memory_order_relaxed);
+      }
+    }
+    void reset() noexcept {
+      count.store(0, std::memory_order_relaxed);
+      total_ns.store(0, std::memory_order_relaxed);
+      max_ns.store(0, std::memory_order_relaxed);
+      for (auto& b : buckets) {
+        b.store(0, std::memory_order_relaxed);
+      }
+    }
+    static void bump(std::atomic<uint64_t>& a, uint64_t by) noexcept {
+      a.store(a.load(std::memory_order_relaxed) + by, std::memory_order_relaxed);
+    }
+  };
+
+  static constexpr size_t index(CoreTaskKind kind) noexcept { return static_cast<size_t>(kind); }
+
+  std::array<Histogram, kCoreTaskKindCount> wait_{};
+  std::array<Histogram, kCoreTaskKindCount> exec_{};
+};
+
+} // namespace cambang
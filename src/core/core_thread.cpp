@@ -4,8 +4,12 @@
 #include <chrono>
 #include <cstdio>
 #include <exception>
+#include <limits>
 #include <utility>
 
+#include "imaging/api/async_log.h"
+#include "imaging/api/thread_policy.h"
+
 namespace cambang {
 
 namespace {
@@ -13,11 +17,29 @@ namespace {
 // Stage A.3 fairness bound: ordinary provider/frame ingress remains FIFO and
 // non-dropping, but CoreThread takes it in single-task slices so command-lane
 // work posted while ordinary work is flowing is observed before another
-// ordinary task runs.
+// ordinary task runs. set_ordinary_tasks_per_turn() widens the slice; the
+// extra tasks are taken one at a time and stop at the first command/essential
+// arrival, so that observation point is kept.
 constexpr size_t kMaxOrdinaryTasksPerCoreThreadTurn = 1;
 
-bool bounded_core_thread_work_full(size_t command_size, size_t ordinary_size) noexcept {
-  return command_size + ordinary_size >= CoreThread::kMaxPendingTasks;
+// Reserve one entry on a bounded lane; fails once the lane holds `capacity`.
+bool try_reserve_bounded_core_thread_work(std::atomic<size_t>& pending, size_t capacity) noexcept {
+  size_t current = pending.load(std::memory_order_relaxed);
+  do {
+    if (current >= capacity) {
+      return false;
+    }
+  } while (!pending.compare_exchange_weak(current, current + 1, std::memory_order_acq_rel,
+                                          std::memory_order_relaxed));
+  return true;
+}
+
+size_t bounded_lane_ring_cells(size_t capacity) noexcept {
+  size_t cells = 1;
+  while (cells < capacity) {
+    cells <<= 1;
+  }
+  return cells;
 }
 
 // The core thread is the sole owner of core state; an uncaught exception
@@ -29,9 +51,9 @@ void run_guarded(const char* label, Fn&& fn) noexcept {
   try {
     fn();
   } catch (const std::exception& e) {
-    std::fprintf(stderr, "[CamBANG][CoreThread] uncaught exception in %s: %s\n", label, e.what());
+    async_log_printf(stderr, "[CamBANG][CoreThread] uncaught exception in %s: %s\n", label, e.what());
   } catch (...) {
-    std::fprintf(stderr, "[CamBANG][CoreThread] uncaught non-standard exception in %s\n", label);
+    async_log_printf(stderr, "[CamBANG][CoreThread] uncaught non-standard exception in %s\n", label);
   }
 }
 
@@ -64,9 +86,13 @@ bool CoreThread::start(IHooks* hooks) {
     has_deadline_ = false;
     deadline_ns_ = 0;
     essential_tasks_.clear();
-    command_tasks_.clear();
-    tasks_.clear();
+    essential_pending_.store(false, std::memory_order_relaxed);
   }
+  // No consumer runs yet; start() stands in for it.
+  command_ring_.clear();
+  ordinary_ring_.clear();
+  ordinary_pending_.store(0, std::memory_order_relaxed);
+  command_pending_.store(0, std::memory_order_relaxed);
 
   // Reset accounting
   tasks_enqueued_.store(0, std::memory_order_relaxed);
@@ -75,6 +101,7 @@ bool CoreThread::start(IHooks* hooks) {
   tasks_dropped_full_.store(0, std::memory_order_relaxed);
   tasks_dropped_closed_.store(0, std::memory_order_relaxed);
   tasks_dropped_allocfail_.store(0, std::memory_order_relaxed);
+  task_timing_.reset();
 
   try {
     thread_ = std::thread(&CoreThread::thread_main, this);
@@ -85,9 +112,11 @@ bool CoreThread::start(IHooks* hooks) {
       stop_requested_ = false;
       stop_when_idle_ = false;
       essential_tasks_.clear();
-      command_tasks_.clear();
-      tasks_.clear();
     }
+    command_ring_.clear();
+    ordinary_ring_.clear();
+    ordinary_pending_.store(0, std::memory_order_relaxed);
+    command_pending_.store(0, std::memory_order_relaxed);
     running_.store(false, std::memory_order_release);
     return false;
   }
@@ -171,6 +200,21 @@ void CoreThread::post(Task task) {
 CoreThread::PostResult CoreThread::try_post(Task task) {
   // External ingress point.
   // All non-core threads must schedule work through this method.
+  return try_post_bounded_(ordinary_ring_, std::move(task), false);
+}
+
+
+CoreThread::PostResult CoreThread::try_post_command(Task task) {
+  // Command ingress point. This queue is bounded together with ordinary work,
+  // but drains before ordinary provider/frame work so public Core commands get
+  // a prompt service opportunity under sustained provider production.
+  return try_post_bounded_(command_ring_, std::move(task), true);
+}
+
+
+CoreThread::PostResult CoreThread::try_post_bounded_(BoundedMpscRing<QueuedTask>& ring,
+                                                     Task&& task,
+                                                     bool command) {
   if (!task) {
     return PostResult::Enqueued; // nothing to do; treat as success
   }
@@ -181,70 +225,62 @@ CoreThread::PostResult CoreThread::try_post(Task task) {
     return PostResult::Closed;
   }
 
-  {
-    std::lock_guard<std::mutex> lock(mu_);
-    if (stop_requested_) {
-      tasks_dropped_closed_.fetch_add(1, std::memory_order_relaxed);
-      return PostResult::Closed;
-    }
+  // Admission closes under mu_ by setting stop_requested_; the in-flight count
+  // lets the core thread's final exit check wait out a poster that observed
+  // "open" just before that, instead of stranding its task (seq_cst pairs the
+  // increment here with stop_requested_ there).
+  ring_posters_in_flight_.fetch_add(1, std::memory_order_seq_cst);
+  if (stop_requested_.load(std::memory_order_seq_cst)) {
+    ring_posters_in_flight_.fetch_sub(1, std::memory_order_release);
+    tasks_dropped_closed_.fetch_add(1, std::memory_order_relaxed);
+    return PostResult::Closed;
+  }
 
-    if (bounded_core_thread_work_full(command_tasks_.size(), tasks_.size())) {
-      tasks_dropped_full_.fetch_add(1, std::memory_order_relaxed);
-      return PostResult::QueueFull;
-    }
+  std::atomic<size_t>& pending = command ? command_pending_ : ordinary_pending_;
+  if (!try_reserve_bounded_core_thread_work(pending, command ? command_capacity_ : ordinary_capacity_)) {
+    ring_posters_in_flight_.fetch_sub(1, std::memory_order_release);
+    tasks_dropped_full_.fetch_add(1, std::memory_order_relaxed);
+    return PostResult::QueueFull;
+  }
 
-    try {
-      tasks_.push_back(std::move(task));
-    } catch (...) {
-      // Allocation failure or unexpected exception while enqueueing.
-      tasks_dropped_allocfail_.fetch_add(1, std::memory_order_relaxed);
-      return PostResult::AllocFail;
-    }
+  // Each ring holds at least its lane's capacity in cells and the reservation
+  // above bounds the lane, so a reserved push always finds a free cell.
+  const bool pushed = ring.try_push(QueuedTask{std::move(task), steady_now_ns()});
+  ring_posters_in_flight_.fetch_sub(1, std::memory_order_release);
+  if (!pushed) {
+    pending.fetch_sub(1, std::memory_order_acq_rel);
+    tasks_dropped_full_.fetch_add(1, std::memory_order_relaxed);
+    return PostResult::QueueFull;
   }
 
   tasks_enqueued_.fetch_add(1, std::memory_order_relaxed);
-  cv_.notify_one();
+  if (command) {
+    command_tasks_enqueued_.fetch_add(1, std::memory_order_relaxed);
+  }
+  wake_core_thread_();
   return PostResult::Enqueued;
 }
 
-
-CoreThread::PostResult CoreThread::try_post_command(Task task) {
-  // Command ingress point. This queue is bounded together with ordinary work,
-  // but drains before ordinary provider/frame work so public Core commands get
-  // a prompt service opportunity under sustained provider production.
-  if (!task) {
-    return PostResult::Enqueued;
-  }
-
-  if (!running_.load(std::memory_order_acquire)) {
-    tasks_dropped_closed_.fetch_add(1, std::memory_order_relaxed);
-    return PostResult::Closed;
+void CoreThread::wake_core_thread_() {
+  // Pairs with the fence in thread_main(): either that wait predicate sees
+  // the published cell, or this load sees core_waiting_ and the lock below
+  // orders our notify after the core thread is inside cv_.wait().
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (!core_waiting_.load(std::memory_order_relaxed)) {
+    return;
   }
-
   {
     std::lock_guard<std::mutex> lock(mu_);
-    if (stop_requested_) {
-      tasks_dropped_closed_.fetch_add(1, std::memory_order_relaxed);
-      return PostResult::Closed;
-    }
-
-    if (bounded_core_thread_work_full(command_tasks_.size(), tasks_.size())) {
-      tasks_dropped_full_.fetch_add(1, std::memory_order_relaxed);
-      return PostResult::QueueFull;
-    }
-
-    try {
-      command_tasks_.push_back(std::move(task));
-    } catch (...) {
-      tasks_dropped_allocfail_.fetch_add(1, std::memory_order_relaxed);
-      return PostResult::AllocFail;
-    }
   }
-
-  tasks_enqueued_.fetch_add(1, std::memory_order_relaxed);
-  command_tasks_enqueued_.fetch_add(1, std::memory_order_relaxed);
   cv_.notify_one();
-  return PostResult::Enqueued;
+}
+
+void CoreThread::quiesce_ring_posters_() const noexcept {
+  // Posters never block between their admission check and publish, so this
+  // is a short bounded spin.
+  while (ring_posters_in_flight_.load(std::memory_order_seq_cst) != 0) {
+    std::this_thread::yield();
+  }
 }
 
 
@@ -262,6 +298,7 @@ CoreThread::PostResult CoreThread::try_post_essential(Task task) {
     return PostResult::Closed;
   }
 
+  const uint64_t enqueued_ns = steady_now_ns();
   {
     std::lock_guard<std::mutex> lock(mu_);
     if (stop_requested_) {
@@ -270,11 +307,12 @@ CoreThread::PostResult CoreThread::try_post_essential(Task task) {
     }
 
     try {
-      essential_tasks_.push_back(std::move(task));
+      essential_tasks_.push_back(QueuedTask{std::move(task), enqueued_ns});
     } catch (...) {
       tasks_dropped_allocfail_.fetch_add(1, std::memory_order_relaxed);
       return PostResult::AllocFail;
     }
+    essential_pending_.store(true, std::memory_order_release);
   }
 
   tasks_enqueued_.fetch_add(1, std::memory_order_relaxed);
@@ -283,6 +321,34 @@ CoreThread::PostResult CoreThread::try_post_essential(Task task) {
   return PostResult::Enqueued;
 }
 
+void CoreThread::set_ordinary_tasks_per_turn(size_t max_tasks) noexcept {
+  if (running_.load(std::memory_order_acquire)) {
+    return;
+  }
+  ordinary_tasks_per_turn_ = std::max(max_tasks, kMaxOrdinaryTasksPerCoreThreadTurn);
+}
+
+bool CoreThread::set_lane_capacities(size_t ordinary_tasks, size_t command_tasks) noexcept try {
+  if (running_.load(std::memory_order_acquire)) {
+    return false;
+  }
+  const size_t ordinary = ordinary_tasks != 0 ? ordinary_tasks : ordinary_capacity_;
+  const size_t command = command_tasks != 0 ? command_tasks : command_capacity_;
+  const size_t ordinary_cells = bounded_lane_ring_cells(ordinary);
+  const size_t command_cells = bounded_lane_ring_cells(command);
+  if (ordinary_cells != ordinary_ring_.capacity()) {
+    ordinary_ring_.reset(ordinary_cells);
+  }
+  ordinary_capacity_ = ordinary;
+  if (command_cells != command_ring_.capacity()) {
+    command_ring_.reset(command_cells);
+  }
+  command_capacity_ = command;
+  return true;
+} catch (...) {
+  return false;
+}
+
 CoreThread::Stats CoreThread::stats_copy() const noexcept {
   Stats s;
   s.tasks_enqueued = tasks_enqueued_.load(std::memory_order_relaxed);
@@ -295,14 +361,17 @@ CoreThread::Stats CoreThread::stats_copy() const noexcept {
 }
 
 bool CoreThread::has_pending_command_tasks() const {
-  std::lock_guard<std::mutex> lock(mu_);
-  return !command_tasks_.empty();
+  return command_pending_.load(std::memory_order_acquire) != 0;
 }
 
 void CoreThread::request_timer_tick() {
   // Forces an immediate wake and hook tick on the core thread.
+  const uint64_t now_ns = steady_now_ns();
   {
     std::lock_guard<std::mutex> lock(mu_);
+    if (!timer_tick_requested_) {
+      timer_tick_requested_ns_ = now_ns;
+    }
     timer_tick_requested_ = true;
   }
 
@@ -310,13 +379,12 @@ void CoreThread::request_timer_tick() {
 }
 
 void CoreThread::set_timer_deadline_ns(uint64_t deadline_ns) {
-  // Scaffolding behavior:
-  // - deadline_ns is currently interpreted as a relative delay hint.
-  // - Core warm/retention scheduling will refine this later.
+  const uint64_t now_ns = steady_now_ns();
+  const uint64_t max_ns = static_cast<uint64_t>(std::numeric_limits<int64_t>::max());
   {
     std::lock_guard<std::mutex> lock(mu_);
     has_deadline_ = true;
-    deadline_ns_ = deadline_ns;
+    deadline_ns_ = (deadline_ns > max_ns - now_ns) ? max_ns : now_ns + deadline_ns;
   }
 
   cv_.notify_one();
@@ -332,9 +400,9 @@ void CoreThread::clear_timer_deadline() {
   cv_.notify_one();
 }
 
-void CoreThread::drain_tasks_locked(std::deque<Task>& essential_local,
-                                     std::deque<Task>& command_local,
-                                     std::deque<Task>& ordinary_local) {
+void CoreThread::drain_tasks_locked(std::deque<QueuedTask>& essential_local,
+                                     std::deque<QueuedTask>& command_local,
+                                     std::deque<QueuedTask>& ordinary_local) {
   // Moves all pending tasks into local queues.
   // Guarantees:
   // - Tasks execute outside the mutex.
@@ -344,32 +412,76 @@ void CoreThread::drain_tasks_locked(std::deque<Task>& essential_local,
   // - Ordinary work is drained in a bounded FIFO slice. Remaining ordinary work
   //   stays queued for the next pump so newly posted command work can be observed
   //   before another ordinary slice runs.
+  // - A command drain takes at most one ring's worth, so posters that keep
+  //   refilling the command lane cannot hold the core thread in the drain.
   essential_local.clear();
   command_local.clear();
   ordinary_local.clear();
   essential_local.swap(essential_tasks_);
-  command_local.swap(command_tasks_);
-  const size_t ordinary_to_drain = std::min(tasks_.size(), kMaxOrdinaryTasksPerCoreThreadTurn);
-  for (size_t i = 0; i < ordinary_to_drain; ++i) {
-    ordinary_local.push_back(std::move(tasks_.front()));
-    tasks_.pop_front();
+  essential_pending_.store(false, std::memory_order_release);
+  QueuedTask task;
+  for (size_t i = 0; i < command_capacity_ && command_ring_.try_pop(task); ++i) {
+    command_local.push_back(std::move(task));
+    command_pending_.fetch_sub(1, std::memory_order_acq_rel);
+  }
+  for (size_t i = 0; i < kMaxOrdinaryTasksPerCoreThreadTurn && ordinary_ring_.try_pop(task); ++i) {
+    ordinary_local.push_back(std::move(task));
+    ordinary_pending_.fetch_sub(1, std::memory_order_acq_rel);
   }
 }
 
-void CoreThread::mark_task_start_() noexcept {
-  const uint64_t now_ns = static_cast<uint64_t>(
+uint64_t CoreThread::steady_now_ns() noexcept {
+  return static_cast<uint64_t>(
       std::chrono::duration_cast<std::chrono::nanoseconds>(
           std::chrono::steady_clock::now().time_since_epoch())
           .count());
+}
+
+uint64_t CoreThread::mark_task_start_() noexcept {
+  const uint64_t now_ns = steady_now_ns();
   current_task_started_ns_.store(now_ns, std::memory_order_release);
+  return now_ns;
 }
 
 void CoreThread::mark_task_end_() noexcept {
   current_task_started_ns_.store(0, std::memory_order_release);
 }
 
+void CoreThread::run_timed_(CoreTaskKind kind, const char* label, QueuedTask& queued) noexcept {
+  const uint64_t started_ns = mark_task_start_();
+  task_timing_.record_wait(kind, started_ns > queued.enqueued_ns ? started_ns - queued.enqueued_ns : 0);
+  run_guarded(label, queued.task);
+  const uint64_t ended_ns = steady_now_ns();
+  mark_task_end_();
+  task_timing_.record_exec(kind, ended_ns > started_ns ? ended_ns - started_ns : 0);
+}
+
+void CoreThread::update_performance_hint_(uint64_t turn_started_ns) noexcept {
+  if (performance_hint_target_ns_ == 0) {
+    performance_hint_.close();
+    performance_hint_refused_ = false;
+    return;
+  }
+  const int64_t target_ns = static_cast<int64_t>(performance_hint_target_ns_);
+  if (!performance_hint_.active()) {
+    // The turn that opens the session was not measured; the next one is.
+    if (!performance_hint_refused_) {
+      const int32_t tid = current_os_thread_id();
+      performance_hint_refused_ = !performance_hint_.open(&tid, 1, target_ns);
+    }
+    return;
+  }
+  performance_hint_.update_target(target_ns);
+  if (turn_started_ns != 0) {
+    const uint64_t now_ns = steady_now_ns();
+    performance_hint_.report_actual(
+        static_cast<int64_t>(now_ns > turn_started_ns ? now_ns - turn_started_ns : 0));
+  }
+}
+
 void CoreThread::thread_main() {
   core_tid_.store(std::this_thread::get_id(), std::memory_order_release);
+  apply_current_thread_policy(CBThreadRole::Core, "cambang-core");
   // From this point onward, execution is exclusively on the core thread.
   // No other thread may mutate core state.
 
@@ -379,14 +491,15 @@ void CoreThread::thread_main() {
     mark_task_end_();
   }
 
-  std::deque<Task> essential_local;
-  std::deque<Task> command_local;
-  std::deque<Task> ordinary_local;
+  std::deque<QueuedTask> essential_local;
+  std::deque<QueuedTask> command_local;
+  std::deque<QueuedTask> ordinary_local;
   bool timer_tick_deferred_for_command = false;
 
   for (;;) {
     bool do_timer_tick = false;
     bool stopping = false;
+    uint64_t timer_tick_due_ns = 0;
 
     {
       std::unique_lock<std::mutex> lock(mu_);
@@ -396,37 +509,49 @@ void CoreThread::thread_main() {
 
       auto predicate = [&]() {
         return stop_requested_ || stop_when_idle_ || !essential_tasks_.empty() ||
-               !command_tasks_.empty() || !tasks_.empty() || timer_tick_requested_;
+               has_ring_work_() || timer_tick_requested_;
       };
 
+      // See wake_core_thread_(): announce the wait before the predicate reads
+      // the rings.
+      core_waiting_.store(true, std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+
       if (!has_deadline) {
         // Pure blocking mode: wait until work, timer request, or stop.
         cv_.wait(lock, predicate);
       } else {
-        // Timed wait mode (scaffolding).
-        // Interpret deadline_ns as relative nanoseconds from now.
-        const auto now = std::chrono::steady_clock::now();
-        const auto wait_dur = std::chrono::nanoseconds(deadline_ns);
-        const auto wake_time = now + wait_dur;
+        // Timed wait mode: the deadline is absolute, so a wake for other
+        // work resumes the same wait.
+        const std::chrono::steady_clock::time_point wake_time{
+            std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::nanoseconds(deadline_ns))};
 
         cv_.wait_until(lock, wake_time, predicate);
 
-        // Conservative deadline detection.
+        // Conservative deadline detection. One-shot: the tick re-arms.
         if (std::chrono::steady_clock::now() >= wake_time) {
           do_timer_tick = true;
+          timer_tick_due_ns = deadline_ns;
+          if (deadline_ns_ == deadline_ns) {
+            has_deadline_ = false;
+          }
         }
       }
+      core_waiting_.store(false, std::memory_order_relaxed);
 
       // If a stop-when-idle request is pending and there is no work to drain,
       // convert it into a definitive stop. This closes task admission deterministically.
-      if (stop_when_idle_ && essential_tasks_.empty() && command_tasks_.empty() &&
-          tasks_.empty() && !timer_tick_requested_) {
+      if (stop_when_idle_ && essential_tasks_.empty() && !has_ring_work_() &&
+          !timer_tick_requested_) {
         stop_requested_ = true;
       }
 
       stopping = stop_requested_;
 
       if (timer_tick_requested_) {
+        if (!do_timer_tick || timer_tick_requested_ns_ < timer_tick_due_ns) {
+          timer_tick_due_ns = timer_tick_requested_ns_;
+        }
         do_timer_tick = true;
         timer_tick_requested_ = false;
       }
@@ -434,6 +559,7 @@ void CoreThread::thread_main() {
       // Drain tasks while holding mutex, execute outside.
       drain_tasks_locked(essential_local, command_local, ordinary_local);
     }
+    const uint64_t turn_started_ns = performance_hint_.active() ? steady_now_ns() : 0;
 
     // Execute all tasks serially.
     // Determinism guarantee:
@@ -441,34 +567,48 @@ void CoreThread::thread_main() {
     // - Essential FIFO tasks execute before command FIFO tasks drained in the same pump.
     // - Command FIFO tasks execute before ordinary FIFO tasks drained in the same pump.
     for (size_t i = 0; i < essential_local.size(); ++i) {
-      mark_task_start_();
-      run_guarded("essential_task", essential_local[i]);
-      mark_task_end_();
+      run_timed_(CoreTaskKind::ESSENTIAL, "essential_task", essential_local[i]);
     }
     essential_local.clear();
 
     for (size_t i = 0; i < command_local.size(); ++i) {
-      mark_task_start_();
-      run_guarded("command_task", command_local[i]);
-      mark_task_end_();
+      run_timed_(CoreTaskKind::COMMAND, "command_task", command_local[i]);
     }
     command_local.clear();
 
+    const size_t ordinary_taken = ordinary_local.size();
     for (size_t i = 0; i < ordinary_local.size(); ++i) {
-      mark_task_start_();
-      run_guarded("ordinary_task", ordinary_local[i]);
-      mark_task_end_();
+      run_timed_(CoreTaskKind::ORDINARY, "ordinary_task", ordinary_local[i]);
     }
     ordinary_local.clear();
 
+    // Batched ordinary drain: continue straight off the ring (this thread is
+    // its only consumer) while no command or essential work is waiting; that
+    // work then gets the next pump before any further ordinary task.
+    for (size_t taken = ordinary_taken;
+         taken != 0 && taken < ordinary_tasks_per_turn_ && !stopping &&
+         command_pending_.load(std::memory_order_acquire) == 0 &&
+         !essential_pending_.load(std::memory_order_acquire);
+         ++taken) {
+      QueuedTask task;
+      if (!ordinary_ring_.try_pop(task)) {
+        break;
+      }
+      ordinary_pending_.fetch_sub(1, std::memory_order_acq_rel);
+      run_timed_(CoreTaskKind::ORDINARY, "ordinary_task", task);
+    }
+
     if (do_timer_tick && hooks_) {
       bool defer_timer_for_command = false;
       if (!stopping && !timer_tick_deferred_for_command) {
         std::lock_guard<std::mutex> lock(mu_);
-        defer_timer_for_command = !command_tasks_.empty();
+        defer_timer_for_command = command_ring_.head_ready();
         if (defer_timer_for_command) {
           // Preserve the coalesced tick and give command-lane work posted while
           // this pump was executing a prompt service turn before timer work.
+          if (!timer_tick_requested_ || timer_tick_due_ns < timer_tick_requested_ns_) {
+            timer_tick_requested_ns_ = timer_tick_due_ns;
+          }
           timer_tick_requested_ = true;
         }
       }
@@ -480,23 +620,25 @@ void CoreThread::thread_main() {
         // reaches CoreRuntime's shutdown-phase pump, which calls
         // prov->shutdown() -- exactly the kind of provider call the liveness
         // primitive exists to catch if it never returns.
-        mark_task_start_();
-        run_guarded("on_core_timer_tick", [this]() { hooks_->on_core_timer_tick(); });
-        mark_task_end_();
+        QueuedTask tick(Task([this]() { hooks_->on_core_timer_tick(); }), timer_tick_due_ns);
+        run_timed_(CoreTaskKind::TIMER_TICK, "on_core_timer_tick", tick);
         timer_tick_deferred_for_command = false;
       }
     }
 
+    update_performance_hint_(turn_started_ns);
+
     if (stopping) {
       // A drained task may request a timer tick while stop is already pending
       // (for example, a provider ingress task accepted before closure can enqueue
       // CoreRuntime facts and ask the hook to pump them). Do not strand that
       // accepted work solely because the stop flag was observed before the task ran.
       bool has_deferred_work = false;
+      quiesce_ring_posters_();
       {
         std::lock_guard<std::mutex> lock(mu_);
         has_deferred_work = (!do_timer_tick && timer_tick_requested_) ||
-                            !essential_tasks_.empty() || !command_tasks_.empty() || !tasks_.empty();
+                            !essential_tasks_.empty() || has_ring_work_();
       }
       if (!has_deferred_work) {
         break;
@@ -509,6 +651,8 @@ void CoreThread::thread_main() {
     run_guarded("on_core_stop", [this]() { hooks_->on_core_stop(); });
     mark_task_end_();
   }
+  performance_hint_.close();
+  performance_hint_refused_ = false;
 }
 
 } // namespace cambang
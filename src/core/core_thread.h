@@ -6,9 +6,14 @@
 #include <cstdint>
 #include <cstddef>
 #include <deque>
-#include <functional>
 #include <mutex>
 #include <thread>
+#include <utility>
+
+#include "core/bounded_mpsc_ring.h"
+#include "core/core_task_timing.h"
+#include "core/inline_task.h"
+#include "imaging/api/performance_hint.h"
 
 namespace cambang {
 
@@ -22,8 +27,8 @@ namespace cambang {
 // - All tasks are executed serially (no concurrent core execution).
 // - FIFO ordering is guaranteed only relative to a single POSTING thread.
 //   Concurrent post()/try_post()/try_post_essential() calls from two different
-//   threads race for the internal queue lock; their relative arrival order in
-//   the queue (and therefore processing order) is undefined. This is why
+//   threads race for a queue position; their relative arrival order in the
+//   queue (and therefore processing order) is undefined. This is why
 //   icamera_provider.h requires a Provider to invoke IProviderCallbacks from a
 //   single serialized callback context -- CoreThread cannot recover a
 //   Provider's real event order once two threads have posted concurrently.
@@ -49,12 +54,33 @@ namespace cambang {
 //   work that must not sit behind frame/provider ordinary work.
 // - try_post_essential() uses a separate unbounded-by-kMaxPendingTasks queue for
 //   lifecycle/fact delivery that must not be lost merely because ordinary work is full.
+//
+// Lanes:
+// - Ordinary and command lanes are lock-free bounded MPSC rings with
+//   preallocated cells, so frame-rate posting never takes mu_ or allocates
+//   queue storage. Each lane has its own capacity (kMaxPendingTasks unless
+//   set_lane_capacities() says otherwise), enforced by a per-lane reservation
+//   counter taken before a cell is claimed, so a full ordinary lane never
+//   rejects command work.
+// - The essential lane stays a mutex-protected deque: it is low-rate and must
+//   not be capacity-bounded.
+// - Producers touch mu_ only to wake a core thread that is (about to be)
+//   blocked; see wake_core_thread_().
+// - Every queued task carries its enqueue time so the loop can record queue
+//   wait and execution time per lane (task_timing(), core_task_timing.h).
 class CoreThread final {
 public:
-  // std::function construction may allocate. Public/noexcept command adapters
-  // must construct and enqueue Tasks inside an exception-to-status boundary;
-  // the mailbox can report AllocFail only after a Task reached try_post*().
-  using Task = std::function<void()>;
+  // Inline capture budget for one posted task. Sized so a provider ingress
+  // command (ProviderToCoreCommand plus its transport captures -- see the
+  // static_assert in provider_callback_ingress.cpp) fits without touching the
+  // heap; a larger capture is a compile error at the posting site.
+  static constexpr size_t kTaskInlineBytes = 768;
+
+  // Move-only and allocation-free to construct. Capture copies themselves can
+  // still throw (e.g. copying a std::string), so public/noexcept command
+  // adapters keep building Tasks inside their exception-to-status boundary;
+  // AllocFail now arises only from the unbounded essential lane's deque.
+  using Task = InlineTask<kTaskInlineBytes>;
 
   enum class PostResult : uint8_t {
     Enqueued,
@@ -154,7 +180,7 @@ public:
     return current_task_started_ns_.load(std::memory_order_acquire);
   }
 
-  // Bounded mailbox capacity (number of pending tasks).
+  // Default capacity of each bounded lane (number of pending tasks).
   static constexpr size_t kMaxPendingTasks = 1024;
 
   // Post a unit of work to be executed on the core thread.
@@ -179,7 +205,7 @@ public:
   // Best-effort command post; returns a reason on failure.
   // - thread-safe
   // - does not block
-  // - bounded together with ordinary work
+  // - bounded by the command lane's own capacity
   // - drained after essential facts and before ordinary frame/provider work
   //
   // Use for Core-owned public/request command admission. This keeps posted
@@ -189,7 +215,7 @@ public:
 
   // Essential post; returns a reason on failure.
   // - thread-safe
-  // - not subject to kMaxPendingTasks ordinary queue-full rejection
+  // - not subject to bounded-lane queue-full rejection
   // - drained before ordinary tasks
   //
   // Use only for non-lossy core facts (for example provider lifecycle, native,
@@ -208,6 +234,36 @@ public:
 
   Stats stats_copy() const noexcept;
 
+  // Per-lane/timer-tick wait and execution histograms, reset by start().
+  // CoreRuntime records its own kinds (frame dispatch, snapshot build) here
+  // too; record only from the core thread. Copies are safe from any thread.
+  CoreTaskTimingRecorder& task_timing() noexcept { return task_timing_; }
+  CoreTaskTimingStats task_timing_copy() const noexcept { return task_timing_.copy(); }
+
+  // steady_clock ns since its epoch; the time base of every timing above and
+  // of current_task_started_ns().
+  static uint64_t steady_now_ns() noexcept;
+
+  // Opt-in batched ordinary drain: let one pump run up to max_tasks ordinary
+  // tasks (default 1). Each extra task is taken only while no command or
+  // essential work is queued, so command-lane preemption between ordinary
+  // tasks is unchanged. Call before start(); ignored while running.
+  void set_ordinary_tasks_per_turn(size_t max_tasks) noexcept;
+
+  // Per-lane capacities in pending tasks (0 keeps a lane's current value).
+  // Ring storage is rounded up to a power of two; admission stops at the exact
+  // value. Call before start(); returns false while running (unchanged) or if
+  // a ring cannot be allocated (the ordinary lane is resized first and keeps
+  // its new capacity when only the command ring fails).
+  bool set_lane_capacities(size_t ordinary_tasks, size_t command_tasks) noexcept;
+  size_t ordinary_lane_capacity() const noexcept { return ordinary_capacity_; }
+  size_t command_lane_capacity() const noexcept { return command_capacity_; }
+
+  // Ordinary tasks reserved or queued right now; thread-safe, advisory.
+  size_t ordinary_lane_pending() const noexcept {
+    return ordinary_pending_.load(std::memory_order_relaxed);
+  }
+
   // Thread-safe scheduler visibility for CoreRuntime timer-hook fairness.
   // Returns true when command-lane work is queued but not yet drained into the
   // current CoreThread pump.
@@ -218,27 +274,71 @@ public:
   // - results in hooks_->on_core_timer_tick() being called on the core thread
   void request_timer_tick();
 
-  // Set/clear a timed wake deadline.
+  // Set/clear a timed wake: one timer tick once deadline_ns (a delay from
+  // the call) has elapsed. Fixed when set, so wakes for other work neither
+  // postpone nor repeat it; each tick sets the next one.
   // - thread-safe
   //
-  // NOTE (scaffolding): deadline_ns_ is currently treated as a relative delay hint.
   // Precise scheduling semantics are implemented by core warm/retention logic; this class
   // only provides a timed-wake primitive.
   void set_timer_deadline_ns(uint64_t deadline_ns);
   void clear_timer_deadline();
 
+  // Work-duration target of the core thread's hint session
+  // (imaging/api/performance_hint.h): while it is nonzero, every loop turn
+  // reports its busy time against it; 0 closes the session. CoreRuntime
+  // sets the shortest started stream period. Call only from the core thread.
+  void set_performance_hint_target_ns(uint64_t target_ns) noexcept {
+    performance_hint_target_ns_ = target_ns;
+  }
+
 private:
+  struct QueuedTask {
+    // Constructors rather than member initializers: the ring's
+    // nothrow-default-constructible check runs inside this class.
+    QueuedTask() noexcept : enqueued_ns(0) {}
+    QueuedTask(Task t, uint64_t ns) noexcept : task(std::move(t)), enqueued_ns(ns) {}
+
+    Task task;
+    uint64_t enqueued_ns;
+  };
+
   void thread_main();
 
-  // Drain tasks into local queues; mu_ must be held.
-  void drain_tasks_locked(std::deque<Task>& essential_local,
-                          std::deque<Task>& command_local,
-                          std::deque<Task>& ordinary_local);
+  // Drain tasks into local queues; mu_ must be held (it guards only the
+  // essential lane; the rings are popped by this, their single consumer).
+  void drain_tasks_locked(std::deque<QueuedTask>& essential_local,
+                          std::deque<QueuedTask>& command_local,
+                          std::deque<QueuedTask>& ordinary_local);
+
+  // Shared admission for the two bounded ring lanes.
+  PostResult try_post_bounded_(BoundedMpscRing<QueuedTask>& ring, Task&& task, bool command);
+
+  // run_guarded() one queued task between the liveness marks, recording its
+  // wait and execution time under `kind`.
+  void run_timed_(CoreTaskKind kind, const char* label, QueuedTask& queued) noexcept;
+
+  // Wake the core thread after a lock-free enqueue if it may be waiting.
+  void wake_core_thread_();
+
+  // Ring lanes hold published work (core thread only).
+  bool has_ring_work_() const noexcept {
+    return command_ring_.head_ready() || ordinary_ring_.head_ready();
+  }
+
+  // Wait until no lock-free poster is between its admission check and its
+  // publish. Called on the core thread after admission closed.
+  void quiesce_ring_posters_() const noexcept;
+
+  // Opens, retargets or closes the hint session for the current target and
+  // reports the turn that began at turn_started_ns (0: not measured).
+  void update_performance_hint_(uint64_t turn_started_ns) noexcept;
 
   // Mark/clear current_task_started_ns_ around each run_guarded(...) call in
   // thread_main(). Called only from the core thread; current_task_started_ns_
   // itself is atomic because it is read from other threads.
-  void mark_task_start_() noexcept;
+  // mark_task_start_() returns the start time it published.
+  uint64_t mark_task_start_() noexcept;
   void mark_task_end_() noexcept;
 
   // Synchronization
@@ -251,10 +351,25 @@ private:
   std::atomic<std::thread::id> core_tid_{};
   IHooks* hooks_ = nullptr; // non-owning; must outlive stop()
 
-  // Work queues (protected by mu_).
-  std::deque<Task> essential_tasks_;
-  std::deque<Task> command_tasks_;
-  std::deque<Task> tasks_;
+  // Essential work queue (protected by mu_). essential_pending_ mirrors
+  // "non-empty" for the batched ordinary drain, which runs without mu_.
+  std::deque<QueuedTask> essential_tasks_;
+  std::atomic<bool> essential_pending_{false};
+  size_t ordinary_tasks_per_turn_ = 1; // written only while stopped
+
+  // Bounded lanes. Each *_pending_ counts that lane's reserved-or-queued
+  // entries against its capacity; command_pending_ also backs
+  // has_pending_command_tasks(). Capacities are written only while stopped.
+  size_t ordinary_capacity_ = kMaxPendingTasks;
+  size_t command_capacity_ = kMaxPendingTasks;
+  BoundedMpscRing<QueuedTask> command_ring_{kMaxPendingTasks};
+  BoundedMpscRing<QueuedTask> ordinary_ring_{kMaxPendingTasks};
+  std::atomic<size_t> ordinary_pending_{0};
+  std::atomic<size_t> command_pending_{0};
+  // Posters currently between admission check and ring publish.
+  std::atomic<uint32_t> ring_posters_in_flight_{0};
+  // Set (with mu_ held) just before the core thread may block on cv_.
+  std::atomic<bool> core_waiting_{false};
 
   // Post accounting
   std::atomic<uint64_t> tasks_enqueued_{0};
@@ -267,15 +382,26 @@ private:
   // Liveness primitive backing current_task_started_ns(). 0 == idle.
   std::atomic<uint64_t> current_task_started_ns_{0};
 
+  CoreTaskTimingRecorder task_timing_;
+
+  // Core thread only. A refused session is not retried until the target
+  // returns to 0.
+  uint64_t performance_hint_target_ns_ = 0;
+  CBPerformanceHintSession performance_hint_;
+  bool performance_hint_refused_ = false;
+
   // Stop / running flags
   std::atomic<bool> running_{false};
-  bool stop_requested_ = false;
+  // Written with mu_ held; atomic so ring posters can check admission
+  // without the lock.
+  std::atomic<bool> stop_requested_{false};
   bool stop_when_idle_ = false;
 
   // Timer tick control (protected by mu_).
   bool timer_tick_requested_ = false;
+  uint64_t timer_tick_requested_ns_ = 0; // first request since the last tick
   bool has_deadline_ = false;
-  uint64_t deadline_ns_ = 0;
+  uint64_t deadline_ns_ = 0; // absolute, steady_now_ns() clock
 };
 
 } // namespace cambang
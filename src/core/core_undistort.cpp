@@ -0,0 +1,107 @@
+// src/core/core_undistort.cpp
+#include "core/core_undistort.h"
+
+#include <vector>
+
+namespace cambang {
+
+namespace {
+
+bool is_delivered_image_domain(const CoordinateDomain& domain) noexcept {
+  return std::holds_alternative<CoordinateDomainDeliveredImage>(domain);
+}
+
+// Maps a pixel-centre coordinate from a reference axis of ref_size pixels to
+// one of size pixels.
+double rescale_coordinate(double c, uint32_t ref_size, uint32_t size) noexcept {
+  const double scale = static_cast<double>(size) / static_cast<double>(ref_size);
+  return (c + 0.5) * scale - 0.5;
+}
+
+} // namespace
+
+std::optional<UndistortModel> undistort_model_for_image(const CameraStaticFacts& camera,
+                                                        uint32_t width,
+                                                        uint32_t height) {
+  if (!camera.intrinsics || !camera.distortion || width == 0 || height == 0) {
+    return std::nullopt;
+  }
+  const auto* bc5 = std::get_if<BrownConrady5Distortion>(&camera.distortion->value);
+  if (!bc5 || bc5->image_state() != DistortionImageState::DISTORTED) {
+    return std::nullopt;
+  }
+  const Intrinsics& k = camera.intrinsics->value;
+  if (!is_delivered_image_domain(k.coordinate_domain()) ||
+      !is_delivered_image_domain(bc5->coordinate_domain())) {
+    return std::nullopt;
+  }
+  const uint64_t ref_w = k.reference_width_px();
+  const uint64_t ref_h = k.reference_height_px();
+  if (ref_w * height != ref_h * width ||
+      static_cast<uint64_t>(bc5->reference_width_px()) * ref_h !=
+          static_cast<uint64_t>(bc5->reference_height_px()) * ref_w) {
+    return std::nullopt;
+  }
+
+  const double scale = static_cast<double>(width) / static_cast<double>(ref_w);
+  UndistortModel model{};
+  model.focal_length_x_px = k.focal_length_x_px() * scale;
+  model.focal_length_y_px = k.focal_length_y_px() * scale;
+  model.principal_point_x_px = rescale_coordinate(k.principal_point_x_px(), k.reference_width_px(), width);
+  model.principal_point_y_px = rescale_coordinate(k.principal_point_y_px(), k.reference_height_px(), height);
+  model.skew_px = k.skew_px().value_or(0.0) * scale;
+  model.radial_k1 = bc5->radial_k1();
+  model.radial_k2 = bc5->radial_k2();
+  model.radial_k3 = bc5->radial_k3();
+  model.tangential_p1 = bc5->tangential_p1();
+  model.tangential_p2 = bc5->tangential_p2();
+  return model;
+}
+
+UndistortRemapLutCache& undistort_remap_lut_cache() noexcept {
+  static UndistortRemapLutCache cache;
+  return cache;
+}
+
+bool copy_capture_member_undistorted_rgba(const CoreCaptureResultData::ImageMemberData& member,
+                                          uint8_t* dst,
+                                          size_t dst_size) {
+  const CoreResultPayloadCpuPacked& payload = member.payload;
+  if (!dst || !has_valid_retained_cpu_payload_layout(payload)) {
+    return false;
+  }
+  const size_t required = static_cast<size_t>(payload.width) * payload.height * 4u;
+  if (dst_size < required) {
+    return false;
+  }
+  const std::shared_ptr<const CameraStaticFacts>& camera = member.resolved_image_facts.camera;
+  if (!camera) {
+    return false;
+  }
+  const std::optional<UndistortModel> model =
+      undistort_model_for_image(*camera, payload.width, payload.height);
+  if (!model) {
+    return false;
+  }
+  const std::shared_ptr<const UndistortRemapLut> lut =
+      undistort_remap_lut_cache().get(*model, payload.width, payload.height);
+  if (!lut) {
+    return false;
+  }
+
+  const uint8_t* src = payload.data();
+  size_t src_stride = payload.stride_bytes;
+  std::vector<uint8_t> converted;
+  if (payload.format_fourcc != FOURCC_RGBA) {
+    converted.resize(required);
+    if (!copy_retained_cpu_payload_as_rgba(payload, converted.data(), converted.size())) {
+      return false;
+    }
+    src = converted.data();
+    src_stride = static_cast<size_t>(payload.width) * 4u;
+  }
+  remap_bilinear_rgba8(*lut, src, src_stride, dst);
+  return true;
+}
+
+} // namespace cambang
@@ -0,0 +1,43 @@
+// src/core/core_undistort.h
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+
+#include "core/camera_fact_types.h"
+#include "core/core_result_store.h"
+#include "pixels/remap/undistort_remap.h"
+
+namespace cambang {
+
+// Undistorted read of retained capture members, for native consumers that
+// would otherwise re-implement the remap outside CamBANG.
+//
+// The camera model comes from the member's resolved camera facts (external
+// camera description > provider per-image > provider static), so it follows
+// ExternalCameraDescriptionState without any invalidation hook: remap maps are
+// cached by model and resolution (UndistortRemapLutCache), and a changed model
+// is a different key. Each read is then one bilinear gather pass.
+
+// Model for a width x height image, or nullopt when the facts cannot describe
+// an undistortion of it: intrinsics or a Brown-Conrady distortion missing, a
+// distortion already RECTIFIED (or of unknown state), either fact in a
+// coordinate domain other than the delivered image, or a reference geometry
+// whose aspect ratio differs from the image's. Intrinsics are rescaled from
+// their reference size to the image size.
+std::optional<UndistortModel> undistort_model_for_image(const CameraStaticFacts& camera,
+                                                        uint32_t width,
+                                                        uint32_t height);
+
+// Process-wide map cache used by copy_capture_member_undistorted_rgba().
+UndistortRemapLutCache& undistort_remap_lut_cache() noexcept;
+
+// Writes member as tightly packed width*height undistorted RGBA8 into dst.
+// Returns false when the member has no valid CPU payload or no undistortion
+// model (see undistort_model_for_image), or dst is short.
+bool copy_capture_member_undistorted_rgba(const CoreCaptureResultData::ImageMemberData& member,
+                                          uint8_t* dst,
+                                          size_t dst_size);
+
+} // namespace cambang
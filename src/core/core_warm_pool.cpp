@@ -0,0 +1,164 @@
+// src/core/core_warm_pool.cpp
+#include "core/core_warm_pool.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace cambang {
+
+namespace {
+
+constexpr uint64_t kNsPerMs = 1000000ull;
+
+uint64_t saturating_add(uint64_t a, uint64_t b) noexcept {
+  return b > std::numeric_limits<uint64_t>::max() - a ? std::numeric_limits<uint64_t>::max() : a + b;
+}
+
+} // namespace
+
+double CoreWarmPool::decayed_score_(const History& h, uint64_t now_ns) noexcept {
+  if (now_ns <= h.score_ns) {
+    return h.score;
+  }
+  const double half_lives = static_cast<double>(now_ns - h.score_ns) / static_cast<double>(kScoreHalfLifeNs);
+  return h.score * std::exp2(-half_lives);
+}
+
+CoreWarmPool::History& CoreWarmPool::history_(const std::string& hardware_id, uint64_t now_ns) {
+  auto it = history_by_hardware_id_.find(hardware_id);
+  if (it != history_by_hardware_id_.end()) {
+    return it->second;
+  }
+  if (history_by_hardware_id_.size() >= kMaxHistory) {
+    auto coldest = history_by_hardware_id_.begin();
+    for (auto h = history_by_hardware_id_.begin(); h != history_by_hardware_id_.end(); ++h) {
+      if (decayed_score_(h->second, now_ns) < decayed_score_(coldest->second, now_ns)) {
+        coldest = h;
+      }
+    }
+    history_by_hardware_id_.erase(coldest);
+  }
+  return history_by_hardware_id_[hardware_id];
+}
+
+void CoreWarmPool::note_in_use(uint64_t device_instance_id, const std::string& hardware_id, uint64_t now_ns) {
+  Instance& inst = instances_[device_instance_id];
+  inst.seen_pass = pass_;
+  if (inst.in_use) {
+    return;
+  }
+  inst.in_use = true;
+  inst.has_idle_since = false;
+  if (hardware_id.empty()) {
+    return;
+  }
+
+  History& h = history_(hardware_id, now_ns);
+  if (h.has_last_idle && now_ns >= h.last_idle_ns) {
+    // Gaps far past anything the budget could hold are clipped so one long
+    // absence does not swamp the average.
+    const uint64_t clip_ns = 4ull * budget_.max_predicted_hold_ms * kNsPerMs;
+    const uint64_t gap_ns = std::min(now_ns - h.last_idle_ns, clip_ns);
+    h.mean_gap_ns = h.gap_samples == 0 ? gap_ns : (3 * h.mean_gap_ns + gap_ns) / 4;
+    if (h.gap_samples < std::numeric_limits<uint32_t>::max()) {
+      ++h.gap_samples;
+    }
+  }
+  h.has_last_idle = false;
+  h.score = decayed_score_(h, now_ns) + 1.0;
+  h.score_ns = now_ns;
+}
+
+void CoreWarmPool::plan(uint64_t now_ns, std::vector<IdleDevice>& devices) {
+  std::vector<Candidate>& candidates = candidates_;
+  candidates.clear();
+
+  for (size_t i = 0; i < devices.size(); ++i) {
+    IdleDevice& d = devices[i];
+    Instance& inst = instances_[d.device_instance_id];
+    inst.seen_pass = pass_;
+    History* h = nullptr;
+    if (d.hardware_id && !d.hardware_id->empty()) {
+      h = &history_(*d.hardware_id, now_ns);
+    }
+    if (inst.in_use || !inst.has_idle_since) {
+      inst.in_use = false;
+      inst.has_idle_since = true;
+      inst.idle_since_ns = now_ns;
+      if (h) {
+        h->has_last_idle = true;
+        h->last_idle_ns = now_ns;
+      }
+    }
+
+    const uint64_t hold_ns = static_cast<uint64_t>(d.warm_hold_ms) * kNsPerMs;
+    d.deadline_ns = saturating_add(inst.idle_since_ns, hold_ns);
+    d.extended = false;
+    if (h && h->gap_samples >= kMinGapSamples) {
+      const uint64_t predicted_ns = h->mean_gap_ns + h->mean_gap_ns / 2;
+      const uint64_t extended_deadline_ns = saturating_add(inst.idle_since_ns, predicted_ns);
+      if (predicted_ns > hold_ns &&
+          predicted_ns <= static_cast<uint64_t>(budget_.max_predicted_hold_ms) * kNsPerMs &&
+          extended_deadline_ns > now_ns) {
+        candidates.push_back(Candidate{i, decayed_score_(*h, now_ns), extended_deadline_ns});
+      }
+    }
+  }
+
+  // The budget goes to the most used devices; the rest keep their
+  // configured hold.
+  std::sort(candidates.begin(), candidates.end(), [&devices](const Candidate& a, const Candidate& b) {
+    if (a.score != b.score) {
+      return a.score > b.score;
+    }
+    return devices[a.index].device_instance_id < devices[b.index].device_instance_id;
+  });
+  const size_t granted = std::min(candidates.size(), static_cast<size_t>(budget_.max_extended_devices));
+  for (size_t i = 0; i < granted; ++i) {
+    IdleDevice& d = devices[candidates[i].index];
+    d.deadline_ns = candidates[i].deadline_ns;
+    d.extended = true;
+  }
+
+  for (IdleDevice& d : devices) {
+    const Instance& inst = instances_[d.device_instance_id];
+    if (inst.prewarm_until_ns > d.deadline_ns) {
+      d.deadline_ns = inst.prewarm_until_ns;
+    }
+  }
+
+  for (auto it = instances_.begin(); it != instances_.end();) {
+    it = it->second.seen_pass == pass_ ? std::next(it) : instances_.erase(it);
+  }
+  ++pass_;
+}
+
+void CoreWarmPool::prewarm(uint64_t device_instance_id, uint64_t until_ns) {
+  Instance& inst = instances_[device_instance_id];
+  inst.seen_pass = pass_;
+  inst.prewarm_until_ns = std::max(inst.prewarm_until_ns, until_ns);
+}
+
+void CoreWarmPool::start_generation() noexcept {
+  instances_.clear();
+  for (auto& [hardware_id, h] : history_by_hardware_id_) {
+    (void)hardware_id;
+    h.has_last_idle = false;
+    h.last_idle_ns = 0;
+    h.score_ns = 0;
+  }
+}
+
+bool CoreWarmPool::hardware_stats(const std::string& hardware_id, uint64_t now_ns, HardwareStats& out) const {
+  const auto it = history_by_hardware_id_.find(hardware_id);
+  if (it == history_by_hardware_id_.end()) {
+    return false;
+  }
+  out.gap_samples = it->second.gap_samples;
+  out.mean_gap_ns = it->second.mean_gap_ns;
+  out.score = decayed_score_(it->second, now_ns);
+  return true;
+}
+
+} // namespace cambang
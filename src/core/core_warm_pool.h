@@ -0,0 +1,117 @@
+// src/core/core_warm_pool.h
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace cambang {
+
+// Usage-driven extension of per-device warm-hold.
+//
+// A device's warm_hold_ms keeps it open (and its retained streams
+// configured) for a fixed time after its last use. The pool learns, per
+// hardware_id, how long the device usually sits idle before it is used again
+// (a moving average of observed idle-to-reuse gaps, including reuse that
+// needed a reopen because the hold had expired) and how often and how
+// recently it is used (a decayed use score). When the predicted gap is longer
+// than the configured hold but within Budget::max_predicted_hold_ms, the
+// device is held until the predicted reuse instead. At most
+// Budget::max_extended_devices idle devices hold such an extension at once,
+// the highest-scored ones; each open idle device costs power and memory, so
+// the budget counts devices.
+//
+// Pre-warm holds a device until an explicit time (a scheduled capture), in
+// addition to and outside the predictive budget.
+//
+// Devices with warm_hold_ms == 0 are never auto-closed and are left alone.
+// History is kept across device instances and runtime generations; a
+// device instance's idle state is dropped once it is no longer open.
+//
+// Threading: core thread only.
+class CoreWarmPool final {
+public:
+  static constexpr size_t kMaxHistory = 64;
+  // Use score half-life.
+  static constexpr uint64_t kScoreHalfLifeNs = 10ull * 60ull * 1000000000ull;
+  // Gap samples needed before a prediction is trusted.
+  static constexpr uint32_t kMinGapSamples = 2;
+
+  struct Budget {
+    uint32_t max_extended_devices = 2;
+    uint32_t max_predicted_hold_ms = 120000;
+  };
+
+  // One open, idle device with a nonzero warm hold, offered to plan().
+  struct IdleDevice {
+    uint64_t device_instance_id = 0;
+    const std::string* hardware_id = nullptr;
+    uint32_t warm_hold_ms = 0;
+    // Written by plan(): when the device may be closed.
+    uint64_t deadline_ns = 0;
+    bool extended = false;
+  };
+
+  void set_budget(const Budget& budget) noexcept { budget_ = budget; }
+  const Budget& budget() const noexcept { return budget_; }
+
+  // One warm pass: note_in_use() for every open device in use, then plan()
+  // over every open idle device with a nonzero hold. Use transitions are
+  // taken from consecutive passes; instances in neither are dropped.
+  void note_in_use(uint64_t device_instance_id, const std::string& hardware_id, uint64_t now_ns);
+  // Fills each device's deadline_ns from its configured hold, its prediction
+  // (within the budget) and any pre-warm.
+  void plan(uint64_t now_ns, std::vector<IdleDevice>& devices);
+
+  // Holds an open device until at least until_ns once it is idle.
+  void prewarm(uint64_t device_instance_id, uint64_t until_ns);
+
+  // Runtime start: drops instance state and the clock-relative parts of
+  // history (the core clock restarts per generation). Learned gaps, scores
+  // and the budget are kept.
+  void start_generation() noexcept;
+
+  struct HardwareStats {
+    uint32_t gap_samples = 0;
+    uint64_t mean_gap_ns = 0;
+    double score = 0.0;
+  };
+  bool hardware_stats(const std::string& hardware_id, uint64_t now_ns, HardwareStats& out) const;
+
+private:
+  struct History {
+    uint64_t last_idle_ns = 0;
+    bool has_last_idle = false;
+    uint64_t mean_gap_ns = 0;
+    uint32_t gap_samples = 0;
+    double score = 0.0;
+    uint64_t score_ns = 0;
+  };
+
+  struct Instance {
+    bool in_use = false;
+    bool has_idle_since = false;
+    uint64_t idle_since_ns = 0;
+    uint64_t prewarm_until_ns = 0;
+    uint64_t seen_pass = 0;
+  };
+
+  struct Candidate {
+    size_t index = 0;
+    double score = 0.0;
+    uint64_t deadline_ns = 0;
+  };
+
+  History& history_(const std::string& hardware_id, uint64_t now_ns);
+  static double decayed_score_(const History& h, uint64_t now_ns) noexcept;
+
+  Budget budget_{};
+  std::map<std::string, History> history_by_hardware_id_;
+  std::map<uint64_t, Instance> instances_;
+  uint64_t pass_ = 1;
+  std::vector<Candidate> candidates_;
+};
+
+} // namespace cambang
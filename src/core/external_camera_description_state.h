@@ -1,11 +1,15 @@
 #pragma once
 
+#include <atomic>
+#include <cstdint>
+#include <memory>
 #include <optional>
 #include <string>
 #include <unordered_map>
 
 #include "core/camera_concurrency_adc.h"
 #include "core/camera_fact_types.h"
+#include "core/core_registry_revision.h"
 
 namespace cambang {
 
@@ -30,14 +34,83 @@ class ExternalCameraDescriptionState final {
     return concurrency_;
   }
 
+  // Stamp of the last replace() (core_registry_revision.h); copies keep it,
+  // so equal stamps mean equal entries.
+  uint64_t revision() const noexcept { return revision_; }
+
   void replace(Entries entries, std::optional<camera_concurrency::Truth> concurrency) {
     entries_ = std::move(entries);
     concurrency_ = std::move(concurrency);
+    revision_ = next_core_registry_revision();
   }
 
  private:
   Entries entries_;
   std::optional<camera_concurrency::Truth> concurrency_;
+  uint64_t revision_ = 0;
+};
+
+// One immutable published description set and the camera description
+// version it was configured under (0 when none was).
+struct ExternalCameraDescriptionPublication {
+  ExternalCameraDescriptionState state;
+  uint64_t version = 0;
+};
+using SharedExternalCameraDescription = std::shared_ptr<const ExternalCameraDescriptionPublication>;
+
+// The active publication, swapped whole by a single writer and read from any
+// thread. load() is a reference-count bump: a reader then looks entries up in
+// a set that cannot change under it, with no lock and no copy, for as long as
+// it holds the pointer. Never null.
+class ExternalCameraDescriptionSlot final {
+ public:
+  ExternalCameraDescriptionSlot() : current_(empty_()) {}
+
+  ExternalCameraDescriptionSlot(const ExternalCameraDescriptionSlot&) = delete;
+  ExternalCameraDescriptionSlot& operator=(const ExternalCameraDescriptionSlot&) = delete;
+
+  // next == nullptr publishes the empty set. The replaced publication is
+  // released by its last reader.
+  void publish(SharedExternalCameraDescription next) noexcept {
+    store_(next ? std::move(next) : empty_());
+  }
+
+#if defined(__cpp_lib_atomic_shared_ptr)
+  SharedExternalCameraDescription load() const noexcept { return current_.load(std::memory_order_acquire); }
+
+ private:
+  void store_(SharedExternalCameraDescription next) noexcept {
+    current_.store(std::move(next), std::memory_order_release);
+  }
+
+  std::atomic<SharedExternalCameraDescription> current_;
+#else
+  // Pre-P0718 standard libraries: see LatestResultSlotTable::Slot.
+#if defined(__clang__) || defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wdeprecated-declarations"
+#endif
+  SharedExternalCameraDescription load() const noexcept {
+    return std::atomic_load_explicit(&current_, std::memory_order_acquire);
+  }
+
+ private:
+  void store_(SharedExternalCameraDescription next) noexcept {
+    std::atomic_store_explicit(&current_, std::move(next), std::memory_order_release);
+  }
+#if defined(__clang__) || defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+
+  SharedExternalCameraDescription current_;
+#endif
+
+  // Shared by every slot, so publishing "none" never allocates.
+  static SharedExternalCameraDescription empty_() {
+    static const SharedExternalCameraDescription empty =
+        std::make_shared<const ExternalCameraDescriptionPublication>();
+    return empty;
+  }
 };
 
 } // namespace cambang
@@ -1,15 +1,34 @@
 #pragma once
 
+#include <cstdint>
 #include <memory>
 
+#include "core/snapshot/state_snapshot.h"
+
 // Core-facing publication interface for the public release truth surface.
 //
-// publish() is called from the CamBANG core thread.
+// publish() is called from the CamBANG core thread, or from Core's snapshot
+// publish worker when CoreRuntime::set_snapshot_publish_offload() is on;
+// never from both, and never concurrently.
 // Implementations MUST NOT touch Godot APIs.
 
-struct CamBANGStateSnapshot;
+struct CamBANGStateSnapshotDelta;
 
 struct IStateSnapshotPublisher {
     virtual ~IStateSnapshotPublisher() = default;
     virtual void publish(std::shared_ptr<const CamBANGStateSnapshot> snapshot) = 0;
+
+    // Optional incremental stream (core/snapshot/snapshot_delta.h). Publishers
+    // that return true here also receive, right after each publish() except
+    // the first after attachment, the delta from the previously published
+    // snapshot to the one just published. Core computes deltas only for such
+    // publishers.
+    virtual bool wants_snapshot_delta() const noexcept { return false; }
+    virtual void publish_delta(const CamBANGStateSnapshotDelta& delta) { (void)delta; }
+
+    // Record sections (kCBSnapshotSection* bits) Core builds for this
+    // publisher; the rest are published empty. Read on the core thread before
+    // every build. A change of sections restarts the delta stream: the next
+    // publish() is not followed by a delta.
+    virtual uint32_t wanted_snapshot_sections() const noexcept { return kCBSnapshotSectionsAll; }
 };
@@ -0,0 +1,106 @@
+// src/core/inline_task.h
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace cambang {
+
+// Move-only, allocation-free `void()` callable with fixed inline storage.
+//
+// The callable is constructed directly inside the task object; there is no
+// heap fallback. A capture larger than Capacity (or over-aligned, or with a
+// throwing move) is rejected at compile time, so a call site that grows its
+// capture past the budget fails to build rather than silently allocating on
+// a hot path.
+//
+// Moving a task moves the callable into the destination and leaves the
+// source empty. An empty task is falsy; invoking one is undefined.
+template <size_t Capacity>
+class InlineTask final {
+public:
+  static constexpr size_t kCapacity = Capacity;
+
+  InlineTask() noexcept = default;
+  InlineTask(std::nullptr_t) noexcept {}
+
+  template <typename F,
+            typename Fn = std::decay_t<F>,
+            typename = std::enable_if_t<!std::is_same_v<Fn, InlineTask> &&
+                                        !std::is_same_v<Fn, std::nullptr_t> &&
+                                        std::is_invocable_r_v<void, Fn&>>>
+  InlineTask(F&& fn) noexcept(std::is_nothrow_constructible_v<Fn, F&&>) {
+    static_assert(sizeof(Fn) <= Capacity,
+                  "task capture exceeds InlineTask capacity; shrink the capture or box it explicitly");
+    static_assert(alignof(Fn) <= alignof(std::max_align_t),
+                  "task capture is over-aligned for InlineTask storage");
+    static_assert(std::is_nothrow_move_constructible_v<Fn>,
+                  "InlineTask moves its callable in noexcept contexts");
+    ::new (static_cast<void*>(storage_)) Fn(std::forward<F>(fn));
+    ops_ = &kOpsFor<Fn>;
+  }
+
+  InlineTask(InlineTask&& other) noexcept { take_(other); }
+
+  InlineTask& operator=(InlineTask&& other) noexcept {
+    if (this != &other) {
+      reset();
+      take_(other);
+    }
+    return *this;
+  }
+
+  InlineTask& operator=(std::nullptr_t) noexcept {
+    reset();
+    return *this;
+  }
+
+  InlineTask(const InlineTask&) = delete;
+  InlineTask& operator=(const InlineTask&) = delete;
+
+  ~InlineTask() { reset(); }
+
+  void reset() noexcept {
+    if (ops_) {
+      ops_->destroy(storage_);
+      ops_ = nullptr;
+    }
+  }
+
+  explicit operator bool() const noexcept { return ops_ != nullptr; }
+
+  void operator()() { ops_->invoke(storage_); }
+
+private:
+  struct Ops {
+    void (*invoke)(void* self);
+    void (*move_to)(void* dst, void* src) noexcept; // also destroys src
+    void (*destroy)(void* self) noexcept;
+  };
+
+  template <typename Fn>
+  static constexpr Ops kOpsFor{
+      [](void* self) { (*static_cast<Fn*>(self))(); },
+      [](void* dst, void* src) noexcept {
+        Fn* from = static_cast<Fn*>(src);
+        ::new (dst) Fn(std::move(*from));
+        from->~Fn();
+      },
+      [](void* self) noexcept { static_cast<Fn*>(self)->~Fn(); },
+  };
+
+  void take_(InlineTask& other) noexcept {
+    if (other.ops_) {
+      other.ops_->move_to(storage_, other.storage_);
+      ops_ = other.ops_;
+      other.ops_ = nullptr;
+    }
+  }
+
+  alignas(std::max_align_t) unsigned char storage_[Capacity];
+  const Ops* ops_ = nullptr;
+};
+
+} // namespace cambang
@@ -0,0 +1,148 @@
+// src/core/latest_result_slot_table.h
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+namespace cambang {
+
+// Fixed table of "latest result per key" slots for lock-free readers (the
+// latest result per stream, or per rig for rig stream frame sets).
+//
+// Each slot pairs an atomic key with an atomically swapped shared_ptr.
+// find() scans the slots without taking any lock, so a reader polling every
+// stream every frame never waits on writers (or on whatever lock serializes
+// them, e.g. capture retention or eviction work).
+//
+// Threading:
+// - find()/contains(): any thread, lock-free with respect to writers.
+// - every other member: writers only, externally serialized.
+//
+// Slot reuse: a slot freed by erase() may be claimed for another key while a
+// reader is between its key and value loads. find() therefore accepts a value
+// only if its Key member (stream_id by default) matches the key it looked up.
+//
+// Capacity is fixed; find_or_claim() returns kNoSlot when every slot is held
+// by another key and the caller keeps that value elsewhere.
+template <typename T, uint64_t T::*Key = &T::stream_id>
+class LatestResultSlotTable final {
+public:
+  using Shared = std::shared_ptr<const T>;
+
+  static constexpr size_t kSlots = 32;
+  static constexpr size_t kNoSlot = kSlots;
+
+  LatestResultSlotTable() = default;
+  LatestResultSlotTable(const LatestResultSlotTable&) = delete;
+  LatestResultSlotTable& operator=(const LatestResultSlotTable&) = delete;
+
+  Shared find(uint64_t key) const noexcept {
+    if (key == 0) {
+      return nullptr;
+    }
+    for (const Slot& slot : slots_) {
+      if (slot.key.load(std::memory_order_acquire) != key) {
+        continue;
+      }
+      Shared value = slot.load();
+      if (value && (*value).*Key == key) {
+        return value;
+      }
+    }
+    return nullptr;
+  }
+
+  bool contains(uint64_t key) const noexcept { return find(key) != nullptr; }
+
+  // Writer: slot already holding key, else the first free slot (keyed but
+  // still empty), else kNoSlot. `claimed` reports a newly keyed slot so a
+  // failed commit can give it back with release_claim().
+  size_t find_or_claim(uint64_t key, bool& claimed) noexcept {
+    claimed = false;
+    size_t free_slot = kNoSlot;
+    for (size_t i = 0; i < kSlots; ++i) {
+      const uint64_t held = slots_[i].key.load(std::memory_order_relaxed);
+      if (held == key) {
+        return i;
+      }
+      if (held == 0 && free_slot == kNoSlot) {
+        free_slot = i;
+      }
+    }
+    if (free_slot != kNoSlot) {
+      slots_[free_slot].key.store(key, std::memory_order_release);
+      claimed = true;
+    }
+    return free_slot;
+  }
+
+  // Writer: frees a slot claimed by find_or_claim() that never got a value.
+  void release_claim(size_t slot) noexcept {
+    slots_[slot].key.store(0, std::memory_order_release);
+  }
+
+  // Writer: publishes next in `slot` and returns the value it replaced.
+  Shared exchange(size_t slot, Shared next) noexcept { return slots_[slot].exchange(std::move(next)); }
+
+  // Writer: returns the removed value (nullptr when absent). The key is
+  // cleared after the value so a concurrent find() sees either the old value
+  // or nothing.
+  Shared erase(uint64_t key) noexcept {
+    for (Slot& slot : slots_) {
+      if (slot.key.load(std::memory_order_relaxed) == key) {
+        Shared removed = slot.exchange(nullptr);
+        slot.key.store(0, std::memory_order_release);
+        return removed;
+      }
+    }
+    return nullptr;
+  }
+
+  // Writer: empties every slot and hands the values to `sink(Shared&&)` so
+  // the caller controls where they are destroyed.
+  template <typename Sink>
+  void clear(Sink&& sink) {
+    for (Slot& slot : slots_) {
+      if (slot.key.load(std::memory_order_relaxed) == 0) {
+        continue;
+      }
+      sink(slot.exchange(nullptr));
+      slot.key.store(0, std::memory_order_release);
+    }
+  }
+
+private:
+  struct Slot {
+    std::atomic<uint64_t> key{0};
+
+#if defined(__cpp_lib_atomic_shared_ptr)
+    std::atomic<Shared> value{};
+
+    Shared load() const noexcept { return value.load(std::memory_order_acquire); }
+    Shared exchange(Shared next) noexcept { return value.exchange(std::move(next), std::memory_order_acq_rel); }
+#else
+    // Pre-P0718 standard libraries: the shared_ptr atomic free functions
+    // (deprecated in C++20, still provided) give the same guarantees.
+    Shared value{};
+
+#if defined(__clang__) || defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wdeprecated-declarations"
+#endif
+    Shared load() const noexcept { return std::atomic_load_explicit(&value, std::memory_order_acquire); }
+    Shared exchange(Shared next) noexcept {
+      return std::atomic_exchange_explicit(&value, std::move(next), std::memory_order_acq_rel);
+    }
+#if defined(__clang__) || defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+#endif
+  };
+
+  Slot slots_[kSlots];
+};
+
+} // namespace cambang
@@ -1,45 +1,277 @@
 #include "core/provider_callback_ingress.h"
 
+#include <algorithm>
 #include <chrono>
 #include <cstdio>
 #include <utility>
 
+#include "imaging/api/async_log.h"
+#include "imaging/api/frame_latency_trace.h"
 #include "imaging/api/timeline_teardown_trace.h"
 #include "core/resource_aggregate_telemetry.h"
 
+#if CAMBANG_PROVIDER_BOUND
+  #include "core/core_runtime.h"
+#endif
+
 namespace cambang {
 
+namespace {
+
+size_t stream_depth_home_slot(uint64_t stream_id) noexcept {
+  // Stream ids are sequential; spread them before masking.
+  return static_cast<size_t>((stream_id * 0x9e3779b97f4a7c15ULL) >> 32) &
+         (ProviderCallbackIngress::kStreamDepthSlots - 1);
+}
+
+} // namespace
+
+ProviderCallbackIngress::StreamDepthSlot* ProviderCallbackIngress::find_stream_depth_slot_(
+    uint64_t stream_id) const noexcept {
+  if (stream_id == 0 || stream_id == kRetiredStreamDepthSlot) {
+    return nullptr;
+  }
+  const size_t home = stream_depth_home_slot(stream_id);
+  for (size_t i = 0; i < kStreamDepthSlots; ++i) {
+    StreamDepthSlot& slot = stream_depth_slots_[(home + i) & (kStreamDepthSlots - 1)];
+    const uint64_t id = slot.stream_id.load(std::memory_order_acquire);
+    if (id == stream_id) {
+      return &slot;
+    }
+    if (id == 0) {
+      return nullptr;
+    }
+  }
+  return nullptr;
+}
+
+ProviderCallbackIngress::StreamDepthSlot* ProviderCallbackIngress::claim_stream_depth_slot_(
+    uint64_t stream_id) {
+  if (StreamDepthSlot* slot = find_stream_depth_slot_(stream_id)) {
+    return slot;
+  }
+  if (stream_id == 0 || stream_id == kRetiredStreamDepthSlot) {
+    return nullptr;
+  }
+  std::lock_guard<std::mutex> lock(stream_depth_claim_mu_);
+  // Claims are serialized, so a stream holds at most one slot.
+  if (StreamDepthSlot* slot = find_stream_depth_slot_(stream_id)) {
+    return slot;
+  }
+  const size_t home = stream_depth_home_slot(stream_id);
+  for (size_t i = 0; i < kStreamDepthSlots; ++i) {
+    StreamDepthSlot& slot = stream_depth_slots_[(home + i) & (kStreamDepthSlots - 1)];
+    const uint64_t id = slot.stream_id.load(std::memory_order_relaxed);
+    if (id != 0 && id != kRetiredStreamDepthSlot) {
+      continue;
+    }
+    slot.depth.store(0, std::memory_order_relaxed);
+    slot.retiring.store(false, std::memory_order_relaxed);
+    slot.priority.store(static_cast<uint8_t>(StreamPriority::NORMAL), std::memory_order_relaxed);
+    slot.lease_telemetry.store(
+        global_resource_aggregate_telemetry().acquire_handle(make_stream_scoped_resource_telemetry(stream_id)),
+        std::memory_order_relaxed);
+    slot.stream_id.store(stream_id, std::memory_order_release);
+    return &slot;
+  }
+  return nullptr;
+}
+
+void ProviderCallbackIngress::retire_stream_depth_slot_if_idle_(StreamDepthSlot& slot) {
+  std::lock_guard<std::mutex> lock(stream_depth_claim_mu_);
+  if (slot.retiring.load(std::memory_order_relaxed) &&
+      slot.depth.load(std::memory_order_relaxed) == 0) {
+    slot.retiring.store(false, std::memory_order_relaxed);
+    slot.stream_id.store(kRetiredStreamDepthSlot, std::memory_order_release);
+    ResourceAggregateTelemetry::Handle handle = slot.lease_telemetry.exchange({}, std::memory_order_relaxed);
+    global_resource_aggregate_telemetry().release_handle(handle);
+  }
+}
+
+ResourceAggregateTelemetry::Handle ProviderCallbackIngress::slot_lease_telemetry_(StreamDepthSlot* slot,
+                                                                                 uint64_t stream_id) {
+  if (!slot || slot->stream_id.load(std::memory_order_acquire) != stream_id) {
+    return {};
+  }
+  ResourceAggregateTelemetry::Handle handle = slot->lease_telemetry.load(std::memory_order_acquire);
+  if (handle) {
+    return handle;
+  }
+  // Unpinned by release_lease_telemetry_handles(); re-pin on the stream's
+  // next frame.
+  std::lock_guard<std::mutex> lock(stream_depth_claim_mu_);
+  if (slot->stream_id.load(std::memory_order_relaxed) != stream_id) {
+    return {};
+  }
+  handle = slot->lease_telemetry.load(std::memory_order_relaxed);
+  if (!handle) {
+    handle = global_resource_aggregate_telemetry().acquire_handle(make_stream_scoped_resource_telemetry(stream_id));
+    slot->lease_telemetry.store(handle, std::memory_order_release);
+  }
+  return handle;
+}
+
+void ProviderCallbackIngress::increment_stream_ingress_depth_(StreamDepthSlot* slot) noexcept {
+  if (slot && slot->depth.fetch_add(1, std::memory_order_relaxed) == 0) {
+    streams_with_frames_queued_.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+StreamPriority ProviderCallbackIngress::slot_priority_(const StreamDepthSlot* slot) noexcept {
+  return slot ? static_cast<StreamPriority>(slot->priority.load(std::memory_order_relaxed))
+              : StreamPriority::NORMAL;
+}
+
+size_t ProviderCallbackIngress::fair_share_threshold_(StreamPriority priority) const noexcept {
+  const size_t capacity = core_thread_->ordinary_lane_capacity();
+  switch (priority) {
+    case StreamPriority::LOW:
+      return capacity * kLowPriorityOrdinaryLaneNumerator / kLowPriorityOrdinaryLaneDenominator;
+    case StreamPriority::HIGH:
+      return capacity;
+    case StreamPriority::NORMAL:
+      break;
+  }
+  return capacity * kCongestedOrdinaryLaneNumerator / kCongestedOrdinaryLaneDenominator;
+}
+
+void ProviderCallbackIngress::count_pressure_drop_(uint64_t stream_id) noexcept {
+  const StreamPriority priority = slot_priority_(find_stream_depth_slot_(stream_id));
+  frames_dropped_pressure_by_priority_[static_cast<size_t>(priority)].fetch_add(1, std::memory_order_relaxed);
+}
+
+void ProviderCallbackIngress::set_stream_priority(uint64_t stream_id, StreamPriority priority) {
+  // NORMAL is every slot's default; only an existing slot needs resetting.
+  StreamDepthSlot* slot = priority == StreamPriority::NORMAL ? find_stream_depth_slot_(stream_id)
+                                                             : claim_stream_depth_slot_(stream_id);
+  if (slot) {
+    slot->priority.store(static_cast<uint8_t>(priority), std::memory_order_relaxed);
+  }
+}
+
+void ProviderCallbackIngress::forget_stream_priority(uint64_t stream_id) {
+  if (StreamDepthSlot* slot = find_stream_depth_slot_(stream_id)) {
+    slot->retiring.store(true, std::memory_order_relaxed);
+    retire_stream_depth_slot_if_idle_(*slot);
+  }
+}
+
+void ProviderCallbackIngress::decrement_stream_ingress_depth_(uint64_t stream_id) {
+  StreamDepthSlot* slot = find_stream_depth_slot_(stream_id);
+  if (!slot) {
+    return;
+  }
+  uint32_t depth = slot->depth.load(std::memory_order_relaxed);
+  while (depth > 0 &&
+         !slot->depth.compare_exchange_weak(depth, depth - 1, std::memory_order_relaxed)) {
+  }
+  if (depth != 1) {
+    return;
+  }
+  streams_with_frames_queued_.fetch_sub(1, std::memory_order_relaxed);
+  if (slot->retiring.load(std::memory_order_relaxed)) {
+    retire_stream_depth_slot_if_idle_(*slot);
+  }
+}
+
 uint32_t ProviderCallbackIngress::on_frame_ingress_enqueued_(uint64_t stream_id) {
   if (stream_id == 0) {
     return 0;
   }
-  std::lock_guard<std::mutex> lock(ingress_mu_);
-  uint32_t& depth = stream_ingress_depth_[stream_id];
-  depth++;
-  return depth;
+  StreamDepthSlot* slot = claim_stream_depth_slot_(stream_id);
+  increment_stream_ingress_depth_(slot);
+  return slot ? slot->depth.load(std::memory_order_relaxed) : 0;
 }
 
-void ProviderCallbackIngress::on_frame_ingress_failed_(uint64_t stream_id) {
-  if (stream_id == 0) {
-    return;
+void ProviderCallbackIngress::release_lease_telemetry_handles() noexcept {
+  std::lock_guard<std::mutex> lock(stream_depth_claim_mu_);
+  for (StreamDepthSlot& slot : stream_depth_slots_) {
+    ResourceAggregateTelemetry::Handle handle = slot.lease_telemetry.exchange({}, std::memory_order_relaxed);
+    global_resource_aggregate_telemetry().release_handle(handle);
   }
-  std::lock_guard<std::mutex> lock(ingress_mu_);
-  auto it = stream_ingress_depth_.find(stream_id);
-  if (it == stream_ingress_depth_.end()) {
-    return;
+}
+
+bool ProviderCallbackIngress::try_admit_repeating_frame_(uint64_t stream_id,
+                                                         ResourceAggregateTelemetry::Handle& lease_telemetry) {
+  StreamDepthSlot* slot = claim_stream_depth_slot_(stream_id);
+  const StreamPriority priority = slot_priority_(slot);
+  const size_t threshold = fair_share_threshold_(priority);
+  const bool congested = core_thread_->ordinary_lane_pending() >= threshold;
+  if (congested && slot && priority != StreamPriority::HIGH) {
+    // Share among the streams with frames queued, counting this one now; a
+    // lone stream has nobody to share with and runs to QueueFull. Concurrent
+    // producers of one stream may overshoot its share by one frame each.
+    const uint32_t depth = slot->depth.load(std::memory_order_relaxed);
+    const size_t queued_streams =
+        streams_with_frames_queued_.load(std::memory_order_relaxed) + (depth == 0 ? 1 : 0);
+    if (queued_streams > 1 && depth >= std::max<size_t>(1, threshold / queued_streams)) {
+      return false;
+    }
   }
-  if (it->second > 0) {
-    it->second--;
+  increment_stream_ingress_depth_(slot);
+  // Read once the frame holds the slot's depth above 0, so the slot cannot
+  // retire and unpin the bucket before the count. Without a slot the handle
+  // stays unset and post_command() counts the lease by key.
+  lease_telemetry = slot_lease_telemetry_(slot, stream_id);
+  if (lease_telemetry) {
+    global_resource_aggregate_telemetry().lease_created(lease_telemetry);
   }
-  if (it->second == 0) {
-    stream_ingress_depth_.erase(it);
+  return true;
+}
+
+void ProviderCallbackIngress::on_frame_ingress_failed_(uint64_t stream_id) {
+  if (stream_id == 0) {
+    return;
   }
+  decrement_stream_ingress_depth_(stream_id);
 }
 
 void ProviderCallbackIngress::on_frame_ingress_dispatched_(uint64_t stream_id) {
   on_frame_ingress_failed_(stream_id);
 }
 
+void ProviderCallbackIngress::LatestWinsSlot::push_newest(const FrameView& frame) noexcept {
+  frames[(head + count) % kMaxLatestWinsFramesPerStream] = frame;
+  count++;
+}
+
+FrameView ProviderCallbackIngress::LatestWinsSlot::pop_oldest() noexcept {
+  FrameView out = std::move(frames[head]);
+  frames[head] = FrameView{};
+  head = (head + 1) % kMaxLatestWinsFramesPerStream;
+  count--;
+  return out;
+}
+
+#if CAMBANG_PROVIDER_BOUND
+ProviderBoundCallbacks* bind_provider_callbacks(IProviderCallbacks* callbacks) noexcept {
+  return static_cast<ProviderCallbackIngress*>(callbacks);
+}
+
+ProviderCallbackIngress::ProviderCallbackIngress(CoreThread* core_thread, CoreRuntime* runtime)
+    : core_thread_(core_thread),
+      runtime_(runtime) {}
+
+bool ProviderCallbackIngress::has_core_sink_() const noexcept {
+  return runtime_ != nullptr;
+}
+
+void ProviderCallbackIngress::sink_to_core_(ProviderToCoreCommand&& cmd) {
+  runtime_->enqueue_provider_fact(std::move(cmd));
+}
+
+uint64_t ProviderCallbackIngress::applying_stream_retained_plan_stream_id_() const {
+  return runtime_ ? runtime_->applying_stream_retained_plan_for_stream_id_.load(std::memory_order_acquire) : 0;
+}
+
+uint64_t ProviderCallbackIngress::core_monotonic_now_ns() {
+  return runtime_ ? runtime_->ns_since_epoch_() : 0;
+}
+
+bool ProviderCallbackIngress::is_stream_display_demand_active(uint64_t stream_id) {
+  return runtime_ ? runtime_->provider_stream_display_demand_active_(stream_id) : false;
+}
+#else
 ProviderCallbackIngress::ProviderCallbackIngress(CoreThread* core_thread,
                                                  std::function<void(ProviderToCoreCommand&&)> sink,
                                                  std::function<uint64_t()> core_monotonic_now_ns,
@@ -51,10 +283,16 @@ ProviderCallbackIngress::ProviderCallbackIngress(CoreThread* core_thread,
       is_stream_display_demand_active_(std::move(is_stream_display_demand_active)),
       applying_stream_retained_plan_for_stream_id_(std::move(applying_stream_retained_plan_for_stream_id)) {}
 
-uint64_t ProviderCallbackIngress::allocate_native_id(NativeObjectType /*type*/) {
-  // Core-issued, globally unique for this process/session.
-  // Providers may request IDs from any thread; atomic is sufficient.
-  return native_id_seq_.fetch_add(1, std::memory_order_relaxed);
+bool ProviderCallbackIngress::has_core_sink_() const noexcept {
+  return static_cast<bool>(sink_);
+}
+
+void ProviderCallbackIngress::sink_to_core_(ProviderToCoreCommand&& cmd) {
+  sink_(std::move(cmd));
+}
+
+uint64_t ProviderCallbackIngress::applying_stream_retained_plan_stream_id_() const {
+  return applying_stream_retained_plan_for_stream_id_ ? applying_stream_retained_plan_for_stream_id_() : 0;
 }
 
 uint64_t ProviderCallbackIngress::core_monotonic_now_ns() {
@@ -70,6 +308,30 @@ bool ProviderCallbackIngress::is_stream_display_demand_active(uint64_t stream_id
   }
   return is_stream_display_demand_active_(stream_id);
 }
+#endif
+
+ProviderCallbackIngress::~ProviderCallbackIngress() {
+  release_lease_telemetry_handles();
+}
+
+uint64_t ProviderCallbackIngress::allocate_native_id(NativeObjectType /*type*/) {
+  // Core-issued, globally unique for this process/session.
+  // Providers may request IDs from any thread; atomic is sufficient.
+  return native_id_seq_.fetch_add(1, std::memory_order_relaxed);
+}
+
+std::shared_ptr<CpuPayloadBytes> ProviderCallbackIngress::acquire_cpu_payload_buffer(
+    const CpuPayloadBufferKey& key) {
+  if (!cpu_payload_buffer_pool_) {
+    return nullptr;
+  }
+  return cpu_payload_buffer_pool_->acquire(key);
+}
+
+void ProviderCallbackIngress::set_latest_wins_frames_per_stream(uint32_t frames) noexcept {
+  latest_wins_frames_per_stream_.store(std::min(frames, kMaxLatestWinsFramesPerStream),
+                                       std::memory_order_relaxed);
+}
 
 ProviderCallbackIngress::Stats ProviderCallbackIngress::stats_copy() const noexcept {
   Stats s;
@@ -87,118 +349,137 @@ ProviderCallbackIngress::Stats ProviderCallbackIngress::stats_copy() const noexc
   s.frames_released_on_drop_full = frames_released_on_drop_full_.load(std::memory_order_relaxed);
   s.frames_released_on_drop_closed = frames_released_on_drop_closed_.load(std::memory_order_relaxed);
   s.frames_released_on_drop_allocfail = frames_released_on_drop_allocfail_.load(std::memory_order_relaxed);
+
+  s.frames_coalesced_latest_wins = frames_coalesced_latest_wins_.load(std::memory_order_relaxed);
+  s.frames_dropped_fair_share = frames_dropped_fair_share_.load(std::memory_order_relaxed);
+  for (size_t i = 0; i < kStreamPriorityCount; ++i) {
+    s.frames_dropped_pressure_by_priority[i] = frames_dropped_pressure_by_priority_[i].load(std::memory_order_relaxed);
+  }
+  s.native_object_counters_coalesced = native_object_counters_coalesced_.load(std::memory_order_relaxed);
   return s;
 }
 
-uint32_t ProviderCallbackIngress::ingress_depth_for_stream(uint64_t stream_id) const {
-  if (stream_id == 0) {
-    return 0;
+bool ProviderCallbackIngress::is_stream_ingress_congested(uint64_t stream_id) {
+  if (!core_thread_) {
+    return false;
+  }
+  const StreamPriority priority =
+      stream_id == 0 ? StreamPriority::NORMAL : slot_priority_(find_stream_depth_slot_(stream_id));
+  if (core_thread_->ordinary_lane_pending() >= fair_share_threshold_(priority)) {
+    return true;
+  }
+  const uint32_t limit = latest_wins_frames_per_stream_.load(std::memory_order_relaxed);
+  if (limit == 0 || stream_id == 0) {
+    return false;
   }
   std::lock_guard<std::mutex> lock(ingress_mu_);
-  const auto it = stream_ingress_depth_.find(stream_id);
-  return (it != stream_ingress_depth_.end()) ? it->second : 0;
+  const auto it = latest_wins_slots_.find(stream_id);
+  return it != latest_wins_slots_.end() && it->second.count >= limit;
+}
+
+StreamPriority ProviderCallbackIngress::stream_priority(uint64_t stream_id) {
+  return slot_priority_(find_stream_depth_slot_(stream_id));
+}
+
+uint32_t ProviderCallbackIngress::ingress_depth_for_stream(uint64_t stream_id) const noexcept {
+  const StreamDepthSlot* slot = find_stream_depth_slot_(stream_id);
+  return slot ? slot->depth.load(std::memory_order_relaxed) : 0;
 }
 
 bool ProviderCallbackIngress::is_frame_command_(ProviderToCoreCommandType type) noexcept {
   return type == ProviderToCoreCommandType::PROVIDER_FRAME;
 }
 
+void ProviderCallbackIngress::release_dropped_frame_(FrameView& frame,
+                                                     ResourceAggregateTelemetry::Handle lease_telemetry) {
+  frame.release_now();
+  framebuffer_lease_released(lease_telemetry, frame.stream_id, frame.acquisition_session_id);
+  frame.release = nullptr;
+  frame.release_user = nullptr;
+}
+
+void ProviderCallbackIngress::account_command_drop_(CoreThread::PostResult r,
+                                                    ProviderToCoreCommandType type) noexcept {
+  switch (r) {
+    case CoreThread::PostResult::QueueFull:
+      commands_dropped_full_.fetch_add(1, std::memory_order_relaxed);
+      break;
+    case CoreThread::PostResult::Closed:
+      commands_dropped_closed_.fetch_add(1, std::memory_order_relaxed);
+      if (!is_frame_command_(type)) {
+        non_frame_rejected_closed_.fetch_add(1, std::memory_order_relaxed);
+      }
+      break;
+    case CoreThread::PostResult::AllocFail:
+      commands_dropped_allocfail_.fetch_add(1, std::memory_order_relaxed);
+      if (!is_frame_command_(type)) {
+        non_frame_rejected_allocfail_.fetch_add(1, std::memory_order_relaxed);
+      }
+      break;
+    case CoreThread::PostResult::Enqueued:
+      break;
+  }
+}
+
+void ProviderCallbackIngress::account_frame_drop_and_release_(CoreThread::PostResult r,
+                                                              FrameView& frame,
+                                                              ResourceAggregateTelemetry::Handle lease_telemetry) {
+  switch (r) {
+    case CoreThread::PostResult::QueueFull:
+      frames_dropped_full_.fetch_add(1, std::memory_order_relaxed);
+      if (frame.capture_id == 0) {
+        count_pressure_drop_(frame.stream_id);
+      }
+      release_dropped_frame_(frame, lease_telemetry);
+      frames_released_on_drop_full_.fetch_add(1, std::memory_order_relaxed);
+      break;
+    case CoreThread::PostResult::Closed:
+      frames_dropped_closed_.fetch_add(1, std::memory_order_relaxed);
+      release_dropped_frame_(frame, lease_telemetry);
+      frames_released_on_drop_closed_.fetch_add(1, std::memory_order_relaxed);
+      break;
+    case CoreThread::PostResult::AllocFail:
+      frames_dropped_allocfail_.fetch_add(1, std::memory_order_relaxed);
+      release_dropped_frame_(frame, lease_telemetry);
+      frames_released_on_drop_allocfail_.fetch_add(1, std::memory_order_relaxed);
+      break;
+    case CoreThread::PostResult::Enqueued:
+      break;
+  }
+}
+
 void ProviderCallbackIngress::post_command(ProviderToCoreCommand cmd) {
   // Transport only: package command into a posted task.
-  // Note: This uses std::function internally (CoreThread::Task), which may allocate.
-  // That is acceptable for scaffolding; later we can replace with a fixed-capacity provider_to_core_commands queue.
+  // The task is stored inline in a CoreThread ring cell (CoreThread::Task), so
+  // posting does not allocate; the command payload must fit kTaskInlineBytes.
   const ProviderToCoreCommandType type = cmd.type;
-  uint64_t trace_capture_id = 0;
-  uint64_t trace_device_id = 0;
-  uint64_t trace_acquisition_session_id = 0;
-  uint32_t trace_member_index = 0;
-  if (type == ProviderToCoreCommandType::PROVIDER_CAPTURE_STARTED) {
-    const auto& p = std::get<CmdProviderCaptureStarted>(cmd.payload);
-    trace_capture_id = p.capture_id;
-    trace_device_id = p.device_instance_id;
-  } else if (type == ProviderToCoreCommandType::PROVIDER_CAPTURE_COMPLETED) {
-    const auto& p = std::get<CmdProviderCaptureCompleted>(cmd.payload);
-    trace_capture_id = p.capture_id;
-    trace_device_id = p.device_instance_id;
-  } else if (type == ProviderToCoreCommandType::PROVIDER_CAPTURE_FAILED) {
-    const auto& p = std::get<CmdProviderCaptureFailed>(cmd.payload);
-    trace_capture_id = p.capture_id;
-    trace_device_id = p.device_instance_id;
-  }
   uint64_t frame_stream_id = 0;
   bool is_capture_critical_frame = false;
 
   // Preserve a copy of the frame for the failure-to-enqueue path. We must not rely on
   // moved-from ProviderToCoreCommand contents after constructing the posted lambda.
   FrameView fail_frame;
+  ResourceAggregateTelemetry::Handle fail_lease_telemetry;
   bool has_fail_frame = false;
   if (is_frame_command_(type)) {
     auto& frame_payload = std::get<CmdProviderFrame>(cmd.payload);
+    // The failure path needs the frame for its release hook, not its shared
+    // owners (see FrameView::release); set them aside so this per-frame copy
+    // costs no reference-count traffic.
+    auto cpu_payload_owner = std::move(frame_payload.frame.cpu_payload_owner);
+    auto primary_backing_artifact = std::move(frame_payload.frame.primary_backing_artifact);
     fail_frame = frame_payload.frame;
+    frame_payload.frame.cpu_payload_owner = std::move(cpu_payload_owner);
+    frame_payload.frame.primary_backing_artifact = std::move(primary_backing_artifact);
     frame_stream_id = frame_payload.frame.stream_id;
-    trace_capture_id = frame_payload.frame.capture_id;
-    trace_device_id = frame_payload.frame.device_instance_id;
-    trace_acquisition_session_id = frame_payload.frame.acquisition_session_id;
-    trace_member_index = frame_payload.frame.capture_image.image_member_index;
     is_capture_critical_frame = frame_payload.frame.capture_id != 0;
     has_fail_frame = true;
-    global_resource_aggregate_telemetry().lease_created(make_framebuffer_lease_scoped_resource_telemetry_key(
-        frame_payload.frame.stream_id,
-        frame_payload.frame.acquisition_session_id));
-  }
-
-  auto account_command_drop = [this, type](CoreThread::PostResult rr) {
-    switch (rr) {
-      case CoreThread::PostResult::QueueFull:
-        commands_dropped_full_.fetch_add(1, std::memory_order_relaxed);
-        break;
-      case CoreThread::PostResult::Closed:
-        commands_dropped_closed_.fetch_add(1, std::memory_order_relaxed);
-        if (!is_frame_command_(type)) {
-          non_frame_rejected_closed_.fetch_add(1, std::memory_order_relaxed);
-        }
-        break;
-      case CoreThread::PostResult::AllocFail:
-        commands_dropped_allocfail_.fetch_add(1, std::memory_order_relaxed);
-        if (!is_frame_command_(type)) {
-          non_frame_rejected_allocfail_.fetch_add(1, std::memory_order_relaxed);
-        }
-        break;
-      case CoreThread::PostResult::Enqueued:
-        break;
-    }
-  };
-
-  auto release_dropped_frame = [](FrameView& frame) {
-    frame.release_now();
-    global_resource_aggregate_telemetry().lease_released(make_framebuffer_lease_scoped_resource_telemetry_key(
-        frame.stream_id,
-        frame.acquisition_session_id));
-    frame.release = nullptr;
-    frame.release_user = nullptr;
-  };
-
-  auto account_frame_drop_and_release = [this, release_dropped_frame](CoreThread::PostResult rr, FrameView& frame) {
-    switch (rr) {
-      case CoreThread::PostResult::QueueFull:
-        frames_dropped_full_.fetch_add(1, std::memory_order_relaxed);
-        release_dropped_frame(frame);
-        frames_released_on_drop_full_.fetch_add(1, std::memory_order_relaxed);
-        break;
-      case CoreThread::PostResult::Closed:
-        frames_dropped_closed_.fetch_add(1, std::memory_order_relaxed);
-        release_dropped_frame(frame);
-        frames_released_on_drop_closed_.fetch_add(1, std::memory_order_relaxed);
-        break;
-      case CoreThread::PostResult::AllocFail:
-        frames_dropped_allocfail_.fetch_add(1, std::memory_order_relaxed);
-        release_dropped_frame(frame);
-        frames_released_on_drop_allocfail_.fetch_add(1, std::memory_order_relaxed);
-        break;
-      case CoreThread::PostResult::Enqueued:
-        break;
+    fail_lease_telemetry = frame_payload.lease_telemetry;
+    // A frame carrying a handle was counted at admission.
+    if (!frame_payload.lease_telemetry) {
+      framebuffer_lease_created({}, frame_payload.frame.stream_id, frame_payload.frame.acquisition_session_id);
     }
-  };
+  }
 
   auto account_post_failure = [&](CoreThread::PostResult r) {
     // Failure path: command never entered the core thread.
@@ -206,11 +487,11 @@ void ProviderCallbackIngress::post_command(ProviderToCoreCommand cmd) {
     // queue. Non-frame provider facts and still-capture frames use CoreThread's
     // essential queue, so QueueFull is not an expected failure reason for
     // lifecycle/native/error/capture-terminal truth or exact capture image facts.
-    account_command_drop(r);
+    account_command_drop_(r, type);
 
     if (has_fail_frame) {
       on_frame_ingress_failed_(frame_stream_id);
-      account_frame_drop_and_release(r, fail_frame);
+      account_frame_drop_and_release_(r, fail_frame, fail_lease_telemetry);
     }
   };
 
@@ -219,28 +500,16 @@ void ProviderCallbackIngress::post_command(ProviderToCoreCommand cmd) {
     return;
   }
 
-  // NOTE: sink_ is copied into the posted lambda. This keeps ingress transport-pure
-  // and avoids coupling to any specific dispatcher type.
-  auto task = [this,
-               c = std::move(cmd),
-               sink = sink_,
-               frame_stream_id,
-               release_dropped_frame,
-               trace_capture_id,
-               trace_device_id,
-               trace_acquisition_session_id,
-               trace_member_index,
-               trace_type = type]() mutable {
-    (void)trace_capture_id;
-    (void)trace_device_id;
-    (void)trace_acquisition_session_id;
-    (void)trace_member_index;
-    (void)trace_type;
+  // The task reaches the core sink through this rather than carrying its own
+  // copy: the sink is fixed at construction and this already outlives every
+  // posted task (dispatch updates its ingress depth), so a per-command
+  // std::function copy would only add a copy and widen the inline task.
+  auto task = [this, c = std::move(cmd), frame_stream_id]() mutable {
     if (c.type == ProviderToCoreCommandType::PROVIDER_FRAME) {
       on_frame_ingress_dispatched_(frame_stream_id);
     }
-    if (sink) {
-      sink(std::move(c));
+    if (has_core_sink_()) {
+      sink_to_core_(std::move(c));
       return;
     }
 
@@ -249,10 +518,13 @@ void ProviderCallbackIngress::post_command(ProviderToCoreCommand cmd) {
     // even if no sink is bound. Ingress depth was already decremented above.
     if (c.type == ProviderToCoreCommandType::PROVIDER_FRAME) {
       auto& p = std::get<CmdProviderFrame>(c.payload);
-      release_dropped_frame(p.frame);
+      release_dropped_frame_(p.frame, p.lease_telemetry);
     }
   };
 
+  static_assert(sizeof(task) <= CoreThread::kTaskInlineBytes,
+                "provider ingress task must fit CoreThread's inline task storage");
+
   const CoreThread::PostResult r = (is_frame_command_(type) && !is_capture_critical_frame)
       ? core_thread_->try_post(std::move(task))
       : core_thread_->try_post_essential(std::move(task));
@@ -264,6 +536,94 @@ void ProviderCallbackIngress::post_command(ProviderToCoreCommand cmd) {
   account_post_failure(r);
 }
 
+void ProviderCallbackIngress::post_latest_wins_frame_(const FrameView& frame, uint32_t limit) {
+  const uint64_t stream_id = frame.stream_id;
+
+  // Park the frame. Every parked frame has exactly one stream_id token queued
+  // on the ordinary lane, except the one just parked below until its token is
+  // posted. Replacing in place therefore needs no new token.
+  FrameView superseded;
+  bool has_superseded = false;
+  ResourceAggregateTelemetry::Handle lease_telemetry;
+  StreamDepthSlot* depth_slot = claim_stream_depth_slot_(stream_id);
+  {
+    std::lock_guard<std::mutex> lock(ingress_mu_);
+    LatestWinsSlot& slot = latest_wins_slots_[stream_id];
+    if (slot.count >= limit) {
+      superseded = slot.pop_oldest();
+      has_superseded = true;
+    } else {
+      increment_stream_ingress_depth_(depth_slot);
+    }
+    slot.push_newest(frame);
+    // Counted before dispatch can see the frame (it takes ingress_mu_), and
+    // with the stream's parked frames holding its depth above 0 so the slot
+    // cannot unpin the bucket in between.
+    lease_telemetry = slot_lease_telemetry_(depth_slot, stream_id);
+    framebuffer_lease_created(lease_telemetry, stream_id, frame.acquisition_session_id);
+  }
+  if (has_superseded) {
+    release_dropped_frame_(superseded, lease_telemetry);
+    frames_coalesced_latest_wins_.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+
+  const CoreThread::PostResult r =
+      core_thread_->try_post([this, stream_id]() { dispatch_latest_wins_frame_(stream_id); });
+  if (r == CoreThread::PostResult::Enqueued) {
+    return;
+  }
+
+  // No token for the frame just parked: retire the oldest parked frame so the
+  // token count matches again. With older frames parked that keeps the newest
+  // (coalescing under lane pressure); otherwise the new frame itself is dropped.
+  FrameView retired;
+  bool coalesced = false;
+  {
+    std::lock_guard<std::mutex> lock(ingress_mu_);
+    auto it = latest_wins_slots_.find(stream_id);
+    coalesced = it->second.count > 1;
+    retired = it->second.pop_oldest();
+    if (it->second.count == 0) {
+      latest_wins_slots_.erase(it);
+    }
+    decrement_stream_ingress_depth_(stream_id);
+  }
+  if (coalesced && r == CoreThread::PostResult::QueueFull) {
+    release_dropped_frame_(retired, lease_telemetry);
+    frames_coalesced_latest_wins_.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+  account_command_drop_(r, ProviderToCoreCommandType::PROVIDER_FRAME);
+  account_frame_drop_and_release_(r, retired, lease_telemetry);
+}
+
+void ProviderCallbackIngress::dispatch_latest_wins_frame_(uint64_t stream_id) {
+  ProviderToCoreCommand cmd;
+  cmd.type = ProviderToCoreCommandType::PROVIDER_FRAME;
+  {
+    std::lock_guard<std::mutex> lock(ingress_mu_);
+    auto it = latest_wins_slots_.find(stream_id);
+    if (it == latest_wins_slots_.end() || it->second.count == 0) {
+      return;
+    }
+    // Parked frames were counted into the stream's bucket, which its slot
+    // keeps pinned until they drain; without a slot they release by key.
+    cmd.payload = CmdProviderFrame{it->second.pop_oldest(),
+                                   slot_lease_telemetry_(find_stream_depth_slot_(stream_id), stream_id)};
+    if (it->second.count == 0) {
+      latest_wins_slots_.erase(it);
+    }
+    decrement_stream_ingress_depth_(stream_id);
+  }
+  auto& p = std::get<CmdProviderFrame>(cmd.payload);
+  if (has_core_sink_()) {
+    sink_to_core_(std::move(cmd));
+    return;
+  }
+  release_dropped_frame_(p.frame, p.lease_telemetry);
+}
+
 void ProviderCallbackIngress::on_device_opened(uint64_t device_instance_id) {
   ProviderToCoreCommand cmd;
   cmd.type = ProviderToCoreCommandType::PROVIDER_DEVICE_OPENED;
@@ -279,6 +639,7 @@ void ProviderCallbackIngress::on_device_closed(uint64_t device_instance_id) {
 }
 
 void ProviderCallbackIngress::on_stream_created(uint64_t stream_id) {
+  (void)claim_stream_depth_slot_(stream_id);
   ProviderToCoreCommand cmd;
   cmd.type = ProviderToCoreCommandType::PROVIDER_STREAM_CREATED;
   cmd.payload = CmdProviderStreamCreated{stream_id};
@@ -286,6 +647,10 @@ void ProviderCallbackIngress::on_stream_created(uint64_t stream_id) {
 }
 
 void ProviderCallbackIngress::on_stream_destroyed(uint64_t stream_id) {
+  if (StreamDepthSlot* slot = find_stream_depth_slot_(stream_id)) {
+    slot->retiring.store(true, std::memory_order_relaxed);
+    retire_stream_depth_slot_if_idle_(*slot);
+  }
   ProviderToCoreCommand cmd;
   cmd.type = ProviderToCoreCommandType::PROVIDER_STREAM_DESTROYED;
   cmd.payload = CmdProviderStreamDestroyed{stream_id};
@@ -363,21 +728,36 @@ void ProviderCallbackIngress::on_frame(const FrameView& frame) {
   // core thread itself while that call is in flight for this stream, it can only
   // be a synchronous, reentrant delivery -- a genuine contract violation.
   if (core_thread_ && core_thread_->is_core_thread() &&
-      applying_stream_retained_plan_for_stream_id_ &&
-      applying_stream_retained_plan_for_stream_id_() == frame.stream_id &&
-      frame.stream_id != 0) {
-    std::fprintf(stderr,
-                 "[CamBANG][ContractViolation] provider delivered a frame synchronously "
-                 "from within update_stream_retained_production_plan() for stream_id=%llu; "
-                 "this violates the icamera_provider.h contract.\n",
-                 static_cast<unsigned long long>(frame.stream_id));
+      frame.stream_id != 0 &&
+      applying_stream_retained_plan_stream_id_() == frame.stream_id) {
+    async_log_printf(stderr,
+                     "[CamBANG][ContractViolation] provider delivered a frame synchronously "
+                     "from within update_stream_retained_production_plan() for stream_id=%llu; "
+                     "this violates the icamera_provider.h contract.\n",
+                     static_cast<unsigned long long>(frame.stream_id));
   }
+  frame_latency_trace_record(FrameLatencyHop::IngressEnqueue, frame.stream_id, frame.trace_id);
   // FrameView is a provider-owned view. Ownership is returned to the provider only when
   // core calls frame.release_now(). The core dispatcher MUST ensure release-on-drop.
+  const uint32_t latest_wins_limit = latest_wins_frames_per_stream_.load(std::memory_order_relaxed);
+  if (latest_wins_limit != 0 && core_thread_ && frame.stream_id != 0 && frame.capture_id == 0) {
+    post_latest_wins_frame_(frame, latest_wins_limit);
+    return;
+  }
+  ResourceAggregateTelemetry::Handle lease_telemetry;
+  if (core_thread_ && frame.stream_id != 0 && frame.capture_id == 0) {
+    if (!try_admit_repeating_frame_(frame.stream_id, lease_telemetry)) {
+      frames_dropped_fair_share_.fetch_add(1, std::memory_order_relaxed);
+      count_pressure_drop_(frame.stream_id);
+      frame.release_now();
+      return;
+    }
+  } else {
+    (void)on_frame_ingress_enqueued_(frame.stream_id);
+  }
   ProviderToCoreCommand cmd;
   cmd.type = ProviderToCoreCommandType::PROVIDER_FRAME;
-  (void)on_frame_ingress_enqueued_(frame.stream_id);
-  cmd.payload = CmdProviderFrame{frame}; // copies the view (not the buffer)
+  cmd.payload = CmdProviderFrame{frame, lease_telemetry}; // copies the view (not the buffer)
   post_command(std::move(cmd));
 }
 
@@ -396,6 +776,13 @@ void ProviderCallbackIngress::on_stream_error(uint64_t stream_id, ProviderError
 }
 
 void ProviderCallbackIngress::on_native_object_created(const NativeObjectCreateInfo& info) {
+  {
+    // Updates for this object come after its create; they go in a batch
+    // whose token is posted after the create command below.
+    std::lock_guard<std::mutex> lock(native_counters_mu_);
+    native_counters_batch_open_ = false;
+  }
+
   CmdProviderNativeObjectCreated p{};
   p.native_id = info.native_id;
   p.type = info.type;
@@ -423,4 +810,65 @@ void ProviderCallbackIngress::on_native_object_destroyed(const NativeObjectDestr
   post_command(std::move(cmd));
 }
 
+void ProviderCallbackIngress::on_native_object_counters(const NativeObjectCountersUpdate& update) {
+  if (update.native_id == 0) {
+    return;
+  }
+  uint64_t token_batch = 0;
+  {
+    std::lock_guard<std::mutex> lock(native_counters_mu_);
+    if (!native_counters_batch_open_) {
+      native_counters_batch_open_ = true;
+      token_batch = ++native_counters_batch_;
+    }
+    auto [it, inserted] = pending_native_counters_.try_emplace(update.native_id);
+    if (!inserted) {
+      native_object_counters_coalesced_.fetch_add(1, std::memory_order_relaxed);
+    }
+    it->second = PendingNativeCounters{update.bytes_allocated, update.buffers_in_use, native_counters_batch_};
+  }
+  if (token_batch == 0) {
+    return;
+  }
+
+  const CoreThread::PostResult r = core_thread_
+      ? core_thread_->try_post_essential([this, token_batch]() { dispatch_native_object_counters_(token_batch); })
+      : CoreThread::PostResult::Closed;
+  if (r == CoreThread::PostResult::Enqueued) {
+    return;
+  }
+  account_command_drop_(r, ProviderToCoreCommandType::PROVIDER_NATIVE_OBJECT_COUNTERS);
+  // The updates stay pending; the next one posts a fresh token that carries
+  // them too.
+  std::lock_guard<std::mutex> lock(native_counters_mu_);
+  if (native_counters_batch_ == token_batch) {
+    native_counters_batch_open_ = false;
+  }
+}
+
+void ProviderCallbackIngress::dispatch_native_object_counters_(uint64_t batch) {
+  ProviderToCoreCommand cmd;
+  cmd.type = ProviderToCoreCommandType::PROVIDER_NATIVE_OBJECT_COUNTERS;
+  CmdProviderNativeObjectCounters p;
+  {
+    std::lock_guard<std::mutex> lock(native_counters_mu_);
+    if (native_counters_batch_ == batch) {
+      native_counters_batch_open_ = false;
+    }
+    for (auto it = pending_native_counters_.begin(); it != pending_native_counters_.end();) {
+      if (it->second.batch > batch) {
+        ++it;
+        continue;
+      }
+      p.updates.push_back(NativeObjectCountersUpdate{it->first, it->second.bytes_allocated, it->second.buffers_in_use});
+      it = pending_native_counters_.erase(it);
+    }
+  }
+  if (p.updates.empty() || !has_core_sink_()) {
+    return;
+  }
+  cmd.payload = std::move(p);
+  sink_to_core_(std::move(cmd));
+}
+
 } // namespace cambang
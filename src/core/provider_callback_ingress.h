@@ -1,5 +1,6 @@
 #pragma once
 
+#include <array>
 #include <atomic>
 #include <cstdint>
 #include <functional>
@@ -8,10 +9,16 @@
 
 #include "core/provider_to_core_commands.h"
 #include "core/core_thread.h"
+#include "core/resource_aggregate_telemetry.h"
 #include "imaging/api/icamera_provider.h"
+#include "imaging/api/provider_binding.h"
 
 namespace cambang {
 
+#if CAMBANG_PROVIDER_BOUND
+class CoreRuntime;
+#endif
+
 // ProviderCallbackIngress is the ONLY allowed implementation point where provider
 // callbacks cross into core execution.
 //
@@ -24,6 +31,67 @@ namespace cambang {
 // - CoreThread posting is best-effort.
 // - If posting fails and the command contains a FrameView, ingress MUST release it
 //   (release-on-drop) to avoid leaks.
+//
+// Latest-wins frame coalescing (opt-in, set_latest_wins_frames_per_stream()):
+// - Repeating stream frames are parked in a small per-stream slot and the
+//   ordinary lane carries only a stream_id token per parked frame.
+// - When a stream already has the limit parked (or the ordinary lane is full
+//   while it has older frames parked), the oldest parked frame is released and
+//   the new one takes its place, so preview latency stays bounded by the limit
+//   instead of by the depth of the ordinary queue.
+// - Still-capture frames (capture_id != 0) are never coalesced.
+//
+// Fair-share frame admission (default, non-latest-wins path):
+// - Once the ordinary lane is kCongestedOrdinaryLaneNumerator/Denominator
+//   full, a repeating stream frame is admitted only while its stream holds
+//   fewer queued frames than an equal share of that threshold among the
+//   streams that currently have frames queued. Otherwise it is released at
+//   once (frames_dropped_fair_share). A stream flooding the lane therefore
+//   stops at its share and the remaining headroom stays open to every other
+//   stream, instead of the flooder filling the lane and the others' frames
+//   being the ones dropped at QueueFull.
+// - The share applies only while another stream has frames queued; a lone
+//   stream may use the whole lane and is dropped at QueueFull as before.
+// - Still-capture frames (capture_id != 0) are never subject to it.
+//
+// Stream priority (set_stream_priority(), default NORMAL):
+// - The fair-share threshold above is NORMAL's. LOW streams are held to
+//   their share from kLowPriorityOrdinaryLaneNumerator/Denominator instead,
+//   and HIGH streams are never fair-share limited, so under pressure LOW
+//   frames are shed first and the lane's remaining headroom is HIGH's.
+//   Frames dropped for pressure (fair share or QueueFull) are also counted
+//   per class (frames_dropped_pressure_by_priority).
+//
+// Per-stream ingress depth:
+// - Each stream's queued-frame count lives in a slot of a fixed table of
+//   kStreamDepthSlots atomic counters. Frames find their slot without a lock;
+//   only claiming a slot (on_stream_created() or a stream's first frame) and
+//   retiring it (on_stream_destroyed(), deferred until its queued frames are
+//   dispatched) take a mutex. With the table full, further streams go
+//   uncounted (depth 0, never fair-share limited).
+// - The slot also carries the stream's pinned framebuffer-lease telemetry
+//   handle for the same lifetime, so an admitted frame counts its lease with
+//   an atomic load and no lock. Streams without a slot count by key.
+//
+// Native-object counter coalescing (on_native_object_counters()):
+// - Updates are kept latest-per-object in a pending map; the essential lane
+//   carries one token per batch, and dispatching it hands Core every update
+//   of that batch as a single PROVIDER_NATIVE_OBJECT_COUNTERS command. A pool
+//   resizing many times between core iterations therefore costs one command.
+// - A native-object create closes the open batch, so an update reported
+//   after an object's create is never integrated ahead of it.
+//
+// Core hooks:
+// - Commands, the core timebase, display demand and the retained-plan
+//   reentrancy tripwire come from CoreRuntime. A default build takes them as
+//   std::function; a provider-bound build (provider_binding.h) takes the
+//   CoreRuntime itself and calls it directly.
+//
+// Backpressure (is_stream_ingress_congested()):
+// - A stream is congested while it has at least the latest-wins limit of
+//   frames parked, or while the ordinary lane is past its priority class's
+//   fair-share threshold (full, for HIGH). Either way the next repeating
+//   frame would only displace a queued one or be dropped.
 class ProviderCallbackIngress final : public IProviderCallbacks {
 public:
   struct Stats {
@@ -41,8 +109,40 @@ public:
     uint64_t frames_released_on_drop_full = 0;
     uint64_t frames_released_on_drop_closed = 0;
     uint64_t frames_released_on_drop_allocfail = 0;
+
+    // Latest-wins mode: older parked frames released in favour of a newer one.
+    uint64_t frames_coalesced_latest_wins = 0;
+
+    // Released before posting: the stream was over its fair share of a
+    // congested ordinary lane.
+    uint64_t frames_dropped_fair_share = 0;
+
+    // frames_dropped_fair_share plus repeating-frame frames_dropped_full,
+    // indexed by the stream's StreamPriority.
+    std::array<uint64_t, kStreamPriorityCount> frames_dropped_pressure_by_priority{};
+
+    // Native-object counter updates superseded by a later one for the same
+    // object before Core integrated them.
+    uint64_t native_object_counters_coalesced = 0;
   };
 
+  // Upper bound for set_latest_wins_frames_per_stream().
+  static constexpr uint32_t kMaxLatestWinsFramesPerStream = 4;
+
+  // Ordinary-lane fill fraction at which every stream reports congestion.
+  static constexpr size_t kCongestedOrdinaryLaneNumerator = 3;
+  static constexpr size_t kCongestedOrdinaryLaneDenominator = 4;
+  // Same, for LOW priority streams.
+  static constexpr size_t kLowPriorityOrdinaryLaneNumerator = 1;
+  static constexpr size_t kLowPriorityOrdinaryLaneDenominator = 2;
+
+  // Streams whose ingress depth can be tracked at once (power of two).
+  static constexpr size_t kStreamDepthSlots = 256;
+
+#if CAMBANG_PROVIDER_BOUND
+  // Commands go to runtime->enqueue_provider_fact(), ONLY on the core thread.
+  ProviderCallbackIngress(CoreThread* core_thread, CoreRuntime* runtime);
+#else
   // sink is invoked ONLY on the core thread.
   // It is responsible for consuming the ProviderToCoreCommand (e.g., dispatching).
   ProviderCallbackIngress(CoreThread* core_thread,
@@ -50,18 +150,43 @@ public:
                           std::function<uint64_t()> core_monotonic_now_ns,
                           std::function<bool(uint64_t)> is_stream_display_demand_active,
                           std::function<uint64_t()> applying_stream_retained_plan_for_stream_id = nullptr);
-  ~ProviderCallbackIngress() override = default;
+#endif
+  ~ProviderCallbackIngress() override;
 
   ProviderCallbackIngress(const ProviderCallbackIngress&) = delete;
   ProviderCallbackIngress& operator=(const ProviderCallbackIngress&) = delete;
 
+  // 0 (default) keeps drop-newest behaviour on ordinary-lane pressure.
+  // Otherwise at most `frames` (clamped to kMaxLatestWinsFramesPerStream)
+  // repeating frames stay queued per stream; see the class comment.
+  void set_latest_wins_frames_per_stream(uint32_t frames) noexcept;
+
+  // Pool served by acquire_cpu_payload_buffer(); nullptr (default) offers none.
+  // Set before any provider is attached; the pool must outlive this ingress.
+  void set_cpu_payload_buffer_pool(CpuPayloadBufferPool* pool) noexcept { cpu_payload_buffer_pool_ = pool; }
+
+  // Drop class for the stream's repeating frames; kept until the stream's
+  // depth slot retires. Core sets it before asking the provider to create
+  // the stream and forgets it when that creation fails. Ignored with the
+  // depth table full.
+  void set_stream_priority(uint64_t stream_id, StreamPriority priority);
+  void forget_stream_priority(uint64_t stream_id);
+
   Stats stats_copy() const noexcept;
-  uint32_t ingress_depth_for_stream(uint64_t stream_id) const;
+  uint32_t ingress_depth_for_stream(uint64_t stream_id) const noexcept;
+
+  // Unpins every stream's framebuffer-lease telemetry bucket (slots re-pin
+  // on their stream's next frame). Called at generation teardown so the
+  // buckets can retire.
+  void release_lease_telemetry_handles() noexcept;
 
   // IProviderCallbacks (core-issued services)
   uint64_t allocate_native_id(NativeObjectType type) override;
   uint64_t core_monotonic_now_ns() override;
   bool is_stream_display_demand_active(uint64_t stream_id) override;
+  bool is_stream_ingress_congested(uint64_t stream_id) override;
+  StreamPriority stream_priority(uint64_t stream_id) override;
+  std::shared_ptr<CpuPayloadBytes> acquire_cpu_payload_buffer(const CpuPayloadBufferKey& key) override;
 
   // IProviderCallbacks
   void on_device_opened(uint64_t device_instance_id) override;
@@ -89,21 +214,84 @@ public:
 
   void on_native_object_created(const NativeObjectCreateInfo& info) override;
   void on_native_object_destroyed(const NativeObjectDestroyInfo& info) override;
+  void on_native_object_counters(const NativeObjectCountersUpdate& update) override;
 
 private:
+  // Parked latest-wins frames for one stream, oldest first. Guarded by ingress_mu_.
+  struct LatestWinsSlot {
+    std::array<FrameView, kMaxLatestWinsFramesPerStream> frames{};
+    uint32_t head = 0;
+    uint32_t count = 0;
+
+    void push_newest(const FrameView& frame) noexcept;
+    FrameView pop_oldest() noexcept;
+  };
+
+  // stream_id is 0 while empty and kRetiredStreamDepthSlot once retired;
+  // retired slots are reclaimed, but lookups probe past them.
+  struct StreamDepthSlot {
+    std::atomic<uint64_t> stream_id{0};
+    std::atomic<uint32_t> depth{0};
+    // on_stream_destroyed() seen; retired once depth drains to 0.
+    std::atomic<bool> retiring{false};
+    std::atomic<uint8_t> priority{static_cast<uint8_t>(StreamPriority::NORMAL)};
+    // The stream's framebuffer-lease telemetry bucket, pinned when the slot
+    // is claimed and unpinned when it retires.
+    std::atomic<ResourceAggregateTelemetry::Handle> lease_telemetry{ResourceAggregateTelemetry::Handle{}};
+  };
+  static constexpr uint64_t kRetiredStreamDepthSlot = ~uint64_t{0};
+
+  StreamDepthSlot* find_stream_depth_slot_(uint64_t stream_id) const noexcept;
+  // Null with the table full.
+  StreamDepthSlot* claim_stream_depth_slot_(uint64_t stream_id);
+  void retire_stream_depth_slot_if_idle_(StreamDepthSlot& slot);
+  void increment_stream_ingress_depth_(StreamDepthSlot* slot) noexcept;
+  static StreamPriority slot_priority_(const StreamDepthSlot* slot) noexcept;
+  // Unset without a slot, or once the slot no longer holds `stream_id`.
+  ResourceAggregateTelemetry::Handle slot_lease_telemetry_(StreamDepthSlot* slot, uint64_t stream_id);
+  // Ordinary-lane fill from which `priority` streams are fair-share limited.
+  size_t fair_share_threshold_(StreamPriority priority) const noexcept;
+  void count_pressure_drop_(uint64_t stream_id) noexcept;
+
   uint32_t on_frame_ingress_enqueued_(uint64_t stream_id);
+  // Admits and counts the frame's lease into the stream's bucket; the handle
+  // is left unset when the frame is not admitted.
+  bool try_admit_repeating_frame_(uint64_t stream_id, ResourceAggregateTelemetry::Handle& lease_telemetry);
   void on_frame_ingress_failed_(uint64_t stream_id);
   void on_frame_ingress_dispatched_(uint64_t stream_id);
 
+  void decrement_stream_ingress_depth_(uint64_t stream_id);
+
   static bool is_frame_command_(ProviderToCoreCommandType type) noexcept;
+  static void release_dropped_frame_(FrameView& frame, ResourceAggregateTelemetry::Handle lease_telemetry = {});
+  void account_command_drop_(CoreThread::PostResult r, ProviderToCoreCommandType type) noexcept;
+  void account_frame_drop_and_release_(CoreThread::PostResult r,
+                                       FrameView& frame,
+                                       ResourceAggregateTelemetry::Handle lease_telemetry = {});
+
+  void post_latest_wins_frame_(const FrameView& frame, uint32_t limit);
+  void dispatch_latest_wins_frame_(uint64_t stream_id);
+
+  void dispatch_native_object_counters_(uint64_t batch);
 
   void post_command(ProviderToCoreCommand cmd);
 
+  // Core hooks (see the class comment). Core thread only for sink_to_core_().
+  bool has_core_sink_() const noexcept;
+  void sink_to_core_(ProviderToCoreCommand&& cmd);
+  // 0 outside update_stream_retained_production_plan().
+  uint64_t applying_stream_retained_plan_stream_id_() const;
+
   CoreThread* core_thread_ = nullptr; // non-owning
+#if CAMBANG_PROVIDER_BOUND
+  CoreRuntime* runtime_ = nullptr; // non-owning
+#else
   std::function<void(ProviderToCoreCommand&&)> sink_;
   std::function<uint64_t()> core_monotonic_now_ns_;
   std::function<bool(uint64_t)> is_stream_display_demand_active_;
   std::function<uint64_t()> applying_stream_retained_plan_for_stream_id_;
+#endif
+  CpuPayloadBufferPool* cpu_payload_buffer_pool_ = nullptr; // non-owning
 
   std::atomic<uint64_t> native_id_seq_{1};
 
@@ -122,8 +310,34 @@ private:
   std::atomic<uint64_t> frames_released_on_drop_closed_{0};
   std::atomic<uint64_t> frames_released_on_drop_allocfail_{0};
 
+  std::atomic<uint64_t> frames_coalesced_latest_wins_{0};
+  std::atomic<uint64_t> frames_dropped_fair_share_{0};
+  std::array<std::atomic<uint64_t>, kStreamPriorityCount> frames_dropped_pressure_by_priority_{};
+  std::atomic<uint32_t> latest_wins_frames_per_stream_{0};
+
+  mutable std::array<StreamDepthSlot, kStreamDepthSlots> stream_depth_slots_{};
+  // Streams with at least one frame queued (fair-share divisor).
+  std::atomic<uint32_t> streams_with_frames_queued_{0};
+  // Slot claims and retirement only; taken after ingress_mu_ when both are.
+  std::mutex stream_depth_claim_mu_;
+
   mutable std::mutex ingress_mu_;
-  std::unordered_map<uint64_t, uint32_t> stream_ingress_depth_;
+  std::unordered_map<uint64_t, LatestWinsSlot> latest_wins_slots_;
+
+  // Pending native-object counters, latest per native_id, each tagged with
+  // the batch whose token will deliver it.
+  struct PendingNativeCounters {
+    uint64_t bytes_allocated = 0;
+    uint32_t buffers_in_use = 0;
+    uint64_t batch = 0;
+  };
+  std::mutex native_counters_mu_;
+  std::unordered_map<uint64_t, PendingNativeCounters> pending_native_counters_;
+  // Newest batch whose token was posted; open while that token may still
+  // take updates.
+  uint64_t native_counters_batch_ = 0;
+  bool native_counters_batch_open_ = false;
+  std::atomic<uint64_t> native_object_counters_coalesced_{0};
 };
 
 } // namespace cambang
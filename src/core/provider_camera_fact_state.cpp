@@ -6,6 +6,7 @@
 #include <type_traits>
 #include <variant>
 
+#include "core/core_registry_revision.h"
 #include "core/core_runtime.h"
 
 namespace cambang {
@@ -26,6 +27,9 @@ bool valid(SensorOrientationDegrees value) noexcept {
 bool valid(DistortionImageState value) noexcept {
   return value <= DistortionImageState::UNKNOWN;
 }
+bool valid(ColorFilterArrangement value) noexcept {
+  return value <= ColorFilterArrangement::UNKNOWN;
+}
 bool valid(ImageRotationDegrees value) noexcept {
   return value == ImageRotationDegrees::DEGREES_0 ||
          value == ImageRotationDegrees::DEGREES_90 ||
@@ -84,6 +88,17 @@ bool valid_aperture_f_number(const ApertureFNumber& value) noexcept {
 bool valid_focal_length_mm(const FocalLengthMm& value) noexcept {
   return std::isfinite(value.millimetres()) && value.millimetres() > 0.0;
 }
+bool valid_raw_sensor_layout(const RawSensorLayout& value) noexcept {
+  if (!valid(value.color_filter()) || value.white_level() == 0) {
+    return false;
+  }
+  for (uint32_t black : value.black_levels()) {
+    if (black >= value.white_level()) {
+      return false;
+    }
+  }
+  return true;
+}
 
 // The five dual-tier facts validate identically wherever they appear, so both
 // the static and per-capture-image containers share this check.
@@ -105,14 +120,16 @@ bool valid_static(const CameraStaticFacts& facts) noexcept {
          valid_sourced(facts.intrinsics, valid_intrinsics) &&
          valid_sourced(facts.distortion, valid_distortion) &&
          valid_sourced(facts.pose, valid_pose) &&
-         valid_dual_tier_facts(facts);
+         valid_dual_tier_facts(facts) &&
+         valid_sourced(facts.raw_sensor_layout, valid_raw_sensor_layout);
 }
 } // namespace
 
 bool ProviderCameraFactState::replace_static(
     uint64_t device_instance_id, ProviderCameraFacts facts) {
   if (device_instance_id == 0 || !valid(facts)) return false;
-  static_by_device_[device_instance_id] = std::move(facts);
+  static_by_device_[device_instance_id] =
+      StaticEntry{std::move(facts), next_core_registry_revision()};
   return true;
 }
 
@@ -142,7 +159,12 @@ void ProviderCameraFactState::clear() noexcept {
 const ProviderCameraFacts* ProviderCameraFactState::find_static(
     uint64_t device_instance_id) const noexcept {
   const auto it = static_by_device_.find(device_instance_id);
-  return it == static_by_device_.end() ? nullptr : &it->second;
+  return it == static_by_device_.end() ? nullptr : &it->second.facts;
+}
+
+uint64_t ProviderCameraFactState::static_revision(uint64_t device_instance_id) const noexcept {
+  const auto it = static_by_device_.find(device_instance_id);
+  return it == static_by_device_.end() ? 0 : it->second.revision;
 }
 
 const ProviderCaptureImageFacts* ProviderCameraFactState::find_capture_image(
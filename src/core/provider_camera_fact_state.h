@@ -32,13 +32,21 @@ class ProviderCameraFactState final {
   void clear() noexcept;
 
   const ProviderCameraFacts* find_static(uint64_t device_instance_id) const noexcept;
+  // Stamp of the device's last replace_static() (core_registry_revision.h);
+  // 0 when it has no static facts.
+  uint64_t static_revision(uint64_t device_instance_id) const noexcept;
   const ProviderCaptureImageFacts* find_capture_image(CaptureImageKey key) const noexcept;
 
  private:
   static bool valid(const ProviderCameraFacts& facts) noexcept;
   static bool valid(const ProviderCaptureImageFacts& facts) noexcept;
 
-  std::map<uint64_t, ProviderCameraFacts> static_by_device_;
+  struct StaticEntry {
+    ProviderCameraFacts facts;
+    uint64_t revision = 0;
+  };
+
+  std::map<uint64_t, StaticEntry> static_by_device_;
   std::map<CaptureImageKey, ProviderCaptureImageFacts> capture_images_;
 };
 
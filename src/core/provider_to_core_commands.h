@@ -2,8 +2,10 @@
 
 #include <cstdint>
 #include <variant>
+#include <vector>
 
 #include "core/camera_fact_types.h"
+#include "core/resource_aggregate_telemetry.h"
 #include "imaging/api/provider_contract_datatypes.h"
 
 namespace cambang {
@@ -49,6 +51,8 @@ enum class ProviderToCoreCommandType : uint8_t {
 
   PROVIDER_NATIVE_OBJECT_CREATED,
   PROVIDER_NATIVE_OBJECT_DESTROYED,
+  // Coalesced batch of on_native_object_counters() updates.
+  PROVIDER_NATIVE_OBJECT_COUNTERS,
 
   // Timer tick (internal)
   TIMER_TICK
@@ -114,6 +118,9 @@ struct CmdProviderCaptureImageFacts {
 
 struct CmdProviderFrame {
   FrameView frame; // By value: preserves release hook and all metadata.
+  // Bucket the frame's lease was counted into, when ingress had one resolved
+  // for the stream; valid until the lease is released. Unset: count by key.
+  ResourceAggregateTelemetry::Handle lease_telemetry{};
 };
   
 struct CmdProviderDeviceError {
@@ -147,6 +154,11 @@ struct CmdProviderNativeObjectDestroyed {
   uint64_t destroyed_ns = 0;
 };
 
+// Latest counters per native object, in no particular order.
+struct CmdProviderNativeObjectCounters {
+  std::vector<NativeObjectCountersUpdate> updates;
+};
+
 struct CmdTimerTick {};
 
 // Variant containing all possible payloads.
@@ -167,6 +179,7 @@ using ProviderToCoreCommandData = std::variant<
   CmdProviderStreamError,
   CmdProviderNativeObjectCreated,
   CmdProviderNativeObjectDestroyed,
+  CmdProviderNativeObjectCounters,
   CmdTimerTick
 >;
 
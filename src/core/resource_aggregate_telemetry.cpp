@@ -38,21 +38,76 @@ void ResourceAggregateTelemetry::decrement_if_positive(std::atomic<uint64_t>& cu
   }
 }
 
-void ResourceAggregateTelemetry::lease_created(const ScopedResourceTelemetryKey& key) noexcept {
-  std::lock_guard<std::mutex> lock(mutex_);
-  Bucket& bucket = buckets_[make_key(key)];
+bool ResourceAggregateTelemetry::is_retirable(const Bucket& bucket) noexcept {
+  return bucket.handle_pins == 0 && is_balanced(bucket);
+}
+
+bool ResourceAggregateTelemetry::is_balanced(const Bucket& bucket) noexcept {
+  const uint64_t fbl_cur = bucket.framebuffer_lease_current.load(std::memory_order_relaxed);
+  const uint64_t fbl_new = bucket.framebuffer_lease_total_created.load(std::memory_order_relaxed);
+  const uint64_t fbl_rel = bucket.framebuffer_lease_total_released.load(std::memory_order_relaxed);
+  const uint64_t gpu_cur = bucket.retained_gpu_backing_current.load(std::memory_order_relaxed);
+  const uint64_t gpu_new = bucket.retained_gpu_backing_total_created.load(std::memory_order_relaxed);
+  const uint64_t gpu_rel = bucket.retained_gpu_backing_total_released.load(std::memory_order_relaxed);
+  if (fbl_cur != 0 || gpu_cur != 0 || fbl_new != fbl_rel || gpu_new != gpu_rel) {
+    return false;
+  }
+  for (const auto& bytes : bucket.bytes_current) {
+    if (bytes.load(std::memory_order_relaxed) != 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void ResourceAggregateTelemetry::count_lease_created(Bucket& bucket) noexcept {
   const uint64_t current = bucket.framebuffer_lease_current.fetch_add(1, std::memory_order_relaxed) + 1;
   bucket.framebuffer_lease_total_created.fetch_add(1, std::memory_order_relaxed);
   update_peak(bucket.framebuffer_lease_peak_current, current);
 }
 
-void ResourceAggregateTelemetry::lease_released(const ScopedResourceTelemetryKey& key) noexcept {
-  std::lock_guard<std::mutex> lock(mutex_);
-  Bucket& bucket = buckets_[make_key(key)];
+void ResourceAggregateTelemetry::count_lease_released(Bucket& bucket) noexcept {
   decrement_if_positive(bucket.framebuffer_lease_current);
   bucket.framebuffer_lease_total_released.fetch_add(1, std::memory_order_relaxed);
 }
 
+ResourceAggregateTelemetry::Handle ResourceAggregateTelemetry::acquire_handle(
+    const ScopedResourceTelemetryKey& key) noexcept {
+  std::lock_guard<std::mutex> lock(mutex_);
+  Bucket& bucket = buckets_[make_key(key)];
+  ++bucket.handle_pins;
+  return Handle(&bucket);
+}
+
+void ResourceAggregateTelemetry::release_handle(Handle& handle) noexcept {
+  if (!handle.bucket_) {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (handle.bucket_->handle_pins > 0) {
+    --handle.bucket_->handle_pins;
+  }
+  handle.bucket_ = nullptr;
+}
+
+void ResourceAggregateTelemetry::lease_created(Handle handle) noexcept {
+  count_lease_created(*handle.bucket_);
+}
+
+void ResourceAggregateTelemetry::lease_released(Handle handle) noexcept {
+  count_lease_released(*handle.bucket_);
+}
+
+void ResourceAggregateTelemetry::lease_created(const ScopedResourceTelemetryKey& key) noexcept {
+  std::lock_guard<std::mutex> lock(mutex_);
+  count_lease_created(buckets_[make_key(key)]);
+}
+
+void ResourceAggregateTelemetry::lease_released(const ScopedResourceTelemetryKey& key) noexcept {
+  std::lock_guard<std::mutex> lock(mutex_);
+  count_lease_released(buckets_[make_key(key)]);
+}
+
 void ResourceAggregateTelemetry::retained_gpu_backing_created(const ScopedResourceTelemetryKey& key) noexcept {
   std::lock_guard<std::mutex> lock(mutex_);
   Bucket& bucket = buckets_[make_key(key)];
@@ -68,6 +123,40 @@ void ResourceAggregateTelemetry::retained_gpu_backing_released(const ScopedResou
   bucket.retained_gpu_backing_total_released.fetch_add(1, std::memory_order_relaxed);
 }
 
+void ResourceAggregateTelemetry::bytes_retained(const ScopedResourceTelemetryKey& key,
+                                                ResourceByteGauge gauge,
+                                                uint64_t bytes) noexcept {
+  if (bytes == 0) {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  Bucket& bucket = buckets_[make_key(key)];
+  bucket.bytes_current[static_cast<size_t>(gauge)].fetch_add(bytes, std::memory_order_relaxed);
+}
+
+void ResourceAggregateTelemetry::bytes_released(const ScopedResourceTelemetryKey& key,
+                                                ResourceByteGauge gauge,
+                                                uint64_t bytes) noexcept {
+  if (bytes == 0) {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  const auto it = buckets_.find(make_key(key));
+  if (it == buckets_.end()) {
+    return;
+  }
+  std::atomic<uint64_t>& current = it->second.bytes_current[static_cast<size_t>(gauge)];
+  uint64_t prev = current.load(std::memory_order_relaxed);
+  while (prev > 0 &&
+         !current.compare_exchange_weak(prev, prev > bytes ? prev - bytes : 0, std::memory_order_relaxed)) {
+  }
+}
+
+size_t ResourceAggregateTelemetry::bucket_count() const noexcept {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return buckets_.size();
+}
+
 std::vector<ScopedResourceTelemetryKey> ResourceAggregateTelemetry::snapshot() const noexcept {
   std::vector<ScopedResourceTelemetryKey> out;
   std::lock_guard<std::mutex> lock(mutex_);
@@ -91,6 +180,18 @@ std::vector<ScopedResourceTelemetryKey> ResourceAggregateTelemetry::snapshot() c
     s.retained_gpu_backing_total_created = b.retained_gpu_backing_total_created.load(std::memory_order_relaxed);
     s.retained_gpu_backing_total_released = b.retained_gpu_backing_total_released.load(std::memory_order_relaxed);
     s.retained_gpu_backing_peak_current = b.retained_gpu_backing_peak_current.load(std::memory_order_relaxed);
+    s.retained_cpu_payload_bytes_current =
+        b.bytes_current[static_cast<size_t>(ResourceByteGauge::RETAINED_CPU_PAYLOAD)].load(std::memory_order_relaxed);
+    s.retained_gpu_backing_bytes_current =
+        b.bytes_current[static_cast<size_t>(ResourceByteGauge::RETAINED_GPU_BACKING)].load(std::memory_order_relaxed);
+    s.display_view_bytes_current =
+        b.bytes_current[static_cast<size_t>(ResourceByteGauge::DISPLAY_VIEW)].load(std::memory_order_relaxed);
+    s.pooled_buffer_bytes_current =
+        b.bytes_current[static_cast<size_t>(ResourceByteGauge::POOLED_BUFFER)].load(std::memory_order_relaxed);
+    s.large_page_buffer_bytes_current =
+        b.bytes_current[static_cast<size_t>(ResourceByteGauge::LARGE_PAGE_BUFFER)].load(std::memory_order_relaxed);
+    s.large_page_fallback_bytes_current =
+        b.bytes_current[static_cast<size_t>(ResourceByteGauge::LARGE_PAGE_FALLBACK)].load(std::memory_order_relaxed);
     out.push_back(s);
   }
   return out;
@@ -110,13 +211,7 @@ void ResourceAggregateTelemetry::reconcile_lifecycle(
       b.created_ns = now_ns;
       b.phase = 1;
     }
-    const uint64_t fbl_cur = b.framebuffer_lease_current.load(std::memory_order_relaxed);
-    const uint64_t fbl_new = b.framebuffer_lease_total_created.load(std::memory_order_relaxed);
-    const uint64_t fbl_rel = b.framebuffer_lease_total_released.load(std::memory_order_relaxed);
-    const uint64_t gpu_cur = b.retained_gpu_backing_current.load(std::memory_order_relaxed);
-    const uint64_t gpu_new = b.retained_gpu_backing_total_created.load(std::memory_order_relaxed);
-    const uint64_t gpu_rel = b.retained_gpu_backing_total_released.load(std::memory_order_relaxed);
-    const bool balanced = (fbl_cur == 0 && gpu_cur == 0 && fbl_new == fbl_rel && gpu_new == gpu_rel);
+    const bool balanced = is_balanced(b);
     const bool owner_ended = [&]() {
       switch (key.telemetry_scope) {
         case TelemetryScope::STREAM: {
@@ -137,9 +232,8 @@ void ResourceAggregateTelemetry::reconcile_lifecycle(
         }
         case TelemetryScope::PROVIDER: {
           if (!native_objects || key.provider_native_id == 0) return false;
-          const auto& all = native_objects->all();
-          auto it = all.find(key.provider_native_id);
-          return it == all.end() || it->second.destroyed;
+          const auto* rec = native_objects->find(key.provider_native_id);
+          return rec == nullptr || rec->destroyed;
         }
         case TelemetryScope::UNKNOWN:
         default:
@@ -149,13 +243,17 @@ void ResourceAggregateTelemetry::reconcile_lifecycle(
     if (owner_ended && balanced) {
       b.phase = 3;
       b.destroyed_ns = now_ns;
-      if (b.destroyed_integration_ns == 0) {
+      if (b.destroyed_integration_ns == 0 && now_ns != 0) {
         b.destroyed_integration_ns = now_ns;
+        retirement_order_.emplace(now_ns, key);
       }
     } else {
       b.phase = 1;
       b.destroyed_ns = 0;
-      b.destroyed_integration_ns = 0;
+      if (b.destroyed_integration_ns != 0) {
+        retirement_order_.erase({b.destroyed_integration_ns, key});
+        b.destroyed_integration_ns = 0;
+      }
     }
   }
 }
@@ -163,57 +261,42 @@ void ResourceAggregateTelemetry::reconcile_lifecycle(
 size_t ResourceAggregateTelemetry::retire_destroyed_older_than(uint64_t now_ns, uint64_t retention_window_ns) noexcept {
   std::lock_guard<std::mutex> lock(mutex_);
   size_t retired = 0;
-  for (auto it = buckets_.begin(); it != buckets_.end();) {
-    auto& b = it->second;
-    const uint64_t fbl_cur = b.framebuffer_lease_current.load(std::memory_order_relaxed);
-    const uint64_t fbl_new = b.framebuffer_lease_total_created.load(std::memory_order_relaxed);
-    const uint64_t fbl_rel = b.framebuffer_lease_total_released.load(std::memory_order_relaxed);
-    const uint64_t gpu_cur = b.retained_gpu_backing_current.load(std::memory_order_relaxed);
-    const uint64_t gpu_new = b.retained_gpu_backing_total_created.load(std::memory_order_relaxed);
-    const uint64_t gpu_rel = b.retained_gpu_backing_total_released.load(std::memory_order_relaxed);
-    const bool balanced = (fbl_cur == 0 && gpu_cur == 0 && fbl_new == fbl_rel && gpu_new == gpu_rel);
-    if (b.phase != 3 || !balanced || b.destroyed_integration_ns == 0 || b.destroyed_integration_ns > now_ns || (now_ns - b.destroyed_integration_ns) < retention_window_ns) {
+  for (auto it = retirement_order_.begin(); it != retirement_order_.end();) {
+    const uint64_t destroyed_integration_ns = it->first;
+    if (destroyed_integration_ns > now_ns || (now_ns - destroyed_integration_ns) < retention_window_ns) {
+      break;
+    }
+    const auto bucket = buckets_.find(it->second);
+    // Counted into since the last reconcile, or pinned: keep for now.
+    if (bucket != buckets_.end() && !is_retirable(bucket->second)) {
       ++it;
       continue;
     }
-    it = buckets_.erase(it);
-    ++retired;
+    if (bucket != buckets_.end()) {
+      buckets_.erase(bucket);
+      ++retired;
+    }
+    it = retirement_order_.erase(it);
   }
   return retired;
 }
 
 std::optional<uint64_t> ResourceAggregateTelemetry::next_retirement_delay_ns(uint64_t now_ns, uint64_t retention_window_ns) const noexcept {
   std::lock_guard<std::mutex> lock(mutex_);
-  std::optional<uint64_t> min_delay;
-  for (const auto& [_, b] : buckets_) {
-    if (b.phase != 3 || b.destroyed_integration_ns == 0) continue;
-    const uint64_t retire_at = b.destroyed_integration_ns + retention_window_ns;
-    const uint64_t delay = retire_at > now_ns ? (retire_at - now_ns) : 0;
-    if (!min_delay.has_value() || delay < *min_delay) min_delay = delay;
+  if (retirement_order_.empty()) {
+    return std::nullopt;
   }
-  return min_delay;
+  const uint64_t retire_at = retirement_order_.begin()->first + retention_window_ns;
+  return retire_at > now_ns ? (retire_at - now_ns) : 0;
 }
 
 void ResourceAggregateTelemetry::clear() noexcept {
   std::lock_guard<std::mutex> lock(mutex_);
   for (auto it = buckets_.begin(); it != buckets_.end();) {
-    const Bucket& bucket = it->second;
-    const uint64_t framebuffer_current =
-        bucket.framebuffer_lease_current.load(std::memory_order_relaxed);
-    const uint64_t framebuffer_created =
-        bucket.framebuffer_lease_total_created.load(std::memory_order_relaxed);
-    const uint64_t framebuffer_released =
-        bucket.framebuffer_lease_total_released.load(std::memory_order_relaxed);
-    const uint64_t gpu_current =
-        bucket.retained_gpu_backing_current.load(std::memory_order_relaxed);
-    const uint64_t gpu_created =
-        bucket.retained_gpu_backing_total_created.load(std::memory_order_relaxed);
-    const uint64_t gpu_released =
-        bucket.retained_gpu_backing_total_released.load(std::memory_order_relaxed);
-    const bool balanced = framebuffer_current == 0 && gpu_current == 0 &&
-                          framebuffer_created == framebuffer_released &&
-                          gpu_created == gpu_released;
-    if (balanced) {
+    if (is_retirable(it->second)) {
+      if (it->second.destroyed_integration_ns != 0) {
+        retirement_order_.erase({it->second.destroyed_integration_ns, it->first});
+      }
       it = buckets_.erase(it);
     } else {
       ++it;
@@ -235,6 +318,13 @@ ScopedResourceTelemetryKey make_acquisition_session_scoped_resource_telemetry(ui
   return key;
 }
 
+ScopedResourceTelemetryKey make_device_scoped_resource_telemetry(uint64_t device_instance_id) noexcept {
+  ScopedResourceTelemetryKey key;
+  key.telemetry_scope = device_instance_id == 0 ? TelemetryScope::UNKNOWN : TelemetryScope::DEVICE;
+  key.device_instance_id = device_instance_id;
+  return key;
+}
+
 ScopedResourceTelemetryKey make_framebuffer_lease_scoped_resource_telemetry_key(
     uint64_t stream_id,
     uint64_t acquisition_session_id) noexcept {
@@ -258,4 +348,26 @@ ResourceAggregateTelemetry& global_resource_aggregate_telemetry() noexcept {
   return telemetry;
 }
 
+void framebuffer_lease_created(ResourceAggregateTelemetry::Handle handle,
+                               uint64_t stream_id,
+                               uint64_t acquisition_session_id) noexcept {
+  if (handle) {
+    global_resource_aggregate_telemetry().lease_created(handle);
+    return;
+  }
+  global_resource_aggregate_telemetry().lease_created(
+      make_framebuffer_lease_scoped_resource_telemetry_key(stream_id, acquisition_session_id));
+}
+
+void framebuffer_lease_released(ResourceAggregateTelemetry::Handle handle,
+                                uint64_t stream_id,
+                                uint64_t acquisition_session_id) noexcept {
+  if (handle) {
+    global_resource_aggregate_telemetry().lease_released(handle);
+    return;
+  }
+  global_resource_aggregate_telemetry().lease_released(
+      make_framebuffer_lease_scoped_resource_telemetry_key(stream_id, acquisition_session_id));
+}
+
 } // namespace cambang
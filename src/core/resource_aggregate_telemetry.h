@@ -6,6 +6,8 @@
 #include <map>
 #include <mutex>
 #include <optional>
+#include <set>
+#include <utility>
 #include <vector>
 
 namespace cambang { class CoreStreamRegistry; class CoreAcquisitionSessionRegistry; class CoreDeviceRegistry; class CoreNativeObjectRegistry; }
@@ -20,6 +22,25 @@ enum class TelemetryScope : uint32_t {
   UNKNOWN = 4,
 };
 
+// Byte gauges carried by each telemetry bucket, next to its lease and GPU
+// backing counts.
+enum class ResourceByteGauge : uint32_t {
+  // Retained stream/capture result CPU payloads (CoreResultStore).
+  RETAINED_CPU_PAYLOAD = 0,
+  // GPU backings held by retained results, estimated from their descriptor
+  // (stride_bytes * height); the backing itself stays opaque to core.
+  RETAINED_GPU_BACKING = 1,
+  // Images kept alive by live display views.
+  DISPLAY_VIEW = 2,
+  // Free buffers held by the CPU payload buffer pool for reuse.
+  POOLED_BUFFER = 3,
+  // Frame-sized CPU payload storage (any holder) granted large pages, and
+  // the frame-sized storage that asked for them but was refused. Process-wide
+  // figures from cpu_payload_allocation_stats().
+  LARGE_PAGE_BUFFER = 4,
+  LARGE_PAGE_FALLBACK = 5,
+};
+
 struct ScopedResourceTelemetryKey final {
   uint32_t phase = 1; // LIVE
   uint64_t creation_gen = 0;
@@ -39,15 +60,53 @@ struct ScopedResourceTelemetryKey final {
   uint64_t retained_gpu_backing_total_created = 0;
   uint64_t retained_gpu_backing_total_released = 0;
   uint64_t retained_gpu_backing_peak_current = 0;
+
+  uint64_t retained_cpu_payload_bytes_current = 0;
+  uint64_t retained_gpu_backing_bytes_current = 0;
+  uint64_t display_view_bytes_current = 0;
+  uint64_t pooled_buffer_bytes_current = 0;
+  uint64_t large_page_buffer_bytes_current = 0;
+  uint64_t large_page_fallback_bytes_current = 0;
 };
 
 class ResourceAggregateTelemetry final {
+private:
+  struct Bucket;
+
 public:
+  // Non-owning reference to one bucket, so per-frame lease counting is a few
+  // relaxed atomic updates with no bucket lookup or lock. acquire_handle()
+  // pins the bucket (a pinned bucket is never retired or cleared) until
+  // release_handle(). Unpinned, a handle stays valid while a lease created
+  // through it is outstanding, since an unbalanced bucket is never retired
+  // either; a frame can therefore carry it to its release.
+  class Handle final {
+  public:
+    Handle() = default;
+    explicit operator bool() const noexcept { return bucket_ != nullptr; }
+
+  private:
+    friend class ResourceAggregateTelemetry;
+    explicit Handle(Bucket* bucket) noexcept : bucket_(bucket) {}
+    Bucket* bucket_ = nullptr;
+  };
+
+  Handle acquire_handle(const ScopedResourceTelemetryKey& key) noexcept;
+  void release_handle(Handle& handle) noexcept;
+  void lease_created(Handle handle) noexcept;
+  void lease_released(Handle handle) noexcept;
+
   void lease_created(const ScopedResourceTelemetryKey& key) noexcept;
   void lease_released(const ScopedResourceTelemetryKey& key) noexcept;
   void retained_gpu_backing_created(const ScopedResourceTelemetryKey& key) noexcept;
   void retained_gpu_backing_released(const ScopedResourceTelemetryKey& key) noexcept;
+  // Outstanding bytes keep a bucket LIVE like outstanding leases do.
+  // Releasing bytes never creates a bucket and never goes below zero.
+  void bytes_retained(const ScopedResourceTelemetryKey& key, ResourceByteGauge gauge, uint64_t bytes) noexcept;
+  void bytes_released(const ScopedResourceTelemetryKey& key, ResourceByteGauge gauge, uint64_t bytes) noexcept;
   std::vector<ScopedResourceTelemetryKey> snapshot() const noexcept;
+  // Buckets held, LIVE and DESTROYED-but-not-yet-retired alike.
+  size_t bucket_count() const noexcept;
   void reconcile_lifecycle(uint64_t now_ns,
                            uint64_t current_gen,
                            const CoreStreamRegistry* streams,
@@ -81,27 +140,48 @@ private:
     std::atomic<uint64_t> retained_gpu_backing_total_created{0};
     std::atomic<uint64_t> retained_gpu_backing_total_released{0};
     std::atomic<uint64_t> retained_gpu_backing_peak_current{0};
+    std::array<std::atomic<uint64_t>, 6> bytes_current{}; // by ResourceByteGauge
     uint32_t phase = 1; // LIVE
     uint64_t creation_gen = 0;
     uint64_t created_ns = 0;
     uint64_t destroyed_ns = 0;
+    // Retirement order key; non-zero exactly while listed in retirement_order_.
     uint64_t destroyed_integration_ns = 0;
+    // Outstanding acquire_handle() pins; guarded by mutex_.
+    uint32_t handle_pins = 0;
   };
 
   static Key make_key(const ScopedResourceTelemetryKey& key) noexcept;
+  static void count_lease_created(Bucket& bucket) noexcept;
+  static void count_lease_released(Bucket& bucket) noexcept;
   static void update_peak(std::atomic<uint64_t>& peak, uint64_t current) noexcept;
   static void decrement_if_positive(std::atomic<uint64_t>& current) noexcept;
+  static bool is_balanced(const Bucket& bucket) noexcept;
+  static bool is_retirable(const Bucket& bucket) noexcept;
 
   mutable std::mutex mutex_;
+  // Node-based: a Bucket's address is stable until it is erased.
   std::map<Key, Bucket> buckets_;
+  // DESTROYED buckets by destroyed_integration_ns, oldest first.
+  std::set<std::pair<uint64_t, Key>> retirement_order_;
 };
 
 ScopedResourceTelemetryKey make_stream_scoped_resource_telemetry(uint64_t stream_id) noexcept;
 ScopedResourceTelemetryKey make_acquisition_session_scoped_resource_telemetry(uint64_t acquisition_session_id) noexcept;
+ScopedResourceTelemetryKey make_device_scoped_resource_telemetry(uint64_t device_instance_id) noexcept;
 ScopedResourceTelemetryKey make_unknown_scoped_resource_telemetry() noexcept;
 ScopedResourceTelemetryKey make_framebuffer_lease_scoped_resource_telemetry_key(
     uint64_t stream_id,
     uint64_t acquisition_session_id) noexcept;
 ResourceAggregateTelemetry& global_resource_aggregate_telemetry() noexcept;
 
+// One frame's framebuffer lease on the global telemetry: through `handle`
+// when it is set, else by the frame's stream / acquisition-session key.
+void framebuffer_lease_created(ResourceAggregateTelemetry::Handle handle,
+                               uint64_t stream_id,
+                               uint64_t acquisition_session_id) noexcept;
+void framebuffer_lease_released(ResourceAggregateTelemetry::Handle handle,
+                                uint64_t stream_id,
+                                uint64_t acquisition_session_id) noexcept;
+
 } // namespace cambang
@@ -19,6 +19,9 @@ struct ResultImagePropertiesFacts {
   uint32_t format = 0;
   int32_t orientation = 0;
   uint32_t bit_depth = 0;
+  // Bytes between rows of the retained CPU payload's first plane; 0 when the
+  // result retains no CPU payload.
+  uint32_t row_stride_bytes = 0;
 };
 
 struct ResultImagePropertiesProvenance {
@@ -27,6 +30,7 @@ struct ResultImagePropertiesProvenance {
   ResultFactProvenance format = ResultFactProvenance::UNKNOWN;
   ResultFactProvenance orientation = ResultFactProvenance::UNKNOWN;
   ResultFactProvenance bit_depth = ResultFactProvenance::UNKNOWN;
+  ResultFactProvenance row_stride_bytes = ResultFactProvenance::UNKNOWN;
 };
 
 // Optical-calibration truth lives in the resolved per-member camera facts
@@ -12,4 +12,11 @@ enum class ResultPayloadKind : uint8_t {
   RAW_IMAGE = 4,
 };
 
+// CPU-primary retained kinds: the retained artifact is CPU bytes, whether
+// packed RGBA/BGRA, planar YUV, or RAW sensor samples.
+constexpr bool is_cpu_payload_kind(ResultPayloadKind kind) noexcept {
+  return kind == ResultPayloadKind::CPU_PACKED || kind == ResultPayloadKind::CPU_PLANAR ||
+         kind == ResultPayloadKind::RAW_IMAGE;
+}
+
 } // namespace cambang
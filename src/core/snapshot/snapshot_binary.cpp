@@ -0,0 +1,826 @@
+#include "core/snapshot/snapshot_binary.h"
+
+#include <bit>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+namespace cambang {
+
+static_assert(std::endian::native == std::endian::little,
+              "snapshot binary encoding assumes a little-endian host");
+
+// The wire structs are copied with memcpy in both directions, so their layout
+// must be free of implicit padding; these sizes are part of format version 1.
+static_assert(sizeof(SnapshotBinaryHeader) == 80);
+static_assert(sizeof(SnapshotBinarySectionEntry) == 16);
+static_assert(sizeof(SnapshotBinaryStringRef) == 8);
+static_assert(sizeof(SnapshotBinarySpan) == 8);
+static_assert(sizeof(SnapshotBinaryStillImageMember) == 12);
+static_assert(sizeof(SnapshotBinaryCaptureProfile) == 32);
+static_assert(sizeof(SnapshotBinaryCameraValueString) == 24);
+static_assert(sizeof(SnapshotBinaryCameraValueInt32) == 16);
+static_assert(sizeof(SnapshotBinaryCameraState) == 464);
+static_assert(sizeof(SnapshotBinaryLatencyHistogram) == 64);
+static_assert(sizeof(SnapshotBinaryCaptureLatency) == 320);
+static_assert(sizeof(SnapshotBinaryRig) == 496);
+static_assert(sizeof(SnapshotBinaryDevice) == 880);
+static_assert(sizeof(SnapshotBinaryAcquisitionSession) == 560);
+static_assert(sizeof(SnapshotBinaryFramePacing) == 48);
+static_assert(sizeof(SnapshotBinaryStream) == 272);
+static_assert(sizeof(SnapshotBinaryNativeObject) == 104);
+static_assert(sizeof(SnapshotBinaryScopedResourceTelemetry) == 176);
+static_assert(std::is_trivially_copyable_v<SnapshotBinaryDevice>);
+
+namespace {
+
+constexpr size_t kSectionAlign = 8;
+
+void pad_to_alignment(std::vector<uint8_t>& buf) {
+    buf.resize((buf.size() + kSectionAlign - 1) & ~(kSectionAlign - 1), 0);
+}
+
+template <typename W>
+void append_wire(std::vector<uint8_t>& buf, const W& w) {
+    const size_t at = buf.size();
+    buf.resize(at + sizeof(W));
+    std::memcpy(buf.data() + at, &w, sizeof(W));
+}
+
+class HeapWriter final {
+public:
+    SnapshotBinaryStringRef string(const std::string& s) {
+        SnapshotBinaryStringRef ref;
+        ref.offset = static_cast<uint32_t>(bytes.size());
+        ref.size = static_cast<uint32_t>(s.size());
+        bytes.insert(bytes.end(), s.begin(), s.end());
+        pad_to_alignment(bytes);
+        return ref;
+    }
+
+    template <typename W>
+    SnapshotBinarySpan span(const std::vector<W>& elements) {
+        SnapshotBinarySpan span;
+        span.offset = static_cast<uint32_t>(bytes.size());
+        span.count = static_cast<uint32_t>(elements.size());
+        for (const W& w : elements) {
+            append_wire(bytes, w);
+        }
+        pad_to_alignment(bytes);
+        return span;
+    }
+
+    std::vector<uint8_t> bytes;
+};
+
+template <typename CameraState, typename WireState, typename Fn>
+void for_each_camera_value(CameraState& c, WireState& w, Fn&& fn) {
+    fn(c.exposure.ae_mode, w.exposure_ae_mode);
+    fn(c.exposure.baseline_exposure_compensation_milli_ev, w.exposure_baseline_exposure_compensation_milli_ev);
+    fn(c.focus.af_mode, w.focus_af_mode);
+    fn(c.focus.focus_distance_diopters_milli, w.focus_focus_distance_diopters_milli);
+    fn(c.white_balance.awb_mode, w.white_balance_awb_mode);
+    fn(c.white_balance.color_temperature_kelvin, w.white_balance_color_temperature_kelvin);
+    fn(c.stabilization.mode, w.stabilization_mode);
+    fn(c.stabilization.strength_percent, w.stabilization_strength_percent);
+    fn(c.flash_torch.flash_mode, w.flash_torch_flash_mode);
+    fn(c.flash_torch.torch_level, w.flash_torch_torch_level);
+    fn(c.zoom_crop.zoom_ratio_milli, w.zoom_crop_zoom_ratio_milli);
+    fn(c.zoom_crop.crop_preset, w.zoom_crop_crop_preset);
+    fn(c.processing.noise_reduction_mode, w.processing_noise_reduction_mode);
+    fn(c.processing.edge_enhancement_level, w.processing_edge_enhancement_level);
+    fn(c.metering.metering_mode, w.metering_metering_mode);
+    fn(c.metering.metering_region_preset, w.metering_metering_region_preset);
+    fn(c.antibanding.mode, w.antibanding_mode);
+    fn(c.antibanding.mains_frequency_hz, w.antibanding_mains_frequency_hz);
+    fn(c.orientation_mirroring.rotation_degrees, w.orientation_mirroring_rotation_degrees);
+    fn(c.orientation_mirroring.mirror_mode, w.orientation_mirroring_mirror_mode);
+    fn(c.privacy_hardware_block.privacy_mode, w.privacy_hardware_block_privacy_mode);
+    fn(c.privacy_hardware_block.hardware_block_reason, w.privacy_hardware_block_hardware_block_reason);
+}
+
+// ---- encode ----------------------------------------------------------------
+
+struct CameraValueEncoder {
+    HeapWriter& heap;
+
+    void operator()(const CameraValueStateString& v, SnapshotBinaryCameraValueString& w) const {
+        w.support = static_cast<uint8_t>(v.support);
+        w.has_target = v.has_target ? 1 : 0;
+        w.has_applied = v.has_applied ? 1 : 0;
+        w.apply_status = static_cast<uint8_t>(v.apply_status);
+        w.apply_error_code = v.apply_error_code;
+        w.target = heap.string(v.target);
+        w.applied = heap.string(v.applied);
+    }
+
+    void operator()(const CameraValueStateInt32& v, SnapshotBinaryCameraValueInt32& w) const {
+        w.support = static_cast<uint8_t>(v.support);
+        w.has_target = v.has_target ? 1 : 0;
+        w.has_applied = v.has_applied ? 1 : 0;
+        w.apply_status = static_cast<uint8_t>(v.apply_status);
+        w.apply_error_code = v.apply_error_code;
+        w.target = v.target;
+        w.applied = v.applied;
+    }
+};
+
+SnapshotBinaryCameraState to_wire(const DeviceCameraState& c, HeapWriter& heap) {
+    SnapshotBinaryCameraState w;
+    w.version = c.version;
+    for_each_camera_value(c, w, CameraValueEncoder{heap});
+    return w;
+}
+
+SnapshotBinaryCaptureProfile to_wire(const CaptureProfileState& c, HeapWriter& heap) {
+    SnapshotBinaryCaptureProfile w;
+    w.still_version = c.still.version;
+    w.still_width = c.still.width;
+    w.still_height = c.still.height;
+    w.still_format = c.still.format;
+    std::vector<SnapshotBinaryStillImageMember> members;
+    members.reserve(c.still.still_image_bundle.members.size());
+    for (const CaptureStillImageMemberState& m : c.still.still_image_bundle.members) {
+        SnapshotBinaryStillImageMember wm;
+        wm.image_member_index = m.image_member_index;
+        wm.intended_exposure_compensation_milli_ev = m.intended_exposure_compensation_milli_ev;
+        wm.role = static_cast<uint8_t>(m.role);
+        members.push_back(wm);
+    }
+    w.still_image_members = heap.span(members);
+    return w;
+}
+
+SnapshotBinaryLatencyHistogram to_wire(const LatencyHistogramState& h) {
+    SnapshotBinaryLatencyHistogram w;
+    w.count = h.count;
+    w.min_ns = h.min_ns;
+    w.max_ns = h.max_ns;
+    w.mean_ns = h.mean_ns;
+    w.p50_ns = h.p50_ns;
+    w.p90_ns = h.p90_ns;
+    w.p99_ns = h.p99_ns;
+    w.p999_ns = h.p999_ns;
+    return w;
+}
+
+SnapshotBinaryFramePacing to_wire(const FramePacingState& p) {
+    SnapshotBinaryFramePacing w;
+    w.intervals = p.intervals;
+    w.mean_fps_milli = p.mean_fps_milli;
+    w.interval_p50_ns = p.interval_p50_ns;
+    w.interval_p99_ns = p.interval_p99_ns;
+    w.jitter_ns = p.jitter_ns;
+    w.gaps = p.gaps;
+    return w;
+}
+
+SnapshotBinaryCaptureLatency to_wire(const CaptureLatencyState& c) {
+    SnapshotBinaryCaptureLatency w;
+    w.admission = to_wire(c.admission);
+    w.provider_start = to_wire(c.provider_start);
+    w.image_arrival = to_wire(c.image_arrival);
+    w.finalization = to_wire(c.finalization);
+    w.capture = to_wire(c.capture);
+    return w;
+}
+
+SnapshotBinaryRig to_wire(const RigState& r, HeapWriter& heap) {
+    SnapshotBinaryRig w;
+    w.rig_id = r.rig_id;
+    w.name = heap.string(r.name);
+    std::vector<SnapshotBinaryStringRef> members;
+    members.reserve(r.member_hardware_ids.size());
+    for (const std::string& id : r.member_hardware_ids) {
+        members.push_back(heap.string(id));
+    }
+    w.member_hardware_ids = heap.span(members);
+    w.active_capture_id = r.active_capture_id;
+    w.capture_profile_version = r.capture_profile_version;
+    w.capture_width = r.capture_width;
+    w.capture_height = r.capture_height;
+    w.capture_format = r.capture_format;
+    w.error_code = r.error_code;
+    w.captures_triggered = r.captures_triggered;
+    w.captures_completed = r.captures_completed;
+    w.captures_failed = r.captures_failed;
+    w.last_capture_id = r.last_capture_id;
+    w.last_capture_latency_ns = r.last_capture_latency_ns;
+    w.last_sync_skew_ns = r.last_sync_skew_ns;
+    w.phase = static_cast<uint8_t>(r.phase);
+    w.mode = static_cast<uint8_t>(r.mode);
+    w.capture_latency = to_wire(r.capture_latency);
+    w.sync_skew = to_wire(r.sync_skew);
+    return w;
+}
+
+SnapshotBinaryDevice to_wire(const DeviceState& s, HeapWriter& heap) {
+    SnapshotBinaryDevice w;
+    w.instance_id = s.instance_id;
+    w.hardware_id = heap.string(s.hardware_id);
+    w.rig_id = s.rig_id;
+    w.camera_spec_version = s.camera_spec_version;
+    w.rebuild_count = s.rebuild_count;
+    w.errors_count = s.errors_count;
+    w.warm_hold_ms = s.warm_hold_ms;
+    w.warm_remaining_ms = s.warm_remaining_ms;
+    w.last_error_code = s.last_error_code;
+    w.phase = static_cast<uint8_t>(s.phase);
+    w.mode = static_cast<uint8_t>(s.mode);
+    w.engaged = s.engaged ? 1 : 0;
+    w.capture_profile = to_wire(s.capture_profile, heap);
+    w.camera_state = to_wire(s.camera_state, heap);
+    w.capture_latency = to_wire(s.capture_latency);
+    return w;
+}
+
+SnapshotBinaryAcquisitionSession to_wire(const AcquisitionSessionState& s, HeapWriter& heap) {
+    SnapshotBinaryAcquisitionSession w;
+    w.acquisition_session_id = s.acquisition_session_id;
+    w.device_instance_id = s.device_instance_id;
+    w.captures_triggered = s.captures_triggered;
+    w.captures_completed = s.captures_completed;
+    w.captures_failed = s.captures_failed;
+    w.last_capture_id = s.last_capture_id;
+    w.last_capture_latency_ns = s.last_capture_latency_ns;
+    w.error_code = s.error_code;
+    w.phase = static_cast<uint8_t>(s.phase);
+    w.capture_profile = to_wire(s.capture_profile, heap);
+    w.camera_state = to_wire(s.camera_state, heap);
+    return w;
+}
+
+SnapshotBinaryStream to_wire(const StreamState& s, HeapWriter&) {
+    SnapshotBinaryStream w;
+    w.stream_id = s.stream_id;
+    w.device_instance_id = s.device_instance_id;
+    w.profile_version = s.profile_version;
+    w.width = s.width;
+    w.height = s.height;
+    w.format = s.format;
+    w.target_fps_min = s.target_fps_min;
+    w.target_fps_max = s.target_fps_max;
+    w.queue_depth = s.queue_depth;
+    w.frames_received = s.frames_received;
+    w.frames_delivered = s.frames_delivered;
+    w.frames_dropped = s.frames_dropped;
+    w.last_frame_ts_ns = s.last_frame_ts_ns;
+    w.visibility_frames_presented = s.visibility_frames_presented;
+    w.visibility_frames_rejected_unsupported = s.visibility_frames_rejected_unsupported;
+    w.visibility_frames_rejected_invalid = s.visibility_frames_rejected_invalid;
+    w.phase = static_cast<uint8_t>(s.phase);
+    w.intent = static_cast<uint8_t>(s.intent);
+    w.mode = static_cast<uint8_t>(s.mode);
+    w.stop_reason = static_cast<uint8_t>(s.stop_reason);
+    w.visibility_last_path = static_cast<uint8_t>(s.visibility_last_path);
+    w.qos_level = s.qos_level;
+    w.arrival_pacing = to_wire(s.arrival_pacing);
+    w.delivery_pacing = to_wire(s.delivery_pacing);
+    w.delivery_latency = to_wire(s.delivery_latency);
+    return w;
+}
+
+SnapshotBinaryNativeObject to_wire(const NativeObjectRecord& r, HeapWriter&) {
+    SnapshotBinaryNativeObject w;
+    w.native_id = r.native_id;
+    w.owner_device_instance_id = r.owner_device_instance_id;
+    w.owner_acquisition_session_id = r.owner_acquisition_session_id;
+    w.owner_stream_id = r.owner_stream_id;
+    w.owner_provider_native_id = r.owner_provider_native_id;
+    w.owner_rig_id = r.owner_rig_id;
+    w.root_id = r.root_id;
+    w.creation_gen = r.creation_gen;
+    w.created_ns = r.created_ns;
+    w.destroyed_ns = r.destroyed_ns;
+    w.bytes_allocated = r.bytes_allocated;
+    w.type = r.type;
+    w.buffers_in_use = r.buffers_in_use;
+    w.phase = static_cast<uint8_t>(r.phase);
+    return w;
+}
+
+SnapshotBinaryScopedResourceTelemetry to_wire(const ScopedResourceTelemetry& t, HeapWriter&) {
+    SnapshotBinaryScopedResourceTelemetry w;
+    w.creation_gen = t.creation_gen;
+    w.created_ns = t.created_ns;
+    w.destroyed_ns = t.destroyed_ns;
+    w.framebuffer_lease_current = t.framebuffer_lease_current;
+    w.framebuffer_lease_total_created = t.framebuffer_lease_total_created;
+    w.framebuffer_lease_total_released = t.framebuffer_lease_total_released;
+    w.framebuffer_lease_peak_current = t.framebuffer_lease_peak_current;
+    w.retained_gpu_backing_current = t.retained_gpu_backing_current;
+    w.retained_gpu_backing_total_created = t.retained_gpu_backing_total_created;
+    w.retained_gpu_backing_total_released = t.retained_gpu_backing_total_released;
+    w.retained_gpu_backing_peak_current = t.retained_gpu_backing_peak_current;
+    w.provider_native_id = t.provider_native_id;
+    w.device_instance_id = t.device_instance_id;
+    w.acquisition_session_id = t.acquisition_session_id;
+    w.stream_id = t.stream_id;
+    w.telemetry_scope = t.telemetry_scope;
+    w.phase = static_cast<uint8_t>(t.phase);
+    w.retained_cpu_payload_bytes_current = t.retained_cpu_payload_bytes_current;
+    w.retained_gpu_backing_bytes_current = t.retained_gpu_backing_bytes_current;
+    w.display_view_bytes_current = t.display_view_bytes_current;
+    w.pooled_buffer_bytes_current = t.pooled_buffer_bytes_current;
+    w.large_page_buffer_bytes_current = t.large_page_buffer_bytes_current;
+    w.large_page_fallback_bytes_current = t.large_page_fallback_bytes_current;
+    return w;
+}
+
+uint64_t to_wire(uint64_t id, HeapWriter&) {
+    return id;
+}
+
+// Lays out one message: header + table are reserved up front, sections are
+// appended in add() order, and finish() appends the heap and fills the header.
+class MessageWriter final {
+public:
+    MessageWriter(std::vector<uint8_t>& out, uint32_t section_count)
+        : out_(out), section_count_(section_count + 1) { // + Heap
+        out_.clear();
+        out_.resize(sizeof(SnapshotBinaryHeader) + section_count_ * sizeof(SnapshotBinarySectionEntry), 0);
+    }
+
+    template <typename T>
+    void add(SnapshotBinarySection id, const std::vector<T>& records) {
+        using W = decltype(to_wire(std::declval<const T&>(), heap_));
+        pad_to_alignment(out_);
+        SnapshotBinarySectionEntry e;
+        e.id = static_cast<uint32_t>(id);
+        e.stride = static_cast<uint32_t>(sizeof(W));
+        e.offset = static_cast<uint32_t>(out_.size());
+        e.count = static_cast<uint32_t>(records.size());
+        out_.reserve(out_.size() + records.size() * sizeof(W));
+        for (const T& r : records) {
+            append_wire(out_, to_wire(r, heap_));
+        }
+        put_entry(e);
+    }
+
+    void finish(SnapshotBinaryHeader header) {
+        pad_to_alignment(out_);
+        SnapshotBinarySectionEntry e;
+        e.id = static_cast<uint32_t>(SnapshotBinarySection::Heap);
+        e.stride = 1;
+        e.offset = static_cast<uint32_t>(out_.size());
+        e.count = static_cast<uint32_t>(heap_.bytes.size());
+        out_.insert(out_.end(), heap_.bytes.begin(), heap_.bytes.end());
+        put_entry(e);
+
+        header.section_count = next_entry_;
+        header.total_size = static_cast<uint32_t>(out_.size());
+        std::memcpy(out_.data(), &header, sizeof(header));
+    }
+
+private:
+    void put_entry(const SnapshotBinarySectionEntry& e) {
+        if (next_entry_ >= section_count_) {
+            return;
+        }
+        std::memcpy(out_.data() + sizeof(SnapshotBinaryHeader) + next_entry_ * sizeof(SnapshotBinarySectionEntry),
+                    &e,
+                    sizeof(e));
+        ++next_entry_;
+    }
+
+    std::vector<uint8_t>& out_;
+    HeapWriter heap_;
+    uint32_t section_count_ = 0;
+    uint32_t next_entry_ = 0;
+};
+
+SnapshotBinaryHeader make_header(SnapshotBinaryKind kind,
+                                 uint32_t schema_version,
+                                 uint64_t gen,
+                                 uint64_t version,
+                                 uint64_t topology_version,
+                                 uint64_t timestamp_ns,
+                                 uint64_t imaging_spec_version) {
+    SnapshotBinaryHeader h;
+    h.kind = static_cast<uint16_t>(kind);
+    h.schema_version = schema_version;
+    h.gen = gen;
+    h.version = version;
+    h.topology_version = topology_version;
+    h.timestamp_ns = timestamp_ns;
+    h.imaging_spec_version = imaging_spec_version;
+    return h;
+}
+
+// ---- decode ----------------------------------------------------------------
+
+struct CameraValueDecoder {
+    const SnapshotBinaryView& view;
+
+    void operator()(CameraValueStateString& v, const SnapshotBinaryCameraValueString& w) const {
+        v.support = static_cast<CBCameraValueSupport>(w.support);
+        v.has_target = w.has_target != 0;
+        v.has_applied = w.has_applied != 0;
+        v.apply_status = static_cast<CBCameraApplyStatus>(w.apply_status);
+        v.apply_error_code = w.apply_error_code;
+        v.target = std::string(view.string(w.target));
+        v.applied = std::string(view.string(w.applied));
+    }
+
+    void operator()(CameraValueStateInt32& v, const SnapshotBinaryCameraValueInt32& w) const {
+        v.support = static_cast<CBCameraValueSupport>(w.support);
+        v.has_target = w.has_target != 0;
+        v.has_applied = w.has_applied != 0;
+        v.apply_status = static_cast<CBCameraApplyStatus>(w.apply_status);
+        v.apply_error_code = w.apply_error_code;
+        v.target = w.target;
+        v.applied = w.applied;
+    }
+};
+
+DeviceCameraState from_wire(const SnapshotBinaryCameraState& w, const SnapshotBinaryView& view) {
+    DeviceCameraState c;
+    c.version = w.version;
+    for_each_camera_value(c, w, CameraValueDecoder{view});
+    return c;
+}
+
+CaptureProfileState from_wire(const SnapshotBinaryCaptureProfile& w, const SnapshotBinaryView& view) {
+    CaptureProfileState c;
+    c.still.version = w.still_version;
+    c.still.width = w.still_width;
+    c.still.height = w.still_height;
+    c.still.format = w.still_format;
+    c.still.still_image_bundle.members.reserve(w.still_image_members.count);
+    for (uint32_t i = 0; i < w.still_image_members.count; ++i) {
+        const auto wm = view.element<SnapshotBinaryStillImageMember>(w.still_image_members, i);
+        CaptureStillImageMemberState m;
+        m.image_member_index = wm.image_member_index;
+        m.intended_exposure_compensation_milli_ev = wm.intended_exposure_compensation_milli_ev;
+        m.role = static_cast<CaptureStillImageMemberRole>(wm.role);
+        c.still.still_image_bundle.members.push_back(m);
+    }
+    return c;
+}
+
+LatencyHistogramState from_wire(const SnapshotBinaryLatencyHistogram& w) {
+    LatencyHistogramState h;
+    h.count = w.count;
+    h.min_ns = w.min_ns;
+    h.max_ns = w.max_ns;
+    h.mean_ns = w.mean_ns;
+    h.p50_ns = w.p50_ns;
+    h.p90_ns = w.p90_ns;
+    h.p99_ns = w.p99_ns;
+    h.p999_ns = w.p999_ns;
+    return h;
+}
+
+FramePacingState from_wire(const SnapshotBinaryFramePacing& w) {
+    FramePacingState p;
+    p.intervals = w.intervals;
+    p.mean_fps_milli = w.mean_fps_milli;
+    p.interval_p50_ns = w.interval_p50_ns;
+    p.interval_p99_ns = w.interval_p99_ns;
+    p.jitter_ns = w.jitter_ns;
+    p.gaps = w.gaps;
+    return p;
+}
+
+CaptureLatencyState from_wire(const SnapshotBinaryCaptureLatency& w) {
+    CaptureLatencyState c;
+    c.admission = from_wire(w.admission);
+    c.provider_start = from_wire(w.provider_start);
+    c.image_arrival = from_wire(w.image_arrival);
+    c.finalization = from_wire(w.finalization);
+    c.capture = from_wire(w.capture);
+    return c;
+}
+
+void from_wire(const SnapshotBinaryRig& w, const SnapshotBinaryView& view, RigState& r) {
+    r.rig_id = w.rig_id;
+    r.name = std::string(view.string(w.name));
+    r.member_hardware_ids.reserve(w.member_hardware_ids.count);
+    for (uint32_t i = 0; i < w.member_hardware_ids.count; ++i) {
+        r.member_hardware_ids.emplace_back(
+            view.string(view.element<SnapshotBinaryStringRef>(w.member_hardware_ids, i)));
+    }
+    r.active_capture_id = w.active_capture_id;
+    r.capture_profile_version = w.capture_profile_version;
+    r.capture_width = w.capture_width;
+    r.capture_height = w.capture_height;
+    r.capture_format = w.capture_format;
+    r.error_code = w.error_code;
+    r.captures_triggered = w.captures_triggered;
+    r.captures_completed = w.captures_completed;
+    r.captures_failed = w.captures_failed;
+    r.last_capture_id = w.last_capture_id;
+    r.last_capture_latency_ns = w.last_capture_latency_ns;
+    r.last_sync_skew_ns = w.last_sync_skew_ns;
+    r.phase = static_cast<CBLifecyclePhase>(w.phase);
+    r.mode = static_cast<CBRigMode>(w.mode);
+    r.capture_latency = from_wire(w.capture_latency);
+    r.sync_skew = from_wire(w.sync_skew);
+}
+
+void from_wire(const SnapshotBinaryDevice& w, const SnapshotBinaryView& view, DeviceState& s) {
+    s.instance_id = w.instance_id;
+    s.hardware_id = std::string(view.string(w.hardware_id));
+    s.rig_id = w.rig_id;
+    s.camera_spec_version = w.camera_spec_version;
+    s.rebuild_count = w.rebuild_count;
+    s.errors_count = w.errors_count;
+    s.warm_hold_ms = w.warm_hold_ms;
+    s.warm_remaining_ms = w.warm_remaining_ms;
+    s.last_error_code = w.last_error_code;
+    s.phase = static_cast<CBLifecyclePhase>(w.phase);
+    s.mode = static_cast<CBDeviceMode>(w.mode);
+    s.engaged = w.engaged != 0;
+    s.capture_profile = from_wire(w.capture_profile, view);
+    s.camera_state = from_wire(w.camera_state, view);
+    s.capture_latency = from_wire(w.capture_latency);
+}
+
+void from_wire(const SnapshotBinaryAcquisitionSession& w, const SnapshotBinaryView& view, AcquisitionSessionState& s) {
+    s.acquisition_session_id = w.acquisition_session_id;
+    s.device_instance_id = w.device_instance_id;
+    s.captures_triggered = w.captures_triggered;
+    s.captures_completed = w.captures_completed;
+    s.captures_failed = w.captures_failed;
+    s.last_capture_id = w.last_capture_id;
+    s.last_capture_latency_ns = w.last_capture_latency_ns;
+    s.error_code = w.error_code;
+    s.phase = static_cast<CBLifecyclePhase>(w.phase);
+    s.capture_profile = from_wire(w.capture_profile, view);
+    s.camera_state = from_wire(w.camera_state, view);
+}
+
+void from_wire(const SnapshotBinaryStream& w, const SnapshotBinaryView&, StreamState& s) {
+    s.stream_id = w.stream_id;
+    s.device_instance_id = w.device_instance_id;
+    s.profile_version = w.profile_version;
+    s.width = w.width;
+    s.height = w.height;
+    s.format = w.format;
+    s.target_fps_min = w.target_fps_min;
+    s.target_fps_max = w.target_fps_max;
+    s.queue_depth = w.queue_depth;
+    s.frames_received = w.frames_received;
+    s.frames_delivered = w.frames_delivered;
+    s.frames_dropped = w.frames_dropped;
+    s.last_frame_ts_ns = w.last_frame_ts_ns;
+    s.visibility_frames_presented = w.visibility_frames_presented;
+    s.visibility_frames_rejected_unsupported = w.visibility_frames_rejected_unsupported;
+    s.visibility_frames_rejected_invalid = w.visibility_frames_rejected_invalid;
+    s.phase = static_cast<CBLifecyclePhase>(w.phase);
+    s.intent = static_cast<StreamIntent>(w.intent);
+    s.mode = static_cast<CBStreamMode>(w.mode);
+    s.stop_reason = static_cast<CBStreamStopReason>(w.stop_reason);
+    s.visibility_last_path = static_cast<CBVisibilityLastPath>(w.visibility_last_path);
+    s.qos_level = w.qos_level;
+    s.arrival_pacing = from_wire(w.arrival_pacing);
+    s.delivery_pacing = from_wire(w.delivery_pacing);
+    s.delivery_latency = from_wire(w.delivery_latency);
+}
+
+void from_wire(const SnapshotBinaryNativeObject& w, const SnapshotBinaryView&, NativeObjectRecord& r) {
+    r.native_id = w.native_id;
+    r.owner_device_instance_id = w.owner_device_instance_id;
+    r.owner_acquisition_session_id = w.owner_acquisition_session_id;
+    r.owner_stream_id = w.owner_stream_id;
+    r.owner_provider_native_id = w.owner_provider_native_id;
+    r.owner_rig_id = w.owner_rig_id;
+    r.root_id = w.root_id;
+    r.creation_gen = w.creation_gen;
+    r.created_ns = w.created_ns;
+    r.destroyed_ns = w.destroyed_ns;
+    r.bytes_allocated = w.bytes_allocated;
+    r.type = w.type;
+    r.buffers_in_use = w.buffers_in_use;
+    r.phase = static_cast<CBLifecyclePhase>(w.phase);
+}
+
+void from_wire(const SnapshotBinaryScopedResourceTelemetry& w, const SnapshotBinaryView&, ScopedResourceTelemetry& t) {
+    t.creation_gen = w.creation_gen;
+    t.created_ns = w.created_ns;
+    t.destroyed_ns = w.destroyed_ns;
+    t.framebuffer_lease_current = w.framebuffer_lease_current;
+    t.framebuffer_lease_total_created = w.framebuffer_lease_total_created;
+    t.framebuffer_lease_total_released = w.framebuffer_lease_total_released;
+    t.framebuffer_lease_peak_current = w.framebuffer_lease_peak_current;
+    t.retained_gpu_backing_current = w.retained_gpu_backing_current;
+    t.retained_gpu_backing_total_created = w.retained_gpu_backing_total_created;
+    t.retained_gpu_backing_total_released = w.retained_gpu_backing_total_released;
+    t.retained_gpu_backing_peak_current = w.retained_gpu_backing_peak_current;
+    t.provider_native_id = w.provider_native_id;
+    t.device_instance_id = w.device_instance_id;
+    t.acquisition_session_id = w.acquisition_session_id;
+    t.stream_id = w.stream_id;
+    t.telemetry_scope = w.telemetry_scope;
+    t.phase = static_cast<CBLifecyclePhase>(w.phase);
+    t.retained_cpu_payload_bytes_current = w.retained_cpu_payload_bytes_current;
+    t.retained_gpu_backing_bytes_current = w.retained_gpu_backing_bytes_current;
+    t.display_view_bytes_current = w.display_view_bytes_current;
+    t.pooled_buffer_bytes_current = w.pooled_buffer_bytes_current;
+    t.large_page_buffer_bytes_current = w.large_page_buffer_bytes_current;
+    t.large_page_fallback_bytes_current = w.large_page_fallback_bytes_current;
+}
+
+void from_wire(const uint64_t& w, const SnapshotBinaryView&, uint64_t& id) {
+    id = w;
+}
+
+template <typename W, typename T>
+void read_section(const SnapshotBinaryView& view, SnapshotBinarySection id, std::vector<T>& out) {
+    const uint32_t n = view.count(id);
+    out.clear();
+    out.resize(n);
+    for (uint32_t i = 0; i < n; ++i) {
+        from_wire(view.record<W>(id, i), view, out[i]);
+    }
+}
+
+} // namespace
+
+void encode_snapshot_binary(const CamBANGStateSnapshot& snap, std::vector<uint8_t>& out) {
+    MessageWriter w(out, 7);
+    w.add(SnapshotBinarySection::Rigs, snap.rigs);
+    w.add(SnapshotBinarySection::Devices, snap.devices);
+    w.add(SnapshotBinarySection::AcquisitionSessions, snap.acquisition_sessions);
+    w.add(SnapshotBinarySection::Streams, snap.streams);
+    w.add(SnapshotBinarySection::NativeObjects, snap.native_objects);
+    w.add(SnapshotBinarySection::DetachedRootIds, snap.detached_root_ids);
+    w.add(SnapshotBinarySection::ScopedResourceTelemetry, snap.scoped_resource_telemetry);
+    w.finish(make_header(SnapshotBinaryKind::Snapshot,
+                         snap.schema_version,
+                         snap.gen,
+                         snap.version,
+                         snap.topology_version,
+                         snap.timestamp_ns,
+                         snap.imaging_spec_version));
+}
+
+void encode_snapshot_delta_binary(const CamBANGStateSnapshotDelta& delta, std::vector<uint8_t>& out) {
+    const uint32_t unkeyed = (delta.detached_root_ids_changed ? 1u : 0u) +
+                             (delta.scoped_resource_telemetry_changed ? 1u : 0u);
+    MessageWriter w(out, 10 + unkeyed);
+    w.add(SnapshotBinarySection::Rigs, delta.rigs_changed);
+    w.add(SnapshotBinarySection::Devices, delta.devices_changed);
+    w.add(SnapshotBinarySection::AcquisitionSessions, delta.acquisition_sessions_changed);
+    w.add(SnapshotBinarySection::Streams, delta.streams_changed);
+    w.add(SnapshotBinarySection::NativeObjects, delta.native_objects_changed);
+    w.add(SnapshotBinarySection::RigsRemoved, delta.rigs_removed);
+    w.add(SnapshotBinarySection::DevicesRemoved, delta.devices_removed);
+    w.add(SnapshotBinarySection::AcquisitionSessionsRemoved, delta.acquisition_sessions_removed);
+    w.add(SnapshotBinarySection::StreamsRemoved, delta.streams_removed);
+    w.add(SnapshotBinarySection::NativeObjectsRemoved, delta.native_objects_removed);
+    SnapshotBinaryHeader h = make_header(SnapshotBinaryKind::Delta,
+                                         delta.schema_version,
+                                         delta.gen,
+                                         delta.version,
+                                         delta.topology_version,
+                                         delta.timestamp_ns,
+                                         delta.imaging_spec_version);
+    h.from_gen = delta.from_gen;
+    h.from_version = delta.from_version;
+    if (delta.detached_root_ids_changed) {
+        w.add(SnapshotBinarySection::DetachedRootIds, delta.detached_root_ids);
+        h.flags |= kSnapshotBinaryDetachedRootIdsChanged;
+    }
+    if (delta.scoped_resource_telemetry_changed) {
+        w.add(SnapshotBinarySection::ScopedResourceTelemetry, delta.scoped_resource_telemetry);
+        h.flags |= kSnapshotBinaryScopedResourceTelemetryChanged;
+    }
+    w.finish(h);
+}
+
+size_t snapshot_binary_message_size(const uint8_t* data, size_t size) noexcept {
+    SnapshotBinaryHeader h;
+    if (!data || size < sizeof(h)) {
+        return 0;
+    }
+    std::memcpy(&h, data, sizeof(h));
+    if (h.magic != kSnapshotBinaryMagic || h.total_size < sizeof(h)) {
+        return 0;
+    }
+    return h.total_size;
+}
+
+bool SnapshotBinaryView::open(const uint8_t* data, size_t size) noexcept {
+    data_ = nullptr;
+    header_ = SnapshotBinaryHeader{};
+    heap_ = nullptr;
+    heap_size_ = 0;
+
+    SnapshotBinaryHeader h;
+    if (!data || size < sizeof(h)) {
+        return false;
+    }
+    std::memcpy(&h, data, sizeof(h));
+    if (h.magic != kSnapshotBinaryMagic || h.format_version != kSnapshotBinaryFormatVersion ||
+        h.total_size > size) {
+        return false;
+    }
+    const uint64_t table_end =
+        sizeof(h) + static_cast<uint64_t>(h.section_count) * sizeof(SnapshotBinarySectionEntry);
+    if (table_end > h.total_size) {
+        return false;
+    }
+    for (uint32_t i = 0; i < h.section_count; ++i) {
+        SnapshotBinarySectionEntry e;
+        std::memcpy(&e, data + sizeof(h) + static_cast<size_t>(i) * sizeof(e), sizeof(e));
+        const uint64_t end = static_cast<uint64_t>(e.offset) + static_cast<uint64_t>(e.stride) * e.count;
+        if (e.offset < table_end || end > h.total_size || (e.count != 0 && e.stride == 0)) {
+            return false;
+        }
+        if (e.id == static_cast<uint32_t>(SnapshotBinarySection::Heap)) {
+            if (e.stride != 1) {
+                return false;
+            }
+            heap_ = data + e.offset;
+            heap_size_ = e.count;
+        }
+    }
+    data_ = data;
+    header_ = h;
+    return true;
+}
+
+bool SnapshotBinaryView::find(SnapshotBinarySection id, SnapshotBinarySectionEntry& out) const noexcept {
+    if (!data_) {
+        return false;
+    }
+    for (uint32_t i = 0; i < header_.section_count; ++i) {
+        std::memcpy(&out, data_ + sizeof(SnapshotBinaryHeader) + static_cast<size_t>(i) * sizeof(out), sizeof(out));
+        if (out.id == static_cast<uint32_t>(id)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+uint32_t SnapshotBinaryView::count(SnapshotBinarySection id) const noexcept {
+    SnapshotBinarySectionEntry e;
+    return find(id, e) ? e.count : 0;
+}
+
+std::string_view SnapshotBinaryView::string(SnapshotBinaryStringRef ref) const noexcept {
+    if (static_cast<uint64_t>(ref.offset) + ref.size > heap_size_) {
+        return {};
+    }
+    return std::string_view(reinterpret_cast<const char*>(heap_ + ref.offset), ref.size);
+}
+
+bool decode_snapshot_binary(const uint8_t* data, size_t size, CamBANGStateSnapshot& out) {
+    SnapshotBinaryView view;
+    if (!view.open(data, size) || view.kind() != SnapshotBinaryKind::Snapshot) {
+        return false;
+    }
+    const SnapshotBinaryHeader& h = view.header();
+    out.schema_version = h.schema_version;
+    out.gen = h.gen;
+    out.version = h.version;
+    out.topology_version = h.topology_version;
+    out.timestamp_ns = h.timestamp_ns;
+    out.imaging_spec_version = h.imaging_spec_version;
+    read_section<SnapshotBinaryRig>(view, SnapshotBinarySection::Rigs, out.rigs);
+    read_section<SnapshotBinaryDevice>(view, SnapshotBinarySection::Devices, out.devices);
+    read_section<SnapshotBinaryAcquisitionSession>(
+        view, SnapshotBinarySection::AcquisitionSessions, out.acquisition_sessions);
+    read_section<SnapshotBinaryStream>(view, SnapshotBinarySection::Streams, out.streams);
+    read_section<SnapshotBinaryNativeObject>(view, SnapshotBinarySection::NativeObjects, out.native_objects);
+    read_section<uint64_t>(view, SnapshotBinarySection::DetachedRootIds, out.detached_root_ids);
+    read_section<SnapshotBinaryScopedResourceTelemetry>(
+        view, SnapshotBinarySection::ScopedResourceTelemetry, out.scoped_resource_telemetry);
+    return true;
+}
+
+bool decode_snapshot_delta_binary(const uint8_t* data, size_t size, CamBANGStateSnapshotDelta& out) {
+    SnapshotBinaryView view;
+    if (!view.open(data, size) || view.kind() != SnapshotBinaryKind::Delta) {
+        return false;
+    }
+    const SnapshotBinaryHeader& h = view.header();
+    out.from_gen = h.from_gen;
+    out.from_version = h.from_version;
+    out.schema_version = h.schema_version;
+    out.gen = h.gen;
+    out.version = h.version;
+    out.topology_version = h.topology_version;
+    out.timestamp_ns = h.timestamp_ns;
+    out.imaging_spec_version = h.imaging_spec_version;
+    read_section<SnapshotBinaryRig>(view, SnapshotBinarySection::Rigs, out.rigs_changed);
+    read_section<SnapshotBinaryDevice>(view, SnapshotBinarySection::Devices, out.devices_changed);
+    read_section<SnapshotBinaryAcquisitionSession>(
+        view, SnapshotBinarySection::AcquisitionSessions, out.acquisition_sessions_changed);
+    read_section<SnapshotBinaryStream>(view, SnapshotBinarySection::Streams, out.streams_changed);
+    read_section<SnapshotBinaryNativeObject>(view, SnapshotBinarySection::NativeObjects, out.native_objects_changed);
+    read_section<uint64_t>(view, SnapshotBinarySection::RigsRemoved, out.rigs_removed);
+    read_section<uint64_t>(view, SnapshotBinarySection::DevicesRemoved, out.devices_removed);
+    read_section<uint64_t>(view, SnapshotBinarySection::AcquisitionSessionsRemoved, out.acquisition_sessions_removed);
+    read_section<uint64_t>(view, SnapshotBinarySection::StreamsRemoved, out.streams_removed);
+    read_section<uint64_t>(view, SnapshotBinarySection::NativeObjectsRemoved, out.native_objects_removed);
+    out.detached_root_ids_changed = (h.flags & kSnapshotBinaryDetachedRootIdsChanged) != 0;
+    read_section<uint64_t>(view, SnapshotBinarySection::DetachedRootIds, out.detached_root_ids);
+    out.scoped_resource_telemetry_changed = (h.flags & kSnapshotBinaryScopedResourceTelemetryChanged) != 0;
+    read_section<SnapshotBinaryScopedResourceTelemetry>(
+        view, SnapshotBinarySection::ScopedResourceTelemetry, out.scoped_resource_telemetry);
+    return true;
+}
+
+} // namespace cambang
@@ -0,0 +1,384 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include <vector>
+
+#include "core/snapshot/snapshot_delta.h"
+#include "core/snapshot/state_snapshot.h"
+
+// Compact binary encoding of state snapshot schema v1 for out-of-process
+// monitoring (no Godot Variants involved).
+//
+// A message is self-delimiting and position-independent, so it can be written
+// as-is into a memory-mapped ring or onto a byte stream:
+//
+//   SnapshotBinaryHeader
+//   SnapshotBinarySectionEntry[section_count]
+//   section payloads (each 8-byte aligned)
+//
+// Every section is an array of fixed-stride wire records. Strings and nested
+// arrays live in the Heap section and are referenced by heap offset, so a
+// reader walks the message in place without allocating. All integers are
+// little-endian.
+//
+// Evolution: readers locate sections by id and ignore ids they do not know.
+// Records only ever grow at the end; a reader zero-fills fields beyond the
+// stride a message carries and ignores bytes beyond the fields it knows.
+// Incompatible layout changes bump kSnapshotBinaryFormatVersion.
+
+namespace cambang {
+
+inline constexpr uint32_t kSnapshotBinaryMagic = 0x53534243u; // "CBSS"
+inline constexpr uint16_t kSnapshotBinaryFormatVersion = 1;
+
+enum class SnapshotBinaryKind : uint16_t {
+    Snapshot = 1,
+    Delta = 2,
+};
+
+enum class SnapshotBinarySection : uint32_t {
+    Rigs = 1,
+    Devices = 2,
+    AcquisitionSessions = 3,
+    Streams = 4,
+    NativeObjects = 5,
+    DetachedRootIds = 6,         // uint64_t
+    ScopedResourceTelemetry = 7,
+    // Delta only: ids (uint64_t) of records removed since the base snapshot.
+    RigsRemoved = 8,
+    DevicesRemoved = 9,
+    AcquisitionSessionsRemoved = 10,
+    StreamsRemoved = 11,
+    NativeObjectsRemoved = 12,
+    Heap = 13,                   // stride 1
+};
+
+// SnapshotBinaryHeader::flags (delta only).
+inline constexpr uint32_t kSnapshotBinaryDetachedRootIdsChanged = 1u << 0;
+inline constexpr uint32_t kSnapshotBinaryScopedResourceTelemetryChanged = 1u << 1;
+
+struct SnapshotBinaryHeader {
+    uint32_t magic = kSnapshotBinaryMagic;
+    uint16_t format_version = kSnapshotBinaryFormatVersion;
+    uint16_t kind = 0;            // SnapshotBinaryKind
+    uint32_t total_size = 0;      // whole message, header included
+    uint32_t section_count = 0;
+    uint32_t schema_version = 0;
+    uint32_t flags = 0;
+    uint64_t gen = 0;
+    uint64_t version = 0;
+    uint64_t topology_version = 0;
+    uint64_t timestamp_ns = 0;
+    uint64_t imaging_spec_version = 0;
+    uint64_t from_gen = 0;        // delta base; 0 for snapshots
+    uint64_t from_version = 0;
+};
+
+struct SnapshotBinarySectionEntry {
+    uint32_t id = 0;              // SnapshotBinarySection
+    uint32_t stride = 0;          // bytes per record
+    uint32_t offset = 0;          // from message start
+    uint32_t count = 0;           // records
+};
+
+// Heap references. Offsets are relative to the Heap section payload.
+struct SnapshotBinaryStringRef {
+    uint32_t offset = 0;
+    uint32_t size = 0;            // bytes, UTF-8, not NUL-terminated
+};
+
+struct SnapshotBinarySpan {
+    uint32_t offset = 0;
+    uint32_t count = 0;           // elements of the documented wire type
+};
+
+struct SnapshotBinaryStillImageMember {
+    uint32_t image_member_index = 0;
+    int32_t intended_exposure_compensation_milli_ev = 0;
+    uint8_t role = 0;
+    uint8_t reserved[3] = {};
+};
+
+struct SnapshotBinaryCaptureProfile {
+    uint64_t still_version = 0;
+    uint32_t still_width = 0;
+    uint32_t still_height = 0;
+    uint32_t still_format = 0;
+    uint32_t reserved = 0;
+    SnapshotBinarySpan still_image_members; // SnapshotBinaryStillImageMember
+};
+
+struct SnapshotBinaryCameraValueString {
+    uint8_t support = 0;
+    uint8_t has_target = 0;
+    uint8_t has_applied = 0;
+    uint8_t apply_status = 0;
+    int32_t apply_error_code = 0;
+    SnapshotBinaryStringRef target;
+    SnapshotBinaryStringRef applied;
+};
+
+struct SnapshotBinaryCameraValueInt32 {
+    uint8_t support = 0;
+    uint8_t has_target = 0;
+    uint8_t has_applied = 0;
+    uint8_t apply_status = 0;
+    int32_t apply_error_code = 0;
+    int32_t target = 0;
+    int32_t applied = 0;
+};
+
+// DeviceCameraState flattened in declaration order.
+struct SnapshotBinaryCameraState {
+    uint64_t version = 0;
+    SnapshotBinaryCameraValueString exposure_ae_mode;
+    SnapshotBinaryCameraValueInt32 exposure_baseline_exposure_compensation_milli_ev;
+    SnapshotBinaryCameraValueString focus_af_mode;
+    SnapshotBinaryCameraValueInt32 focus_focus_distance_diopters_milli;
+    SnapshotBinaryCameraValueString white_balance_awb_mode;
+    SnapshotBinaryCameraValueInt32 white_balance_color_temperature_kelvin;
+    SnapshotBinaryCameraValueString stabilization_mode;
+    SnapshotBinaryCameraValueInt32 stabilization_strength_percent;
+    SnapshotBinaryCameraValueString flash_torch_flash_mode;
+    SnapshotBinaryCameraValueInt32 flash_torch_torch_level;
+    SnapshotBinaryCameraValueInt32 zoom_crop_zoom_ratio_milli;
+    SnapshotBinaryCameraValueString zoom_crop_crop_preset;
+    SnapshotBinaryCameraValueString processing_noise_reduction_mode;
+    SnapshotBinaryCameraValueInt32 processing_edge_enhancement_level;
+    SnapshotBinaryCameraValueString metering_metering_mode;
+    SnapshotBinaryCameraValueString metering_metering_region_preset;
+    SnapshotBinaryCameraValueString antibanding_mode;
+    SnapshotBinaryCameraValueInt32 antibanding_mains_frequency_hz;
+    SnapshotBinaryCameraValueInt32 orientation_mirroring_rotation_degrees;
+    SnapshotBinaryCameraValueString orientation_mirroring_mirror_mode;
+    SnapshotBinaryCameraValueString privacy_hardware_block_privacy_mode;
+    SnapshotBinaryCameraValueString privacy_hardware_block_hardware_block_reason;
+};
+
+struct SnapshotBinaryLatencyHistogram {
+    uint64_t count = 0;
+    uint64_t min_ns = 0;
+    uint64_t max_ns = 0;
+    uint64_t mean_ns = 0;
+    uint64_t p50_ns = 0;
+    uint64_t p90_ns = 0;
+    uint64_t p99_ns = 0;
+    uint64_t p999_ns = 0;
+};
+
+struct SnapshotBinaryCaptureLatency {
+    SnapshotBinaryLatencyHistogram admission;
+    SnapshotBinaryLatencyHistogram provider_start;
+    SnapshotBinaryLatencyHistogram image_arrival;
+    SnapshotBinaryLatencyHistogram finalization;
+    SnapshotBinaryLatencyHistogram capture;
+};
+
+struct SnapshotBinaryRig {
+    uint64_t rig_id = 0;
+    SnapshotBinaryStringRef name;
+    SnapshotBinarySpan member_hardware_ids; // SnapshotBinaryStringRef
+    uint64_t active_capture_id = 0;
+    uint64_t capture_profile_version = 0;
+    uint32_t capture_width = 0;
+    uint32_t capture_height = 0;
+    uint32_t capture_format = 0;
+    int32_t error_code = 0;
+    uint64_t captures_triggered = 0;
+    uint64_t captures_completed = 0;
+    uint64_t captures_failed = 0;
+    uint64_t last_capture_id = 0;
+    uint64_t last_capture_latency_ns = 0;
+    uint64_t last_sync_skew_ns = 0;
+    uint8_t phase = 0;
+    uint8_t mode = 0;
+    uint8_t reserved[6] = {};
+    SnapshotBinaryCaptureLatency capture_latency;
+    SnapshotBinaryLatencyHistogram sync_skew;
+};
+
+struct SnapshotBinaryDevice {
+    uint64_t instance_id = 0;
+    SnapshotBinaryStringRef hardware_id;
+    uint64_t rig_id = 0;
+    uint64_t camera_spec_version = 0;
+    uint64_t rebuild_count = 0;
+    uint64_t errors_count = 0;
+    uint32_t warm_hold_ms = 0;
+    uint32_t warm_remaining_ms = 0;
+    int32_t last_error_code = 0;
+    uint8_t phase = 0;
+    uint8_t mode = 0;
+    uint8_t engaged = 0;
+    uint8_t reserved = 0;
+    SnapshotBinaryCaptureProfile capture_profile;
+    SnapshotBinaryCameraState camera_state;
+    SnapshotBinaryCaptureLatency capture_latency;
+};
+
+struct SnapshotBinaryAcquisitionSession {
+    uint64_t acquisition_session_id = 0;
+    uint64_t device_instance_id = 0;
+    uint64_t captures_triggered = 0;
+    uint64_t captures_completed = 0;
+    uint64_t captures_failed = 0;
+    uint64_t last_capture_id = 0;
+    uint64_t last_capture_latency_ns = 0;
+    int32_t error_code = 0;
+    uint8_t phase = 0;
+    uint8_t reserved[3] = {};
+    SnapshotBinaryCaptureProfile capture_profile;
+    SnapshotBinaryCameraState camera_state;
+};
+
+struct SnapshotBinaryFramePacing {
+    uint64_t intervals = 0;
+    uint32_t mean_fps_milli = 0;
+    uint32_t reserved = 0;
+    uint64_t interval_p50_ns = 0;
+    uint64_t interval_p99_ns = 0;
+    uint64_t jitter_ns = 0;
+    uint64_t gaps = 0;
+};
+
+struct SnapshotBinaryStream {
+    uint64_t stream_id = 0;
+    uint64_t device_instance_id = 0;
+    uint64_t profile_version = 0;
+    uint32_t width = 0;
+    uint32_t height = 0;
+    uint32_t format = 0;
+    uint32_t target_fps_min = 0;
+    uint32_t target_fps_max = 0;
+    uint32_t queue_depth = 0;
+    uint64_t frames_received = 0;
+    uint64_t frames_delivered = 0;
+    uint64_t frames_dropped = 0;
+    uint64_t last_frame_ts_ns = 0;
+    uint64_t visibility_frames_presented = 0;
+    uint64_t visibility_frames_rejected_unsupported = 0;
+    uint64_t visibility_frames_rejected_invalid = 0;
+    uint8_t phase = 0;
+    uint8_t intent = 0;
+    uint8_t mode = 0;
+    uint8_t stop_reason = 0;
+    uint8_t visibility_last_path = 0;
+    uint8_t qos_level = 0;
+    uint8_t reserved[2] = {};
+    SnapshotBinaryFramePacing arrival_pacing;
+    SnapshotBinaryFramePacing delivery_pacing;
+    SnapshotBinaryLatencyHistogram delivery_latency;
+};
+
+struct SnapshotBinaryNativeObject {
+    uint64_t native_id = 0;
+    uint64_t owner_device_instance_id = 0;
+    uint64_t owner_acquisition_session_id = 0;
+    uint64_t owner_stream_id = 0;
+    uint64_t owner_provider_native_id = 0;
+    uint64_t owner_rig_id = 0;
+    uint64_t root_id = 0;
+    uint64_t creation_gen = 0;
+    uint64_t created_ns = 0;
+    uint64_t destroyed_ns = 0;
+    uint64_t bytes_allocated = 0;
+    uint32_t type = 0;
+    uint32_t buffers_in_use = 0;
+    uint8_t phase = 0;
+    uint8_t reserved[7] = {};
+};
+
+struct SnapshotBinaryScopedResourceTelemetry {
+    uint64_t creation_gen = 0;
+    uint64_t created_ns = 0;
+    uint64_t destroyed_ns = 0;
+    uint64_t framebuffer_lease_current = 0;
+    uint64_t framebuffer_lease_total_created = 0;
+    uint64_t framebuffer_lease_total_released = 0;
+    uint64_t framebuffer_lease_peak_current = 0;
+    uint64_t retained_gpu_backing_current = 0;
+    uint64_t retained_gpu_backing_total_created = 0;
+    uint64_t retained_gpu_backing_total_released = 0;
+    uint64_t retained_gpu_backing_peak_current = 0;
+    uint64_t provider_native_id = 0;
+    uint64_t device_instance_id = 0;
+    uint64_t acquisition_session_id = 0;
+    uint64_t stream_id = 0;
+    uint32_t telemetry_scope = 0;
+    uint8_t phase = 0;
+    uint8_t reserved[3] = {};
+    uint64_t retained_cpu_payload_bytes_current = 0;
+    uint64_t retained_gpu_backing_bytes_current = 0;
+    uint64_t display_view_bytes_current = 0;
+    uint64_t pooled_buffer_bytes_current = 0;
+    uint64_t large_page_buffer_bytes_current = 0;
+    uint64_t large_page_fallback_bytes_current = 0;
+};
+
+// Encoders replace `out` with one message, reusing its capacity.
+void encode_snapshot_binary(const CamBANGStateSnapshot& snap, std::vector<uint8_t>& out);
+void encode_snapshot_delta_binary(const CamBANGStateSnapshotDelta& delta, std::vector<uint8_t>& out);
+
+// Returns the size of the message starting at `data` once its header is
+// available (0 if `size` does not cover a header or the magic is wrong).
+// Stream readers use this to frame messages.
+size_t snapshot_binary_message_size(const uint8_t* data, size_t size) noexcept;
+
+// Zero-copy reader over one message. The caller keeps the bytes alive.
+class SnapshotBinaryView final {
+public:
+    // Validates the header, section table and every section's bounds.
+    bool open(const uint8_t* data, size_t size) noexcept;
+
+    const SnapshotBinaryHeader& header() const noexcept { return header_; }
+    SnapshotBinaryKind kind() const noexcept { return static_cast<SnapshotBinaryKind>(header_.kind); }
+
+    // 0 when the section is absent.
+    uint32_t count(SnapshotBinarySection id) const noexcept;
+
+    // Record `i` of section `id`. `W` must be the section's wire type.
+    template <typename W>
+    W record(SnapshotBinarySection id, uint32_t i) const noexcept {
+        W out{};
+        SnapshotBinarySectionEntry s;
+        if (find(id, s) && i < s.count) {
+            std::memcpy(&out, data_ + s.offset + static_cast<size_t>(i) * s.stride,
+                        s.stride < sizeof(W) ? s.stride : sizeof(W));
+        }
+        return out;
+    }
+
+    // Element `i` of a heap span of `W`; zero-initialised when out of bounds.
+    template <typename W>
+    W element(SnapshotBinarySpan span, uint32_t i) const noexcept {
+        W out{};
+        if (i < span.count) {
+            const uint64_t at = static_cast<uint64_t>(span.offset) + static_cast<uint64_t>(i) * sizeof(W);
+            if (at + sizeof(W) <= heap_size_) {
+                std::memcpy(&out, heap_ + at, sizeof(W));
+            }
+        }
+        return out;
+    }
+
+    // Empty when out of bounds.
+    std::string_view string(SnapshotBinaryStringRef ref) const noexcept;
+
+private:
+    bool find(SnapshotBinarySection id, SnapshotBinarySectionEntry& out) const noexcept;
+
+    const uint8_t* data_ = nullptr;
+    SnapshotBinaryHeader header_{};
+    const uint8_t* heap_ = nullptr;
+    size_t heap_size_ = 0;
+};
+
+// Materialise a message back into snapshot / delta form. Return false on a
+// malformed message or a kind mismatch.
+bool decode_snapshot_binary(const uint8_t* data, size_t size, CamBANGStateSnapshot& out);
+bool decode_snapshot_delta_binary(const uint8_t* data, size_t size, CamBANGStateSnapshotDelta& out);
+
+} // namespace cambang
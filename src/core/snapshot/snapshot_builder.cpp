@@ -1,12 +1,16 @@
 #include "core/snapshot/snapshot_builder.h"
 
+#include <algorithm>
 #include <cstring>
 #include <limits>
 #include <set>
+#include <utility>
 
+#include "core/core_capture_latency_stats.h"
 #include "core/core_device_registry.h"
 #include "core/core_acquisition_session_registry.h"
 #include "core/core_native_object_registry.h"
+#include "core/core_result_store.h"
 #include "core/core_rig_registry.h"
 #include "core/core_spec_state.h"
 #include "core/core_stream_registry.h"
@@ -36,6 +40,52 @@ CBVisibilityLastPath to_snapshot_visibility_path(CoreVisibilityPath path) {
     }
 }
 
+LatencyHistogramState make_latency_histogram_state(const CoreHdrHistogram::Summary& summary) {
+    LatencyHistogramState out;
+    out.count = summary.count;
+    out.min_ns = summary.min_ns;
+    out.max_ns = summary.max_ns;
+    out.mean_ns = summary.mean_ns;
+    out.p50_ns = summary.p50_ns;
+    out.p90_ns = summary.p90_ns;
+    out.p99_ns = summary.p99_ns;
+    out.p999_ns = summary.p999_ns;
+    return out;
+}
+
+LatencyHistogramState make_latency_histogram_state(const CoreHdrHistogram& histogram) {
+    return make_latency_histogram_state(histogram.summary());
+}
+
+FramePacingState make_frame_pacing_state(const CoreFramePacing::Summary& summary) {
+    FramePacingState out;
+    out.intervals = summary.intervals;
+    if (summary.mean_interval_ns != 0) {
+        const uint64_t fps_milli = (1'000'000'000'000ull + summary.mean_interval_ns / 2) / summary.mean_interval_ns;
+        out.mean_fps_milli = static_cast<uint32_t>(
+            std::min<uint64_t>(fps_milli, std::numeric_limits<uint32_t>::max()));
+    }
+    out.interval_p50_ns = summary.interval_p50_ns;
+    out.interval_p99_ns = summary.interval_p99_ns;
+    out.jitter_ns = summary.jitter_ns;
+    out.gaps = summary.gaps;
+    return out;
+}
+
+CaptureLatencyState make_capture_latency_state(const CoreCaptureLatencyStats::Histograms* histograms) {
+    using Metric = CoreCaptureLatencyStats::Metric;
+    CaptureLatencyState out;
+    if (!histograms) {
+        return out;
+    }
+    out.admission = make_latency_histogram_state((*histograms)[Metric::Admission]);
+    out.provider_start = make_latency_histogram_state((*histograms)[Metric::ProviderStart]);
+    out.image_arrival = make_latency_histogram_state((*histograms)[Metric::ImageArrival]);
+    out.finalization = make_latency_histogram_state((*histograms)[Metric::Finalization]);
+    out.capture = make_latency_histogram_state((*histograms)[Metric::Capture]);
+    return out;
+}
+
 inline void fnv1a_u64(uint64_t& h, uint64_t v) {
     for (int i = 0; i < 8; ++i) {
         uint8_t b = static_cast<uint8_t>((v >> (i * 8)) & 0xFF);
@@ -119,52 +169,207 @@ std::set<uint64_t> compute_detached_roots(const SnapshotBuilder::Inputs& in) {
     return detached_roots;
 }
 
+// Identity of the devices/streams compute_detached_roots() checks owners
+// against; any change to either id set must change this value.
+uint64_t detached_owner_fingerprint(const SnapshotBuilder::Inputs& in) {
+    uint64_t h = kFnvOffset;
+    if (in.devices) {
+        fnv1a_u64(h, static_cast<uint64_t>(in.devices->all().size()));
+        for (const auto& [device_id, rec] : in.devices->all()) {
+            (void)rec;
+            fnv1a_u64(h, device_id);
+        }
+    }
+    if (in.streams) {
+        fnv1a_u64(h, static_cast<uint64_t>(in.streams->all().size()));
+        for (const auto& [stream_id, rec] : in.streams->all()) {
+            (void)rec;
+            fnv1a_u64(h, stream_id);
+        }
+    }
+    return h;
+}
+
 } // namespace
 
-CamBANGStateSnapshot SnapshotBuilder::build(const Inputs& in,
-                                            uint64_t gen,
-                                            uint64_t version,
-                                            uint64_t topology_version,
-                                            uint64_t timestamp_ns) const {
-    CamBANGStateSnapshot snap;
-    snap.schema_version = CamBANGStateSnapshot::kSchemaVersion;
-    snap.gen = gen;
-    snap.version = version;
-    snap.topology_version = topology_version;
-    snap.timestamp_ns = timestamp_ns;
+const std::shared_ptr<const std::vector<RigState>>& SnapshotBuilder::rig_states_(
+    const CoreRigRegistry& rigs, const CoreCaptureLatencyStats* capture_latency) const {
+    const uint64_t latency_revision = capture_latency ? capture_latency->revision() : 0;
+    if (rigs_cache_.valid && rigs_cache_.revision == rigs.revision() &&
+        rigs_cache_latency_revision_ == latency_revision) {
+        return rigs_cache_.records;
+    }
+    auto out_records = std::make_shared<std::vector<RigState>>();
+    std::vector<RigState>& out = *out_records;
+    out.reserve(rigs.all().size());
+    for (const auto& [rig_id, rec] : rigs.all()) {
+        RigState r;
+        r.rig_id = rec.rig_id;
+        r.name = rec.name;
+        r.phase = rec.live ? CBLifecyclePhase::LIVE : CBLifecyclePhase::CREATED;
+        r.mode = CBRigMode::OFF;
+        r.member_hardware_ids = rec.member_hardware_ids;
+        r.active_capture_id = rec.active_capture_id;
+        r.capture_profile_version = rec.capture_profile_version;
+        r.capture_width = rec.capture_width;
+        r.capture_height = rec.capture_height;
+        r.capture_format = rec.capture_format;
+        r.captures_triggered = rec.captures_triggered;
+        r.captures_completed = rec.captures_completed;
+        r.captures_failed = rec.captures_failed;
+        r.last_capture_id = rec.last_capture_id;
+        r.last_capture_latency_ns = rec.last_capture_latency_ns;
+        r.last_sync_skew_ns = rec.last_sync_skew_ns;
+        if (const CoreCaptureLatencyStats::Histograms* histograms =
+                capture_latency ? capture_latency->rig(rig_id) : nullptr) {
+            r.capture_latency = make_capture_latency_state(histograms);
+            r.sync_skew = make_latency_histogram_state(
+                (*histograms)[CoreCaptureLatencyStats::Metric::SyncSkew]);
+        }
+        r.error_code = rec.error_code;
+        out.push_back(std::move(r));
+    }
+    rigs_cache_.records = std::move(out_records);
+    rigs_cache_.valid = true;
+    rigs_cache_.revision = rigs.revision();
+    rigs_cache_latency_revision_ = latency_revision;
+    return rigs_cache_.records;
+}
 
-    snap.imaging_spec_version = in.spec_state ? in.spec_state->imaging_spec_version() : 0;
+const std::shared_ptr<const std::vector<AcquisitionSessionState>>& SnapshotBuilder::acquisition_session_states_(
+    const CoreAcquisitionSessionRegistry& sessions) const {
+    if (acquisition_sessions_cache_.valid && acquisition_sessions_cache_.revision == sessions.revision()) {
+        return acquisition_sessions_cache_.records;
+    }
+    auto out_records = std::make_shared<std::vector<AcquisitionSessionState>>();
+    std::vector<AcquisitionSessionState>& out = *out_records;
+    out.reserve(sessions.all().size());
+    for (const auto& [session_id, rec] : sessions.all()) {
+        (void)session_id;
+        if (rec.phase == CBLifecyclePhase::DESTROYED) {
+            continue;
+        }
+        AcquisitionSessionState s;
+        s.acquisition_session_id = rec.acquisition_session_id;
+        s.device_instance_id = rec.device_instance_id;
+        s.phase = rec.phase;
+        s.capture_profile.still.version = rec.capture_profile_version;
+        s.capture_profile.still.width = rec.capture_width;
+        s.capture_profile.still.height = rec.capture_height;
+        s.capture_profile.still.format = rec.capture_format;
+        s.capture_profile.still.still_image_bundle = make_still_image_bundle_state(rec.capture_still_image_bundle);
+        s.captures_triggered = rec.captures_triggered;
+        s.captures_completed = rec.captures_completed;
+        s.captures_failed = rec.captures_failed;
+        s.last_capture_id = rec.last_capture_id;
+        s.last_capture_latency_ns = rec.last_capture_latency_ns;
+        s.error_code = rec.error_code;
+        out.push_back(std::move(s));
+    }
+    acquisition_sessions_cache_.records = std::move(out_records);
+    acquisition_sessions_cache_.valid = true;
+    acquisition_sessions_cache_.revision = sessions.revision();
+    return acquisition_sessions_cache_.records;
+}
 
-    // Rigs
-    if (in.rigs) {
-        snap.rigs.reserve(in.rigs->all().size());
-        for (const auto& [rig_id, rec] : in.rigs->all()) {
-            (void)rig_id;
-            RigState r;
-            r.rig_id = rec.rig_id;
-            r.name = rec.name;
-            r.phase = rec.live ? CBLifecyclePhase::LIVE : CBLifecyclePhase::CREATED;
-            r.mode = CBRigMode::OFF;
-            r.member_hardware_ids = rec.member_hardware_ids;
-            r.active_capture_id = rec.active_capture_id;
-            r.capture_profile_version = rec.capture_profile_version;
-            r.capture_width = rec.capture_width;
-            r.capture_height = rec.capture_height;
-            r.capture_format = rec.capture_format;
-            r.captures_triggered = rec.captures_triggered;
-            r.captures_completed = rec.captures_completed;
-            r.captures_failed = rec.captures_failed;
-            r.last_capture_id = rec.last_capture_id;
-            r.last_capture_latency_ns = rec.last_capture_latency_ns;
-            r.last_sync_skew_ns = rec.last_sync_skew_ns;
-            r.error_code = rec.error_code;
-            snap.rigs.push_back(std::move(r));
+const SnapshotBuilder::NativeSectionCache& SnapshotBuilder::native_section_(const Inputs& in,
+                                                                           bool with_records) const {
+    const CoreNativeObjectRegistry& native_objects = *in.native_objects;
+    const bool stale = !native_cache_.valid || native_cache_.revision != native_objects.revision();
+    if (stale && !with_records) {
+        std::set<uint64_t> root_ids;
+        for (const auto& [nid, rec] : native_objects.all()) {
+            (void)nid;
+            if (rec.root_id != 0) {
+                root_ids.insert(rec.root_id);
+            }
         }
+        native_cache_.records.reset();
+        native_cache_.records_valid = false;
+        native_cache_.root_ids.assign(root_ids.begin(), root_ids.end());
+        native_cache_.valid = true;
+        native_cache_.revision = native_objects.revision();
+        native_cache_.detached_valid = false;
+    } else if (stale || !native_cache_.records_valid) {
+        auto out_records = std::make_shared<std::vector<NativeObjectRecord>>();
+        std::vector<NativeObjectRecord>& out = *out_records;
+        out.reserve(native_objects.all().size());
+        std::set<uint64_t> root_ids;
+        for (const auto& [nid, rec] : native_objects.all()) {
+            (void)nid;
+            NativeObjectRecord n;
+            n.native_id = rec.native_id;
+            n.type = rec.type;
+            n.root_id = rec.root_id;
+
+            if (rec.destroyed) {
+                n.phase = CBLifecyclePhase::DESTROYED;
+            } else if (!rec.created) {
+                n.phase = CBLifecyclePhase::CREATED;
+            } else {
+                n.phase = CBLifecyclePhase::LIVE;
+            }
+
+            n.owner_device_instance_id = rec.owner_device_instance_id;
+            n.owner_acquisition_session_id = rec.owner_acquisition_session_id;
+            n.owner_stream_id = rec.owner_stream_id;
+            n.owner_provider_native_id = rec.owner_provider_native_id;
+            n.owner_rig_id = rec.owner_rig_id;
+
+            n.creation_gen = rec.creation_gen;
+
+            n.created_ns = rec.created_ns;
+            n.destroyed_ns = rec.destroyed_ns;
+
+            n.bytes_allocated = rec.bytes_allocated;
+            n.buffers_in_use = rec.buffers_in_use;
+
+            out.push_back(std::move(n));
+            if (rec.root_id != 0) {
+                root_ids.insert(rec.root_id);
+            }
+        }
+        native_cache_.records = std::move(out_records);
+        native_cache_.root_ids.assign(root_ids.begin(), root_ids.end());
+        native_cache_.valid = true;
+        native_cache_.records_valid = true;
+        native_cache_.revision = native_objects.revision();
+        native_cache_.detached_valid = false;
+    }
+    const uint64_t owner_fingerprint = detached_owner_fingerprint(in);
+    if (!native_cache_.detached_valid || native_cache_.detached_owner_fingerprint != owner_fingerprint) {
+        const std::set<uint64_t> detached_roots = compute_detached_roots(in);
+        native_cache_.detached_root_ids =
+            std::make_shared<const std::vector<uint64_t>>(detached_roots.begin(), detached_roots.end());
+        native_cache_.detached_valid = true;
+        native_cache_.detached_owner_fingerprint = owner_fingerprint;
+    }
+    return native_cache_;
+}
+
+SnapshotBuilder::View SnapshotBuilder::capture(const Inputs& in,
+                                               uint64_t gen,
+                                               uint64_t version,
+                                               uint64_t topology_version,
+                                               uint64_t timestamp_ns,
+                                               uint32_t sections) const {
+    View view;
+    view.gen = gen;
+    view.version = version;
+    view.topology_version = topology_version;
+    view.timestamp_ns = timestamp_ns;
+
+    view.imaging_spec_version = in.spec_state ? in.spec_state->imaging_spec_version() : 0;
+    native_records_wanted_ = (sections & kCBSnapshotSectionNativeObjects) != 0;
+
+    // Rigs
+    if (in.rigs && (sections & kCBSnapshotSectionRigs)) {
+        view.rigs = rig_states_(*in.rigs, in.capture_latency);
     }
 
     // Devices
-    if (in.devices) {
-        snap.devices.reserve(in.devices->all().size());
+    if (in.devices && (sections & kCBSnapshotSectionDevices)) {
+        view.devices.reserve(in.devices->all().size());
         for (const auto& [id, rec] : in.devices->all()) {
             DeviceState d;
             d.instance_id = id;
@@ -210,41 +415,22 @@ CamBANGStateSnapshot SnapshotBuilder::build(const Inputs& in,
             }
             d.last_error_code = static_cast<int32_t>(rec.last_error_code);
             d.errors_count = rec.errors_count;
+            if (in.capture_latency) {
+                d.capture_latency = make_capture_latency_state(in.capture_latency->device(id));
+            }
 
-            snap.devices.push_back(std::move(d));
+            view.devices.push_back(std::move(d));
         }
     }
 
     // Acquisition sessions
-    if (in.acquisition_sessions) {
-        snap.acquisition_sessions.reserve(in.acquisition_sessions->all().size());
-        for (const auto& [session_id, rec] : in.acquisition_sessions->all()) {
-            (void)session_id;
-            if (rec.phase == CBLifecyclePhase::DESTROYED) {
-                continue;
-            }
-            AcquisitionSessionState s;
-            s.acquisition_session_id = rec.acquisition_session_id;
-            s.device_instance_id = rec.device_instance_id;
-            s.phase = rec.phase;
-            s.capture_profile.still.version = rec.capture_profile_version;
-            s.capture_profile.still.width = rec.capture_width;
-            s.capture_profile.still.height = rec.capture_height;
-            s.capture_profile.still.format = rec.capture_format;
-            s.capture_profile.still.still_image_bundle = make_still_image_bundle_state(rec.capture_still_image_bundle);
-            s.captures_triggered = rec.captures_triggered;
-            s.captures_completed = rec.captures_completed;
-            s.captures_failed = rec.captures_failed;
-            s.last_capture_id = rec.last_capture_id;
-            s.last_capture_latency_ns = rec.last_capture_latency_ns;
-            s.error_code = rec.error_code;
-            snap.acquisition_sessions.push_back(std::move(s));
-        }
+    if (in.acquisition_sessions && (sections & kCBSnapshotSectionAcquisitionSessions)) {
+        view.acquisition_sessions = acquisition_session_states_(*in.acquisition_sessions);
     }
 
     // Streams
-    if (in.streams) {
-        snap.streams.reserve(in.streams->all().size());
+    if (in.streams && (sections & kCBSnapshotSectionStreams)) {
+        view.streams.reserve(in.streams->all().size());
         for (const auto& [sid, rec] : in.streams->all()) {
             if (!rec.created) {
                 continue;
@@ -293,55 +479,60 @@ CamBANGStateSnapshot SnapshotBuilder::build(const Inputs& in,
             s.visibility_frames_rejected_unsupported = rec.visibility_frames_rejected_unsupported;
             s.visibility_frames_rejected_invalid = rec.visibility_frames_rejected_invalid;
             s.visibility_last_path = to_snapshot_visibility_path(rec.visibility_last_path);
+            s.qos_level = rec.qos_level;
+            s.arrival_pacing = make_frame_pacing_state(rec.arrival_pacing.summary());
+            CoreResultStore::StreamDeliveryStats delivery;
+            if (in.results && in.results->get_stream_delivery_stats(sid, delivery)) {
+                s.delivery_pacing = make_frame_pacing_state(delivery.pacing);
+                s.delivery_latency = make_latency_histogram_state(delivery.latency);
+            }
 
-            snap.streams.push_back(std::move(s));
+            view.streams.push_back(std::move(s));
         }
     }
 
 
 // Native objects (provider-reported lifecycle truth).
-if (in.native_objects) {
-    snap.native_objects.reserve(in.native_objects->all().size());
-    for (const auto& [nid, rec] : in.native_objects->all()) {
-        (void)nid;
-        NativeObjectRecord n;
-        n.native_id = rec.native_id;
-        n.type = rec.type;
-        n.root_id = rec.root_id;
-
-        if (rec.destroyed) {
-            n.phase = CBLifecyclePhase::DESTROYED;
-        } else if (!rec.created) {
-            n.phase = CBLifecyclePhase::CREATED;
-        } else {
-            n.phase = CBLifecyclePhase::LIVE;
-        }
-
-        n.owner_device_instance_id = rec.owner_device_instance_id;
-        n.owner_acquisition_session_id = rec.owner_acquisition_session_id;
-        n.owner_stream_id = rec.owner_stream_id;
-        n.owner_provider_native_id = rec.owner_provider_native_id;
-        n.owner_rig_id = rec.owner_rig_id;
-
-        n.creation_gen = rec.creation_gen;
+if (in.native_objects && (sections & kCBSnapshotSectionNativeObjects)) {
+    const NativeSectionCache& native = native_section_(in, true);
+    view.native_objects = native.records;
+    view.detached_root_ids = native.detached_root_ids;
+}
 
-        n.created_ns = rec.created_ns;
-        n.destroyed_ns = rec.destroyed_ns;
+if (in.scoped_resource_telemetry && (sections & kCBSnapshotSectionScopedResourceTelemetry)) {
+    view.has_scoped_resource_telemetry = true;
+    view.scoped_resource_telemetry = in.scoped_resource_telemetry->snapshot();
+}
 
-        n.bytes_allocated = rec.bytes_allocated;
-        n.buffers_in_use = rec.buffers_in_use;
+return view;
+}
 
-        snap.native_objects.push_back(std::move(n));
+CamBANGStateSnapshot SnapshotBuilder::materialize(View view) {
+    CamBANGStateSnapshot snap;
+    snap.schema_version = CamBANGStateSnapshot::kSchemaVersion;
+    snap.gen = view.gen;
+    snap.version = view.version;
+    snap.topology_version = view.topology_version;
+    snap.timestamp_ns = view.timestamp_ns;
+    snap.imaging_spec_version = view.imaging_spec_version;
+    if (view.rigs) {
+        snap.rigs = *view.rigs;
+    }
+    snap.devices = std::move(view.devices);
+    if (view.acquisition_sessions) {
+        snap.acquisition_sessions = *view.acquisition_sessions;
+    }
+    snap.streams = std::move(view.streams);
+    if (view.native_objects) {
+        snap.native_objects = *view.native_objects;
+    }
+    if (view.detached_root_ids) {
+        snap.detached_root_ids = *view.detached_root_ids;
     }
 
-    const std::set<uint64_t> detached_roots = compute_detached_roots(in);
-    snap.detached_root_ids.assign(detached_roots.begin(), detached_roots.end());
-}
-
-if (in.scoped_resource_telemetry) {
-    const auto entries = in.scoped_resource_telemetry->snapshot();
-    snap.scoped_resource_telemetry.reserve(entries.size());
-    for (const auto& entry : entries) {
+if (view.has_scoped_resource_telemetry) {
+    snap.scoped_resource_telemetry.reserve(view.scoped_resource_telemetry.size());
+    for (const auto& entry : view.scoped_resource_telemetry) {
         ::ScopedResourceTelemetry out;
         out.phase = static_cast<CBLifecyclePhase>(entry.phase == 3 ? 3 : 1);
         out.creation_gen = entry.creation_gen;
@@ -360,6 +551,12 @@ if (in.scoped_resource_telemetry) {
         out.retained_gpu_backing_total_created = entry.retained_gpu_backing_total_created;
         out.retained_gpu_backing_total_released = entry.retained_gpu_backing_total_released;
         out.retained_gpu_backing_peak_current = entry.retained_gpu_backing_peak_current;
+        out.retained_cpu_payload_bytes_current = entry.retained_cpu_payload_bytes_current;
+        out.retained_gpu_backing_bytes_current = entry.retained_gpu_backing_bytes_current;
+        out.display_view_bytes_current = entry.display_view_bytes_current;
+        out.pooled_buffer_bytes_current = entry.pooled_buffer_bytes_current;
+        out.large_page_buffer_bytes_current = entry.large_page_buffer_bytes_current;
+        out.large_page_fallback_bytes_current = entry.large_page_fallback_bytes_current;
         snap.scoped_resource_telemetry.push_back(out);
     }
 }
@@ -367,6 +564,15 @@ if (in.scoped_resource_telemetry) {
 return snap;
 }
 
+CamBANGStateSnapshot SnapshotBuilder::build(const Inputs& in,
+                                            uint64_t gen,
+                                            uint64_t version,
+                                            uint64_t topology_version,
+                                            uint64_t timestamp_ns,
+                                            uint32_t sections) const {
+    return materialize(capture(in, gen, version, topology_version, timestamp_ns, sections));
+}
+
 uint64_t SnapshotBuilder::compute_topology_signature(const Inputs& in) const {
     uint64_t h = kFnvOffset;
     if (in.devices) {
@@ -417,25 +623,16 @@ uint64_t SnapshotBuilder::compute_topology_signature(const Inputs& in) const {
     }
 
     if (in.native_objects) {
-        std::set<uint64_t> root_ids;
-
-        for (const auto& [native_id, rec] : in.native_objects->all()) {
-            (void)native_id;
-            if (rec.root_id == 0) {
-                continue;
-            }
-            root_ids.insert(rec.root_id);
-        }
-
-        const std::set<uint64_t> detached_root_ids = compute_detached_roots(in);
+        // Walks the records too only while builds keep asking for them.
+        const NativeSectionCache& native = native_section_(in, native_records_wanted_);
 
-        fnv1a_u64(h, static_cast<uint64_t>(root_ids.size()));
-        for (uint64_t root_id : root_ids) {
+        fnv1a_u64(h, static_cast<uint64_t>(native.root_ids.size()));
+        for (uint64_t root_id : native.root_ids) {
             fnv1a_u64(h, root_id);
         }
 
-        fnv1a_u64(h, static_cast<uint64_t>(detached_root_ids.size()));
-        for (uint64_t root_id : detached_root_ids) {
+        fnv1a_u64(h, static_cast<uint64_t>(native.detached_root_ids->size()));
+        for (uint64_t root_id : *native.detached_root_ids) {
             fnv1a_u64(h, root_id);
         }
     }
@@ -1,23 +1,46 @@
 #pragma once
 
 #include <cstdint>
+#include <memory>
+#include <vector>
 
+#include "core/resource_aggregate_telemetry.h"
 #include "core/snapshot/state_snapshot.h"
 
 namespace cambang {
 
+class CoreCaptureLatencyStats;
 class CoreDeviceRegistry;
 class CoreAcquisitionSessionRegistry;
+class CoreResultStore;
 class CoreRigRegistry;
 class CoreStreamRegistry;
 class ProviderCallbackIngress;
 class CoreNativeObjectRegistry;
 class CoreSpecState;
-class ResourceAggregateTelemetry;
 
 // Minimal deterministic builder for schema v1 state snapshot.
 // Populates implemented fields from current registries; all others use
 // canonical defaults (0/empty/STOPPED/etc.).
+//
+// Sections sourced from a single revisioned registry (rigs, acquisition
+// sessions, native objects and their detached roots) are cached across
+// builds and reused while the registry revision() is unchanged, so a publish
+// that only moved stream counters does not re-walk every native object.
+// Devices and streams are always rebuilt: they fold in cross-registry and
+// time-derived state. The cache makes a builder single-threaded; CoreRuntime
+// uses its builder on the core thread only.
+//
+// A cached section is an immutable shared vector: a registry change builds a
+// new one and leaves the old one to whoever still holds it. capture() takes
+// a View -- those shared sections by reference, plus the rebuilt devices and
+// streams and the raw telemetry entries -- without copying the cached
+// sections, and materialize() turns a View into the snapshot on any thread.
+// build() is the two run back to back.
+//
+// build() fills only the requested record sections (kCBSnapshotSection*);
+// compute_topology_signature() always covers the full topology. With native
+// objects left out, only their root ids are walked, for the signature.
 class SnapshotBuilder final {
 public:
     struct Inputs {
@@ -30,18 +53,84 @@ public:
         const CoreNativeObjectRegistry* native_objects = nullptr;
         const CoreSpecState* spec_state = nullptr;
         const ResourceAggregateTelemetry* scoped_resource_telemetry = nullptr;
+        const CoreCaptureLatencyStats* capture_latency = nullptr;
+        // Stream delivery pacing (display pickups).
+        const CoreResultStore* results = nullptr;
     };
 
+    // Everything materialize() needs, detached from the registries.
+    struct View {
+        uint64_t gen = 0;
+        uint64_t version = 0;
+        uint64_t topology_version = 0;
+        uint64_t timestamp_ns = 0;
+        uint64_t imaging_spec_version = 0;
+
+        std::shared_ptr<const std::vector<RigState>> rigs;
+        std::vector<DeviceState> devices;
+        std::shared_ptr<const std::vector<AcquisitionSessionState>> acquisition_sessions;
+        std::vector<StreamState> streams;
+        std::shared_ptr<const std::vector<NativeObjectRecord>> native_objects;
+        std::shared_ptr<const std::vector<uint64_t>> detached_root_ids;
+        bool has_scoped_resource_telemetry = false;
+        std::vector<ScopedResourceTelemetryKey> scoped_resource_telemetry;
+    };
+
+    // Core thread (reads the registries and the section caches).
+    View capture(const Inputs& in,
+                 uint64_t gen,
+                 uint64_t version,
+                 uint64_t topology_version,
+                 uint64_t timestamp_ns,
+                 uint32_t sections = kCBSnapshotSectionsAll) const;
+    // Any thread.
+    static CamBANGStateSnapshot materialize(View view);
+
     CamBANGStateSnapshot build(const Inputs& in,
                               uint64_t gen,
                               uint64_t version,
                               uint64_t topology_version,
-                              uint64_t timestamp_ns) const;
+                              uint64_t timestamp_ns,
+                              uint32_t sections = kCBSnapshotSectionsAll) const;
 
     // Topology signature used to decide when topology_version increments.
     // This is deliberately simple in v1 scaffolding: it tracks existence of
     // rigs, device instances, and streams by ID.
     uint64_t compute_topology_signature(const Inputs& in) const;
+
+private:
+    template <typename T>
+    struct SectionCache {
+        bool valid = false;
+        uint64_t revision = 0;
+        std::shared_ptr<const std::vector<T>> records;
+    };
+    struct NativeSectionCache {
+        bool valid = false;
+        uint64_t revision = 0;
+        // False when the last walk collected root ids only.
+        bool records_valid = false;
+        std::shared_ptr<const std::vector<NativeObjectRecord>> records;
+        std::vector<uint64_t> root_ids; // ascending, distinct, non-zero
+        // Detached roots also depend on which devices/streams exist.
+        bool detached_valid = false;
+        uint64_t detached_owner_fingerprint = 0;
+        std::shared_ptr<const std::vector<uint64_t>> detached_root_ids; // ascending
+    };
+
+    const std::shared_ptr<const std::vector<RigState>>& rig_states_(
+        const CoreRigRegistry& rigs, const CoreCaptureLatencyStats* capture_latency) const;
+    const std::shared_ptr<const std::vector<AcquisitionSessionState>>& acquisition_session_states_(
+        const CoreAcquisitionSessionRegistry& sessions) const;
+    const NativeSectionCache& native_section_(const Inputs& in, bool with_records) const;
+
+    mutable SectionCache<RigState> rigs_cache_;
+    // Rigs also fold in their capture latency histograms.
+    mutable uint64_t rigs_cache_latency_revision_ = 0;
+    mutable SectionCache<AcquisitionSessionState> acquisition_sessions_cache_;
+    mutable NativeSectionCache native_cache_;
+    // Whether the last build() asked for native objects.
+    mutable bool native_records_wanted_ = true;
 };
 
 } // namespace cambang
@@ -0,0 +1,150 @@
+#include "core/snapshot/snapshot_delta.h"
+
+#include <utility>
+
+bool CamBANGStateSnapshotDelta::records_unchanged() const noexcept {
+    return rigs_changed.empty() && rigs_removed.empty() &&
+           devices_changed.empty() && devices_removed.empty() &&
+           acquisition_sessions_changed.empty() && acquisition_sessions_removed.empty() &&
+           streams_changed.empty() && streams_removed.empty() &&
+           native_objects_changed.empty() && native_objects_removed.empty() &&
+           !detached_root_ids_changed && !scoped_resource_telemetry_changed;
+}
+
+namespace cambang {
+
+namespace {
+
+// Merge walk over two id-ascending sections.
+template <typename T>
+void diff_section(const std::vector<T>& from,
+                  const std::vector<T>& to,
+                  uint64_t T::*key,
+                  std::vector<T>& changed,
+                  std::vector<uint64_t>& removed) {
+    size_t i = 0;
+    size_t j = 0;
+    while (i < from.size() || j < to.size()) {
+        if (j == to.size() || (i < from.size() && from[i].*key < to[j].*key)) {
+            removed.push_back(from[i].*key);
+            ++i;
+        } else if (i == from.size() || to[j].*key < from[i].*key) {
+            changed.push_back(to[j]);
+            ++j;
+        } else {
+            if (!(from[i] == to[j])) {
+                changed.push_back(to[j]);
+            }
+            ++i;
+            ++j;
+        }
+    }
+}
+
+template <typename T>
+void apply_section(std::vector<T>& base,
+                   const std::vector<T>& changed,
+                   const std::vector<uint64_t>& removed,
+                   uint64_t T::*key) {
+    if (changed.empty() && removed.empty()) {
+        return;
+    }
+    std::vector<T> out;
+    out.reserve(base.size() + changed.size());
+    size_t c = 0;
+    size_t r = 0;
+    for (T& rec : base) {
+        const uint64_t id = rec.*key;
+        while (c < changed.size() && changed[c].*key < id) {
+            out.push_back(changed[c++]);
+        }
+        while (r < removed.size() && removed[r] < id) {
+            ++r;
+        }
+        if (r < removed.size() && removed[r] == id) {
+            continue;
+        }
+        if (c < changed.size() && changed[c].*key == id) {
+            out.push_back(changed[c++]);
+            continue;
+        }
+        out.push_back(std::move(rec));
+    }
+    while (c < changed.size()) {
+        out.push_back(changed[c++]);
+    }
+    base = std::move(out);
+}
+
+} // namespace
+
+CamBANGStateSnapshotDelta compute_snapshot_delta(const CamBANGStateSnapshot& from,
+                                                 const CamBANGStateSnapshot& to) {
+    CamBANGStateSnapshotDelta d;
+    d.from_gen = from.gen;
+    d.from_version = from.version;
+    d.schema_version = to.schema_version;
+    d.gen = to.gen;
+    d.version = to.version;
+    d.topology_version = to.topology_version;
+    d.timestamp_ns = to.timestamp_ns;
+    d.imaging_spec_version = to.imaging_spec_version;
+
+    diff_section(from.rigs, to.rigs, &RigState::rig_id, d.rigs_changed, d.rigs_removed);
+    diff_section(from.devices, to.devices, &DeviceState::instance_id, d.devices_changed, d.devices_removed);
+    diff_section(from.acquisition_sessions,
+                 to.acquisition_sessions,
+                 &AcquisitionSessionState::acquisition_session_id,
+                 d.acquisition_sessions_changed,
+                 d.acquisition_sessions_removed);
+    diff_section(from.streams, to.streams, &StreamState::stream_id, d.streams_changed, d.streams_removed);
+    diff_section(from.native_objects,
+                 to.native_objects,
+                 &NativeObjectRecord::native_id,
+                 d.native_objects_changed,
+                 d.native_objects_removed);
+
+    if (from.detached_root_ids != to.detached_root_ids) {
+        d.detached_root_ids_changed = true;
+        d.detached_root_ids = to.detached_root_ids;
+    }
+    if (from.scoped_resource_telemetry != to.scoped_resource_telemetry) {
+        d.scoped_resource_telemetry_changed = true;
+        d.scoped_resource_telemetry = to.scoped_resource_telemetry;
+    }
+    return d;
+}
+
+bool apply_snapshot_delta(CamBANGStateSnapshot& base, const CamBANGStateSnapshotDelta& delta) {
+    if (base.gen != delta.from_gen || base.version != delta.from_version) {
+        return false;
+    }
+    base.schema_version = delta.schema_version;
+    base.gen = delta.gen;
+    base.version = delta.version;
+    base.topology_version = delta.topology_version;
+    base.timestamp_ns = delta.timestamp_ns;
+    base.imaging_spec_version = delta.imaging_spec_version;
+
+    apply_section(base.rigs, delta.rigs_changed, delta.rigs_removed, &RigState::rig_id);
+    apply_section(base.devices, delta.devices_changed, delta.devices_removed, &DeviceState::instance_id);
+    apply_section(base.acquisition_sessions,
+                  delta.acquisition_sessions_changed,
+                  delta.acquisition_sessions_removed,
+                  &AcquisitionSessionState::acquisition_session_id);
+    apply_section(base.streams, delta.streams_changed, delta.streams_removed, &StreamState::stream_id);
+    apply_section(base.native_objects,
+                  delta.native_objects_changed,
+                  delta.native_objects_removed,
+                  &NativeObjectRecord::native_id);
+
+    if (delta.detached_root_ids_changed) {
+        base.detached_root_ids = delta.detached_root_ids;
+    }
+    if (delta.scoped_resource_telemetry_changed) {
+        base.scoped_resource_telemetry = delta.scoped_resource_telemetry;
+    }
+    return true;
+}
+
+} // namespace cambang
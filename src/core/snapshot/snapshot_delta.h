@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "core/snapshot/state_snapshot.h"
+
+// Incremental form of a CamBANGStateSnapshot relative to an earlier one.
+//
+// Record sections carry only records that were added or changed (full record
+// value) plus the ids of removed records, keyed by each record's id field:
+// rig_id, instance_id, acquisition_session_id, stream_id, native_id. The
+// small unkeyed sections (detached_root_ids, scoped_resource_telemetry) are
+// carried whole when they changed. Header fields are always carried.
+//
+// A delta is only meaningful against the snapshot it was computed from:
+// from_gen/from_version identify that base, and apply_snapshot_delta()
+// refuses any other.
+struct CamBANGStateSnapshotDelta {
+    uint64_t from_gen = 0;
+    uint64_t from_version = 0;
+
+    uint32_t schema_version = CamBANGStateSnapshot::kSchemaVersion;
+    uint64_t gen = 0;
+    uint64_t version = 0;
+    uint64_t topology_version = 0;
+    uint64_t timestamp_ns = 0;
+    uint64_t imaging_spec_version = 0;
+
+    std::vector<RigState> rigs_changed;
+    std::vector<uint64_t> rigs_removed;
+    std::vector<DeviceState> devices_changed;
+    std::vector<uint64_t> devices_removed;
+    std::vector<AcquisitionSessionState> acquisition_sessions_changed;
+    std::vector<uint64_t> acquisition_sessions_removed;
+    std::vector<StreamState> streams_changed;
+    std::vector<uint64_t> streams_removed;
+    std::vector<NativeObjectRecord> native_objects_changed;
+    std::vector<uint64_t> native_objects_removed;
+
+    bool detached_root_ids_changed = false;
+    std::vector<uint64_t> detached_root_ids;
+    bool scoped_resource_telemetry_changed = false;
+    std::vector<ScopedResourceTelemetry> scoped_resource_telemetry;
+
+    // True when no record or unkeyed section changed (header fields aside).
+    bool records_unchanged() const noexcept;
+};
+
+namespace cambang {
+
+// Records in each keyed section of both snapshots must be in ascending id
+// order, as SnapshotBuilder emits them.
+CamBANGStateSnapshotDelta compute_snapshot_delta(const CamBANGStateSnapshot& from,
+                                                 const CamBANGStateSnapshot& to);
+
+// Applies `delta` to `base` in place, preserving ascending id order. Returns
+// false, leaving `base` untouched, if `base` is not the snapshot the delta was
+// computed from (gen/version mismatch).
+bool apply_snapshot_delta(CamBANGStateSnapshot& base, const CamBANGStateSnapshotDelta& delta);
+
+} // namespace cambang
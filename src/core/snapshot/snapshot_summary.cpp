@@ -0,0 +1,118 @@
+#include "core/snapshot/snapshot_summary.h"
+
+namespace cambang {
+
+namespace {
+
+void bump(uint64_t& v, uint64_t amount, int64_t sign) {
+    if (sign > 0) {
+        v += amount;
+    } else {
+        v = v >= amount ? v - amount : 0;
+    }
+}
+
+// Section sizes only need the ids: a changed record adds one when it is new,
+// a removed one subtracts one when it was known.
+template <typename Records, typename IdOf>
+void fold_section(std::unordered_set<uint64_t>& ids,
+                  uint64_t& count,
+                  const Records& changed,
+                  const std::vector<uint64_t>& removed,
+                  IdOf id_of) {
+    for (const auto& r : changed) {
+        if (ids.insert(id_of(r)).second) {
+            ++count;
+        }
+    }
+    for (uint64_t id : removed) {
+        if (ids.erase(id) != 0) {
+            bump(count, 1, -1);
+        }
+    }
+}
+
+} // namespace
+
+void StateSummaryTracker::add_native_(const NativeEntry& e, int64_t sign) {
+    CamBANGStateSummary& s = summary_;
+    const bool current = e.creation_gen == s.gen;
+    bump(s.native_all, 1, sign);
+    bump(s.native_cur, current ? 1 : 0, sign);
+    bump(s.native_prev, current ? 0 : 1, sign);
+    bump(s.native_dead, e.destroyed ? 1 : 0, sign);
+}
+
+void StateSummaryTracker::recount_native_generations_() {
+    CamBANGStateSummary& s = summary_;
+    s.native_cur = 0;
+    s.native_prev = 0;
+    for (const auto& [id, e] : natives_) {
+        (e.creation_gen == s.gen ? s.native_cur : s.native_prev) += 1;
+    }
+}
+
+bool StateSummaryTracker::apply(const CamBANGStateSnapshotDelta& delta) {
+    CamBANGStateSummary& s = summary_;
+    if (delta.from_gen != s.gen || delta.from_version != s.version) {
+        return false;
+    }
+    const bool gen_changed = delta.gen != s.gen;
+    s.gen = delta.gen;
+    s.version = delta.version;
+    s.topology_version = delta.topology_version;
+    s.timestamp_ns = delta.timestamp_ns;
+
+    fold_section(rigs_, s.rigs, delta.rigs_changed, delta.rigs_removed,
+                 [](const RigState& r) { return r.rig_id; });
+    fold_section(devices_, s.devices, delta.devices_changed, delta.devices_removed,
+                 [](const DeviceState& d) { return d.instance_id; });
+    fold_section(sessions_, s.acquisition_sessions, delta.acquisition_sessions_changed,
+                 delta.acquisition_sessions_removed,
+                 [](const AcquisitionSessionState& a) { return a.acquisition_session_id; });
+    fold_section(streams_, s.streams, delta.streams_changed, delta.streams_removed,
+                 [](const StreamState& st) { return st.stream_id; });
+
+    for (const NativeObjectRecord& n : delta.native_objects_changed) {
+        NativeEntry e;
+        e.creation_gen = n.creation_gen;
+        e.destroyed = n.phase == CBLifecyclePhase::DESTROYED;
+        auto [it, added] = natives_.try_emplace(n.native_id, e);
+        if (!added) {
+            add_native_(it->second, -1);
+            it->second = e;
+        }
+        add_native_(e, 1);
+    }
+    for (uint64_t id : delta.native_objects_removed) {
+        if (const auto it = natives_.find(id); it != natives_.end()) {
+            add_native_(it->second, -1);
+            natives_.erase(it);
+        }
+    }
+    if (gen_changed) {
+        recount_native_generations_();
+    }
+
+    if (delta.detached_root_ids_changed) {
+        s.detached_roots = delta.detached_root_ids.size();
+    }
+    return true;
+}
+
+void StateSummaryTracker::reset(const CamBANGStateSnapshot& snap) {
+    clear();
+    static const CamBANGStateSnapshot kEmptySnapshot{};
+    (void)apply(compute_snapshot_delta(kEmptySnapshot, snap));
+}
+
+void StateSummaryTracker::clear() {
+    summary_ = CamBANGStateSummary{};
+    rigs_.clear();
+    devices_.clear();
+    sessions_.clear();
+    streams_.clear();
+    natives_.clear();
+}
+
+} // namespace cambang
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cstdint>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "core/snapshot/snapshot_delta.h"
+#include "core/snapshot/state_snapshot.h"
+
+// Aggregate counters the status panel shows over a snapshot, so it can bind
+// them instead of reducing over every record (see
+// docs/dev/cambangstatuspanel_mappings.md). Maintained by
+// StateSummaryTracker from snapshot deltas.
+struct CamBANGStateSummary {
+    uint64_t gen = 0;
+    uint64_t version = 0;
+    uint64_t topology_version = 0;
+    uint64_t timestamp_ns = 0;
+
+    // Section sizes.
+    uint64_t rigs = 0;
+    uint64_t devices = 0;
+    uint64_t acquisition_sessions = 0;
+    uint64_t streams = 0;
+    uint64_t detached_roots = 0;
+
+    // Native objects: all, created in this gen (cur), retained from an
+    // earlier gen (prev), and DESTROYED.
+    uint64_t native_all = 0;
+    uint64_t native_cur = 0;
+    uint64_t native_prev = 0;
+    uint64_t native_dead = 0;
+
+    bool operator==(const CamBANGStateSummary&) const = default;
+};
+
+namespace cambang {
+
+// Keeps a CamBANGStateSummary current from snapshot deltas. Each native
+// record's contribution is remembered by id, so folding a delta costs its
+// changed and removed records, not the snapshot size.
+//
+// Threading: single owner.
+class StateSummaryTracker final {
+public:
+    // Folds `delta` in. Returns false, leaving the summary untouched, when the
+    // delta was not computed from the state folded last; a cleared tracker
+    // accepts a delta computed from an empty snapshot.
+    bool apply(const CamBANGStateSnapshotDelta& delta);
+    // Rebuilds from a whole snapshot.
+    void reset(const CamBANGStateSnapshot& snap);
+    void clear();
+
+    const CamBANGStateSummary& summary() const noexcept { return summary_; }
+
+private:
+    struct NativeEntry {
+        uint64_t creation_gen = 0;
+        bool destroyed = false;
+    };
+
+    void add_native_(const NativeEntry& e, int64_t sign);
+    void recount_native_generations_();
+
+    CamBANGStateSummary summary_{};
+    std::unordered_set<uint64_t> rigs_;
+    std::unordered_set<uint64_t> devices_;
+    std::unordered_set<uint64_t> sessions_;
+    std::unordered_set<uint64_t> streams_;
+    std::unordered_map<uint64_t, NativeEntry> natives_;
+};
+
+} // namespace cambang
@@ -57,10 +57,41 @@ struct CaptureStillImageMemberState {
     uint32_t image_member_index = 0;
     cambang::CaptureStillImageMemberRole role = cambang::CaptureStillImageMemberRole::DEFAULT_METERED;
     int32_t intended_exposure_compensation_milli_ev = 0;
+
+    bool operator==(const CaptureStillImageMemberState&) const = default;
 };
 
 struct CaptureStillImageBundleState {
     std::vector<CaptureStillImageMemberState> members;
+
+    bool operator==(const CaptureStillImageBundleState&) const = default;
+};
+
+// Summary of a streaming latency histogram (see docs/state_snapshot.md).
+// Percentiles are bucket tops: at most ~3% above the true value.
+struct LatencyHistogramState {
+    uint64_t count = 0;
+    uint64_t min_ns = 0;
+    uint64_t max_ns = 0;
+    uint64_t mean_ns = 0;
+    uint64_t p50_ns = 0;
+    uint64_t p90_ns = 0;
+    uint64_t p99_ns = 0;
+    uint64_t p999_ns = 0;
+
+    bool operator==(const LatencyHistogramState&) const = default;
+};
+
+// Completed still-capture latency by stage, since the runtime started or
+// the histograms were last reset.
+struct CaptureLatencyState {
+    LatencyHistogramState admission{};
+    LatencyHistogramState provider_start{};
+    LatencyHistogramState image_arrival{};
+    LatencyHistogramState finalization{};
+    LatencyHistogramState capture{};
+
+    bool operator==(const CaptureLatencyState&) const = default;
 };
 
 struct RigState {
@@ -86,7 +117,12 @@ struct RigState {
     uint64_t last_capture_latency_ns = 0;
     uint64_t last_sync_skew_ns = 0;
 
+    CaptureLatencyState capture_latency{};
+    LatencyHistogramState sync_skew{};
+
     int32_t error_code = 0;
+
+    bool operator==(const RigState&) const = default;
 };
 
 struct StillCaptureProfileState {
@@ -95,10 +131,14 @@ struct StillCaptureProfileState {
     uint32_t height = 0;
     uint32_t format = 0;
     CaptureStillImageBundleState still_image_bundle{};
+
+    bool operator==(const StillCaptureProfileState&) const = default;
 };
 
 struct CaptureProfileState {
     StillCaptureProfileState still{};
+
+    bool operator==(const CaptureProfileState&) const = default;
 };
 
 enum class CBCameraValueSupport : uint8_t { SUPPORTED=0, UNSUPPORTED=1, UNIMPLEMENTED=2, UNKNOWN=3 };
@@ -112,6 +152,8 @@ struct CameraValueStateString {
     std::string applied;
     CBCameraApplyStatus apply_status = CBCameraApplyStatus::UNKNOWN;
     int32_t apply_error_code = 0;
+
+    bool operator==(const CameraValueStateString&) const = default;
 };
 
 struct CameraValueStateInt32 {
@@ -122,61 +164,85 @@ struct CameraValueStateInt32 {
     int32_t applied = 0;
     CBCameraApplyStatus apply_status = CBCameraApplyStatus::UNKNOWN;
     int32_t apply_error_code = 0;
+
+    bool operator==(const CameraValueStateInt32&) const = default;
 };
 
 struct DeviceCameraExposureState {
     CameraValueStateString ae_mode{};
     CameraValueStateInt32 baseline_exposure_compensation_milli_ev{};
+
+    bool operator==(const DeviceCameraExposureState&) const = default;
 };
 
 struct DeviceCameraFocusState {
     CameraValueStateString af_mode{};
     CameraValueStateInt32 focus_distance_diopters_milli{};
+
+    bool operator==(const DeviceCameraFocusState&) const = default;
 };
 
 struct DeviceCameraWhiteBalanceState {
     CameraValueStateString awb_mode{};
     CameraValueStateInt32 color_temperature_kelvin{};
+
+    bool operator==(const DeviceCameraWhiteBalanceState&) const = default;
 };
 
 struct DeviceCameraStabilizationState {
     CameraValueStateString mode{};
     CameraValueStateInt32 strength_percent{};
+
+    bool operator==(const DeviceCameraStabilizationState&) const = default;
 };
 
 struct DeviceCameraFlashTorchState {
     CameraValueStateString flash_mode{};
     CameraValueStateInt32 torch_level{};
+
+    bool operator==(const DeviceCameraFlashTorchState&) const = default;
 };
 
 struct DeviceCameraZoomCropState {
     CameraValueStateInt32 zoom_ratio_milli{};
     CameraValueStateString crop_preset{};
+
+    bool operator==(const DeviceCameraZoomCropState&) const = default;
 };
 
 struct DeviceCameraProcessingState {
     CameraValueStateString noise_reduction_mode{};
     CameraValueStateInt32 edge_enhancement_level{};
+
+    bool operator==(const DeviceCameraProcessingState&) const = default;
 };
 
 struct DeviceCameraMeteringState {
     CameraValueStateString metering_mode{};
     CameraValueStateString metering_region_preset{};
+
+    bool operator==(const DeviceCameraMeteringState&) const = default;
 };
 
 struct DeviceCameraAntibandingState {
     CameraValueStateString mode{};
     CameraValueStateInt32 mains_frequency_hz{};
+
+    bool operator==(const DeviceCameraAntibandingState&) const = default;
 };
 
 struct DeviceCameraOrientationMirroringState {
     CameraValueStateInt32 rotation_degrees{};
     CameraValueStateString mirror_mode{};
+
+    bool operator==(const DeviceCameraOrientationMirroringState&) const = default;
 };
 
 struct DeviceCameraPrivacyHardwareBlockState {
     CameraValueStateString privacy_mode{};
     CameraValueStateString hardware_block_reason{};
+
+    bool operator==(const DeviceCameraPrivacyHardwareBlockState&) const = default;
 };
 
 struct DeviceCameraState {
@@ -192,6 +258,8 @@ struct DeviceCameraState {
     DeviceCameraAntibandingState antibanding{};
     DeviceCameraOrientationMirroringState orientation_mirroring{};
     DeviceCameraPrivacyHardwareBlockState privacy_hardware_block{};
+
+    bool operator==(const DeviceCameraState&) const = default;
 };
 
 struct DeviceState {
@@ -214,6 +282,10 @@ struct DeviceState {
     uint64_t rebuild_count = 0;
     uint64_t errors_count = 0;
     int32_t last_error_code = 0;
+
+    CaptureLatencyState capture_latency{};
+
+    bool operator==(const DeviceState&) const = default;
 };
 
 // Provisional tranche-1 contract shape for acquisition-session truth.
@@ -235,6 +307,21 @@ struct AcquisitionSessionState {
     uint64_t last_capture_latency_ns = 0;
 
     int32_t error_code = 0;
+
+    bool operator==(const AcquisitionSessionState&) const = default;
+};
+
+// Inter-frame interval statistics of one side of a stream (see
+// docs/state_snapshot.md). Interval percentiles are histogram bucket tops.
+struct FramePacingState {
+    uint64_t intervals = 0;
+    uint32_t mean_fps_milli = 0;
+    uint64_t interval_p50_ns = 0;
+    uint64_t interval_p99_ns = 0;
+    uint64_t jitter_ns = 0;
+    uint64_t gaps = 0;
+
+    bool operator==(const FramePacingState&) const = default;
 };
 
 struct StreamState {
@@ -266,6 +353,18 @@ struct StreamState {
     uint64_t visibility_frames_rejected_unsupported = 0;
     uint64_t visibility_frames_rejected_invalid = 0;
     CBVisibilityLastPath visibility_last_path = CBVisibilityLastPath::NONE;
+
+    // Stream QoS level the profile above is lowered to (0 = the stream's own
+    // profile; see CoreRuntime::set_stream_qos_enabled()).
+    uint8_t qos_level = 0;
+
+    // Frames from the provider, and results taken up by the display.
+    FramePacingState arrival_pacing{};
+    FramePacingState delivery_pacing{};
+    // Retain to display pickup.
+    LatencyHistogramState delivery_latency{};
+
+    bool operator==(const StreamState&) const = default;
 };
 
 struct NativeObjectRecord {
@@ -290,6 +389,8 @@ struct NativeObjectRecord {
 
     uint64_t bytes_allocated = 0;
     uint32_t buffers_in_use = 0;
+
+    bool operator==(const NativeObjectRecord&) const = default;
 };
 
 struct ScopedResourceTelemetry {
@@ -307,11 +408,20 @@ struct ScopedResourceTelemetry {
     uint64_t retained_gpu_backing_total_released = 0;
     uint64_t retained_gpu_backing_peak_current = 0;
 
+    uint64_t retained_cpu_payload_bytes_current = 0;
+    uint64_t retained_gpu_backing_bytes_current = 0; // estimated
+    uint64_t display_view_bytes_current = 0;
+    uint64_t pooled_buffer_bytes_current = 0;
+    uint64_t large_page_buffer_bytes_current = 0;
+    uint64_t large_page_fallback_bytes_current = 0;
+
     uint32_t telemetry_scope = 4; // UNKNOWN
     uint64_t provider_native_id = 0;
     uint64_t device_instance_id = 0;
     uint64_t acquisition_session_id = 0;
     uint64_t stream_id = 0;
+
+    bool operator==(const ScopedResourceTelemetry&) const = default;
 };
 
 struct CamBANGStateSnapshot {
@@ -333,4 +443,20 @@ struct CamBANGStateSnapshot {
     std::vector<NativeObjectRecord> native_objects;
     std::vector<uint64_t> detached_root_ids;
     std::vector<ScopedResourceTelemetry> scoped_resource_telemetry;
+
+    bool operator==(const CamBANGStateSnapshot&) const = default;
 };
+
+// Record sections a snapshot consumer can ask Core to build (bitmask; see
+// IStateSnapshotPublisher::wanted_snapshot_sections()). The header fields are
+// always filled and topology_version always tracks the full topology; a
+// section that was not asked for is published empty.
+constexpr uint32_t kCBSnapshotSectionRigs = 1u << 0;
+constexpr uint32_t kCBSnapshotSectionDevices = 1u << 1;
+constexpr uint32_t kCBSnapshotSectionAcquisitionSessions = 1u << 2;
+constexpr uint32_t kCBSnapshotSectionStreams = 1u << 3;
+// native_objects and detached_root_ids.
+constexpr uint32_t kCBSnapshotSectionNativeObjects = 1u << 4;
+constexpr uint32_t kCBSnapshotSectionScopedResourceTelemetry = 1u << 5;
+constexpr uint32_t kCBSnapshotSectionCount = 6;
+constexpr uint32_t kCBSnapshotSectionsAll = (1u << kCBSnapshotSectionCount) - 1;
@@ -1,8 +1,10 @@
 #pragma once
 
+#include <array>
+#include <atomic>
 #include <cstdint>
 #include <memory>
-#include <mutex>
+#include <utility>
 
 #include "core/i_state_snapshot_publisher.h"
 
@@ -13,25 +15,106 @@
 //
 // This is suitable for smoke and for Godot-side bridging (where Godot thread
 // polls and emits signals).
+//
+// No mutex: the pointer is swapped atomically and publish_seq() advances after
+// each store, so a poller can compare publish_seq() against the value it last
+// saw and skip snapshot_copy() (and its refcount traffic) when nothing changed.
+// A snapshot_copy() taken after reading publish_seq() is at least as new as
+// the store that produced that seq.
+//
+// Readers that only look at some record sections register them with
+// add_section_interest(); Core then builds just the union of the registered
+// sections. Until any reader registers, every section is built.
 
 class StateSnapshotBuffer final : public IStateSnapshotPublisher {
 public:
-    void publish(std::shared_ptr<const CamBANGStateSnapshot> snapshot) override {
-        std::lock_guard<std::mutex> lock(mu_);
-        latest_ = std::move(snapshot);
+    using Shared = std::shared_ptr<const CamBANGStateSnapshot>;
+
+    void publish(Shared snapshot) override {
+        store(std::move(snapshot));
+    }
+
+    Shared snapshot_copy() const {
+        return load();
     }
 
-    std::shared_ptr<const CamBANGStateSnapshot> snapshot_copy() const {
-        std::lock_guard<std::mutex> lock(mu_);
-        return latest_;
+    // Bumped by every publish() and clear().
+    uint64_t publish_seq() const noexcept {
+        return seq_.load(std::memory_order_acquire);
     }
 
     void clear() {
-        std::lock_guard<std::mutex> lock(mu_);
-        latest_.reset();
+        store(nullptr);
+    }
+
+    // Reference-counted per section, from any thread; takes effect from the
+    // next build.
+    void add_section_interest(uint32_t sections) noexcept {
+        for (uint32_t i = 0; i < kCBSnapshotSectionCount; ++i) {
+            if (sections & (1u << i)) {
+                section_interest_[i].fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+        interest_registered_.store(true, std::memory_order_release);
+    }
+
+    void remove_section_interest(uint32_t sections) noexcept {
+        for (uint32_t i = 0; i < kCBSnapshotSectionCount; ++i) {
+            if (!(sections & (1u << i))) {
+                continue;
+            }
+            // Decrement only while non-zero, so an unbalanced remove racing
+            // another cannot wrap the count.
+            uint32_t count = section_interest_[i].load(std::memory_order_relaxed);
+            while (count != 0 &&
+                   !section_interest_[i].compare_exchange_weak(count, count - 1, std::memory_order_relaxed)) {
+            }
+        }
+    }
+
+    uint32_t wanted_snapshot_sections() const noexcept override {
+        if (!interest_registered_.load(std::memory_order_acquire)) {
+            return kCBSnapshotSectionsAll;
+        }
+        uint32_t sections = 0;
+        for (uint32_t i = 0; i < kCBSnapshotSectionCount; ++i) {
+            if (section_interest_[i].load(std::memory_order_relaxed) != 0) {
+                sections |= 1u << i;
+            }
+        }
+        return sections;
     }
 
 private:
-    mutable std::mutex mu_;
-    std::shared_ptr<const CamBANGStateSnapshot> latest_;
+    void store(Shared next) {
+        // The replaced snapshot is released here, on the writer's thread.
+        Shared prev = exchange(std::move(next));
+        seq_.fetch_add(1, std::memory_order_release);
+    }
+
+#if defined(__cpp_lib_atomic_shared_ptr)
+    Shared load() const noexcept { return latest_.load(std::memory_order_acquire); }
+    Shared exchange(Shared next) noexcept { return latest_.exchange(std::move(next), std::memory_order_acq_rel); }
+
+    std::atomic<Shared> latest_{};
+#else
+    // Pre-P0718 standard libraries: see LatestResultSlotTable::Slot.
+#if defined(__clang__) || defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wdeprecated-declarations"
+#endif
+    Shared load() const noexcept { return std::atomic_load_explicit(&latest_, std::memory_order_acquire); }
+    Shared exchange(Shared next) noexcept {
+        return std::atomic_exchange_explicit(&latest_, std::move(next), std::memory_order_acq_rel);
+    }
+#if defined(__clang__) || defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+
+    Shared latest_{};
+#endif
+
+    std::atomic<uint64_t> seq_{0};
+    std::array<std::atomic<uint32_t>, kCBSnapshotSectionCount> section_interest_{};
+    std::atomic<bool> interest_registered_{false};
 };
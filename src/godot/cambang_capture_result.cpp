@@ -1,11 +1,16 @@
 #include "godot/cambang_capture_result.h"
 
+#include "core/core_capture_fusion.h"
+#include "core/core_capture_thumbnails.h"
+#include "core/core_encoded_image.h"
 #include "godot/cambang_server.h"
 #include "godot/cambang_result_convert.h"
 #include "godot/godot_gpu_display_service.h"
 #include "godot/result_access_cost_evidence.h"
 
+#include <algorithm>
 #include <chrono>
+#include <cstring>
 #include <type_traits>
 #include <variant>
 
@@ -20,8 +25,7 @@ uint64_t result_access_now_ns() {
 }
 
 bool capture_member_has_cpu_payload(const CoreCaptureResultData::ImageMemberData& member) {
-  return !member.payload.empty() && member.payload.width != 0 && member.payload.height != 0 &&
-         (member.payload.format_fourcc == FOURCC_RGBA || member.payload.format_fourcc == FOURCC_BGRA);
+  return has_valid_retained_cpu_payload_layout(member.payload);
 }
 
 const char* capture_to_image_evidence_route(const CoreCaptureResultData::ImageMemberData* member) {
@@ -242,6 +246,33 @@ godot::Dictionary to_dict(const SourcedFact<FocalLengthMm>& fact) {
   return out;
 }
 
+const char* color_filter_arrangement_name(ColorFilterArrangement value) {
+  switch (value) {
+    case ColorFilterArrangement::RGGB: return "rggb";
+    case ColorFilterArrangement::GRBG: return "grbg";
+    case ColorFilterArrangement::GBRG: return "gbrg";
+    case ColorFilterArrangement::BGGR: return "bggr";
+    case ColorFilterArrangement::RGB: return "rgb";
+    case ColorFilterArrangement::MONO: return "mono";
+    case ColorFilterArrangement::NIR: return "nir";
+    case ColorFilterArrangement::UNKNOWN: return "unknown";
+  }
+  return "unknown";
+}
+
+godot::Dictionary to_dict(const SourcedFact<RawSensorLayout>& fact) {
+  godot::Dictionary out;
+  out["origin"] = godot::String(fact_origin_name(fact.origin));
+  out["color_filter"] = godot::String(color_filter_arrangement_name(fact.value.color_filter()));
+  godot::Array black_levels;
+  for (uint32_t black : fact.value.black_levels()) {
+    black_levels.push_back(static_cast<int64_t>(black));
+  }
+  out["black_levels"] = black_levels;
+  out["white_level"] = static_cast<int64_t>(fact.value.white_level());
+  return out;
+}
+
 godot::Dictionary to_dict(const SourcedFact<RealizedImageTransform>& fact) {
   godot::Dictionary out;
   out["origin"] = godot::String(fact_origin_name(fact.origin));
@@ -253,27 +284,30 @@ godot::Dictionary to_dict(const SourcedFact<RealizedImageTransform>& fact) {
 
 godot::Dictionary camera_facts_to_dict(const CoreResolvedCaptureImageFacts& facts) {
   godot::Dictionary out;
-  if (facts.camera.facing) {
+  static const CameraStaticFacts kNoCameraFacts{};
+  const CameraStaticFacts& camera = facts.camera ? *facts.camera : kNoCameraFacts;
+  if (camera.facing) {
     godot::Dictionary value;
-    value["value"] = godot::String(camera_facing_name(facts.camera.facing->value));
-    value["origin"] = godot::String(fact_origin_name(facts.camera.facing->origin));
+    value["value"] = godot::String(camera_facing_name(camera.facing->value));
+    value["origin"] = godot::String(fact_origin_name(camera.facing->origin));
     out["facing"] = value;
   }
-  if (facts.camera.nature) {
+  if (camera.nature) {
     godot::Dictionary value;
-    value["value"] = godot::String(camera_nature_name(facts.camera.nature->value));
-    value["origin"] = godot::String(fact_origin_name(facts.camera.nature->origin));
+    value["value"] = godot::String(camera_nature_name(camera.nature->value));
+    value["origin"] = godot::String(fact_origin_name(camera.nature->origin));
     out["camera_nature"] = value;
   }
-  if (facts.camera.sensor_orientation) {
+  if (camera.sensor_orientation) {
     godot::Dictionary value;
-    value["value"] = static_cast<int64_t>(facts.camera.sensor_orientation->value);
-    value["origin"] = godot::String(fact_origin_name(facts.camera.sensor_orientation->origin));
+    value["value"] = static_cast<int64_t>(camera.sensor_orientation->value);
+    value["origin"] = godot::String(fact_origin_name(camera.sensor_orientation->origin));
     out["sensor_orientation_degrees"] = value;
   }
-  if (facts.camera.intrinsics) out["intrinsics"] = to_dict(*facts.camera.intrinsics);
-  if (facts.camera.distortion) out["distortion"] = to_dict(*facts.camera.distortion);
-  if (facts.camera.pose) out["pose"] = to_dict(*facts.camera.pose);
+  if (camera.intrinsics) out["intrinsics"] = to_dict(*camera.intrinsics);
+  if (camera.distortion) out["distortion"] = to_dict(*camera.distortion);
+  if (camera.pose) out["pose"] = to_dict(*camera.pose);
+  if (camera.raw_sensor_layout) out["raw_sensor_layout"] = to_dict(*camera.raw_sensor_layout);
   add_acquisition_timing_camera_fact(out, facts.image.acquisition_timing);
   if (facts.image.focus_state) out["focus_state"] = to_dict(*facts.image.focus_state);
   if (facts.image.exposure_time) out["exposure_time"] = to_dict(*facts.image.exposure_time);
@@ -310,23 +344,40 @@ bool CamBANGCaptureResult::has_geolocation() const {
   return data_ && data_->has_admission_context && data_->admission_context.geolocation.has_value();
 }
 godot::Dictionary CamBANGCaptureResult::get_geolocation() const {
-  if (!has_geolocation()) return godot::Dictionary();
-  const CaptureGeolocation& location = *data_->admission_context.geolocation;
-  godot::Dictionary out;
-  out["latitude_degrees"] = location.latitude_degrees();
-  out["longitude_degrees"] = location.longitude_degrees();
-  if (location.altitude_meters()) out["altitude_meters"] = *location.altitude_meters();
-  return out;
+  if (!geolocation_built_) {
+    geolocation_ = godot::Dictionary();
+    if (has_geolocation()) {
+      const CaptureGeolocation& location = *data_->admission_context.geolocation;
+      geolocation_["latitude_degrees"] = location.latitude_degrees();
+      geolocation_["longitude_degrees"] = location.longitude_degrees();
+      if (location.altitude_meters()) geolocation_["altitude_meters"] = *location.altitude_meters();
+    }
+    geolocation_.make_read_only();
+    geolocation_built_ = true;
+  }
+  return geolocation_;
 }
 
 bool CamBANGCaptureResult::has_image_properties() const { return data_ && data_->facts.has_image_properties; }
 
 godot::Dictionary CamBANGCaptureResult::get_image_properties() const {
-  return has_image_properties() ? to_dict(data_->facts.image_properties) : godot::Dictionary();
+  if (!image_properties_built_) {
+    image_properties_ = has_image_properties() ? to_dict(data_->facts.image_properties) : godot::Dictionary();
+    image_properties_.make_read_only();
+    image_properties_built_ = true;
+  }
+  return image_properties_;
 }
 
 godot::Dictionary CamBANGCaptureResult::get_image_properties_provenance() const {
-  return has_image_properties() ? to_dict(data_->facts.image_properties_provenance) : godot::Dictionary();
+  if (!image_properties_provenance_built_) {
+    image_properties_provenance_ = has_image_properties()
+        ? to_dict(data_->facts.image_properties_provenance)
+        : godot::Dictionary();
+    image_properties_provenance_.make_read_only();
+    image_properties_provenance_built_ = true;
+  }
+  return image_properties_provenance_;
 }
 
 int CamBANGCaptureResult::can_get_display_view() const {
@@ -397,7 +448,11 @@ int CamBANGCaptureResult::can_to_image_member(int image_member_index) const {
       CoreResultAccessOperation::TO_IMAGE));
 }
 
-godot::Ref<godot::Image> perform_capture_to_image_member_access(const SharedCaptureResultData& data, int image_member_index) {
+godot::Ref<godot::Image> perform_capture_to_image_member_access(
+    const SharedCaptureResultData& data,
+    int image_member_index,
+    bool reuse_converted_image,
+    godot::Image::Format format = godot::Image::FORMAT_RGBA8) {
   if (!data || image_member_index < 0) {
     const uint64_t begin_ns = result_access_now_ns();
     godot::Ref<godot::Image> image;
@@ -431,12 +486,14 @@ godot::Ref<godot::Image> perform_capture_to_image_member_access(const SharedCapt
   const uint64_t begin_ns = result_access_now_ns();
   godot::Ref<godot::Image> image;
   if (capture_member_has_cpu_payload(*member)) {
-    image = payload_to_image(member->payload);
+    image = payload_to_image(member->payload, reuse_converted_image ? member->retained_frame_id : 0, format);
   } else if (member->payload_kind == ResultPayloadKind::GPU_SURFACE &&
              member->retained_gpu_backing) {
-    image = godot_gpu_display_materialize_to_image(
+    image = gpu_backing_to_image(
         member->retained_gpu_backing_descriptor,
-        member->retained_gpu_backing);
+        member->retained_gpu_backing,
+        reuse_converted_image ? member->retained_frame_id : 0,
+        format);
   }
   result_access_cost_evidence::record_capture_member_access(
       evidence_route,
@@ -531,9 +588,10 @@ godot::Ref<godot::Image> perform_capture_to_image_member_gpu_materializer_access
   return image;
 }
 
-godot::Ref<godot::Image> CamBANGCaptureResult::to_image_member(int image_member_index) const {
+godot::Ref<godot::Image> CamBANGCaptureResult::to_image_member(int image_member_index,
+                                                               godot::Image::Format format) const {
   godot::Ref<godot::Image> image =
-      perform_capture_to_image_member_access(data_, image_member_index);
+      perform_capture_to_image_member_access(data_, image_member_index, /*reuse_converted_image=*/true, format);
   if (server_ && data_ && image_member_index >= 0) {
     server_->report_capture_result_member_observation(
         data_, static_cast<uint32_t>(image_member_index));
@@ -544,7 +602,9 @@ godot::Ref<godot::Image> CamBANGCaptureResult::to_image_member(int image_member_
 godot::Ref<godot::Image> CamBANGCaptureResult::calibrate_to_image_member_for_retained_access(
     const SharedCaptureResultData& data,
     uint32_t image_member_index) {
-  return perform_capture_to_image_member_access(data, static_cast<int>(image_member_index));
+  // Calibration measures the real conversion, never a cache hit.
+  return perform_capture_to_image_member_access(
+      data, static_cast<int>(image_member_index), /*reuse_converted_image=*/false);
 }
 
 godot::Ref<godot::Image> CamBANGCaptureResult::calibrate_to_image_member_cpu_payload_for_retained_access(
@@ -573,12 +633,86 @@ godot::Variant CamBANGCaptureResult::get_display_view() const {
   return to_image();
 }
 
-godot::Ref<godot::Image> CamBANGCaptureResult::to_image() const {
-  return to_image_member(0);
+godot::Ref<godot::Image> CamBANGCaptureResult::to_image(godot::Image::Format format) const {
+  return to_image_member(0, format);
+}
+
+godot::Ref<godot::Image> CamBANGCaptureResult::get_thumbnail_member(int image_member_index, int size) const {
+  if (!data_ || image_member_index < 0) {
+    return godot::Ref<godot::Image>();
+  }
+  const auto* member = data_->image_member_at(static_cast<uint32_t>(image_member_index));
+  if (!member) {
+    return godot::Ref<godot::Image>();
+  }
+  const std::shared_ptr<const CoreCaptureThumbnails> thumbnails = obtain_capture_member_thumbnails(*member);
+  const CoreDerivedPayload* level =
+      thumbnails ? thumbnails->level_for(static_cast<uint32_t>(std::max(size, 1))) : nullptr;
+  if (!level) {
+    return godot::Ref<godot::Image>();
+  }
+  godot::PackedByteArray bytes;
+  bytes.resize(static_cast<int64_t>(level->bytes.size()));
+  std::memcpy(bytes.ptrw(), level->bytes.data(), level->bytes.size());
+  return godot::Image::create_from_data(
+      static_cast<int>(level->width), static_cast<int>(level->height), false, godot::Image::FORMAT_RGBA8, bytes);
+}
+
+godot::Ref<godot::Image> CamBANGCaptureResult::get_thumbnail(int size) const {
+  return get_thumbnail_member(0, size);
+}
+
+godot::Ref<godot::Image> CamBANGCaptureResult::get_fused_image() const {
+  if (!data_) {
+    return godot::Ref<godot::Image>();
+  }
+  const std::shared_ptr<const CoreDerivedPayload> fused = obtain_capture_exposure_fusion(*data_);
+  if (!fused) {
+    return godot::Ref<godot::Image>();
+  }
+  godot::PackedByteArray bytes;
+  bytes.resize(static_cast<int64_t>(fused->bytes.size()));
+  std::memcpy(bytes.ptrw(), fused->bytes.data(), fused->bytes.size());
+  return godot::Image::create_from_data(
+      static_cast<int>(fused->width), static_cast<int>(fused->height), false, godot::Image::FORMAT_RGBA8, bytes);
+}
+
+bool CamBANGCaptureResult::is_fused_image_ready() const {
+  return data_ && capture_exposure_fusion_done(*data_);
 }
 
 godot::PackedByteArray CamBANGCaptureResult::get_encoded_bytes() const {
-  return godot::PackedByteArray();
+  godot::PackedByteArray out;
+  if (!data_) {
+    return out;
+  }
+  const std::shared_ptr<const std::vector<uint8_t>> bytes =
+      obtain_capture_member_encoded_bytes(data_->default_image);
+  if (!bytes || bytes->empty()) {
+    return out;
+  }
+  out.resize(static_cast<int64_t>(bytes->size()));
+  std::memcpy(out.ptrw(), bytes->data(), bytes->size());
+  return out;
+}
+
+godot::PackedByteArray CamBANGCaptureResult::get_raw_bytes_member(int image_member_index) const {
+  godot::PackedByteArray out;
+  if (!data_ || image_member_index < 0) {
+    return out;
+  }
+  const auto* member = data_->image_member_at(static_cast<uint32_t>(image_member_index));
+  if (!member || !has_valid_retained_raw_payload_layout(member->payload)) {
+    return out;
+  }
+  const size_t size = static_cast<size_t>(member->payload.stride_bytes) * member->payload.height;
+  out.resize(static_cast<int64_t>(size));
+  std::memcpy(out.ptrw(), member->payload.data(), size);
+  return out;
+}
+
+godot::PackedByteArray CamBANGCaptureResult::get_raw_bytes() const {
+  return get_raw_bytes_member(0);
 }
 
 void CamBANGCaptureResult::_bind_methods() {
@@ -604,12 +738,22 @@ void CamBANGCaptureResult::_bind_methods() {
   godot::ClassDB::bind_method(godot::D_METHOD("has_additional_images"), &CamBANGCaptureResult::has_additional_images);
   godot::ClassDB::bind_method(godot::D_METHOD("get_image_member", "image_member_index"), &CamBANGCaptureResult::get_image_member);
   godot::ClassDB::bind_method(godot::D_METHOD("can_to_image_member", "image_member_index"), &CamBANGCaptureResult::can_to_image_member);
-  godot::ClassDB::bind_method(godot::D_METHOD("to_image_member", "image_member_index"), &CamBANGCaptureResult::to_image_member);
+  godot::ClassDB::bind_method(godot::D_METHOD("to_image_member", "image_member_index", "format"),
+                              &CamBANGCaptureResult::to_image_member, DEFVAL(godot::Image::FORMAT_RGBA8));
   godot::ClassDB::bind_method(godot::D_METHOD("can_get_encoded_bytes"), &CamBANGCaptureResult::can_get_encoded_bytes);
+  godot::ClassDB::bind_method(godot::D_METHOD("get_thumbnail_member", "image_member_index", "size"),
+                              &CamBANGCaptureResult::get_thumbnail_member, DEFVAL(256));
+  godot::ClassDB::bind_method(godot::D_METHOD("get_raw_bytes_member", "image_member_index"),
+                              &CamBANGCaptureResult::get_raw_bytes_member);
 
   godot::ClassDB::bind_method(godot::D_METHOD("get_display_view"), &CamBANGCaptureResult::get_display_view);
-  godot::ClassDB::bind_method(godot::D_METHOD("to_image"), &CamBANGCaptureResult::to_image);
+  godot::ClassDB::bind_method(godot::D_METHOD("to_image", "format"), &CamBANGCaptureResult::to_image,
+                              DEFVAL(godot::Image::FORMAT_RGBA8));
+  godot::ClassDB::bind_method(godot::D_METHOD("get_thumbnail", "size"), &CamBANGCaptureResult::get_thumbnail, DEFVAL(256));
   godot::ClassDB::bind_method(godot::D_METHOD("get_encoded_bytes"), &CamBANGCaptureResult::get_encoded_bytes);
+  godot::ClassDB::bind_method(godot::D_METHOD("get_raw_bytes"), &CamBANGCaptureResult::get_raw_bytes);
+  godot::ClassDB::bind_method(godot::D_METHOD("get_fused_image"), &CamBANGCaptureResult::get_fused_image);
+  godot::ClassDB::bind_method(godot::D_METHOD("is_fused_image_ready"), &CamBANGCaptureResult::is_fused_image_ready);
 
   BIND_CONSTANT(CAPABILITY_READY);
   BIND_CONSTANT(CAPABILITY_CHEAP);
@@ -26,7 +26,12 @@ public:
 
   CamBANGCaptureResult() = default;
 
-  void set_data(SharedCaptureResultData data) { data_ = std::move(data); }
+  void set_data(SharedCaptureResultData data) {
+    data_ = std::move(data);
+    geolocation_built_ = false;
+    image_properties_built_ = false;
+    image_properties_provenance_built_ = false;
+  }
   void set_server(CamBANGServer* server) { server_ = server; }
 
   uint32_t get_width() const;
@@ -51,12 +56,35 @@ public:
   bool has_additional_images() const;
   godot::Dictionary get_image_member(int image_member_index) const;
   int can_to_image_member(int image_member_index) const;
-  godot::Ref<godot::Image> to_image_member(int image_member_index) const;
+  // format as for CamBANGStreamResult::to_image().
+  godot::Ref<godot::Image> to_image_member(int image_member_index,
+                                           godot::Image::Format format = godot::Image::FORMAT_RGBA8) const;
   int can_get_encoded_bytes() const;
+  // An RGBA8 thumbnail of the member from its pyramid (see
+  // core_capture_thumbnails.h): the smallest level at least size pixels on
+  // its longest side, else the largest. Built in the background once the
+  // capture completes; a call that gets there first builds it. Null when the
+  // member has no CPU payload.
+  godot::Ref<godot::Image> get_thumbnail_member(int image_member_index, int size = 256) const;
+  // The member's RAW sensor samples (format PIXEL_FORMAT_RAW16 or
+  // PIXEL_FORMAT_RAW10) exactly as delivered, rows
+  // get_image_properties()["row_stride_bytes"] apart. Empty for any other
+  // format; RAW members have no to_image(), thumbnail or encoded form.
+  godot::PackedByteArray get_raw_bytes_member(int image_member_index) const;
 
   godot::Variant get_display_view() const;
-  godot::Ref<godot::Image> to_image() const;
+  godot::Ref<godot::Image> to_image(godot::Image::Format format = godot::Image::FORMAT_RGBA8) const;
+  godot::Ref<godot::Image> get_thumbnail(int size = 256) const;
   godot::PackedByteArray get_encoded_bytes() const;
+  godot::PackedByteArray get_raw_bytes() const;
+  // An RGBA8 exposure fusion of a bracketed capture's members (see
+  // core_capture_fusion.h), at their size. Built in the background once the
+  // capture completes; a call that gets there first builds it, which takes
+  // a full pass over every member. Null when the capture has no bracket
+  // members or they cannot be fused.
+  godot::Ref<godot::Image> get_fused_image() const;
+  // True once get_fused_image() will not wait for the fusion.
+  bool is_fused_image_ready() const;
 
   static godot::Ref<godot::Image> calibrate_to_image_member_for_retained_access(
       const SharedCaptureResultData& data,
@@ -73,6 +101,15 @@ public:
 private:
   SharedCaptureResultData data_;
   CamBANGServer* server_ = nullptr;
+
+  // Fact Dictionaries built from data_ on first access and returned
+  // read-only after that; data_ does not change once set.
+  mutable godot::Dictionary geolocation_;
+  mutable godot::Dictionary image_properties_;
+  mutable godot::Dictionary image_properties_provenance_;
+  mutable bool geolocation_built_ = false;
+  mutable bool image_properties_built_ = false;
+  mutable bool image_properties_provenance_built_ = false;
 };
 
 } // namespace cambang
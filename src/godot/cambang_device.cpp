@@ -1,6 +1,7 @@
 #include "godot/cambang_device.h"
 
 #include "godot/cambang_capture_result.h"
+#include "godot/cambang_operation.h"
 #include "godot/cambang_server.h"
 #include "godot/cambang_stream.h"
 
@@ -132,6 +133,16 @@ godot::Error CamBANGDevice::engage() {
   return server_->engage_endpoint_handle(hardware_id_, display_name_);
 }
 
+godot::Ref<CamBANGOperation> CamBANGDevice::engage_async() {
+  if (!server_) {
+    return godot::Ref<CamBANGOperation>();
+  }
+  if (hardware_id_.is_empty()) {
+    return server_->_track_operation_(CoreOperation(), godot::ERR_UNAVAILABLE);
+  }
+  return server_->engage_endpoint_handle_async(hardware_id_, display_name_);
+}
+
 godot::Error CamBANGDevice::disengage() {
   if (!server_) {
     return godot::ERR_UNAVAILABLE;
@@ -175,6 +186,22 @@ godot::Error CamBANGDevice::trigger_capture() {
   return godot::OK;
 }
 
+godot::Ref<CamBANGOperation> CamBANGDevice::trigger_capture_async() {
+  if (!server_) {
+    return godot::Ref<CamBANGOperation>();
+  }
+  const uint64_t device_instance_id = get_instance_id();
+  if (device_instance_id == 0 || !server_->is_running()) {
+    return server_->_track_operation_(CoreOperation(), godot::ERR_UNAVAILABLE);
+  }
+  uint64_t capture_id = 0;
+  godot::Ref<CamBANGOperation> op = server_->trigger_device_capture_async(device_instance_id, capture_id);
+  if (capture_id != 0) {
+    current_capture_id_ = capture_id;
+  }
+  return op;
+}
+
 
 godot::Ref<CamBANGCaptureResult> CamBANGDevice::get_result() const {
   const uint64_t device_instance_id = get_instance_id();
@@ -296,12 +323,14 @@ void CamBANGDevice::_bind_methods() {
   godot::ClassDB::bind_method(godot::D_METHOD("is_live"), &CamBANGDevice::is_live);
   godot::ClassDB::bind_method(godot::D_METHOD("is_endpoint_handle"), &CamBANGDevice::is_endpoint_handle);
   godot::ClassDB::bind_method(godot::D_METHOD("engage"), &CamBANGDevice::engage);
+  godot::ClassDB::bind_method(godot::D_METHOD("engage_async"), &CamBANGDevice::engage_async);
   godot::ClassDB::bind_method(godot::D_METHOD("disengage"), &CamBANGDevice::disengage);
   godot::ClassDB::bind_method(
       godot::D_METHOD("create_stream", "definition"),
       &CamBANGDevice::create_stream,
       DEFVAL(godot::Variant()));
   godot::ClassDB::bind_method(godot::D_METHOD("trigger_capture"), &CamBANGDevice::trigger_capture);
+  godot::ClassDB::bind_method(godot::D_METHOD("trigger_capture_async"), &CamBANGDevice::trigger_capture_async);
   godot::ClassDB::bind_method(godot::D_METHOD("get_result"), &CamBANGDevice::get_result);
   godot::ClassDB::bind_method(godot::D_METHOD("set_warm_policy", "policy"), &CamBANGDevice::set_warm_policy);
   godot::ClassDB::bind_method(godot::D_METHOD("set_still_capture_profile", "profile"), &CamBANGDevice::set_still_capture_profile);
@@ -11,6 +11,7 @@
 
 namespace cambang {
 
+class CamBANGOperation;
 class CamBANGServer;
 class CamBANGStream;
 class CamBANGCaptureResult;
@@ -48,10 +49,15 @@ public:
   bool is_live() const { return live_; }
   bool is_endpoint_handle() const { return device_instance_id_ == 0 && !hardware_id_.is_empty(); }
   godot::Error engage();
+  // Awaitable engage(): completes once the provider reports the device open.
+  godot::Ref<CamBANGOperation> engage_async();
   godot::Error disengage();
   godot::Ref<CamBANGStream> create_stream(const godot::Variant& definition = godot::Variant());
 
   godot::Error trigger_capture();
+  // Awaitable trigger_capture(): completes once the capture has completed
+  // (get_result() then reads it) or failed.
+  godot::Ref<CamBANGOperation> trigger_capture_async();
   godot::Ref<CamBANGCaptureResult> get_result() const;
   godot::Error set_warm_policy(const godot::Dictionary& policy);
   godot::Error set_still_capture_profile(const godot::Dictionary& profile);
@@ -0,0 +1,105 @@
+#define CAMBANG_FRAME_LEASE_IMPLEMENTATION 1
+#include "godot/cambang_frame_lease.h"
+
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <new>
+
+#include <godot_cpp/core/object.hpp>
+
+#include "godot/cambang_stream_result.h"
+
+namespace cambang {
+namespace {
+
+// What lease.opaque points at: one reference on the retained result.
+struct FrameLeaseHold final {
+  SharedStreamResultData result;
+};
+
+void fill_frame_lease(const CoreStreamResultData& r, cambang_frame_lease& out) noexcept {
+  out.stream_id = r.stream_id;
+  out.device_instance_id = r.device_instance_id;
+  out.retained_frame_id = r.retained_frame_id;
+  out.width = r.image_width;
+  out.height = r.image_height;
+  out.format_fourcc = r.image_format_fourcc;
+
+  int64_t time_ns = 0;
+  if (r.image_facts.acquisition_timing &&
+      image_acquisition_time_ns(r.image_facts.acquisition_timing->value, time_ns)) {
+    out.flags |= CAMBANG_FRAME_LEASE_HAS_ACQUISITION_TIME;
+    out.acquisition_time_ns = time_ns;
+  }
+
+  if (has_current_cpu_payload(r)) {
+    const CoreResultPayloadCpuPacked& p = r.payload;
+    out.flags |= CAMBANG_FRAME_LEASE_HAS_CPU;
+    out.cpu_data = p.data();
+    out.cpu_size_bytes = p.size_bytes();
+    out.stride_bytes = p.stride_bytes;
+    out.plane_count = p.plane_count;
+    for (uint32_t i = 0; i < kMaxFramePlanes; ++i) {
+      out.plane_offset_bytes[i] = p.planes[i].offset_bytes;
+      out.plane_row_stride_bytes[i] = p.planes[i].row_stride_bytes;
+    }
+  }
+
+  const RetainedGpuBackingDescriptor& gpu = r.retained_gpu_backing_descriptor;
+  if (gpu.valid) {
+    out.flags |= CAMBANG_FRAME_LEASE_HAS_GPU;
+    out.gpu_backing_id = gpu.backing_id;
+    out.gpu_width = gpu.width;
+    out.gpu_height = gpu.height;
+    out.gpu_stride_bytes = gpu.stride_bytes;
+    out.gpu_format_fourcc = gpu.format_fourcc;
+  }
+}
+
+} // namespace
+} // namespace cambang
+
+static_assert(CAMBANG_FRAME_LEASE_MAX_PLANES == cambang::kMaxFramePlanes);
+
+extern "C" {
+
+uint32_t cambang_frame_lease_abi_version(void) {
+  return CAMBANG_FRAME_LEASE_ABI_VERSION;
+}
+
+int32_t cambang_frame_lease_acquire(uint64_t stream_result_instance_id, cambang_frame_lease* out) {
+  if (!out || out->struct_size < sizeof(cambang_frame_lease)) {
+    return CAMBANG_FRAME_LEASE_INVALID_ARGUMENT;
+  }
+  std::memset(reinterpret_cast<uint8_t*>(out) + sizeof(out->struct_size), 0,
+              sizeof(cambang_frame_lease) - sizeof(out->struct_size));
+  const auto* result = godot::Object::cast_to<cambang::CamBANGStreamResult>(
+      godot::ObjectDB::get_instance(stream_result_instance_id));
+  if (!result) {
+    return CAMBANG_FRAME_LEASE_INVALID_ARGUMENT;
+  }
+  const cambang::SharedStreamResultData& data = result->data();
+  if (!data || data->retained_frame_id == 0) {
+    return CAMBANG_FRAME_LEASE_EMPTY;
+  }
+  auto* hold = new (std::nothrow) cambang::FrameLeaseHold{data};
+  if (!hold) {
+    return CAMBANG_FRAME_LEASE_EMPTY;
+  }
+  cambang::fill_frame_lease(*hold->result, *out);
+  out->opaque = hold;
+  return CAMBANG_FRAME_LEASE_OK;
+}
+
+void cambang_frame_lease_release(cambang_frame_lease* lease) {
+  if (!lease || !lease->opaque) {
+    return;
+  }
+  delete static_cast<cambang::FrameLeaseHold*>(lease->opaque);
+  lease->opaque = nullptr;
+  lease->cpu_data = nullptr;
+  lease->flags = 0;
+}
+
+} // extern "C"
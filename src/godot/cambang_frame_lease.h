@@ -0,0 +1,117 @@
+#pragma once
+
+// Native frame leases: a C ABI through which another GDExtension (or any
+// native code in the process) reads a CamBANGStreamResult's pixels in place.
+//
+// A consumer obtains the result object as usual (GDScript or its own
+// godot-cpp calls) and passes its instance id here. The library resolves
+// the symbols from the loaded CamBANG library (dlsym / GetProcAddress, or
+// by linking against it); the function pointer typedefs below match.
+//
+//   cambang_frame_lease lease{};
+//   lease.struct_size = sizeof(lease);
+//   if (cambang_frame_lease_acquire(result.get_instance_id(), &lease) == CAMBANG_FRAME_LEASE_OK) {
+//     ... read lease.cpu_data ...
+//     cambang_frame_lease_release(&lease);
+//   }
+//
+// A lease holds a reference on the retained result, so its bytes stay
+// valid and unchanged until it is released, even after the result object
+// is freed, the stream moves on or CamBANGServer stops. Every acquired
+// lease must be released exactly once. The CPU bytes are the retained
+// payload itself: no copy is made, and they must not be written.
+//
+// GPU-backed results expose only the scalar backing descriptor; no
+// backend-native handle crosses this ABI.
+//
+// Threading: acquire on the thread that owns the result object (normally
+// the main thread); read and release a lease from any thread.
+
+#include <stdint.h>
+
+#if defined(_WIN32)
+#if defined(CAMBANG_FRAME_LEASE_IMPLEMENTATION)
+#define CAMBANG_FRAME_LEASE_API __declspec(dllexport)
+#else
+#define CAMBANG_FRAME_LEASE_API
+#endif
+#else
+#define CAMBANG_FRAME_LEASE_API __attribute__((visibility("default")))
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Bumped when cambang_frame_lease changes incompatibly; fields are only
+// ever appended, and struct_size tells the library which ones to fill.
+#define CAMBANG_FRAME_LEASE_ABI_VERSION 1u
+#define CAMBANG_FRAME_LEASE_MAX_PLANES 3u
+
+enum cambang_frame_lease_status {
+  CAMBANG_FRAME_LEASE_OK = 0,
+  // Null lease, struct_size too small, or an id that is not a live
+  // CamBANGStreamResult.
+  CAMBANG_FRAME_LEASE_INVALID_ARGUMENT = 1,
+  // The result holds no frame.
+  CAMBANG_FRAME_LEASE_EMPTY = 2,
+};
+
+enum cambang_frame_lease_flags {
+  // cpu_data and the CPU layout fields below are set.
+  CAMBANG_FRAME_LEASE_HAS_CPU = 1u << 0,
+  // The gpu_* descriptor fields are set.
+  CAMBANG_FRAME_LEASE_HAS_GPU = 1u << 1,
+  CAMBANG_FRAME_LEASE_HAS_ACQUISITION_TIME = 1u << 2,
+};
+
+typedef struct cambang_frame_lease {
+  // Set by the caller to sizeof(cambang_frame_lease) before acquiring.
+  uint32_t struct_size;
+  uint32_t flags;
+
+  uint64_t stream_id;
+  uint64_t device_instance_id;
+  // Same identity for every representation of the frame (never 0).
+  uint64_t retained_frame_id;
+  uint32_t width;
+  uint32_t height;
+  uint32_t format_fourcc;
+  uint32_t reserved0;
+  // In the frame's acquisition clock domain (see CaptureImageFacts).
+  int64_t acquisition_time_ns;
+
+  // CPU payload: RGBA/BGRA (stride_bytes per row) or planar YUV 4:2:0.
+  const uint8_t* cpu_data;
+  uint64_t cpu_size_bytes;
+  uint32_t stride_bytes;
+  uint32_t plane_count;
+  uint64_t plane_offset_bytes[CAMBANG_FRAME_LEASE_MAX_PLANES];
+  uint32_t plane_row_stride_bytes[CAMBANG_FRAME_LEASE_MAX_PLANES];
+  uint32_t reserved1;
+
+  // GPU backing descriptor. gpu_backing_id names the retained backing
+  // resource, not this frame; 0 when the provider has no scalar identity.
+  uint64_t gpu_backing_id;
+  uint32_t gpu_width;
+  uint32_t gpu_height;
+  uint32_t gpu_stride_bytes;
+  uint32_t gpu_format_fourcc;
+
+  // Owned by the library; cleared by release.
+  void* opaque;
+} cambang_frame_lease;
+
+CAMBANG_FRAME_LEASE_API uint32_t cambang_frame_lease_abi_version(void);
+CAMBANG_FRAME_LEASE_API int32_t cambang_frame_lease_acquire(uint64_t stream_result_instance_id,
+                                                             cambang_frame_lease* out);
+// Safe on a zeroed or already released lease.
+CAMBANG_FRAME_LEASE_API void cambang_frame_lease_release(cambang_frame_lease* lease);
+
+typedef uint32_t (*cambang_frame_lease_abi_version_fn)(void);
+typedef int32_t (*cambang_frame_lease_acquire_fn)(uint64_t, cambang_frame_lease*);
+typedef void (*cambang_frame_lease_release_fn)(cambang_frame_lease*);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
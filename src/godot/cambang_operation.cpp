@@ -0,0 +1,31 @@
+#include "godot/cambang_operation.h"
+
+namespace cambang {
+
+void CamBANGOperation::_resolve_from_server_(int outcome, uint32_t error_code) {
+  if (is_done() || outcome == OUTCOME_PENDING) {
+    return;
+  }
+  outcome_ = outcome;
+  error_code_ = outcome == OUTCOME_FAILED ? error_code : 0;
+  emit_signal("completed", outcome_ == OUTCOME_SUCCEEDED, get_error_code());
+}
+
+void CamBANGOperation::_bind_methods() {
+  godot::ClassDB::bind_method(godot::D_METHOD("is_done"), &CamBANGOperation::is_done);
+  godot::ClassDB::bind_method(godot::D_METHOD("get_outcome"), &CamBANGOperation::get_outcome);
+  godot::ClassDB::bind_method(godot::D_METHOD("is_succeeded"), &CamBANGOperation::is_succeeded);
+  godot::ClassDB::bind_method(godot::D_METHOD("get_error_code"), &CamBANGOperation::get_error_code);
+  godot::ClassDB::bind_method(godot::D_METHOD("get_admission_error"), &CamBANGOperation::get_admission_error);
+  BIND_CONSTANT(OUTCOME_PENDING);
+  BIND_CONSTANT(OUTCOME_SUCCEEDED);
+  BIND_CONSTANT(OUTCOME_FAILED);
+  BIND_CONSTANT(OUTCOME_CANCELLED);
+  ADD_PROPERTY(godot::PropertyInfo(godot::Variant::BOOL, "done"), "", "is_done");
+  ADD_SIGNAL(godot::MethodInfo(
+      "completed",
+      godot::PropertyInfo(godot::Variant::BOOL, "succeeded"),
+      godot::PropertyInfo(godot::Variant::INT, "error_code")));
+}
+
+} // namespace cambang
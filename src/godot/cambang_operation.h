@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstdint>
+
+#include <godot_cpp/classes/ref_counted.hpp>
+#include <godot_cpp/core/class_db.hpp>
+#include <godot_cpp/core/error_macros.hpp>
+
+namespace cambang {
+
+class CamBANGServer;
+
+// Completion handle returned by the *_async() lifecycle methods
+// (CamBANGDevice.engage_async(), CamBANGStream.start_async(), ...). The
+// `completed` signal is emitted once, from CamBANGServer's main-thread tick,
+// never from inside the call that returned the handle, so
+// `await op.completed` cannot miss it.
+class CamBANGOperation final : public godot::RefCounted {
+  GDCLASS(CamBANGOperation, godot::RefCounted)
+
+public:
+  static constexpr int OUTCOME_PENDING = 0;
+  static constexpr int OUTCOME_SUCCEEDED = 1;
+  static constexpr int OUTCOME_FAILED = 2;
+  static constexpr int OUTCOME_CANCELLED = 3;
+
+  CamBANGOperation() = default;
+
+  bool is_done() const { return outcome_ != OUTCOME_PENDING; }
+  int get_outcome() const { return outcome_; }
+  bool is_succeeded() const { return outcome_ == OUTCOME_SUCCEEDED; }
+  // Provider error code of a failed operation; 0 otherwise.
+  int64_t get_error_code() const { return static_cast<int64_t>(error_code_); }
+  // Status of the synchronous admission: OK, or the error the blocking
+  // variant of the command would have returned (the operation then fails).
+  godot::Error get_admission_error() const { return admission_error_; }
+
+protected:
+  static void _bind_methods();
+
+private:
+  friend class CamBANGServer;
+  void _set_admission_error_from_server_(godot::Error error) { admission_error_ = error; }
+  void _resolve_from_server_(int outcome, uint32_t error_code);
+
+  int outcome_ = OUTCOME_PENDING;
+  uint32_t error_code_ = 0;
+  godot::Error admission_error_ = godot::OK;
+};
+
+} // namespace cambang
@@ -0,0 +1,157 @@
+#include "godot/cambang_performance_monitors.h"
+
+#include <chrono>
+#include <iterator>
+
+#include <godot_cpp/classes/performance.hpp>
+#include <godot_cpp/variant/array.hpp>
+#include <godot_cpp/variant/callable.hpp>
+#include <godot_cpp/variant/string_name.hpp>
+
+#include "godot/cambang_server.h"
+
+namespace cambang {
+
+namespace {
+
+enum Monitor : int64_t {
+  CORE_BUSY_PERCENT = 0,
+  CORE_ORDINARY_WAIT_MEAN_US,
+  PUBLISH_REQUESTS_COALESCED_PER_S,
+  INGRESS_FRAMES_DROPPED_PER_S,
+  INGRESS_FRAMES_COALESCED_PER_S,
+  FRAMES_RECEIVED_PER_S,
+  FRAMES_DROPPED_PER_S,
+  SYNTHETIC_FRAMES_EMITTED_PER_S,
+  SYNTHETIC_FRAME_RENDER_MS_PER_S,
+  SYNTHETIC_PATTERN_OVERLAY_MS_PER_S,
+  SYNTHETIC_GPU_UPDATE_MS_PER_S,
+  CPU_DISPLAY_REFRESHES_PER_S,
+  CPU_DISPLAY_REFRESH_MS_PER_S,
+};
+
+constexpr const char* kMonitorIds[] = {
+    "CamBANG/core_busy_percent",
+    "CamBANG/core_ordinary_wait_mean_us",
+    "CamBANG/publish_requests_coalesced_per_s",
+    "CamBANG/ingress_frames_dropped_per_s",
+    "CamBANG/ingress_frames_coalesced_per_s",
+    "CamBANG/frames_received_per_s",
+    "CamBANG/frames_dropped_per_s",
+    "CamBANG/synthetic_frames_emitted_per_s",
+    "CamBANG/synthetic_frame_render_ms_per_s",
+    "CamBANG/synthetic_pattern_overlay_ms_per_s",
+    "CamBANG/synthetic_gpu_update_ms_per_s",
+    "CamBANG/cpu_display_refreshes_per_s",
+    "CamBANG/cpu_display_refresh_ms_per_s",
+};
+static_assert(std::size(kMonitorIds) == CamBANGPerformanceMonitors::kMonitorCount);
+
+CamBANGPerformanceMonitors* g_monitors = nullptr;
+
+uint64_t steady_now_ns() {
+  return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+// A counter that went backwards was restarted; its whole value is new.
+template <typename T>
+double delta(T now, T before) {
+  return static_cast<double>(now >= before ? now - before : now);
+}
+
+} // namespace
+
+double CamBANGPerformanceMonitors::sample(int64_t monitor) {
+  if (monitor < 0 || static_cast<size_t>(monitor) >= kMonitorCount) {
+    return 0.0;
+  }
+  const uint64_t now_ns = steady_now_ns();
+  if (last_ns_ == 0 || now_ns - last_ns_ >= kRateWindowNs) {
+    refresh_(now_ns);
+  }
+  return values_[monitor];
+}
+
+void CamBANGPerformanceMonitors::refresh_(uint64_t now_ns) {
+  CamBANGPerformanceCounters now{};
+  if (server_) {
+    server_->sample_performance_counters_(now);
+  }
+  const bool have_window = last_ns_ != 0 && now.runtime_running && last_.runtime_running;
+  const double seconds = have_window ? static_cast<double>(now_ns - last_ns_) / 1e9 : 0.0;
+  const auto per_s = [seconds](double d) { return seconds > 0.0 ? d / seconds : 0.0; };
+
+  if (!have_window) {
+    for (double& v : values_) {
+      v = 0.0;
+    }
+  } else {
+    values_[CORE_BUSY_PERCENT] = per_s(delta(now.core_exec_ns, last_.core_exec_ns)) / 1e7;
+    const double waits = delta(now.core_ordinary_waits, last_.core_ordinary_waits);
+    values_[CORE_ORDINARY_WAIT_MEAN_US] =
+        waits > 0.0 ? delta(now.core_ordinary_wait_ns, last_.core_ordinary_wait_ns) / waits / 1e3 : 0.0;
+    values_[PUBLISH_REQUESTS_COALESCED_PER_S] =
+        per_s(delta(now.publish_requests_coalesced, last_.publish_requests_coalesced));
+    values_[INGRESS_FRAMES_DROPPED_PER_S] =
+        per_s(delta(now.ingress_frames_dropped, last_.ingress_frames_dropped));
+    values_[INGRESS_FRAMES_COALESCED_PER_S] =
+        per_s(delta(now.ingress_frames_coalesced, last_.ingress_frames_coalesced));
+    values_[FRAMES_RECEIVED_PER_S] = per_s(delta(now.frames_received, last_.frames_received));
+    values_[FRAMES_DROPPED_PER_S] = per_s(delta(now.frames_dropped, last_.frames_dropped));
+    values_[SYNTHETIC_FRAMES_EMITTED_PER_S] =
+        per_s(delta(now.synthetic_frames_emitted, last_.synthetic_frames_emitted));
+    values_[SYNTHETIC_FRAME_RENDER_MS_PER_S] =
+        per_s(delta(now.synthetic_frame_render_ms, last_.synthetic_frame_render_ms));
+    values_[SYNTHETIC_PATTERN_OVERLAY_MS_PER_S] =
+        per_s(delta(now.synthetic_pattern_overlay_ms, last_.synthetic_pattern_overlay_ms));
+    values_[SYNTHETIC_GPU_UPDATE_MS_PER_S] =
+        per_s(delta(now.synthetic_gpu_update_ms, last_.synthetic_gpu_update_ms));
+    values_[CPU_DISPLAY_REFRESHES_PER_S] =
+        per_s(delta(now.cpu_display_refreshes, last_.cpu_display_refreshes));
+    values_[CPU_DISPLAY_REFRESH_MS_PER_S] =
+        per_s(delta(now.cpu_display_refresh_ns, last_.cpu_display_refresh_ns)) / 1e6;
+  }
+  last_ = now;
+  last_ns_ = now_ns;
+}
+
+void register_performance_monitor_classes() {
+  godot::ClassDB::register_class<CamBANGPerformanceMonitors>();
+}
+
+void install_performance_monitors(const CamBANGServer* server) {
+  godot::Performance* performance = godot::Performance::get_singleton();
+  if (!performance || g_monitors) {
+    return;
+  }
+  g_monitors = memnew(CamBANGPerformanceMonitors);
+  g_monitors->set_server(server);
+  for (size_t i = 0; i < CamBANGPerformanceMonitors::kMonitorCount; ++i) {
+    const godot::StringName id(kMonitorIds[i]);
+    if (performance->has_custom_monitor(id)) {
+      continue;
+    }
+    godot::Array args;
+    args.append(static_cast<int64_t>(i));
+    performance->add_custom_monitor(id, godot::Callable(g_monitors, godot::StringName("sample")), args);
+  }
+}
+
+void uninstall_performance_monitors() {
+  if (!g_monitors) {
+    return;
+  }
+  if (godot::Performance* performance = godot::Performance::get_singleton()) {
+    for (const char* id : kMonitorIds) {
+      const godot::StringName name(id);
+      if (performance->has_custom_monitor(name)) {
+        performance->remove_custom_monitor(name);
+      }
+    }
+  }
+  memdelete(g_monitors);
+  g_monitors = nullptr;
+}
+
+} // namespace cambang
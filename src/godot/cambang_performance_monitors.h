@@ -0,0 +1,79 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <godot_cpp/classes/object.hpp>
+#include <godot_cpp/core/class_db.hpp>
+
+namespace cambang {
+
+class CamBANGServer;
+
+// Cumulative CamBANG hot-path counters, sampled for the Performance monitors
+// below. Every field only grows while the runtime runs; a restart may start
+// them over.
+struct CamBANGPerformanceCounters {
+  bool runtime_running = false;
+  // Core thread (CoreRuntime::Stats): execution time of its top-level
+  // tasks, and queue wait of ordinary (provider ingress) tasks.
+  uint64_t core_exec_ns = 0;
+  uint64_t core_ordinary_waits = 0;
+  uint64_t core_ordinary_wait_ns = 0;
+  uint64_t publish_requests_coalesced = 0;
+  // Provider ingress (ProviderCallbackIngress::Stats).
+  uint64_t ingress_frames_dropped = 0;
+  uint64_t ingress_frames_coalesced = 0;
+  // Summed over the latest snapshot's streams.
+  uint64_t frames_received = 0;
+  uint64_t frames_dropped = 0;
+  // Synthetic provider (pattern renderer and GPU bridge update timing).
+  uint64_t synthetic_frames_emitted = 0;
+  double synthetic_frame_render_ms = 0.0;
+  double synthetic_pattern_overlay_ms = 0.0;
+  double synthetic_gpu_update_ms = 0.0;
+  // Live CPU display refresh.
+  uint64_t cpu_display_refreshes = 0;
+  uint64_t cpu_display_refresh_ns = 0;
+};
+
+// Godot Performance custom monitors ("CamBANG/...") over the counters above,
+// so CamBANG cost shows in the editor profiler and remote debug sessions
+// next to engine frame time. Counters are converted to rates (per second, or
+// busy milliseconds per second) over windows of at least kRateWindowNs;
+// between windows a monitor reports the last window's value, so however
+// often Godot polls, the counters are sampled a few times a second.
+//
+// Bridge-owned Object registered only so ClassDB can resolve sample() as the
+// monitors' Callable target -- not a user-facing CamBANG class. Main thread
+// only.
+class CamBANGPerformanceMonitors : public godot::Object {
+  GDCLASS(CamBANGPerformanceMonitors, godot::Object);
+
+public:
+  static constexpr uint64_t kRateWindowNs = 250'000'000;
+  static constexpr size_t kMonitorCount = 13;
+
+  double sample(int64_t monitor);
+
+  void set_server(const CamBANGServer* server) noexcept { server_ = server; }
+
+private:
+  static void _bind_methods() {
+    godot::ClassDB::bind_method(godot::D_METHOD("sample", "monitor"), &CamBANGPerformanceMonitors::sample);
+  }
+
+  void refresh_(uint64_t now_ns);
+
+  const CamBANGServer* server_ = nullptr;
+  CamBANGPerformanceCounters last_{};
+  uint64_t last_ns_ = 0;
+  double values_[kMonitorCount]{};
+};
+
+void register_performance_monitor_classes();
+// Adds the monitors, sampling server; uninstall removes them. Main thread.
+void install_performance_monitors(const CamBANGServer* server);
+void uninstall_performance_monitors();
+
+} // namespace cambang
@@ -1,8 +1,12 @@
 #include "godot/cambang_result_convert.h"
 
-#include <cstring>
 #include <cstddef>
 #include <cstdint>
+#include <mutex>
+#include <vector>
+
+#include "core/core_derived_payload.h"
+#include "godot/godot_gpu_display_service.h"
 
 namespace cambang {
 
@@ -11,37 +15,102 @@ int to_prov_int(ResultFactProvenance v) {
   return static_cast<int>(v);
 }
 
-godot::PackedByteArray payload_rgba_to_pba(
-    const CoreResultPayloadCpuPacked& payload,
-    size_t required_bytes) {
-  godot::PackedByteArray out;
-  out.resize(static_cast<int64_t>(required_bytes));
-  if (required_bytes == 0) {
-    return out;
-  }
+// Small round-robin cache of converted payload bytes and GPU read-backs.
+// Several nodes reading the same latest result in one frame hit it. Each entry
+// pins one RGBA8 frame, so the cache only covers a few concurrently read
+// streams. Entries are per output format (GPU read-backs are RGBA8 only).
+// The source pointer (payload data or GPU backing) guards against a
+// retained_frame_id reused by a later runtime session before
+// clear_payload_image_cache() ran. Entries live in a
+// vector (not a static array) so no Godot value is constructed before, or
+// destroyed after, the engine it belongs to: clears leave it empty.
+struct PayloadImageCacheEntry {
+  uint64_t retained_frame_id = 0;
+  const void* source = nullptr;
+  uint32_t width = 0;
+  uint32_t height = 0;
+  uint32_t format_fourcc = 0;
+  godot::Image::Format image_format = godot::Image::FORMAT_RGBA8;
+  godot::PackedByteArray bytes;
+};
+
+constexpr size_t kPayloadImageCacheEntries = 4;
+std::mutex g_payload_image_cache_mutex;
+std::vector<PayloadImageCacheEntry> g_payload_image_cache;
+size_t g_payload_image_cache_next = 0;
+
+bool payload_image_cache_matches(const PayloadImageCacheEntry& entry,
+                                 uint64_t retained_frame_id,
+                                 const CoreResultPayloadCpuPacked& payload,
+                                 godot::Image::Format image_format) {
+  return entry.retained_frame_id == retained_frame_id &&
+         entry.source == payload.data() &&
+         entry.width == payload.width &&
+         entry.height == payload.height &&
+         entry.format_fourcc == payload.format_fourcc &&
+         entry.image_format == image_format;
+}
 
-  std::memcpy(out.ptrw(), payload.data(), required_bytes);
-  return out;
+godot::Ref<godot::Image> image_from_bytes(uint32_t width,
+                                          uint32_t height,
+                                          godot::Image::Format image_format,
+                                          const godot::PackedByteArray& bytes) {
+  return godot::Image::create_from_data(
+      static_cast<int>(width),
+      static_cast<int>(height),
+      false,
+      image_format,
+      bytes);
 }
 
-godot::PackedByteArray payload_bgra_to_rgba_pba(
-    const CoreResultPayloadCpuPacked& payload,
-    size_t required_bytes) {
-  godot::PackedByteArray out;
-  out.resize(static_cast<int64_t>(required_bytes));
-  if (required_bytes == 0) {
-    return out;
+// Formats payload_to_image() writes directly.
+bool fused_output_of(godot::Image::Format image_format, PackedTransformOutput& out) {
+  switch (image_format) {
+    case godot::Image::FORMAT_RGBA8:
+      out = PackedTransformOutput::RGBA8;
+      return true;
+    case godot::Image::FORMAT_RGB8:
+      out = PackedTransformOutput::RGB8;
+      return true;
+    case godot::Image::FORMAT_L8:
+      out = PackedTransformOutput::LUMA8;
+      return true;
+    default:
+      return false;
   }
+}
 
-  uint8_t* dst = out.ptrw();
-  const uint8_t* src = payload.data();
-  for (size_t i = 0; i + 3 < required_bytes; i += 4) {
-    dst[i] = src[i + 2];
-    dst[i + 1] = src[i + 1];
-    dst[i + 2] = src[i];
-    dst[i + 3] = 255;
+// Image::convert() for the formats without a fused conversion; converting
+// an Image never touches the shared cached bytes (copy-on-write).
+godot::Ref<godot::Image> converted_to(godot::Ref<godot::Image> image, godot::Image::Format image_format) {
+  if (image.is_valid() && image->get_format() != image_format) {
+    image->convert(image_format);
   }
-  return out;
+  return image;
+}
+
+void store_image_cache_entry_locked(uint64_t retained_frame_id,
+                                    const void* source,
+                                    uint32_t width,
+                                    uint32_t height,
+                                    uint32_t format_fourcc,
+                                    godot::Image::Format image_format,
+                                    const godot::PackedByteArray& bytes) {
+  size_t slot = g_payload_image_cache.size();
+  if (slot < kPayloadImageCacheEntries) {
+    g_payload_image_cache.emplace_back();
+  } else {
+    slot = g_payload_image_cache_next;
+    g_payload_image_cache_next = (slot + 1) % kPayloadImageCacheEntries;
+  }
+  PayloadImageCacheEntry& entry = g_payload_image_cache[slot];
+  entry.retained_frame_id = retained_frame_id;
+  entry.source = source;
+  entry.width = width;
+  entry.height = height;
+  entry.format_fourcc = format_fourcc;
+  entry.image_format = image_format;
+  entry.bytes = bytes;
 }
 
 } // namespace
@@ -53,6 +122,7 @@ godot::Dictionary to_dict(const ResultImagePropertiesFacts& v) {
   d["format"] = static_cast<int64_t>(v.format);
   d["orientation"] = v.orientation;
   d["bit_depth"] = static_cast<int64_t>(v.bit_depth);
+  d["row_stride_bytes"] = static_cast<int64_t>(v.row_stride_bytes);
   return d;
 }
 
@@ -63,34 +133,119 @@ godot::Dictionary to_dict(const ResultImagePropertiesProvenance& v) {
   d["format"] = to_prov_int(v.format);
   d["orientation"] = to_prov_int(v.orientation);
   d["bit_depth"] = to_prov_int(v.bit_depth);
+  d["row_stride_bytes"] = to_prov_int(v.row_stride_bytes);
   return d;
 }
 
-godot::Ref<godot::Image> payload_to_image(const CoreResultPayloadCpuPacked& payload) {
-  if (payload.width == 0 || payload.height == 0 || payload.empty()) {
+godot::Ref<godot::Image> payload_to_image(const CoreResultPayloadCpuPacked& payload,
+                                          uint64_t retained_frame_id,
+                                          godot::Image::Format format) {
+  if (!has_valid_retained_cpu_payload_layout(payload)) {
     return godot::Ref<godot::Image>();
   }
+  PackedTransformOutput output = PackedTransformOutput::RGBA8;
+  if (!fused_output_of(format, output)) {
+    return converted_to(payload_to_image(payload, retained_frame_id), format);
+  }
 
-  if (payload.format_fourcc != FOURCC_RGBA && payload.format_fourcc != FOURCC_BGRA) {
-    return godot::Ref<godot::Image>();
+  if (retained_frame_id != 0) {
+    godot::PackedByteArray cached;
+    {
+      std::lock_guard<std::mutex> lock(g_payload_image_cache_mutex);
+      for (const PayloadImageCacheEntry& entry : g_payload_image_cache) {
+        if (payload_image_cache_matches(entry, retained_frame_id, payload, format)) {
+          cached = entry.bytes;
+          break;
+        }
+      }
+    }
+    if (!cached.is_empty()) {
+      return image_from_bytes(payload.width, payload.height, format, cached);
+    }
+  }
+
+  godot::PackedByteArray bytes;
+  if (output == PackedTransformOutput::RGBA8) {
+    const size_t required_bytes =
+        static_cast<size_t>(payload.width) * static_cast<size_t>(payload.height) * 4u;
+    bytes.resize(static_cast<int64_t>(required_bytes));
+    if (!copy_retained_cpu_payload_as_rgba(payload, bytes.ptrw(), required_bytes)) {
+      return godot::Ref<godot::Image>();
+    }
+  } else {
+    PackedTransform transform{};
+    transform.output = output;
+    const size_t required_bytes = retained_cpu_payload_transformed_size(payload, transform);
+    bytes.resize(static_cast<int64_t>(required_bytes));
+    if (required_bytes == 0 ||
+        !copy_retained_cpu_payload_transformed(payload, transform, bytes.ptrw(), required_bytes)) {
+      return godot::Ref<godot::Image>();
+    }
+  }
+
+  if (retained_frame_id != 0) {
+    std::lock_guard<std::mutex> lock(g_payload_image_cache_mutex);
+    store_image_cache_entry_locked(
+        retained_frame_id, payload.data(), payload.width, payload.height, payload.format_fourcc, format, bytes);
   }
 
-  const size_t required_bytes =
-      static_cast<size_t>(payload.width) * static_cast<size_t>(payload.height) * 4u;
-  if (payload.stride_bytes != payload.width * 4u || payload.size_bytes() < required_bytes) {
+  return image_from_bytes(payload.width, payload.height, format, bytes);
+}
+
+godot::Ref<godot::Image> gpu_backing_to_image(const RetainedGpuBackingDescriptor& descriptor,
+                                              const std::shared_ptr<void>& backing,
+                                              uint64_t retained_frame_id,
+                                              godot::Image::Format format) {
+  if (!backing) {
     return godot::Ref<godot::Image>();
   }
+  if (format != godot::Image::FORMAT_RGBA8) {
+    return converted_to(gpu_backing_to_image(descriptor, backing, retained_frame_id), format);
+  }
+  if (retained_frame_id != 0) {
+    godot::PackedByteArray cached;
+    uint32_t width = 0;
+    uint32_t height = 0;
+    {
+      std::lock_guard<std::mutex> lock(g_payload_image_cache_mutex);
+      for (const PayloadImageCacheEntry& entry : g_payload_image_cache) {
+        if (entry.retained_frame_id == retained_frame_id && entry.source == backing.get()) {
+          cached = entry.bytes;
+          width = entry.width;
+          height = entry.height;
+          break;
+        }
+      }
+    }
+    if (!cached.is_empty()) {
+      return image_from_bytes(width, height, godot::Image::FORMAT_RGBA8, cached);
+    }
+  }
 
-  godot::PackedByteArray bytes = payload.format_fourcc == FOURCC_RGBA
-      ? payload_rgba_to_pba(payload, required_bytes)
-      : payload_bgra_to_rgba_pba(payload, required_bytes);
+  godot::Ref<godot::Image> image = godot_gpu_display_materialize_to_image(descriptor, backing);
+  if (retained_frame_id != 0 && image.is_valid() && image->get_format() == godot::Image::FORMAT_RGBA8) {
+    const godot::PackedByteArray bytes = image->get_data();
+    std::lock_guard<std::mutex> lock(g_payload_image_cache_mutex);
+    store_image_cache_entry_locked(retained_frame_id,
+                                   backing.get(),
+                                   static_cast<uint32_t>(image->get_width()),
+                                   static_cast<uint32_t>(image->get_height()),
+                                   descriptor.format_fourcc,
+                                   godot::Image::FORMAT_RGBA8,
+                                   bytes);
+  }
+  return image;
+}
 
-  return godot::Image::create_from_data(
-      static_cast<int>(payload.width),
-      static_cast<int>(payload.height),
-      false,
-      godot::Image::FORMAT_RGBA8,
-      bytes);
+uint64_t clear_payload_image_cache() {
+  std::lock_guard<std::mutex> lock(g_payload_image_cache_mutex);
+  uint64_t released = 0;
+  for (const PayloadImageCacheEntry& entry : g_payload_image_cache) {
+    released += static_cast<uint64_t>(entry.bytes.size());
+  }
+  g_payload_image_cache.clear();
+  g_payload_image_cache_next = 0;
+  return released;
 }
 
 } // namespace cambang
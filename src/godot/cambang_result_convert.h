@@ -13,6 +13,32 @@ godot::Dictionary to_dict(const ResultImagePropertiesFacts& v);
 
 godot::Dictionary to_dict(const ResultImagePropertiesProvenance& v);
 
-godot::Ref<godot::Image> payload_to_image(const CoreResultPayloadCpuPacked& payload);
+// Converts a retained CPU payload to an Image of format. RGBA8, RGB8 and L8
+// are written in one pass from the payload (L8 of a planar payload reads only
+// its Y plane; see core_derived_payload.h); any other format is converted
+// from RGBA8 by Image::convert(). A nonzero retained_frame_id reuses the
+// converted bytes of a recent call for the same retained frame and format:
+// every caller still gets its own Image, but they share one copy-on-write
+// PackedByteArray, so repeated to_image() calls on one result cost no
+// conversion or copy until a caller mutates its Image.
+godot::Ref<godot::Image> payload_to_image(const CoreResultPayloadCpuPacked& payload,
+                                          uint64_t retained_frame_id = 0,
+                                          godot::Image::Format format = godot::Image::FORMAT_RGBA8);
+
+// Reads a retained GPU backing back through the display service
+// (godot_gpu_display_materialize_to_image). A nonzero retained_frame_id
+// shares the read-back bytes the same way, so a GPU-primary result without a
+// CPU sidecar is read back once on its first to_image() rather than on every
+// call -- and the producer need not copy a sidecar for every frame in case
+// one is read. The read-back is RGBA8; other formats convert the Image.
+godot::Ref<godot::Image> gpu_backing_to_image(const RetainedGpuBackingDescriptor& descriptor,
+                                              const std::shared_ptr<void>& backing,
+                                              uint64_t retained_frame_id = 0,
+                                              godot::Image::Format format = godot::Image::FORMAT_RGBA8);
+
+// Drops every cached conversion and read-back (runtime start/stop, where
+// retained_frame_id restarts with each runtime session, and memory pressure).
+// Returns the cached bytes dropped.
+uint64_t clear_payload_image_cache();
 
 } // namespace cambang
@@ -1,6 +1,9 @@
 #include "godot/cambang_server.h"
 #include "godot/cambang_capture_result.h"
 #include "godot/cambang_device.h"
+#include "godot/cambang_operation.h"
+#include "godot/cambang_performance_monitors.h"
+#include "godot/cambang_result_convert.h"
 #include "godot/cambang_stream.h"
 #include "godot/cambang_stream_result.h"
 #include "godot/cambang_stream_result_internal.h"
@@ -19,18 +22,22 @@
 #include <godot_cpp/variant/string.hpp>
 #include <godot_cpp/variant/utility_functions.hpp>
 #include <godot_cpp/variant/variant.hpp>
+#include <godot_cpp/variant/packed_int64_array.hpp>
 #include <godot_cpp/variant/packed_string_array.hpp>
 
 #include <algorithm>
 #include <chrono>
 #include <cmath>
+#include <filesystem>
 #include <initializer_list>
 #include <unordered_set>
 #include <vector>
 
 #include "core/synthetic_timeline_request_binding.h"
+#include "imaging/api/frame_latency_trace.h"
 #include "imaging/api/timeline_teardown_trace.h"
 #include "imaging/api/provider_error_string.h"
+#include "imaging/api/thread_policy.h"
 #include "imaging/broker/provider_broker.h"
 #include "imaging/broker/banner_info.h"
 
@@ -72,6 +79,12 @@ struct LiveRetainedCalibrationMetrics final {
 
 static LiveRetainedCalibrationMetrics g_live_retained_calibration_metrics;
 
+// Live retained-access calibration measures an identity at most once per
+// sampling window, and spends at most the frame budget measuring per tick
+// (at least one calibration always runs, so a slow route cannot starve).
+static constexpr uint64_t kLiveRetainedCalibrationResampleIntervalNs = 2'000'000'000ull;
+static constexpr uint64_t kLiveRetainedCalibrationFrameBudgetNs = 1'000'000ull;
+
 static double ns_to_ms_u64(uint64_t ns) noexcept {
   return static_cast<double>(ns) / 1'000'000.0;
 }
@@ -106,6 +119,35 @@ static bool parse_stream_intent_definition_value(const godot::Variant& value,
   return false;
 }
 
+static bool parse_stream_priority_definition_value(const godot::Variant& value,
+                                                   StreamPriority& out) noexcept {
+  if (value.get_type() == godot::Variant::INT) {
+    const int64_t i = int64_t(value);
+    if (i < 0 || i >= static_cast<int64_t>(kStreamPriorityCount)) {
+      return false;
+    }
+    out = static_cast<StreamPriority>(i);
+    return true;
+  }
+  if (value.get_type() == godot::Variant::STRING ||
+      value.get_type() == godot::Variant::STRING_NAME) {
+    const godot::String token = value;
+    if (token == "LOW" || token == "low" || token == "Low") {
+      out = StreamPriority::LOW;
+      return true;
+    }
+    if (token == "NORMAL" || token == "normal" || token == "Normal") {
+      out = StreamPriority::NORMAL;
+      return true;
+    }
+    if (token == "HIGH" || token == "high" || token == "High") {
+      out = StreamPriority::HIGH;
+      return true;
+    }
+  }
+  return false;
+}
+
 static bool parse_stream_definition_u32_field(const godot::Dictionary& dict,
                                               const char* key,
                                               uint32_t& out,
@@ -163,7 +205,8 @@ static bool parse_stream_profile_definition(const godot::Variant& value,
   const godot::Dictionary profile = value;
   if (!stream_definition_has_only_keys(
           profile,
-          {"width", "height", "format_fourcc", "target_fps", "target_fps_min", "target_fps_max"})) {
+          {"width", "height", "format_fourcc", "target_fps", "target_fps_min", "target_fps_max",
+           "cpu_sidecar_downscale"})) {
     return false;
   }
   out_profile = template_profile;
@@ -190,6 +233,11 @@ static bool parse_stream_profile_definition(const godot::Variant& value,
     }
   }
 
+  if (!parse_stream_definition_u32_field(profile, "cpu_sidecar_downscale", out_profile.cpu_sidecar_downscale, false) ||
+      out_profile.cpu_sidecar_downscale > kMaxCpuSidecarDownscale) {
+    return false;
+  }
+
   if (out_profile.width == 0 || out_profile.height == 0 || out_profile.format_fourcc == 0) {
     return false;
   }
@@ -296,11 +344,13 @@ static bool parse_picture_definition(const godot::Variant& value,
 static bool parse_stream_definition(const godot::Variant& definition,
                                     const StreamTemplate& stream_template,
                                     StreamIntent& out_intent,
+                                    StreamPriority& out_priority,
                                     CaptureProfile& out_profile,
                                     bool& out_has_profile,
                                     PictureConfig& out_picture,
                                     bool& out_has_picture) noexcept {
   out_intent = StreamIntent::PREVIEW;
+  out_priority = StreamPriority::NORMAL;
   out_profile = CaptureProfile{};
   out_has_profile = false;
   out_picture = stream_template.picture;
@@ -314,7 +364,7 @@ static bool parse_stream_definition(const godot::Variant& definition,
   }
 
   const godot::Dictionary def = definition;
-  if (!stream_definition_has_only_keys(def, {"intent", "profile", "picture"})) {
+  if (!stream_definition_has_only_keys(def, {"intent", "priority", "profile", "picture"})) {
     return false;
   }
 
@@ -324,6 +374,12 @@ static bool parse_stream_definition(const godot::Variant& definition,
     }
   }
 
+  if (def.has("priority")) {
+    if (!parse_stream_priority_definition_value(def.get("priority", godot::Variant()), out_priority)) {
+      return false;
+    }
+  }
+
   if (def.has("profile")) {
     if (!parse_stream_profile_definition(
             def.get("profile", godot::Variant()), stream_template.profile, out_profile)) {
@@ -805,6 +861,8 @@ static godot::String backing_plan_evaluation_completion_reason_name(
       return "live_display_demand_family_crossing";
     case BackingPlanEvaluationCompletionReason::SingleViableCandidate:
       return "single_viable_candidate";
+    case BackingPlanEvaluationCompletionReason::PersistedPrior:
+      return "persisted_prior";
   }
   return "unknown";
 }
@@ -827,6 +885,8 @@ static godot::String result_payload_kind_name(ResultPayloadKind payload_kind) {
   switch (payload_kind) {
     case ResultPayloadKind::CPU_PACKED:
       return "cpu_packed";
+    case ResultPayloadKind::CPU_PLANAR:
+      return "cpu_planar";
     case ResultPayloadKind::GPU_SURFACE:
       return "gpu_surface";
     case ResultPayloadKind::ENCODED_IMAGE:
@@ -1175,6 +1235,57 @@ static bool apply_synthetic_capture_capability_downgrade_cmdline_to_project_sett
   return true;
 }
 
+static bool read_replay_project_settings(ReplayProviderConfig& out_config) {
+  out_config = ReplayProviderConfig{};
+  godot::ProjectSettings* settings = godot::ProjectSettings::get_singleton();
+  if (!settings) {
+    return true;
+  }
+  const godot::String recording = settings->get_setting(
+      kReplayRecordingProjectSetting,
+      godot::String(""));
+  const godot::String pacing = settings->get_setting(
+      kReplayPacingProjectSetting,
+      godot::String(replay_pacing_setting_value(ReplayPacing::OriginalTiming)));
+  return parse_replay_provider_selection(
+      recording.utf8().get_data(),
+      pacing.utf8().get_data(),
+      out_config);
+}
+
+static bool apply_replay_cmdline_to_project_settings() {
+  godot::ProjectSettings* settings = godot::ProjectSettings::get_singleton();
+  if (!settings) {
+    return true;
+  }
+
+  std::string recording;
+  bool recording_found = false;
+  if (!try_read_single_namespaced_cmdline_override(
+          kReplayRecordingArg, recording, recording_found)) {
+    return false;
+  }
+  std::string pacing;
+  bool pacing_found = false;
+  if (!try_read_single_namespaced_cmdline_override(
+          kReplayPacingArg, pacing, pacing_found)) {
+    return false;
+  }
+  if (pacing_found) {
+    ReplayPacing parsed = ReplayPacing::OriginalTiming;
+    if (!parse_replay_pacing(pacing, parsed)) {
+      return false;
+    }
+    settings->set_setting(kReplayPacingProjectSetting, godot::String(pacing.c_str()));
+  }
+  if (recording_found) {
+    settings->set_setting(
+        kReplayRecordingProjectSetting,
+        godot::String::utf8(recording.c_str()));
+  }
+  return true;
+}
+
 static godot::Error map_provider_result_to_godot_error(ProviderResult pr) noexcept {
   switch (pr.code) {
     case ProviderError::OK: return godot::OK;
@@ -1298,6 +1409,27 @@ static uint64_t build_capture_member_identity_signature(
   return signature;
 }
 
+static uint64_t build_capture_member_posture_signature(
+    const SharedCaptureResultData& data) noexcept {
+  if (!data) {
+    return 0;
+  }
+  uint64_t signature = 0;
+  signature = mix_identity_u64(signature, data->image_member_count());
+  for (uint32_t i = 0; i < data->image_member_count(); ++i) {
+    const auto* member = data->image_member_at(i);
+    if (!member) {
+      continue;
+    }
+    signature = mix_identity_u64(signature, member->image_member_index);
+    signature = mix_identity_u64(signature, member->access_posture.posture_id);
+    signature = mix_identity_u64(
+        signature,
+        static_cast<uint64_t>(member->retained_access_truth.to_image));
+  }
+  return signature;
+}
+
 static bool infer_stream_result_posture_shape_for_calibration(
     const SharedStreamResultData& result,
     CoreProductionPostureShape& out) noexcept {
@@ -1311,7 +1443,7 @@ static bool infer_stream_result_posture_shape_for_calibration(
               : CoreProductionPostureShape::GpuPrimaryNoCpuSidecar;
     return true;
   }
-  if (result->payload_kind == ResultPayloadKind::CPU_PACKED) {
+  if (is_cpu_payload_kind(result->payload_kind)) {
     out = CoreProductionPostureShape::CpuPrimary;
     return true;
   }
@@ -1335,7 +1467,7 @@ static bool infer_capture_result_posture_shape_for_calibration(
               : CoreProductionPostureShape::GpuPrimaryNoCpuSidecar;
     return true;
   }
-  if (member->payload_kind == ResultPayloadKind::CPU_PACKED) {
+  if (is_cpu_payload_kind(member->payload_kind)) {
     out = CoreProductionPostureShape::CpuPrimary;
     return true;
   }
@@ -1410,6 +1542,32 @@ static godot::Error map_try_stop_stream_status(TryStopStreamStatus s) noexcept {
   }
 }
 
+static void report_start_stream_rejection(TryStartStreamStatus status,
+                                          uint64_t stream_id,
+                                          uint64_t device_instance_id) {
+  if (status == TryStartStreamStatus::Busy) {
+    ERR_PRINT(godot::vformat(
+        "CamBANGServer: start_stream rejected because another stream is already active for device_instance_id=%d; stop the active stream before starting stream_id=%d.",
+        static_cast<int64_t>(device_instance_id),
+        static_cast<int64_t>(stream_id)));
+  } else if (status == TryStartStreamStatus::ProviderRejected) {
+    ERR_PRINT(godot::vformat(
+        "CamBANGServer: start_stream rejected by provider for stream_id=%d; status=%s.",
+        static_cast<int64_t>(stream_id),
+        try_start_stream_status_name(status)));
+  }
+}
+
+static int operation_outcome_to_int(CoreOperationOutcome outcome) noexcept {
+  switch (outcome) {
+    case CoreOperationOutcome::Pending: return CamBANGOperation::OUTCOME_PENDING;
+    case CoreOperationOutcome::Succeeded: return CamBANGOperation::OUTCOME_SUCCEEDED;
+    case CoreOperationOutcome::Failed: return CamBANGOperation::OUTCOME_FAILED;
+    case CoreOperationOutcome::Cancelled: return CamBANGOperation::OUTCOME_CANCELLED;
+  }
+  return CamBANGOperation::OUTCOME_FAILED;
+}
+
 static bool line_contains_token(const std::string& line, const char* token) {
   return token && line.find(token) != std::string::npos;
 }
@@ -1458,6 +1616,26 @@ godot::Error CamBANGServer::start(const godot::Variant& provider_kind_arg,
                                   const godot::Variant& role_arg,
                                   const godot::Variant& timing_driver_arg,
                                   const godot::Variant& timeline_reconciliation_arg) {
+  ProviderConfigArgs config;
+  const godot::Error parsed = _parse_provider_config_args_(
+      "start", provider_kind_arg, role_arg, timing_driver_arg, timeline_reconciliation_arg, config);
+  if (parsed != godot::OK) {
+    return parsed;
+  }
+  return _start_with_provider_config(
+      config.mode,
+      config.synthetic_role,
+      config.timing_driver,
+      config.completion_gated_destructive_sequencing_enabled);
+}
+
+godot::Error CamBANGServer::_parse_provider_config_args_(
+    const char* method,
+    const godot::Variant& provider_kind_arg,
+    const godot::Variant& role_arg,
+    const godot::Variant& timing_driver_arg,
+    const godot::Variant& timeline_reconciliation_arg,
+    ProviderConfigArgs& out) {
   const bool has_provider_kind = provider_kind_arg.get_type() != godot::Variant::NIL;
   const bool has_role = role_arg.get_type() != godot::Variant::NIL;
   const bool has_timing_driver = timing_driver_arg.get_type() != godot::Variant::NIL;
@@ -1466,7 +1644,7 @@ godot::Error CamBANGServer::start(const godot::Variant& provider_kind_arg,
   int provider_kind = PROVIDER_KIND_PLATFORM_BACKED;
   if (has_provider_kind) {
     if (provider_kind_arg.get_type() != godot::Variant::INT) {
-      ERR_PRINT("CamBANGServer: start rejected; provider_kind must be an integer when supplied.");
+      ERR_PRINT(godot::vformat("CamBANGServer: %s rejected; provider_kind must be an integer when supplied.", method));
       return godot::ERR_INVALID_PARAMETER;
     }
     provider_kind = static_cast<int>(int64_t(provider_kind_arg));
@@ -1474,18 +1652,19 @@ godot::Error CamBANGServer::start(const godot::Variant& provider_kind_arg,
 
   if (provider_kind == PROVIDER_KIND_PLATFORM_BACKED) {
     if (has_role || has_timing_driver || has_timeline_reconciliation) {
-      ERR_PRINT("CamBANGServer: start rejected; platform-backed start does not accept synthetic role/timing/reconciliation arguments.");
+      ERR_PRINT(godot::vformat("CamBANGServer: %s rejected; platform-backed start does not accept synthetic role/timing/reconciliation arguments.", method));
       return godot::ERR_INVALID_PARAMETER;
     }
-    return _start_with_provider_config(
-        RuntimeMode::platform_backed,
-        SyntheticRole::Nominal,
-        TimingDriver::VirtualTime,
-        true);
+    out.mode = RuntimeMode::platform_backed;
+    out.synthetic_role = SyntheticRole::Nominal;
+    out.timing_driver = TimingDriver::VirtualTime;
+    out.completion_gated_destructive_sequencing_enabled = true;
+    return godot::OK;
   }
   if (provider_kind != PROVIDER_KIND_SYNTHETIC) {
     ERR_PRINT(godot::vformat(
-        "CamBANGServer: start rejected; unknown provider_kind value '%d'.",
+        "CamBANGServer: %s rejected; unknown provider_kind value '%d'.",
+        method,
         provider_kind));
     return godot::ERR_INVALID_PARAMETER;
   }
@@ -1493,7 +1672,7 @@ godot::Error CamBANGServer::start(const godot::Variant& provider_kind_arg,
   int role = SYNTHETIC_ROLE_NOMINAL;
   if (has_role) {
     if (role_arg.get_type() != godot::Variant::INT) {
-      ERR_PRINT("CamBANGServer: start rejected; synthetic role must be an integer when supplied.");
+      ERR_PRINT(godot::vformat("CamBANGServer: %s rejected; synthetic role must be an integer when supplied.", method));
       return godot::ERR_INVALID_PARAMETER;
     }
     role = static_cast<int>(int64_t(role_arg));
@@ -1502,7 +1681,8 @@ godot::Error CamBANGServer::start(const godot::Variant& provider_kind_arg,
   SyntheticRole parsed_role{};
   if (!parse_synthetic_role_int(role, parsed_role)) {
     ERR_PRINT(godot::vformat(
-        "CamBANGServer: start rejected; unknown synthetic role value '%d'.",
+        "CamBANGServer: %s rejected; unknown synthetic role value '%d'.",
+        method,
         role));
     return godot::ERR_INVALID_PARAMETER;
   }
@@ -1510,7 +1690,7 @@ godot::Error CamBANGServer::start(const godot::Variant& provider_kind_arg,
   int timing_driver = TIMING_DRIVER_VIRTUAL_TIME;
   if (has_timing_driver) {
     if (timing_driver_arg.get_type() != godot::Variant::INT) {
-      ERR_PRINT("CamBANGServer: start rejected; timing_driver must be an integer when supplied.");
+      ERR_PRINT(godot::vformat("CamBANGServer: %s rejected; timing_driver must be an integer when supplied.", method));
       return godot::ERR_INVALID_PARAMETER;
     }
     timing_driver = static_cast<int>(int64_t(timing_driver_arg));
@@ -1519,7 +1699,8 @@ godot::Error CamBANGServer::start(const godot::Variant& provider_kind_arg,
   TimingDriver parsed_timing_driver{};
   if (!parse_timing_driver_int(timing_driver, parsed_timing_driver)) {
     ERR_PRINT(godot::vformat(
-        "CamBANGServer: start rejected; unknown timing driver value '%d'.",
+        "CamBANGServer: %s rejected; unknown timing driver value '%d'.",
+        method,
         timing_driver));
     return godot::ERR_INVALID_PARAMETER;
   }
@@ -1530,17 +1711,18 @@ godot::Error CamBANGServer::start(const godot::Variant& provider_kind_arg,
   TimelineReconciliation requested_timeline_reconciliation = TimelineReconciliation::CompletionGated;
   if (has_timeline_reconciliation) {
     if (!reconciliation_applicable) {
-      ERR_PRINT("CamBANGServer: start rejected; timeline_reconciliation applies only to synthetic timeline virtual_time mode.");
+      ERR_PRINT(godot::vformat("CamBANGServer: %s rejected; timeline_reconciliation applies only to synthetic timeline virtual_time mode.", method));
       return godot::ERR_INVALID_PARAMETER;
     }
     if (timeline_reconciliation_arg.get_type() != godot::Variant::INT) {
-      ERR_PRINT("CamBANGServer: start rejected; timeline_reconciliation must be an integer when supplied.");
+      ERR_PRINT(godot::vformat("CamBANGServer: %s rejected; timeline_reconciliation must be an integer when supplied.", method));
       return godot::ERR_INVALID_PARAMETER;
     }
     const int timeline_reconciliation = static_cast<int>(int64_t(timeline_reconciliation_arg));
     if (!parse_timeline_reconciliation_int(timeline_reconciliation, requested_timeline_reconciliation)) {
       ERR_PRINT(godot::vformat(
-          "CamBANGServer: start rejected; unknown timeline_reconciliation value '%d'.",
+          "CamBANGServer: %s rejected; unknown timeline_reconciliation value '%d'.",
+          method,
           timeline_reconciliation));
       return godot::ERR_INVALID_PARAMETER;
     }
@@ -1549,21 +1731,119 @@ godot::Error CamBANGServer::start(const godot::Variant& provider_kind_arg,
   completion_gated_destructive_sequencing_enabled =
       (requested_timeline_reconciliation == TimelineReconciliation::CompletionGated);
 
-  return _start_with_provider_config(
-      RuntimeMode::synthetic,
-      parsed_role,
-      parsed_timing_driver,
-      completion_gated_destructive_sequencing_enabled);
+  out.mode = RuntimeMode::synthetic;
+  out.synthetic_role = parsed_role;
+  out.timing_driver = parsed_timing_driver;
+  out.completion_gated_destructive_sequencing_enabled = completion_gated_destructive_sequencing_enabled;
+  return godot::OK;
+}
+
+godot::Error CamBANGServer::swap_provider(const godot::Variant& provider_kind_arg,
+                                          const godot::Variant& role_arg,
+                                          const godot::Variant& timing_driver_arg,
+                                          const godot::Variant& timeline_reconciliation_arg) {
+  ProviderConfigArgs config;
+  const godot::Error parsed = _parse_provider_config_args_(
+      "swap_provider", provider_kind_arg, role_arg, timing_driver_arg, timeline_reconciliation_arg, config);
+  if (parsed != godot::OK) {
+    return parsed;
+  }
+  ProviderBroker* broker = dynamic_cast<ProviderBroker*>(provider_.get());
+  if (!is_public_boundary_ready_() || !broker || runtime_.attached_provider() != broker) {
+    ERR_PRINT("CamBANGServer: swap_provider rejected because the runtime is not running with an observable baseline.");
+    return godot::ERR_BUSY;
+  }
+  {
+    ProviderResult cap = ProviderBroker::check_mode_supported_in_build(config.mode);
+    if (!cap.ok()) {
+      ERR_PRINT(godot::vformat(
+          "CamBANGServer: cannot swap; requested provider_mode='%s' is not supported in this build.",
+          mode_to_cstr(config.mode)));
+      return map_provider_result_to_godot_error(cap);
+    }
+    const ProviderAccessStatus access = ProviderBroker::check_mode_access_readiness(config.mode);
+    if (!access.ok()) {
+      ERR_PRINT(godot::vformat(
+          "CamBANGServer: cannot swap; provider access/readiness preflight failed for provider_mode='%s' code='%s' reason='%s'.",
+          mode_to_cstr(config.mode),
+          cambang::to_string(access.code),
+          access.stable_reason ? access.stable_reason : ""));
+      return map_provider_access_status_to_godot_error(access);
+    }
+  }
+
+  const bool prior_completion_gated = completion_gated_destructive_sequencing_enabled_;
+  completion_gated_destructive_sequencing_enabled_ = config.completion_gated_destructive_sequencing_enabled;
+  ProviderBrokerRequest request;
+  if (!_read_provider_broker_request_(config.mode, config.synthetic_role, config.timing_driver, request)) {
+    completion_gated_destructive_sequencing_enabled_ = prior_completion_gated;
+    return godot::ERR_INVALID_PARAMETER;
+  }
+
+  // Runs on the core thread once Core has closed everything the old
+  // provider holds.
+  const TrySwapProviderStatus status = runtime_.try_swap_provider([broker, &request]() {
+    return broker->swap_provider([&request](ProviderBroker& b) {
+      return _apply_provider_broker_request_(b, std::move(request))
+          ? ProviderResult::success()
+          : ProviderResult::failure(ProviderError::ERR_INVALID_ARGUMENT);
+    });
+  });
+  switch (status) {
+    case TrySwapProviderStatus::OK:
+      break;
+    case TrySwapProviderStatus::Busy:
+      completion_gated_destructive_sequencing_enabled_ = prior_completion_gated;
+      return godot::ERR_BUSY;
+    case TrySwapProviderStatus::InvalidArgument:
+      completion_gated_destructive_sequencing_enabled_ = prior_completion_gated;
+      return godot::ERR_INVALID_PARAMETER;
+    case TrySwapProviderStatus::ProviderRejected:
+    default:
+      ERR_PRINT("CamBANGServer: swap_provider failed; the replacement provider did not come up. stop() and start() again.");
+      return godot::FAILED;
+  }
+
+  // Core closed every device and destroyed every stream; host bookkeeping
+  // follows as it does for an explicit close, and wrappers go non-live
+  // through the next snapshot.
+  for (auto& kv : endpoint_lifecycle_by_hardware_id_) {
+    EndpointLifecycleState& state = kv.second;
+    if (state.device_instance_id != 0) {
+      state.close_requested = true;
+    } else {
+      state.open_requested = false;
+    }
+  }
+  for (const auto& kv : direct_stream_hardware_id_by_stream_id_) {
+    CamBANGStreamResult::remove_live_stream_cpu_display_view(kv.first);
+  }
+  direct_stream_hardware_id_by_stream_id_.clear();
+  active_runtime_mode_ = config.mode;
+  active_synthetic_role_ = config.synthetic_role;
+  strict_scenario_unmet_logged_ = false;
+  rig_trigger_rejection_logged_ = false;
+  _reset_scenario_session_state_();
+  _clear_pending_endpoint_startup_intents_();
+  _refresh_timeline_teardown_trace_mode();
+
+  const ProviderBannerInfo bi = describe_provider_for_banner(provider_.get());
+  godot::UtilityFunctions::print("[CamBANG] provider swapped: ", bi.provider_mode, " / ", bi.provider_name);
+  return godot::OK;
 }
 
 godot::Dictionary CamBANGServer::get_provider_support() const {
-  godot::Dictionary out;
-  out["platform_backed"] = ProviderBroker::check_mode_supported_in_build(RuntimeMode::platform_backed).ok();
-  out["synthetic"] = ProviderBroker::check_mode_supported_in_build(RuntimeMode::synthetic).ok();
-  out["target_platform"] = godot::String(CAMBANG_GDE_TARGET_PLATFORM);
-  out["platform_family"] = godot::String(CAMBANG_GDE_PLATFORM_PROVIDER_FAMILY);
-  out["platform_provider_status"] = godot::String(CAMBANG_GDE_PLATFORM_PROVIDER_STATUS);
-  return out;
+  // Fixed by the build, so built once on first query and shared read-only.
+  if (provider_support_.is_empty()) {
+    provider_support_["platform_backed"] =
+        ProviderBroker::check_mode_supported_in_build(RuntimeMode::platform_backed).ok();
+    provider_support_["synthetic"] = ProviderBroker::check_mode_supported_in_build(RuntimeMode::synthetic).ok();
+    provider_support_["target_platform"] = godot::String(CAMBANG_GDE_TARGET_PLATFORM);
+    provider_support_["platform_family"] = godot::String(CAMBANG_GDE_PLATFORM_PROVIDER_FAMILY);
+    provider_support_["platform_provider_status"] = godot::String(CAMBANG_GDE_PLATFORM_PROVIDER_STATUS);
+    provider_support_.make_read_only();
+  }
+  return provider_support_;
 }
 
 godot::Error CamBANGServer::_start_with_provider_config(
@@ -1581,9 +1861,15 @@ godot::Error CamBANGServer::_start_with_provider_config(
   _clear_pending_endpoint_startup_intents_();
   latest_.reset();
   latest_export_.clear();
+  export_cache_.clear();
   has_latest_export_ = false;
+  latest_export_pending_ = false;
+  state_summary_.clear();
+  state_summary_export_.clear();
+  state_summary_export_pending_ = false;
   has_godot_counters_ = false;
   CamBANGStreamResult::clear_live_stream_cpu_display_views();
+  clear_payload_image_cache();
   result_access_cost_evidence::clear();
   _clear_live_retained_result_access_calibration_state_();
 
@@ -1612,7 +1898,12 @@ godot::Error CamBANGServer::_start_with_provider_config(
     _set_all_tracked_wrapper_live_states_false_();
     latest_.reset();
     latest_export_.clear();
+    export_cache_.clear();
     has_latest_export_ = false;
+    latest_export_pending_ = false;
+    state_summary_.clear();
+    state_summary_export_.clear();
+    state_summary_export_pending_ = false;
     has_godot_counters_ = false;
     snapshot_buffer_.clear();
     last_seen_published_seq_ = runtime_.published_seq();
@@ -1621,7 +1912,9 @@ godot::Error CamBANGServer::_start_with_provider_config(
     endpoint_lifecycle_by_hardware_id_.clear();
     direct_stream_hardware_id_by_stream_id_.clear();
     latest_capture_id_by_device_instance_id_.clear();
+    issued_stream_result_wrappers_.clear();
     CamBANGStreamResult::clear_live_stream_cpu_display_views();
+    clear_payload_image_cache();
     result_access_cost_evidence::clear();
     _clear_live_retained_result_access_calibration_state_();
 
@@ -1662,7 +1955,27 @@ godot::Error CamBANGServer::_start_with_provider_config(
   // Ensure the SceneTree tick hook exists so snapshots can be drained + signals emitted.
   _ensure_tick_connected();
 
+  // Render-thread display bridges are deferred from extension load to the
+  // first start; they must exist before the provider produces any backing.
+  install_synthetic_gpu_backing_godot_bridge();
+  install_live_cpu_display_bridge();
+
   // Explicit user action: do not auto-start on launch.
+  frame_latency_trace_clear();
+  // Platform-backed runs persist converged retained-plan decisions under
+  // user://, so the next run settles on them instead of re-evaluating.
+  // Synthetic runs do not: their hardware is scenario-defined, and verifier
+  // scenes rely on every start evaluating afresh.
+  std::filesystem::path retained_plan_prior_path;
+  if (godot::ProjectSettings* settings = godot::ProjectSettings::get_singleton();
+      settings && mode == RuntimeMode::platform_backed) {
+    const godot::String prior_path =
+        settings->globalize_path("user://cambang/retained_plan_priors.txt");
+    const godot::CharString utf8 = prior_path.utf8();
+    retained_plan_prior_path = std::filesystem::path(
+        std::u8string(reinterpret_cast<const char8_t*>(utf8.get_data())));
+  }
+  (void)runtime_.set_retained_plan_prior_path(std::move(retained_plan_prior_path));
   if (!runtime_.start()) {
     clear_start_attempt_state();
     return godot::FAILED;
@@ -1702,6 +2015,7 @@ void CamBANGServer::stop() {
     provider_.reset();
   }
   CamBANGStreamResult::clear_live_stream_cpu_display_views();
+  clear_payload_image_cache();
   synthetic_gpu_backing_drain_render_releases_before_stop();
   drain_live_cpu_display_bridge_before_stop();
   result_access_cost_evidence::clear();
@@ -1729,7 +2043,12 @@ void CamBANGServer::stop() {
   // Enforce documented NIL pre-baseline behaviour across restart boundaries.
   latest_.reset();
   latest_export_.clear();
+  export_cache_.clear();
   has_latest_export_ = false;
+  latest_export_pending_ = false;
+  state_summary_.clear();
+  state_summary_export_.clear();
+  state_summary_export_pending_ = false;
   has_godot_counters_ = false;
   snapshot_buffer_.clear();
   last_seen_published_seq_ = runtime_.published_seq();
@@ -1738,6 +2057,7 @@ void CamBANGServer::stop() {
   endpoint_lifecycle_by_hardware_id_.clear();
   direct_stream_hardware_id_by_stream_id_.clear();
   latest_capture_id_by_device_instance_id_.clear();
+  issued_stream_result_wrappers_.clear();
 }
 
 void CamBANGServer::stop_and_quit(int64_t exit_code) {
@@ -1935,6 +2255,48 @@ godot::Error CamBANGServer::engage_endpoint_handle(const godot::String& hardware
     }
     return godot::ERR_UNAVAILABLE;
   }
+
+  SetupOpenDevice open;
+  EndpointLifecycleState* state = nullptr;
+  const godot::Error rc = _prepare_endpoint_engage_(hardware_id, display_name, open, state);
+  if (rc != godot::OK || state == nullptr) {
+    return rc;
+  }
+  return _finish_endpoint_engage_(
+      *state, runtime_.try_open_device(open.hardware_id, open.device_instance_id, open.root_id));
+}
+
+godot::Ref<CamBANGOperation> CamBANGServer::engage_endpoint_handle_async(
+    const godot::String& hardware_id,
+    const godot::String& display_name) {
+  if (hardware_id.is_empty() || !is_public_boundary_ready_()) {
+    return _track_operation_(CoreOperation(), godot::ERR_UNAVAILABLE);
+  }
+
+  SetupOpenDevice open;
+  EndpointLifecycleState* state = nullptr;
+  const godot::Error rc = _prepare_endpoint_engage_(hardware_id, display_name, open, state);
+  if (rc != godot::OK) {
+    return _track_operation_(CoreOperation(), rc);
+  }
+  if (state == nullptr) {
+    // Already engaged (or its open is in flight): nothing left to wait for.
+    CoreOperation done = CoreOperation::make_pending();
+    (void)done.resolve(CoreOperationOutcome::Succeeded);
+    return _track_operation_(done, godot::OK);
+  }
+  TryOpenDeviceStatus status = TryOpenDeviceStatus::Busy;
+  const CoreOperation op =
+      runtime_.open_device_async(open.hardware_id, open.device_instance_id, open.root_id, &status);
+  return _track_operation_(op, _finish_endpoint_engage_(*state, status));
+}
+
+godot::Error CamBANGServer::_prepare_endpoint_engage_(
+    const godot::String& hardware_id,
+    const godot::String& display_name,
+    SetupOpenDevice& out_open,
+    EndpointLifecycleState*& out_state) {
+  out_state = nullptr;
   if (!provider_) {
     return godot::ERR_UNAVAILABLE;
   }
@@ -1953,9 +2315,15 @@ godot::Error CamBANGServer::engage_endpoint_handle(const godot::String& hardware
 
   state.device_instance_id = next_direct_device_instance_id_.fetch_add(1, std::memory_order_relaxed);
   state.root_id = next_direct_root_id_.fetch_add(1, std::memory_order_relaxed);
-  const TryOpenDeviceStatus open_status =
-      runtime_.try_open_device(std::string(hardware_id.utf8().get_data()), state.device_instance_id, state.root_id);
-  switch (open_status) {
+  out_open.hardware_id = std::string(hardware_id.utf8().get_data());
+  out_open.device_instance_id = state.device_instance_id;
+  out_open.root_id = state.root_id;
+  out_state = &state;
+  return godot::OK;
+}
+
+godot::Error CamBANGServer::_finish_endpoint_engage_(EndpointLifecycleState& state, TryOpenDeviceStatus status) {
+  switch (status) {
     case TryOpenDeviceStatus::OK:
       state.open_requested = true;
       state.close_requested = false;
@@ -2041,6 +2409,7 @@ godot::Ref<CamBANGStream> CamBANGServer::create_stream_for_endpoint_hardware_id(
 
   const StreamTemplate stream_template = provider_->stream_template();
   StreamIntent stream_intent = StreamIntent::PREVIEW;
+  StreamPriority stream_priority = StreamPriority::NORMAL;
   CaptureProfile stream_profile{};
   bool has_stream_profile = false;
   PictureConfig stream_picture{};
@@ -2049,6 +2418,7 @@ godot::Ref<CamBANGStream> CamBANGServer::create_stream_for_endpoint_hardware_id(
           definition,
           stream_template,
           stream_intent,
+          stream_priority,
           stream_profile,
           has_stream_profile,
           stream_picture,
@@ -2071,7 +2441,8 @@ godot::Ref<CamBANGStream> CamBANGServer::create_stream_for_endpoint_hardware_id(
       stream_intent,
       has_stream_profile ? &stream_profile : nullptr,
       has_stream_picture ? &stream_picture : nullptr,
-      0);
+      0,
+      stream_priority);
   if (cs != TryCreateStreamStatus::OK) {
     return godot::Ref<CamBANGStream>();
   }
@@ -2149,6 +2520,19 @@ godot::Error CamBANGServer::start_direct_stream_handle(
     uint64_t stream_id,
     const godot::String& hardware_id,
     uint64_t device_instance_id) {
+  const godot::Error invalid = _validate_direct_stream_handle_(stream_id, hardware_id, device_instance_id);
+  if (invalid != godot::OK) {
+    return invalid;
+  }
+  const TryStartStreamStatus status = runtime_.try_start_stream(stream_id);
+  report_start_stream_rejection(status, stream_id, device_instance_id);
+  return map_try_start_stream_status(status);
+}
+
+godot::Error CamBANGServer::_validate_direct_stream_handle_(
+    uint64_t stream_id,
+    const godot::String& hardware_id,
+    uint64_t device_instance_id) const {
   if (stream_id == 0 || !is_public_boundary_ready_() || !provider_) {
     return godot::ERR_UNAVAILABLE;
   }
@@ -2162,20 +2546,34 @@ godot::Error CamBANGServer::start_direct_stream_handle(
   if (device_instance_id == 0) {
     return godot::ERR_INVALID_PARAMETER;
   }
-  const TryStartStreamStatus status = runtime_.try_start_stream(stream_id);
-  const godot::Error rc = map_try_start_stream_status(status);
-  if (status == TryStartStreamStatus::Busy) {
-    ERR_PRINT(godot::vformat(
-        "CamBANGServer: start_stream rejected because another stream is already active for device_instance_id=%d; stop the active stream before starting stream_id=%d.",
-        static_cast<int64_t>(device_instance_id),
-        static_cast<int64_t>(stream_id)));
-  } else if (status == TryStartStreamStatus::ProviderRejected) {
-    ERR_PRINT(godot::vformat(
-        "CamBANGServer: start_stream rejected by provider for stream_id=%d; status=%s.",
-        static_cast<int64_t>(stream_id),
-        try_start_stream_status_name(status)));
+  return godot::OK;
+}
+
+godot::Ref<CamBANGOperation> CamBANGServer::start_direct_stream_handle_async(
+    uint64_t stream_id,
+    const godot::String& hardware_id,
+    uint64_t device_instance_id) {
+  const godot::Error invalid = _validate_direct_stream_handle_(stream_id, hardware_id, device_instance_id);
+  if (invalid != godot::OK) {
+    return _track_operation_(CoreOperation(), invalid);
   }
-  return rc;
+  TryStartStreamStatus status = TryStartStreamStatus::Busy;
+  const CoreOperation op = runtime_.start_stream_async(stream_id, &status);
+  report_start_stream_rejection(status, stream_id, device_instance_id);
+  return _track_operation_(op, map_try_start_stream_status(status));
+}
+
+godot::Ref<CamBANGOperation> CamBANGServer::stop_direct_stream_handle_async(
+    uint64_t stream_id,
+    const godot::String& hardware_id,
+    uint64_t device_instance_id) {
+  const godot::Error invalid = _validate_direct_stream_handle_(stream_id, hardware_id, device_instance_id);
+  if (invalid != godot::OK) {
+    return _track_operation_(CoreOperation(), invalid);
+  }
+  TryStopStreamStatus status = TryStopStreamStatus::Busy;
+  const CoreOperation op = runtime_.stop_stream_async(stream_id, &status);
+  return _track_operation_(op, map_try_stop_stream_status(status));
 }
 
 godot::Error CamBANGServer::stop_direct_stream_handle(
@@ -2220,6 +2618,7 @@ void CamBANGServer::register_tracked_device_wrapper_(uint64_t wrapper_object_id)
     tracked_device_wrapper_object_ids_.erase(wrapper_object_id);
     return;
   }
+  _index_tracked_device_wrapper_(wrapper_object_id, *device);
   device->_set_live_from_server_(
       _is_device_live_by_identity_(device->get_hardware_id(), device->get_instance_id()));
 }
@@ -2235,6 +2634,7 @@ void CamBANGServer::register_tracked_stream_wrapper_(uint64_t wrapper_object_id)
     tracked_stream_wrapper_object_ids_.erase(wrapper_object_id);
     return;
   }
+  _index_tracked_stream_wrapper_(wrapper_object_id, *stream);
   stream->_set_result_live_from_server_(
       _is_stream_result_live_by_identity_(stream->get_stream_id()));
 }
@@ -2275,7 +2675,110 @@ bool CamBANGServer::_is_stream_result_live_by_identity_(uint64_t stream_id) cons
   return false;
 }
 
-void CamBANGServer::_refresh_tracked_wrapper_live_states_from_snapshot_() {
+void CamBANGServer::_index_tracked_device_wrapper_(uint64_t wrapper_object_id, const CamBANGDevice& device) {
+  std::vector<uint64_t>* ids = nullptr;
+  const godot::String hardware_id = device.get_hardware_id();
+  if (!hardware_id.is_empty()) {
+    ids = &tracked_device_wrappers_by_hardware_id_[std::string(hardware_id.utf8().get_data())];
+  } else if (const uint64_t device_instance_id = device.get_instance_id(); device_instance_id != 0) {
+    ids = &tracked_device_wrappers_by_instance_id_[device_instance_id];
+  } else {
+    return;
+  }
+  if (std::find(ids->begin(), ids->end(), wrapper_object_id) == ids->end()) {
+    ids->push_back(wrapper_object_id);
+  }
+}
+
+void CamBANGServer::_index_tracked_stream_wrapper_(uint64_t wrapper_object_id, const CamBANGStream& stream) {
+  const uint64_t stream_id = stream.get_stream_id();
+  if (stream_id == 0) {
+    return;
+  }
+  std::vector<uint64_t>& ids = tracked_stream_wrappers_by_stream_id_[stream_id];
+  if (std::find(ids.begin(), ids.end(), wrapper_object_id) == ids.end()) {
+    ids.push_back(wrapper_object_id);
+  }
+}
+
+void CamBANGServer::_refresh_indexed_device_wrappers_(std::vector<uint64_t>& wrapper_object_ids) {
+  // By index: a live_changed handler may create (and index) wrappers.
+  for (size_t i = 0; i < wrapper_object_ids.size();) {
+    const uint64_t wrapper_object_id = wrapper_object_ids[i];
+    godot::Object* object = godot::ObjectDB::get_instance(wrapper_object_id);
+    CamBANGDevice* device = godot::Object::cast_to<CamBANGDevice>(object);
+    if (!device) {
+      tracked_device_wrapper_object_ids_.erase(wrapper_object_id);
+      wrapper_object_ids.erase(wrapper_object_ids.begin() + static_cast<std::ptrdiff_t>(i));
+      continue;
+    }
+    device->_set_live_from_server_(
+        _is_device_live_by_identity_(device->get_hardware_id(), device->get_instance_id()));
+    ++i;
+  }
+}
+
+void CamBANGServer::_refresh_indexed_stream_wrappers_(std::vector<uint64_t>& wrapper_object_ids) {
+  // By index: a live_changed handler may create (and index) wrappers.
+  for (size_t i = 0; i < wrapper_object_ids.size();) {
+    const uint64_t wrapper_object_id = wrapper_object_ids[i];
+    godot::Object* object = godot::ObjectDB::get_instance(wrapper_object_id);
+    CamBANGStream* stream = godot::Object::cast_to<CamBANGStream>(object);
+    if (!stream) {
+      tracked_stream_wrapper_object_ids_.erase(wrapper_object_id);
+      wrapper_object_ids.erase(wrapper_object_ids.begin() + static_cast<std::ptrdiff_t>(i));
+      continue;
+    }
+    stream->_set_result_live_from_server_(
+        _is_stream_result_live_by_identity_(stream->get_stream_id()));
+    ++i;
+  }
+}
+
+void CamBANGServer::_refresh_tracked_wrapper_live_states_from_snapshot_(
+    const CamBANGStateSnapshot* prior,
+    const CamBANGStateSnapshotDelta& delta) {
+  if (prior != nullptr) {
+    auto refresh_device = [this](const std::string& hardware_id, uint64_t device_instance_id) {
+      if (const auto it = tracked_device_wrappers_by_hardware_id_.find(hardware_id);
+          it != tracked_device_wrappers_by_hardware_id_.end()) {
+        _refresh_indexed_device_wrappers_(it->second);
+      }
+      if (const auto it = tracked_device_wrappers_by_instance_id_.find(device_instance_id);
+          it != tracked_device_wrappers_by_instance_id_.end()) {
+        _refresh_indexed_device_wrappers_(it->second);
+      }
+    };
+    for (const DeviceState& device : delta.devices_changed) {
+      refresh_device(device.hardware_id, device.instance_id);
+    }
+    for (uint64_t device_instance_id : delta.devices_removed) {
+      for (const DeviceState& device : prior->devices) {
+        if (device.instance_id == device_instance_id) {
+          refresh_device(device.hardware_id, device_instance_id);
+          break;
+        }
+      }
+    }
+    auto refresh_stream = [this](uint64_t stream_id) {
+      if (const auto it = tracked_stream_wrappers_by_stream_id_.find(stream_id);
+          it != tracked_stream_wrappers_by_stream_id_.end()) {
+        _refresh_indexed_stream_wrappers_(it->second);
+      }
+    };
+    for (const StreamState& stream : delta.streams_changed) {
+      refresh_stream(stream.stream_id);
+    }
+    for (uint64_t stream_id : delta.streams_removed) {
+      refresh_stream(stream_id);
+    }
+    return;
+  }
+
+  // First publish of a gen: refresh every wrapper and rebuild the indexes.
+  tracked_device_wrappers_by_hardware_id_.clear();
+  tracked_device_wrappers_by_instance_id_.clear();
+  tracked_stream_wrappers_by_stream_id_.clear();
   for (auto it = tracked_device_wrapper_object_ids_.begin();
        it != tracked_device_wrapper_object_ids_.end();) {
     godot::Object* object = godot::ObjectDB::get_instance(*it);
@@ -2284,6 +2787,7 @@ void CamBANGServer::_refresh_tracked_wrapper_live_states_from_snapshot_() {
       it = tracked_device_wrapper_object_ids_.erase(it);
       continue;
     }
+    _index_tracked_device_wrapper_(*it, *device);
     device->_set_live_from_server_(
         _is_device_live_by_identity_(device->get_hardware_id(), device->get_instance_id()));
     ++it;
@@ -2297,6 +2801,7 @@ void CamBANGServer::_refresh_tracked_wrapper_live_states_from_snapshot_() {
       it = tracked_stream_wrapper_object_ids_.erase(it);
       continue;
     }
+    _index_tracked_stream_wrapper_(*it, *stream);
     stream->_set_result_live_from_server_(
         _is_stream_result_live_by_identity_(stream->get_stream_id()));
     ++it;
@@ -2391,32 +2896,112 @@ godot::Ref<CamBANGStreamResult> CamBANGServer::get_stream_result_by_stream_id(ui
   if (!is_public_boundary_ready_()) {
     return godot::Ref<CamBANGStreamResult>();
   }
-  SharedStreamResultData data = runtime_.get_latest_stream_result(stream_id);
-  if (!data) {
-    return godot::Ref<CamBANGStreamResult>();
-  }
-  godot::Ref<CamBANGStreamResult> out;
-  out.instantiate();
-  out->set_data(std::move(data));
-  return out;
+  return wrap_stream_result_(stream_id, runtime_.get_latest_stream_result(stream_id));
 }
 
-godot::Ref<CamBANGCaptureResult> CamBANGServer::get_capture_result_by_id(uint64_t capture_id, uint64_t device_instance_id) const {
+godot::Dictionary CamBANGServer::get_stream_results_by_stream_ids(
+    const godot::PackedInt64Array& stream_ids) const {
+  godot::Dictionary out;
   if (!is_public_boundary_ready_()) {
-    return godot::Ref<CamBANGCaptureResult>();
+    return out;
   }
-  SharedCaptureResultData data = runtime_.get_capture_result(capture_id, device_instance_id);
-  if (!data) {
-    return godot::Ref<CamBANGCaptureResult>();
+  for (int64_t i = 0; i < stream_ids.size(); ++i) {
+    const uint64_t stream_id = static_cast<uint64_t>(stream_ids[i]);
+    if (stream_id == 0 || out.has(stream_ids[i])) {
+      continue;
+    }
+    SharedStreamResultData data = runtime_.get_latest_stream_result(stream_id);
+    if (!data) {
+      issued_stream_result_wrappers_.erase(stream_id);
+      continue;
+    }
+    if (stream_result_changed_since_issued_(stream_id, data)) {
+      out[stream_ids[i]] = wrap_stream_result_(stream_id, std::move(data));
+    }
   }
-  godot::Ref<CamBANGCaptureResult> out;
-  out.instantiate();
-  out->set_data(std::move(data));
-  out->set_server(const_cast<CamBANGServer*>(this));
   return out;
 }
 
-godot::TypedArray<CamBANGCaptureResult> CamBANGServer::get_capture_result_set_by_id(uint64_t capture_id) const {
+int64_t CamBANGServer::get_stream_result_revision() const {
+  return static_cast<int64_t>(runtime_.stream_result_revision());
+}
+
+int64_t CamBANGServer::get_capture_result_revision() const {
+  return static_cast<int64_t>(runtime_.capture_result_revision());
+}
+
+bool CamBANGServer::stream_result_changed_since_issued_(uint64_t stream_id,
+                                                         const SharedStreamResultData& data) const {
+  const auto it = issued_stream_result_wrappers_.find(stream_id);
+  return it == issued_stream_result_wrappers_.end() || it->second.wrapper_object_id == 0 ||
+         it->second.data.lock() != data;
+}
+
+godot::Error CamBANGServer::set_stream_jitter_buffer_latency_usec(uint64_t stream_id, int64_t latency_usec) {
+  if (stream_id == 0 || latency_usec < 0) {
+    return godot::ERR_INVALID_PARAMETER;
+  }
+  runtime_.set_stream_jitter_buffer_latency(stream_id, static_cast<uint64_t>(latency_usec) * 1000ull);
+  return godot::OK;
+}
+
+godot::Error CamBANGServer::set_stream_display_only(uint64_t stream_id, bool enabled) {
+  if (stream_id == 0) {
+    return godot::ERR_INVALID_PARAMETER;
+  }
+  runtime_.set_stream_display_only(stream_id, enabled);
+  return godot::OK;
+}
+
+godot::Ref<CamBANGStreamResult> CamBANGServer::get_stream_result_for_display_by_stream_id(
+    uint64_t stream_id,
+    int64_t display_delay_usec) const {
+  if (!is_public_boundary_ready_()) {
+    return godot::Ref<CamBANGStreamResult>();
+  }
+  const uint64_t delay_ns = display_delay_usec > 0 ? static_cast<uint64_t>(display_delay_usec) * 1000ull : 0;
+  return wrap_stream_result_(stream_id, runtime_.get_stream_result_for_display(stream_id, delay_ns));
+}
+
+godot::Ref<CamBANGStreamResult> CamBANGServer::wrap_stream_result_(uint64_t stream_id,
+                                                                   SharedStreamResultData data) const {
+  if (!data) {
+    issued_stream_result_wrappers_.erase(stream_id);
+    return godot::Ref<CamBANGStreamResult>();
+  }
+  IssuedStreamResultWrapper& issued = issued_stream_result_wrappers_[stream_id];
+  if (issued.wrapper_object_id != 0 && issued.data.lock() == data) {
+    // Results are immutable, so a live wrapper of this one is as good as new.
+    CamBANGStreamResult* wrapper = godot::Object::cast_to<CamBANGStreamResult>(
+        godot::ObjectDB::get_instance(issued.wrapper_object_id));
+    if (wrapper) {
+      return godot::Ref<CamBANGStreamResult>(wrapper);
+    }
+  }
+  godot::Ref<CamBANGStreamResult> out;
+  out.instantiate();
+  issued.data = data;
+  issued.wrapper_object_id = out->get_instance_id();
+  out->set_data(std::move(data));
+  return out;
+}
+
+godot::Ref<CamBANGCaptureResult> CamBANGServer::get_capture_result_by_id(uint64_t capture_id, uint64_t device_instance_id) const {
+  if (!is_public_boundary_ready_()) {
+    return godot::Ref<CamBANGCaptureResult>();
+  }
+  SharedCaptureResultData data = runtime_.get_capture_result(capture_id, device_instance_id);
+  if (!data) {
+    return godot::Ref<CamBANGCaptureResult>();
+  }
+  godot::Ref<CamBANGCaptureResult> out;
+  out.instantiate();
+  out->set_data(std::move(data));
+  out->set_server(const_cast<CamBANGServer*>(this));
+  return out;
+}
+
+godot::TypedArray<CamBANGCaptureResult> CamBANGServer::get_capture_result_set_by_id(uint64_t capture_id) const {
   godot::TypedArray<CamBANGCaptureResult> out;
   if (!is_public_boundary_ready_()) {
     return out;
@@ -2507,6 +3092,66 @@ godot::Error CamBANGServer::trigger_device_capture(
   return godot::OK;
 }
 
+godot::Ref<CamBANGOperation> CamBANGServer::trigger_device_capture_async(
+    uint64_t device_instance_id,
+    uint64_t& out_capture_id) {
+  out_capture_id = 0;
+  if (device_instance_id == 0 || !is_public_boundary_ready_()) {
+    return _track_operation_(CoreOperation(), godot::ERR_BUSY);
+  }
+
+  uint64_t capture_id = next_capture_id_.fetch_add(1, std::memory_order_relaxed);
+  if (capture_id == 0) {
+    capture_id = next_capture_id_.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  TryTriggerDeviceCaptureStatus status = TryTriggerDeviceCaptureStatus::Busy;
+  const CoreOperation op =
+      runtime_.trigger_device_capture_async_for_server(device_instance_id, capture_id, &status);
+  if (status == TryTriggerDeviceCaptureStatus::OK) {
+    latest_capture_id_by_device_instance_id_[device_instance_id] = capture_id;
+    out_capture_id = capture_id;
+  }
+  return _track_operation_(op, map_try_trigger_device_capture_status(status));
+}
+
+godot::Ref<CamBANGOperation> CamBANGServer::_track_operation_(const CoreOperation& op,
+                                                              godot::Error admission_error) {
+  godot::Ref<CamBANGOperation> handle;
+  handle.instantiate();
+  handle->_set_admission_error_from_server_(admission_error);
+  const uint64_t token = next_operation_token_++;
+  pending_operations_.emplace(token, handle);
+  // A refused command hands back an already-failed (or invalid, reporting
+  // Cancelled) operation; report it as the failure it is.
+  const bool refused = admission_error != godot::OK;
+  op.on_done([this, token, refused](CoreOperationOutcome outcome, uint32_t error_code) {
+    if (refused) {
+      outcome = CoreOperationOutcome::Failed;
+    }
+    std::lock_guard<std::mutex> lock(completed_operations_mu_);
+    completed_operations_.push_back(CompletedOperation{token, outcome, error_code});
+  });
+  return handle;
+}
+
+void CamBANGServer::_deliver_completed_operations_() {
+  std::vector<CompletedOperation> completed;
+  {
+    std::lock_guard<std::mutex> lock(completed_operations_mu_);
+    completed.swap(completed_operations_);
+  }
+  for (const CompletedOperation& c : completed) {
+    const auto it = pending_operations_.find(c.token);
+    if (it == pending_operations_.end()) {
+      continue;
+    }
+    const godot::Ref<CamBANGOperation> handle = it->second;
+    pending_operations_.erase(it);
+    handle->_resolve_from_server_(operation_outcome_to_int(c.outcome), c.error_code);
+  }
+}
+
 godot::Error CamBANGServer::set_device_still_capture_profile(
     uint64_t device_instance_id,
     const CaptureProfile& profile,
@@ -2638,6 +3283,19 @@ void CamBANGServer::_drain_pending_endpoint_startup_intents_after_baseline_() {
   }
   std::sort(keys.begin(), keys.end());
 
+  // Every pending engage and still profile goes to Core as one setup batch,
+  // so a scene engaging many endpoints costs one core slice and publish.
+  constexpr size_t kNoCommand = static_cast<size_t>(-1);
+  struct StartupDrainStep {
+    std::string key;
+    EndpointLifecycleState* engage_state = nullptr;
+    size_t open_index = kNoCommand;
+    size_t still_index = kNoCommand;
+  };
+  std::vector<StartupDrainStep> steps;
+  std::vector<SetupCommand> commands;
+  steps.reserve(keys.size());
+
   for (const std::string& key : keys) {
     auto it = pending_endpoint_startup_intents_.find(key);
     if (it == pending_endpoint_startup_intents_.end()) {
@@ -2653,8 +3311,12 @@ void CamBANGServer::_drain_pending_endpoint_startup_intents_after_baseline_() {
       continue;
     }
 
+    StartupDrainStep step;
+    step.key = key;
     if (intent.engage_requested && !intent.engage_applied) {
-      const godot::Error rc = engage_endpoint_handle(intent.hardware_id, intent.display_name);
+      SetupOpenDevice open;
+      const godot::Error rc =
+          _prepare_endpoint_engage_(intent.hardware_id, intent.display_name, open, step.engage_state);
       if (rc != godot::OK) {
         ERR_PRINT(godot::vformat(
             "CamBANGServer: pending startup engage for hardware_id=%s failed after baseline; err=%d reason=%s.",
@@ -2664,11 +3326,14 @@ void CamBANGServer::_drain_pending_endpoint_startup_intents_after_baseline_() {
         pending_endpoint_startup_intents_.erase(it);
         continue;
       }
-      intent.engage_applied = true;
+      if (step.engage_state != nullptr) {
+        step.open_index = commands.size();
+        commands.push_back(std::move(open));
+      }
     }
 
-    const uint64_t device_instance_id = resolve_endpoint_instance_id(intent.hardware_id);
     if (intent.has_still_profile && !intent.still_profile_applied) {
+      const uint64_t device_instance_id = resolve_endpoint_instance_id(intent.hardware_id);
       if (device_instance_id == 0) {
         ERR_PRINT(godot::vformat(
             "CamBANGServer: pending startup still profile for hardware_id=%s failed after baseline; no runtime device instance is available.",
@@ -2676,10 +3341,48 @@ void CamBANGServer::_drain_pending_endpoint_startup_intents_after_baseline_() {
         pending_endpoint_startup_intents_.erase(it);
         continue;
       }
-      const godot::Error rc = set_device_still_capture_profile(
-          device_instance_id,
-          intent.still_profile,
-          intent.still_image_bundle);
+      step.still_index = commands.size();
+      commands.push_back(SetupSetStillCaptureProfile{
+          device_instance_id, intent.still_profile, intent.still_image_bundle});
+    }
+    steps.push_back(std::move(step));
+  }
+
+  std::vector<SetupCommandStatus> statuses;
+  if (!commands.empty()) {
+    (void)runtime_.try_run_setup_batch(commands, statuses);
+  }
+  // Commands that did not run read as std::monostate below.
+  statuses.resize(commands.size());
+
+  for (const StartupDrainStep& step : steps) {
+    auto it = pending_endpoint_startup_intents_.find(step.key);
+    if (it == pending_endpoint_startup_intents_.end()) {
+      continue;
+    }
+    PendingEndpointStartupIntent& intent = it->second;
+
+    if (step.engage_state != nullptr) {
+      const auto* status = std::get_if<TryOpenDeviceStatus>(&statuses[step.open_index]);
+      const godot::Error rc =
+          _finish_endpoint_engage_(*step.engage_state, status ? *status : TryOpenDeviceStatus::Busy);
+      if (rc != godot::OK) {
+        ERR_PRINT(godot::vformat(
+            "CamBANGServer: pending startup engage for hardware_id=%s failed after baseline; err=%d reason=%s.",
+            intent.hardware_id,
+            static_cast<int>(rc),
+            godot_error_to_cstr(rc)));
+        pending_endpoint_startup_intents_.erase(it);
+        continue;
+      }
+    }
+    if (intent.engage_requested) {
+      intent.engage_applied = true;
+    }
+
+    if (step.still_index != kNoCommand) {
+      const auto* status = std::get_if<TrySetStillCaptureProfileStatus>(&statuses[step.still_index]);
+      const godot::Error rc = status ? map_try_set_still_capture_profile_status(*status) : godot::ERR_BUSY;
       if (rc != godot::OK) {
         ERR_PRINT(godot::vformat(
             "CamBANGServer: pending startup still profile for hardware_id=%s failed after baseline; err=%d reason=%s.",
@@ -2692,6 +3395,8 @@ void CamBANGServer::_drain_pending_endpoint_startup_intents_after_baseline_() {
       intent.still_profile_applied = true;
     }
 
+    const uint64_t device_instance_id = resolve_endpoint_instance_id(intent.hardware_id);
+
     if (intent.has_warm_policy) {
       if (device_instance_id == 0) {
         ERR_PRINT(godot::vformat(
@@ -2855,9 +3560,64 @@ void CamBANGServer::_on_godot_process_frame() {
   runtime_.check_core_thread_liveness();
 
   _on_godot_tick(delta_s);
+  _watch_memory_pressure_(now_ns);
   _drain_pending_stop_and_quit_();
 }
 
+namespace {
+constexpr uint64_t kMemoryPressureSampleIntervalNs = 1'000'000'000ull;
+// Pressure that persists is trimmed again no sooner than this.
+constexpr uint64_t kMemoryPressureRetrimIntervalNs = 30'000'000'000ull;
+// Available memory as a percentage of physical memory.
+constexpr int64_t kMemoryPressureModeratePercent = 10;
+constexpr int64_t kMemoryPressureCriticalPercent = 5;
+} // namespace
+
+void CamBANGServer::_watch_memory_pressure_(uint64_t now_ns) {
+  // Godot forwards no trim callback (Android onTrimMemory stays in Java), so
+  // low available memory stands in for it.
+  if (now_ns < memory_pressure_next_sample_ns_ || !runtime_.is_running()) {
+    return;
+  }
+  memory_pressure_next_sample_ns_ = now_ns + kMemoryPressureSampleIntervalNs;
+  godot::OS* os = godot::OS::get_singleton();
+  if (!os) {
+    return;
+  }
+  const godot::Dictionary info = os->get_memory_info();
+  const int64_t physical = static_cast<int64_t>(info.get("physical", -1));
+  const int64_t available = static_cast<int64_t>(info.get("available", -1));
+  if (physical <= 0 || available < 0) {
+    // Not reported on this platform.
+    return;
+  }
+  uint8_t pressure = 0;
+  if (available * 100 < physical * kMemoryPressureCriticalPercent) {
+    pressure = 2;
+  } else if (available * 100 < physical * kMemoryPressureModeratePercent) {
+    pressure = 1;
+  }
+  if (pressure == 0) {
+    memory_pressure_level_ = 0;
+    return;
+  }
+  if (pressure <= memory_pressure_level_ &&
+      now_ns - memory_pressure_last_trim_ns_ < kMemoryPressureRetrimIntervalNs) {
+    return;
+  }
+  memory_pressure_level_ = pressure;
+  memory_pressure_last_trim_ns_ = now_ns;
+
+  const MemoryTrimLevel level = (pressure == 2) ? MemoryTrimLevel::Critical : MemoryTrimLevel::Moderate;
+  const uint64_t runtime_released = runtime_.trim_memory(level);
+  const uint64_t image_cache_released = clear_payload_image_cache();
+  image_cache_trim_bytes_released_ += image_cache_released;
+  godot::UtilityFunctions::print_verbose(
+      "[CamBANG] memory pressure trim level=", (pressure == 2) ? "critical" : "moderate",
+      " available_bytes=", available,
+      " released_bytes=", static_cast<int64_t>(runtime_released + image_cache_released));
+}
+
 bool CamBANGServer::_consume_latest_core_snapshot() {
   const uint64_t published_seq = runtime_.published_seq();
   if (published_seq == last_seen_published_seq_) {
@@ -2928,22 +3688,81 @@ bool CamBANGServer::_consume_latest_core_snapshot() {
     }
   }
 
+  std::shared_ptr<const CamBANGStateSnapshot> prior = std::move(latest_);
+  if (prior && prior->gen != snap->gen) {
+    prior.reset();
+  }
+  // Against the last emitted snapshot of this gen, so the ids cover every
+  // core publish coalesced into this tick; the first publish of a gen
+  // reports each of its records as changed.
+  static const CamBANGStateSnapshot kEmptySnapshot{};
+  const CamBANGStateSnapshotDelta delta = compute_snapshot_delta(prior ? *prior : kEmptySnapshot, *snap);
+  if (!prior) {
+    state_summary_.clear();
+  }
+  if (!state_summary_.apply(delta)) {
+    state_summary_.reset(*snap);
+  }
   latest_ = snap;
   _reconcile_endpoint_lifecycle_from_snapshot(*snap);
 
-  // Export as a struct-like Variant graph for Godot inspection.
-  latest_export_ = export_snapshot_to_godot(*snap, godot_gen_, godot_version_, godot_topology_version_);
+  // Exported for Godot inspection on demand (get_state_snapshot()).
   has_latest_export_ = true;
-  _refresh_tracked_wrapper_live_states_from_snapshot_();
+  latest_export_pending_ = true;
+  state_summary_export_pending_ = true;
+  _refresh_tracked_wrapper_live_states_from_snapshot_(prior.get(), delta);
 
   emit_signal("state_published",
               static_cast<uint64_t>(godot_gen_),
               static_cast<uint64_t>(godot_version_),
               static_cast<uint64_t>(godot_topology_version_));
+  emit_signal("state_changed", _build_state_changes_(prior.get(), *snap, delta));
 
   return true;
 }
 
+static godot::PackedInt64Array to_packed_ids(const std::vector<uint64_t>& ids) {
+  godot::PackedInt64Array out;
+  out.resize(static_cast<int64_t>(ids.size()));
+  for (size_t i = 0; i < ids.size(); ++i) {
+    out.set(static_cast<int64_t>(i), static_cast<int64_t>(ids[i]));
+  }
+  return out;
+}
+
+template <typename Record, typename IdOf>
+static godot::PackedInt64Array to_packed_record_ids(const std::vector<Record>& records, IdOf id_of) {
+  godot::PackedInt64Array out;
+  out.resize(static_cast<int64_t>(records.size()));
+  for (size_t i = 0; i < records.size(); ++i) {
+    out.set(static_cast<int64_t>(i), static_cast<int64_t>(id_of(records[i])));
+  }
+  return out;
+}
+
+godot::Dictionary CamBANGServer::_build_state_changes_(const CamBANGStateSnapshot* prior,
+                                                        const CamBANGStateSnapshot& snap,
+                                                        const CamBANGStateSnapshotDelta& delta) const {
+  godot::Dictionary out;
+  out["gen"] = static_cast<int64_t>(godot_gen_);
+  out["version"] = static_cast<int64_t>(godot_version_);
+  out["topology_version"] = static_cast<int64_t>(godot_topology_version_);
+  out["baseline"] = prior == nullptr;
+  // Core snapshot versions this emission covers: (core_from_version,
+  // core_version]. Intermediate core publishes were coalesced away.
+  out["core_from_version"] = prior ? static_cast<int64_t>(prior->version) : int64_t{-1};
+  out["core_version"] = static_cast<int64_t>(snap.version);
+  out["rigs_changed"] = to_packed_record_ids(delta.rigs_changed, [](const RigState& r) { return r.rig_id; });
+  out["rigs_removed"] = to_packed_ids(delta.rigs_removed);
+  out["devices_changed"] =
+      to_packed_record_ids(delta.devices_changed, [](const DeviceState& d) { return d.instance_id; });
+  out["devices_removed"] = to_packed_ids(delta.devices_removed);
+  out["streams_changed"] =
+      to_packed_record_ids(delta.streams_changed, [](const StreamState& st) { return st.stream_id; });
+  out["streams_removed"] = to_packed_ids(delta.streams_removed);
+  return out;
+}
+
 void CamBANGServer::_reconcile_endpoint_lifecycle_from_snapshot(const CamBANGStateSnapshot& snap) {
   if (endpoint_lifecycle_by_hardware_id_.empty()) {
     return;
@@ -3000,6 +3819,7 @@ void CamBANGServer::_on_godot_tick(double delta) {
     // wrappers that are refreshed from latest retained stream state each tick.
     CamBANGStreamResult::refresh_live_stream_cpu_display_views(runtime_);
     synthetic_gpu_backing_drain_pending_live_display_wrapper_refreshes();
+    synthetic_gpu_backing_begin_render_release_tick();
   }
 
   std::string timeline_line;
@@ -3028,7 +3848,8 @@ void CamBANGServer::_on_godot_tick(double delta) {
     return backing_plan_reports;
   };
 
-  if (_consume_latest_core_snapshot()) {
+  const bool consumed_snapshot = _consume_latest_core_snapshot();
+  if (consumed_snapshot) {
     _drain_pending_endpoint_startup_intents_after_baseline_();
     _drain_pending_scenario_start_after_baseline_();
     _arm_live_retained_result_access_calibration_from_snapshot_(
@@ -3037,10 +3858,24 @@ void CamBANGServer::_on_godot_tick(double delta) {
   } else if (!pending_endpoint_startup_intents_.empty()) {
     _drain_pending_endpoint_startup_intents_after_baseline_();
   }
-  const auto& backing_reports = ensure_backing_plan_reports();
-  _observe_active_stream_evaluation_calibration_identities_(now_ns, backing_reports);
-  _observe_active_capture_evaluation_calibration_identities_(now_ns, backing_reports);
+  // Calibration identities only move with a new snapshot or a new retained
+  // result, so a tick with neither skips the report round trip to the core
+  // thread and the per-stream result reads: idle streams cost nothing here.
+  const uint64_t stream_result_revision = runtime_.stream_result_revision();
+  const uint64_t capture_result_revision = runtime_.capture_result_revision();
+  if (consumed_snapshot ||
+      stream_result_revision != last_observed_stream_result_revision_ ||
+      capture_result_revision != last_observed_capture_result_revision_) {
+    last_observed_stream_result_revision_ = stream_result_revision;
+    last_observed_capture_result_revision_ = capture_result_revision;
+    const auto& backing_reports = ensure_backing_plan_reports();
+    _observe_active_stream_evaluation_calibration_identities_(now_ns, backing_reports);
+    _observe_active_capture_evaluation_calibration_identities_(now_ns, backing_reports);
+  }
   _process_armed_live_retained_result_access_calibration_(now_ns);
+  // After the snapshot drain, so a completed engage or start is already
+  // reflected in the wrappers' live state when its signal fires.
+  _deliver_completed_operations_();
 }
 
 void CamBANGServer::_clear_live_retained_result_access_calibration_state_() {
@@ -3125,7 +3960,8 @@ void CamBANGServer::_arm_live_retained_result_access_calibration_from_snapshot_(
     const auto completed_it =
         completed_live_stream_retained_result_calibrations_.find(stream.stream_id);
     if (completed_it != completed_live_stream_retained_result_calibrations_.end() &&
-        same_stream_identity(completed_it->second, result)) {
+        same_stream_identity(completed_it->second, result) &&
+        now_ns < completed_it->second.resample_after_ns) {
       continue;
     }
     pending_live_stream_retained_result_calibrations_[stream.stream_id] = armed;
@@ -3162,6 +3998,18 @@ void CamBANGServer::_arm_live_retained_result_access_calibration_from_snapshot_(
                armed.member_identity_signature ==
                    build_capture_member_identity_signature(data);
       };
+  // A new capture in the postures the device last measured reuses that
+  // measurement until the window closes.
+  const auto inherit_capture_sampling_window =
+      [this](ArmedLiveCaptureRetainedResultCalibration& armed,
+             const auto& completed_it) noexcept {
+        if (completed_it !=
+                completed_live_capture_retained_result_calibrations_.end() &&
+            completed_it->second.member_posture_signature ==
+                armed.member_posture_signature) {
+          armed.resample_after_ns = completed_it->second.resample_after_ns;
+        }
+      };
   for (const AcquisitionSessionState& session : latest_->acquisition_sessions) {
     if (session.last_capture_id == 0 || session.device_instance_id == 0) {
       continue;
@@ -3182,6 +4030,8 @@ void CamBANGServer::_arm_live_retained_result_access_calibration_from_snapshot_(
     armed.acquisition_session_id = result->acquisition_session_id;
     armed.member_identity_signature =
         build_capture_member_identity_signature(result);
+    armed.member_posture_signature =
+        build_capture_member_posture_signature(result);
     bool needs_settle_delay = false;
     for (uint32_t i = 0; i < result->image_member_count(); ++i) {
       const auto* member = result->image_member_at(i);
@@ -3206,6 +4056,7 @@ void CamBANGServer::_arm_live_retained_result_access_calibration_from_snapshot_(
         same_capture_identity(completed_it->second, result, armed.evaluation_identity)) {
       continue;
     }
+    inherit_capture_sampling_window(armed, completed_it);
     pending_live_capture_retained_result_calibrations_[session.device_instance_id] =
         armed;
     completed_live_capture_retained_result_calibrations_.erase(
@@ -3228,6 +4079,8 @@ void CamBANGServer::_arm_live_retained_result_access_calibration_from_snapshot_(
       armed.acquisition_session_id = result->acquisition_session_id;
       armed.member_identity_signature =
           build_capture_member_identity_signature(result);
+      armed.member_posture_signature =
+          build_capture_member_posture_signature(result);
       bool needs_settle_delay = false;
       for (uint32_t i = 0; i < result->image_member_count(); ++i) {
         const auto* member = result->image_member_at(i);
@@ -3257,6 +4110,7 @@ void CamBANGServer::_arm_live_retained_result_access_calibration_from_snapshot_(
           same_capture_identity(completed_it->second, result, armed.evaluation_identity)) {
         continue;
       }
+      inherit_capture_sampling_window(armed, completed_it);
       pending_live_capture_retained_result_calibrations_[result->device_instance_id] =
           armed;
       completed_live_capture_retained_result_calibrations_.erase(
@@ -3567,19 +4421,35 @@ void CamBANGServer::_process_armed_live_retained_result_access_calibration_(
                armed.display_view == data->retained_access_truth.display_view &&
                armed.to_image == data->retained_access_truth.to_image;
       };
+  // Entries left over when the budget runs out stay pending for the next tick.
+  bool measured_this_tick = false;
+  const auto frame_budget_spent = [&]() {
+    return measured_this_tick &&
+           static_cast<uint64_t>(
+               std::chrono::duration_cast<std::chrono::nanoseconds>(
+                   std::chrono::steady_clock::now() - metrics_t0)
+                   .count()) >= kLiveRetainedCalibrationFrameBudgetNs;
+  };
   for (auto it = pending_live_stream_retained_result_calibrations_.begin();
        it != pending_live_stream_retained_result_calibrations_.end();) {
     if (now_ns < it->second.due_after_ns) {
       ++it;
       continue;
     }
+    if (frame_budget_spent()) {
+      break;
+    }
     SharedStreamResultData result = runtime_.get_latest_stream_result(it->first);
     if (!same_stream_identity(it->second, result)) {
       it = pending_live_stream_retained_result_calibrations_.erase(it);
       continue;
     }
     retained_result_access_calibration::calibrate_stream_result(result, &runtime_);
-    completed_live_stream_retained_result_calibrations_[it->first] = it->second;
+    measured_this_tick = true;
+    ArmedLiveStreamRetainedResultCalibration& completed =
+        completed_live_stream_retained_result_calibrations_[it->first];
+    completed = it->second;
+    completed.resample_after_ns = now_ns + kLiveRetainedCalibrationResampleIntervalNs;
     it = pending_live_stream_retained_result_calibrations_.erase(it);
   }
 
@@ -3601,6 +4471,11 @@ void CamBANGServer::_process_armed_live_retained_result_access_calibration_(
       ++it;
       continue;
     }
+    const bool sampled = now_ns >= it->second.resample_after_ns;
+    if (sampled && frame_budget_spent()) {
+      ++it;
+      continue;
+    }
     SharedCaptureResultData result =
         runtime_.get_capture_result(it->second.capture_id, it->first);
     if (!same_capture_identity(
@@ -3608,9 +4483,15 @@ void CamBANGServer::_process_armed_live_retained_result_access_calibration_(
       it = pending_live_capture_retained_result_calibrations_.erase(it);
       continue;
     }
-    retained_result_access_calibration::calibrate_capture_result(result, &runtime_);
-    completed_live_capture_retained_result_calibrations_[it->first] =
-        it->second;
+    ArmedLiveCaptureRetainedResultCalibration completed = it->second;
+    if (sampled) {
+      retained_result_access_calibration::calibrate_capture_result(result, &runtime_);
+      measured_this_tick = true;
+      completed.resample_after_ns = now_ns + kLiveRetainedCalibrationResampleIntervalNs;
+    } else {
+      retained_result_access_calibration::report_capture_result_observation(result, &runtime_);
+    }
+    completed_live_capture_retained_result_calibrations_[it->first] = completed;
     it = pending_live_capture_retained_result_calibrations_.erase(it);
   }
   const uint64_t elapsed_ns = static_cast<uint64_t>(
@@ -3659,9 +4540,25 @@ godot::Variant CamBANGServer::get_state_snapshot() const {
   if (!has_latest_export_) {
     return godot::Variant();
   }
+  if (latest_export_pending_) {
+    latest_export_ = export_cache_.export_snapshot(*latest_, godot_gen_, godot_version_, godot_topology_version_);
+    latest_export_pending_ = false;
+  }
   return latest_export_;
 }
 
+godot::Variant CamBANGServer::get_state_summary() const {
+  if (!has_latest_export_) {
+    return godot::Variant();
+  }
+  if (state_summary_export_pending_) {
+    state_summary_export_ =
+        export_state_summary_to_godot(state_summary_.summary(), godot_gen_, godot_version_, godot_topology_version_);
+    state_summary_export_pending_ = false;
+  }
+  return state_summary_export_;
+}
+
 
 godot::Variant CamBANGServer::get_backing_plan_evaluation_diagnostics() const {
   if (!runtime_.is_running()) {
@@ -3687,6 +4584,89 @@ godot::Variant CamBANGServer::get_backing_plan_evaluation_diagnostics() const {
   return godot::Variant(evaluation_reports);
 }
 
+godot::Variant CamBANGServer::get_frame_latency_trace_diagnostics() const {
+  if (!runtime_.is_running()) {
+    return godot::Variant();
+  }
+  const std::string json = frame_latency_trace_chrome_json();
+  return godot::Variant(godot::String(json.c_str()));
+}
+
+godot::Variant CamBANGServer::get_core_thread_timing_diagnostics() const {
+  if (!runtime_.is_running()) {
+    return godot::Variant();
+  }
+  const CoreTaskTimingStats timing = runtime_.stats_copy().task_timing;
+  const auto histogram_to_dictionary = [](const CoreLatencyHistogram& h) {
+    godot::Dictionary d;
+    d["count"] = static_cast<uint64_t>(h.count);
+    d["total_ns"] = static_cast<uint64_t>(h.total_ns);
+    d["max_ns"] = static_cast<uint64_t>(h.max_ns);
+    godot::Array buckets;
+    for (const uint64_t n : h.buckets) {
+      buckets.append(static_cast<uint64_t>(n));
+    }
+    d["buckets"] = buckets;
+    return d;
+  };
+  godot::Dictionary out;
+  godot::Array bucket_upper_ns;
+  for (size_t b = 0; b < CoreLatencyHistogram::kBuckets; ++b) {
+    bucket_upper_ns.append(static_cast<uint64_t>(CoreLatencyHistogram::bucket_upper_ns(b)));
+  }
+  out["bucket_upper_ns"] = bucket_upper_ns;
+  for (size_t k = 0; k < kCoreTaskKindCount; ++k) {
+    godot::Dictionary kind;
+    kind["queue_wait"] = histogram_to_dictionary(timing.queue_wait[k]);
+    kind["exec"] = histogram_to_dictionary(timing.exec[k]);
+    out[to_string(static_cast<CoreTaskKind>(k))] = kind;
+  }
+  return godot::Variant(out);
+}
+
+void CamBANGServer::sample_performance_counters_(CamBANGPerformanceCounters& out) const {
+  out = CamBANGPerformanceCounters{};
+  out.runtime_running = runtime_.is_running();
+  if (!out.runtime_running) {
+    return;
+  }
+  const CoreRuntime::Stats stats = runtime_.stats_copy();
+  for (CoreTaskKind kind : {CoreTaskKind::ESSENTIAL, CoreTaskKind::COMMAND, CoreTaskKind::ORDINARY,
+                            CoreTaskKind::TIMER_TICK}) {
+    out.core_exec_ns += stats.task_timing.exec[static_cast<size_t>(kind)].total_ns;
+  }
+  const CoreLatencyHistogram& ordinary_wait =
+      stats.task_timing.queue_wait[static_cast<size_t>(CoreTaskKind::ORDINARY)];
+  out.core_ordinary_waits = ordinary_wait.count;
+  out.core_ordinary_wait_ns = ordinary_wait.total_ns;
+  out.publish_requests_coalesced = stats.publish_requests_coalesced;
+
+  const ProviderCallbackIngress::Stats ingress = runtime_.ingress_stats_copy();
+  out.ingress_frames_dropped = ingress.frames_dropped_full + ingress.frames_dropped_closed +
+                               ingress.frames_dropped_allocfail + ingress.frames_dropped_fair_share;
+  out.ingress_frames_coalesced = ingress.frames_coalesced_latest_wins;
+
+  if (latest_) {
+    for (const StreamState& stream : latest_->streams) {
+      out.frames_received += stream.frames_received;
+      out.frames_dropped += stream.frames_dropped;
+    }
+  }
+
+  if (const ProviderBroker* broker = dynamic_cast<const ProviderBroker*>(provider_.get())) {
+    SyntheticMetricsSnapshot snap{};
+    if (broker->get_synthetic_metrics_snapshot_for_host(snap)) {
+      out.synthetic_frames_emitted = snap.total_emitted_frames;
+      out.synthetic_frame_render_ms = snap.frame_render_total_ms;
+      out.synthetic_pattern_overlay_ms = snap.pattern_overlay_total_ms;
+      out.synthetic_gpu_update_ms = snap.gpu_update_total_total_ms;
+    }
+  }
+
+  CamBANGStreamResult::get_live_stream_cpu_display_refresh_totals(
+      out.cpu_display_refreshes, out.cpu_display_refresh_ns);
+}
+
 godot::Variant CamBANGServer::get_synthetic_metrics_snapshot() const {
   if (!runtime_.is_running()) {
     return godot::Variant();
@@ -3744,6 +4724,16 @@ godot::Variant CamBANGServer::get_synthetic_metrics_snapshot() const {
   d["gpu_texture_update_total_ms"] = snap.gpu_texture_update_total_ms;
   d["catchup_ticks_capped"] = static_cast<uint64_t>(snap.catchup_ticks_capped);
   d["catchup_frames_dropped"] = static_cast<uint64_t>(snap.catchup_frames_dropped);
+  d["congested_frames_skipped"] = static_cast<uint64_t>(snap.congested_frames_skipped);
+  const CBThreadPolicyStats thread_policy = thread_policy_stats();
+  d["thread_policy_applied"] = thread_policy.applied;
+  d["thread_policy_refused"] = thread_policy.refused;
+  const CoreRuntime::Stats runtime_stats = runtime_.stats_copy();
+  d["memory_trims"] = runtime_stats.memory_trims;
+  d["memory_trim_bytes_released"] = runtime_stats.memory_trim_bytes_released + image_cache_trim_bytes_released_;
+  d["stream_qos_level"] = runtime_stats.stream_qos_level;
+  d["stream_qos_level_changes"] = runtime_stats.stream_qos_level_changes;
+  d["stream_qos_reconfigurations"] = runtime_stats.stream_qos_reconfigurations;
   godot::Dictionary stream_result_revisions;
   if (latest_) {
     for (const StreamState& stream : latest_->streams) {
@@ -3871,34 +4861,142 @@ godot::Error CamBANGServer::load_external_scenario(const godot::String& json_tex
   return map_provider_result_to_godot_error(pr);
 }
 
-godot::Error CamBANGServer::ingest_camera_description(
-    const godot::String& json_text) {
-  const std::string text_utf8 = json_text.utf8().get_data();
-  const CoreRuntime::ReplaceExternalCameraDescriptionResult result =
-      runtime_.replace_external_camera_description_json_for_internal(text_utf8);
+static godot::Error map_replace_external_camera_description_result(
+    const char* method,
+    const CoreRuntime::ReplaceExternalCameraDescriptionResult& result) {
   switch (result.status) {
     case CoreRuntime::ReplaceExternalCameraDescriptionStatus::Ok:
       return godot::OK;
     case CoreRuntime::ReplaceExternalCameraDescriptionStatus::Busy:
-      ERR_PRINT(
-          "CamBANGServer: ingest_camera_description rejected because the active runtime generation is immutable.");
+      ERR_PRINT(godot::vformat(
+          "CamBANGServer: %s rejected because the active runtime generation is immutable.",
+          method));
       return godot::ERR_BUSY;
     case CoreRuntime::ReplaceExternalCameraDescriptionStatus::ParseError:
       ERR_PRINT(godot::vformat(
-          "CamBANGServer: ingest_camera_description parse failed: %s.",
+          "CamBANGServer: %s parse failed: %s.",
+          method,
           result.error_message.c_str()));
       return godot::ERR_PARSE_ERROR;
     case CoreRuntime::ReplaceExternalCameraDescriptionStatus::Invalid:
       ERR_PRINT(godot::vformat(
-          "CamBANGServer: ingest_camera_description validation failed: %s.",
+          "CamBANGServer: %s validation failed: %s.",
+          method,
           result.error_message.c_str()));
       return godot::ERR_INVALID_DATA;
+    case CoreRuntime::ReplaceExternalCameraDescriptionStatus::IoError:
+      ERR_PRINT(godot::vformat(
+          "CamBANGServer: %s failed: %s.",
+          method,
+          result.error_message.c_str()));
+      return godot::ERR_FILE_CANT_OPEN;
   }
 
-  ERR_PRINT("CamBANGServer: ingest_camera_description returned unknown status.");
+  ERR_PRINT(godot::vformat("CamBANGServer: %s returned unknown status.", method));
   return godot::ERR_BUG;
 }
 
+godot::Error CamBANGServer::ingest_camera_description(
+    const godot::String& json_text) {
+  const std::string text_utf8 = json_text.utf8().get_data();
+  return map_replace_external_camera_description_result(
+      "ingest_camera_description",
+      runtime_.replace_external_camera_description_json_for_internal(text_utf8));
+}
+
+godot::Error CamBANGServer::ingest_camera_description_file(
+    const godot::String& path) {
+  godot::String global_path = path;
+  if (godot::ProjectSettings* settings = godot::ProjectSettings::get_singleton()) {
+    global_path = settings->globalize_path(path);
+  }
+  const std::string path_utf8 = global_path.utf8().get_data();
+  return map_replace_external_camera_description_result(
+      "ingest_camera_description_file",
+      runtime_.replace_external_camera_description_json_file_for_internal(path_utf8));
+}
+
+void CamBANGServer::set_stream_qos_enabled(bool enabled) {
+  runtime_.set_stream_qos_enabled(enabled);
+}
+
+bool CamBANGServer::is_stream_qos_enabled() const {
+  return runtime_.stream_qos_enabled();
+}
+
+godot::Error CamBANGServer::set_capture_spill(
+    int medium,
+    int64_t byte_budget,
+    const godot::String& directory) {
+  if (is_running()) {
+    ERR_PRINT("CamBANGServer: set_capture_spill rejected while running; call it before start().");
+    return godot::ERR_BUSY;
+  }
+  CoreCaptureSpillStore::Medium core_medium = CoreCaptureSpillStore::Medium::OFF;
+  switch (medium) {
+    case CAPTURE_SPILL_OFF: core_medium = CoreCaptureSpillStore::Medium::OFF; break;
+    case CAPTURE_SPILL_TEMP_FILE: core_medium = CoreCaptureSpillStore::Medium::TEMP_FILE; break;
+    case CAPTURE_SPILL_COMPRESSED_MEMORY: core_medium = CoreCaptureSpillStore::Medium::COMPRESSED_MEMORY; break;
+    default:
+      ERR_PRINT(godot::vformat("CamBANGServer: set_capture_spill unknown medium %d.", medium));
+      return godot::ERR_INVALID_PARAMETER;
+  }
+  if (byte_budget < 0 || (medium == CAPTURE_SPILL_TEMP_FILE && directory.is_empty())) {
+    ERR_PRINT("CamBANGServer: set_capture_spill requires a non-negative byte_budget, and a directory for CAPTURE_SPILL_TEMP_FILE.");
+    return godot::ERR_INVALID_PARAMETER;
+  }
+  std::filesystem::path spill_directory;
+  if (medium == CAPTURE_SPILL_TEMP_FILE) {
+    godot::String global_path = directory;
+    if (godot::ProjectSettings* settings = godot::ProjectSettings::get_singleton()) {
+      global_path = settings->globalize_path(directory);
+    }
+    const godot::CharString utf8 = global_path.utf8();
+    spill_directory = std::filesystem::path(
+        std::u8string(reinterpret_cast<const char8_t*>(utf8.get_data())));
+  }
+  if (!runtime_.set_capture_spill_medium(
+          core_medium, static_cast<uint64_t>(byte_budget), std::move(spill_directory))) {
+    return godot::ERR_BUSY;
+  }
+  return godot::OK;
+}
+
+godot::Error CamBANGServer::set_frame_shard_count(int shard_count) {
+  if (is_running()) {
+    ERR_PRINT("CamBANGServer: set_frame_shard_count rejected while running; call it before start().");
+    return godot::ERR_BUSY;
+  }
+  if (shard_count < 0 || static_cast<size_t>(shard_count) > CoreFrameShards::kMaxShards) {
+    ERR_PRINT(godot::vformat("CamBANGServer: set_frame_shard_count requires 0..%d.",
+                             static_cast<int>(CoreFrameShards::kMaxShards)));
+    return godot::ERR_INVALID_PARAMETER;
+  }
+  if (!runtime_.set_frame_shard_count(static_cast<size_t>(shard_count))) {
+    return godot::ERR_BUSY;
+  }
+  return godot::OK;
+}
+
+int CamBANGServer::get_frame_shard_count() const {
+  return static_cast<int>(runtime_.frame_shard_count());
+}
+
+godot::Error CamBANGServer::set_snapshot_publish_offload(bool enabled) {
+  if (is_running()) {
+    ERR_PRINT("CamBANGServer: set_snapshot_publish_offload rejected while running; call it before start().");
+    return godot::ERR_BUSY;
+  }
+  if (!runtime_.set_snapshot_publish_offload(enabled)) {
+    return godot::ERR_BUSY;
+  }
+  return godot::OK;
+}
+
+bool CamBANGServer::is_snapshot_publish_offload_enabled() const {
+  return runtime_.snapshot_publish_offload();
+}
+
 godot::Error CamBANGServer::set_capture_geolocation(
     const godot::Dictionary& geolocation) {
   if (geolocation.is_empty()) {
@@ -4134,6 +5232,117 @@ void CamBANGServer::_handle_timeline_teardown_trace_line(const std::string& line
   strict_scenario_unmet_logged_ = true;
 }
 
+bool CamBANGServer::_read_provider_broker_request_(
+    RuntimeMode mode,
+    SyntheticRole synthetic_role,
+    TimingDriver timing_driver,
+    ProviderBrokerRequest& out) {
+  out = ProviderBrokerRequest{};
+  out.mode = mode;
+  out.synthetic_role = synthetic_role;
+  out.timing_driver = timing_driver;
+  if (mode == RuntimeMode::synthetic) {
+    if (!apply_synthetic_producer_output_form_cmdline_to_project_setting()) {
+      ERR_PRINT("CamBANGServer: invalid duplicate or unsupported Synthetic producer output-form maintainer setting.");
+      return false;
+    }
+    if (!apply_synthetic_stream_capability_downgrade_cmdline_to_project_setting()) {
+      ERR_PRINT("CamBANGServer: invalid duplicate or unsupported Synthetic stream capability downgrade maintainer setting.");
+      return false;
+    }
+    if (!apply_synthetic_capture_capability_downgrade_cmdline_to_project_setting()) {
+      ERR_PRINT("CamBANGServer: invalid duplicate or unsupported Synthetic capture capability downgrade maintainer setting.");
+      return false;
+    }
+    if (!apply_replay_cmdline_to_project_settings()) {
+      ERR_PRINT("CamBANGServer: invalid duplicate or unsupported replay maintainer setting.");
+      return false;
+    }
+    if (!read_synthetic_producer_output_form_project_setting(out.producer_output_form_mode)) {
+      ERR_PRINT("CamBANGServer: invalid Synthetic producer output-form maintainer project setting.");
+      return false;
+    }
+    if (!read_synthetic_stream_capability_downgrade_project_setting(
+            out.stream_capability_downgrade_conditions)) {
+      ERR_PRINT("CamBANGServer: invalid Synthetic stream capability downgrade maintainer project setting.");
+      return false;
+    }
+    if (!read_synthetic_capture_capability_downgrade_project_setting(
+            out.capture_capability_downgrade_conditions)) {
+      ERR_PRINT("CamBANGServer: invalid Synthetic capture capability downgrade maintainer project setting.");
+      return false;
+    }
+    if (!read_replay_project_settings(out.replay)) {
+      ERR_PRINT("CamBANGServer: invalid replay maintainer project setting.");
+      return false;
+    }
+  }
+  out.reconciliation_applicable =
+      mode == RuntimeMode::synthetic &&
+      synthetic_role == SyntheticRole::Timeline &&
+      timing_driver == TimingDriver::VirtualTime;
+  out.timeline_reconciliation = completion_gated_destructive_sequencing_enabled_
+      ? TimelineReconciliation::CompletionGated
+      : TimelineReconciliation::Strict;
+  return true;
+}
+
+bool CamBANGServer::_apply_provider_broker_request_(ProviderBroker& broker, ProviderBrokerRequest request) {
+  ProviderResult sr = broker.set_runtime_mode_requested(request.mode);
+  if (!sr.ok()) {
+    ERR_PRINT(godot::vformat(
+        "CamBANGServer: provider_mode='%s' is not supported in this build.",
+        mode_to_cstr(request.mode)));
+    return false;
+  }
+  ProviderResult role_req = broker.set_synthetic_role_requested(request.synthetic_role);
+  if (!role_req.ok()) {
+    ERR_PRINT("CamBANGServer: requested synthetic role configuration rejected by provider broker.");
+    return false;
+  }
+  ProviderResult timing_req = broker.set_synthetic_timing_driver_requested(request.timing_driver);
+  if (!timing_req.ok()) {
+    ERR_PRINT("CamBANGServer: requested synthetic timing_driver configuration rejected by provider broker.");
+    return false;
+  }
+  if (request.mode == RuntimeMode::synthetic) {
+    ProviderResult output_form_req =
+        broker.set_synthetic_producer_output_form_mode_requested(request.producer_output_form_mode);
+    if (!output_form_req.ok()) {
+      ERR_PRINT("CamBANGServer: requested Synthetic producer output-form configuration rejected by provider broker.");
+      return false;
+    }
+    ProviderResult stream_downgrade_req =
+        broker.set_synthetic_stream_capability_downgrade_conditions_requested(
+            std::move(request.stream_capability_downgrade_conditions));
+    if (!stream_downgrade_req.ok()) {
+      ERR_PRINT("CamBANGServer: requested Synthetic stream capability downgrade configuration rejected by provider broker.");
+      return false;
+    }
+    ProviderResult capture_downgrade_req =
+        broker.set_synthetic_capture_capability_downgrade_conditions_requested(
+            std::move(request.capture_capability_downgrade_conditions));
+    if (!capture_downgrade_req.ok()) {
+      ERR_PRINT("CamBANGServer: requested Synthetic capture capability downgrade configuration rejected by provider broker.");
+      return false;
+    }
+    ProviderResult replay_req = broker.set_replay_requested(std::move(request.replay));
+    if (!replay_req.ok()) {
+      ERR_PRINT("CamBANGServer: requested replay configuration rejected by provider broker.");
+      return false;
+    }
+  }
+  if (request.reconciliation_applicable) {
+    ProviderResult recon_req =
+        broker.set_synthetic_timeline_reconciliation_requested(request.timeline_reconciliation);
+    if (!recon_req.ok()) {
+      ERR_PRINT("CamBANGServer: requested synthetic timeline_reconciliation configuration rejected by provider broker.");
+      return false;
+    }
+  }
+  return true;
+}
+
 bool CamBANGServer::_ensure_provider_attached_and_initialized(
     RuntimeMode mode,
     SyntheticRole synthetic_role,
@@ -4152,90 +5361,11 @@ bool CamBANGServer::_ensure_provider_attached_and_initialized(
     auto broker = std::make_unique<ProviderBroker>();
     broker->set_synthetic_timeline_request_dispatch_hook(
         make_synthetic_timeline_request_dispatch_hook(runtime_));
-    ProviderResult sr = broker->set_runtime_mode_requested(mode);
-    if (!sr.ok()) {
-      ERR_PRINT(godot::vformat(
-          "CamBANGServer: provider_mode='%s' is not supported in this build.",
-          mode_to_cstr(mode)));
-      return false;
-    }
-    ProviderResult role_req = broker->set_synthetic_role_requested(synthetic_role);
-    if (!role_req.ok()) {
-      ERR_PRINT("CamBANGServer: requested synthetic role configuration rejected by provider broker.");
-      return false;
-    }
-    ProviderResult timing_req = broker->set_synthetic_timing_driver_requested(timing_driver);
-    if (!timing_req.ok()) {
-      ERR_PRINT("CamBANGServer: requested synthetic timing_driver configuration rejected by provider broker.");
+    ProviderBrokerRequest request;
+    if (!_read_provider_broker_request_(mode, synthetic_role, timing_driver, request) ||
+        !_apply_provider_broker_request_(*broker, std::move(request))) {
       return false;
     }
-    if (mode == RuntimeMode::synthetic) {
-      if (!apply_synthetic_producer_output_form_cmdline_to_project_setting()) {
-        ERR_PRINT("CamBANGServer: invalid duplicate or unsupported Synthetic producer output-form maintainer setting.");
-        return false;
-      }
-      if (!apply_synthetic_stream_capability_downgrade_cmdline_to_project_setting()) {
-        ERR_PRINT("CamBANGServer: invalid duplicate or unsupported Synthetic stream capability downgrade maintainer setting.");
-        return false;
-      }
-      if (!apply_synthetic_capture_capability_downgrade_cmdline_to_project_setting()) {
-        ERR_PRINT("CamBANGServer: invalid duplicate or unsupported Synthetic capture capability downgrade maintainer setting.");
-        return false;
-      }
-      SyntheticProducerOutputFormMode producer_output_form_mode = SyntheticProducerOutputFormMode::Auto;
-      if (!read_synthetic_producer_output_form_project_setting(producer_output_form_mode)) {
-        ERR_PRINT("CamBANGServer: invalid Synthetic producer output-form maintainer project setting.");
-        return false;
-      }
-      std::vector<SyntheticStreamCapabilityDowngradeCondition>
-          stream_capability_downgrade_conditions{};
-      if (!read_synthetic_stream_capability_downgrade_project_setting(
-              stream_capability_downgrade_conditions)) {
-        ERR_PRINT("CamBANGServer: invalid Synthetic stream capability downgrade maintainer project setting.");
-        return false;
-      }
-      std::vector<SyntheticCaptureCapabilityDowngradeCondition>
-          capture_capability_downgrade_conditions{};
-      if (!read_synthetic_capture_capability_downgrade_project_setting(
-              capture_capability_downgrade_conditions)) {
-        ERR_PRINT("CamBANGServer: invalid Synthetic capture capability downgrade maintainer project setting.");
-        return false;
-      }
-      ProviderResult output_form_req =
-          broker->set_synthetic_producer_output_form_mode_requested(producer_output_form_mode);
-      if (!output_form_req.ok()) {
-        ERR_PRINT("CamBANGServer: requested Synthetic producer output-form configuration rejected by provider broker.");
-        return false;
-      }
-      ProviderResult stream_downgrade_req =
-          broker->set_synthetic_stream_capability_downgrade_conditions_requested(
-              std::move(stream_capability_downgrade_conditions));
-      if (!stream_downgrade_req.ok()) {
-        ERR_PRINT("CamBANGServer: requested Synthetic stream capability downgrade configuration rejected by provider broker.");
-        return false;
-      }
-      ProviderResult capture_downgrade_req =
-          broker->set_synthetic_capture_capability_downgrade_conditions_requested(
-              std::move(capture_capability_downgrade_conditions));
-      if (!capture_downgrade_req.ok()) {
-        ERR_PRINT("CamBANGServer: requested Synthetic capture capability downgrade configuration rejected by provider broker.");
-        return false;
-      }
-    }
-    const bool reconciliation_applicable =
-        mode == RuntimeMode::synthetic &&
-        synthetic_role == SyntheticRole::Timeline &&
-        timing_driver == TimingDriver::VirtualTime;
-    if (reconciliation_applicable) {
-      ProviderResult recon_req = broker->set_synthetic_timeline_reconciliation_requested(
-          completion_gated_destructive_sequencing_enabled_
-              ? TimelineReconciliation::CompletionGated
-              : TimelineReconciliation::Strict);
-      if (!recon_req.ok()) {
-        ERR_PRINT("CamBANGServer: requested synthetic timeline_reconciliation configuration rejected by provider broker.");
-        return false;
-      }
-    }
     provider_ = std::move(broker);
   }
   ProviderResult pr = provider_->initialize(runtime_.provider_callbacks());
@@ -4262,6 +5392,13 @@ void CamBANGServer::_bind_methods() {
       DEFVAL(godot::Variant()),
       DEFVAL(godot::Variant()));
   godot::ClassDB::bind_method(godot::D_METHOD("stop"), &CamBANGServer::stop);
+  godot::ClassDB::bind_method(
+      godot::D_METHOD("swap_provider", "provider_kind", "role", "timing_driver", "timeline_reconciliation"),
+      &CamBANGServer::swap_provider,
+      DEFVAL(godot::Variant()),
+      DEFVAL(godot::Variant()),
+      DEFVAL(godot::Variant()),
+      DEFVAL(godot::Variant()));
   godot::ClassDB::bind_method(godot::D_METHOD("stop_and_quit", "exit_code"), &CamBANGServer::stop_and_quit, DEFVAL(0));
   godot::ClassDB::bind_method(godot::D_METHOD("is_running"), &CamBANGServer::is_running);
   godot::ClassDB::bind_method(godot::D_METHOD("get_active_provider_config"), &CamBANGServer::get_active_provider_config);
@@ -4269,20 +5406,43 @@ void CamBANGServer::_bind_methods() {
   godot::ClassDB::bind_method(godot::D_METHOD("select_builtin_scenario", "scenario_name"), &CamBANGServer::select_builtin_scenario);
   godot::ClassDB::bind_method(godot::D_METHOD("load_external_scenario", "json_text"), &CamBANGServer::load_external_scenario);
   godot::ClassDB::bind_method(godot::D_METHOD("ingest_camera_description", "json_text"), &CamBANGServer::ingest_camera_description);
+  godot::ClassDB::bind_method(godot::D_METHOD("ingest_camera_description_file", "path"), &CamBANGServer::ingest_camera_description_file);
   godot::ClassDB::bind_method(godot::D_METHOD("set_capture_geolocation", "geolocation"), &CamBANGServer::set_capture_geolocation);
+  godot::ClassDB::bind_method(godot::D_METHOD("set_stream_qos_enabled", "enabled"), &CamBANGServer::set_stream_qos_enabled);
+  godot::ClassDB::bind_method(godot::D_METHOD("is_stream_qos_enabled"), &CamBANGServer::is_stream_qos_enabled);
+  godot::ClassDB::bind_method(
+      godot::D_METHOD("set_capture_spill", "medium", "byte_budget", "directory"),
+      &CamBANGServer::set_capture_spill,
+      DEFVAL(godot::String()));
+  godot::ClassDB::bind_method(godot::D_METHOD("set_frame_shard_count", "shard_count"), &CamBANGServer::set_frame_shard_count);
+  godot::ClassDB::bind_method(godot::D_METHOD("get_frame_shard_count"), &CamBANGServer::get_frame_shard_count);
+  godot::ClassDB::bind_method(godot::D_METHOD("set_snapshot_publish_offload", "enabled"), &CamBANGServer::set_snapshot_publish_offload);
+  godot::ClassDB::bind_method(godot::D_METHOD("is_snapshot_publish_offload_enabled"), &CamBANGServer::is_snapshot_publish_offload_enabled);
   godot::ClassDB::bind_method(godot::D_METHOD("start_scenario"), &CamBANGServer::start_scenario);
   godot::ClassDB::bind_method(godot::D_METHOD("stop_scenario"), &CamBANGServer::stop_scenario);
   godot::ClassDB::bind_method(godot::D_METHOD("set_timeline_paused", "paused"), &CamBANGServer::set_timeline_paused);
   godot::ClassDB::bind_method(godot::D_METHOD("advance_timeline", "dt_ns"), &CamBANGServer::advance_timeline);
   godot::ClassDB::bind_method(godot::D_METHOD("get_state_snapshot"), &CamBANGServer::get_state_snapshot);
+  godot::ClassDB::bind_method(godot::D_METHOD("get_state_summary"), &CamBANGServer::get_state_summary);
   godot::ClassDB::bind_method(godot::D_METHOD("get_synthetic_metrics_snapshot"), &CamBANGServer::get_synthetic_metrics_snapshot);
   godot::ClassDB::bind_method(godot::D_METHOD("get_backing_plan_evaluation_diagnostics"), &CamBANGServer::get_backing_plan_evaluation_diagnostics);
+  godot::ClassDB::bind_method(godot::D_METHOD("get_frame_latency_trace_diagnostics"), &CamBANGServer::get_frame_latency_trace_diagnostics);
+  godot::ClassDB::bind_method(godot::D_METHOD("get_core_thread_timing_diagnostics"), &CamBANGServer::get_core_thread_timing_diagnostics);
   godot::ClassDB::bind_method(godot::D_METHOD("enumerate_devices"), &CamBANGServer::enumerate_devices);
   godot::ClassDB::bind_method(godot::D_METHOD("get_device_for_hardware_id", "hardware_id"), &CamBANGServer::get_device_for_hardware_id);
   godot::ClassDB::bind_method(godot::D_METHOD("get_device", "device_instance_id"), &CamBANGServer::get_device);
   godot::ClassDB::bind_method(godot::D_METHOD("get_rig", "rig_id"), &CamBANGServer::get_rig);
   godot::ClassDB::bind_method(godot::D_METHOD("create_rig", "member_hardware_ids"), &CamBANGServer::create_rig);
   godot::ClassDB::bind_method(godot::D_METHOD("get_stream_result_by_stream_id", "stream_id"), &CamBANGServer::get_stream_result_by_stream_id);
+  godot::ClassDB::bind_method(godot::D_METHOD("get_stream_results_by_stream_ids", "stream_ids"), &CamBANGServer::get_stream_results_by_stream_ids);
+  godot::ClassDB::bind_method(godot::D_METHOD("get_stream_result_revision"), &CamBANGServer::get_stream_result_revision);
+  godot::ClassDB::bind_method(godot::D_METHOD("get_capture_result_revision"), &CamBANGServer::get_capture_result_revision);
+  godot::ClassDB::bind_method(godot::D_METHOD("set_stream_jitter_buffer_latency_usec", "stream_id", "latency_usec"),
+                              &CamBANGServer::set_stream_jitter_buffer_latency_usec);
+  godot::ClassDB::bind_method(godot::D_METHOD("set_stream_display_only", "stream_id", "enabled"),
+                              &CamBANGServer::set_stream_display_only);
+  godot::ClassDB::bind_method(godot::D_METHOD("get_stream_result_for_display_by_stream_id", "stream_id", "display_delay_usec"),
+                              &CamBANGServer::get_stream_result_for_display_by_stream_id);
   godot::ClassDB::bind_method(godot::D_METHOD("get_capture_result_by_id", "capture_id", "device_instance_id"), &CamBANGServer::get_capture_result_by_id);
   godot::ClassDB::bind_method(godot::D_METHOD("get_capture_result_set_by_id", "capture_id"), &CamBANGServer::get_capture_result_set_by_id);
 
@@ -4297,14 +5457,22 @@ void CamBANGServer::_bind_methods() {
   BIND_CONSTANT(TIMING_DRIVER_VIRTUAL_TIME);
   BIND_CONSTANT(TIMELINE_RECONCILIATION_COMPLETION_GATED);
   BIND_CONSTANT(TIMELINE_RECONCILIATION_STRICT);
+  BIND_CONSTANT(CAPTURE_SPILL_OFF);
+  BIND_CONSTANT(CAPTURE_SPILL_TEMP_FILE);
+  BIND_CONSTANT(CAPTURE_SPILL_COMPRESSED_MEMORY);
   BIND_CONSTANT(PIXEL_FORMAT_RGBA);
   BIND_CONSTANT(PIXEL_FORMAT_BGRA);
+  BIND_CONSTANT(PIXEL_FORMAT_RAW16);
+  BIND_CONSTANT(PIXEL_FORMAT_RAW10);
 
   ADD_SIGNAL(godot::MethodInfo(
       "state_published",
       godot::PropertyInfo(godot::Variant::INT, "gen"),
       godot::PropertyInfo(godot::Variant::INT, "version"),
       godot::PropertyInfo(godot::Variant::INT, "topology_version")));
+  ADD_SIGNAL(godot::MethodInfo(
+      "state_changed",
+      godot::PropertyInfo(godot::Variant::DICTIONARY, "changes")));
 }
 
 } // namespace cambang
@@ -3,9 +3,11 @@
 #include <cstdint>
 #include <atomic>
 #include <memory>
+#include <mutex>
 #include <unordered_map>
 #include <unordered_set>
 #include <string>
+#include <vector>
 
 #include "imaging/api/provider_contract_datatypes.h"
 
@@ -20,11 +22,15 @@
 
 #include "core/core_runtime.h"
 #include "core/state_snapshot_buffer.h"
+#include "core/snapshot/snapshot_delta.h"
+#include "core/snapshot/snapshot_summary.h"
 #include "core/snapshot/state_snapshot.h"
 
+#include "godot/cambang_operation.h"
 #include "godot/state_snapshot_export.h"
 
 #include "imaging/broker/mode.h"
+#include "imaging/replay/config.h"
 #include "imaging/synthetic/config.h"
 
 // Provider lifecycle is owned by the server (Godot thread), but attached to the
@@ -42,6 +48,9 @@ class CamBANGStream;
 class CamBANGCaptureResult;
 class CamBANGDevice;
 class CamBANGRig;
+class CamBANGPerformanceMonitors;
+struct CamBANGPerformanceCounters;
+class ProviderBroker;
 
 // CamBANGServer is the release-facing lifecycle owner.
 //
@@ -84,9 +93,15 @@ public:
   static constexpr int TIMELINE_RECONCILIATION_COMPLETION_GATED = 0;
   static constexpr int TIMELINE_RECONCILIATION_STRICT = 1;
 
+  static constexpr int CAPTURE_SPILL_OFF = 0;
+  static constexpr int CAPTURE_SPILL_TEMP_FILE = 1;
+  static constexpr int CAPTURE_SPILL_COMPRESSED_MEMORY = 2;
+
   // Public CamBANG FourCC-style pixel format constants for Godot Dictionary profile fields.
   static constexpr int PIXEL_FORMAT_RGBA = static_cast<int>(FOURCC_RGBA);
   static constexpr int PIXEL_FORMAT_BGRA = static_cast<int>(FOURCC_BGRA);
+  static constexpr int PIXEL_FORMAT_RAW16 = static_cast<int>(FOURCC_RAW16);
+  static constexpr int PIXEL_FORMAT_RAW10 = static_cast<int>(FOURCC_RAW10);
 
   // User-facing control of core processing.
   godot::Error start(
@@ -97,6 +112,19 @@ public:
   void stop();
   void stop_and_quit(int64_t exit_code = 0);
   bool is_running() const;
+  // Provider hot-swap while running (CoreRuntime::try_swap_provider() over
+  // ProviderBroker::swap_provider()), with start()'s arguments. Core stays
+  // LIVE and keeps its generation: every stream and device of the old
+  // provider closes, so existing CamBANGDevice/CamBANGStream handles go
+  // non-live as on a close, and handles engaged afterwards address the
+  // replacement. Rigs, specs and retained results are kept. ERR_BUSY before
+  // the baseline publish. A failed swap leaves no provider attached; stop()
+  // and start() again.
+  godot::Error swap_provider(
+      const godot::Variant& provider_kind = godot::Variant(),
+      const godot::Variant& role = godot::Variant(),
+      const godot::Variant& timing_driver = godot::Variant(),
+      const godot::Variant& timeline_reconciliation = godot::Variant());
 
   godot::Variant get_active_provider_config() const;
   godot::Dictionary get_provider_support() const;
@@ -110,11 +138,48 @@ public:
   // docs/status_panel_surface_policy.md); this reads Core registry-backed truth
   // on demand.
   godot::Variant get_backing_plan_evaluation_diagnostics() const;
+  // Per-frame latency trace from provider acquisition to texture update (see
+  // imaging/api/frame_latency_trace.h) as Chrome trace / Perfetto JSON text.
+  // Returns a NIL Variant when the runtime is not running; the trace is reset
+  // on start() and keeps only the newest events. Diagnostic surface only.
+  godot::Variant get_frame_latency_trace_diagnostics() const;
+  // Core-thread queue wait and execution histograms per work kind (see
+  // core/core_task_timing.h): a Dictionary keyed by kind name, each holding
+  // "queue_wait" and "exec" histograms, plus the shared "bucket_upper_ns".
+  // Returns a NIL Variant when the runtime is not running; reset on start().
+  // Diagnostic surface only.
+  godot::Variant get_core_thread_timing_diagnostics() const;
 
   godot::Error select_builtin_scenario(const godot::String& scenario_name);
   godot::Error load_external_scenario(const godot::String& json_text);
   godot::Error ingest_camera_description(const godot::String& json_text);
+  // As ingest_camera_description(), reading the JSON from a file (res:// and
+  // user:// paths are globalized). The file is memory-mapped and parsed in
+  // place. Safe to call from a Thread, so a large description can be parsed
+  // off the main thread; only the parsed result is handed to Core. Files
+  // packed into a PCK cannot be mapped: read those and use
+  // ingest_camera_description(). ERR_FILE_CANT_OPEN when the file cannot be
+  // mapped.
+  godot::Error ingest_camera_description_file(const godot::String& path);
   godot::Error set_capture_geolocation(const godot::Dictionary& geolocation);
+  // Load-adaptive stream quality of service (CoreRuntime::
+  // set_stream_qos_enabled()); off by default, kept across runtime restarts.
+  // Each stream's level is published as qos_level in its snapshot entry.
+  void set_stream_qos_enabled(bool enabled);
+  bool is_stream_qos_enabled() const;
+  // Second tier for capture results evicted over the byte budget
+  // (CoreRuntime::set_capture_spill_medium()); CAPTURE_SPILL_OFF until set.
+  // CAPTURE_SPILL_TEMP_FILE needs a directory (res:// and user:// paths are
+  // globalized). ERR_BUSY while running.
+  godot::Error set_capture_spill(int medium, int64_t byte_budget, const godot::String& directory);
+  // Per-device frame retention shards (CoreRuntime::set_frame_shard_count());
+  // 0 (off) until set, at most 8. ERR_BUSY while running.
+  godot::Error set_frame_shard_count(int shard_count);
+  int get_frame_shard_count() const;
+  // Off-core-thread snapshot building (CoreRuntime::
+  // set_snapshot_publish_offload()); off until set. ERR_BUSY while running.
+  godot::Error set_snapshot_publish_offload(bool enabled);
+  bool is_snapshot_publish_offload_enabled() const;
   godot::Error start_scenario();
   godot::Error stop_scenario();
   godot::Error set_timeline_paused(bool paused);
@@ -126,6 +191,10 @@ public:
   // - Before the first publish, returns NIL.
   // - After publish, returns a Dictionary matching docs/state_snapshot.md.
   godot::Variant get_state_snapshot() const;
+  // Return the StatusPanel aggregate counters of the latest snapshot (see
+  // export_state_summary_to_godot()), kept current from snapshot deltas.
+  // NIL before the first publish, like get_state_snapshot().
+  godot::Variant get_state_summary() const;
   godot::Array enumerate_devices() const;
   godot::Ref<CamBANGDevice> get_device_for_hardware_id(const godot::String& hardware_id) const;
   godot::Ref<CamBANGDevice> get_device(uint64_t device_instance_id) const;
@@ -135,6 +204,26 @@ public:
   // the combination. The server mints the rig_id (like capture_id).
   godot::Ref<CamBANGRig> create_rig(const godot::PackedStringArray& member_hardware_ids);
   godot::Ref<CamBANGStreamResult> get_stream_result_by_stream_id(uint64_t stream_id) const;
+  // Batched get_stream_result_by_stream_id() for polling many streams:
+  // { stream_id: CamBANGStreamResult } holding only the streams whose latest
+  // result differs from the one last handed out for them (by any result
+  // query). Streams without a result, or unchanged, are left out.
+  godot::Dictionary get_stream_results_by_stream_ids(const godot::PackedInt64Array& stream_ids) const;
+  // Wait-free change counters over retained results
+  // (CoreRuntime::stream_result_revision()/capture_result_revision()): a
+  // poller that saw the same value last time has no new stream result, or
+  // no capture result change, to read. Only grow, including across restarts.
+  int64_t get_stream_result_revision() const;
+  int64_t get_capture_result_revision() const;
+  // Jitter-buffer display selection (CoreRuntime::set_stream_jitter_buffer_latency());
+  // latency 0 turns it off. With it off, the display query answers like
+  // get_stream_result_by_stream_id().
+  godot::Error set_stream_jitter_buffer_latency_usec(uint64_t stream_id, int64_t latency_usec);
+  // Display-only results (CoreRuntime::set_stream_display_only()): no access
+  // calibration or derived-payload cache for the stream. Off by default.
+  godot::Error set_stream_display_only(uint64_t stream_id, bool enabled);
+  godot::Ref<CamBANGStreamResult> get_stream_result_for_display_by_stream_id(uint64_t stream_id,
+                                                                             int64_t display_delay_usec) const;
   godot::Ref<CamBANGCaptureResult> get_capture_result_by_id(uint64_t capture_id, uint64_t device_instance_id) const;
   uint64_t get_latest_capture_id_for_device(uint64_t device_instance_id) const;
   godot::TypedArray<CamBANGCaptureResult> get_capture_result_set_by_id(uint64_t capture_id) const;
@@ -179,6 +268,24 @@ public:
                                          uint64_t device_instance_id);
   uint64_t resolve_endpoint_instance_id(const godot::String& hardware_id) const;
 
+  // Awaitable variants of the lifecycle commands above: same validation and
+  // admission, but the returned operation completes when Core integrates the
+  // provider fact (device opened, stream started/stopped, capture completed).
+  // A refused command returns an operation that fails with the admission
+  // error. Unlike engage_endpoint_handle(), engage_endpoint_handle_async()
+  // records no startup intent before the boundary is ready; it fails with
+  // ERR_UNAVAILABLE.
+  godot::Ref<CamBANGOperation> engage_endpoint_handle_async(const godot::String& hardware_id,
+                                                            const godot::String& display_name);
+  godot::Ref<CamBANGOperation> start_direct_stream_handle_async(uint64_t stream_id,
+                                                                const godot::String& hardware_id,
+                                                                uint64_t device_instance_id);
+  godot::Ref<CamBANGOperation> stop_direct_stream_handle_async(uint64_t stream_id,
+                                                               const godot::String& hardware_id,
+                                                               uint64_t device_instance_id);
+  godot::Ref<CamBANGOperation> trigger_device_capture_async(uint64_t device_instance_id,
+                                                            uint64_t& out_capture_id);
+
 protected:
   static void _bind_methods();
 
@@ -186,11 +293,18 @@ private:
   friend class CamBANGDevice;
   friend class CamBANGStream;
   friend class CamBANGRig;
+  friend class CamBANGPerformanceMonitors;
   // Called on the Godot main thread via the SceneTree "process_frame" signal.
   void _on_godot_process_frame();
 
+  // Performance monitor counters (cambang_performance_monitors.h). Main thread.
+  void sample_performance_counters_(CamBANGPerformanceCounters& out) const;
+
   // Core tick handler (Godot main thread) invoked by _on_godot_process_frame().
   void _on_godot_tick(double delta);
+  // Samples OS available memory about once a second and trims Core, the
+  // provider and the image cache when it runs low.
+  void _watch_memory_pressure_(uint64_t now_ns);
   void _arm_live_retained_result_access_calibration_from_snapshot_(
       uint64_t now_ns,
       const std::vector<CoreBackingPlanEvaluationReport>& backing_plan_reports);
@@ -220,7 +334,18 @@ private:
   void _drain_pending_endpoint_startup_intents_after_baseline_();
   godot::Error _start_scenario_now_();
   void _drain_pending_scenario_start_after_baseline_();
-  void _refresh_tracked_wrapper_live_states_from_snapshot_();
+  // prior is the snapshot latest_ replaced; null (and delta unused) on the
+  // first publish of a gen.
+  void _refresh_tracked_wrapper_live_states_from_snapshot_(const CamBANGStateSnapshot* prior,
+                                                           const CamBANGStateSnapshotDelta& delta);
+  // state_changed payload: the ids delta touched and the versions it spans.
+  godot::Dictionary _build_state_changes_(const CamBANGStateSnapshot* prior,
+                                          const CamBANGStateSnapshot& snap,
+                                          const CamBANGStateSnapshotDelta& delta) const;
+  void _index_tracked_device_wrapper_(uint64_t wrapper_object_id, const CamBANGDevice& device);
+  void _index_tracked_stream_wrapper_(uint64_t wrapper_object_id, const CamBANGStream& stream);
+  void _refresh_indexed_device_wrappers_(std::vector<uint64_t>& wrapper_object_ids);
+  void _refresh_indexed_stream_wrappers_(std::vector<uint64_t>& wrapper_object_ids);
   void _set_all_tracked_wrapper_live_states_false_();
   bool _is_device_live_by_identity_(const godot::String& hardware_id,
                                     uint64_t device_instance_id) const;
@@ -231,14 +356,29 @@ private:
   static CamBANGServer* singleton_;
 
   CoreRuntime runtime_;
+  // No section interest is registered: get_state_snapshot() exports every
+  // section, so Core builds them all.
   StateSnapshotBuffer snapshot_buffer_;
 
   // Godot-thread cached snapshot.
   std::shared_ptr<const CamBANGStateSnapshot> latest_;
 
   // Godot-thread cached exported snapshot (struct-like Variant graph).
+  // Exported from latest_ on the first get_state_snapshot() after each
+  // publish, so publishes nobody reads cost no Variant work.
   bool has_latest_export_ = false;
-  godot::Dictionary latest_export_;
+  mutable bool latest_export_pending_ = false;
+  mutable godot::Dictionary latest_export_;
+  mutable StateSnapshotExportCache export_cache_;
+
+  // Aggregates of latest_, folded from each publish's delta; exported on
+  // the first get_state_summary() after each publish.
+  StateSummaryTracker state_summary_;
+  mutable bool state_summary_export_pending_ = false;
+  mutable godot::Dictionary state_summary_export_;
+
+  // get_provider_support() result; empty until first queried.
+  mutable godot::Dictionary provider_support_;
 
   // Godot-facing tick-bounded counters (truth model for state_published).
   // These are not the core's internal publication counters.
@@ -250,6 +390,10 @@ private:
 
   // O(1) "changed since last Godot tick" marker: core publish sequence.
   uint64_t last_seen_published_seq_ = 0;
+  // Same for retained results (CoreRuntime::stream_result_revision() and
+  // capture_result_revision()), as of the last calibration identity pass.
+  uint64_t last_observed_stream_result_revision_ = 0;
+  uint64_t last_observed_capture_result_revision_ = 0;
 
   // Godot-boundary run/session guard.
   // - active_session_id_ is non-zero only while a start()-initiated run is active.
@@ -264,6 +408,42 @@ private:
 
   void _ensure_tick_connected();
   void _disconnect_tick_if_connected_();
+  struct ProviderConfigArgs {
+    RuntimeMode mode = RuntimeMode::platform_backed;
+    SyntheticRole synthetic_role = SyntheticRole::Nominal;
+    TimingDriver timing_driver = TimingDriver::VirtualTime;
+    bool completion_gated_destructive_sequencing_enabled = true;
+  };
+  // start()/swap_provider() argument validation; method names the caller in
+  // rejection messages.
+  static godot::Error _parse_provider_config_args_(
+      const char* method,
+      const godot::Variant& provider_kind_arg,
+      const godot::Variant& role_arg,
+      const godot::Variant& timing_driver_arg,
+      const godot::Variant& timeline_reconciliation_arg,
+      ProviderConfigArgs& out);
+  // Broker selection, read on the main thread (project settings and command
+  // line) and applied to an uninitialized broker, which for a swap happens
+  // on the core thread.
+  struct ProviderBrokerRequest {
+    RuntimeMode mode = RuntimeMode::platform_backed;
+    SyntheticRole synthetic_role = SyntheticRole::Nominal;
+    TimingDriver timing_driver = TimingDriver::VirtualTime;
+    SyntheticProducerOutputFormMode producer_output_form_mode = SyntheticProducerOutputFormMode::Auto;
+    std::vector<SyntheticStreamCapabilityDowngradeCondition> stream_capability_downgrade_conditions;
+    std::vector<SyntheticCaptureCapabilityDowngradeCondition> capture_capability_downgrade_conditions;
+    // Synthetic mode only; a recording path selects ReplayProvider.
+    ReplayProviderConfig replay;
+    bool reconciliation_applicable = false;
+    TimelineReconciliation timeline_reconciliation = TimelineReconciliation::CompletionGated;
+  };
+  bool _read_provider_broker_request_(
+      RuntimeMode mode,
+      SyntheticRole synthetic_role,
+      TimingDriver timing_driver,
+      ProviderBrokerRequest& out);
+  static bool _apply_provider_broker_request_(ProviderBroker& broker, ProviderBrokerRequest request);
   godot::Error _start_with_provider_config(
       RuntimeMode mode,
       SyntheticRole synthetic_role,
@@ -295,6 +475,13 @@ private:
   bool tick_connected_ = false;
   uint64_t last_tick_time_ns_ = 0;
 
+  // Low-memory watch state (main thread). Level 0 is no pressure, 1 and 2
+  // are MemoryTrimLevel::Moderate and ::Critical plus one.
+  uint64_t memory_pressure_next_sample_ns_ = 0;
+  uint64_t memory_pressure_last_trim_ns_ = 0;
+  uint8_t memory_pressure_level_ = 0;
+  uint64_t image_cache_trim_bytes_released_ = 0;
+
   struct ArmedLiveStreamRetainedResultCalibration {
     uint64_t stream_id = 0;
     uint64_t posture_id = 0;
@@ -302,14 +489,21 @@ private:
     ResultCapability display_view = ResultCapability::UNSUPPORTED;
     ResultCapability to_image = ResultCapability::UNSUPPORTED;
     uint64_t due_after_ns = 0;
+    // Until then the identity's last measurement stands (sampling window).
+    uint64_t resample_after_ns = 0;
   };
   struct ArmedLiveCaptureRetainedResultCalibration {
     uint64_t device_instance_id = 0;
     uint64_t capture_id = 0;
     uint64_t acquisition_session_id = 0;
     uint64_t member_identity_signature = 0;
+    // Member postures only (no capture or frame ids), so consecutive captures
+    // in one posture share a sampling window.
+    uint64_t member_posture_signature = 0;
     uint64_t evaluation_identity = 0;
     uint64_t due_after_ns = 0;
+    // Until then the device only reports the last measurement of its postures.
+    uint64_t resample_after_ns = 0;
   };
   std::unordered_map<uint64_t, ArmedLiveStreamRetainedResultCalibration>
       pending_live_stream_retained_result_calibrations_;
@@ -385,10 +579,56 @@ private:
     bool close_requested = false;
   };
   std::unordered_map<std::string, EndpointLifecycleState> endpoint_lifecycle_by_hardware_id_;
+  // engage_endpoint_handle() split around its open: prepare assigns the
+  // device instance and fills out_open (returning OK with out_state null
+  // when the endpoint is already engaged); finish applies the open status.
+  godot::Error _prepare_endpoint_engage_(const godot::String& hardware_id,
+                                         const godot::String& display_name,
+                                         SetupOpenDevice& out_open,
+                                         EndpointLifecycleState*& out_state);
+  godot::Error _finish_endpoint_engage_(EndpointLifecycleState& state, TryOpenDeviceStatus status);
+  godot::Error _validate_direct_stream_handle_(uint64_t stream_id,
+                                               const godot::String& hardware_id,
+                                               uint64_t device_instance_id) const;
+
+  // Async command completions. The core thread resolves a CoreOperation and
+  // queues its outcome here; _on_godot_tick() hands it to the CamBANGOperation
+  // still held (main thread only) in pending_operations_ and emits completed.
+  struct CompletedOperation {
+    uint64_t token = 0;
+    CoreOperationOutcome outcome = CoreOperationOutcome::Pending;
+    uint32_t error_code = 0;
+  };
+  godot::Ref<CamBANGOperation> _track_operation_(const CoreOperation& op, godot::Error admission_error);
+  void _deliver_completed_operations_();
+  uint64_t next_operation_token_ = 1;
+  std::unordered_map<uint64_t, godot::Ref<CamBANGOperation>> pending_operations_;
+  std::mutex completed_operations_mu_;
+  std::vector<CompletedOperation> completed_operations_;
   std::unordered_map<uint64_t, godot::String> direct_stream_hardware_id_by_stream_id_;
   std::unordered_map<uint64_t, uint64_t> latest_capture_id_by_device_instance_id_;
+  // Last CamBANGStreamResult handed out per stream, held by object id so
+  // neither the wrapper nor its result is kept alive here. A repeat query
+  // whose latest result is unchanged returns that same wrapper rather than
+  // allocating another.
+  struct IssuedStreamResultWrapper {
+    std::weak_ptr<const CoreStreamResultData> data;
+    uint64_t wrapper_object_id = 0;
+  };
+  mutable std::unordered_map<uint64_t, IssuedStreamResultWrapper> issued_stream_result_wrappers_;
+  godot::Ref<CamBANGStreamResult> wrap_stream_result_(uint64_t stream_id, SharedStreamResultData data) const;
+  // True when data is not the result last wrapped for stream_id.
+  bool stream_result_changed_since_issued_(uint64_t stream_id, const SharedStreamResultData& data) const;
   std::unordered_set<uint64_t> tracked_device_wrapper_object_ids_;
   std::unordered_set<uint64_t> tracked_stream_wrapper_object_ids_;
+  // Tracked wrapper ids by the identity their liveness is read from: device
+  // endpoint handles by hardware_id, instance handles by device instance id,
+  // streams by stream_id. A publish within one gen refreshes only the
+  // wrappers whose records its snapshot delta touches. Entries for dead
+  // wrappers are dropped when next visited; a full refresh rebuilds all.
+  std::unordered_map<std::string, std::vector<uint64_t>> tracked_device_wrappers_by_hardware_id_;
+  std::unordered_map<uint64_t, std::vector<uint64_t>> tracked_device_wrappers_by_instance_id_;
+  std::unordered_map<uint64_t, std::vector<uint64_t>> tracked_stream_wrappers_by_stream_id_;
 };
 
 } // namespace cambang
@@ -1,4 +1,5 @@
 #include "godot/cambang_stream.h"
+#include "godot/cambang_operation.h"
 #include "godot/cambang_server.h"
 #include "godot/cambang_stream_result.h"
 
@@ -34,6 +35,26 @@ godot::Error CamBANGStream::stop() {
   return server_->stop_direct_stream_handle(stream_id_, hardware_id_, device_instance_id_);
 }
 
+godot::Ref<CamBANGOperation> CamBANGStream::start_async() {
+  if (!server_) {
+    return godot::Ref<CamBANGOperation>();
+  }
+  if (destroy_requested_ || stream_id_ == 0 || device_instance_id_ == 0) {
+    return server_->_track_operation_(CoreOperation(), godot::ERR_UNAVAILABLE);
+  }
+  return server_->start_direct_stream_handle_async(stream_id_, hardware_id_, device_instance_id_);
+}
+
+godot::Ref<CamBANGOperation> CamBANGStream::stop_async() {
+  if (!server_) {
+    return godot::Ref<CamBANGOperation>();
+  }
+  if (destroy_requested_ || stream_id_ == 0 || device_instance_id_ == 0) {
+    return server_->_track_operation_(CoreOperation(), godot::ERR_UNAVAILABLE);
+  }
+  return server_->stop_direct_stream_handle_async(stream_id_, hardware_id_, device_instance_id_);
+}
+
 godot::Error CamBANGStream::destroy() {
   if (destroy_requested_) {
     return godot::OK;
@@ -56,6 +77,27 @@ godot::Ref<CamBANGStreamResult> CamBANGStream::get_result() const {
   return server_->get_stream_result_by_stream_id(stream_id_);
 }
 
+godot::Error CamBANGStream::set_jitter_buffer_latency_usec(int64_t latency_usec) {
+  if (!is_valid_stream_handle()) {
+    return godot::ERR_UNAVAILABLE;
+  }
+  return server_->set_stream_jitter_buffer_latency_usec(stream_id_, latency_usec);
+}
+
+godot::Error CamBANGStream::set_display_only(bool enabled) {
+  if (!is_valid_stream_handle()) {
+    return godot::ERR_UNAVAILABLE;
+  }
+  return server_->set_stream_display_only(stream_id_, enabled);
+}
+
+godot::Ref<CamBANGStreamResult> CamBANGStream::get_result_for_display(int64_t display_delay_usec) const {
+  if (!is_valid_stream_handle() || !server_->is_running()) {
+    return godot::Ref<CamBANGStreamResult>();
+  }
+  return server_->get_stream_result_for_display_by_stream_id(stream_id_, display_delay_usec);
+}
+
 void CamBANGStream::_bind_methods() {
   godot::ClassDB::bind_method(godot::D_METHOD("get_stream_id"), &CamBANGStream::get_stream_id);
   godot::ClassDB::bind_method(godot::D_METHOD("get_device_instance_id"), &CamBANGStream::get_device_instance_id);
@@ -64,8 +106,15 @@ void CamBANGStream::_bind_methods() {
   godot::ClassDB::bind_method(godot::D_METHOD("is_valid_stream_handle"), &CamBANGStream::is_valid_stream_handle);
   godot::ClassDB::bind_method(godot::D_METHOD("start"), &CamBANGStream::start);
   godot::ClassDB::bind_method(godot::D_METHOD("stop"), &CamBANGStream::stop);
+  godot::ClassDB::bind_method(godot::D_METHOD("start_async"), &CamBANGStream::start_async);
+  godot::ClassDB::bind_method(godot::D_METHOD("stop_async"), &CamBANGStream::stop_async);
   godot::ClassDB::bind_method(godot::D_METHOD("destroy"), &CamBANGStream::destroy);
   godot::ClassDB::bind_method(godot::D_METHOD("get_result"), &CamBANGStream::get_result);
+  godot::ClassDB::bind_method(godot::D_METHOD("set_jitter_buffer_latency_usec", "latency_usec"),
+                              &CamBANGStream::set_jitter_buffer_latency_usec);
+  godot::ClassDB::bind_method(godot::D_METHOD("get_result_for_display", "display_delay_usec"),
+                              &CamBANGStream::get_result_for_display);
+  godot::ClassDB::bind_method(godot::D_METHOD("set_display_only", "enabled"), &CamBANGStream::set_display_only);
   BIND_CONSTANT(INTENT_PREVIEW);
   BIND_CONSTANT(INTENT_VIEWFINDER);
   ADD_PROPERTY(godot::PropertyInfo(godot::Variant::BOOL, "result_live"), "", "is_result_live");
@@ -10,6 +10,7 @@
 
 namespace cambang {
 
+class CamBANGOperation;
 class CamBANGServer;
 class CamBANGStreamResult;
 
@@ -44,7 +45,18 @@ public:
   godot::Error start();
   godot::Error stop();
   godot::Error destroy();
+  // Awaitable start()/stop(): the operation completes once the provider
+  // reports the stream started (or stopped). See CamBANGOperation.
+  godot::Ref<CamBANGOperation> start_async();
+  godot::Ref<CamBANGOperation> stop_async();
   godot::Ref<CamBANGStreamResult> get_result() const;
+  // Jitter-buffer mode: get_result_for_display() then returns the frame
+  // acquired latency_usec before the predicted display time
+  // (now + display_delay_usec) instead of the newest. 0 turns it off.
+  godot::Error set_jitter_buffer_latency_usec(int64_t latency_usec);
+  godot::Ref<CamBANGStreamResult> get_result_for_display(int64_t display_delay_usec) const;
+  // Display-only mode (CamBANGServer::set_stream_display_only()).
+  godot::Error set_display_only(bool enabled);
 
 protected:
   static void _bind_methods();
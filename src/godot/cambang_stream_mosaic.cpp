@@ -0,0 +1,343 @@
+#include "godot/cambang_stream_mosaic.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include <godot_cpp/classes/image.hpp>
+#include <godot_cpp/classes/rendering_server.hpp>
+
+#include "core/core_derived_payload.h"
+#include "godot/cambang_stream_result.h"
+#include "godot/godot_gpu_display_service.h"
+
+namespace cambang {
+
+namespace {
+
+constexpr uint32_t kRgbaBytesPerPixel = 4;
+
+// Largest size of src_width x src_height's aspect ratio within the tile,
+// never upscaled.
+void fit_to_tile(uint32_t src_width,
+                 uint32_t src_height,
+                 uint32_t tile_width,
+                 uint32_t tile_height,
+                 uint32_t& out_width,
+                 uint32_t& out_height) noexcept {
+  if (src_width == 0 || src_height == 0) {
+    out_width = 0;
+    out_height = 0;
+    return;
+  }
+  const uint64_t w = src_width;
+  const uint64_t h = src_height;
+  if (w * tile_height >= h * tile_width) {
+    out_width = tile_width;
+    out_height = static_cast<uint32_t>(std::max<uint64_t>(1, h * tile_width / w));
+  } else {
+    out_height = tile_height;
+    out_width = static_cast<uint32_t>(std::max<uint64_t>(1, w * tile_height / h));
+  }
+  out_width = std::min(out_width, src_width);
+  out_height = std::min(out_height, src_height);
+}
+
+bool rid_state_invalidated(const SharedLiveCpuTextureRidState& state) {
+  std::lock_guard<std::mutex> lock(state.mutex);
+  return state.invalidated;
+}
+
+} // namespace
+
+CamBANGStreamMosaic::~CamBANGStreamMosaic() = default;
+
+void CamBANGStreamMosaic::set_streams(const godot::Array& streams) {
+  tiles_.clear();
+  tiles_.resize(static_cast<size_t>(streams.size()));
+  for (int64_t i = 0; i < streams.size(); ++i) {
+    godot::Object* object = streams[i];
+    tiles_[static_cast<size_t>(i)].stream = godot::Ref<CamBANGStream>(godot::Object::cast_to<CamBANGStream>(object));
+  }
+  reset_layout_();
+}
+
+godot::Array CamBANGStreamMosaic::get_streams() const {
+  godot::Array out;
+  for (const Tile& tile : tiles_) {
+    out.push_back(tile.stream);
+  }
+  return out;
+}
+
+void CamBANGStreamMosaic::set_tile_size(const godot::Vector2i& size) {
+  if (size.x <= 0 || size.y <= 0) {
+    return;
+  }
+  tile_width_ = static_cast<uint32_t>(size.x);
+  tile_height_ = static_cast<uint32_t>(size.y);
+  reset_layout_();
+}
+
+godot::Vector2i CamBANGStreamMosaic::get_tile_size() const {
+  return godot::Vector2i(static_cast<int32_t>(tile_width_), static_cast<int32_t>(tile_height_));
+}
+
+void CamBANGStreamMosaic::set_columns(int columns) {
+  if (columns <= 0) {
+    return;
+  }
+  columns_ = static_cast<uint32_t>(columns);
+  reset_layout_();
+}
+
+int CamBANGStreamMosaic::get_columns() const {
+  return static_cast<int>(columns_);
+}
+
+int CamBANGStreamMosaic::get_tile_count() const {
+  return static_cast<int>(tiles_.size());
+}
+
+void CamBANGStreamMosaic::reset_layout_() {
+  const uint32_t count = static_cast<uint32_t>(tiles_.size());
+  layout_columns_ = std::min(columns_, count);
+  const uint32_t rows = layout_columns_ == 0 ? 0 : (count + layout_columns_ - 1) / layout_columns_;
+  const uint32_t width = layout_columns_ * tile_width_;
+  const uint32_t height = rows * tile_height_;
+  if (width != atlas_width_ || height != atlas_height_) {
+    atlas_width_ = width;
+    atlas_height_ = height;
+    recreate_texture_ = true;
+    if (texture_.is_valid() && width != 0) {
+      texture_->update_dimensions(width, height);
+    }
+  }
+  atlas_bytes_.resize(static_cast<int64_t>(width) * height * kRgbaBytesPerPixel);
+  atlas_bytes_.fill(0);
+  for (Tile& tile : tiles_) {
+    tile.shown_retained_frame_id = 0;
+    tile.content_width = 0;
+    tile.content_height = 0;
+  }
+  upload_needed_ = true;
+}
+
+void CamBANGStreamMosaic::tile_origin_(size_t index, uint32_t& x, uint32_t& y) const noexcept {
+  x = static_cast<uint32_t>(index % layout_columns_) * tile_width_;
+  y = static_cast<uint32_t>(index / layout_columns_) * tile_height_;
+}
+
+bool CamBANGStreamMosaic::clear_tile_(size_t index) {
+  Tile& tile = tiles_[index];
+  if (tile.content_width == 0) {
+    return false;
+  }
+  uint32_t x = 0;
+  uint32_t y = 0;
+  tile_origin_(index, x, y);
+  uint8_t* atlas = atlas_bytes_.ptrw();
+  const size_t atlas_stride = static_cast<size_t>(atlas_width_) * kRgbaBytesPerPixel;
+  for (uint32_t row = 0; row < tile_height_; ++row) {
+    std::memset(atlas + (y + row) * atlas_stride + static_cast<size_t>(x) * kRgbaBytesPerPixel, 0,
+                static_cast<size_t>(tile_width_) * kRgbaBytesPerPixel);
+  }
+  tile.content_width = 0;
+  tile.content_height = 0;
+  return true;
+}
+
+bool CamBANGStreamMosaic::write_tile_(size_t index, const CoreStreamResultData& data) {
+  // Tightly packed RGBA8 of the tile's content, then blitted centred.
+  const uint8_t* src = nullptr;
+  uint32_t width = 0;
+  uint32_t height = 0;
+  godot::Ref<godot::Image> materialized;
+
+  if (has_current_cpu_payload(data)) {
+    fit_to_tile(data.payload.width, data.payload.height, tile_width_, tile_height_, width, height);
+    PackedTransform transform{};
+    transform.target_width = width;
+    transform.target_height = height;
+    const size_t size = retained_cpu_payload_transformed_size(data.payload, transform);
+    if (size != static_cast<size_t>(width) * height * kRgbaBytesPerPixel) {
+      return false;
+    }
+    tile_scratch_.resize(size);
+    if (!copy_retained_cpu_payload_transformed(data.payload, transform, tile_scratch_.data(), size)) {
+      return false;
+    }
+    src = tile_scratch_.data();
+  } else if (data.retained_gpu_backing_descriptor.valid) {
+    const godot::Ref<godot::Image> image = godot_gpu_display_materialize_to_image(
+        data.retained_gpu_backing_descriptor,
+        data.retained_gpu_backing);
+    if (image.is_null() || image->get_width() <= 0 || image->get_height() <= 0) {
+      return false;
+    }
+    fit_to_tile(static_cast<uint32_t>(image->get_width()), static_cast<uint32_t>(image->get_height()),
+                tile_width_, tile_height_, width, height);
+    // The materialized image may be shared with other readers; scale a
+    // copy-on-write copy of it.
+    materialized = godot::Image::create_from_data(
+        image->get_width(), image->get_height(), false, image->get_format(), image->get_data());
+    if (materialized.is_null()) {
+      return false;
+    }
+    if (materialized->get_format() != godot::Image::FORMAT_RGBA8) {
+      materialized->convert(godot::Image::FORMAT_RGBA8);
+    }
+    materialized->resize(static_cast<int32_t>(width), static_cast<int32_t>(height),
+                         godot::Image::INTERPOLATE_BILINEAR);
+    if (static_cast<uint32_t>(materialized->get_width()) != width ||
+        static_cast<uint32_t>(materialized->get_height()) != height) {
+      return false;
+    }
+    src = materialized->ptr();
+  }
+  if (!src || width == 0 || height == 0) {
+    return false;
+  }
+
+  Tile& tile = tiles_[index];
+  if (tile.content_width != width || tile.content_height != height) {
+    clear_tile_(index);
+  }
+  uint32_t x = 0;
+  uint32_t y = 0;
+  tile_origin_(index, x, y);
+  x += (tile_width_ - width) / 2;
+  y += (tile_height_ - height) / 2;
+  uint8_t* atlas = atlas_bytes_.ptrw();
+  const size_t atlas_stride = static_cast<size_t>(atlas_width_) * kRgbaBytesPerPixel;
+  const size_t src_stride = static_cast<size_t>(width) * kRgbaBytesPerPixel;
+  for (uint32_t row = 0; row < height; ++row) {
+    std::memcpy(atlas + (y + row) * atlas_stride + static_cast<size_t>(x) * kRgbaBytesPerPixel,
+                src + row * src_stride, src_stride);
+  }
+  tile.content_x = x;
+  tile.content_y = y;
+  tile.content_width = width;
+  tile.content_height = height;
+  return true;
+}
+
+bool CamBANGStreamMosaic::ensure_texture_() {
+  // A CamBANGServer stop invalidates every CPU display texture; start over
+  // with a new one and upload the whole atlas to it.
+  if (rid_state_ && rid_state_invalidated(*rid_state_)) {
+    rid_state_.reset();
+    texture_.unref();
+  }
+  if (!rid_state_) {
+    rid_state_ = make_live_cpu_texture_rid_state();
+    if (!rid_state_) {
+      return false;
+    }
+    stale_rid_ = godot::RID();
+    recreate_texture_ = false;
+    upload_needed_ = true;
+  }
+  if (texture_.is_null()) {
+    texture_.instantiate();
+    if (texture_.is_null()) {
+      return false;
+    }
+    texture_->init(rid_state_, 0, atlas_width_, atlas_height_, false);
+  }
+  return true;
+}
+
+int CamBANGStreamMosaic::update() {
+  if (tiles_.empty() || !ensure_texture_()) {
+    return 0;
+  }
+
+  int written = 0;
+  for (size_t i = 0; i < tiles_.size(); ++i) {
+    Tile& tile = tiles_[i];
+    SharedStreamResultData data;
+    if (tile.stream.is_valid()) {
+      const godot::Ref<CamBANGStreamResult> result = tile.stream->get_result();
+      if (result.is_valid()) {
+        data = result->data();
+      }
+    }
+    const uint64_t frame_id = data ? data->retained_frame_id : 0;
+    if (frame_id == tile.shown_retained_frame_id) {
+      continue;
+    }
+    // A frame that cannot be shown is not retried, and leaves the tile
+    // empty rather than showing an older frame.
+    if (frame_id != 0 && write_tile_(i, *data)) {
+      ++written;
+    } else if (clear_tile_(i)) {
+      ++written;
+    }
+    tile.shown_retained_frame_id = frame_id;
+  }
+  if (written == 0 && !upload_needed_) {
+    return 0;
+  }
+
+  godot::RenderingServer* rs = godot::RenderingServer::get_singleton();
+  if (!rs) {
+    return written;
+  }
+  const godot::Ref<godot::Image> image = godot::Image::create_from_data(
+      static_cast<int32_t>(atlas_width_), static_cast<int32_t>(atlas_height_), false,
+      godot::Image::FORMAT_RGBA8, atlas_bytes_);
+  if (image.is_null()) {
+    return written;
+  }
+  // Texture creation runs on the render thread (see
+  // enqueue_live_cpu_texture_create()); until it has, and after a layout
+  // change until the resized texture replaces the old one, the latest
+  // atlas is queued for creation instead of updated in place.
+  const godot::RID rid = rid_state_->snapshot_rid();
+  if (recreate_texture_) {
+    stale_rid_ = rid;
+    recreate_texture_ = false;
+  }
+  if (rid == stale_rid_) {
+    enqueue_live_cpu_texture_create(rid_state_, image);
+  } else {
+    rs->texture_2d_update(rid, image, 0);
+  }
+  upload_needed_ = false;
+  return written;
+}
+
+godot::Ref<godot::Texture2D> CamBANGStreamMosaic::get_texture() const {
+  return texture_;
+}
+
+godot::Rect2 CamBANGStreamMosaic::get_tile_uv_rect(int index) const {
+  if (index < 0 || static_cast<size_t>(index) >= tiles_.size() || atlas_width_ == 0 || atlas_height_ == 0) {
+    return godot::Rect2();
+  }
+  const Tile& tile = tiles_[static_cast<size_t>(index)];
+  if (tile.content_width == 0) {
+    return godot::Rect2();
+  }
+  const float w = static_cast<float>(atlas_width_);
+  const float h = static_cast<float>(atlas_height_);
+  return godot::Rect2(static_cast<float>(tile.content_x) / w,
+                      static_cast<float>(tile.content_y) / h,
+                      static_cast<float>(tile.content_width) / w,
+                      static_cast<float>(tile.content_height) / h);
+}
+
+void CamBANGStreamMosaic::_bind_methods() {
+  godot::ClassDB::bind_method(godot::D_METHOD("set_streams", "streams"), &CamBANGStreamMosaic::set_streams);
+  godot::ClassDB::bind_method(godot::D_METHOD("get_streams"), &CamBANGStreamMosaic::get_streams);
+  godot::ClassDB::bind_method(godot::D_METHOD("set_tile_size", "size"), &CamBANGStreamMosaic::set_tile_size);
+  godot::ClassDB::bind_method(godot::D_METHOD("get_tile_size"), &CamBANGStreamMosaic::get_tile_size);
+  godot::ClassDB::bind_method(godot::D_METHOD("set_columns", "columns"), &CamBANGStreamMosaic::set_columns);
+  godot::ClassDB::bind_method(godot::D_METHOD("get_columns"), &CamBANGStreamMosaic::get_columns);
+  godot::ClassDB::bind_method(godot::D_METHOD("get_tile_count"), &CamBANGStreamMosaic::get_tile_count);
+  godot::ClassDB::bind_method(godot::D_METHOD("update"), &CamBANGStreamMosaic::update);
+  godot::ClassDB::bind_method(godot::D_METHOD("get_texture"), &CamBANGStreamMosaic::get_texture);
+  godot::ClassDB::bind_method(godot::D_METHOD("get_tile_uv_rect", "index"), &CamBANGStreamMosaic::get_tile_uv_rect);
+}
+
+} // namespace cambang
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <godot_cpp/classes/ref.hpp>
+#include <godot_cpp/classes/ref_counted.hpp>
+#include <godot_cpp/classes/texture2d.hpp>
+#include <godot_cpp/core/class_db.hpp>
+#include <godot_cpp/variant/array.hpp>
+#include <godot_cpp/variant/packed_byte_array.hpp>
+#include <godot_cpp/variant/rect2.hpp>
+#include <godot_cpp/variant/rid.hpp>
+#include <godot_cpp/variant/vector2i.hpp>
+
+#include "godot/cambang_stream.h"
+#include "godot/cambang_stream_result_internal.h"
+
+namespace cambang {
+
+struct CoreStreamResultData;
+
+// One atlas texture holding the latest frame of several streams, for grid
+// views that would otherwise keep a display view (and a texture) per
+// stream.
+//
+// Each stream owns one tile, laid out row-major in `columns` columns. A
+// frame is scaled to fit its tile, keeping its aspect ratio, and
+// get_tile_uv_rect() gives the part of the atlas it covers. update() --
+// normally once per frame, on the main thread -- rewrites only the tiles
+// whose stream retained a new frame since the last update, and uploads the
+// atlas once when any did.
+//
+// CPU payloads are scaled straight into their tile in one fused pass (no
+// full-resolution copy); GPU-backed results go through to_image()'s
+// materialization and are scaled from that.
+class CamBANGStreamMosaic final : public godot::RefCounted {
+  GDCLASS(CamBANGStreamMosaic, godot::RefCounted)
+
+public:
+  static constexpr int kDefaultTileWidth = 320;
+  static constexpr int kDefaultTileHeight = 180;
+  static constexpr int kDefaultColumns = 4;
+
+  CamBANGStreamMosaic() = default;
+  ~CamBANGStreamMosaic() override;
+
+  // CamBANGStream handles, one tile each in order. Other entries leave
+  // their tile empty.
+  void set_streams(const godot::Array& streams);
+  godot::Array get_streams() const;
+  void set_tile_size(const godot::Vector2i& size);
+  godot::Vector2i get_tile_size() const;
+  void set_columns(int columns);
+  int get_columns() const;
+  int get_tile_count() const;
+
+  // Number of tiles rewritten.
+  int update();
+  // Null until the first update() with at least one tile. The same texture
+  // is returned across updates (its size follows the layout) until a
+  // CamBANGServer stop invalidates it; fetch it again after a restart.
+  godot::Ref<godot::Texture2D> get_texture() const;
+  // Normalized; an empty rect for a tile showing no frame yet.
+  godot::Rect2 get_tile_uv_rect(int index) const;
+
+protected:
+  static void _bind_methods();
+
+private:
+  struct Tile {
+    godot::Ref<CamBANGStream> stream;
+    uint64_t shown_retained_frame_id = 0;
+    // Atlas pixels the frame covers; zero width while the tile is empty.
+    uint32_t content_x = 0;
+    uint32_t content_y = 0;
+    uint32_t content_width = 0;
+    uint32_t content_height = 0;
+  };
+
+  void reset_layout_();
+  void tile_origin_(size_t index, uint32_t& x, uint32_t& y) const noexcept;
+  // False when the tile was already empty.
+  bool clear_tile_(size_t index);
+  bool write_tile_(size_t index, const CoreStreamResultData& data);
+  bool ensure_texture_();
+
+  std::vector<Tile> tiles_;
+  uint32_t tile_width_ = kDefaultTileWidth;
+  uint32_t tile_height_ = kDefaultTileHeight;
+  uint32_t columns_ = kDefaultColumns;
+  // columns_, or fewer when there are fewer tiles.
+  uint32_t layout_columns_ = 0;
+
+  // RGBA8, atlas_width_ x atlas_height_, tightly packed. Handing it to an
+  // Image shares it copy-on-write, so a queued upload never sees a later
+  // tile write.
+  godot::PackedByteArray atlas_bytes_;
+  uint32_t atlas_width_ = 0;
+  uint32_t atlas_height_ = 0;
+  std::vector<uint8_t> tile_scratch_;
+  bool upload_needed_ = false;
+
+  std::shared_ptr<SharedLiveCpuTextureRidState> rid_state_;
+  godot::Ref<LiveCpuDisplayTexture2D> texture_;
+  // Set by a layout change: the texture is created again at the new size,
+  // and stale_rid_ (the texture of the old size, or none yet) is not
+  // updated in place meanwhile.
+  bool recreate_texture_ = false;
+  godot::RID stale_rid_;
+};
+
+} // namespace cambang
@@ -5,8 +5,11 @@
 #include <cstring>
 #include <cstdlib>
 #include <chrono>
+#include <condition_variable>
 #include <map>
+#include <memory>
 #include <mutex>
+#include <thread>
 #include <vector>
 
 #include <godot_cpp/classes/image_texture.hpp>
@@ -15,11 +18,13 @@
 #include <godot_cpp/variant/string_name.hpp>
 
 #include "core/core_runtime.h"
+#include "core/resource_aggregate_telemetry.h"
 #include "godot/cambang_result_convert.h"
 #include "godot/cambang_server.h"
 #include "godot/godot_gpu_display_service.h"
 #include "godot/result_access_cost_evidence.h"
 #include "godot/cambang_stream_result_internal.h"
+#include "imaging/api/frame_latency_trace.h"
 
 namespace cambang {
 
@@ -53,13 +58,7 @@ bool has_current_retained_cpu_payload(const SharedStreamResultData& data) {
       data->payload.format_fourcc != data->image_format_fourcc) {
     return false;
   }
-  if (data->payload.format_fourcc != FOURCC_RGBA && data->payload.format_fourcc != FOURCC_BGRA) {
-    return false;
-  }
-  const size_t expected_size =
-      static_cast<size_t>(data->payload.width) * static_cast<size_t>(data->payload.height) * 4u;
-  return data->payload.stride_bytes == data->payload.width * 4u &&
-         data->payload.size_bytes() >= expected_size;
+  return has_valid_retained_cpu_payload_layout(data->payload);
 }
 
 uint64_t result_access_now_ns() {
@@ -112,20 +111,57 @@ const char* display_view_evidence_route(const SharedStreamResultData& data) {
   return result_access_cost_evidence::kRouteStreamDisplayViewCpuLiveDisplayView;
 }
 
+// Next image of one live CPU display view, converted off the main thread by
+// LiveCpuDisplayPreparer. Held apart from LiveCpuDisplayViewEntry so the
+// preparer never owns an entry (nor its texture RID state): if the view is
+// dropped mid-conversion, only these images go with the preparer's job.
+struct LiveCpuDisplayPrepareSlot final {
+  std::mutex mutex;
+  // Converted image of prepared_retained_frame_id, not yet shown.
+  godot::Ref<godot::Image> prepared;
+  uint64_t prepared_retained_frame_id = 0;
+  // The image the view showed before its current one; the preparer
+  // overwrites it next, so a view holds two images at most.
+  godot::Ref<godot::Image> spare;
+  // A queued or running job, for requested_retained_frame_id.
+  bool pending = false;
+  uint64_t requested_retained_frame_id = 0;
+};
+
 struct LiveCpuDisplayViewEntry final {
   std::mutex mutex;
+  const std::shared_ptr<LiveCpuDisplayPrepareSlot> prepare = std::make_shared<LiveCpuDisplayPrepareSlot>();
   std::shared_ptr<SharedLiveCpuTextureRidState> rid_state;
   godot::Ref<godot::Image> image;
   uint64_t last_retained_frame_id = 0;
+  // Content signature of the frame last uploaded, and when it was.
+  ContentSignature shown_signature{};
+  uint64_t shown_at_ns = 0;
+  // CoreRuntime::stream_result_revision() at which the entry last showed
+  // its stream's latest result; the per-tick refresh passes it over until
+  // the revision moves. 0 until then.
+  uint64_t settled_stream_result_revision = 0;
   uint64_t next_refresh_after_ns = 0;
   uint64_t last_refresh_elapsed_ns = 0;
   uint32_t width = 0;
   uint32_t height = 0;
+  // Image bytes published to the stream's DISPLAY_VIEW byte gauge; set only
+  // on the registered entry, and withdrawn when it is dropped.
+  uint64_t stream_id = 0;
+  uint64_t telemetry_image_bytes = 0;
+
+  ~LiveCpuDisplayViewEntry() {
+    global_resource_aggregate_telemetry().bytes_released(
+        make_stream_scoped_resource_telemetry(stream_id), ResourceByteGauge::DISPLAY_VIEW, telemetry_image_bytes);
+  }
 };
 
 constexpr uint64_t kLiveCpuDisplayRefreshIntervalNs = 66'666'667ull;
 constexpr uint64_t kLiveCpuDisplayRefreshBudgetNs = 4'000'000ull;
 constexpr uint64_t kLiveCpuDisplayRefreshBackoffMaxNs = 500'000'000ull;
+// Longest a newer frame with the shown frame's content signature is left
+// unshown, so a change the signature does not sample still appears.
+constexpr uint64_t kLiveCpuDisplayUnchangedContentMaxAgeNs = 500'000'000ull;
 
 bool ensure_live_cpu_image_storage(
     LiveCpuDisplayViewEntry& entry,
@@ -157,34 +193,168 @@ bool write_live_cpu_rgba_pixels(
   if (!data || entry.image.is_null()) {
     return false;
   }
-  const size_t required = static_cast<size_t>(width) * static_cast<size_t>(height) * 4u;
-  if (data->payload.size_bytes() < required) {
+  if (data->payload.width != width || data->payload.height != height) {
     return false;
   }
   uint8_t* dst = entry.image->ptrw();
   if (!dst) {
     return false;
   }
-  const uint8_t* src = data->payload.data();
-  if (!src) {
-    return false;
+  const size_t required = static_cast<size_t>(width) * static_cast<size_t>(height) * 4u;
+  return copy_retained_cpu_payload_as_rgba(data->payload, dst, required);
+}
+
+// A planar payload's bytes, unconverted, for the GPU conversion pass.
+// Retained planar payloads are tightly packed, so one copy takes all planes.
+LiveCpuYuvFrame make_live_cpu_yuv_frame(const CoreResultPayloadCpuPacked& payload) {
+  LiveCpuYuvFrame frame;
+  frame.planes.resize(static_cast<int64_t>(payload.size_bytes()));
+  std::memcpy(frame.planes.ptrw(), payload.data(), payload.size_bytes());
+  frame.width = payload.width;
+  frame.height = payload.height;
+  frame.y_offset = payload.planes[0].offset_bytes;
+  frame.y_row_stride = payload.planes[0].row_stride_bytes;
+  frame.uv_row_stride = payload.planes[1].row_stride_bytes;
+  if (payload.format_fourcc == FOURCC_I420) {
+    frame.u_offset = payload.planes[1].offset_bytes;
+    frame.v_offset = payload.planes[2].offset_bytes;
+    frame.uv_pixel_stride = 1;
+  } else {
+    const uint32_t chroma = payload.planes[1].offset_bytes;
+    frame.u_offset = payload.format_fourcc == FOURCC_NV12 ? chroma : chroma + 1u;
+    frame.v_offset = payload.format_fourcc == FOURCC_NV12 ? chroma + 1u : chroma;
+    frame.uv_pixel_stride = 2;
   }
-  if (data->payload.format_fourcc == FOURCC_RGBA) {
-    std::memcpy(dst, src, required);
-    return true;
+  return frame;
+}
+
+// A BGRA payload's bytes, unswizzled, for a B8G8R8A8 texture. Row padding
+// of an adopted provider buffer is dropped; the texture is tightly packed.
+godot::PackedByteArray make_live_cpu_bgra_bytes(const CoreResultPayloadCpuPacked& payload) {
+  godot::PackedByteArray bytes;
+  const size_t row_bytes = static_cast<size_t>(payload.width) * 4u;
+  bytes.resize(static_cast<int64_t>(row_bytes * payload.height));
+  uint8_t* dst = bytes.ptrw();
+  if (payload.stride_bytes == row_bytes) {
+    std::memcpy(dst, payload.data(), row_bytes * payload.height);
+    return bytes;
   }
-  if (data->payload.format_fourcc == FOURCC_BGRA) {
-    for (size_t i = 0; i + 3 < required; i += 4) {
-      dst[i] = src[i + 2];
-      dst[i + 1] = src[i + 1];
-      dst[i + 2] = src[i];
-      dst[i + 3] = 255;
-    }
-    return true;
+  const uint8_t* src = payload.data();
+  for (uint32_t y = 0; y < payload.height; ++y) {
+    std::memcpy(dst, src, row_bytes);
+    src += payload.stride_bytes;
+    dst += row_bytes;
   }
-  return false;
+  return bytes;
 }
 
+// Converts retained payloads into live display images on one background
+// thread, so the per-tick refresh only hands a ready image to the texture.
+// Jobs coalesce per view: a view asking again before its job ran just
+// replaces the result to convert. Started on first use; stop() (on display
+// view teardown) drops queued jobs and joins the thread, so no conversion
+// outlives the views' Godot session.
+class LiveCpuDisplayPreparer final {
+public:
+  ~LiveCpuDisplayPreparer() { stop(); }
+
+  void request(const std::shared_ptr<LiveCpuDisplayPrepareSlot>& slot, const SharedStreamResultData& data) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (!worker_.joinable()) {
+        stop_requested_ = false;
+        try {
+          worker_ = std::thread([this] { run_(); });
+        } catch (...) {
+          return;
+        }
+      }
+      // Order: mutex_, then a slot's; the worker never holds both.
+      std::lock_guard<std::mutex> slot_lock(slot->mutex);
+      if (slot->pending && slot->requested_retained_frame_id == data->retained_frame_id) {
+        return;
+      }
+      jobs_[slot] = data;
+      slot->pending = true;
+      slot->requested_retained_frame_id = data->retained_frame_id;
+    }
+    cv_.notify_one();
+  }
+
+  void stop() {
+    std::map<std::shared_ptr<LiveCpuDisplayPrepareSlot>, SharedStreamResultData> dropped;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stop_requested_ = true;
+      dropped.swap(jobs_);
+    }
+    cv_.notify_all();
+    if (worker_.joinable()) {
+      worker_.join();
+    }
+    for (const auto& job : dropped) {
+      std::lock_guard<std::mutex> slot_lock(job.first->mutex);
+      job.first->pending = false;
+    }
+  }
+
+private:
+  void run_() {
+    for (;;) {
+      std::shared_ptr<LiveCpuDisplayPrepareSlot> slot;
+      SharedStreamResultData data;
+      {
+        std::unique_lock<std::mutex> lock(mutex_);
+        cv_.wait(lock, [this] { return stop_requested_ || !jobs_.empty(); });
+        if (stop_requested_) {
+          return;
+        }
+        auto it = jobs_.begin();
+        slot = it->first;
+        data = std::move(it->second);
+        jobs_.erase(it);
+      }
+
+      // An unshown prepared image is superseded by this job, so it is the
+      // one overwritten.
+      godot::Ref<godot::Image> image;
+      {
+        std::lock_guard<std::mutex> slot_lock(slot->mutex);
+        image = slot->prepared.is_valid() ? std::move(slot->prepared) : std::move(slot->spare);
+        slot->prepared = godot::Ref<godot::Image>();
+        slot->spare = godot::Ref<godot::Image>();
+      }
+      LiveCpuDisplayViewEntry working_entry;
+      working_entry.image = image;
+      working_entry.width = image.is_valid() ? static_cast<uint32_t>(image->get_width()) : 0;
+      working_entry.height = image.is_valid() ? static_cast<uint32_t>(image->get_height()) : 0;
+      const uint32_t width = data->payload.width;
+      const uint32_t height = data->payload.height;
+      const bool converted = ensure_live_cpu_image_storage(working_entry, width, height) &&
+          write_live_cpu_rgba_pixels(working_entry, data, width, height);
+
+      std::lock_guard<std::mutex> slot_lock(slot->mutex);
+      if (slot->requested_retained_frame_id == data->retained_frame_id) {
+        slot->pending = false;
+      }
+      if (converted) {
+        slot->prepared = working_entry.image;
+        slot->prepared_retained_frame_id = data->retained_frame_id;
+      } else {
+        slot->spare = working_entry.image;
+      }
+    }
+  }
+
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::map<std::shared_ptr<LiveCpuDisplayPrepareSlot>, SharedStreamResultData> jobs_;
+  bool stop_requested_ = false;
+  std::thread worker_;
+};
+
+LiveCpuDisplayPreparer g_live_cpu_display_preparer;
+
 std::mutex g_live_cpu_display_views_mutex;
 std::map<uint64_t, std::shared_ptr<LiveCpuDisplayViewEntry>> g_live_cpu_display_views;
 
@@ -200,6 +370,7 @@ struct LiveCpuDisplayMetrics {
   uint64_t ephemeral_total_ns = 0;
   uint64_t ephemeral_update_ns = 0;
   uint64_t skipped_unchanged = 0;
+  uint64_t skipped_unchanged_content = 0;
   uint64_t skipped_due_budget = 0;
   uint64_t skipped_due_no_demand = 0;
   uint64_t removed = 0;
@@ -244,6 +415,11 @@ void note_live_cpu_display_refresh_skip_unchanged() {
   ++g_live_cpu_display_metrics.skipped_unchanged;
 }
 
+void note_live_cpu_display_refresh_skip_unchanged_content() {
+  std::lock_guard<std::mutex> lock(g_live_cpu_display_metrics_mutex);
+  ++g_live_cpu_display_metrics.skipped_unchanged_content;
+}
+
 void note_live_cpu_display_refresh_skip_due_budget() {
   std::lock_guard<std::mutex> lock(g_live_cpu_display_metrics_mutex);
   ++g_live_cpu_display_metrics.skipped_due_budget;
@@ -287,6 +463,8 @@ godot::Dictionary snapshot_live_cpu_display_metrics() {
       static_cast<double>(g_live_cpu_display_metrics.ephemeral_update_ns) / 1'000'000.0;
   d["cpu_display_refresh_skipped_unchanged"] =
       static_cast<uint64_t>(g_live_cpu_display_metrics.skipped_unchanged);
+  d["cpu_display_refresh_skipped_unchanged_content"] =
+      static_cast<uint64_t>(g_live_cpu_display_metrics.skipped_unchanged_content);
   d["cpu_display_refresh_skipped_due_budget"] =
       static_cast<uint64_t>(g_live_cpu_display_metrics.skipped_due_budget);
   d["cpu_display_refresh_skipped_due_no_demand"] =
@@ -318,6 +496,12 @@ bool refresh_live_cpu_display_view_entry(
   const uint64_t now_ns = result_access_now_ns();
   const uint32_t width = data->payload.width;
   const uint32_t height = data->payload.height;
+  // With a RenderingDevice, planar frames upload their planes and convert on
+  // the GPU, and BGRA frames upload as-is to a B8G8R8A8 texture; both skip
+  // the preparer's conversion.
+  const bool gpu_yuv = data->payload.is_planar() && live_cpu_yuv_display_conversion_available();
+  const bool gpu_bgra = data->payload.format_fourcc == FOURCC_BGRA && live_cpu_bgra_display_upload_available();
+  const bool device_upload = gpu_yuv || gpu_bgra;
   uint32_t prior_width = 0;
   uint32_t prior_height = 0;
   {
@@ -341,7 +525,31 @@ bool refresh_live_cpu_display_view_entry(
       }
       return true;
     }
+    // A newer frame of a static scene: identical signature, same size.
+    const bool unchanged_content =
+        !force_refresh &&
+        entry.width == width &&
+        entry.height == height &&
+        entry.rid_state &&
+        entry.rid_state->snapshot_rid().is_valid() &&
+        now_ns - entry.shown_at_ns < kLiveCpuDisplayUnchangedContentMaxAgeNs &&
+        content_signature_difference(entry.shown_signature, data->content_signature) == 0;
+    if (unchanged_content) {
+      note_live_cpu_display_refresh_skip_unchanged_content();
+      if (display_demand_trace_enabled()) {
+        godot::UtilityFunctions::print(
+            "[CamBANG][DemandTrace] cpu_display_refresh stream_id=",
+            static_cast<uint64_t>(data->stream_id),
+            " action=skipped_unchanged_content demand_active=",
+            demand_active);
+      }
+      return true;
+    }
     if (!force_refresh && now_ns < entry.next_refresh_after_ns) {
+      // Convert meanwhile, so the image is ready once the budget allows.
+      if (!device_upload) {
+        g_live_cpu_display_preparer.request(entry.prepare, data);
+      }
       note_live_cpu_display_refresh_skip_due_budget();
       if (display_demand_trace_enabled()) {
         godot::UtilityFunctions::print(
@@ -355,6 +563,7 @@ bool refresh_live_cpu_display_view_entry(
       return true;
     }
   }
+  frame_latency_trace_record(FrameLatencyHop::GodotPickup, data->stream_id, data->trace_id);
 
   godot::Ref<godot::Image> image;
   std::shared_ptr<SharedLiveCpuTextureRidState> rid_state;
@@ -370,13 +579,41 @@ bool refresh_live_cpu_display_view_entry(
     }
   }
 
+  // The per-tick refresh shows an image the preparer converted off the main
+  // thread, and waits a tick for one not ready yet; a forced refresh (a
+  // view's first image, or an ephemeral view) converts here.
   LiveCpuDisplayViewEntry working_entry;
-  working_entry.image = image;
   working_entry.width = width;
   working_entry.height = height;
-  if (!ensure_live_cpu_image_storage(working_entry, width, height) ||
-      !write_live_cpu_rgba_pixels(working_entry, data, width, height)) {
-    return false;
+  bool from_preparer = false;
+  if (!device_upload) {
+    std::lock_guard<std::mutex> lock(entry.prepare->mutex);
+    if (entry.prepare->prepared.is_valid() &&
+        entry.prepare->prepared_retained_frame_id == data->retained_frame_id &&
+        static_cast<uint32_t>(entry.prepare->prepared->get_width()) == width &&
+        static_cast<uint32_t>(entry.prepare->prepared->get_height()) == height) {
+      working_entry.image = std::move(entry.prepare->prepared);
+      entry.prepare->prepared = godot::Ref<godot::Image>();
+      from_preparer = true;
+    }
+  }
+  if (!device_upload && !from_preparer) {
+    if (!force_refresh) {
+      g_live_cpu_display_preparer.request(entry.prepare, data);
+      if (display_demand_trace_enabled()) {
+        godot::UtilityFunctions::print(
+            "[CamBANG][DemandTrace] cpu_display_refresh stream_id=",
+            static_cast<uint64_t>(data->stream_id),
+            " action=preparing demand_active=",
+            demand_active);
+      }
+      return true;
+    }
+    working_entry.image = image;
+    if (!ensure_live_cpu_image_storage(working_entry, width, height) ||
+        !write_live_cpu_rgba_pixels(working_entry, data, width, height)) {
+      return false;
+    }
   }
 
   godot::RenderingServer* rs = godot::RenderingServer::get_singleton();
@@ -386,9 +623,16 @@ bool refresh_live_cpu_display_view_entry(
   const bool need_recreate =
       !rid_state->snapshot_rid().is_valid() ||
       prior_width != width ||
-      prior_height != height;
+      prior_height != height ||
+      rid_state->holds_device_texture();
   const auto refresh_begin = std::chrono::steady_clock::now();
-  if (need_recreate) {
+  if (gpu_yuv) {
+    // Creation, upload and conversion all happen on the render thread; the
+    // same eventual-consistency gap as the create path below applies.
+    enqueue_live_cpu_yuv_texture_upload(rid_state, make_live_cpu_yuv_frame(data->payload));
+  } else if (gpu_bgra) {
+    enqueue_live_cpu_bgra_texture_upload(rid_state, make_live_cpu_bgra_bytes(data->payload), width, height);
+  } else if (need_recreate) {
     // RenderingServer::texture_2d_create() bypasses the normal async command
     // queue and executes directly on whatever thread calls it, unlike
     // free_rid()/texture_2d_update() -- see enqueue_live_cpu_texture_create()'s
@@ -407,6 +651,7 @@ bool refresh_live_cpu_display_view_entry(
     }
     rs->texture_2d_update(texture_rid, working_entry.image, 0);
   }
+  frame_latency_trace_record(FrameLatencyHop::TextureUpdate, data->stream_id, data->trace_id);
   const uint64_t refresh_elapsed_ns = elapsed_ns_since(refresh_begin);
   uint64_t next_refresh_after_ns = now_ns + kLiveCpuDisplayRefreshIntervalNs;
   if (refresh_elapsed_ns > kLiveCpuDisplayRefreshBudgetNs) {
@@ -415,15 +660,33 @@ bool refresh_live_cpu_display_view_entry(
     next_refresh_after_ns = now_ns + backoff_ns;
   }
 
+  const uint64_t image_bytes = static_cast<uint64_t>(width) * static_cast<uint64_t>(height) * 4u;
+  uint64_t prior_image_bytes = 0;
   {
     std::lock_guard<std::mutex> lock(entry.mutex);
     entry.image = working_entry.image;
+    if (from_preparer && image.is_valid() && image != working_entry.image) {
+      std::lock_guard<std::mutex> prepare_lock(entry.prepare->mutex);
+      entry.prepare->spare = image;
+    }
     entry.rid_state = rid_state;
     entry.last_retained_frame_id = data->retained_frame_id;
+    entry.shown_signature = data->content_signature;
+    entry.shown_at_ns = now_ns;
     entry.last_refresh_elapsed_ns = refresh_elapsed_ns;
     entry.next_refresh_after_ns = next_refresh_after_ns;
     entry.width = width;
     entry.height = height;
+    prior_image_bytes = entry.telemetry_image_bytes;
+    entry.stream_id = data->stream_id;
+    entry.telemetry_image_bytes = image_bytes;
+  }
+  if (image_bytes != prior_image_bytes) {
+    const ScopedResourceTelemetryKey telemetry_key = make_stream_scoped_resource_telemetry(data->stream_id);
+    global_resource_aggregate_telemetry().bytes_released(
+        telemetry_key, ResourceByteGauge::DISPLAY_VIEW, prior_image_bytes);
+    global_resource_aggregate_telemetry().bytes_retained(
+        telemetry_key, ResourceByteGauge::DISPLAY_VIEW, image_bytes);
   }
   notify_live_cpu_display_wrapper_refresh(data->stream_id, width, height);
   note_live_cpu_display_refresh_attempt(
@@ -517,22 +780,41 @@ uint64_t CamBANGStreamResult::get_stream_id() const { return data_ ? data_->stre
 uint64_t CamBANGStreamResult::get_device_instance_id() const { return data_ ? data_->device_instance_id : 0; }
 int CamBANGStreamResult::get_intent() const { return data_ ? static_cast<int>(data_->intent) : 0; }
 godot::Dictionary CamBANGStreamResult::get_camera_facts() const {
-  if (!data_) {
-    return godot::Dictionary();
+  if (!camera_facts_built_) {
+    camera_facts_ = godot::Dictionary();
+    if (data_) {
+      add_acquisition_timing_camera_fact(camera_facts_, data_->image_facts.acquisition_timing);
+      if (camera_facts_.has("acquisition_timing")) {
+        godot::Dictionary timing = camera_facts_["acquisition_timing"];
+        timing.make_read_only();
+      }
+    }
+    camera_facts_.make_read_only();
+    camera_facts_built_ = true;
   }
-  godot::Dictionary out;
-  add_acquisition_timing_camera_fact(out, data_->image_facts.acquisition_timing);
-  return out;
+  return camera_facts_;
 }
 
 bool CamBANGStreamResult::has_image_properties() const { return data_ && data_->facts.has_image_properties; }
 
 godot::Dictionary CamBANGStreamResult::get_image_properties() const {
-  return has_image_properties() ? to_dict(data_->facts.image_properties) : godot::Dictionary();
+  if (!image_properties_built_) {
+    image_properties_ = has_image_properties() ? to_dict(data_->facts.image_properties) : godot::Dictionary();
+    image_properties_.make_read_only();
+    image_properties_built_ = true;
+  }
+  return image_properties_;
 }
 
 godot::Dictionary CamBANGStreamResult::get_image_properties_provenance() const {
-  return has_image_properties() ? to_dict(data_->facts.image_properties_provenance) : godot::Dictionary();
+  if (!image_properties_provenance_built_) {
+    image_properties_provenance_ = has_image_properties()
+        ? to_dict(data_->facts.image_properties_provenance)
+        : godot::Dictionary();
+    image_properties_provenance_.make_read_only();
+    image_properties_provenance_built_ = true;
+  }
+  return image_properties_provenance_;
 }
 
 int CamBANGStreamResult::can_get_display_view() const {
@@ -571,7 +853,7 @@ int CamBANGStreamResult::get_display_view_path_kind() const {
 godot::Variant perform_stream_display_view_access(
     const SharedStreamResultData& data,
     bool mark_display_demand,
-    bool persistent_cpu_display_view) {
+    bool persistent_display_view) {
   if (!data) {
     const uint64_t begin_ns = result_access_now_ns();
     result_access_cost_evidence::record_stream_access(
@@ -596,9 +878,11 @@ godot::Variant perform_stream_display_view_access(
   }
   if (data->payload_kind == ResultPayloadKind::GPU_SURFACE) {
     if (data->retained_gpu_backing) {
+      // Calibration measures building a view, not borrowing the shared one.
       godot::Ref<godot::Texture2D> retained = godot_gpu_display_get_texture_by_descriptor(
           data->retained_gpu_backing_descriptor,
-          data->retained_gpu_backing);
+          data->retained_gpu_backing,
+          /*share_display_view=*/persistent_display_view);
       if (retained.is_valid()) {
         trace_stream_display_path("retained_gpu_backing");
         result = retained;
@@ -619,7 +903,7 @@ godot::Variant perform_stream_display_view_access(
         reported_capability);
     return result;
   }
-  godot::Ref<godot::Texture2D> live_cpu = persistent_cpu_display_view
+  godot::Ref<godot::Texture2D> live_cpu = persistent_display_view
       ? ensure_live_cpu_display_view(data)
       : make_ephemeral_cpu_display_view(data);
   if (live_cpu.is_valid()) {
@@ -643,7 +927,9 @@ godot::Variant perform_stream_display_view_access(
 }
 
 
-godot::Ref<godot::Image> perform_stream_to_image_access(const SharedStreamResultData& data) {
+godot::Ref<godot::Image> perform_stream_to_image_access(const SharedStreamResultData& data,
+                                                        bool reuse_converted_image,
+                                                        godot::Image::Format format = godot::Image::FORMAT_RGBA8) {
   if (!data) {
     const uint64_t begin_ns = result_access_now_ns();
     godot::Ref<godot::Image> image;
@@ -663,7 +949,7 @@ godot::Ref<godot::Image> perform_stream_to_image_access(const SharedStreamResult
   const uint64_t begin_ns = result_access_now_ns();
   godot::Ref<godot::Image> image;
   if (has_current_retained_cpu_payload(data)) {
-    image = payload_to_image(data->payload);
+    image = payload_to_image(data->payload, reuse_converted_image ? data->retained_frame_id : 0, format);
     result_access_cost_evidence::record_stream_access(
         evidence_route,
         data,
@@ -673,9 +959,11 @@ godot::Ref<godot::Image> perform_stream_to_image_access(const SharedStreamResult
     return image;
   }
   if (data->payload_kind == ResultPayloadKind::GPU_SURFACE && data->retained_gpu_backing) {
-    image = godot_gpu_display_materialize_to_image(
+    image = gpu_backing_to_image(
         data->retained_gpu_backing_descriptor,
-        data->retained_gpu_backing);
+        data->retained_gpu_backing,
+        reuse_converted_image ? data->retained_frame_id : 0,
+        format);
     result_access_cost_evidence::record_stream_access(
         evidence_route,
         data,
@@ -718,6 +1006,31 @@ godot::Ref<godot::Image> perform_stream_to_image_cpu_payload_access(const Shared
   return image;
 }
 
+godot::Ref<godot::Image> perform_stream_to_reduced_sidecar_image_access(const SharedStreamResultData& data,
+                                                                         godot::Image::Format format) {
+  const uint64_t begin_ns = result_access_now_ns();
+  godot::Ref<godot::Image> image;
+  if (!data || !has_reduced_cpu_sidecar(*data)) {
+    result_access_cost_evidence::record_stream_access(
+        result_access_cost_evidence::kRouteStreamAccessUnsupported,
+        data,
+        result_access_now_ns() - begin_ns,
+        false,
+        ResultCapability::UNSUPPORTED);
+    return image;
+  }
+  // The sidecar is already CPU bytes at its own size: the same cheap
+  // conversion as a full sidecar, on downscale^2 fewer pixels.
+  image = payload_to_image(data->payload, data->retained_frame_id, format);
+  result_access_cost_evidence::record_stream_access(
+      result_access_cost_evidence::kRouteStreamToImageGpuPrimaryReducedCpuSidecar,
+      data,
+      result_access_now_ns() - begin_ns,
+      image.is_valid(),
+      ResultCapability::CHEAP);
+  return image;
+}
+
 godot::Ref<godot::Image> perform_stream_to_image_gpu_materializer_access(const SharedStreamResultData& data) {
   const uint64_t begin_ns = result_access_now_ns();
   godot::Ref<godot::Image> image;
@@ -751,22 +1064,40 @@ godot::Variant CamBANGStreamResult::get_display_view() const {
   return perform_stream_display_view_access(
       data_,
       /*mark_display_demand=*/true,
-      /*persistent_cpu_display_view=*/true);
+      /*persistent_display_view=*/true);
 }
 
-godot::Ref<godot::Image> CamBANGStreamResult::to_image() const {
-  return perform_stream_to_image_access(data_);
+godot::Ref<godot::Image> CamBANGStreamResult::to_image(godot::Image::Format format) const {
+  return perform_stream_to_image_access(data_, /*reuse_converted_image=*/true, format);
+}
+
+godot::Ref<godot::Image> CamBANGStreamResult::to_reduced_sidecar_image(godot::Image::Format format) const {
+  return perform_stream_to_reduced_sidecar_image_access(data_, format);
+}
+
+bool CamBANGStreamResult::is_content_changed_since(const godot::Ref<CamBANGStreamResult>& previous,
+                                                   int threshold) const {
+  if (!data_ || previous.is_null() || !previous->data_ || previous->data_->stream_id != data_->stream_id) {
+    return true;
+  }
+  if (previous->data_->retained_frame_id == data_->retained_frame_id) {
+    return false;
+  }
+  return static_cast<int64_t>(
+             content_signature_difference(previous->data_->content_signature, data_->content_signature)) >
+         threshold;
 }
 
 godot::Variant CamBANGStreamResult::calibrate_display_view_for_retained_access(const SharedStreamResultData& data) {
   return perform_stream_display_view_access(
       data,
       /*mark_display_demand=*/false,
-      /*persistent_cpu_display_view=*/false);
+      /*persistent_display_view=*/false);
 }
 
 godot::Ref<godot::Image> CamBANGStreamResult::calibrate_to_image_for_retained_access(const SharedStreamResultData& data) {
-  return perform_stream_to_image_access(data);
+  // Calibration measures the real conversion, never a cache hit.
+  return perform_stream_to_image_access(data, /*reuse_converted_image=*/false);
 }
 
 godot::Ref<godot::Image> CamBANGStreamResult::calibrate_to_image_cpu_payload_for_retained_access(
@@ -800,7 +1131,14 @@ void CamBANGStreamResult::_bind_methods() {
 
   godot::ClassDB::bind_method(godot::D_METHOD("get_display_view_path_kind"), &CamBANGStreamResult::get_display_view_path_kind);
   godot::ClassDB::bind_method(godot::D_METHOD("get_display_view"), &CamBANGStreamResult::get_display_view);
-  godot::ClassDB::bind_method(godot::D_METHOD("to_image"), &CamBANGStreamResult::to_image);
+  godot::ClassDB::bind_method(godot::D_METHOD("to_image", "format"), &CamBANGStreamResult::to_image,
+                              DEFVAL(godot::Image::FORMAT_RGBA8));
+  godot::ClassDB::bind_method(godot::D_METHOD("to_reduced_sidecar_image", "format"),
+                              &CamBANGStreamResult::to_reduced_sidecar_image,
+                              DEFVAL(godot::Image::FORMAT_RGBA8));
+  godot::ClassDB::bind_method(godot::D_METHOD("is_content_changed_since", "previous", "threshold"),
+                              &CamBANGStreamResult::is_content_changed_since,
+                              DEFVAL(0));
 
   BIND_CONSTANT(CAPABILITY_READY);
   BIND_CONSTANT(CAPABILITY_CHEAP);
@@ -812,7 +1150,7 @@ void CamBANGStreamResult::_bind_methods() {
   BIND_CONSTANT(DISPLAY_PATH_STREAM_LIVE_CPU_DISPLAY_VIEW);
 }
 
-void CamBANGStreamResult::refresh_live_stream_cpu_display_views(const CoreRuntime& runtime) {
+void CamBANGStreamResult::refresh_live_stream_cpu_display_views(CoreRuntime& runtime) {
   struct RefreshCandidate final {
     uint64_t stream_id = 0;
     std::shared_ptr<LiveCpuDisplayViewEntry> entry;
@@ -827,6 +1165,9 @@ void CamBANGStreamResult::refresh_live_stream_cpu_display_views(const CoreRuntim
     }
   }
 
+  // Read before any result below, so a result published meanwhile leaves
+  // its entry unsettled for the next tick.
+  const uint64_t stream_result_revision = runtime.stream_result_revision();
   const auto refresh_begin = std::chrono::steady_clock::now();
   uint32_t removed_count = 0;
   uint32_t refreshed_count = 0;
@@ -834,6 +1175,12 @@ void CamBANGStreamResult::refresh_live_stream_cpu_display_views(const CoreRuntim
   uint32_t skipped_no_demand_count = 0;
   for (const RefreshCandidate& candidate : candidates) {
     const uint64_t stream_id = candidate.stream_id;
+    if (candidate.entry) {
+      std::lock_guard<std::mutex> entry_lock(candidate.entry->mutex);
+      if (candidate.entry->settled_stream_result_revision == stream_result_revision) {
+        continue;
+      }
+    }
     SharedStreamResultData data = runtime.get_latest_stream_result(stream_id);
     if (!data) {
       std::lock_guard<std::mutex> lock(g_live_cpu_display_views_mutex);
@@ -859,7 +1206,7 @@ void CamBANGStreamResult::refresh_live_stream_cpu_display_views(const CoreRuntim
       }
       continue;
     }
-    if (data->payload_kind == ResultPayloadKind::CPU_PACKED && has_current_retained_cpu_payload(data)) {
+    if (is_cpu_payload_kind(data->payload_kind) && has_current_retained_cpu_payload(data)) {
       uint64_t prior_retained_frame_id = 0;
       {
         std::lock_guard<std::mutex> entry_lock(candidate.entry->mutex);
@@ -871,10 +1218,16 @@ void CamBANGStreamResult::refresh_live_stream_cpu_display_views(const CoreRuntim
         {
           std::lock_guard<std::mutex> entry_lock(candidate.entry->mutex);
           latest_retained_frame_id = candidate.entry->last_retained_frame_id;
+          if (latest_retained_frame_id == data->retained_frame_id) {
+            candidate.entry->settled_stream_result_revision = stream_result_revision;
+          }
         }
         if (latest_retained_frame_id != prior_retained_frame_id) {
           ++updated_count;
         }
+        if (latest_retained_frame_id == data->retained_frame_id) {
+          runtime.note_stream_result_displayed(*data);
+        }
       }
     } else if (display_demand_trace_enabled()) {
       godot::UtilityFunctions::print(
@@ -913,6 +1266,7 @@ void CamBANGStreamResult::remove_live_stream_cpu_display_view(uint64_t stream_id
 }
 
 void CamBANGStreamResult::clear_live_stream_cpu_display_views() {
+  g_live_cpu_display_preparer.stop();
   std::lock_guard<std::mutex> lock(g_live_cpu_display_views_mutex);
   g_live_cpu_display_views.clear();
   clear_live_cpu_display_metrics();
@@ -922,4 +1276,10 @@ godot::Dictionary CamBANGStreamResult::get_live_stream_cpu_display_metrics_snaps
   return snapshot_live_cpu_display_metrics();
 }
 
+void CamBANGStreamResult::get_live_stream_cpu_display_refresh_totals(uint64_t& updated, uint64_t& total_ns) {
+  std::lock_guard<std::mutex> lock(g_live_cpu_display_metrics_mutex);
+  updated = g_live_cpu_display_metrics.refresh_updated;
+  total_ns = g_live_cpu_display_metrics.total_ns;
+}
+
 } // namespace cambang
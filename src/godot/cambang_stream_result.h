@@ -29,7 +29,13 @@ public:
 
   CamBANGStreamResult() = default;
 
-  void set_data(SharedStreamResultData data) { data_ = std::move(data); }
+  void set_data(SharedStreamResultData data) {
+    data_ = std::move(data);
+    camera_facts_built_ = false;
+    image_properties_built_ = false;
+    image_properties_provenance_built_ = false;
+  }
+  const SharedStreamResultData& data() const noexcept { return data_; }
 
   uint32_t get_width() const;
   uint32_t get_height() const;
@@ -51,12 +57,25 @@ public:
 
   int get_display_view_path_kind() const;
   godot::Variant get_display_view() const;
-  godot::Ref<godot::Image> to_image() const;
-
-  static void refresh_live_stream_cpu_display_views(const CoreRuntime& runtime);
+  // format: a Godot Image::Format; RGBA8, RGB8 and L8 convert in one pass.
+  godot::Ref<godot::Image> to_image(godot::Image::Format format = godot::Image::FORMAT_RGBA8) const;
+  // The reduced-resolution CPU sidecar of a GPU-primary result whose stream
+  // profile set cpu_sidecar_downscale, at the sidecar's own size; null when
+  // the result has none. to_image() never returns it.
+  godot::Ref<godot::Image> to_reduced_sidecar_image(godot::Image::Format format = godot::Image::FORMAT_RGBA8) const;
+  // True when this result's content differs from previous (an earlier
+  // result of the same stream) by more than threshold, the largest change
+  // of any content-signature cell on a 0-255 scale. A result of another
+  // stream, or one without a CPU payload to summarise, always reads as
+  // changed.
+  bool is_content_changed_since(const godot::Ref<CamBANGStreamResult>& previous, int threshold = 0) const;
+
+  static void refresh_live_stream_cpu_display_views(CoreRuntime& runtime);
   static void remove_live_stream_cpu_display_view(uint64_t stream_id);
   static void clear_live_stream_cpu_display_views();
   static godot::Dictionary get_live_stream_cpu_display_metrics_snapshot();
+  // Cumulative refresh updates and refresh time, for Performance monitors.
+  static void get_live_stream_cpu_display_refresh_totals(uint64_t& updated, uint64_t& total_ns);
   static godot::Variant calibrate_display_view_for_retained_access(const SharedStreamResultData& data);
   static godot::Ref<godot::Image> calibrate_to_image_for_retained_access(const SharedStreamResultData& data);
   static godot::Ref<godot::Image> calibrate_to_image_cpu_payload_for_retained_access(const SharedStreamResultData& data);
@@ -66,6 +85,15 @@ public:
 
 private:
   SharedStreamResultData data_;
+
+  // Fact Dictionaries built from data_ on first access and returned
+  // read-only after that; data_ does not change once set.
+  mutable godot::Dictionary camera_facts_;
+  mutable godot::Dictionary image_properties_;
+  mutable godot::Dictionary image_properties_provenance_;
+  mutable bool camera_facts_built_ = false;
+  mutable bool image_properties_built_ = false;
+  mutable bool image_properties_provenance_built_ = false;
 };
 
 } // namespace cambang
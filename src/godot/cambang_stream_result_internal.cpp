@@ -1,13 +1,21 @@
 #include "godot/cambang_stream_result_internal.h"
 
+#include <atomic>
 #include <cstdint>
 #include <condition_variable>
 #include <cstdio>
 #include <cstdlib>
+#include <cstring>
 #include <map>
 #include <mutex>
 #include <utility>
 #include <vector>
+#include <godot_cpp/classes/rd_shader_source.hpp>
+#include <godot_cpp/classes/rd_shader_spirv.hpp>
+#include <godot_cpp/classes/rd_texture_format.hpp>
+#include <godot_cpp/classes/rd_texture_view.hpp>
+#include <godot_cpp/classes/rd_uniform.hpp>
+#include <godot_cpp/classes/rendering_device.hpp>
 #include <godot_cpp/classes/rendering_server.hpp>
 #include <godot_cpp/core/class_db.hpp>
 #include <godot_cpp/core/object.hpp>
@@ -15,6 +23,7 @@
 #include <godot_cpp/variant/color.hpp>
 #include <godot_cpp/variant/rect2.hpp>
 #include <godot_cpp/variant/string_name.hpp>
+#include <godot_cpp/variant/typed_array.hpp>
 #include <godot_cpp/variant/vector2.hpp>
 #include <godot_cpp/variant/utility_functions.hpp>
 
@@ -38,9 +47,29 @@ std::mutex g_live_cpu_display_wrapper_borrow_mutex;
 std::map<uint64_t, CpuDisplayWrapperBorrow> g_live_cpu_display_wrapper_borrows;
 std::map<uint64_t, uint32_t> g_live_cpu_display_wrapper_borrow_counts;
 
+// An RGBA image to create a texture from, a planar frame for the
+// conversion pass, or a BGRA frame to upload as-is.
 struct PendingLiveCpuTextureCreate final {
+  enum class Kind : uint8_t {
+    RGBA_IMAGE,
+    YUV_FRAME,
+    BGRA_FRAME,
+  };
+
   std::shared_ptr<SharedLiveCpuTextureRidState> rid_state;
+  Kind kind = Kind::RGBA_IMAGE;
   godot::Ref<godot::Image> image;
+  LiveCpuYuvFrame yuv_frame;
+  godot::PackedByteArray bgra_bytes;
+  uint32_t bgra_width = 0;
+  uint32_t bgra_height = 0;
+};
+
+// A RenderingServer texture and the RenderingDevice resources behind it,
+// freed in that order so the wrapper never outlives the texture it wraps.
+struct PendingLiveCpuTextureRelease final {
+  godot::RID texture_rid;
+  godot::RID device_rids[2];
 };
 
 // Guards both the pending-create and pending-release queues below: both feed
@@ -60,7 +89,7 @@ LiveCpuTextureCreateDrainHelper* g_live_cpu_texture_create_drain_helper = nullpt
 // waiting to be freed, so there is nothing to deduplicate against (contrast
 // g_pending_live_cpu_texture_creates, which is keyed by rid_state identity
 // so a fast-refreshing stream only ever creates from its latest image).
-std::vector<godot::RID> g_pending_live_cpu_texture_releases;
+std::vector<PendingLiveCpuTextureRelease> g_pending_live_cpu_texture_releases;
 bool g_pending_live_cpu_texture_release_drain_scheduled = false;
 bool g_pending_live_cpu_texture_release_drain_running = false;
 std::size_t g_live_cpu_release_producers = 0;
@@ -75,6 +104,25 @@ enum class LiveCpuDisplayBridgePhase {
 LiveCpuDisplayBridgePhase g_live_cpu_display_bridge_phase =
     LiveCpuDisplayBridgePhase::Closed;
 
+// Whether a render-thread upload path has been set up. Failed is sticky
+// until the bridge is reinstalled: frames then take the RGBA path.
+enum class LiveCpuDevicePathState : uint8_t {
+  Unbuilt,
+  Ready,
+  Failed,
+};
+
+// The YUV conversion pipeline, built by the first create drain with a planar
+// frame. The RIDs are guarded by g_pending_live_cpu_texture_mutex and
+// released by bridge uninstall.
+std::atomic<LiveCpuDevicePathState> g_live_cpu_yuv_compute_state{LiveCpuDevicePathState::Unbuilt};
+godot::RID g_live_cpu_yuv_compute_shader;
+godot::RID g_live_cpu_yuv_compute_pipeline;
+
+// Whether the RenderingDevice samples B8G8R8A8_UNORM textures, checked by
+// the first create drain with a BGRA frame.
+std::atomic<LiveCpuDevicePathState> g_live_cpu_bgra_upload_state{LiveCpuDevicePathState::Unbuilt};
+
 std::mutex g_live_cpu_texture_rid_state_registry_mutex;
 std::map<uint64_t, std::weak_ptr<SharedLiveCpuTextureRidState>>
     g_live_cpu_texture_rid_state_registry;
@@ -217,8 +265,11 @@ void request_pending_live_cpu_texture_release_drain() {
 // that reason. Mirror that discipline here so both display paths are
 // consistent rather than resting on a policy-vs-guarantee distinction only
 // one of the two paths bothers to make.
-void release_live_cpu_texture_rid(const godot::RID& rid) {
-  if (!rid.is_valid()) {
+void release_live_cpu_texture_rid(
+    const godot::RID& rid,
+    const godot::RID& device_texture = godot::RID(),
+    const godot::RID& device_plane_buffer = godot::RID()) {
+  if (!rid.is_valid() && !device_texture.is_valid() && !device_plane_buffer.is_valid()) {
     return;
   }
   LiveCpuReleaseProducerLease release_admission;
@@ -231,11 +282,312 @@ void release_live_cpu_texture_rid(const godot::RID& rid) {
   }
   {
     std::lock_guard<std::mutex> lock(g_pending_live_cpu_texture_mutex);
-    g_pending_live_cpu_texture_releases.push_back(rid);
+    g_pending_live_cpu_texture_releases.push_back(
+        PendingLiveCpuTextureRelease{rid, {device_texture, device_plane_buffer}});
   }
   request_pending_live_cpu_texture_release_drain();
 }
 
+// One pixel per invocation, with the integer math of
+// convert_yuv420_rows_to_packed() (pixels/convert/yuv420_to_rgba.cpp), so
+// the pass writes the bytes the CPU conversion would. The planes arrive as
+// raw bytes in a uint buffer, four to a word; offsets and strides are in
+// bytes.
+const char* const kLiveCpuYuvComputeShaderSource = R"GLSL(
+#version 450
+layout(local_size_x = 8, local_size_y = 8, local_size_z = 1) in;
+layout(set = 0, binding = 0, std430) restrict readonly buffer Planes {
+  uint words[];
+} planes;
+layout(rgba8, set = 0, binding = 1) uniform restrict writeonly image2D out_image;
+layout(push_constant, std430) uniform Params {
+  uint width;
+  uint height;
+  uint y_offset;
+  uint y_row_stride;
+  uint u_offset;
+  uint v_offset;
+  uint uv_row_stride;
+  uint uv_pixel_stride;
+} params;
+
+int plane_byte(uint index) {
+  return int((planes.words[index >> 2] >> ((index & 3u) * 8u)) & 0xFFu);
+}
+
+void main() {
+  const uvec2 p = gl_GlobalInvocationID.xy;
+  if (p.x >= params.width || p.y >= params.height) {
+    return;
+  }
+  const uint uv_index = (p.y / 2u) * params.uv_row_stride + (p.x / 2u) * params.uv_pixel_stride;
+  const int c = plane_byte(params.y_offset + p.y * params.y_row_stride + p.x) - 16;
+  const int d = plane_byte(params.u_offset + uv_index) - 128;
+  const int e = plane_byte(params.v_offset + uv_index) - 128;
+  const ivec3 rgb = clamp(ivec3(298 * c + 409 * e + 128,
+                                298 * c - 100 * d - 208 * e + 128,
+                                298 * c + 516 * d + 128) >> 8,
+                          ivec3(0), ivec3(255));
+  imageStore(out_image, ivec2(p), vec4(vec3(rgb) / 255.0, 1.0));
+}
+)GLSL";
+
+// Render thread only. Builds the YUV conversion pipeline on first use;
+// false once building it has failed, or while the bridge is closing.
+// Mirrors ensure_pattern_compute_pipeline() in synthetic_gpu_backing_bridge.cpp.
+bool ensure_live_cpu_yuv_compute_pipeline(
+    godot::RenderingDevice* rd, godot::RID& shader_out, godot::RID& pipeline_out) {
+  {
+    std::lock_guard<std::mutex> lock(g_pending_live_cpu_texture_mutex);
+    if (g_live_cpu_display_bridge_phase != LiveCpuDisplayBridgePhase::Active) {
+      return false;
+    }
+    if (g_live_cpu_yuv_compute_state.load(std::memory_order_acquire) == LiveCpuDevicePathState::Ready) {
+      shader_out = g_live_cpu_yuv_compute_shader;
+      pipeline_out = g_live_cpu_yuv_compute_pipeline;
+      return pipeline_out.is_valid();
+    }
+  }
+  if (g_live_cpu_yuv_compute_state.load(std::memory_order_acquire) == LiveCpuDevicePathState::Failed) {
+    return false;
+  }
+
+  godot::Ref<godot::RDShaderSource> source;
+  source.instantiate();
+  source->set_language(godot::RenderingDevice::SHADER_LANGUAGE_GLSL);
+  source->set_stage_source(godot::RenderingDevice::SHADER_STAGE_COMPUTE, kLiveCpuYuvComputeShaderSource);
+  const godot::Ref<godot::RDShaderSPIRV> spirv = rd->shader_compile_spirv_from_source(source);
+  godot::RID shader;
+  if (spirv.is_valid() && spirv->get_stage_compile_error(godot::RenderingDevice::SHADER_STAGE_COMPUTE).is_empty()) {
+    shader = rd->shader_create_from_spirv(spirv);
+  }
+  godot::RID built;
+  if (shader.is_valid()) {
+    built = rd->compute_pipeline_create(shader);
+  }
+  if (!built.is_valid()) {
+    if (shader.is_valid()) {
+      rd->free_rid(shader);
+    }
+    g_live_cpu_yuv_compute_state.store(LiveCpuDevicePathState::Failed, std::memory_order_release);
+    std::fprintf(stderr, "[CamBANG][CpuDisplay] YUV conversion pipeline unavailable; planar frames convert on the CPU\n");
+    std::fflush(stderr);
+    return false;
+  }
+
+  bool stored = false;
+  {
+    std::lock_guard<std::mutex> lock(g_pending_live_cpu_texture_mutex);
+    if (g_live_cpu_display_bridge_phase == LiveCpuDisplayBridgePhase::Active) {
+      g_live_cpu_yuv_compute_shader = shader;
+      g_live_cpu_yuv_compute_pipeline = built;
+      g_live_cpu_yuv_compute_state.store(LiveCpuDevicePathState::Ready, std::memory_order_release);
+      stored = true;
+    }
+  }
+  if (!stored) {
+    // Freeing the shader frees the pipeline built from it.
+    rd->free_rid(shader);
+    return false;
+  }
+  shader_out = shader;
+  pipeline_out = built;
+  return true;
+}
+
+// Render thread only. Uploads frame's planes into rid_state's storage
+// buffer and dispatches the conversion into its texture, first replacing
+// both (and the RenderingServer texture over them) when the frame's size
+// differs from theirs.
+void submit_live_cpu_yuv_frame(
+    godot::RenderingServer* rs,
+    godot::RenderingDevice* rd,
+    SharedLiveCpuTextureRidState& rid_state,
+    const LiveCpuYuvFrame& frame) {
+  godot::RID shader;
+  godot::RID pipeline;
+  if (!ensure_live_cpu_yuv_compute_pipeline(rd, shader, pipeline)) {
+    return;
+  }
+  const uint32_t buffer_bytes = static_cast<uint32_t>(frame.planes.size());
+  godot::RID texture;
+  godot::RID buffer;
+  godot::RID uniform_set;
+  {
+    std::lock_guard<std::mutex> lock(rid_state.mutex);
+    if (rid_state.invalidated) {
+      return;
+    }
+    const LiveCpuDeviceTexture& device = rid_state.device;
+    if (device.plane_buffer.is_valid() &&
+        device.width == frame.width &&
+        device.height == frame.height &&
+        device.plane_buffer_bytes == buffer_bytes) {
+      texture = device.texture;
+      buffer = device.plane_buffer;
+      uniform_set = device.uniform_set;
+    }
+  }
+  if (!texture.is_valid()) {
+    godot::Ref<godot::RDTextureFormat> format;
+    format.instantiate();
+    format->set_width(static_cast<int64_t>(frame.width));
+    format->set_height(static_cast<int64_t>(frame.height));
+    format->set_format(godot::RenderingDevice::DATA_FORMAT_R8G8B8A8_UNORM);
+    format->set_usage_bits(
+        godot::RenderingDevice::TEXTURE_USAGE_CAN_COPY_FROM_BIT |
+        godot::RenderingDevice::TEXTURE_USAGE_SAMPLING_BIT |
+        godot::RenderingDevice::TEXTURE_USAGE_STORAGE_BIT);
+    godot::Ref<godot::RDTextureView> view;
+    view.instantiate();
+    texture = rd->texture_create(format, view);
+    buffer = rd->storage_buffer_create(buffer_bytes);
+    const godot::RID texture_rid = texture.is_valid() ? rs->texture_rd_create(texture) : godot::RID();
+    if (!texture_rid.is_valid() || !buffer.is_valid()) {
+      if (texture_rid.is_valid()) {
+        rs->free_rid(texture_rid);
+      }
+      if (buffer.is_valid()) {
+        rd->free_rid(buffer);
+      }
+      if (texture.is_valid()) {
+        rd->free_rid(texture);
+      }
+      return;
+    }
+    LiveCpuDeviceTexture device;
+    device.texture = texture;
+    device.plane_buffer = buffer;
+    device.width = frame.width;
+    device.height = frame.height;
+    device.plane_buffer_bytes = buffer_bytes;
+    rid_state.replace_rid(texture_rid, device);
+    std::lock_guard<std::mutex> lock(rid_state.mutex);
+    if (rid_state.device.texture != texture) {
+      // Invalidated meanwhile; replace_rid() released the new resources.
+      return;
+    }
+  }
+  if (!uniform_set.is_valid() || !rd->uniform_set_is_valid(uniform_set)) {
+    godot::Ref<godot::RDUniform> planes_uniform;
+    planes_uniform.instantiate();
+    planes_uniform->set_uniform_type(godot::RenderingDevice::UNIFORM_TYPE_STORAGE_BUFFER);
+    planes_uniform->set_binding(0);
+    planes_uniform->add_id(buffer);
+    godot::Ref<godot::RDUniform> out_uniform;
+    out_uniform.instantiate();
+    out_uniform->set_uniform_type(godot::RenderingDevice::UNIFORM_TYPE_IMAGE);
+    out_uniform->set_binding(1);
+    out_uniform->add_id(texture);
+    godot::TypedArray<godot::RDUniform> uniforms;
+    uniforms.push_back(planes_uniform);
+    uniforms.push_back(out_uniform);
+    // A uniform set is freed with the texture and buffer it references.
+    uniform_set = rd->uniform_set_create(uniforms, shader, 0);
+    if (!uniform_set.is_valid()) {
+      return;
+    }
+    std::lock_guard<std::mutex> lock(rid_state.mutex);
+    if (rid_state.device.texture == texture) {
+      rid_state.device.uniform_set = uniform_set;
+    }
+  }
+
+  if (rd->buffer_update(buffer, 0, buffer_bytes, frame.planes) != godot::OK) {
+    return;
+  }
+  const uint32_t params[8] = {
+      frame.width,
+      frame.height,
+      frame.y_offset,
+      frame.y_row_stride,
+      frame.u_offset,
+      frame.v_offset,
+      frame.uv_row_stride,
+      frame.uv_pixel_stride,
+  };
+  godot::PackedByteArray push_constant;
+  push_constant.resize(sizeof(params));
+  std::memcpy(push_constant.ptrw(), params, sizeof(params));
+
+  const int64_t list = rd->compute_list_begin();
+  rd->compute_list_bind_compute_pipeline(list, pipeline);
+  rd->compute_list_bind_uniform_set(list, uniform_set, 0);
+  rd->compute_list_set_push_constant(list, push_constant, static_cast<uint32_t>(sizeof(params)));
+  rd->compute_list_dispatch(list, (frame.width + 7u) / 8u, (frame.height + 7u) / 8u, 1);
+  rd->compute_list_end();
+}
+
+// Render thread only. Updates rid_state's B8G8R8A8 texture with bytes, or
+// creates it from them (with the RenderingServer texture over it) for a
+// frame of a new size.
+void submit_live_cpu_bgra_frame(
+    godot::RenderingServer* rs,
+    godot::RenderingDevice* rd,
+    SharedLiveCpuTextureRidState& rid_state,
+    const godot::PackedByteArray& bytes,
+    uint32_t width,
+    uint32_t height) {
+  constexpr int64_t kUsage =
+      godot::RenderingDevice::TEXTURE_USAGE_SAMPLING_BIT |
+      godot::RenderingDevice::TEXTURE_USAGE_CAN_UPDATE_BIT |
+      godot::RenderingDevice::TEXTURE_USAGE_CAN_COPY_FROM_BIT;
+  const LiveCpuDevicePathState upload_state = g_live_cpu_bgra_upload_state.load(std::memory_order_acquire);
+  if (upload_state == LiveCpuDevicePathState::Failed) {
+    return;
+  }
+  if (upload_state == LiveCpuDevicePathState::Unbuilt) {
+    const bool supported = rd->texture_is_format_supported_for_usage(
+        godot::RenderingDevice::DATA_FORMAT_B8G8R8A8_UNORM, kUsage);
+    g_live_cpu_bgra_upload_state.store(
+        supported ? LiveCpuDevicePathState::Ready : LiveCpuDevicePathState::Failed, std::memory_order_release);
+    if (!supported) {
+      std::fprintf(stderr, "[CamBANG][CpuDisplay] B8G8R8A8 textures unsupported; BGRA frames swizzle on the CPU\n");
+      std::fflush(stderr);
+      return;
+    }
+  }
+  godot::RID texture;
+  {
+    std::lock_guard<std::mutex> lock(rid_state.mutex);
+    if (rid_state.invalidated) {
+      return;
+    }
+    const LiveCpuDeviceTexture& device = rid_state.device;
+    if (device.texture.is_valid() && !device.plane_buffer.is_valid() &&
+        device.width == width && device.height == height) {
+      texture = device.texture;
+    }
+  }
+  if (texture.is_valid()) {
+    (void)rd->texture_update(texture, 0, bytes);
+    return;
+  }
+  godot::Ref<godot::RDTextureFormat> format;
+  format.instantiate();
+  format->set_width(static_cast<int64_t>(width));
+  format->set_height(static_cast<int64_t>(height));
+  format->set_format(godot::RenderingDevice::DATA_FORMAT_B8G8R8A8_UNORM);
+  format->set_usage_bits(kUsage);
+  godot::Ref<godot::RDTextureView> view;
+  view.instantiate();
+  godot::TypedArray<godot::PackedByteArray> data;
+  data.push_back(bytes);
+  texture = rd->texture_create(format, view, data);
+  const godot::RID texture_rid = texture.is_valid() ? rs->texture_rd_create(texture) : godot::RID();
+  if (!texture_rid.is_valid()) {
+    if (texture.is_valid()) {
+      rd->free_rid(texture);
+    }
+    return;
+  }
+  LiveCpuDeviceTexture device;
+  device.texture = texture;
+  device.width = width;
+  device.height = height;
+  rid_state.replace_rid(texture_rid, device);
+}
+
 uint64_t g_next_live_cpu_display_wrapper_borrow_id = 1;
 
 void unregister_live_cpu_texture_rid_state(uint64_t registration_id) {
@@ -278,25 +630,22 @@ std::shared_ptr<SharedLiveCpuTextureRidState> make_live_cpu_texture_rid_state()
   return state;
 }
 
-void enqueue_live_cpu_texture_create(
-    std::shared_ptr<SharedLiveCpuTextureRidState> rid_state,
-    godot::Ref<godot::Image> image) {
-  if (!rid_state || image.is_null()) {
-    return;
-  }
+namespace {
+
+void enqueue_pending_live_cpu_texture_create(PendingLiveCpuTextureCreate request) {
   PendingLiveCpuTextureCreate superseded;
   {
     std::lock_guard<std::mutex> lock(g_pending_live_cpu_texture_mutex);
     if (g_live_cpu_display_bridge_phase != LiveCpuDisplayBridgePhase::Active) {
       return;
     }
-    const auto it = g_pending_live_cpu_texture_creates.find(rid_state.get());
+    const SharedLiveCpuTextureRidState* key = request.rid_state.get();
+    const auto it = g_pending_live_cpu_texture_creates.find(key);
     if (it == g_pending_live_cpu_texture_creates.end()) {
-      g_pending_live_cpu_texture_creates.emplace(
-          rid_state.get(), PendingLiveCpuTextureCreate{rid_state, std::move(image)});
+      g_pending_live_cpu_texture_creates.emplace(key, std::move(request));
     } else {
       superseded = std::move(it->second);
-      it->second = PendingLiveCpuTextureCreate{rid_state, std::move(image)};
+      it->second = std::move(request);
     }
   }
   // Ref/shared ownership from the superseded request is released after the
@@ -305,6 +654,69 @@ void enqueue_live_cpu_texture_create(
   request_pending_live_cpu_texture_create_drain();
 }
 
+} // namespace
+
+void enqueue_live_cpu_texture_create(
+    std::shared_ptr<SharedLiveCpuTextureRidState> rid_state,
+    godot::Ref<godot::Image> image) {
+  if (!rid_state || image.is_null()) {
+    return;
+  }
+  PendingLiveCpuTextureCreate request;
+  request.rid_state = std::move(rid_state);
+  request.image = std::move(image);
+  enqueue_pending_live_cpu_texture_create(std::move(request));
+}
+
+bool live_cpu_yuv_display_conversion_available() {
+  if (g_live_cpu_yuv_compute_state.load(std::memory_order_acquire) == LiveCpuDevicePathState::Failed) {
+    return false;
+  }
+  godot::RenderingServer* rs = godot::RenderingServer::get_singleton();
+  return rs && rs->get_rendering_device() != nullptr;
+}
+
+void enqueue_live_cpu_yuv_texture_upload(
+    std::shared_ptr<SharedLiveCpuTextureRidState> rid_state,
+    LiveCpuYuvFrame frame) {
+  if (!rid_state || frame.width == 0 || frame.height == 0 || frame.planes.is_empty()) {
+    return;
+  }
+  // The pass reads the planes a 32-bit word at a time.
+  frame.planes.resize((frame.planes.size() + 3) & ~int64_t{3});
+  PendingLiveCpuTextureCreate request;
+  request.rid_state = std::move(rid_state);
+  request.kind = PendingLiveCpuTextureCreate::Kind::YUV_FRAME;
+  request.yuv_frame = std::move(frame);
+  enqueue_pending_live_cpu_texture_create(std::move(request));
+}
+
+bool live_cpu_bgra_display_upload_available() {
+  if (g_live_cpu_bgra_upload_state.load(std::memory_order_acquire) == LiveCpuDevicePathState::Failed) {
+    return false;
+  }
+  godot::RenderingServer* rs = godot::RenderingServer::get_singleton();
+  return rs && rs->get_rendering_device() != nullptr;
+}
+
+void enqueue_live_cpu_bgra_texture_upload(
+    std::shared_ptr<SharedLiveCpuTextureRidState> rid_state,
+    godot::PackedByteArray bytes,
+    uint32_t width,
+    uint32_t height) {
+  if (!rid_state || width == 0 || height == 0 ||
+      bytes.size() != static_cast<int64_t>(width) * static_cast<int64_t>(height) * 4) {
+    return;
+  }
+  PendingLiveCpuTextureCreate request;
+  request.rid_state = std::move(rid_state);
+  request.kind = PendingLiveCpuTextureCreate::Kind::BGRA_FRAME;
+  request.bgra_bytes = std::move(bytes);
+  request.bgra_width = width;
+  request.bgra_height = height;
+  enqueue_pending_live_cpu_texture_create(std::move(request));
+}
+
 bool LiveCpuTextureCreateDrainHelper::drain_pending_creates_on_render_thread() {
   std::map<const SharedLiveCpuTextureRidState*, PendingLiveCpuTextureCreate> pending;
   {
@@ -337,6 +749,19 @@ bool LiveCpuTextureCreateDrainHelper::drain_pending_creates_on_render_thread() {
   }
   for (auto& [key, entry] : pending) {
     (void)key;
+    if (entry.kind != PendingLiveCpuTextureCreate::Kind::RGBA_IMAGE) {
+      godot::RenderingDevice* rd = rs->get_rendering_device();
+      if (!rd) {
+        continue;
+      }
+      if (entry.kind == PendingLiveCpuTextureCreate::Kind::YUV_FRAME) {
+        submit_live_cpu_yuv_frame(rs, rd, *entry.rid_state, entry.yuv_frame);
+      } else {
+        submit_live_cpu_bgra_frame(
+            rs, rd, *entry.rid_state, entry.bgra_bytes, entry.bgra_width, entry.bgra_height);
+      }
+      continue;
+    }
     const godot::RID texture_rid = rs->texture_2d_create(entry.image);
     if (texture_rid.is_valid()) {
       entry.rid_state->replace_rid(texture_rid);
@@ -355,7 +780,7 @@ bool LiveCpuTextureCreateDrainHelper::drain_pending_creates_on_render_thread() {
 }
 
 bool LiveCpuTextureCreateDrainHelper::drain_pending_releases_on_render_thread() {
-  std::vector<godot::RID> pending;
+  std::vector<PendingLiveCpuTextureRelease> pending;
   {
     std::lock_guard<std::mutex> lock(g_pending_live_cpu_texture_mutex);
     g_pending_live_cpu_texture_release_drain_scheduled = false;
@@ -370,8 +795,8 @@ bool LiveCpuTextureCreateDrainHelper::drain_pending_releases_on_render_thread()
   if (!rs) {
     {
       std::lock_guard<std::mutex> lock(g_pending_live_cpu_texture_mutex);
-      for (godot::RID& rid : pending) {
-        g_pending_live_cpu_texture_releases.push_back(std::move(rid));
+      for (PendingLiveCpuTextureRelease& release : pending) {
+        g_pending_live_cpu_texture_releases.push_back(std::move(release));
       }
       g_pending_live_cpu_texture_release_drain_running = false;
       g_pending_live_cpu_texture_changed.notify_all();
@@ -379,9 +804,15 @@ bool LiveCpuTextureCreateDrainHelper::drain_pending_releases_on_render_thread()
     request_pending_live_cpu_texture_release_drain();
     return true;
   }
-  for (const godot::RID& rid : pending) {
-    if (rid.is_valid()) {
-      rs->free_rid(rid);
+  godot::RenderingDevice* rd = rs->get_rendering_device();
+  for (const PendingLiveCpuTextureRelease& release : pending) {
+    if (release.texture_rid.is_valid()) {
+      rs->free_rid(release.texture_rid);
+    }
+    for (const godot::RID& device_rid : release.device_rids) {
+      if (rd && device_rid.is_valid()) {
+        rd->free_rid(device_rid);
+      }
     }
   }
   {
@@ -397,6 +828,13 @@ bool LiveCpuTextureCreateDrainHelper::drain_pending_releases_on_render_thread()
 }
 
 void install_live_cpu_display_bridge() {
+  {
+    // Installed by an earlier CamBANGServer start; stays until teardown.
+    std::lock_guard<std::mutex> lock(g_pending_live_cpu_texture_mutex);
+    if (g_live_cpu_display_bridge_phase == LiveCpuDisplayBridgePhase::Active) {
+      return;
+    }
+  }
   LiveCpuTextureCreateDrainHelper* helper = memnew(LiveCpuTextureCreateDrainHelper);
   if (!helper) {
     godot::UtilityFunctions::push_error(
@@ -442,6 +880,15 @@ void uninstall_live_cpu_display_bridge() {
     g_pending_live_cpu_texture_changed.wait(
         lock, [] { return g_live_cpu_state_producers == 0; });
     cancelled_creates.swap(g_pending_live_cpu_texture_creates);
+    if (g_live_cpu_yuv_compute_shader.is_valid()) {
+      // Freeing the shader frees the pipeline built from it.
+      g_pending_live_cpu_texture_releases.push_back(
+          PendingLiveCpuTextureRelease{godot::RID(), {g_live_cpu_yuv_compute_shader, godot::RID()}});
+    }
+    g_live_cpu_yuv_compute_shader = godot::RID();
+    g_live_cpu_yuv_compute_pipeline = godot::RID();
+    g_live_cpu_yuv_compute_state.store(LiveCpuDevicePathState::Unbuilt, std::memory_order_release);
+    g_live_cpu_bgra_upload_state.store(LiveCpuDevicePathState::Unbuilt, std::memory_order_release);
     g_pending_live_cpu_texture_changed.notify_all();
   }
   cancelled_creates.clear();
@@ -485,25 +932,44 @@ godot::RID SharedLiveCpuTextureRidState::snapshot_rid() const {
   return texture_rid;
 }
 
-void SharedLiveCpuTextureRidState::replace_rid(const godot::RID& texture_rid_in) {
+void SharedLiveCpuTextureRidState::replace_rid(
+    const godot::RID& texture_rid_in,
+    const LiveCpuDeviceTexture& device_in) {
   LiveCpuReleaseProducerLease release_admission;
   godot::RID prior;
-  godot::RID rejected_incoming;
+  LiveCpuDeviceTexture prior_device;
+  bool rejected = false;
   {
     std::lock_guard<std::mutex> lock(mutex);
     if (invalidated && texture_rid_in.is_valid()) {
-      rejected_incoming = texture_rid_in;
+      rejected = true;
     } else {
       prior = texture_rid;
+      prior_device = device;
       texture_rid = texture_rid_in;
+      device = device_in;
+      device.uniform_set = godot::RID();
     }
   }
-  if (prior.is_valid() && prior != texture_rid_in) {
-    release_live_cpu_texture_rid(prior);
+  if (rejected) {
+    release_live_cpu_texture_rid(texture_rid_in, device_in.texture, device_in.plane_buffer);
+    return;
+  }
+  if (prior == texture_rid_in) {
+    prior = godot::RID();
   }
-  if (rejected_incoming.is_valid()) {
-    release_live_cpu_texture_rid(rejected_incoming);
+  if (prior_device.texture == device_in.texture) {
+    prior_device.texture = godot::RID();
   }
+  if (prior_device.plane_buffer == device_in.plane_buffer) {
+    prior_device.plane_buffer = godot::RID();
+  }
+  release_live_cpu_texture_rid(prior, prior_device.texture, prior_device.plane_buffer);
+}
+
+bool SharedLiveCpuTextureRidState::holds_device_texture() const {
+  std::lock_guard<std::mutex> lock(mutex);
+  return device.texture.is_valid();
 }
 
 void SharedLiveCpuTextureRidState::clear() {
@@ -513,13 +979,16 @@ void SharedLiveCpuTextureRidState::clear() {
 void SharedLiveCpuTextureRidState::invalidate_and_release() {
   LiveCpuReleaseProducerLease release_admission;
   godot::RID prior;
+  LiveCpuDeviceTexture prior_device;
   {
     std::lock_guard<std::mutex> lock(mutex);
     invalidated = true;
     prior = texture_rid;
+    prior_device = device;
     texture_rid = godot::RID();
+    device = LiveCpuDeviceTexture();
   }
-  release_live_cpu_texture_rid(prior);
+  release_live_cpu_texture_rid(prior, prior_device.texture, prior_device.plane_buffer);
 }
 
 bool SharedLiveCpuTextureRidState::draw_allowed() const {
@@ -10,20 +10,44 @@
 #include <godot_cpp/core/class_db.hpp>
 #include <godot_cpp/core/object.hpp>
 #include <godot_cpp/variant/color.hpp>
+#include <godot_cpp/variant/packed_byte_array.hpp>
 #include <godot_cpp/variant/rect2.hpp>
 #include <godot_cpp/variant/rid.hpp>
 #include <godot_cpp/variant/vector2.hpp>
 
 namespace cambang {
 
+// RenderingDevice resources behind a live display RID that the render
+// thread writes itself (see enqueue_live_cpu_yuv_texture_upload() and
+// enqueue_live_cpu_bgra_texture_upload()) rather than through
+// texture_2d_update(). Released with the RID they back.
+struct LiveCpuDeviceTexture final {
+  godot::RID texture;
+  // YUV conversion only: the storage buffer the frame's planes are uploaded
+  // to, and the uniform set binding it and texture (freed with them).
+  godot::RID plane_buffer;
+  godot::RID uniform_set;
+  uint32_t width = 0;
+  uint32_t height = 0;
+  uint32_t plane_buffer_bytes = 0;
+};
+
 struct SharedLiveCpuTextureRidState final {
   mutable std::mutex mutex;
   godot::RID texture_rid;
+  LiveCpuDeviceTexture device;
   bool invalidated = false;
   uint64_t registration_id = 0;
 
   godot::RID snapshot_rid() const;
-  void replace_rid(const godot::RID& texture_rid_in);
+  // device_in gives the RenderingDevice resources behind texture_rid_in, if
+  // any; the prior RID and resources are released.
+  void replace_rid(
+      const godot::RID& texture_rid_in,
+      const LiveCpuDeviceTexture& device_in = LiveCpuDeviceTexture());
+  // True while texture_rid is written by the render thread directly, so the
+  // RGBA path must create a texture of its own rather than update it.
+  bool holds_device_texture() const;
   void clear();
   // Marks this display view invalidated AND enqueues texture_rid for
   // render-thread release, rather than deferring release to whenever this
@@ -159,14 +183,66 @@ void enqueue_live_cpu_texture_create(
     std::shared_ptr<SharedLiveCpuTextureRidState> rid_state,
     godot::Ref<godot::Image> image);
 
+// One planar 4:2:0 frame (NV12, NV21 or I420) for
+// enqueue_live_cpu_yuv_texture_upload(): the retained payload's planes,
+// copied unconverted, and where each lies in planes. The conversion reads
+// chroma for column x at u/v_offset + (x / 2) * uv_pixel_stride on chroma
+// row y / 2, as Yuv420Source (pixels/convert/yuv420_to_rgba.h) does.
+struct LiveCpuYuvFrame final {
+  godot::PackedByteArray planes;
+  uint32_t width = 0;
+  uint32_t height = 0;
+  uint32_t y_offset = 0;
+  uint32_t y_row_stride = 0;
+  uint32_t u_offset = 0;
+  uint32_t v_offset = 0;
+  uint32_t uv_row_stride = 0;
+  uint32_t uv_pixel_stride = 1;
+};
+
+// True while planar frames can be shown through
+// enqueue_live_cpu_yuv_texture_upload(): a RenderingDevice exists (not the
+// Compatibility renderer) and building the conversion pipeline has not
+// failed. Failure is sticky until the bridge is reinstalled.
+bool live_cpu_yuv_display_conversion_available();
+
+// Shows frame through rid_state without converting it on the CPU: the
+// render thread uploads the planes (1.5 bytes per pixel rather than 4) to a
+// storage buffer and a compute pass converts them, with the integer BT.601
+// limited-range math of convert_yuv420_rows_to_packed(), into the
+// RenderingDevice texture behind rid_state's RID. Same-size frames reuse
+// that texture and buffer; a new size replaces both. Latest-wins per
+// rid_state, sharing the queue of enqueue_live_cpu_texture_create() (a later
+// request of either kind supersedes an earlier one).
+void enqueue_live_cpu_yuv_texture_upload(
+    std::shared_ptr<SharedLiveCpuTextureRidState> rid_state,
+    LiveCpuYuvFrame frame);
+
+// True while BGRA frames can be shown through
+// enqueue_live_cpu_bgra_texture_upload(): a RenderingDevice exists and
+// samples B8G8R8A8_UNORM textures. Sticky until the bridge is reinstalled.
+bool live_cpu_bgra_display_upload_available();
+
+// Shows a tightly packed width x height BGRA8 frame through rid_state
+// without swizzling it: the render thread uploads bytes as-is to a
+// RenderingDevice B8G8R8A8_UNORM texture behind rid_state's RID, created on
+// the first frame of a size and updated in place after that. Shares the
+// latest-wins queue of enqueue_live_cpu_texture_create().
+void enqueue_live_cpu_bgra_texture_upload(
+    std::shared_ptr<SharedLiveCpuTextureRidState> rid_state,
+    godot::PackedByteArray bytes,
+    uint32_t width,
+    uint32_t height);
+
 // Constructs and registers every CPU display RID state so extension teardown
 // can invalidate states that have no currently live display wrapper.
 std::shared_ptr<SharedLiveCpuTextureRidState> make_live_cpu_texture_rid_state();
 
-// Lifecycle hooks: call from the same GDExtension init/deinit points as the GPU
-// bridge. Uninstall closes create admission, invalidates all registered states,
-// and waits for every accepted create/release callback before dropping the
-// callback helper.
+// Lifecycle hooks: install from the same CamBANGServer start point as the GPU
+// bridge (a no-op once installed), uninstall from GDExtension deinit. Uninstall
+// closes create admission, invalidates all registered states, and waits for
+// every accepted create/release callback before dropping the callback helper;
+// it is a no-op when no start ever installed the bridge.
 void install_live_cpu_display_bridge();
 void uninstall_live_cpu_display_bridge();
 
@@ -1,10 +1,115 @@
 #include "godot/godot_gpu_display_service.h"
 
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include <godot_cpp/core/object.hpp>
+
 #include "godot/synthetic_gpu_backing_bridge.h"
 #include "imaging/synthetic/gpu_backing_runtime.h"
 
 namespace cambang {
 
+namespace {
+
+// Display views by complete descriptor identity. Entries hold the view's
+// object id, not a Ref: a view carries its stream's display demand, so the
+// cache must not keep one alive. A hit is a view some consumer still holds
+// for an unchanged backing, handed back without asking the backend.
+struct CachedDisplayView {
+  uint64_t stream_id = 0;
+  uint64_t backing_id = 0;
+  uint32_t width = 0;
+  uint32_t height = 0;
+  uint32_t format_fourcc = 0;
+  std::weak_ptr<void> legacy_backing;
+  uint64_t view_id = 0;
+  uint64_t last_use = 0;
+
+  bool matches(const RetainedGpuBackingDescriptor& d) const noexcept {
+    return stream_id == d.stream_id && backing_id == d.backing_id && width == d.width &&
+           height == d.height && format_fourcc == d.format_fourcc;
+  }
+};
+
+// A live stream has one current backing, so this bounds the cache at a few
+// entries per displayed stream.
+constexpr size_t kMaxCachedDisplayViews = 16;
+std::mutex g_display_view_cache_mutex;
+std::vector<CachedDisplayView> g_display_view_cache;
+uint64_t g_display_view_cache_clock = 0;
+
+bool same_backing(const std::weak_ptr<void>& cached, const std::shared_ptr<void>& backing) noexcept {
+  return !cached.owner_before(backing) && !backing.owner_before(cached);
+}
+
+// Null when no live view is cached for descriptor (and, when given, for that
+// legacy backing object).
+godot::Ref<godot::Texture2D> find_cached_display_view(
+    const RetainedGpuBackingDescriptor& descriptor,
+    const std::shared_ptr<void>* legacy_backing) {
+  uint64_t view_id = 0;
+  {
+    std::lock_guard<std::mutex> lock(g_display_view_cache_mutex);
+    for (CachedDisplayView& entry : g_display_view_cache) {
+      if (entry.matches(descriptor) && (!legacy_backing || same_backing(entry.legacy_backing, *legacy_backing))) {
+        entry.last_use = ++g_display_view_cache_clock;
+        view_id = entry.view_id;
+        break;
+      }
+    }
+  }
+  if (view_id == 0) {
+    return {};
+  }
+  // A Ref cannot be taken on a view whose last reference is going away, so a
+  // dying view misses here like an evicted one.
+  godot::Ref<godot::Texture2D> view(
+      godot::Object::cast_to<godot::Texture2D>(godot::ObjectDB::get_instance(view_id)));
+  if (view.is_null() || !synthetic_gpu_backing_display_texture_is_live(view)) {
+    return {};
+  }
+  return view;
+}
+
+void remember_display_view(const RetainedGpuBackingDescriptor& descriptor,
+                           const std::shared_ptr<void>& legacy_backing,
+                           const godot::Ref<godot::Texture2D>& view) {
+  std::lock_guard<std::mutex> lock(g_display_view_cache_mutex);
+  // The stream moved to this backing; its older entries cannot hit again.
+  std::erase_if(g_display_view_cache, [&](const CachedDisplayView& entry) {
+    return entry.stream_id == descriptor.stream_id;
+  });
+  if (g_display_view_cache.size() >= kMaxCachedDisplayViews) {
+    auto oldest = g_display_view_cache.begin();
+    for (auto it = g_display_view_cache.begin(); it != g_display_view_cache.end(); ++it) {
+      if (it->last_use < oldest->last_use) {
+        oldest = it;
+      }
+    }
+    g_display_view_cache.erase(oldest);
+  }
+  CachedDisplayView entry;
+  entry.stream_id = descriptor.stream_id;
+  entry.backing_id = descriptor.backing_id;
+  entry.width = descriptor.width;
+  entry.height = descriptor.height;
+  entry.format_fourcc = descriptor.format_fourcc;
+  entry.legacy_backing = legacy_backing;
+  entry.view_id = static_cast<uint64_t>(view->get_instance_id());
+  entry.last_use = ++g_display_view_cache_clock;
+  g_display_view_cache.push_back(std::move(entry));
+}
+
+template <typename Pred>
+void forget_display_views(Pred&& pred) {
+  std::lock_guard<std::mutex> lock(g_display_view_cache_mutex);
+  std::erase_if(g_display_view_cache, std::forward<Pred>(pred));
+}
+
+} // namespace
+
 bool godot_gpu_display_descriptor_has_complete_identity(
     const RetainedGpuBackingDescriptor& descriptor) noexcept {
   // backing_id == 0 is compatibility metadata only. It means a GPU backing may
@@ -21,23 +126,37 @@ bool godot_gpu_display_descriptor_has_complete_identity(
 
 godot::Ref<godot::Texture2D> godot_gpu_display_lookup_texture_by_descriptor(
     const RetainedGpuBackingDescriptor& descriptor) {
-  (void)godot_gpu_display_descriptor_has_complete_identity(descriptor);
-  // Descriptor-only display resolution is a future activation point. This
-  // service intentionally has no descriptor-keyed cache in the current slice.
-  return {};
+  if (!godot_gpu_display_descriptor_has_complete_identity(descriptor)) {
+    return {};
+  }
+  // Only a view already built for this identity and still held somewhere;
+  // descriptor-only construction remains a future activation point.
+  return find_cached_display_view(descriptor, nullptr);
 }
 
 godot::Ref<godot::Texture2D> godot_gpu_display_get_texture_by_descriptor(
     const RetainedGpuBackingDescriptor& descriptor,
-    const std::shared_ptr<void>& legacy_retained_gpu_backing) {
-  (void)godot_gpu_display_descriptor_has_complete_identity(descriptor);
-  // The completeness helper is for future descriptor-native/provider-backed
-  // lookup and must not block the current synthetic compatibility path. When a
-  // legacy retained backing exists, delegate without storing the returned
-  // Texture2D so display-view ownership and lifetime diagnostics remain visible
-  // in the synthetic bridge. Descriptor-only lookup remains no-op/null for now.
+    const std::shared_ptr<void>& legacy_retained_gpu_backing,
+    bool share_display_view) {
+  // Completeness gates only the cache; an incomplete descriptor still reaches
+  // the synthetic compatibility path, which keeps display-view ownership and
+  // lifetime diagnostics in the bridge.
+  const bool cacheable = share_display_view && legacy_retained_gpu_backing &&
+                         godot_gpu_display_descriptor_has_complete_identity(descriptor);
+  if (cacheable) {
+    if (godot::Ref<godot::Texture2D> cached =
+            find_cached_display_view(descriptor, &legacy_retained_gpu_backing);
+        cached.is_valid()) {
+      return cached;
+    }
+  }
   if (legacy_retained_gpu_backing) {
-    return synthetic_gpu_backing_display_texture(legacy_retained_gpu_backing);
+    godot::Ref<godot::Texture2D> view =
+        synthetic_gpu_backing_display_texture(legacy_retained_gpu_backing, share_display_view);
+    if (cacheable && view.is_valid()) {
+      remember_display_view(descriptor, legacy_retained_gpu_backing, view);
+    }
+    return view;
   }
   return godot_gpu_display_lookup_texture_by_descriptor(descriptor);
 }
@@ -67,19 +186,22 @@ godot::Ref<godot::Image> godot_gpu_display_materialize_to_image(
 }
 
 void godot_gpu_display_invalidate_descriptor(const RetainedGpuBackingDescriptor& descriptor) {
-  (void)godot_gpu_display_descriptor_has_complete_identity(descriptor);
-  // No descriptor-keyed display cache exists in this slice. Future providers
-  // may use this boundary for Godot-layer adapter invalidation only.
+  if (!godot_gpu_display_descriptor_has_complete_identity(descriptor)) {
+    return;
+  }
+  forget_display_views([&](const CachedDisplayView& entry) { return entry.matches(descriptor); });
 }
 
 void godot_gpu_display_invalidate_stream(uint64_t stream_id) {
   if (stream_id == 0) {
     return;
   }
+  forget_display_views([&](const CachedDisplayView& entry) { return entry.stream_id == stream_id; });
   synthetic_gpu_backing_invalidate_live_display_wrappers_for_stream(stream_id);
 }
 
 void godot_gpu_display_invalidate_all() {
+  forget_display_views([](const CachedDisplayView&) { return true; });
   synthetic_gpu_backing_invalidate_all_live_display_wrappers();
 }
 
@@ -11,8 +11,11 @@
 namespace cambang {
 
 // Internal Godot-side display adapter resolver/factory for retained GPU stream
-// views. The service is deliberately non-owning: it does not cache or retain
-// Texture2D refs, Godot RIDs, or backend-native handles. Current synthetic GPU
+// views. The service is deliberately non-owning: it does not retain Texture2D
+// refs, Godot RIDs, or backend-native handles. It remembers the object id of
+// the shared view last built for each complete descriptor identity, so an
+// unchanged backing's view is found by lookup while a consumer still holds
+// it; the invalidate hooks below drop those entries. Current synthetic GPU
 // display resolution still uses the legacy GPU backing artifact as the
 // compatibility behavior carrier; RetainedGpuBackingDescriptor is the
 // provider-neutral scalar metadata seam for future descriptor/platform-backed
@@ -22,17 +25,30 @@ namespace cambang {
 bool godot_gpu_display_descriptor_has_complete_identity(
     const RetainedGpuBackingDescriptor& descriptor) noexcept;
 
+// The cached live view for descriptor's complete identity, or null.
 godot::Ref<godot::Texture2D> godot_gpu_display_lookup_texture_by_descriptor(
     const RetainedGpuBackingDescriptor& descriptor);
 
+// share_display_view: hand every caller of one backing the same display view
+// while it is alive (the backend remembers it by object id, without owning
+// it), so several consumers of a stream borrow one texture wrapper. False
+// always builds a fresh view.
 godot::Ref<godot::Texture2D> godot_gpu_display_get_texture_by_descriptor(
     const RetainedGpuBackingDescriptor& descriptor,
-    const std::shared_ptr<void>& legacy_retained_gpu_backing);
+    const std::shared_ptr<void>& legacy_retained_gpu_backing,
+    bool share_display_view = true);
 
 bool godot_gpu_display_can_materialize_to_image(
     const RetainedGpuBackingDescriptor& descriptor,
     const std::shared_ptr<void>& legacy_retained_gpu_backing);
 
+// Never waits on the GPU. Synthetic backings keep the CPU-side bytes they
+// last uploaded (or staged), so materialization shares those bytes instead
+// of reading the texture back. A backend whose content exists only on the
+// GPU must stage its read-back ahead of demand (e.g. a small ring of
+// RenderingDevice::texture_get_data_async() targets filled as frames are
+// retained) and answer from the completed copy, or report the backing as
+// not materializable; it must not stall the calling frame here.
 godot::Ref<godot::Image> godot_gpu_display_materialize_to_image(
     const RetainedGpuBackingDescriptor& descriptor,
     const std::shared_ptr<void>& legacy_retained_gpu_backing);
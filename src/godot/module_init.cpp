@@ -12,9 +12,12 @@
 #include <godot_cpp/core/object.hpp>
 
 #include "godot/cambang_server.h"
+#include "godot/cambang_performance_monitors.h"
 #include "godot/cambang_device.h"
 #include "godot/cambang_rig.h"
 #include "godot/cambang_stream.h"
+#include "godot/cambang_operation.h"
+#include "godot/cambang_stream_mosaic.h"
 #include "godot/cambang_capture_result.h"
 #include "godot/cambang_stream_result.h"
 #include "godot/cambang_stream_result_internal.h"
@@ -32,13 +35,15 @@ static void cambang_gde_initialize(godot::ModuleInitializationLevel p_level) {
     godot::ClassDB::register_class<cambang::CamBANGDevice>();
     godot::ClassDB::register_class<cambang::CamBANGRig>();
     godot::ClassDB::register_class<cambang::CamBANGStream>();
+    godot::ClassDB::register_class<cambang::CamBANGOperation>();
     godot::ClassDB::register_class<cambang::CamBANGStreamResult>();
     godot::ClassDB::register_class<cambang::CamBANGCaptureResult>();
+    godot::ClassDB::register_class<cambang::CamBANGStreamMosaic>();
     // Scene-level class registration phase (RefCounted/Object classes).
     cambang::register_stream_result_internal_classes();
     cambang::register_synthetic_gpu_backing_internal_classes();
-    cambang::install_synthetic_gpu_backing_godot_bridge();
-    cambang::install_live_cpu_display_bridge();
+    cambang::register_performance_monitor_classes();
+    // Display bridges are installed by CamBANGServer's first start().
 
     // Create and register the Engine singleton.
     // Note: Engine singletons are not part of the scene tree; they do not receive _process.
@@ -46,6 +51,7 @@ static void cambang_gde_initialize(godot::ModuleInitializationLevel p_level) {
     // snapshot draining and tick-bounded signal emission.
     g_server = memnew(cambang::CamBANGServer);
     godot::Engine::get_singleton()->register_singleton("CamBANGServer", g_server);
+    cambang::install_performance_monitors(g_server);
 }
 
 static void cambang_gde_uninitialize(godot::ModuleInitializationLevel p_level) {
@@ -53,6 +59,7 @@ static void cambang_gde_uninitialize(godot::ModuleInitializationLevel p_level) {
         return;
     }
 
+    cambang::uninstall_performance_monitors();
     if (g_server) {
         g_server->stop();
         godot::Engine::get_singleton()->unregister_singleton("CamBANGServer");
@@ -6,6 +6,7 @@
 #include <mutex>
 #include <set>
 #include <string>
+#include <utility>
 
 #include <godot_cpp/variant/string.hpp>
 #include <godot_cpp/variant/variant.hpp>
@@ -14,6 +15,11 @@ namespace cambang::result_access_cost_evidence {
 namespace {
 
 constexpr size_t kMaxSeenFreshIdentities = 4096;
+// Each new successful sample of an identity moves its standing measurement
+// 1/kDecayDivisor of the way, so old evidence decays geometrically and the
+// classification follows thermal and load drift without one outlier
+// flipping it.
+constexpr uint64_t kDecayDivisor = 4;
 
 struct OperationIdentity final {
   std::string route;
@@ -151,6 +157,21 @@ void note_posture_locked(RouteEvidence& evidence, const std::string& route, cons
   }
 }
 
+void store_measurement_locked(const OperationIdentity& identity, RecordedAccessMeasurement measurement) {
+  auto [it, inserted] = g_latest_measurements.try_emplace(identity, measurement);
+  if (inserted) {
+    return;
+  }
+  const RecordedAccessMeasurement& previous = it->second;
+  if (measurement.success && previous.success && previous.elapsed_ns != 0) {
+    const uint64_t sample_ns = measurement.elapsed_ns;
+    measurement.elapsed_ns = sample_ns >= previous.elapsed_ns
+        ? previous.elapsed_ns + (sample_ns - previous.elapsed_ns) / kDecayDivisor
+        : previous.elapsed_ns - (previous.elapsed_ns - sample_ns) / kDecayDivisor;
+  }
+  it->second = std::move(measurement);
+}
+
 void set_dictionary_value(godot::Dictionary& dictionary, const char* key, const godot::Variant& value) {
   dictionary.set(godot::Variant(godot::String(key)), value);
 }
@@ -227,13 +248,13 @@ void record_stream_access(
     evidence.last_bytes = infer_last_bytes(data);
     note_posture_locked(evidence, route_key, data->access_posture);
     OperationIdentity identity{route, data->access_posture.posture_id, data->stream_id, 0, 0, 0};
-    g_latest_measurements[identity] = RecordedAccessMeasurement{
+    store_measurement_locked(identity, RecordedAccessMeasurement{
         route_key,
         data->access_posture.posture_id,
         elapsed_ns,
         evidence.last_bytes,
         success,
-        reported_capability};
+        reported_capability});
   } else {
     evidence.last_width = 0;
     evidence.last_height = 0;
@@ -287,13 +308,13 @@ void record_capture_member_access(
         data ? data->capture_id : 0,
         member->image_member_index,
         0};
-    g_latest_measurements[identity] = RecordedAccessMeasurement{
+    store_measurement_locked(identity, RecordedAccessMeasurement{
         route_key,
         member->access_posture.posture_id,
         elapsed_ns,
         evidence.last_bytes,
         success,
-        reported_capability};
+        reported_capability});
   } else {
     evidence.last_width = 0;
     evidence.last_height = 0;
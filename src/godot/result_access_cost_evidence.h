@@ -18,6 +18,7 @@ constexpr const char* kRouteStreamToImageCpuPacked = "stream_to_image.cpu_packed
 constexpr const char* kRouteStreamToImageGpuPrimaryCpuSidecar = "stream_to_image.gpu_primary_cpu_sidecar";
 constexpr const char* kRouteStreamToImageGpuPrimaryCpuSidecarMaterializer = "stream_to_image.gpu_primary_cpu_sidecar_materializer";
 constexpr const char* kRouteStreamToImageGpuPrimaryNoCpuSidecarMaterializer = "stream_to_image.gpu_primary_no_cpu_sidecar_materializer";
+constexpr const char* kRouteStreamToImageGpuPrimaryReducedCpuSidecar = "stream_to_image.gpu_primary_reduced_cpu_sidecar";
 constexpr const char* kRouteStreamDisplayViewRetainedGpuBacking = "stream_display_view.retained_gpu_backing";
 constexpr const char* kRouteStreamDisplayViewCpuLiveDisplayView = "stream_display_view.cpu_live_display_view";
 constexpr const char* kRouteStreamAccessUnsupported = "stream_access.unsupported";
@@ -70,6 +71,8 @@ void record_capture_member_access(
     ResultCapability reported_capability) noexcept;
 
 godot::Dictionary snapshot();
+// The standing measurement of (route, posture): the latest sample, with its
+// elapsed time decayed toward it from earlier successful samples.
 std::optional<RecordedAccessMeasurement> latest_stream_measurement(
     const char* route,
     uint64_t posture_id);
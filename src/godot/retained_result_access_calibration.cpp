@@ -104,7 +104,7 @@ void report_stream_to_image_observation(
     return;
   }
   std::optional<result_access_cost_evidence::RecordedAccessMeasurement> measurement;
-  if (data->payload_kind == ResultPayloadKind::CPU_PACKED) {
+  if (is_cpu_payload_kind(data->payload_kind)) {
     measurement = result_access_cost_evidence::latest_stream_measurement(
         result_access_cost_evidence::kRouteStreamToImageCpuPacked,
         data->access_posture.posture_id);
@@ -168,7 +168,7 @@ void report_capture_to_image_observation(
     return;
   }
   std::optional<result_access_cost_evidence::RecordedAccessMeasurement> measurement;
-  if (member.payload_kind == ResultPayloadKind::CPU_PACKED) {
+  if (is_cpu_payload_kind(member.payload_kind)) {
     measurement = result_access_cost_evidence::latest_capture_measurement(
         result_access_cost_evidence::kRouteCaptureToImageCpuPacked,
         member.access_posture.posture_id,
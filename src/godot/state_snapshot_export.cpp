@@ -1,6 +1,11 @@
 #include "godot/state_snapshot_export.h"
 
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
 #include <godot_cpp/variant/utility_functions.hpp>
+#include <godot_cpp/variant/variant.hpp>
 
 namespace cambang {
 
@@ -8,7 +13,25 @@ static inline godot::String gs(const std::string& s) {
   return godot::String(s.c_str());
 }
 
-static inline godot::String lifecycle_phase_token(CBLifecyclePhase phase) {
+// Enum tokens are a small fixed set of literals; each distinct literal is
+// converted to a godot::String once per cache and shared (Strings are COW).
+class TokenCache final {
+public:
+  const godot::String& operator()(const char* token) {
+    auto it = strings_.find(token);
+    if (it == strings_.end()) {
+      it = strings_.emplace(token, godot::String(token)).first;
+    }
+    return it->second;
+  }
+
+  void clear() noexcept { strings_.clear(); }
+
+private:
+  std::unordered_map<const char*, godot::String> strings_;
+};
+
+static inline const char* lifecycle_phase_token(CBLifecyclePhase phase) {
   switch (phase) {
     case CBLifecyclePhase::CREATED:
       return "CREATED";
@@ -25,7 +48,7 @@ static inline godot::String lifecycle_phase_token(CBLifecyclePhase phase) {
   }
 }
 
-static inline godot::String rig_mode_token(CBRigMode mode) {
+static inline const char* rig_mode_token(CBRigMode mode) {
   switch (mode) {
     case CBRigMode::OFF:
       return "OFF";
@@ -44,7 +67,7 @@ static inline godot::String rig_mode_token(CBRigMode mode) {
   }
 }
 
-static inline godot::String device_mode_token(CBDeviceMode mode) {
+static inline const char* device_mode_token(CBDeviceMode mode) {
   switch (mode) {
     case CBDeviceMode::IDLE:
       return "IDLE";
@@ -61,7 +84,7 @@ static inline godot::String device_mode_token(CBDeviceMode mode) {
   }
 }
 
-static inline godot::String stream_mode_token(CBStreamMode mode) {
+static inline const char* stream_mode_token(CBStreamMode mode) {
   switch (mode) {
     case CBStreamMode::STOPPED:
       return "STOPPED";
@@ -78,7 +101,7 @@ static inline godot::String stream_mode_token(CBStreamMode mode) {
   }
 }
 
-static inline godot::String stream_intent_token(cambang::StreamIntent intent) {
+static inline const char* stream_intent_token(cambang::StreamIntent intent) {
   switch (intent) {
     case cambang::StreamIntent::PREVIEW:
       return "PREVIEW";
@@ -91,7 +114,7 @@ static inline godot::String stream_intent_token(cambang::StreamIntent intent) {
   }
 }
 
-static inline godot::String stream_stop_reason_token(CBStreamStopReason reason) {
+static inline const char* stream_stop_reason_token(CBStreamStopReason reason) {
   switch (reason) {
     case CBStreamStopReason::NONE:
       return "NONE";
@@ -108,7 +131,7 @@ static inline godot::String stream_stop_reason_token(CBStreamStopReason reason)
   }
 }
 
-static inline godot::String capture_still_image_member_role_name(
+static inline const char* capture_still_image_member_role_name(
     cambang::CaptureStillImageMemberRole role) {
   switch (role) {
     case cambang::CaptureStillImageMemberRole::DEFAULT_METERED:
@@ -120,7 +143,7 @@ static inline godot::String capture_still_image_member_role_name(
   }
 }
 
-static inline godot::String native_object_type_token(uint32_t raw_type) {
+static inline const char* native_object_type_token(uint32_t raw_type) {
   switch (static_cast<NativeObjectType>(raw_type)) {
     case NativeObjectType::Provider:
       return "provider";
@@ -141,7 +164,7 @@ static inline godot::String native_object_type_token(uint32_t raw_type) {
   }
 }
 
-static inline godot::String visibility_last_path_token(CBVisibilityLastPath path) {
+static inline const char* visibility_last_path_token(CBVisibilityLastPath path) {
   switch (path) {
     case CBVisibilityLastPath::NONE:
       return "NONE";
@@ -160,7 +183,7 @@ static inline godot::String visibility_last_path_token(CBVisibilityLastPath path
   }
 }
 
-static inline godot::String telemetry_scope_token(uint32_t scope) {
+static inline const char* telemetry_scope_token(uint32_t scope) {
   switch (scope) {
     case 0: return "STREAM";
     case 1: return "ACQUISITION_SESSION";
@@ -170,13 +193,13 @@ static inline godot::String telemetry_scope_token(uint32_t scope) {
   }
 }
 
-static godot::Dictionary export_scoped_resource_telemetry(const ScopedResourceTelemetry& t) {
+static godot::Dictionary export_scoped_resource_telemetry(TokenCache& tok, const ScopedResourceTelemetry& t) {
   godot::Dictionary d;
-  d["phase"] = lifecycle_phase_token(t.phase);
+  d["phase"] = tok(lifecycle_phase_token(t.phase));
   d["creation_gen"] = static_cast<uint64_t>(t.creation_gen);
   d["created_ns"] = static_cast<uint64_t>(t.created_ns);
   d["destroyed_ns"] = static_cast<uint64_t>(t.destroyed_ns);
-  d["telemetry_scope"] = telemetry_scope_token(t.telemetry_scope);
+  d["telemetry_scope"] = tok(telemetry_scope_token(t.telemetry_scope));
   d["provider_native_id"] = static_cast<uint64_t>(t.provider_native_id);
   d["device_instance_id"] = static_cast<uint64_t>(t.device_instance_id);
   d["acquisition_session_id"] = static_cast<uint64_t>(t.acquisition_session_id);
@@ -189,104 +212,143 @@ static godot::Dictionary export_scoped_resource_telemetry(const ScopedResourceTe
   d["retained_gpu_backing_total_created"] = static_cast<uint64_t>(t.retained_gpu_backing_total_created);
   d["retained_gpu_backing_total_released"] = static_cast<uint64_t>(t.retained_gpu_backing_total_released);
   d["retained_gpu_backing_peak_current"] = static_cast<uint64_t>(t.retained_gpu_backing_peak_current);
+  d["retained_cpu_payload_bytes_current"] = static_cast<uint64_t>(t.retained_cpu_payload_bytes_current);
+  d["retained_gpu_backing_bytes_current"] = static_cast<uint64_t>(t.retained_gpu_backing_bytes_current);
+  d["display_view_bytes_current"] = static_cast<uint64_t>(t.display_view_bytes_current);
+  d["pooled_buffer_bytes_current"] = static_cast<uint64_t>(t.pooled_buffer_bytes_current);
+  d["large_page_buffer_bytes_current"] = static_cast<uint64_t>(t.large_page_buffer_bytes_current);
+  d["large_page_fallback_bytes_current"] = static_cast<uint64_t>(t.large_page_fallback_bytes_current);
   return d;
 }
 
+static godot::Dictionary export_latency_histogram(const LatencyHistogramState& h) {
+  godot::Dictionary d;
+  d["count"] = static_cast<uint64_t>(h.count);
+  d["min_ns"] = static_cast<uint64_t>(h.min_ns);
+  d["max_ns"] = static_cast<uint64_t>(h.max_ns);
+  d["mean_ns"] = static_cast<uint64_t>(h.mean_ns);
+  d["p50_ns"] = static_cast<uint64_t>(h.p50_ns);
+  d["p90_ns"] = static_cast<uint64_t>(h.p90_ns);
+  d["p99_ns"] = static_cast<uint64_t>(h.p99_ns);
+  d["p999_ns"] = static_cast<uint64_t>(h.p999_ns);
+  return d;
+}
 
-static godot::String camera_value_support_token(CBCameraValueSupport s) {
+static godot::Dictionary export_capture_latency(const CaptureLatencyState& c) {
+  godot::Dictionary d;
+  d["admission"] = export_latency_histogram(c.admission);
+  d["provider_start"] = export_latency_histogram(c.provider_start);
+  d["image_arrival"] = export_latency_histogram(c.image_arrival);
+  d["finalization"] = export_latency_histogram(c.finalization);
+  d["capture"] = export_latency_histogram(c.capture);
+  return d;
+}
+
+static godot::Dictionary export_frame_pacing(const FramePacingState& p) {
+  godot::Dictionary d;
+  d["intervals"] = static_cast<uint64_t>(p.intervals);
+  d["mean_fps_milli"] = static_cast<uint32_t>(p.mean_fps_milli);
+  d["interval_p50_ns"] = static_cast<uint64_t>(p.interval_p50_ns);
+  d["interval_p99_ns"] = static_cast<uint64_t>(p.interval_p99_ns);
+  d["jitter_ns"] = static_cast<uint64_t>(p.jitter_ns);
+  d["gaps"] = static_cast<uint64_t>(p.gaps);
+  return d;
+}
+
+static const char* camera_value_support_token(CBCameraValueSupport s) {
   switch (s) {
-    case CBCameraValueSupport::SUPPORTED: return gs("SUPPORTED");
-    case CBCameraValueSupport::UNSUPPORTED: return gs("UNSUPPORTED");
-    case CBCameraValueSupport::UNIMPLEMENTED: return gs("UNIMPLEMENTED");
-    default: return gs("UNKNOWN");
+    case CBCameraValueSupport::SUPPORTED: return "SUPPORTED";
+    case CBCameraValueSupport::UNSUPPORTED: return "UNSUPPORTED";
+    case CBCameraValueSupport::UNIMPLEMENTED: return "UNIMPLEMENTED";
+    default: return "UNKNOWN";
   }
 }
 
-static godot::String camera_apply_status_token(CBCameraApplyStatus s) {
+static const char* camera_apply_status_token(CBCameraApplyStatus s) {
   switch (s) {
-    case CBCameraApplyStatus::APPLIED: return gs("APPLIED");
-    case CBCameraApplyStatus::PENDING: return gs("PENDING");
-    case CBCameraApplyStatus::REJECTED: return gs("REJECTED");
-    case CBCameraApplyStatus::CONSTRAINED: return gs("CONSTRAINED");
-    default: return gs("UNKNOWN");
+    case CBCameraApplyStatus::APPLIED: return "APPLIED";
+    case CBCameraApplyStatus::PENDING: return "PENDING";
+    case CBCameraApplyStatus::REJECTED: return "REJECTED";
+    case CBCameraApplyStatus::CONSTRAINED: return "CONSTRAINED";
+    default: return "UNKNOWN";
   }
 }
 
-static godot::Dictionary export_camera_value_state_string(const CameraValueStateString& v) {
+static godot::Dictionary export_camera_value_state_string(TokenCache& tok, const CameraValueStateString& v) {
   godot::Dictionary d;
-  d["support"] = camera_value_support_token(v.support);
+  d["support"] = tok(camera_value_support_token(v.support));
   d["has_target"] = v.has_target;
   d["target"] = gs(v.target);
   d["has_applied"] = v.has_applied;
   d["applied"] = gs(v.applied);
-  d["apply_status"] = camera_apply_status_token(v.apply_status);
+  d["apply_status"] = tok(camera_apply_status_token(v.apply_status));
   d["apply_error_code"] = static_cast<int>(v.apply_error_code);
   return d;
 }
 
-static godot::Dictionary export_camera_value_state_int32(const CameraValueStateInt32& v) {
+static godot::Dictionary export_camera_value_state_int32(TokenCache& tok, const CameraValueStateInt32& v) {
   godot::Dictionary d;
-  d["support"] = camera_value_support_token(v.support);
+  d["support"] = tok(camera_value_support_token(v.support));
   d["has_target"] = v.has_target;
   d["target"] = static_cast<int>(v.target);
   d["has_applied"] = v.has_applied;
   d["applied"] = static_cast<int>(v.applied);
-  d["apply_status"] = camera_apply_status_token(v.apply_status);
+  d["apply_status"] = tok(camera_apply_status_token(v.apply_status));
   d["apply_error_code"] = static_cast<int>(v.apply_error_code);
   return d;
 }
 
-static godot::Dictionary export_device_camera_state(const DeviceCameraState& c) {
+static godot::Dictionary export_device_camera_state(TokenCache& tok, const DeviceCameraState& c) {
   godot::Dictionary d;
   d["version"] = static_cast<uint64_t>(c.version);
   godot::Dictionary exposure;
-  exposure["ae_mode"] = export_camera_value_state_string(c.exposure.ae_mode);
-  exposure["baseline_exposure_compensation_milli_ev"] = export_camera_value_state_int32(c.exposure.baseline_exposure_compensation_milli_ev);
+  exposure["ae_mode"] = export_camera_value_state_string(tok, c.exposure.ae_mode);
+  exposure["baseline_exposure_compensation_milli_ev"] = export_camera_value_state_int32(tok, c.exposure.baseline_exposure_compensation_milli_ev);
   d["exposure"] = exposure;
   godot::Dictionary focus;
-  focus["af_mode"] = export_camera_value_state_string(c.focus.af_mode);
-  focus["focus_distance_diopters_milli"] = export_camera_value_state_int32(c.focus.focus_distance_diopters_milli);
+  focus["af_mode"] = export_camera_value_state_string(tok, c.focus.af_mode);
+  focus["focus_distance_diopters_milli"] = export_camera_value_state_int32(tok, c.focus.focus_distance_diopters_milli);
   d["focus"] = focus;
   godot::Dictionary white_balance;
-  white_balance["awb_mode"] = export_camera_value_state_string(c.white_balance.awb_mode);
-  white_balance["color_temperature_kelvin"] = export_camera_value_state_int32(c.white_balance.color_temperature_kelvin);
+  white_balance["awb_mode"] = export_camera_value_state_string(tok, c.white_balance.awb_mode);
+  white_balance["color_temperature_kelvin"] = export_camera_value_state_int32(tok, c.white_balance.color_temperature_kelvin);
   d["white_balance"] = white_balance;
   godot::Dictionary stabilization;
-  stabilization["mode"] = export_camera_value_state_string(c.stabilization.mode);
-  stabilization["strength_percent"] = export_camera_value_state_int32(c.stabilization.strength_percent);
+  stabilization["mode"] = export_camera_value_state_string(tok, c.stabilization.mode);
+  stabilization["strength_percent"] = export_camera_value_state_int32(tok, c.stabilization.strength_percent);
   d["stabilization"] = stabilization;
   godot::Dictionary flash_torch;
-  flash_torch["flash_mode"] = export_camera_value_state_string(c.flash_torch.flash_mode);
-  flash_torch["torch_level"] = export_camera_value_state_int32(c.flash_torch.torch_level);
+  flash_torch["flash_mode"] = export_camera_value_state_string(tok, c.flash_torch.flash_mode);
+  flash_torch["torch_level"] = export_camera_value_state_int32(tok, c.flash_torch.torch_level);
   d["flash_torch"] = flash_torch;
   godot::Dictionary zoom_crop;
-  zoom_crop["zoom_ratio_milli"] = export_camera_value_state_int32(c.zoom_crop.zoom_ratio_milli);
-  zoom_crop["crop_preset"] = export_camera_value_state_string(c.zoom_crop.crop_preset);
+  zoom_crop["zoom_ratio_milli"] = export_camera_value_state_int32(tok, c.zoom_crop.zoom_ratio_milli);
+  zoom_crop["crop_preset"] = export_camera_value_state_string(tok, c.zoom_crop.crop_preset);
   d["zoom_crop"] = zoom_crop;
   godot::Dictionary processing;
-  processing["noise_reduction_mode"] = export_camera_value_state_string(c.processing.noise_reduction_mode);
-  processing["edge_enhancement_level"] = export_camera_value_state_int32(c.processing.edge_enhancement_level);
+  processing["noise_reduction_mode"] = export_camera_value_state_string(tok, c.processing.noise_reduction_mode);
+  processing["edge_enhancement_level"] = export_camera_value_state_int32(tok, c.processing.edge_enhancement_level);
   d["processing"] = processing;
   godot::Dictionary metering;
-  metering["metering_mode"] = export_camera_value_state_string(c.metering.metering_mode);
-  metering["metering_region_preset"] = export_camera_value_state_string(c.metering.metering_region_preset);
+  metering["metering_mode"] = export_camera_value_state_string(tok, c.metering.metering_mode);
+  metering["metering_region_preset"] = export_camera_value_state_string(tok, c.metering.metering_region_preset);
   d["metering"] = metering;
   godot::Dictionary antibanding;
-  antibanding["mode"] = export_camera_value_state_string(c.antibanding.mode);
-  antibanding["mains_frequency_hz"] = export_camera_value_state_int32(c.antibanding.mains_frequency_hz);
+  antibanding["mode"] = export_camera_value_state_string(tok, c.antibanding.mode);
+  antibanding["mains_frequency_hz"] = export_camera_value_state_int32(tok, c.antibanding.mains_frequency_hz);
   d["antibanding"] = antibanding;
   godot::Dictionary orientation_mirroring;
-  orientation_mirroring["rotation_degrees"] = export_camera_value_state_int32(c.orientation_mirroring.rotation_degrees);
-  orientation_mirroring["mirror_mode"] = export_camera_value_state_string(c.orientation_mirroring.mirror_mode);
+  orientation_mirroring["rotation_degrees"] = export_camera_value_state_int32(tok, c.orientation_mirroring.rotation_degrees);
+  orientation_mirroring["mirror_mode"] = export_camera_value_state_string(tok, c.orientation_mirroring.mirror_mode);
   d["orientation_mirroring"] = orientation_mirroring;
   godot::Dictionary privacy_hardware_block;
-  privacy_hardware_block["privacy_mode"] = export_camera_value_state_string(c.privacy_hardware_block.privacy_mode);
-  privacy_hardware_block["hardware_block_reason"] = export_camera_value_state_string(c.privacy_hardware_block.hardware_block_reason);
+  privacy_hardware_block["privacy_mode"] = export_camera_value_state_string(tok, c.privacy_hardware_block.privacy_mode);
+  privacy_hardware_block["hardware_block_reason"] = export_camera_value_state_string(tok, c.privacy_hardware_block.hardware_block_reason);
   d["privacy_hardware_block"] = privacy_hardware_block;
   return d;
 }
 
-static godot::Dictionary export_capture_profile(const CaptureProfileState& c) {
+static godot::Dictionary export_capture_profile(TokenCache& tok, const CaptureProfileState& c) {
   godot::Dictionary profile;
   godot::Dictionary still;
   still["version"] = static_cast<uint64_t>(c.still.version);
@@ -299,7 +361,7 @@ static godot::Dictionary export_capture_profile(const CaptureProfileState& c) {
     godot::Dictionary md;
     md["image_member_index"] = static_cast<int64_t>(m.image_member_index);
     md["role"] = static_cast<int64_t>(m.role);
-    md["role_name"] = capture_still_image_member_role_name(m.role);
+    md["role_name"] = tok(capture_still_image_member_role_name(m.role));
     md["intended_exposure_compensation_milli_ev"] = static_cast<int64_t>(m.intended_exposure_compensation_milli_ev);
     members.push_back(md);
   }
@@ -309,12 +371,12 @@ static godot::Dictionary export_capture_profile(const CaptureProfileState& c) {
   return profile;
 }
 
-static godot::Dictionary export_rig(const RigState& r) {
+static godot::Dictionary export_rig(TokenCache& tok, const RigState& r) {
   godot::Dictionary d;
   d["rig_id"] = static_cast<uint64_t>(r.rig_id);
   d["name"] = gs(r.name);
-  d["phase"] = lifecycle_phase_token(r.phase);
-  d["mode"] = rig_mode_token(r.mode);
+  d["phase"] = tok(lifecycle_phase_token(r.phase));
+  d["mode"] = tok(rig_mode_token(r.mode));
 
   godot::Array members;
   members.resize(static_cast<int>(r.member_hardware_ids.size()));
@@ -336,38 +398,41 @@ static godot::Dictionary export_rig(const RigState& r) {
   d["last_capture_id"] = static_cast<uint64_t>(r.last_capture_id);
   d["last_capture_latency_ns"] = static_cast<uint64_t>(r.last_capture_latency_ns);
   d["last_sync_skew_ns"] = static_cast<uint64_t>(r.last_sync_skew_ns);
+  d["capture_latency"] = export_capture_latency(r.capture_latency);
+  d["sync_skew"] = export_latency_histogram(r.sync_skew);
 
   d["error_code"] = static_cast<int>(r.error_code);
   return d;
 }
 
-static godot::Dictionary export_device(const DeviceState& s) {
+static godot::Dictionary export_device(TokenCache& tok, const DeviceState& s) {
   godot::Dictionary d;
   d["hardware_id"] = gs(s.hardware_id);
   d["instance_id"] = static_cast<uint64_t>(s.instance_id);
-  d["phase"] = lifecycle_phase_token(s.phase);
-  d["mode"] = device_mode_token(s.mode);
+  d["phase"] = tok(lifecycle_phase_token(s.phase));
+  d["mode"] = tok(device_mode_token(s.mode));
   d["engaged"] = static_cast<bool>(s.engaged);
   d["rig_id"] = static_cast<uint64_t>(s.rig_id);
   d["camera_spec_version"] = static_cast<uint64_t>(s.camera_spec_version);
-  d["capture_profile"] = export_capture_profile(s.capture_profile);
-  d["camera_state"] = export_device_camera_state(s.camera_state);
+  d["capture_profile"] = export_capture_profile(tok, s.capture_profile);
+  d["camera_state"] = export_device_camera_state(tok, s.camera_state);
   d["warm_hold_ms"] = static_cast<uint32_t>(s.warm_hold_ms);
   d["warm_remaining_ms"] = static_cast<uint32_t>(s.warm_remaining_ms);
   d["rebuild_count"] = static_cast<uint64_t>(s.rebuild_count);
   d["errors_count"] = static_cast<uint64_t>(s.errors_count);
   d["last_error_code"] = static_cast<int>(s.last_error_code);
+  d["capture_latency"] = export_capture_latency(s.capture_latency);
   return d;
 }
 
-static godot::Dictionary export_stream(const StreamState& s) {
+static godot::Dictionary export_stream(TokenCache& tok, const StreamState& s) {
   godot::Dictionary d;
   d["stream_id"] = static_cast<uint64_t>(s.stream_id);
   d["device_instance_id"] = static_cast<uint64_t>(s.device_instance_id);
-  d["phase"] = lifecycle_phase_token(s.phase);
-  d["intent"] = stream_intent_token(s.intent);
-  d["mode"] = stream_mode_token(s.mode);
-  d["stop_reason"] = stream_stop_reason_token(s.stop_reason);
+  d["phase"] = tok(lifecycle_phase_token(s.phase));
+  d["intent"] = tok(stream_intent_token(s.intent));
+  d["mode"] = tok(stream_mode_token(s.mode));
+  d["stop_reason"] = tok(stream_stop_reason_token(s.stop_reason));
   d["profile_version"] = static_cast<uint64_t>(s.profile_version);
   d["width"] = static_cast<uint32_t>(s.width);
   d["height"] = static_cast<uint32_t>(s.height);
@@ -384,17 +449,21 @@ static godot::Dictionary export_stream(const StreamState& s) {
       static_cast<uint64_t>(s.visibility_frames_rejected_unsupported);
   d["visibility_frames_rejected_invalid"] =
       static_cast<uint64_t>(s.visibility_frames_rejected_invalid);
-  d["visibility_last_path"] = visibility_last_path_token(s.visibility_last_path);
+  d["visibility_last_path"] = tok(visibility_last_path_token(s.visibility_last_path));
+  d["qos_level"] = static_cast<uint32_t>(s.qos_level);
+  d["arrival_pacing"] = export_frame_pacing(s.arrival_pacing);
+  d["delivery_pacing"] = export_frame_pacing(s.delivery_pacing);
+  d["delivery_latency"] = export_latency_histogram(s.delivery_latency);
   return d;
 }
 
-static godot::Dictionary export_acquisition_session(const AcquisitionSessionState& s) {
+static godot::Dictionary export_acquisition_session(TokenCache& tok, const AcquisitionSessionState& s) {
   godot::Dictionary d;
   d["acquisition_session_id"] = static_cast<uint64_t>(s.acquisition_session_id);
   d["device_instance_id"] = static_cast<uint64_t>(s.device_instance_id);
-  d["phase"] = lifecycle_phase_token(s.phase);
-  d["capture_profile"] = export_capture_profile(s.capture_profile);
-  d["camera_state"] = export_device_camera_state(s.camera_state);
+  d["phase"] = tok(lifecycle_phase_token(s.phase));
+  d["capture_profile"] = export_capture_profile(tok, s.capture_profile);
+  d["camera_state"] = export_device_camera_state(tok, s.camera_state);
   d["captures_triggered"] = static_cast<uint64_t>(s.captures_triggered);
   d["captures_completed"] = static_cast<uint64_t>(s.captures_completed);
   d["captures_failed"] = static_cast<uint64_t>(s.captures_failed);
@@ -404,11 +473,11 @@ static godot::Dictionary export_acquisition_session(const AcquisitionSessionStat
   return d;
 }
 
-static godot::Dictionary export_native_object(const NativeObjectRecord& r) {
+static godot::Dictionary export_native_object(TokenCache& tok, const NativeObjectRecord& r) {
   godot::Dictionary d;
   d["native_id"] = static_cast<uint64_t>(r.native_id);
-  d["type"] = native_object_type_token(r.type);
-  d["phase"] = lifecycle_phase_token(r.phase);
+  d["type"] = tok(native_object_type_token(r.type));
+  d["phase"] = tok(lifecycle_phase_token(r.phase));
   d["owner_device_instance_id"] = static_cast<uint64_t>(r.owner_device_instance_id);
   d["owner_acquisition_session_id"] = static_cast<uint64_t>(r.owner_acquisition_session_id);
   d["owner_stream_id"] = static_cast<uint64_t>(r.owner_stream_id);
@@ -423,10 +492,121 @@ static godot::Dictionary export_native_object(const NativeObjectRecord& r) {
   return d;
 }
 
-godot::Dictionary export_snapshot_to_godot(const CamBANGStateSnapshot& snap,
-                                          uint64_t gen,
-                                          uint64_t version,
-                                          uint64_t topology_version) {
+// Read-only down the whole record graph: cached record Dictionaries are
+// shared by every snapshot export that reuses them, so a GDScript write into
+// one must not leak into another published snapshot.
+static void seal_variant_graph(godot::Dictionary& d);
+
+static void seal_variant_graph(godot::Array& a) {
+  for (int64_t i = 0; i < a.size(); ++i) {
+    const godot::Variant v = a[i];
+    if (v.get_type() == godot::Variant::DICTIONARY) {
+      godot::Dictionary nested = v;
+      seal_variant_graph(nested);
+    } else if (v.get_type() == godot::Variant::ARRAY) {
+      godot::Array nested = v;
+      seal_variant_graph(nested);
+    }
+  }
+  a.make_read_only();
+}
+
+static void seal_variant_graph(godot::Dictionary& d) {
+  godot::Array values = d.values();
+  seal_variant_graph(values);
+  d.make_read_only();
+}
+
+template <typename T>
+struct RecordCacheEntry {
+  T record;
+  godot::Dictionary exported;
+};
+
+template <typename T>
+using RecordCache = std::unordered_map<uint64_t, RecordCacheEntry<T>>;
+
+template <typename T>
+struct UnkeyedSectionCache {
+  bool valid = false;
+  std::vector<T> records;
+  godot::Array exported;
+};
+
+struct StateSnapshotExportCache::State {
+  TokenCache tokens;
+  RecordCache<RigState> rigs;
+  RecordCache<DeviceState> devices;
+  RecordCache<AcquisitionSessionState> acquisition_sessions;
+  RecordCache<StreamState> streams;
+  RecordCache<NativeObjectRecord> native_objects;
+  UnkeyedSectionCache<uint64_t> detached_root_ids;
+  UnkeyedSectionCache<ScopedResourceTelemetry> scoped_resource_telemetry;
+};
+
+// Exports one keyed section, reusing the cached Dictionary of every record
+// that compares equal to the one it was exported from. Records that left the
+// snapshot drop out of the cache.
+template <typename T, typename ExportFn>
+static godot::Array export_keyed_section(const std::vector<T>& records,
+                                         uint64_t T::*key,
+                                         RecordCache<T>* cache,
+                                         TokenCache& tok,
+                                         ExportFn export_fn) {
+  godot::Array out;
+  out.resize(static_cast<int>(records.size()));
+  if (!cache) {
+    for (size_t i = 0; i < records.size(); ++i) {
+      out[static_cast<int>(i)] = export_fn(tok, records[i]);
+    }
+    return out;
+  }
+
+  RecordCache<T> next;
+  next.reserve(records.size());
+  for (size_t i = 0; i < records.size(); ++i) {
+    const T& rec = records[i];
+    const uint64_t id = rec.*key;
+    auto prev = cache->find(id);
+    if (prev != cache->end() && prev->second.record == rec) {
+      out[static_cast<int>(i)] = prev->second.exported;
+      next.emplace(id, std::move(prev->second));
+      cache->erase(prev);
+      continue;
+    }
+    godot::Dictionary d = export_fn(tok, rec);
+    seal_variant_graph(d);
+    out[static_cast<int>(i)] = d;
+    // Duplicate ids are not expected; the first record keeps the slot.
+    next.emplace(id, RecordCacheEntry<T>{rec, d});
+  }
+  *cache = std::move(next);
+  return out;
+}
+
+template <typename T, typename BuildFn>
+static godot::Array export_unkeyed_section(const std::vector<T>& records,
+                                           UnkeyedSectionCache<T>* cache,
+                                           BuildFn build_fn) {
+  if (cache && cache->valid && cache->records == records) {
+    return cache->exported;
+  }
+  godot::Array out = build_fn();
+  if (cache) {
+    seal_variant_graph(out);
+    cache->valid = true;
+    cache->records = records;
+    cache->exported = out;
+  }
+  return out;
+}
+
+static godot::Dictionary export_snapshot_impl(const CamBANGStateSnapshot& snap,
+                                              uint64_t gen,
+                                              uint64_t version,
+                                              uint64_t topology_version,
+                                              TokenCache& tok,
+                                              StateSnapshotExportCache::State* cache) {
   godot::Dictionary out;
 
   // Header.
@@ -438,68 +618,89 @@ godot::Dictionary export_snapshot_to_godot(const CamBANGStateSnapshot& snap,
   out["imaging_spec_version"] = static_cast<uint64_t>(snap.imaging_spec_version);
 
   // Records.
-  {
-    godot::Array rigs;
-    rigs.resize(static_cast<int>(snap.rigs.size()));
-    for (size_t i = 0; i < snap.rigs.size(); ++i) {
-      rigs[static_cast<int>(i)] = export_rig(snap.rigs[i]);
-    }
-    out["rigs"] = rigs;
-  }
-  {
-    godot::Array devices;
-    devices.resize(static_cast<int>(snap.devices.size()));
-    for (size_t i = 0; i < snap.devices.size(); ++i) {
-      devices[static_cast<int>(i)] = export_device(snap.devices[i]);
-    }
-    out["devices"] = devices;
-  }
-  {
-    godot::Array acquisition_sessions;
-    acquisition_sessions.resize(static_cast<int>(snap.acquisition_sessions.size()));
-    for (size_t i = 0; i < snap.acquisition_sessions.size(); ++i) {
-      acquisition_sessions[static_cast<int>(i)] = export_acquisition_session(snap.acquisition_sessions[i]);
-    }
-    out["acquisition_sessions"] = acquisition_sessions;
-  }
-  {
-    godot::Array streams;
-    streams.resize(static_cast<int>(snap.streams.size()));
-    for (size_t i = 0; i < snap.streams.size(); ++i) {
-      streams[static_cast<int>(i)] = export_stream(snap.streams[i]);
-    }
-    out["streams"] = streams;
-  }
-  {
-    godot::Array native_objects;
-    native_objects.resize(static_cast<int>(snap.native_objects.size()));
-    for (size_t i = 0; i < snap.native_objects.size(); ++i) {
-      native_objects[static_cast<int>(i)] = export_native_object(snap.native_objects[i]);
-    }
-    out["native_objects"] = native_objects;
-  }
-  {
-    godot::Array detached;
-    detached.resize(static_cast<int>(snap.detached_root_ids.size()));
-    for (size_t i = 0; i < snap.detached_root_ids.size(); ++i) {
-      detached[static_cast<int>(i)] = static_cast<uint64_t>(snap.detached_root_ids[i]);
-    }
-    out["detached_root_ids"] = detached;
-  }
+  out["rigs"] = export_keyed_section(
+      snap.rigs, &RigState::rig_id, cache ? &cache->rigs : nullptr, tok, export_rig);
+  out["devices"] = export_keyed_section(
+      snap.devices, &DeviceState::instance_id, cache ? &cache->devices : nullptr, tok, export_device);
+  out["acquisition_sessions"] = export_keyed_section(snap.acquisition_sessions,
+                                                     &AcquisitionSessionState::acquisition_session_id,
+                                                     cache ? &cache->acquisition_sessions : nullptr,
+                                                     tok,
+                                                     export_acquisition_session);
+  out["streams"] = export_keyed_section(
+      snap.streams, &StreamState::stream_id, cache ? &cache->streams : nullptr, tok, export_stream);
+  out["native_objects"] = export_keyed_section(snap.native_objects,
+                                               &NativeObjectRecord::native_id,
+                                               cache ? &cache->native_objects : nullptr,
+                                               tok,
+                                               export_native_object);
+
+  out["detached_root_ids"] = export_unkeyed_section(
+      snap.detached_root_ids, cache ? &cache->detached_root_ids : nullptr, [&snap]() {
+        godot::Array detached;
+        detached.resize(static_cast<int>(snap.detached_root_ids.size()));
+        for (size_t i = 0; i < snap.detached_root_ids.size(); ++i) {
+          detached[static_cast<int>(i)] = static_cast<uint64_t>(snap.detached_root_ids[i]);
+        }
+        return detached;
+      });
+  out["scoped_resource_telemetry"] = export_unkeyed_section(
+      snap.scoped_resource_telemetry, cache ? &cache->scoped_resource_telemetry : nullptr, [&snap, &tok]() {
+        godot::Array scoped;
+        scoped.resize(static_cast<int>(snap.scoped_resource_telemetry.size()));
+        for (size_t i = 0; i < snap.scoped_resource_telemetry.size(); ++i) {
+          scoped[static_cast<int>(i)] = export_scoped_resource_telemetry(tok, snap.scoped_resource_telemetry[i]);
+        }
+        return scoped;
+      });
+
+  return out;
+}
 
+godot::Dictionary export_snapshot_to_godot(const CamBANGStateSnapshot& snap,
+                                          uint64_t gen,
+                                          uint64_t version,
+                                          uint64_t topology_version) {
+  TokenCache tok;
+  return export_snapshot_impl(snap, gen, version, topology_version, tok, nullptr);
+}
 
-    {
-    godot::Array scoped;
-    scoped.resize(static_cast<int>(snap.scoped_resource_telemetry.size()));
-    for (size_t i = 0; i < snap.scoped_resource_telemetry.size(); ++i) {
-      scoped[static_cast<int>(i)] = export_scoped_resource_telemetry(snap.scoped_resource_telemetry[i]);
-    }
-    out["scoped_resource_telemetry"] = scoped;
-  }
+godot::Dictionary export_state_summary_to_godot(const CamBANGStateSummary& summary,
+                                               uint64_t gen,
+                                               uint64_t version,
+                                               uint64_t topology_version) {
+  godot::Dictionary out;
+  out["gen"] = static_cast<uint64_t>(gen);
+  out["version"] = static_cast<uint64_t>(version);
+  out["topology_version"] = static_cast<uint64_t>(topology_version);
+  out["timestamp_ns"] = static_cast<uint64_t>(summary.timestamp_ns);
+
+  out["rigs"] = static_cast<uint64_t>(summary.rigs);
+  out["devices"] = static_cast<uint64_t>(summary.devices);
+  out["acquisition_sessions"] = static_cast<uint64_t>(summary.acquisition_sessions);
+  out["streams"] = static_cast<uint64_t>(summary.streams);
+  out["detached_roots"] = static_cast<uint64_t>(summary.detached_roots);
+
+  out["native_all"] = static_cast<uint64_t>(summary.native_all);
+  out["native_cur"] = static_cast<uint64_t>(summary.native_cur);
+  out["native_prev"] = static_cast<uint64_t>(summary.native_prev);
+  out["native_dead"] = static_cast<uint64_t>(summary.native_dead);
+  return out;
+}
 
+StateSnapshotExportCache::StateSnapshotExportCache() : state_(std::make_unique<State>()) {}
 
+StateSnapshotExportCache::~StateSnapshotExportCache() = default;
 
-  return out;
+void StateSnapshotExportCache::clear() {
+  state_ = std::make_unique<State>();
+}
+
+godot::Dictionary StateSnapshotExportCache::export_snapshot(const CamBANGStateSnapshot& snap,
+                                                           uint64_t gen,
+                                                           uint64_t version,
+                                                           uint64_t topology_version) {
+  return export_snapshot_impl(snap, gen, version, topology_version, state_->tokens, state_.get());
 }
 
 } // namespace cambang
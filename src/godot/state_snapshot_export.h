@@ -1,11 +1,13 @@
 #pragma once
 
 #include <cstdint>
+#include <memory>
 
 #include <godot_cpp/variant/array.hpp>
 #include <godot_cpp/variant/dictionary.hpp>
 #include <godot_cpp/variant/string.hpp>
 
+#include "core/snapshot/snapshot_summary.h"
 #include "core/snapshot/state_snapshot.h"
 
 namespace cambang {
@@ -23,4 +25,43 @@ godot::Dictionary export_snapshot_to_godot(const CamBANGStateSnapshot& snap,
                                           uint64_t version,
                                           uint64_t topology_version);
 
+// Export a CamBANGStateSummary as a flat Dictionary of its fields. The header
+// uses the same Godot-facing counters as the snapshot it summarizes.
+godot::Dictionary export_state_summary_to_godot(const CamBANGStateSummary& summary,
+                                               uint64_t gen,
+                                               uint64_t version,
+                                               uint64_t topology_version);
+
+// Godot-thread exporter that keeps the previous export's per-record
+// Dictionaries and token Strings between calls.
+//
+// A record whose value equals the one it was last exported from (matched by
+// its id field) reuses that record's Dictionary; only added or changed records
+// are rebuilt; unchanged detached_root_ids / scoped_resource_telemetry Arrays
+// are reused whole. Anything shared between successive exports is made
+// read-only, as docs/state_snapshot.md requires of published snapshots. The
+// top-level Dictionary and the keyed section Arrays are fresh on every export.
+class StateSnapshotExportCache final {
+public:
+  struct State;
+
+  StateSnapshotExportCache();
+  ~StateSnapshotExportCache();
+
+  StateSnapshotExportCache(const StateSnapshotExportCache&) = delete;
+  StateSnapshotExportCache& operator=(const StateSnapshotExportCache&) = delete;
+
+  // Same output as export_snapshot_to_godot().
+  godot::Dictionary export_snapshot(const CamBANGStateSnapshot& snap,
+                                    uint64_t gen,
+                                    uint64_t version,
+                                    uint64_t topology_version);
+
+  // Drops every cached record and token.
+  void clear();
+
+private:
+  std::unique_ptr<State> state_;
+};
+
 } // namespace cambang
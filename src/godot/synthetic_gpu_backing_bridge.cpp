@@ -3,9 +3,14 @@
 #include "godot/godot_gpu_display_service.h"
 #include "godot/cambang_stream_result_internal.h"
 #include "core/resource_aggregate_telemetry.h"
+#include "imaging/api/frame_latency_trace.h"
+#include "pixels/pattern/cpu_packed_pattern_renderer.h"
+#include "pixels/pattern/pattern_render_target.h"
 
+#include <atomic>
 #include <cstring>
 #include <condition_variable>
+#include <cstddef>
 #include <cstdio>
 #include <cstdlib>
 #include <cstdint>
@@ -13,6 +18,7 @@
 #include <memory>
 #include <mutex>
 #include <chrono>
+#include <iterator>
 #include <utility>
 #include <vector>
 
@@ -22,24 +28,30 @@
 #include <godot_cpp/classes/rendering_device.hpp>
 #include <godot_cpp/classes/rendering_server.hpp>
 #include <godot_cpp/classes/image.hpp>
+#include <godot_cpp/classes/rd_shader_source.hpp>
+#include <godot_cpp/classes/rd_shader_spirv.hpp>
 #include <godot_cpp/classes/rd_texture_format.hpp>
 #include <godot_cpp/classes/rd_texture_view.hpp>
 #include <godot_cpp/classes/texture2d.hpp>
+#include <godot_cpp/classes/rd_uniform.hpp>
 #include <godot_cpp/classes/texture2drd.hpp>
 #include <godot_cpp/variant/callable.hpp>
+#include <godot_cpp/variant/typed_array.hpp>
 #include <godot_cpp/variant/utility_functions.hpp>
 #include <godot_cpp/variant/array.hpp>
 #include <godot_cpp/variant/packed_byte_array.hpp>
 #include <godot_cpp/variant/string_name.hpp>
+#include <godot_cpp/variant/vector3.hpp>
 
 namespace cambang {
 
 void register_synthetic_gpu_backing_internal_classes();
 
-static bool enqueue_pending_release(const godot::RID& rid);
+static bool enqueue_pending_release(const godot::RID& rid, uint32_t recycle_width, uint32_t recycle_height);
 static void request_pending_release_drain();
 static void schedule_render_thread_drain(godot::RenderingServer* rs, RenderThreadDrainHelper* helper);
 static void unregister_display_texture_rid_state(uint64_t registration_id);
+static void submit_pending_texture_updates(godot::RenderingDevice* rd);
 
 enum class RenderReleasePhase {
   Closed,
@@ -49,14 +61,83 @@ enum class RenderReleasePhase {
 
 static std::mutex g_pending_release_mutex;
 static std::condition_variable g_pending_release_changed;
+struct PendingRidRelease final {
+  godot::RID rid;
+  // Nonzero for a backing texture that may go to the texture pool.
+  uint32_t recycle_width = 0;
+  uint32_t recycle_height = 0;
+};
+
 // RIDs that must be released from the render thread.
-static std::vector<godot::RID> g_pending_releases;
+static std::vector<PendingRidRelease> g_pending_releases;
 static std::size_t g_release_producers = 0;
 static bool g_pending_release_drain_scheduled = false;
 static bool g_pending_release_drain_running = false;
 static RenderReleasePhase g_render_release_phase = RenderReleasePhase::Closed;
 static RenderThreadDrainHelper* g_render_thread_drain_helper = nullptr;
 
+// Released backing textures kept for reuse by a later backing of the same
+// size, so still captures and stream restarts/resizes do not churn GPU
+// allocations. Every backing texture is RGBA8 with the same usage bits, so
+// the size is the whole key. Textures enter on the render-thread drain (only
+// when their last owner, display wrappers included, is gone) and leave when
+// a producer takes one, when the pool is over kBackingTexturePoolMax*
+// (oldest first), when one has sat unused for kBackingTexturePoolIdleTrimNs
+// (checked on each drain), or when the pool is retired by stop() or bridge
+// teardown. Guarded by g_pending_release_mutex.
+struct PooledBackingTexture final {
+  godot::RID rid;
+  uint32_t width = 0;
+  uint32_t height = 0;
+  uint64_t pooled_ns = 0;
+};
+
+static constexpr std::size_t kBackingTexturePoolMaxTextures = 8;
+static constexpr uint64_t kBackingTexturePoolMaxBytes = 64ull * 1024ull * 1024ull;
+static constexpr uint64_t kBackingTexturePoolIdleTrimNs = 2'000'000'000ull;
+
+// Oldest first.
+static std::vector<PooledBackingTexture> g_backing_texture_pool;
+// Set while stop() drains, so pooled textures are freed rather than kept.
+static bool g_backing_texture_pool_flush_requested = false;
+
+static uint64_t backing_texture_bytes(uint32_t width, uint32_t height) noexcept {
+  return static_cast<uint64_t>(width) * 4u * static_cast<uint64_t>(height);
+}
+
+// Caller holds g_pending_release_mutex. The pool must be emptied by a drain.
+static bool backing_texture_pool_retiring_locked() {
+  return !g_backing_texture_pool.empty() &&
+      (g_backing_texture_pool_flush_requested || g_render_release_phase != RenderReleasePhase::Active);
+}
+
+// Release work (RID frees and Texture2DRD wrapper releases) per host tick is
+// capped, so a teardown burst is spread over several frames instead of
+// spiking one render frame; synthetic_gpu_backing_begin_render_release_tick()
+// opens each tick's budget. Pooling a texture costs nothing and is not
+// counted. Uploads are never deferred, and neither is release work once
+// stop() or bridge teardown drains. Guarded by g_pending_release_mutex.
+static constexpr std::size_t kReleaseWorkPerTick = 32;
+static std::size_t g_release_work_this_tick = 0;
+
+// Caller holds g_pending_release_mutex. Release work the current tick still
+// admits; unbounded while draining for stop() or teardown.
+static std::size_t release_work_allowance_locked() {
+  if (g_backing_texture_pool_flush_requested || g_render_release_phase != RenderReleasePhase::Active) {
+    return SIZE_MAX;
+  }
+  return g_release_work_this_tick < kReleaseWorkPerTick ? kReleaseWorkPerTick - g_release_work_this_tick : 0;
+}
+
+// Caller holds g_pending_release_mutex.
+static bool release_drain_work_pending_locked() {
+  if (!g_pending_texture_updates.empty() || backing_texture_pool_retiring_locked()) {
+    return true;
+  }
+  return (!g_pending_releases.empty() || !g_pending_texture_wrapper_releases.empty()) &&
+      release_work_allowance_locked() > 0;
+}
+
 class RenderReleaseProducerLease final {
 public:
   RenderReleaseProducerLease() {
@@ -101,11 +182,16 @@ struct SharedDisplayTextureRidState final {
   godot::RID rd_texture;
   bool invalidated = false;
   uint64_t registration_id = 0;
+  // Nonzero for backing textures, which go to the texture pool once this
+  // state (and so every display wrapper of the texture) is gone. Forced
+  // release_now() calls always free: a stale wrapper may still sample it.
+  uint32_t recycle_width = 0;
+  uint32_t recycle_height = 0;
 
   explicit SharedDisplayTextureRidState(const godot::RID& rid) : rd_texture(rid) {}
 
   ~SharedDisplayTextureRidState() {
-    release_now();
+    release_now(true);
     unregister_display_texture_rid_state(registration_id);
   }
 
@@ -125,7 +211,7 @@ struct SharedDisplayTextureRidState final {
   // after every registered state and wrapper has joined the final drain. A
   // CamBANG-level stop() alone must not skip release, or the RID leaks once the
   // final retained owner is dropped.
-  void release_now() {
+  void release_now(bool recycle = false) {
     RenderReleaseProducerLease release_admission;
     godot::RID rid;
     {
@@ -137,7 +223,8 @@ struct SharedDisplayTextureRidState final {
     if (!rid.is_valid()) {
       return;
     }
-    if (release_admission && enqueue_pending_release(rid)) {
+    if (release_admission &&
+        enqueue_pending_release(rid, recycle ? recycle_width : 0, recycle ? recycle_height : 0)) {
       request_pending_release_drain();
       return;
     }
@@ -151,16 +238,53 @@ struct SharedDisplayTextureRidState final {
 struct RetainedSyntheticGpuBacking final {
   std::mutex mutex;
   std::shared_ptr<SharedDisplayTextureRidState> rid_state;
+  // Retained-primary backings: the bytes the texture was created from.
   godot::PackedByteArray upload_bytes;
+  // Stream-live backings: two persistent staging buffers. A producer update
+  // writes the slot not currently on the GPU (or overwrites the staged one
+  // that has not been submitted yet), and the render-thread drain submits it.
+  // Neither buffer is shared with the RenderingDevice, so steady-state
+  // updates never reallocate.
+  godot::PackedByteArray staging[2];
+  int staged_slot = -1;    // awaiting submission; -1 when none
+  int submitted_slot = -1; // last slot uploaded to the texture
+  uint64_t staged_trace_id = 0; // frame_latency_trace id of the staged frame
+  // Pixels that differ between the staged frame and the texture contents.
+  // A narrow region is uploaded through dirty_strip (a kDirtyStripColumns
+  // wide texture created on first use) and copied into place on the GPU.
+  PatternDirtyRect pending_dirty{};
+  bool pending_dirty_whole_frame = true;
+  std::shared_ptr<SharedDisplayTextureRidState> dirty_strip_state;
+  godot::PackedByteArray dirty_strip_bytes;
+  // Generated frames (SyntheticGpuPatternFrame). The base is uploaded to
+  // generated_base_state by the render-thread drain when generated_base_dirty;
+  // generated_frame holds the overlays of the newest generated frame, with
+  // its base pointer cleared. generated_staged marks one awaiting the drain,
+  // like staged_slot for a CPU update (at most one of the two is set), and
+  // generated_latest that the newest content is generated, not in staging.
+  godot::PackedByteArray generated_base_bytes;
+  uint64_t generated_base_revision = 0;
+  bool generated_base_dirty = false;
+  std::shared_ptr<SharedDisplayTextureRidState> generated_base_state;
+  godot::RID generated_uniform_set;
+  godot::RID generated_uniform_set_texture;
+  SyntheticGpuPatternFrame generated_frame{};
+  bool generated_staged = false;
+  bool generated_latest = false;
   uint64_t stream_id = 0;
   uint32_t width = 0;
   uint32_t height = 0;
   uint32_t stride_bytes = 0;
   bool released = false;
   ScopedResourceTelemetryKey telemetry_key{};
+  // Object id of the display view last handed out for sharing; 0 when none.
+  // Not a reference: the view lives only as long as its consumers hold it.
+  uint64_t shared_display_view_id = 0;
 
   void release_now() {
     std::shared_ptr<SharedDisplayTextureRidState> state;
+    std::shared_ptr<SharedDisplayTextureRidState> strip_state;
+    std::shared_ptr<SharedDisplayTextureRidState> base_state;
     {
       std::lock_guard<std::mutex> lock(mutex);
       if (released) {
@@ -169,17 +293,58 @@ struct RetainedSyntheticGpuBacking final {
       released = true;
       global_resource_aggregate_telemetry().retained_gpu_backing_released(telemetry_key);
       state = std::move(rid_state);
+      strip_state = std::move(dirty_strip_state);
+      // The uniform set goes with its textures.
+      base_state = std::move(generated_base_state);
     }
     // Drop CamBANG's backing reference after releasing the backing lock. If
     // user-facing display wrappers still hold metadata references to the same
     // state, final RID cleanup is deferred until those wrappers are destroyed.
     (void)state;
+    (void)strip_state;
+    (void)base_state;
   }
 
   ~RetainedSyntheticGpuBacking() {
     release_now();
   }
+
+  // Caller holds mutex. Newest content: a staged update when one is pending,
+  // else the last submitted one, else the creation bytes. When
+  // generated_latest, this is the generated frame's base and the overlays
+  // still have to be applied.
+  const godot::PackedByteArray& latest_bytes_locked() const {
+    if (generated_latest) {
+      return generated_base_bytes;
+    }
+    if (staged_slot >= 0) {
+      return staging[staged_slot];
+    }
+    if (submitted_slot >= 0) {
+      return staging[submitted_slot];
+    }
+    return upload_bytes;
+  }
+};
+
+// Stream-live backings with a staged update awaiting the next render-thread
+// drain, which submits every stream's update in one callback. Guarded by
+// g_pending_release_mutex; a backing appears at most once (staged_slot marks
+// it as queued), so updates to one stream between drains coalesce.
+static std::vector<std::weak_ptr<RetainedSyntheticGpuBacking>> g_pending_texture_updates;
+
+// The compute pipeline that writes generated frames, built by the first
+// drain with a generated frame to submit. Failed is sticky for the bridge's
+// lifetime: producers then fall back to CPU updates. The RIDs are guarded by
+// g_pending_release_mutex and freed by bridge teardown.
+enum class PatternComputeState : uint8_t {
+  Unbuilt,
+  Ready,
+  Failed,
 };
+static std::atomic<PatternComputeState> g_pattern_compute_state{PatternComputeState::Unbuilt};
+static godot::RID g_pattern_compute_shader;
+static godot::RID g_pattern_compute_pipeline;
 
 class DeferredDisplayTexture2DRD : public godot::Texture2D {
   GDCLASS(DeferredDisplayTexture2DRD, godot::Texture2D);
@@ -197,6 +362,14 @@ public:
       uint32_t height);
   void update_dimensions(uint32_t width, uint32_t height);
   void prepare_for_bridge_teardown();
+  // Whether this view still draws state (not yet torn down).
+  bool displays(const std::shared_ptr<SharedDisplayTextureRidState>& state) const {
+    return texture_.is_valid() && state_ == state;
+  }
+  // Whether this view still draws any state that may draw.
+  bool displays_live_state() const {
+    return texture_.is_valid() && state_ && state_->draw_allowed();
+  }
 
   int32_t _get_width() const override;
   int32_t _get_height() const override;
@@ -272,7 +445,7 @@ struct PendingTextureWrapperRelease final {
 // their destructor frees Godot's internal RenderingServer texture wrapper.
 static std::vector<PendingTextureWrapperRelease> g_pending_texture_wrapper_releases;
 
-static bool enqueue_pending_release(const godot::RID& rid) {
+static bool enqueue_pending_release(const godot::RID& rid, uint32_t recycle_width, uint32_t recycle_height) {
   if (!rid.is_valid()) {
     return false;
   }
@@ -280,7 +453,7 @@ static bool enqueue_pending_release(const godot::RID& rid) {
   if (g_render_release_phase == RenderReleasePhase::Closed) {
     return false;
   }
-  g_pending_releases.push_back(rid);
+  g_pending_releases.push_back(PendingRidRelease{rid, recycle_width, recycle_height});
   return true;
 }
 
@@ -578,7 +751,7 @@ static void request_pending_release_drain() {
   {
     std::lock_guard<std::mutex> lock(g_pending_release_mutex);
     if (g_render_release_phase == RenderReleasePhase::Closed ||
-        (g_pending_releases.empty() && g_pending_texture_wrapper_releases.empty()) ||
+        !release_drain_work_pending_locked() ||
         g_pending_release_drain_scheduled ||
         g_pending_release_drain_running) {
       return;
@@ -595,9 +768,69 @@ static void request_pending_release_drain() {
   schedule_render_thread_drain(rs, helper);
 }
 
+static std::mutex g_gpu_update_timing_stats_mutex;
+static SyntheticGpuBackingUpdateStats g_gpu_update_timing_stats;
+
+static void record_update_timing(uint64_t& max_ns, uint64_t& total_ns, uint64_t& calls, uint64_t sample_ns) {
+  total_ns += sample_ns;
+  ++calls;
+  if (sample_ns > max_ns) {
+    max_ns = sample_ns;
+  }
+}
+
+// Render thread only; caller holds g_pending_release_mutex. Pools the
+// recyclable releases and moves every RID to free now into to_free: the other
+// releases, pool overflow, idle pool entries, or the whole pool once it is
+// retiring.
+static void pool_released_backing_textures_locked(
+    std::vector<PendingRidRelease>& released,
+    std::vector<godot::RID>& to_free) {
+  const uint64_t now_ns = static_cast<uint64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(
+          std::chrono::steady_clock::now().time_since_epoch()).count());
+  const bool retiring =
+      g_backing_texture_pool_flush_requested || g_render_release_phase != RenderReleasePhase::Active;
+  for (PendingRidRelease& release : released) {
+    if (!release.rid.is_valid()) {
+      continue;
+    }
+    if (retiring || release.recycle_width == 0 || release.recycle_height == 0) {
+      to_free.push_back(release.rid);
+      continue;
+    }
+    g_backing_texture_pool.push_back(
+        PooledBackingTexture{release.rid, release.recycle_width, release.recycle_height, now_ns});
+  }
+
+  uint64_t pooled_bytes = 0;
+  for (const PooledBackingTexture& pooled : g_backing_texture_pool) {
+    pooled_bytes += backing_texture_bytes(pooled.width, pooled.height);
+  }
+  std::size_t keep_from = 0;
+  while (keep_from < g_backing_texture_pool.size()) {
+    const PooledBackingTexture& oldest = g_backing_texture_pool[keep_from];
+    const bool over_cap = g_backing_texture_pool.size() - keep_from > kBackingTexturePoolMaxTextures ||
+        pooled_bytes > kBackingTexturePoolMaxBytes;
+    const bool idle = now_ns - oldest.pooled_ns > kBackingTexturePoolIdleTrimNs;
+    if (!retiring && !over_cap && !idle) {
+      break;
+    }
+    pooled_bytes -= backing_texture_bytes(oldest.width, oldest.height);
+    to_free.push_back(oldest.rid);
+    ++keep_from;
+  }
+  g_backing_texture_pool.erase(
+      g_backing_texture_pool.begin(),
+      g_backing_texture_pool.begin() + static_cast<std::ptrdiff_t>(keep_from));
+}
+
 bool RenderThreadDrainHelper::drain_pending_releases_on_render_thread() {
-  std::vector<godot::RID> pending;
+  const auto drain_t0 = std::chrono::steady_clock::now();
+  std::vector<PendingRidRelease> pending;
   std::vector<PendingTextureWrapperRelease> pending_texture_wrappers;
+  bool has_texture_updates = false;
+  uint64_t queue_depth = 0;
   {
     std::lock_guard<std::mutex> lock(g_pending_release_mutex);
     if (g_render_release_phase == RenderReleasePhase::Closed) {
@@ -606,8 +839,26 @@ bool RenderThreadDrainHelper::drain_pending_releases_on_render_thread() {
       return false;
     }
     g_pending_release_drain_running = true;
-    pending.swap(g_pending_releases);
-    pending_texture_wrappers.swap(g_pending_texture_wrapper_releases);
+    queue_depth = g_pending_releases.size() + g_pending_texture_wrapper_releases.size();
+    const std::size_t allowance = release_work_allowance_locked();
+    // RID releases are all taken: pooling is free, and frees over the
+    // allowance are requeued below.
+    if (allowance > 0) {
+      pending.swap(g_pending_releases);
+    }
+    if (allowance >= g_pending_texture_wrapper_releases.size()) {
+      pending_texture_wrappers.swap(g_pending_texture_wrapper_releases);
+    } else {
+      const auto split = g_pending_texture_wrapper_releases.begin() + static_cast<std::ptrdiff_t>(allowance);
+      pending_texture_wrappers.assign(
+          std::make_move_iterator(g_pending_texture_wrapper_releases.begin()),
+          std::make_move_iterator(split));
+      g_pending_texture_wrapper_releases.erase(g_pending_texture_wrapper_releases.begin(), split);
+    }
+    if (allowance != SIZE_MAX) {
+      g_release_work_this_tick += pending_texture_wrappers.size();
+    }
+    has_texture_updates = !g_pending_texture_updates.empty();
     g_pending_release_drain_scheduled = false;
   }
 
@@ -615,11 +866,16 @@ bool RenderThreadDrainHelper::drain_pending_releases_on_render_thread() {
 
   godot::RenderingServer* rs = godot::RenderingServer::get_singleton();
   godot::RenderingDevice* rd = rs ? rs->get_rendering_device() : nullptr;
-  if (!pending.empty() && !rd) {
+  // Uploads go first: a backing released since its update was staged has
+  // already dropped out, and its RID may be among the frees below.
+  if (has_texture_updates) {
+    submit_pending_texture_updates(rd);
+  }
+  if (!rd) {
     {
       std::lock_guard<std::mutex> lock(g_pending_release_mutex);
-      for (godot::RID &rid : pending) {
-        g_pending_releases.push_back(std::move(rid));
+      for (PendingRidRelease &release : pending) {
+        g_pending_releases.push_back(std::move(release));
       }
       g_pending_release_drain_running = false;
       g_pending_release_changed.notify_all();
@@ -628,13 +884,33 @@ bool RenderThreadDrainHelper::drain_pending_releases_on_render_thread() {
     return true;
   }
 
-  for (const godot::RID &rid : pending) {
-    if (rid.is_valid()) {
-      if (gpu_trace_enabled()) {
-        godot::UtilityFunctions::print("[CamBANG][SyntheticGpu] texture_free rid=", rid.get_id());
+  std::vector<godot::RID> to_free;
+  {
+    std::lock_guard<std::mutex> lock(g_pending_release_mutex);
+    pool_released_backing_textures_locked(pending, to_free);
+    const std::size_t allowance = release_work_allowance_locked();
+    if (to_free.size() > allowance) {
+      // Over this tick's budget: the rest goes back to the front of the queue.
+      std::vector<PendingRidRelease> deferred;
+      deferred.reserve(to_free.size() - allowance + g_pending_releases.size());
+      for (std::size_t i = allowance; i < to_free.size(); ++i) {
+        deferred.push_back(PendingRidRelease{to_free[i]});
+      }
+      for (PendingRidRelease& release : g_pending_releases) {
+        deferred.push_back(std::move(release));
       }
-      rd->free_rid(rid);
+      g_pending_releases.swap(deferred);
+      to_free.resize(allowance);
     }
+    if (allowance != SIZE_MAX) {
+      g_release_work_this_tick += to_free.size();
+    }
+  }
+  for (const godot::RID &rid : to_free) {
+    if (gpu_trace_enabled()) {
+      godot::UtilityFunctions::print("[CamBANG][SyntheticGpu] texture_free rid=", rid.get_id());
+    }
+    rd->free_rid(rid);
   }
 
   {
@@ -643,31 +919,77 @@ bool RenderThreadDrainHelper::drain_pending_releases_on_render_thread() {
     g_pending_release_changed.notify_all();
   }
 
+  const uint64_t drain_ns = static_cast<uint64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - drain_t0).count());
+  {
+    std::lock_guard<std::mutex> timing_lock(g_gpu_update_timing_stats_mutex);
+    record_update_timing(
+        g_gpu_update_timing_stats.release_drain_max_ns,
+        g_gpu_update_timing_stats.release_drain_total_ns,
+        g_gpu_update_timing_stats.release_drain_calls,
+        drain_ns);
+    if (queue_depth > g_gpu_update_timing_stats.release_queue_depth_max) {
+      g_gpu_update_timing_stats.release_queue_depth_max = queue_depth;
+    }
+  }
+
   request_pending_release_drain();
   return true;
 }
 
 namespace {
 
-struct GpuUpdateTimingStats final {
-  uint64_t upload_copy_calls = 0;
-  uint64_t upload_copy_total_ns = 0;
-  uint64_t upload_copy_max_ns = 0;
-  uint64_t texture_update_calls = 0;
-  uint64_t texture_update_total_ns = 0;
-  uint64_t texture_update_max_ns = 0;
-  uint64_t texture_update_skipped = 0;
-};
+// Takes a pooled backing texture of exactly width x height, most recently
+// pooled first; an invalid RID on a miss. Counts the hit or miss.
+godot::RID take_pooled_backing_texture(uint32_t width, uint32_t height) {
+  godot::RID rid;
+  {
+    std::lock_guard<std::mutex> lock(g_pending_release_mutex);
+    if (g_render_release_phase == RenderReleasePhase::Active && !g_backing_texture_pool_flush_requested) {
+      for (auto it = g_backing_texture_pool.rbegin(); it != g_backing_texture_pool.rend(); ++it) {
+        if (it->width == width && it->height == height) {
+          rid = it->rid;
+          g_backing_texture_pool.erase(std::next(it).base());
+          break;
+        }
+      }
+    }
+  }
+  std::lock_guard<std::mutex> timing_lock(g_gpu_update_timing_stats_mutex);
+  if (rid.is_valid()) {
+    ++g_gpu_update_timing_stats.texture_pool_hits;
+  } else {
+    ++g_gpu_update_timing_stats.texture_pool_misses;
+  }
+  return rid;
+}
 
-std::mutex g_gpu_update_timing_stats_mutex;
-GpuUpdateTimingStats g_gpu_update_timing_stats;
+// Every backing texture is created with this format, so pooled textures fit
+// any backing of their size. Storage lets the pattern compute pass write
+// generated frames straight into a stream-live texture.
+godot::Ref<godot::RDTextureFormat> make_backing_texture_format(uint32_t width, uint32_t height) {
+  godot::Ref<godot::RDTextureFormat> format;
+  format.instantiate();
+  format->set_width(static_cast<int64_t>(width));
+  format->set_height(static_cast<int64_t>(height));
+  format->set_format(godot::RenderingDevice::DATA_FORMAT_R8G8B8A8_UNORM);
+  format->set_usage_bits(
+      godot::RenderingDevice::TEXTURE_USAGE_CAN_COPY_FROM_BIT |
+      godot::RenderingDevice::TEXTURE_USAGE_CAN_COPY_TO_BIT |
+      godot::RenderingDevice::TEXTURE_USAGE_CAN_UPDATE_BIT |
+      godot::RenderingDevice::TEXTURE_USAGE_SAMPLING_BIT |
+      godot::RenderingDevice::TEXTURE_USAGE_STORAGE_BIT);
+  return format;
+}
 
-void record_update_timing(uint64_t& max_ns, uint64_t& total_ns, uint64_t& calls, uint64_t sample_ns) {
-  total_ns += sample_ns;
-  ++calls;
-  if (sample_ns > max_ns) {
-    max_ns = sample_ns;
-  }
+std::shared_ptr<SharedDisplayTextureRidState> make_backing_texture_rid_state(
+    const godot::RID& rid,
+    uint32_t width,
+    uint32_t height) {
+  std::shared_ptr<SharedDisplayTextureRidState> state = make_display_texture_rid_state(rid);
+  state->recycle_width = width;
+  state->recycle_height = height;
+  return state;
 }
 
 void trace_gpu(const char* message) {
@@ -735,43 +1057,56 @@ std::shared_ptr<void> retain_primary_gpu_backing_rgba8(
     return {};
   }
 
-  godot::Ref<godot::RDTextureFormat> format;
-  format.instantiate();
-  format->set_width(static_cast<int64_t>(width));
-  format->set_height(static_cast<int64_t>(height));
-  format->set_format(godot::RenderingDevice::DATA_FORMAT_R8G8B8A8_UNORM);
-  format->set_usage_bits(
-      godot::RenderingDevice::TEXTURE_USAGE_CAN_COPY_FROM_BIT |
-      godot::RenderingDevice::TEXTURE_USAGE_CAN_COPY_TO_BIT |
-      godot::RenderingDevice::TEXTURE_USAGE_SAMPLING_BIT);
-
-  godot::Ref<godot::RDTextureView> view;
-  view.instantiate();
-
   godot::PackedByteArray bytes;
   bytes.resize(static_cast<int64_t>(stride_bytes) * static_cast<int64_t>(height));
   std::memcpy(bytes.ptrw(), src, static_cast<size_t>(bytes.size()));
 
-  godot::Array data;
-  data.push_back(bytes);
-  const godot::RID texture = rd->texture_create(format, view, data);
-  if (!texture.is_valid()) {
-    return {};
+  // A pooled texture still holds its previous contents; the upload is staged
+  // for the render-thread drain like a stream-live update, and draws are
+  // queued behind it.
+  godot::RID texture = take_pooled_backing_texture(width, height);
+  const bool pooled = texture.is_valid();
+  if (!pooled) {
+    godot::Ref<godot::RDTextureView> view;
+    view.instantiate();
+    godot::Array data;
+    data.push_back(bytes);
+    texture = rd->texture_create(make_backing_texture_format(width, height), view, data);
+    if (!texture.is_valid()) {
+      return {};
+    }
   }
   if (gpu_trace_enabled()) {
     godot::UtilityFunctions::print("[CamBANG][SyntheticGpu] texture_alloc kind=retain_primary rid=", texture.get_id(),
                                    " w=", static_cast<uint64_t>(width),
-                                   " h=", static_cast<uint64_t>(height));
+                                   " h=", static_cast<uint64_t>(height),
+                                   " pooled=", pooled);
   }
 
   auto retained_backing = std::make_shared<RetainedSyntheticGpuBacking>();
   retained_backing->telemetry_key = make_unknown_scoped_resource_telemetry();
   global_resource_aggregate_telemetry().retained_gpu_backing_created(retained_backing->telemetry_key);
-  retained_backing->rid_state = make_display_texture_rid_state(texture);
+  retained_backing->rid_state = make_backing_texture_rid_state(texture, width, height);
   retained_backing->width = width;
   retained_backing->height = height;
   retained_backing->stride_bytes = stride_bytes;
   retained_backing->upload_bytes = bytes;
+  if (pooled) {
+    retained_backing->staging[0] = bytes;
+    retained_backing->staged_slot = 0;
+    bool queued = false;
+    {
+      std::lock_guard<std::mutex> lock(g_pending_release_mutex);
+      if (g_render_release_phase == RenderReleasePhase::Active) {
+        g_pending_texture_updates.push_back(retained_backing);
+        queued = true;
+      }
+    }
+    if (!queued) {
+      return {};
+    }
+    request_pending_release_drain();
+  }
   return std::static_pointer_cast<void>(retained_backing);
 }
 
@@ -796,40 +1131,38 @@ std::shared_ptr<void> create_stream_live_gpu_backing_rgba8(
     return {};
   }
 
-  godot::Ref<godot::RDTextureFormat> format;
-  format.instantiate();
-  format->set_width(static_cast<int64_t>(width));
-  format->set_height(static_cast<int64_t>(height));
-  format->set_format(godot::RenderingDevice::DATA_FORMAT_R8G8B8A8_UNORM);
-  format->set_usage_bits(
-      godot::RenderingDevice::TEXTURE_USAGE_CAN_COPY_FROM_BIT |
-      godot::RenderingDevice::TEXTURE_USAGE_CAN_UPDATE_BIT |
-      godot::RenderingDevice::TEXTURE_USAGE_SAMPLING_BIT);
-
-  godot::Ref<godot::RDTextureView> view;
-  view.instantiate();
+  // A pooled texture keeps its previous contents until the first update,
+  // which is always whole-frame (pending_dirty_whole_frame starts true);
+  // display views only exist for frames that have been updated.
+  godot::RID texture = take_pooled_backing_texture(width, height);
+  const bool pooled = texture.is_valid();
+  if (!pooled) {
+    godot::Ref<godot::RDTextureView> view;
+    view.instantiate();
 
-  godot::PackedByteArray bytes;
-  bytes.resize(static_cast<int64_t>(stride_bytes) * static_cast<int64_t>(height));
-  std::memset(bytes.ptrw(), 0, static_cast<size_t>(bytes.size()));
+    godot::PackedByteArray bytes;
+    bytes.resize(static_cast<int64_t>(stride_bytes) * static_cast<int64_t>(height));
+    std::memset(bytes.ptrw(), 0, static_cast<size_t>(bytes.size()));
 
-  godot::Array data;
-  data.push_back(bytes);
-  const godot::RID texture = rd->texture_create(format, view, data);
-  if (!texture.is_valid()) {
-    return {};
+    godot::Array data;
+    data.push_back(bytes);
+    texture = rd->texture_create(make_backing_texture_format(width, height), view, data);
+    if (!texture.is_valid()) {
+      return {};
+    }
   }
   if (gpu_trace_enabled()) {
     godot::UtilityFunctions::print("[CamBANG][SyntheticGpu] texture_alloc kind=stream_live rid=", texture.get_id(),
                                    " w=", static_cast<uint64_t>(width),
-                                   " h=", static_cast<uint64_t>(height));
+                                   " h=", static_cast<uint64_t>(height),
+                                   " pooled=", pooled);
   }
 
   auto retained_backing = std::make_shared<RetainedSyntheticGpuBacking>();
   retained_backing->stream_id = stream_id;
   retained_backing->telemetry_key = make_stream_scoped_resource_telemetry(stream_id);
   global_resource_aggregate_telemetry().retained_gpu_backing_created(retained_backing->telemetry_key);
-  retained_backing->rid_state = make_display_texture_rid_state(texture);
+  retained_backing->rid_state = make_backing_texture_rid_state(texture, width, height);
   retained_backing->width = width;
   retained_backing->height = height;
   retained_backing->stride_bytes = stride_bytes;
@@ -841,29 +1174,22 @@ bool update_stream_live_gpu_backing_rgba8(
     const uint8_t* src,
     uint32_t width,
     uint32_t height,
-    uint32_t stride_bytes) noexcept {
+    uint32_t stride_bytes,
+    const SyntheticGpuBackingDirtyRegion& dirty,
+    uint64_t frame_trace_id) noexcept {
   if (bridge_teardown_started()) {
     return false;
   }
   if (!backing || !src || width == 0 || height == 0 || stride_bytes != width * 4u) {
     return false;
   }
-  request_pending_release_drain();
-  godot::RenderingServer* rs = godot::RenderingServer::get_singleton();
-  if (!rs) {
-    return false;
-  }
-  godot::RenderingDevice* rd = rs->get_rendering_device();
-  if (!rd) {
-    return false;
-  }
 
   const std::shared_ptr<RetainedSyntheticGpuBacking> retained =
       std::static_pointer_cast<RetainedSyntheticGpuBacking>(backing);
   if (!retained) {
     return false;
   }
-  godot::RID texture_rid;
+  bool newly_staged = false;
   {
     std::lock_guard<std::mutex> lock(retained->mutex);
     if (retained->released || !retained->rid_state) {
@@ -872,76 +1198,503 @@ bool update_stream_live_gpu_backing_rgba8(
     if (retained->width != width || retained->height != height || retained->stride_bytes != stride_bytes) {
       return false;
     }
-    texture_rid = retained->rid_state->snapshot_rid();
-    if (!texture_rid.is_valid()) {
+    if (!retained->rid_state->snapshot_rid().is_valid()) {
       return false;
     }
 
+    const bool coalesced = retained->staged_slot >= 0 || retained->generated_staged;
+    const int slot = retained->staged_slot >= 0 ? retained->staged_slot : (retained->submitted_slot == 0 ? 1 : 0);
+    godot::PackedByteArray& staging = retained->staging[slot];
     const int64_t frame_bytes = static_cast<int64_t>(stride_bytes) * static_cast<int64_t>(height);
-    if (retained->upload_bytes.size() != frame_bytes) {
-      retained->upload_bytes.resize(frame_bytes);
+    if (staging.size() != frame_bytes) {
+      staging.resize(frame_bytes);
     }
     const auto copy_t0 = std::chrono::steady_clock::now();
-    std::memcpy(retained->upload_bytes.ptrw(), src, static_cast<size_t>(frame_bytes));
+    std::memcpy(staging.ptrw(), src, static_cast<size_t>(frame_bytes));
     const auto copy_t1 = std::chrono::steady_clock::now();
-    const auto update_t0 = copy_t1;
-    rd->texture_update(texture_rid, 0, retained->upload_bytes);
-    const auto update_t1 = std::chrono::steady_clock::now();
+    retained->staged_slot = slot;
+    retained->staged_trace_id = frame_trace_id;
+    retained->generated_staged = false;
+    retained->generated_latest = false;
+    newly_staged = !coalesced;
+    const bool region_in_frame =
+        dirty.x <= width && dirty.y <= height &&
+        dirty.width <= width - dirty.x && dirty.height <= height - dirty.y;
+    if (!region_in_frame) {
+      retained->pending_dirty_whole_frame = true;
+    } else {
+      retained->pending_dirty =
+          retained->pending_dirty.united(PatternDirtyRect{dirty.x, dirty.y, dirty.width, dirty.height});
+    }
     const uint64_t copy_ns = static_cast<uint64_t>(
         std::chrono::duration_cast<std::chrono::nanoseconds>(copy_t1 - copy_t0).count());
-    const uint64_t update_ns = static_cast<uint64_t>(
-        std::chrono::duration_cast<std::chrono::nanoseconds>(update_t1 - update_t0).count());
     std::lock_guard<std::mutex> timing_lock(g_gpu_update_timing_stats_mutex);
     record_update_timing(
         g_gpu_update_timing_stats.upload_copy_max_ns,
         g_gpu_update_timing_stats.upload_copy_total_ns,
         g_gpu_update_timing_stats.upload_copy_calls,
         copy_ns);
+    if (coalesced) {
+      // The previously staged frame never reached the texture.
+      ++g_gpu_update_timing_stats.texture_update_skipped;
+    }
+  }
+
+  if (newly_staged) {
+    bool queued = false;
+    {
+      std::lock_guard<std::mutex> lock(g_pending_release_mutex);
+      if (g_render_release_phase == RenderReleasePhase::Active) {
+        g_pending_texture_updates.push_back(retained);
+        queued = true;
+      }
+    }
+    if (!queued) {
+      std::lock_guard<std::mutex> lock(retained->mutex);
+      retained->staged_slot = -1;
+      retained->pending_dirty_whole_frame = true;
+      return false;
+    }
+  }
+  request_pending_release_drain();
+  queue_live_display_wrapper_refresh(retained->stream_id, width, height);
+  return true;
+}
+
+bool can_generate_stream_live_pattern_rgba8() noexcept {
+  if (bridge_teardown_started() ||
+      g_pattern_compute_state.load(std::memory_order_acquire) == PatternComputeState::Failed) {
+    return false;
+  }
+  godot::RenderingServer* rs = godot::RenderingServer::get_singleton();
+  return rs && rs->get_rendering_device() != nullptr;
+}
+
+bool generate_stream_live_pattern_rgba8(
+    const std::shared_ptr<void>& backing,
+    uint32_t width,
+    uint32_t height,
+    const SyntheticGpuPatternFrame& frame,
+    uint64_t frame_trace_id) noexcept {
+  if (bridge_teardown_started() ||
+      g_pattern_compute_state.load(std::memory_order_acquire) == PatternComputeState::Failed) {
+    return false;
+  }
+  if (!backing || !frame.base || width == 0 || height == 0) {
+    return false;
+  }
+
+  const std::shared_ptr<RetainedSyntheticGpuBacking> retained =
+      std::static_pointer_cast<RetainedSyntheticGpuBacking>(backing);
+  if (!retained) {
+    return false;
+  }
+  bool newly_staged = false;
+  {
+    std::lock_guard<std::mutex> lock(retained->mutex);
+    if (retained->released || !retained->rid_state) {
+      return false;
+    }
+    if (retained->width != width || retained->height != height || retained->stride_bytes != width * 4u) {
+      return false;
+    }
+    if (!retained->rid_state->snapshot_rid().is_valid()) {
+      return false;
+    }
+
+    const int64_t frame_bytes = static_cast<int64_t>(retained->stride_bytes) * static_cast<int64_t>(height);
+    if (retained->generated_base_bytes.size() != frame_bytes ||
+        retained->generated_base_revision != frame.base_revision) {
+      if (retained->generated_base_bytes.size() != frame_bytes) {
+        retained->generated_base_bytes.resize(frame_bytes);
+      }
+      std::memcpy(retained->generated_base_bytes.ptrw(), frame.base, static_cast<size_t>(frame_bytes));
+      retained->generated_base_revision = frame.base_revision;
+      retained->generated_base_dirty = true;
+    }
+    const bool coalesced = retained->staged_slot >= 0 || retained->generated_staged;
+    if (coalesced) {
+      // The previously staged frame never reached the texture.
+      retained->staged_slot = -1;
+      std::lock_guard<std::mutex> timing_lock(g_gpu_update_timing_stats_mutex);
+      ++g_gpu_update_timing_stats.texture_update_skipped;
+    }
+    retained->generated_frame = frame;
+    retained->generated_frame.base = nullptr;
+    retained->generated_staged = true;
+    retained->generated_latest = true;
+    retained->staged_trace_id = frame_trace_id;
+    newly_staged = !coalesced;
+  }
+
+  if (newly_staged) {
+    bool queued = false;
+    {
+      std::lock_guard<std::mutex> lock(g_pending_release_mutex);
+      if (g_render_release_phase == RenderReleasePhase::Active) {
+        g_pending_texture_updates.push_back(retained);
+        queued = true;
+      }
+    }
+    if (!queued) {
+      std::lock_guard<std::mutex> lock(retained->mutex);
+      retained->generated_staged = false;
+      retained->generated_latest = false;
+      retained->pending_dirty_whole_frame = true;
+      return false;
+    }
+  }
+  request_pending_release_drain();
+  queue_live_display_wrapper_refresh(retained->stream_id, width, height);
+  return true;
+}
+
+} // namespace
+
+// Dirty regions at most this many columns wide are uploaded through the
+// per-backing strip texture instead of a whole-texture update.
+static constexpr uint32_t kDirtyStripColumns = 64;
+
+// Render thread only. Caller holds retained->mutex. Creates the strip texture
+// on first use; false keeps the caller on the whole-texture path. A strip
+// invalidated by bridge teardown is not recreated.
+static bool ensure_dirty_strip_locked(godot::RenderingDevice* rd, RetainedSyntheticGpuBacking& retained) {
+  if (retained.dirty_strip_state) {
+    return retained.dirty_strip_state->draw_allowed();
+  }
+
+  godot::Ref<godot::RDTextureFormat> format;
+  format.instantiate();
+  format->set_width(static_cast<int64_t>(kDirtyStripColumns));
+  format->set_height(static_cast<int64_t>(retained.height));
+  format->set_format(godot::RenderingDevice::DATA_FORMAT_R8G8B8A8_UNORM);
+  format->set_usage_bits(
+      godot::RenderingDevice::TEXTURE_USAGE_CAN_COPY_FROM_BIT |
+      godot::RenderingDevice::TEXTURE_USAGE_CAN_UPDATE_BIT);
+
+  godot::Ref<godot::RDTextureView> view;
+  view.instantiate();
+
+  const int64_t strip_bytes = static_cast<int64_t>(kDirtyStripColumns) * 4 * static_cast<int64_t>(retained.height);
+  if (retained.dirty_strip_bytes.size() != strip_bytes) {
+    retained.dirty_strip_bytes.resize(strip_bytes);
+  }
+  std::memset(retained.dirty_strip_bytes.ptrw(), 0, static_cast<size_t>(strip_bytes));
+
+  godot::Array data;
+  data.push_back(retained.dirty_strip_bytes);
+  const godot::RID strip = rd->texture_create(format, view, data);
+  if (!strip.is_valid()) {
+    return false;
+  }
+  retained.dirty_strip_state = make_display_texture_rid_state(strip);
+  return true;
+}
+
+// Render thread only. Caller holds retained->mutex. Packs the dirty columns
+// of `frame` into the strip, uploads the strip and copies the region into
+// the backing texture on the GPU.
+static bool submit_dirty_region_locked(
+    godot::RenderingDevice* rd,
+    RetainedSyntheticGpuBacking& retained,
+    const godot::RID& texture_rid,
+    const godot::PackedByteArray& frame,
+    const PatternDirtyRect& dirty) {
+  if (!ensure_dirty_strip_locked(rd, retained)) {
+    return false;
+  }
+  const godot::RID strip_rid = retained.dirty_strip_state->snapshot_rid();
+  const size_t strip_stride = static_cast<size_t>(kDirtyStripColumns) * 4u;
+  const size_t row_bytes = static_cast<size_t>(dirty.width) * 4u;
+  const uint8_t* src = frame.ptr();
+  uint8_t* dst = retained.dirty_strip_bytes.ptrw();
+  for (uint32_t row = 0; row < dirty.height; ++row) {
+    const size_t src_offset =
+        static_cast<size_t>(dirty.y + row) * retained.stride_bytes + static_cast<size_t>(dirty.x) * 4u;
+    std::memcpy(dst + static_cast<size_t>(row) * strip_stride, src + src_offset, row_bytes);
+  }
+  if (rd->texture_update(strip_rid, 0, retained.dirty_strip_bytes) != godot::OK) {
+    return false;
+  }
+  return rd->texture_copy(
+             strip_rid,
+             texture_rid,
+             godot::Vector3(0, 0, 0),
+             godot::Vector3(static_cast<godot::real_t>(dirty.x), static_cast<godot::real_t>(dirty.y), 0),
+             godot::Vector3(static_cast<godot::real_t>(dirty.width), static_cast<godot::real_t>(dirty.height), 1),
+             0,
+             0,
+             0,
+             0) == godot::OK;
+}
+
+// The per-frame overlays of CpuPackedPatternRenderer::apply_overlays, over the
+// uploaded base. Push constants: offsets_rgb holds the three per-channel
+// frame-index offsets bytewise (zero when off); bar_x is the moving bar's
+// column, 0xFFFFFFFF when off.
+static const char* const kPatternComputeShaderSource = R"GLSL(
+#version 450
+layout(local_size_x = 8, local_size_y = 8, local_size_z = 1) in;
+layout(rgba8, set = 0, binding = 0) uniform readonly image2D base_image;
+layout(rgba8, set = 0, binding = 1) uniform writeonly image2D out_image;
+layout(push_constant, std430) uniform Params {
+  uint width;
+  uint height;
+  uint offsets_rgb;
+  uint bar_x;
+} params;
+
+void main() {
+  const uvec2 p = gl_GlobalInvocationID.xy;
+  if (p.x >= params.width || p.y >= params.height) {
+    return;
+  }
+  if (p.x == params.bar_x) {
+    imageStore(out_image, ivec2(p), vec4(1.0));
+    return;
+  }
+  const uvec4 base = uvec4(round(imageLoad(base_image, ivec2(p)) * 255.0));
+  const uvec4 add = uvec4(params.offsets_rgb & 0xFFu,
+                          (params.offsets_rgb >> 8) & 0xFFu,
+                          (params.offsets_rgb >> 16) & 0xFFu,
+                          0u);
+  imageStore(out_image, ivec2(p), vec4((base + add) & 0xFFu) / 255.0);
+}
+)GLSL";
+
+// Render thread only. Builds the pattern compute pipeline on first use;
+// false once building it has failed, or while the bridge is tearing down.
+static bool ensure_pattern_compute_pipeline(godot::RenderingDevice* rd, godot::RID& pipeline) {
+  {
+    std::lock_guard<std::mutex> lock(g_pending_release_mutex);
+    if (g_render_release_phase != RenderReleasePhase::Active) {
+      return false;
+    }
+    if (g_pattern_compute_state.load(std::memory_order_acquire) == PatternComputeState::Ready) {
+      pipeline = g_pattern_compute_pipeline;
+      return pipeline.is_valid();
+    }
+  }
+  if (g_pattern_compute_state.load(std::memory_order_acquire) == PatternComputeState::Failed) {
+    return false;
+  }
+
+  godot::Ref<godot::RDShaderSource> source;
+  source.instantiate();
+  source->set_language(godot::RenderingDevice::SHADER_LANGUAGE_GLSL);
+  source->set_stage_source(godot::RenderingDevice::SHADER_STAGE_COMPUTE, kPatternComputeShaderSource);
+  const godot::Ref<godot::RDShaderSPIRV> spirv = rd->shader_compile_spirv_from_source(source);
+  godot::RID shader;
+  if (spirv.is_valid() && spirv->get_stage_compile_error(godot::RenderingDevice::SHADER_STAGE_COMPUTE).is_empty()) {
+    shader = rd->shader_create_from_spirv(spirv);
+  }
+  godot::RID built;
+  if (shader.is_valid()) {
+    built = rd->compute_pipeline_create(shader);
+  }
+  if (!built.is_valid()) {
+    if (shader.is_valid()) {
+      rd->free_rid(shader);
+    }
+    g_pattern_compute_state.store(PatternComputeState::Failed, std::memory_order_release);
+    trace_gpu("pattern compute pipeline unavailable; generated frames fall back to CPU updates");
+    return false;
+  }
+
+  bool stored = false;
+  {
+    std::lock_guard<std::mutex> lock(g_pending_release_mutex);
+    if (g_render_release_phase == RenderReleasePhase::Active) {
+      g_pattern_compute_shader = shader;
+      g_pattern_compute_pipeline = built;
+      g_pattern_compute_state.store(PatternComputeState::Ready, std::memory_order_release);
+      stored = true;
+    }
+  }
+  if (!stored) {
+    // Freeing the shader frees the pipeline built from it.
+    rd->free_rid(shader);
+    return false;
+  }
+  pipeline = built;
+  return true;
+}
+
+// Render thread only. Caller holds retained->mutex. Uploads the base when it
+// changed and dispatches the compute pass that writes retained.generated_frame
+// into the backing texture.
+static bool submit_generated_frame_locked(
+    godot::RenderingDevice* rd,
+    RetainedSyntheticGpuBacking& retained,
+    const godot::RID& texture_rid) {
+  godot::RID pipeline;
+  if (!ensure_pattern_compute_pipeline(rd, pipeline)) {
+    return false;
+  }
+  if (!retained.generated_base_state) {
+    godot::Ref<godot::RDTextureView> view;
+    view.instantiate();
+    godot::Array data;
+    data.push_back(retained.generated_base_bytes);
+    const godot::RID base =
+        rd->texture_create(make_backing_texture_format(retained.width, retained.height), view, data);
+    if (!base.is_valid()) {
+      return false;
+    }
+    retained.generated_base_state = make_display_texture_rid_state(base);
+    retained.generated_base_dirty = false;
+  }
+  const godot::RID base_rid = retained.generated_base_state->snapshot_rid();
+  if (!base_rid.is_valid()) {
+    return false;
+  }
+  if (retained.generated_base_dirty) {
+    if (rd->texture_update(base_rid, 0, retained.generated_base_bytes) != godot::OK) {
+      return false;
+    }
+    retained.generated_base_dirty = false;
+  }
+
+  if (!retained.generated_uniform_set.is_valid() ||
+      retained.generated_uniform_set_texture != texture_rid ||
+      !rd->uniform_set_is_valid(retained.generated_uniform_set)) {
+    godot::RID shader;
+    {
+      std::lock_guard<std::mutex> lock(g_pending_release_mutex);
+      shader = g_pattern_compute_shader;
+    }
+    godot::Ref<godot::RDUniform> base_uniform;
+    base_uniform.instantiate();
+    base_uniform->set_uniform_type(godot::RenderingDevice::UNIFORM_TYPE_IMAGE);
+    base_uniform->set_binding(0);
+    base_uniform->add_id(base_rid);
+    godot::Ref<godot::RDUniform> out_uniform;
+    out_uniform.instantiate();
+    out_uniform->set_uniform_type(godot::RenderingDevice::UNIFORM_TYPE_IMAGE);
+    out_uniform->set_binding(1);
+    out_uniform->add_id(texture_rid);
+    godot::TypedArray<godot::RDUniform> uniforms;
+    uniforms.push_back(base_uniform);
+    uniforms.push_back(out_uniform);
+    // A uniform set is freed with the textures it references.
+    retained.generated_uniform_set = rd->uniform_set_create(uniforms, shader, 0);
+    retained.generated_uniform_set_texture = texture_rid;
+    if (!retained.generated_uniform_set.is_valid()) {
+      return false;
+    }
+  }
+
+  const SyntheticGpuPatternFrame& frame = retained.generated_frame;
+  const uint32_t params[4] = {
+      retained.width,
+      retained.height,
+      frame.overlay_frame_index_offsets
+          ? CpuPackedPatternRenderer::frame_index_offset_px(PatternSpec::PackedFormat::RGBA8, frame.frame_index)
+          : 0u,
+      frame.overlay_moving_bar ? CpuPackedPatternRenderer::moving_bar_x(retained.width, frame.frame_index)
+                               : 0xFFFFFFFFu,
+  };
+  godot::PackedByteArray push_constant;
+  push_constant.resize(sizeof(params));
+  std::memcpy(push_constant.ptrw(), params, sizeof(params));
+
+  const int64_t list = rd->compute_list_begin();
+  rd->compute_list_bind_compute_pipeline(list, pipeline);
+  rd->compute_list_bind_uniform_set(list, retained.generated_uniform_set, 0);
+  rd->compute_list_set_push_constant(list, push_constant, static_cast<uint32_t>(sizeof(params)));
+  rd->compute_list_dispatch(list, (retained.width + 7u) / 8u, (retained.height + 7u) / 8u, 1);
+  rd->compute_list_end();
+  return true;
+}
+
+// Render thread only (the release drain). Submits every staged stream-live
+// update in one pass; without a RenderingDevice the staged updates are
+// dropped, since there is no texture left to update. A staged frame whose
+// dirty region is narrow uploads only that region.
+static void submit_pending_texture_updates(godot::RenderingDevice* rd) {
+  std::vector<std::weak_ptr<RetainedSyntheticGpuBacking>> pending;
+  {
+    std::lock_guard<std::mutex> lock(g_pending_release_mutex);
+    pending.swap(g_pending_texture_updates);
+  }
+  for (const std::weak_ptr<RetainedSyntheticGpuBacking>& weak : pending) {
+    const std::shared_ptr<RetainedSyntheticGpuBacking> retained = weak.lock();
+    if (!retained) {
+      continue;
+    }
+    std::lock_guard<std::mutex> lock(retained->mutex);
+    const int slot = std::exchange(retained->staged_slot, -1);
+    const bool generated = std::exchange(retained->generated_staged, false);
+    const uint64_t trace_id = std::exchange(retained->staged_trace_id, 0);
+    if ((slot < 0 && !generated) || retained->released || !retained->rid_state || !rd) {
+      retained->pending_dirty_whole_frame = true;
+      continue;
+    }
+    const godot::RID texture_rid = retained->rid_state->snapshot_rid();
+    if (!texture_rid.is_valid()) {
+      retained->pending_dirty_whole_frame = true;
+      continue;
+    }
+    if (generated) {
+      const auto update_t0 = std::chrono::steady_clock::now();
+      const bool dispatched = submit_generated_frame_locked(rd, *retained, texture_rid);
+      const auto update_t1 = std::chrono::steady_clock::now();
+      // Staging no longer matches the texture either way.
+      retained->pending_dirty = PatternDirtyRect{};
+      retained->pending_dirty_whole_frame = true;
+      if (!dispatched) {
+        continue;
+      }
+      frame_latency_trace_record(FrameLatencyHop::TextureUpdate, retained->stream_id, trace_id);
+      const uint64_t update_ns = static_cast<uint64_t>(
+          std::chrono::duration_cast<std::chrono::nanoseconds>(update_t1 - update_t0).count());
+      std::lock_guard<std::mutex> timing_lock(g_gpu_update_timing_stats_mutex);
+      record_update_timing(
+          g_gpu_update_timing_stats.texture_update_max_ns,
+          g_gpu_update_timing_stats.texture_update_total_ns,
+          g_gpu_update_timing_stats.texture_update_calls,
+          update_ns);
+      continue;
+    }
+    const PatternDirtyRect dirty = std::exchange(retained->pending_dirty, PatternDirtyRect{});
+    const bool whole_frame = std::exchange(retained->pending_dirty_whole_frame, false);
+    if (!whole_frame && dirty.empty()) {
+      // Pixel-identical to what the texture already holds.
+      retained->submitted_slot = slot;
+      frame_latency_trace_record(FrameLatencyHop::TextureUpdate, retained->stream_id, trace_id);
+      continue;
+    }
+    const auto update_t0 = std::chrono::steady_clock::now();
+    const bool partial =
+        !whole_frame && dirty.width <= kDirtyStripColumns &&
+        submit_dirty_region_locked(rd, *retained, texture_rid, retained->staging[slot], dirty);
+    if (!partial) {
+      rd->texture_update(texture_rid, 0, retained->staging[slot]);
+    }
+    const auto update_t1 = std::chrono::steady_clock::now();
+    retained->submitted_slot = slot;
+    frame_latency_trace_record(FrameLatencyHop::TextureUpdate, retained->stream_id, trace_id);
+    const uint64_t update_ns = static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(update_t1 - update_t0).count());
+    std::lock_guard<std::mutex> timing_lock(g_gpu_update_timing_stats_mutex);
     record_update_timing(
         g_gpu_update_timing_stats.texture_update_max_ns,
         g_gpu_update_timing_stats.texture_update_total_ns,
         g_gpu_update_timing_stats.texture_update_calls,
         update_ns);
   }
-  queue_live_display_wrapper_refresh(retained->stream_id, width, height);
-  return true;
 }
 
-bool take_update_timing_stats(
-    uint64_t& upload_copy_calls,
-    uint64_t& upload_copy_total_ns,
-    uint64_t& upload_copy_max_ns,
-    uint64_t& texture_update_calls,
-    uint64_t& texture_update_total_ns,
-    uint64_t& texture_update_max_ns,
-    uint64_t& texture_update_skipped) noexcept {
+namespace {
+
+bool take_update_timing_stats(SyntheticGpuBackingUpdateStats& out) noexcept {
   std::lock_guard<std::mutex> lock(g_gpu_update_timing_stats_mutex);
-  upload_copy_calls = g_gpu_update_timing_stats.upload_copy_calls;
-  upload_copy_total_ns = g_gpu_update_timing_stats.upload_copy_total_ns;
-  upload_copy_max_ns = g_gpu_update_timing_stats.upload_copy_max_ns;
-  texture_update_calls = g_gpu_update_timing_stats.texture_update_calls;
-  texture_update_total_ns = g_gpu_update_timing_stats.texture_update_total_ns;
-  texture_update_max_ns = g_gpu_update_timing_stats.texture_update_max_ns;
-  texture_update_skipped = g_gpu_update_timing_stats.texture_update_skipped;
+  out = g_gpu_update_timing_stats;
   return true;
 }
 
-bool peek_update_timing_stats(
-    uint64_t& upload_copy_calls,
-    uint64_t& upload_copy_total_ns,
-    uint64_t& upload_copy_max_ns,
-    uint64_t& texture_update_calls,
-    uint64_t& texture_update_total_ns,
-    uint64_t& texture_update_max_ns,
-    uint64_t& texture_update_skipped) noexcept {
-  return take_update_timing_stats(
-      upload_copy_calls,
-      upload_copy_total_ns,
-      upload_copy_max_ns,
-      texture_update_calls,
-      texture_update_total_ns,
-      texture_update_max_ns,
-      texture_update_skipped);
+bool peek_update_timing_stats(SyntheticGpuBackingUpdateStats& out) noexcept {
+  return take_update_timing_stats(out);
 }
 
 void release_stream_live_gpu_backing(std::shared_ptr<void>& backing) noexcept {
@@ -974,7 +1727,7 @@ bool can_materialize_to_image(const std::shared_ptr<void>& backing) noexcept {
   }
   const int64_t required =
       static_cast<int64_t>(retained->stride_bytes) * static_cast<int64_t>(retained->height);
-  return required > 0 && retained->upload_bytes.size() >= required;
+  return required > 0 && retained->latest_bytes_locked().size() >= required;
 }
 
 godot::Ref<godot::Image> materialize_to_image(const std::shared_ptr<void>& backing) {
@@ -990,6 +1743,8 @@ godot::Ref<godot::Image> materialize_to_image(const std::shared_ptr<void>& backi
   godot::PackedByteArray bytes;
   uint32_t width = 0;
   uint32_t height = 0;
+  bool generated = false;
+  SyntheticGpuPatternFrame generated_frame{};
   {
     std::lock_guard<std::mutex> lock(retained->mutex);
     if (retained->released ||
@@ -1000,15 +1755,34 @@ godot::Ref<godot::Image> materialize_to_image(const std::shared_ptr<void>& backi
     }
     const int64_t required =
         static_cast<int64_t>(retained->stride_bytes) * static_cast<int64_t>(retained->height);
-    if (required <= 0 || retained->upload_bytes.size() < required) {
+    if (required <= 0 || retained->latest_bytes_locked().size() < required) {
       return {};
     }
     width = retained->width;
     height = retained->height;
-    bytes = retained->upload_bytes;
+    bytes = retained->latest_bytes_locked();
     if (bytes.size() != required) {
       bytes.resize(required);
     }
+    generated = retained->generated_latest;
+    generated_frame = retained->generated_frame;
+  }
+  if (generated) {
+    // The pixels the compute pass wrote, rebuilt from the base on the CPU.
+    PatternSpec spec{};
+    spec.width = width;
+    spec.height = height;
+    spec.format = PatternSpec::PackedFormat::RGBA8;
+    spec.overlay_frame_index_offsets = generated_frame.overlay_frame_index_offsets;
+    spec.overlay_moving_bar = generated_frame.overlay_moving_bar;
+    PatternRenderTarget dst{};
+    dst.data = bytes.ptrw();
+    dst.size_bytes = static_cast<size_t>(bytes.size());
+    dst.width = width;
+    dst.height = height;
+    dst.stride_bytes = width * 4u;
+    dst.format = spec.format;
+    CpuPackedPatternRenderer::apply_overlays(spec, dst, generated_frame.frame_index);
   }
 
   return godot::Image::create_from_data(
@@ -1029,6 +1803,8 @@ const SyntheticGpuBackingRuntimeOps kOps{
     &can_materialize_to_image,
     &take_update_timing_stats,
     &peek_update_timing_stats,
+    &can_generate_stream_live_pattern_rgba8,
+    &generate_stream_live_pattern_rgba8,
 };
 
 bool activate_render_release_bridge() {
@@ -1043,6 +1819,8 @@ bool activate_render_release_bridge() {
     rejected = g_render_release_phase != RenderReleasePhase::Closed ||
         !g_pending_releases.empty() ||
         !g_pending_texture_wrapper_releases.empty() ||
+        !g_pending_texture_updates.empty() ||
+        !g_backing_texture_pool.empty() ||
         g_release_producers != 0 ||
         g_pending_release_drain_scheduled ||
         g_pending_release_drain_running ||
@@ -1063,6 +1841,13 @@ void begin_render_release_bridge_drain() {
   std::lock_guard<std::mutex> lock(g_pending_release_mutex);
   if (g_render_release_phase == RenderReleasePhase::Active) {
     g_render_release_phase = RenderReleasePhase::Draining;
+    if (g_pattern_compute_shader.is_valid()) {
+      // Freeing the shader frees the pipeline built from it.
+      g_pending_releases.push_back(PendingRidRelease{g_pattern_compute_shader});
+    }
+    g_pattern_compute_shader = godot::RID();
+    g_pattern_compute_pipeline = godot::RID();
+    g_pattern_compute_state.store(PatternComputeState::Unbuilt, std::memory_order_release);
     g_pending_release_changed.notify_all();
   }
 }
@@ -1077,6 +1862,8 @@ void wait_for_render_release_bridge_quiescence_and_close() {
       return g_render_release_phase != RenderReleasePhase::Draining ||
           (g_pending_releases.empty() &&
            g_pending_texture_wrapper_releases.empty() &&
+           g_pending_texture_updates.empty() &&
+           g_backing_texture_pool.empty() &&
            g_release_producers == 0 &&
            !g_pending_release_drain_scheduled &&
            !g_pending_release_drain_running);
@@ -1100,6 +1887,13 @@ void wait_for_render_release_bridge_quiescence_and_close() {
 } // namespace
 
 void install_synthetic_gpu_backing_godot_bridge() {
+  {
+    // Installed by an earlier CamBANGServer start; stays until teardown.
+    std::lock_guard<std::mutex> lock(g_pending_release_mutex);
+    if (g_render_release_phase == RenderReleasePhase::Active) {
+      return;
+    }
+  }
   if (!activate_render_release_bridge()) {
     godot::UtilityFunctions::push_error(
         "[CamBANG][SyntheticGpu] bridge install rejected: render release protocol was not closed and empty");
@@ -1210,6 +2004,12 @@ void synthetic_gpu_backing_invalidate_all_live_display_wrappers() {
 
 void synthetic_gpu_backing_drain_render_releases_before_stop() {
   godot::RenderingServer* rs = godot::RenderingServer::get_singleton();
+  // Pooled textures are not kept across a stop: there may be no producer
+  // for a long while. They are freed along with the accepted releases.
+  {
+    std::lock_guard<std::mutex> lock(g_pending_release_mutex);
+    g_backing_texture_pool_flush_requested = true;
+  }
   for (;;) {
     request_pending_release_drain();
     {
@@ -1217,15 +2017,20 @@ void synthetic_gpu_backing_drain_render_releases_before_stop() {
       if (g_render_release_phase != RenderReleasePhase::Active ||
           (g_pending_releases.empty() &&
            g_pending_texture_wrapper_releases.empty() &&
+           g_pending_texture_updates.empty() &&
+           g_backing_texture_pool.empty() &&
            g_release_producers == 0 &&
            !g_pending_release_drain_scheduled &&
            !g_pending_release_drain_running)) {
+        g_backing_texture_pool_flush_requested = false;
         return;
       }
     }
     if (!rs) {
       godot::UtilityFunctions::push_error(
           "[CamBANG][SyntheticGpu] cannot drain accepted render releases: RenderingServer unavailable");
+      std::lock_guard<std::mutex> lock(g_pending_release_mutex);
+      g_backing_texture_pool_flush_requested = false;
       return;
     }
     // Godot's RenderingServerDefault::sync() puts a synchronous command
@@ -1235,6 +2040,14 @@ void synthetic_gpu_backing_drain_render_releases_before_stop() {
   }
 }
 
+void synthetic_gpu_backing_begin_render_release_tick() {
+  {
+    std::lock_guard<std::mutex> lock(g_pending_release_mutex);
+    g_release_work_this_tick = 0;
+  }
+  request_pending_release_drain();
+}
+
 void synthetic_gpu_backing_drain_pending_live_display_wrapper_refreshes() {
   const std::vector<PendingLiveDisplayWrapperRefresh> refreshes =
       take_pending_live_display_wrapper_refreshes();
@@ -1271,7 +2084,9 @@ void synthetic_gpu_backing_drain_pending_live_display_wrapper_refreshes() {
   }
 }
 
-godot::Ref<godot::Texture2D> synthetic_gpu_backing_display_texture(const std::shared_ptr<void>& backing) {
+godot::Ref<godot::Texture2D> synthetic_gpu_backing_display_texture(
+    const std::shared_ptr<void>& backing,
+    bool share_display_view) {
   constexpr const char* kDisplayTextureRidOwnerMetaKey = "__cambang_synth_gpu_rid_owner";
   if (bridge_teardown_started()) {
     return {};
@@ -1299,6 +2114,7 @@ godot::Ref<godot::Texture2D> synthetic_gpu_backing_display_texture(const std::sh
   uint64_t stream_id = 0;
   uint32_t width = 0;
   uint32_t height = 0;
+  uint64_t shared_view_id = 0;
   {
     std::lock_guard<std::mutex> lock(retained->mutex);
     if (retained->released || !retained->rid_state) {
@@ -1308,6 +2124,7 @@ godot::Ref<godot::Texture2D> synthetic_gpu_backing_display_texture(const std::sh
     stream_id = retained->stream_id;
     width = retained->width;
     height = retained->height;
+    shared_view_id = retained->shared_display_view_id;
   }
 
   const godot::RID display_rid = state->snapshot_rid();
@@ -1315,6 +2132,20 @@ godot::Ref<godot::Texture2D> synthetic_gpu_backing_display_texture(const std::sh
     return {};
   }
 
+  // Every consumer of one backing borrows the same view while any of them
+  // holds it. A Ref cannot be taken on a view whose last reference is going
+  // away, so a dying view simply misses and a new one is built.
+  if (share_display_view && shared_view_id != 0 && state->draw_allowed()) {
+    DeferredDisplayTexture2DRD* shared = godot::Object::cast_to<DeferredDisplayTexture2DRD>(
+        godot::ObjectDB::get_instance(shared_view_id));
+    if (shared && shared->displays(state)) {
+      godot::Ref<DeferredDisplayTexture2DRD> borrowed(shared);
+      if (borrowed.is_valid()) {
+        return borrowed;
+      }
+    }
+  }
+
   godot::Ref<godot::Texture2DRD> texture;
   texture.instantiate();
   if (texture.is_null()) {
@@ -1341,9 +2172,22 @@ godot::Ref<godot::Texture2D> synthetic_gpu_backing_display_texture(const std::sh
   }
   rid_owner->init(stream_id, std::move(state));
   display_view->set_meta(godot::StringName(kDisplayTextureRidOwnerMetaKey), rid_owner);
+  if (share_display_view) {
+    std::lock_guard<std::mutex> lock(retained->mutex);
+    retained->shared_display_view_id = static_cast<uint64_t>(display_view->get_instance_id());
+  }
   return display_view;
 }
 
+bool synthetic_gpu_backing_display_texture_is_live(const godot::Ref<godot::Texture2D>& view) {
+  if (bridge_teardown_started() || view.is_null()) {
+    return false;
+  }
+  const DeferredDisplayTexture2DRD* display_view =
+      godot::Object::cast_to<DeferredDisplayTexture2DRD>(view.ptr());
+  return display_view && display_view->displays_live_state();
+}
+
 godot::Ref<godot::Image> synthetic_gpu_backing_materialize_to_image(const std::shared_ptr<void>& backing) {
   return materialize_to_image(backing);
 }
@@ -7,14 +7,25 @@
 
 namespace cambang {
 
+// Installed on the first CamBANGServer start rather than at extension load,
+// so editor and headless runs that never start a camera register no
+// render-thread helper; later calls are no-ops. Uninstalled at extension
+// teardown.
 void install_synthetic_gpu_backing_godot_bridge();
 void uninstall_synthetic_gpu_backing_godot_bridge();
 
-godot::Ref<godot::Texture2D> synthetic_gpu_backing_display_texture(const std::shared_ptr<void>& backing);
+godot::Ref<godot::Texture2D> synthetic_gpu_backing_display_texture(
+    const std::shared_ptr<void>& backing,
+    bool share_display_view = true);
+// Whether view is a display view this bridge built that can still draw.
+bool synthetic_gpu_backing_display_texture_is_live(const godot::Ref<godot::Texture2D>& view);
 void synthetic_gpu_backing_invalidate_live_display_wrappers_for_stream(uint64_t stream_id);
 void synthetic_gpu_backing_invalidate_all_live_display_wrappers();
 void synthetic_gpu_backing_warn_and_abandon_live_display_wrappers_before_stop();
 void synthetic_gpu_backing_drain_render_releases_before_stop();
+// Once per host tick: opens the tick's render-thread release budget and
+// schedules a drain for work deferred by the previous one.
+void synthetic_gpu_backing_begin_render_release_tick();
 void synthetic_gpu_backing_drain_pending_live_display_wrapper_refreshes();
 godot::Ref<godot::Image> synthetic_gpu_backing_materialize_to_image(const std::shared_ptr<void>& backing);
 
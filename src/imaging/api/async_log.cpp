@@ -0,0 +1,169 @@
+#include "imaging/api/async_log.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstdarg>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <thread>
+
+namespace cambang {
+
+namespace {
+
+struct Line final {
+  std::FILE* stream = nullptr;
+  uint32_t len = 0;
+  char text[kAsyncLogMaxLineBytes];
+};
+
+class Sink final {
+public:
+  void push(std::FILE* stream, const char* text, size_t len);
+  void flush();
+  uint64_t dropped() const noexcept { return dropped_.load(std::memory_order_relaxed); }
+
+private:
+  void start_writer_locked_();
+  void writer_main_();
+  static void write_line_(std::FILE* stream, const char* text, size_t len);
+
+  std::mutex mu_;
+  std::condition_variable work_cv_;
+  std::condition_variable written_cv_;
+  std::array<Line, kAsyncLogCapacity> ring_{};
+  size_t head_ = 0;
+  size_t count_ = 0;
+  // Lines accepted / written (dropped lines are neither).
+  uint64_t queued_total_ = 0;
+  uint64_t written_total_ = 0;
+  std::atomic<uint64_t> dropped_{0};
+  uint64_t dropped_reported_ = 0;
+  bool writer_started_ = false;
+  // Thread creation failed: lines are written on the caller instead.
+  bool synchronous_ = false;
+};
+
+// Deliberately leaked so logging stays valid through static destruction;
+// the atexit hook writes what is still queued.
+Sink& sink() {
+  static Sink* s = new Sink();
+  return *s;
+}
+
+void Sink::write_line_(std::FILE* stream, const char* text, size_t len) {
+  std::fwrite(text, 1, len, stream);
+  std::fputc('\n', stream);
+}
+
+void Sink::start_writer_locked_() {
+  writer_started_ = true;
+  try {
+    std::thread([this]() { writer_main_(); }).detach();
+    std::atexit([]() { sink().flush(); });
+  } catch (...) {
+    synchronous_ = true;
+  }
+}
+
+void Sink::push(std::FILE* stream, const char* text, size_t len) {
+  std::unique_lock<std::mutex> lk(mu_);
+  if (!writer_started_) {
+    start_writer_locked_();
+  }
+  if (synchronous_) {
+    lk.unlock();
+    write_line_(stream, text, len);
+    std::fflush(stream);
+    return;
+  }
+  if (count_ == ring_.size()) {
+    dropped_.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+  Line& line = ring_[(head_ + count_) % ring_.size()];
+  line.stream = stream;
+  line.len = static_cast<uint32_t>(len);
+  std::memcpy(line.text, text, len);
+  ++count_;
+  ++queued_total_;
+  lk.unlock();
+  work_cv_.notify_one();
+}
+
+void Sink::flush() {
+  std::unique_lock<std::mutex> lk(mu_);
+  if (!writer_started_ || synchronous_) {
+    return;
+  }
+  const uint64_t target = queued_total_;
+  written_cv_.wait(lk, [&]() { return written_total_ >= target; });
+}
+
+void Sink::writer_main_() {
+  Line line;
+  std::unique_lock<std::mutex> lk(mu_);
+  while (true) {
+    work_cv_.wait(lk, [&]() { return count_ > 0; });
+    while (count_ > 0) {
+      const Line& front = ring_[head_];
+      line.stream = front.stream;
+      line.len = front.len;
+      std::memcpy(line.text, front.text, front.len);
+      head_ = (head_ + 1) % ring_.size();
+      --count_;
+      const uint64_t dropped = dropped_.load(std::memory_order_relaxed);
+      const uint64_t newly_dropped = dropped - dropped_reported_;
+      dropped_reported_ = dropped;
+      lk.unlock();
+
+      if (newly_dropped > 0) {
+        char note[96];
+        const int n = std::snprintf(note, sizeof(note),
+                                    "[CamBANG][Log] %llu log lines dropped (queue full)",
+                                    static_cast<unsigned long long>(newly_dropped));
+        write_line_(stderr, note, n > 0 ? static_cast<size_t>(n) : 0u);
+      }
+      write_line_(line.stream, line.text, line.len);
+      std::fflush(line.stream);
+
+      lk.lock();
+      ++written_total_;
+    }
+    written_cv_.notify_all();
+  }
+}
+
+} // namespace
+
+void async_log_printf(std::FILE* stream, const char* fmt, ...) {
+  if (!stream || !fmt) {
+    return;
+  }
+  char text[kAsyncLogMaxLineBytes];
+  va_list args;
+  va_start(args, fmt);
+  const int n = std::vsnprintf(text, sizeof(text), fmt, args);
+  va_end(args);
+  if (n < 0) {
+    return;
+  }
+  size_t len = std::min(static_cast<size_t>(n), sizeof(text) - 1);
+  while (len > 0 && text[len - 1] == '\n') {
+    --len;
+  }
+  sink().push(stream, text, len);
+}
+
+void async_log_flush() {
+  sink().flush();
+}
+
+uint64_t async_log_dropped_count() noexcept {
+  return sink().dropped();
+}
+
+} // namespace cambang
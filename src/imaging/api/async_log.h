@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+
+namespace cambang {
+
+// Non-blocking diagnostic output for CamBANG's own threads.
+//
+// async_log_printf() formats on the caller into a bounded line (no I/O) and
+// queues it; a background writer thread, started on first use, writes and
+// flushes the queued lines in order. A caller therefore never waits on a slow
+// stdout/stderr (a pipe into adb logcat or CI capture), only on a short
+// in-memory copy. A line arriving while kAsyncLogCapacity lines are queued is
+// dropped and counted; the writer reports the count once it catches up.
+// Lines longer than kAsyncLogMaxLineBytes are truncated. A newline is
+// appended to every line.
+//
+// Queued lines are written before normal process exit. Paths that end the
+// process abnormally (std::abort) call async_log_flush() first.
+//
+// Threading: every function may be called from any thread.
+inline constexpr size_t kAsyncLogCapacity = 256;
+inline constexpr size_t kAsyncLogMaxLineBytes = 512;
+
+void async_log_printf(std::FILE* stream, const char* fmt, ...);
+
+// Blocks until every line queued before the call has been written.
+void async_log_flush();
+
+uint64_t async_log_dropped_count() noexcept;
+
+} // namespace cambang
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+
+namespace cambang {
+
+// Start barrier for the device jobs of one rig capture submission.
+//
+// Each member's worker does its per-device preparation (session realization,
+// request building, base rendering) first and then waits here, so every
+// member starts from the same instant instead of in whatever order the
+// workers reached it. The skew left between members is the release fan-out,
+// not each member's preparation time.
+//
+// A member that terminalizes before arriving calls drop(), so the rest never
+// wait for it. The wait is bounded: a member that cannot run concurrently
+// (executor saturated by other work) costs its siblings at most the timeout.
+//
+// Threading: every function may be called from any thread.
+class CBCaptureStartBarrier final {
+public:
+  explicit CBCaptureStartBarrier(size_t parties) noexcept : waiting_for_(parties) {}
+
+  CBCaptureStartBarrier(const CBCaptureStartBarrier&) = delete;
+  CBCaptureStartBarrier& operator=(const CBCaptureStartBarrier&) = delete;
+
+  // Counts the caller in and blocks until every party arrived or dropped, or
+  // timeout elapsed. True when the barrier released together.
+  bool arrive_and_wait(std::chrono::nanoseconds timeout) noexcept try {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (count_down_locked_()) {
+      return true;
+    }
+    return released_.wait_for(lock, timeout, [this] { return waiting_for_ == 0; });
+  } catch (...) {
+    return false;
+  }
+
+  void drop() noexcept try {
+    std::lock_guard<std::mutex> lock(mutex_);
+    (void)count_down_locked_();
+  } catch (...) {
+  }
+
+private:
+  bool count_down_locked_() noexcept {
+    if (waiting_for_ > 0 && --waiting_for_ == 0) {
+      released_.notify_all();
+    }
+    return waiting_for_ == 0;
+  }
+
+  std::mutex mutex_;
+  std::condition_variable released_;
+  size_t waiting_for_ = 0;
+};
+
+} // namespace cambang
@@ -0,0 +1,168 @@
+#include "imaging/api/cpu_payload_buffer_pool.h"
+
+#include <atomic>
+#include <new>
+
+namespace cambang {
+
+bool CpuPayloadBufferPool::buffer_is_free_(const std::shared_ptr<CpuPayloadBytes>& buffer) noexcept {
+  // Only the pool can mint new references (under mu_), so once the count has
+  // fallen back to the pool's own it stays there. The fence pairs with the
+  // releasing holder's decrement so its last reads of the bytes happen-before
+  // the next writer's.
+  if (!buffer || buffer.use_count() != 1) {
+    return false;
+  }
+  std::atomic_thread_fence(std::memory_order_acquire);
+  return true;
+}
+
+bool CpuPayloadBufferPool::class_is_idle_(const SizeClass& c) noexcept {
+  for (const auto& buffer : c.buffers) {
+    if (!buffer_is_free_(buffer)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+CpuPayloadBufferPool::SizeClass* CpuPayloadBufferPool::find_or_admit_class_locked_(
+    const CpuPayloadBufferKey& key) noexcept {
+  SizeClass* empty = nullptr;
+  SizeClass* evictable = nullptr;
+  for (SizeClass& c : classes_) {
+    if (!c.active) {
+      if (!empty) {
+        empty = &c;
+      }
+      continue;
+    }
+    if (c.key == key) {
+      return &c;
+    }
+    if (!empty && (!evictable || c.last_used < evictable->last_used) && class_is_idle_(c)) {
+      evictable = &c;
+    }
+  }
+
+  SizeClass* admitted = empty;
+  if (!admitted && evictable) {
+    evictable->buffers.clear();
+    ++stats_.classes_evicted;
+    admitted = evictable;
+  }
+  if (!admitted) {
+    return nullptr;
+  }
+  try {
+    admitted->buffers.reserve(kMaxBuffersPerClass);
+  } catch (...) {
+    admitted->active = false;
+    return nullptr;
+  }
+  admitted->key = key;
+  admitted->active = true;
+  return admitted;
+}
+
+std::shared_ptr<CpuPayloadBytes> CpuPayloadBufferPool::allocate_unpooled_locked_(size_t size_bytes) noexcept {
+  try {
+    return std::make_shared<CpuPayloadBytes>(size_bytes);
+  } catch (...) {
+    ++stats_.alloc_failures;
+    return nullptr;
+  }
+}
+
+std::shared_ptr<CpuPayloadBytes> CpuPayloadBufferPool::acquire(const CpuPayloadBufferKey& key) noexcept {
+  if (key.size_bytes == 0) {
+    return nullptr;
+  }
+  std::lock_guard<std::mutex> lock(mu_);
+  SizeClass* c = find_or_admit_class_locked_(key);
+  if (!c) {
+    auto unpooled = allocate_unpooled_locked_(key.size_bytes);
+    if (unpooled) {
+      ++stats_.unpooled;
+    }
+    return unpooled;
+  }
+  c->last_used = ++use_clock_;
+
+  for (const auto& buffer : c->buffers) {
+    if (buffer_is_free_(buffer)) {
+      ++stats_.reused;
+      return buffer;
+    }
+  }
+
+  auto fresh = allocate_unpooled_locked_(key.size_bytes);
+  if (!fresh) {
+    return nullptr;
+  }
+  if (c->buffers.size() < kMaxBuffersPerClass) {
+    // Capacity was reserved when the class was admitted; this cannot throw.
+    c->buffers.push_back(fresh);
+    ++stats_.allocated;
+  } else {
+    ++stats_.unpooled;
+  }
+  return fresh;
+}
+
+uint64_t CpuPayloadBufferPool::trim() noexcept {
+  std::lock_guard<std::mutex> lock(mu_);
+  uint64_t released = 0;
+  for (SizeClass& c : classes_) {
+    if (!c.active) {
+      continue;
+    }
+    size_t kept = 0;
+    for (size_t i = 0; i < c.buffers.size(); ++i) {
+      if (!buffer_is_free_(c.buffers[i])) {
+        c.buffers[kept++] = std::move(c.buffers[i]);
+      } else {
+        released += c.buffers[i]->size();
+      }
+    }
+    c.buffers.resize(kept);
+    if (kept == 0) {
+      c.active = false;
+    }
+  }
+  return released;
+}
+
+CpuPayloadBufferPool::Stats CpuPayloadBufferPool::stats_copy() const noexcept {
+  std::lock_guard<std::mutex> lock(mu_);
+  return stats_;
+}
+
+size_t CpuPayloadBufferPool::pooled_buffer_count() const noexcept {
+  std::lock_guard<std::mutex> lock(mu_);
+  size_t n = 0;
+  for (const SizeClass& c : classes_) {
+    if (c.active) {
+      n += c.buffers.size();
+    }
+  }
+  return n;
+}
+
+uint64_t CpuPayloadBufferPool::free_pooled_bytes() const noexcept {
+  std::lock_guard<std::mutex> lock(mu_);
+  uint64_t bytes = 0;
+  for (const SizeClass& c : classes_) {
+    if (!c.active) {
+      continue;
+    }
+    for (const auto& buffer : c.buffers) {
+      if (buffer && buffer.use_count() == 1) {
+        bytes += buffer->size();
+      }
+    }
+  }
+  return bytes;
+}
+
+} // namespace cambang
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "imaging/api/cpu_payload_bytes.h"
+
+namespace cambang {
+
+// Geometry a recyclable CPU payload buffer is sized for. size_bytes is the
+// exact vector size handed out (packed: stride_bytes * height; planar: the
+// full multi-plane span), so a buffer adopted through
+// FrameView::cpu_payload_owner reports the frame's own byte count.
+struct CpuPayloadBufferKey {
+  uint32_t width = 0;
+  uint32_t height = 0;
+  uint32_t stride_bytes = 0;
+  uint32_t format_fourcc = 0;
+  size_t size_bytes = 0;
+
+  bool operator==(const CpuPayloadBufferKey& o) const noexcept {
+    return width == o.width && height == o.height && stride_bytes == o.stride_bytes &&
+           format_fourcc == o.format_fourcc && size_bytes == o.size_bytes;
+  }
+  bool operator!=(const CpuPayloadBufferKey& o) const noexcept { return !(*this == o); }
+};
+
+// Size-classed pool of full-frame CPU payload buffers.
+//
+// acquire() hands out a shared_ptr to a pool-held vector. The pool keeps its
+// own reference, so a buffer is free again exactly when every outside holder
+// (provider lease, FrameView::cpu_payload_owner, retained result, snapshot
+// wrapper) has dropped it; nothing is returned explicitly and the last holder
+// may be on any thread. In steady state every acquire() is a reuse and no
+// full-frame buffer is allocated or freed.
+//
+// Bounds: at most kMaxBuffersPerClass buffers per key and kMaxClasses keys.
+// A class whose buffers are all free is evicted (least recently used first)
+// to admit a new key. When a class is saturated, or no class can be evicted,
+// acquire() falls back to an unpooled buffer that is simply freed after its
+// last use, so callers never wait and never see a failure for pressure alone.
+//
+// Buffers are CpuPayloadBytes: 64-byte aligned, and frame-sized ones are
+// offered large pages (see cpu_payload_bytes.h).
+//
+// Buffer contents are unspecified on acquire(); callers overwrite the whole
+// span before publishing it. A buffer must not be written after it has been
+// published as an immutable cpu_payload_owner.
+//
+// Threading: acquire(), stats_copy() and trim() from any thread.
+class CpuPayloadBufferPool final {
+public:
+  struct Stats {
+    uint64_t reused = 0;
+    uint64_t allocated = 0;
+    uint64_t unpooled = 0;
+    uint64_t classes_evicted = 0;
+    uint64_t alloc_failures = 0;
+  };
+
+  static constexpr size_t kMaxClasses = 16;
+  static constexpr size_t kMaxBuffersPerClass = 8;
+
+  CpuPayloadBufferPool() = default;
+  CpuPayloadBufferPool(const CpuPayloadBufferPool&) = delete;
+  CpuPayloadBufferPool& operator=(const CpuPayloadBufferPool&) = delete;
+
+  // Returns a buffer of exactly key.size_bytes, or nullptr when size_bytes is
+  // zero or the allocation itself failed.
+  std::shared_ptr<CpuPayloadBytes> acquire(const CpuPayloadBufferKey& key) noexcept;
+
+  // Releases the pool's reference to every currently free buffer and returns
+  // their bytes. Buffers still held elsewhere stay pooled.
+  uint64_t trim() noexcept;
+
+  Stats stats_copy() const noexcept;
+  size_t pooled_buffer_count() const noexcept;
+  // Bytes of pooled buffers no outside holder references: memory kept only
+  // for reuse. Buffers in use are accounted by whoever holds them.
+  uint64_t free_pooled_bytes() const noexcept;
+
+private:
+  struct SizeClass {
+    CpuPayloadBufferKey key{};
+    bool active = false;
+    uint64_t last_used = 0;
+    std::vector<std::shared_ptr<CpuPayloadBytes>> buffers;
+  };
+
+  static bool buffer_is_free_(const std::shared_ptr<CpuPayloadBytes>& buffer) noexcept;
+  static bool class_is_idle_(const SizeClass& c) noexcept;
+  SizeClass* find_or_admit_class_locked_(const CpuPayloadBufferKey& key) noexcept;
+  std::shared_ptr<CpuPayloadBytes> allocate_unpooled_locked_(size_t size_bytes) noexcept;
+
+  mutable std::mutex mu_;
+  std::array<SizeClass, kMaxClasses> classes_{};
+  uint64_t use_clock_ = 0;
+  Stats stats_{};
+};
+
+} // namespace cambang
@@ -0,0 +1,236 @@
+#include "imaging/api/cpu_payload_bytes.h"
+
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+
+#if defined(_WIN32)
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#elif defined(__linux__)
+#include <sys/mman.h>
+#endif
+
+namespace cambang {
+
+namespace {
+
+// Large storage is laid out as [payload | padding to 64 | trailer], so the
+// trailer is found from (p, bytes) alone and deallocate needs nothing else.
+enum class LargeStorageKind : uint32_t {
+  HEAP = 0,   // aligned operator new; the page allocator refused
+  MAPPED = 1, // page-allocator memory without large pages
+  LARGE = 2,  // large pages granted
+};
+
+struct alignas(kCpuPayloadAlignment) LargeStorageTrailer {
+  LargeStorageKind kind = LargeStorageKind::HEAP;
+  size_t mapped_bytes = 0;
+};
+
+constexpr size_t round_up(size_t n, size_t unit) noexcept {
+  return (n + unit - 1) / unit * unit;
+}
+
+size_t large_storage_span(size_t bytes) noexcept {
+  return round_up(bytes, kCpuPayloadAlignment) + sizeof(LargeStorageTrailer);
+}
+
+LargeStorageTrailer* trailer_of(void* p, size_t bytes) noexcept {
+  return reinterpret_cast<LargeStorageTrailer*>(static_cast<uint8_t*>(p) +
+                                                round_up(bytes, kCpuPayloadAlignment));
+}
+
+struct AllocationCounters {
+  std::atomic<uint64_t> large_page_buffers{0};
+  std::atomic<uint64_t> large_page_bytes{0};
+  std::atomic<uint64_t> fallback_buffers{0};
+  std::atomic<uint64_t> fallback_bytes{0};
+  std::atomic<uint64_t> large_page_grants_total{0};
+  std::atomic<uint64_t> large_page_fallbacks_total{0};
+};
+
+AllocationCounters& counters() noexcept {
+  static AllocationCounters c;
+  return c;
+}
+
+void* heap_allocate(size_t bytes) {
+  return ::operator new(bytes, std::align_val_t{kCpuPayloadAlignment});
+}
+
+void heap_deallocate(void* p) noexcept {
+  ::operator delete(p, std::align_val_t{kCpuPayloadAlignment});
+}
+
+#if defined(_WIN32)
+
+// Cleared after the first refusal (typically ERROR_PRIVILEGE_NOT_HELD: the
+// host has not enabled SeLockMemoryPrivilege), so later frames do not pay
+// for a failing call.
+std::atomic<bool> g_large_pages_usable{true};
+
+void* map_storage(size_t span, LargeStorageTrailer& t) noexcept {
+  const SIZE_T large_min = GetLargePageMinimum();
+  if (large_min != 0 && g_large_pages_usable.load(std::memory_order_relaxed)) {
+    const size_t len = round_up(span, large_min);
+    if (void* p = VirtualAlloc(nullptr, len, MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES, PAGE_READWRITE)) {
+      t.kind = LargeStorageKind::LARGE;
+      t.mapped_bytes = len;
+      return p;
+    }
+    g_large_pages_usable.store(false, std::memory_order_relaxed);
+  }
+  if (void* p = VirtualAlloc(nullptr, span, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE)) {
+    t.kind = LargeStorageKind::MAPPED;
+    t.mapped_bytes = span;
+    return p;
+  }
+  return nullptr;
+}
+
+void unmap_storage(void* p, size_t) noexcept {
+  (void)VirtualFree(p, 0, MEM_RELEASE);
+}
+
+#elif defined(__linux__)
+
+constexpr size_t kHugePageBytes = size_t{2} << 20;
+
+// THP reports "always [madvise] never" with the active mode bracketed.
+// "[never]" makes MADV_HUGEPAGE a silent no-op, so it must not count as a
+// grant. An unreadable file (common on Android) leaves madvise to decide.
+bool transparent_huge_pages_disabled() noexcept {
+  static const bool disabled = [] {
+    std::FILE* f = std::fopen("/sys/kernel/mm/transparent_hugepage/enabled", "r");
+    if (!f) {
+      return false;
+    }
+    char mode[128] = {};
+    const size_t n = std::fread(mode, 1, sizeof(mode) - 1, f);
+    std::fclose(f);
+    mode[n] = '\0';
+    return std::strstr(mode, "[never]") != nullptr;
+  }();
+  return disabled;
+}
+
+void* map_storage(size_t span, LargeStorageTrailer& t) noexcept {
+  // Over-map by one huge page and trim, so the payload starts on a huge
+  // page boundary and the whole span is eligible for promotion.
+  const size_t len = round_up(span, kHugePageBytes);
+  void* raw = mmap(nullptr, len + kHugePageBytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (raw == MAP_FAILED) {
+    return nullptr;
+  }
+  const uintptr_t base = reinterpret_cast<uintptr_t>(raw);
+  const uintptr_t aligned = round_up(base, kHugePageBytes);
+  const size_t head = aligned - base;
+  if (head != 0) {
+    (void)munmap(raw, head);
+  }
+  if (kHugePageBytes - head != 0) {
+    (void)munmap(reinterpret_cast<void*>(aligned + len), kHugePageBytes - head);
+  }
+  void* p = reinterpret_cast<void*>(aligned);
+  t.kind = LargeStorageKind::MAPPED;
+#if defined(MADV_HUGEPAGE)
+  if (!transparent_huge_pages_disabled() && madvise(p, len, MADV_HUGEPAGE) == 0) {
+    t.kind = LargeStorageKind::LARGE;
+  }
+#endif
+  t.mapped_bytes = len;
+  return p;
+}
+
+void unmap_storage(void* p, size_t mapped_bytes) noexcept {
+  (void)munmap(p, mapped_bytes);
+}
+
+#else
+
+void* map_storage(size_t, LargeStorageTrailer&) noexcept {
+  return nullptr;
+}
+
+void unmap_storage(void*, size_t) noexcept {}
+
+#endif
+
+} // namespace
+
+void* cpu_payload_storage_allocate(size_t bytes) {
+  if (bytes < kCpuPayloadLargePageThreshold) {
+    return heap_allocate(bytes);
+  }
+  const size_t span = large_storage_span(bytes);
+  LargeStorageTrailer t{};
+  void* p = map_storage(span, t);
+  if (!p) {
+    p = heap_allocate(span);
+    t = LargeStorageTrailer{};
+  }
+  *trailer_of(p, bytes) = t;
+
+  AllocationCounters& c = counters();
+  if (t.kind == LargeStorageKind::LARGE) {
+    c.large_page_buffers.fetch_add(1, std::memory_order_relaxed);
+    c.large_page_bytes.fetch_add(bytes, std::memory_order_relaxed);
+    c.large_page_grants_total.fetch_add(1, std::memory_order_relaxed);
+  } else {
+    c.fallback_buffers.fetch_add(1, std::memory_order_relaxed);
+    c.fallback_bytes.fetch_add(bytes, std::memory_order_relaxed);
+    c.large_page_fallbacks_total.fetch_add(1, std::memory_order_relaxed);
+  }
+  return p;
+}
+
+void cpu_payload_storage_deallocate(void* p, size_t bytes) noexcept {
+  if (!p) {
+    return;
+  }
+  if (bytes < kCpuPayloadLargePageThreshold) {
+    heap_deallocate(p);
+    return;
+  }
+  const LargeStorageTrailer t = *trailer_of(p, bytes);
+  AllocationCounters& c = counters();
+  if (t.kind == LargeStorageKind::LARGE) {
+    c.large_page_buffers.fetch_sub(1, std::memory_order_relaxed);
+    c.large_page_bytes.fetch_sub(bytes, std::memory_order_relaxed);
+  } else {
+    c.fallback_buffers.fetch_sub(1, std::memory_order_relaxed);
+    c.fallback_bytes.fetch_sub(bytes, std::memory_order_relaxed);
+  }
+  if (t.kind == LargeStorageKind::HEAP) {
+    heap_deallocate(p);
+  } else {
+    unmap_storage(p, t.mapped_bytes);
+  }
+}
+
+bool cpu_payload_storage_has_large_pages(const void* p, size_t bytes) noexcept {
+  if (!p || bytes < kCpuPayloadLargePageThreshold) {
+    return false;
+  }
+  return trailer_of(const_cast<void*>(p), bytes)->kind == LargeStorageKind::LARGE;
+}
+
+CpuPayloadAllocationStats cpu_payload_allocation_stats() noexcept {
+  const AllocationCounters& c = counters();
+  CpuPayloadAllocationStats s;
+  s.large_page_buffers_current = c.large_page_buffers.load(std::memory_order_relaxed);
+  s.large_page_bytes_current = c.large_page_bytes.load(std::memory_order_relaxed);
+  s.fallback_buffers_current = c.fallback_buffers.load(std::memory_order_relaxed);
+  s.fallback_bytes_current = c.fallback_bytes.load(std::memory_order_relaxed);
+  s.large_page_grants_total = c.large_page_grants_total.load(std::memory_order_relaxed);
+  s.large_page_fallbacks_total = c.large_page_fallbacks_total.load(std::memory_order_relaxed);
+  return s;
+}
+
+} // namespace cambang
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <vector>
+
+namespace cambang {
+
+// Every CpuPayloadBytes data() pointer is aligned to this: one cache line,
+// and wide enough for any vector load the pixel kernels issue.
+inline constexpr size_t kCpuPayloadAlignment = 64;
+
+// Storage of at least this many bytes (a 1080p RGBA frame and up) comes
+// from the system page allocator and is offered large pages: transparent
+// huge pages (madvise) on Linux/Android, MEM_LARGE_PAGES on Windows when
+// the process holds the lock-pages privilege. Where neither is available
+// the storage is ordinary aligned memory; the allocation never fails for
+// lack of large pages.
+inline constexpr size_t kCpuPayloadLargePageThreshold = size_t{2} << 20;
+
+// Raw storage behind CpuPayloadAllocator. allocate throws std::bad_alloc;
+// deallocate must be given the byte count passed to allocate.
+void* cpu_payload_storage_allocate(size_t bytes);
+void cpu_payload_storage_deallocate(void* p, size_t bytes) noexcept;
+// True when storage obtained from cpu_payload_storage_allocate(bytes) was
+// granted large pages.
+bool cpu_payload_storage_has_large_pages(const void* p, size_t bytes) noexcept;
+
+// Process-wide view of the large-page path. "Current" values cover storage
+// still allocated; totals count allocations since process start. Storage
+// below kCpuPayloadLargePageThreshold is not counted.
+struct CpuPayloadAllocationStats {
+  uint64_t large_page_buffers_current = 0;
+  uint64_t large_page_bytes_current = 0;
+  uint64_t fallback_buffers_current = 0;
+  uint64_t fallback_bytes_current = 0;
+  uint64_t large_page_grants_total = 0;
+  uint64_t large_page_fallbacks_total = 0;
+};
+
+CpuPayloadAllocationStats cpu_payload_allocation_stats() noexcept;
+
+// Stateless allocator for full-frame CPU payload storage. Element
+// construction is std::allocator's, so sized vectors still start zeroed.
+template <class T>
+struct CpuPayloadAllocator {
+  using value_type = T;
+
+  CpuPayloadAllocator() noexcept = default;
+  template <class U>
+  CpuPayloadAllocator(const CpuPayloadAllocator<U>&) noexcept {}
+
+  T* allocate(size_t n) {
+    if (n > static_cast<size_t>(-1) / sizeof(T)) {
+      throw std::bad_array_new_length();
+    }
+    return static_cast<T*>(cpu_payload_storage_allocate(n * sizeof(T)));
+  }
+  void deallocate(T* p, size_t n) noexcept { cpu_payload_storage_deallocate(p, n * sizeof(T)); }
+
+  template <class U>
+  bool operator==(const CpuPayloadAllocator<U>&) const noexcept { return true; }
+  template <class U>
+  bool operator!=(const CpuPayloadAllocator<U>&) const noexcept { return false; }
+};
+
+// Byte storage of a CPU payload: provider frame buffers, pooled buffers,
+// FrameView::cpu_payload_owner and retained result payloads.
+using CpuPayloadBytes = std::vector<uint8_t, CpuPayloadAllocator<uint8_t>>;
+
+} // namespace cambang
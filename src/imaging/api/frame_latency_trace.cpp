@@ -0,0 +1,181 @@
+#include "imaging/api/frame_latency_trace.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+
+namespace cambang {
+
+namespace {
+
+// One ring slot, guarded by a sequence word: odd while a writer is inside,
+// 2 * index + 2 once the event for ring index `index` is complete. Fields are
+// relaxed atomics so a reader racing a writer is well-defined and detected
+// by the sequence check rather than torn.
+struct Slot final {
+  std::atomic<uint64_t> seq{0};
+  std::atomic<uint64_t> trace_id{0};
+  std::atomic<uint64_t> stream_id{0};
+  std::atomic<uint64_t> timestamp_ns{0};
+  std::atomic<uint32_t> thread_and_hop{0};
+};
+
+std::array<Slot, kFrameLatencyTraceCapacity> g_ring{};
+std::atomic<uint64_t> g_head{0};
+std::atomic<uint64_t> g_cleared_before{0};
+std::atomic<uint64_t> g_next_trace_id{1};
+std::atomic<uint32_t> g_next_thread_index{1};
+
+uint32_t current_thread_index() noexcept {
+  thread_local uint32_t index = 0;
+  if (index == 0) {
+    index = g_next_thread_index.fetch_add(1, std::memory_order_relaxed);
+  }
+  return index;
+}
+
+uint64_t steady_now_ns() noexcept {
+  return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+void append_ts_us(std::string& out, uint64_t ns) {
+  char buf[32];
+  std::snprintf(buf, sizeof(buf), "%" PRIu64 ".%03u", ns / 1000u, static_cast<unsigned>(ns % 1000u));
+  out += buf;
+}
+
+void append_async(std::string& out, char phase, const char* name, const FrameLatencyTraceEvent& e, uint64_t ts_ns) {
+  char buf[160];
+  std::snprintf(buf, sizeof(buf),
+                ",\n{\"name\":\"%s\",\"cat\":\"frame_latency\",\"ph\":\"%c\",\"id\":\"0x%" PRIx64
+                "\",\"pid\":1,\"tid\":%u,\"ts\":",
+                name, phase, e.trace_id, e.thread_index);
+  out += buf;
+  append_ts_us(out, ts_ns);
+  std::snprintf(buf, sizeof(buf), ",\"args\":{\"stream_id\":%" PRIu64 "}}", e.stream_id);
+  out += buf;
+}
+
+} // namespace
+
+const char* to_string(FrameLatencyHop hop) noexcept {
+  switch (hop) {
+    case FrameLatencyHop::ProviderAcquire: return "provider_acquire";
+    case FrameLatencyHop::StrandPost: return "strand_post";
+    case FrameLatencyHop::IngressEnqueue: return "ingress_enqueue";
+    case FrameLatencyHop::CoreDispatch: return "core_dispatch";
+    case FrameLatencyHop::RetainFrame: return "retain_frame";
+    case FrameLatencyHop::GodotPickup: return "godot_pickup";
+    case FrameLatencyHop::TextureUpdate: return "texture_update";
+  }
+  return "unknown";
+}
+
+uint64_t frame_latency_trace_new_id() noexcept {
+  uint64_t id = g_next_trace_id.fetch_add(1, std::memory_order_relaxed);
+  if (id == 0) {
+    id = g_next_trace_id.fetch_add(1, std::memory_order_relaxed);
+  }
+  return id;
+}
+
+uint64_t frame_latency_trace_begin(uint64_t stream_id) noexcept {
+  const uint64_t id = frame_latency_trace_new_id();
+  frame_latency_trace_record(FrameLatencyHop::ProviderAcquire, stream_id, id);
+  return id;
+}
+
+void frame_latency_trace_record(FrameLatencyHop hop, uint64_t stream_id, uint64_t trace_id) noexcept {
+  if (trace_id == 0) {
+    return;
+  }
+  const uint64_t ts = steady_now_ns();
+  const uint64_t index = g_head.fetch_add(1, std::memory_order_relaxed);
+  Slot& slot = g_ring[index % kFrameLatencyTraceCapacity];
+  slot.seq.store(2u * index + 1u, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  slot.trace_id.store(trace_id, std::memory_order_relaxed);
+  slot.stream_id.store(stream_id, std::memory_order_relaxed);
+  slot.timestamp_ns.store(ts, std::memory_order_relaxed);
+  slot.thread_and_hop.store((current_thread_index() << 8) | static_cast<uint32_t>(hop), std::memory_order_relaxed);
+  slot.seq.store(2u * index + 2u, std::memory_order_release);
+}
+
+void frame_latency_trace_clear() noexcept {
+  g_cleared_before.store(g_head.load(std::memory_order_acquire), std::memory_order_release);
+}
+
+void frame_latency_trace_copy(std::vector<FrameLatencyTraceEvent>& out) {
+  const uint64_t head = g_head.load(std::memory_order_acquire);
+  const uint64_t oldest = head > kFrameLatencyTraceCapacity ? head - kFrameLatencyTraceCapacity : 0;
+  const uint64_t begin = std::max(oldest, g_cleared_before.load(std::memory_order_acquire));
+  out.reserve(out.size() + static_cast<size_t>(head - std::min(head, begin)));
+  for (uint64_t index = begin; index < head; ++index) {
+    const Slot& slot = g_ring[index % kFrameLatencyTraceCapacity];
+    const uint64_t expected = 2u * index + 2u;
+    if (slot.seq.load(std::memory_order_acquire) != expected) {
+      continue; // still being written, or already overwritten
+    }
+    FrameLatencyTraceEvent e{};
+    e.trace_id = slot.trace_id.load(std::memory_order_relaxed);
+    e.stream_id = slot.stream_id.load(std::memory_order_relaxed);
+    e.timestamp_ns = slot.timestamp_ns.load(std::memory_order_relaxed);
+    const uint32_t thread_and_hop = slot.thread_and_hop.load(std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (slot.seq.load(std::memory_order_relaxed) != expected) {
+      continue;
+    }
+    e.thread_index = thread_and_hop >> 8;
+    e.hop = static_cast<FrameLatencyHop>(thread_and_hop & 0xFFu);
+    out.push_back(e);
+  }
+}
+
+std::string frame_latency_trace_chrome_json() {
+  std::vector<FrameLatencyTraceEvent> events;
+  frame_latency_trace_copy(events);
+  std::stable_sort(events.begin(), events.end(), [](const FrameLatencyTraceEvent& a, const FrameLatencyTraceEvent& b) {
+    if (a.trace_id != b.trace_id) return a.trace_id < b.trace_id;
+    return a.timestamp_ns < b.timestamp_ns;
+  });
+
+  std::string out;
+  out.reserve(events.size() * 400u + 128u);
+  out += "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n"
+         "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"args\":{\"name\":\"CamBANG frame latency\"}}";
+  for (size_t first = 0; first < events.size();) {
+    size_t last = first;
+    while (last + 1 < events.size() && events[last + 1].trace_id == events[first].trace_id) {
+      ++last;
+    }
+    // Whole frame, then one nested slice per hop named after the hop it
+    // starts from. A frame with a single recorded hop gets only the instant.
+    if (last > first) {
+      append_async(out, 'b', "frame", events[first], events[first].timestamp_ns);
+      for (size_t i = first; i < last; ++i) {
+        append_async(out, 'b', to_string(events[i].hop), events[i], events[i].timestamp_ns);
+        append_async(out, 'e', to_string(events[i].hop), events[i], events[i + 1].timestamp_ns);
+      }
+      append_async(out, 'e', "frame", events[first], events[last].timestamp_ns);
+    }
+    for (size_t i = first; i <= last; ++i) {
+      char buf[224];
+      std::snprintf(buf, sizeof(buf),
+                    ",\n{\"name\":\"%s\",\"cat\":\"frame_latency\",\"ph\":\"i\",\"s\":\"t\",\"pid\":1,\"tid\":%u,"
+                    "\"args\":{\"stream_id\":%" PRIu64 ",\"trace_id\":%" PRIu64 "},\"ts\":",
+                    to_string(events[i].hop), events[i].thread_index, events[i].stream_id, events[i].trace_id);
+      out += buf;
+      append_ts_us(out, events[i].timestamp_ns);
+      out += "}";
+    }
+    first = last + 1;
+  }
+  out += "\n]}\n";
+  return out;
+}
+
+} // namespace cambang
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace cambang {
+
+// Per-frame latency trace across the stream frame path.
+//
+// Each hop a repeating stream frame passes records one event (hop, stream,
+// frame trace id, steady-clock time, recording thread) into a fixed process-
+// wide ring. Recording is wait-free and allocation-free, so the trace stays on
+// in every build; the ring simply keeps the newest kFrameLatencyTraceCapacity events.
+//
+// A frame's trace id travels on FrameView::trace_id and, once retained, on
+// CoreStreamResultData::trace_id. Providers that know when they acquired a
+// frame call frame_latency_trace_begin() there; otherwise CBProviderStrand
+// assigns the id at post time and the trace starts at StrandPost. Still
+// captures are not traced.
+//
+// Export: frame_latency_trace_chrome_json() renders the retained events as
+// Chrome trace / Perfetto JSON (CamBANGServer::get_frame_latency_trace_diagnostics()).
+//
+// Threading: every function may be called from any thread.
+enum class FrameLatencyHop : uint8_t {
+  ProviderAcquire = 0,
+  StrandPost,
+  IngressEnqueue,
+  CoreDispatch,
+  RetainFrame,
+  GodotPickup,
+  TextureUpdate,
+};
+
+const char* to_string(FrameLatencyHop hop) noexcept;
+
+struct FrameLatencyTraceEvent final {
+  uint64_t trace_id = 0;
+  uint64_t stream_id = 0;
+  uint64_t timestamp_ns = 0; // std::chrono::steady_clock
+  uint32_t thread_index = 0; // small per-process id of the recording thread
+  FrameLatencyHop hop = FrameLatencyHop::ProviderAcquire;
+};
+
+inline constexpr size_t kFrameLatencyTraceCapacity = 8192;
+
+// Issues a new trace id (never 0) and records ProviderAcquire for it.
+uint64_t frame_latency_trace_begin(uint64_t stream_id) noexcept;
+
+// Issues a new trace id (never 0) without recording anything.
+uint64_t frame_latency_trace_new_id() noexcept;
+
+// No-op for trace_id 0 (untraced frame).
+void frame_latency_trace_record(FrameLatencyHop hop, uint64_t stream_id, uint64_t trace_id) noexcept;
+
+// Drops every event recorded so far (e.g. at runtime start).
+void frame_latency_trace_clear() noexcept;
+
+// Appends the retained events, oldest first. Events being overwritten while
+// they are read are skipped.
+void frame_latency_trace_copy(std::vector<FrameLatencyTraceEvent>& out);
+
+// Chrome trace event JSON of the retained events: one async "frame" slice per
+// trace id with a nested slice per hop-to-hop segment, plus an instant event
+// per hop on the recording thread.
+std::string frame_latency_trace_chrome_json();
+
+} // namespace cambang
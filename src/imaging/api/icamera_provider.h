@@ -6,6 +6,7 @@
 #include <vector>
 
 #include "core/camera_fact_types.h"
+#include "cpu_payload_buffer_pool.h"
 #include "provider_contract_datatypes.h"
 
 namespace cambang {
@@ -32,7 +33,7 @@ inline constexpr uint64_t kDefaultCaptureAdmissionWatchdogTimeoutNs =
 // command; nothing here will crash or corrupt if called from multiple
 // threads). But CoreThread's posted-task queues are FIFO only relative to a
 // single POSTING thread -- concurrent posts from two different provider
-// threads race for CoreThread's internal queue lock, and the relative order
+// threads race for a position in CoreThread's queue, and the relative order
 // they land in the queue (and therefore the order Core processes them) is
 // UNDEFINED. Core has no mechanism to detect or repair a misordering after
 // the fact.
@@ -82,6 +83,38 @@ public:
   // This call is synchronous and must be safe to invoke from any provider thread.
   virtual bool is_stream_display_demand_active(uint64_t stream_id) = 0;
 
+  // Optional backpressure hint: true while Core is already holding as many
+  // undelivered repeating frames for stream_id as it will keep, or its frame
+  // mailbox is close to full. A repeating frame produced now would most likely
+  // be dropped or displace a queued one, so providers may skip rendering or
+  // converting it at the source. Advisory only: never skip still-capture
+  // frames on it, and a false answer promises nothing.
+  // This call is synchronous and must be safe to invoke from any provider thread.
+  virtual bool is_stream_ingress_congested(uint64_t stream_id) {
+    (void)stream_id;
+    return false;
+  }
+
+  // Drop class Core assigned to stream_id (StreamRequest::priority); NORMAL
+  // for an unknown stream. CBProviderStrand consults it only when its frame
+  // ring is filling, to shed lower classes first.
+  // This call is synchronous, lock-free and safe from any provider thread.
+  virtual StreamPriority stream_priority(uint64_t stream_id) {
+    (void)stream_id;
+    return StreamPriority::NORMAL;
+  }
+
+  // Optional recyclable CPU payload buffer (exactly key.size_bytes, contents
+  // unspecified) for a frame the provider is about to fill. Publish it through
+  // FrameView::cpu_payload_owner and stop writing it; the buffer recycles once
+  // Core and every retained result have dropped it. nullptr means Core offers
+  // no pool or the allocation failed; providers then use their own storage.
+  // This call is synchronous and must be safe to invoke from any provider thread.
+  virtual std::shared_ptr<CpuPayloadBytes> acquire_cpu_payload_buffer(const CpuPayloadBufferKey& key) {
+    (void)key;
+    return nullptr;
+  }
+
   // ---- Device lifecycle confirmations ----
   virtual void on_device_opened(uint64_t device_instance_id) = 0;
   virtual void on_device_closed(uint64_t device_instance_id) = 0;
@@ -128,6 +161,12 @@ public:
   // ---- Native object reporting (snapshot introspection) ----
   virtual void on_native_object_created(const NativeObjectCreateInfo& info) = 0;
   virtual void on_native_object_destroyed(const NativeObjectDestroyInfo& info) = 0;
+  // Optional: pooled resources keep one long-lived native object and report
+  // its size here instead of a destroy/create pair per resize. Core coalesces
+  // updates per object and integrates them in batches.
+  virtual void on_native_object_counters(const NativeObjectCountersUpdate& update) {
+    (void)update;
+  }
 };
 
 
@@ -167,6 +206,20 @@ public:
   // This is an internal execution-capability seam for future multi-image still
   // requests; default-only still capture continues through trigger_capture().
   virtual bool supports_multi_image_still_sequence() const noexcept = 0;
+  // Repeating streams one device instance may have flowing at once. Core
+  // refuses to start a stream past it (TryStartStreamStatus::Busy). The
+  // default keeps one active stream per device; a provider whose capture
+  // session feeds several output geometries from one sensor flow ("sibling"
+  // streams, e.g. a preview and an analysis stream) raises it.
+  virtual uint32_t max_active_streams_per_device() const noexcept { return 1; }
+  // Whether a still capture on this device runs alongside its repeating
+  // streams, the still being one more output of the running session, so
+  // preview keeps flowing. When false (the default) Core pauses the device's
+  // repeating stream frames until the capture is result-safe.
+  virtual bool supports_capture_alongside_streams(uint64_t device_instance_id) const noexcept {
+    (void)device_instance_id;
+    return false;
+  }
 
   // Internal producer-backing capability advertisement for stream realization.
   // Backing capability is provider/runtime truth and is distinct from payload kind policy.
@@ -261,6 +314,19 @@ public:
       const PictureConfig& picture) = 0;
   virtual ProviderResult stop_stream(uint64_t stream_id) = 0;
 
+  // Replace a created stream's profile in place, started or not. A started
+  // stream keeps its started state with no stopped/started facts: frames at
+  // the old profile may still arrive until the first frame at the new one.
+  // Providers reuse whatever platform session they can; on failure the
+  // stream keeps its previous profile, or, when that cannot be restored, is
+  // stopped with an error fact. Providers that cannot do this without
+  // teardown must return ERR_NOT_SUPPORTED.
+  virtual ProviderResult reconfigure_stream(uint64_t stream_id, const CaptureProfile& profile) {
+    (void)stream_id;
+    (void)profile;
+    return ProviderResult::failure(ProviderError::ERR_NOT_SUPPORTED);
+  }
+
   // Narrow internal seam for Core-owned parent-scoped backing-plan evaluation.
   // A successful return commits the requested retained-production plan for
   // subsequent frames from this created stream; providers must not emit a frame
@@ -301,6 +367,36 @@ public:
     return ProviderResult::failure(ProviderError::ERR_NOT_SUPPORTED);
   }
 
+  // Memory pressure: release provider-owned memory kept only for reuse
+  // (buffer pools, render caches) down to the level's floor and return the
+  // bytes released, best-effort. Frames and captures in flight keep what
+  // they hold. Called on the core thread; must be prompt.
+  virtual uint64_t trim_memory(MemoryTrimLevel level) noexcept {
+    (void)level;
+    return 0;
+  }
+
+  // Advisory frame-pool sizing for a created stream: how many of its frames
+  // Core may hold at once. Sent after create_stream() succeeds and again
+  // whenever Core's retention for the stream changes (history ring, jitter
+  // buffer, recorder), so a provider can resize ahead of time rather than
+  // find out through exhaustion drops. A pool whose slots are freed by
+  // FrameView::release needs in_flight_frames; storage a retained result
+  // keeps alive needs retained_frames on top. Called on the core thread;
+  // must be prompt and must not emit facts.
+  virtual void set_stream_pool_depth_hint(uint64_t stream_id, const StreamPoolDepthHint& hint) noexcept {
+    (void)stream_id;
+    (void)hint;
+  }
+
+  // Load signal: cumulative count of stream frames the provider dropped
+  // before handing them to core (buffer pool exhausted, producer behind its
+  // schedule). Read on the core thread by the stream QoS controller; must be
+  // cheap and lock-free. Providers that never drop report 0.
+  virtual uint64_t producer_frames_dropped_total() const noexcept {
+    return 0;
+  }
+
   // Trigger a still capture for a device instance. A successful return is
   // admission/ownership transfer: the provider will later report terminal
   // capture success or failure through the provider callback/strand path.
@@ -0,0 +1,105 @@
+#include "imaging/api/mapped_file.h"
+
+#if defined(_WIN32)
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#include <filesystem>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace cambang {
+
+bool CBMappedFile::open(const std::string& path, bool hint_sequential) noexcept {
+  close();
+  if (path.empty()) {
+    return false;
+  }
+#if defined(_WIN32)
+  HANDLE file = INVALID_HANDLE_VALUE;
+  try {
+    file = CreateFileW(std::filesystem::path(path).c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                       OPEN_EXISTING, hint_sequential ? FILE_FLAG_SEQUENTIAL_SCAN : FILE_ATTRIBUTE_NORMAL,
+                       nullptr);
+  } catch (...) {
+    return false;
+  }
+  if (file == INVALID_HANDLE_VALUE) {
+    return false;
+  }
+  file_handle_ = file;
+  LARGE_INTEGER bytes{};
+  if (!GetFileSizeEx(file, &bytes) || bytes.QuadPart <= 0 ||
+      static_cast<unsigned long long>(bytes.QuadPart) > SIZE_MAX) {
+    close();
+    return false;
+  }
+  HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  if (!mapping) {
+    close();
+    return false;
+  }
+  mapping_handle_ = mapping;
+  data_ = static_cast<const uint8_t*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+  if (!data_) {
+    close();
+    return false;
+  }
+  size_ = static_cast<size_t>(bytes.QuadPart);
+  return true;
+#else
+  const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0) {
+    return false;
+  }
+  struct stat st {};
+  if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+    ::close(fd);
+    return false;
+  }
+  void* p = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+  // The mapping keeps the file referenced.
+  ::close(fd);
+  if (p == MAP_FAILED) {
+    return false;
+  }
+  data_ = static_cast<const uint8_t*>(p);
+  size_ = static_cast<size_t>(st.st_size);
+  if (hint_sequential) {
+    (void)madvise(p, size_, MADV_SEQUENTIAL);
+  }
+  return true;
+#endif
+}
+
+void CBMappedFile::close() noexcept {
+#if defined(_WIN32)
+  if (data_) {
+    UnmapViewOfFile(data_);
+  }
+  if (mapping_handle_) {
+    CloseHandle(static_cast<HANDLE>(mapping_handle_));
+  }
+  if (file_handle_) {
+    CloseHandle(static_cast<HANDLE>(file_handle_));
+  }
+#else
+  if (data_) {
+    munmap(const_cast<uint8_t*>(data_), size_);
+  }
+#endif
+  data_ = nullptr;
+  size_ = 0;
+  file_handle_ = nullptr;
+  mapping_handle_ = nullptr;
+}
+
+} // namespace cambang
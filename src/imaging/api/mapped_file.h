@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace cambang {
+
+// Read-only mapping of a whole file (mmap / MapViewOfFile), for parsing or
+// scanning file contents in place without reading them into a buffer.
+//
+// Empty files are refused: a zero-length mapping is not portable.
+//
+// Threading: not thread-safe; one owner opens and closes. data() may be read
+// from any thread while the file is open.
+class CBMappedFile final {
+public:
+  CBMappedFile() = default;
+  ~CBMappedFile() { close(); }
+
+  CBMappedFile(const CBMappedFile&) = delete;
+  CBMappedFile& operator=(const CBMappedFile&) = delete;
+
+  // Maps path (UTF-8), closing any previous file. hint_sequential advises
+  // the system that the file is read front to back. False when the file
+  // cannot be opened or mapped, or is empty.
+  bool open(const std::string& path, bool hint_sequential = true) noexcept;
+  void close() noexcept;
+  bool is_open() const noexcept { return data_ != nullptr; }
+
+  const uint8_t* data() const noexcept { return data_; }
+  size_t size() const noexcept { return size_; }
+  std::string_view text() const noexcept {
+    return std::string_view(reinterpret_cast<const char*>(data_), size_);
+  }
+
+private:
+  const uint8_t* data_ = nullptr;
+  size_t size_ = 0;
+  void* file_handle_ = nullptr;
+  void* mapping_handle_ = nullptr;
+};
+
+} // namespace cambang
@@ -0,0 +1,127 @@
+#include "imaging/api/performance_hint.h"
+
+#if defined(__ANDROID__)
+#include <dlfcn.h>
+#include <unistd.h>
+#endif
+
+namespace cambang {
+
+namespace {
+
+#if defined(__ANDROID__)
+
+// Mirrors <android/performance_hint.h>, which declares these only for
+// __ANDROID_API__ >= 33.
+using GetManagerFn = void* (*)();
+using CreateSessionFn = void* (*)(void*, const int32_t*, size_t, int64_t);
+using UpdateTargetFn = int (*)(void*, int64_t);
+using ReportActualFn = int (*)(void*, int64_t);
+using CloseSessionFn = void (*)(void*);
+
+struct HintEntryPoints {
+  void* manager = nullptr;
+  CreateSessionFn create_session = nullptr;
+  UpdateTargetFn update_target = nullptr;
+  ReportActualFn report_actual = nullptr;
+  CloseSessionFn close_session = nullptr;
+
+  HintEntryPoints() noexcept {
+    void* lib = dlopen("libandroid.so", RTLD_NOW | RTLD_LOCAL);
+    if (!lib) {
+      return;
+    }
+    auto get_manager = reinterpret_cast<GetManagerFn>(dlsym(lib, "APerformanceHint_getManager"));
+    create_session = reinterpret_cast<CreateSessionFn>(dlsym(lib, "APerformanceHint_createSession"));
+    update_target =
+        reinterpret_cast<UpdateTargetFn>(dlsym(lib, "APerformanceHint_updateTargetWorkDuration"));
+    report_actual =
+        reinterpret_cast<ReportActualFn>(dlsym(lib, "APerformanceHint_reportActualWorkDuration"));
+    close_session = reinterpret_cast<CloseSessionFn>(dlsym(lib, "APerformanceHint_closeSession"));
+    if (get_manager && create_session && update_target && report_actual && close_session) {
+      manager = get_manager();
+    }
+  }
+
+  bool usable() const noexcept { return manager != nullptr; }
+};
+
+const HintEntryPoints& hint_entry_points() noexcept {
+  static const HintEntryPoints entry_points;
+  return entry_points;
+}
+
+#endif
+
+} // namespace
+
+bool CBPerformanceHintSession::open(const int32_t* thread_ids, size_t count, int64_t target_ns) noexcept {
+  close();
+#if defined(__ANDROID__)
+  const HintEntryPoints& hint = hint_entry_points();
+  if (!hint.usable() || !thread_ids || target_ns <= 0) {
+    return false;
+  }
+  int32_t ids[16];
+  size_t used = 0;
+  for (size_t i = 0; i < count && used < sizeof(ids) / sizeof(ids[0]); ++i) {
+    if (thread_ids[i] != 0) {
+      ids[used++] = thread_ids[i];
+    }
+  }
+  if (used == 0) {
+    return false;
+  }
+  session_ = hint.create_session(hint.manager, ids, used, target_ns);
+  if (session_) {
+    target_ns_ = target_ns;
+  }
+  return session_ != nullptr;
+#else
+  (void)thread_ids;
+  (void)count;
+  (void)target_ns;
+  return false;
+#endif
+}
+
+void CBPerformanceHintSession::close() noexcept {
+  if (!session_) {
+    return;
+  }
+#if defined(__ANDROID__)
+  hint_entry_points().close_session(session_);
+#endif
+  session_ = nullptr;
+  target_ns_ = 0;
+}
+
+void CBPerformanceHintSession::update_target(int64_t target_ns) noexcept {
+  if (!session_ || target_ns <= 0 || target_ns == target_ns_) {
+    return;
+  }
+#if defined(__ANDROID__)
+  if (hint_entry_points().update_target(session_, target_ns) == 0) {
+    target_ns_ = target_ns;
+  }
+#endif
+}
+
+void CBPerformanceHintSession::report_actual(int64_t actual_ns) noexcept {
+  if (!session_ || actual_ns <= 0) {
+    return;
+  }
+#if defined(__ANDROID__)
+  (void)hint_entry_points().report_actual(session_, actual_ns);
+#endif
+}
+
+int32_t current_os_thread_id() noexcept {
+#if defined(__ANDROID__)
+  return static_cast<int32_t>(gettid());
+#else
+  return 0;
+#endif
+}
+
+} // namespace cambang
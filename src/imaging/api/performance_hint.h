@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace cambang {
+
+// Work-duration hint session (Android ADPF, APerformanceHintManager).
+//
+// A session names the threads that together do one periodic piece of work
+// and the duration each cycle should take. Reporting the actual duration of
+// every cycle lets the governor keep just enough clock headroom for that
+// target instead of ramping down mid-stream and ramping up only after the
+// work has already fallen behind; no frequency is pinned.
+//
+// The entry points are resolved from libandroid at run time (API 33+), so
+// older Android releases and every other platform get a session that never
+// opens and ignores reports.
+//
+// Threading: not thread-safe; one owner serializes every call on a session.
+// current_os_thread_id() may be called from any thread.
+class CBPerformanceHintSession final {
+public:
+  CBPerformanceHintSession() = default;
+  ~CBPerformanceHintSession() { close(); }
+
+  CBPerformanceHintSession(const CBPerformanceHintSession&) = delete;
+  CBPerformanceHintSession& operator=(const CBPerformanceHintSession&) = delete;
+
+  // Opens a session over thread_ids (zero ids are skipped; at most 16 are
+  // used), closing any previous one. False when the platform has no hint
+  // support, no id is usable, target_ns is not positive, or the system
+  // refuses the session.
+  bool open(const int32_t* thread_ids, size_t count, int64_t target_ns) noexcept;
+  void close() noexcept;
+  bool active() const noexcept { return session_ != nullptr; }
+
+  int64_t target_ns() const noexcept { return target_ns_; }
+  // No-op while closed or when target_ns is unchanged or not positive.
+  void update_target(int64_t target_ns) noexcept;
+  // Duration one cycle actually took. Ignored while closed.
+  void report_actual(int64_t actual_ns) noexcept;
+
+private:
+  void* session_ = nullptr;
+  int64_t target_ns_ = 0;
+};
+
+// Kernel thread id of the calling thread where hint sessions exist, else 0.
+int32_t current_os_thread_id() noexcept;
+
+} // namespace cambang
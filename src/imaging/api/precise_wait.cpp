@@ -0,0 +1,105 @@
+#include "imaging/api/precise_wait.h"
+
+#include <chrono>
+#include <thread>
+
+#if defined(_WIN32)
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+// Older SDKs lack the flag; the running OS decides whether it is honoured.
+#ifndef CREATE_WAITABLE_TIMER_HIGH_RESOLUTION
+#define CREATE_WAITABLE_TIMER_HIGH_RESOLUTION 0x00000002
+#endif
+#elif defined(__linux__) || defined(__ANDROID__)
+#include <sys/timerfd.h>
+#include <time.h>
+#include <unistd.h>
+#endif
+
+namespace cambang {
+
+uint64_t precise_wait_now_ns() noexcept {
+  return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+CBPreciseWaiter::CBPreciseWaiter(uint64_t spin_ns) noexcept : spin_ns_(spin_ns) {
+#if defined(_WIN32)
+  // Refused before Windows 10 1803; the fallback sleep covers that.
+  HANDLE timer = CreateWaitableTimerExW(nullptr, nullptr,
+                                        CREATE_WAITABLE_TIMER_HIGH_RESOLUTION,
+                                        TIMER_ALL_ACCESS);
+  if (timer) {
+    timer_ = reinterpret_cast<intptr_t>(timer);
+  }
+#elif defined(__linux__) || defined(__ANDROID__)
+  // steady_clock is CLOCK_MONOTONIC here, so deadlines arm the timer as-is.
+  const int fd = timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC);
+  if (fd >= 0) {
+    timer_ = fd;
+  }
+#endif
+}
+
+CBPreciseWaiter::~CBPreciseWaiter() {
+  if (timer_ == -1) {
+    return;
+  }
+#if defined(_WIN32)
+  CloseHandle(reinterpret_cast<HANDLE>(timer_));
+#elif defined(__linux__) || defined(__ANDROID__)
+  close(static_cast<int>(timer_));
+#endif
+}
+
+void CBPreciseWaiter::wait_until(uint64_t deadline_ns) noexcept {
+  if (deadline_ns > spin_ns_) {
+    sleep_until_(deadline_ns - spin_ns_);
+  }
+  while (precise_wait_now_ns() < deadline_ns) {
+    std::this_thread::yield();
+  }
+}
+
+void CBPreciseWaiter::sleep_until_(uint64_t deadline_ns) noexcept {
+  const uint64_t now_ns = precise_wait_now_ns();
+  if (deadline_ns <= now_ns) {
+    return;
+  }
+#if defined(_WIN32)
+  if (timer_ != -1) {
+    // Negative due time is relative, in 100ns units.
+    LARGE_INTEGER due{};
+    due.QuadPart = -static_cast<LONGLONG>((deadline_ns - now_ns) / 100);
+    HANDLE timer = reinterpret_cast<HANDLE>(timer_);
+    if (SetWaitableTimerEx(timer, &due, 0, nullptr, nullptr, nullptr, 0) &&
+        WaitForSingleObject(timer, INFINITE) == WAIT_OBJECT_0) {
+      return;
+    }
+  }
+#elif defined(__linux__) || defined(__ANDROID__)
+  if (timer_ != -1) {
+    itimerspec spec{};
+    spec.it_value.tv_sec = static_cast<time_t>(deadline_ns / 1'000'000'000ull);
+    spec.it_value.tv_nsec = static_cast<long>(deadline_ns % 1'000'000'000ull);
+    const int fd = static_cast<int>(timer_);
+    if (timerfd_settime(fd, TFD_TIMER_ABSTIME, &spec, nullptr) == 0) {
+      uint64_t expirations = 0;
+      if (read(fd, &expirations, sizeof(expirations)) ==
+          static_cast<ssize_t>(sizeof(expirations))) {
+        return;
+      }
+    }
+  }
+#endif
+  std::this_thread::sleep_until(std::chrono::steady_clock::time_point(
+      std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+          std::chrono::nanoseconds(deadline_ns))));
+}
+
+} // namespace cambang
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstdint>
+
+namespace cambang {
+
+// Waits until a std::chrono::steady_clock deadline with sub-millisecond
+// accuracy.
+//
+// A plain sleep wakes on the OS tick (about 1ms on Linux, up to 15.6ms on a
+// default Windows timer), so a loop that sleeps to each deadline lands in
+// tick-quantized bursts. The waiter sleeps on a high-resolution kernel timer
+// (timerfd on Linux/Android, a CREATE_WAITABLE_TIMER_HIGH_RESOLUTION waitable
+// timer on Windows 10 1803+) until spin_ns before the deadline and spins the
+// rest. Platforms or kernels without such a timer fall back to
+// std::this_thread::sleep_until for the coarse part; the spin still lands the
+// deadline, at the cost of a longer spin after a late wake.
+//
+// Threading: not thread-safe; one owner thread makes every call.
+class CBPreciseWaiter final {
+public:
+  // Final stretch spun rather than slept by default.
+  static constexpr uint64_t kDefaultSpinNs = 200'000;
+
+  explicit CBPreciseWaiter(uint64_t spin_ns = kDefaultSpinNs) noexcept;
+  ~CBPreciseWaiter();
+
+  CBPreciseWaiter(const CBPreciseWaiter&) = delete;
+  CBPreciseWaiter& operator=(const CBPreciseWaiter&) = delete;
+
+  // Returns once steady_clock reaches deadline_ns (time_since_epoch, in ns);
+  // immediately when it already has.
+  void wait_until(uint64_t deadline_ns) noexcept;
+
+  // True when a high-resolution kernel timer backs the coarse wait.
+  bool high_resolution() const noexcept { return timer_ != -1; }
+
+private:
+  void sleep_until_(uint64_t deadline_ns) noexcept;
+
+  uint64_t spin_ns_ = kDefaultSpinNs;
+  // timerfd, or a Windows timer HANDLE's value; -1 when unavailable.
+  intptr_t timer_ = -1;
+};
+
+// std::chrono::steady_clock::now() in ns since its epoch.
+uint64_t precise_wait_now_ns() noexcept;
+
+} // namespace cambang
@@ -0,0 +1,56 @@
+#pragma once
+
+// Compile-time provider binding.
+//
+// A default build keeps the provider seam runtime-polymorphic: ProviderBroker
+// selects SyntheticProvider, ReplayProvider or the platform provider at
+// start(), and every provider reports to Core through IProviderCallbacks.
+//
+// A build bound to one provider (SCons provider=android_camera2_only defines
+// CAMBANG_PROVIDER_BOUND_ANDROID_CAMERA2) compiles only that provider and no
+// synthetic or replay provider, so the only IProviderCallbacks a provider
+// is ever handed is Core's ProviderCallbackIngress. The per-frame path
+// therefore names concrete final types instead of interfaces:
+// - CBProviderStrand delivers into ProviderCallbackIngress, and the
+//   provider's own per-frame queries (is_stream_ingress_congested,
+//   acquire_cpu_payload_buffer, core_monotonic_now_ns) go to it too, as
+//   direct calls rather than virtual dispatch;
+// - ProviderCallbackIngress hands commands, timestamps and display-demand
+//   queries to CoreRuntime directly rather than through std::function.
+//
+// Core -> provider control calls still go through ProviderBroker, which
+// serializes them and drains them at shutdown; they are per-command, not
+// per-frame.
+//
+// CAMBANG_PROVIDER_BOUND may also be set directly (host maintainer tools
+// build core_spine_smoke that way to exercise the bound ingress path with
+// StubProvider).
+
+#if defined(CAMBANG_PROVIDER_BOUND_ANDROID_CAMERA2) && CAMBANG_PROVIDER_BOUND_ANDROID_CAMERA2
+  #undef CAMBANG_PROVIDER_BOUND
+  #define CAMBANG_PROVIDER_BOUND 1
+#endif
+#if !defined(CAMBANG_PROVIDER_BOUND)
+  #define CAMBANG_PROVIDER_BOUND 0
+#endif
+
+namespace cambang {
+
+class IProviderCallbacks;
+
+#if CAMBANG_PROVIDER_BOUND
+class ProviderCallbackIngress;
+// The callbacks every provider reports to in this build.
+using ProviderBoundCallbacks = ProviderCallbackIngress;
+// Narrows the callbacks a provider's initialize() receives to Core's
+// ingress. Only Core calls initialize() in a bound build, always with its
+// own ingress.
+ProviderBoundCallbacks* bind_provider_callbacks(IProviderCallbacks* callbacks) noexcept;
+#else
+using ProviderBoundCallbacks = IProviderCallbacks;
+inline ProviderBoundCallbacks* bind_provider_callbacks(IProviderCallbacks* callbacks) noexcept {
+  return callbacks;
+}
+#endif
+
+} // namespace cambang
@@ -9,6 +9,7 @@
 
 #include "core/capture_admission_context.h"
 #include "core/camera_fact_types.h"
+#include "imaging/api/cpu_payload_bytes.h"
 
 // Pattern preset vocabulary is provider-agnostic and lives in the Pattern Module.
 // It is safe to depend on here (no platform headers).
@@ -32,12 +33,70 @@ constexpr uint32_t make_fourcc(char a, char b, char c, char d) {
 inline constexpr uint32_t FOURCC_RGBA = make_fourcc('R', 'G', 'B', 'A');
 inline constexpr uint32_t FOURCC_BGRA = make_fourcc('B', 'G', 'R', 'A');
 
+// 8-bit 4:2:0 YUV formats (BT.601 limited range) carried without RGBA
+// conversion. Plane order follows the FourCC: NV12/NV21 are Y + interleaved
+// chroma, I420 is Y + U + V.
+inline constexpr uint32_t FOURCC_NV12 = make_fourcc('N', 'V', '1', '2');
+inline constexpr uint32_t FOURCC_NV21 = make_fourcc('N', 'V', '2', '1');
+inline constexpr uint32_t FOURCC_I420 = make_fourcc('I', '4', '2', '0');
+
+inline constexpr uint32_t kMaxFramePlanes = 3;
+
+constexpr bool is_planar_yuv420_fourcc(uint32_t fourcc) {
+  return fourcc == FOURCC_NV12 || fourcc == FOURCC_NV21 || fourcc == FOURCC_I420;
+}
+
+constexpr uint32_t planar_yuv420_plane_count(uint32_t fourcc) {
+  return fourcc == FOURCC_I420 ? 3u : (is_planar_yuv420_fourcc(fourcc) ? 2u : 0u);
+}
+
+// Undemosaiced Bayer sensor readout, carried as one opaque packed plane and
+// never converted. RAW16 is one little-endian 16-bit sample per pixel
+// (Android RAW_SENSOR); RAW10 is MIPI CSI-2 packing, four 10-bit samples in
+// five bytes, so its width must be a multiple of 4. The colour filter
+// arrangement and black/white levels needed to read the samples are camera
+// facts, not part of the format.
+inline constexpr uint32_t FOURCC_RAW16 = make_fourcc('R', 'W', '1', '6');
+inline constexpr uint32_t FOURCC_RAW10 = make_fourcc('R', 'W', '1', '0');
+
+constexpr bool is_raw_bayer_fourcc(uint32_t fourcc) {
+  return fourcc == FOURCC_RAW16 || fourcc == FOURCC_RAW10;
+}
+
+// Bytes in one tightly packed row of a RAW format, or 0 when fourcc is not a
+// RAW format or width cannot be represented in it.
+constexpr uint32_t raw_bayer_row_bytes(uint32_t fourcc, uint32_t width) {
+  if (width == 0) {
+    return 0;
+  }
+  if (fourcc == FOURCC_RAW16) {
+    return width <= 0x7FFFFFFFu ? width * 2u : 0u;
+  }
+  if (fourcc == FOURCC_RAW10) {
+    return (width % 4u) == 0 && width <= 0x7FFFFFFFu ? (width / 4u) * 5u : 0u;
+  }
+  return 0;
+}
+
 // Public semantics for repeating streams.
 enum class StreamIntent : uint8_t {
   PREVIEW = 0,
   VIEWFINDER = 1,
 };
 
+// Drop class of a repeating stream under frame pressure, chosen at stream
+// creation. When the provider strand or Core's ingress runs short, LOW
+// streams shed frames first and HIGH streams last; on the core thread a
+// HIGH stream's queued frame is integrated ahead of lower classes' frames.
+// Still-capture frames are never dropped and are not classed.
+enum class StreamPriority : uint8_t {
+  LOW = 0,
+  NORMAL = 1,
+  HIGH = 2,
+};
+
+inline constexpr size_t kStreamPriorityCount = 3;
+
 // Scoped, stable error categories for provider results and failure signals.
 // Keep categories stable across versions; mapping to text lives elsewhere.
 enum class ProviderError : uint32_t {
@@ -77,6 +136,10 @@ enum class CoreProductionPostureShape : uint8_t {
 struct CoreRetainedProductionPlan {
   CoreProductionPostureShape posture = CoreProductionPostureShape::CpuPrimary;
   bool valid = false;
+  // Integer downscale of the CPU sidecar of a GpuPrimaryWithCpuSidecar plan
+  // (1 = full resolution). Core stamps it from the stream's Capture Profile;
+  // a provider that cannot reduce the sidecar publishes it full size.
+  uint8_t cpu_sidecar_downscale = 1;
 
   constexpr bool primary_cpu() const noexcept { return posture == CoreProductionPostureShape::CpuPrimary; }
   constexpr bool primary_gpu() const noexcept { return posture != CoreProductionPostureShape::CpuPrimary; }
@@ -85,6 +148,9 @@ struct CoreRetainedProductionPlan {
            posture == CoreProductionPostureShape::GpuPrimaryWithCpuSidecar;
   }
   constexpr bool retain_gpu_display() const noexcept { return primary_gpu(); }
+  constexpr bool reduced_cpu_sidecar() const noexcept {
+    return posture == CoreProductionPostureShape::GpuPrimaryWithCpuSidecar && cpu_sidecar_downscale > 1u;
+  }
 };
 
 struct ProducerBackingCapabilities {
@@ -115,6 +181,33 @@ struct ProviderResult {
   static constexpr ProviderResult failure(ProviderError c) { return ProviderResult{c}; }
 };
 
+// Memory-pressure trim depth (CoreRuntime::trim_memory()). Moderate releases
+// memory kept only for reuse and shrinks caches to a small working floor;
+// Critical empties them and lowers retained capture memory to what callers
+// still hold.
+enum class MemoryTrimLevel : uint8_t {
+  Moderate = 0,
+  Critical = 1,
+};
+
+// How many of one stream's frames Core may hold at once
+// (ICameraProvider::set_stream_pool_depth_hint()).
+struct StreamPoolDepthHint {
+  // Frames Core may hold before calling FrameView::release: its share of
+  // the ingress queue, latest-wins parking, a frame-shard queue and the
+  // frame being dispatched.
+  uint32_t in_flight_frames = 0;
+  // Stream results Core may keep after release: the latest result plus any
+  // history ring, jitter buffer and recorder queue. A retained result keeps
+  // its cpu_payload_owner alive, not the provider's frame token.
+  uint32_t retained_frames = 0;
+
+  bool operator==(const StreamPoolDepthHint& o) const noexcept {
+    return in_flight_frames == o.in_flight_frames && retained_frames == o.retained_frames;
+  }
+  bool operator!=(const StreamPoolDepthHint& o) const noexcept { return !(*this == o); }
+};
+
 
 // Native object type vocabulary (core-owned).
 //
@@ -150,8 +243,28 @@ struct CaptureProfile {
   uint32_t format_fourcc = 0;   // canonical CamBANG FourCC-style format
   uint32_t target_fps_min = 0;  // 0 if unspecified
   uint32_t target_fps_max = 0;  // 0 if unspecified
+  // Requested integer downscale of a GPU-primary stream's CPU sidecar, for
+  // consumers that only analyse a small CPU image while the display uses the
+  // full-resolution backing. 0 or 1 keeps the sidecar at full resolution.
+  uint32_t cpu_sidecar_downscale = 0;
 };
 
+constexpr uint32_t kMaxCpuSidecarDownscale = 16;
+
+// The plan a stream's provider is asked to run: the sidecar posture carries
+// the profile's sidecar downscale, every other posture stays at 1.
+constexpr CoreRetainedProductionPlan stream_retained_plan_for_profile(
+    CoreRetainedProductionPlan plan, const CaptureProfile& profile) noexcept {
+  plan.cpu_sidecar_downscale = 1;
+  if (plan.posture == CoreProductionPostureShape::GpuPrimaryWithCpuSidecar &&
+      profile.cpu_sidecar_downscale > 1u) {
+    plan.cpu_sidecar_downscale = static_cast<uint8_t>(
+        profile.cpu_sidecar_downscale < kMaxCpuSidecarDownscale ? profile.cpu_sidecar_downscale
+                                                                : kMaxCpuSidecarDownscale);
+  }
+  return plan;
+}
+
 struct PictureConfig {
   // Pattern selection (synthetic/stub). Platform-backed providers may interpret
   // this as picture adjustment parameters subject to capability.
@@ -299,6 +412,7 @@ struct StreamRequest {
 
   uint64_t profile_version = 0;      // core bookkeeping
   CoreRetainedProductionPlan requested_retained_plan{}; // core-selected internal production posture
+  StreamPriority priority = StreamPriority::NORMAL;     // core-owned drop class
 };
 
 enum class CaptureSubmissionOrigin : uint8_t {
@@ -319,8 +433,10 @@ struct CaptureRequest {
   uint32_t height = 0;
   // Materialized provider-agnostic still-result format FourCC. Current
   // implemented displayable still paths use packed pixel formats such as
-  // FOURCC_RGBA / FOURCC_BGRA; encoded or RAW representations require matching
-  // payload-kind/result support and are not enabled by this field alone.
+  // FOURCC_RGBA / FOURCC_BGRA. RAW formats (is_raw_bayer_fourcc()) are
+  // retained as opaque packed payloads, not displayable images; encoded
+  // representations require matching payload-kind/result support and are not
+  // enabled by this field alone.
   uint32_t format_fourcc = 0;
   PictureConfig picture{};
   CaptureStillImageBundle still_image_bundle{};
@@ -370,6 +486,15 @@ struct NativeObjectDestroyInfo {
   uint64_t destroyed_ns = 0;              // provider value (0 is valid when has_destroyed_ns=true)
 };
 
+// New resource counters for a live native object (a pool that grew or
+// shrank). Replaces the values from NativeObjectCreateInfo or an earlier
+// update; only the latest one per object before Core integrates them counts.
+struct NativeObjectCountersUpdate {
+  uint64_t native_id = 0;                 // core-issued
+  uint64_t bytes_allocated = 0;           // 0 if n/a
+  uint32_t buffers_in_use = 0;            // 0 if n/a
+};
+
 // Internal still-capture image routing marker (provider -> core).
 //
 // Default-initialized and legacy-populated frames remain DEFAULT_METERED.
@@ -410,13 +535,25 @@ struct RetainedGpuBackingDescriptor {
 // Frame view delivered from provider.
 // Provider retains buffer ownership until core calls release().
 // release() must be safe and non-blocking; it is called from core thread context.
+// One plane of a planar/semi-planar CPU frame. Pointers stay valid under the
+// same lifetime rule as FrameView::data.
+struct FramePlaneView {
+  const uint8_t* data = nullptr;
+  size_t size_bytes = 0;
+  uint32_t row_stride_bytes = 0;
+};
+
+// Field order is a hot/cold layout. The header (correlation, geometry,
+// buffer, trace id, release hook, retention intent and CPU owner) fits the
+// first two cache lines and is all a repeating stream frame's ingress,
+// dispatch and release touch; capture, timing, GPU and planar metadata
+// follow in the tail.
 struct FrameView {
   // Correlation
   uint64_t device_instance_id = 0;
   uint64_t stream_id = 0;    // 0 if this frame belongs only to a still capture
   uint64_t acquisition_session_id = 0; // 0 if unavailable/unknown
   uint64_t capture_id = 0;   // 0 if this is a repeating stream frame
-  CaptureImageFrameMetadata capture_image{};
 
   // Image metadata
   uint32_t width = 0;
@@ -424,38 +561,21 @@ struct FrameView {
   uint32_t format_fourcc = 0;
   ProducerBackingKind primary_backing_kind = ProducerBackingKind::CPU;
 
-  // Optional provider-authored timing for this exact acquired frame. A present
-  // zero-valued acquisition mark is valid and remains distinct from absence.
-  std::optional<SourcedFact<ImageAcquisitionTiming>> acquisition_timing{};
-
   // Buffer
   const uint8_t* data = nullptr;
   size_t size_bytes = 0;
-  // Internal provider->Core retention intent for CPU bytes. This distinguishes
-  // CPU bytes deliberately published for primary/sidecar retention from
-  // provider-local staging/upload details. CPU-primary frames with CPU payload
-  // are still retained as primary by Core; GPU-primary frames retain CPU sidecar
-  // data only when this remains true.
-  bool retain_cpu_sidecar = true;
-  // Optional immutable owner for tightly packed CPU payload bytes. Providers may
-  // set this only when the pointed-to vector exactly backs data/size_bytes and
-  // will not be mutated after posting. Core may then retain/adopt the shared
-  // payload instead of copying it. release_now() still releases provider-side
-  // frame bookkeeping; this shared owner is the retained-result byte lifetime.
-  std::shared_ptr<const std::vector<uint8_t>> cpu_payload_owner{};
-  // Optional opaque primary artifact for non-CPU-backed frames.
-  // For ProducerBackingKind::GPU this carries the authoritative provider->core
-  // primary backing when available.
-  std::shared_ptr<void> primary_backing_artifact{};
-  // Neutral metadata for the primary GPU backing above. This tranche keeps the
-  // legacy primary_backing_artifact path authoritative for behavior; the
-  // descriptor is passive scaffolding for later resource-ownership isolation.
-  RetainedGpuBackingDescriptor retained_gpu_backing_descriptor{};
-  // Echo of the Core-requested internal retention posture that produced this frame.
-  CoreRetainedProductionPlan requested_retained_plan{};
 
   // Optional per-row stride (0 if tightly packed/unknown)
   uint32_t stride_bytes = 0;
+  // Planar YUV layout (see is_planar_yuv420_fourcc()). When plane_count is
+  // non-zero, planes[] describe the frame in FourCC plane order and
+  // data/size_bytes/stride_bytes mirror planes[0]. Planes may live in
+  // separate allocations; Core packs them into one retained payload.
+  uint32_t plane_count = 0;
+
+  // Frame latency trace id (see imaging/api/frame_latency_trace.h). 0 means
+  // untraced; CBProviderStrand assigns one to stream frames posted without.
+  uint64_t trace_id = 0;
 
   // Release hook.
   //
@@ -475,10 +595,52 @@ struct FrameView {
   // any particular thread/context affinity (e.g. a GPU context or buffer-pool
   // API that requires same-thread symmetry with acquisition is NOT safe to
   // drive directly from this callback without its own internal marshalling).
+  // The frame it is handed carries the posted metadata, but its shared
+  // owners (cpu_payload_owner, primary_backing_artifact) may already be
+  // empty: they are the retained byte lifetime, not release bookkeeping.
   using ReleaseFn = void (*)(void* user, const FrameView* frame);
   ReleaseFn release = nullptr;
   void* release_user = nullptr;
 
+  // Internal provider->Core retention intent for CPU bytes. This distinguishes
+  // CPU bytes deliberately published for primary/sidecar retention from
+  // provider-local staging/upload details. CPU-primary frames with CPU payload
+  // are still retained as primary by Core; GPU-primary frames retain CPU sidecar
+  // data only when this remains true.
+  bool retain_cpu_sidecar = true;
+  // Dimensions of a reduced CPU sidecar on a GPU-primary frame (see
+  // CoreRetainedProductionPlan::cpu_sidecar_downscale). When non-zero,
+  // data/size_bytes/stride_bytes describe the sidecar image at this size while
+  // width/height stay the primary backing's. 0 means the sidecar is full size.
+  uint32_t cpu_sidecar_width = 0;
+  uint32_t cpu_sidecar_height = 0;
+  // Echo of the Core-requested internal retention posture that produced this frame.
+  CoreRetainedProductionPlan requested_retained_plan{};
+  // Optional immutable owner for tightly packed CPU payload bytes. Providers may
+  // set this only when the pointed-to vector exactly backs data/size_bytes and
+  // will not be mutated after posting. Core may then retain/adopt the shared
+  // payload instead of copying it. release_now() still releases provider-side
+  // frame bookkeeping; this shared owner is the retained-result byte lifetime.
+  std::shared_ptr<const CpuPayloadBytes> cpu_payload_owner{};
+
+  // Optional provider-authored timing for this exact acquired frame. A present
+  // zero-valued acquisition mark is valid and remains distinct from absence.
+  std::optional<SourcedFact<ImageAcquisitionTiming>> acquisition_timing{};
+
+  CaptureImageFrameMetadata capture_image{};
+
+  // Optional opaque primary artifact for non-CPU-backed frames.
+  // For ProducerBackingKind::GPU this carries the authoritative provider->core
+  // primary backing when available.
+  std::shared_ptr<void> primary_backing_artifact{};
+  // Neutral metadata for the primary GPU backing above. This tranche keeps the
+  // legacy primary_backing_artifact path authoritative for behavior; the
+  // descriptor is passive scaffolding for later resource-ownership isolation.
+  RetainedGpuBackingDescriptor retained_gpu_backing_descriptor{};
+
+  // See plane_count.
+  FramePlaneView planes[kMaxFramePlanes]{};
+
   void release_now() const {
     if (release) {
       release(release_user, this);
@@ -486,4 +648,7 @@ struct FrameView {
   }
 };
 
+static_assert(offsetof(FrameView, cpu_payload_owner) + sizeof(FrameView::cpu_payload_owner) <= 128,
+              "FrameView's hot header must stay within two cache lines");
+
 } // namespace cambang
@@ -1,10 +1,41 @@
 #include "imaging/api/provider_strand.h"
 
+#include "imaging/api/async_log.h"
+#include "imaging/api/frame_latency_trace.h"
+#include "imaging/api/performance_hint.h"
+#include "imaging/api/thread_policy.h"
+
+#include <algorithm>
 #include <cassert>
 #include <cstdio>
 #include <exception>
+#include <utility>
+
+#if CAMBANG_PROVIDER_BOUND
+  #include "core/provider_callback_ingress.h"
+#endif
+
 namespace cambang {
 
+namespace {
+
+// Delivery invokes arbitrary IProviderCallbacks methods. An uncaught
+// exception escaping the worker's entry function is UB and terminates the
+// whole process, and one escaping an inline post would unwind through the
+// provider, so it must not propagate past this point.
+template <typename Fn>
+void deliver_guarded(Fn&& fn) noexcept {
+  try {
+    fn();
+  } catch (const std::exception& e) {
+    async_log_printf(stderr, "[CamBANG][CBProviderStrand] uncaught exception in deliver_: %s\n", e.what());
+  } catch (...) {
+    async_log_printf(stderr, "[CamBANG][CBProviderStrand] uncaught non-standard exception in deliver_\n");
+  }
+}
+
+} // namespace
+
 CBProviderStrand::~CBProviderStrand() { stop(); }
 
 bool CBProviderStrand::start(
@@ -14,19 +45,32 @@ bool CBProviderStrand::start(
   if (!callbacks || running()) {
     return false;
   }
-  callbacks_ = callbacks;
+  const size_t ring_slots = std::min(capacity > 0 ? capacity : kMaxFrameRingSlots, kMaxFrameRingSlots);
+  if (!ring_ || ring_slots_ != ring_slots) {
+    ring_ = std::make_unique<FrameSlot[]>(ring_slots);
+    ring_slots_ = ring_slots;
+  }
+  for (size_t i = 0; i < ring_slots_; ++i) {
+    ring_[i].turn.store(i, std::memory_order_relaxed);
+  }
+  ring_tail_.store(0, std::memory_order_relaxed);
+  ring_head_ = 0;
+  ring_head_shared_.store(0, std::memory_order_relaxed);
+  worker_waiting_.store(false, std::memory_order_relaxed);
+  inline_ = false;
+  callbacks_ = bind_provider_callbacks(callbacks);
   debug_name_ = debug_name;
   capacity_ = capacity;
   {
     std::lock_guard<std::mutex> lk(mu_);
-    closed_ = false;
+    closed_.store(false, std::memory_order_release);
   }
   stop_requested_.store(false, std::memory_order_release);
   try {
     worker_ = std::thread([this]() { thread_main_(); });
   } catch (...) {
     std::lock_guard<std::mutex> lk(mu_);
-    closed_ = true;
+    closed_.store(true, std::memory_order_release);
     callbacks_ = nullptr;
     debug_name_ = nullptr;
     capacity_ = 0;
@@ -42,11 +86,40 @@ bool CBProviderStrand::start(
   return false;
 }
 
+bool CBProviderStrand::start_inline(IProviderCallbacks* callbacks, const char* debug_name) noexcept {
+  if (!callbacks || running()) {
+    return false;
+  }
+  inline_ = true;
+  callbacks_ = bind_provider_callbacks(callbacks);
+  debug_name_ = debug_name;
+  capacity_ = 0;
+  {
+    std::lock_guard<std::mutex> lk(mu_);
+    closed_.store(false, std::memory_order_release);
+  }
+  stop_requested_.store(false, std::memory_order_release);
+  running_.store(true, std::memory_order_release);
+  return true;
+}
+
 void CBProviderStrand::stop() {
   if (!running()) {
     return;
   }
 
+  if (inline_) {
+    // Nothing is queued; closing under mu_ waits out a delivery in progress
+    // and refuses every later post.
+    {
+      std::lock_guard<std::mutex> lk(mu_);
+      closed_.store(true, std::memory_order_release);
+    }
+    callbacks_ = nullptr;
+    running_.store(false, std::memory_order_release);
+    return;
+  }
+
   stop_requested_.store(true, std::memory_order_release);
   {
     std::lock_guard<std::mutex> lk(mu_);
@@ -56,6 +129,7 @@ void CBProviderStrand::stop() {
   if (worker_.joinable()) {
     worker_.join();
   }
+  worker_os_thread_id_.store(0, std::memory_order_release);
 
   // Close admission and drain atomically under mu_. Setting closed_ here,
   // in the same critical section as the drain, closes the race where post()
@@ -65,14 +139,27 @@ void CBProviderStrand::stop() {
   // thread has already exited above) and never accounted as dropped either.
   // post() re-checks closed_ under this same mutex before pushing, so the two
   // critical sections cannot interleave: any post() call is fully ordered
-  // before or after this one.
+  // before or after this one. Frame posts do not take mu_; each is counted in
+  // frame_posters_ before it checks closed_, so once the count drains to
+  // zero every frame is either dropped by its poster or published in the
+  // ring.
+  {
+    std::lock_guard<std::mutex> lk(mu_);
+    closed_.store(true, std::memory_order_seq_cst);
+  }
+  while (frame_posters_.load(std::memory_order_seq_cst) != 0) {
+    std::this_thread::yield();
+  }
   {
     std::lock_guard<std::mutex> lk(mu_);
-    closed_ = true;
-    for (auto& ev : q_) {
-      drop_(ev);
+    for (auto& entry : control_) {
+      drop_(entry.ev);
+    }
+    control_.clear();
+    FrameView frame;
+    while (ring_pop_(frame)) {
+      frame.release_now();
     }
-    q_.clear();
   }
 
   callbacks_ = nullptr;
@@ -83,6 +170,11 @@ void CBProviderStrand::flush() {
   if (!running()) {
     return;
   }
+  if (inline_) {
+    // Every post that returned has been delivered.
+    std::lock_guard<std::mutex> lk(mu_);
+    return;
+  }
   auto p = std::make_shared<std::promise<void>>();
   auto f = p->get_future();
   post(EvBarrier{p});
@@ -98,9 +190,13 @@ void CBProviderStrand::post(Event ev) {
     drop_(ev);
     return;
   }
+  if (inline_) {
+    deliver_inline_(ev);
+    return;
+  }
 
   std::unique_lock<std::mutex> lk(mu_);
-  if (closed_) {
+  if (closed_.load(std::memory_order_relaxed)) {
     // Authoritative check: stop()'s drain has already run (or is running) in
     // the same critical section that sets closed_. Dropping here rather than
     // pushing keeps admission-close deterministic relative to drain.
@@ -108,54 +204,161 @@ void CBProviderStrand::post(Event ev) {
     drop_(ev);
     return;
   }
-  const EventClass cls = classify_(ev);
-  if (capacity_ > 0 && q_.size() >= capacity_) {
-    if (cls == EventClass::Frame) {
-      // Deterministic backpressure: repeating stream frames are droppable.
+  // Non-lossy classes must not be silently dropped once admitted
+  // (docs/architecture/provider_strand_model.md: lifecycle/native-object/
+  // error events "must never be dropped"). Repeating frames live in the ring,
+  // so there is nothing here to reclaim; admission proceeds past capacity_
+  // rather than violating the non-lossy contract.
+  if (capacity_ > 0 && control_.size() >= capacity_ && classify_(ev) != EventClass::Frame) {
+    // Diagnosable record of sustained non-lossy pressure exceeding
+    // capacity_; this is the only visibility gap in otherwise-correct
+    // non-lossy admission.
+    non_lossy_over_capacity_count_.fetch_add(1, std::memory_order_relaxed);
+  }
+  // Read under mu_ so keys stay monotonic along the lane.
+  control_.push_back(ControlEntry{ring_tail_.load(std::memory_order_seq_cst), std::move(ev)});
+  lk.unlock();
+  cv_.notify_one();
+}
+
+void CBProviderStrand::post_stream_frame_(FrameView frame) {
+  if (!running() || stop_requested_.load(std::memory_order_acquire)) {
+    frame.release_now();
+    return;
+  }
+  if (inline_) {
+    deliver_frame_inline_(frame);
+    return;
+  }
+
+  // Pairs with stop(): it sets closed_ and then waits for this count to
+  // drain, so a frame is either refused here or published before the drain.
+  frame_posters_.fetch_add(1, std::memory_order_seq_cst);
+  if (closed_.load(std::memory_order_seq_cst)) {
+    frame_posters_.fetch_sub(1, std::memory_order_seq_cst);
+    frame.release_now();
+    return;
+  }
+  // The class only matters once the ring is half full; below that every
+  // frame is admitted without asking.
+  StreamPriority priority = StreamPriority::NORMAL;
+  if (capacity_ > 0 &&
+      ring_fill_() * kLowFrameRingFillDenominator >= ring_slots_ * kLowFrameRingFillNumerator) {
+    priority = callbacks_->stream_priority(frame.stream_id);
+  }
+  const bool pushed = priority != StreamPriority::LOW && ring_push_(frame);
+  frame_posters_.fetch_sub(1, std::memory_order_seq_cst);
+  if (pushed) {
+    wake_worker_if_waiting_();
+    return;
+  }
+
+  if (capacity_ == 0) {
+    // Unbounded strand: the frame waits in the control lane, still ordered
+    // after every frame already in the ring.
+    post(std::make_unique<EvFrame>(EvFrame{std::move(frame)}));
+    return;
+  }
+  if (priority == StreamPriority::HIGH) {
+    // Ring full: a HIGH frame takes a bounded control-lane slot instead.
+    std::unique_lock<std::mutex> lk(mu_);
+    if (!closed_.load(std::memory_order_relaxed) && control_.size() < capacity_) {
+      control_.push_back(ControlEntry{ring_tail_.load(std::memory_order_seq_cst),
+                                      std::make_unique<EvFrame>(EvFrame{std::move(frame)})});
       lk.unlock();
-      drop_(ev);
+      cv_.notify_one();
       return;
     }
+  }
+  // Deterministic backpressure: repeating stream frames are droppable.
+  frames_dropped_by_priority_[static_cast<size_t>(priority)].fetch_add(1, std::memory_order_relaxed);
+  frame.release_now();
+}
+
+size_t CBProviderStrand::ring_fill_() const noexcept {
+  const uint64_t tail = ring_tail_.load(std::memory_order_relaxed);
+  const uint64_t head = ring_head_shared_.load(std::memory_order_relaxed);
+  return tail > head ? static_cast<size_t>(tail - head) : 0;
+}
 
-    // Non-lossy classes must not be silently dropped once admitted
-    // (docs/architecture/provider_strand_model.md: lifecycle/native-object/
-    // error events "must never be dropped"). Prefer reclaiming space from an
-    // already-queued frame; if none is available, admission proceeds past
-    // capacity_ rather than violating the non-lossy contract.
-    bool evicted_frame = false;
-    for (auto it = q_.begin(); it != q_.end(); ++it) {
-      if (classify_(*it) == EventClass::Frame) {
-        Event dropped = std::move(*it);
-        q_.erase(it);
-        lk.unlock();
-        drop_(dropped);
-        lk.lock();
-        evicted_frame = true;
-        break;
+void CBProviderStrand::deliver_inline_(Event& ev) {
+  std::lock_guard<std::mutex> lk(mu_);
+  if (closed_.load(std::memory_order_relaxed)) {
+    drop_(ev);
+    return;
+  }
+  deliver_guarded([&]() { deliver_(ev); });
+}
+
+void CBProviderStrand::deliver_frame_inline_(FrameView& frame) {
+  std::lock_guard<std::mutex> lk(mu_);
+  if (closed_.load(std::memory_order_relaxed)) {
+    frame.release_now();
+    return;
+  }
+  deliver_guarded([&]() { deliver_frame_(frame); });
+}
+
+bool CBProviderStrand::ring_push_(FrameView& frame) noexcept {
+  uint64_t pos = ring_tail_.load(std::memory_order_relaxed);
+  while (true) {
+    FrameSlot& slot = ring_[pos % ring_slots_];
+    const uint64_t turn = slot.turn.load(std::memory_order_acquire);
+    const int64_t diff = static_cast<int64_t>(turn - pos);
+    if (diff == 0) {
+      if (ring_tail_.compare_exchange_weak(
+              pos, pos + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+        slot.frame = std::move(frame);
+        slot.turn.store(pos + 1, std::memory_order_release);
+        return true;
       }
-    }
-    if (!evicted_frame) {
-      // Diagnosable record of sustained non-lossy pressure exceeding
-      // capacity_; this is the only visibility gap in otherwise-correct
-      // non-lossy admission.
-      non_lossy_over_capacity_count_.fetch_add(1, std::memory_order_relaxed);
+    } else if (diff < 0) {
+      // The slot still holds the frame from one lap ago: ring full.
+      return false;
+    } else {
+      pos = ring_tail_.load(std::memory_order_relaxed);
     }
   }
-  q_.push_back(std::move(ev));
-  lk.unlock();
-  cv_.notify_one();
+}
+
+bool CBProviderStrand::ring_pop_(FrameView& out) noexcept {
+  if (!ring_) {
+    return false;
+  }
+  FrameSlot& slot = ring_[ring_head_ % ring_slots_];
+  if (slot.turn.load(std::memory_order_acquire) != ring_head_ + 1) {
+    return false;
+  }
+  out = std::move(slot.frame);
+  slot.frame = FrameView{};
+  slot.turn.store(ring_head_ + ring_slots_, std::memory_order_release);
+  ++ring_head_;
+  ring_head_shared_.store(ring_head_, std::memory_order_relaxed);
+  return true;
+}
+
+void CBProviderStrand::wake_worker_if_waiting_() {
+  // The worker sets worker_waiting_ and then re-reads ring_tail_ under mu_
+  // before waiting; this load follows the producer's claim, so one of the
+  // two sees the other (both seq_cst), and notifying under mu_ cannot slip
+  // in before the wait.
+  if (worker_waiting_.load(std::memory_order_seq_cst)) {
+    std::lock_guard<std::mutex> lk(mu_);
+    cv_.notify_one();
+  }
 }
 
 CBProviderStrand::EventClass CBProviderStrand::classify_(const Event& ev) {
   return std::visit(
       [](const auto& e) -> EventClass {
         using T = std::decay_t<decltype(e)>;
-        if constexpr (std::is_same_v<T, EvFrame>) {
+        if constexpr (std::is_same_v<T, std::unique_ptr<EvFrame>>) {
           // Still-capture frames are exact capture facts and must stay ordered
           // with terminal capture lifecycle facts; only repeating stream frames
           // (capture_id == 0) are latest-state/droppable frame work.
-          return e.frame.capture_id != 0 ? EventClass::Lifecycle : EventClass::Frame;
-        } else if constexpr (std::is_same_v<T, EvNativeCreated> || std::is_same_v<T, EvNativeDestroyed>) {
+          return e->frame.capture_id != 0 ? EventClass::Lifecycle : EventClass::Frame;
+        } else if constexpr (std::is_same_v<T, EvNativeCreated> || std::is_same_v<T, EvNativeDestroyed> ||
+                             std::is_same_v<T, EvNativeCounters>) {
           return EventClass::NativeObject;
         } else if constexpr (std::is_same_v<T, EvDeviceError> || std::is_same_v<T, EvStreamError>) {
           return EventClass::Error;
@@ -167,35 +370,62 @@ CBProviderStrand::EventClass CBProviderStrand::classify_(const Event& ev) {
 }
 
 void CBProviderStrand::thread_main_() {
+  apply_current_thread_policy(CBThreadRole::ProviderCallbacks, debug_name_);
+  worker_os_thread_id_.store(current_os_thread_id(), std::memory_order_release);
   while (true) {
     Event ev;
+    FrameView frame;
+    bool have_frame = false;
     {
       std::unique_lock<std::mutex> lk(mu_);
-      cv_.wait(lk, [&]() {
-        return stop_requested_.load(std::memory_order_acquire) || !q_.empty();
-      });
-
-      if (stop_requested_.load(std::memory_order_acquire) && q_.empty()) {
-        break;
+      while (true) {
+        // A control event goes first once every frame claimed before it was
+        // posted has been delivered.
+        if (!control_.empty() && control_.front().frame_pos <= ring_head_) {
+          ev = std::move(control_.front().ev);
+          control_.pop_front();
+          break;
+        }
+        if (ring_pop_(frame)) {
+          have_frame = true;
+          break;
+        }
+        if (stop_requested_.load(std::memory_order_acquire)) {
+          return;
+        }
+        if (ring_tail_.load(std::memory_order_seq_cst) != ring_head_) {
+          // Claimed but not yet published; the producer is mid-copy.
+          lk.unlock();
+          std::this_thread::yield();
+          lk.lock();
+          continue;
+        }
+        worker_waiting_.store(true, std::memory_order_seq_cst);
+        if (ring_tail_.load(std::memory_order_seq_cst) == ring_head_) {
+          cv_.wait(lk);
+        }
+        worker_waiting_.store(false, std::memory_order_relaxed);
       }
-
-      ev = std::move(q_.front());
-      q_.pop_front();
     }
 
-    // deliver_() invokes arbitrary IProviderCallbacks virtual methods. An
-    // uncaught exception escaping this thread's entry function is UB and
-    // terminates the whole process, so it must not propagate past this point.
-    try {
-      deliver_(ev);
-    } catch (const std::exception& e) {
-      std::fprintf(stderr, "[CamBANG][CBProviderStrand] uncaught exception in deliver_: %s\n", e.what());
-    } catch (...) {
-      std::fprintf(stderr, "[CamBANG][CBProviderStrand] uncaught non-standard exception in deliver_\n");
-    }
+    deliver_guarded([&]() {
+      if (have_frame) {
+        deliver_frame_(frame);
+      } else {
+        deliver_(ev);
+      }
+    });
   }
 }
 
+void CBProviderStrand::deliver_frame_(FrameView& frame) {
+  if (!callbacks_) {
+    frame.release_now();
+    return;
+  }
+  callbacks_->on_frame(frame);
+}
+
 void CBProviderStrand::deliver_(Event& ev) {
   if (!callbacks_) {
     drop_(ev);
@@ -223,16 +453,16 @@ void CBProviderStrand::deliver_(Event& ev) {
           callbacks_->on_capture_completed(e.id, e.device_instance_id);
         } else if constexpr (std::is_same_v<T, EvCaptureFailed>) {
           callbacks_->on_capture_failed(e.id, e.device_instance_id, e.err);
-        } else if constexpr (std::is_same_v<T, EvCameraStaticFacts>) {
-          callbacks_->on_camera_static_facts(e.device_instance_id, std::move(e.facts));
-        } else if constexpr (std::is_same_v<T, EvCaptureImageFacts>) {
+        } else if constexpr (std::is_same_v<T, std::unique_ptr<EvCameraStaticFacts>>) {
+          callbacks_->on_camera_static_facts(e->device_instance_id, std::move(e->facts));
+        } else if constexpr (std::is_same_v<T, std::unique_ptr<EvCaptureImageFacts>>) {
           callbacks_->on_capture_image_facts(
-              e.capture_id,
-              e.device_instance_id,
-              e.image_member_index,
-              std::move(e.facts));
-        } else if constexpr (std::is_same_v<T, EvFrame>) {
-          callbacks_->on_frame(e.frame);
+              e->capture_id,
+              e->device_instance_id,
+              e->image_member_index,
+              std::move(e->facts));
+        } else if constexpr (std::is_same_v<T, std::unique_ptr<EvFrame>>) {
+          callbacks_->on_frame(e->frame);
         } else if constexpr (std::is_same_v<T, EvDeviceError>) {
           callbacks_->on_device_error(e.id, e.err);
         } else if constexpr (std::is_same_v<T, EvStreamError>) {
@@ -241,6 +471,8 @@ void CBProviderStrand::deliver_(Event& ev) {
           callbacks_->on_native_object_created(e.info);
         } else if constexpr (std::is_same_v<T, EvNativeDestroyed>) {
           callbacks_->on_native_object_destroyed(e.info);
+        } else if constexpr (std::is_same_v<T, EvNativeCounters>) {
+          callbacks_->on_native_object_counters(e.update);
         } else if constexpr (std::is_same_v<T, EvBarrier>) {
           e.done->set_value();
         } else {
@@ -255,8 +487,8 @@ void CBProviderStrand::drop_(Event& ev) {
   std::visit(
       [&](auto& e) {
         using T = std::decay_t<decltype(e)>;
-        if constexpr (std::is_same_v<T, EvFrame>) {
-          e.frame.release_now();
+        if constexpr (std::is_same_v<T, std::unique_ptr<EvFrame>>) {
+          e->frame.release_now();
         } else if constexpr (std::is_same_v<T, EvBarrier>) {
           // If we drop a barrier, wake the waiter.
           e.done->set_value();
@@ -291,7 +523,7 @@ void CBProviderStrand::post_capture_failed(uint64_t capture_id,
 
 void CBProviderStrand::post_camera_static_facts(
     uint64_t device_instance_id, ProviderCameraFacts facts) {
-  post(EvCameraStaticFacts{device_instance_id, std::move(facts)});
+  post(std::make_unique<EvCameraStaticFacts>(EvCameraStaticFacts{device_instance_id, std::move(facts)}));
 }
 
 void CBProviderStrand::post_capture_image_facts(
@@ -299,11 +531,22 @@ void CBProviderStrand::post_capture_image_facts(
     uint64_t device_instance_id,
     uint32_t image_member_index,
     ProviderCaptureImageFacts facts) {
-  post(EvCaptureImageFacts{
-      capture_id, device_instance_id, image_member_index, std::move(facts)});
+  post(std::make_unique<EvCaptureImageFacts>(EvCaptureImageFacts{
+      capture_id, device_instance_id, image_member_index, std::move(facts)}));
 }
 
-void CBProviderStrand::post_frame(const FrameView& frame) { post(EvFrame{frame}); }
+void CBProviderStrand::post_frame(const FrameView& frame) {
+  FrameView f = frame;
+  if (f.stream_id != 0 && f.capture_id == 0 && f.trace_id == 0) {
+    f.trace_id = frame_latency_trace_new_id();
+  }
+  frame_latency_trace_record(FrameLatencyHop::StrandPost, f.stream_id, f.trace_id);
+  if (f.capture_id != 0) {
+    post(std::make_unique<EvFrame>(EvFrame{std::move(f)}));
+    return;
+  }
+  post_stream_frame_(std::move(f));
+}
 
 void CBProviderStrand::post_device_error(uint64_t device_instance_id, ProviderError error) {
   post(EvDeviceError{device_instance_id, error});
@@ -312,5 +555,8 @@ void CBProviderStrand::post_stream_error(uint64_t stream_id, ProviderError error
 
 void CBProviderStrand::post_native_object_created(const NativeObjectCreateInfo& info) { post(EvNativeCreated{info}); }
 void CBProviderStrand::post_native_object_destroyed(const NativeObjectDestroyInfo& info) { post(EvNativeDestroyed{info}); }
+void CBProviderStrand::post_native_object_counters(const NativeObjectCountersUpdate& update) {
+  post(EvNativeCounters{update});
+}
 
 } // namespace cambang
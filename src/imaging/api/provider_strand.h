@@ -5,12 +5,15 @@
 #include <cstddef>
 #include <cstdint>
 #include <deque>
+#include <array>
 #include <future>
+#include <memory>
 #include <mutex>
 #include <thread>
 #include <variant>
 
 #include "imaging/api/icamera_provider.h"
+#include "imaging/api/provider_binding.h"
 
 namespace cambang {
 
@@ -18,6 +21,25 @@ namespace cambang {
 //
 // Providers MUST route all Provider→core facts (IProviderCallbacks::on_*) through this strand.
 // Core-issued sync services (allocate_native_id, core_monotonic_now_ns) remain direct calls.
+//
+// Events travel in two lanes merged back into one delivery order. Repeating
+// stream frames (the hot path) go into a fixed ring of FrameView slots that
+// producers claim lock-free; every other event goes into a mutex-guarded
+// control lane whose rare bulky payloads (fact structs, still frames) are
+// boxed, so neither lane's slot is sized by the largest fact. A control event
+// is keyed by the ring position current when it was posted and is delivered
+// once every frame claimed before it has been, so posts from one thread (and
+// posts ordered by happens-before) keep their order across lanes.
+//
+// Deliveries go to ProviderBoundCallbacks: IProviderCallbacks by default, or
+// Core's final ProviderCallbackIngress in a provider-bound build, where they
+// are direct calls (see provider_binding.h).
+//
+// Frame ring admission is classed by StreamPriority (asked of the callbacks'
+// stream_priority() only once the ring is half full): LOW frames are dropped
+// from half full, leaving the rest of the ring to NORMAL and HIGH streams,
+// and a HIGH frame that finds the ring full waits in the control lane while
+// that lane is under capacity instead of being dropped.
 class CBProviderStrand final {
 public:
   enum class EventClass : uint8_t {
@@ -33,9 +55,31 @@ public:
   CBProviderStrand(const CBProviderStrand&) = delete;
   CBProviderStrand& operator=(const CBProviderStrand&) = delete;
 
+  // Default bound on queued events; see post() for how Frame events give way.
+  static constexpr size_t kDefaultCapacity = 4096;
+  // Upper bound on the frame ring's slots (each holds one FrameView).
+  static constexpr size_t kMaxFrameRingSlots = 256;
+  // Ring fill from which LOW stream frames are dropped.
+  static constexpr size_t kLowFrameRingFillNumerator = 1;
+  static constexpr size_t kLowFrameRingFillDenominator = 2;
+
   // Returns false without exposing a partially-running strand if worker-thread
-  // construction fails or the strand is already running.
-  bool start(IProviderCallbacks* callbacks, const char* debug_name = "provider_strand", size_t capacity = 4096) noexcept;
+  // construction fails or the strand is already running. Repeating stream
+  // frames get min(capacity, kMaxFrameRingSlots) ring slots and are dropped
+  // when those are full; capacity 0 leaves both lanes unbounded (frames past
+  // the ring wait in the control lane).
+  bool start(IProviderCallbacks* callbacks,
+             const char* debug_name = "provider_strand",
+             size_t capacity = kDefaultCapacity) noexcept;
+
+  // Threadless alternative to start() for providers whose facts already come
+  // from one serialized context (virtual-time drivers): each post delivers
+  // straight to callbacks on the posting thread, under the strand mutex, so
+  // concurrent posters are still serialized and nothing is queued or
+  // dropped. flush() then only waits out a delivery in progress. Callbacks
+  // must not post back into the strand. False if already running.
+  bool start_inline(IProviderCallbacks* callbacks,
+                    const char* debug_name = "provider_strand") noexcept;
 
   // Deterministic barrier: all events posted before flush() are guaranteed delivered before it returns.
   void flush();
@@ -44,16 +88,29 @@ public:
   void stop();
 
   bool running() const noexcept { return running_.load(std::memory_order_acquire); }
+  bool inline_delivery() const noexcept { return inline_; }
+  // Kernel id of the worker thread (current_os_thread_id(), performance_hint.h)
+  // once it has started; 0 before that, for inline delivery, and on
+  // platforms without one.
+  int32_t worker_os_thread_id() const noexcept {
+    return worker_os_thread_id_.load(std::memory_order_acquire);
+  }
 
   // Count of admissions where a non-lossy (Lifecycle/NativeObject/Error) event
-  // was pushed past capacity() because no queued Frame event was available to
-  // evict. This is expected to stay at 0 under normal operation; a nonzero and
-  // growing value indicates sustained non-lossy pressure that capacity_ can no
-  // longer bound (see provider_strand.cpp post()).
+  // was pushed while the control lane already held capacity events. Frames
+  // never share the control lane's bound (they have the ring), so this is
+  // expected to stay at 0 under normal operation; a nonzero and growing value
+  // indicates sustained non-lossy pressure that capacity_ can no longer bound
+  // (see provider_strand.cpp post()).
   uint64_t non_lossy_over_capacity_count() const noexcept {
     return non_lossy_over_capacity_count_.load(std::memory_order_relaxed);
   }
 
+  // Repeating frames dropped at admission, by their stream's class.
+  uint64_t frames_dropped(StreamPriority priority) const noexcept {
+    return frames_dropped_by_priority_[static_cast<size_t>(priority)].load(std::memory_order_relaxed);
+  }
+
   // ---- Fact posting helpers ----
   void post_device_opened(uint64_t device_instance_id);
   void post_device_closed(uint64_t device_instance_id);
@@ -79,6 +136,7 @@ public:
 
   void post_native_object_created(const NativeObjectCreateInfo& info);
   void post_native_object_destroyed(const NativeObjectDestroyInfo& info);
+  void post_native_object_counters(const NativeObjectCountersUpdate& update);
 
 private:
   struct EvDeviceOpened { uint64_t id; };
@@ -107,9 +165,12 @@ private:
 
   struct EvNativeCreated { NativeObjectCreateInfo info; };
   struct EvNativeDestroyed { NativeObjectDestroyInfo info; };
+  struct EvNativeCounters { NativeObjectCountersUpdate update; };
 
   struct EvBarrier { std::shared_ptr<std::promise<void>> done; };
 
+  // Control-lane event. Payloads much larger than the common case are boxed
+  // so a lane slot stays small.
   using Event = std::variant<
       EvDeviceOpened,
       EvDeviceClosed,
@@ -120,38 +181,80 @@ private:
       EvCaptureStarted,
       EvCaptureCompleted,
       EvCaptureFailed,
-      EvCameraStaticFacts,
-      EvCaptureImageFacts,
-      EvFrame,
+      std::unique_ptr<EvCameraStaticFacts>,
+      std::unique_ptr<EvCaptureImageFacts>,
+      std::unique_ptr<EvFrame>,
       EvDeviceError,
       EvStreamError,
       EvNativeCreated,
       EvNativeDestroyed,
+      EvNativeCounters,
       EvBarrier>;
 
+  struct ControlEntry {
+    // Ring position when posted: delivered after every frame claimed before.
+    uint64_t frame_pos;
+    Event ev;
+  };
+
+  // One frame ring slot. turn == pos: free for the producer claiming pos;
+  // turn == pos + 1: published; consumed slots advance by the ring size.
+  struct FrameSlot {
+    std::atomic<uint64_t> turn{0};
+    FrameView frame{};
+  };
+
   void post(Event ev);
+  void post_stream_frame_(FrameView frame);
+  void deliver_inline_(Event& ev);
+  void deliver_frame_inline_(FrameView& frame);
+  bool ring_push_(FrameView& frame) noexcept;
+  // Frames claimed but not yet delivered (approximate while producers race).
+  size_t ring_fill_() const noexcept;
+  // Worker (or stop()'s drain) only.
+  bool ring_pop_(FrameView& out) noexcept;
+  void wake_worker_if_waiting_();
   static EventClass classify_(const Event& ev);
   void thread_main_();
   void deliver_(Event& ev);
+  void deliver_frame_(FrameView& frame);
   void drop_(Event& ev);
 
   std::mutex mu_;
   std::condition_variable cv_;
-  std::deque<Event> q_;
+  std::deque<ControlEntry> control_;
   size_t capacity_ = 0;
-  // Protected by mu_. Set true, atomically with stop()'s drain, in the same
-  // critical section; checked by post() before pushing so admission-close is
+  // start_inline(): posts deliver on the caller's thread; no worker.
+  bool inline_ = false;
+  // Set true under mu_, in the same critical section that opens stop()'s
+  // drain; checked by post() under mu_ before pushing so admission-close is
   // deterministic relative to drain (no event can be pushed after drain has
-  // already run). Reset false by start().
-  bool closed_ = false;
+  // already run). Frame posts check it without mu_ while counted in
+  // frame_posters_, which stop() waits out before draining the ring. Reset
+  // false by start().
+  std::atomic<bool> closed_{false};
+
+  std::unique_ptr<FrameSlot[]> ring_;
+  size_t ring_slots_ = 0;
+  alignas(64) std::atomic<uint64_t> ring_tail_{0};
+  // Next ring position to deliver; worker (or stop()'s drain) only.
+  uint64_t ring_head_ = 0;
+  // ring_head_ for producers' admission check.
+  std::atomic<uint64_t> ring_head_shared_{0};
+  std::atomic<uint32_t> frame_posters_{0};
+  // Set under mu_ while the worker is about to wait on cv_; ring producers
+  // (which never take mu_ otherwise) notify only then.
+  std::atomic<bool> worker_waiting_{false};
 
-  IProviderCallbacks* callbacks_ = nullptr;
+  ProviderBoundCallbacks* callbacks_ = nullptr;
   const char* debug_name_ = nullptr;
 
   std::atomic<bool> running_{false};
   std::atomic<bool> stop_requested_{false};
   std::thread worker_;
+  std::atomic<int32_t> worker_os_thread_id_{0};
   std::atomic<uint64_t> non_lossy_over_capacity_count_{0};
+  std::array<std::atomic<uint64_t>, kStreamPriorityCount> frames_dropped_by_priority_{};
 };
 
 } // namespace cambang
@@ -0,0 +1,177 @@
+#include "imaging/api/shared_memory.h"
+
+#if defined(_WIN32)
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#elif defined(__linux__) || defined(__ANDROID__)
+#include <fcntl.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+// Kernel ABI values, for C libraries whose headers predate memfd sealing.
+#ifndef MFD_CLOEXEC
+#define MFD_CLOEXEC 0x0001U
+#endif
+#ifndef MFD_ALLOW_SEALING
+#define MFD_ALLOW_SEALING 0x0002U
+#endif
+#ifndef F_ADD_SEALS
+#define F_ADD_SEALS 1033
+#define F_SEAL_SEAL 0x0001
+#define F_SEAL_SHRINK 0x0002
+#define F_SEAL_GROW 0x0004
+#endif
+#endif
+
+namespace cambang {
+
+namespace {
+
+bool valid_name(const std::string& name) noexcept {
+  if (name.empty() || name.size() > 64) {
+    return false;
+  }
+  for (const char c : name) {
+    const bool ok = (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z') || (c >= '0' && c <= '9') ||
+                    c == '.' || c == '_' || c == '-';
+    if (!ok) {
+      return false;
+    }
+  }
+  return true;
+}
+
+#if defined(_WIN32)
+
+std::wstring object_name(const std::string& name, const char* suffix) {
+  std::wstring out = L"Local\\";
+  for (const char c : name) {
+    out.push_back(static_cast<wchar_t>(c));
+  }
+  for (const char* s = suffix; *s != '\0'; ++s) {
+    out.push_back(static_cast<wchar_t>(*s));
+  }
+  return out;
+}
+
+#endif
+
+} // namespace
+
+bool CBSharedMemoryRegion::open(const std::string& name, size_t size_bytes) noexcept try {
+  close();
+  if (!valid_name(name) || size_bytes == 0) {
+    return false;
+  }
+#if defined(_WIN32)
+  const uint64_t size64 = static_cast<uint64_t>(size_bytes);
+  HANDLE mapping = CreateFileMappingW(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE,
+                                      static_cast<DWORD>(size64 >> 32), static_cast<DWORD>(size64),
+                                      object_name(name, "").c_str());
+  if (!mapping) {
+    return false;
+  }
+  // An existing mapping of that name belongs to someone else.
+  if (GetLastError() == ERROR_ALREADY_EXISTS) {
+    CloseHandle(mapping);
+    return false;
+  }
+  void* view = MapViewOfFile(mapping, FILE_MAP_ALL_ACCESS, 0, 0, size_bytes);
+  HANDLE event = view ? CreateEventW(nullptr, FALSE, FALSE, object_name(name, ".event").c_str()) : nullptr;
+  if (!view || !event) {
+    if (view) {
+      UnmapViewOfFile(view);
+    }
+    CloseHandle(mapping);
+    return false;
+  }
+  mapping_handle_ = mapping;
+  event_handle_ = event;
+  data_ = view;
+  size_ = size_bytes;
+  return true;
+#elif defined(__linux__) || defined(__ANDROID__)
+  // Through syscall(): bionic declares memfd_create() only from API 30.
+  const int memory_fd = static_cast<int>(syscall(SYS_memfd_create, name.c_str(), MFD_CLOEXEC | MFD_ALLOW_SEALING));
+  if (memory_fd < 0) {
+    return false;
+  }
+  if (ftruncate(memory_fd, static_cast<off_t>(size_bytes)) != 0) {
+    ::close(memory_fd);
+    return false;
+  }
+  // A consumer can map the region but never shrink it under the writer.
+  (void)fcntl(memory_fd, F_ADD_SEALS, F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_SEAL);
+  void* view = mmap(nullptr, size_bytes, PROT_READ | PROT_WRITE, MAP_SHARED, memory_fd, 0);
+  const int event_fd = view != MAP_FAILED ? eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK) : -1;
+  if (view == MAP_FAILED || event_fd < 0) {
+    if (view != MAP_FAILED) {
+      munmap(view, size_bytes);
+    }
+    ::close(memory_fd);
+    return false;
+  }
+  memory_fd_ = memory_fd;
+  event_fd_ = event_fd;
+  data_ = view;
+  size_ = size_bytes;
+  return true;
+#else
+  return false;
+#endif
+} catch (...) {
+  close();
+  return false;
+}
+
+void CBSharedMemoryRegion::close() noexcept {
+#if defined(_WIN32)
+  if (data_) {
+    UnmapViewOfFile(data_);
+  }
+  if (event_handle_) {
+    CloseHandle(static_cast<HANDLE>(event_handle_));
+  }
+  if (mapping_handle_) {
+    CloseHandle(static_cast<HANDLE>(mapping_handle_));
+  }
+#elif defined(__linux__) || defined(__ANDROID__)
+  if (data_) {
+    munmap(data_, size_);
+  }
+  if (event_fd_ >= 0) {
+    ::close(event_fd_);
+  }
+  if (memory_fd_ >= 0) {
+    ::close(memory_fd_);
+  }
+#endif
+  data_ = nullptr;
+  size_ = 0;
+  memory_fd_ = -1;
+  event_fd_ = -1;
+  mapping_handle_ = nullptr;
+  event_handle_ = nullptr;
+}
+
+void CBSharedMemoryRegion::signal() noexcept {
+  if (!data_) {
+    return;
+  }
+#if defined(_WIN32)
+  (void)SetEvent(static_cast<HANDLE>(event_handle_));
+#elif defined(__linux__) || defined(__ANDROID__)
+  const uint64_t one = 1;
+  // A full counter (consumer not draining) already means "wake up".
+  (void)!write(event_fd_, &one, sizeof(one));
+#endif
+}
+
+} // namespace cambang
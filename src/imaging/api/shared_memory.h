@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace cambang {
+
+// Process-shareable memory region with a wake-up event.
+//
+// Linux/Android: an anonymous memfd (sealed against shrinking) and an
+// eventfd. Neither has a name another process can open, so a consumer
+// receives the two descriptors over a Unix socket (SCM_RIGHTS) or opens
+// /proc/<pid>/fd/<fd> of this process. Windows: a pagefile-backed file
+// mapping named "Local\<name>" and an auto-reset event named
+// "Local\<name>.event", both openable by name from the same session. Other
+// platforms never open a region.
+//
+// signal() wakes one waiting consumer; it carries no data, so a consumer
+// reads the region after every wake-up and on a timeout.
+//
+// Threading: not thread-safe; one owner serializes open()/close(). data()
+// may be written from any thread while the region is open.
+class CBSharedMemoryRegion final {
+public:
+  CBSharedMemoryRegion() = default;
+  ~CBSharedMemoryRegion() { close(); }
+
+  CBSharedMemoryRegion(const CBSharedMemoryRegion&) = delete;
+  CBSharedMemoryRegion& operator=(const CBSharedMemoryRegion&) = delete;
+
+  // Creates and maps size_bytes of zeroed memory, closing any previous
+  // region. name (at most 64 of [A-Za-z0-9._-]) is the memfd label or the
+  // Windows object name. False on a bad name or size, on a platform without
+  // shared memory, or when the system refuses.
+  bool open(const std::string& name, size_t size_bytes) noexcept;
+  void close() noexcept;
+  bool is_open() const noexcept { return data_ != nullptr; }
+
+  uint8_t* data() const noexcept { return static_cast<uint8_t*>(data_); }
+  size_t size() const noexcept { return size_; }
+  void signal() noexcept;
+
+  // Descriptors of the open region (Linux/Android), else -1.
+  int memory_fd() const noexcept { return memory_fd_; }
+  int event_fd() const noexcept { return event_fd_; }
+
+private:
+  void* data_ = nullptr;
+  size_t size_ = 0;
+  int memory_fd_ = -1;
+  int event_fd_ = -1;
+  void* mapping_handle_ = nullptr;
+  void* event_handle_ = nullptr;
+};
+
+} // namespace cambang
@@ -0,0 +1,437 @@
+#include "imaging/api/strict_json.h"
+
+#include <cctype>
+#include <iterator>
+#include <limits>
+#include <unordered_set>
+#include <utility>
+
+namespace cambang::strict_json {
+namespace {
+
+// Objects up to this many members check duplicate keys by scanning the
+// members already read; larger ones switch to a hash set.
+constexpr std::size_t kLinearKeyScanMembers = 16;
+
+bool is_digit(char c) noexcept {
+  return std::isdigit(static_cast<unsigned char>(c)) != 0;
+}
+
+} // namespace
+
+bool Document::parse(std::string_view text, const ParseOptions& options, std::string* error) {
+  text_ = text;
+  options_ = options;
+  error_ = error;
+  pos_ = 0;
+  root_ = {};
+  nodes_.clear();
+  open_.clear();
+  decoded_.clear();
+
+  if (options_.max_input_bytes != 0 && text_.size() > options_.max_input_bytes) {
+    return fail("input exceeds byte limit");
+  }
+  if (!parse_value(0)) {
+    return false;
+  }
+  skip_ws();
+  if (pos_ != text_.size()) {
+    return fail("unexpected trailing input at byte " + std::to_string(pos_));
+  }
+
+  root_ = open_.back();
+  open_.clear();
+  // Containers record an index while nodes_ is still growing; resolve them
+  // to pointers now that it is final.
+  const auto resolve = [this](Value& v) {
+    if (v.item_count_ != 0) {
+      v.items_ = nodes_.data() + v.first_item_;
+    }
+  };
+  resolve(root_);
+  for (Value& v : nodes_) {
+    resolve(v);
+  }
+  return true;
+}
+
+bool Document::fail(std::string message) {
+  if (error_) {
+    *error_ = std::move(message);
+  }
+  return false;
+}
+
+void Document::skip_ws() noexcept {
+  while (pos_ < text_.size() && std::isspace(static_cast<unsigned char>(text_[pos_]))) {
+    ++pos_;
+  }
+}
+
+bool Document::consume(char c) noexcept {
+  if (pos_ < text_.size() && text_[pos_] == c) {
+    ++pos_;
+    return true;
+  }
+  return false;
+}
+
+bool Document::match_literal(std::string_view literal) noexcept {
+  if (text_.compare(pos_, literal.size(), literal) != 0) {
+    return false;
+  }
+  pos_ += literal.size();
+  return true;
+}
+
+bool Document::parse_value(std::size_t depth) {
+  skip_ws();
+  if (pos_ >= text_.size()) {
+    return fail("unexpected end of json");
+  }
+
+  const char c = text_[pos_];
+  if (c == '{') {
+    return parse_object(depth + 1);
+  }
+  if (c == '[') {
+    return parse_array(depth + 1);
+  }
+
+  Value v{};
+  if (c == '"') {
+    v.type = Value::Type::String;
+    if (!parse_string(v.text)) {
+      return false;
+    }
+  } else if (c == '-' || is_digit(c)) {
+    v.type = Value::Type::Number;
+    if (!parse_number(v)) {
+      return false;
+    }
+  } else if (match_literal("true")) {
+    v.type = Value::Type::Bool;
+    v.bool_value = true;
+  } else if (match_literal("false")) {
+    v.type = Value::Type::Bool;
+  } else if (!match_literal("null")) {
+    return fail("unexpected token at byte " + std::to_string(pos_));
+  }
+  open_.push_back(v);
+  return true;
+}
+
+bool Document::parse_string(std::string_view& out) {
+  if (!consume('"')) {
+    return fail("expected string at byte " + std::to_string(pos_));
+  }
+
+  const std::size_t start = pos_;
+  // Until the first escape the value is the raw span [start, pos_); from then
+  // on it is built in decoded_ from decoded_start.
+  bool escaped = false;
+  std::size_t decoded_start = 0;
+  while (pos_ < text_.size()) {
+    const char c = text_[pos_++];
+    if (c == '"') {
+      out = escaped ? std::string_view(decoded_.data() + decoded_start, decoded_.size() - decoded_start)
+                    : text_.substr(start, pos_ - 1 - start);
+      return true;
+    }
+    if (c == '\\') {
+      if (!escaped) {
+        if (decoded_.capacity() < text_.size()) {
+          decoded_.reserve(text_.size());
+        }
+        decoded_start = decoded_.size();
+        decoded_.append(text_.data() + start, pos_ - 1 - start);
+        escaped = true;
+      }
+      if (pos_ >= text_.size()) {
+        return fail("unterminated escape in string");
+      }
+      const char e = text_[pos_++];
+      switch (e) {
+        case '"': decoded_.push_back('"'); break;
+        case '\\': decoded_.push_back('\\'); break;
+        case '/': decoded_.push_back('/'); break;
+        case 'b': decoded_.push_back('\b'); break;
+        case 'f': decoded_.push_back('\f'); break;
+        case 'n': decoded_.push_back('\n'); break;
+        case 'r': decoded_.push_back('\r'); break;
+        case 't': decoded_.push_back('\t'); break;
+        case 'u':
+          if (!parse_unicode_escape()) {
+            return false;
+          }
+          break;
+        default:
+          return fail("invalid escape sequence in string");
+      }
+    } else {
+      if (static_cast<unsigned char>(c) < 0x20) {
+        return fail("control character in string");
+      }
+      if (escaped) {
+        decoded_.push_back(c);
+      }
+    }
+    if (options_.max_string_bytes != 0) {
+      const std::size_t length = escaped ? decoded_.size() - decoded_start : pos_ - start;
+      if (length > options_.max_string_bytes) {
+        return fail("string exceeds byte limit");
+      }
+    }
+  }
+
+  return fail("unterminated string");
+}
+
+bool Document::parse_unicode_escape() {
+  std::uint32_t codepoint = 0;
+  if (!parse_hex_escape(codepoint)) {
+    return false;
+  }
+  if (options_.ascii_unicode_escapes_only) {
+    if (codepoint > 0x7Fu) {
+      return fail("non-ascii unicode escape is not supported in strict v1 parser");
+    }
+    decoded_.push_back(static_cast<char>(codepoint));
+    return true;
+  }
+  if (codepoint >= 0xD800u && codepoint <= 0xDBFFu) {
+    if (pos_ + 6 > text_.size() || text_[pos_] != '\\' || text_[pos_ + 1] != 'u') {
+      return fail("missing low surrogate after high surrogate escape");
+    }
+    pos_ += 2;
+    std::uint32_t low = 0;
+    if (!parse_hex_escape(low)) {
+      return false;
+    }
+    if (low < 0xDC00u || low > 0xDFFFu) {
+      return fail("invalid low surrogate escape in string");
+    }
+    codepoint = 0x10000u + ((codepoint - 0xD800u) << 10) + (low - 0xDC00u);
+  } else if (codepoint >= 0xDC00u && codepoint <= 0xDFFFu) {
+    return fail("unexpected low surrogate escape in string");
+  }
+  append_utf8(codepoint);
+  return true;
+}
+
+bool Document::parse_hex_escape(std::uint32_t& out) {
+  if (pos_ + 4 > text_.size()) {
+    return fail("incomplete unicode escape in string");
+  }
+  std::uint32_t code = 0;
+  for (int i = 0; i < 4; ++i) {
+    const char h = text_[pos_++];
+    code <<= 4;
+    if (h >= '0' && h <= '9') {
+      code |= static_cast<std::uint32_t>(h - '0');
+    } else if (h >= 'a' && h <= 'f') {
+      code |= static_cast<std::uint32_t>(h - 'a' + 10);
+    } else if (h >= 'A' && h <= 'F') {
+      code |= static_cast<std::uint32_t>(h - 'A' + 10);
+    } else {
+      return fail("invalid unicode escape in string");
+    }
+  }
+  out = code;
+  return true;
+}
+
+void Document::append_utf8(std::uint32_t codepoint) {
+  if (codepoint <= 0x7Fu) {
+    decoded_.push_back(static_cast<char>(codepoint));
+    return;
+  }
+  if (codepoint <= 0x7FFu) {
+    decoded_.push_back(static_cast<char>(0xC0u | ((codepoint >> 6) & 0x1Fu)));
+    decoded_.push_back(static_cast<char>(0x80u | (codepoint & 0x3Fu)));
+    return;
+  }
+  if (codepoint <= 0xFFFFu) {
+    decoded_.push_back(static_cast<char>(0xE0u | ((codepoint >> 12) & 0x0Fu)));
+    decoded_.push_back(static_cast<char>(0x80u | ((codepoint >> 6) & 0x3Fu)));
+    decoded_.push_back(static_cast<char>(0x80u | (codepoint & 0x3Fu)));
+    return;
+  }
+  decoded_.push_back(static_cast<char>(0xF0u | ((codepoint >> 18) & 0x07u)));
+  decoded_.push_back(static_cast<char>(0x80u | ((codepoint >> 12) & 0x3Fu)));
+  decoded_.push_back(static_cast<char>(0x80u | ((codepoint >> 6) & 0x3Fu)));
+  decoded_.push_back(static_cast<char>(0x80u | (codepoint & 0x3Fu)));
+}
+
+bool Document::parse_number(Value& out) {
+  const std::size_t start = pos_;
+  const bool negative = consume('-');
+  if (pos_ >= text_.size() || !is_digit(text_[pos_])) {
+    return fail("invalid number at byte " + std::to_string(start));
+  }
+  if (text_[pos_] == '0' && pos_ + 1 < text_.size() && is_digit(text_[pos_ + 1])) {
+    return fail("leading zero is not allowed for numbers");
+  }
+
+  if (options_.integers_only) {
+    std::int64_t value = 0;
+    while (pos_ < text_.size() && is_digit(text_[pos_])) {
+      const int digit = text_[pos_] - '0';
+      if (value > (std::numeric_limits<std::int64_t>::max() - digit) / 10) {
+        return fail("integer overflow in number literal");
+      }
+      value = value * 10 + digit;
+      ++pos_;
+    }
+    if (pos_ < text_.size() && (text_[pos_] == '.' || text_[pos_] == 'e' || text_[pos_] == 'E')) {
+      return fail("non-integer numbers are not supported in strict v1 loader");
+    }
+    out.integer_value = negative ? -value : value;
+    out.text = text_.substr(start, pos_ - start);
+    return true;
+  }
+
+  while (pos_ < text_.size() && is_digit(text_[pos_])) {
+    ++pos_;
+  }
+  if (consume('.')) {
+    if (pos_ >= text_.size() || !is_digit(text_[pos_])) {
+      return fail("invalid fractional number at byte " + std::to_string(start));
+    }
+    while (pos_ < text_.size() && is_digit(text_[pos_])) {
+      ++pos_;
+    }
+  }
+  if (consume('e') || consume('E')) {
+    if (!consume('+')) {
+      consume('-');
+    }
+    if (pos_ >= text_.size() || !is_digit(text_[pos_])) {
+      return fail("invalid exponent number at byte " + std::to_string(start));
+    }
+    while (pos_ < text_.size() && is_digit(text_[pos_])) {
+      ++pos_;
+    }
+  }
+  out.text = text_.substr(start, pos_ - start);
+  return true;
+}
+
+bool Document::enter_container(std::size_t depth, char open) {
+  if (options_.max_nesting_depth != 0 && depth > options_.max_nesting_depth) {
+    return fail("json nesting exceeds depth limit");
+  }
+  if (!consume(open)) {
+    return fail(std::string("expected '") + open + "' at byte " + std::to_string(pos_));
+  }
+  return true;
+}
+
+// The container's items are the values pushed onto open_ since `first`; they
+// move to the end of nodes_ as one contiguous run and the container takes
+// their place on open_.
+void Document::close_container(Value::Type type, std::size_t first) {
+  Value v{};
+  v.type = type;
+  v.first_item_ = nodes_.size();
+  v.item_count_ = open_.size() - first;
+  nodes_.insert(nodes_.end(),
+                std::make_move_iterator(open_.begin() + static_cast<std::ptrdiff_t>(first)),
+                std::make_move_iterator(open_.end()));
+  open_.resize(first);
+  open_.push_back(v);
+}
+
+bool Document::parse_array(std::size_t depth) {
+  if (!enter_container(depth, '[')) {
+    return false;
+  }
+  const std::size_t first = open_.size();
+
+  skip_ws();
+  if (consume(']')) {
+    close_container(Value::Type::Array, first);
+    return true;
+  }
+
+  for (;;) {
+    if (!parse_value(depth)) {
+      return false;
+    }
+    skip_ws();
+    if (consume(']')) {
+      close_container(Value::Type::Array, first);
+      return true;
+    }
+    if (!consume(',')) {
+      return fail("expected ',' or ']' in array at byte " + std::to_string(pos_));
+    }
+  }
+}
+
+bool Document::has_member_key(std::size_t first, std::string_view key) const noexcept {
+  for (std::size_t i = first; i < open_.size(); ++i) {
+    if (open_[i].key == key) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool Document::parse_object(std::size_t depth) {
+  if (!enter_container(depth, '{')) {
+    return false;
+  }
+  const std::size_t first = open_.size();
+
+  skip_ws();
+  if (consume('}')) {
+    close_container(Value::Type::Object, first);
+    return true;
+  }
+
+  std::unordered_set<std::string_view> seen_keys;
+  for (;;) {
+    std::string_view key;
+    skip_ws();
+    if (!parse_string(key)) {
+      return false;
+    }
+    const std::size_t members = open_.size() - first;
+    bool duplicate = false;
+    if (members < kLinearKeyScanMembers) {
+      duplicate = has_member_key(first, key);
+    } else {
+      if (seen_keys.empty()) {
+        seen_keys.reserve(members * 2);
+        for (std::size_t i = first; i < open_.size(); ++i) {
+          seen_keys.insert(open_[i].key);
+        }
+      }
+      duplicate = !seen_keys.insert(key).second;
+    }
+    if (duplicate) {
+      return fail("duplicate object key: " + std::string(key));
+    }
+    skip_ws();
+    if (!consume(':')) {
+      return fail("expected ':' after key '" + std::string(key) + "'");
+    }
+    if (!parse_value(depth)) {
+      return false;
+    }
+    open_.back().key = key;
+
+    skip_ws();
+    if (consume('}')) {
+      close_container(Value::Type::Object, first);
+      return true;
+    }
+    if (!consume(',')) {
+      return fail("expected ',' or '}' in object at byte " + std::to_string(pos_));
+    }
+  }
+}
+
+} // namespace cambang::strict_json
@@ -0,0 +1,139 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace cambang::strict_json {
+
+// Strict JSON reader shared by the scenario, ADC camera-description and
+// camera-concurrency loaders.
+//
+// Document::parse() reads straight from the caller's bytes into one flat node
+// array: string and number values are views into the input (a string that
+// contains escapes is decoded once into a buffer owned by the document), and
+// the elements or members of each container sit contiguously. A parse costs a
+// handful of vector growths rather than one allocation per value, key and
+// container, and a Document reused across parses keeps its capacity.
+//
+// Grammar is plain RFC 8259 with duplicate object keys rejected. Options turn
+// on the per-loader input bounds and the scenario loader's integer-only v1
+// dialect.
+struct ParseOptions {
+  // 0 leaves the corresponding bound unchecked.
+  std::size_t max_input_bytes = 0;
+  std::size_t max_nesting_depth = 0;
+  std::size_t max_string_bytes = 0;
+  // Numbers must be integers that fit int64_t (Value::integer_value is set);
+  // fractions and exponents are rejected.
+  bool integers_only = false;
+  // \uXXXX escapes must name ASCII code points.
+  bool ascii_unicode_escapes_only = false;
+};
+
+class Document;
+
+class Value final {
+public:
+  enum class Type : std::uint8_t {
+    Null = 0,
+    Bool,
+    Number,
+    String,
+    Array,
+    Object,
+  };
+
+  // Array elements or object members, contiguous and in document order.
+  class Items final {
+  public:
+    const Value* begin() const noexcept { return begin_; }
+    const Value* end() const noexcept { return begin_ + size_; }
+    std::size_t size() const noexcept { return size_; }
+    bool empty() const noexcept { return size_ == 0; }
+    const Value& operator[](std::size_t i) const noexcept { return begin_[i]; }
+
+  private:
+    friend class Value;
+    Items(const Value* begin, std::size_t size) noexcept : begin_(begin), size_(size) {}
+
+    const Value* begin_;
+    std::size_t size_;
+  };
+
+  Type type = Type::Null;
+  bool bool_value = false;
+  // Number under ParseOptions::integers_only.
+  std::int64_t integer_value = 0;
+  // String: decoded bytes. Number: the literal as written.
+  std::string_view text{};
+  // Object members: the member name (decoded).
+  std::string_view key{};
+
+  Items items() const noexcept { return Items(items_, item_count_); }
+
+  // First member named `name`; nullptr when absent or not an object.
+  const Value* find(std::string_view name) const noexcept {
+    for (const Value& member : items()) {
+      if (member.key == name) {
+        return &member;
+      }
+    }
+    return nullptr;
+  }
+
+private:
+  friend class Document;
+
+  const Value* items_ = nullptr;
+  std::size_t item_count_ = 0;
+  std::size_t first_item_ = 0;
+};
+
+// Views handed out by a Document point into it and into the parsed input;
+// both must outlive them. Not copyable or movable for the same reason.
+class Document final {
+public:
+  Document() = default;
+  Document(const Document&) = delete;
+  Document& operator=(const Document&) = delete;
+
+  bool parse(std::string_view text, const ParseOptions& options, std::string* error);
+
+  const Value& root() const noexcept { return root_; }
+
+private:
+  bool fail(std::string message);
+  void skip_ws() noexcept;
+  bool consume(char c) noexcept;
+  bool match_literal(std::string_view literal) noexcept;
+  bool parse_value(std::size_t depth);
+  bool parse_string(std::string_view& out);
+  bool parse_unicode_escape();
+  bool parse_hex_escape(std::uint32_t& out);
+  bool parse_number(Value& out);
+  bool parse_array(std::size_t depth);
+  bool parse_object(std::size_t depth);
+  bool enter_container(std::size_t depth, char open);
+  bool has_member_key(std::size_t first, std::string_view key) const noexcept;
+  void close_container(Value::Type type, std::size_t first);
+  void append_utf8(std::uint32_t codepoint);
+
+  std::string_view text_{};
+  ParseOptions options_{};
+  std::string* error_ = nullptr;
+  std::size_t pos_ = 0;
+
+  Value root_{};
+  std::vector<Value> nodes_;
+  // Values of containers still being parsed, innermost last.
+  std::vector<Value> open_;
+  // Decoded escaped strings. Reserved to the input size before the first
+  // escape is decoded: decoding never lengthens a string, so it cannot
+  // reallocate under views already handed out.
+  std::string decoded_;
+};
+
+} // namespace cambang::strict_json
@@ -0,0 +1,180 @@
+#include "imaging/api/thread_policy.h"
+
+#include <atomic>
+#include <cstddef>
+
+#if defined(_WIN32)
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#elif defined(__APPLE__)
+#include <pthread.h>
+#include <sys/qos.h>
+#elif defined(__linux__) || defined(__ANDROID__)
+#include <pthread.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace cambang {
+
+namespace {
+
+std::atomic<uint64_t> g_applied{0};
+std::atomic<uint64_t> g_refused{0};
+
+void count(bool applied) noexcept {
+  (applied ? g_applied : g_refused).fetch_add(1, std::memory_order_relaxed);
+}
+
+#if defined(_WIN32)
+
+using AvSetMmThreadCharacteristicsWFn = HANDLE(WINAPI*)(LPCWSTR, LPDWORD);
+using AvRevertMmThreadCharacteristicsFn = BOOL(WINAPI*)(HANDLE);
+using SetThreadDescriptionFn = HRESULT(WINAPI*)(HANDLE, PCWSTR);
+
+// avrt.dll and SetThreadDescription are resolved at run time so no build
+// links avrt.lib and older Windows without SetThreadDescription still runs.
+struct WindowsEntryPoints {
+  AvSetMmThreadCharacteristicsWFn set_mm = nullptr;
+  AvRevertMmThreadCharacteristicsFn revert_mm = nullptr;
+  SetThreadDescriptionFn set_description = nullptr;
+
+  WindowsEntryPoints() noexcept {
+    if (HMODULE avrt = LoadLibraryW(L"avrt.dll")) {
+      set_mm = reinterpret_cast<AvSetMmThreadCharacteristicsWFn>(
+          reinterpret_cast<void*>(GetProcAddress(avrt, "AvSetMmThreadCharacteristicsW")));
+      revert_mm = reinterpret_cast<AvRevertMmThreadCharacteristicsFn>(
+          reinterpret_cast<void*>(GetProcAddress(avrt, "AvRevertMmThreadCharacteristics")));
+    }
+    if (HMODULE kernel32 = GetModuleHandleW(L"kernel32.dll")) {
+      set_description = reinterpret_cast<SetThreadDescriptionFn>(
+          reinterpret_cast<void*>(GetProcAddress(kernel32, "SetThreadDescription")));
+    }
+  }
+};
+
+const WindowsEntryPoints& windows_entry_points() noexcept {
+  static const WindowsEntryPoints entry_points;
+  return entry_points;
+}
+
+// Leaves the MMCSS task when the thread exits.
+struct MmcssRegistration {
+  HANDLE task = nullptr;
+
+  ~MmcssRegistration() {
+    if (task && windows_entry_points().revert_mm) {
+      windows_entry_points().revert_mm(task);
+    }
+  }
+};
+
+thread_local MmcssRegistration t_mmcss;
+
+void set_thread_name(const char* name) noexcept {
+  if (!windows_entry_points().set_description) {
+    return;
+  }
+  wchar_t wide[64]{};
+  for (size_t i = 0; i + 1 < sizeof(wide) / sizeof(wide[0]) && name[i] != '\0'; ++i) {
+    wide[i] = static_cast<wchar_t>(static_cast<unsigned char>(name[i]));
+  }
+  (void)windows_entry_points().set_description(GetCurrentThread(), wide);
+}
+
+bool apply_role(CBThreadRole role) noexcept {
+  switch (role) {
+    case CBThreadRole::Core:
+    case CBThreadRole::ProviderCallbacks: {
+      if (!t_mmcss.task && windows_entry_points().set_mm) {
+        DWORD task_index = 0;
+        t_mmcss.task = windows_entry_points().set_mm(L"Capture", &task_index);
+      }
+      if (t_mmcss.task) {
+        return true;
+      }
+      return SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_ABOVE_NORMAL) != 0;
+    }
+    case CBThreadRole::CaptureWorker:
+      return true;
+    case CBThreadRole::Background:
+      return SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_BELOW_NORMAL) != 0;
+  }
+  return false;
+}
+
+#elif defined(__APPLE__)
+
+void set_thread_name(const char* name) noexcept {
+  (void)pthread_setname_np(name);
+}
+
+bool apply_role(CBThreadRole role) noexcept {
+  qos_class_t qos = QOS_CLASS_DEFAULT;
+  switch (role) {
+    case CBThreadRole::Core: qos = QOS_CLASS_USER_INTERACTIVE; break;
+    case CBThreadRole::ProviderCallbacks: qos = QOS_CLASS_USER_INITIATED; break;
+    case CBThreadRole::CaptureWorker: return true;
+    case CBThreadRole::Background: qos = QOS_CLASS_UTILITY; break;
+  }
+  return pthread_set_qos_class_self_np(qos, 0) == 0;
+}
+
+#elif defined(__linux__) || defined(__ANDROID__)
+
+void set_thread_name(const char* name) noexcept {
+  // The kernel keeps 15 characters plus the terminator.
+  char truncated[16]{};
+  for (size_t i = 0; i + 1 < sizeof(truncated) && name[i] != '\0'; ++i) {
+    truncated[i] = name[i];
+  }
+  (void)pthread_setname_np(pthread_self(), truncated);
+}
+
+bool apply_role(CBThreadRole role) noexcept {
+  // Android's THREAD_PRIORITY_URGENT_DISPLAY / _DISPLAY / _BACKGROUND.
+  int nice = 0;
+  switch (role) {
+    case CBThreadRole::Core: nice = -8; break;
+    case CBThreadRole::ProviderCallbacks: nice = -4; break;
+    case CBThreadRole::CaptureWorker: return true;
+    case CBThreadRole::Background: nice = 10; break;
+  }
+  // Per-thread on Linux: PRIO_PROCESS with a tid names one thread.
+  const id_t tid = static_cast<id_t>(syscall(SYS_gettid));
+  return setpriority(PRIO_PROCESS, tid, nice) == 0;
+}
+
+#else
+
+void set_thread_name(const char*) noexcept {}
+
+bool apply_role(CBThreadRole role) noexcept {
+  return role == CBThreadRole::CaptureWorker;
+}
+
+#endif
+
+} // namespace
+
+void apply_current_thread_policy(CBThreadRole role, const char* name) noexcept {
+  if (name && name[0] != '\0') {
+    set_thread_name(name);
+  }
+  count(apply_role(role));
+}
+
+CBThreadPolicyStats thread_policy_stats() noexcept {
+  CBThreadPolicyStats stats;
+  stats.applied = g_applied.load(std::memory_order_relaxed);
+  stats.refused = g_refused.load(std::memory_order_relaxed);
+  return stats;
+}
+
+} // namespace cambang
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstdint>
+
+namespace cambang {
+
+// Scheduling policy for the threads CamBANG creates.
+//
+// Every CamBANG thread calls apply_current_thread_policy() first thing with
+// its role, so one table decides placement for all of them:
+//
+//   Core               CoreThread: frame dispatch and every state transition;
+//                      CoreFrameShards retention workers
+//   ProviderCallbacks  CBProviderStrand workers and platform control/callback
+//                      executors
+//   CaptureWorker      still-capture rendering and pixel conversion pools
+//   Background         spill, encode and recording I/O
+//
+// Linux/Android raise Core and ProviderCallbacks to the Android display
+// priorities (nice -8 and -4), which also steers the energy-aware scheduler
+// toward big cores, and lower Background to nice 10. Windows registers Core
+// and ProviderCallbacks with the MMCSS "Capture" task (falling back to
+// above-normal priority) and lowers Background. Apple platforms map the
+// roles onto QoS classes. CaptureWorker keeps the default priority
+// everywhere, so capture bursts share the cores fairly with the app.
+//
+// No thread is pinned: a fixed affinity mask fights the scheduler's own
+// big/little placement and cannot follow hotplugged or thermally parked
+// cores.
+//
+// Best-effort: a change the OS refuses (no privilege to raise priority on a
+// desktop Linux session, for instance) leaves the thread at its default and
+// is counted in thread_policy_stats().
+//
+// Threading: every function may be called from any thread.
+enum class CBThreadRole : uint8_t {
+  Core = 0,
+  ProviderCallbacks,
+  CaptureWorker,
+  Background,
+};
+
+struct CBThreadPolicyStats final {
+  // Threads whose role's scheduling change took effect.
+  uint64_t applied = 0;
+  // Threads left at the OS default because the change was refused.
+  uint64_t refused = 0;
+};
+
+// Names the calling thread (truncated to the platform's limit; null keeps
+// the current name) and applies its role's scheduling.
+void apply_current_thread_policy(CBThreadRole role, const char* name) noexcept;
+
+CBThreadPolicyStats thread_policy_stats() noexcept;
+
+} // namespace cambang
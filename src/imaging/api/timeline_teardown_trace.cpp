@@ -1,27 +1,50 @@
 #include "imaging/api/timeline_teardown_trace.h"
 
+#include <algorithm>
+#include <array>
 #include <atomic>
-#include <cstdlib>
-#include <cstdarg>
+#include <chrono>
+#include <cinttypes>
 #include <cstdio>
-#include <deque>
+#include <cstdlib>
 #include <mutex>
 
 namespace cambang {
 
 namespace {
 
-std::mutex& trace_mu() {
-  static std::mutex mu;
-  return mu;
-}
+// One ring slot, guarded by a sequence word as in frame_latency_trace.cpp:
+// odd while a writer is inside, 2 * index + 2 once the event for ring index
+// `index` is complete. Fields are relaxed atomics so a reader racing a
+// writer is detected by the sequence check rather than torn.
+struct Slot final {
+  std::atomic<uint64_t> seq{0};
+  std::atomic<const char*> fmt{nullptr};
+  std::atomic<uint64_t> timestamp_ns{0};
+  std::atomic<uint32_t> thread_and_arg_count{0};
+  std::array<std::atomic<uint64_t>, kTimelineTeardownTraceMaxArgs> args{};
+};
+
+std::array<Slot, kTimelineTeardownTraceCapacity> g_ring{};
+std::atomic<uint64_t> g_head{0};
+std::atomic<uint32_t> g_next_thread_index{1};
+
+// Drain cursor; try_pop() may be called from any thread.
+std::mutex g_pop_mu;
+uint64_t g_next_pop = 0;
 
-std::deque<std::string>& trace_q() {
-  static std::deque<std::string> q;
-  return q;
+uint32_t current_thread_index() noexcept {
+  thread_local uint32_t index = 0;
+  if (index == 0) {
+    index = g_next_thread_index.fetch_add(1, std::memory_order_relaxed);
+  }
+  return index;
 }
 
-constexpr size_t kTraceQueueCap = 256;
+uint64_t steady_now_ns() noexcept {
+  return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now().time_since_epoch()).count());
+}
 
 std::atomic<bool>& trace_enabled() {
   static std::atomic<bool> enabled{false};
@@ -78,6 +101,96 @@ std::string normalize_line(std::string line) {
   return std::string("[timeline_teardown] ") + line;
 }
 
+// printf-style formatting of a recorded event. Each conversion is rebuilt
+// with its flags, width and precision and given the recorded argument at the
+// width the conversion letter implies (length modifiers are replaced).
+std::string format_event(const char* fmt, const uint64_t* args, uint32_t arg_count) {
+  std::string out;
+  uint32_t next_arg = 0;
+  const char* p = fmt;
+  while (*p) {
+    if (*p != '%') {
+      out.push_back(*p++);
+      continue;
+    }
+    if (p[1] == '%') {
+      out.push_back('%');
+      p += 2;
+      continue;
+    }
+    const char* spec_begin = p++;
+    std::string spec = "%";
+    while (*p && std::char_traits<char>::find("-+ #0", 5, *p)) {
+      spec.push_back(*p++);
+    }
+    while (*p && ((*p >= '0' && *p <= '9') || *p == '.')) {
+      spec.push_back(*p++);
+    }
+    while (*p && std::char_traits<char>::find("hlLqjzt", 7, *p)) {
+      ++p;
+    }
+    const char conv = *p;
+    if (!conv || next_arg >= arg_count) {
+      out.append(spec_begin, static_cast<size_t>((conv ? p + 1 : p) - spec_begin));
+      if (conv) {
+        ++p;
+      }
+      continue;
+    }
+    ++p;
+    const uint64_t v = args[next_arg++];
+    char buf[128];
+    buf[0] = '\0';
+    switch (conv) {
+      case 'd':
+      case 'i':
+        spec += "ll";
+        spec.push_back(conv);
+        std::snprintf(buf, sizeof(buf), spec.c_str(), static_cast<long long>(v));
+        break;
+      case 'u':
+      case 'o':
+      case 'x':
+      case 'X':
+        spec += "ll";
+        spec.push_back(conv);
+        std::snprintf(buf, sizeof(buf), spec.c_str(), static_cast<unsigned long long>(v));
+        break;
+      case 'c':
+        spec.push_back(conv);
+        std::snprintf(buf, sizeof(buf), spec.c_str(), static_cast<int>(v));
+        break;
+      case 'e':
+      case 'E':
+      case 'f':
+      case 'F':
+      case 'g':
+      case 'G': {
+        double d = 0.0;
+        std::memcpy(&d, &v, sizeof(d));
+        spec.push_back(conv);
+        std::snprintf(buf, sizeof(buf), spec.c_str(), d);
+        break;
+      }
+      case 's': {
+        const char* str = reinterpret_cast<const char*>(static_cast<uintptr_t>(v));
+        spec.push_back(conv);
+        std::snprintf(buf, sizeof(buf), spec.c_str(), str ? str : "(null)");
+        break;
+      }
+      case 'p':
+        spec.push_back(conv);
+        std::snprintf(buf, sizeof(buf), spec.c_str(), reinterpret_cast<void*>(static_cast<uintptr_t>(v)));
+        break;
+      default:
+        out.append(spec_begin, static_cast<size_t>(p - spec_begin));
+        continue;
+    }
+    out += buf;
+  }
+  return out;
+}
+
 } // namespace
 
 void timeline_teardown_trace_set_enabled(bool enabled) {
@@ -90,40 +203,67 @@ bool timeline_teardown_trace_enabled() {
   return trace_enabled().load(std::memory_order_relaxed);
 }
 
-void timeline_teardown_trace_emit(const char* fmt, ...) {
-  init_from_env_once();
-  if (!timeline_teardown_trace_enabled()) {
-    return;
-  }
-
-  if (!fmt) {
-    return;
-  }
-
-  char msg[512];
-  va_list args;
-  va_start(args, fmt);
-  std::vsnprintf(msg, sizeof(msg), fmt, args);
-  va_end(args);
-
-  std::string line = normalize_line(msg);
+namespace timeline_teardown_trace_detail {
 
-  std::lock_guard<std::mutex> lock(trace_mu());
-  auto& q = trace_q();
-  q.push_back(line);
-  if (q.size() > kTraceQueueCap) {
-    q.pop_front();
+void record(const char* fmt, const uint64_t* args, uint32_t arg_count) noexcept {
+  const uint64_t ts = steady_now_ns();
+  const uint64_t index = g_head.fetch_add(1, std::memory_order_relaxed);
+  Slot& slot = g_ring[index % kTimelineTeardownTraceCapacity];
+  slot.seq.store(2u * index + 1u, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  slot.fmt.store(fmt, std::memory_order_relaxed);
+  slot.timestamp_ns.store(ts, std::memory_order_relaxed);
+  slot.thread_and_arg_count.store((current_thread_index() << 8) | arg_count, std::memory_order_relaxed);
+  for (uint32_t i = 0; i < arg_count; ++i) {
+    slot.args[i].store(args[i], std::memory_order_relaxed);
   }
+  slot.seq.store(2u * index + 2u, std::memory_order_release);
 }
 
+} // namespace timeline_teardown_trace_detail
+
 bool timeline_teardown_trace_try_pop(std::string& out) {
-  std::lock_guard<std::mutex> lock(trace_mu());
-  auto& q = trace_q();
-  if (q.empty()) {
-    return false;
+  const char* fmt = nullptr;
+  uint64_t timestamp_ns = 0;
+  uint32_t thread_and_arg_count = 0;
+  uint64_t args[kTimelineTeardownTraceMaxArgs]{};
+  {
+    std::lock_guard<std::mutex> lock(g_pop_mu);
+    const uint64_t head = g_head.load(std::memory_order_acquire);
+    if (head > kTimelineTeardownTraceCapacity && g_next_pop < head - kTimelineTeardownTraceCapacity) {
+      g_next_pop = head - kTimelineTeardownTraceCapacity; // older events were overwritten
+    }
+    bool found = false;
+    while (!found && g_next_pop < head) {
+      const Slot& slot = g_ring[g_next_pop % kTimelineTeardownTraceCapacity];
+      const uint64_t expected = 2u * g_next_pop + 2u;
+      const uint64_t seq = slot.seq.load(std::memory_order_acquire);
+      if (seq < expected) {
+        return false; // still being written; drained on a later call
+      }
+      if (seq == expected) {
+        fmt = slot.fmt.load(std::memory_order_relaxed);
+        timestamp_ns = slot.timestamp_ns.load(std::memory_order_relaxed);
+        thread_and_arg_count = slot.thread_and_arg_count.load(std::memory_order_relaxed);
+        for (size_t i = 0; i < kTimelineTeardownTraceMaxArgs; ++i) {
+          args[i] = slot.args[i].load(std::memory_order_relaxed);
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        found = slot.seq.load(std::memory_order_relaxed) == expected;
+      }
+      ++g_next_pop; // taken, or overwritten by a newer lap
+    }
+    if (!found) {
+      return false;
+    }
   }
-  out = std::move(q.front());
-  q.pop_front();
+
+  const uint32_t arg_count = std::min<uint32_t>(thread_and_arg_count & 0xFFu,
+                                                static_cast<uint32_t>(kTimelineTeardownTraceMaxArgs));
+  out = normalize_line(format_event(fmt, args, arg_count));
+  char suffix[64];
+  std::snprintf(suffix, sizeof(suffix), " thread=%u t_ns=%" PRIu64, thread_and_arg_count >> 8, timestamp_ns);
+  out += suffix;
   return true;
 }
 
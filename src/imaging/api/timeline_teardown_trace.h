@@ -1,13 +1,72 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
 #include <string>
+#include <type_traits>
 
 namespace cambang {
 
+// Timeline teardown trace: sequencing of destructive timeline primitives
+// (activate / pending / dispatch / fail), drained by CamBANGServer for its
+// trace echo and strict timeline monitor.
+//
+// emit() does not format. It records the format's address, a steady-clock
+// time, the recording thread and up to kTimelineTeardownTraceMaxArgs raw
+// arguments into a fixed process-wide ring (wait-free, allocation-free, like
+// frame_latency_trace), so a trace point costs tens of nanoseconds and
+// tracing can stay on while hunting timing-sensitive races. try_pop() formats
+// each line as it is drained and appends " thread=<n> t_ns=<steady ns>". The
+// ring keeps the newest kTimelineTeardownTraceCapacity events.
+//
+// Because formatting is deferred, fmt must be a string literal and every %s
+// argument a string with static storage. Arguments are integers, enums,
+// floating point or const char*; '*' widths are not supported.
+//
+// Threading: every function may be called from any thread.
+inline constexpr size_t kTimelineTeardownTraceCapacity = 256;
+inline constexpr size_t kTimelineTeardownTraceMaxArgs = 4;
+
 void timeline_teardown_trace_set_enabled(bool enabled);
 bool timeline_teardown_trace_enabled();
 
-void timeline_teardown_trace_emit(const char* fmt, ...);
+namespace timeline_teardown_trace_detail {
+
+template <typename T>
+uint64_t pack_arg(T value) noexcept {
+  using U = std::decay_t<T>;
+  if constexpr (std::is_enum_v<U>) {
+    return static_cast<uint64_t>(static_cast<std::underlying_type_t<U>>(value));
+  } else if constexpr (std::is_integral_v<U>) {
+    return static_cast<uint64_t>(value);
+  } else if constexpr (std::is_floating_point_v<U>) {
+    const double d = static_cast<double>(value);
+    uint64_t bits = 0;
+    std::memcpy(&bits, &d, sizeof(bits));
+    return bits;
+  } else {
+    static_assert(std::is_convertible_v<U, const char*>,
+                  "timeline_teardown_trace_emit: unsupported argument type");
+    return static_cast<uint64_t>(reinterpret_cast<uintptr_t>(static_cast<const char*>(value)));
+  }
+}
+
+void record(const char* fmt, const uint64_t* args, uint32_t arg_count) noexcept;
+
+} // namespace timeline_teardown_trace_detail
+
+template <typename... Args>
+void timeline_teardown_trace_emit(const char* fmt, Args... args) {
+  static_assert(sizeof...(Args) <= kTimelineTeardownTraceMaxArgs,
+                "timeline_teardown_trace_emit: too many arguments");
+  if (!fmt || !timeline_teardown_trace_enabled()) {
+    return;
+  }
+  const uint64_t packed[sizeof...(Args) + 1] = {timeline_teardown_trace_detail::pack_arg(args)..., 0};
+  timeline_teardown_trace_detail::record(fmt, packed, static_cast<uint32_t>(sizeof...(Args)));
+}
+
 bool timeline_teardown_trace_try_pop(std::string& out);
 
 } // namespace cambang
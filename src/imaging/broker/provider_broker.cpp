@@ -27,6 +27,7 @@
   #include "imaging/synthetic/provider.h"
   #include "imaging/synthetic/config.h"
   #include "imaging/synthetic/builtin_scenario_library.h"
+  #include "imaging/replay/provider.h"
 #endif
 
 namespace cambang {
@@ -282,6 +283,20 @@ uint64_t ProviderBroker::capture_admission_watchdog_timeout_ns() const noexcept
              : kDefaultCaptureAdmissionWatchdogTimeoutNs;
 }
 
+uint32_t ProviderBroker::max_active_streams_per_device() const noexcept {
+  ActiveProviderCall call;
+  return acquire_active_provider_call_(call).ok()
+             ? call.provider()->max_active_streams_per_device()
+             : 1;
+}
+
+bool ProviderBroker::supports_capture_alongside_streams(
+    uint64_t device_instance_id) const noexcept {
+  ActiveProviderCall call;
+  return acquire_active_provider_call_(call).ok() &&
+         call.provider()->supports_capture_alongside_streams(device_instance_id);
+}
+
 ProviderResult ProviderBroker::update_stream_retained_production_plan(
     uint64_t stream_id,
     CoreRetainedProductionPlan requested_retained_plan) {
@@ -435,6 +450,15 @@ ProviderResult ProviderBroker::set_synthetic_capture_capability_downgrade_condit
   return ProviderResult::success();
 }
 
+ProviderResult ProviderBroker::set_replay_requested(ReplayProviderConfig config) noexcept {
+  std::lock_guard<std::mutex> lock(active_provider_mutex_);
+  if (provider_lifecycle_state_ != ProviderLifecycleState::Uninitialized) {
+    return ProviderResult::failure(ProviderError::ERR_BUSY);
+  }
+  replay_requested_ = std::move(config);
+  return ProviderResult::success();
+}
+
 void ProviderBroker::dispatch_synthetic_timeline_request_(const SyntheticScheduledEvent& ev) {
   std::function<void(const SyntheticScheduledEvent&)> hook;
   {
@@ -500,6 +524,7 @@ ProviderResult ProviderBroker::initialize(IProviderCallbacks *callbacks) {
         stream_capability_downgrade_conditions_requested_;
     capture_capability_downgrade_conditions_latched_ =
         capture_capability_downgrade_conditions_requested_;
+    replay_latched_ = replay_requested_;
     provider_lifecycle_state_ = ProviderLifecycleState::Initializing;
     provider_call_admission_closed_ = true;
   }
@@ -527,7 +552,11 @@ ProviderResult ProviderBroker::initialize(IProviderCallbacks *callbacks) {
     }
 
     std::unique_ptr<ICameraProvider> candidate;
-    if (mode_latched_ == RuntimeMode::synthetic) {
+    if (mode_latched_ == RuntimeMode::synthetic && !replay_latched_.recording_path.empty()) {
+#if defined(CAMBANG_ENABLE_SYNTHETIC) && CAMBANG_ENABLE_SYNTHETIC
+      candidate = std::make_unique<ReplayProvider>(replay_latched_);
+#endif
+    } else if (mode_latched_ == RuntimeMode::synthetic) {
 #if defined(CAMBANG_ENABLE_SYNTHETIC) && CAMBANG_ENABLE_SYNTHETIC
       SyntheticProviderConfig cfg{};
       cfg.synthetic_role = synthetic_role_latched_;
@@ -648,6 +677,15 @@ ProviderResult ProviderBroker::stop_stream(uint64_t stream_id) {
   return call.provider()->stop_stream(stream_id);
 }
 
+ProviderResult ProviderBroker::reconfigure_stream(uint64_t stream_id, const CaptureProfile& profile) {
+  ActiveProviderCall call;
+  ProviderResult pr = acquire_active_provider_call_(call);
+  if (!pr.ok()) {
+    return pr;
+  }
+  return call.provider()->reconfigure_stream(stream_id, profile);
+}
+
 ProviderResult ProviderBroker::set_stream_picture_config(uint64_t stream_id, const PictureConfig& picture) {
   ActiveProviderCall call;
   ProviderResult pr = acquire_active_provider_call_(call);
@@ -686,6 +724,36 @@ ProviderResult ProviderBroker::release_capture_parent_priming(
   return call.provider()->release_capture_parent_priming(device_instance_id);
 }
 
+uint64_t ProviderBroker::trim_memory(MemoryTrimLevel level) noexcept try {
+  ActiveProviderCall call;
+  if (!acquire_active_provider_call_(call).ok()) {
+    return 0;
+  }
+  return call.provider()->trim_memory(level);
+} catch (...) {
+  return 0;
+}
+
+void ProviderBroker::set_stream_pool_depth_hint(uint64_t stream_id,
+                                                const StreamPoolDepthHint& hint) noexcept try {
+  ActiveProviderCall call;
+  if (!acquire_active_provider_call_(call).ok()) {
+    return;
+  }
+  call.provider()->set_stream_pool_depth_hint(stream_id, hint);
+} catch (...) {
+}
+
+uint64_t ProviderBroker::producer_frames_dropped_total() const noexcept try {
+  ActiveProviderCall call;
+  if (!acquire_active_provider_call_(call).ok()) {
+    return 0;
+  }
+  return call.provider()->producer_frames_dropped_total();
+} catch (...) {
+  return 0;
+}
+
 ProviderResult ProviderBroker::trigger_capture(const CaptureRequest& req) {
   ActiveProviderCall call;
   ProviderResult pr = acquire_active_provider_call_(call);
@@ -771,6 +839,44 @@ ProviderResult ProviderBroker::shutdown() {
   return shutdown_result;
 }
 
+ProviderResult ProviderBroker::swap_provider(
+    const std::function<ProviderResult(ProviderBroker&)>& reselect) {
+  IProviderCallbacks* callbacks = nullptr;
+  {
+    std::lock_guard<std::mutex> lock(active_provider_mutex_);
+    if (provider_lifecycle_state_ == ProviderLifecycleState::Uninitialized) {
+      return err_not_initialized();
+    }
+    if (provider_lifecycle_state_ != ProviderLifecycleState::Active) {
+      return ProviderResult::failure(ProviderError::ERR_BUSY);
+    }
+    callbacks = callbacks_;
+  }
+
+  const ProviderResult shutdown_result = shutdown();
+  {
+    // Drain refusal (re-entrant call, concurrent shutdown) leaves the
+    // lifecycle where it was; only a completed shutdown may re-initialize.
+    std::lock_guard<std::mutex> lock(active_provider_mutex_);
+    if (provider_lifecycle_state_ != ProviderLifecycleState::Uninitialized) {
+      return shutdown_result.ok() ? ProviderResult::failure(ProviderError::ERR_BUSY)
+                                  : shutdown_result;
+    }
+  }
+  if (reselect) {
+    ProviderResult reselect_result = ProviderResult::success();
+    try {
+      reselect_result = reselect(*this);
+    } catch (...) {
+      return ProviderResult::failure(ProviderError::ERR_PROVIDER_FAILED);
+    }
+    if (!reselect_result.ok()) {
+      return reselect_result;
+    }
+  }
+  return initialize(callbacks);
+}
+
 #if defined(CAMBANG_INTERNAL_SMOKE) && CAMBANG_INTERNAL_SMOKE
 ProviderResult ProviderBroker::install_active_provider_for_smoke(
     std::unique_ptr<ICameraProvider> provider,
@@ -847,6 +953,9 @@ bool ProviderBroker::try_tick_virtual_time(uint64_t dt_ns, bool flush_strand) {
         hook = synthetic_timeline_request_dispatch_hook_;
       }
       tick_result = true;
+    } else if (auto* replay = dynamic_cast<ReplayProvider*>(call.provider())) {
+      replay->advance(dt_ns);
+      tick_result = true;
     } else
 #endif
 
@@ -4,7 +4,10 @@
 // Locked invariants:
 // - Core binds to exactly one provider instance (the broker).
 // - Runtime selection between platform-backed and synthetic occurs via provider_mode.
-// - Switching provider_mode requires teardown/restart (selection is latched at initialize()).
+// - Selection is latched at initialize(). Switching provider_mode either
+//   restarts the runtime or hot-swaps via swap_provider(), which
+//   CoreRuntime::try_swap_provider() drives once Core has retired the old
+//   provider's streams and devices.
 // - No public Godot API changes: broker implements the internal provider interface.
 
 #include <cstddef>
@@ -19,6 +22,7 @@
 #include "imaging/api/icamera_provider.h"
 #include "imaging/api/provider_access_status.h"
 #include "imaging/broker/mode.h"
+#include "imaging/replay/config.h"
 
 // Waiver (cpp_code_quality_policy.md Waivers section): ProviderBroker does
 // NOT depend on the concrete SyntheticProvider class (that coupling was
@@ -73,6 +77,9 @@ public:
       std::vector<SyntheticStreamCapabilityDowngradeCondition> conditions) noexcept;
   ProviderResult set_synthetic_capture_capability_downgrade_conditions_requested(
       std::vector<SyntheticCaptureCapabilityDowngradeCondition> conditions) noexcept;
+  // Synthetic mode only: a non-empty recording_path selects ReplayProvider
+  // (playback of a stream recording) instead of SyntheticProvider.
+  ProviderResult set_replay_requested(ReplayProviderConfig config) noexcept;
 
   const char* provider_name() const override;
   ProviderKind provider_kind() const noexcept override;
@@ -101,6 +108,8 @@ public:
   uint64_t stream_backing_plan_evaluation_settle_delay_ns() const noexcept override;
   uint64_t capture_backing_plan_evaluation_settle_delay_ns() const noexcept override;
   uint64_t capture_admission_watchdog_timeout_ns() const noexcept override;
+  uint32_t max_active_streams_per_device() const noexcept override;
+  bool supports_capture_alongside_streams(uint64_t device_instance_id) const noexcept override;
 
   ProviderResult initialize(IProviderCallbacks* callbacks) override;
   ProviderResult enumerate_endpoints(std::vector<CameraEndpoint>& out_endpoints) override;
@@ -120,6 +129,7 @@ public:
       const CaptureProfile& profile,
       const PictureConfig& picture) override;
   ProviderResult stop_stream(uint64_t stream_id) override;
+  ProviderResult reconfigure_stream(uint64_t stream_id, const CaptureProfile& profile) override;
   ProviderResult update_stream_retained_production_plan(
       uint64_t stream_id,
       CoreRetainedProductionPlan requested_retained_plan) override;
@@ -128,6 +138,9 @@ public:
   ProviderResult set_capture_picture_config(uint64_t device_instance_id, const PictureConfig& picture) override;
   ProviderResult sync_capture_parent_priming(const CaptureRequest& req) override;
   ProviderResult release_capture_parent_priming(uint64_t device_instance_id) override;
+  uint64_t trim_memory(MemoryTrimLevel level) noexcept override;
+  void set_stream_pool_depth_hint(uint64_t stream_id, const StreamPoolDepthHint& hint) noexcept override;
+  uint64_t producer_frames_dropped_total() const noexcept override;
 
   ProviderResult trigger_capture(const CaptureRequest& req) override;
   ProviderResult trigger_capture_submission(const CaptureSubmission& submission) override;
@@ -144,6 +157,15 @@ public:
 
   ProviderResult shutdown() override;
 
+  // Hot-swap: drains and shuts down the active provider exactly as shutdown()
+  // does, runs reselect while the broker is uninitialized (so the
+  // set_*_requested() setters accept the new selection), then initializes the
+  // replacement with the same callbacks. A failed provider shutdown does not
+  // stop the swap (the old instance is released either way); a failed
+  // reselect or initialize leaves the broker uninitialized. Not callable from
+  // provider callbacks.
+  ProviderResult swap_provider(const std::function<ProviderResult(ProviderBroker&)>& reselect);
+
   // ---- Virtual-time helper (not part of ICameraProvider) ----
   // Drives virtual time for backends that require an external pump (stub, synthetic
   // virtual_time). Returns true if the active backend consumed the tick.
@@ -268,6 +290,8 @@ private:
       stream_capability_downgrade_conditions_latched_{};
   std::vector<SyntheticCaptureCapabilityDowngradeCondition>
       capture_capability_downgrade_conditions_latched_{};
+  ReplayProviderConfig replay_requested_{};
+  ReplayProviderConfig replay_latched_{};
   std::function<void(const SyntheticScheduledEvent&)> synthetic_timeline_request_dispatch_hook_{};
 };
 
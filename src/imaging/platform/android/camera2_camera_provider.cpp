@@ -7,6 +7,13 @@
 // images. Requires the Android NDK.
 
 #include "imaging/platform/android/camera2_camera_provider.h"
+#include "imaging/api/performance_hint.h"
+#include "imaging/api/thread_policy.h"
+#include "pixels/convert/yuv420_to_rgba.h"
+
+#if CAMBANG_PROVIDER_BOUND
+#include "core/provider_callback_ingress.h"
+#endif
 
 #include <camera/NdkCameraCaptureSession.h>
 #include <camera/NdkCameraDevice.h>
@@ -20,6 +27,8 @@
 #include <android/log.h>
 
 #include <algorithm>
+#include <array>
+#include <chrono>
 #include <cmath>
 #include <cstdarg>
 #include <cstdio>
@@ -147,7 +156,28 @@ bool BoundedControlExecutor::run_bounded(
   return true;
 }
 
+bool BoundedControlExecutor::post(std::function<void()> job) noexcept {
+  if (!running_.load(std::memory_order_acquire) || !job) {
+    return false;
+  }
+  try {
+    auto wrapped = [job = std::move(job)](const AbandonToken&) { job(); };
+    std::lock_guard<std::mutex> lock(mu_);
+    if (stop_requested_) {
+      return false;
+    }
+    q_.push_back(Entry{std::move(wrapped),
+                       std::make_shared<AbandonToken>(),
+                       std::make_shared<std::promise<void>>()});
+  } catch (...) {
+    return false;
+  }
+  cv_.notify_one();
+  return true;
+}
+
 void BoundedControlExecutor::thread_main_() noexcept {
+  apply_current_thread_policy(CBThreadRole::ProviderCallbacks, "cambang-c2-ctl");
   for (;;) {
     Entry entry;
     {
@@ -169,73 +199,165 @@ void BoundedControlExecutor::thread_main_() noexcept {
 }
 
 // ---------------------------------------------------------------------------
-// Frame conversion (YUV_420_888 -> packed RGBA/BGRA)
+// RowBandConversionPool
 // ---------------------------------------------------------------------------
 
-namespace {
+RowBandConversionPool::~RowBandConversionPool() { stop(); }
 
-inline uint8_t clamp_u8(int32_t v) noexcept {
-  return static_cast<uint8_t>(v < 0 ? 0 : (v > 255 ? 255 : v));
+bool RowBandConversionPool::start(size_t worker_count,
+                                  uint32_t band_rows,
+                                  uint64_t min_pixels) noexcept {
+  if (running_.load(std::memory_order_acquire) || worker_count == 0 || band_rows == 0) {
+    return false;
+  }
+  {
+    std::lock_guard<std::mutex> lock(mu_);
+    stop_requested_ = false;
+    current_.reset();
+    band_rows_ = band_rows;
+    min_pixels_ = min_pixels;
+  }
+  try {
+    workers_.reserve(worker_count);
+    for (size_t i = 0; i < worker_count; ++i) {
+      workers_.emplace_back([this] { worker_main_(); });
+    }
+  } catch (...) {
+    // Fewer workers than asked is still a correct pool; none is not.
+    if (workers_.empty()) {
+      return false;
+    }
+  }
+  running_.store(true, std::memory_order_release);
+  return true;
 }
 
-// BT.601 limited ("video") range, the range Camera2 YUV_420_888 output uses.
-// Fixed point at 1/256 so a full frame stays integer-only.
-//
-// Handles both planar (uv_pixel_stride == 1) and semiplanar/NV12-NV21
-// (uv_pixel_stride == 2) chroma layouts, which is the whole point of
-// YUV_420_888: the format is a family, and the strides are the only truthful
-// description of which member a given device handed over.
-void convert_yuv420_to_packed(const uint8_t* y_plane,
-                              int32_t y_row_stride,
-                              const uint8_t* u_plane,
-                              const uint8_t* v_plane,
-                              int32_t uv_row_stride,
-                              int32_t uv_pixel_stride,
-                              uint32_t width,
-                              uint32_t height,
-                              uint32_t dst_fourcc,
-                              uint8_t* dst) {
-  const bool to_rgba = (dst_fourcc == FOURCC_RGBA);
-  const size_t dst_row_bytes = static_cast<size_t>(width) * 4u;
-  for (uint32_t row = 0; row < height; ++row) {
-    const uint8_t* y_row = y_plane + static_cast<ptrdiff_t>(y_row_stride) * row;
-    const ptrdiff_t uv_row_offset =
-        static_cast<ptrdiff_t>(uv_row_stride) * static_cast<ptrdiff_t>(row / 2u);
-    const uint8_t* u_row = u_plane + uv_row_offset;
-    const uint8_t* v_row = v_plane + uv_row_offset;
-    uint8_t* out = dst + dst_row_bytes * row;
-    for (uint32_t col = 0; col < width; ++col) {
-      const ptrdiff_t uv_index =
-          static_cast<ptrdiff_t>(uv_pixel_stride) * static_cast<ptrdiff_t>(col / 2u);
-      const int32_t c = static_cast<int32_t>(y_row[col]) - 16;
-      const int32_t d = static_cast<int32_t>(u_row[uv_index]) - 128;
-      const int32_t e = static_cast<int32_t>(v_row[uv_index]) - 128;
-      const uint8_t r = clamp_u8((298 * c + 409 * e + 128) >> 8);
-      const uint8_t g = clamp_u8((298 * c - 100 * d - 208 * e + 128) >> 8);
-      const uint8_t b = clamp_u8((298 * c + 516 * d + 128) >> 8);
-      if (to_rgba) {
-        out[4 * col + 0] = r;
-        out[4 * col + 1] = g;
-        out[4 * col + 2] = b;
-      } else { // BGRA
-        out[4 * col + 0] = b;
-        out[4 * col + 1] = g;
-        out[4 * col + 2] = r;
+void RowBandConversionPool::stop() noexcept {
+  {
+    std::lock_guard<std::mutex> lock(mu_);
+    stop_requested_ = true;
+  }
+  work_cv_.notify_all();
+  for (std::thread& w : workers_) {
+    // Workers only run pure CPU bands and never block inside one, so the
+    // join is bounded by a single band.
+    if (w.joinable()) {
+      w.join();
+    }
+  }
+  workers_.clear();
+  running_.store(false, std::memory_order_release);
+}
+
+bool RowBandConversionPool::drain_(Split& split) noexcept {
+  bool finished_last = false;
+  for (;;) {
+    const uint32_t index = split.next.fetch_add(1, std::memory_order_relaxed);
+    if (index >= split.band_count) {
+      break;
+    }
+    const uint32_t begin = index * split.band_rows;
+    const uint32_t end = std::min(split.rows, begin + split.band_rows);
+    (*split.band)(begin, end);
+    if (split.done.fetch_add(1, std::memory_order_acq_rel) + 1 == split.band_count) {
+      finished_last = true;
+    }
+  }
+  return finished_last;
+}
+
+void RowBandConversionPool::run(uint32_t rows,
+                                uint64_t pixels,
+                                const std::function<void(uint32_t, uint32_t)>& band) noexcept {
+  if (rows == 0) {
+    return;
+  }
+  std::shared_ptr<Split> split;
+  if (running_.load(std::memory_order_acquire) && pixels >= min_pixels_) {
+    std::lock_guard<std::mutex> lock(mu_);
+    if (!stop_requested_ && !current_) {
+      try {
+        split = std::make_shared<Split>();
+      } catch (...) {
+        split.reset();
+      }
+      if (split) {
+        split->band = &band;
+        split->rows = rows;
+        split->band_rows = band_rows_;
+        split->band_count = (rows + band_rows_ - 1) / band_rows_;
+        current_ = split;
+        ++split_generation_;
       }
-      out[4 * col + 3] = 0xFF;
     }
   }
+  if (!split) {
+    band(0, rows);
+    return;
+  }
+
+  work_cv_.notify_all();
+  drain_(*split);
+  {
+    std::unique_lock<std::mutex> lock(mu_);
+    done_cv_.wait(lock, [&split] {
+      return split->done.load(std::memory_order_acquire) == split->band_count;
+    });
+    current_.reset();
+  }
 }
 
-// Copies one acquired YUV_420_888 AImage into dst (width*height*4, requested
-// fourcc). Returns false without touching dst on any shape mismatch, so a
-// device that silently substituted geometry can never be published as if it
-// had honoured the request.
-bool convert_acquired_image(AImage* image,
-                            uint32_t width,
-                            uint32_t height,
-                            uint32_t dst_fourcc,
-                            uint8_t* dst) {
+void RowBandConversionPool::worker_main_() noexcept {
+  apply_current_thread_policy(CBThreadRole::CaptureWorker, "cambang-c2-conv");
+  uint64_t seen_generation = 0;
+  for (;;) {
+    std::shared_ptr<Split> split;
+    {
+      std::unique_lock<std::mutex> lock(mu_);
+      work_cv_.wait(lock, [this, seen_generation] {
+        return stop_requested_ || (current_ && split_generation_ != seen_generation);
+      });
+      if (stop_requested_) {
+        break;
+      }
+      seen_generation = split_generation_;
+      split = current_;
+    }
+    if (drain_(*split)) {
+      // Taking the lock orders this notify after the caller's predicate
+      // check, so the final band's completion cannot be missed.
+      std::lock_guard<std::mutex> lock(mu_);
+      done_cv_.notify_all();
+    }
+  }
+}
+
+// ---------------------------------------------------------------------------
+// Frame conversion (YUV_420_888 -> packed RGBA/BGRA)
+// ---------------------------------------------------------------------------
+
+namespace {
+
+// Plane pointers and strides of one acquired YUV_420_888 AImage, already
+// bounds-checked against the requested geometry.
+struct AcquiredYuv420Planes {
+  const uint8_t* y = nullptr;
+  const uint8_t* u = nullptr;
+  const uint8_t* v = nullptr;
+  size_t y_len = 0;
+  size_t u_len = 0;
+  size_t v_len = 0;
+  int32_t y_row_stride = 0;
+  int32_t uv_row_stride = 0;
+  int32_t uv_pixel_stride = 0;
+};
+
+// Returns false on any shape mismatch, so a device that silently substituted
+// geometry can never be published as if it had honoured the request.
+bool read_acquired_yuv420_planes(AImage* image,
+                                 uint32_t width,
+                                 uint32_t height,
+                                 AcquiredYuv420Planes& out) {
   if (!image) {
     return false;
   }
@@ -269,16 +391,252 @@ bool convert_acquired_image(AImage* image,
   }
   // Bounds check before reading: a driver reporting strides inconsistent with
   // the buffer it handed over must fail the conversion, not walk off the end.
+  const uint32_t chroma_w = (width + 1u) / 2u;
+  const uint32_t chroma_h = (height + 1u) / 2u;
   const int64_t y_needed =
       static_cast<int64_t>(y_row_stride) * (height - 1) + width;
-  const int64_t uv_needed = static_cast<int64_t>(uv_row_stride) * ((height / 2u) - 1) +
-                            static_cast<int64_t>(uv_pixel_stride) * ((width / 2u) - 1) + 1;
+  const int64_t uv_needed = static_cast<int64_t>(uv_row_stride) * (chroma_h - 1) +
+                            static_cast<int64_t>(uv_pixel_stride) * (chroma_w - 1) + 1;
   if (y_len < y_needed || u_len < uv_needed || v_len < uv_needed) {
     return false;
   }
+  out.y = y_data;
+  out.u = u_data;
+  out.v = v_data;
+  out.y_len = static_cast<size_t>(y_len);
+  out.u_len = static_cast<size_t>(u_len);
+  out.v_len = static_cast<size_t>(v_len);
+  out.y_row_stride = y_row_stride;
+  out.uv_row_stride = uv_row_stride;
+  out.uv_pixel_stride = uv_pixel_stride;
+  return true;
+}
+
+// Copies one acquired YUV_420_888 AImage into dst (width*height*4, requested
+// fourcc). Returns false without touching dst on any shape mismatch. With
+// bands, a large image is split across the row-band pool; the call still
+// returns only once every row is written.
+bool convert_acquired_image(AImage* image,
+                            uint32_t width,
+                            uint32_t height,
+                            uint32_t dst_fourcc,
+                            uint8_t* dst,
+                            RowBandConversionPool* bands = nullptr) {
+  AcquiredYuv420Planes p{};
+  if (!read_acquired_yuv420_planes(image, width, height, p)) {
+    return false;
+  }
+  // BT.601 limited ("video") range, the range Camera2 YUV_420_888 output
+  // uses. The strides say which member of the YUV_420_888 family (planar or
+  // semiplanar NV12/NV21) this device handed over.
+  Yuv420Source src{};
+  src.y = p.y;
+  src.u = p.u;
+  src.v = p.v;
+  src.y_row_stride = static_cast<uint32_t>(p.y_row_stride);
+  src.uv_row_stride = static_cast<uint32_t>(p.uv_row_stride);
+  src.uv_pixel_stride = static_cast<uint32_t>(p.uv_pixel_stride);
+  const bool to_rgba = (dst_fourcc == FOURCC_RGBA);
+  const size_t dst_stride = static_cast<size_t>(width) * 4u;
+  if (!bands) {
+    convert_yuv420_rows_to_packed(src, width, 0, height, to_rgba, dst, dst_stride);
+    return true;
+  }
+  const std::function<void(uint32_t, uint32_t)> band = [&](uint32_t begin, uint32_t end) {
+    convert_yuv420_rows_to_packed(src, width, begin, end, to_rgba, dst, dst_stride);
+  };
+  bands->run(height, static_cast<uint64_t>(width) * height, band);
+  return true;
+}
+
+// Tightly packed byte size of one requested stream frame or still in
+// dst_fourcc.
+size_t stream_frame_bytes(uint32_t width, uint32_t height, uint32_t dst_fourcc) {
+  if (is_raw_bayer_fourcc(dst_fourcc)) {
+    return static_cast<size_t>(raw_bayer_row_bytes(dst_fourcc, width)) * height;
+  }
+  const size_t luma = static_cast<size_t>(width) * static_cast<size_t>(height);
+  if (!is_planar_yuv420_fourcc(dst_fourcc)) {
+    return luma * 4u;
+  }
+  const size_t chroma = static_cast<size_t>((width + 1u) / 2u) * ((height + 1u) / 2u);
+  return luma + 2u * chroma;
+}
+
+// Describes on fv the planes of a tightly packed dst_fourcc (NV12/NV21/I420)
+// image starting at base, as repack_acquired_image_planar() lays them out.
+void describe_tight_yuv420_planes(const uint8_t* base,
+                                  uint32_t width,
+                                  uint32_t height,
+                                  uint32_t dst_fourcc,
+                                  FrameView& fv) {
+  const uint32_t chroma_w = (width + 1u) / 2u;
+  const uint32_t chroma_h = (height + 1u) / 2u;
+  const uint8_t* chroma_dst = base + static_cast<size_t>(width) * height;
+  const size_t chroma_plane = static_cast<size_t>(chroma_w) * chroma_h;
+  fv.plane_count = planar_yuv420_plane_count(dst_fourcc);
+  fv.planes[0] = FramePlaneView{base, static_cast<size_t>(width) * height, width};
+  if (dst_fourcc == FOURCC_I420) {
+    fv.planes[1] = FramePlaneView{chroma_dst, chroma_plane, chroma_w};
+    fv.planes[2] = FramePlaneView{chroma_dst + chroma_plane, chroma_plane, chroma_w};
+  } else {
+    fv.planes[1] = FramePlaneView{chroma_dst, chroma_plane * 2u, chroma_w * 2u};
+  }
+}
+
+// Repacks one acquired YUV_420_888 AImage into dst in the tight plane order
+// of dst_fourcc (NV12/NV21/I420) without any colour conversion, and describes
+// the planes on fv. YUV_420_888 leaves chroma interleaving to the device, so
+// the chroma walk honours the reported pixel stride and, where the device's
+// own layout already matches, each row degenerates to a memcpy.
+bool repack_acquired_image_planar(AImage* image,
+                                  uint32_t width,
+                                  uint32_t height,
+                                  uint32_t dst_fourcc,
+                                  uint8_t* dst,
+                                  FrameView& fv) {
+  AcquiredYuv420Planes p{};
+  if (!read_acquired_yuv420_planes(image, width, height, p)) {
+    return false;
+  }
+  const uint32_t chroma_w = (width + 1u) / 2u;
+  const uint32_t chroma_h = (height + 1u) / 2u;
+  uint8_t* y_dst = dst;
+  for (uint32_t row = 0; row < height; ++row) {
+    std::memcpy(y_dst + static_cast<size_t>(row) * width,
+                p.y + static_cast<ptrdiff_t>(p.y_row_stride) * row, width);
+  }
+  uint8_t* chroma_dst = dst + static_cast<size_t>(width) * height;
+  const size_t chroma_plane = static_cast<size_t>(chroma_w) * chroma_h;
+  for (uint32_t row = 0; row < chroma_h; ++row) {
+    const ptrdiff_t src_off = static_cast<ptrdiff_t>(p.uv_row_stride) * row;
+    const uint8_t* u_row = p.u + src_off;
+    const uint8_t* v_row = p.v + src_off;
+    if (dst_fourcc == FOURCC_I420) {
+      uint8_t* u_out = chroma_dst + static_cast<size_t>(row) * chroma_w;
+      uint8_t* v_out = u_out + chroma_plane;
+      if (p.uv_pixel_stride == 1) {
+        std::memcpy(u_out, u_row, chroma_w);
+        std::memcpy(v_out, v_row, chroma_w);
+        continue;
+      }
+      for (uint32_t col = 0; col < chroma_w; ++col) {
+        u_out[col] = u_row[static_cast<ptrdiff_t>(p.uv_pixel_stride) * col];
+        v_out[col] = v_row[static_cast<ptrdiff_t>(p.uv_pixel_stride) * col];
+      }
+      continue;
+    }
+    const uint8_t* first = dst_fourcc == FOURCC_NV12 ? u_row : v_row;
+    const uint8_t* second = dst_fourcc == FOURCC_NV12 ? v_row : u_row;
+    uint8_t* out = chroma_dst + static_cast<size_t>(row) * chroma_w * 2u;
+    if (p.uv_pixel_stride == 2 && second == first + 1) {
+      std::memcpy(out, first, static_cast<size_t>(chroma_w) * 2u - 1u);
+      out[chroma_w * 2u - 1u] = second[2u * (chroma_w - 1u)];
+      continue;
+    }
+    for (uint32_t col = 0; col < chroma_w; ++col) {
+      const ptrdiff_t off = static_cast<ptrdiff_t>(p.uv_pixel_stride) * col;
+      out[2u * col] = first[off];
+      out[2u * col + 1u] = second[off];
+    }
+  }
+
+  describe_tight_yuv420_planes(dst, width, height, dst_fourcc, fv);
+  return true;
+}
+
+// AImageReader format a still of fourcc is read through: the RAW formats as
+// themselves, everything else as YUV_420_888 for the listener to repack or
+// convert.
+int32_t still_reader_format(uint32_t fourcc) {
+  if (fourcc == FOURCC_RAW16) return AIMAGE_FORMAT_RAW16;
+  if (fourcc == FOURCC_RAW10) return AIMAGE_FORMAT_RAW10;
+  return AIMAGE_FORMAT_YUV_420_888;
+}
+
+// Copies the single plane of an acquired RAW16/RAW10 AImage into dst as
+// tightly packed rows of raw_bayer_row_bytes(), byte for byte: the samples
+// are never unpacked, demosaiced or scaled. Only the device's row padding is
+// dropped, and an unpadded image is one memcpy. Returns false without
+// touching dst on any shape mismatch.
+bool copy_acquired_image_raw(AImage* image,
+                             uint32_t width,
+                             uint32_t height,
+                             uint32_t dst_fourcc,
+                             uint8_t* dst) {
+  if (!image) {
+    return false;
+  }
+  int32_t img_w = 0, img_h = 0, img_format = 0;
+  if (AImage_getWidth(image, &img_w) != AMEDIA_OK ||
+      AImage_getHeight(image, &img_h) != AMEDIA_OK ||
+      AImage_getFormat(image, &img_format) != AMEDIA_OK) {
+    return false;
+  }
+  const size_t row_bytes = raw_bayer_row_bytes(dst_fourcc, width);
+  if (row_bytes == 0 || static_cast<uint32_t>(img_w) != width ||
+      static_cast<uint32_t>(img_h) != height || img_format != still_reader_format(dst_fourcc)) {
+    return false;
+  }
+  uint8_t* data = nullptr;
+  int len = 0;
+  int32_t row_stride = 0;
+  if (AImage_getPlaneData(image, 0, &data, &len) != AMEDIA_OK ||
+      AImage_getPlaneRowStride(image, 0, &row_stride) != AMEDIA_OK || !data ||
+      row_stride <= 0 || static_cast<size_t>(row_stride) < row_bytes) {
+    return false;
+  }
+  const int64_t needed = static_cast<int64_t>(row_stride) * (height - 1) +
+                         static_cast<int64_t>(row_bytes);
+  if (len < needed) {
+    return false;
+  }
+  if (static_cast<size_t>(row_stride) == row_bytes) {
+    std::memcpy(dst, data, row_bytes * height);
+    return true;
+  }
+  for (uint32_t row = 0; row < height; ++row) {
+    std::memcpy(dst + row_bytes * row, data + static_cast<ptrdiff_t>(row_stride) * row, row_bytes);
+  }
+  return true;
+}
 
-  convert_yuv420_to_packed(y_data, y_row_stride, u_data, v_data, uv_row_stride,
-                           uv_pixel_stride, width, height, dst_fourcc, dst);
+// Describes on fv the planes of image itself when the device's YUV_420_888
+// layout already is dst_fourcc's: separate chroma planes with a unit pixel
+// stride for I420, or chroma interleaved in NV12 (U first) or NV21 (V first)
+// order. Rows keep the device's strides, which Core's planar retention
+// honours. False for any other layout, which must be repacked instead.
+bool describe_acquired_image_planes_in_place(AImage* image,
+                                             uint32_t width,
+                                             uint32_t height,
+                                             uint32_t dst_fourcc,
+                                             FrameView& fv) {
+  AcquiredYuv420Planes p{};
+  if (!read_acquired_yuv420_planes(image, width, height, p)) {
+    return false;
+  }
+  const auto y_stride = static_cast<uint32_t>(p.y_row_stride);
+  const auto uv_stride = static_cast<uint32_t>(p.uv_row_stride);
+  if (dst_fourcc == FOURCC_I420) {
+    if (p.uv_pixel_stride != 1) {
+      return false;
+    }
+    fv.plane_count = 3;
+    fv.planes[1] = FramePlaneView{p.u, p.u_len, uv_stride};
+    fv.planes[2] = FramePlaneView{p.v, p.v_len, uv_stride};
+  } else {
+    const uint8_t* first = dst_fourcc == FOURCC_NV12 ? p.u : p.v;
+    const uint8_t* second = dst_fourcc == FOURCC_NV12 ? p.v : p.u;
+    const size_t second_len = dst_fourcc == FOURCC_NV12 ? p.v_len : p.u_len;
+    if (p.uv_pixel_stride != 2 || second != first + 1) {
+      return false;
+    }
+    // The interleaved plane runs from its first byte to the end of the
+    // other chroma plane, which is the same memory one byte on.
+    fv.plane_count = 2;
+    fv.planes[1] = FramePlaneView{first, second_len + 1u, uv_stride};
+  }
+  fv.planes[0] = FramePlaneView{p.y, p.y_len, y_stride};
   return true;
 }
 
@@ -305,6 +663,12 @@ struct StaticCharacteristics {
 
   bool is_logical_multi_camera = false;
 
+  // ACAMERA_INFO_SUPPORTED_HARDWARE_LEVEL is LIMITED or better, whose
+  // guaranteed stream combinations include a preview-size YUV stream with a
+  // maximum-size still in one session: a still then rides the running session
+  // and preview need not pause for it. LEGACY and EXTERNAL promise no such pair.
+  bool still_alongside_preview = false;
+
   // Device-constant optics: reported only when the device offers exactly one
   // possible value, which is Camera2's way of describing a prime lens or a
   // fixed iris. More than one value means the quantity is per-capture and
@@ -377,6 +741,12 @@ struct StaticCharacteristics {
   // result omits ACAMERA_DISTORTION_CORRECTION_MODE.
   bool distortion_correction_supported = false;
 
+  // ResultFactTag groups a capture result is read for: the ones the device
+  // lists in ACAMERA_REQUEST_AVAILABLE_RESULT_KEYS (all of them when it lists
+  // none) and something here consumes -- focus distance only when it is
+  // metric, calibration only with an array to express it in.
+  uint32_t result_fact_tags = 0;
+
   // Output geometries the device actually supports for YUV_420_888.
   std::vector<std::pair<uint32_t, uint32_t>> supported_yuv_sizes;
 
@@ -389,6 +759,34 @@ struct StaticCharacteristics {
     return false;
   }
 
+  // RAW_SENSOR / RAW10 output geometries, offered for stills only, and what a
+  // consumer needs to read the samples: the colour filter arrangement and the
+  // black/white levels (ACAMERA_SENSOR_INFO_COLOR_FILTER_ARRANGEMENT,
+  // ACAMERA_SENSOR_BLACK_LEVEL_PATTERN, ACAMERA_SENSOR_INFO_WHITE_LEVEL).
+  std::vector<std::pair<uint32_t, uint32_t>> supported_raw16_sizes;
+  std::vector<std::pair<uint32_t, uint32_t>> supported_raw10_sizes;
+  bool has_color_filter_arrangement = false;
+  uint8_t color_filter_arrangement = 0;
+  bool has_black_level_pattern = false;
+  int32_t black_level_pattern[4] = {0, 0, 0, 0};
+  bool has_white_level = false;
+  int32_t white_level = 0;
+
+  // Whether a still of format_fourcc can be delivered at w x h: a RAW size
+  // for the RAW formats, else a YUV_420_888 one.
+  bool supports_still_size(uint32_t format_fourcc, uint32_t w, uint32_t h) const noexcept {
+    if (!is_raw_bayer_fourcc(format_fourcc)) {
+      return supports_size(w, h);
+    }
+    const auto& sizes = format_fourcc == FOURCC_RAW16 ? supported_raw16_sizes : supported_raw10_sizes;
+    for (const auto& size : sizes) {
+      if (size.first == w && size.second == h) {
+        return true;
+      }
+    }
+    return false;
+  }
+
   // Per format/size minimum frame duration. Camera2 defines a session's floor
   // as the max over its configured outputs, so this is the hardware limit for
   // one output, not necessarily the limit the session will run at.
@@ -396,6 +794,8 @@ struct StaticCharacteristics {
     uint32_t width = 0;
     uint32_t height = 0;
     int64_t min_frame_duration_ns = 0;
+
+    bool operator==(const YuvMinDuration&) const = default;
   };
   std::vector<YuvMinDuration> yuv_min_frame_durations;
   bool has_max_frame_duration = false;
@@ -410,6 +810,8 @@ struct StaticCharacteristics {
     }
     return 0;
   }
+
+  bool operator==(const StaticCharacteristics&) const = default;
 };
 
 // Realized capture-result facts for exactly one still member. Every field is
@@ -458,6 +860,43 @@ struct ResultFacts {
   int64_t frame_duration_ns = 0;
 };
 
+// Which ResultFacts groups a capture result is read for, one bit per group.
+// StaticCharacteristics::result_fact_tags is what the device reports and Core
+// consumes, decided once at open; anything outside it is never looked up.
+enum ResultFactTag : uint32_t {
+  kResultFactSensorTimestamp = 1u << 0,
+  kResultFactExposure = 1u << 1,       // exposure time and sensitivity
+  kResultFactAperture = 1u << 2,
+  kResultFactFocalLength = 1u << 3,
+  kResultFactFocusDistance = 1u << 4,
+  kResultFactAeCompensation = 1u << 5,
+  kResultFactCalibration = 1u << 6,    // intrinsics, distortion, correction mode
+  // Burst diagnostics only: logged for bracket members, never published.
+  kResultFactAfState = 1u << 7,
+  kResultFactFrameDuration = 1u << 8,
+};
+inline constexpr uint32_t kResultFactDiagnostics = kResultFactAfState | kResultFactFrameDuration;
+inline constexpr uint32_t kResultFactAll = (1u << 9) - 1u;
+
+// The group a result key belongs to, or 0 for a key no group reads.
+inline uint32_t result_fact_tag_for_key(uint32_t key) noexcept {
+  switch (key) {
+    case ACAMERA_SENSOR_TIMESTAMP: return kResultFactSensorTimestamp;
+    case ACAMERA_SENSOR_EXPOSURE_TIME:
+    case ACAMERA_SENSOR_SENSITIVITY: return kResultFactExposure;
+    case ACAMERA_LENS_APERTURE: return kResultFactAperture;
+    case ACAMERA_LENS_FOCAL_LENGTH: return kResultFactFocalLength;
+    case ACAMERA_LENS_FOCUS_DISTANCE: return kResultFactFocusDistance;
+    case ACAMERA_CONTROL_AE_EXPOSURE_COMPENSATION: return kResultFactAeCompensation;
+    case ACAMERA_LENS_INTRINSIC_CALIBRATION:
+    case ACAMERA_LENS_DISTORTION:
+    case ACAMERA_DISTORTION_CORRECTION_MODE: return kResultFactCalibration;
+    case ACAMERA_CONTROL_AF_STATE: return kResultFactAfState;
+    case ACAMERA_SENSOR_FRAME_DURATION: return kResultFactFrameDuration;
+    default: return 0;
+  }
+}
+
 // True for the AF states that mean the lens has stopped moving and the result
 // is a settled position rather than a point on a scan.
 inline bool af_state_is_settled(uint8_t af_state) noexcept {
@@ -465,6 +904,27 @@ inline bool af_state_is_settled(uint8_t af_state) noexcept {
          af_state == ACAMERA_CONTROL_AF_STATE_NOT_FOCUSED_LOCKED;
 }
 
+// AImage lease-through accounting for one stream reader. A planar stream
+// frame whose device layout already is the requested one (see
+// describe_acquired_image_planes_in_place) is posted with its planes inside
+// the acquired AImage, which stays acquired until Core releases the frame,
+// instead of being repacked into a pool slot first.
+//
+// Leased images count against the reader's maxImages and
+// AImageReader_acquireLatestImage needs two free images to skip ahead, so
+// at most max_outstanding images are leased at once; past that a frame takes
+// the repack path. FrameView.release may run on any thread after the session
+// is torn down, so the reader is deleted by whichever of teardown and the
+// last outstanding lease's release comes last (retire_stream_reader):
+// a leased image is never returned to a deleted reader.
+struct StreamImageLeases {
+  std::mutex m;
+  size_t max_outstanding = 0;
+  size_t outstanding = 0;
+  // Set by teardown when leases were outstanding; the last release deletes it.
+  AImageReader* retired_reader = nullptr;
+};
+
 struct StreamProduction {
   uint64_t stream_id = 0;
   uint64_t device_instance_id = 0;
@@ -476,16 +936,60 @@ struct StreamProduction {
   uint64_t frames_posted = 0;
   uint64_t convert_failures = 0;
 
+  size_t frame_bytes = 0;
+  // Sensor frame period the profile asks for: the work-duration target of
+  // the device's stream hint session (DeviceBackend::stream_hint).
+  int64_t frame_period_ns = 0;
+
+  // In-flight frame token. bytes is the Core-pooled payload buffer drawn for
+  // the frame holding the slot; it is published as cpu_payload_owner and
+  // dropped on release, so a retained result recycles it on its own.
   struct BufferSlot {
-    std::vector<uint8_t> bytes;
+    std::shared_ptr<CpuPayloadBytes> bytes;
     std::atomic<bool> in_use{false};
   };
   std::vector<std::shared_ptr<BufferSlot>> pool;
   size_t cursor = 0;
 
+  // Adaptive pool depth. Slots hold no storage of their own, but each one in
+  // flight pins a full frame of Core-pooled bytes, so growth is bounded by
+  // kMaxPoolBytes as well as kMaxPoolSlots. The pool grows by one slot
+  // whenever a frame would otherwise be dropped for exhaustion, and shrinks
+  // towards the peak in-flight depth seen over each kShrinkWindowFrames
+  // (plus kShrinkHeadroom) without going below min_pool_slots.
+  static constexpr size_t kMaxPoolSlots = 32;
+  static constexpr size_t kMaxPoolBytes = size_t{192} << 20;
+  static constexpr uint64_t kShrinkWindowFrames = 256;
+  static constexpr size_t kShrinkHeadroom = 2;
+  size_t min_pool_slots = 0;
+
   // Guarded by DeviceBackend::m.
   bool producing = false;
   uint64_t pool_exhausted_drops = 0;
+  uint64_t congested_skips = 0;
+  uint64_t pool_resizes = 0;
+  size_t window_peak_in_flight = 0;
+  uint64_t window_frames = 0;
+
+  // Pool telemetry: one FrameBufferLease native object per started pool. A
+  // resize reports its new depth as a counters update on the same record
+  // rather than retiring it. Guarded by DeviceBackend::m.
+  uint64_t root_id = 0;
+  uint64_t provider_native_id = 0;
+  uint64_t pool_native_id = 0;
+
+  size_t max_pool_slots() const noexcept {
+    const size_t by_bytes = frame_bytes == 0 ? kMaxPoolSlots : kMaxPoolBytes / frame_bytes;
+    return std::max(min_pool_slots, std::min(kMaxPoolSlots, by_bytes));
+  }
+
+  // Floors the pool at Core's in-flight depth for the stream
+  // (ICameraProvider::set_stream_pool_depth_hint()), within the byte bound
+  // and never below base_slots.
+  void apply_pool_depth_hint(size_t base_slots, uint32_t in_flight_frames) noexcept {
+    min_pool_slots = base_slots;
+    min_pool_slots = std::max(base_slots, std::min<size_t>(in_flight_frames, max_pool_slots()));
+  }
 };
 
 // Collector for one in-flight burst (a burst of one is the ordinary single
@@ -507,14 +1011,22 @@ struct BurstCollector {
   uint32_t fourcc = 0;
 
   struct Image {
-    std::shared_ptr<std::vector<uint8_t>> bytes;
+    std::shared_ptr<CpuPayloadBytes> bytes;
     bool has_timestamp = false;
     int64_t timestamp_ns = 0;
   };
   std::vector<Image> images;      // arrival order == capture order
   size_t failed_count = 0;        // onCaptureFailed, per member
-  std::vector<ResultFacts> results_in_order;      // results with no timestamp
-  std::map<int64_t, ResultFacts> results_by_time; // results keyed by sensor ts
+
+  // ResultFactTag groups read out of each result (see
+  // StaticCharacteristics::result_fact_tags).
+  uint32_t fact_tags = 0;
+  // Results in arrival order, in a pool reserve()d for every member when the
+  // collector is built, so the result callback never allocates. A result
+  // with a sensor timestamp is paired with its image by that timestamp; one
+  // without can only be paired positionally. Results past the pool's
+  // capacity belong to no member and are dropped.
+  std::vector<ResultFacts> results;
 
   bool settled() const {
     return images.size() + failed_count >= expected;
@@ -529,6 +1041,9 @@ struct DeviceBackend;
 // released after ACameraDevice_close, which guarantees callback quiescence).
 struct ListenerCtx {
   std::weak_ptr<DeviceBackend> backend;
+  // Stream reader contexts only: the DeviceBackend::stream_outputs entry
+  // whose reader this context was registered on.
+  size_t stream_output_index = 0;
 };
 
 struct DeviceBackend : std::enable_shared_from_this<DeviceBackend> {
@@ -546,27 +1061,49 @@ struct DeviceBackend : std::enable_shared_from_this<DeviceBackend> {
   ACameraCaptureSession* session = nullptr;
   ACaptureSessionOutputContainer* output_container = nullptr;
 
-  ACaptureSessionOutput* stream_output = nullptr;
+  // One stream output of the realized session, per sibling stream.
+  struct StreamOutput {
+    StreamOutputSpec spec{};
+    AImageReader* reader = nullptr;
+    // Created with reader and cleared with it; null means no lease.
+    std::shared_ptr<StreamImageLeases> image_leases;
+    ANativeWindow* window = nullptr;
+    ACaptureSessionOutput* output = nullptr;
+    // Non-null while repeating_request targets this output.
+    ACameraOutputTarget* target = nullptr;
+  };
+
   ACaptureSessionOutput* still_output = nullptr;
-  AImageReader* stream_reader = nullptr;
   AImageReader* still_reader = nullptr;
-  ANativeWindow* stream_window = nullptr;
   ANativeWindow* still_window = nullptr;
-  ACameraOutputTarget* stream_target = nullptr;
   ACaptureRequest* repeating_request = nullptr;
 
-  // Currently realized session output set.
-  bool cfg_has_stream = false;
-  uint32_t cfg_stream_w = 0;
-  uint32_t cfg_stream_h = 0;
+  // Still requests reused across captures, one per burst position. Touched
+  // only on the control thread (capture_burst_'s submit job and session
+  // teardown), so they need no lock. A request is rebuilt when the still
+  // window changes or its position's request_shape() differs; otherwise a
+  // capture only rewrites the entry values in place. Freed with the session.
+  struct CachedStillRequest {
+    ACaptureRequest* request = nullptr;
+    ACameraOutputTarget* target = nullptr;
+    uint8_t shape = 0;
+  };
+  std::vector<CachedStillRequest> still_requests;
+  ANativeWindow* still_requests_window = nullptr;
+
+  // Currently realized session output set. stream_outputs[i] reads through
+  // stream_reader_ctxs[i].
+  std::vector<StreamOutput> stream_outputs;
   bool cfg_has_still = false;
   uint32_t cfg_still_w = 0;
   uint32_t cfg_still_h = 0;
+  // AImageReader format of the still output (see still_reader_format()).
+  int32_t cfg_still_reader_format = AIMAGE_FORMAT_YUV_420_888;
   bool repeating_active = false;
 
   std::unique_ptr<ListenerCtx> device_ctx;
   std::unique_ptr<ListenerCtx> session_ctx;
-  std::unique_ptr<ListenerCtx> stream_reader_ctx;
+  std::unique_ptr<ListenerCtx> stream_reader_ctxs[kMaxSessionStreams];
   std::unique_ptr<ListenerCtx> still_reader_ctx;
   std::unique_ptr<ListenerCtx> capture_ctx;
   // Separate from capture_ctx on purpose: the repeating request's results
@@ -588,20 +1125,74 @@ struct DeviceBackend : std::enable_shared_from_this<DeviceBackend> {
   uint64_t root_id = 0;
   uint64_t acquisition_session_id = 0; // core-issued native id once realized
   CBProviderStrand* strand = nullptr;  // provider outlives all backends
+  ProviderBoundCallbacks* callbacks = nullptr;  // likewise; payload buffer / backpressure queries only
+  RowBandConversionPool* still_conversion = nullptr; // likewise provider-owned
+  std::atomic<uint64_t>* producer_frames_dropped = nullptr; // likewise
 
   StaticCharacteristics chars{};
 
   bool closed = false; // set before Camera2 objects are released
   bool failed = false;
+  // True from open_device() until the open worker's openCamera settles:
+  // device set, or the failure latched in open_error. open_cv wakes waiters.
+  bool open_pending = false;
+  ProviderError open_error = ProviderError::OK;
+  std::condition_variable open_cv;
+  // The Device native object is created only once the camera is open; its id
+  // is issued up front by open_device().
+  uint64_t device_native_id = 0;
+  bool device_native_created = false;
   std::atomic<uint64_t> image_arrived_count{0};
   // Still images delivered while no burst was collecting. Non-zero is normal
   // (AF trigger submissions produce one each); a jump across a capture would
   // mean one landed inside a collector and displaced a real member.
   std::atomic<uint64_t> stray_still_images{0};
 
-  std::shared_ptr<StreamProduction> stream;
+  // Production state of each started (or stopped, not yet destroyed)
+  // stream; key: stream_id.
+  std::map<uint64_t, std::shared_ptr<StreamProduction>> streams;
   std::shared_ptr<BurstCollector> burst; // non-null only during a capture
 
+  // Work-duration hints for the stream frame path of this device: the image
+  // listener thread, which converts every frame, and the strand worker that
+  // carries it on to Core. Opened on the first frame (the listener thread is
+  // only known then), closed with the session. Not retried after a refusal
+  // until the next session.
+  CBPerformanceHintSession stream_hint;
+  int32_t stream_hint_listener_tid = 0;
+  bool stream_hint_refused = false;
+
+  StreamProduction* find_stream_locked(uint64_t stream_id) const {
+    const auto it = streams.find(stream_id);
+    return it == streams.end() ? nullptr : it->second.get();
+  }
+
+  bool any_stream_producing_locked() const {
+    for (const auto& [stream_id, production] : streams) {
+      (void)stream_id;
+      if (production && production->producing) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  // Caller holds m through lock. False when the open is still in flight
+  // after timeout_ms.
+  bool wait_open_settled(std::unique_lock<std::mutex>& lock, uint32_t timeout_ms) {
+    return open_cv.wait_for(lock, std::chrono::milliseconds(timeout_ms),
+                            [this] { return !open_pending; });
+  }
+
+  std::vector<StreamOutputSpec> configured_stream_specs_locked() const {
+    std::vector<StreamOutputSpec> specs;
+    specs.reserve(stream_outputs.size());
+    for (const StreamOutput& out : stream_outputs) {
+      specs.push_back(out.spec);
+    }
+    return specs;
+  }
+
   // Caller holds m. Latches backend failure and posts the truthful facts.
   void latch_failure_locked(ProviderError error) {
     if (failed) {
@@ -610,15 +1201,70 @@ struct DeviceBackend : std::enable_shared_from_this<DeviceBackend> {
     failed = true;
     if (strand) {
       strand->post_device_error(device_instance_id, error);
-      if (stream && stream->producing) {
-        stream->producing = false;
-        strand->post_stream_error(stream->stream_id, error);
-        strand->post_stream_stopped(stream->stream_id, error);
+      for (auto& [stream_id, production] : streams) {
+        if (production && production->producing) {
+          production->producing = false;
+          strand->post_stream_error(stream_id, error);
+          strand->post_stream_stopped(stream_id, error);
+        }
       }
     }
   }
 };
 
+// Stream pool telemetry (see StreamProduction). Caller holds backend.m.
+void retire_stream_pool_record_locked(DeviceBackend& backend, StreamProduction& s) {
+  if (s.pool_native_id == 0 || !backend.strand || !backend.callbacks) {
+    s.pool_native_id = 0;
+    return;
+  }
+  NativeObjectDestroyInfo info{};
+  info.native_id = std::exchange(s.pool_native_id, 0);
+  info.has_destroyed_ns = true;
+  info.destroyed_ns = backend.callbacks->core_monotonic_now_ns();
+  backend.strand->post_native_object_destroyed(info);
+}
+
+void report_stream_pool_record_locked(DeviceBackend& backend, StreamProduction& s) {
+  retire_stream_pool_record_locked(backend, s);
+  if (!backend.strand || !backend.callbacks) {
+    return;
+  }
+  NativeObjectCreateInfo info{};
+  info.native_id = backend.callbacks->allocate_native_id(NativeObjectType::FrameBufferLease);
+  if (info.native_id == 0) {
+    return;
+  }
+  info.type = static_cast<uint32_t>(NativeObjectType::FrameBufferLease);
+  info.root_id = s.root_id;
+  info.owner_device_instance_id = s.device_instance_id;
+  info.owner_acquisition_session_id = s.acquisition_session_id;
+  info.owner_stream_id = s.stream_id;
+  info.owner_provider_native_id = s.provider_native_id;
+  info.has_created_ns = true;
+  info.created_ns = backend.callbacks->core_monotonic_now_ns();
+  info.buffers_in_use = static_cast<uint32_t>(s.pool.size());
+  info.bytes_allocated = static_cast<uint64_t>(s.pool.size()) * s.frame_bytes;
+  s.pool_native_id = info.native_id;
+  backend.strand->post_native_object_created(info);
+}
+
+// A resized pool: new counters on the existing record, or a first record.
+void update_stream_pool_record_locked(DeviceBackend& backend, StreamProduction& s) {
+  if (s.pool_native_id == 0) {
+    report_stream_pool_record_locked(backend, s);
+    return;
+  }
+  if (!backend.strand) {
+    return;
+  }
+  NativeObjectCountersUpdate update{};
+  update.native_id = s.pool_native_id;
+  update.buffers_in_use = static_cast<uint32_t>(s.pool.size());
+  update.bytes_allocated = static_cast<uint64_t>(s.pool.size()) * s.frame_bytes;
+  backend.strand->post_native_object_counters(update);
+}
+
 // Frame release leases: FrameView.release must stay valid on any thread and
 // with any provider-side storage teardown ordering, so each posted frame owns
 // its backing through a heap lease (matches SyntheticProvider's pattern).
@@ -627,7 +1273,12 @@ struct StreamFrameLease {
 };
 
 struct CaptureFrameLease {
-  std::shared_ptr<std::vector<uint8_t>> bytes;
+  std::shared_ptr<CpuPayloadBytes> bytes;
+};
+
+struct StreamImageLease {
+  std::shared_ptr<StreamImageLeases> leases;
+  AImage* image = nullptr;
 };
 
 namespace {
@@ -636,6 +1287,7 @@ void release_stream_frame(void* user, const FrameView* /*frame*/) {
   auto* lease = static_cast<StreamFrameLease*>(user);
   if (!lease) return;
   if (lease->slot) {
+    lease->slot->bytes.reset();
     lease->slot->in_use.store(false, std::memory_order_release);
   }
   delete lease;
@@ -645,6 +1297,38 @@ void release_capture_frame(void* user, const FrameView* /*frame*/) {
   delete static_cast<CaptureFrameLease*>(user);
 }
 
+void release_stream_image_frame(void* user, const FrameView* /*frame*/) {
+  auto* lease = static_cast<StreamImageLease*>(user);
+  if (!lease) return;
+  AImage_delete(lease->image);
+  AImageReader* retired_reader = nullptr;
+  {
+    std::lock_guard<std::mutex> ll(lease->leases->m);
+    if (--lease->leases->outstanding == 0) {
+      retired_reader = std::exchange(lease->leases->retired_reader, nullptr);
+    }
+  }
+  if (retired_reader) {
+    AImageReader_delete(retired_reader);
+  }
+  delete lease;
+}
+
+// Deletes a torn-down stream reader now, or hands it to the last outstanding
+// image lease (see StreamImageLeases). The reader's listener must already be
+// cleared.
+void retire_stream_reader(AImageReader* reader, const std::shared_ptr<StreamImageLeases>& leases) {
+  if (!reader) return;
+  if (leases) {
+    std::lock_guard<std::mutex> ll(leases->m);
+    if (leases->outstanding != 0) {
+      leases->retired_reader = reader;
+      return;
+    }
+  }
+  AImageReader_delete(reader);
+}
+
 // Acquisition timing from AImage_getTimestamp, which carries the Camera2
 // SENSOR_TIMESTAMP for that exact image: nanoseconds, marking the start of
 // exposure of the first row.
@@ -677,14 +1361,168 @@ std::optional<SourcedFact<ImageAcquisitionTiming>> make_acquisition_timing(
   return SourcedFact<ImageAcquisitionTiming>{*timing, FactOrigin::NATIVE_REPORTED};
 }
 
-// Routes one arrived stream image into the repeating stream pool. Caller
-// holds backend.m. Still captures never come through here; they have their
-// own reader and waiter.
-void deliver_stream_image_locked(DeviceBackend& backend, AImage* image) {
-  StreamProduction* s = backend.stream.get();
-  if (!s || !s->producing || !backend.strand) {
+// Tracks the in-flight peak for the current window and, once per window,
+// trims idle slots the peak shows are not needed. Only free slots are
+// removed; a slot still leased to Core leaves with its lease. Caller holds
+// backend.m.
+void note_stream_pool_depth_locked(DeviceBackend& backend, StreamProduction& s) {
+  size_t in_flight = 0;
+  for (const auto& slot : s.pool) {
+    if (slot->in_use.load(std::memory_order_acquire)) {
+      ++in_flight;
+    }
+  }
+  s.window_peak_in_flight = std::max(s.window_peak_in_flight, in_flight);
+  if (++s.window_frames < StreamProduction::kShrinkWindowFrames) {
+    return;
+  }
+  const size_t target = std::max(s.min_pool_slots,
+                                 s.window_peak_in_flight + StreamProduction::kShrinkHeadroom);
+  s.window_frames = 0;
+  s.window_peak_in_flight = 0;
+  if (s.pool.size() <= target) {
+    return;
+  }
+  size_t kept = 0;
+  for (size_t i = 0; i < s.pool.size(); ++i) {
+    const bool removable = s.pool.size() - (i - kept) > target &&
+                           !s.pool[i]->in_use.load(std::memory_order_acquire);
+    if (!removable) {
+      s.pool[kept++] = std::move(s.pool[i]);
+    }
+  }
+  if (kept == s.pool.size()) {
+    return;
+  }
+  s.pool.resize(kept);
+  s.cursor = 0;
+  ++s.pool_resizes;
+  update_stream_pool_record_locked(backend, s);
+}
+
+// Reports one stream frame's listener work (acquire through post) to the
+// device's hint session, opening it against the shortest producing frame
+// period. Caller holds backend.m, on the image listener thread.
+void report_stream_frame_work_locked(DeviceBackend& backend, int64_t work_ns) {
+  int64_t target_ns = 0;
+  for (const auto& [stream_id, production] : backend.streams) {
+    (void)stream_id;
+    if (production && production->producing && production->frame_period_ns > 0 &&
+        (target_ns == 0 || production->frame_period_ns < target_ns)) {
+      target_ns = production->frame_period_ns;
+    }
+  }
+  if (target_ns == 0) {
     return;
   }
+  const int32_t listener_tid = current_os_thread_id();
+  if (!backend.stream_hint.active() || backend.stream_hint_listener_tid != listener_tid) {
+    if (backend.stream_hint_refused) {
+      return;
+    }
+    const int32_t tids[2] = {
+        listener_tid,
+        backend.strand ? backend.strand->worker_os_thread_id() : 0,
+    };
+    if (!backend.stream_hint.open(tids, 2, target_ns)) {
+      backend.stream_hint_refused = true;
+      return;
+    }
+    backend.stream_hint_listener_tid = listener_tid;
+  }
+  backend.stream_hint.update_target(target_ns);
+  backend.stream_hint.report_actual(work_ns);
+}
+
+// Posts image as a lease-through frame when its layout and the lease budget
+// of its reader allow (see StreamImageLeases). True when the image now
+// belongs to the frame. Caller holds backend.m.
+bool post_stream_image_in_place_locked(DeviceBackend& backend,
+                                       const std::shared_ptr<StreamImageLeases>& leases,
+                                       StreamProduction& s,
+                                       AImage* image) {
+  if (!leases || !is_planar_yuv420_fourcc(s.fourcc)) {
+    return false;
+  }
+  FrameView fv{};
+  if (!describe_acquired_image_planes_in_place(image, s.width, s.height, s.fourcc, fv)) {
+    return false;
+  }
+  {
+    std::lock_guard<std::mutex> ll(leases->m);
+    if (leases->outstanding >= leases->max_outstanding) {
+      return false;
+    }
+    ++leases->outstanding;
+  }
+  StreamImageLease* lease = nullptr;
+  try {
+    lease = new StreamImageLease{leases, image};
+  } catch (...) {
+    std::lock_guard<std::mutex> ll(leases->m);
+    --leases->outstanding;
+    return false;
+  }
+  ++s.frames_posted;
+
+  int64_t timestamp_ns = -1;
+  if (AImage_getTimestamp(image, &timestamp_ns) != AMEDIA_OK) {
+    timestamp_ns = -1;
+  }
+  fv.device_instance_id = s.device_instance_id;
+  fv.stream_id = s.stream_id;
+  fv.acquisition_session_id = s.acquisition_session_id;
+  fv.capture_id = 0;
+  fv.width = s.width;
+  fv.height = s.height;
+  fv.format_fourcc = s.fourcc;
+  if (timestamp_ns >= 0) {
+    fv.acquisition_timing =
+        make_acquisition_timing(timestamp_ns, backend.chars.timestamp_source_realtime);
+  }
+  fv.data = fv.planes[0].data;
+  fv.size_bytes = fv.planes[0].size_bytes;
+  fv.stride_bytes = fv.planes[0].row_stride_bytes;
+  fv.requested_retained_plan = s.plan;
+  fv.release = &release_stream_image_frame;
+  fv.release_user = lease;
+  backend.strand->post_frame(fv);
+  return true;
+}
+
+// Routes one image arrived on stream output output_index into its stream's
+// pool. Caller holds backend.m. Still captures never come through here; they
+// have their own reader and waiter. True when image was leased to the posted
+// frame, in which case the caller must not delete it.
+bool deliver_stream_image_locked(DeviceBackend& backend,
+                                 size_t output_index,
+                                 const AImageReader* reader,
+                                 AImage* image) {
+  // A reader from a torn-down session can still be draining its last
+  // callback; only the output it was registered for may take the image.
+  if (output_index >= backend.stream_outputs.size() ||
+      backend.stream_outputs[output_index].reader != reader) {
+    return false;
+  }
+  const DeviceBackend::StreamOutput& output = backend.stream_outputs[output_index];
+  StreamProduction* s = backend.find_stream_locked(output.spec.stream_id);
+  if (!s || !s->producing || !backend.strand) {
+    return false;
+  }
+  // Core would drop or coalesce this frame away; skip the pool slot and the
+  // conversion. The caller returns the AImage either way.
+  if (backend.callbacks && backend.callbacks->is_stream_ingress_congested(s->stream_id)) {
+    ++s->congested_skips;
+    if ((s->congested_skips & (s->congested_skips - 1)) == 0) {
+      log_line("stream=%llu skipped frame while core ingress congested (skips=%llu)",
+               static_cast<unsigned long long>(s->stream_id),
+               static_cast<unsigned long long>(s->congested_skips));
+    }
+    return false;
+  }
+  if (post_stream_image_in_place_locked(backend, output.image_leases, *s, image)) {
+    return true;
+  }
 
   std::shared_ptr<StreamProduction::BufferSlot> slot;
   const size_t n = s->pool.size();
@@ -700,17 +1538,63 @@ void deliver_stream_image_locked(DeviceBackend& backend, AImage* image) {
       break;
     }
   }
+  if (!slot && n < s->max_pool_slots()) {
+    // Core is holding frames longer than the pool allows for: deepen it
+    // rather than drop. The new slot is claimed before it is published.
+    try {
+      auto grown = std::make_shared<StreamProduction::BufferSlot>();
+      grown->in_use.store(true, std::memory_order_relaxed);
+      s->pool.push_back(grown);
+      slot = std::move(grown);
+    } catch (...) {
+      slot.reset();
+    }
+    if (slot) {
+      s->cursor = 0;
+      ++s->pool_resizes;
+      update_stream_pool_record_locked(backend, *s);
+    }
+  }
   if (!slot) {
     ++s->pool_exhausted_drops;
+    if (backend.producer_frames_dropped) {
+      backend.producer_frames_dropped->fetch_add(1, std::memory_order_relaxed);
+    }
     if ((s->pool_exhausted_drops & (s->pool_exhausted_drops - 1)) == 0) {
-      log_line("stream=%llu frame pool exhausted (drops=%llu)",
-               static_cast<unsigned long long>(s->stream_id),
+      log_line("stream=%llu frame pool exhausted at %zu slots (drops=%llu)",
+               static_cast<unsigned long long>(s->stream_id), s->pool.size(),
                static_cast<unsigned long long>(s->pool_exhausted_drops));
     }
-    return; // repeating frames are lossy
+    return false; // repeating frames are lossy
+  }
+  note_stream_pool_depth_locked(backend, *s);
+
+  const bool planar = is_planar_yuv420_fourcc(s->fourcc);
+  CpuPayloadBufferKey payload_key{};
+  payload_key.width = s->width;
+  payload_key.height = s->height;
+  payload_key.stride_bytes = planar ? s->width : s->width * 4u;
+  payload_key.format_fourcc = s->fourcc;
+  payload_key.size_bytes = s->frame_bytes;
+  if (backend.callbacks) {
+    slot->bytes = backend.callbacks->acquire_cpu_payload_buffer(payload_key);
+  }
+  if (!slot->bytes) {
+    try {
+      slot->bytes = std::make_shared<CpuPayloadBytes>(s->frame_bytes);
+    } catch (...) {
+      slot->in_use.store(false, std::memory_order_release);
+      return false; // repeating frames are lossy
+    }
   }
 
-  if (!convert_acquired_image(image, s->width, s->height, s->fourcc, slot->bytes.data())) {
+  FrameView fv{};
+  const bool produced =
+      planar ? repack_acquired_image_planar(image, s->width, s->height, s->fourcc,
+                                            slot->bytes->data(), fv)
+             : convert_acquired_image(image, s->width, s->height, s->fourcc, slot->bytes->data());
+  if (!produced) {
+    slot->bytes.reset();
     slot->in_use.store(false, std::memory_order_release);
     ++s->convert_failures;
     if ((s->convert_failures & (s->convert_failures - 1)) == 0) {
@@ -718,7 +1602,7 @@ void deliver_stream_image_locked(DeviceBackend& backend, AImage* image) {
                static_cast<unsigned long long>(s->stream_id), s->width, s->height,
                static_cast<unsigned long long>(s->convert_failures));
     }
-    return;
+    return false;
   }
   ++s->frames_posted;
 
@@ -727,7 +1611,6 @@ void deliver_stream_image_locked(DeviceBackend& backend, AImage* image) {
     timestamp_ns = -1;
   }
 
-  FrameView fv{};
   fv.device_instance_id = s->device_instance_id;
   fv.stream_id = s->stream_id;
   fv.acquisition_session_id = s->acquisition_session_id;
@@ -739,13 +1622,15 @@ void deliver_stream_image_locked(DeviceBackend& backend, AImage* image) {
     fv.acquisition_timing =
         make_acquisition_timing(timestamp_ns, backend.chars.timestamp_source_realtime);
   }
-  fv.data = slot->bytes.data();
-  fv.size_bytes = slot->bytes.size();
-  fv.stride_bytes = s->width * 4u;
+  fv.data = slot->bytes->data();
+  fv.size_bytes = planar ? fv.planes[0].size_bytes : slot->bytes->size();
+  fv.cpu_payload_owner = slot->bytes;
+  fv.stride_bytes = planar ? s->width : s->width * 4u;
   fv.requested_retained_plan = s->plan;
   fv.release = &release_stream_frame;
   fv.release_user = new StreamFrameLease{slot};
   backend.strand->post_frame(fv);
+  return false;
 }
 
 // ---- NDK callbacks --------------------------------------------------------
@@ -793,16 +1678,23 @@ void on_stream_image_available(void* context, AImageReader* reader) {
   if (AImageReader_acquireLatestImage(reader, &image) != AMEDIA_OK || !image) {
     return;
   }
+  const auto work_started = std::chrono::steady_clock::now();
+  bool leased = false;
   {
     std::lock_guard<std::mutex> bl(backend->m);
     if (!backend->closed) {
-      deliver_stream_image_locked(*backend, image);
+      leased = deliver_stream_image_locked(*backend, ctx->stream_output_index, reader, image);
+      report_stream_frame_work_locked(
+          *backend, std::chrono::duration_cast<std::chrono::nanoseconds>(
+                        std::chrono::steady_clock::now() - work_started).count());
     }
   }
-  // The delivered bytes were copied into a pool slot above, so the AImage is
-  // returned to the reader immediately rather than pinned for the frame's
-  // retained lifetime.
-  AImage_delete(image);
+  // Unless the frame reads the image in place, its bytes were copied into a
+  // pool slot above, so the AImage is returned to the reader immediately
+  // rather than pinned for the frame's retained lifetime.
+  if (!leased) {
+    AImage_delete(image);
+  }
 }
 
 void on_still_image_available(void* context, AImageReader* reader) {
@@ -831,11 +1723,24 @@ void on_still_image_available(void* context, AImageReader* reader) {
     return;
   }
 
-  auto bytes = std::make_shared<std::vector<uint8_t>>(
-      static_cast<size_t>(burst->width) * burst->height * 4u);
-  const bool converted =
-      convert_acquired_image(image, burst->width, burst->height, burst->fourcc,
-                             bytes->data());
+  // A planar still keeps the sensor's YUV as-is: the RGBA expansion (2.7x the
+  // bytes of a 4:2:0 frame) is deferred to whoever asks Core for RGBA. A RAW
+  // still is the sensor's samples, copied out unchanged.
+  const bool planar = is_planar_yuv420_fourcc(burst->fourcc);
+  auto bytes = std::make_shared<CpuPayloadBytes>(
+      stream_frame_bytes(burst->width, burst->height, burst->fourcc));
+  FrameView planes{};
+  bool converted = false;
+  if (is_raw_bayer_fourcc(burst->fourcc)) {
+    converted = copy_acquired_image_raw(image, burst->width, burst->height, burst->fourcc,
+                                        bytes->data());
+  } else if (planar) {
+    converted = repack_acquired_image_planar(image, burst->width, burst->height, burst->fourcc,
+                                             bytes->data(), planes);
+  } else {
+    converted = convert_acquired_image(image, burst->width, burst->height, burst->fourcc,
+                                       bytes->data(), backend->still_conversion);
+  }
   int64_t timestamp_ns = -1;
   if (AImage_getTimestamp(image, &timestamp_ns) != AMEDIA_OK) {
     timestamp_ns = -1;
@@ -860,65 +1765,78 @@ void on_still_image_available(void* context, AImageReader* reader) {
   burst->cv.notify_all();
 }
 
-void extract_result_facts(const ACameraMetadata* result, ResultFacts& out) {
+// Reads the ResultFactTag groups in tags out of result. A group outside tags
+// is not looked up at all, so a result costs only the lookups its facts need.
+void extract_result_facts(const ACameraMetadata* result, uint32_t tags, ResultFacts& out) {
   if (!result) return;
   ACameraMetadata_const_entry entry{};
-  if (ACameraMetadata_getConstEntry(result, ACAMERA_SENSOR_EXPOSURE_TIME, &entry) ==
-          ACAMERA_OK && entry.count >= 1) {
-    out.has_exposure_ns = true;
-    out.exposure_ns = entry.data.i64[0];
-  }
-  if (ACameraMetadata_getConstEntry(result, ACAMERA_SENSOR_SENSITIVITY, &entry) ==
-          ACAMERA_OK && entry.count >= 1) {
-    out.has_iso = true;
-    out.iso = entry.data.i32[0];
+  if ((tags & kResultFactExposure) != 0) {
+    if (ACameraMetadata_getConstEntry(result, ACAMERA_SENSOR_EXPOSURE_TIME, &entry) ==
+            ACAMERA_OK && entry.count >= 1) {
+      out.has_exposure_ns = true;
+      out.exposure_ns = entry.data.i64[0];
+    }
+    if (ACameraMetadata_getConstEntry(result, ACAMERA_SENSOR_SENSITIVITY, &entry) ==
+            ACAMERA_OK && entry.count >= 1) {
+      out.has_iso = true;
+      out.iso = entry.data.i32[0];
+    }
   }
-  if (ACameraMetadata_getConstEntry(result, ACAMERA_LENS_APERTURE, &entry) ==
-          ACAMERA_OK && entry.count >= 1) {
+  if ((tags & kResultFactAperture) != 0 &&
+      ACameraMetadata_getConstEntry(result, ACAMERA_LENS_APERTURE, &entry) == ACAMERA_OK &&
+      entry.count >= 1) {
     out.has_aperture = true;
     out.aperture = entry.data.f[0];
   }
-  if (ACameraMetadata_getConstEntry(result, ACAMERA_LENS_FOCAL_LENGTH, &entry) ==
-          ACAMERA_OK && entry.count >= 1) {
+  if ((tags & kResultFactFocalLength) != 0 &&
+      ACameraMetadata_getConstEntry(result, ACAMERA_LENS_FOCAL_LENGTH, &entry) == ACAMERA_OK &&
+      entry.count >= 1) {
     out.has_focal_length_mm = true;
     out.focal_length_mm = entry.data.f[0];
   }
-  if (ACameraMetadata_getConstEntry(result, ACAMERA_LENS_FOCUS_DISTANCE, &entry) ==
-          ACAMERA_OK && entry.count >= 1) {
+  if ((tags & kResultFactFocusDistance) != 0 &&
+      ACameraMetadata_getConstEntry(result, ACAMERA_LENS_FOCUS_DISTANCE, &entry) == ACAMERA_OK &&
+      entry.count >= 1) {
     out.has_focus_diopters = true;
     out.focus_diopters = entry.data.f[0];
   }
-  if (ACameraMetadata_getConstEntry(result, ACAMERA_CONTROL_AE_EXPOSURE_COMPENSATION,
+  if ((tags & kResultFactAeCompensation) != 0 &&
+      ACameraMetadata_getConstEntry(result, ACAMERA_CONTROL_AE_EXPOSURE_COMPENSATION,
                                     &entry) == ACAMERA_OK && entry.count >= 1) {
     out.has_ae_comp_steps = true;
     out.ae_comp_steps = entry.data.i32[0];
   }
-  if (ACameraMetadata_getConstEntry(result, ACAMERA_LENS_INTRINSIC_CALIBRATION, &entry) ==
-          ACAMERA_OK && entry.count >= 5) {
-    out.has_intrinsics = true;
-    for (int i = 0; i < 5; ++i) out.intrinsics[i] = entry.data.f[i];
-  }
-  if (ACameraMetadata_getConstEntry(result, ACAMERA_LENS_DISTORTION, &entry) == ACAMERA_OK &&
-      entry.count >= 5) {
-    out.has_distortion = true;
-    for (int i = 0; i < 5; ++i) out.distortion[i] = entry.data.f[i];
-  }
-  if (ACameraMetadata_getConstEntry(result, ACAMERA_DISTORTION_CORRECTION_MODE, &entry) ==
-          ACAMERA_OK && entry.count >= 1) {
-    out.has_distortion_correction_mode = true;
-    out.distortion_correction_mode = entry.data.u8[0];
+  if ((tags & kResultFactCalibration) != 0) {
+    if (ACameraMetadata_getConstEntry(result, ACAMERA_LENS_INTRINSIC_CALIBRATION, &entry) ==
+            ACAMERA_OK && entry.count >= 5) {
+      out.has_intrinsics = true;
+      for (int i = 0; i < 5; ++i) out.intrinsics[i] = entry.data.f[i];
+    }
+    if (ACameraMetadata_getConstEntry(result, ACAMERA_LENS_DISTORTION, &entry) == ACAMERA_OK &&
+        entry.count >= 5) {
+      out.has_distortion = true;
+      for (int i = 0; i < 5; ++i) out.distortion[i] = entry.data.f[i];
+    }
+    if (ACameraMetadata_getConstEntry(result, ACAMERA_DISTORTION_CORRECTION_MODE, &entry) ==
+            ACAMERA_OK && entry.count >= 1) {
+      out.has_distortion_correction_mode = true;
+      out.distortion_correction_mode = entry.data.u8[0];
+    }
   }
-  if (ACameraMetadata_getConstEntry(result, ACAMERA_SENSOR_TIMESTAMP, &entry) == ACAMERA_OK &&
+  if ((tags & kResultFactSensorTimestamp) != 0 &&
+      ACameraMetadata_getConstEntry(result, ACAMERA_SENSOR_TIMESTAMP, &entry) == ACAMERA_OK &&
       entry.count >= 1) {
     out.has_sensor_timestamp = true;
     out.sensor_timestamp_ns = entry.data.i64[0];
   }
-  if (ACameraMetadata_getConstEntry(result, ACAMERA_CONTROL_AF_STATE, &entry) == ACAMERA_OK &&
+  if ((tags & kResultFactAfState) != 0 &&
+      ACameraMetadata_getConstEntry(result, ACAMERA_CONTROL_AF_STATE, &entry) == ACAMERA_OK &&
       entry.count >= 1) {
     out.has_af_state = true;
     out.af_state = entry.data.u8[0];
   }
-  if (ACameraMetadata_getConstEntry(result, ACAMERA_SENSOR_FRAME_DURATION, &entry) ==
+  if ((tags & kResultFactFrameDuration) != 0 &&
+      ACameraMetadata_getConstEntry(result, ACAMERA_SENSOR_FRAME_DURATION, &entry) ==
           ACAMERA_OK && entry.count >= 1) {
     out.has_frame_duration = true;
     out.frame_duration_ns = entry.data.i64[0];
@@ -940,17 +1858,13 @@ void on_capture_completed(void* context,
   }
   if (!burst) return;
   ResultFacts facts{};
-  extract_result_facts(result, facts);
+  extract_result_facts(result, burst->fact_tags, facts);
   {
     std::lock_guard<std::mutex> wl(burst->m);
-    // Keyed by sensor timestamp so the right result reaches the right image
-    // even with several captures in flight. A device that omits the timestamp
-    // cannot be correlated that way, so those results stay in arrival order
-    // and are only used when the burst is a single capture.
-    if (facts.has_sensor_timestamp) {
-      burst->results_by_time[facts.sensor_timestamp_ns] = facts;
-    } else {
-      burst->results_in_order.push_back(facts);
+    // Paired with images by sensor timestamp at collection, so the right
+    // result reaches the right image even with several captures in flight.
+    if (burst->results.size() < burst->results.capacity()) {
+      burst->results.push_back(facts);
     }
   }
   burst->cv.notify_all();
@@ -1028,6 +1942,33 @@ void read_static_characteristics(const ACameraMetadata* meta, StaticCharacterist
     out.timestamp_source_realtime =
         (entry.data.u8[0] == ACAMERA_SENSOR_INFO_TIMESTAMP_SOURCE_REALTIME);
   }
+  if (ACameraMetadata_getConstEntry(meta, ACAMERA_SENSOR_INFO_COLOR_FILTER_ARRANGEMENT, &entry) ==
+          ACAMERA_OK && entry.count >= 1) {
+    out.has_color_filter_arrangement = true;
+    out.color_filter_arrangement = entry.data.u8[0];
+  }
+  if (ACameraMetadata_getConstEntry(meta, ACAMERA_SENSOR_BLACK_LEVEL_PATTERN, &entry) == ACAMERA_OK &&
+      entry.count >= 4) {
+    out.has_black_level_pattern = true;
+    for (int i = 0; i < 4; ++i) out.black_level_pattern[i] = entry.data.i32[i];
+  }
+  if (ACameraMetadata_getConstEntry(meta, ACAMERA_SENSOR_INFO_WHITE_LEVEL, &entry) == ACAMERA_OK &&
+      entry.count >= 1) {
+    out.has_white_level = true;
+    out.white_level = entry.data.i32[0];
+  }
+  if (ACameraMetadata_getConstEntry(meta, ACAMERA_INFO_SUPPORTED_HARDWARE_LEVEL, &entry) ==
+          ACAMERA_OK && entry.count >= 1) {
+    switch (entry.data.u8[0]) {
+      case ACAMERA_INFO_SUPPORTED_HARDWARE_LEVEL_LIMITED:
+      case ACAMERA_INFO_SUPPORTED_HARDWARE_LEVEL_FULL:
+      case ACAMERA_INFO_SUPPORTED_HARDWARE_LEVEL_3:
+        out.still_alongside_preview = true;
+        break;
+      default:
+        break;
+    }
+  }
   if (ACameraMetadata_getConstEntry(meta, ACAMERA_REQUEST_AVAILABLE_CAPABILITIES, &entry) ==
       ACAMERA_OK) {
     for (uint32_t i = 0; i < entry.count; ++i) {
@@ -1186,13 +2127,36 @@ void read_static_characteristics(const ACameraMetadata* meta, StaticCharacterist
       const int32_t width = entry.data.i32[i + 1];
       const int32_t height = entry.data.i32[i + 2];
       const int32_t is_input = entry.data.i32[i + 3];
-      if (is_input == ACAMERA_SCALER_AVAILABLE_STREAM_CONFIGURATIONS_OUTPUT &&
-          format == AIMAGE_FORMAT_YUV_420_888 && width > 0 && height > 0) {
-        out.supported_yuv_sizes.emplace_back(static_cast<uint32_t>(width),
-                                             static_cast<uint32_t>(height));
+      if (is_input != ACAMERA_SCALER_AVAILABLE_STREAM_CONFIGURATIONS_OUTPUT || width <= 0 ||
+          height <= 0) {
+        continue;
+      }
+      const std::pair<uint32_t, uint32_t> size(static_cast<uint32_t>(width),
+                                               static_cast<uint32_t>(height));
+      if (format == AIMAGE_FORMAT_YUV_420_888) {
+        out.supported_yuv_sizes.push_back(size);
+      } else if (format == AIMAGE_FORMAT_RAW16) {
+        out.supported_raw16_sizes.push_back(size);
+      } else if (format == AIMAGE_FORMAT_RAW10 && (size.first % 4u) == 0) {
+        out.supported_raw10_sizes.push_back(size);
       }
     }
   }
+
+  uint32_t reported = kResultFactAll;
+  if (ACameraMetadata_getConstEntry(meta, ACAMERA_REQUEST_AVAILABLE_RESULT_KEYS, &entry) ==
+          ACAMERA_OK && entry.count >= 1) {
+    reported = 0;
+    for (uint32_t i = 0; i < entry.count; ++i) {
+      reported |= result_fact_tag_for_key(static_cast<uint32_t>(entry.data.i32[i]));
+    }
+  }
+  uint32_t consumed = kResultFactSensorTimestamp | kResultFactExposure | kResultFactAperture |
+                      kResultFactFocalLength | kResultFactDiagnostics;
+  if (out.focus_distance_is_metric) consumed |= kResultFactFocusDistance;
+  if (out.has_exposure_compensation) consumed |= kResultFactAeCompensation;
+  if (out.has_active_array || out.has_pre_correction_array) consumed |= kResultFactCalibration;
+  out.result_fact_tags = reported & consumed;
 }
 
 } // namespace
@@ -1210,12 +2174,13 @@ using camera2_detail::ListenerCtx;
 using camera2_detail::ResultFacts;
 using camera2_detail::StaticCharacteristics;
 using camera2_detail::BurstCollector;
+using camera2_detail::StreamImageLeases;
 using camera2_detail::StreamProduction;
 
 struct Camera2CameraProvider::CapturedMemberFrame {
   bool ok = false;
   ProviderError error = ProviderError::ERR_PROVIDER_FAILED;
-  std::shared_ptr<std::vector<uint8_t>> bytes;
+  std::shared_ptr<CpuPayloadBytes> bytes;
   bool has_timestamp = false;
   int64_t timestamp_ns = 0;
   bool has_facts = false;
@@ -1246,6 +2211,22 @@ struct Camera2CameraProvider::MemberRequestSpec {
   // after every bundle, which is what made the lens hunt.
   bool set_af_trigger = false;
   uint8_t af_trigger = 0;
+
+  // Which entries a request for this spec carries, beyond its template. Two
+  // specs with the same shape can share one cached request, each capture
+  // rewriting the values (see DeviceBackend::still_requests).
+  uint8_t request_shape(bool awb_lock_available) const noexcept {
+    uint8_t shape = 0;
+    if (manual) {
+      shape |= 0x01u;
+      if (frame_duration_ns > 0) shape |= 0x02u;
+      if (awb_lock_available) shape |= 0x04u;
+    } else if (apply_ae_compensation) {
+      shape |= 0x08u;
+    }
+    if (set_af_trigger) shape |= 0x10u;
+    return shape;
+  }
 };
 
 namespace {
@@ -1275,6 +2256,59 @@ const char* facing_label(uint8_t facing) noexcept {
   }
 }
 
+camera_status_t read_camera_characteristics(ACameraManager* manager,
+                                            const char* hardware_id,
+                                            StaticCharacteristics& out) {
+  ACameraMetadata* meta = nullptr;
+  const camera_status_t st =
+      ACameraManager_getCameraCharacteristics(manager, hardware_id, &meta);
+  if (st != ACAMERA_OK || !meta) {
+    return st != ACAMERA_OK ? st : ACAMERA_ERROR_UNKNOWN;
+  }
+  out = StaticCharacteristics{};
+  camera2_detail::read_static_characteristics(meta, out);
+  ACameraMetadata_free(meta);
+  return ACAMERA_OK;
+}
+
+// Static characteristics of every camera read so far in this process, by
+// hardware_id. They are constant for the OS build, so a provider started
+// again in the same process (CamBANGServer stop/start) hands them out
+// without another ACameraMetadata read. Hits are revalidated in the
+// background after open (Camera2CameraProvider::revalidate_characteristics_).
+class CharacteristicsCache final {
+public:
+  static CharacteristicsCache& instance() {
+    static CharacteristicsCache cache;
+    return cache;
+  }
+
+  bool find(const std::string& hardware_id, StaticCharacteristics& out) const {
+    std::lock_guard<std::mutex> lock(mu_);
+    const auto it = entries_.find(hardware_id);
+    if (it == entries_.end()) {
+      return false;
+    }
+    out = it->second;
+    return true;
+  }
+
+  // True when chars replace different cached characteristics.
+  bool store(const std::string& hardware_id, const StaticCharacteristics& chars) {
+    std::lock_guard<std::mutex> lock(mu_);
+    auto [it, inserted] = entries_.try_emplace(hardware_id, chars);
+    if (inserted || it->second == chars) {
+      return false;
+    }
+    it->second = chars;
+    return true;
+  }
+
+private:
+  mutable std::mutex mu_;
+  std::map<std::string, StaticCharacteristics> entries_;
+};
+
 } // namespace
 
 Camera2CameraProvider::~Camera2CameraProvider() {
@@ -1332,9 +2366,35 @@ CaptureTemplate Camera2CameraProvider::capture_template() const {
   return t;
 }
 
+bool Camera2CameraProvider::supports_capture_alongside_streams(
+    uint64_t device_instance_id) const noexcept try {
+  std::shared_ptr<DeviceBackend> backend;
+  {
+    std::lock_guard<std::mutex> state_lock(state_mutex_);
+    const auto it = devices_.find(device_instance_id);
+    if (it == devices_.end() || !it->second.open) {
+      return false;
+    }
+    backend = it->second.backend;
+  }
+  if (!backend) {
+    return false;
+  }
+  std::lock_guard<std::mutex> bl(backend->m);
+  return !backend->open_pending && !backend->closed && backend->chars.still_alongside_preview;
+} catch (...) {
+  return false;
+}
+
 ProducerBackingCapabilities Camera2CameraProvider::stream_backing_capabilities(
     const CaptureProfile& /*profile*/,
     const PictureConfig& /*picture*/) const noexcept {
+  // CPU only. A GPU-primary AHardwareBuffer stream needs a Godot-side importer
+  // for the buffer (camera AHBs are YUV, sampled through an external-format
+  // Vulkan YCbCr conversion that RenderingDevice does not expose) and a typed
+  // artifact route in the display service, which today hands every retained
+  // GPU backing to the synthetic bridge. Advertising GPU before both exist
+  // would let Core pick a posture no display path can show.
   return ProducerBackingCapabilities{true, false, false};
 }
 
@@ -1398,10 +2458,19 @@ ProviderResult Camera2CameraProvider::initialize(IProviderCallbacks* callbacks)
     manager_.reset();
     return ProviderResult::failure(ProviderError::ERR_PROVIDER_FAILED);
   }
+  for (BoundedControlExecutor& worker : open_workers_) {
+    if (!worker.start()) {
+      stop_open_workers_();
+      control_.stop();
+      manager_.reset();
+      return ProviderResult::failure(ProviderError::ERR_PROVIDER_FAILED);
+    }
+  }
 
-  callbacks_ = callbacks;
-  if (!strand_.start(callbacks_, "camera2_provider")) {
+  callbacks_ = bind_provider_callbacks(callbacks);
+  if (!strand_.start(callbacks, "camera2_provider")) {
     callbacks_ = nullptr;
+    stop_open_workers_();
     control_.stop();
     manager_.reset();
     return ProviderResult::failure(ProviderError::ERR_PROVIDER_FAILED);
@@ -1410,11 +2479,16 @@ ProviderResult Camera2CameraProvider::initialize(IProviderCallbacks* callbacks)
   if (!start_capture_executor_()) {
     strand_.stop();
     callbacks_ = nullptr;
+    stop_open_workers_();
     control_.stop();
     manager_.reset();
     return ProviderResult::failure(ProviderError::ERR_PROVIDER_FAILED);
   }
 
+  // Best-effort: a pool that fails to start leaves every still converting
+  // inline on the listener thread, which is correct, only slower.
+  (void)still_conversion_.start(kRowBandWorkerCount, kRowBandRows, kRowBandMinPixels);
+
   provider_native_id_ = alloc_native_id_(NativeObjectType::Provider);
   emit_native_created_(provider_native_id_, NativeObjectType::Provider, 0, 0, 0, 0);
 
@@ -1454,17 +2528,20 @@ ProviderResult Camera2CameraProvider::enumerate_endpoints(
             CameraEndpoint ep;
             ep.hardware_id = id;
             // Camera2 has no human-readable device name; compose a stable
-            // label from the id and the facing the platform reports.
+            // label from the id and the facing the platform reports. The id
+            // list itself stays live (external cameras come and go); the
+            // full characteristics read here also serves open_device().
             const char* facing = "unknown";
-            ACameraMetadata* meta = nullptr;
-            if (ACameraManager_getCameraCharacteristics(manager, id, &meta) == ACAMERA_OK &&
-                meta) {
-              ACameraMetadata_const_entry entry{};
-              if (ACameraMetadata_getConstEntry(meta, ACAMERA_LENS_FACING, &entry) ==
-                      ACAMERA_OK && entry.count >= 1) {
-                facing = facing_label(entry.data.u8[0]);
-              }
-              ACameraMetadata_free(meta);
+            StaticCharacteristics chars{};
+            CharacteristicsCache& cache = CharacteristicsCache::instance();
+            bool have_chars = cache.find(ep.hardware_id, chars);
+            if (!have_chars &&
+                read_camera_characteristics(manager, id, chars) == ACAMERA_OK) {
+              (void)cache.store(ep.hardware_id, chars);
+              have_chars = true;
+            }
+            if (have_chars && chars.has_facing) {
+              facing = facing_label(chars.facing);
             }
             ep.name = std::string("Camera ") + id + " (" + facing + ")";
             local.endpoints.push_back(std::move(ep));
@@ -1512,6 +2589,9 @@ ProviderResult Camera2CameraProvider::open_device(
   backend->device_instance_id = device_instance_id;
   backend->root_id = root_id;
   backend->strand = &strand_;
+  backend->callbacks = callbacks_;
+  backend->still_conversion = &still_conversion_;
+  backend->producer_frames_dropped = &producer_frames_dropped_;
   // Every NDK callback context is allocated up front and owned by the
   // backend. The NDK keeps the raw pointer for the lifetime of the object it
   // was registered on, and the backend outlives all of them: it is released
@@ -1519,20 +2599,24 @@ ProviderResult Camera2CameraProvider::open_device(
   // quiescence.
   backend->device_ctx = std::make_unique<ListenerCtx>();
   backend->session_ctx = std::make_unique<ListenerCtx>();
-  backend->stream_reader_ctx = std::make_unique<ListenerCtx>();
+  for (size_t i = 0; i < camera2_detail::kMaxSessionStreams; ++i) {
+    backend->stream_reader_ctxs[i] = std::make_unique<ListenerCtx>();
+    backend->stream_reader_ctxs[i]->backend = backend;
+    backend->stream_reader_ctxs[i]->stream_output_index = i;
+  }
   backend->still_reader_ctx = std::make_unique<ListenerCtx>();
   backend->capture_ctx = std::make_unique<ListenerCtx>();
   backend->repeating_ctx = std::make_unique<ListenerCtx>();
   backend->device_ctx->backend = backend;
   backend->repeating_ctx->backend = backend;
   backend->session_ctx->backend = backend;
-  backend->stream_reader_ctx->backend = backend;
   backend->still_reader_ctx->backend = backend;
   backend->capture_ctx->backend = backend;
 
   struct OpenResult {
     ProviderError error = ProviderError::ERR_PROVIDER_FAILED;
     bool ok = false;
+    bool chars_from_cache = false;
   };
   auto result = std::make_shared<OpenResult>();
   auto token = std::make_shared<BoundedControlExecutor::AbandonToken>();
@@ -1543,49 +2627,28 @@ ProviderResult Camera2CameraProvider::open_device(
 
         // Characteristics first: they are needed by admission and by static
         // facts, and a device whose characteristics cannot be read is not one
-        // this provider can honestly configure.
+        // this provider can honestly configure. A cached copy stands in until
+        // the background revalidation after open.
         StaticCharacteristics chars{};
-        ACameraMetadata* meta = nullptr;
-        camera_status_t st =
-            ACameraManager_getCameraCharacteristics(manager, hardware_id.c_str(), &meta);
-        if (st != ACAMERA_OK || !meta) {
-          local.error = camera2_detail::provider_error_from_camera_status(st);
-          if (!t.abandoned.load(std::memory_order_acquire)) {
-            *result = local;
-          }
-          return;
-        }
-        camera2_detail::read_static_characteristics(meta, chars);
-        ACameraMetadata_free(meta);
-
-        ACameraDevice_StateCallbacks device_cbs{};
-        device_cbs.context = backend->device_ctx.get();
-        device_cbs.onDisconnected = &camera2_detail::on_device_disconnected;
-        device_cbs.onError = &camera2_detail::on_device_error;
-
-        ACameraDevice* device = nullptr;
-        st = ACameraManager_openCamera(manager, hardware_id.c_str(), &device_cbs, &device);
-        if (st != ACAMERA_OK || !device) {
-          local.error = camera2_detail::provider_error_from_camera_status(st);
-          camera2_detail::log_line("openCamera failed id=%s status=%d",
-                                   hardware_id.c_str(), static_cast<int>(st));
-          if (device) {
-            ACameraDevice_close(device);
-          }
-          if (!t.abandoned.load(std::memory_order_acquire)) {
-            *result = local;
+        CharacteristicsCache& cache = CharacteristicsCache::instance();
+        local.chars_from_cache = cache.find(hardware_id, chars);
+        if (!local.chars_from_cache) {
+          const camera_status_t st =
+              read_camera_characteristics(manager, hardware_id.c_str(), chars);
+          if (st != ACAMERA_OK) {
+            local.error = camera2_detail::provider_error_from_camera_status(st);
+            if (!t.abandoned.load(std::memory_order_acquire)) {
+              *result = local;
+            }
+            return;
           }
-          return;
+          (void)cache.store(hardware_id, chars);
         }
-
         if (t.abandoned.load(std::memory_order_acquire)) {
-          // Caller gave up: the acquisition is orphaned; release it here.
-          ACameraDevice_close(device);
           return;
         }
         {
           std::lock_guard<std::mutex> bl(backend->m);
-          backend->device = device;
           backend->chars = std::move(chars);
         }
         local.ok = true;
@@ -1599,21 +2662,118 @@ ProviderResult Camera2CameraProvider::open_device(
     return ProviderResult::failure(result->error);
   }
 
+  // The camera itself opens on an open worker; this call returns once the
+  // open is submitted. Everything that needs the ACameraDevice waits for it
+  // (DeviceBackend::wait_open_settled), so a multi-camera startup overlaps
+  // its openCamera calls instead of paying one after another.
+  const uint64_t native_id = alloc_native_id_(NativeObjectType::Device);
+  {
+    std::lock_guard<std::mutex> bl(backend->m);
+    backend->open_pending = true;
+    backend->device_native_id = native_id;
+  }
+  const bool chars_from_cache = result->chars_from_cache;
+  BoundedControlExecutor& open_worker = open_workers_[device_instance_id % kOpenWorkerCount];
+  if (!open_worker.post([this, backend, chars_from_cache] {
+        complete_device_open_(backend, chars_from_cache);
+      })) {
+    return ProviderResult::failure(ProviderError::ERR_BAD_STATE);
+  }
+
   dev.hardware_id = hardware_id;
   dev.device_instance_id = device_instance_id;
   dev.root_id = root_id;
   dev.open = true;
-  dev.stream_id = 0;
-  dev.native_id = alloc_native_id_(NativeObjectType::Device);
+  dev.stream_ids.clear();
+  dev.native_id = native_id;
   dev.backend = backend;
-
-  emit_native_created_(dev.native_id, NativeObjectType::Device, root_id,
-                       device_instance_id, 0, 0);
-  strand_.post_device_opened(device_instance_id);
-  post_static_camera_facts_best_effort_(device_instance_id, backend);
   return ProviderResult::success();
 }
 
+void Camera2CameraProvider::complete_device_open_(
+    const std::shared_ptr<DeviceBackend>& backend,
+    bool chars_from_cache) {
+  ACameraManager* manager = as_manager(manager_);
+  ACameraDevice_StateCallbacks device_cbs{};
+  device_cbs.context = backend->device_ctx.get();
+  device_cbs.onDisconnected = &camera2_detail::on_device_disconnected;
+  device_cbs.onError = &camera2_detail::on_device_error;
+
+  ACameraDevice* device = nullptr;
+  const camera_status_t st =
+      ACameraManager_openCamera(manager, backend->hardware_id.c_str(), &device_cbs, &device);
+  if (st != ACAMERA_OK || !device) {
+    camera2_detail::log_line("openCamera failed id=%s status=%d",
+                             backend->hardware_id.c_str(), static_cast<int>(st));
+  }
+
+  bool opened = false;
+  {
+    std::lock_guard<std::mutex> bl(backend->m);
+    backend->open_pending = false;
+    if (backend->closed) {
+      // close_device() or shutdown gave up waiting; the device is released
+      // below and was never reported.
+    } else if (st == ACAMERA_OK && device) {
+      backend->device = std::exchange(device, nullptr);
+      backend->device_native_created = true;
+      emit_native_created_(backend->device_native_id, NativeObjectType::Device,
+                           backend->root_id, backend->device_instance_id, 0, 0);
+      strand_.post_device_opened(backend->device_instance_id);
+      opened = true;
+    } else {
+      backend->open_error = st != ACAMERA_OK
+                                ? camera2_detail::provider_error_from_camera_status(st)
+                                : ProviderError::ERR_PROVIDER_FAILED;
+      backend->latch_failure_locked(backend->open_error);
+    }
+  }
+  backend->open_cv.notify_all();
+  if (device) {
+    ACameraDevice_close(device);
+  }
+  if (!opened) {
+    return;
+  }
+  post_static_camera_facts_best_effort_(backend->device_instance_id, backend);
+  if (chars_from_cache) {
+    revalidate_characteristics_(backend->device_instance_id, backend);
+  }
+}
+
+void Camera2CameraProvider::revalidate_characteristics_(
+    uint64_t device_instance_id,
+    const std::shared_ptr<DeviceBackend>& backend) {
+  std::weak_ptr<DeviceBackend> weak = backend;
+  ACameraManager* manager = as_manager(manager_);
+  (void)control_.post([this, weak, manager, device_instance_id]() {
+    std::shared_ptr<DeviceBackend> strong = weak.lock();
+    if (!strong || shutting_down_.load(std::memory_order_acquire)) {
+      return;
+    }
+    StaticCharacteristics fresh{};
+    if (read_camera_characteristics(manager, strong->hardware_id.c_str(), fresh) !=
+            ACAMERA_OK ||
+        !CharacteristicsCache::instance().store(strong->hardware_id, fresh)) {
+      return;
+    }
+    // The cache was stale (an OS or HAL update inside one process is rare,
+    // but not impossible): admission and the static facts follow the
+    // platform from here on.
+    {
+      std::lock_guard<std::mutex> bl(strong->m);
+      if (strong->closed) {
+        return;
+      }
+      strong->chars = fresh;
+    }
+    camera2_detail::log_line(
+        "device=%llu cached characteristics were stale; re-posting static facts",
+        static_cast<unsigned long long>(device_instance_id));
+    post_static_camera_facts_best_effort_(device_instance_id, strong);
+  });
+}
+
 void Camera2CameraProvider::post_static_camera_facts_best_effort_(
     uint64_t device_instance_id,
     const std::shared_ptr<DeviceBackend>& backend) {
@@ -1741,9 +2901,34 @@ void Camera2CameraProvider::post_static_camera_facts_best_effort_(
     }
   }
 
+  // RAW sensor layout, only for a device that can deliver RAW stills and
+  // reports all three parts; the CFA enum values are Camera2's own.
+  if ((!chars.supported_raw16_sizes.empty() || !chars.supported_raw10_sizes.empty()) &&
+      chars.has_color_filter_arrangement && chars.has_black_level_pattern && chars.has_white_level &&
+      chars.color_filter_arrangement <= ACAMERA_SENSOR_INFO_COLOR_FILTER_ARRANGEMENT_NIR &&
+      chars.white_level > 0) {
+    std::array<uint32_t, 4> black_levels{};
+    bool black_levels_valid = true;
+    for (int i = 0; i < 4; ++i) {
+      black_levels_valid = black_levels_valid && chars.black_level_pattern[i] >= 0;
+      black_levels[i] = static_cast<uint32_t>(chars.black_level_pattern[i]);
+    }
+    if (black_levels_valid) {
+      if (const auto layout = RawSensorLayout::create(
+              static_cast<ColorFilterArrangement>(chars.color_filter_arrangement), black_levels,
+              static_cast<uint32_t>(chars.white_level))) {
+        facts.raw_sensor_layout = SourcedFact<RawSensorLayout>{*layout, FactOrigin::NATIVE_REPORTED};
+      }
+    }
+  }
+
   if (facts.facing || facts.nature || facts.sensor_orientation || facts.focal_length_mm ||
-      facts.aperture_f_number || facts.focus_state || facts.pose) {
-    strand_.post_camera_static_facts(device_instance_id, ProviderCameraFacts{facts});
+      facts.aperture_f_number || facts.focus_state || facts.pose || facts.raw_sensor_layout) {
+    // Posted under m so facts never follow close_device()'s device closed.
+    std::lock_guard<std::mutex> bl(backend->m);
+    if (!backend->closed) {
+      strand_.post_camera_static_facts(device_instance_id, ProviderCameraFacts{facts});
+    }
   } else {
     camera2_detail::log_line(
         "static camera facts unavailable for device=%llu (device reports none)",
@@ -1830,14 +3015,16 @@ void Camera2CameraProvider::teardown_session_locked_(
   uint64_t session_native_id = 0;
   {
     std::lock_guard<std::mutex> bl(backend->m);
-    if (!backend->session && !backend->stream_reader && !backend->still_reader) {
+    if (!backend->session && backend->stream_outputs.empty() && !backend->still_reader) {
       return;
     }
     session_native_id = backend->acquisition_session_id;
     backend->acquisition_session_id = 0;
     backend->repeating_active = false;
-    backend->cfg_has_stream = false;
     backend->cfg_has_still = false;
+    backend->stream_hint.close();
+    backend->stream_hint_listener_tid = 0;
+    backend->stream_hint_refused = false;
   }
 
   auto token = std::make_shared<BoundedControlExecutor::AbandonToken>();
@@ -1845,23 +3032,21 @@ void Camera2CameraProvider::teardown_session_locked_(
       [backend](const BoundedControlExecutor::AbandonToken& /*t*/) {
         ACameraCaptureSession* session = nullptr;
         ACaptureSessionOutputContainer* container = nullptr;
-        ACaptureSessionOutput* stream_output = nullptr;
+        std::vector<DeviceBackend::StreamOutput> stream_outputs;
         ACaptureSessionOutput* still_output = nullptr;
-        AImageReader* stream_reader = nullptr;
         AImageReader* still_reader = nullptr;
-        ACameraOutputTarget* stream_target = nullptr;
         ACaptureRequest* repeating_request = nullptr;
+        std::vector<DeviceBackend::CachedStillRequest> still_requests;
+        still_requests.swap(backend->still_requests);
+        backend->still_requests_window = nullptr;
         {
           std::lock_guard<std::mutex> bl(backend->m);
           session = std::exchange(backend->session, nullptr);
           container = std::exchange(backend->output_container, nullptr);
-          stream_output = std::exchange(backend->stream_output, nullptr);
+          stream_outputs.swap(backend->stream_outputs);
           still_output = std::exchange(backend->still_output, nullptr);
-          stream_reader = std::exchange(backend->stream_reader, nullptr);
           still_reader = std::exchange(backend->still_reader, nullptr);
-          stream_target = std::exchange(backend->stream_target, nullptr);
           repeating_request = std::exchange(backend->repeating_request, nullptr);
-          backend->stream_window = nullptr;
           backend->still_window = nullptr;
         }
         // Ordering is load-bearing: stop the flow, close the session (which
@@ -1874,19 +3059,31 @@ void Camera2CameraProvider::teardown_session_locked_(
         if (repeating_request) {
           ACaptureRequest_free(repeating_request);
         }
-        if (stream_target) {
-          ACameraOutputTarget_free(stream_target);
+        for (DeviceBackend::CachedStillRequest& cached : still_requests) {
+          ACaptureRequest_free(cached.request);
+          ACameraOutputTarget_free(cached.target);
+        }
+        for (DeviceBackend::StreamOutput& out : stream_outputs) {
+          if (out.target) ACameraOutputTarget_free(out.target);
         }
         if (container) {
-          if (stream_output) ACaptureSessionOutputContainer_remove(container, stream_output);
+          for (DeviceBackend::StreamOutput& out : stream_outputs) {
+            if (out.output) ACaptureSessionOutputContainer_remove(container, out.output);
+          }
           if (still_output) ACaptureSessionOutputContainer_remove(container, still_output);
           ACaptureSessionOutputContainer_free(container);
         }
-        if (stream_output) ACaptureSessionOutput_free(stream_output);
+        for (DeviceBackend::StreamOutput& out : stream_outputs) {
+          if (out.output) ACaptureSessionOutput_free(out.output);
+        }
         if (still_output) ACaptureSessionOutput_free(still_output);
-        if (stream_reader) {
-          AImageReader_setImageListener(stream_reader, nullptr);
-          AImageReader_delete(stream_reader);
+        for (DeviceBackend::StreamOutput& out : stream_outputs) {
+          if (out.reader) {
+            // Frames Core still holds keep their images; the reader outlives
+            // the last of them.
+            AImageReader_setImageListener(out.reader, nullptr);
+            camera2_detail::retire_stream_reader(out.reader, out.image_leases);
+          }
         }
         if (still_reader) {
           AImageReader_setImageListener(still_reader, nullptr);
@@ -1902,32 +3099,37 @@ void Camera2CameraProvider::teardown_session_locked_(
 
 ProviderResult Camera2CameraProvider::ensure_session_configured_(
     const std::shared_ptr<DeviceBackend>& backend,
-    bool want_stream,
-    uint32_t stream_width,
-    uint32_t stream_height,
+    const std::vector<camera2_detail::StreamOutputSpec>& streams,
     bool want_still,
     uint32_t still_width,
-    uint32_t still_height) {
+    uint32_t still_height,
+    uint32_t still_format_fourcc) {
   if (!backend) {
     return ProviderResult::failure(ProviderError::ERR_BAD_STATE);
   }
-  if (!want_stream && !want_still) {
+  if ((streams.empty() && !want_still) || streams.size() > camera2_detail::kMaxSessionStreams) {
     return ProviderResult::failure(ProviderError::ERR_INVALID_ARGUMENT);
   }
 
+  const int32_t still_format = camera2_detail::still_reader_format(still_format_fourcc);
   std::lock_guard<std::mutex> configure_lock(backend->configure_mutex);
   {
-    std::lock_guard<std::mutex> bl(backend->m);
+    std::unique_lock<std::mutex> bl(backend->m);
+    if (!backend->wait_open_settled(bl, kControlJobTimeoutMs)) {
+      return ProviderResult::failure(ProviderError::ERR_TIMEOUT);
+    }
+    if (backend->open_error != ProviderError::OK) {
+      return ProviderResult::failure(backend->open_error);
+    }
     if (backend->closed || backend->failed || !backend->device) {
       return ProviderResult::failure(ProviderError::ERR_BAD_STATE);
     }
     const bool matches = backend->session != nullptr &&
-                         backend->cfg_has_stream == want_stream &&
+                         backend->configured_stream_specs_locked() == streams &&
                          backend->cfg_has_still == want_still &&
-                         (!want_stream || (backend->cfg_stream_w == stream_width &&
-                                           backend->cfg_stream_h == stream_height)) &&
                          (!want_still || (backend->cfg_still_w == still_width &&
-                                          backend->cfg_still_h == still_height));
+                                          backend->cfg_still_h == still_height &&
+                                          backend->cfg_still_reader_format == still_format));
     if (matches) {
       return ProviderResult::success();
     }
@@ -1939,13 +3141,17 @@ ProviderResult Camera2CameraProvider::ensure_session_configured_(
     }
     // Geometry the device does not actually offer for YUV_420_888 must fail
     // here rather than be silently substituted by the HAL (brief §6).
-    if (want_stream && !backend->chars.supports_size(stream_width, stream_height)) {
-      camera2_detail::log_line("no supported YUV output matches stream %ux%u",
-                               stream_width, stream_height);
-      return ProviderResult::failure(ProviderError::ERR_PLATFORM_CONSTRAINT);
+    for (const camera2_detail::StreamOutputSpec& spec : streams) {
+      if (!backend->chars.supports_size(spec.width, spec.height)) {
+        camera2_detail::log_line("no supported YUV output matches stream %ux%u",
+                                 spec.width, spec.height);
+        return ProviderResult::failure(ProviderError::ERR_PLATFORM_CONSTRAINT);
+      }
     }
-    if (want_still && !backend->chars.supports_size(still_width, still_height)) {
-      camera2_detail::log_line("no supported YUV output matches still %ux%u",
+    if (want_still &&
+        !backend->chars.supports_still_size(still_format_fourcc, still_width, still_height)) {
+      camera2_detail::log_line("no supported %s output matches still %ux%u",
+                               is_raw_bayer_fourcc(still_format_fourcc) ? "RAW" : "YUV",
                                still_width, still_height);
       return ProviderResult::failure(ProviderError::ERR_PLATFORM_CONSTRAINT);
     }
@@ -1960,8 +3166,8 @@ ProviderResult Camera2CameraProvider::ensure_session_configured_(
   auto result = std::make_shared<ConfigureResult>();
   auto token = std::make_shared<BoundedControlExecutor::AbandonToken>();
   const bool completed = control_.run_bounded(
-      [result, backend, want_stream, stream_width, stream_height, want_still,
-       still_width, still_height](const BoundedControlExecutor::AbandonToken& t) {
+      [result, backend, streams, want_still, still_width, still_height,
+       still_format](const BoundedControlExecutor::AbandonToken& t) {
         ConfigureResult local;
 
         ACameraDevice* device = nullptr;
@@ -1975,11 +3181,9 @@ ProviderResult Camera2CameraProvider::ensure_session_configured_(
           return;
         }
 
-        AImageReader* stream_reader = nullptr;
+        std::vector<DeviceBackend::StreamOutput> stream_outputs(streams.size());
         AImageReader* still_reader = nullptr;
-        ANativeWindow* stream_window = nullptr;
         ANativeWindow* still_window = nullptr;
-        ACaptureSessionOutput* stream_output = nullptr;
         ACaptureSessionOutput* still_output = nullptr;
         ACaptureSessionOutputContainer* container = nullptr;
         ACameraCaptureSession* session = nullptr;
@@ -1989,12 +3193,14 @@ ProviderResult Camera2CameraProvider::ensure_session_configured_(
         const auto unwind = [&]() {
           if (session) ACameraCaptureSession_close(session);
           if (container) ACaptureSessionOutputContainer_free(container);
-          if (stream_output) ACaptureSessionOutput_free(stream_output);
-          if (still_output) ACaptureSessionOutput_free(still_output);
-          if (stream_reader) {
-            AImageReader_setImageListener(stream_reader, nullptr);
-            AImageReader_delete(stream_reader);
+          for (DeviceBackend::StreamOutput& out : stream_outputs) {
+            if (out.output) ACaptureSessionOutput_free(out.output);
+            if (out.reader) {
+              AImageReader_setImageListener(out.reader, nullptr);
+              AImageReader_delete(out.reader);
+            }
           }
+          if (still_output) ACaptureSessionOutput_free(still_output);
           if (still_reader) {
             AImageReader_setImageListener(still_reader, nullptr);
             AImageReader_delete(still_reader);
@@ -2004,23 +3210,25 @@ ProviderResult Camera2CameraProvider::ensure_session_configured_(
         media_status_t ms = AMEDIA_OK;
         camera_status_t cs = ACAMERA_OK;
 
-        if (want_stream) {
-          ms = AImageReader_new(static_cast<int32_t>(stream_width),
-                                static_cast<int32_t>(stream_height),
+        for (size_t i = 0; i < streams.size(); ++i) {
+          DeviceBackend::StreamOutput& out = stream_outputs[i];
+          out.spec = streams[i];
+          ms = AImageReader_new(static_cast<int32_t>(out.spec.width),
+                                static_cast<int32_t>(out.spec.height),
                                 AIMAGE_FORMAT_YUV_420_888, kStreamReaderMaxImages,
-                                &stream_reader);
-          if (ms != AMEDIA_OK || !stream_reader) {
+                                &out.reader);
+          if (ms != AMEDIA_OK || !out.reader) {
+            out.reader = nullptr;
             local.error = ProviderError::ERR_PLATFORM_CONSTRAINT;
             unwind();
             if (!t.abandoned.load(std::memory_order_acquire)) *result = local;
             return;
           }
           AImageReader_ImageListener listener{};
-          listener.context = backend->stream_reader_ctx.get();
+          listener.context = backend->stream_reader_ctxs[i].get();
           listener.onImageAvailable = &camera2_detail::on_stream_image_available;
-          AImageReader_setImageListener(stream_reader, &listener);
-          if (AImageReader_getWindow(stream_reader, &stream_window) != AMEDIA_OK ||
-              !stream_window) {
+          AImageReader_setImageListener(out.reader, &listener);
+          if (AImageReader_getWindow(out.reader, &out.window) != AMEDIA_OK || !out.window) {
             local.error = ProviderError::ERR_PROVIDER_FAILED;
             unwind();
             if (!t.abandoned.load(std::memory_order_acquire)) *result = local;
@@ -2030,7 +3238,7 @@ ProviderResult Camera2CameraProvider::ensure_session_configured_(
         if (want_still) {
           ms = AImageReader_new(static_cast<int32_t>(still_width),
                                 static_cast<int32_t>(still_height),
-                                AIMAGE_FORMAT_YUV_420_888, kStillReaderMaxImages,
+                                still_format, kStillReaderMaxImages,
                                 &still_reader);
           if (ms != AMEDIA_OK || !still_reader) {
             local.error = ProviderError::ERR_PLATFORM_CONSTRAINT;
@@ -2058,9 +3266,9 @@ ProviderResult Camera2CameraProvider::ensure_session_configured_(
           if (!t.abandoned.load(std::memory_order_acquire)) *result = local;
           return;
         }
-        if (stream_window) {
-          if (ACaptureSessionOutput_create(stream_window, &stream_output) != ACAMERA_OK ||
-              ACaptureSessionOutputContainer_add(container, stream_output) != ACAMERA_OK) {
+        for (DeviceBackend::StreamOutput& out : stream_outputs) {
+          if (ACaptureSessionOutput_create(out.window, &out.output) != ACAMERA_OK ||
+              ACaptureSessionOutputContainer_add(container, out.output) != ACAMERA_OK) {
             local.error = ProviderError::ERR_PLATFORM_CONSTRAINT;
             unwind();
             if (!t.abandoned.load(std::memory_order_acquire)) *result = local;
@@ -2105,20 +3313,20 @@ ProviderResult Camera2CameraProvider::ensure_session_configured_(
             *result = local;
             return;
           }
-          backend->stream_reader = stream_reader;
+          for (DeviceBackend::StreamOutput& out : stream_outputs) {
+            out.image_leases = std::make_shared<StreamImageLeases>();
+            out.image_leases->max_outstanding = static_cast<size_t>(kStreamReaderMaxImages - 2);
+          }
+          backend->stream_outputs = std::move(stream_outputs);
           backend->still_reader = still_reader;
-          backend->stream_window = stream_window;
           backend->still_window = still_window;
-          backend->stream_output = stream_output;
           backend->still_output = still_output;
           backend->output_container = container;
           backend->session = session;
-          backend->cfg_has_stream = want_stream;
-          backend->cfg_stream_w = stream_width;
-          backend->cfg_stream_h = stream_height;
           backend->cfg_has_still = want_still;
           backend->cfg_still_w = still_width;
           backend->cfg_still_h = still_height;
+          backend->cfg_still_reader_format = still_format;
         }
         local.ok = true;
         *result = local;
@@ -2148,6 +3356,21 @@ ProviderResult Camera2CameraProvider::ensure_session_configured_(
   return ProviderResult::success();
 }
 
+bool Camera2CameraProvider::mark_backend_closed_(
+    const std::shared_ptr<DeviceBackend>& backend) {
+  std::unique_lock<std::mutex> bl(backend->m);
+  // Bounded: an open still in flight past this releases its own device.
+  (void)backend->wait_open_settled(bl, kControlJobTimeoutMs);
+  backend->closed = true;
+  return backend->device_native_created;
+}
+
+void Camera2CameraProvider::stop_open_workers_() noexcept {
+  for (BoundedControlExecutor& worker : open_workers_) {
+    worker.stop();
+  }
+}
+
 ProviderResult Camera2CameraProvider::close_device(uint64_t device_instance_id) {
   if (!initialized_.load(std::memory_order_acquire)) {
     return ProviderResult::failure(ProviderError::ERR_BAD_STATE);
@@ -2171,12 +3394,13 @@ ProviderResult Camera2CameraProvider::close_device(uint64_t device_instance_id)
   if (it == devices_.end() || !it->second.open) {
     return ProviderResult::failure(ProviderError::ERR_BAD_STATE);
   }
-  if (it->second.stream_id != 0) {
+  if (!it->second.stream_ids.empty()) {
     return ProviderResult::failure(ProviderError::ERR_BAD_STATE);
   }
 
   DeviceState& dev = it->second;
   std::shared_ptr<DeviceBackend> backend = dev.backend;
+  bool native_created = false;
   if (backend) {
     // Session teardown emits its own AcquisitionSession destruction fact and
     // must complete before the device is closed.
@@ -2184,10 +3408,7 @@ ProviderResult Camera2CameraProvider::close_device(uint64_t device_instance_id)
       std::lock_guard<std::mutex> configure_lock(backend->configure_mutex);
       teardown_session_locked_(backend);
     }
-    {
-      std::lock_guard<std::mutex> bl(backend->m);
-      backend->closed = true;
-    }
+    native_created = mark_backend_closed_(backend);
     auto token = std::make_shared<BoundedControlExecutor::AbandonToken>();
     (void)control_.run_bounded(
         [backend](const BoundedControlExecutor::AbandonToken& /*t*/) {
@@ -2208,7 +3429,9 @@ ProviderResult Camera2CameraProvider::close_device(uint64_t device_instance_id)
   dev.open = false;
   dev.backend.reset();
   strand_.post_device_closed(device_instance_id);
-  emit_native_destroyed_(dev.native_id);
+  if (native_created) {
+    emit_native_destroyed_(dev.native_id);
+  }
   dev.native_id = 0;
   return ProviderResult::success();
 }
@@ -2227,7 +3450,7 @@ ProviderResult Camera2CameraProvider::create_stream(const StreamRequest& req) {
   if (dev_it == devices_.end() || !dev_it->second.open) {
     return ProviderResult::failure(ProviderError::ERR_BAD_STATE);
   }
-  if (dev_it->second.stream_id != 0) {
+  if (dev_it->second.stream_ids.size() >= camera2_detail::kMaxSessionStreams) {
     return ProviderResult::failure(ProviderError::ERR_BUSY);
   }
   auto& st = streams_[req.stream_id];
@@ -2239,7 +3462,7 @@ ProviderResult Camera2CameraProvider::create_stream(const StreamRequest& req) {
   st.created = true;
   st.started = false;
   st.native_id = alloc_native_id_(NativeObjectType::Stream);
-  dev_it->second.stream_id = req.stream_id;
+  dev_it->second.stream_ids.push_back(req.stream_id);
 
   uint64_t session_native_id = 0;
   if (dev_it->second.backend) {
@@ -2273,12 +3496,15 @@ ProviderResult Camera2CameraProvider::destroy_stream(uint64_t stream_id) {
   auto dev_it = devices_.find(dev_id);
   if (dev_it != devices_.end()) {
     if (dev_it->second.backend) {
-      std::lock_guard<std::mutex> bl(dev_it->second.backend->m);
-      dev_it->second.backend->stream.reset();
-    }
-    if (dev_it->second.stream_id == stream_id) {
-      dev_it->second.stream_id = 0;
+      DeviceBackend& backend = *dev_it->second.backend;
+      std::lock_guard<std::mutex> bl(backend.m);
+      if (StreamProduction* production = backend.find_stream_locked(stream_id)) {
+        camera2_detail::retire_stream_pool_record_locked(backend, *production);
+      }
+      backend.streams.erase(stream_id);
     }
+    auto& ids = dev_it->second.stream_ids;
+    ids.erase(std::remove(ids.begin(), ids.end(), stream_id), ids.end());
   }
 
   // Quiescence: posted frames referencing this stream drain before the stream
@@ -2292,117 +3518,117 @@ ProviderResult Camera2CameraProvider::destroy_stream(uint64_t stream_id) {
   return ProviderResult::success();
 }
 
-ProviderResult Camera2CameraProvider::start_stream(
-    uint64_t stream_id,
-    const CaptureProfile& profile,
-    const PictureConfig& /*picture*/) {
-  if (!initialized_.load(std::memory_order_acquire) ||
-      shutting_down_.load(std::memory_order_acquire)) {
-    return ProviderResult::failure(ProviderError::ERR_BAD_STATE);
-  }
-  if (profile.width == 0 || profile.height == 0) {
-    return ProviderResult::failure(ProviderError::ERR_INVALID_ARGUMENT);
-  }
-  if (profile.format_fourcc != FOURCC_RGBA && profile.format_fourcc != FOURCC_BGRA) {
-    return ProviderResult::failure(ProviderError::ERR_NOT_SUPPORTED);
-  }
-
-  std::lock_guard<std::mutex> state_lock(state_mutex_);
-  auto st_it = streams_.find(stream_id);
-  if (st_it == streams_.end() || !st_it->second.created) {
-    return ProviderResult::failure(ProviderError::ERR_BAD_STATE);
-  }
-  if (st_it->second.started) {
-    return ProviderResult::failure(ProviderError::ERR_BAD_STATE);
-  }
-  auto dev_it = devices_.find(st_it->second.req.device_instance_id);
-  if (dev_it == devices_.end() || !dev_it->second.open) {
-    return ProviderResult::failure(ProviderError::ERR_BAD_STATE);
-  }
-  DeviceState& dev = dev_it->second;
-  if (!dev.backend) {
+ProviderResult Camera2CameraProvider::set_repeating_streams_(
+    const std::shared_ptr<DeviceBackend>& backend,
+    const std::vector<uint64_t>& stream_ids) {
+  if (!backend) {
     return ProviderResult::failure(ProviderError::ERR_BAD_STATE);
   }
+  // Held so the session cannot be rebuilt under the request being swapped.
+  std::lock_guard<std::mutex> configure_lock(backend->configure_mutex);
 
-  // Provision the still output alongside the stream at the same geometry, so
-  // still capture while streaming works without a session rebuild. A capture
-  // at a different geometry is refused while producing; see the header.
-  ProviderResult pr = ensure_session_configured_(dev.backend, true, profile.width,
-                                                 profile.height, true, profile.width,
-                                                 profile.height);
-  if (!pr.ok()) {
-    return pr;
-  }
-
-  StreamState& st = st_it->second;
-  st.req.profile = profile;
-
-  uint64_t session_native_id = 0;
-  {
-    std::lock_guard<std::mutex> bl(dev.backend->m);
-    session_native_id = dev.backend->acquisition_session_id;
-  }
-
-  auto production = std::make_shared<StreamProduction>();
-  production->stream_id = stream_id;
-  production->device_instance_id = dev.device_instance_id;
-  production->acquisition_session_id = session_native_id;
-  production->width = profile.width;
-  production->height = profile.height;
-  production->fourcc = profile.format_fourcc;
-  production->plan = st.req.requested_retained_plan;
-  const size_t frame_bytes =
-      static_cast<size_t>(profile.width) * static_cast<size_t>(profile.height) * 4u;
-  production->pool.reserve(kStreamPoolSlots);
-  for (size_t i = 0; i < kStreamPoolSlots; ++i) {
-    auto slot = std::make_shared<StreamProduction::BufferSlot>();
-    slot->bytes.resize(frame_bytes);
-    production->pool.push_back(std::move(slot));
-  }
-
-  // Build and submit the repeating request on the control thread; it is a
-  // backend call and must stay off the core thread's own stack.
-  struct StartResult {
+  struct RepeatingResult {
     ProviderError error = ProviderError::ERR_PROVIDER_FAILED;
     bool ok = false;
   };
-  auto result = std::make_shared<StartResult>();
+  auto result = std::make_shared<RepeatingResult>();
   auto token = std::make_shared<BoundedControlExecutor::AbandonToken>();
-  std::shared_ptr<DeviceBackend> backend = dev.backend;
   const bool completed = control_.run_bounded(
-      [result, backend](const BoundedControlExecutor::AbandonToken& t) {
-        StartResult local;
+      [result, backend, stream_ids](const BoundedControlExecutor::AbandonToken& t) {
+        RepeatingResult local;
         ACameraDevice* device = nullptr;
         ACameraCaptureSession* session = nullptr;
-        ANativeWindow* window = nullptr;
+        std::vector<ANativeWindow*> windows;
+        bool missing_output = false;
         {
           std::lock_guard<std::mutex> bl(backend->m);
           device = backend->device;
           session = backend->session;
-          window = backend->stream_window;
+          for (const uint64_t id : stream_ids) {
+            ANativeWindow* window = nullptr;
+            for (const DeviceBackend::StreamOutput& out : backend->stream_outputs) {
+              if (out.spec.stream_id == id) {
+                window = out.window;
+              }
+            }
+            missing_output = missing_output || !window;
+            windows.push_back(window);
+          }
         }
-        if (!device || !session || !window) {
+        if (!device || !session || missing_output) {
           local.error = ProviderError::ERR_BAD_STATE;
           if (!t.abandoned.load(std::memory_order_acquire)) *result = local;
           return;
         }
 
+        // Swaps the latched request and targets for the new ones (null when
+        // the flow stopped) and frees the old ones outside the lock.
+        const auto latch = [&](ACaptureRequest* request,
+                               const std::vector<ACameraOutputTarget*>& targets) {
+          ACaptureRequest* old_request = nullptr;
+          std::vector<ACameraOutputTarget*> old_targets;
+          {
+            std::lock_guard<std::mutex> bl(backend->m);
+            old_request = std::exchange(backend->repeating_request, request);
+            for (DeviceBackend::StreamOutput& out : backend->stream_outputs) {
+              if (out.target) {
+                old_targets.push_back(std::exchange(out.target, nullptr));
+              }
+              for (size_t i = 0; i < stream_ids.size() && i < targets.size(); ++i) {
+                if (out.spec.stream_id == stream_ids[i]) {
+                  out.target = targets[i];
+                }
+              }
+            }
+            backend->repeating_active = request != nullptr;
+          }
+          if (old_request) ACaptureRequest_free(old_request);
+          for (ACameraOutputTarget* tg : old_targets) {
+            ACameraOutputTarget_free(tg);
+          }
+        };
+
+        if (stream_ids.empty()) {
+          ACameraCaptureSession_stopRepeating(session);
+          latch(nullptr, {});
+          local.ok = true;
+          *result = local;
+          return;
+        }
+
         ACaptureRequest* request = nullptr;
-        ACameraOutputTarget* target = nullptr;
+        std::vector<ACameraOutputTarget*> targets;
+        const auto unwind = [&]() {
+          for (ACameraOutputTarget* tg : targets) {
+            if (tg) ACameraOutputTarget_free(tg);
+          }
+          if (request) ACaptureRequest_free(request);
+        };
         camera_status_t cs =
             ACameraDevice_createCaptureRequest(device, TEMPLATE_PREVIEW, &request);
         if (cs != ACAMERA_OK || !request) {
+          request = nullptr;
           local.error = camera2_detail::provider_error_from_camera_status(cs);
           if (!t.abandoned.load(std::memory_order_acquire)) *result = local;
           return;
         }
-        if (ACameraOutputTarget_create(window, &target) != ACAMERA_OK || !target ||
-            ACaptureRequest_addTarget(request, target) != ACAMERA_OK) {
-          if (target) ACameraOutputTarget_free(target);
-          ACaptureRequest_free(request);
-          local.error = ProviderError::ERR_PROVIDER_FAILED;
-          if (!t.abandoned.load(std::memory_order_acquire)) *result = local;
-          return;
+        // One request targeting every started sibling: each sensor frame
+        // lands on all of their outputs, scaled by the ISP.
+        for (ANativeWindow* window : windows) {
+          ACameraOutputTarget* target = nullptr;
+          if (ACameraOutputTarget_create(window, &target) != ACAMERA_OK || !target) {
+            local.error = ProviderError::ERR_PROVIDER_FAILED;
+            unwind();
+            if (!t.abandoned.load(std::memory_order_acquire)) *result = local;
+            return;
+          }
+          targets.push_back(target);
+          if (ACaptureRequest_addTarget(request, target) != ACAMERA_OK) {
+            local.error = ProviderError::ERR_PROVIDER_FAILED;
+            unwind();
+            if (!t.abandoned.load(std::memory_order_acquire)) *result = local;
+            return;
+          }
         }
 
         // Result callbacks on the repeating request exist to observe AF state.
@@ -2413,11 +3639,12 @@ ProviderResult Camera2CameraProvider::start_stream(
         repeating_cbs.context = backend->repeating_ctx.get();
         repeating_cbs.onCaptureCompleted = &camera2_detail::on_repeating_capture_completed;
 
+        // Replaces any current repeating request in place; the session and
+        // the siblings already flowing are left as they are.
         cs = ACameraCaptureSession_setRepeatingRequest(session, &repeating_cbs, 1, &request,
                                                        nullptr);
         if (cs != ACAMERA_OK) {
-          ACameraOutputTarget_free(target);
-          ACaptureRequest_free(request);
+          unwind();
           local.error = camera2_detail::provider_error_from_camera_status(cs);
           camera2_detail::log_line("setRepeatingRequest failed status=%d",
                                    static_cast<int>(cs));
@@ -2426,21 +3653,27 @@ ProviderResult Camera2CameraProvider::start_stream(
         }
 
         if (t.abandoned.load(std::memory_order_acquire)) {
-          // Caller gave up: stop the flow we just started rather than leaving
-          // the camera streaming into a stream nobody will publish.
-          ACameraCaptureSession_stopRepeating(session);
-          ACameraOutputTarget_free(target);
-          ACaptureRequest_free(request);
-          return;
-        }
-        {
-          std::lock_guard<std::mutex> bl(backend->m);
-          backend->repeating_request = request;
-          backend->stream_target = target;
-          backend->repeating_active = true;
+          // Caller gave up. Keep the new flow only if a sibling it targets
+          // is still producing; otherwise stop it rather than leaving the
+          // camera streaming into streams nobody will publish.
+          bool any_producing = false;
+          {
+            std::lock_guard<std::mutex> bl(backend->m);
+            for (const uint64_t id : stream_ids) {
+              const StreamProduction* production = backend->find_stream_locked(id);
+              any_producing = any_producing || (production && production->producing);
+            }
+          }
+          if (!any_producing) {
+            ACameraCaptureSession_stopRepeating(session);
+            unwind();
+            latch(nullptr, {});
+            return;
+          }
         }
+        latch(request, targets);
         local.ok = true;
-        *result = local;
+        if (!t.abandoned.load(std::memory_order_acquire)) *result = local;
       },
       token, kControlJobTimeoutMs);
   if (!completed) {
@@ -2449,6 +3682,78 @@ ProviderResult Camera2CameraProvider::start_stream(
   if (!result->ok) {
     return ProviderResult::failure(result->error);
   }
+  return ProviderResult::success();
+}
+
+ProviderResult Camera2CameraProvider::start_stream(
+    uint64_t stream_id,
+    const CaptureProfile& profile,
+    const PictureConfig& /*picture*/) {
+  if (!initialized_.load(std::memory_order_acquire) ||
+      shutting_down_.load(std::memory_order_acquire)) {
+    return ProviderResult::failure(ProviderError::ERR_BAD_STATE);
+  }
+  if (profile.width == 0 || profile.height == 0) {
+    return ProviderResult::failure(ProviderError::ERR_INVALID_ARGUMENT);
+  }
+  if (profile.format_fourcc != FOURCC_RGBA && profile.format_fourcc != FOURCC_BGRA &&
+      !is_planar_yuv420_fourcc(profile.format_fourcc)) {
+    return ProviderResult::failure(ProviderError::ERR_NOT_SUPPORTED);
+  }
+
+  std::lock_guard<std::mutex> state_lock(state_mutex_);
+  auto st_it = streams_.find(stream_id);
+  if (st_it == streams_.end() || !st_it->second.created) {
+    return ProviderResult::failure(ProviderError::ERR_BAD_STATE);
+  }
+  if (st_it->second.started) {
+    return ProviderResult::failure(ProviderError::ERR_BAD_STATE);
+  }
+  auto dev_it = devices_.find(st_it->second.req.device_instance_id);
+  if (dev_it == devices_.end() || !dev_it->second.open) {
+    return ProviderResult::failure(ProviderError::ERR_BAD_STATE);
+  }
+  DeviceState& dev = dev_it->second;
+  if (!dev.backend) {
+    return ProviderResult::failure(ProviderError::ERR_BAD_STATE);
+  }
+
+  // Every created sibling is an output of the session, so starting another
+  // one later only swaps the repeating request. The still output rides
+  // alongside at the largest sibling geometry, so still capture while
+  // streaming works without a session rebuild. A capture at a different
+  // geometry is refused while producing; see the header.
+  uint32_t still_width = 0;
+  uint32_t still_height = 0;
+  const std::vector<camera2_detail::StreamOutputSpec> specs =
+      session_stream_specs_(dev, stream_id, profile, still_width, still_height);
+  std::vector<uint64_t> repeating_ids;
+  {
+    std::lock_guard<std::mutex> bl(dev.backend->m);
+    for (const camera2_detail::StreamOutputSpec& spec : specs) {
+      const StreamProduction* production = dev.backend->find_stream_locked(spec.stream_id);
+      if (spec.stream_id == stream_id || (production && production->producing)) {
+        repeating_ids.push_back(spec.stream_id);
+      }
+    }
+  }
+  ProviderResult pr =
+      ensure_session_configured_(dev.backend, specs, true, still_width, still_height);
+  if (!pr.ok()) {
+    return pr;
+  }
+
+  StreamState& st = st_it->second;
+  st.req.profile = profile;
+  std::shared_ptr<StreamProduction> production =
+      make_stream_production_(dev, stream_id, profile, st.req.requested_retained_plan, st.pool_depth_hint);
+
+  // The repeating request is built and submitted on the control thread; it
+  // is a backend call and must stay off the core thread's own stack.
+  pr = set_repeating_streams_(dev.backend, repeating_ids);
+  if (!pr.ok()) {
+    return pr;
+  }
 
   {
     std::lock_guard<std::mutex> bl(dev.backend->m);
@@ -2456,7 +3761,11 @@ ProviderResult Camera2CameraProvider::start_stream(
       return ProviderResult::failure(ProviderError::ERR_PROVIDER_FAILED);
     }
     production->producing = true;
-    dev.backend->stream = production;
+    if (StreamProduction* previous = dev.backend->find_stream_locked(stream_id)) {
+      camera2_detail::retire_stream_pool_record_locked(*dev.backend, *previous);
+    }
+    dev.backend->streams[stream_id] = production;
+    camera2_detail::report_stream_pool_record_locked(*dev.backend, *production);
   }
 
   st.started = true;
@@ -2482,31 +3791,24 @@ ProviderResult Camera2CameraProvider::stop_stream(uint64_t stream_id) {
     backend = dev_it->second.backend;
   }
   if (backend) {
+    std::vector<uint64_t> still_repeating;
     {
       std::lock_guard<std::mutex> bl(backend->m);
-      auto& stream = backend->stream;
-      if (stream && stream->stream_id == stream_id) {
-        already_stopped_by_error = !stream->producing;
-        stream->producing = false;
+      if (StreamProduction* production = backend->find_stream_locked(stream_id)) {
+        already_stopped_by_error = !production->producing;
+        production->producing = false;
+      }
+      for (const uint64_t id : dev_it->second.stream_ids) {
+        const StreamProduction* production = backend->find_stream_locked(id);
+        if (production && production->producing) {
+          still_repeating.push_back(id);
+        }
       }
     }
-    // Stop the repeating flow for real; leaving it running would keep the
+    // Stop this output's flow for real; leaving it targeted would keep the
     // sensor and the reader busy behind a stream Core considers stopped.
-    auto token = std::make_shared<BoundedControlExecutor::AbandonToken>();
-    (void)control_.run_bounded(
-        [backend](const BoundedControlExecutor::AbandonToken& /*t*/) {
-          ACameraCaptureSession* session = nullptr;
-          {
-            std::lock_guard<std::mutex> bl(backend->m);
-            session = backend->session;
-          }
-          if (session) {
-            ACameraCaptureSession_stopRepeating(session);
-          }
-          std::lock_guard<std::mutex> bl(backend->m);
-          backend->repeating_active = false;
-        },
-        token, kControlJobTimeoutMs);
+    // Siblings still producing keep flowing through the narrowed request.
+    (void)set_repeating_streams_(backend, still_repeating);
   }
 
   st_it->second.started = false;
@@ -2518,6 +3820,198 @@ ProviderResult Camera2CameraProvider::stop_stream(uint64_t stream_id) {
   return ProviderResult::success();
 }
 
+ProviderResult Camera2CameraProvider::reconfigure_stream(uint64_t stream_id,
+                                                        const CaptureProfile& profile) {
+  if (!initialized_.load(std::memory_order_acquire) ||
+      shutting_down_.load(std::memory_order_acquire)) {
+    return ProviderResult::failure(ProviderError::ERR_BAD_STATE);
+  }
+  if (profile.width == 0 || profile.height == 0) {
+    return ProviderResult::failure(ProviderError::ERR_INVALID_ARGUMENT);
+  }
+  if (profile.format_fourcc != FOURCC_RGBA && profile.format_fourcc != FOURCC_BGRA &&
+      !is_planar_yuv420_fourcc(profile.format_fourcc)) {
+    return ProviderResult::failure(ProviderError::ERR_NOT_SUPPORTED);
+  }
+
+  std::lock_guard<std::mutex> state_lock(state_mutex_);
+  auto st_it = streams_.find(stream_id);
+  if (st_it == streams_.end() || !st_it->second.created) {
+    return ProviderResult::failure(ProviderError::ERR_BAD_STATE);
+  }
+  auto dev_it = devices_.find(st_it->second.req.device_instance_id);
+  if (dev_it == devices_.end() || !dev_it->second.open || !dev_it->second.backend) {
+    return ProviderResult::failure(ProviderError::ERR_BAD_STATE);
+  }
+  DeviceState& dev = dev_it->second;
+  StreamState& st = st_it->second;
+  const std::shared_ptr<DeviceBackend> backend = dev.backend;
+  const CaptureProfile previous = st.req.profile;
+  if (!st.started) {
+    // The session follows at start_stream.
+    st.req.profile = profile;
+    return ProviderResult::success();
+  }
+
+  // Swaps a fresh production in for the stream's current one. Frames from
+  // the old one stop at the swap; the stream stays started throughout.
+  const auto swap_production = [&](const CaptureProfile& p) -> bool {
+    std::shared_ptr<StreamProduction> production =
+        make_stream_production_(dev, stream_id, p, st.req.requested_retained_plan, st.pool_depth_hint);
+    std::lock_guard<std::mutex> bl(backend->m);
+    if (backend->failed || backend->closed) {
+      return false;
+    }
+    production->producing = true;
+    if (StreamProduction* old = backend->find_stream_locked(stream_id)) {
+      old->producing = false;
+      camera2_detail::retire_stream_pool_record_locked(*backend, *old);
+    }
+    backend->streams[stream_id] = production;
+    camera2_detail::report_stream_pool_record_locked(*backend, *production);
+    return true;
+  };
+
+  if (previous.width == profile.width && previous.height == profile.height) {
+    // Same reader geometry: conversion happens per production, so a format
+    // change needs no session work, and frame rate is not applied to the
+    // repeating request at all.
+    if (!swap_production(profile)) {
+      return ProviderResult::failure(ProviderError::ERR_PROVIDER_FAILED);
+    }
+    st.req.profile = profile;
+    return ProviderResult::success();
+  }
+
+  // A new reader size means new session outputs. The device stays open and
+  // only the session is rebuilt, which is refused while a sibling is still
+  // flowing through it.
+  {
+    std::lock_guard<std::mutex> bl(backend->m);
+    for (const auto& [id, production] : backend->streams) {
+      if (id != stream_id && production && production->producing) {
+        return ProviderResult::failure(ProviderError::ERR_PLATFORM_CONSTRAINT);
+      }
+    }
+  }
+
+  // Pause publication and the repeating flow, rebuild at p and resume.
+  const auto rebuild_at = [&](const CaptureProfile& p) -> ProviderResult {
+    {
+      std::lock_guard<std::mutex> bl(backend->m);
+      if (StreamProduction* production = backend->find_stream_locked(stream_id)) {
+        production->producing = false;
+      }
+    }
+    ProviderResult r = set_repeating_streams_(backend, {});
+    if (!r.ok()) {
+      return r;
+    }
+    uint32_t still_width = 0;
+    uint32_t still_height = 0;
+    const std::vector<camera2_detail::StreamOutputSpec> specs =
+        session_stream_specs_(dev, stream_id, p, still_width, still_height);
+    r = ensure_session_configured_(backend, specs, true, still_width, still_height);
+    if (!r.ok()) {
+      return r;
+    }
+    r = set_repeating_streams_(backend, {stream_id});
+    if (!r.ok()) {
+      return r;
+    }
+    if (!swap_production(p)) {
+      return ProviderResult::failure(ProviderError::ERR_PROVIDER_FAILED);
+    }
+    return ProviderResult::success();
+  };
+
+  const ProviderResult pr = rebuild_at(profile);
+  if (pr.ok()) {
+    st.req.profile = profile;
+    return pr;
+  }
+  camera2_detail::log_line("stream=%llu reconfigure to %ux%u failed code=%u; restoring %ux%u",
+                           static_cast<unsigned long long>(stream_id), profile.width,
+                           profile.height, static_cast<unsigned>(pr.code), previous.width,
+                           previous.height);
+  if (!rebuild_at(previous).ok()) {
+    // Neither geometry runs: the stream has stopped, so say so.
+    {
+      std::lock_guard<std::mutex> bl(backend->m);
+      if (StreamProduction* production = backend->find_stream_locked(stream_id)) {
+        production->producing = false;
+      }
+    }
+    (void)set_repeating_streams_(backend, {});
+    st.started = false;
+    strand_.post_stream_stopped(stream_id, pr.code);
+  }
+  return pr;
+}
+
+std::vector<camera2_detail::StreamOutputSpec> Camera2CameraProvider::session_stream_specs_(
+    const DeviceState& dev,
+    uint64_t stream_id,
+    const CaptureProfile& profile,
+    uint32_t& still_width,
+    uint32_t& still_height) const {
+  std::vector<camera2_detail::StreamOutputSpec> specs;
+  still_width = 0;
+  still_height = 0;
+  for (const uint64_t id : dev.stream_ids) {
+    const auto sibling = streams_.find(id);
+    if (sibling == streams_.end()) {
+      continue;
+    }
+    const CaptureProfile& p = id == stream_id ? profile : sibling->second.req.profile;
+    if (p.width == 0 || p.height == 0) {
+      continue;
+    }
+    specs.push_back(camera2_detail::StreamOutputSpec{id, p.width, p.height});
+    if (static_cast<uint64_t>(p.width) * p.height >
+        static_cast<uint64_t>(still_width) * still_height) {
+      still_width = p.width;
+      still_height = p.height;
+    }
+  }
+  return specs;
+}
+
+std::shared_ptr<StreamProduction> Camera2CameraProvider::make_stream_production_(
+    const DeviceState& dev,
+    uint64_t stream_id,
+    const CaptureProfile& profile,
+    const CoreRetainedProductionPlan& plan,
+    uint32_t pool_depth_hint) {
+  uint64_t session_native_id = 0;
+  {
+    std::lock_guard<std::mutex> bl(dev.backend->m);
+    session_native_id = dev.backend->acquisition_session_id;
+  }
+
+  auto production = std::make_shared<StreamProduction>();
+  production->stream_id = stream_id;
+  production->device_instance_id = dev.device_instance_id;
+  production->acquisition_session_id = session_native_id;
+  production->width = profile.width;
+  production->height = profile.height;
+  production->fourcc = profile.format_fourcc;
+  production->plan = plan;
+  production->frame_bytes =
+      stream_frame_bytes(profile.width, profile.height, profile.format_fourcc);
+  // target_fps_max 0 leaves the rate to the device; stream_template() offers 30.
+  production->frame_period_ns =
+      1'000'000'000ll / static_cast<int64_t>(profile.target_fps_max != 0 ? profile.target_fps_max : 30);
+  production->apply_pool_depth_hint(kStreamPoolSlots, pool_depth_hint);
+  production->root_id = dev.root_id;
+  production->provider_native_id = provider_native_id_;
+  production->pool.reserve(StreamProduction::kMaxPoolSlots);
+  for (size_t i = 0; i < production->min_pool_slots; ++i) {
+    production->pool.push_back(std::make_shared<StreamProduction::BufferSlot>());
+  }
+  return production;
+}
+
 ProviderResult Camera2CameraProvider::update_stream_retained_production_plan(
     uint64_t stream_id,
     CoreRetainedProductionPlan requested_retained_plan) {
@@ -2543,14 +4037,53 @@ ProviderResult Camera2CameraProvider::update_stream_retained_production_plan(
   auto dev_it = devices_.find(st_it->second.req.device_instance_id);
   if (dev_it != devices_.end() && dev_it->second.backend) {
     std::lock_guard<std::mutex> bl(dev_it->second.backend->m);
-    auto& stream = dev_it->second.backend->stream;
-    if (stream && stream->stream_id == stream_id) {
+    if (StreamProduction* stream = dev_it->second.backend->find_stream_locked(stream_id)) {
       stream->plan = requested_retained_plan;
     }
   }
   return ProviderResult::success();
 }
 
+void Camera2CameraProvider::set_stream_pool_depth_hint(uint64_t stream_id,
+                                                       const StreamPoolDepthHint& hint) noexcept try {
+  if (!initialized_.load(std::memory_order_acquire)) {
+    return;
+  }
+  // Slots pin Core-pooled bytes only until release (see BufferSlot), so the
+  // in-flight depth is all the pool needs; retained results are Core's.
+  std::lock_guard<std::mutex> state_lock(state_mutex_);
+  auto st_it = streams_.find(stream_id);
+  if (st_it == streams_.end() || !st_it->second.created) {
+    return;
+  }
+  st_it->second.pool_depth_hint = hint.in_flight_frames;
+
+  auto dev_it = devices_.find(st_it->second.req.device_instance_id);
+  if (dev_it == devices_.end() || !dev_it->second.backend) {
+    return;
+  }
+  DeviceBackend& backend = *dev_it->second.backend;
+  std::lock_guard<std::mutex> bl(backend.m);
+  StreamProduction* s = backend.find_stream_locked(stream_id);
+  if (!s) {
+    return;
+  }
+  // A deeper floor is filled now, so the first burst after the change does
+  // not have to grow the pool one drop-averted slot at a time; a shallower
+  // one is left to the shrink window.
+  s->apply_pool_depth_hint(kStreamPoolSlots, hint.in_flight_frames);
+  if (s->pool.size() >= s->min_pool_slots) {
+    return;
+  }
+  while (s->pool.size() < s->min_pool_slots) {
+    s->pool.push_back(std::make_shared<StreamProduction::BufferSlot>());
+  }
+  s->cursor = 0;
+  ++s->pool_resizes;
+  camera2_detail::update_stream_pool_record_locked(backend, *s);
+} catch (...) {
+}
+
 ProviderResult Camera2CameraProvider::set_stream_picture_config(
     uint64_t /*stream_id*/, const PictureConfig& /*picture*/) {
   return ProviderResult::failure(ProviderError::ERR_NOT_SUPPORTED);
@@ -2610,6 +4143,7 @@ void Camera2CameraProvider::stop_and_join_capture_executor_() noexcept {
 }
 
 void Camera2CameraProvider::capture_worker_main_() noexcept {
+  apply_current_thread_policy(CBThreadRole::CaptureWorker, "cambang-c2-cap");
   for (;;) {
     DeviceCaptureJob job;
     {
@@ -2653,6 +4187,7 @@ bool Camera2CameraProvider::capture_burst_(
   burst->width = width;
   burst->height = height;
   burst->fourcc = format_fourcc;
+  burst->results.reserve(specs.size());
 
   {
     std::lock_guard<std::mutex> bl(backend->m);
@@ -2660,6 +4195,11 @@ bool Camera2CameraProvider::capture_burst_(
       for (auto& f : out_frames) f.error = ProviderError::ERR_PROVIDER_FAILED;
       return false;
     }
+    // The cadence and AF diagnostics are only logged to tell bracket members
+    // apart, so a single capture skips them.
+    burst->fact_tags = backend->chars.result_fact_tags &
+                       (specs.size() > 1 ? camera2_detail::kResultFactAll
+                                         : ~camera2_detail::kResultFactDiagnostics);
     backend->burst = burst;
   }
   // Whatever happens below, this capture must stop owning the collector slot,
@@ -2698,42 +4238,58 @@ bool Camera2CameraProvider::capture_burst_(
           return;
         }
 
+        // Reuse the previous capture's requests when they target this still
+        // window; a burst position keeps its request only if it carries the
+        // same entries, so rewriting values below leaves nothing stale behind.
+        std::vector<DeviceBackend::CachedStillRequest>& cache = backend->still_requests;
+        const auto free_cached = [](DeviceBackend::CachedStillRequest& cached) {
+          if (cached.request) ACaptureRequest_free(cached.request);
+          if (cached.target) ACameraOutputTarget_free(cached.target);
+          cached = DeviceBackend::CachedStillRequest{};
+        };
+        if (backend->still_requests_window != window) {
+          for (DeviceBackend::CachedStillRequest& cached : cache) free_cached(cached);
+          cache.clear();
+          backend->still_requests_window = window;
+        }
+        if (cache.size() < specs.size()) {
+          cache.resize(specs.size());
+        }
         std::vector<ACaptureRequest*> requests;
-        std::vector<ACameraOutputTarget*> targets;
-        // Everything acquired here is freed on every path; Camera2 copies what
-        // it needs at submission, so none of it outlives this job.
-        const auto unwind = [&]() {
-          for (ACaptureRequest* r : requests) {
-            if (r) ACaptureRequest_free(r);
-          }
-          for (ACameraOutputTarget* tg : targets) {
-            if (tg) ACameraOutputTarget_free(tg);
-          }
-          requests.clear();
-          targets.clear();
+        requests.reserve(specs.size());
+        // A request that failed mid-patch may hold a half-written entry set,
+        // so it is dropped rather than reused.
+        const auto fail_member = [&](size_t i, ProviderError error) {
+          free_cached(cache[i]);
+          local.error = error;
+          if (!t.abandoned.load(std::memory_order_acquire)) *submit = local;
         };
 
         camera_status_t cs = ACAMERA_OK;
-        for (const MemberRequestSpec& spec : specs) {
-          ACaptureRequest* request = nullptr;
-          ACameraOutputTarget* target = nullptr;
-          cs = ACameraDevice_createCaptureRequest(device, TEMPLATE_STILL_CAPTURE, &request);
-          if (cs != ACAMERA_OK || !request) {
-            local.error = camera2_detail::provider_error_from_camera_status(cs);
-            unwind();
-            if (!t.abandoned.load(std::memory_order_acquire)) *submit = local;
-            return;
+        for (size_t i = 0; i < specs.size(); ++i) {
+          const MemberRequestSpec& spec = specs[i];
+          const uint8_t shape = spec.request_shape(awb_lock_available);
+          DeviceBackend::CachedStillRequest& cached = cache[i];
+          if (cached.request && cached.shape != shape) {
+            free_cached(cached);
           }
-          requests.push_back(request);
-          if (ACameraOutputTarget_create(window, &target) != ACAMERA_OK || !target ||
-              ACaptureRequest_addTarget(request, target) != ACAMERA_OK) {
-            if (target) ACameraOutputTarget_free(target);
-            local.error = ProviderError::ERR_PROVIDER_FAILED;
-            unwind();
-            if (!t.abandoned.load(std::memory_order_acquire)) *submit = local;
-            return;
+          if (!cached.request) {
+            cs = ACameraDevice_createCaptureRequest(device, TEMPLATE_STILL_CAPTURE,
+                                                    &cached.request);
+            if (cs != ACAMERA_OK || !cached.request) {
+              cached.request = nullptr;
+              fail_member(i, camera2_detail::provider_error_from_camera_status(cs));
+              return;
+            }
+            if (ACameraOutputTarget_create(window, &cached.target) != ACAMERA_OK ||
+                !cached.target ||
+                ACaptureRequest_addTarget(cached.request, cached.target) != ACAMERA_OK) {
+              fail_member(i, ProviderError::ERR_PROVIDER_FAILED);
+              return;
+            }
+            cached.shape = shape;
           }
-          targets.push_back(target);
+          ACaptureRequest* request = cached.request;
 
           if (spec.manual) {
             // AE off plus an explicit exposure/sensitivity pair. Nothing has to
@@ -2749,18 +4305,14 @@ bool Camera2CameraProvider::capture_burst_(
                                              &exposure) != ACAMERA_OK ||
                 ACaptureRequest_setEntry_i32(request, ACAMERA_SENSOR_SENSITIVITY, 1,
                                              &sensitivity) != ACAMERA_OK) {
-              local.error = ProviderError::ERR_PLATFORM_CONSTRAINT;
-              unwind();
-              if (!t.abandoned.load(std::memory_order_acquire)) *submit = local;
+              fail_member(i, ProviderError::ERR_PLATFORM_CONSTRAINT);
               return;
             }
             if (spec.frame_duration_ns > 0) {
               const int64_t frame_duration = spec.frame_duration_ns;
               if (ACaptureRequest_setEntry_i64(request, ACAMERA_SENSOR_FRAME_DURATION, 1,
                                                &frame_duration) != ACAMERA_OK) {
-                local.error = ProviderError::ERR_PLATFORM_CONSTRAINT;
-                unwind();
-                if (!t.abandoned.load(std::memory_order_acquire)) *submit = local;
+                fail_member(i, ProviderError::ERR_PLATFORM_CONSTRAINT);
                 return;
               }
             }
@@ -2777,9 +4329,7 @@ bool Camera2CameraProvider::capture_burst_(
             if (ACaptureRequest_setEntry_i32(
                     request, ACAMERA_CONTROL_AE_EXPOSURE_COMPENSATION, 1, &comp_steps) !=
                 ACAMERA_OK) {
-              local.error = ProviderError::ERR_PLATFORM_CONSTRAINT;
-              unwind();
-              if (!t.abandoned.load(std::memory_order_acquire)) *submit = local;
+              fail_member(i, ProviderError::ERR_PLATFORM_CONSTRAINT);
               return;
             }
           }
@@ -2788,12 +4338,11 @@ bool Camera2CameraProvider::capture_burst_(
             const uint8_t trigger = spec.af_trigger;
             if (ACaptureRequest_setEntry_u8(request, ACAMERA_CONTROL_AF_TRIGGER, 1,
                                             &trigger) != ACAMERA_OK) {
-              local.error = ProviderError::ERR_PLATFORM_CONSTRAINT;
-              unwind();
-              if (!t.abandoned.load(std::memory_order_acquire)) *submit = local;
+              fail_member(i, ProviderError::ERR_PLATFORM_CONSTRAINT);
               return;
             }
           }
+          requests.push_back(request);
         }
 
         ACameraCaptureSession_captureCallbacks capture_cbs{};
@@ -2803,11 +4352,11 @@ bool Camera2CameraProvider::capture_burst_(
 
         // One submission for the whole bundle: Camera2 runs the requests
         // back-to-back on consecutive sensor frames instead of the caller
-        // reintroducing a pipeline round trip between each member.
+        // reintroducing a pipeline round trip between each member. It copies
+        // the requests here, so the next capture may rewrite the cached ones.
         cs = ACameraCaptureSession_capture(session, &capture_cbs,
                                            static_cast<int>(requests.size()),
                                            requests.data(), nullptr);
-        unwind();
         if (cs != ACAMERA_OK) {
           local.error = camera2_detail::provider_error_from_camera_status(cs);
           camera2_detail::log_line("burst capture submit failed status=%d members=%zu",
@@ -2838,16 +4387,18 @@ bool Camera2CameraProvider::capture_burst_(
   // takes backend->m -- so burst->m must be released before returning, or the
   // guard would invert that order against a concurrently arriving image.
   std::vector<BurstCollector::Image> images;
-  std::map<int64_t, ResultFacts> results_by_time;
-  std::vector<ResultFacts> results_in_order;
+  std::vector<ResultFacts> results;
   bool settled = false;
   {
     std::unique_lock<std::mutex> wl(burst->m);
     settled = burst->cv.wait_for(wl, std::chrono::milliseconds(kCaptureSampleWaitMs),
                                  [&burst] { return burst->settled(); });
     images = burst->images;
-    results_by_time = burst->results_by_time;
-    results_in_order = burst->results_in_order;
+    results = burst->results;
+  }
+  size_t results_keyed = 0;
+  for (const ResultFacts& result : results) {
+    if (result.has_sensor_timestamp) ++results_keyed;
   }
 
   // Sensor timestamps are monotonic within a device, so ascending timestamp is
@@ -2879,10 +4430,10 @@ bool Camera2CameraProvider::capture_burst_(
     }
     camera2_detail::log_line(
         "burst collect: expected=%zu images=%zu failed=%zu no_timestamp=%zu "
-        "results_by_time=%zu results_unkeyed=%zu strays_total=%llu settled=%s "
+        "results_keyed=%zu results_unkeyed=%zu strays_total=%llu settled=%s "
         "raw_deltas_ms=[%s]",
         burst->expected, images.size(), static_cast<size_t>(0) + burst->failed_count,
-        missing_timestamps, results_by_time.size(), results_in_order.size(),
+        missing_timestamps, results_keyed, results.size() - results_keyed,
         static_cast<unsigned long long>(
             backend->stray_still_images.load(std::memory_order_relaxed)),
         settled ? "yes" : "no", deltas);
@@ -2909,21 +4460,18 @@ bool Camera2CameraProvider::capture_burst_(
     // an unmatched result is dropped rather than attached to the wrong image.
     bool paired = false;
     if (img.has_timestamp) {
-      const auto it = results_by_time.find(img.timestamp_ns);
-      if (it != results_by_time.end()) {
-        out_frames[i].has_facts = true;
-        out_frames[i].facts = it->second;
-        paired = true;
+      for (const ResultFacts& result : results) {
+        if (result.has_sensor_timestamp && result.sensor_timestamp_ns == img.timestamp_ns) {
+          out_frames[i].has_facts = true;
+          out_frames[i].facts = result;
+          paired = true;
+          break;
+        }
       }
     }
-    if (!paired && out_frames.size() == 1) {
-      if (!results_in_order.empty()) {
-        out_frames[i].has_facts = true;
-        out_frames[i].facts = results_in_order.front();
-      } else if (!results_by_time.empty()) {
-        out_frames[i].has_facts = true;
-        out_frames[i].facts = results_by_time.begin()->second;
-      }
+    if (!paired && out_frames.size() == 1 && !results.empty()) {
+      out_frames[i].has_facts = true;
+      out_frames[i].facts = results.front();
     }
   }
   return true;
@@ -3060,6 +4608,24 @@ void Camera2CameraProvider::run_device_capture_job_(const DeviceCaptureJob& job)
     }
   };
 
+  // A member that terminalizes before the rig start point releases its
+  // siblings instead of holding them to the wait bound.
+  struct StartBarrierDropGuard {
+    CBCaptureStartBarrier* barrier = nullptr;
+    ~StartBarrierDropGuard() {
+      if (barrier) {
+        barrier->drop();
+      }
+    }
+  } start_barrier_guard{job.start_barrier.get()};
+  const auto await_rig_start = [&]() {
+    if (start_barrier_guard.barrier) {
+      start_barrier_guard.barrier = nullptr;
+      (void)job.start_barrier->arrive_and_wait(
+          std::chrono::milliseconds(kRigCaptureStartBarrierWaitMs));
+    }
+  };
+
   try {
     // Every admitted device job emits capture_started and exactly one
     // terminal fact, shutdown-cancellation included.
@@ -3098,29 +4664,25 @@ void Camera2CameraProvider::run_device_capture_job_(const DeviceCaptureJob& job)
     std::lock_guard<std::mutex> still_lock(backend->still_capture_mutex);
 
     bool stream_producing = false;
-    uint32_t stream_w = 0, stream_h = 0;
+    std::vector<camera2_detail::StreamOutputSpec> stream_specs;
     {
       std::lock_guard<std::mutex> bl(backend->m);
       if (backend->closed || backend->failed) {
         fail(ProviderError::ERR_PROVIDER_FAILED);
         return;
       }
-      if (backend->stream && backend->stream->producing) {
-        stream_producing = true;
-        stream_w = backend->stream->width;
-        stream_h = backend->stream->height;
+      stream_producing = backend->any_stream_producing_locked();
+      if (stream_producing) {
+        stream_specs = backend->configured_stream_specs_locked();
       }
     }
 
     // While a stream produces, the session output set is pinned; the capture
     // must fit it. Otherwise the session is rebuilt still-only at the
     // requested geometry.
-    ProviderResult pr =
-        stream_producing
-            ? ensure_session_configured_(backend, true, stream_w, stream_h, true,
-                                         job.request.width, job.request.height)
-            : ensure_session_configured_(backend, false, 0, 0, true, job.request.width,
-                                         job.request.height);
+    ProviderResult pr = ensure_session_configured_(
+        backend, stream_producing ? stream_specs : std::vector<camera2_detail::StreamOutputSpec>{},
+        true, job.request.width, job.request.height, job.request.format_fourcc);
     if (!pr.ok()) {
       fail(pr.code);
       return;
@@ -3384,6 +4946,7 @@ void Camera2CameraProvider::run_device_capture_job_(const DeviceCaptureJob& job)
         specs.push_back(spec);
       }
 
+      await_rig_start();
       if (!capture_burst_(backend, job.request.width, job.request.height,
                           job.request.format_fourcc, specs, frames)) {
         fail(frames.empty() ? ProviderError::ERR_PROVIDER_FAILED : frames[0].error);
@@ -3406,6 +4969,7 @@ void Camera2CameraProvider::run_device_capture_job_(const DeviceCaptureJob& job)
         }
         const std::vector<MemberRequestSpec> one{spec};
         std::vector<CapturedMemberFrame> single;
+        await_rig_start();
         if (!capture_burst_(backend, job.request.width, job.request.height,
                             job.request.format_fourcc, one, single) ||
             single.empty()) {
@@ -3520,8 +5084,18 @@ void Camera2CameraProvider::run_device_capture_job_(const DeviceCaptureJob& job)
             captured.timestamp_ns, chars.timestamp_source_realtime);
       }
       fv.data = captured.bytes->data();
-      fv.size_bytes = captured.bytes->size();
-      fv.stride_bytes = job.request.width * 4u;
+      if (is_planar_yuv420_fourcc(fv.format_fourcc)) {
+        camera2_detail::describe_tight_yuv420_planes(
+            captured.bytes->data(), fv.width, fv.height, fv.format_fourcc, fv);
+        fv.size_bytes = fv.planes[0].size_bytes;
+        fv.stride_bytes = fv.width;
+      } else if (is_raw_bayer_fourcc(fv.format_fourcc)) {
+        fv.size_bytes = captured.bytes->size();
+        fv.stride_bytes = raw_bayer_row_bytes(fv.format_fourcc, fv.width);
+      } else {
+        fv.size_bytes = captured.bytes->size();
+        fv.stride_bytes = job.request.width * 4u;
+      }
       // Fresh immutable allocation: publish for zero-copy retention (brief §4).
       fv.cpu_payload_owner = captured.bytes;
       fv.requested_retained_plan = job.request.requested_retained_plan;
@@ -3777,7 +5351,8 @@ ProviderResult Camera2CameraProvider::validate_and_admit_submission_locked_(
     if (req.width == 0 || req.height == 0) {
       return ProviderResult::failure(ProviderError::ERR_INVALID_ARGUMENT);
     }
-    if (req.format_fourcc != FOURCC_RGBA && req.format_fourcc != FOURCC_BGRA) {
+    if (req.format_fourcc != FOURCC_RGBA && req.format_fourcc != FOURCC_BGRA &&
+        !is_planar_yuv420_fourcc(req.format_fourcc) && !is_raw_bayer_fourcc(req.format_fourcc)) {
       return ProviderResult::failure(ProviderError::ERR_NOT_SUPPORTED);
     }
     if (!is_valid_capture_still_image_bundle(req.still_image_bundle,
@@ -3802,26 +5377,38 @@ ProviderResult Camera2CameraProvider::validate_and_admit_submission_locked_(
     {
       std::lock_guard<std::mutex> bl(dev_it->second.backend->m);
       const StaticCharacteristics& chars = dev_it->second.backend->chars;
-      if (!chars.supports_size(req.width, req.height)) {
+      if (!chars.supports_still_size(req.format_fourcc, req.width, req.height)) {
         camera2_detail::log_line(
             "capture admission refused: device=%llu rig=%llu size=%ux%u not in "
-            "supported still sizes -> ERR_PLATFORM_CONSTRAINT",
+            "supported still sizes for the format -> ERR_PLATFORM_CONSTRAINT",
             static_cast<unsigned long long>(req.device_instance_id),
             static_cast<unsigned long long>(req.rig_id), req.width, req.height);
         return ProviderResult::failure(ProviderError::ERR_PLATFORM_CONSTRAINT);
       }
       // A started stream pins the session output set; a capture that needs a
-      // different geometry cannot execute without rebuilding the session and
-      // dropping the live stream.
-      const auto& stream = dev_it->second.backend->stream;
-      if (stream && stream->producing &&
-          (stream->width != req.width || stream->height != req.height)) {
+      // different geometry than the still output provisioned beside the
+      // streams cannot execute without rebuilding the session and dropping
+      // the live streams.
+      bool pinned = false;
+      uint32_t pinned_w = 0, pinned_h = 0;
+      int32_t pinned_format = AIMAGE_FORMAT_YUV_420_888;
+      {
+        std::lock_guard<std::mutex> bl(dev_it->second.backend->m);
+        pinned = dev_it->second.backend->any_stream_producing_locked();
+        pinned_w = dev_it->second.backend->cfg_still_w;
+        pinned_h = dev_it->second.backend->cfg_still_h;
+        pinned_format = dev_it->second.backend->cfg_still_reader_format;
+      }
+      // The still output beside streams reads YUV, so a RAW capture is
+      // refused here too while they produce.
+      if (pinned && (pinned_w != req.width || pinned_h != req.height ||
+                     pinned_format != camera2_detail::still_reader_format(req.format_fourcc))) {
         camera2_detail::log_line(
             "capture admission refused: device=%llu rig=%llu request=%ux%u "
             "differs from producing stream=%ux%u -> ERR_PLATFORM_CONSTRAINT",
             static_cast<unsigned long long>(req.device_instance_id),
             static_cast<unsigned long long>(req.rig_id), req.width, req.height,
-            stream->width, stream->height);
+            pinned_w, pinned_h);
         return ProviderResult::failure(ProviderError::ERR_PLATFORM_CONSTRAINT);
       }
       if (req.still_image_bundle.members.size() > 1) {
@@ -3876,6 +5463,15 @@ ProviderResult Camera2CameraProvider::trigger_capture_submission(
     if (!pr.ok()) {
       return pr;
     }
+    // A rig wider than the worker count cannot have every member waiting at
+    // once, so it runs unsynchronized rather than timing out each capture.
+    if (submission.origin == CaptureSubmissionOrigin::RIG_CAPTURE && jobs.size() > 1 &&
+        jobs.size() <= kCaptureWorkerCount) {
+      const auto barrier = std::make_shared<CBCaptureStartBarrier>(jobs.size());
+      for (DeviceCaptureJob& job : jobs) {
+        job.start_barrier = barrier;
+      }
+    }
     for (DeviceCaptureJob& job : jobs) {
       in_flight_captures_[InFlightKey{job.request.capture_id,
                                       job.request.device_instance_id}] = job.generation;
@@ -3897,6 +5493,10 @@ ProviderResult Camera2CameraProvider::abort_capture(uint64_t /*capture_id*/) {
   return ProviderResult::failure(ProviderError::ERR_NOT_SUPPORTED);
 }
 
+uint64_t Camera2CameraProvider::producer_frames_dropped_total() const noexcept {
+  return producer_frames_dropped_.load(std::memory_order_relaxed);
+}
+
 ProviderResult Camera2CameraProvider::apply_camera_spec_patch(
     const std::string& hardware_id,
     uint64_t /*new_camera_spec_version*/,
@@ -3953,8 +5553,8 @@ ProviderResult Camera2CameraProvider::shutdown() {
     auto dev_it = devices_.find(st.req.device_instance_id);
     if (dev_it != devices_.end() && dev_it->second.backend) {
       std::lock_guard<std::mutex> bl(dev_it->second.backend->m);
-      if (dev_it->second.backend->stream) {
-        dev_it->second.backend->stream->producing = false;
+      if (StreamProduction* production = dev_it->second.backend->find_stream_locked(stream_id)) {
+        production->producing = false;
       }
     }
     st.started = false;
@@ -3972,9 +5572,15 @@ ProviderResult Camera2CameraProvider::shutdown() {
     if (dev_it != devices_.end()) {
       if (dev_it->second.backend) {
         std::lock_guard<std::mutex> bl(dev_it->second.backend->m);
-        dev_it->second.backend->stream.reset();
+        auto& productions = dev_it->second.backend->streams;
+        if (const auto production = productions.find(stream_id); production != productions.end()) {
+          camera2_detail::retire_stream_pool_record_locked(*dev_it->second.backend,
+                                                           *production->second);
+          productions.erase(production);
+        }
       }
-      dev_it->second.stream_id = 0;
+      auto& ids = dev_it->second.stream_ids;
+      ids.erase(std::remove(ids.begin(), ids.end(), stream_id), ids.end());
     }
     it = streams_.erase(it);
     strand_.post_stream_destroyed(stream_id);
@@ -3987,15 +5593,13 @@ ProviderResult Camera2CameraProvider::shutdown() {
       continue;
     }
     std::shared_ptr<DeviceBackend> backend = dev.backend;
+    bool native_created = false;
     if (backend) {
       {
         std::lock_guard<std::mutex> configure_lock(backend->configure_mutex);
         teardown_session_locked_(backend);
       }
-      {
-        std::lock_guard<std::mutex> bl(backend->m);
-        backend->closed = true;
-      }
+      native_created = mark_backend_closed_(backend);
       auto token = std::make_shared<BoundedControlExecutor::AbandonToken>();
       (void)control_.run_bounded(
           [backend](const BoundedControlExecutor::AbandonToken& /*t*/) {
@@ -4013,7 +5617,9 @@ ProviderResult Camera2CameraProvider::shutdown() {
     dev.open = false;
     dev.backend.reset();
     strand_.post_device_closed(dev_id);
-    emit_native_destroyed_(dev.native_id);
+    if (native_created) {
+      emit_native_destroyed_(dev.native_id);
+    }
     dev.native_id = 0;
   }
 
@@ -4022,10 +5628,16 @@ ProviderResult Camera2CameraProvider::shutdown() {
   } // release state_mutex_ before draining the strand (brief §10)
 
   // 6. With provider state settled and no locks held: flush and stop the
-  //    strand, then stop the control thread and release the manager.
+  //    strand, then stop the control and conversion threads and release the
+  //    manager. Device close already quiesced every still listener, so no
+  //    conversion can still be using the band pool.
   strand_.flush();
   strand_.stop();
+  // An open that outlived close's wait finishes here and releases its
+  // device; it reports nothing once the backend is closed.
+  stop_open_workers_();
   control_.stop();
+  still_conversion_.stop();
   manager_.reset();
 
   callbacks_ = nullptr;
@@ -16,9 +16,15 @@
 //   - Pixel format. Camera2 guarantees YUV_420_888, JPEG and PRIVATE outputs;
 //     RGBA_8888 from the camera HAL is not a guaranteed capability. Core's
 //     profiles are packed RGBA/BGRA, so the provider configures AImageReader
-//     as YUV_420_888 and converts (see convert_yuv420_to_packed). The
+//     as YUV_420_888 and converts (see convert_yuv420_rows_to_packed). The
 //     conversion is the price of working on every device rather than the
-//     subset that happens to expose RGBA.
+//     subset that happens to expose RGBA. Stream profiles and still captures
+//     requesting NV12/NV21/I420 skip the conversion: the planes are repacked
+//     into the requested layout and retained as CPU_PLANAR, and Core expands
+//     them to RGBA only when a result is read as an image. A stream frame
+//     whose device layout already is the requested one skips the repack too:
+//     its planes are posted in place and the AImage is released with the
+//     frame.
 //
 //   - Outputs are fixed at session creation. A Camera2 capture session
 //     declares its whole output set up front; adding an output means tearing
@@ -29,6 +35,13 @@
 //     different geometry while a stream is producing is refused
 //     (ERR_PLATFORM_CONSTRAINT) rather than glitching the live stream. That
 //     refusal is a session-configuration constraint, not a shortcut.
+//     Several streams of one device ("sibling" streams, e.g. a high-res
+//     preview and a low-res analysis stream) are outputs of the same session:
+//     it is built with one YUV_420_888 reader per created stream, and the
+//     repeating request targets the started ones, so the ISP scales each
+//     geometry from the same sensor frame. Starting or stopping a sibling
+//     only swaps the repeating request; siblings must therefore all be
+//     created before the first of them starts.
 //
 //   - Metadata is genuinely realized. Camera2 capture *result* metadata
 //     reports what the sensor actually did for that exact frame, not the
@@ -45,16 +58,24 @@
 // - Every mutating ICameraProvider entry arrives core-thread-serialized via
 //   ProviderBroker; provider state is still guarded by state_mutex_ across
 //   check-then-act windows.
-// - Every blocking Camera2 call (openCamera, createCaptureSession, session
+// - Every blocking Camera2 call (createCaptureSession, session and device
 //   close) runs on a single provider-owned control thread with a bounded
 //   wait, so a wedged camera HAL degrades to a deterministic ERR_TIMEOUT
 //   instead of wedging the core thread (brief §2 enforcement ladder).
+//   openCamera is the exception: it runs on one of a few open workers, so
+//   the opens of a multi-camera startup overlap (see open_device).
 // - AImageReader listeners and ACameraCaptureSession capture callbacks fire
 //   on NDK-owned threads; every provider->core fact is funneled through
 //   CBProviderStrand (the single serialized callback context).
+// - The per-frame queries (backpressure, payload buffers, native ids,
+//   timestamps) are made on the callbacks directly; in a provider-bound
+//   build they name Core's ingress (imaging/api/provider_binding.h).
 // - Still captures execute on a small bounded worker pool with generation-
 //   based cancellation; saturation is an admission failure (ERR_BUSY).
+// - Large still conversions are split into row bands across a second small
+//   pool (RowBandConversionPool) that the still listener joins and awaits.
 
+#include <array>
 #include <atomic>
 #include <condition_variable>
 #include <cstdint>
@@ -68,6 +89,7 @@
 #include <thread>
 #include <vector>
 
+#include "imaging/api/capture_start_barrier.h"
 #include "imaging/api/icamera_provider.h"
 #include "imaging/api/provider_access_status.h"
 #include "imaging/api/provider_strand.h"
@@ -108,6 +130,10 @@ public:
   bool run_bounded(std::function<void(const AbandonToken&)> job,
                    std::shared_ptr<AbandonToken> token,
                    uint32_t timeout_ms) noexcept;
+  // Queues job without waiting for it: background work that must stay
+  // ordered with (and never overlap) the bounded jobs. False when stopped.
+  // stop() still runs queued jobs, so a job must check for shutdown itself.
+  bool post(std::function<void()> job) noexcept;
 
 private:
   void thread_main_() noexcept;
@@ -126,9 +152,84 @@ private:
   std::thread worker_;
 };
 
+// Small provider-owned pool that splits one large still conversion into row
+// bands. The caller (the NDK still-image listener) always converts bands
+// itself alongside the workers and returns only once every band is done, so
+// the AImage lease, member ordering and BurstCollector hand-off are exactly
+// what they are for an inline conversion -- the pool only shortens the time
+// the listener holds the image.
+//
+// One split runs at a time; a caller that finds the pool busy (another
+// device's still) converts inline rather than queueing, so a stall here can
+// never exceed today's serial conversion cost.
+class RowBandConversionPool final {
+public:
+  RowBandConversionPool() = default;
+  ~RowBandConversionPool();
+
+  RowBandConversionPool(const RowBandConversionPool&) = delete;
+  RowBandConversionPool& operator=(const RowBandConversionPool&) = delete;
+
+  // Images below min_pixels, or any image while the pool is stopped or
+  // busy, are converted inline by run().
+  bool start(size_t worker_count, uint32_t band_rows, uint64_t min_pixels) noexcept;
+  void stop() noexcept;
+
+  // Calls band(row_begin, row_end) over [0, rows), either once inline or in
+  // bands from this thread and any idle worker. Returns after every band is
+  // done. Never throws; band must not either.
+  void run(uint32_t rows,
+           uint64_t pixels,
+           const std::function<void(uint32_t, uint32_t)>& band) noexcept;
+
+private:
+  struct Split {
+    const std::function<void(uint32_t, uint32_t)>* band = nullptr;
+    uint32_t rows = 0;
+    uint32_t band_rows = 0;
+    uint32_t band_count = 0;
+    std::atomic<uint32_t> next{0};
+    std::atomic<uint32_t> done{0};
+  };
+
+  void worker_main_() noexcept;
+  // Claims and converts bands until none are left. Returns true when this
+  // call completed the final band.
+  static bool drain_(Split& split) noexcept;
+
+  std::mutex mu_;
+  std::condition_variable work_cv_;
+  std::condition_variable done_cv_;
+  std::shared_ptr<Split> current_;
+  uint64_t split_generation_ = 0;
+  bool stop_requested_ = false;
+  uint32_t band_rows_ = 0;
+  uint64_t min_pixels_ = 0;
+  std::atomic<bool> running_{false};
+  std::vector<std::thread> workers_;
+};
+
 // Opaque holder for per-device Camera2 objects + frame routing state.
 // Defined in the .cpp so no platform headers leak into this header.
 struct DeviceBackend;
+struct StreamProduction;
+
+// Streams one capture session carries as sibling outputs. Two YUV outputs
+// plus the still output is the largest set Camera2's documented stream
+// combinations cover below FULL hardware level; a device that still cannot
+// configure it fails session creation, which start_stream reports.
+inline constexpr size_t kMaxSessionStreams = 2;
+
+// One stream output of a capture session.
+struct StreamOutputSpec {
+  uint64_t stream_id = 0;
+  uint32_t width = 0;
+  uint32_t height = 0;
+
+  bool operator==(const StreamOutputSpec& o) const noexcept {
+    return stream_id == o.stream_id && width == o.width && height == o.height;
+  }
+};
 
 } // namespace camera2_detail
 
@@ -166,12 +267,23 @@ public:
   // degenerate, or a bundle exceeding kMaxBracketMembers, is refused with
   // ERR_NOT_SUPPORTED.
   bool supports_multi_image_still_sequence() const noexcept override { return true; }
+  // Sibling streams of one device share its capture session (see the header
+  // comment above).
+  uint32_t max_active_streams_per_device() const noexcept override {
+    return static_cast<uint32_t>(camera2_detail::kMaxSessionStreams);
+  }
+  // Stills are an output of the running session (the still reader rides
+  // alongside the sibling streams) and the capture never stops the repeating
+  // request, so preview keeps flowing on devices whose hardware level
+  // guarantees that stream combination. Opens still in flight answer false.
+  bool supports_capture_alongside_streams(uint64_t device_instance_id) const noexcept override;
 
   // Derived from the bounded per-step timeouts below (never a guess, per the
   // doc comment on the base declaration).
   //
-  // Cold setup is two bounded control jobs -- session realization (readers,
-  // outputs, ACameraDevice_createCaptureSession) and request construction.
+  // Cold setup is a device open still in flight plus two bounded control
+  // jobs -- session realization (readers, outputs,
+  // ACameraDevice_createCaptureSession) and request construction.
   // Each member then pays one still capture bounded by kCaptureSampleWaitMs
   // plus a control-thread queueing allowance, because the capture submission
   // runs on the shared bounded executor.
@@ -179,13 +291,13 @@ public:
   // This exceeds Core's 30s default, which sizes only for a single-image
   // capture.
   uint64_t capture_admission_watchdog_timeout_ns() const noexcept override {
-    constexpr uint64_t kColdSetupChainMs = 2ull * kControlJobTimeoutMs;
+    constexpr uint64_t kColdSetupChainMs = 3ull * kControlJobTimeoutMs;
     constexpr uint64_t kPerMemberMs =
         static_cast<uint64_t>(kCaptureSampleWaitMs) + kControlJobTimeoutMs;
     constexpr uint64_t kSafetyMarginMs = 2000ull;
     constexpr uint64_t kWorstCaseMs =
-        kColdSetupChainMs + static_cast<uint64_t>(kMaxBracketMembers) * kPerMemberMs +
-        kSafetyMarginMs;
+        kColdSetupChainMs + kRigCaptureStartBarrierWaitMs +
+        static_cast<uint64_t>(kMaxBracketMembers) * kPerMemberMs + kSafetyMarginMs;
     return kWorstCaseMs * 1'000'000ull;
   }
 
@@ -198,6 +310,12 @@ public:
   ProviderResult initialize(IProviderCallbacks* callbacks) override;
   ProviderResult enumerate_endpoints(std::vector<CameraEndpoint>& out_endpoints) override;
 
+  // Reads the characteristics (cached after the first open) and returns;
+  // ACameraManager_openCamera then runs on an open worker, so opening several
+  // cameras costs about the slowest open rather than the sum. The Device
+  // native object and on_device_opened follow once the camera is actually
+  // open; a failed open is reported as a device error. Session realization
+  // and close_device wait (bounded) for an open still in flight.
   ProviderResult open_device(
       const std::string& hardware_id,
       uint64_t device_instance_id,
@@ -212,6 +330,7 @@ public:
       const CaptureProfile& profile,
       const PictureConfig& picture) override;
   ProviderResult stop_stream(uint64_t stream_id) override;
+  ProviderResult reconfigure_stream(uint64_t stream_id, const CaptureProfile& profile) override;
   ProviderResult update_stream_retained_production_plan(
       uint64_t stream_id,
       CoreRetainedProductionPlan requested_retained_plan) override;
@@ -222,6 +341,8 @@ public:
   ProviderResult trigger_capture(const CaptureRequest& req) override;
   ProviderResult trigger_capture_submission(const CaptureSubmission& submission) override;
   ProviderResult abort_capture(uint64_t capture_id) override;
+  void set_stream_pool_depth_hint(uint64_t stream_id, const StreamPoolDepthHint& hint) noexcept override;
+  uint64_t producer_frames_dropped_total() const noexcept override;
 
   ProviderResult apply_camera_spec_patch(
       const std::string& hardware_id,
@@ -247,15 +368,23 @@ private:
   // for every output), so this is deliberately larger than the WinRT
   // provider's equivalent.
   static constexpr uint32_t kControlJobTimeoutMs = 5000;
+  // Upper bound a prepared rig member waits for its siblings before issuing
+  // its still requests anyway.
+  static constexpr uint32_t kRigCaptureStartBarrierWaitMs = 250;
+  // Concurrent openCamera calls: enough for a four-camera rig to open at
+  // once. Opens of more devices queue behind these.
+  static constexpr size_t kOpenWorkerCount = 4;
   // Bound on waiting for auto-focus to settle after a lock trigger. Sized to
   // contain a lens that never converges, not to pace one that does: a normal
   // convergence reports a locked AF state in a few frames and the wait returns
   // as soon as it does, so this is never spent in the common case.
   static constexpr uint32_t kAfLockWaitMs = 1500;
   // AImageReader maxImages for the repeating stream. Must exceed the number
-  // of images the converter can hold at once; the provider copies out and
-  // deletes each AImage immediately, so this is headroom, not a pipeline
-  // depth.
+  // of images the converter can hold at once. A planar frame whose device
+  // layout already matches is leased to Core in its AImage rather than
+  // copied out, and at most maxImages - 2 images are leased at once so
+  // acquireLatestImage can still skip ahead; every other frame is copied out
+  // and its AImage deleted immediately.
   static constexpr int32_t kStreamReaderMaxImages = 4;
   // Still AImageReader depth. The provider copies out and deletes each AImage
   // immediately, so a burst of N members can drain through a shallow reader --
@@ -264,7 +393,17 @@ private:
   // kMaxBracketMembers below: raising the bracket cap REQUIRES raising this in
   // step (and re-verifying on device), or the extra members bottleneck here.
   static constexpr int32_t kStillReaderMaxImages = 2;
+  // Initial and minimum stream frame-slot count. The pool adapts above this
+  // to how long Core holds frames (StreamProduction in the .cpp); reader
+  // depth above does not, since frames past the lease budget fall back here.
   static constexpr size_t kStreamPoolSlots = 8;
+  // Still conversion row-band workers (the listener thread converts too).
+  // Engaged only for stills of at least kRowBandMinPixels: below that the
+  // hand-off costs more than it saves, and stream frames never use it --
+  // their conversion overlaps the next sensor frame already.
+  static constexpr size_t kRowBandWorkerCount = 3;
+  static constexpr uint64_t kRowBandMinPixels = 4000000;
+  static constexpr uint32_t kRowBandRows = 64;
   // Provider-side admission cap for still_image_bundle size on this provider.
   // This is a deliberate POLICY cap, not a device/hardware limit: it is the same
   // constant on every device (so all devices refuse >5 identically), and it
@@ -284,8 +423,9 @@ private:
     uint64_t root_id = 0;
     bool open = false;
     uint64_t native_id = 0;
-    // Core enforces one repeating stream per device instance; tracked defensively.
-    uint64_t stream_id = 0;
+    // Created streams of this device, in creation order: the capture
+    // session's stream outputs (at most camera2_detail::kMaxSessionStreams).
+    std::vector<uint64_t> stream_ids;
     // AcquisitionSession native truth (the concretely realized
     // ACameraCaptureSession) lives on the backend, which owns its own locking
     // so capture workers never hold state_mutex_ across bounded backend jobs.
@@ -297,11 +437,18 @@ private:
     bool created = false;
     bool started = false;
     uint64_t native_id = 0;
+    // Core's in-flight depth (set_stream_pool_depth_hint()), applied to
+    // every production made for the stream.
+    uint32_t pool_depth_hint = 0;
   };
 
   struct DeviceCaptureJob {
     CaptureRequest request{};
     uint64_t generation = 0;
+    // Shared by the members of one rig submission that fits the worker
+    // count; each waits on it after session realization and metering so the
+    // rig's still requests are issued together.
+    std::shared_ptr<CBCaptureStartBarrier> start_barrier{};
   };
 
   struct InFlightKey {
@@ -323,23 +470,49 @@ private:
   void emit_native_destroyed_(uint64_t native_id);
 
   // Realizes (or rebuilds) the device's capture session so it carries exactly
-  // the requested output set, and emits the AcquisitionSession native-created
-  // fact on each realization. Serialized per device via the backend's
+  // the requested output set -- one output per entry of streams, plus the
+  // still output when want_still -- and emits the AcquisitionSession
+  // native-created fact on each realization. Serialized per device via the backend's
   // configure mutex; must NOT be called while holding a backend's inner
   // mutex. Lock order: state_mutex_ (optional, core-thread entries only) ->
   // backend configure mutex -> backend inner mutex; nothing re-acquires
   // state_mutex_ inside the configure mutex.
   //
   // Rebuilding cancels any repeating request, so a config change is refused
-  // with ERR_PLATFORM_CONSTRAINT while the stream is producing.
+  // with ERR_PLATFORM_CONSTRAINT while the stream is producing. The still
+  // output reads YUV_420_888 unless still_format_fourcc is a RAW format.
   ProviderResult ensure_session_configured_(
       const std::shared_ptr<camera2_detail::DeviceBackend>& backend,
-      bool want_stream,
-      uint32_t stream_width,
-      uint32_t stream_height,
+      const std::vector<camera2_detail::StreamOutputSpec>& streams,
       bool want_still,
       uint32_t still_width,
-      uint32_t still_height);
+      uint32_t still_height,
+      uint32_t still_format_fourcc = 0);
+
+  // Points the session's repeating request at the outputs of stream_ids (all
+  // in the realized session), replacing the previous request without
+  // rebuilding the session; an empty set stops the repeating flow. Runs on
+  // the control thread. Same lock rules as ensure_session_configured_.
+  ProviderResult set_repeating_streams_(
+      const std::shared_ptr<camera2_detail::DeviceBackend>& backend,
+      const std::vector<uint64_t>& stream_ids);
+
+  // The session stream outputs for dev's created streams, with stream_id at
+  // profile and every sibling at its own profile; still_width/still_height
+  // receive the largest of them. Caller holds state_mutex_.
+  std::vector<camera2_detail::StreamOutputSpec> session_stream_specs_(
+      const DeviceState& dev,
+      uint64_t stream_id,
+      const CaptureProfile& profile,
+      uint32_t& still_width,
+      uint32_t& still_height) const;
+  // A fresh, not yet producing, production record for stream_id at profile.
+  std::shared_ptr<camera2_detail::StreamProduction> make_stream_production_(
+      const DeviceState& dev,
+      uint64_t stream_id,
+      const CaptureProfile& profile,
+      const CoreRetainedProductionPlan& plan,
+      uint32_t pool_depth_hint);
 
   // Tears the session down (session close, outputs, readers) on the control
   // thread and emits the AcquisitionSession destruction fact. Caller must
@@ -357,6 +530,22 @@ private:
   void post_static_camera_facts_best_effort_(
       uint64_t device_instance_id,
       const std::shared_ptr<camera2_detail::DeviceBackend>& backend);
+  // Open worker: ACameraManager_openCamera for a device open_device() has
+  // accepted; settles DeviceBackend::open_pending and posts the Device native
+  // object, on_device_opened and static facts (or the failure).
+  void complete_device_open_(
+      const std::shared_ptr<camera2_detail::DeviceBackend>& backend,
+      bool chars_from_cache);
+  // Waits (bounded) for an open in flight, then marks the backend closed.
+  // True when the Device native object was created, i.e. the camera opened.
+  bool mark_backend_closed_(const std::shared_ptr<camera2_detail::DeviceBackend>& backend);
+  void stop_open_workers_() noexcept;
+  // Re-reads the characteristics open_device() took from the process-wide
+  // cache, on the control thread after open; a difference replaces the
+  // cached and device copies and re-posts the static facts.
+  void revalidate_characteristics_(
+      uint64_t device_instance_id,
+      const std::shared_ptr<camera2_detail::DeviceBackend>& backend);
 
   // Capture executor.
   bool start_capture_executor_() noexcept;
@@ -381,6 +570,8 @@ private:
   // members describe the same scene closely enough to combine. Images are
   // paired to their result metadata by ACAMERA_SENSOR_TIMESTAMP, the only
   // correlation Camera2 offers once several captures are in flight together.
+  // The requests are kept on the backend and reused by the next capture of
+  // the same bracket shape, which only rewrites their exposure entries.
   //
   // Returns false only when the submission itself failed; per-member failures
   // are reported in out_frames.
@@ -426,11 +617,16 @@ private:
       const std::shared_ptr<camera2_detail::DeviceBackend>& backend) noexcept;
 
   CBProviderStrand strand_;
-  IProviderCallbacks* callbacks_ = nullptr;
+  ProviderBoundCallbacks* callbacks_ = nullptr;
   std::atomic<bool> initialized_{false};
   std::atomic<bool> shutting_down_{false};
 
   camera2_detail::BoundedControlExecutor control_;
+  // device_instance_id % kOpenWorkerCount picks the worker.
+  std::array<camera2_detail::BoundedControlExecutor, kOpenWorkerCount> open_workers_;
+  camera2_detail::RowBandConversionPool still_conversion_;
+  // Repeating frames dropped on frame pool exhaustion, over every backend.
+  std::atomic<uint64_t> producer_frames_dropped_{0};
   // ACameraManager, owned for the provider's whole lifetime. Opaque here.
   std::shared_ptr<void> manager_;
 
@@ -4,9 +4,12 @@
 //
 // Backend surface: winrt::Windows::Media::Capture::MediaCapture with
 // Windows.Media.Capture.Frames MediaFrameReader delivering Bgra8 software
-// bitmaps. Requires a C++/WinRT-capable toolchain (MSVC + Windows SDK).
+// bitmaps (native NV12 for NV12 stream profiles). Requires a C++/WinRT-capable toolchain (MSVC + Windows SDK).
 
 #include "imaging/platform/windows/winrt_camera_provider.h"
+#include "imaging/api/async_log.h"
+#include "imaging/api/thread_policy.h"
+#include "pixels/convert/packed_swizzle.h"
 
 #ifndef WIN32_LEAN_AND_MEAN
 #define WIN32_LEAN_AND_MEAN
@@ -57,8 +60,7 @@ void log_line(const char* fmt, ...) {
   va_start(args, fmt);
   std::vsnprintf(buffer, sizeof(buffer), fmt, args);
   va_end(args);
-  std::fprintf(stderr, "[CamBANG][winrt_provider] %s\n", buffer);
-  std::fflush(stderr);
+  async_log_printf(stderr, "[CamBANG][winrt_provider] %s\n", buffer);
 }
 
 ProviderError provider_error_from_hresult(winrt::hresult hr) noexcept {
@@ -189,7 +191,28 @@ bool BoundedControlExecutor::run_bounded(
   return true;
 }
 
+bool BoundedControlExecutor::post(std::function<void()> job) noexcept {
+  if (!running_.load(std::memory_order_acquire) || !job) {
+    return false;
+  }
+  try {
+    auto wrapped = [job = std::move(job)](const AbandonToken&) { job(); };
+    std::lock_guard<std::mutex> lock(mu_);
+    if (stop_requested_) {
+      return false;
+    }
+    q_.push_back(Entry{std::move(wrapped),
+                       std::make_shared<AbandonToken>(),
+                       std::make_shared<std::promise<void>>()});
+  } catch (...) {
+    return false;
+  }
+  cv_.notify_one();
+  return true;
+}
+
 void BoundedControlExecutor::thread_main_() noexcept {
+  apply_current_thread_policy(CBThreadRole::ProviderCallbacks, "cambang-winrt-ctl");
   bool apartment_initialized = false;
   try {
     winrt::init_apartment(winrt::apartment_type::multi_threaded);
@@ -224,33 +247,45 @@ void BoundedControlExecutor::thread_main_() noexcept {
 // Frame conversion (Bgra8 rows -> packed RGBA/BGRA)
 // ---------------------------------------------------------------------------
 
+// Plane descriptions of the bitmaps one stream delivers. A reader keeps
+// handing over the same format and geometry, so they are queried once and
+// reused until a bitmap arrives that differs.
+struct BitmapPlaneLayout {
+  bool valid = false;
+  wgi::BitmapPixelFormat format = wgi::BitmapPixelFormat::Unknown;
+  int32_t width = 0;
+  int32_t height = 0;
+  int32_t plane_count = 0;
+  wgi::BitmapPlaneDescription planes[2]{};
+};
+
 namespace {
 
-void convert_bgra_rows(const uint8_t* scanline0,
-                       int32_t pitch,
-                       uint32_t width,
-                       uint32_t height,
-                       uint32_t dst_fourcc,
-                       uint8_t* dst) {
-  const size_t row_bytes = static_cast<size_t>(width) * 4u;
-  const bool to_rgba = (dst_fourcc == FOURCC_RGBA);
-  for (uint32_t y = 0; y < height; ++y) {
-    const uint8_t* src = scanline0 + static_cast<ptrdiff_t>(pitch) * static_cast<ptrdiff_t>(y);
-    uint8_t* out = dst + row_bytes * y;
-    if (to_rgba) {
-      for (uint32_t x = 0; x < width; ++x) {
-        out[4 * x + 0] = src[4 * x + 2];
-        out[4 * x + 1] = src[4 * x + 1];
-        out[4 * x + 2] = src[4 * x + 0];
-        out[4 * x + 3] = 0xFF;
-      }
-    } else { // BGRA: same channel order; force opaque alpha.
-      std::memcpy(out, src, row_bytes);
-      for (uint32_t x = 0; x < width; ++x) {
-        out[4 * x + 3] = 0xFF;
-      }
-    }
+// Brings layout up to date with buffer, locked from a bitmap of format and
+// width x height. False when the buffer has more planes than are described.
+bool refresh_plane_layout(const wgi::BitmapBuffer& buffer,
+                          wgi::BitmapPixelFormat format,
+                          int32_t width,
+                          int32_t height,
+                          BitmapPlaneLayout& layout) {
+  if (layout.valid && layout.format == format && layout.width == width &&
+      layout.height == height) {
+    return true;
+  }
+  layout.valid = false;
+  const int32_t count = buffer.GetPlaneCount();
+  if (count < 1 || count > 2) {
+    return false;
+  }
+  for (int32_t i = 0; i < count; ++i) {
+    layout.planes[i] = buffer.GetPlaneDescription(i);
   }
+  layout.format = format;
+  layout.width = width;
+  layout.height = height;
+  layout.plane_count = count;
+  layout.valid = true;
+  return true;
 }
 
 // Copies a Bgra8 SoftwareBitmap into dst (width*height*4, requested fourcc).
@@ -258,7 +293,8 @@ bool convert_software_bitmap(const wgi::SoftwareBitmap& bitmap,
                              uint32_t width,
                              uint32_t height,
                              uint32_t dst_fourcc,
-                             uint8_t* dst) {
+                             uint8_t* dst,
+                             BitmapPlaneLayout& layout) {
   if (!bitmap || bitmap.BitmapPixelFormat() != wgi::BitmapPixelFormat::Bgra8) {
     return false;
   }
@@ -274,13 +310,24 @@ bool convert_software_bitmap(const wgi::SoftwareBitmap& bitmap,
         reference.as<::Windows::Foundation::IMemoryBufferByteAccess>();
     uint8_t* data = nullptr;
     uint32_t capacity = 0;
-    if (SUCCEEDED(byte_access->GetBuffer(&data, &capacity)) && data) {
-      const wgi::BitmapPlaneDescription plane = buffer.GetPlaneDescription(0);
+    if (refresh_plane_layout(buffer, wgi::BitmapPixelFormat::Bgra8,
+                             static_cast<int32_t>(width), static_cast<int32_t>(height),
+                             layout) &&
+        SUCCEEDED(byte_access->GetBuffer(&data, &capacity)) && data) {
+      const wgi::BitmapPlaneDescription& plane = layout.planes[0];
       const uint8_t* scanline0 = data + plane.StartIndex;
       const size_t needed = static_cast<size_t>(plane.Stride) * height;
       if (capacity >= plane.StartIndex + needed) {
-        convert_bgra_rows(scanline0, plane.Stride, width, height, dst_fourcc, dst);
+        // One pass per pixel: copy, optional B/R swap, and alpha force
+        // together. Bgra8 camera bitmaps do not promise opaque alpha
+        // (sources commonly report BitmapAlphaMode::Ignore, leaving the byte
+        // unspecified), so the force stays; folded into the copy it costs no
+        // extra memory traffic.
+        convert_bgra_rows_to_packed_opaque(scanline0, static_cast<ptrdiff_t>(plane.Stride), width, height,
+                                           dst_fourcc == FOURCC_RGBA, dst);
         ok = true;
+      } else {
+        layout.valid = false;
       }
     }
     reference.Close();
@@ -289,6 +336,90 @@ bool convert_software_bitmap(const wgi::SoftwareBitmap& bitmap,
   return ok;
 }
 
+// Tightly packed byte size of one stream frame in dst_fourcc.
+size_t stream_frame_bytes(uint32_t width, uint32_t height, uint32_t dst_fourcc) {
+  const size_t luma = static_cast<size_t>(width) * static_cast<size_t>(height);
+  if (dst_fourcc != FOURCC_NV12) {
+    return luma * 4u;
+  }
+  const size_t chroma = static_cast<size_t>((width + 1u) / 2u) * ((height + 1u) / 2u);
+  return luma + 2u * chroma;
+}
+
+// Repacks an Nv12 SoftwareBitmap into dst as tight NV12 (Y plane, then
+// interleaved UV) and describes the planes on fv. No colour conversion: the
+// reader hands over the camera's native NV12, so each row is one memcpy.
+bool repack_nv12_software_bitmap(const wgi::SoftwareBitmap& bitmap,
+                                 uint32_t width,
+                                 uint32_t height,
+                                 uint8_t* dst,
+                                 FrameView& fv,
+                                 BitmapPlaneLayout& layout) {
+  if (!bitmap || bitmap.BitmapPixelFormat() != wgi::BitmapPixelFormat::Nv12) {
+    return false;
+  }
+  if (static_cast<uint32_t>(bitmap.PixelWidth()) != width ||
+      static_cast<uint32_t>(bitmap.PixelHeight()) != height) {
+    return false;
+  }
+  const uint32_t chroma_row_bytes = ((width + 1u) / 2u) * 2u;
+  const uint32_t chroma_h = (height + 1u) / 2u;
+  uint8_t* y_dst = dst;
+  uint8_t* uv_dst = dst + static_cast<size_t>(width) * height;
+  wgi::BitmapBuffer buffer = bitmap.LockBuffer(wgi::BitmapBufferAccessMode::Read);
+  bool ok = false;
+  {
+    wf::IMemoryBufferReference reference = buffer.CreateReference();
+    auto byte_access =
+        reference.as<::Windows::Foundation::IMemoryBufferByteAccess>();
+    uint8_t* data = nullptr;
+    uint32_t capacity = 0;
+    if (refresh_plane_layout(buffer, wgi::BitmapPixelFormat::Nv12,
+                             static_cast<int32_t>(width), static_cast<int32_t>(height),
+                             layout) &&
+        layout.plane_count == 2 &&
+        SUCCEEDED(byte_access->GetBuffer(&data, &capacity)) && data) {
+      const wgi::BitmapPlaneDescription& y_plane = layout.planes[0];
+      const wgi::BitmapPlaneDescription& uv_plane = layout.planes[1];
+      const bool y_fits =
+          y_plane.Stride >= static_cast<int32_t>(width) &&
+          static_cast<size_t>(y_plane.StartIndex) +
+                  static_cast<size_t>(y_plane.Stride) * (height - 1u) + width <=
+              capacity;
+      const bool uv_fits =
+          uv_plane.Stride >= static_cast<int32_t>(chroma_row_bytes) &&
+          static_cast<size_t>(uv_plane.StartIndex) +
+                  static_cast<size_t>(uv_plane.Stride) * (chroma_h - 1u) + chroma_row_bytes <=
+              capacity;
+      if (y_fits && uv_fits) {
+        const uint8_t* y_src = data + y_plane.StartIndex;
+        for (uint32_t row = 0; row < height; ++row) {
+          std::memcpy(y_dst + static_cast<size_t>(row) * width,
+                      y_src + static_cast<size_t>(y_plane.Stride) * row, width);
+        }
+        const uint8_t* uv_src = data + uv_plane.StartIndex;
+        for (uint32_t row = 0; row < chroma_h; ++row) {
+          std::memcpy(uv_dst + static_cast<size_t>(row) * chroma_row_bytes,
+                      uv_src + static_cast<size_t>(uv_plane.Stride) * row, chroma_row_bytes);
+        }
+        ok = true;
+      } else {
+        layout.valid = false;
+      }
+    }
+    reference.Close();
+  }
+  buffer.Close();
+  if (!ok) {
+    return false;
+  }
+  fv.plane_count = 2;
+  fv.planes[0] = FramePlaneView{y_dst, static_cast<size_t>(width) * height, width};
+  fv.planes[1] = FramePlaneView{uv_dst, static_cast<size_t>(chroma_row_bytes) * chroma_h,
+                                chroma_row_bytes};
+  return true;
+}
+
 } // namespace
 
 // ---------------------------------------------------------------------------
@@ -302,12 +433,21 @@ struct StreamProduction {
   uint32_t width = 0;
   uint32_t height = 0;
   uint32_t fourcc = 0;
+  size_t frame_bytes = 0;
   CoreRetainedProductionPlan plan{};
   uint64_t frames_posted = 0;
   uint64_t convert_failures = 0;
 
+  // A slot is an in-flight token: bytes is drawn fresh for each frame (Core's
+  // payload pool when available) and published as cpu_payload_owner, so a
+  // retained result never aliases storage the next frame writes. Without a
+  // Core pool the slot's own spare is reused once nothing else holds it.
+  // While a frame is out, the slot keeps itself alive through self and is
+  // the frame's release_user, so publishing a frame allocates no lease.
   struct BufferSlot {
-    std::vector<uint8_t> bytes;
+    std::shared_ptr<CpuPayloadBytes> bytes;
+    std::shared_ptr<CpuPayloadBytes> spare;
+    std::shared_ptr<BufferSlot> self;
     std::atomic<bool> in_use{false};
   };
   std::vector<std::shared_ptr<BufferSlot>> pool;
@@ -316,6 +456,32 @@ struct StreamProduction {
   // Guarded by DeviceBackend::m.
   bool producing = false;
   uint64_t pool_exhausted_drops = 0;
+  BitmapPlaneLayout plane_layout{};
+};
+
+// A closed device's MediaCapture whose release is still running on the
+// control thread. One capture per device serves both the stream reader and
+// the still pipeline under ExclusiveControl, so a second capture of the same
+// hardware cannot initialize (ExclusiveControlNotAvailable) until this one
+// is closed; a reopen waits for finish() instead of failing.
+struct CaptureRelease {
+  std::mutex m;
+  std::condition_variable cv;
+  bool done = false;
+
+  void finish() {
+    {
+      std::lock_guard<std::mutex> lock(m);
+      done = true;
+    }
+    cv.notify_all();
+  }
+
+  // False when the release is still running after timeout_ms.
+  bool wait(uint32_t timeout_ms) {
+    std::unique_lock<std::mutex> lock(m);
+    return cv.wait_for(lock, std::chrono::milliseconds(timeout_ms), [this] { return done; });
+  }
 };
 
 struct DeviceBackend : std::enable_shared_from_this<DeviceBackend> {
@@ -328,20 +494,34 @@ struct DeviceBackend : std::enable_shared_from_this<DeviceBackend> {
   wmc::MediaCapture capture{nullptr};
   wmcf::MediaFrameSource frame_source{nullptr};
   wmcf::MediaFrameReader reader{nullptr};
-  // Still-capture pipeline, prepared lazily on first capture. Stills come
+  // Still-capture pipeline, prepared at priming or on first capture. Stills come
   // from here, not from the frame reader above, which serves streams only.
   wmc::LowLagPhotoCapture low_lag_photo{nullptr};
   winrt::event_token frame_token{};
   winrt::event_token failed_token{};
   bool reader_started = false;
+  // Subtype the realized reader was created with: native Nv12 for an NV12
+  // stream profile, Bgra8 otherwise.
+  bool reader_nv12 = false;
 
   uint64_t device_instance_id = 0;
   uint64_t root_id = 0;
   uint64_t acquisition_session_id = 0; // core-issued native id once realized
   CBProviderStrand* strand = nullptr;  // provider outlives all backends
+  IProviderCallbacks* callbacks = nullptr; // payload buffers; same lifetime
+  std::atomic<uint64_t>* producer_frames_dropped = nullptr; // same lifetime
 
   bool closed = false;   // set before WinRT objects are released
   bool failed = false;
+  // True from open_device() until the open worker's InitializeAsync settles:
+  // capture set, or the failure latched in open_error. open_cv wakes waiters.
+  bool open_pending = false;
+  ProviderError open_error = ProviderError::OK;
+  std::condition_variable open_cv;
+  // The Device native object is created only once the capture is
+  // initialized; its id is issued up front by open_device().
+  uint64_t device_native_id = 0;
+  bool device_native_created = false;
   uint32_t configured_w = 0;
   uint32_t configured_h = 0;
   std::atomic<uint64_t> frame_arrived_count{0};
@@ -349,6 +529,23 @@ struct DeviceBackend : std::enable_shared_from_this<DeviceBackend> {
 
   std::shared_ptr<StreamProduction> stream;
 
+  // Caller holds m through lock. False when the open is still in flight
+  // after timeout_ms.
+  bool wait_open_settled(std::unique_lock<std::mutex>& lock, uint32_t timeout_ms) {
+    return open_cv.wait_for(lock, std::chrono::milliseconds(timeout_ms),
+                            [this] { return !open_pending; });
+  }
+
+  // The initialized MediaCapture, waiting up to timeout_ms for an open in
+  // flight; null once closed, after a failed open, or on timeout.
+  wmc::MediaCapture opened_capture(uint32_t timeout_ms) {
+    std::unique_lock<std::mutex> lock(m);
+    if (!wait_open_settled(lock, timeout_ms) || closed) {
+      return nullptr;
+    }
+    return capture;
+  }
+
   // Caller holds m. Latches backend failure and posts the truthful facts.
   void latch_failure_locked(ProviderError error) {
     if (failed) {
@@ -368,24 +565,21 @@ struct DeviceBackend : std::enable_shared_from_this<DeviceBackend> {
 
 // Frame release leases: FrameView.release must stay valid on any thread and
 // with any provider-side storage teardown ordering, so each posted frame owns
-// its backing through a heap lease (matches SyntheticProvider's pattern).
-struct StreamFrameLease {
-  std::shared_ptr<StreamProduction::BufferSlot> slot;
-};
-
+// its backing. Stream frames hold their slot (BufferSlot::self); captures
+// use a heap lease (matches SyntheticProvider's pattern).
 struct CaptureFrameLease {
-  std::shared_ptr<std::vector<uint8_t>> bytes;
+  std::shared_ptr<CpuPayloadBytes> bytes;
 };
 
 namespace {
 
 void release_stream_frame(void* user, const FrameView* /*frame*/) {
-  auto* lease = static_cast<StreamFrameLease*>(user);
-  if (!lease) return;
-  if (lease->slot) {
-    lease->slot->in_use.store(false, std::memory_order_release);
-  }
-  delete lease;
+  auto* slot = static_cast<StreamProduction::BufferSlot*>(user);
+  if (!slot) return;
+  // Outlives the pool for the rest of this call even if the stream is gone.
+  const std::shared_ptr<StreamProduction::BufferSlot> keep = std::move(slot->self);
+  slot->bytes.reset();
+  slot->in_use.store(false, std::memory_order_release);
 }
 
 void release_capture_frame(void* user, const FrameView* /*frame*/) {
@@ -489,6 +683,9 @@ void deliver_frame_locked(DeviceBackend& backend,
   }
   if (!slot) {
     ++s->pool_exhausted_drops;
+    if (backend.producer_frames_dropped) {
+      backend.producer_frames_dropped->fetch_add(1, std::memory_order_relaxed);
+    }
     if ((s->pool_exhausted_drops & (s->pool_exhausted_drops - 1)) == 0) {
       log_line("stream=%llu frame pool exhausted (drops=%llu)",
                static_cast<unsigned long long>(s->stream_id),
@@ -497,8 +694,36 @@ void deliver_frame_locked(DeviceBackend& backend,
     return; // repeating frames are lossy
   }
 
-  if (!convert_software_bitmap(bitmap, s->width, s->height, s->fourcc,
-                               slot->bytes.data())) {
+  const bool planar = s->fourcc == FOURCC_NV12;
+  CpuPayloadBufferKey payload_key{};
+  payload_key.width = s->width;
+  payload_key.height = s->height;
+  payload_key.stride_bytes = planar ? s->width : s->width * 4u;
+  payload_key.format_fourcc = s->fourcc;
+  payload_key.size_bytes = s->frame_bytes;
+  if (backend.callbacks) {
+    slot->bytes = backend.callbacks->acquire_cpu_payload_buffer(payload_key);
+  }
+  if (!slot->bytes) {
+    if (!slot->spare || slot->spare.use_count() != 1) {
+      try {
+        slot->spare = std::make_shared<CpuPayloadBytes>(s->frame_bytes);
+      } catch (...) {
+        slot->in_use.store(false, std::memory_order_release);
+        return; // repeating frames are lossy
+      }
+    }
+    slot->bytes = slot->spare;
+  }
+
+  FrameView fv{};
+  const bool produced =
+      planar ? repack_nv12_software_bitmap(bitmap, s->width, s->height, slot->bytes->data(), fv,
+                                           s->plane_layout)
+             : convert_software_bitmap(bitmap, s->width, s->height, s->fourcc,
+                                       slot->bytes->data(), s->plane_layout);
+  if (!produced) {
+    slot->bytes.reset();
     slot->in_use.store(false, std::memory_order_release);
     ++s->convert_failures;
     if ((s->convert_failures & (s->convert_failures - 1)) == 0) {
@@ -514,7 +739,6 @@ void deliver_frame_locked(DeviceBackend& backend,
   }
   ++s->frames_posted;
 
-  FrameView fv{};
   fv.device_instance_id = s->device_instance_id;
   fv.stream_id = s->stream_id;
   fv.acquisition_session_id = s->acquisition_session_id;
@@ -525,12 +749,14 @@ void deliver_frame_locked(DeviceBackend& backend,
   if (has_sample_time) {
     fv.acquisition_timing = make_acquisition_timing(sample_time_100ns);
   }
-  fv.data = slot->bytes.data();
-  fv.size_bytes = slot->bytes.size();
-  fv.stride_bytes = s->width * 4u;
+  fv.data = slot->bytes->data();
+  fv.size_bytes = planar ? fv.planes[0].size_bytes : slot->bytes->size();
+  fv.cpu_payload_owner = slot->bytes;
+  fv.stride_bytes = planar ? s->width : s->width * 4u;
   fv.requested_retained_plan = s->plan;
+  slot->self = slot;
   fv.release = &release_stream_frame;
-  fv.release_user = new StreamFrameLease{slot};
+  fv.release_user = slot.get();
   backend.strand->post_frame(fv);
 }
 
@@ -572,6 +798,128 @@ constexpr const char* kConsentKey =
 constexpr const char* kConsentKeyNonPackaged =
     "Software\\Microsoft\\Windows\\CurrentVersion\\CapabilityAccessManager\\ConsentStore\\webcam\\NonPackaged";
 
+// DeviceInformation.EnclosureLocation as read for one device.
+struct EnclosureLookup {
+  wde::Panel panel = wde::Panel::Unknown;
+  uint32_t rotation_degrees_clockwise = 0;
+
+  bool operator==(const EnclosureLookup&) const = default;
+};
+
+// Runs on a provider executor thread (MTA). False when the lookup fails,
+// outlasts wait_ms, is abandoned, or the device reports no enclosure location.
+bool lookup_enclosure(const winrt::hstring& device_hid,
+                      uint32_t wait_ms,
+                      const BoundedControlExecutor::AbandonToken& t,
+                      EnclosureLookup& out) noexcept {
+  try {
+    auto op = wde::DeviceInformation::CreateFromIdAsync(device_hid);
+    if (!winrt_detail::wait_async_bounded(op, wait_ms)) {
+      return false;
+    }
+    const wde::DeviceInformation info = op.GetResults();
+    if (t.abandoned.load(std::memory_order_acquire) || !info) {
+      return false;
+    }
+    const wde::EnclosureLocation enclosure = info.EnclosureLocation();
+    if (!enclosure) {
+      return false; // device reports no enclosure location; omit, don't guess
+    }
+    out.panel = enclosure.Panel();
+    out.rotation_degrees_clockwise = enclosure.RotationAngleInDegreesClockwise();
+    return !t.abandoned.load(std::memory_order_acquire);
+  } catch (...) {
+    // Best-effort enrichment only; a failure here must never affect
+    // open_device()'s already-committed success.
+    return false;
+  }
+}
+
+CameraStaticFacts static_facts_from_enclosure(const EnclosureLookup& enclosure) {
+  CameraStaticFacts facts{};
+  // A device that reports a physical enclosure panel is physical hardware by
+  // construction: a virtual camera has no chassis location to report. Derived
+  // rather than native-reported -- the platform stated a panel, not a nature.
+  // Devices without an enclosure location never get here, so no nature is
+  // claimed for USB or virtual cameras, which WinRT gives us no reliable way
+  // to tell apart.
+  facts.nature = SourcedFact<CameraNature>{CameraNature::PHYSICAL, FactOrigin::DERIVED};
+  if (enclosure.panel == wde::Panel::Front) {
+    facts.facing = SourcedFact<CameraFacing>{CameraFacing::FRONT, FactOrigin::NATIVE_REPORTED};
+  } else if (enclosure.panel == wde::Panel::Back) {
+    facts.facing = SourcedFact<CameraFacing>{CameraFacing::BACK, FactOrigin::NATIVE_REPORTED};
+  }
+  // Top/Bottom/Left/Right/Unknown don't map onto CamBANG's front/back/
+  // external vocabulary without guessing; omitted rather than fabricated.
+
+  const uint32_t rotation_mod = enclosure.rotation_degrees_clockwise % 360u;
+  // Real mountings are always axis-aligned in practice; round to the
+  // nearest quarter-turn rather than requiring an exact match.
+  const uint32_t nearest_quarter = ((rotation_mod + 45u) / 90u) % 4u;
+  switch (nearest_quarter) {
+    case 0u:
+      facts.sensor_orientation = SourcedFact<SensorOrientationDegrees>{
+          SensorOrientationDegrees::DEGREES_0, FactOrigin::NATIVE_REPORTED};
+      break;
+    case 1u:
+      facts.sensor_orientation = SourcedFact<SensorOrientationDegrees>{
+          SensorOrientationDegrees::DEGREES_90, FactOrigin::NATIVE_REPORTED};
+      break;
+    case 2u:
+      facts.sensor_orientation = SourcedFact<SensorOrientationDegrees>{
+          SensorOrientationDegrees::DEGREES_180, FactOrigin::NATIVE_REPORTED};
+      break;
+    default:
+      facts.sensor_orientation = SourcedFact<SensorOrientationDegrees>{
+          SensorOrientationDegrees::DEGREES_270, FactOrigin::NATIVE_REPORTED};
+      break;
+  }
+  return facts;
+}
+
+// Enclosure locations read so far in this process, by hardware_id. The
+// CreateFromIdAsync lookup behind them is the slowest part of open_device()'s
+// enrichment, and its answer does not change while the device stays plugged
+// in, so a provider started again in the same process (CamBANGServer
+// stop/start) reuses it and only revalidates in the background.
+class EnclosureCache final {
+public:
+  static EnclosureCache& instance() {
+    static EnclosureCache cache;
+    return cache;
+  }
+
+  bool find(const std::string& hardware_id, EnclosureLookup& out) {
+    std::lock_guard<std::mutex> lock(mu_);
+    const auto it = entries_.find(hardware_id);
+    if (it == entries_.end()) {
+      return false;
+    }
+    out = it->second;
+    return true;
+  }
+
+  // True when an entry existed and differed from enclosure.
+  bool store(const std::string& hardware_id, const EnclosureLookup& enclosure) {
+    std::lock_guard<std::mutex> lock(mu_);
+    auto [it, inserted] = entries_.try_emplace(hardware_id, enclosure);
+    if (inserted || it->second == enclosure) {
+      return false;
+    }
+    it->second = enclosure;
+    return true;
+  }
+
+  void erase(const std::string& hardware_id) {
+    std::lock_guard<std::mutex> lock(mu_);
+    entries_.erase(hardware_id);
+  }
+
+private:
+  std::mutex mu_;
+  std::map<std::string, EnclosureLookup> entries_;
+};
+
 } // namespace
 
 WinrtCameraProvider::~WinrtCameraProvider() {
@@ -670,10 +1018,18 @@ ProviderResult WinrtCameraProvider::initialize(IProviderCallbacks* callbacks) {
   if (!control_.start()) {
     return ProviderResult::failure(ProviderError::ERR_PROVIDER_FAILED);
   }
+  for (BoundedControlExecutor& worker : open_workers_) {
+    if (!worker.start()) {
+      stop_open_workers_();
+      control_.stop();
+      return ProviderResult::failure(ProviderError::ERR_PROVIDER_FAILED);
+    }
+  }
 
   callbacks_ = callbacks;
   if (!strand_.start(callbacks_, "winrt_provider")) {
     callbacks_ = nullptr;
+    stop_open_workers_();
     control_.stop();
     return ProviderResult::failure(ProviderError::ERR_PROVIDER_FAILED);
   }
@@ -681,6 +1037,7 @@ ProviderResult WinrtCameraProvider::initialize(IProviderCallbacks* callbacks) {
   if (!start_capture_executor_()) {
     strand_.stop();
     callbacks_ = nullptr;
+    stop_open_workers_();
     control_.stop();
     return ProviderResult::failure(ProviderError::ERR_PROVIDER_FAILED);
   }
@@ -767,86 +1124,26 @@ ProviderResult WinrtCameraProvider::open_device(
   backend->device_instance_id = device_instance_id;
   backend->root_id = root_id;
   backend->strand = &strand_;
-
-  struct OpenResult {
-    ProviderError error = ProviderError::ERR_PROVIDER_FAILED;
-    bool ok = false;
-  };
-  auto result = std::make_shared<OpenResult>();
-  auto token = std::make_shared<BoundedControlExecutor::AbandonToken>();
-  const winrt::hstring device_hid = winrt_detail::utf8_to_hstring(hardware_id);
-  const bool completed = control_.run_bounded(
-      [result, backend, device_hid](const BoundedControlExecutor::AbandonToken& t) {
-        OpenResult local;
-        wmc::MediaCapture capture{nullptr};
-        try {
-          capture = wmc::MediaCapture();
-          wmc::MediaCaptureInitializationSettings settings;
-          settings.VideoDeviceId(device_hid);
-          settings.StreamingCaptureMode(wmc::StreamingCaptureMode::Video);
-          // ExclusiveControl is required, not preferred: honouring Core's
-          // requested geometry goes through MediaFrameSource::SetFormatAsync,
-          // which a SharedReadOnly open cannot perform. Opening read-only was
-          // tried and fails start_stream outright, with no frames at all, so
-          // do not "fix" this by switching sharing mode -- the contract also
-          // forbids the workaround of inheriting whatever geometry the device
-          // happens to be in.
-          //
-          // It was briefly suspected that holding exclusive control freezes
-          // the camera's own autofocus. That is not so: a controlled
-          // comparison holding one autofocus-capable device 45s under each
-          // sharing mode showed autofocus and auto-exposure working normally
-          // in both, confirmed by direct observation of the lens motor.
-          settings.SharingMode(wmc::MediaCaptureSharingMode::ExclusiveControl);
-          settings.MemoryPreference(wmc::MediaCaptureMemoryPreference::Cpu);
-          auto op = capture.InitializeAsync(settings);
-          if (!winrt_detail::wait_async_bounded(op, kControlJobTimeoutMs - 500)) {
-            local.error = ProviderError::ERR_TIMEOUT;
-          } else {
-            op.GetResults();
-            local.ok = true;
-          }
-        } catch (const winrt::hresult_error& e) {
-          local.error = winrt_detail::provider_error_from_hresult(e.code());
-          winrt_detail::log_line("MediaCapture initialize failed hr=0x%08X",
-                                 static_cast<uint32_t>(e.code()));
-        } catch (...) {
-        }
-        if (t.abandoned.load(std::memory_order_acquire)) {
-          // Caller gave up: the acquisition is orphaned; release it here.
-          if (local.ok && capture) {
-            capture.Close();
-          }
-          return;
-        }
-        if (local.ok) {
-          std::weak_ptr<DeviceBackend> weak = backend;
-          std::lock_guard<std::mutex> bl(backend->m);
-          backend->capture = capture;
-          backend->failed_token = capture.Failed(
-              [weak](const wmc::MediaCapture&,
-                     const wmc::MediaCaptureFailedEventArgs& args) {
-                std::shared_ptr<DeviceBackend> strong = weak.lock();
-                if (!strong) {
-                  return;
-                }
-                std::lock_guard<std::mutex> bl2(strong->m);
-                if (strong->closed) {
-                  return;
-                }
-                strong->latch_failure_locked(
-                    winrt_detail::provider_error_from_hresult(
-                        winrt::hresult(static_cast<int32_t>(args.Code()))));
-              });
-        }
-        *result = local;
-      },
-      token, kControlJobTimeoutMs);
-  if (!completed) {
-    return ProviderResult::failure(ProviderError::ERR_TIMEOUT);
-  }
-  if (!result->ok) {
-    return ProviderResult::failure(result->error);
+  backend->callbacks = callbacks_;
+  backend->producer_frames_dropped = &producer_frames_dropped_;
+
+  // MediaCapture initialization runs on an open worker; this call returns
+  // once it is submitted. Everything that needs the capture waits for it
+  // (DeviceBackend::wait_open_settled), so a multi-camera startup overlaps
+  // its InitializeAsync calls instead of paying one after another.
+  const uint64_t native_id = alloc_native_id_(NativeObjectType::Device);
+  backend->open_pending = true;
+  backend->device_native_id = native_id;
+  std::shared_ptr<winrt_detail::CaptureRelease> prior_release;
+  if (auto rel_it = capture_releases_.find(hardware_id); rel_it != capture_releases_.end()) {
+    prior_release = std::move(rel_it->second);
+    capture_releases_.erase(rel_it);
+  }
+  BoundedControlExecutor& open_worker = open_workers_[device_instance_id % kOpenWorkerCount];
+  if (!open_worker.post([this, backend, hardware_id, prior_release] {
+        complete_device_open_(backend, hardware_id, prior_release);
+      })) {
+    return ProviderResult::failure(ProviderError::ERR_BAD_STATE);
   }
 
   dev.hardware_id = hardware_id;
@@ -854,125 +1151,187 @@ ProviderResult WinrtCameraProvider::open_device(
   dev.root_id = root_id;
   dev.open = true;
   dev.stream_id = 0;
-  dev.native_id = alloc_native_id_(NativeObjectType::Device);
+  dev.native_id = native_id;
   dev.backend = backend;
-
-  emit_native_created_(dev.native_id, NativeObjectType::Device, root_id,
-                       device_instance_id, 0, 0);
-  strand_.post_device_opened(device_instance_id);
-  post_static_camera_facts_best_effort_(device_instance_id, hardware_id);
   return ProviderResult::success();
 }
 
+void WinrtCameraProvider::complete_device_open_(
+    const std::shared_ptr<DeviceBackend>& backend,
+    const std::string& hardware_id,
+    const std::shared_ptr<winrt_detail::CaptureRelease>& prior_release) {
+  ProviderError error = ProviderError::ERR_PROVIDER_FAILED;
+  bool ok = false;
+  wmc::MediaCapture capture{nullptr};
+  if (prior_release && !prior_release->wait(kControlJobTimeoutMs)) {
+    // Initialize anyway: the release may yet land first, and if it does not
+    // the open fails truthfully with the busy error below.
+    winrt_detail::log_line("previous capture of device=%llu still releasing at reopen",
+                           static_cast<unsigned long long>(backend->device_instance_id));
+  }
+  try {
+    capture = wmc::MediaCapture();
+    wmc::MediaCaptureInitializationSettings settings;
+    settings.VideoDeviceId(winrt_detail::utf8_to_hstring(hardware_id));
+    settings.StreamingCaptureMode(wmc::StreamingCaptureMode::Video);
+    // ExclusiveControl is required, not preferred: honouring Core's
+    // requested geometry goes through MediaFrameSource::SetFormatAsync,
+    // which a SharedReadOnly open cannot perform. Opening read-only was
+    // tried and fails start_stream outright, with no frames at all, so
+    // do not "fix" this by switching sharing mode -- the contract also
+    // forbids the workaround of inheriting whatever geometry the device
+    // happens to be in.
+    //
+    // It was briefly suspected that holding exclusive control freezes
+    // the camera's own autofocus. That is not so: a controlled
+    // comparison holding one autofocus-capable device 45s under each
+    // sharing mode showed autofocus and auto-exposure working normally
+    // in both, confirmed by direct observation of the lens motor.
+    settings.SharingMode(wmc::MediaCaptureSharingMode::ExclusiveControl);
+    settings.MemoryPreference(wmc::MediaCaptureMemoryPreference::Cpu);
+    auto op = capture.InitializeAsync(settings);
+    if (!winrt_detail::wait_async_bounded(op, kControlJobTimeoutMs - 500)) {
+      error = ProviderError::ERR_TIMEOUT;
+    } else {
+      op.GetResults();
+      ok = true;
+    }
+  } catch (const winrt::hresult_error& e) {
+    error = winrt_detail::provider_error_from_hresult(e.code());
+    winrt_detail::log_line("MediaCapture initialize failed hr=0x%08X",
+                           static_cast<uint32_t>(e.code()));
+  } catch (...) {
+  }
+
+  bool opened = false;
+  {
+    std::lock_guard<std::mutex> bl(backend->m);
+    backend->open_pending = false;
+    if (backend->closed) {
+      // close_device() or shutdown gave up waiting; the capture is released
+      // below and was never reported.
+    } else if (ok) {
+      std::weak_ptr<DeviceBackend> weak = backend;
+      backend->capture = std::exchange(capture, nullptr);
+      backend->failed_token = backend->capture.Failed(
+          [weak](const wmc::MediaCapture&,
+                 const wmc::MediaCaptureFailedEventArgs& args) {
+            std::shared_ptr<DeviceBackend> strong = weak.lock();
+            if (!strong) {
+              return;
+            }
+            std::lock_guard<std::mutex> bl2(strong->m);
+            if (strong->closed) {
+              return;
+            }
+            strong->latch_failure_locked(
+                winrt_detail::provider_error_from_hresult(
+                    winrt::hresult(static_cast<int32_t>(args.Code()))));
+          });
+      backend->device_native_created = true;
+      emit_native_created_(backend->device_native_id, NativeObjectType::Device,
+                           backend->root_id, backend->device_instance_id, 0, 0);
+      strand_.post_device_opened(backend->device_instance_id);
+      opened = true;
+    } else {
+      backend->open_error = error;
+      backend->latch_failure_locked(error);
+    }
+  }
+  backend->open_cv.notify_all();
+  if (ok && capture) {
+    try {
+      capture.Close();
+    } catch (...) {
+    }
+  }
+  if (opened) {
+    post_static_camera_facts_best_effort_(backend, hardware_id);
+  }
+}
+
 void WinrtCameraProvider::post_static_camera_facts_best_effort_(
-    uint64_t device_instance_id, const std::string& hardware_id) {
-  struct LookupResult {
-    bool ok = false;
-    bool has_panel = false;
-    wde::Panel panel = wde::Panel::Unknown;
-    uint32_t rotation_degrees_clockwise = 0;
+    const std::shared_ptr<DeviceBackend>& backend, const std::string& hardware_id) {
+  const uint64_t device_instance_id = backend->device_instance_id;
+  const auto post_facts = [this, &backend, device_instance_id](const EnclosureLookup& enclosure) {
+    // Posted under m so facts never follow close_device()'s device closed.
+    std::lock_guard<std::mutex> bl(backend->m);
+    if (!backend->closed) {
+      strand_.post_camera_static_facts(
+          device_instance_id, ProviderCameraFacts{static_facts_from_enclosure(enclosure)});
+    }
   };
-  auto result = std::make_shared<LookupResult>();
-  auto token = std::make_shared<BoundedControlExecutor::AbandonToken>();
-  const winrt::hstring device_hid = winrt_detail::utf8_to_hstring(hardware_id);
-  const bool completed = control_.run_bounded(
-      [result, device_hid](const BoundedControlExecutor::AbandonToken& t) {
-        try {
-          auto op = wde::DeviceInformation::CreateFromIdAsync(device_hid);
-          if (!winrt_detail::wait_async_bounded(op, kControlJobTimeoutMs - 500)) {
-            return;
-          }
-          const wde::DeviceInformation info = op.GetResults();
-          if (t.abandoned.load(std::memory_order_acquire) || !info) {
-            return;
-          }
-          const wde::EnclosureLocation enclosure = info.EnclosureLocation();
-          if (!enclosure) {
-            return; // device reports no enclosure location; omit, don't guess
-          }
-          LookupResult local;
-          local.ok = true;
-          local.has_panel = true;
-          local.panel = enclosure.Panel();
-          local.rotation_degrees_clockwise = enclosure.RotationAngleInDegreesClockwise();
-          if (!t.abandoned.load(std::memory_order_acquire)) {
-            *result = local;
-          }
-        } catch (...) {
-          // Best-effort enrichment only; a failure here must never affect
-          // open_device()'s already-committed success.
-        }
-      },
-      token, kControlJobTimeoutMs);
-  if (!completed || !result->ok) {
+
+  EnclosureCache& cache = EnclosureCache::instance();
+  EnclosureLookup cached{};
+  const bool have_cached = cache.find(hardware_id, cached);
+  if (have_cached) {
+    post_facts(cached);
+  }
+
+  // On a cache hit this revalidates: the facts are already posted, and are
+  // posted again only if the platform now says something else.
+  const BoundedControlExecutor::AbandonToken live{};
+  EnclosureLookup fresh{};
+  if (!lookup_enclosure(winrt_detail::utf8_to_hstring(hardware_id),
+                        kControlJobTimeoutMs - 500, live, fresh)) {
+    if (have_cached) {
+      // Not reported any more (or not this time): stop trusting the entry
+      // for later opens; facts already posted for this open stand.
+      cache.erase(hardware_id);
+      return;
+    }
     winrt_detail::log_line(
         "static camera facts unavailable for device=%llu (enclosure location "
         "lookup timed out, failed, or device reports none)",
         static_cast<unsigned long long>(device_instance_id));
     return;
   }
-
-  CameraStaticFacts facts{};
-  // A device that reports a physical enclosure panel is physical hardware by
-  // construction: a virtual camera has no chassis location to report. Derived
-  // rather than native-reported -- the platform stated a panel, not a nature.
-  // Devices without an enclosure location reach the early return above, so no
-  // nature is claimed for USB or virtual cameras, which WinRT gives us no
-  // reliable way to tell apart.
-  facts.nature = SourcedFact<CameraNature>{CameraNature::PHYSICAL, FactOrigin::DERIVED};
-  if (result->panel == wde::Panel::Front) {
-    facts.facing = SourcedFact<CameraFacing>{CameraFacing::FRONT, FactOrigin::NATIVE_REPORTED};
-  } else if (result->panel == wde::Panel::Back) {
-    facts.facing = SourcedFact<CameraFacing>{CameraFacing::BACK, FactOrigin::NATIVE_REPORTED};
-  }
-  // Top/Bottom/Left/Right/Unknown don't map onto CamBANG's front/back/
-  // external vocabulary without guessing; omitted rather than fabricated.
-
-  const uint32_t rotation_mod = result->rotation_degrees_clockwise % 360u;
-  // Real mountings are always axis-aligned in practice; round to the
-  // nearest quarter-turn rather than requiring an exact match.
-  const uint32_t nearest_quarter = ((rotation_mod + 45u) / 90u) % 4u;
-  switch (nearest_quarter) {
-    case 0u:
-      facts.sensor_orientation = SourcedFact<SensorOrientationDegrees>{
-          SensorOrientationDegrees::DEGREES_0, FactOrigin::NATIVE_REPORTED};
-      break;
-    case 1u:
-      facts.sensor_orientation = SourcedFact<SensorOrientationDegrees>{
-          SensorOrientationDegrees::DEGREES_90, FactOrigin::NATIVE_REPORTED};
-      break;
-    case 2u:
-      facts.sensor_orientation = SourcedFact<SensorOrientationDegrees>{
-          SensorOrientationDegrees::DEGREES_180, FactOrigin::NATIVE_REPORTED};
-      break;
-    default:
-      facts.sensor_orientation = SourcedFact<SensorOrientationDegrees>{
-          SensorOrientationDegrees::DEGREES_270, FactOrigin::NATIVE_REPORTED};
-      break;
-  }
-
-  if (facts.facing || facts.nature || facts.sensor_orientation) {
-    strand_.post_camera_static_facts(device_instance_id, ProviderCameraFacts{facts});
+  if (cache.store(hardware_id, fresh)) {
+    winrt_detail::log_line(
+        "enclosure location changed since cached for device=%llu; reposting static facts",
+        static_cast<unsigned long long>(device_instance_id));
+  } else if (have_cached) {
+    return;
   }
+  post_facts(fresh);
 }
 
 ProviderResult WinrtCameraProvider::ensure_reader_realized_(
-    const std::shared_ptr<DeviceBackend>& backend) {
+    const std::shared_ptr<DeviceBackend>& backend,
+    uint32_t stream_fourcc) {
   if (!backend) {
     return ProviderResult::failure(ProviderError::ERR_BAD_STATE);
   }
+  const bool want_nv12 = stream_fourcc == FOURCC_NV12;
+  bool switching = false;
   std::lock_guard<std::mutex> configure_lock(backend->configure_mutex);
   {
-    std::lock_guard<std::mutex> bl(backend->m);
+    std::unique_lock<std::mutex> bl(backend->m);
+    if (!backend->wait_open_settled(bl, kControlJobTimeoutMs)) {
+      return ProviderResult::failure(ProviderError::ERR_TIMEOUT);
+    }
+    if (backend->open_error != ProviderError::OK) {
+      return ProviderResult::failure(backend->open_error);
+    }
     if (backend->closed) {
       return ProviderResult::failure(ProviderError::ERR_BAD_STATE);
     }
     if (backend->reader) {
-      return backend->failed
-                 ? ProviderResult::failure(ProviderError::ERR_PROVIDER_FAILED)
-                 : ProviderResult::success();
-    }
-    if (!backend->capture) {
+      if (backend->failed) {
+        return ProviderResult::failure(ProviderError::ERR_PROVIDER_FAILED);
+      }
+      if (stream_fourcc == 0 || backend->reader_nv12 == want_nv12) {
+        return ProviderResult::success();
+      }
+      // A stream needs the other subtype. The reader is replaced on the same
+      // frame source, so geometry and the acquisition session carry over;
+      // a live stream would lose delivery, hence the refusal.
+      if (backend->stream && backend->stream->producing) {
+        return ProviderResult::failure(ProviderError::ERR_PLATFORM_CONSTRAINT);
+      }
+      switching = true;
+    } else if (!backend->capture) {
       return ProviderResult::failure(ProviderError::ERR_BAD_STATE);
     }
   }
@@ -984,7 +1343,7 @@ ProviderResult WinrtCameraProvider::ensure_reader_realized_(
   auto result = std::make_shared<RealizeResult>();
   auto token = std::make_shared<BoundedControlExecutor::AbandonToken>();
   const bool completed = control_.run_bounded(
-      [result, backend](const BoundedControlExecutor::AbandonToken& t) {
+      [result, backend, want_nv12, switching](const BoundedControlExecutor::AbandonToken& t) {
         RealizeResult local;
         wmcf::MediaFrameSource source{nullptr};
         wmcf::MediaFrameReader reader{nullptr};
@@ -993,34 +1352,44 @@ ProviderResult WinrtCameraProvider::ensure_reader_realized_(
           {
             std::lock_guard<std::mutex> bl(backend->m);
             capture = backend->capture;
+            if (switching) {
+              source = backend->frame_source;
+            }
           }
-          if (!capture) {
+          if (!capture || (switching && !source)) {
             local.error = ProviderError::ERR_BAD_STATE;
           } else {
-            // Pick the color video source (prefer record, accept preview).
-            for (const auto& kv : capture.FrameSources()) {
-              const wmcf::MediaFrameSource candidate = kv.Value();
-              const auto info = candidate.Info();
-              if (info.SourceKind() != wmcf::MediaFrameSourceKind::Color) {
-                continue;
-              }
-              if (info.MediaStreamType() ==
-                  winrt::Windows::Media::Capture::MediaStreamType::VideoRecord) {
-                source = candidate;
-                break;
-              }
-              if (!source &&
-                  info.MediaStreamType() ==
-                      winrt::Windows::Media::Capture::MediaStreamType::VideoPreview) {
-                source = candidate;
+            // Pick the color video source (prefer record, accept preview);
+            // a subtype switch reuses the source already configured.
+            if (!switching) {
+              for (const auto& kv : capture.FrameSources()) {
+                const wmcf::MediaFrameSource candidate = kv.Value();
+                const auto info = candidate.Info();
+                if (info.SourceKind() != wmcf::MediaFrameSourceKind::Color) {
+                  continue;
+                }
+                if (info.MediaStreamType() ==
+                    winrt::Windows::Media::Capture::MediaStreamType::VideoRecord) {
+                  source = candidate;
+                  break;
+                }
+                if (!source &&
+                    info.MediaStreamType() ==
+                        winrt::Windows::Media::Capture::MediaStreamType::VideoPreview) {
+                  source = candidate;
+                }
               }
             }
             if (!source) {
               local.error = ProviderError::ERR_PLATFORM_CONSTRAINT;
               winrt_detail::log_line("no color video frame source on device");
             } else {
+              // Nv12 is the camera's native layout, so asking for it keeps
+              // Media Foundation from colour-converting every frame on the
+              // CPU; NV12 streams then publish the planes unconverted.
               auto op = capture.CreateFrameReaderAsync(
-                  source, wmm::MediaEncodingSubtypes::Bgra8());
+                  source, want_nv12 ? wmm::MediaEncodingSubtypes::Nv12()
+                                    : wmm::MediaEncodingSubtypes::Bgra8());
               if (!winrt_detail::wait_async_bounded(op, kControlJobTimeoutMs - 500)) {
                 local.error = ProviderError::ERR_TIMEOUT;
               } else {
@@ -1043,6 +1412,9 @@ ProviderResult WinrtCameraProvider::ensure_reader_realized_(
           }
           return;
         }
+        wmcf::MediaFrameReader replaced{nullptr};
+        winrt::event_token replaced_token{};
+        bool replaced_started = false;
         if (local.ok) {
           std::weak_ptr<DeviceBackend> weak = backend;
           std::lock_guard<std::mutex> bl(backend->m);
@@ -1050,8 +1422,12 @@ ProviderResult WinrtCameraProvider::ensure_reader_realized_(
             local.ok = false;
             local.error = ProviderError::ERR_BAD_STATE;
           } else {
+            replaced = std::exchange(backend->reader, nullptr);
+            replaced_token = std::exchange(backend->frame_token, {});
+            replaced_started = std::exchange(backend->reader_started, false);
             backend->frame_source = source;
             backend->reader = reader;
+            backend->reader_nv12 = want_nv12;
             backend->frame_token = reader.FrameArrived(
                 [weak](const wmcf::MediaFrameReader& rdr,
                        const wmcf::MediaFrameArrivedEventArgs&) {
@@ -1109,6 +1485,20 @@ ProviderResult WinrtCameraProvider::ensure_reader_realized_(
         if (!local.ok && reader) {
           reader.Close();
         }
+        if (replaced) {
+          try {
+            if (replaced_token.value != 0) {
+              replaced.FrameArrived(replaced_token);
+            }
+            if (replaced_started) {
+              auto stop_op = replaced.StopAsync();
+              (void)winrt_detail::wait_async_bounded(stop_op, kControlJobTimeoutMs - 500);
+            }
+            replaced.Close();
+          } catch (...) {
+            // Best-effort: the replaced reader is unreachable either way.
+          }
+        }
         *result = local;
       },
       token, kControlJobTimeoutMs);
@@ -1120,6 +1510,9 @@ ProviderResult WinrtCameraProvider::ensure_reader_realized_(
   if (!result->ok) {
     return ProviderResult::failure(result->error);
   }
+  if (switching) {
+    return ProviderResult::success(); // same source, same acquisition session
+  }
 
   // AcquisitionSession native truth: the concretely realized frame reader.
   const uint64_t session_id = alloc_native_id_(NativeObjectType::AcquisitionSession);
@@ -1144,7 +1537,8 @@ ProviderResult WinrtCameraProvider::ensure_reader_geometry_(
   if (width == 0 || height == 0) {
     return ProviderResult::failure(ProviderError::ERR_INVALID_ARGUMENT);
   }
-  if (format_fourcc != FOURCC_RGBA && format_fourcc != FOURCC_BGRA) {
+  if (format_fourcc != FOURCC_RGBA && format_fourcc != FOURCC_BGRA &&
+      format_fourcc != FOURCC_NV12) {
     return ProviderResult::failure(ProviderError::ERR_NOT_SUPPORTED);
   }
   if (!backend) {
@@ -1310,6 +1704,74 @@ ProviderResult WinrtCameraProvider::ensure_reader_started_(
   return ProviderResult::success();
 }
 
+ProviderResult WinrtCameraProvider::ensure_reader_stopped_(
+    const std::shared_ptr<DeviceBackend>& backend) {
+  if (!backend) {
+    return ProviderResult::failure(ProviderError::ERR_BAD_STATE);
+  }
+  std::lock_guard<std::mutex> configure_lock(backend->configure_mutex);
+  {
+    std::lock_guard<std::mutex> bl(backend->m);
+    if (backend->closed || !backend->reader || backend->failed) {
+      return ProviderResult::failure(ProviderError::ERR_BAD_STATE);
+    }
+    if (!backend->reader_started) {
+      return ProviderResult::success();
+    }
+  }
+
+  auto stopped = std::make_shared<bool>(false);
+  auto token = std::make_shared<BoundedControlExecutor::AbandonToken>();
+  const bool completed = control_.run_bounded(
+      [stopped, backend](const BoundedControlExecutor::AbandonToken& t) {
+        bool ok = false;
+        try {
+          wmcf::MediaFrameReader reader{nullptr};
+          {
+            std::lock_guard<std::mutex> bl(backend->m);
+            reader = backend->reader;
+          }
+          if (reader) {
+            auto op = reader.StopAsync();
+            ok = winrt_detail::wait_async_bounded(op, kControlJobTimeoutMs - 500);
+          }
+        } catch (const winrt::hresult_error& e) {
+          winrt_detail::log_line("reader StopAsync failed hr=0x%08X",
+                                 static_cast<uint32_t>(e.code()));
+        } catch (...) {
+        }
+        if (!t.abandoned.load(std::memory_order_acquire)) {
+          *stopped = ok;
+        }
+      },
+      token, kControlJobTimeoutMs);
+  if (!completed) {
+    return ProviderResult::failure(ProviderError::ERR_TIMEOUT);
+  }
+  if (!*stopped) {
+    return ProviderResult::failure(ProviderError::ERR_PROVIDER_FAILED);
+  }
+  std::lock_guard<std::mutex> bl(backend->m);
+  backend->reader_started = false;
+  return ProviderResult::success();
+}
+
+bool WinrtCameraProvider::mark_backend_closed_(
+    const std::shared_ptr<DeviceBackend>& backend, uint64_t& out_session_native_id) {
+  std::unique_lock<std::mutex> bl(backend->m);
+  // Bounded: an open still in flight past this releases its own capture.
+  (void)backend->wait_open_settled(bl, kControlJobTimeoutMs);
+  backend->closed = true;
+  out_session_native_id = backend->acquisition_session_id;
+  return backend->device_native_created;
+}
+
+void WinrtCameraProvider::stop_open_workers_() noexcept {
+  for (BoundedControlExecutor& worker : open_workers_) {
+    worker.stop();
+  }
+}
+
 ProviderResult WinrtCameraProvider::close_device(uint64_t device_instance_id) {
   if (!initialized_.load(std::memory_order_acquire)) {
     return ProviderResult::failure(ProviderError::ERR_BAD_STATE);
@@ -1340,17 +1802,20 @@ ProviderResult WinrtCameraProvider::close_device(uint64_t device_instance_id) {
   DeviceState& dev = it->second;
   std::shared_ptr<DeviceBackend> backend = dev.backend;
   uint64_t session_native_id = 0;
+  bool native_created = false;
   if (backend) {
-    std::lock_guard<std::mutex> bl(backend->m);
-    backend->closed = true;
-    session_native_id = backend->acquisition_session_id;
+    native_created = mark_backend_closed_(backend, session_native_id);
   }
 
   // Real release of WinRT objects on the control thread.
+  auto release = std::make_shared<winrt_detail::CaptureRelease>();
   auto token = std::make_shared<BoundedControlExecutor::AbandonToken>();
-  (void)control_.run_bounded(
-      [backend](const BoundedControlExecutor::AbandonToken& /*t*/) {
-        if (!backend) return;
+  const bool released = control_.run_bounded(
+      [backend, release](const BoundedControlExecutor::AbandonToken& /*t*/) {
+        if (!backend) {
+          release->finish();
+          return;
+        }
         wmcf::MediaFrameReader reader{nullptr};
         wmc::MediaCapture capture{nullptr};
         wmc::LowLagPhotoCapture low_lag_photo{nullptr};
@@ -1389,8 +1854,12 @@ ProviderResult WinrtCameraProvider::close_device(uint64_t device_instance_id) {
           // Best-effort backend release; truthful facts are emitted by the
           // caller regardless (the objects are unreachable after this).
         }
+        release->finish();
       },
       token, kControlJobTimeoutMs);
+  if (!released) {
+    capture_releases_[dev.hardware_id] = release;
+  }
 
   dev.open = false;
   dev.backend.reset();
@@ -1398,7 +1867,9 @@ ProviderResult WinrtCameraProvider::close_device(uint64_t device_instance_id) {
     emit_native_destroyed_(session_native_id);
   }
   strand_.post_device_closed(device_instance_id);
-  emit_native_destroyed_(dev.native_id);
+  if (native_created) {
+    emit_native_destroyed_(dev.native_id);
+  }
   dev.native_id = 0;
   return ProviderResult::success();
 }
@@ -1506,7 +1977,7 @@ ProviderResult WinrtCameraProvider::start_stream(
   }
   DeviceState& dev = dev_it->second;
 
-  ProviderResult pr = ensure_reader_realized_(dev.backend);
+  ProviderResult pr = ensure_reader_realized_(dev.backend, profile.format_fourcc);
   if (!pr.ok()) {
     return pr;
   }
@@ -1522,29 +1993,8 @@ ProviderResult WinrtCameraProvider::start_stream(
 
   StreamState& st = st_it->second;
   st.req.profile = profile;
-
-  uint64_t session_native_id = 0;
-  {
-    std::lock_guard<std::mutex> bl(dev.backend->m);
-    session_native_id = dev.backend->acquisition_session_id;
-  }
-
-  auto production = std::make_shared<StreamProduction>();
-  production->stream_id = stream_id;
-  production->device_instance_id = dev.device_instance_id;
-  production->acquisition_session_id = session_native_id;
-  production->width = profile.width;
-  production->height = profile.height;
-  production->fourcc = profile.format_fourcc;
-  production->plan = st.req.requested_retained_plan;
-  const size_t frame_bytes =
-      static_cast<size_t>(profile.width) * static_cast<size_t>(profile.height) * 4u;
-  production->pool.reserve(kStreamPoolSlots);
-  for (size_t i = 0; i < kStreamPoolSlots; ++i) {
-    auto slot = std::make_shared<StreamProduction::BufferSlot>();
-    slot->bytes.resize(frame_bytes);
-    production->pool.push_back(std::move(slot));
-  }
+  std::shared_ptr<StreamProduction> production =
+      make_stream_production_(dev, stream_id, profile, st.req.requested_retained_plan, st.pool_depth_hint);
 
   {
     std::lock_guard<std::mutex> bl(dev.backend->m);
@@ -1591,6 +2041,118 @@ ProviderResult WinrtCameraProvider::stop_stream(uint64_t stream_id) {
   return ProviderResult::success();
 }
 
+ProviderResult WinrtCameraProvider::reconfigure_stream(uint64_t stream_id,
+                                                      const CaptureProfile& profile) {
+  if (!initialized_.load(std::memory_order_acquire) ||
+      shutting_down_.load(std::memory_order_acquire)) {
+    return ProviderResult::failure(ProviderError::ERR_BAD_STATE);
+  }
+  if (profile.width == 0 || profile.height == 0) {
+    return ProviderResult::failure(ProviderError::ERR_INVALID_ARGUMENT);
+  }
+  if (profile.format_fourcc != FOURCC_RGBA && profile.format_fourcc != FOURCC_BGRA &&
+      profile.format_fourcc != FOURCC_NV12) {
+    return ProviderResult::failure(ProviderError::ERR_NOT_SUPPORTED);
+  }
+
+  std::lock_guard<std::mutex> state_lock(state_mutex_);
+  auto st_it = streams_.find(stream_id);
+  if (st_it == streams_.end() || !st_it->second.created) {
+    return ProviderResult::failure(ProviderError::ERR_BAD_STATE);
+  }
+  auto dev_it = devices_.find(st_it->second.req.device_instance_id);
+  if (dev_it == devices_.end() || !dev_it->second.open || !dev_it->second.backend) {
+    return ProviderResult::failure(ProviderError::ERR_BAD_STATE);
+  }
+  DeviceState& dev = dev_it->second;
+  StreamState& st = st_it->second;
+  const std::shared_ptr<DeviceBackend> backend = dev.backend;
+  const CaptureProfile previous = st.req.profile;
+  if (!st.started ||
+      (previous.width == profile.width && previous.height == profile.height &&
+       previous.format_fourcc == profile.format_fourcc)) {
+    // Nothing to renegotiate yet (start_stream does it), or only the frame
+    // rate changed, which the reader does not apply.
+    st.req.profile = profile;
+    return ProviderResult::success();
+  }
+
+  // The MediaCapture and frame source stay; the reader is paused, the source
+  // format renegotiated (the reader itself replaced only for a subtype
+  // change) and the reader resumed. Publication pauses with it, so no frame
+  // at a half-applied profile is posted.
+  const auto apply = [&](const CaptureProfile& p) -> ProviderResult {
+    {
+      std::lock_guard<std::mutex> bl(backend->m);
+      if (backend->stream && backend->stream->stream_id == stream_id) {
+        backend->stream->producing = false;
+      }
+    }
+    ProviderResult r = ensure_reader_realized_(backend, p.format_fourcc);
+    if (r.ok()) r = ensure_reader_stopped_(backend);
+    if (r.ok()) r = ensure_reader_geometry_(backend, p.width, p.height, p.format_fourcc);
+    if (r.ok()) r = ensure_reader_started_(backend);
+    if (!r.ok()) {
+      return r;
+    }
+    std::shared_ptr<StreamProduction> production =
+        make_stream_production_(dev, stream_id, p, st.req.requested_retained_plan, st.pool_depth_hint);
+    std::lock_guard<std::mutex> bl(backend->m);
+    if (backend->failed || backend->closed) {
+      return ProviderResult::failure(ProviderError::ERR_PROVIDER_FAILED);
+    }
+    production->producing = true;
+    backend->stream = production;
+    return ProviderResult::success();
+  };
+
+  const ProviderResult pr = apply(profile);
+  if (pr.ok()) {
+    st.req.profile = profile;
+    return pr;
+  }
+  winrt_detail::log_line("stream reconfigure to %ux%u failed code=%u; restoring %ux%u",
+                         profile.width, profile.height, static_cast<unsigned>(pr.code),
+                         previous.width, previous.height);
+  if (!apply(previous).ok()) {
+    // Neither profile runs: the stream has stopped, so say so.
+    st.started = false;
+    strand_.post_stream_stopped(stream_id, pr.code);
+  }
+  return pr;
+}
+
+std::shared_ptr<StreamProduction> WinrtCameraProvider::make_stream_production_(
+    const DeviceState& dev,
+    uint64_t stream_id,
+    const CaptureProfile& profile,
+    const CoreRetainedProductionPlan& plan,
+    uint32_t pool_depth_hint) {
+  uint64_t session_native_id = 0;
+  {
+    std::lock_guard<std::mutex> bl(dev.backend->m);
+    session_native_id = dev.backend->acquisition_session_id;
+  }
+
+  auto production = std::make_shared<StreamProduction>();
+  production->stream_id = stream_id;
+  production->device_instance_id = dev.device_instance_id;
+  production->acquisition_session_id = session_native_id;
+  production->width = profile.width;
+  production->height = profile.height;
+  production->fourcc = profile.format_fourcc;
+  production->frame_bytes =
+      winrt_detail::stream_frame_bytes(profile.width, profile.height, profile.format_fourcc);
+  production->plan = plan;
+  const size_t pool_slots =
+      std::max(kStreamPoolSlots, std::min<size_t>(pool_depth_hint, kMaxStreamPoolSlots));
+  production->pool.reserve(pool_slots);
+  for (size_t i = 0; i < pool_slots; ++i) {
+    production->pool.push_back(std::make_shared<StreamProduction::BufferSlot>());
+  }
+  return production;
+}
+
 ProviderResult WinrtCameraProvider::update_stream_retained_production_plan(
     uint64_t stream_id,
     CoreRetainedProductionPlan requested_retained_plan) {
@@ -1624,6 +2186,38 @@ ProviderResult WinrtCameraProvider::update_stream_retained_production_plan(
   return ProviderResult::success();
 }
 
+void WinrtCameraProvider::set_stream_pool_depth_hint(uint64_t stream_id,
+                                                     const StreamPoolDepthHint& hint) noexcept try {
+  if (!initialized_.load(std::memory_order_acquire)) {
+    return;
+  }
+  // A slot is held only until Core releases the frame; a retained result
+  // keeps the Core-pooled bytes, so the in-flight depth is what counts.
+  std::lock_guard<std::mutex> state_lock(state_mutex_);
+  auto st_it = streams_.find(stream_id);
+  if (st_it == streams_.end() || !st_it->second.created) {
+    return;
+  }
+  st_it->second.pool_depth_hint = hint.in_flight_frames;
+
+  auto dev_it = devices_.find(st_it->second.req.device_instance_id);
+  if (dev_it == devices_.end() || !dev_it->second.backend) {
+    return;
+  }
+  // The running production deepens now; a shallower hint takes effect with
+  // the next production made for the stream.
+  const size_t target = std::min<size_t>(hint.in_flight_frames, kMaxStreamPoolSlots);
+  std::lock_guard<std::mutex> bl(dev_it->second.backend->m);
+  auto& stream = dev_it->second.backend->stream;
+  if (!stream || stream->stream_id != stream_id) {
+    return;
+  }
+  while (stream->pool.size() < target) {
+    stream->pool.push_back(std::make_shared<StreamProduction::BufferSlot>());
+  }
+} catch (...) {
+}
+
 ProviderResult WinrtCameraProvider::set_stream_picture_config(
     uint64_t /*stream_id*/, const PictureConfig& /*picture*/) {
   return ProviderResult::failure(ProviderError::ERR_NOT_SUPPORTED);
@@ -1634,6 +2228,61 @@ ProviderResult WinrtCameraProvider::set_capture_picture_config(
   return ProviderResult::failure(ProviderError::ERR_NOT_SUPPORTED);
 }
 
+ProviderResult WinrtCameraProvider::sync_capture_parent_priming(const CaptureRequest& req) {
+  if (!initialized_.load(std::memory_order_acquire) ||
+      shutting_down_.load(std::memory_order_acquire)) {
+    return ProviderResult::failure(ProviderError::ERR_BAD_STATE);
+  }
+  if (req.device_instance_id == 0) {
+    return ProviderResult::failure(ProviderError::ERR_INVALID_ARGUMENT);
+  }
+
+  std::shared_ptr<DeviceBackend> backend;
+  {
+    std::lock_guard<std::mutex> state_lock(state_mutex_);
+    auto dev_it = devices_.find(req.device_instance_id);
+    if (dev_it == devices_.end() || !dev_it->second.open) {
+      return ProviderResult::failure(ProviderError::ERR_BAD_STATE);
+    }
+    backend = dev_it->second.backend;
+  }
+  if (!backend) {
+    return ProviderResult::failure(ProviderError::ERR_BAD_STATE);
+  }
+
+  // The same steps a capture job takes before CaptureAsync, each idempotent,
+  // so a repeated equivalent request costs only the checks.
+  ProviderResult pr = ensure_reader_realized_(backend, 0);
+  if (!pr.ok()) {
+    return pr;
+  }
+  if (req.width != 0 && req.height != 0) {
+    pr = ensure_reader_geometry_(backend, req.width, req.height, req.format_fourcc);
+    if (!pr.ok()) {
+      return pr;
+    }
+  }
+  return ensure_low_lag_photo_realized_(backend);
+}
+
+ProviderResult WinrtCameraProvider::release_capture_parent_priming(uint64_t device_instance_id) {
+  if (!initialized_.load(std::memory_order_acquire)) {
+    return ProviderResult::failure(ProviderError::ERR_BAD_STATE);
+  }
+  if (device_instance_id == 0) {
+    return ProviderResult::failure(ProviderError::ERR_INVALID_ARGUMENT);
+  }
+  std::lock_guard<std::mutex> state_lock(state_mutex_);
+  auto dev_it = devices_.find(device_instance_id);
+  if (dev_it == devices_.end() || !dev_it->second.open) {
+    return ProviderResult::failure(ProviderError::ERR_BAD_STATE);
+  }
+  // Nothing to drop: the photo pipeline is owned by the device, not by the
+  // priming hold, and finishing it here would only move its preparation back
+  // onto the next trigger.
+  return ProviderResult::success();
+}
+
 // ---------------------------------------------------------------------------
 // Still capture
 // ---------------------------------------------------------------------------
@@ -1683,6 +2332,7 @@ void WinrtCameraProvider::stop_and_join_capture_executor_() noexcept {
 }
 
 void WinrtCameraProvider::capture_worker_main_() noexcept {
+  apply_current_thread_policy(CBThreadRole::CaptureWorker, "cambang-winrt-cap");
   for (;;) {
     DeviceCaptureJob job;
     {
@@ -1714,14 +2364,8 @@ bool WinrtCameraProvider::query_exposure_compensation_range_(
   if (!backend) {
     return false;
   }
-  wmc::MediaCapture capture{nullptr};
-  {
-    std::lock_guard<std::mutex> bl(backend->m);
-    if (backend->closed) {
-      return false;
-    }
-    capture = backend->capture;
-  }
+  // Admission may ask while the device is still opening.
+  const wmc::MediaCapture capture = backend->opened_capture(kControlJobTimeoutMs);
   if (!capture) {
     return false;
   }
@@ -1750,14 +2394,8 @@ bool WinrtCameraProvider::query_focus_state_at_infinity_(
   if (!backend) {
     return false;
   }
-  wmc::MediaCapture capture{nullptr};
-  {
-    std::lock_guard<std::mutex> bl(backend->m);
-    if (backend->closed) {
-      return false;
-    }
-    capture = backend->capture;
-  }
+  // Admission may ask while the device is still opening.
+  const wmc::MediaCapture capture = backend->opened_capture(kControlJobTimeoutMs);
   if (!capture) {
     return false;
   }
@@ -1995,10 +2633,11 @@ WinrtCameraProvider::CapturedMemberFrame WinrtCameraProvider::capture_one_member
                     bitmap.PixelWidth(), bitmap.PixelHeight(), width, height);
                 local.error = ProviderError::ERR_PLATFORM_CONSTRAINT;
               } else {
-                auto bytes = std::make_shared<std::vector<uint8_t>>(
+                auto bytes = std::make_shared<CpuPayloadBytes>(
                     static_cast<size_t>(width) * height * 4u);
+                winrt_detail::BitmapPlaneLayout layout{};
                 if (winrt_detail::convert_software_bitmap(bitmap, width, height, format_fourcc,
-                                                          bytes->data())) {
+                                                          bytes->data(), layout)) {
                   local.bytes = std::move(bytes);
                   local.ok = true;
                 } else {
@@ -2101,7 +2740,7 @@ void WinrtCameraProvider::run_device_capture_job_(const DeviceCaptureJob& job) n
       return;
     }
 
-    ProviderResult pr = ensure_reader_realized_(backend);
+    ProviderResult pr = ensure_reader_realized_(backend, 0);
     if (!pr.ok()) {
       fail(pr.code);
       return;
@@ -2453,6 +3092,10 @@ ProviderResult WinrtCameraProvider::abort_capture(uint64_t /*capture_id*/) {
   return ProviderResult::failure(ProviderError::ERR_NOT_SUPPORTED);
 }
 
+uint64_t WinrtCameraProvider::producer_frames_dropped_total() const noexcept {
+  return producer_frames_dropped_.load(std::memory_order_relaxed);
+}
+
 ProviderResult WinrtCameraProvider::apply_camera_spec_patch(
     const std::string& hardware_id,
     uint64_t /*new_camera_spec_version*/,
@@ -2554,12 +3197,9 @@ ProviderResult WinrtCameraProvider::shutdown() {
     }
     std::shared_ptr<DeviceBackend> backend = dev.backend;
     uint64_t session_native_id = 0;
+    bool native_created = false;
     if (backend) {
-      {
-        std::lock_guard<std::mutex> bl(backend->m);
-        backend->closed = true;
-        session_native_id = backend->acquisition_session_id;
-      }
+      native_created = mark_backend_closed_(backend, session_native_id);
       auto token = std::make_shared<BoundedControlExecutor::AbandonToken>();
       (void)control_.run_bounded(
           [backend](const BoundedControlExecutor::AbandonToken& /*t*/) {
@@ -2610,18 +3250,24 @@ ProviderResult WinrtCameraProvider::shutdown() {
       emit_native_destroyed_(session_native_id);
     }
     strand_.post_device_closed(dev_id);
-    emit_native_destroyed_(dev.native_id);
+    if (native_created) {
+      emit_native_destroyed_(dev.native_id);
+    }
     dev.native_id = 0;
   }
 
+  capture_releases_.clear();
   emit_native_destroyed_(provider_native_id_);
   provider_native_id_ = 0;
   } // release state_mutex_ before draining the strand (brief §10)
 
   // 6. With provider state settled and no locks held: flush and stop the
-  //    strand, then stop the control thread.
+  //    strand, then stop the open workers and the control thread. An open
+  //    that outlived close's wait finishes here and releases its capture; it
+  //    reports nothing once the backend is closed.
   strand_.flush();
   strand_.stop();
+  stop_open_workers_();
   control_.stop();
 
   callbacks_ = nullptr;
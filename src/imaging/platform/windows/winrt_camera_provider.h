@@ -5,7 +5,8 @@
 // Family: windows_winrt (docs/provider_architecture.md §2.2.x). The backend
 // is the WinRT capture surface via C++/WinRT: Windows.Media.Capture
 // (MediaCapture) with Windows.Media.Capture.Frames (MediaFrameReader)
-// delivering Bgra8 software bitmaps. Device identity is the WinRT
+// delivering Bgra8 software bitmaps, or native NV12 planes for an NV12 stream
+// profile (no Media Foundation colour conversion). Device identity is the WinRT
 // DeviceInformation Id (the device-interface symbolic link). This
 // translation unit requires a C++/WinRT-capable toolchain (MSVC + Windows
 // SDK); the build compiles it only for MSVC Windows GDE targets.
@@ -34,13 +35,16 @@
 // - All WinRT object creation/configuration/release (every awaited async op)
 //   runs on a single provider-owned control thread with a bounded wait, so a
 //   wedged camera driver degrades to a deterministic ERR_TIMEOUT instead of
-//   wedging the core thread (brief §2 enforcement ladder).
+//   wedging the core thread (brief §2 enforcement ladder). MediaCapture
+//   initialization is the exception: it runs on one of a few open workers,
+//   so the opens of a multi-camera startup overlap (see open_device).
 // - FrameArrived events fire on WinRT threadpool threads; every
 //   provider->core fact is funneled through CBProviderStrand (the single
 //   serialized callback context).
 // - Still captures execute on a small bounded worker pool with generation-
 //   based cancellation; saturation is an admission failure (ERR_BUSY).
 
+#include <array>
 #include <atomic>
 #include <condition_variable>
 #include <cstdint>
@@ -89,6 +93,11 @@ public:
                    std::shared_ptr<AbandonToken> token,
                    uint32_t timeout_ms) noexcept;
 
+  // Queues job on the control thread without waiting for it. Returns false
+  // when the executor is stopped. Jobs still queued at stop() run before it
+  // returns.
+  bool post(std::function<void()> job) noexcept;
+
 private:
   void thread_main_() noexcept;
 
@@ -109,6 +118,8 @@ private:
 // Opaque holder for per-device WinRT capture objects + frame routing state.
 // Defined in the .cpp so no platform headers leak into this header.
 struct DeviceBackend;
+struct StreamProduction;
+struct CaptureRelease;
 
 } // namespace winrt_detail
 
@@ -142,9 +153,10 @@ public:
   // to the photo pipeline: the step count happens to be unchanged, but the
   // steps themselves are different.
   //
-  // Cold setup is three bounded control jobs -- frame-source/reader
-  // realization, geometry (SetFormatAsync), and LowLagPhotoCapture
-  // preparation. Reader *start* is no longer part of the capture path at all.
+  // Cold setup is a device open still in flight plus three bounded control
+  // jobs -- frame-source/reader realization, geometry (SetFormatAsync), and
+  // LowLagPhotoCapture preparation. Reader *start* is no longer part of the
+  // capture path at all.
   //
   // Each member then pays one bounded exposure-compensation control job
   // (kExposureControlJobTimeoutMs) plus the photo capture job, whose own bound
@@ -155,7 +167,7 @@ public:
   // This exceeds Core's 30s default, which sizes only for a single-image
   // capture.
   uint64_t capture_admission_watchdog_timeout_ns() const noexcept override {
-    constexpr uint64_t kColdSetupChainMs = 3ull * kControlJobTimeoutMs;
+    constexpr uint64_t kColdSetupChainMs = 4ull * kControlJobTimeoutMs;
     constexpr uint64_t kPerMemberMs =
         static_cast<uint64_t>(kExposureControlJobTimeoutMs) + kCaptureSampleWaitMs +
         kControlJobTimeoutMs;
@@ -174,6 +186,12 @@ public:
   ProviderResult initialize(IProviderCallbacks* callbacks) override;
   ProviderResult enumerate_endpoints(std::vector<CameraEndpoint>& out_endpoints) override;
 
+  // Returns once MediaCapture initialization is submitted to an open
+  // worker, so opening several cameras costs about the slowest open rather
+  // than the sum. The Device native object and on_device_opened follow once
+  // the capture is initialized; a failed open is reported as a device error.
+  // Reader realization, control queries and close_device wait (bounded) for
+  // an open still in flight.
   ProviderResult open_device(
       const std::string& hardware_id,
       uint64_t device_instance_id,
@@ -188,6 +206,7 @@ public:
       const CaptureProfile& profile,
       const PictureConfig& picture) override;
   ProviderResult stop_stream(uint64_t stream_id) override;
+  ProviderResult reconfigure_stream(uint64_t stream_id, const CaptureProfile& profile) override;
   ProviderResult update_stream_retained_production_plan(
       uint64_t stream_id,
       CoreRetainedProductionPlan requested_retained_plan) override;
@@ -195,9 +214,19 @@ public:
   ProviderResult set_stream_picture_config(uint64_t stream_id, const PictureConfig& picture) override;
   ProviderResult set_capture_picture_config(uint64_t device_instance_id, const PictureConfig& picture) override;
 
+  // Capture-parent priming realizes the frame source at the request's
+  // geometry and prepares the device's LowLagPhotoCapture ahead of the
+  // trigger, so a first still pays neither media-type negotiation nor photo
+  // pipeline preparation. The prepared pipeline lives until close_device();
+  // release leaves it warm.
+  ProviderResult sync_capture_parent_priming(const CaptureRequest& req) override;
+  ProviderResult release_capture_parent_priming(uint64_t device_instance_id) override;
+
   ProviderResult trigger_capture(const CaptureRequest& req) override;
   ProviderResult trigger_capture_submission(const CaptureSubmission& submission) override;
   ProviderResult abort_capture(uint64_t capture_id) override;
+  void set_stream_pool_depth_hint(uint64_t stream_id, const StreamPoolDepthHint& hint) noexcept override;
+  uint64_t producer_frames_dropped_total() const noexcept override;
 
   ProviderResult apply_camera_spec_patch(
       const std::string& hardware_id,
@@ -219,7 +248,12 @@ private:
   static constexpr size_t kCaptureQueueCapacity = 6;
   static constexpr uint32_t kCaptureSampleWaitMs = 5000;
   static constexpr uint32_t kControlJobTimeoutMs = 3500;
+  // Concurrent MediaCapture initializations: enough for a four-camera rig to
+  // open at once. Opens of more devices queue behind these.
+  static constexpr size_t kOpenWorkerCount = 4;
   static constexpr size_t kStreamPoolSlots = 8;
+  // Upper bound on a pool deepened by set_stream_pool_depth_hint().
+  static constexpr size_t kMaxStreamPoolSlots = 32;
   // Setting/reading a UVC device control is near-instant on real hardware;
   // this bound exists only to contain a wedged driver, matching the same
   // enforcement posture as kControlJobTimeoutMs.
@@ -250,6 +284,9 @@ private:
     bool created = false;
     bool started = false;
     uint64_t native_id = 0;
+    // Core's in-flight depth (set_stream_pool_depth_hint()), applied to
+    // every production made for the stream.
+    uint32_t pool_depth_hint = 0;
   };
 
   struct DeviceCaptureJob {
@@ -281,8 +318,12 @@ private:
   // holding a backend's inner mutex. Lock order: state_mutex_ (optional,
   // core-thread entries only) -> backend configure mutex -> backend inner
   // mutex; nothing re-acquires state_mutex_ inside the configure mutex.
+  // stream_fourcc picks the reader subtype (Nv12 for FOURCC_NV12, else
+  // Bgra8); 0 accepts whatever reader is already realized. A stopped reader
+  // of the other subtype is replaced on the same frame source.
   ProviderResult ensure_reader_realized_(
-      const std::shared_ptr<winrt_detail::DeviceBackend>& backend);
+      const std::shared_ptr<winrt_detail::DeviceBackend>& backend,
+      uint32_t stream_fourcc);
   // Configures the reader output media type (control thread). Same locking
   // rules as ensure_reader_realized_. Fails deterministically when a started
   // stream already pins a different geometry.
@@ -295,17 +336,46 @@ private:
   // ensure_reader_realized_.
   ProviderResult ensure_reader_started_(
       const std::shared_ptr<winrt_detail::DeviceBackend>& backend);
+  // Stops the realized frame reader (idempotent) without releasing it. Same
+  // locking rules as ensure_reader_realized_.
+  ProviderResult ensure_reader_stopped_(
+      const std::shared_ptr<winrt_detail::DeviceBackend>& backend);
+  // A fresh, not yet producing, production record for stream_id at profile.
+  std::shared_ptr<winrt_detail::StreamProduction> make_stream_production_(
+      const DeviceState& dev,
+      uint64_t stream_id,
+      const CaptureProfile& profile,
+      const CoreRetainedProductionPlan& plan,
+      uint32_t pool_depth_hint);
+
+  // Open worker: MediaCapture initialization for a device open_device() has
+  // accepted; settles DeviceBackend::open_pending and posts the Device native
+  // object, on_device_opened and static facts (or the failure).
+  // prior_release, when set, is the same hardware's previous capture still
+  // being released; the new capture is initialized only once it is gone.
+  void complete_device_open_(
+      const std::shared_ptr<winrt_detail::DeviceBackend>& backend,
+      const std::string& hardware_id,
+      const std::shared_ptr<winrt_detail::CaptureRelease>& prior_release);
+  // Waits (bounded) for an open in flight, then marks the backend closed.
+  // True when the Device native object was created, i.e. the capture opened.
+  bool mark_backend_closed_(const std::shared_ptr<winrt_detail::DeviceBackend>& backend,
+                            uint64_t& out_session_native_id);
+  void stop_open_workers_() noexcept;
 
   // Best-effort, device-level static camera facts (facing, sensor mounting
-  // orientation) from DeviceInformation.EnclosureLocation. Runs its own
-  // bounded control-thread lookup and never fails/blocks open_device(): a
-  // lookup failure, timeout, or a device with no reported enclosure location
-  // simply means no static facts are posted (never fabricated), logged via
-  // log_line for diagnosability only. Posts through the strand after
+  // orientation) from DeviceInformation.EnclosureLocation, looked up on the
+  // open worker after the capture opened; never fails the open: a lookup
+  // failure, timeout, or a device with no reported enclosure location simply
+  // means no static facts are posted (never fabricated), logged via log_line
+  // for diagnosability only. Posts through the strand after
   // on_device_opened, per brief §8 (static facts key by opened device
-  // identity).
+  // identity). A device whose enclosure location was already read in this
+  // process posts the cached facts at once and revalidates them, posting
+  // again only when they changed.
   void post_static_camera_facts_best_effort_(
-      uint64_t device_instance_id, const std::string& hardware_id);
+      const std::shared_ptr<winrt_detail::DeviceBackend>& backend,
+      const std::string& hardware_id);
 
   // Capture executor.
   bool start_capture_executor_() noexcept;
@@ -352,7 +422,7 @@ private:
   struct CapturedMemberFrame {
     bool ok = false;
     ProviderError error = ProviderError::ERR_PROVIDER_FAILED;
-    std::shared_ptr<std::vector<uint8_t>> bytes;
+    std::shared_ptr<CpuPayloadBytes> bytes;
     bool has_sample_time = false;
     int64_t sample_time_100ns = 0;
 
@@ -375,7 +445,8 @@ private:
   // waiter mechanism. Shared by the default-metered member and every
   // additional-bracket member -- this is the same single-frame wait
   // single-image capture already used, just made reusable per member.
-  // Prepares the per-device still-capture pipeline, once, on first capture.
+  // Prepares the per-device still-capture pipeline, once, at capture-parent
+  // priming or else on first capture.
   // Stills come from here rather than from the stream frame reader; see the
   // still-capture note in this header's overview.
   ProviderResult ensure_low_lag_photo_realized_(
@@ -389,14 +460,21 @@ private:
   IProviderCallbacks* callbacks_ = nullptr;
   std::atomic<bool> initialized_{false};
   std::atomic<bool> shutting_down_{false};
+  // Repeating frames dropped on frame pool exhaustion, over every backend.
+  std::atomic<uint64_t> producer_frames_dropped_{0};
 
   winrt_detail::BoundedControlExecutor control_;
+  // device_instance_id % kOpenWorkerCount picks the worker.
+  std::array<winrt_detail::BoundedControlExecutor, kOpenWorkerCount> open_workers_;
 
   // Provider bookkeeping state. Lock ordering when both are needed:
   // capture_mutex_ before state_mutex_ (matches SyntheticProvider).
   mutable std::mutex state_mutex_;
   std::map<uint64_t, DeviceState> devices_;   // key: device_instance_id
   std::map<uint64_t, StreamState> streams_;   // key: stream_id
+  // Captures whose release outlived close_device()'s bound, so a reopen of
+  // the same hardware waits for them. key: hardware_id
+  std::map<std::string, std::shared_ptr<winrt_detail::CaptureRelease>> capture_releases_;
   uint64_t provider_native_id_ = 0;
 
   // Capture executor state.
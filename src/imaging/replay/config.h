@@ -0,0 +1,77 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace cambang {
+
+// How ReplayProvider paces a recording.
+//   OriginalTiming: each frame is due at its recorded acquisition time
+//     relative to the first frame, on the clock advance() drives.
+//   AsFastAsPossible: every advance() emits frames until
+//     ReplayProviderConfig::max_frames_in_flight are held by Core, so the
+//     rate is whatever Core sustains.
+enum class ReplayPacing : std::uint8_t {
+  OriginalTiming = 0,
+  AsFastAsPossible = 1,
+};
+
+struct ReplayProviderConfig {
+  // A stream recording written by CoreStreamRecorder. Empty selects no replay.
+  std::string recording_path{};
+  ReplayPacing pacing = ReplayPacing::OriginalTiming;
+  // Restart from the first frame after the last one.
+  bool loop = true;
+  // Frames delivered and not yet released by Core; further frames wait.
+  uint32_t max_frames_in_flight = 4;
+};
+
+// Maintainer selection of replay for CamBANGServer's synthetic mode, as a
+// project setting or its command-line override. A non-empty recording
+// replaces SyntheticProvider with ReplayProvider for the next start().
+inline constexpr const char* kReplayRecordingProjectSetting =
+    "cambang/maintainer/replay_recording";
+inline constexpr const char* kReplayRecordingArg =
+    "--cambang-replay-recording=";
+inline constexpr const char* kReplayPacingProjectSetting =
+    "cambang/maintainer/replay_pacing";
+inline constexpr const char* kReplayPacingArg =
+    "--cambang-replay-pacing=";
+
+inline bool parse_replay_pacing(std::string_view pacing, ReplayPacing& out) noexcept {
+  if (pacing.empty() || pacing == "original_timing") {
+    out = ReplayPacing::OriginalTiming;
+    return true;
+  }
+  if (pacing == "as_fast_as_possible") {
+    out = ReplayPacing::AsFastAsPossible;
+    return true;
+  }
+  return false;
+}
+
+inline const char* replay_pacing_setting_value(ReplayPacing pacing) noexcept {
+  switch (pacing) {
+    case ReplayPacing::AsFastAsPossible:
+      return "as_fast_as_possible";
+    case ReplayPacing::OriginalTiming:
+    default:
+      return "original_timing";
+  }
+}
+
+// Builds the broker's replay request from the two maintainer settings.
+inline bool parse_replay_provider_selection(
+    std::string_view recording_path,
+    std::string_view pacing,
+    ReplayProviderConfig& out) {
+  out = ReplayProviderConfig{};
+  if (!parse_replay_pacing(pacing, out.pacing)) {
+    return false;
+  }
+  out.recording_path = std::string(recording_path);
+  return true;
+}
+
+} // namespace cambang
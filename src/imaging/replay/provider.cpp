@@ -0,0 +1,619 @@
+#include "imaging/replay/provider.h"
+
+#include <cstring>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+#include "imaging/api/mapped_file.h"
+
+namespace cambang {
+
+namespace {
+
+// CoreStreamRecorder's container (core/core_stream_recorder.h); the layout
+// is repeated here because providers do not depend on Core. Keep in step.
+constexpr char kFileMagic[8] = {'C', 'B', 'S', 'T', 'R', 'E', 'C', '\0'};
+constexpr uint32_t kFormatVersion = 1;
+constexpr uint64_t kAlignment = 64;
+constexpr uint64_t kFileHeaderBytes = 64;
+constexpr uint32_t kFrameMagic = 0x52464243u; // "CBFR"
+constexpr uint32_t kIndexMagic = 0x58494243u; // "CBIX"
+constexpr uint32_t kFrameHeaderBytes = 192;
+constexpr uint64_t kIndexHeaderBytes = 16;
+constexpr uint64_t kIndexEntryBytes = 16;
+constexpr int64_t kNoAcquisitionTime = std::numeric_limits<int64_t>::min();
+
+// Frame header field offsets.
+constexpr size_t kFrPayloadBytes = 8;
+constexpr size_t kFrWidth = 32;
+constexpr size_t kFrHeight = 36;
+constexpr size_t kFrFourcc = 40;
+constexpr size_t kFrStride = 44;
+constexpr size_t kFrPlaneCount = 48;
+constexpr size_t kFrPlaneOffsets = 56;  // u64 x kMaxFramePlanes
+constexpr size_t kFrPlaneStrides = 80;  // u32 x kMaxFramePlanes
+constexpr size_t kFrAcquisitionTime = 128;
+
+// Interval assumed when the recording carries no usable timing.
+constexpr uint64_t kDefaultFramePeriodNs = 33'333'333ull;
+// As in the stub heartbeat: a host stall does not turn into a burst of the
+// whole backlog; playback skips ahead instead.
+constexpr uint32_t kMaxCatchupFrames = 4;
+
+template <typename T>
+T get(const uint8_t* buf, size_t offset) noexcept {
+  using U = std::make_unsigned_t<T>;
+  U v = 0;
+  for (size_t i = 0; i < sizeof(T); ++i) {
+    v |= static_cast<U>(static_cast<U>(buf[offset + i]) << (8 * i));
+  }
+  return static_cast<T>(v);
+}
+
+uint64_t aligned(uint64_t offset) noexcept {
+  return (offset + kAlignment - 1) / kAlignment * kAlignment;
+}
+
+} // namespace
+
+ReplayProvider::ReplayProvider(ReplayProviderConfig config) : config_(std::move(config)) {}
+
+ReplayProvider::~ReplayProvider() = default;
+
+ProviderAccessStatus ReplayProvider::check_access_readiness() noexcept {
+  return ProviderAccessStatus::ready("replay_provider_ready");
+}
+
+const char* ReplayProvider::provider_name() const {
+  return "ReplayProvider";
+}
+
+StreamTemplate ReplayProvider::stream_template() const {
+  StreamTemplate t{};
+  t.profile.width = width_;
+  t.profile.height = height_;
+  t.profile.format_fourcc = format_fourcc_;
+  const uint64_t period = frame_period_ns_ != 0 ? frame_period_ns_ : kDefaultFramePeriodNs;
+  const uint32_t fps = static_cast<uint32_t>((1'000'000'000ull + period / 2) / period);
+  t.profile.target_fps_min = fps != 0 ? fps : 1;
+  t.profile.target_fps_max = t.profile.target_fps_min;
+  return t;
+}
+
+CaptureTemplate ReplayProvider::capture_template() const {
+  CaptureTemplate t{};
+  t.profile = stream_template().profile;
+  return t;
+}
+
+ProducerBackingCapabilities ReplayProvider::stream_backing_capabilities(
+    const CaptureProfile& profile,
+    const PictureConfig& picture) const noexcept {
+  (void)profile;
+  (void)picture;
+  return ProducerBackingCapabilities{true, false, false};
+}
+
+bool ReplayProvider::load_recording_() {
+  if (mapping_) {
+    // Re-initialized: frames from the previous session may still be held.
+    return true;
+  }
+  frames_.clear();
+  auto mapping = std::make_unique<CBMappedFile>();
+  if (config_.recording_path.empty() || !mapping->open(config_.recording_path)) {
+    return false;
+  }
+  const uint8_t* base = mapping->data();
+  const uint64_t file_bytes = mapping->size();
+  if (file_bytes < kFileHeaderBytes || std::memcmp(base, kFileMagic, sizeof(kFileMagic)) != 0 ||
+      get<uint32_t>(base, 8) != kFormatVersion) {
+    return false;
+  }
+
+  // Frame records in file order; chunk indexes are stepped over and the
+  // trailer (or a cut-short tail) ends the walk.
+  bool timed = true;
+  std::vector<int64_t> times;
+  for (uint64_t offset = aligned(get<uint32_t>(base, 12)); offset + 8 <= file_bytes;) {
+    const uint8_t* block = base + offset;
+    const uint32_t magic = get<uint32_t>(block, 0);
+    if (magic == kIndexMagic) {
+      offset = aligned(offset + kIndexHeaderBytes + kIndexEntryBytes * get<uint32_t>(block, 4));
+      continue;
+    }
+    if (magic != kFrameMagic || offset + kFrameHeaderBytes > file_bytes ||
+        get<uint32_t>(block, 4) != kFrameHeaderBytes) {
+      break;
+    }
+    const uint64_t payload_bytes = get<uint64_t>(block, kFrPayloadBytes);
+    const uint64_t payload_offset = offset + kFrameHeaderBytes;
+    if (payload_bytes == 0 || payload_bytes > file_bytes - payload_offset) {
+      break;
+    }
+    const uint32_t w = get<uint32_t>(block, kFrWidth);
+    const uint32_t h = get<uint32_t>(block, kFrHeight);
+    const uint32_t fourcc = get<uint32_t>(block, kFrFourcc);
+    if (frames_.empty()) {
+      width_ = w;
+      height_ = h;
+      format_fourcc_ = fourcc;
+    } else if (w != width_ || h != height_ || fourcc != format_fourcc_) {
+      return false;
+    }
+
+    RecordedFrame rec{};
+    rec.payload = base + payload_offset;
+    rec.payload_bytes = static_cast<size_t>(payload_bytes);
+    rec.stride_bytes = get<uint32_t>(block, kFrStride);
+    rec.plane_count = get<uint32_t>(block, kFrPlaneCount);
+    if (rec.plane_count > kMaxFramePlanes) {
+      return false;
+    }
+    for (uint32_t i = 0; i < rec.plane_count; ++i) {
+      const uint64_t plane_offset = get<uint64_t>(block, kFrPlaneOffsets + 8 * i);
+      if (plane_offset >= payload_bytes || (i > 0 && plane_offset <= rec.plane_offsets[i - 1])) {
+        return false;
+      }
+      rec.plane_offsets[i] = static_cast<size_t>(plane_offset);
+      rec.plane_strides[i] = get<uint32_t>(block, kFrPlaneStrides + 4 * i);
+    }
+    const int64_t time_ns = get<int64_t>(block, kFrAcquisitionTime);
+    timed = timed && time_ns != kNoAcquisitionTime;
+    times.push_back(time_ns);
+    frames_.push_back(rec);
+    offset = aligned(payload_offset + payload_bytes);
+  }
+  if (frames_.empty() || width_ == 0 || height_ == 0 || format_fourcc_ == 0) {
+    frames_.clear();
+    return false;
+  }
+
+  // Playback offsets: recorded acquisition times relative to the first frame
+  // (never running backwards), or a fixed cadence when any frame is untimed.
+  uint64_t last = 0;
+  for (size_t i = 0; i < frames_.size(); ++i) {
+    uint64_t offset_ns = static_cast<uint64_t>(i) * kDefaultFramePeriodNs;
+    if (timed) {
+      offset_ns = times[i] > times[0] ? static_cast<uint64_t>(times[i] - times[0]) : 0;
+    }
+    last = offset_ns > last ? offset_ns : last;
+    frames_[i].offset_ns = last;
+  }
+  frame_period_ns_ = frames_.size() > 1 ? last / (frames_.size() - 1) : 0;
+  if (frame_period_ns_ == 0) {
+    frame_period_ns_ = kDefaultFramePeriodNs;
+  }
+  pass_span_ns_ = last + frame_period_ns_;
+  mapping_ = std::move(mapping);
+  return true;
+}
+
+uint64_t ReplayProvider::alloc_native_id_(NativeObjectType type) const {
+  if (!callbacks_) {
+    return 0;
+  }
+  return callbacks_->allocate_native_id(type);
+}
+
+void ReplayProvider::emit_native_created_(
+    uint64_t native_id,
+    NativeObjectType type,
+    uint64_t root_id,
+    uint64_t owner_device_id,
+    uint64_t owner_acquisition_session_id,
+    uint64_t owner_stream_id) {
+  if (!callbacks_ || native_id == 0) {
+    return;
+  }
+  NativeObjectCreateInfo info{};
+  info.native_id = native_id;
+  info.type = static_cast<uint32_t>(type);
+  info.root_id = root_id;
+  info.owner_device_instance_id = owner_device_id;
+  info.owner_acquisition_session_id = owner_acquisition_session_id;
+  info.owner_stream_id = owner_stream_id;
+  info.owner_provider_native_id = type == NativeObjectType::Provider ? 0 : provider_native_id_;
+  info.has_created_ns = true;
+  info.created_ns = now_ns_;
+  strand_.post_native_object_created(info);
+}
+
+void ReplayProvider::emit_native_destroyed_(uint64_t native_id) {
+  if (!callbacks_ || native_id == 0) {
+    return;
+  }
+  NativeObjectDestroyInfo info{};
+  info.native_id = native_id;
+  info.has_destroyed_ns = true;
+  info.destroyed_ns = now_ns_;
+  strand_.post_native_object_destroyed(info);
+}
+
+void ReplayProvider::release_frame_(void* user, const FrameView* /*frame*/) {
+  auto* self = static_cast<ReplayProvider*>(user);
+  if (!self) {
+    return;
+  }
+  self->frames_released_.fetch_add(1, std::memory_order_relaxed);
+  self->frames_in_flight_.fetch_sub(1, std::memory_order_acq_rel);
+}
+
+ProviderResult ReplayProvider::initialize(IProviderCallbacks* callbacks) {
+  if (initialized_) {
+    return ProviderResult::failure(ProviderError::ERR_BAD_STATE);
+  }
+  if (!callbacks) {
+    return ProviderResult::failure(ProviderError::ERR_INVALID_ARGUMENT);
+  }
+  if (!load_recording_()) {
+    return ProviderResult::failure(ProviderError::ERR_INVALID_ARGUMENT);
+  }
+
+  callbacks_ = callbacks;
+  if (!strand_.start_inline(callbacks_, "replay_provider")) {
+    callbacks_ = nullptr;
+    return ProviderResult::failure(ProviderError::ERR_PROVIDER_FAILED);
+  }
+  now_ns_ = 1;
+  provider_native_id_ = alloc_native_id_(NativeObjectType::Provider);
+  emit_native_created_(provider_native_id_, NativeObjectType::Provider, 0, 0, 0, 0);
+  initialized_ = true;
+  shutting_down_ = false;
+  return ProviderResult::success();
+}
+
+#if defined(CAMBANG_INTERNAL_SMOKE)
+void ReplayProvider::flush_callbacks_for_smoke() {
+  strand_.flush();
+}
+#endif
+
+ProviderResult ReplayProvider::enumerate_endpoints(std::vector<CameraEndpoint>& out_endpoints) {
+  if (!initialized_ || shutting_down_) {
+    return ProviderResult::failure(ProviderError::ERR_BAD_STATE);
+  }
+  out_endpoints.clear();
+  CameraEndpoint ep;
+  ep.hardware_id = kReplayHardwareId;
+  ep.name = "Replay " + std::to_string(width_) + "x" + std::to_string(height_);
+  out_endpoints.push_back(ep);
+  return ProviderResult::success();
+}
+
+ProviderResult ReplayProvider::open_device(
+    const std::string& hardware_id,
+    uint64_t device_instance_id,
+    uint64_t root_id) {
+  if (!initialized_ || shutting_down_) {
+    return ProviderResult::failure(ProviderError::ERR_BAD_STATE);
+  }
+  if (hardware_id != kReplayHardwareId || device_instance_id == 0 || root_id == 0) {
+    return ProviderResult::failure(ProviderError::ERR_INVALID_ARGUMENT);
+  }
+  auto& dev = devices_[device_instance_id];
+  if (dev.open) {
+    return ProviderResult::failure(ProviderError::ERR_BUSY);
+  }
+  dev = DeviceState{};
+  dev.device_instance_id = device_instance_id;
+  dev.root_id = root_id;
+  dev.open = true;
+  dev.native_id = alloc_native_id_(NativeObjectType::Device);
+  emit_native_created_(dev.native_id, NativeObjectType::Device, root_id, device_instance_id, 0, 0);
+  strand_.post_device_opened(device_instance_id);
+  return ProviderResult::success();
+}
+
+ProviderResult ReplayProvider::close_device(uint64_t device_instance_id) {
+  if (!initialized_) {
+    return ProviderResult::failure(ProviderError::ERR_BAD_STATE);
+  }
+  auto it = devices_.find(device_instance_id);
+  if (it == devices_.end() || !it->second.open || it->second.stream_id != 0) {
+    return ProviderResult::failure(ProviderError::ERR_BAD_STATE);
+  }
+  it->second.open = false;
+  strand_.post_device_closed(device_instance_id);
+  emit_native_destroyed_(it->second.native_id);
+  devices_.erase(it);
+  return ProviderResult::success();
+}
+
+ProviderResult ReplayProvider::create_stream(const StreamRequest& req) {
+  if (!initialized_ || shutting_down_) {
+    return ProviderResult::failure(ProviderError::ERR_BAD_STATE);
+  }
+  if (req.stream_id == 0 || req.device_instance_id == 0) {
+    return ProviderResult::failure(ProviderError::ERR_INVALID_ARGUMENT);
+  }
+  auto dev_it = devices_.find(req.device_instance_id);
+  if (dev_it == devices_.end() || !dev_it->second.open) {
+    return ProviderResult::failure(ProviderError::ERR_BAD_STATE);
+  }
+  if (dev_it->second.stream_id != 0) {
+    return ProviderResult::failure(ProviderError::ERR_BUSY);
+  }
+  if (streams_.count(req.stream_id) != 0) {
+    return ProviderResult::failure(ProviderError::ERR_BAD_STATE);
+  }
+
+  DeviceState& dev = dev_it->second;
+  StreamState& st = streams_[req.stream_id];
+  st.req = req;
+  st.native_id = alloc_native_id_(NativeObjectType::Stream);
+  dev.acquisition_session_native_id = alloc_native_id_(NativeObjectType::AcquisitionSession);
+  st.acquisition_session_native_id = dev.acquisition_session_native_id;
+  dev.stream_id = req.stream_id;
+
+  emit_native_created_(dev.acquisition_session_native_id, NativeObjectType::AcquisitionSession,
+                       dev.root_id, dev.device_instance_id, 0, 0);
+  emit_native_created_(st.native_id, NativeObjectType::Stream, dev.root_id, dev.device_instance_id,
+                       st.acquisition_session_native_id, req.stream_id);
+  strand_.post_stream_created(req.stream_id);
+  return ProviderResult::success();
+}
+
+void ReplayProvider::close_stream_(std::map<uint64_t, StreamState>::iterator it) {
+  const uint64_t stream_id = it->first;
+  const uint64_t native_id = it->second.native_id;
+  auto dev_it = devices_.find(it->second.req.device_instance_id);
+  streams_.erase(it);
+  strand_.post_stream_destroyed(stream_id);
+  emit_native_destroyed_(native_id);
+  if (dev_it != devices_.end() && dev_it->second.stream_id == stream_id) {
+    dev_it->second.stream_id = 0;
+    emit_native_destroyed_(dev_it->second.acquisition_session_native_id);
+    dev_it->second.acquisition_session_native_id = 0;
+  }
+}
+
+ProviderResult ReplayProvider::destroy_stream(uint64_t stream_id) {
+  if (!initialized_) {
+    return ProviderResult::failure(ProviderError::ERR_BAD_STATE);
+  }
+  if (stream_id == 0) {
+    return ProviderResult::failure(ProviderError::ERR_INVALID_ARGUMENT);
+  }
+  auto it = streams_.find(stream_id);
+  if (it == streams_.end() || it->second.started) {
+    return ProviderResult::failure(ProviderError::ERR_BAD_STATE);
+  }
+  close_stream_(it);
+  return ProviderResult::success();
+}
+
+ProviderResult ReplayProvider::start_stream(
+    uint64_t stream_id,
+    const CaptureProfile& profile,
+    const PictureConfig& picture) {
+  (void)picture;
+  if (!initialized_ || shutting_down_) {
+    return ProviderResult::failure(ProviderError::ERR_BAD_STATE);
+  }
+  auto it = streams_.find(stream_id);
+  if (it == streams_.end() || it->second.started) {
+    return ProviderResult::failure(ProviderError::ERR_BAD_STATE);
+  }
+  if (profile.width == 0 || profile.height == 0 || profile.format_fourcc == 0) {
+    return ProviderResult::failure(ProviderError::ERR_INVALID_ARGUMENT);
+  }
+  // The recording fixes the geometry; the requested rate is ignored in
+  // favour of the recorded timing.
+  if (profile.width != width_ || profile.height != height_ || profile.format_fourcc != format_fourcc_) {
+    return ProviderResult::failure(ProviderError::ERR_NOT_SUPPORTED);
+  }
+
+  StreamState& st = it->second;
+  st.req.profile = profile;
+  st.started = true;
+  st.cursor = 0;
+  st.pass_start_ns = now_ns_;
+  strand_.post_stream_started(stream_id);
+  // The first frame is due now.
+  emit_due_frames_(stream_id, st);
+  return ProviderResult::success();
+}
+
+void ReplayProvider::advance(uint64_t dt_ns) {
+  if (!initialized_ || shutting_down_) {
+    return;
+  }
+  now_ns_ += dt_ns;
+  for (auto& [stream_id, st] : streams_) {
+    if (st.started) {
+      emit_due_frames_(stream_id, st);
+    }
+  }
+}
+
+void ReplayProvider::emit_due_frames_(uint64_t stream_id, StreamState& st) {
+  const bool paced = config_.pacing == ReplayPacing::OriginalTiming;
+  // Unpaced playback emits at most one pass of the recording per call, so a
+  // consumer that releases synchronously cannot spin it forever.
+  const size_t limit = paced ? kMaxCatchupFrames : frames_.size();
+  size_t emitted = 0;
+  while (emitted < limit &&
+         frames_in_flight_.load(std::memory_order_acquire) < config_.max_frames_in_flight) {
+    if (st.cursor == frames_.size()) {
+      if (!config_.loop) {
+        return;
+      }
+      st.cursor = 0;
+      st.pass_start_ns += pass_span_ns_;
+    }
+    const RecordedFrame& rec = frames_[st.cursor];
+    const uint64_t due_ns = st.pass_start_ns + rec.offset_ns;
+    if (paced && due_ns > now_ns_) {
+      return;
+    }
+    emit_frame_(stream_id, st, rec, paced ? due_ns : now_ns_);
+    ++st.cursor;
+    ++emitted;
+  }
+  if (paced && emitted == limit && st.cursor < frames_.size() &&
+      st.pass_start_ns + frames_[st.cursor].offset_ns <= now_ns_) {
+    // Far behind: re-anchor so the next frame is due now.
+    st.pass_start_ns = now_ns_ - frames_[st.cursor].offset_ns;
+  }
+}
+
+void ReplayProvider::emit_frame_(uint64_t stream_id, StreamState& st, const RecordedFrame& rec, uint64_t due_ns) {
+  FrameView fv{};
+  fv.device_instance_id = st.req.device_instance_id;
+  fv.stream_id = stream_id;
+  fv.width = width_;
+  fv.height = height_;
+  fv.format_fourcc = format_fourcc_;
+
+  const auto tick_period = TickPeriod::create(1, 1);
+  const auto checked_mark = ImageAcquisitionTiming::checked_mark_from_unsigned(due_ns);
+  if (tick_period && checked_mark) {
+    const auto timing = ImageAcquisitionTiming::create(
+        *checked_mark,
+        *tick_period,
+        ImageAcquisitionClockDomain::PROVIDER_MONOTONIC,
+        ImageAcquisitionReferenceEvent::PROVIDER_OBSERVED,
+        ImageAcquisitionComparability::SAME_PROVIDER);
+    if (timing) {
+      fv.acquisition_timing = SourcedFact<ImageAcquisitionTiming>{*timing, FactOrigin::DERIVED};
+    }
+  }
+
+  fv.data = rec.payload;
+  fv.size_bytes = rec.payload_bytes;
+  fv.stride_bytes = rec.stride_bytes;
+  fv.plane_count = rec.plane_count;
+  for (uint32_t i = 0; i < rec.plane_count; ++i) {
+    const size_t end = i + 1 < rec.plane_count ? rec.plane_offsets[i + 1] : rec.payload_bytes;
+    fv.planes[i].data = rec.payload + rec.plane_offsets[i];
+    fv.planes[i].size_bytes = end - rec.plane_offsets[i];
+    fv.planes[i].row_stride_bytes = rec.plane_strides[i];
+  }
+  if (rec.plane_count != 0) {
+    fv.data = fv.planes[0].data;
+    fv.size_bytes = fv.planes[0].size_bytes;
+    fv.stride_bytes = fv.planes[0].row_stride_bytes;
+  }
+  fv.requested_retained_plan = st.req.requested_retained_plan;
+  fv.release = &ReplayProvider::release_frame_;
+  fv.release_user = this;
+
+  ++st.frame_index;
+  frames_in_flight_.fetch_add(1, std::memory_order_acq_rel);
+  frames_emitted_.fetch_add(1, std::memory_order_relaxed);
+  strand_.post_frame(fv);
+}
+
+ProviderResult ReplayProvider::stop_stream(uint64_t stream_id) {
+  if (!initialized_) {
+    return ProviderResult::failure(ProviderError::ERR_BAD_STATE);
+  }
+  auto it = streams_.find(stream_id);
+  if (it == streams_.end() || !it->second.started) {
+    return ProviderResult::failure(ProviderError::ERR_BAD_STATE);
+  }
+  it->second.started = false;
+  strand_.post_stream_stopped(stream_id, ProviderError::OK);
+  return ProviderResult::success();
+}
+
+ProviderResult ReplayProvider::update_stream_retained_production_plan(
+    uint64_t stream_id,
+    CoreRetainedProductionPlan requested_retained_plan) {
+  if (!initialized_) {
+    return ProviderResult::failure(ProviderError::ERR_BAD_STATE);
+  }
+  if (!requested_retained_plan.valid) {
+    return ProviderResult::failure(ProviderError::ERR_INVALID_ARGUMENT);
+  }
+  auto it = streams_.find(stream_id);
+  if (it == streams_.end()) {
+    return ProviderResult::failure(ProviderError::ERR_BAD_STATE);
+  }
+  const ProducerBackingCapabilities caps =
+      stream_backing_capabilities(it->second.req.profile, it->second.req.picture);
+  if (!caps.viable(requested_retained_plan.posture)) {
+    return ProviderResult::failure(ProviderError::ERR_NOT_SUPPORTED);
+  }
+  it->second.req.requested_retained_plan = requested_retained_plan;
+  return ProviderResult::success();
+}
+
+ProviderResult ReplayProvider::set_stream_picture_config(uint64_t /*stream_id*/, const PictureConfig& /*picture*/) {
+  return ProviderResult::failure(ProviderError::ERR_NOT_SUPPORTED);
+}
+
+ProviderResult ReplayProvider::set_capture_picture_config(uint64_t /*device_instance_id*/, const PictureConfig& /*picture*/) {
+  return ProviderResult::failure(ProviderError::ERR_NOT_SUPPORTED);
+}
+
+ProviderResult ReplayProvider::trigger_capture(const CaptureRequest& /*req*/) {
+  return ProviderResult::failure(ProviderError::ERR_NOT_SUPPORTED);
+}
+
+ProviderResult ReplayProvider::abort_capture(uint64_t /*capture_id*/) {
+  return ProviderResult::failure(ProviderError::ERR_NOT_SUPPORTED);
+}
+
+ProviderResult ReplayProvider::apply_camera_spec_patch(
+    const std::string& hardware_id,
+    uint64_t /*new_camera_spec_version*/,
+    SpecPatchView /*patch*/) {
+  if (!initialized_ || shutting_down_) {
+    return ProviderResult::failure(ProviderError::ERR_BAD_STATE);
+  }
+  if (hardware_id != kReplayHardwareId) {
+    return ProviderResult::failure(ProviderError::ERR_INVALID_ARGUMENT);
+  }
+  return ProviderResult::success();
+}
+
+ProviderResult ReplayProvider::apply_imaging_spec_patch(
+    uint64_t /*new_imaging_spec_version*/,
+    SpecPatchView /*patch*/) {
+  if (!initialized_ || shutting_down_) {
+    return ProviderResult::failure(ProviderError::ERR_BAD_STATE);
+  }
+  return ProviderResult::success();
+}
+
+ProviderResult ReplayProvider::shutdown() {
+  if (!initialized_) {
+    return ProviderResult::failure(ProviderError::ERR_BAD_STATE);
+  }
+  if (shutting_down_) {
+    return ProviderResult::success();
+  }
+  shutting_down_ = true;
+
+  for (auto& [stream_id, st] : streams_) {
+    if (st.started) {
+      st.started = false;
+      strand_.post_stream_stopped(stream_id, ProviderError::OK);
+    }
+  }
+  while (!streams_.empty()) {
+    close_stream_(streams_.begin());
+  }
+  for (auto& [dev_id, dev] : devices_) {
+    if (dev.open) {
+      dev.open = false;
+      strand_.post_device_closed(dev_id);
+      emit_native_destroyed_(dev.native_id);
+    }
+  }
+  devices_.clear();
+
+  emit_native_destroyed_(provider_native_id_);
+  provider_native_id_ = 0;
+
+  strand_.flush();
+  strand_.stop();
+  callbacks_ = nullptr;
+  initialized_ = false;
+  return ProviderResult::success();
+}
+
+} // namespace cambang
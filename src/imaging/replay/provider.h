@@ -0,0 +1,187 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "imaging/api/icamera_provider.h"
+#include "imaging/api/provider_access_status.h"
+#include "imaging/api/provider_strand.h"
+#include "imaging/replay/config.h"
+
+namespace cambang {
+
+class CBMappedFile;
+
+// Plays a stream recording (CoreStreamRecorder's container) back as one
+// camera endpoint with one repeating stream.
+//
+// The recording is memory-mapped read-only at initialize(); every frame is a
+// CPU-backed FrameView whose data (and planes) point straight into the
+// mapping. Nothing is copied or recycled, so release() only hands the frame's
+// in-flight credit back. The mapping lives until the provider is destroyed,
+// like the stub provider's buffer slots, so frames Core still holds after
+// shutdown() stay valid.
+//
+// The provider reads the container itself (providers do not depend on Core):
+// it walks the self-describing frame records, so a recording cut short
+// without its trailer replays too. Every frame must share one geometry and
+// FourCC, which become the stream and capture templates. Still captures are
+// not supported.
+//
+// Frames carry playback-time acquisition timing on the provider clock;
+// recorded capture facts are not replayed.
+//
+// Time only moves through advance() (the broker's virtual-time tick), as for
+// the stub provider.
+class ReplayProvider final : public ICameraProvider {
+public:
+  static constexpr const char* kReplayHardwareId = "replay0";
+
+  explicit ReplayProvider(ReplayProviderConfig config);
+  ~ReplayProvider() override;
+
+  ReplayProvider(const ReplayProvider&) = delete;
+  ReplayProvider& operator=(const ReplayProvider&) = delete;
+
+  static ProviderAccessStatus check_access_readiness() noexcept;
+
+  const char* provider_name() const override;
+  ProviderKind provider_kind() const noexcept override { return ProviderKind::synthetic; }
+
+  StreamTemplate stream_template() const override;
+  CaptureTemplate capture_template() const override;
+  bool supports_stream_picture_updates() const noexcept override { return false; }
+  bool supports_capture_picture_updates() const noexcept override { return false; }
+  bool supports_multi_image_still_sequence() const noexcept override { return false; }
+  ProducerBackingCapabilities stream_backing_capabilities(
+      const CaptureProfile& profile,
+      const PictureConfig& picture) const noexcept override;
+
+  // Test instrumentation (thread-safe).
+  uint64_t frames_emitted() const noexcept { return frames_emitted_.load(std::memory_order_relaxed); }
+  uint64_t frames_released() const noexcept { return frames_released_.load(std::memory_order_relaxed); }
+  // Frames in the mapped recording (0 before initialize()).
+  size_t recorded_frame_count() const noexcept { return frames_.size(); }
+
+  // Virtual-time driver (not part of provider contract).
+  void advance(uint64_t dt_ns);
+#if defined(CAMBANG_INTERNAL_SMOKE)
+  void flush_callbacks_for_smoke();
+#endif
+
+  ProviderResult initialize(IProviderCallbacks* callbacks) override;
+  ProviderResult enumerate_endpoints(std::vector<CameraEndpoint>& out_endpoints) override;
+
+  ProviderResult open_device(
+      const std::string& hardware_id,
+      uint64_t device_instance_id,
+      uint64_t root_id) override;
+
+  ProviderResult close_device(uint64_t device_instance_id) override;
+
+  ProviderResult create_stream(const StreamRequest& req) override;
+  ProviderResult destroy_stream(uint64_t stream_id) override;
+
+  ProviderResult start_stream(
+      uint64_t stream_id,
+      const CaptureProfile& profile,
+      const PictureConfig& picture) override;
+  ProviderResult stop_stream(uint64_t stream_id) override;
+  ProviderResult update_stream_retained_production_plan(
+      uint64_t stream_id,
+      CoreRetainedProductionPlan requested_retained_plan) override;
+
+  ProviderResult set_stream_picture_config(uint64_t stream_id, const PictureConfig& picture) override;
+  ProviderResult set_capture_picture_config(uint64_t device_instance_id, const PictureConfig& picture) override;
+
+  ProviderResult trigger_capture(const CaptureRequest& req) override;
+  ProviderResult abort_capture(uint64_t capture_id) override;
+
+  ProviderResult apply_camera_spec_patch(
+      const std::string& hardware_id,
+      uint64_t new_camera_spec_version,
+      SpecPatchView patch) override;
+
+  ProviderResult apply_imaging_spec_patch(
+      uint64_t new_imaging_spec_version,
+      SpecPatchView patch) override;
+
+  ProviderResult shutdown() override;
+
+private:
+  // One frame record, resolved into the mapping.
+  struct RecordedFrame {
+    const uint8_t* payload = nullptr;
+    size_t payload_bytes = 0;
+    uint32_t stride_bytes = 0;
+    uint32_t plane_count = 0;
+    size_t plane_offsets[kMaxFramePlanes]{};
+    uint32_t plane_strides[kMaxFramePlanes]{};
+    // Playback offset from the first frame.
+    uint64_t offset_ns = 0;
+  };
+
+  struct DeviceState {
+    uint64_t device_instance_id = 0;
+    uint64_t root_id = 0;
+    bool open = false;
+    uint64_t stream_id = 0;
+    uint64_t native_id = 0;
+    uint64_t acquisition_session_native_id = 0;
+  };
+
+  struct StreamState {
+    StreamRequest req{};
+    bool started = false;
+    uint64_t native_id = 0;
+    uint64_t acquisition_session_native_id = 0;
+    uint64_t frame_index = 0;
+    // Next recorded frame and the playback time its loop pass started.
+    size_t cursor = 0;
+    uint64_t pass_start_ns = 0;
+  };
+
+  bool load_recording_();
+  void emit_due_frames_(uint64_t stream_id, StreamState& st);
+  void emit_frame_(uint64_t stream_id, StreamState& st, const RecordedFrame& rec, uint64_t due_ns);
+
+  uint64_t alloc_native_id_(NativeObjectType type) const;
+  void emit_native_created_(uint64_t native_id, NativeObjectType type, uint64_t root_id, uint64_t owner_device_id, uint64_t owner_acquisition_session_id, uint64_t owner_stream_id);
+  void emit_native_destroyed_(uint64_t native_id);
+  void close_stream_(std::map<uint64_t, StreamState>::iterator it);
+
+  static void release_frame_(void* user, const FrameView* frame);
+
+  ReplayProviderConfig config_;
+  CBProviderStrand strand_;
+  IProviderCallbacks* callbacks_ = nullptr;
+  bool initialized_ = false;
+  bool shutting_down_ = false;
+
+  std::unique_ptr<CBMappedFile> mapping_;
+  std::vector<RecordedFrame> frames_;
+  uint32_t width_ = 0;
+  uint32_t height_ = 0;
+  uint32_t format_fourcc_ = 0;
+  // Mean recorded frame interval, and one loop pass (last offset + interval).
+  uint64_t frame_period_ns_ = 0;
+  uint64_t pass_span_ns_ = 0;
+
+  std::map<uint64_t, DeviceState> devices_;  // key: device_instance_id
+  std::map<uint64_t, StreamState> streams_;  // key: stream_id
+
+  std::atomic<uint32_t> frames_in_flight_{0};
+  std::atomic<uint64_t> frames_emitted_{0};
+  std::atomic<uint64_t> frames_released_{0};
+
+  // Playback clock (ns since initialize()). Only advanced via advance().
+  uint64_t now_ns_ = 0;
+  uint64_t provider_native_id_ = 0;
+};
+
+} // namespace cambang
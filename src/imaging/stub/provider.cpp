@@ -1,5 +1,6 @@
 ﻿#include "imaging/stub/provider.h"
 
+#include <algorithm>
 #include <atomic>
 #include <cstdint>
 #include <vector>
@@ -132,6 +133,21 @@ void StubProvider::release_native_acquisition_session_(DeviceState& dev) {
   dev.acquisition_session_native_id = 0;
 }
 
+void StubProvider::retire_stream_buffer_pool_(StreamState& st) {
+  retired_buffer_slots_.erase(
+      std::remove_if(retired_buffer_slots_.begin(), retired_buffer_slots_.end(),
+                     [](const std::unique_ptr<StreamState::BufferSlot>& slot) {
+                       return !slot->in_use.load(std::memory_order_acquire);
+                     }),
+      retired_buffer_slots_.end());
+  for (auto& slot : st.pool) {
+    if (slot && slot->in_use.load(std::memory_order_acquire)) {
+      retired_buffer_slots_.push_back(std::move(slot));
+    }
+  }
+  st.pool.clear();
+}
+
 void StubProvider::release_test_frame(void* user, const FrameView* /*frame*/) {
   auto* slot = static_cast<StreamState::BufferSlot*>(user);
   if (!slot) return;
@@ -150,7 +166,7 @@ ProviderResult StubProvider::initialize(IProviderCallbacks* callbacks) {
   }
 
   callbacks_ = callbacks;
-  if (!strand_.start(callbacks_, "stub_provider")) {
+  if (!strand_.start_inline(callbacks_, "stub_provider")) {
     callbacks_ = nullptr;
     return ProviderResult::failure(ProviderError::ERR_PROVIDER_FAILED);
   }
@@ -305,6 +321,7 @@ ProviderResult StubProvider::destroy_stream(uint64_t stream_id) {
   }
 
   const uint64_t native_id = st_it->second.native_id;
+  retire_stream_buffer_pool_(st_it->second);
   streams_.erase(st_it);
   strand_.post_stream_destroyed(stream_id);
   emit_native_destroyed_(native_id);
@@ -652,6 +669,12 @@ ProviderResult StubProvider::release_capture_parent_priming(uint64_t device_inst
   return ProviderResult::success();
 }
 
+void StubProvider::set_stream_pool_depth_hint(uint64_t /*stream_id*/, const StreamPoolDepthHint& hint) noexcept {
+  last_pool_depth_hint_in_flight_.store(hint.in_flight_frames, std::memory_order_relaxed);
+  last_pool_depth_hint_retained_.store(hint.retained_frames, std::memory_order_relaxed);
+  pool_depth_hints_received_.fetch_add(1, std::memory_order_release);
+}
+
 ProviderResult StubProvider::trigger_capture(const CaptureRequest& req) {
   if (!initialized_ || shutting_down_) {
     return ProviderResult::failure(ProviderError::ERR_BAD_STATE);
@@ -733,6 +756,7 @@ ProviderResult StubProvider::shutdown() {
     }
 
     const uint64_t native_id = it->second.native_id;
+    retire_stream_buffer_pool_(it->second);
     it = streams_.erase(it);
     strand_.post_stream_destroyed(stream_id);
     emit_native_destroyed_(native_id);
@@ -42,6 +42,13 @@ public:
 // Test instrumentation (thread-safe).
 uint64_t frames_emitted() const noexcept { return frames_emitted_.load(std::memory_order_relaxed); }
 uint64_t frames_released() const noexcept { return frames_released_.load(std::memory_order_relaxed); }
+// Last set_stream_pool_depth_hint() received, and how many arrived. The stub
+// pool is sized for overload tests, so the hint is only recorded.
+uint64_t pool_depth_hints_received() const noexcept { return pool_depth_hints_received_.load(std::memory_order_acquire); }
+StreamPoolDepthHint last_pool_depth_hint() const noexcept {
+  return StreamPoolDepthHint{last_pool_depth_hint_in_flight_.load(std::memory_order_acquire),
+                             last_pool_depth_hint_retained_.load(std::memory_order_acquire)};
+}
 
   // Test-only helpers (not part of provider contract).
   void emit_test_frames(uint64_t stream_id, uint32_t count);
@@ -84,6 +91,7 @@ uint64_t frames_released() const noexcept { return frames_released_.load(std::me
   ProviderResult set_capture_picture_config(uint64_t device_instance_id, const PictureConfig& picture) override;
   ProviderResult sync_capture_parent_priming(const CaptureRequest& req) override;
   ProviderResult release_capture_parent_priming(uint64_t device_instance_id) override;
+  void set_stream_pool_depth_hint(uint64_t stream_id, const StreamPoolDepthHint& hint) noexcept override;
 
   ProviderResult trigger_capture(const CaptureRequest& req) override;
   ProviderResult abort_capture(uint64_t capture_id) override;
@@ -147,11 +155,20 @@ private:
   // Test instrumentation (thread-safe). Not part of the provider contract.
   std::atomic<uint64_t> frames_emitted_{0};
   std::atomic<uint64_t> frames_released_{0};
+  std::atomic<uint64_t> pool_depth_hints_received_{0};
+  std::atomic<uint32_t> last_pool_depth_hint_in_flight_{0};
+  std::atomic<uint32_t> last_pool_depth_hint_retained_{0};
 
   // Deterministic storage.
   std::map<uint64_t, DeviceState> devices_;   // key: device_instance_id
   std::map<uint64_t, StreamState> streams_;   // key: stream_id
 
+  // Buffer slots of destroyed streams whose frames Core has not released yet.
+  // Core may still hold a delivered frame (queued provider fact, parked
+  // ingress frame) after the strand has drained, so slot storage must outlive
+  // the stream until its release hook runs.
+  std::vector<std::unique_ptr<StreamState::BufferSlot>> retired_buffer_slots_;
+
   // Count of invalid preset requests observed at runtime (e.g. bad enum value).
   std::atomic<uint64_t> invalid_preset_requests_{0};
 
@@ -169,6 +186,7 @@ static constexpr const char* kStubHardwareId = "stub0";
   void emit_native_destroyed_(uint64_t native_id);
   uint64_t ensure_native_acquisition_session_(DeviceState& dev);
   void release_native_acquisition_session_(DeviceState& dev);
+  void retire_stream_buffer_pool_(StreamState& st);
 
   uint64_t provider_native_id_ = 0;
 };
@@ -46,6 +46,29 @@ enum class SyntheticProducerOutputFormMode : std::uint8_t {
   CpuAndGpu = 3,
 };
 
+// Stream frame content for SyntheticProvider. Headless skips pattern rendering
+// and GPU backing entirely: every stream frame is a CPU-backed FrameView of the
+// requested geometry whose payload is one immutable all-zero buffer shared by
+// every stream of that size, with the same metadata, timing and release
+// lifetime as a rendered frame. Meant for control-plane soak runs (device and
+// stream churn, rigs, capture admission, snapshot publish) with many endpoints
+// on one host; it overrides producer_output_form_mode for stream frames.
+// Still captures keep rendering.
+//
+// Looped renders the same frames as Rendered, but each one only once: a CPU
+// stream picture whose overlays repeat after a short frame-index period is
+// rendered into immutable buffers, one per ordinal of the period, shared by
+// every stream of that picture and size. Later frames hand the cached buffer
+// out as their payload with no copy and no render. Meant for load generation
+// at resolutions and stream counts the renderer cannot sustain. Streams with
+// GPU backing, a dynamic base or a period past the cache's byte budget render
+// as in Rendered.
+enum class SyntheticFrameContentMode : std::uint8_t {
+  Rendered = 0,
+  Headless = 1,
+  Looped = 2,
+};
+
 struct SyntheticStreamCapabilityDowngradeCondition {
   std::string device_hardware_id{};
   bool has_stream_intent = false;
@@ -396,6 +419,15 @@ struct SyntheticNominalDefaults {
   uint32_t fps_den = 1;
 
   uint64_t start_stream_warmup_ns = 0;
+
+  // Display-demand rate governor. After a stream has emitted this many
+  // consecutive frames with no display demand
+  // (IProviderCallbacks::is_stream_display_demand_active()), only every
+  // idle_demand_frame_divisor-th due frame is emitted; the cadence and
+  // timestamps of the frames that are emitted do not change, and the first
+  // due point that sees demand again emits at full rate. 0 disables.
+  uint32_t idle_demand_frames_before_throttle = 0;
+  uint32_t idle_demand_frame_divisor = 4;
 };
 
 struct SyntheticPatternDefaults {
@@ -419,6 +451,21 @@ struct SyntheticProviderConfig {
   SyntheticTimelineScenario timeline_scenario{};
 
   SyntheticProducerOutputFormMode producer_output_form_mode = SyntheticProducerOutputFormMode::Auto;
+  SyntheticFrameContentMode frame_content_mode = SyntheticFrameContentMode::Rendered;
+
+  // Worker threads shared by every stream for row-banded pattern base
+  // renders of large frames. 0 renders serially; kAutoPatternBandWorkers
+  // sizes the pool from hardware concurrency. Output bytes are the same either
+  // way.
+  static constexpr uint32_t kAutoPatternBandWorkers = 0xFFFFFFFFu;
+  uint32_t pattern_band_workers = kAutoPatternBandWorkers;
+
+  // Captures one device may have admitted but not yet terminal at once. A
+  // trigger past this depth is refused with ERR_BUSY. 0 bounds a device only
+  // by the shared capture queue. Whatever the depth, a device's terminal facts
+  // post in admission order.
+  uint32_t max_in_flight_captures_per_device = 0;
+
   std::vector<SyntheticStreamCapabilityDowngradeCondition>
       verification_stream_capability_downgrade_conditions{};
   std::vector<SyntheticCaptureCapabilityDowngradeCondition>
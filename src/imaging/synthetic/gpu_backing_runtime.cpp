@@ -1,11 +1,14 @@
 #include "imaging/synthetic/gpu_backing_runtime.h"
 
+#include <atomic>
 #include <condition_variable>
 #include <cstdio>
 #include <cstdlib>
 #include <cstddef>
 #include <mutex>
 
+#include "imaging/api/async_log.h"
+
 namespace cambang {
 namespace {
 
@@ -15,6 +18,12 @@ enum class RuntimeOpsPhase {
   Draining,
 };
 
+// Calls are admitted without the mutex: a call counts itself in, then reads
+// the published table. Install and clear (rare, serialized by the mutex)
+// unpublish the table first, then wait for the count to drain. All admission
+// atomics are seq_cst, so either the drain sees a call's count or the call
+// sees the unpublished table. Only a call that finishes while a drain waits
+// takes the mutex, to wake it.
 class RuntimeOpsRegistry final {
 public:
   class CallLease final {
@@ -45,12 +54,16 @@ public:
   };
 
   CallLease acquire_call() noexcept {
-    std::lock_guard<std::mutex> lock(mutex_);
-    if (phase_ != RuntimeOpsPhase::Active || !ops_) {
+    if (!published_ops_.load(std::memory_order_relaxed)) {
+      return {};
+    }
+    in_flight_calls_.fetch_add(1);
+    const SyntheticGpuBackingRuntimeOps* ops = published_ops_.load();
+    if (!ops) {
+      release_call_();
       return {};
     }
-    ++in_flight_calls_;
-    return CallLease(*this, ops_);
+    return CallLease(*this, ops);
   }
 
   void install(const SyntheticGpuBackingRuntimeOps* ops) noexcept {
@@ -61,7 +74,7 @@ public:
 
     std::unique_lock<std::mutex> lock(mutex_);
     wait_for_other_drain_(lock);
-    if (phase_ == RuntimeOpsPhase::Active && ops_ == ops) {
+    if (phase_ == RuntimeOpsPhase::Active && published_ops_.load() == ops) {
       return;
     }
     if (phase_ == RuntimeOpsPhase::Active) {
@@ -70,7 +83,7 @@ public:
       finish_drain_();
     }
 
-    ops_ = ops;
+    published_ops_.store(ops);
     phase_ = RuntimeOpsPhase::Active;
     state_changed_.notify_all();
   }
@@ -90,11 +103,13 @@ public:
 private:
   void begin_drain_() noexcept {
     phase_ = RuntimeOpsPhase::Draining;
-    ops_ = nullptr;
+    draining_.store(true);
+    published_ops_.store(nullptr);
     state_changed_.notify_all();
   }
 
   void finish_drain_() noexcept {
+    draining_.store(false);
     phase_ = RuntimeOpsPhase::Closed;
     state_changed_.notify_all();
   }
@@ -104,21 +119,21 @@ private:
   }
 
   void wait_for_in_flight_calls_(std::unique_lock<std::mutex>& lock) noexcept {
-    state_changed_.wait(lock, [this] { return in_flight_calls_ == 0; });
+    state_changed_.wait(lock, [this] { return in_flight_calls_.load() == 0; });
   }
 
   void release_call_() noexcept {
-    std::lock_guard<std::mutex> lock(mutex_);
-    --in_flight_calls_;
-    if (in_flight_calls_ == 0) {
+    if (in_flight_calls_.fetch_sub(1) == 1 && draining_.load()) {
+      std::lock_guard<std::mutex> lock(mutex_);
       state_changed_.notify_all();
     }
   }
 
   std::mutex mutex_;
   std::condition_variable state_changed_;
-  const SyntheticGpuBackingRuntimeOps* ops_ = nullptr;
-  std::size_t in_flight_calls_ = 0;
+  std::atomic<const SyntheticGpuBackingRuntimeOps*> published_ops_{nullptr};
+  std::atomic<std::size_t> in_flight_calls_{0};
+  std::atomic<bool> draining_{false};
   RuntimeOpsPhase phase_ = RuntimeOpsPhase::Closed;
 };
 
@@ -133,8 +148,7 @@ void trace_line(const char* message) {
   if (!gpu_trace_enabled()) {
     return;
   }
-  std::fprintf(stdout, "[CamBANG][SyntheticGpu] %s\n", message);
-  std::fflush(stdout);
+  async_log_printf(stdout, "[CamBANG][SyntheticGpu] %s\n", message);
 }
 
 } // namespace
@@ -216,14 +230,17 @@ bool synthetic_gpu_backing_update_stream_live_gpu_backing_rgba8(
     const uint8_t* src,
     uint32_t width,
     uint32_t height,
-    uint32_t stride_bytes) noexcept {
+    uint32_t stride_bytes,
+    const SyntheticGpuBackingDirtyRegion& dirty,
+    uint64_t frame_trace_id) noexcept {
   const RuntimeOpsRegistry::CallLease lease = g_registry.acquire_call();
   if (!lease || !lease.ops()->update_stream_live_gpu_backing_rgba8) {
     trace_line("update_stream_live_gpu_backing success=false reason=ops_unset_or_missing_update_fn");
     return false;
   }
   const bool ok =
-      lease.ops()->update_stream_live_gpu_backing_rgba8(backing, src, width, height, stride_bytes);
+      lease.ops()->update_stream_live_gpu_backing_rgba8(
+          backing, src, width, height, stride_bytes, dirty, frame_trace_id);
   trace_line(ok ? "update_stream_live_gpu_backing success=true" : "update_stream_live_gpu_backing success=false");
   return ok;
 }
@@ -250,47 +267,42 @@ bool synthetic_gpu_backing_can_materialize_to_image(const std::shared_ptr<void>&
   return ok;
 }
 
-bool synthetic_gpu_backing_take_update_timing_stats(
-    uint64_t& upload_copy_calls,
-    uint64_t& upload_copy_total_ns,
-    uint64_t& upload_copy_max_ns,
-    uint64_t& texture_update_calls,
-    uint64_t& texture_update_total_ns,
-    uint64_t& texture_update_max_ns,
-    uint64_t& texture_update_skipped) noexcept {
+bool synthetic_gpu_backing_can_generate_stream_live_pattern_rgba8() noexcept {
+  const RuntimeOpsRegistry::CallLease lease = g_registry.acquire_call();
+  return lease && lease.ops()->can_generate_stream_live_pattern_rgba8 &&
+         lease.ops()->generate_stream_live_pattern_rgba8 &&
+         lease.ops()->can_generate_stream_live_pattern_rgba8();
+}
+
+bool synthetic_gpu_backing_generate_stream_live_pattern_rgba8(
+    const std::shared_ptr<void>& backing,
+    uint32_t width,
+    uint32_t height,
+    const SyntheticGpuPatternFrame& frame,
+    uint64_t frame_trace_id) noexcept {
+  const RuntimeOpsRegistry::CallLease lease = g_registry.acquire_call();
+  if (!lease || !lease.ops()->generate_stream_live_pattern_rgba8) {
+    trace_line("generate_stream_live_pattern success=false reason=ops_unset_or_missing_generate_fn");
+    return false;
+  }
+  const bool ok = lease.ops()->generate_stream_live_pattern_rgba8(backing, width, height, frame, frame_trace_id);
+  trace_line(ok ? "generate_stream_live_pattern success=true" : "generate_stream_live_pattern success=false");
+  return ok;
+}
+
+bool synthetic_gpu_backing_take_update_timing_stats(SyntheticGpuBackingUpdateStats& out) noexcept {
   const RuntimeOpsRegistry::CallLease lease = g_registry.acquire_call();
   if (!lease || !lease.ops()->take_update_timing_stats) {
     return false;
   }
-  return lease.ops()->take_update_timing_stats(
-      upload_copy_calls,
-      upload_copy_total_ns,
-      upload_copy_max_ns,
-      texture_update_calls,
-      texture_update_total_ns,
-      texture_update_max_ns,
-      texture_update_skipped);
+  return lease.ops()->take_update_timing_stats(out);
 }
-bool synthetic_gpu_backing_peek_update_timing_stats(
-    uint64_t& upload_copy_calls,
-    uint64_t& upload_copy_total_ns,
-    uint64_t& upload_copy_max_ns,
-    uint64_t& texture_update_calls,
-    uint64_t& texture_update_total_ns,
-    uint64_t& texture_update_max_ns,
-    uint64_t& texture_update_skipped) noexcept {
+bool synthetic_gpu_backing_peek_update_timing_stats(SyntheticGpuBackingUpdateStats& out) noexcept {
   const RuntimeOpsRegistry::CallLease lease = g_registry.acquire_call();
   if (!lease || !lease.ops()->peek_update_timing_stats) {
     return false;
   }
-  return lease.ops()->peek_update_timing_stats(
-      upload_copy_calls,
-      upload_copy_total_ns,
-      upload_copy_max_ns,
-      texture_update_calls,
-      texture_update_total_ns,
-      texture_update_max_ns,
-      texture_update_skipped);
+  return lease.ops()->peek_update_timing_stats(out);
 }
 #else
 std::shared_ptr<void> synthetic_gpu_backing_create_stream_live_gpu_backing_rgba8(
@@ -309,12 +321,16 @@ bool synthetic_gpu_backing_update_stream_live_gpu_backing_rgba8(
     const uint8_t* src,
     uint32_t width,
     uint32_t height,
-    uint32_t stride_bytes) noexcept {
+    uint32_t stride_bytes,
+    const SyntheticGpuBackingDirtyRegion& dirty,
+    uint64_t frame_trace_id) noexcept {
   (void)backing;
   (void)src;
   (void)width;
   (void)height;
   (void)stride_bytes;
+  (void)dirty;
+  (void)frame_trace_id;
   return false;
 }
 void synthetic_gpu_backing_release_stream_live_gpu_backing(std::shared_ptr<void>& backing) noexcept {
@@ -324,38 +340,28 @@ bool synthetic_gpu_backing_can_materialize_to_image(const std::shared_ptr<void>&
   (void)backing;
   return false;
 }
-bool synthetic_gpu_backing_take_update_timing_stats(
-    uint64_t& upload_copy_calls,
-    uint64_t& upload_copy_total_ns,
-    uint64_t& upload_copy_max_ns,
-    uint64_t& texture_update_calls,
-    uint64_t& texture_update_total_ns,
-    uint64_t& texture_update_max_ns,
-    uint64_t& texture_update_skipped) noexcept {
-  (void)upload_copy_calls;
-  (void)upload_copy_total_ns;
-  (void)upload_copy_max_ns;
-  (void)texture_update_calls;
-  (void)texture_update_total_ns;
-  (void)texture_update_max_ns;
-  (void)texture_update_skipped;
+bool synthetic_gpu_backing_can_generate_stream_live_pattern_rgba8() noexcept {
+  return false;
+}
+bool synthetic_gpu_backing_generate_stream_live_pattern_rgba8(
+    const std::shared_ptr<void>& backing,
+    uint32_t width,
+    uint32_t height,
+    const SyntheticGpuPatternFrame& frame,
+    uint64_t frame_trace_id) noexcept {
+  (void)backing;
+  (void)width;
+  (void)height;
+  (void)frame;
+  (void)frame_trace_id;
+  return false;
+}
+bool synthetic_gpu_backing_take_update_timing_stats(SyntheticGpuBackingUpdateStats& out) noexcept {
+  (void)out;
   return false;
 }
-bool synthetic_gpu_backing_peek_update_timing_stats(
-    uint64_t& upload_copy_calls,
-    uint64_t& upload_copy_total_ns,
-    uint64_t& upload_copy_max_ns,
-    uint64_t& texture_update_calls,
-    uint64_t& texture_update_total_ns,
-    uint64_t& texture_update_max_ns,
-    uint64_t& texture_update_skipped) noexcept {
-  (void)upload_copy_calls;
-  (void)upload_copy_total_ns;
-  (void)upload_copy_max_ns;
-  (void)texture_update_calls;
-  (void)texture_update_total_ns;
-  (void)texture_update_max_ns;
-  (void)texture_update_skipped;
+bool synthetic_gpu_backing_peek_update_timing_stats(SyntheticGpuBackingUpdateStats& out) noexcept {
+  (void)out;
   return false;
 }
 #endif
@@ -6,6 +6,52 @@
 
 namespace cambang {
 
+// Pixels of an update that differ from the frame previously handed to the same
+// stream-live backing. The default (kWholeFrame extents) means everything
+// changed; an empty region means the frame is identical. The backing may
+// upload more than the region, never less.
+struct SyntheticGpuBackingDirtyRegion final {
+  static constexpr uint32_t kWholeFrame = 0xFFFFFFFFu;
+  uint32_t x = 0;
+  uint32_t y = 0;
+  uint32_t width = kWholeFrame;
+  uint32_t height = kWholeFrame;
+};
+
+// A stream-live frame the backing generates on the GPU instead of receiving
+// its pixels: a pattern base plus CpuPackedPatternRenderer's per-frame
+// overlays (frame-index offsets, moving bar) for frame_index. base holds
+// width x height tightly packed RGBA8 pixels and is read only when
+// base_revision differs from the backing's previous generated frame.
+struct SyntheticGpuPatternFrame final {
+  const uint8_t* base = nullptr;
+  uint64_t base_revision = 0;
+  uint64_t frame_index = 0;
+  bool overlay_frame_index_offsets = false;
+  bool overlay_moving_bar = false;
+};
+
+// Cumulative bridge cost counters since install. Durations are nanoseconds.
+struct SyntheticGpuBackingUpdateStats final {
+  // Producer-side copies of stream-live frames into staging.
+  uint64_t upload_copy_calls = 0;
+  uint64_t upload_copy_total_ns = 0;
+  uint64_t upload_copy_max_ns = 0;
+  // Render-thread texture uploads, and staged frames replaced before upload.
+  uint64_t texture_update_calls = 0;
+  uint64_t texture_update_total_ns = 0;
+  uint64_t texture_update_max_ns = 0;
+  uint64_t texture_update_skipped = 0;
+  // Backing textures taken from / not found in the released-texture pool.
+  uint64_t texture_pool_hits = 0;
+  uint64_t texture_pool_misses = 0;
+  // Render-thread release drains, and the deepest release queue one found.
+  uint64_t release_drain_calls = 0;
+  uint64_t release_drain_total_ns = 0;
+  uint64_t release_drain_max_ns = 0;
+  uint64_t release_queue_depth_max = 0;
+};
+
 struct SyntheticGpuBackingRuntimeOps final {
   bool (*is_available)() noexcept = nullptr;
   bool (*realize_rgba8_global_gpu_roundtrip)(
@@ -29,31 +75,29 @@ struct SyntheticGpuBackingRuntimeOps final {
       const uint8_t* src,
       uint32_t width,
       uint32_t height,
-      uint32_t stride_bytes) noexcept = nullptr;
+      uint32_t stride_bytes,
+      const SyntheticGpuBackingDirtyRegion& dirty,
+      uint64_t frame_trace_id) noexcept = nullptr;
   void (*release_stream_live_gpu_backing)(std::shared_ptr<void>& backing) noexcept = nullptr;
   bool (*can_materialize_to_image)(const std::shared_ptr<void>& backing) noexcept = nullptr;
-  bool (*take_update_timing_stats)(
-      uint64_t& upload_copy_calls,
-      uint64_t& upload_copy_total_ns,
-      uint64_t& upload_copy_max_ns,
-      uint64_t& texture_update_calls,
-      uint64_t& texture_update_total_ns,
-      uint64_t& texture_update_max_ns,
-      uint64_t& texture_update_skipped) noexcept = nullptr;
-  bool (*peek_update_timing_stats)(
-      uint64_t& upload_copy_calls,
-      uint64_t& upload_copy_total_ns,
-      uint64_t& upload_copy_max_ns,
-      uint64_t& texture_update_calls,
-      uint64_t& texture_update_total_ns,
-      uint64_t& texture_update_max_ns,
-      uint64_t& texture_update_skipped) noexcept = nullptr;
+  bool (*take_update_timing_stats)(SyntheticGpuBackingUpdateStats& out) noexcept = nullptr;
+  bool (*peek_update_timing_stats)(SyntheticGpuBackingUpdateStats& out) noexcept = nullptr;
+  // Optional. can_generate reports whether generate may currently succeed;
+  // a generate that returns false leaves the backing for a CPU update.
+  bool (*can_generate_stream_live_pattern_rgba8)() noexcept = nullptr;
+  bool (*generate_stream_live_pattern_rgba8)(
+      const std::shared_ptr<void>& backing,
+      uint32_t width,
+      uint32_t height,
+      const SyntheticGpuPatternFrame& frame,
+      uint64_t frame_trace_id) noexcept = nullptr;
 };
 
 // The table is non-owning and must remain alive until a matching clear has
 // returned. Installation safely drains a different active table before
 // publishing the replacement. Clear closes admission first, then waits for
-// every call already admitted through this seam to return.
+// every call already admitted through this seam to return. Admission itself
+// takes no lock, so the per-frame calls stay off the install/clear mutex.
 void set_synthetic_gpu_backing_runtime_ops(const SyntheticGpuBackingRuntimeOps* ops) noexcept;
 void clear_synthetic_gpu_backing_runtime_ops() noexcept;
 
@@ -81,24 +125,19 @@ bool synthetic_gpu_backing_update_stream_live_gpu_backing_rgba8(
     const uint8_t* src,
     uint32_t width,
     uint32_t height,
-    uint32_t stride_bytes) noexcept;
+    uint32_t stride_bytes,
+    const SyntheticGpuBackingDirtyRegion& dirty = {},
+    uint64_t frame_trace_id = 0) noexcept; // frame_latency_trace id of the frame, 0 if untraced
 void synthetic_gpu_backing_release_stream_live_gpu_backing(std::shared_ptr<void>& backing) noexcept;
 bool synthetic_gpu_backing_can_materialize_to_image(const std::shared_ptr<void>& backing) noexcept;
-bool synthetic_gpu_backing_take_update_timing_stats(
-    uint64_t& upload_copy_calls,
-    uint64_t& upload_copy_total_ns,
-    uint64_t& upload_copy_max_ns,
-    uint64_t& texture_update_calls,
-    uint64_t& texture_update_total_ns,
-    uint64_t& texture_update_max_ns,
-    uint64_t& texture_update_skipped) noexcept;
-bool synthetic_gpu_backing_peek_update_timing_stats(
-    uint64_t& upload_copy_calls,
-    uint64_t& upload_copy_total_ns,
-    uint64_t& upload_copy_max_ns,
-    uint64_t& texture_update_calls,
-    uint64_t& texture_update_total_ns,
-    uint64_t& texture_update_max_ns,
-    uint64_t& texture_update_skipped) noexcept;
+bool synthetic_gpu_backing_can_generate_stream_live_pattern_rgba8() noexcept;
+bool synthetic_gpu_backing_generate_stream_live_pattern_rgba8(
+    const std::shared_ptr<void>& backing,
+    uint32_t width,
+    uint32_t height,
+    const SyntheticGpuPatternFrame& frame,
+    uint64_t frame_trace_id = 0) noexcept;
+bool synthetic_gpu_backing_take_update_timing_stats(SyntheticGpuBackingUpdateStats& out) noexcept;
+bool synthetic_gpu_backing_peek_update_timing_stats(SyntheticGpuBackingUpdateStats& out) noexcept;
 
 } // namespace cambang
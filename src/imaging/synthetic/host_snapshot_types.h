@@ -104,6 +104,8 @@ struct SyntheticMetricsSnapshot {
   double gpu_texture_update_total_ms = 0.0;
   uint64_t catchup_ticks_capped = 0;
   uint64_t catchup_frames_dropped = 0;
+  uint64_t congested_frames_skipped = 0;
+  uint64_t demand_governed_frames_skipped = 0;
   SyntheticCaptureGpuBackingRetainPostureMetricsSnapshot
       capture_gpu_backing_retain_cpu_primary{};
   SyntheticCaptureGpuBackingRetainPostureMetricsSnapshot
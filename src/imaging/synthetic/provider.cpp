@@ -21,10 +21,15 @@
 #include <intrin.h> // _umul128 / _udiv128
 #endif
 
+#include "imaging/api/async_log.h"
 #include "imaging/synthetic/scenario_loader.h"
 #include "imaging/synthetic/gpu_update_policy_resolver.h"
+#include "imaging/api/frame_latency_trace.h"
+#include "imaging/api/precise_wait.h"
+#include "imaging/api/thread_policy.h"
 #include "imaging/api/timeline_teardown_trace.h"
 #include "imaging/synthetic/gpu_backing_runtime.h"
+#include "pixels/convert/packed_transform.h"
 #include "pixels/pattern/pattern_render_target.h"
 #if __has_include(<godot_cpp/variant/utility_functions.hpp>)
 #include <godot_cpp/variant/utility_functions.hpp>
@@ -69,7 +74,7 @@ void synthetic_triage_print_line(const std::string& line) {
 #if CAMBANG_SYNTH_TRIAGE_HAS_GODOT_UTILITY_PRINT
   godot::UtilityFunctions::print(line.c_str());
 #else
-  std::fprintf(stdout, "%s\n", line.c_str());
+  async_log_printf(stdout, "%s\n", line.c_str());
 #endif
 }
 
@@ -537,7 +542,12 @@ ProviderResult SyntheticProvider::initialize(IProviderCallbacks* callbacks) {
     return ProviderResult::failure(ProviderError::ERR_INVALID_ARGUMENT);
   }
   callbacks_ = callbacks;
-  if (!strand_.start(callbacks_, "synthetic_provider")) {
+  // Virtual time is driven from the host's tick, so its facts need no extra
+  // thread hop; capture workers' posts are serialized by the strand itself.
+  const bool strand_started = cfg_.timing_driver == TimingDriver::VirtualTime
+                                  ? strand_.start_inline(callbacks_, "synthetic_provider")
+                                  : strand_.start(callbacks_, "synthetic_provider");
+  if (!strand_started) {
     callbacks_ = nullptr;
     return ProviderResult::failure(ProviderError::ERR_PROVIDER_FAILED);
   }
@@ -547,6 +557,7 @@ ProviderResult SyntheticProvider::initialize(IProviderCallbacks* callbacks) {
     callbacks_ = nullptr;
     return ProviderResult::failure(ProviderError::ERR_PROVIDER_FAILED);
   }
+  start_pattern_band_pool_();
   initialized_ = true;
   {
     std::lock_guard<std::mutex> state_lock(provider_state_mutex_);
@@ -568,12 +579,8 @@ ProviderResult SyntheticProvider::initialize(IProviderCallbacks* callbacks) {
     timeline_running_ = true;
     timeline_paused_ = false;
     timeline_scenario_ = cfg_.timeline_scenario;
-    if (!timeline_scenario_.events.empty()) {
-      // Config-seeded scenarios are provider-owned and auto-run at initialize.
-      for (const auto& ev : timeline_scenario_.events) {
-        timeline_schedule_(ev);
-      }
-    }
+    // Config-seeded scenarios are provider-owned and auto-run at initialize.
+    timeline_arm_scenario_();
   }
 
   // Report provider native object (BOUND). Root/owners are 0 at provider scope.
@@ -590,21 +597,72 @@ ProviderResult SyntheticProvider::initialize(IProviderCallbacks* callbacks) {
     strand_.post_native_object_created(info);
   }
 
+  realtime_clock_ = cfg_.timing_driver == TimingDriver::RealTime &&
+                    cfg_.synthetic_role == SyntheticRole::Nominal;
+  if (realtime_clock_) {
+    realtime_origin_ns_ = provider_monotonic_now_ns() - clock_.now_ns();
+    start_realtime_pacer_();
+  }
+
   return ProviderResult::success();
 }
 
-void SyntheticProvider::timeline_schedule_(uint64_t at_ns, SyntheticEventType type, uint64_t stream_id) {
-  SyntheticScheduledEvent ev{};
-  ev.at_ns = at_ns;
-  ev.type = type;
-  ev.stream_id = stream_id;
-  timeline_schedule_(ev);
+void SyntheticProvider::timeline_schedule_emit_frame_(uint64_t at_ns, uint64_t stream_id) {
+  TimelineQueueEntry entry{};
+  entry.at_ns = at_ns;
+  entry.stream_id = stream_id;
+  entry.source = TimelineEntrySource::Continuation;
+  timeline_schedule_(entry);
 }
 
-void SyntheticProvider::timeline_schedule_(const SyntheticScheduledEvent& src) {
-  SyntheticScheduledEvent ev = src;
-  ev.seq = ++timeline_seq_;
-  timeline_q_.push(ev);
+void SyntheticProvider::timeline_schedule_(TimelineQueueEntry entry) {
+  entry.seq = ++timeline_seq_;
+  timeline_q_.push(entry);
+}
+
+void SyntheticProvider::timeline_schedule_periodic_(uint32_t index, uint64_t occurrence) {
+  const SyntheticPeriodicEvents& run = timeline_scenario_.periodic[index];
+  if (occurrence >= run.count) {
+    return;
+  }
+  TimelineQueueEntry entry{};
+  entry.at_ns = run.start_ns + occurrence * run.period_ns;
+  entry.occurrence = occurrence;
+  entry.index = index;
+  entry.source = TimelineEntrySource::Periodic;
+  timeline_schedule_(entry);
+}
+
+void SyntheticProvider::timeline_arm_scenario_() {
+  for (size_t i = 0; i < timeline_scenario_.events.size(); ++i) {
+    TimelineQueueEntry entry{};
+    entry.at_ns = timeline_scenario_.events[i].at_ns;
+    entry.index = static_cast<uint32_t>(i);
+    entry.source = TimelineEntrySource::Authored;
+    timeline_schedule_(entry);
+  }
+  for (size_t i = 0; i < timeline_scenario_.periodic.size(); ++i) {
+    timeline_schedule_periodic_(static_cast<uint32_t>(i), 0);
+  }
+}
+
+SyntheticScheduledEvent SyntheticProvider::timeline_event_for_entry_(const TimelineQueueEntry& entry) const {
+  SyntheticScheduledEvent ev{};
+  switch (entry.source) {
+    case TimelineEntrySource::Authored:
+      ev = timeline_scenario_.events[entry.index];
+      break;
+    case TimelineEntrySource::Periodic:
+      ev = timeline_scenario_.periodic[entry.index].event;
+      break;
+    case TimelineEntrySource::Continuation:
+      ev.type = SyntheticEventType::EmitFrame;
+      ev.stream_id = entry.stream_id;
+      break;
+  }
+  ev.at_ns = entry.at_ns;
+  ev.seq = entry.seq;
+  return ev;
 }
 
 void SyntheticProvider::timeline_dispatch_request_(const SyntheticScheduledEvent& ev) {
@@ -782,11 +840,15 @@ void SyntheticProvider::timeline_pump_(bool allow_paused_timeline_step) {
   uint32_t emitted_this_pump = 0;
   bool catchup_tick_capped = false;
   while (!timeline_q_.empty()) {
-    const SyntheticScheduledEvent ev = timeline_q_.top();
-    if (ev.at_ns > now) {
+    const TimelineQueueEntry entry = timeline_q_.top();
+    if (entry.at_ns > now) {
       break;
     }
     timeline_q_.pop();
+    if (entry.source == TimelineEntrySource::Periodic) {
+      timeline_schedule_periodic_(entry.index, entry.occurrence + 1);
+    }
+    const SyntheticScheduledEvent ev = timeline_event_for_entry_(entry);
     const auto event_t0 = std::chrono::steady_clock::now();
 
     switch (ev.type) {
@@ -803,7 +865,7 @@ void SyntheticProvider::timeline_pump_(bool allow_paused_timeline_step) {
         if (is_stream_capture_paused_locked_(s)) {
           s.consecutive_behind_ticks = 0;
           s.next_due_ns = snap_repeating_due_after_(ev.at_ns, now, period);
-          timeline_schedule_(s.next_due_ns, SyntheticEventType::EmitFrame, ev.stream_id);
+          timeline_schedule_emit_frame_(s.next_due_ns, ev.stream_id);
           break;
         }
         if (triage_catchup_cap_per_tick_ > 0 && emitted_this_pump >= triage_catchup_cap_per_tick_) {
@@ -811,9 +873,14 @@ void SyntheticProvider::timeline_pump_(bool allow_paused_timeline_step) {
             ++triage_catchup_ticks_capped_total_;
             catchup_tick_capped = true;
           }
-          ++triage_catchup_frames_dropped_total_;
+          triage_catchup_frames_dropped_total_.fetch_add(1, std::memory_order_relaxed);
           s.next_due_ns = ev.at_ns + period;
-          timeline_schedule_(s.next_due_ns, SyntheticEventType::EmitFrame, ev.stream_id);
+          timeline_schedule_emit_frame_(s.next_due_ns, ev.stream_id);
+          break;
+        }
+        if (should_skip_congested_frame_(s)) {
+          s.next_due_ns = ev.at_ns + period;
+          timeline_schedule_emit_frame_(s.next_due_ns, ev.stream_id);
           break;
         }
         // Execute the same frame emission path as nominal, but driven by explicit
@@ -826,7 +893,7 @@ void SyntheticProvider::timeline_pump_(bool allow_paused_timeline_step) {
         }
         s.next_due_ns = ev.at_ns + period;
         // Deterministic continuation: schedule the next frame.
-        timeline_schedule_(s.next_due_ns, SyntheticEventType::EmitFrame, ev.stream_id);
+        timeline_schedule_emit_frame_(s.next_due_ns, ev.stream_id);
         const auto emit_event_t1 = std::chrono::steady_clock::now();
         const uint64_t emit_event_ns = static_cast<uint64_t>(
             std::chrono::duration_cast<std::chrono::nanoseconds>(emit_event_t1 - emit_event_t0).count());
@@ -955,6 +1022,16 @@ uint64_t SyntheticProvider::alloc_native_id_(NativeObjectType type) {
   return callbacks_->allocate_native_id(type);
 }
 
+std::shared_ptr<CpuPayloadBytes> SyntheticProvider::acquire_cpu_payload_buffer_(
+    const CpuPayloadBufferKey& key) {
+  if (callbacks_) {
+    if (auto buffer = callbacks_->acquire_cpu_payload_buffer(key)) {
+      return buffer;
+    }
+  }
+  return local_cpu_payload_buffer_pool_.acquire(key);
+}
+
 void SyntheticProvider::emit_native_create_device_(const DeviceState& d) {
   if (!callbacks_) {
     return;
@@ -1377,14 +1454,13 @@ ProviderResult SyntheticProvider::start_stream(
   constexpr size_t kPoolSize = 8;
   const uint32_t stride = w * 4u;
   const size_t size_bytes = static_cast<size_t>(stride) * static_cast<size_t>(h);
-  const size_t existing0 = (s.pool.empty() || !s.pool[0]) ? 0 : s.pool[0]->bytes.size();
-  if (s.pool.size() != kPoolSize || existing0 != size_bytes) {
+  const size_t pool_size = std::max<size_t>(kPoolSize, s.pool_depth_hint);
+  if (s.pool.size() != pool_size) {
     s.pool.clear();
-    s.pool.reserve(kPoolSize);
-    for (size_t i = 0; i < kPoolSize; ++i) {
+    s.pool.reserve(pool_size);
+    for (size_t i = 0; i < pool_size; ++i) {
       auto slot = std::make_shared<SyntheticProvider::StreamState::BufferSlot>();
       slot->stream_id = stream_id;
-      slot->bytes.resize(size_bytes);
       slot->in_use.store(false, std::memory_order_relaxed);
       s.pool.emplace_back(std::move(slot));
     }
@@ -1413,6 +1489,8 @@ ProviderResult SyntheticProvider::start_stream(
     bool preset_valid = true;
     s.render_spec = build_stream_render_spec(s.picture, w, h, &preset_valid);
     s.render_spec_valid = true;
+    s.renderer.set_band_pool(&pattern_band_pool_);
+    s.renderer.set_base_cache(&PatternBaseCache::shared());
     s.renderer.configure(s.render_spec);
     if (!preset_valid) {
       invalid_preset_requests_.fetch_add(1, std::memory_order_relaxed);
@@ -1421,12 +1499,14 @@ ProviderResult SyntheticProvider::start_stream(
 
   s.started = true;
   s.producing = true;
+  s.demand_idle_frames = 0;
+  s.demand_throttled_due_points = 0;
 
   // First capture timestamp is scheduled (not wall-clock).
   s.next_due_ns = clock_.now_ns() + cfg_.nominal.start_stream_warmup_ns;
   if (cfg_.synthetic_role == SyntheticRole::Timeline) {
     // Timeline role: drive emission via explicit scheduled events.
-    timeline_schedule_(s.next_due_ns, SyntheticEventType::EmitFrame, stream_id);
+    timeline_schedule_emit_frame_(s.next_due_ns, stream_id);
   }
   strand_.post_stream_started(stream_id);
   return ProviderResult::success();
@@ -1455,6 +1535,46 @@ ProviderResult SyntheticProvider::stop_stream(uint64_t stream_id) {
   return ProviderResult::success();
 }
 
+ProviderResult SyntheticProvider::reconfigure_stream(uint64_t stream_id, const CaptureProfile& profile) {
+  if (!initialized_) {
+    return ProviderResult::failure(ProviderError::ERR_BAD_STATE);
+  }
+  if (shutting_down_) {
+    return ProviderResult::failure(ProviderError::ERR_SHUTTING_DOWN);
+  }
+  if (profile.width == 0 || profile.height == 0 || profile.format_fourcc == 0) {
+    return ProviderResult::failure(ProviderError::ERR_INVALID_ARGUMENT);
+  }
+  if (profile.format_fourcc != FOURCC_RGBA) {
+    // v1 synthetic only.
+    return ProviderResult::failure(ProviderError::ERR_NOT_SUPPORTED);
+  }
+  std::lock_guard<std::mutex> state_lock(provider_state_mutex_);
+  auto it = streams_.find(stream_id);
+  if (it == streams_.end() || !it->second.created) {
+    return ProviderResult::failure(ProviderError::ERR_BAD_STATE);
+  }
+  StreamState& s = it->second;
+  if (s.started && cfg_.producer_output_form_mode == SyntheticProducerOutputFormMode::GpuOnly &&
+      !stream_parent_context_backing_capabilities_locked_(
+           s.req.device_instance_id, s.req.intent, profile, s.picture)
+           .gpu_backed_available) {
+    return ProviderResult::failure(ProviderError::ERR_NOT_SUPPORTED);
+  }
+
+  // The pool, the renderer and the emission schedule carry over; only state
+  // sized for the old geometry is rebuilt, so the next due frame is already
+  // at the new profile.
+  s.req.profile = profile;
+  s.req.requested_retained_plan = stream_retained_plan_for_profile(s.req.requested_retained_plan, profile);
+  if (s.started) {
+    release_stream_live_gpu_backing_(s);
+    s.gpu_staging.resize(static_cast<size_t>(profile.width) * 4u * profile.height);
+  }
+  s.render_spec_valid = false;
+  return ProviderResult::success();
+}
+
 ProviderResult SyntheticProvider::update_stream_retained_production_plan(
     uint64_t stream_id,
     CoreRetainedProductionPlan requested_retained_plan) {
@@ -1576,6 +1696,78 @@ ProviderResult SyntheticProvider::release_capture_parent_priming(uint64_t device
   return ProviderResult::success();
 }
 
+uint64_t SyntheticProvider::trim_memory(MemoryTrimLevel level) noexcept try {
+  uint64_t released = local_cpu_payload_buffer_pool_.trim();
+  released += PatternBaseCache::shared().trim(level == MemoryTrimLevel::Critical ? 0u : 1u);
+
+  // Payloads are freed after the lock drops; a frame still in flight keeps its
+  // own reference and is not counted.
+  std::vector<std::shared_ptr<LoopedFrameSet>> dropped_sets;
+  std::vector<std::shared_ptr<CpuPayloadBytes>> dropped_zeros;
+  {
+    std::lock_guard<std::mutex> state_lock(provider_state_mutex_);
+    for (auto it = looped_frame_sets_.begin(); it != looped_frame_sets_.end();) {
+      if (it->use_count() != 1) {
+        ++it;
+        continue;
+      }
+      looped_frame_set_bytes_ -= (*it)->bytes;
+      for (const auto& frame : (*it)->frames) {
+        if (frame && frame.use_count() == 1) {
+          released += frame->size();
+        }
+      }
+      dropped_sets.push_back(std::move(*it));
+      it = looped_frame_sets_.erase(it);
+    }
+    if (level == MemoryTrimLevel::Critical) {
+      for (auto it = headless_zero_payloads_.begin(); it != headless_zero_payloads_.end();) {
+        if (it->second && it->second.use_count() != 1) {
+          ++it;
+          continue;
+        }
+        if (it->second) {
+          released += it->second->size();
+          dropped_zeros.push_back(std::move(it->second));
+        }
+        it = headless_zero_payloads_.erase(it);
+      }
+    }
+  }
+  return released;
+} catch (...) {
+  return 0;
+}
+
+void SyntheticProvider::set_stream_pool_depth_hint(uint64_t stream_id,
+                                                   const StreamPoolDepthHint& hint) noexcept try {
+  // Slots are only tokens for frames Core has not released yet: a retained
+  // result keeps its payload buffer, not the slot, so only the in-flight
+  // depth matters here.
+  std::lock_guard<std::mutex> state_lock(provider_state_mutex_);
+  auto it = streams_.find(stream_id);
+  if (it == streams_.end() || !it->second.created) {
+    return;
+  }
+  StreamState& s = it->second;
+  s.pool_depth_hint = hint.in_flight_frames;
+  // A running pool grows now; it shrinks back at the next start_stream().
+  if (!s.started) {
+    return;
+  }
+  while (s.pool.size() < s.pool_depth_hint) {
+    auto slot = std::make_shared<StreamState::BufferSlot>();
+    slot->stream_id = stream_id;
+    s.pool.emplace_back(std::move(slot));
+  }
+} catch (...) {
+}
+
+uint64_t SyntheticProvider::producer_frames_dropped_total() const noexcept {
+  // Frames skipped because the timeline fell behind its schedule.
+  return triage_catchup_frames_dropped_total_.load(std::memory_order_relaxed);
+}
+
 ProviderResult SyntheticProvider::trigger_capture(const CaptureRequest& req) {
   CaptureSubmission submission{};
   submission.capture_id = req.capture_id;
@@ -1680,6 +1872,12 @@ ProviderResult SyntheticProvider::validate_and_admit_capture_submission_locked_(
       set_failure_info("device_not_open_during_precheck", req.device_instance_id, device_state);
       return ProviderResult::failure(ProviderError::ERR_BAD_STATE);
     }
+    if (cfg_.max_in_flight_captures_per_device != 0 &&
+        in_flight_capture_count_locked_(req.device_instance_id) >=
+            cfg_.max_in_flight_captures_per_device) {
+      set_failure_info("device_capture_depth_exhausted", req.device_instance_id, &dev_it->second);
+      return ProviderResult::failure(ProviderError::ERR_BUSY);
+    }
 
     const uint32_t fmt = req.format_fourcc == 0 ? FOURCC_RGBA : req.format_fourcc;
     if (!(fmt == FOURCC_RGBA || fmt == FOURCC_BGRA)) {
@@ -1794,6 +1992,17 @@ ProviderResult SyntheticProvider::validate_and_admit_capture_submission_locked_(
   }
 
   try {
+    // Rig members start together when they can all run at once; a rig wider
+    // than the worker limit would only time out waiting for a worker.
+    if (job.origin == CaptureSubmissionOrigin::RIG_CAPTURE &&
+        job.device_jobs.size() > 1 &&
+        job.device_jobs.size() <= capture_worker_limit_) {
+      const auto barrier =
+          std::make_shared<CBCaptureStartBarrier>(job.device_jobs.size());
+      for (DeviceCaptureJob& device_job : job.device_jobs) {
+        device_job.start_barrier = barrier;
+      }
+    }
     for (const DeviceCaptureJob& device_job : job.device_jobs) {
       const InFlightCaptureKey key{
           device_job.request.capture_id,
@@ -1803,6 +2012,7 @@ ProviderResult SyntheticProvider::validate_and_admit_capture_submission_locked_(
       in_flight.device_instance_id = device_job.request.device_instance_id;
       in_flight.acquisition_session_id = device_job.acquisition_session_id;
       in_flight.generation = job.generation;
+      in_flight.admission_seq = ++next_capture_admission_seq_;
       const auto inserted = in_flight_captures_.emplace(key, in_flight);
       if (!inserted.second) {
         rollback_capture_submission_locked_(job);
@@ -1855,7 +2065,7 @@ void SyntheticProvider::rollback_capture_submission_locked_(
         release_native_acquisition_session_for_capture_(
             device_job.request.device_instance_id);
       } catch (...) {
-        std::fprintf(
+        async_log_printf(
             stderr,
             "[CamBANG][SyntheticProvider] exception while rolling back capture-session retain\n");
       }
@@ -1864,6 +2074,28 @@ void SyntheticProvider::rollback_capture_submission_locked_(
   }
 }
 
+size_t SyntheticProvider::in_flight_capture_count_locked_(
+    uint64_t device_instance_id) const noexcept {
+  size_t count = 0;
+  for (const auto& kv : in_flight_captures_) {
+    if (kv.second.device_instance_id == device_instance_id) {
+      ++count;
+    }
+  }
+  return count;
+}
+
+bool SyntheticProvider::has_earlier_in_flight_capture_locked_(
+    const InFlightCaptureDevice& in_flight) const noexcept {
+  for (const auto& kv : in_flight_captures_) {
+    if (kv.second.device_instance_id == in_flight.device_instance_id &&
+        kv.second.admission_seq < in_flight.admission_seq) {
+      return true;
+    }
+  }
+  return false;
+}
+
 bool SyntheticProvider::should_stop_capture_job_(uint64_t generation) const noexcept {
   std::lock_guard<std::mutex> capture_lock(capture_mutex_);
   return capture_admission_closed_ || generation != capture_generation_;
@@ -1898,6 +2130,138 @@ SyntheticProvider::dequeue_capture_work_locked_() noexcept {
   return item;
 }
 
+bool SyntheticProvider::capture_job_ready_locked_() const noexcept {
+#if defined(CAMBANG_INTERNAL_SMOKE) && CAMBANG_INTERNAL_SMOKE
+  if (capture_workers_paused_for_test_) {
+    return false;
+  }
+#endif
+  return capture_queue_count_ != 0;
+}
+
+bool SyntheticProvider::has_stealable_capture_member_locked_() const noexcept {
+  for (const CaptureMemberBatch* batch : capture_member_batches_) {
+    if (batch->next < batch->member_indices.size()) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void SyntheticProvider::prepare_capture_member_(const DeviceCaptureJob& job,
+                                                const CpuPayloadBytes& base_bytes,
+                                                size_t member_index,
+                                                CaptureMemberPrep& out) const noexcept {
+  const CaptureRequest& req = job.request;
+  const auto& member = req.still_image_bundle.members[member_index];
+  try {
+    const bool needs_exposure_adjustment =
+        member.intended_exposure_compensation_milli_ev != 0;
+    const bool needs_bgra_swizzle = job.format_fourcc == FOURCC_BGRA;
+    if (!needs_exposure_adjustment && !needs_bgra_swizzle) {
+      // Copy-construct from the immutable base render: one pass into
+      // uninitialized storage. The previous resize()-then-memcpy shape
+      // value-initialized (zero-filled) the whole multi-MB buffer first and
+      // then overwrote every byte, doubling memory traffic per plain bracket
+      // member on the capture-latency path.
+      const uint64_t member_copy_begin_ns = provider_monotonic_now_ns();
+      out.bytes = std::make_shared<CpuPayloadBytes>(base_bytes);
+      out.copy_ns = provider_monotonic_now_ns() - member_copy_begin_ns;
+      return;
+    }
+    const uint64_t member_alloc_begin_ns = provider_monotonic_now_ns();
+    out.bytes = std::make_shared<CpuPayloadBytes>();
+    out.bytes->resize(job.frame_size_bytes);
+    out.alloc_ns = provider_monotonic_now_ns() - member_alloc_begin_ns;
+    // Synthetic still generation can fold exposure-variant synthesis and
+    // optional FourCC mapping into one pass because this provider owns the
+    // source pixels. That is an implementation detail of SyntheticProvider,
+    // not a rule that platform-backed providers must synthesize frames the
+    // same way.
+    const uint64_t member_adjust_begin_ns = provider_monotonic_now_ns();
+    copy_rgba8_with_optional_adjustments(
+        out.bytes->data(),
+        job.stride_bytes,
+        base_bytes.data(),
+        job.stride_bytes,
+        req.width,
+        req.height,
+        needs_bgra_swizzle,
+        member.intended_exposure_compensation_milli_ev);
+    out.ev_bgra_ns = provider_monotonic_now_ns() - member_adjust_begin_ns;
+  } catch (...) {
+    out.bytes.reset();
+    out.error = std::current_exception();
+  }
+}
+
+void SyntheticProvider::run_claimed_capture_member_locked_(std::unique_lock<std::mutex>& capture_lock,
+                                                           CaptureMemberBatch& batch) noexcept {
+  const size_t member_index = batch.member_indices[batch.next++];
+  ++batch.in_progress;
+  capture_lock.unlock();
+  // Only the claimer writes this entry; the owner reads it after `done` is set
+  // under capture_mutex_.
+  prepare_capture_member_(*batch.job, *batch.base_bytes, member_index, batch.out[member_index]);
+  capture_lock.lock();
+  batch.out[member_index].done = true;
+  --batch.in_progress;
+  capture_cv_.notify_all();
+}
+
+bool SyntheticProvider::steal_capture_member_locked_(std::unique_lock<std::mutex>& capture_lock) noexcept {
+  for (CaptureMemberBatch* batch : capture_member_batches_) {
+    if (batch->next < batch->member_indices.size()) {
+      // The owner's close waits out in_progress, so *batch outlives the
+      // unlocked preparation even if it leaves the registry meanwhile.
+      run_claimed_capture_member_locked_(capture_lock, *batch);
+      return true;
+    }
+  }
+  return false;
+}
+
+void SyntheticProvider::open_capture_member_batch_(CaptureMemberBatch& batch) noexcept {
+  if (batch.member_indices.size() < 2) {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> capture_lock(capture_mutex_);
+    // Reserved at executor start; when every slot is taken the owner simply
+    // prepares its members alone.
+    if (capture_member_batches_.size() >= capture_member_batches_.capacity()) {
+      return;
+    }
+    capture_member_batches_.push_back(&batch);
+    batch.open = true;
+  }
+  capture_cv_.notify_all();
+}
+
+SyntheticProvider::CaptureMemberPrep&
+SyntheticProvider::await_capture_member_(CaptureMemberBatch& batch, size_t member_index) noexcept {
+  std::unique_lock<std::mutex> capture_lock(capture_mutex_);
+  while (!batch.out[member_index].done) {
+    if (batch.next < batch.member_indices.size()) {
+      run_claimed_capture_member_locked_(capture_lock, batch);
+    } else {
+      capture_cv_.wait(capture_lock);
+    }
+  }
+  return batch.out[member_index];
+}
+
+void SyntheticProvider::close_capture_member_batch_(CaptureMemberBatch& batch) noexcept {
+  std::unique_lock<std::mutex> capture_lock(capture_mutex_);
+  batch.next = batch.member_indices.size();
+  if (batch.open) {
+    capture_member_batches_.erase(
+        std::find(capture_member_batches_.begin(), capture_member_batches_.end(), &batch));
+    batch.open = false;
+  }
+  capture_cv_.wait(capture_lock, [&]() { return batch.in_progress == 0; });
+}
+
 bool SyntheticProvider::start_capture_executor_() noexcept {
   std::vector<std::thread> workers;
   try {
@@ -1912,6 +2276,10 @@ bool SyntheticProvider::start_capture_executor_() noexcept {
       capture_queue_head_ = 0;
       capture_queue_tail_ = 0;
       ++capture_generation_;
+      capture_worker_limit_ = std::clamp<size_t>(
+          std::thread::hardware_concurrency(), kCaptureWorkerCount, kMaxCaptureWorkerCount);
+      capture_member_batches_.clear();
+      capture_member_batches_.reserve(capture_worker_limit_);
 #if defined(CAMBANG_INTERNAL_SMOKE) && CAMBANG_INTERNAL_SMOKE
       capture_workers_paused_for_test_ = false;
       capture_jobs_paused_after_dequeue_for_test_ = false;
@@ -1924,8 +2292,8 @@ bool SyntheticProvider::start_capture_executor_() noexcept {
 #endif
     }
 
-    workers.reserve(kCaptureWorkerCount);
-    for (size_t i = 0; i < kCaptureWorkerCount; ++i) {
+    workers.reserve(capture_worker_limit_);
+    for (size_t i = 0; i < capture_worker_limit_; ++i) {
       workers.emplace_back([this]() { capture_worker_main_(); });
     }
 
@@ -1952,6 +2320,7 @@ bool SyntheticProvider::start_capture_executor_() noexcept {
 }
 
 void SyntheticProvider::capture_worker_main_() noexcept {
+  apply_current_thread_policy(CBThreadRole::CaptureWorker, "cambang-synth-cap");
   while (true) {
     CaptureWorkItem item{};
 #if defined(CAMBANG_INTERNAL_SMOKE) && CAMBANG_INTERNAL_SMOKE
@@ -1960,23 +2329,18 @@ void SyntheticProvider::capture_worker_main_() noexcept {
     {
       std::unique_lock<std::mutex> capture_lock(capture_mutex_);
       capture_cv_.wait(capture_lock, [&]() {
-        return capture_executor_stop_requested_ ||
-#if defined(CAMBANG_INTERNAL_SMOKE) && CAMBANG_INTERNAL_SMOKE
-               (!capture_workers_paused_for_test_ &&
-                capture_queue_count_ != 0);
-#else
-               capture_queue_count_ != 0;
-#endif
+        return capture_executor_stop_requested_ || capture_job_ready_locked_() ||
+               has_stealable_capture_member_locked_();
       });
       if (capture_executor_stop_requested_ && capture_queue_count_ == 0) {
         return;
       }
-#if defined(CAMBANG_INTERNAL_SMOKE) && CAMBANG_INTERNAL_SMOKE
-      if (capture_workers_paused_for_test_ &&
-          !capture_executor_stop_requested_) {
+      if (!capture_job_ready_locked_()) {
+        // No device job to take (or dequeue paused for test): help a running
+        // job with its bundle members instead.
+        (void)steal_capture_member_locked_(capture_lock);
         continue;
       }
-#endif
       item = dequeue_capture_work_locked_();
       ++capture_active_jobs_;
 #if defined(CAMBANG_INTERNAL_SMOKE) && CAMBANG_INTERNAL_SMOKE
@@ -2003,7 +2367,7 @@ void SyntheticProvider::capture_worker_main_() noexcept {
 #endif
       run_device_capture_job_(item.job, item.generation);
     } catch (const std::exception& e) {
-      std::fprintf(
+      async_log_printf(
           stderr,
           "[CamBANG][SyntheticProvider] capture worker exception: %s\n",
           e.what());
@@ -2014,12 +2378,12 @@ void SyntheticProvider::capture_worker_main_() noexcept {
             CaptureTerminalKind::Failed,
             ProviderError::ERR_PROVIDER_FAILED);
       } catch (...) {
-        std::fprintf(
+        async_log_printf(
             stderr,
             "[CamBANG][SyntheticProvider] exception while terminalizing failed capture worker job\n");
       }
     } catch (...) {
-      std::fprintf(
+      async_log_printf(
           stderr,
           "[CamBANG][SyntheticProvider] non-standard capture worker exception\n");
       try {
@@ -2029,7 +2393,7 @@ void SyntheticProvider::capture_worker_main_() noexcept {
             CaptureTerminalKind::Failed,
             ProviderError::ERR_PROVIDER_FAILED);
       } catch (...) {
-        std::fprintf(
+        async_log_printf(
             stderr,
             "[CamBANG][SyntheticProvider] exception while terminalizing failed capture worker job\n");
       }
@@ -2051,7 +2415,7 @@ void SyntheticProvider::run_device_capture_job_(const DeviceCaptureJob& job, uin
     return;
   }
 
-  std::shared_ptr<std::vector<std::uint8_t>> deferred_cpu_staging_bytes{};
+  std::shared_ptr<CpuPayloadBytes> deferred_cpu_staging_bytes{};
   try {
     const bool ok = generate_device_capture_payloads_(
         job, generation, &deferred_cpu_staging_bytes);
@@ -2080,7 +2444,7 @@ void SyntheticProvider::run_device_capture_job_(const DeviceCaptureJob& job, uin
 bool SyntheticProvider::generate_device_capture_payloads_(
     const DeviceCaptureJob& job,
     uint64_t generation,
-    std::shared_ptr<std::vector<std::uint8_t>>* deferred_cpu_staging_bytes) {
+    std::shared_ptr<CpuPayloadBytes>* deferred_cpu_staging_bytes) {
   uint64_t staging_alloc_ns = 0;
   uint64_t before_first_member_ns = 0;
   uint64_t member_iteration_gap_ns = 0;
@@ -2094,12 +2458,22 @@ bool SyntheticProvider::generate_device_capture_payloads_(
   uint64_t member_frame_assembly_ns = 0;
   uint64_t member_post_ns = 0;
   const CaptureRequest& req = job.request;
+  // A member leaving before it reaches the start barrier releases its
+  // siblings instead of holding them to the timeout.
+  struct StartBarrierDropGuard {
+    CBCaptureStartBarrier* barrier = nullptr;
+    ~StartBarrierDropGuard() {
+      if (barrier) {
+        barrier->drop();
+      }
+    }
+  } start_barrier_guard{job.start_barrier.get()};
   if (should_stop_capture_job_(generation)) {
     return false;
   }
 
   const uint64_t staging_begin_ns = provider_monotonic_now_ns();
-  auto base_bytes = std::make_shared<std::vector<std::uint8_t>>();
+  auto base_bytes = std::make_shared<CpuPayloadBytes>();
   base_bytes->resize(job.frame_size_bytes);
   staging_alloc_ns = provider_monotonic_now_ns() - staging_begin_ns;
 
@@ -2129,6 +2503,9 @@ bool SyntheticProvider::generate_device_capture_payloads_(
   ov.stream_id = 0;
 
   CpuPackedPatternRenderer renderer{};
+  renderer.set_band_pool(&pattern_band_pool_);
+  // Repeat captures of one picture at one size reuse the rendered base.
+  renderer.set_base_cache(&PatternBaseCache::shared());
   const uint64_t base_render_begin_ns = provider_monotonic_now_ns();
   renderer.render_into(spec, dst, ov);
   base_render_ns = provider_monotonic_now_ns() - base_render_begin_ns;
@@ -2148,6 +2525,11 @@ bool SyntheticProvider::generate_device_capture_payloads_(
         &triage_capture_ready_stage_gpu_primary_with_cpu_sidecar_;
   }
 
+  if (start_barrier_guard.barrier) {
+    start_barrier_guard.barrier = nullptr;
+    (void)job.start_barrier->arrive_and_wait(
+        std::chrono::nanoseconds(kRigCaptureStartBarrierTimeoutNs));
+  }
   const uint64_t provider_post_capture_started_steady_ns =
       provider_monotonic_now_ns();
   strand_.post_capture_started(req.capture_id, req.device_instance_id);
@@ -2176,6 +2558,29 @@ bool SyntheticProvider::generate_device_capture_payloads_(
         base_render_ns;
   }
   const auto& members = req.still_image_bundle.members;
+  const auto can_reuse_base_for_member = [&](size_t i) {
+    return i == 0 &&
+           members[i].intended_exposure_compensation_milli_ev == 0 &&
+           job.format_fourcc == FOURCC_RGBA;
+  };
+  // Members that need pixels of their own are prepared through a batch that
+  // idle capture workers can steal from; this worker still posts every member
+  // itself, in order, as soon as that member is ready.
+  CaptureMemberBatch member_batch{};
+  member_batch.job = &job;
+  member_batch.base_bytes = base_bytes.get();
+  member_batch.out.resize(members.size());
+  for (size_t i = 0; i < members.size(); ++i) {
+    if (!can_reuse_base_for_member(i)) {
+      member_batch.member_indices.push_back(i);
+    }
+  }
+  open_capture_member_batch_(member_batch);
+  struct MemberBatchCloser {
+    SyntheticProvider* provider;
+    CaptureMemberBatch* batch;
+    ~MemberBatchCloser() { provider->close_capture_member_batch_(*batch); }
+  } member_batch_closer{this, &member_batch};
   uint64_t last_member_post_end_ns = provider_post_capture_started_steady_ns;
   for (size_t i = 0; i < members.size(); ++i) {
     const uint64_t member_span_begin_ns = provider_monotonic_now_ns();
@@ -2188,62 +2593,25 @@ bool SyntheticProvider::generate_device_capture_payloads_(
     if (should_stop_capture_job_(generation)) {
       return false;
     }
-    uint64_t member_cpu_prep_ns = 0;
+    uint64_t member_prep_wait_ns = 0;
     uint64_t member_gpu_retain_ns = 0;
     uint64_t member_frame_assembly_sample_ns = 0;
     uint64_t member_post_sample_ns = 0;
     const auto& member = members[i];
-    const bool can_reuse_base_for_default =
-        i == 0 &&
-        member.intended_exposure_compensation_milli_ev == 0 &&
-        job.format_fourcc == FOURCC_RGBA;
-    std::shared_ptr<std::vector<std::uint8_t>> bytes;
-    if (can_reuse_base_for_default) {
+    std::shared_ptr<CpuPayloadBytes> bytes;
+    if (can_reuse_base_for_member(i)) {
       bytes = base_bytes;
     } else {
-      const bool needs_exposure_adjustment =
-          member.intended_exposure_compensation_milli_ev != 0;
-      const bool needs_bgra_swizzle = job.format_fourcc == FOURCC_BGRA;
-      if (!needs_exposure_adjustment && !needs_bgra_swizzle) {
-        // Copy-construct from the immutable base render: one pass into
-        // uninitialized storage. The previous resize()-then-memcpy shape
-        // value-initialized (zero-filled) the whole multi-MB buffer first and
-        // then overwrote every byte, doubling memory traffic per plain bracket
-        // member on the capture-latency path.
-        const uint64_t member_copy_begin_ns = provider_monotonic_now_ns();
-        bytes = std::make_shared<std::vector<std::uint8_t>>(*base_bytes);
-        const uint64_t member_copy_sample_ns =
-            provider_monotonic_now_ns() - member_copy_begin_ns;
-        member_copy_ns += member_copy_sample_ns;
-        member_cpu_prep_ns += member_copy_sample_ns;
-      } else {
-        const uint64_t member_alloc_begin_ns = provider_monotonic_now_ns();
-        bytes = std::make_shared<std::vector<std::uint8_t>>();
-        bytes->resize(job.frame_size_bytes);
-        const uint64_t member_alloc_sample_ns =
-            provider_monotonic_now_ns() - member_alloc_begin_ns;
-        member_alloc_ns += member_alloc_sample_ns;
-        member_cpu_prep_ns += member_alloc_sample_ns;
-        // Synthetic still generation can fold exposure-variant synthesis and
-        // optional FourCC mapping into one pass because this provider owns the
-        // source pixels. That is an implementation detail of SyntheticProvider,
-        // not a rule that platform-backed providers must synthesize frames the
-        // same way.
-        const uint64_t member_adjust_begin_ns = provider_monotonic_now_ns();
-        copy_rgba8_with_optional_adjustments(
-            bytes->data(),
-            job.stride_bytes,
-            base_bytes->data(),
-            job.stride_bytes,
-            req.width,
-            req.height,
-            needs_bgra_swizzle,
-            member.intended_exposure_compensation_milli_ev);
-        const uint64_t member_adjust_sample_ns =
-            provider_monotonic_now_ns() - member_adjust_begin_ns;
-        member_ev_bgra_ns += member_adjust_sample_ns;
-        member_cpu_prep_ns += member_adjust_sample_ns;
+      const uint64_t member_prep_wait_begin_ns = provider_monotonic_now_ns();
+      CaptureMemberPrep& prep = await_capture_member_(member_batch, i);
+      member_prep_wait_ns = provider_monotonic_now_ns() - member_prep_wait_begin_ns;
+      if (prep.error) {
+        std::rethrow_exception(prep.error);
       }
+      bytes = std::move(prep.bytes);
+      member_alloc_ns += prep.alloc_ns;
+      member_copy_ns += prep.copy_ns;
+      member_ev_bgra_ns += prep.ev_bgra_ns;
     }
 
     FrameView fv{};
@@ -2380,8 +2748,10 @@ bool SyntheticProvider::generate_device_capture_payloads_(
     last_member_post_end_ns = member_post_end_ns;
     const uint64_t member_span_total_ns =
         member_post_end_ns - member_span_begin_ns;
+    // Preparation may have run on another worker, so the span counts the
+    // wait for it rather than its CPU time.
     const uint64_t member_measured_total_ns =
-        member_cpu_prep_ns + member_gpu_retain_ns +
+        member_prep_wait_ns + member_gpu_retain_ns +
         member_frame_assembly_sample_ns + member_post_sample_ns;
     if (member_span_total_ns >= member_measured_total_ns) {
       member_iteration_gap_ns +=
@@ -2484,7 +2854,7 @@ void SyntheticProvider::finish_device_capture_job_(const DeviceCaptureJob& job,
                                                    uint64_t generation,
                                                    CaptureTerminalKind terminal,
                                                    ProviderError error,
-                                                   std::shared_ptr<std::vector<std::uint8_t>>
+                                                   std::shared_ptr<CpuPayloadBytes>
                                                        deferred_cpu_staging_bytes) {
   const uint64_t finish_begin_ns = provider_monotonic_now_ns();
   uint64_t terminal_post_ns = 0;
@@ -2509,14 +2879,21 @@ void SyntheticProvider::finish_device_capture_job_(const DeviceCaptureJob& job,
   }
   {
     capture_lock_wait_begin_ns = provider_monotonic_now_ns();
-    std::lock_guard<std::mutex> capture_lock(capture_mutex_);
-    capture_lock_acquired_ns = provider_monotonic_now_ns();
+    std::unique_lock<std::mutex> capture_lock(capture_mutex_);
     const InFlightCaptureKey key{job.request.capture_id, job.request.device_instance_id};
     auto it = in_flight_captures_.find(key);
     if (it == in_flight_captures_.end()) {
       return;
     }
     InFlightCaptureDevice& in_flight = it->second;
+    // Pipelined captures on one device complete in admission order. An
+    // earlier capture was dequeued first, so it is already running (or
+    // failing through shutdown) and its entry leaves only after its own
+    // terminal fact has posted.
+    capture_cv_.wait(capture_lock, [&]() {
+      return !has_earlier_in_flight_capture_locked_(in_flight);
+    });
+    capture_lock_acquired_ns = provider_monotonic_now_ns();
     if (in_flight.generation != generation) {
       terminal = CaptureTerminalKind::Failed;
       error = ProviderError::ERR_SHUTTING_DOWN;
@@ -2542,7 +2919,6 @@ void SyntheticProvider::finish_device_capture_job_(const DeviceCaptureJob& job,
       }
       state_lock_released_ns = provider_monotonic_now_ns();
     }
-    in_flight_captures_.erase(it);
   }
 
   if (should_post_terminal) {
@@ -2777,6 +3153,12 @@ void SyntheticProvider::finish_device_capture_job_(const DeviceCaptureJob& job,
       terminal_post_exception = std::current_exception();
     }
   }
+  {
+    std::lock_guard<std::mutex> capture_lock(capture_mutex_);
+    in_flight_captures_.erase(InFlightCaptureKey{
+        job.request.capture_id, job.request.device_instance_id});
+  }
+  capture_cv_.notify_all();
   if (should_release) {
     std::lock_guard<std::mutex> state_lock(provider_state_mutex_);
     release_native_acquisition_session_for_capture_(job.request.device_instance_id);
@@ -2860,14 +3242,14 @@ void SyntheticProvider::stop_and_join_capture_executor_() noexcept {
     }
   }
 
-  // Every queued item is drained by the fixed workers after the generation is
+  // Every queued item is drained by the workers after the generation is
   // closed. Active items observe the same generation change at their next
   // cancellation checkpoint. Joining above therefore owns the complete
   // worker lifetime and leaves no job that can callback into a later restart.
   std::lock_guard<std::mutex> capture_lock(capture_mutex_);
   if (capture_queue_count_ != 0 || capture_active_jobs_ != 0 ||
       !in_flight_captures_.empty()) {
-    std::fprintf(
+    async_log_printf(
         stderr,
         "[CamBANG][SyntheticProvider] capture executor failed to reach quiescence queue=%zu active=%zu in_flight=%zu\n",
         capture_queue_count_,
@@ -2917,7 +3299,7 @@ SyntheticProvider::capture_executor_snapshot_for_test() const {
   std::lock_guard<std::mutex> state_lock(provider_state_mutex_);
   CaptureExecutorSnapshotForTest snapshot{};
   snapshot.worker_count = capture_workers_.size();
-  snapshot.worker_limit = kCaptureWorkerCount;
+  snapshot.worker_limit = capture_worker_limit_;
   snapshot.queued_jobs = capture_queue_count_;
   snapshot.queue_capacity = kCaptureQueueCapacity;
   snapshot.active_jobs = capture_active_jobs_;
@@ -2945,6 +3327,39 @@ bool SyntheticProvider::is_stream_capture_paused_locked_(const StreamState& s) c
   return it != capture_pause_depth_by_device_.end() && it->second > 0;
 }
 
+// Core backpressure: a repeating frame Core reports it would drop or coalesce
+// away is not rendered. Virtual-time runs keep their exact emission sequence.
+bool SyntheticProvider::should_skip_congested_frame_(const StreamState& s) {
+  if (cfg_.timing_driver == TimingDriver::VirtualTime || !callbacks_ ||
+      !callbacks_->is_stream_ingress_congested(s.req.stream_id)) {
+    return false;
+  }
+  ++triage_congested_frames_skipped_total_;
+  return true;
+}
+
+bool SyntheticProvider::should_skip_undemanded_frame_(StreamState& s) {
+  const uint32_t idle_limit = cfg_.nominal.idle_demand_frames_before_throttle;
+  if (idle_limit == 0 || !callbacks_) {
+    return false;
+  }
+  if (callbacks_->is_stream_display_demand_active(s.req.stream_id)) {
+    s.demand_idle_frames = 0;
+    s.demand_throttled_due_points = 0;
+    return false;
+  }
+  if (s.demand_idle_frames < idle_limit) {
+    ++s.demand_idle_frames;
+    return false;
+  }
+  const uint32_t divisor = std::max<uint32_t>(1, cfg_.nominal.idle_demand_frame_divisor);
+  if (s.demand_throttled_due_points++ % divisor == divisor - 1) {
+    return false;
+  }
+  ++triage_demand_governed_frames_skipped_total_;
+  return true;
+}
+
 uint64_t SyntheticProvider::snap_repeating_due_after_(uint64_t due_ns, uint64_t now_ns, uint64_t period_ns) noexcept {
   if (period_ns == 0 || due_ns > now_ns) {
     return due_ns;
@@ -3214,7 +3629,7 @@ ProviderResult SyntheticProvider::start_timeline_scenario_for_host() {
     std::vector<SyntheticStagedRigTopology> staged_rigs;
     if (!materialize_staged_canonical_scenario_(timeline_scenario_, staged_rigs, error)) {
       if (!error.empty()) {
-        std::fprintf(stderr, "[Synthetic] canonical scenario materialization failed: %s\n", error.c_str());
+        async_log_printf(stderr, "[Synthetic] canonical scenario materialization failed: %s\n", error.c_str());
       }
       return ProviderResult::failure(ProviderError::ERR_INVALID_ARGUMENT);
     }
@@ -3224,9 +3639,7 @@ ProviderResult SyntheticProvider::start_timeline_scenario_for_host() {
   // and marking the timeline running/unpaused. It intentionally does not advance
   // or pump synthetic time; the host stepper is responsible for executing due
   // events via advance(dt_ns), including a meaningful dt=0 current-time pump.
-  for (const auto& ev : timeline_scenario_.events) {
-    timeline_schedule_(ev);
-  }
+  timeline_arm_scenario_();
   timeline_running_ = true;
   timeline_paused_ = false;
   return ProviderResult::success();
@@ -3306,6 +3719,7 @@ ProviderResult SyntheticProvider::shutdown() {
     return ProviderResult::failure(ProviderError::ERR_BAD_STATE);
   }
   shutting_down_ = true;
+  stop_realtime_pacer_();
 
   // Close capture admission and wait for accepted capture production to post a
   // terminal fact and release its retained acquisition-session references before
@@ -3355,6 +3769,7 @@ ProviderResult SyntheticProvider::shutdown() {
 
   strand_.flush();
   strand_.stop();
+  pattern_band_pool_.stop();
 
   initialized_ = false;
   callbacks_ = nullptr;
@@ -3366,6 +3781,51 @@ ProviderResult SyntheticProvider::shutdown() {
   return ProviderResult::success();
 }
 
+void SyntheticProvider::start_realtime_pacer_() noexcept {
+  realtime_pacer_stop_.store(false, std::memory_order_release);
+  try {
+    realtime_pacer_ = std::thread([this]() { realtime_pacer_main_(); });
+  } catch (...) {
+    async_log_printf(
+        stderr,
+        "[CamBANG][SyntheticProvider] real-time pacer did not start; host ticks pace frames\n");
+  }
+}
+
+void SyntheticProvider::stop_realtime_pacer_() noexcept {
+  realtime_pacer_stop_.store(true, std::memory_order_release);
+  if (realtime_pacer_.joinable()) {
+    realtime_pacer_.join();
+  }
+}
+
+void SyntheticProvider::realtime_pacer_main_() noexcept {
+  apply_current_thread_policy(CBThreadRole::ProviderCallbacks, "cambang-synth-pace");
+  CBPreciseWaiter waiter;
+  while (!realtime_pacer_stop_.load(std::memory_order_acquire)) {
+    uint64_t deadline_ns = provider_monotonic_now_ns() + kRealtimePacerIdleNs;
+    {
+      std::lock_guard<std::mutex> state_lock(provider_state_mutex_);
+      if (const std::optional<uint64_t> due = next_due_ns_locked_()) {
+        deadline_ns = std::min(deadline_ns, realtime_origin_ns_ + *due);
+      }
+    }
+    waiter.wait_until(deadline_ns);
+    if (realtime_pacer_stop_.load(std::memory_order_acquire)) {
+      break;
+    }
+    try {
+      // Same path as the free-running host tick: frames reach Core through
+      // the strand worker, never by draining it here.
+      advance(0, /*allow_paused_timeline_step=*/false, /*flush_strand=*/false);
+    } catch (...) {
+      async_log_printf(
+          stderr,
+          "[CamBANG][SyntheticProvider] exception in real-time pacer advance\n");
+    }
+  }
+}
+
 void SyntheticProvider::release_frame_(void* user, const FrameView* frame) {
   (void)frame;
   auto* lease = static_cast<FrameReleaseLease*>(user);
@@ -3373,11 +3833,32 @@ void SyntheticProvider::release_frame_(void* user, const FrameView* frame) {
     return;
   }
   if (lease->slot) {
+    // The payload buffer stays alive through any retained cpu_payload_owner
+    // and recycles once that is dropped too.
+    lease->slot->bytes.reset();
     lease->slot->in_use.store(false, std::memory_order_release);
   }
   delete lease;
 }
 
+void SyntheticProvider::start_pattern_band_pool_() noexcept {
+  // Bands of 64 rows keep a 1080p frame at 17 bands, enough to balance
+  // across a handful of workers; smaller frames render faster inline than
+  // the hand-off costs.
+  constexpr uint32_t kBandRows = 64;
+  constexpr uint64_t kMinPixels = 1280ull * 720ull;
+  constexpr uint32_t kMaxAutoWorkers = 4;
+  uint32_t workers = cfg_.pattern_band_workers;
+  if (workers == SyntheticProviderConfig::kAutoPatternBandWorkers) {
+    // The calling thread renders bands too, so leave it a core.
+    const uint32_t hw = std::thread::hardware_concurrency();
+    workers = hw > 2 ? std::min(kMaxAutoWorkers, hw / 2) : 0;
+  }
+  if (workers != 0) {
+    (void)pattern_band_pool_.start(workers, kBandRows, kMinPixels);
+  }
+}
+
 bool SyntheticProvider::ensure_stream_live_gpu_backing_(
     StreamState& s,
     uint32_t width,
@@ -3421,6 +3902,8 @@ bool SyntheticProvider::ensure_stream_live_gpu_backing_(
   s.live_gpu_width = width;
   s.live_gpu_height = height;
   s.live_gpu_stride_bytes = stride;
+  s.live_gpu_pending_dirty = PatternDirtyRect{};
+  s.live_gpu_pending_dirty_whole_frame = true;
   return true;
 }
 
@@ -3483,6 +3966,14 @@ void SyntheticProvider::emit_one_frame_(StreamState& s, uint64_t scheduled_captu
     return;
   }
 
+  if (cfg_.frame_content_mode == SyntheticFrameContentMode::Headless) {
+    emit_headless_frame_(s, std::move(slot), scheduled_capture_ns);
+    const uint64_t emit_ns = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - emit_t0).count());
+    record_timing_sample(emit_ns, triage_emit_frame_calls_, triage_emit_frame_total_ns_, triage_emit_frame_max_ns_);
+    return;
+  }
+
   if (!s.render_spec_valid) {
     bool preset_valid = true;
     const auto spec_t0 = std::chrono::steady_clock::now();
@@ -3500,13 +3991,51 @@ void SyntheticProvider::emit_one_frame_(StreamState& s, uint64_t scheduled_captu
   }
   const PatternSpec& spec = s.render_spec;
 
-  const auto target_t0 = std::chrono::steady_clock::now();
   const bool publish_cpu_payload =
       s.resolved_output_form_mode != SyntheticProducerOutputFormMode::GpuOnly;
   const bool render_direct_to_cpu_slot = publish_cpu_payload && !s.prefer_gpu_backing;
+  if (cfg_.frame_content_mode == SyntheticFrameContentMode::Looped && render_direct_to_cpu_slot &&
+      emit_looped_frame_(s, slot, scheduled_capture_ns)) {
+    const uint64_t emit_ns = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - emit_t0).count());
+    record_timing_sample(emit_ns, triage_emit_frame_calls_, triage_emit_frame_total_ns_, triage_emit_frame_max_ns_);
+    return;
+  }
+
+  // A reduced sidecar is box-downscaled from gpu_staging into a smaller slot
+  // buffer, so the CPU copy per frame shrinks by downscale^2.
+  PackedTransform sidecar_transform{};
+  PackedTransformGeometry sidecar_geometry{};
+  const bool reduced_sidecar =
+      publish_cpu_payload && !render_direct_to_cpu_slot && s.req.requested_retained_plan.reduced_cpu_sidecar();
+  if (reduced_sidecar) {
+    sidecar_transform.downscale = s.req.requested_retained_plan.cpu_sidecar_downscale;
+    if (!resolve_packed_transform(sidecar_transform, w, h, sidecar_geometry)) {
+      slot->in_use.store(false, std::memory_order_release);
+      return;
+    }
+  }
+  const uint32_t payload_w = reduced_sidecar ? sidecar_geometry.width : w;
+  const uint32_t payload_h = reduced_sidecar ? sidecar_geometry.height : h;
+  const uint32_t payload_stride = reduced_sidecar ? payload_w * 4u : stride;
+
+  const auto target_t0 = std::chrono::steady_clock::now();
+  if (publish_cpu_payload) {
+    CpuPayloadBufferKey payload_key{};
+    payload_key.width = payload_w;
+    payload_key.height = payload_h;
+    payload_key.stride_bytes = payload_stride;
+    payload_key.format_fourcc = FOURCC_RGBA;
+    payload_key.size_bytes = static_cast<size_t>(payload_stride) * static_cast<size_t>(payload_h);
+    slot->bytes = acquire_cpu_payload_buffer_(payload_key);
+    if (!slot->bytes) {
+      slot->in_use.store(false, std::memory_order_release);
+      return;
+    }
+  }
   PatternRenderTarget dst{};
-  dst.data = render_direct_to_cpu_slot ? static_cast<void*>(slot->bytes.data()) : static_cast<void*>(s.gpu_staging.data());
-  dst.size_bytes = render_direct_to_cpu_slot ? slot->bytes.size() : s.gpu_staging.size();
+  dst.data = render_direct_to_cpu_slot ? static_cast<void*>(slot->bytes->data()) : static_cast<void*>(s.gpu_staging.data());
+  dst.size_bytes = render_direct_to_cpu_slot ? slot->bytes->size() : s.gpu_staging.size();
   dst.width = w;
   dst.height = h;
   dst.stride_bytes = stride;
@@ -3522,12 +4051,31 @@ void SyntheticProvider::emit_one_frame_(StreamState& s, uint64_t scheduled_captu
   ov.timestamp_ns = scheduled_capture_ns;
   ov.stream_id = s.req.stream_id;
 
-  const auto render_t0 = std::chrono::steady_clock::now();
-  s.renderer.render_into(spec, dst, ov);
-  const auto render_t1 = std::chrono::steady_clock::now();
-  const uint64_t render_ns = static_cast<uint64_t>(
-      std::chrono::duration_cast<std::chrono::nanoseconds>(render_t1 - render_t0).count());
-  record_timing_sample(render_ns, triage_frame_render_calls_, triage_frame_render_total_ns_, triage_frame_render_max_ns_);
+  const uint64_t frame_trace_id = frame_latency_trace_begin(s.req.stream_id);
+  const auto render_on_cpu = [&] {
+    const auto render_t0 = std::chrono::steady_clock::now();
+    s.renderer.render_into(spec, dst, ov);
+    const auto render_t1 = std::chrono::steady_clock::now();
+    const uint64_t render_ns = static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(render_t1 - render_t0).count());
+    record_timing_sample(render_ns, triage_frame_render_calls_, triage_frame_render_total_ns_, triage_frame_render_max_ns_);
+    if (s.prefer_gpu_backing) {
+      s.live_gpu_pending_dirty = s.live_gpu_pending_dirty.united(s.renderer.last_dirty_rect());
+      if (s.live_gpu_pending_dirty.covers(w, h)) {
+        s.live_gpu_pending_dirty_whole_frame = true;
+      }
+    }
+  };
+  // A GPU-only stream whose frames are a cached base plus overlays lets the
+  // live backing generate them: no CPU render and no frame upload. gpu_staging
+  // and the renderer then lag the texture, so the next CPU-rendered frame is
+  // uploaded whole.
+  bool generate_on_gpu =
+      s.resolved_output_form_mode == SyntheticProducerOutputFormMode::GpuOnly && !spec.dynamic_base &&
+      synthetic_gpu_backing_can_generate_stream_live_pattern_rgba8();
+  if (!generate_on_gpu) {
+    render_on_cpu();
+  }
   bool gpu_ok = false;
   std::shared_ptr<void> gpu_backing;
   if (s.prefer_gpu_backing) {
@@ -3553,7 +4101,8 @@ void SyntheticProvider::emit_one_frame_(StreamState& s, uint64_t scheduled_captu
       if (display_demand_trace_enabled_) {
         const bool prev_active = display_demand_last_active_by_stream_[s.req.stream_id];
         if (prev_active != display_demand_active) {
-          std::printf(
+          async_log_printf(
+              stdout,
               "[CamBANG][DemandTrace] provider_demand_transition stream_id=%llu active=%d policy=%s\n",
               static_cast<unsigned long long>(s.req.stream_id),
               display_demand_active ? 1 : 0,
@@ -3569,12 +4118,44 @@ void SyntheticProvider::emit_one_frame_(StreamState& s, uint64_t scheduled_captu
         ++triage_gpu_update_attempts_total_;
         ++triage_gpu_update_total_calls_;
         const auto update_total_t0 = std::chrono::steady_clock::now();
-        gpu_ok = synthetic_gpu_backing_update_stream_live_gpu_backing_rgba8(
-            s.live_gpu_backing,
-            s.gpu_staging.data(),
-            w,
-            h,
-            stride);
+        if (generate_on_gpu) {
+          std::shared_ptr<const PatternBaseFrame> base = s.renderer.base_frame(spec);
+          if (base && base != s.gpu_pattern_base) {
+            s.gpu_pattern_base = std::move(base);
+            ++s.gpu_pattern_base_revision;
+          }
+          SyntheticGpuPatternFrame frame{};
+          frame.base = s.gpu_pattern_base ? s.gpu_pattern_base->pixels.data() : nullptr;
+          frame.base_revision = s.gpu_pattern_base_revision;
+          frame.frame_index = ov.frame_index;
+          frame.overlay_frame_index_offsets = spec.overlay_frame_index_offsets;
+          frame.overlay_moving_bar = spec.overlay_moving_bar;
+          gpu_ok = frame.base &&
+                   synthetic_gpu_backing_generate_stream_live_pattern_rgba8(
+                       s.live_gpu_backing, w, h, frame, frame_trace_id);
+          if (!gpu_ok) {
+            generate_on_gpu = false;
+            render_on_cpu();
+            s.live_gpu_pending_dirty_whole_frame = true;
+          }
+        }
+        if (!generate_on_gpu) {
+          SyntheticGpuBackingDirtyRegion dirty{};
+          if (!s.live_gpu_pending_dirty_whole_frame) {
+            dirty.x = s.live_gpu_pending_dirty.x;
+            dirty.y = s.live_gpu_pending_dirty.y;
+            dirty.width = s.live_gpu_pending_dirty.width;
+            dirty.height = s.live_gpu_pending_dirty.height;
+          }
+          gpu_ok = synthetic_gpu_backing_update_stream_live_gpu_backing_rgba8(
+              s.live_gpu_backing,
+              s.gpu_staging.data(),
+              w,
+              h,
+              stride,
+              dirty,
+              frame_trace_id);
+        }
         const auto update_total_t1 = std::chrono::steady_clock::now();
         const uint64_t update_total_ns = static_cast<uint64_t>(
             std::chrono::duration_cast<std::chrono::nanoseconds>(update_total_t1 - update_total_t0).count());
@@ -3584,7 +4165,8 @@ void SyntheticProvider::emit_one_frame_(StreamState& s, uint64_t scheduled_captu
       if (display_demand_trace_enabled_) {
         const bool prev_skip = display_demand_last_skip_by_stream_[s.req.stream_id];
         if (prev_skip != skip_gpu_update_for_demand) {
-          std::printf(
+          async_log_printf(
+              stdout,
               "[CamBANG][DemandTrace] provider_gpu_decision_transition stream_id=%llu demand_active=%d decision=%s\n",
               static_cast<unsigned long long>(s.req.stream_id),
               display_demand_active ? 1 : 0,
@@ -3616,7 +4198,9 @@ void SyntheticProvider::emit_one_frame_(StreamState& s, uint64_t scheduled_captu
               s.gpu_staging.data(),
               w,
               h,
-              stride);
+              stride,
+              SyntheticGpuBackingDirtyRegion{},
+              frame_trace_id);
           const auto update_retry_t1 = std::chrono::steady_clock::now();
           const uint64_t update_retry_ns = static_cast<uint64_t>(
               std::chrono::duration_cast<std::chrono::nanoseconds>(update_retry_t1 - update_retry_t0).count());
@@ -3629,6 +4213,8 @@ void SyntheticProvider::emit_one_frame_(StreamState& s, uint64_t scheduled_captu
       }
       if (gpu_ok) {
         gpu_backing = s.live_gpu_backing;
+        s.live_gpu_pending_dirty = PatternDirtyRect{};
+        s.live_gpu_pending_dirty_whole_frame = generate_on_gpu;
       }
     }
   }
@@ -3638,6 +4224,7 @@ void SyntheticProvider::emit_one_frame_(StreamState& s, uint64_t scheduled_captu
   if (requires_gpu_primary && !gpu_backing) {
     // A mode that selected a truthful GPU-backed stream must not silently emit
     // a CPU fallback frame when live GPU backing creation/update is unavailable.
+    slot->bytes.reset();
     slot->in_use.store(false, std::memory_order_release);
     return;
   }
@@ -3647,7 +4234,12 @@ void SyntheticProvider::emit_one_frame_(StreamState& s, uint64_t scheduled_captu
       // Preserve a current CPU materialization source for the exact FrameView that
       // is about to be retained. GPU-only mode keeps CPU staging provider-local.
       const auto copy_t0 = std::chrono::steady_clock::now();
-      std::memcpy(slot->bytes.data(), s.gpu_staging.data(), slot->bytes.size());
+      if (reduced_sidecar) {
+        apply_packed_transform_rows(sidecar_transform, sidecar_geometry, s.gpu_staging.data(), stride, 0,
+                                    /*bgra_source=*/false, 0, payload_h, slot->bytes->data(), payload_stride);
+      } else {
+        std::memcpy(slot->bytes->data(), s.gpu_staging.data(), slot->bytes->size());
+      }
       const auto copy_t1 = std::chrono::steady_clock::now();
       const uint64_t copy_ns = static_cast<uint64_t>(
           std::chrono::duration_cast<std::chrono::nanoseconds>(copy_t1 - copy_t0).count());
@@ -3660,6 +4252,7 @@ void SyntheticProvider::emit_one_frame_(StreamState& s, uint64_t scheduled_captu
   fv.stream_id = s.req.stream_id;
   fv.acquisition_session_id = s.acquisition_session_native_id;
   fv.capture_id = 0;
+  fv.trace_id = frame_trace_id;
   fv.width = w;
   fv.height = h;
   fv.format_fourcc = FOURCC_RGBA;
@@ -3687,19 +4280,23 @@ void SyntheticProvider::emit_one_frame_(StreamState& s, uint64_t scheduled_captu
         SourcedFact<ImageAcquisitionTiming>{*timing, FactOrigin::VIRTUAL_CAMERA_AUTHORED};
   }
   fv.retain_cpu_sidecar = publish_cpu_payload;
+  if (reduced_sidecar) {
+    fv.cpu_sidecar_width = payload_w;
+    fv.cpu_sidecar_height = payload_h;
+  }
   fv.requested_retained_plan = s.req.requested_retained_plan;
   if (publish_cpu_payload) {
-    fv.data = slot->bytes.data();
-    fv.size_bytes = slot->bytes.size();
-    fv.cpu_payload_owner =
-        std::shared_ptr<const std::vector<uint8_t>>(slot, &slot->bytes);
+    fv.data = slot->bytes->data();
+    fv.size_bytes = slot->bytes->size();
+    fv.cpu_payload_owner = slot->bytes;
   }
-  fv.stride_bytes = stride;
+  fv.stride_bytes = payload_stride;
   const bool profile_compatible =
       fv.width == s.req.profile.width &&
       fv.height == s.req.profile.height &&
       (s.req.profile.format_fourcc == 0 || s.req.profile.format_fourcc == fv.format_fourcc);
   if (!profile_compatible) {
+    slot->bytes.reset();
     slot->in_use.store(false, std::memory_order_release);
     return;
   }
@@ -3720,6 +4317,138 @@ void SyntheticProvider::emit_one_frame_(StreamState& s, uint64_t scheduled_captu
   record_timing_sample(emit_ns, triage_emit_frame_calls_, triage_emit_frame_total_ns_, triage_emit_frame_max_ns_);
 }
 
+void SyntheticProvider::emit_headless_frame_(StreamState& s,
+                                             std::shared_ptr<StreamState::BufferSlot> slot,
+                                             uint64_t scheduled_capture_ns) {
+  const uint32_t w = s.req.profile.width;
+  const uint32_t h = s.req.profile.height;
+  const uint32_t stride = w * 4u;
+  const size_t size_bytes = static_cast<size_t>(stride) * static_cast<size_t>(h);
+  std::shared_ptr<CpuPayloadBytes>& zeros = headless_zero_payloads_[size_bytes];
+  if (!zeros) {
+    zeros = std::make_shared<CpuPayloadBytes>(size_bytes, std::uint8_t{0});
+  }
+  slot->bytes = zeros;
+  post_shared_cpu_payload_frame_(s, std::move(slot), scheduled_capture_ns);
+}
+
+std::shared_ptr<SyntheticProvider::LoopedFrameSet> SyntheticProvider::find_or_create_looped_frame_set_(
+    const PatternSpec& spec) {
+  for (const auto& set : looped_frame_sets_) {
+    if (set->matches(spec)) {
+      return set;
+    }
+  }
+  const uint64_t period = CpuPackedPatternRenderer::overlay_period_frames(spec);
+  const uint64_t frame_bytes = static_cast<uint64_t>(spec.width) * 4u * static_cast<uint64_t>(spec.height);
+  if (period == 0 || frame_bytes == 0 || period > kLoopedFrameSetByteBudget / frame_bytes) {
+    return nullptr;
+  }
+  const uint64_t set_bytes = period * frame_bytes;
+  for (auto it = looped_frame_sets_.begin();
+       it != looped_frame_sets_.end() && looped_frame_set_bytes_ + set_bytes > kLoopedFrameSetByteBudget;) {
+    if (it->use_count() == 1) {
+      looped_frame_set_bytes_ -= (*it)->bytes;
+      it = looped_frame_sets_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  if (looped_frame_set_bytes_ + set_bytes > kLoopedFrameSetByteBudget) {
+    return nullptr;
+  }
+  auto set = std::make_shared<LoopedFrameSet>();
+  set->base_key = PatternBaseKey::from_spec(spec);
+  set->overlay_frame_index_offsets = spec.overlay_frame_index_offsets;
+  set->overlay_moving_bar = spec.overlay_moving_bar;
+  set->frames.resize(static_cast<size_t>(period));
+  set->bytes = set_bytes;
+  looped_frame_sets_.push_back(set);
+  looped_frame_set_bytes_ += set_bytes;
+  return set;
+}
+
+bool SyntheticProvider::emit_looped_frame_(StreamState& s,
+                                           std::shared_ptr<StreamState::BufferSlot>& slot,
+                                           uint64_t scheduled_capture_ns) {
+  const PatternSpec& spec = s.render_spec;
+  if (!s.looped_frames || !s.looped_frames->matches(spec)) {
+    s.looped_frames = find_or_create_looped_frame_set_(spec);
+    if (!s.looped_frames) {
+      return false;
+    }
+  }
+  const uint64_t frame_index = generator_frame_ordinal_from_ns_(scheduled_capture_ns, s.picture);
+  std::shared_ptr<CpuPayloadBytes>& frame =
+      s.looped_frames->frames[static_cast<size_t>(frame_index % s.looped_frames->frames.size())];
+  if (!frame) {
+    auto bytes = std::make_shared<CpuPayloadBytes>(
+        static_cast<size_t>(spec.width) * 4u * static_cast<size_t>(spec.height));
+    PatternRenderTarget dst{};
+    dst.data = bytes->data();
+    dst.size_bytes = bytes->size();
+    dst.width = spec.width;
+    dst.height = spec.height;
+    dst.stride_bytes = spec.width * 4u;
+    dst.format = PatternSpec::PackedFormat::RGBA8;
+    PatternOverlayData ov{};
+    ov.frame_index = frame_index;
+    ov.timestamp_ns = scheduled_capture_ns;
+    ov.stream_id = s.req.stream_id;
+    const auto render_t0 = std::chrono::steady_clock::now();
+    s.renderer.render_into(spec, dst, ov);
+    const uint64_t render_ns = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - render_t0).count());
+    record_timing_sample(render_ns, triage_frame_render_calls_, triage_frame_render_total_ns_, triage_frame_render_max_ns_);
+    frame = std::move(bytes);
+  }
+  slot->bytes = frame;
+  post_shared_cpu_payload_frame_(s, std::move(slot), scheduled_capture_ns);
+  return true;
+}
+
+void SyntheticProvider::post_shared_cpu_payload_frame_(StreamState& s,
+                                                       std::shared_ptr<StreamState::BufferSlot> slot,
+                                                       uint64_t scheduled_capture_ns) {
+  const uint32_t w = s.req.profile.width;
+  const uint32_t h = s.req.profile.height;
+  const uint32_t stride = w * 4u;
+
+  FrameView fv{};
+  fv.device_instance_id = s.req.device_instance_id;
+  fv.stream_id = s.req.stream_id;
+  fv.acquisition_session_id = s.acquisition_session_native_id;
+  fv.capture_id = 0;
+  fv.trace_id = frame_latency_trace_begin(s.req.stream_id);
+  fv.width = w;
+  fv.height = h;
+  fv.format_fourcc = FOURCC_RGBA;
+  fv.primary_backing_kind = ProducerBackingKind::CPU;
+  if (const auto timing = synthetic_acquisition_timing_from_unsigned(
+          scheduled_capture_ns,
+          ImageAcquisitionReferenceEvent::PROVIDER_OBSERVED,
+          ImageAcquisitionComparability::SAME_PROVIDER)) {
+    fv.acquisition_timing =
+        SourcedFact<ImageAcquisitionTiming>{*timing, FactOrigin::VIRTUAL_CAMERA_AUTHORED};
+  }
+  fv.retain_cpu_sidecar = true;
+  fv.requested_retained_plan = s.req.requested_retained_plan;
+  fv.data = slot->bytes->data();
+  fv.size_bytes = slot->bytes->size();
+  fv.cpu_payload_owner = slot->bytes;
+  fv.stride_bytes = stride;
+  if (s.req.profile.format_fourcc != 0 && s.req.profile.format_fourcc != fv.format_fourcc) {
+    slot->bytes.reset();
+    slot->in_use.store(false, std::memory_order_release);
+    return;
+  }
+  auto* lease = new FrameReleaseLease();
+  lease->slot = std::move(slot);
+  fv.release = &SyntheticProvider::release_frame_;
+  fv.release_user = lease;
+  strand_.post_frame(fv);
+}
+
 void SyntheticProvider::emit_due_frames_() {
   const uint64_t now = clock_.now_ns();
   const uint64_t period = fps_period_ns(cfg_.nominal.fps_num, cfg_.nominal.fps_den);
@@ -3754,17 +4483,19 @@ void SyntheticProvider::emit_due_frames_() {
     uint32_t emitted_this_tick = 0;
     if (s.next_due_ns <= now) {
       const uint64_t scheduled = s.next_due_ns;
-      emit_one_frame_(s, scheduled);
-      ++emitted_this_tick;
-      ++triage_frames_emitted_total_;
+      if (!should_skip_congested_frame_(s) && !should_skip_undemanded_frame_(s)) {
+        emit_one_frame_(s, scheduled);
+        ++emitted_this_tick;
+        ++triage_frames_emitted_total_;
+      }
 
       const uint64_t next_due = scheduled + period;
       if (next_due <= now) {
         const uint64_t snapped_due = snap_repeating_due_after_(next_due, now, period);
         if (snapped_due > next_due) {
           ++triage_catchup_ticks_capped_total_;
-          triage_catchup_frames_dropped_total_ +=
-              static_cast<uint64_t>((snapped_due - next_due) / period);
+          triage_catchup_frames_dropped_total_.fetch_add(
+              static_cast<uint64_t>((snapped_due - next_due) / period), std::memory_order_relaxed);
         }
         s.next_due_ns = snapped_due;
       } else {
@@ -3788,13 +4519,7 @@ void SyntheticProvider::emit_triage_trace_if_due_() {
     return;
   }
   triage_next_log_ns_ = now + kTriageLogIntervalNs;
-  uint64_t gpu_upload_copy_calls = 0;
-  uint64_t gpu_upload_copy_total_ns = 0;
-  uint64_t gpu_upload_copy_max_ns = 0;
-  uint64_t gpu_texture_update_calls = 0;
-  uint64_t gpu_texture_update_total_ns = 0;
-  uint64_t gpu_texture_update_max_ns = 0;
-  uint64_t gpu_texture_update_skipped = 0;
+  SyntheticGpuBackingUpdateStats gpu_stats{};
   uint64_t pattern_base_cache_hit_count = 0;
   uint64_t pattern_base_cache_miss_count = 0;
   uint64_t pattern_base_render_total_ns = 0;
@@ -3816,24 +4541,22 @@ void SyntheticProvider::emit_triage_trace_if_due_() {
     pattern_overlay_total_ns += stats.overlay_total_ns;
     pattern_overlay_max_ns = std::max(pattern_overlay_max_ns, stats.overlay_max_ns);
   }
-  const bool has_gpu_subbucket_stats = synthetic_gpu_backing_take_update_timing_stats(
-      gpu_upload_copy_calls,
-      gpu_upload_copy_total_ns,
-      gpu_upload_copy_max_ns,
-      gpu_texture_update_calls,
-      gpu_texture_update_total_ns,
-      gpu_texture_update_max_ns,
-      gpu_texture_update_skipped);
+  if (!synthetic_gpu_backing_take_update_timing_stats(gpu_stats)) {
+    gpu_stats = SyntheticGpuBackingUpdateStats{};
+  }
   synthetic_triage_printf(
       "[CamBANG][SyntheticTriageMetrics] total_emitted_frames=%llu catchup_bursts=%llu catchup_max_per_tick=%u "
-      "falling_behind_repeats=%llu catchup_cap=%u catchup_ticks_capped=%llu catchup_frames_dropped=%llu",
+      "falling_behind_repeats=%llu catchup_cap=%u catchup_ticks_capped=%llu catchup_frames_dropped=%llu "
+      "congested_frames_skipped=%llu demand_governed_frames_skipped=%llu",
       static_cast<unsigned long long>(triage_frames_emitted_total_),
       static_cast<unsigned long long>(triage_catchup_bursts_total_),
       triage_catchup_max_frames_in_tick_,
       static_cast<unsigned long long>(triage_falling_behind_repeat_total_),
       triage_catchup_cap_per_tick_,
       static_cast<unsigned long long>(triage_catchup_ticks_capped_total_),
-      static_cast<unsigned long long>(triage_catchup_frames_dropped_total_));
+      static_cast<unsigned long long>(triage_catchup_frames_dropped_total_.load(std::memory_order_relaxed)),
+      static_cast<unsigned long long>(triage_congested_frames_skipped_total_),
+      static_cast<unsigned long long>(triage_demand_governed_frames_skipped_total_));
   synthetic_triage_printf(
       "[CamBANG][SyntheticGpuMetrics] gpu_update_attempts=%llu gpu_update_failures=%llu gpu_update_retries=%llu "
       "gpu_update_demand_skipped=%llu "
@@ -3843,7 +4566,9 @@ void SyntheticProvider::emit_triage_trace_if_due_() {
       "gpu_update_total_calls=%llu gpu_update_total_total_ms=%.3f gpu_update_total_max_ms=%.3f "
       "gpu_upload_copy_calls=%llu gpu_upload_copy_total_ms=%.3f gpu_upload_copy_max_ms=%.3f "
       "gpu_texture_update_calls=%llu gpu_texture_update_total_ms=%.3f gpu_texture_update_max_ms=%.3f "
-      "gpu_texture_update_skipped=%llu",
+      "gpu_texture_update_skipped=%llu gpu_texture_pool_hits=%llu gpu_texture_pool_misses=%llu "
+      "gpu_release_drain_calls=%llu gpu_release_drain_total_ms=%.3f gpu_release_drain_max_ms=%.3f "
+      "gpu_release_queue_depth_max=%llu",
       static_cast<unsigned long long>(triage_gpu_update_attempts_total_),
       static_cast<unsigned long long>(triage_gpu_update_failures_total_),
       static_cast<unsigned long long>(triage_gpu_update_retries_total_),
@@ -3859,13 +4584,19 @@ void SyntheticProvider::emit_triage_trace_if_due_() {
       static_cast<unsigned long long>(triage_gpu_update_total_calls_),
       ns_to_ms(triage_gpu_update_total_ns_),
       ns_to_ms(triage_gpu_update_total_max_ns_),
-      static_cast<unsigned long long>(has_gpu_subbucket_stats ? gpu_upload_copy_calls : 0),
-      ns_to_ms(has_gpu_subbucket_stats ? gpu_upload_copy_total_ns : 0),
-      ns_to_ms(has_gpu_subbucket_stats ? gpu_upload_copy_max_ns : 0),
-      static_cast<unsigned long long>(has_gpu_subbucket_stats ? gpu_texture_update_calls : 0),
-      ns_to_ms(has_gpu_subbucket_stats ? gpu_texture_update_total_ns : 0),
-      ns_to_ms(has_gpu_subbucket_stats ? gpu_texture_update_max_ns : 0),
-      static_cast<unsigned long long>(has_gpu_subbucket_stats ? gpu_texture_update_skipped : 0));
+      static_cast<unsigned long long>(gpu_stats.upload_copy_calls),
+      ns_to_ms(gpu_stats.upload_copy_total_ns),
+      ns_to_ms(gpu_stats.upload_copy_max_ns),
+      static_cast<unsigned long long>(gpu_stats.texture_update_calls),
+      ns_to_ms(gpu_stats.texture_update_total_ns),
+      ns_to_ms(gpu_stats.texture_update_max_ns),
+      static_cast<unsigned long long>(gpu_stats.texture_update_skipped),
+      static_cast<unsigned long long>(gpu_stats.texture_pool_hits),
+      static_cast<unsigned long long>(gpu_stats.texture_pool_misses),
+      static_cast<unsigned long long>(gpu_stats.release_drain_calls),
+      ns_to_ms(gpu_stats.release_drain_total_ns),
+      ns_to_ms(gpu_stats.release_drain_max_ns),
+      static_cast<unsigned long long>(gpu_stats.release_queue_depth_max));
   synthetic_triage_printf(
       "[CamBANG][SyntheticTimelineMetrics] timeline_pump_calls=%llu timeline_pump_total_ms=%.3f timeline_pump_max_ms=%.3f "
       "timeline_event_exec_calls=%llu timeline_event_exec_total_ms=%.3f timeline_event_exec_max_ms=%.3f "
@@ -3929,13 +4660,7 @@ SyntheticMetricsSnapshot SyntheticProvider::get_metrics_snapshot_for_host() cons
   out.current_virtual_timeline_ns = clock_.now_ns();
   uint64_t pattern_base_copy_total_ns = 0;
   uint64_t pattern_overlay_total_ns = 0;
-  uint64_t gpu_upload_copy_calls = 0;
-  uint64_t gpu_upload_copy_total_ns = 0;
-  uint64_t gpu_upload_copy_max_ns = 0;
-  uint64_t gpu_texture_update_calls = 0;
-  uint64_t gpu_texture_update_total_ns = 0;
-  uint64_t gpu_texture_update_max_ns = 0;
-  uint64_t gpu_texture_update_skipped = 0;
+  SyntheticGpuBackingUpdateStats gpu_stats{};
   for (const auto& kv : streams_) {
     const auto& stats = kv.second.renderer.debug_stats();
     pattern_base_copy_total_ns += stats.base_copy_total_ns;
@@ -3945,18 +4670,10 @@ SyntheticMetricsSnapshot SyntheticProvider::get_metrics_snapshot_for_host() cons
   out.gpu_update_attempts = triage_gpu_update_attempts_total_;
   out.gpu_update_demand_skipped = triage_gpu_update_demand_skipped_total_;
   out.capture_gpu_backing_retain_calls = triage_capture_gpu_backing_retain_calls_;
-  const bool has_gpu_subbucket_stats = synthetic_gpu_backing_peek_update_timing_stats(
-      gpu_upload_copy_calls,
-      gpu_upload_copy_total_ns,
-      gpu_upload_copy_max_ns,
-      gpu_texture_update_calls,
-      gpu_texture_update_total_ns,
-      gpu_texture_update_max_ns,
-      gpu_texture_update_skipped);
-  (void)gpu_upload_copy_max_ns;
-  (void)gpu_texture_update_max_ns;
-  (void)gpu_texture_update_skipped;
-  out.gpu_texture_update_calls = has_gpu_subbucket_stats ? gpu_texture_update_calls : 0;
+  if (!synthetic_gpu_backing_peek_update_timing_stats(gpu_stats)) {
+    gpu_stats = SyntheticGpuBackingUpdateStats{};
+  }
+  out.gpu_texture_update_calls = gpu_stats.texture_update_calls;
   out.frame_copy_calls = triage_frame_copy_calls_;
   out.capture_gpu_backing_retain_total_ms =
       ns_to_ms(triage_capture_gpu_backing_retain_total_ns_);
@@ -3966,10 +4683,12 @@ SyntheticMetricsSnapshot SyntheticProvider::get_metrics_snapshot_for_host() cons
   out.pattern_overlay_total_ms = ns_to_ms(pattern_overlay_total_ns);
   out.pattern_base_copy_total_ms = ns_to_ms(pattern_base_copy_total_ns);
   out.gpu_update_total_total_ms = ns_to_ms(triage_gpu_update_total_ns_);
-  out.gpu_upload_copy_total_ms = ns_to_ms(has_gpu_subbucket_stats ? gpu_upload_copy_total_ns : 0);
-  out.gpu_texture_update_total_ms = ns_to_ms(has_gpu_subbucket_stats ? gpu_texture_update_total_ns : 0);
+  out.gpu_upload_copy_total_ms = ns_to_ms(gpu_stats.upload_copy_total_ns);
+  out.gpu_texture_update_total_ms = ns_to_ms(gpu_stats.texture_update_total_ns);
   out.catchup_ticks_capped = triage_catchup_ticks_capped_total_;
-  out.catchup_frames_dropped = triage_catchup_frames_dropped_total_;
+  out.catchup_frames_dropped = triage_catchup_frames_dropped_total_.load(std::memory_order_relaxed);
+  out.congested_frames_skipped = triage_congested_frames_skipped_total_;
+  out.demand_governed_frames_skipped = triage_demand_governed_frames_skipped_total_;
   out.capture_gpu_backing_retain_cpu_primary =
       SyntheticCaptureGpuBackingRetainPostureMetricsSnapshot{};
   out.capture_gpu_backing_retain_gpu_primary_no_cpu_sidecar.calls =
@@ -4359,6 +5078,45 @@ SyntheticMetricsSnapshot SyntheticProvider::get_metrics_snapshot_for_host() cons
   return out;
 }
 
+std::optional<uint64_t> SyntheticProvider::next_due_ns_locked_() const {
+  if (cfg_.synthetic_role == SyntheticRole::Timeline) {
+    if (!timeline_running_ || timeline_q_.empty()) {
+      return std::nullopt;
+    }
+    return timeline_q_.top().at_ns;
+  }
+  std::optional<uint64_t> earliest;
+  for (const auto& kv : streams_) {
+    const StreamState& s = kv.second;
+    if (!s.created || !s.started || is_stream_capture_paused_locked_(s)) {
+      continue;
+    }
+    if (!earliest || s.next_due_ns < *earliest) {
+      earliest = s.next_due_ns;
+    }
+  }
+  return earliest;
+}
+
+uint64_t SyntheticProvider::advance_to_next_due(uint64_t max_dt_ns) {
+  if (!initialized_ || shutting_down_) {
+    return 0;
+  }
+  uint64_t dt_ns = max_dt_ns;
+  {
+    std::lock_guard<std::mutex> lk(provider_state_mutex_);
+    if (cfg_.synthetic_role == SyntheticRole::Timeline && timeline_running_ && timeline_paused_) {
+      return 0;
+    }
+    if (const std::optional<uint64_t> due = next_due_ns_locked_()) {
+      const uint64_t now = clock_.now_ns();
+      dt_ns = std::min(dt_ns, *due > now ? *due - now : 0);
+    }
+  }
+  advance(dt_ns);
+  return dt_ns;
+}
+
 void SyntheticProvider::advance(uint64_t dt_ns,
                                 bool allow_paused_timeline_step,
                                 bool flush_strand) {
@@ -4378,9 +5136,14 @@ void SyntheticProvider::advance(uint64_t dt_ns,
     return;
   }
 
-  // v1: only VirtualTime is implemented. Advancing by dt=0 is still a valid
-  // host-stepper operation because timeline_pump_() executes events already due
-  // at the current virtual time.
+  // Advancing by dt=0 is still a valid host-stepper operation because
+  // timeline_pump_() executes events already due at the current virtual time.
+  // Under the real-time clock, time is the monotonic clock's and dt only asks
+  // for whatever is due now.
+  if (realtime_clock_) {
+    const uint64_t elapsed_ns = provider_monotonic_now_ns() - realtime_origin_ns_;
+    dt_ns = elapsed_ns > clock_.now_ns() ? elapsed_ns - clock_.now_ns() : 0;
+  }
   clock_.advance(dt_ns);
   if (cfg_.synthetic_role == SyntheticRole::Timeline) {
     timeline_pump_(allow_paused_timeline_step);
@@ -4,6 +4,7 @@
 #include <atomic>
 #include <condition_variable>
 #include <cstdint>
+#include <exception>
 #include <functional>
 #include <mutex>
 #include <map>
@@ -14,6 +15,7 @@
 #include <thread>
 #include <vector>
 
+#include "imaging/api/capture_start_barrier.h"
 #include "imaging/api/icamera_provider.h"
 #include "imaging/api/provider_access_status.h"
 #include "imaging/api/provider_strand.h"
@@ -24,6 +26,7 @@
 #include "imaging/synthetic/scenario.h"
 #include "imaging/synthetic/virtual_clock.h"
 #include "pixels/pattern/cpu_packed_pattern_renderer.h"
+#include "pixels/pattern/pattern_band_pool.h"
 
 namespace cambang {
 
@@ -85,6 +88,7 @@ public:
       const CaptureProfile& profile,
       const PictureConfig& picture) override;
   ProviderResult stop_stream(uint64_t stream_id) override;
+  ProviderResult reconfigure_stream(uint64_t stream_id, const CaptureProfile& profile) override;
   ProviderResult update_stream_retained_production_plan(
       uint64_t stream_id,
       CoreRetainedProductionPlan requested_retained_plan) override;
@@ -93,6 +97,9 @@ public:
   ProviderResult set_capture_picture_config(uint64_t device_instance_id, const PictureConfig& picture) override;
   ProviderResult sync_capture_parent_priming(const CaptureRequest& req) override;
   ProviderResult release_capture_parent_priming(uint64_t device_instance_id) override;
+  uint64_t trim_memory(MemoryTrimLevel level) noexcept override;
+  void set_stream_pool_depth_hint(uint64_t stream_id, const StreamPoolDepthHint& hint) noexcept override;
+  uint64_t producer_frames_dropped_total() const noexcept override;
 
   ProviderResult trigger_capture(const CaptureRequest& req) override;
   ProviderResult trigger_capture_submission(const CaptureSubmission& submission) override;
@@ -122,6 +129,15 @@ public:
                bool allow_paused_timeline_step = false,
                bool flush_strand = true);
 
+  // Event-driven VirtualTime stepping for long verification runs: advances by
+  // exactly the virtual time until the earliest pending due point (next
+  // scheduled timeline event, or next nominal stream frame), capped at
+  // max_dt_ns, then behaves as advance(). A run of these visits every due
+  // point in order with no idle ticks in between, so hours of simulated
+  // stream time cost one step per event. Returns the virtual time advanced:
+  // max_dt_ns when nothing is pending, 0 while the timeline is paused.
+  uint64_t advance_to_next_due(uint64_t max_dt_ns);
+
   // Smoke/scenario-only helpers. These preserve the main runtime architecture
   // while allowing deterministic lifecycle edge cases to be exercised.
   ProviderResult disconnect_device_for_test(uint64_t device_instance_id);
@@ -283,8 +299,25 @@ private:
   static constexpr uint64_t kBackingPlanEvaluationSettleDelayNs = 20'000'000ull;
 
   CBProviderStrand strand_;
+  // Queued timeline work, kept small: authored events and periodic runs stay
+  // in timeline_scenario_ and are referenced by index, a periodic run queues
+  // only its next occurrence, and EmitFrame continuations carry just the
+  // stream id. timeline_event_for_entry_() rebuilds the full event when due.
+  enum class TimelineEntrySource : uint8_t {
+    Authored = 0,
+    Periodic = 1,
+    Continuation = 2,
+  };
+  struct TimelineQueueEntry {
+    uint64_t at_ns = 0;
+    uint64_t seq = 0;
+    uint64_t stream_id = 0;      // Continuation only.
+    uint64_t occurrence = 0;     // Periodic only.
+    uint32_t index = 0;          // Into timeline_scenario_.events / .periodic.
+    TimelineEntrySource source = TimelineEntrySource::Authored;
+  };
   struct TimelineEventCompare {
-    bool operator()(const SyntheticScheduledEvent& a, const SyntheticScheduledEvent& b) const noexcept {
+    bool operator()(const TimelineQueueEntry& a, const TimelineQueueEntry& b) const noexcept {
       if (a.at_ns != b.at_ns) {
         return a.at_ns > b.at_ns;
       }
@@ -292,8 +325,11 @@ private:
     }
   };
 
-  void timeline_schedule_(uint64_t at_ns, SyntheticEventType type, uint64_t stream_id);
-  void timeline_schedule_(const SyntheticScheduledEvent& ev);
+  void timeline_schedule_emit_frame_(uint64_t at_ns, uint64_t stream_id);
+  void timeline_schedule_(TimelineQueueEntry entry);
+  void timeline_schedule_periodic_(uint32_t index, uint64_t occurrence);
+  void timeline_arm_scenario_();
+  SyntheticScheduledEvent timeline_event_for_entry_(const TimelineQueueEntry& entry) const;
   void timeline_dispatch_request_(const SyntheticScheduledEvent& ev);
   void timeline_activate_or_dispatch_(const SyntheticScheduledEvent& ev, bool allow_pending);
   bool timeline_destructive_prereq_ready_(const SyntheticScheduledEvent& ev, const char*& reason) const;
@@ -344,6 +380,24 @@ private:
     PictureConfig capture_picture{};
   };
 
+  // SyntheticFrameContentMode::Looped frames of one stream picture at one
+  // size: one slot per ordinal of the overlay period, each filled by the first
+  // stream to render that ordinal and never written after.
+  struct LoopedFrameSet {
+    PatternBaseKey base_key{};
+    bool overlay_frame_index_offsets = false;
+    bool overlay_moving_bar = false;
+    std::vector<std::shared_ptr<CpuPayloadBytes>> frames;
+    // Full-period payload bytes.
+    uint64_t bytes = 0;
+
+    bool matches(const PatternSpec& spec) const noexcept {
+      return base_key == PatternBaseKey::from_spec(spec) &&
+             overlay_frame_index_offsets == spec.overlay_frame_index_offsets &&
+             overlay_moving_bar == spec.overlay_moving_bar;
+    }
+  };
+
   struct StreamState {
     StreamRequest req{};
     bool created = false;
@@ -357,6 +411,7 @@ private:
     CpuPackedPatternRenderer renderer{};
     PatternSpec render_spec{};
     bool render_spec_valid = false;
+    std::shared_ptr<LoopedFrameSet> looped_frames{};
     bool prefer_gpu_backing = false;
     SyntheticProducerOutputFormMode resolved_output_form_mode = SyntheticProducerOutputFormMode::Auto;
     std::vector<std::uint8_t> gpu_staging;
@@ -366,20 +421,39 @@ private:
     uint32_t live_gpu_width = 0;
     uint32_t live_gpu_height = 0;
     uint32_t live_gpu_stride_bytes = 0;
-
+    // Pixels rendered since the live backing last accepted an update
+    // (demand-skipped frames accumulate). A fresh backing starts whole-frame.
+    PatternDirtyRect live_gpu_pending_dirty{};
+    bool live_gpu_pending_dirty_whole_frame = true;
+    // Base of the frames the live backing generates on the GPU, and the
+    // revision handed with it (bumped whenever the base changes).
+    std::shared_ptr<const PatternBaseFrame> gpu_pattern_base{};
+    uint64_t gpu_pattern_base_revision = 0;
+
+    // In-flight frame token. bytes is the recyclable payload buffer drawn
+    // for the frame currently holding the slot; it is published as the
+    // frame's cpu_payload_owner and dropped when the slot is released, so a
+    // retained result keeps it alive without pinning the slot.
     struct BufferSlot {
       uint64_t stream_id = 0;
-      std::vector<std::uint8_t> bytes;
+      std::shared_ptr<CpuPayloadBytes> bytes;
       std::atomic<bool> in_use{false};
     };
     std::vector<std::shared_ptr<BufferSlot>> pool;
     size_t pool_cursor = 0;
+    // Core's in-flight depth for the stream (set_stream_pool_depth_hint());
+    // the pool never holds fewer slots than this.
+    uint32_t pool_depth_hint = 0;
     uint32_t consecutive_behind_ticks = 0;
+    // Display-demand governor (SyntheticNominalDefaults): frames emitted
+    // since demand was last seen, and due points passed while throttled.
+    uint32_t demand_idle_frames = 0;
+    uint32_t demand_throttled_due_points = 0;
   };
 
   struct FrameReleaseLease {
     std::shared_ptr<StreamState::BufferSlot> slot;
-    std::shared_ptr<std::vector<std::uint8_t>> bytes;
+    std::shared_ptr<CpuPayloadBytes> bytes;
   };
 
   static void release_frame_(void* user, const FrameView* frame);
@@ -387,6 +461,7 @@ private:
   uint32_t effective_endpoint_count_() const noexcept;
 
   uint64_t alloc_native_id_(NativeObjectType type);
+  std::shared_ptr<CpuPayloadBytes> acquire_cpu_payload_buffer_(const CpuPayloadBufferKey& key);
   void emit_native_create_device_(const DeviceState& d);
   void emit_native_destroy_(uint64_t native_id);
   void emit_camera_static_facts_(const DeviceState& d);
@@ -403,9 +478,29 @@ private:
   void release_native_acquisition_session_if_unheld_(DeviceState& d);
 
   void emit_due_frames_();
+  std::optional<uint64_t> next_due_ns_locked_() const;
   void emit_one_frame_(StreamState& s, uint64_t scheduled_capture_ns);
+  void emit_headless_frame_(StreamState& s,
+                            std::shared_ptr<StreamState::BufferSlot> slot,
+                            uint64_t scheduled_capture_ns);
+  // False, with slot untouched, when the stream's picture cannot be looped.
+  bool emit_looped_frame_(StreamState& s,
+                          std::shared_ptr<StreamState::BufferSlot>& slot,
+                          uint64_t scheduled_capture_ns);
+  std::shared_ptr<LoopedFrameSet> find_or_create_looped_frame_set_(const PatternSpec& spec);
+  // Posts a CPU-backed frame whose payload is slot->bytes, shared and
+  // immutable.
+  void post_shared_cpu_payload_frame_(StreamState& s,
+                                      std::shared_ptr<StreamState::BufferSlot> slot,
+                                      uint64_t scheduled_capture_ns);
   bool is_stream_capture_paused_locked_(const StreamState& s) const;
+  bool should_skip_congested_frame_(const StreamState& s);
+  bool should_skip_undemanded_frame_(StreamState& s);
   static uint64_t snap_repeating_due_after_(uint64_t due_ns, uint64_t now_ns, uint64_t period_ns) noexcept;
+  void start_pattern_band_pool_() noexcept;
+  void start_realtime_pacer_() noexcept;
+  void stop_realtime_pacer_() noexcept;
+  void realtime_pacer_main_() noexcept;
   bool ensure_stream_live_gpu_backing_(StreamState& s, uint32_t width, uint32_t height, uint32_t stride);
   void release_stream_live_gpu_backing_(StreamState& s);
   void emit_triage_trace_if_due_();
@@ -430,6 +525,9 @@ private:
     uint64_t capture_timestamp_ns = 0;
     SyntheticProducerOutputFormMode output_form_mode =
         SyntheticProducerOutputFormMode::CpuOnly;
+    // Shared by the members of one rig submission that fits the worker
+    // limit; capture_started posts only once every member has rendered.
+    std::shared_ptr<CBCaptureStartBarrier> start_barrier{};
   };
 
   struct CaptureSubmissionJob {
@@ -456,11 +554,39 @@ private:
     uint64_t generation = 0;
   };
 
+  // Pixels for one still-bundle member, prepared ahead of posting.
+  struct CaptureMemberPrep {
+    std::shared_ptr<CpuPayloadBytes> bytes;
+    uint64_t alloc_ns = 0;
+    uint64_t copy_ns = 0;
+    uint64_t ev_bgra_ns = 0;
+    std::exception_ptr error;
+    bool done = false; // guarded by capture_mutex_
+  };
+
+  // A device job's member preparations, claimed in member order by the
+  // owning worker and by idle workers alike. Only the owner posts, in member
+  // order, as each member becomes ready, so per-device fact ordering does not
+  // depend on who prepared what. next and in_progress are guarded by
+  // capture_mutex_.
+  struct CaptureMemberBatch {
+    const DeviceCaptureJob* job = nullptr;
+    const CpuPayloadBytes* base_bytes = nullptr;
+    std::vector<size_t> member_indices;
+    std::vector<CaptureMemberPrep> out; // indexed by bundle member position
+    size_t next = 0;
+    size_t in_progress = 0;
+    bool open = false;
+  };
+
   struct InFlightCaptureDevice {
     uint64_t capture_id = 0;
     uint64_t device_instance_id = 0;
     uint64_t acquisition_session_id = 0;
     uint64_t generation = 0;
+    // Admission order across the provider; a device's terminal facts post in
+    // this order so pipelined captures complete as they were triggered.
+    uint64_t admission_seq = 0;
     bool terminal_posted = false;
     bool release_done = false;
   };
@@ -481,18 +607,32 @@ private:
       CaptureSubmissionJob& out_job,
       CaptureAdmissionFailureInfo* failure_info);
   void rollback_capture_submission_locked_(CaptureSubmissionJob& job) noexcept;
+  size_t in_flight_capture_count_locked_(uint64_t device_instance_id) const noexcept;
+  bool has_earlier_in_flight_capture_locked_(const InFlightCaptureDevice& in_flight) const noexcept;
   bool should_stop_capture_job_(uint64_t generation) const noexcept;
   void run_device_capture_job_(const DeviceCaptureJob& job, uint64_t generation);
   bool generate_device_capture_payloads_(
       const DeviceCaptureJob& job,
       uint64_t generation,
-      std::shared_ptr<std::vector<std::uint8_t>>* deferred_cpu_staging_bytes);
+      std::shared_ptr<CpuPayloadBytes>* deferred_cpu_staging_bytes);
   void finish_device_capture_job_(const DeviceCaptureJob& job,
                                   uint64_t generation,
                                   CaptureTerminalKind terminal,
                                   ProviderError error,
-                                  std::shared_ptr<std::vector<std::uint8_t>>
+                                  std::shared_ptr<CpuPayloadBytes>
                                       deferred_cpu_staging_bytes = {});
+  void prepare_capture_member_(const DeviceCaptureJob& job,
+                               const CpuPayloadBytes& base_bytes,
+                               size_t member_index,
+                               CaptureMemberPrep& out) const noexcept;
+  void open_capture_member_batch_(CaptureMemberBatch& batch) noexcept;
+  CaptureMemberPrep& await_capture_member_(CaptureMemberBatch& batch, size_t member_index) noexcept;
+  void close_capture_member_batch_(CaptureMemberBatch& batch) noexcept;
+  void run_claimed_capture_member_locked_(std::unique_lock<std::mutex>& capture_lock,
+                                          CaptureMemberBatch& batch) noexcept;
+  bool steal_capture_member_locked_(std::unique_lock<std::mutex>& capture_lock) noexcept;
+  bool has_stealable_capture_member_locked_() const noexcept;
+  bool capture_job_ready_locked_() const noexcept;
   bool start_capture_executor_() noexcept;
   void capture_worker_main_() noexcept;
   void stop_and_join_capture_executor_() noexcept;
@@ -505,6 +645,21 @@ private:
 private:
   SyntheticProviderConfig cfg_{};
   IProviderCallbacks* callbacks_ = nullptr;
+  // Used only when the callbacks offer no Core-owned payload pool
+  // (IProviderCallbacks::acquire_cpu_payload_buffer returned nullptr).
+  CpuPayloadBufferPool local_cpu_payload_buffer_pool_;
+  // SyntheticFrameContentMode::Headless payloads by byte size; never written
+  // after creation. Guarded by provider_state_mutex_.
+  std::map<size_t, std::shared_ptr<CpuPayloadBytes>> headless_zero_payloads_;
+  // SyntheticFrameContentMode::Looped sets, with their full-period bytes
+  // counted against kLoopedFrameSetByteBudget whether filled or not. A set no
+  // stream holds is dropped to make room. Guarded by provider_state_mutex_.
+  static constexpr uint64_t kLoopedFrameSetByteBudget = 512ull * 1024ull * 1024ull; // 512 MiB
+  std::vector<std::shared_ptr<LoopedFrameSet>> looped_frame_sets_;
+  uint64_t looped_frame_set_bytes_ = 0;
+  // Shared by every stream renderer; started at initialize(), stopped at
+  // shutdown() once no stream can render.
+  PatternBandPool pattern_band_pool_;
   // Atomic because entry-point guards read these before taking any provider
   // mutex; under broker mediation admission is closed and drained before
   // shutdown mutates them, but the reference implementation must not carry
@@ -514,6 +669,22 @@ private:
 
   SyntheticVirtualClock clock_;
 
+  // TimingDriver::RealTime in the Nominal role. The clock follows the
+  // monotonic clock from realtime_origin_ns_ (steady ns at which clock_ read
+  // 0), so advance() ignores a host tick's dt and only emits what is due. The
+  // pacer thread advances at each stream's exact due time on a
+  // CBPreciseWaiter instead of leaving cadence to the host's tick; if it
+  // cannot start, host ticks still pace frames, tick-quantized. Timeline
+  // RealTime stays host-ticked: its dispatch hook must run through the
+  // broker's tick.
+  bool realtime_clock_ = false;
+  uint64_t realtime_origin_ns_ = 0;
+  // Longest the pacer waits with nothing due, which also bounds how late it
+  // notices a newly started stream and how long shutdown waits to join it.
+  static constexpr uint64_t kRealtimePacerIdleNs = 5'000'000;
+  std::atomic<bool> realtime_pacer_stop_{false};
+  std::thread realtime_pacer_;
+
   // Provider state accessed by provider API calls and asynchronous still-capture
   // cleanup. Never hold this mutex while rendering or copying pixel payloads.
   mutable std::mutex provider_state_mutex_;
@@ -521,20 +692,33 @@ private:
   // Capture executor state. Lock ordering, when both are needed: capture_mutex_
   // before provider_state_mutex_. Queue storage and worker concurrency are hard
   // bounded independently of process-lifetime capture volume.
+  //
+  // Workers scale with the host's cores (kCaptureWorkerCount up to
+  // kMaxCaptureWorkerCount), so the device jobs of a multi-camera rig render
+  // side by side. A worker with no device job to take steals still-bundle
+  // member preparations from a running job's CaptureMemberBatch.
   static constexpr size_t kCaptureWorkerCount = 4;
+  static constexpr size_t kMaxCaptureWorkerCount = 16;
   static constexpr size_t kCaptureQueueCapacity = 64;
+  // Upper bound a rendered rig member waits for its siblings.
+  static constexpr uint64_t kRigCaptureStartBarrierTimeoutNs = 250'000'000;
   mutable std::mutex capture_mutex_;
   std::condition_variable capture_cv_;
   bool capture_admission_closed_ = false;
   bool capture_executor_stop_requested_ = true;
   uint64_t capture_generation_ = 0;
   std::map<InFlightCaptureKey, InFlightCaptureDevice> in_flight_captures_;
+  uint64_t next_capture_admission_seq_ = 0;
   std::array<std::optional<CaptureWorkItem>, kCaptureQueueCapacity>
       capture_queue_{};
   size_t capture_queue_head_ = 0;
   size_t capture_queue_tail_ = 0;
   size_t capture_queue_count_ = 0;
   size_t capture_active_jobs_ = 0;
+  size_t capture_worker_limit_ = kCaptureWorkerCount;
+  // Batches open for stealing; at most one per active job, reserved to the
+  // worker limit at start so registration never allocates.
+  std::vector<CaptureMemberBatch*> capture_member_batches_;
   std::vector<std::thread> capture_workers_;
 #if defined(CAMBANG_INTERNAL_SMOKE) && CAMBANG_INTERNAL_SMOKE
   bool capture_workers_paused_for_test_ = false;
@@ -565,8 +749,8 @@ private:
   bool timeline_running_ = false;
   bool timeline_paused_ = false;
   bool completion_gated_destructive_sequencing_enabled_ = false;
-  std::priority_queue<SyntheticScheduledEvent,
-                      std::vector<SyntheticScheduledEvent>,
+  std::priority_queue<TimelineQueueEntry,
+                      std::vector<TimelineQueueEntry>,
                       TimelineEventCompare>
       timeline_q_;
   std::vector<SyntheticScheduledEvent> timeline_pending_destructive_;
@@ -582,7 +766,10 @@ private:
   uint64_t triage_frames_emitted_total_ = 0;
   uint64_t triage_catchup_bursts_total_ = 0;
   uint64_t triage_catchup_ticks_capped_total_ = 0;
-  uint64_t triage_catchup_frames_dropped_total_ = 0;
+  // Atomic: also read from the core thread (producer_frames_dropped_total()).
+  std::atomic<uint64_t> triage_catchup_frames_dropped_total_{0};
+  uint64_t triage_congested_frames_skipped_total_ = 0;
+  uint64_t triage_demand_governed_frames_skipped_total_ = 0;
   uint32_t triage_catchup_max_frames_in_tick_ = 0;
   uint64_t triage_falling_behind_repeat_total_ = 0;
   uint64_t triage_gpu_update_attempts_total_ = 0;
@@ -38,8 +38,21 @@ struct SyntheticScheduledEvent {
   PictureConfig picture{};
 };
 
+// A run of `count` copies of `event` due at start_ns, start_ns + period_ns,
+// ... (event.at_ns is ignored). The provider queues one occurrence at a time,
+// so a long periodic run costs one entry and one payload, not one per event.
+struct SyntheticPeriodicEvents {
+  std::uint64_t start_ns = 0;
+  std::uint64_t period_ns = 0;
+  std::uint64_t count = 0;
+  SyntheticScheduledEvent event{};
+};
+
 struct SyntheticTimelineScenario {
   std::vector<SyntheticScheduledEvent> events;
+  // Expanded lazily alongside `events`. At equal timestamps, occurrences run
+  // after the authored events and in the order they were generated.
+  std::vector<SyntheticPeriodicEvents> periodic;
 };
 
 } // namespace cambang
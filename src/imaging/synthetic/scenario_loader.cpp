@@ -1,18 +1,108 @@
 #include "imaging/synthetic/scenario_loader.h"
 
+#include <algorithm>
 #include <fstream>
+#include <memory>
+#include <mutex>
 #include <sstream>
+#include <vector>
 
 #include "imaging/synthetic/scenario_loader_convert.h"
 #include "imaging/synthetic/scenario_loader_parse.h"
 #include "imaging/synthetic/scenario_loader_validate.h"
 
 namespace cambang {
+namespace {
+
+// Bounds for the compiled-scenario cache. Authored scenarios are a few KiB;
+// texts past the per-entry cap are loaded normally and not retained.
+constexpr std::size_t kMaxCachedScenarios = 32;
+constexpr std::size_t kMaxCachedTextBytes = 256u << 10;
+
+std::uint64_t hash_scenario_text(const std::string& text) noexcept {
+  std::uint64_t h = 1469598103934665603ull;
+  for (const char c : text) {
+    h ^= static_cast<unsigned char>(c);
+    h *= 1099511628211ull;
+  }
+  return h;
+}
+
+class CompiledScenarioCache final {
+public:
+  std::shared_ptr<const SyntheticCanonicalScenario> find(std::uint64_t hash, const std::string& text) {
+    std::lock_guard<std::mutex> lock(mu_);
+    for (Entry& e : entries_) {
+      if (e.hash == hash && e.text == text) {
+        e.last_use = ++use_clock_;
+        ++stats_.hits;
+        return e.canonical;
+      }
+    }
+    ++stats_.misses;
+    return nullptr;
+  }
+
+  void insert(std::uint64_t hash, const std::string& text, const SyntheticCanonicalScenario& canonical) {
+    if (text.size() > kMaxCachedTextBytes) {
+      return;
+    }
+    auto compiled = std::make_shared<const SyntheticCanonicalScenario>(canonical);
+    std::lock_guard<std::mutex> lock(mu_);
+    for (const Entry& e : entries_) {
+      if (e.hash == hash && e.text == text) {
+        return;
+      }
+    }
+    if (entries_.size() >= kMaxCachedScenarios) {
+      const auto lru = std::min_element(entries_.begin(), entries_.end(), [](const Entry& a, const Entry& b) {
+        return a.last_use < b.last_use;
+      });
+      entries_.erase(lru);
+      ++stats_.evictions;
+    }
+    entries_.push_back(Entry{hash, text, std::move(compiled), ++use_clock_});
+  }
+
+  SyntheticScenarioCacheStats stats() {
+    std::lock_guard<std::mutex> lock(mu_);
+    SyntheticScenarioCacheStats s = stats_;
+    s.entries = entries_.size();
+    return s;
+  }
+
+private:
+  struct Entry {
+    std::uint64_t hash = 0;
+    std::string text;
+    std::shared_ptr<const SyntheticCanonicalScenario> canonical;
+    std::uint64_t last_use = 0;
+  };
+
+  std::mutex mu_;
+  std::vector<Entry> entries_;
+  std::uint64_t use_clock_ = 0;
+  SyntheticScenarioCacheStats stats_{};
+};
+
+CompiledScenarioCache& compiled_scenario_cache() {
+  static CompiledScenarioCache cache;
+  return cache;
+}
+
+} // namespace
 
 bool load_synthetic_canonical_scenario_from_json_text(
     const std::string& text,
     SyntheticCanonicalScenario& out,
     std::string* error) {
+  CompiledScenarioCache& cache = compiled_scenario_cache();
+  const std::uint64_t hash = hash_scenario_text(text);
+  if (const auto compiled = cache.find(hash, text)) {
+    out = *compiled;
+    return true;
+  }
+
   SyntheticScenarioLoaderParsedDocument parsed{};
   if (!parse_synthetic_scenario_loader_json_text(text, parsed, error)) {
     return false;
@@ -20,7 +110,11 @@ bool load_synthetic_canonical_scenario_from_json_text(
   if (!validate_parsed_synthetic_scenario_loader_document(parsed, error)) {
     return false;
   }
-  return convert_parsed_synthetic_scenario_loader_document_to_canonical(parsed, out, error);
+  if (!convert_parsed_synthetic_scenario_loader_document_to_canonical(parsed, out, error)) {
+    return false;
+  }
+  cache.insert(hash, text, out);
+  return true;
 }
 
 bool load_synthetic_canonical_scenario_from_json_file(
@@ -47,4 +141,8 @@ bool load_synthetic_canonical_scenario_from_json_file(
   return load_synthetic_canonical_scenario_from_json_text(oss.str(), out, error);
 }
 
+SyntheticScenarioCacheStats synthetic_scenario_cache_stats() {
+  return compiled_scenario_cache().stats();
+}
+
 } // namespace cambang
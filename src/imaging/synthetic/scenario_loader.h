@@ -1,11 +1,18 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
 #include <string>
 
 #include "imaging/synthetic/scenario_model.h"
 
 namespace cambang {
 
+// Both loaders go through a process-wide cache of compiled scenarios keyed by
+// the JSON content (hash, then byte compare). Loading the same text again,
+// e.g. each session of a regression run, copies out the cached canonical
+// scenario without parsing, validating or converting; edited text misses and
+// is fully re-validated. Only successful loads are cached.
 bool load_synthetic_canonical_scenario_from_json_file(
     const std::string& path,
     SyntheticCanonicalScenario& out,
@@ -16,4 +23,13 @@ bool load_synthetic_canonical_scenario_from_json_text(
     SyntheticCanonicalScenario& out,
     std::string* error = nullptr);
 
+struct SyntheticScenarioCacheStats {
+  std::uint64_t hits = 0;
+  std::uint64_t misses = 0;
+  std::uint64_t evictions = 0;
+  std::size_t entries = 0;
+};
+
+SyntheticScenarioCacheStats synthetic_scenario_cache_stats();
+
 } // namespace cambang
@@ -1,11 +1,12 @@
 #include "imaging/synthetic/scenario_loader_parse.h"
 #include "imaging/synthetic/config.h"
+#include "imaging/api/strict_json.h"
 
-#include <cctype>
+#include <algorithm>
 #include <cstdint>
 #include <limits>
 #include <string>
-#include <unordered_set>
+#include <string_view>
 #include <utility>
 
 namespace cambang {
@@ -17,326 +18,19 @@ void set_error(std::string* error, const std::string& message) {
   }
 }
 
-struct JsonValue {
-  enum class Type : std::uint8_t {
-    Null = 0,
-    Bool,
-    Number,
-    String,
-    Array,
-    Object,
-  };
-
-  Type type = Type::Null;
-  bool bool_value = false;
-  std::int64_t number_value = 0;
-  std::string string_value;
-  std::vector<JsonValue> array_value;
-  std::vector<std::pair<std::string, JsonValue>> object_value;
-};
-
-class JsonParser {
-public:
-  explicit JsonParser(const std::string& text) : text_(text) {}
-
-  bool parse(JsonValue& out, std::string* error) {
-    pos_ = 0;
-    if (!parse_value(out, error)) {
-      return false;
-    }
-    skip_ws();
-    if (pos_ != text_.size()) {
-      set_error(error, "unexpected trailing input at byte " + std::to_string(pos_));
-      return false;
-    }
-    return true;
-  }
-
-private:
-  void skip_ws() {
-    while (pos_ < text_.size() && std::isspace(static_cast<unsigned char>(text_[pos_]))) {
-      ++pos_;
-    }
-  }
-
-  bool consume(char c) {
-    if (pos_ < text_.size() && text_[pos_] == c) {
-      ++pos_;
-      return true;
-    }
-    return false;
-  }
-
-  bool parse_value(JsonValue& out, std::string* error) {
-    skip_ws();
-    if (pos_ >= text_.size()) {
-      set_error(error, "unexpected end of json");
-      return false;
-    }
-
-    const char c = text_[pos_];
-    if (c == '{') {
-      return parse_object(out, error);
-    }
-    if (c == '[') {
-      return parse_array(out, error);
-    }
-    if (c == '"') {
-      out.type = JsonValue::Type::String;
-      return parse_string(out.string_value, error);
-    }
-    if (c == '-' || (c >= '0' && c <= '9')) {
-      out.type = JsonValue::Type::Number;
-      return parse_integer(out.number_value, error);
-    }
-    if (match_literal("true")) {
-      out.type = JsonValue::Type::Bool;
-      out.bool_value = true;
-      return true;
-    }
-    if (match_literal("false")) {
-      out.type = JsonValue::Type::Bool;
-      out.bool_value = false;
-      return true;
-    }
-    if (match_literal("null")) {
-      out.type = JsonValue::Type::Null;
-      return true;
-    }
-
-    set_error(error, "unexpected token at byte " + std::to_string(pos_));
-    return false;
-  }
-
-  bool match_literal(const char* lit) {
-    size_t i = 0;
-    while (lit[i] != '\0') {
-      if (pos_ + i >= text_.size() || text_[pos_ + i] != lit[i]) {
-        return false;
-      }
-      ++i;
-    }
-    pos_ += i;
-    return true;
-  }
-
-  bool parse_string(std::string& out, std::string* error) {
-    if (!consume('"')) {
-      set_error(error, "expected string at byte " + std::to_string(pos_));
-      return false;
-    }
-
-    std::string value;
-    while (pos_ < text_.size()) {
-      const char c = text_[pos_++];
-      if (c == '"') {
-        out = std::move(value);
-        return true;
-      }
-      if (c == '\\') {
-        if (pos_ >= text_.size()) {
-          set_error(error, "unterminated escape in string");
-          return false;
-        }
-        const char e = text_[pos_++];
-        switch (e) {
-          case '"': value.push_back('"'); break;
-          case '\\': value.push_back('\\'); break;
-          case '/': value.push_back('/'); break;
-          case 'b': value.push_back('\b'); break;
-          case 'f': value.push_back('\f'); break;
-          case 'n': value.push_back('\n'); break;
-          case 'r': value.push_back('\r'); break;
-          case 't': value.push_back('\t'); break;
-          case 'u': {
-            if (pos_ + 4 > text_.size()) {
-              set_error(error, "incomplete unicode escape in string");
-              return false;
-            }
-            // Strict v1 parser accepts \uXXXX escapes but only preserves ASCII
-            // code points directly; non-ASCII is rejected to keep parser minimal.
-            unsigned int code = 0;
-            for (int i = 0; i < 4; ++i) {
-              const char h = text_[pos_++];
-              code <<= 4;
-              if (h >= '0' && h <= '9') {
-                code |= static_cast<unsigned int>(h - '0');
-              } else if (h >= 'a' && h <= 'f') {
-                code |= static_cast<unsigned int>(h - 'a' + 10);
-              } else if (h >= 'A' && h <= 'F') {
-                code |= static_cast<unsigned int>(h - 'A' + 10);
-              } else {
-                set_error(error, "invalid unicode escape in string");
-                return false;
-              }
-            }
-            if (code > 0x7F) {
-              set_error(error, "non-ascii unicode escape is not supported in strict v1 parser");
-              return false;
-            }
-            value.push_back(static_cast<char>(code));
-            break;
-          }
-          default:
-            set_error(error, "invalid escape sequence in string");
-            return false;
-        }
-      } else {
-        if (static_cast<unsigned char>(c) < 0x20) {
-          set_error(error, "control character in string");
-          return false;
-        }
-        value.push_back(c);
-      }
-    }
-
-    set_error(error, "unterminated string");
-    return false;
-  }
-
-  bool parse_integer(std::int64_t& out, std::string* error) {
-    const size_t start = pos_;
-    bool neg = false;
-    if (consume('-')) {
-      neg = true;
-    }
-    if (pos_ >= text_.size() || !std::isdigit(static_cast<unsigned char>(text_[pos_]))) {
-      set_error(error, "invalid number at byte " + std::to_string(start));
-      return false;
-    }
-    if (text_[pos_] == '0' && pos_ + 1 < text_.size() && std::isdigit(static_cast<unsigned char>(text_[pos_ + 1]))) {
-      set_error(error, "leading zero is not allowed for numbers");
-      return false;
-    }
-
-    std::int64_t value = 0;
-    while (pos_ < text_.size() && std::isdigit(static_cast<unsigned char>(text_[pos_]))) {
-      const int digit = text_[pos_] - '0';
-      if (value > (std::numeric_limits<std::int64_t>::max() - digit) / 10) {
-        set_error(error, "integer overflow in number literal");
-        return false;
-      }
-      value = value * 10 + digit;
-      ++pos_;
-    }
-
-    if (pos_ < text_.size()) {
-      const char c = text_[pos_];
-      if (c == '.' || c == 'e' || c == 'E') {
-        set_error(error, "non-integer numbers are not supported in strict v1 loader");
-        return false;
-      }
-    }
-
-    out = neg ? -value : value;
-    return true;
-  }
-
-  bool parse_array(JsonValue& out, std::string* error) {
-    if (!consume('[')) {
-      set_error(error, "expected '[' at byte " + std::to_string(pos_));
-      return false;
-    }
-
-    out = {};
-    out.type = JsonValue::Type::Array;
-
-    skip_ws();
-    if (consume(']')) {
-      return true;
-    }
-
-    for (;;) {
-      JsonValue element{};
-      if (!parse_value(element, error)) {
-        return false;
-      }
-      out.array_value.push_back(std::move(element));
-
-      skip_ws();
-      if (consume(']')) {
-        return true;
-      }
-      if (!consume(',')) {
-        set_error(error, "expected ',' or ']' in array at byte " + std::to_string(pos_));
-        return false;
-      }
-    }
-  }
-
-  bool parse_object(JsonValue& out, std::string* error) {
-    if (!consume('{')) {
-      set_error(error, "expected '{' at byte " + std::to_string(pos_));
-      return false;
-    }
-
-    out = {};
-    out.type = JsonValue::Type::Object;
-
-    skip_ws();
-    if (consume('}')) {
-      return true;
-    }
-
-    std::unordered_set<std::string> seen_keys;
-    for (;;) {
-      std::string key;
-      skip_ws();
-      if (!parse_string(key, error)) {
-        return false;
-      }
-      if (!seen_keys.emplace(key).second) {
-        set_error(error, "duplicate object key: " + key);
-        return false;
-      }
-      skip_ws();
-      if (!consume(':')) {
-        set_error(error, "expected ':' after key '" + key + "'");
-        return false;
-      }
-      JsonValue value{};
-      if (!parse_value(value, error)) {
-        return false;
-      }
-      out.object_value.emplace_back(std::move(key), std::move(value));
-
-      skip_ws();
-      if (consume('}')) {
-        return true;
-      }
-      if (!consume(',')) {
-        set_error(error, "expected ',' or '}' in object at byte " + std::to_string(pos_));
-        return false;
-      }
-    }
-  }
-
-private:
-  const std::string& text_;
-  size_t pos_ = 0;
-};
+using JsonValue = strict_json::Value;
 
 const JsonValue* find_field(const JsonValue& obj, const char* name) {
-  for (const auto& kv : obj.object_value) {
-    if (kv.first == name) {
-      return &kv.second;
-    }
-  }
-  return nullptr;
+  return obj.find(name);
 }
 
 bool require_only_fields(const JsonValue& obj,
                          const std::initializer_list<const char*>& allowed,
                          std::string* error,
                          const std::string& context) {
-  std::unordered_set<std::string> allowed_set;
-  allowed_set.reserve(allowed.size());
-  for (const auto* name : allowed) {
-    allowed_set.emplace(name);
-  }
-  for (const auto& kv : obj.object_value) {
-    if (allowed_set.find(kv.first) == allowed_set.end()) {
-      set_error(error, context + " contains unknown field: " + kv.first);
+  for (const JsonValue& member : obj.items()) {
+    if (std::find(allowed.begin(), allowed.end(), member.key) == allowed.end()) {
+      set_error(error, context + " contains unknown field: " + std::string(member.key));
       return false;
     }
   }
@@ -356,20 +50,20 @@ bool require_type(const JsonValue* value, JsonValue::Type type, const std::strin
 }
 
 bool parse_u32(const JsonValue& value, const std::string& field, std::uint32_t& out, std::string* error) {
-  if (value.type != JsonValue::Type::Number || value.number_value < 0 || value.number_value > static_cast<std::int64_t>(std::numeric_limits<std::uint32_t>::max())) {
+  if (value.type != JsonValue::Type::Number || value.integer_value < 0 || value.integer_value > static_cast<std::int64_t>(std::numeric_limits<std::uint32_t>::max())) {
     set_error(error, "field '" + field + "' must be uint32 integer");
     return false;
   }
-  out = static_cast<std::uint32_t>(value.number_value);
+  out = static_cast<std::uint32_t>(value.integer_value);
   return true;
 }
 
 bool parse_u64(const JsonValue& value, const std::string& field, std::uint64_t& out, std::string* error) {
-  if (value.type != JsonValue::Type::Number || value.number_value < 0) {
+  if (value.type != JsonValue::Type::Number || value.integer_value < 0) {
     set_error(error, "field '" + field + "' must be uint64 integer");
     return false;
   }
-  out = static_cast<std::uint64_t>(value.number_value);
+  out = static_cast<std::uint64_t>(value.integer_value);
   return true;
 }
 
@@ -381,7 +75,7 @@ bool parse_format_fourcc_json(const JsonValue& value,
     return parse_u32(value, field, out, error);
   }
   if (value.type == JsonValue::Type::String) {
-    if (!parse_fourcc_token(value.string_value, out)) {
+    if (!parse_fourcc_token(value.text, out)) {
       set_error(error, "field '" + field + "' must be uint32 integer or fourcc token");
       return false;
     }
@@ -492,7 +186,7 @@ bool parse_picture(const JsonValue& value,
     return false;
   }
 
-  out.preset = preset->string_value;
+  out.preset = preset->text;
   out.overlay_frame_index_offsets = overlay_offsets->bool_value;
   out.overlay_moving_bar = overlay_bar->bool_value;
   out.solid_r = static_cast<std::uint8_t>(r);
@@ -531,11 +225,11 @@ bool parse_document_object(const JsonValue& root,
   }
 
   out = {};
-  out.schema_version = static_cast<std::uint32_t>(schema_version->number_value);
+  out.schema_version = static_cast<std::uint32_t>(schema_version->integer_value);
 
-  out.devices.reserve(devices->array_value.size());
-  for (size_t i = 0; i < devices->array_value.size(); ++i) {
-    const auto& item = devices->array_value[i];
+  out.devices.reserve(devices->items().size());
+  for (size_t i = 0; i < devices->items().size(); ++i) {
+    const auto& item = devices->items()[i];
     const std::string ctx = "devices[" + std::to_string(i) + "]";
     if (item.type != JsonValue::Type::Object) {
       set_error(error, ctx + " must be object");
@@ -551,16 +245,16 @@ bool parse_document_object(const JsonValue& root,
       return false;
     }
     SyntheticScenarioLoaderParsedDevice d{};
-    d.key = key->string_value;
+    d.key = key->text;
     if (!parse_u32(*endpoint, ctx + ".endpoint_index", d.endpoint_index, error)) {
       return false;
     }
     out.devices.push_back(std::move(d));
   }
 
-  out.streams.reserve(streams->array_value.size());
-  for (size_t i = 0; i < streams->array_value.size(); ++i) {
-    const auto& item = streams->array_value[i];
+  out.streams.reserve(streams->items().size());
+  for (size_t i = 0; i < streams->items().size(); ++i) {
+    const auto& item = streams->items()[i];
     const std::string ctx = "streams[" + std::to_string(i) + "]";
     if (item.type != JsonValue::Type::Object) {
       set_error(error, ctx + " must be object");
@@ -582,9 +276,9 @@ bool parse_document_object(const JsonValue& root,
     }
 
     SyntheticScenarioLoaderParsedStream s{};
-    s.key = key->string_value;
-    s.device_key = device_key->string_value;
-    s.intent = intent->string_value;
+    s.key = key->text;
+    s.device_key = device_key->text;
+    s.intent = intent->text;
 
     if (!capture_profile) {
       set_error(error, "missing required field: " + ctx + ".capture_profile");
@@ -599,9 +293,9 @@ bool parse_document_object(const JsonValue& root,
 
 
   if (rigs) {
-    out.rigs.reserve(rigs->array_value.size());
-    for (size_t i = 0; i < rigs->array_value.size(); ++i) {
-      const auto& item = rigs->array_value[i];
+    out.rigs.reserve(rigs->items().size());
+    for (size_t i = 0; i < rigs->items().size(); ++i) {
+      const auto& item = rigs->items()[i];
       const std::string ctx = "rigs[" + std::to_string(i) + "]";
       if (item.type != JsonValue::Type::Object) { set_error(error, ctx + " must be object"); return false; }
       if (!require_only_fields(item, {"key", "rig_id", "members"}, error, ctx)) { return false; }
@@ -612,21 +306,21 @@ bool parse_document_object(const JsonValue& root,
           !require_type(rig_id, JsonValue::Type::Number, ctx + ".rig_id", error) ||
           !require_type(members, JsonValue::Type::Array, ctx + ".members", error)) { return false; }
       SyntheticScenarioLoaderParsedRig r{};
-      r.key = key->string_value;
+      r.key = key->text;
       if (!parse_u64(*rig_id, ctx + ".rig_id", r.rig_id, error)) { return false; }
-      r.members.reserve(members->array_value.size());
-      for (size_t j = 0; j < members->array_value.size(); ++j) {
-        const auto& m = members->array_value[j];
+      r.members.reserve(members->items().size());
+      for (size_t j = 0; j < members->items().size(); ++j) {
+        const auto& m = members->items()[j];
         if (m.type != JsonValue::Type::String) { set_error(error, ctx + ".members[" + std::to_string(j) + "] must be string"); return false; }
-        r.members.push_back(m.string_value);
+        r.members.emplace_back(m.text);
       }
       out.rigs.push_back(std::move(r));
     }
   }
 
-  out.timeline.reserve(timeline->array_value.size());
-  for (size_t i = 0; i < timeline->array_value.size(); ++i) {
-    const auto& item = timeline->array_value[i];
+  out.timeline.reserve(timeline->items().size());
+  for (size_t i = 0; i < timeline->items().size(); ++i) {
+    const auto& item = timeline->items()[i];
     const std::string ctx = "timeline[" + std::to_string(i) + "]";
     if (item.type != JsonValue::Type::Object) {
       set_error(error, ctx + " must be object");
@@ -647,7 +341,7 @@ bool parse_document_object(const JsonValue& root,
     if (!parse_u64(*at_ns, ctx + ".at_ns", a.at_ns, error)) {
       return false;
     }
-    a.type = type->string_value;
+    a.type = type->text;
 
     if (const JsonValue* device_key = find_field(item, "device_key")) {
       if (device_key->type != JsonValue::Type::String) {
@@ -655,7 +349,7 @@ bool parse_document_object(const JsonValue& root,
         return false;
       }
       a.has_device_key = true;
-      a.device_key = device_key->string_value;
+      a.device_key = device_key->text;
     }
 
     if (const JsonValue* stream_key = find_field(item, "stream_key")) {
@@ -664,7 +358,7 @@ bool parse_document_object(const JsonValue& root,
         return false;
       }
       a.has_stream_key = true;
-      a.stream_key = stream_key->string_value;
+      a.stream_key = stream_key->text;
     }
 
     if (const JsonValue* picture = find_field(item, "picture")) {
@@ -683,15 +377,17 @@ bool parse_document_object(const JsonValue& root,
 } // namespace
 
 bool parse_synthetic_scenario_loader_json_text(
-    const std::string& text,
+    std::string_view text,
     SyntheticScenarioLoaderParsedDocument& out,
     std::string* error) {
-  JsonParser parser(text);
-  JsonValue root{};
-  if (!parser.parse(root, error)) {
+  strict_json::ParseOptions options{};
+  options.integers_only = true;
+  options.ascii_unicode_escapes_only = true;
+  strict_json::Document document;
+  if (!document.parse(text, options, error)) {
     return false;
   }
-  return parse_document_object(root, out, error);
+  return parse_document_object(document.root(), out, error);
 }
 
 } // namespace cambang
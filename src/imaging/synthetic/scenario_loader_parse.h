@@ -2,6 +2,7 @@
 
 #include <cstdint>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace cambang {
@@ -66,7 +67,7 @@ struct SyntheticScenarioLoaderParsedDocument {
 };
 
 bool parse_synthetic_scenario_loader_json_text(
-    const std::string& text,
+    std::string_view text,
     SyntheticScenarioLoaderParsedDocument& out,
     std::string* error = nullptr);
 
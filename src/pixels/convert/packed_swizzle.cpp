@@ -0,0 +1,191 @@
+#include "pixels/convert/packed_swizzle.h"
+
+#include <cstring>
+
+#include "pixels/pixel_simd.h"
+
+namespace cambang {
+
+namespace {
+
+inline uint32_t swizzle_pixel(uint32_t bgra) noexcept {
+  // Little-endian lanes: byte 0 (B) and byte 2 (R) trade places; G stays.
+  return (bgra & 0x0000FF00u) | ((bgra >> 16) & 0x000000FFu) | ((bgra & 0x000000FFu) << 16) | 0xFF000000u;
+}
+
+} // namespace
+
+void swizzle_bgra_to_rgba_opaque(const uint8_t* src, uint8_t* dst, size_t pixel_count) noexcept {
+  size_t i = 0;
+#if defined(CAMBANG_PIXELS_SSE2)
+  // Same lane arithmetic as swizzle_pixel(), four pixels per step. pshufb
+  // (SSSE3) would save two ops but is not part of the x86-64 baseline.
+  const __m128i keep_g = _mm_set1_epi32(0x0000FF00);
+  const __m128i low_byte = _mm_set1_epi32(0x000000FF);
+  const __m128i opaque = _mm_set1_epi32(static_cast<int>(0xFF000000u));
+  for (; i + 4 <= pixel_count; i += 4) {
+    const __m128i px = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * 4u));
+    const __m128i g = _mm_and_si128(px, keep_g);
+    const __m128i r = _mm_and_si128(_mm_srli_epi32(px, 16), low_byte);
+    const __m128i b = _mm_slli_epi32(_mm_and_si128(px, low_byte), 16);
+    const __m128i out = _mm_or_si128(_mm_or_si128(g, r), _mm_or_si128(b, opaque));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * 4u), out);
+  }
+#elif defined(CAMBANG_PIXELS_NEON)
+  for (; i + 16 <= pixel_count; i += 16) {
+    const uint8x16x4_t bgra = vld4q_u8(src + i * 4u);
+    uint8x16x4_t rgba;
+    rgba.val[0] = bgra.val[2];
+    rgba.val[1] = bgra.val[1];
+    rgba.val[2] = bgra.val[0];
+    rgba.val[3] = vdupq_n_u8(0xFF);
+    vst4q_u8(dst + i * 4u, rgba);
+  }
+#endif
+  for (; i < pixel_count; ++i) {
+    uint32_t px = 0;
+    std::memcpy(&px, src + i * 4u, sizeof(px));
+    px = swizzle_pixel(px);
+    std::memcpy(dst + i * 4u, &px, sizeof(px));
+  }
+}
+
+void copy_bgra_opaque(const uint8_t* src, uint8_t* dst, size_t pixel_count) noexcept {
+  size_t i = 0;
+#if defined(CAMBANG_PIXELS_SSE2)
+  const __m128i opaque = _mm_set1_epi32(static_cast<int>(0xFF000000u));
+  for (; i + 4 <= pixel_count; i += 4) {
+    const __m128i px = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * 4u));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * 4u), _mm_or_si128(px, opaque));
+  }
+#elif defined(CAMBANG_PIXELS_NEON)
+  const uint32x4_t opaque = vdupq_n_u32(0xFF000000u);
+  for (; i + 4 <= pixel_count; i += 4) {
+    const uint32x4_t px = vreinterpretq_u32_u8(vld1q_u8(src + i * 4u));
+    vst1q_u8(dst + i * 4u, vreinterpretq_u8_u32(vorrq_u32(px, opaque)));
+  }
+#endif
+  for (; i < pixel_count; ++i) {
+    uint32_t px = 0;
+    std::memcpy(&px, src + i * 4u, sizeof(px));
+    px |= 0xFF000000u;
+    std::memcpy(dst + i * 4u, &px, sizeof(px));
+  }
+}
+
+void pack_packed32_as_rgb8(const uint8_t* src, uint8_t* dst, size_t pixel_count, bool bgra_source) noexcept {
+  const size_t r_at = bgra_source ? 2u : 0u;
+  const size_t b_at = bgra_source ? 0u : 2u;
+  size_t i = 0;
+#if defined(CAMBANG_PIXELS_SSE2)
+  // Four pixels per step without pshufb: each 64-bit lane joins its two
+  // pixels' RGB into six bytes, and the lanes are stored 6 bytes apart. The
+  // second store writes two bytes past this step's output, which the next
+  // pixel's bytes overwrite, hence the spare pixel in the loop bound.
+  const __m128i keep_g = _mm_set1_epi32(0x0000FF00);
+  const __m128i low_byte = _mm_set1_epi32(0x000000FF);
+  const __m128i first_rgb = _mm_set_epi32(0, 0x00FFFFFF, 0, 0x00FFFFFF);
+  const __m128i second_rgb = _mm_set_epi32(0x0000FFFF, static_cast<int>(0xFF000000u),
+                                           0x0000FFFF, static_cast<int>(0xFF000000u));
+  for (; i + 5 <= pixel_count; i += 4) {
+    __m128i px = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * 4u));
+    if (bgra_source) {
+      px = _mm_or_si128(_mm_and_si128(px, keep_g),
+                        _mm_or_si128(_mm_and_si128(_mm_srli_epi32(px, 16), low_byte),
+                                     _mm_slli_epi32(_mm_and_si128(px, low_byte), 16)));
+    }
+    const __m128i joined = _mm_or_si128(_mm_and_si128(px, first_rgb),
+                                        _mm_and_si128(_mm_srli_epi64(px, 8), second_rgb));
+    uint8_t* out = dst + i * 3u;
+    _mm_storel_epi64(reinterpret_cast<__m128i*>(out), joined);
+    _mm_storel_epi64(reinterpret_cast<__m128i*>(out + 6), _mm_srli_si128(joined, 8));
+  }
+#elif defined(CAMBANG_PIXELS_NEON)
+  for (; i + 16 <= pixel_count; i += 16) {
+    const uint8x16x4_t px = vld4q_u8(src + i * 4u);
+    uint8x16x3_t rgb;
+    rgb.val[0] = bgra_source ? px.val[2] : px.val[0];
+    rgb.val[1] = px.val[1];
+    rgb.val[2] = bgra_source ? px.val[0] : px.val[2];
+    vst3q_u8(dst + i * 3u, rgb);
+  }
+#endif
+  for (; i < pixel_count; ++i) {
+    const uint8_t* p = src + i * 4u;
+    uint8_t* out = dst + i * 3u;
+    out[0] = p[r_at];
+    out[1] = p[1];
+    out[2] = p[b_at];
+  }
+}
+
+void pack_packed32_as_luma8(const uint8_t* src, uint8_t* dst, size_t pixel_count, bool bgra_source) noexcept {
+  const uint32_t r_weight = 77u;
+  const uint32_t g_weight = 150u;
+  const uint32_t b_weight = 29u;
+  const size_t r_at = bgra_source ? 2u : 0u;
+  const size_t b_at = bgra_source ? 0u : 2u;
+  size_t i = 0;
+#if defined(CAMBANG_PIXELS_SSE2)
+  // pmaddwd sums (c0 * w0 + c1 * w1) and (c2 * w2 + a * 0) per pixel; one
+  // shuffle pass adds the two halves. Every term fits 16-bit lanes.
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i weights = bgra_source ? _mm_set_epi16(0, 77, 150, 29, 0, 77, 150, 29)
+                                      : _mm_set_epi16(0, 29, 150, 77, 0, 29, 150, 77);
+  const __m128i round = _mm_set1_epi32(128);
+  for (; i + 4 <= pixel_count; i += 4) {
+    const __m128i px = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * 4u));
+    const __m128i lo = _mm_madd_epi16(_mm_unpacklo_epi8(px, zero), weights);
+    const __m128i hi = _mm_madd_epi16(_mm_unpackhi_epi8(px, zero), weights);
+    const __m128i lo_sum = _mm_add_epi32(_mm_shuffle_epi32(lo, _MM_SHUFFLE(2, 0, 2, 0)),
+                                         _mm_shuffle_epi32(lo, _MM_SHUFFLE(3, 1, 3, 1)));
+    const __m128i hi_sum = _mm_add_epi32(_mm_shuffle_epi32(hi, _MM_SHUFFLE(2, 0, 2, 0)),
+                                         _mm_shuffle_epi32(hi, _MM_SHUFFLE(3, 1, 3, 1)));
+    const __m128i luma = _mm_srli_epi32(_mm_add_epi32(_mm_unpacklo_epi64(lo_sum, hi_sum), round), 8);
+    const __m128i bytes = _mm_packus_epi16(_mm_packs_epi32(luma, zero), zero);
+    const uint32_t word = static_cast<uint32_t>(_mm_cvtsi128_si32(bytes));
+    std::memcpy(dst + i, &word, sizeof(word));
+  }
+#elif defined(CAMBANG_PIXELS_NEON)
+  const uint8x8_t rw = vdup_n_u8(static_cast<uint8_t>(r_weight));
+  const uint8x8_t gw = vdup_n_u8(static_cast<uint8_t>(g_weight));
+  const uint8x8_t bw = vdup_n_u8(static_cast<uint8_t>(b_weight));
+  for (; i + 16 <= pixel_count; i += 16) {
+    const uint8x16x4_t px = vld4q_u8(src + i * 4u);
+    const uint8x16_t r = px.val[r_at];
+    const uint8x16_t g = px.val[1];
+    const uint8x16_t b = px.val[b_at];
+    uint16x8_t lo = vmull_u8(vget_low_u8(r), rw);
+    lo = vmlal_u8(lo, vget_low_u8(g), gw);
+    lo = vmlal_u8(lo, vget_low_u8(b), bw);
+    uint16x8_t hi = vmull_u8(vget_high_u8(r), rw);
+    hi = vmlal_u8(hi, vget_high_u8(g), gw);
+    hi = vmlal_u8(hi, vget_high_u8(b), bw);
+    // vrshrn adds the 128 before the shift.
+    vst1q_u8(dst + i, vcombine_u8(vrshrn_n_u16(lo, 8), vrshrn_n_u16(hi, 8)));
+  }
+#endif
+  for (; i < pixel_count; ++i) {
+    const uint8_t* p = src + i * 4u;
+    dst[i] = static_cast<uint8_t>((r_weight * p[r_at] + g_weight * p[1] + b_weight * p[b_at] + 128u) >> 8);
+  }
+}
+
+void convert_bgra_rows_to_packed_opaque(const uint8_t* src_row0,
+                                        ptrdiff_t src_pitch,
+                                        uint32_t width,
+                                        uint32_t height,
+                                        bool to_rgba,
+                                        uint8_t* dst) noexcept {
+  const size_t row_bytes = static_cast<size_t>(width) * 4u;
+  auto* const kernel = to_rgba ? &swizzle_bgra_to_rgba_opaque : &copy_bgra_opaque;
+  if (src_pitch == static_cast<ptrdiff_t>(row_bytes)) {
+    kernel(src_row0, dst, static_cast<size_t>(width) * static_cast<size_t>(height));
+    return;
+  }
+  for (uint32_t y = 0; y < height; ++y) {
+    kernel(src_row0 + src_pitch * static_cast<ptrdiff_t>(y), dst + row_bytes * y, width);
+  }
+}
+
+} // namespace cambang
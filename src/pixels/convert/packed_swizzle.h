@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace cambang {
+
+// Writes pixel_count packed 32-bit BGRA pixels from src as RGBA into dst,
+// forcing alpha to 0xFF. src and dst may alias exactly (in-place) but must not
+// otherwise overlap. Vectorized with SSE2 on x86-64 and NEON on AArch64 (both
+// architectural baselines, so no runtime dispatch); other targets use the
+// scalar loop, which also handles every tail.
+void swizzle_bgra_to_rgba_opaque(const uint8_t* src, uint8_t* dst, size_t pixel_count) noexcept;
+
+// Same contract, keeping BGRA channel order: a copy that forces alpha to 0xFF
+// in the same pass instead of a memcpy followed by a per-pixel alpha write.
+void copy_bgra_opaque(const uint8_t* src, uint8_t* dst, size_t pixel_count) noexcept;
+
+// Writes pixel_count packed 32-bit RGBA (or BGRA, with bgra_source) pixels
+// from src as 24-bit RGB into dst, dropping alpha. src and dst must not
+// overlap. SSE2 / NEON as above.
+void pack_packed32_as_rgb8(const uint8_t* src, uint8_t* dst, size_t pixel_count, bool bgra_source) noexcept;
+
+// Same source contract, writing one byte of integer BT.601 luma per pixel:
+// (77 R + 150 G + 29 B + 128) >> 8, as PackedTransformOutput::LUMA8.
+void pack_packed32_as_luma8(const uint8_t* src, uint8_t* dst, size_t pixel_count, bool bgra_source) noexcept;
+
+// Converts a height-row BGRA image whose rows are src_pitch bytes apart into
+// tightly packed opaque RGBA (to_rgba) or BGRA at dst. A tight pitch is
+// processed as one span so the vector loop never restarts per row. Callers
+// own all bounds validation; src_pitch may be negative (bottom-up images).
+void convert_bgra_rows_to_packed_opaque(const uint8_t* src_row0,
+                                        ptrdiff_t src_pitch,
+                                        uint32_t width,
+                                        uint32_t height,
+                                        bool to_rgba,
+                                        uint8_t* dst) noexcept;
+
+} // namespace cambang
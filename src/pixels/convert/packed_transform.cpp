@@ -0,0 +1,329 @@
+#include "pixels/convert/packed_transform.h"
+
+#include <cstring>
+
+#include "pixels/convert/packed_swizzle.h"
+
+#include "pixels/pixel_simd.h"
+
+namespace cambang {
+
+namespace {
+
+// Output index o of out_extent covers source [begin, end) of extent, both
+// relative to the crop origin.
+inline void output_span(uint32_t o,
+                        uint32_t downscale,
+                        uint32_t extent,
+                        uint32_t out_extent,
+                        uint32_t& begin,
+                        uint32_t& end) noexcept {
+  if (downscale != 1) {
+    begin = o * downscale;
+    end = begin + downscale < extent ? begin + downscale : extent;
+    return;
+  }
+  begin = static_cast<uint32_t>(static_cast<uint64_t>(o) * extent / out_extent);
+  end = static_cast<uint32_t>(static_cast<uint64_t>(o + 1u) * extent / out_extent);
+}
+
+// Per-channel sums of a cols x rows box of packed 32-bit pixels. Pairs of
+// pixels accumulate in 16-bit lanes (one channel of one pixel each), flushed
+// to 32 bits before 257 additions could overflow them; an odd last column is
+// added separately.
+void box_sum(const uint8_t* p, size_t stride, uint32_t cols, uint32_t rows, uint32_t sum[4]) noexcept {
+  const uint32_t pairs = cols / 2u;
+  sum[0] = sum[1] = sum[2] = sum[3] = 0;
+#if defined(CAMBANG_PIXELS_SSE2)
+  if (pairs != 0) {
+    const __m128i zero = _mm_setzero_si128();
+    __m128i acc16 = zero;
+    __m128i acc32 = zero;
+    uint32_t pending = 0;
+    for (uint32_t y = 0; y < rows; ++y) {
+      const uint8_t* row = p + static_cast<size_t>(y) * stride;
+      for (uint32_t i = 0; i < pairs; ++i) {
+        const __m128i px = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(row + static_cast<size_t>(i) * 8u));
+        acc16 = _mm_add_epi16(acc16, _mm_unpacklo_epi8(px, zero));
+        if (++pending == 256u) {
+          acc32 = _mm_add_epi32(acc32, _mm_add_epi32(_mm_unpacklo_epi16(acc16, zero),
+                                                     _mm_unpackhi_epi16(acc16, zero)));
+          acc16 = zero;
+          pending = 0;
+        }
+      }
+    }
+    acc32 = _mm_add_epi32(acc32, _mm_add_epi32(_mm_unpacklo_epi16(acc16, zero),
+                                               _mm_unpackhi_epi16(acc16, zero)));
+    alignas(16) uint32_t lanes[4];
+    _mm_store_si128(reinterpret_cast<__m128i*>(lanes), acc32);
+    sum[0] = lanes[0];
+    sum[1] = lanes[1];
+    sum[2] = lanes[2];
+    sum[3] = lanes[3];
+  }
+#elif defined(CAMBANG_PIXELS_NEON)
+  if (pairs != 0) {
+    uint16x8_t acc16 = vdupq_n_u16(0);
+    uint32x4_t acc32 = vdupq_n_u32(0);
+    uint32_t pending = 0;
+    for (uint32_t y = 0; y < rows; ++y) {
+      const uint8_t* row = p + static_cast<size_t>(y) * stride;
+      for (uint32_t i = 0; i < pairs; ++i) {
+        acc16 = vaddw_u8(acc16, vld1_u8(row + static_cast<size_t>(i) * 8u));
+        if (++pending == 256u) {
+          acc32 = vaddw_u16(vaddw_u16(acc32, vget_low_u16(acc16)), vget_high_u16(acc16));
+          acc16 = vdupq_n_u16(0);
+          pending = 0;
+        }
+      }
+    }
+    acc32 = vaddw_u16(vaddw_u16(acc32, vget_low_u16(acc16)), vget_high_u16(acc16));
+    vst1q_u32(sum, acc32);
+  }
+#else
+  for (uint32_t y = 0; y < rows; ++y) {
+    const uint8_t* row = p + static_cast<size_t>(y) * stride;
+    for (uint32_t i = 0; i < pairs * 2u; ++i) {
+      sum[0] += row[i * 4u + 0u];
+      sum[1] += row[i * 4u + 1u];
+      sum[2] += row[i * 4u + 2u];
+      sum[3] += row[i * 4u + 3u];
+    }
+  }
+#endif
+  if ((cols & 1u) != 0) {
+    for (uint32_t y = 0; y < rows; ++y) {
+      const uint8_t* px = p + static_cast<size_t>(y) * stride + static_cast<size_t>(pairs) * 8u;
+      sum[0] += px[0];
+      sum[1] += px[1];
+      sum[2] += px[2];
+      sum[3] += px[3];
+    }
+  }
+}
+
+// Rounded (sum + count / 2) / count, a shift for the power-of-two boxes of
+// the usual 1/2, 1/4 and 1/8 downscales.
+inline uint32_t box_average(uint32_t sum, uint32_t count, uint32_t pow2_shift) noexcept {
+  return pow2_shift != 0 ? (sum + (count >> 1)) >> pow2_shift : (sum + count / 2u) / count;
+}
+
+inline uint32_t pow2_shift_of(uint32_t count) noexcept {
+  if (count < 2u || (count & (count - 1u)) != 0) {
+    return 0;
+  }
+  uint32_t shift = 0;
+  while ((1u << shift) != count) {
+    ++shift;
+  }
+  return shift;
+}
+
+inline uint8_t luma_bt601(uint32_t r, uint32_t g, uint32_t b) noexcept {
+  return static_cast<uint8_t>((77u * r + 150u * g + 29u * b + 128u) >> 8);
+}
+
+inline void store_output(const PackedTransform& transform,
+                         uint32_t r,
+                         uint32_t g,
+                         uint32_t b,
+                         uint32_t a,
+                         uint8_t* out) noexcept {
+  if (transform.use_lut) {
+    r = transform.lut[r];
+    g = transform.lut[g];
+    b = transform.lut[b];
+  }
+  switch (transform.output) {
+    case PackedTransformOutput::RGBA8:
+      out[0] = static_cast<uint8_t>(r);
+      out[1] = static_cast<uint8_t>(g);
+      out[2] = static_cast<uint8_t>(b);
+      out[3] = static_cast<uint8_t>(a);
+      break;
+    case PackedTransformOutput::BGRA8:
+      out[0] = static_cast<uint8_t>(b);
+      out[1] = static_cast<uint8_t>(g);
+      out[2] = static_cast<uint8_t>(r);
+      out[3] = static_cast<uint8_t>(a);
+      break;
+    case PackedTransformOutput::LUMA8:
+      out[0] = luma_bt601(r, g, b);
+      break;
+    case PackedTransformOutput::RGB8:
+      out[0] = static_cast<uint8_t>(r);
+      out[1] = static_cast<uint8_t>(g);
+      out[2] = static_cast<uint8_t>(b);
+      break;
+  }
+}
+
+// Crop and convert only: one memcpy or packed_swizzle call per row.
+bool copy_row_packed(const PackedTransform& transform,
+                     bool bgra_source,
+                     const uint8_t* src,
+                     uint8_t* dst,
+                     uint32_t width) noexcept {
+  if (transform.use_lut) {
+    return false;
+  }
+  if (!bgra_source && transform.output == PackedTransformOutput::RGBA8) {
+    std::memcpy(dst, src, static_cast<size_t>(width) * 4u);
+    return true;
+  }
+  if (bgra_source && transform.output == PackedTransformOutput::RGBA8) {
+    swizzle_bgra_to_rgba_opaque(src, dst, width);
+    return true;
+  }
+  if (bgra_source && transform.output == PackedTransformOutput::BGRA8) {
+    copy_bgra_opaque(src, dst, width);
+    return true;
+  }
+  if (transform.output == PackedTransformOutput::RGB8) {
+    pack_packed32_as_rgb8(src, dst, width, bgra_source);
+    return true;
+  }
+  if (transform.output == PackedTransformOutput::LUMA8) {
+    pack_packed32_as_luma8(src, dst, width, bgra_source);
+    return true;
+  }
+  return false;
+}
+
+} // namespace
+
+bool resolve_packed_transform(const PackedTransform& transform,
+                              uint32_t src_width,
+                              uint32_t src_height,
+                              PackedTransformGeometry& out) noexcept {
+  if (src_width == 0 || src_height == 0 || transform.downscale == 0) {
+    return false;
+  }
+  PackedTransformGeometry g{};
+  if (transform.crop_width == 0 || transform.crop_height == 0) {
+    g.crop_width = src_width;
+    g.crop_height = src_height;
+  } else {
+    if (transform.crop_x >= src_width || transform.crop_y >= src_height ||
+        transform.crop_width > src_width - transform.crop_x ||
+        transform.crop_height > src_height - transform.crop_y) {
+      return false;
+    }
+    g.crop_x = transform.crop_x;
+    g.crop_y = transform.crop_y;
+    g.crop_width = transform.crop_width;
+    g.crop_height = transform.crop_height;
+  }
+  if (transform.target_width != 0 || transform.target_height != 0) {
+    if (transform.downscale != 1) {
+      return false;
+    }
+    const uint64_t cw = g.crop_width;
+    const uint64_t ch = g.crop_height;
+    uint64_t tw = transform.target_width;
+    uint64_t th = transform.target_height;
+    if (tw == 0) {
+      tw = (cw * th + ch / 2u) / ch;
+      tw = tw == 0 ? 1u : tw;
+    } else if (th == 0) {
+      th = (ch * tw + cw / 2u) / cw;
+      th = th == 0 ? 1u : th;
+    }
+    if (tw > cw || th > ch) {
+      return false;
+    }
+    g.width = static_cast<uint32_t>(tw);
+    g.height = static_cast<uint32_t>(th);
+    g.max_source_rows = static_cast<uint32_t>((ch + th - 1u) / th);
+  } else {
+    const uint32_t ds = transform.downscale;
+    g.width = g.crop_width / ds + (g.crop_width % ds != 0 ? 1u : 0u);
+    g.height = g.crop_height / ds + (g.crop_height % ds != 0 ? 1u : 0u);
+    g.max_source_rows = ds < g.crop_height ? ds : g.crop_height;
+  }
+  switch (transform.output) {
+    case PackedTransformOutput::LUMA8:
+      g.bytes_per_pixel = 1u;
+      break;
+    case PackedTransformOutput::RGB8:
+      g.bytes_per_pixel = 3u;
+      break;
+    default:
+      g.bytes_per_pixel = 4u;
+      break;
+  }
+  out = g;
+  return true;
+}
+
+void packed_transform_source_rows(const PackedTransform& transform,
+                                  const PackedTransformGeometry& geometry,
+                                  uint32_t out_row,
+                                  uint32_t& begin,
+                                  uint32_t& end) noexcept {
+  output_span(out_row, transform.downscale, geometry.crop_height, geometry.height, begin, end);
+  begin += geometry.crop_y;
+  end += geometry.crop_y;
+}
+
+void apply_packed_transform_rows(const PackedTransform& transform,
+                                 const PackedTransformGeometry& geometry,
+                                 const uint8_t* src,
+                                 size_t src_stride,
+                                 uint32_t src_row_base,
+                                 bool bgra_source,
+                                 uint32_t out_row_begin,
+                                 uint32_t out_row_end,
+                                 uint8_t* dst,
+                                 size_t dst_stride) noexcept {
+  const uint32_t ds = transform.downscale;
+  const bool unscaled = geometry.width == geometry.crop_width && geometry.height == geometry.crop_height;
+  // Channel byte offsets of R and B in the source.
+  const uint32_t r_at = bgra_source ? 2u : 0u;
+  const uint32_t b_at = bgra_source ? 0u : 2u;
+
+  for (uint32_t oy = out_row_begin; oy < out_row_end; ++oy) {
+    uint32_t sy0 = 0;
+    uint32_t sy1 = 0;
+    packed_transform_source_rows(transform, geometry, oy, sy0, sy1);
+    const uint8_t* src_row0 = src + static_cast<size_t>(sy0 - src_row_base) * src_stride +
+                              static_cast<size_t>(geometry.crop_x) * 4u;
+    uint8_t* out = dst + static_cast<size_t>(oy) * dst_stride;
+    if (unscaled) {
+      if (copy_row_packed(transform, bgra_source, src_row0, out, geometry.width)) {
+        continue;
+      }
+      for (uint32_t ox = 0; ox < geometry.width; ++ox) {
+        const uint8_t* p = src_row0 + static_cast<size_t>(ox) * 4u;
+        store_output(transform, p[r_at], p[1], p[b_at], bgra_source ? 0xFFu : p[3],
+                     out + static_cast<size_t>(ox) * geometry.bytes_per_pixel);
+      }
+      continue;
+    }
+
+    const uint32_t rows = sy1 - sy0;
+    uint32_t last_count = 0;
+    uint32_t shift = 0;
+    for (uint32_t ox = 0; ox < geometry.width; ++ox) {
+      uint32_t sx0 = 0;
+      uint32_t sx1 = 0;
+      output_span(ox, ds, geometry.crop_width, geometry.width, sx0, sx1);
+      uint32_t sum[4];
+      box_sum(src_row0 + static_cast<size_t>(sx0) * 4u, src_stride, sx1 - sx0, rows, sum);
+      const uint32_t count = rows * (sx1 - sx0);
+      if (count != last_count) {
+        last_count = count;
+        shift = pow2_shift_of(count);
+      }
+      store_output(transform,
+                   box_average(sum[r_at], count, shift),
+                   box_average(sum[1], count, shift),
+                   box_average(sum[b_at], count, shift),
+                   bgra_source ? 0xFFu : box_average(sum[3], count, shift),
+                   out + static_cast<size_t>(ox) * geometry.bytes_per_pixel);
+    }
+  }
+}
+
+} // namespace cambang
@@ -0,0 +1,103 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace cambang {
+
+enum class PackedTransformOutput : uint8_t {
+  RGBA8 = 0,
+  BGRA8 = 1,
+  // One byte per pixel: integer BT.601 luma, (77 R + 150 G + 29 B + 128) >> 8.
+  LUMA8 = 2,
+  // Three bytes per pixel, R G B; alpha is dropped.
+  RGB8 = 3,
+};
+
+// A chain of per-pixel post-processing steps over one packed 32-bit RGBA or
+// BGRA image, applied in one pass: crop, integer box downscale, per-channel
+// LUT, then conversion to the output format. Each source pixel is read once
+// and each output pixel written once, instead of one full-frame pass (and
+// one intermediate image) per step.
+struct PackedTransform {
+  // Source rectangle; a zero width or height selects the whole image.
+  uint32_t crop_x = 0;
+  uint32_t crop_y = 0;
+  uint32_t crop_width = 0;
+  uint32_t crop_height = 0;
+  // Each output pixel averages a downscale x downscale block of the crop
+  // (1: no scaling). Blocks cut by the crop's right or bottom edge average
+  // the pixels they have.
+  uint32_t downscale = 1;
+  // A fixed output size instead (downscale must stay 1): each output pixel
+  // averages the area of the crop it covers. With one of the two zero, it
+  // follows the crop's aspect ratio. Never larger than the crop.
+  uint32_t target_width = 0;
+  uint32_t target_height = 0;
+  PackedTransformOutput output = PackedTransformOutput::RGBA8;
+  // When use_lut, R, G and B are mapped through lut after the downscale.
+  bool use_lut = false;
+  std::array<uint8_t, 256> lut{};
+
+  bool operator==(const PackedTransform& o) const noexcept {
+    return crop_x == o.crop_x && crop_y == o.crop_y && crop_width == o.crop_width &&
+           crop_height == o.crop_height && downscale == o.downscale && target_width == o.target_width &&
+           target_height == o.target_height && output == o.output &&
+           use_lut == o.use_lut && (!use_lut || lut == o.lut);
+  }
+};
+
+// A PackedTransform resolved against a source size.
+struct PackedTransformGeometry {
+  uint32_t crop_x = 0;
+  uint32_t crop_y = 0;
+  uint32_t crop_width = 0;
+  uint32_t crop_height = 0;
+  uint32_t width = 0;  // output
+  uint32_t height = 0; // output
+  uint32_t bytes_per_pixel = 0;
+  // Source rows read by any one output row.
+  uint32_t max_source_rows = 0;
+
+  size_t tight_size_bytes() const noexcept {
+    return static_cast<size_t>(width) * height * bytes_per_pixel;
+  }
+};
+
+// False when transform does not fit a src_width x src_height image: an empty
+// source, a crop reaching outside it, a zero downscale, or a target size
+// combined with a downscale or larger than the crop.
+bool resolve_packed_transform(const PackedTransform& transform,
+                              uint32_t src_width,
+                              uint32_t src_height,
+                              PackedTransformGeometry& out) noexcept;
+
+// The source rows [begin, end) that output row out_row averages.
+void packed_transform_source_rows(const PackedTransform& transform,
+                                  const PackedTransformGeometry& geometry,
+                                  uint32_t out_row,
+                                  uint32_t& begin,
+                                  uint32_t& end) noexcept;
+
+// Writes output rows [out_row_begin, out_row_end) to dst, whose rows are
+// dst_stride bytes apart and which points at output row 0. src holds source
+// rows src_stride bytes apart, starting with source row src_row_base, and
+// must hold every source row those output rows read. With bgra_source, the
+// source is BGRA and its alpha is ignored (output alpha is 0xFF, as for
+// swizzle_bgra_to_rgba_opaque); an RGBA source's alpha is averaged through.
+// Crop-and-convert rows without scaling or a LUT take the vectorized
+// packed_swizzle kernels; scaled rows sum their boxes with SSE2 or NEON,
+// byte-identical to the scalar loop. Callers own all bounds validation.
+void apply_packed_transform_rows(const PackedTransform& transform,
+                                 const PackedTransformGeometry& geometry,
+                                 const uint8_t* src,
+                                 size_t src_stride,
+                                 uint32_t src_row_base,
+                                 bool bgra_source,
+                                 uint32_t out_row_begin,
+                                 uint32_t out_row_end,
+                                 uint8_t* dst,
+                                 size_t dst_stride) noexcept;
+
+} // namespace cambang
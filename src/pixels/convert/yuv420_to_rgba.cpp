@@ -0,0 +1,263 @@
+#include "pixels/convert/yuv420_to_rgba.h"
+
+#include "pixels/pixel_simd.h"
+
+// 32-bit ARM: NEON is an optional extension there, so pixel_simd.h leaves it
+// off. Android armeabi-v7a builds may still emit it; this kernel asks the
+// running CPU before taking the vector path.
+#if !defined(CAMBANG_PIXELS_NEON) && defined(__ARM_NEON) && !defined(__aarch64__) && defined(__linux__) && \
+    !(defined(CAMBANG_PIXELS_FORCE_SCALAR) && CAMBANG_PIXELS_FORCE_SCALAR)
+#define CAMBANG_YUV420_NEON_RUNTIME 1
+#include <arm_neon.h>
+#include <asm/hwcap.h>
+#include <sys/auxv.h>
+#endif
+
+namespace cambang {
+
+namespace {
+
+inline uint8_t clamp_u8(int32_t v) {
+  return static_cast<uint8_t>(v < 0 ? 0 : (v > 255 ? 255 : v));
+}
+
+// Converts columns [col_begin, width) of one row. This is the reference
+// kernel: the vector paths below must stay bit-identical to it, and it also
+// finishes the tail of every row they leave behind.
+void convert_yuv420_row_scalar(const uint8_t* y_row,
+                               const uint8_t* u_row,
+                               const uint8_t* v_row,
+                               size_t uv_pixel_stride,
+                               uint32_t col_begin,
+                               uint32_t width,
+                               bool to_rgba,
+                               uint8_t* out) {
+  for (uint32_t col = col_begin; col < width; ++col) {
+    const size_t uv_index = uv_pixel_stride * static_cast<size_t>(col / 2u);
+    const int32_t c = static_cast<int32_t>(y_row[col]) - 16;
+    const int32_t d = static_cast<int32_t>(u_row[uv_index]) - 128;
+    const int32_t e = static_cast<int32_t>(v_row[uv_index]) - 128;
+    const uint8_t r = clamp_u8((298 * c + 409 * e + 128) >> 8);
+    const uint8_t g = clamp_u8((298 * c - 100 * d - 208 * e + 128) >> 8);
+    const uint8_t b = clamp_u8((298 * c + 516 * d + 128) >> 8);
+    uint8_t* px = out + 4u * static_cast<size_t>(col);
+    px[0] = to_rgba ? r : b;
+    px[1] = g;
+    px[2] = to_rgba ? b : r;
+    px[3] = 0xFF;
+  }
+}
+
+// The vector paths convert 16-pixel blocks of the two layouts real sources
+// hand over: planar (uv_pixel_stride == 1) and semiplanar NV12/NV21
+// (uv_pixel_stride == 2); anything else is left to the scalar kernel. A
+// semiplanar block reads 16 chroma bytes for 8 samples, one byte past the
+// last sample it needs, so it only runs while the next block's first chroma
+// sample is still inside the image's chroma extent.
+inline uint32_t vector_block_span(size_t uv_pixel_stride) noexcept {
+  return uv_pixel_stride == 2 ? 18u : 16u;
+}
+
+#if defined(CAMBANG_PIXELS_SSE2)
+
+// One channel for 4 pixels: pmaddwd forms 298 * c + d_coeff * d and
+// e_coeff * e + 128 * 1 exactly in 32 bits, as the scalar int32 math does.
+inline __m128i yuv420_sse2_channel_half(__m128i cd, __m128i e1, __m128i cd_weights, __m128i e1_weights) noexcept {
+  const __m128i sum = _mm_add_epi32(_mm_madd_epi16(cd, cd_weights), _mm_madd_epi16(e1, e1_weights));
+  return _mm_srai_epi32(sum, 8);
+}
+
+// 8 pixels of one channel as saturated int16 (every value fits; the final
+// packus is the scalar clamp_u8).
+inline __m128i yuv420_sse2_channel(__m128i c, __m128i d, __m128i e, int16_t d_coeff, int16_t e_coeff) noexcept {
+  const __m128i one = _mm_set1_epi16(1);
+  const __m128i cd_weights = _mm_set_epi16(d_coeff, 298, d_coeff, 298, d_coeff, 298, d_coeff, 298);
+  const __m128i e1_weights = _mm_set_epi16(128, e_coeff, 128, e_coeff, 128, e_coeff, 128, e_coeff);
+  const __m128i lo = yuv420_sse2_channel_half(_mm_unpacklo_epi16(c, d), _mm_unpacklo_epi16(e, one), cd_weights,
+                                              e1_weights);
+  const __m128i hi = yuv420_sse2_channel_half(_mm_unpackhi_epi16(c, d), _mm_unpackhi_epi16(e, one), cd_weights,
+                                              e1_weights);
+  return _mm_packs_epi32(lo, hi);
+}
+
+// Eight chroma samples as int16 minus 128.
+inline __m128i yuv420_sse2_load_chroma(const uint8_t* row, size_t uv_index, bool semiplanar) noexcept {
+  const __m128i zero = _mm_setzero_si128();
+  __m128i wide;
+  if (semiplanar) {
+    // Even bytes are this plane's samples; the odd ones belong to the other.
+    wide = _mm_and_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(row + uv_index)), _mm_set1_epi16(0x00FF));
+  } else {
+    wide = _mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(row + uv_index)), zero);
+  }
+  return _mm_sub_epi16(wide, _mm_set1_epi16(128));
+}
+
+uint32_t convert_yuv420_row_vector(const uint8_t* y_row,
+                                   const uint8_t* u_row,
+                                   const uint8_t* v_row,
+                                   size_t uv_pixel_stride,
+                                   uint32_t width,
+                                   bool to_rgba,
+                                   uint8_t* out) {
+  if (uv_pixel_stride != 1 && uv_pixel_stride != 2) {
+    return 0;
+  }
+  const bool semiplanar = (uv_pixel_stride == 2);
+  const uint32_t block_span = vector_block_span(uv_pixel_stride);
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i y_offset = _mm_set1_epi16(16);
+  const __m128i alpha = _mm_set1_epi8(static_cast<char>(0xFF));
+
+  uint32_t col = 0;
+  for (; col + block_span <= width; col += 16u) {
+    const __m128i y = _mm_loadu_si128(reinterpret_cast<const __m128i*>(y_row + col));
+    const size_t uv_index = uv_pixel_stride * (col / 2u);
+    const __m128i d = yuv420_sse2_load_chroma(u_row, uv_index, semiplanar);
+    const __m128i e = yuv420_sse2_load_chroma(v_row, uv_index, semiplanar);
+    // Each chroma sample covers two horizontal luma samples.
+    const __m128i d_lo = _mm_unpacklo_epi16(d, d);
+    const __m128i d_hi = _mm_unpackhi_epi16(d, d);
+    const __m128i e_lo = _mm_unpacklo_epi16(e, e);
+    const __m128i e_hi = _mm_unpackhi_epi16(e, e);
+    const __m128i c_lo = _mm_sub_epi16(_mm_unpacklo_epi8(y, zero), y_offset);
+    const __m128i c_hi = _mm_sub_epi16(_mm_unpackhi_epi8(y, zero), y_offset);
+
+    const __m128i r = _mm_packus_epi16(yuv420_sse2_channel(c_lo, d_lo, e_lo, 0, 409),
+                                       yuv420_sse2_channel(c_hi, d_hi, e_hi, 0, 409));
+    const __m128i g = _mm_packus_epi16(yuv420_sse2_channel(c_lo, d_lo, e_lo, -100, -208),
+                                       yuv420_sse2_channel(c_hi, d_hi, e_hi, -100, -208));
+    const __m128i b = _mm_packus_epi16(yuv420_sse2_channel(c_lo, d_lo, e_lo, 516, 0),
+                                       yuv420_sse2_channel(c_hi, d_hi, e_hi, 516, 0));
+
+    const __m128i first = to_rgba ? r : b;
+    const __m128i third = to_rgba ? b : r;
+    const __m128i fg_lo = _mm_unpacklo_epi8(first, g);
+    const __m128i fg_hi = _mm_unpackhi_epi8(first, g);
+    const __m128i ta_lo = _mm_unpacklo_epi8(third, alpha);
+    const __m128i ta_hi = _mm_unpackhi_epi8(third, alpha);
+    uint8_t* dst = out + 4u * static_cast<size_t>(col);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), _mm_unpacklo_epi16(fg_lo, ta_lo));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 16), _mm_unpackhi_epi16(fg_lo, ta_lo));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 32), _mm_unpacklo_epi16(fg_hi, ta_hi));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 48), _mm_unpackhi_epi16(fg_hi, ta_hi));
+  }
+  return col;
+}
+
+#elif defined(CAMBANG_PIXELS_NEON) || defined(CAMBANG_YUV420_NEON_RUNTIME)
+
+// One 8-pixel channel: ((298 * c + chroma_term + 128) >> 8) clamped to
+// [0, 255]. Widens to 32 bits exactly where the scalar kernel's int32 math
+// does; vqmovun/vqmovn saturation is the scalar clamp_u8.
+inline uint8x8_t yuv420_neon_channel(int16x8_t c,
+                                     int16x8_t d,
+                                     int16_t d_coeff,
+                                     int16x8_t e,
+                                     int16_t e_coeff) noexcept {
+  const int32x4_t bias = vdupq_n_s32(128);
+  int32x4_t lo = vmlal_n_s16(bias, vget_low_s16(c), 298);
+  int32x4_t hi = vmlal_n_s16(bias, vget_high_s16(c), 298);
+  lo = vmlal_n_s16(lo, vget_low_s16(d), d_coeff);
+  hi = vmlal_n_s16(hi, vget_high_s16(d), d_coeff);
+  lo = vmlal_n_s16(lo, vget_low_s16(e), e_coeff);
+  hi = vmlal_n_s16(hi, vget_high_s16(e), e_coeff);
+  const uint16x8_t clamped =
+      vcombine_u16(vqmovun_s32(vshrq_n_s32(lo, 8)), vqmovun_s32(vshrq_n_s32(hi, 8)));
+  return vqmovn_u16(clamped);
+}
+
+uint32_t convert_yuv420_row_vector(const uint8_t* y_row,
+                                   const uint8_t* u_row,
+                                   const uint8_t* v_row,
+                                   size_t uv_pixel_stride,
+                                   uint32_t width,
+                                   bool to_rgba,
+                                   uint8_t* out) {
+#if defined(CAMBANG_YUV420_NEON_RUNTIME)
+  static const bool available = (getauxval(AT_HWCAP) & HWCAP_NEON) != 0;
+  if (!available) {
+    return 0;
+  }
+#endif
+  if (uv_pixel_stride != 1 && uv_pixel_stride != 2) {
+    return 0;
+  }
+  const bool semiplanar = (uv_pixel_stride == 2);
+  const uint32_t block_span = vector_block_span(uv_pixel_stride);
+  const int16x8_t y_offset = vdupq_n_s16(16);
+  const int16x8_t uv_offset = vdupq_n_s16(128);
+  const uint8x16_t alpha = vdupq_n_u8(0xFF);
+
+  uint32_t col = 0;
+  for (; col + block_span <= width; col += 16u) {
+    const uint8x16_t y = vld1q_u8(y_row + col);
+    const size_t uv_index = uv_pixel_stride * (col / 2u);
+    uint8x8_t u8;
+    uint8x8_t v8;
+    if (semiplanar) {
+      u8 = vld2_u8(u_row + uv_index).val[0];
+      v8 = vld2_u8(v_row + uv_index).val[0];
+    } else {
+      u8 = vld1_u8(u_row + uv_index);
+      v8 = vld1_u8(v_row + uv_index);
+    }
+
+    const int16x8_t d = vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(u8)), uv_offset);
+    const int16x8_t e = vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(v8)), uv_offset);
+    // Each chroma sample covers two horizontal luma samples.
+    const int16x8x2_t dd = vzipq_s16(d, d);
+    const int16x8x2_t ee = vzipq_s16(e, e);
+    const int16x8_t c_lo =
+        vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(vget_low_u8(y))), y_offset);
+    const int16x8_t c_hi =
+        vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(vget_high_u8(y))), y_offset);
+
+    const uint8x16_t r =
+        vcombine_u8(yuv420_neon_channel(c_lo, dd.val[0], 0, ee.val[0], 409),
+                    yuv420_neon_channel(c_hi, dd.val[1], 0, ee.val[1], 409));
+    const uint8x16_t g =
+        vcombine_u8(yuv420_neon_channel(c_lo, dd.val[0], -100, ee.val[0], -208),
+                    yuv420_neon_channel(c_hi, dd.val[1], -100, ee.val[1], -208));
+    const uint8x16_t b =
+        vcombine_u8(yuv420_neon_channel(c_lo, dd.val[0], 516, ee.val[0], 0),
+                    yuv420_neon_channel(c_hi, dd.val[1], 516, ee.val[1], 0));
+
+    uint8x16x4_t px;
+    px.val[0] = to_rgba ? r : b;
+    px.val[1] = g;
+    px.val[2] = to_rgba ? b : r;
+    px.val[3] = alpha;
+    vst4q_u8(out + 4u * col, px);
+  }
+  return col;
+}
+
+#endif
+
+} // namespace
+
+void convert_yuv420_rows_to_packed(
+    const Yuv420Source& src,
+    uint32_t width,
+    uint32_t row_begin,
+    uint32_t row_end,
+    bool to_rgba,
+    uint8_t* dst,
+    size_t dst_stride_bytes) {
+  const size_t uv_pixel_stride = src.uv_pixel_stride;
+  for (uint32_t row = row_begin; row < row_end; ++row) {
+    const uint8_t* y_row = src.y + static_cast<size_t>(row) * src.y_row_stride;
+    const size_t uv_row_offset = static_cast<size_t>(row / 2u) * src.uv_row_stride;
+    const uint8_t* u_row = src.u + uv_row_offset;
+    const uint8_t* v_row = src.v + uv_row_offset;
+    uint8_t* out = dst + static_cast<size_t>(row) * dst_stride_bytes;
+    uint32_t col = 0;
+#if defined(CAMBANG_PIXELS_SSE2) || defined(CAMBANG_PIXELS_NEON) || defined(CAMBANG_YUV420_NEON_RUNTIME)
+    col = convert_yuv420_row_vector(y_row, u_row, v_row, uv_pixel_stride, width, to_rgba, out);
+#endif
+    convert_yuv420_row_scalar(y_row, u_row, v_row, uv_pixel_stride, col, width, to_rgba, out);
+  }
+}
+
+} // namespace cambang
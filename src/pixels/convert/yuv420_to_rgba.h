@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace cambang {
+
+// Source description for one 8-bit 4:2:0 YUV image. Chroma samples for
+// column x live at u/v + (x / 2) * uv_pixel_stride on chroma row y / 2, so
+// one description covers I420 (pixel stride 1) and NV12/NV21 (pixel stride
+// 2 with u/v pointing one byte apart).
+struct Yuv420Source {
+  const uint8_t* y = nullptr;
+  const uint8_t* u = nullptr;
+  const uint8_t* v = nullptr;
+  uint32_t y_row_stride = 0;
+  uint32_t uv_row_stride = 0;
+  uint32_t uv_pixel_stride = 1;
+};
+
+// Writes rows [row_begin, row_end) of a width-wide image as packed 32-bit
+// RGBA (or BGRA when to_rgba is false) using integer BT.601 limited-range
+// coefficients. dst points at row 0; alpha is always 0xFF. Callers own all
+// bounds validation. Rows are independent, so a large image may be split
+// into row bands converted concurrently.
+//
+// Planar and semiplanar (uv_pixel_stride 1 or 2) rows are vectorized with
+// SSE2 / NEON (pixels/pixel_simd.h; 32-bit ARM checks the CPU for NEON at
+// run time), bit-identical to the scalar reference that handles every other
+// layout and each row's tail.
+void convert_yuv420_rows_to_packed(
+    const Yuv420Source& src,
+    uint32_t width,
+    uint32_t row_begin,
+    uint32_t row_end,
+    bool to_rgba,
+    uint8_t* dst,
+    size_t dst_stride_bytes);
+
+} // namespace cambang
@@ -0,0 +1,177 @@
+#include "pixels/encode/lz_block.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace cambang {
+
+namespace {
+
+constexpr size_t kMinMatch = 4;
+// The block format ends with literals: the last match starts at least
+// kMatchStartLimit bytes before the end and ends at least kLastLiterals before.
+constexpr size_t kLastLiterals = 5;
+constexpr size_t kMatchStartLimit = 12;
+constexpr size_t kMaxOffset = 65535;
+constexpr unsigned kHashBits = 16;
+// Misses before each wider step through data that does not match.
+constexpr unsigned kSkipShift = 6;
+
+inline uint32_t read32(const uint8_t* p) noexcept {
+  uint32_t v = 0;
+  std::memcpy(&v, p, sizeof(v));
+  return v;
+}
+
+inline uint32_t hash4(uint32_t v) noexcept {
+  return (v * 2654435761u) >> (32u - kHashBits);
+}
+
+void put_length(std::vector<uint8_t>& out, size_t length) {
+  while (length >= 255u) {
+    out.push_back(255u);
+    length -= 255u;
+  }
+  out.push_back(static_cast<uint8_t>(length));
+}
+
+void put_literals(std::vector<uint8_t>& out, const uint8_t* literals, size_t count, size_t match_code) {
+  out.push_back(static_cast<uint8_t>((std::min<size_t>(count, 15u) << 4) | std::min<size_t>(match_code, 15u)));
+  if (count >= 15u) {
+    put_length(out, count - 15u);
+  }
+  out.insert(out.end(), literals, literals + count);
+}
+
+bool read_length(const uint8_t* src, size_t size, size_t& ip, size_t limit, size_t& length) noexcept {
+  uint8_t b = 0;
+  do {
+    if (ip >= size) {
+      return false;
+    }
+    b = src[ip++];
+    length += b;
+    if (length > limit) {
+      return false;
+    }
+  } while (b == 255u);
+  return true;
+}
+
+} // namespace
+
+void lz_block_compress(const uint8_t* src, size_t size, std::vector<uint8_t>& out) {
+  out.reserve(out.size() + lz_block_compress_bound(size));
+  size_t anchor = 0;
+  if (size > kMatchStartLimit) {
+    std::vector<uint32_t> table(size_t{1} << kHashBits, 0);
+    const size_t match_start_end = size - kMatchStartLimit;
+    const size_t match_end = size - kLastLiterals;
+    size_t i = 0;
+    size_t misses = 0;
+    while (i < match_start_end) {
+      const uint32_t seq = read32(src + i);
+      uint32_t& slot = table[hash4(seq)];
+      const size_t candidate = slot;
+      slot = static_cast<uint32_t>(i);
+      if (candidate >= i || i - candidate > kMaxOffset || read32(src + candidate) != seq) {
+        i += 1u + (misses++ >> kSkipShift);
+        continue;
+      }
+      misses = 0;
+      size_t start = i;
+      size_t from = candidate;
+      while (start > anchor && from > 0 && src[start - 1] == src[from - 1]) {
+        --start;
+        --from;
+      }
+      size_t end = i + kMinMatch;
+      size_t ref = candidate + kMinMatch;
+      while (end + 8 <= match_end) {
+        uint64_t a = 0;
+        uint64_t b = 0;
+        std::memcpy(&a, src + end, sizeof(a));
+        std::memcpy(&b, src + ref, sizeof(b));
+        if (a != b) {
+          break;
+        }
+        end += 8;
+        ref += 8;
+      }
+      while (end < match_end && src[end] == src[ref]) {
+        ++end;
+        ++ref;
+      }
+      const size_t offset = start - from;
+      const size_t match_code = end - start - kMinMatch;
+      put_literals(out, src + anchor, start - anchor, match_code);
+      out.push_back(static_cast<uint8_t>(offset & 0xFFu));
+      out.push_back(static_cast<uint8_t>(offset >> 8));
+      if (match_code >= 15u) {
+        put_length(out, match_code - 15u);
+      }
+      anchor = end;
+      i = end;
+    }
+  }
+  put_literals(out, src + anchor, size - anchor, 0);
+}
+
+bool lz_block_decompress(const uint8_t* src, size_t size, uint8_t* dst, size_t dst_size) noexcept {
+  size_t ip = 0;
+  size_t op = 0;
+  for (;;) {
+    if (ip >= size) {
+      return false;
+    }
+    const uint8_t token = src[ip++];
+    size_t literals = token >> 4;
+    if (literals == 15u && !read_length(src, size, ip, dst_size, literals)) {
+      return false;
+    }
+    if (literals > size - ip || literals > dst_size - op) {
+      return false;
+    }
+    std::memcpy(dst + op, src + ip, literals);
+    ip += literals;
+    op += literals;
+    if (ip == size) {
+      return op == dst_size;
+    }
+
+    if (size - ip < 2u) {
+      return false;
+    }
+    const size_t offset = static_cast<size_t>(src[ip]) | (static_cast<size_t>(src[ip + 1]) << 8);
+    ip += 2;
+    if (offset == 0 || offset > op) {
+      return false;
+    }
+    size_t length = token & 0x0Fu;
+    if (length == 15u && !read_length(src, size, ip, dst_size, length)) {
+      return false;
+    }
+    length += kMinMatch;
+    if (length > dst_size - op) {
+      return false;
+    }
+    uint8_t* out = dst + op;
+    const uint8_t* ref = out - offset;
+    if (offset >= length) {
+      std::memcpy(out, ref, length);
+    } else {
+      // Overlapping copy repeats the last offset bytes (runs). Copy whole
+      // periods, each chunk as long as everything before it, so a long run
+      // takes a few memcpys rather than a byte loop.
+      size_t copied = 0;
+      while (copied < length) {
+        const size_t chunk = std::min(copied + offset, length - copied);
+        std::memcpy(out + copied, ref, chunk);
+        copied += chunk;
+      }
+    }
+    op += length;
+  }
+}
+
+} // namespace cambang
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace cambang {
+
+// Byte-stream compression in the LZ4 block format (no frame header,
+// checksum or dictionary), for keeping retained payloads compressed in memory.
+//
+// Self-contained, like the PNG encoder: greedy single-probe hash matching over
+// a 64 KiB window, skipping ahead faster through data that keeps missing, so
+// incompressible input (sensor noise) costs little more than a copy.
+// Rendered and flat content compresses well; busy natural images compress
+// modestly. Any conforming LZ4 block decoder reads the output.
+
+// Worst-case compressed size of size input bytes.
+constexpr size_t lz_block_compress_bound(size_t size) noexcept {
+  return size + size / 255u + 16u;
+}
+
+// Appends the compressed form of src[0, size) to out.
+void lz_block_compress(const uint8_t* src, size_t size, std::vector<uint8_t>& out);
+
+// Decompresses the block src[0, size) into dst, which it must fill exactly.
+// False on malformed input or a size mismatch; dst contents are unspecified
+// then.
+bool lz_block_decompress(const uint8_t* src, size_t size, uint8_t* dst, size_t dst_size) noexcept;
+
+} // namespace cambang
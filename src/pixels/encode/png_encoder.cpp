@@ -0,0 +1,425 @@
+#include "pixels/encode/png_encoder.h"
+
+#include <array>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+
+namespace cambang {
+
+namespace {
+
+constexpr uint8_t kPngSignature[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1a, '\n'};
+
+constexpr uint32_t kWindowSize = 32768;
+constexpr uint32_t kWindowMask = kWindowSize - 1;
+constexpr uint32_t kHashBits = 15;
+constexpr uint32_t kHashSize = 1u << kHashBits;
+constexpr uint32_t kMinMatch = 3;
+constexpr uint32_t kMaxMatch = 258;
+// Greedy matcher bounds: chains longer than this are cut short, and a match
+// this long is taken without looking further.
+constexpr uint32_t kMaxChain = 32;
+constexpr uint32_t kNiceMatch = 128;
+
+constexpr uint16_t kLengthBase[29] = {
+    3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27,
+    31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258};
+constexpr uint8_t kLengthExtra[29] = {
+    0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2,
+    2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0};
+constexpr uint16_t kDistBase[30] = {
+    1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129,
+    193, 257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577};
+constexpr uint8_t kDistExtra[30] = {
+    0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6,
+    6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13};
+
+uint32_t reverse_bits(uint32_t code, uint32_t length) noexcept {
+  uint32_t out = 0;
+  for (uint32_t i = 0; i < length; ++i) {
+    out = (out << 1) | (code & 1u);
+    code >>= 1;
+  }
+  return out;
+}
+
+// Fixed Huffman codes (RFC 1951 3.2.6), bit-reversed for the LSB-first
+// writer, plus length/distance symbol lookups.
+struct FixedTables {
+  std::array<uint16_t, 288> lit_code{};
+  std::array<uint8_t, 288> lit_bits{};
+  std::array<uint8_t, 30> dist_code{};
+  std::array<uint8_t, kMaxMatch + 1> length_symbol{};
+  // Distances 1..256 directly, larger ones by (distance - 1) >> 7.
+  std::array<uint8_t, 512> dist_symbol{};
+
+  FixedTables() noexcept {
+    for (uint32_t v = 0; v < 288; ++v) {
+      uint32_t code = 0;
+      uint32_t bits = 0;
+      if (v < 144) {
+        code = 0x30u + v;
+        bits = 8;
+      } else if (v < 256) {
+        code = 0x190u + (v - 144u);
+        bits = 9;
+      } else if (v < 280) {
+        code = v - 256u;
+        bits = 7;
+      } else {
+        code = 0xc0u + (v - 280u);
+        bits = 8;
+      }
+      lit_code[v] = static_cast<uint16_t>(reverse_bits(code, bits));
+      lit_bits[v] = static_cast<uint8_t>(bits);
+    }
+    for (uint32_t d = 0; d < 30; ++d) {
+      dist_code[d] = static_cast<uint8_t>(reverse_bits(d, 5));
+    }
+    for (uint32_t s = 0; s < 29; ++s) {
+      const uint32_t end = s + 1 < 29 ? kLengthBase[s + 1] : kMaxMatch + 1;
+      for (uint32_t len = kLengthBase[s]; len < end; ++len) {
+        length_symbol[len] = static_cast<uint8_t>(s);
+      }
+    }
+    for (uint32_t s = 0; s < 30; ++s) {
+      const uint32_t end = s + 1 < 30 ? kDistBase[s + 1] : kWindowSize + 1;
+      for (uint32_t d = kDistBase[s]; d < end; ++d) {
+        if (d <= 256) {
+          dist_symbol[d - 1] = static_cast<uint8_t>(s);
+        } else {
+          dist_symbol[256 + ((d - 1) >> 7)] = static_cast<uint8_t>(s);
+        }
+      }
+    }
+  }
+
+  uint32_t dist_symbol_for(uint32_t distance) const noexcept {
+    return distance <= 256 ? dist_symbol[distance - 1] : dist_symbol[256 + ((distance - 1) >> 7)];
+  }
+};
+
+const FixedTables& fixed_tables() noexcept {
+  static const FixedTables tables;
+  return tables;
+}
+
+class BitWriter final {
+public:
+  explicit BitWriter(std::vector<uint8_t>& out) noexcept : out_(out) {}
+
+  void put(uint32_t bits, uint32_t count) {
+    acc_ |= static_cast<uint64_t>(bits) << fill_;
+    fill_ += count;
+    while (fill_ >= 8) {
+      out_.push_back(static_cast<uint8_t>(acc_));
+      acc_ >>= 8;
+      fill_ -= 8;
+    }
+  }
+
+  void flush() {
+    if (fill_ > 0) {
+      out_.push_back(static_cast<uint8_t>(acc_));
+    }
+    acc_ = 0;
+    fill_ = 0;
+  }
+
+private:
+  std::vector<uint8_t>& out_;
+  uint64_t acc_ = 0;
+  uint32_t fill_ = 0;
+};
+
+void put_be32(std::vector<uint8_t>& out, uint32_t v) {
+  out.push_back(static_cast<uint8_t>(v >> 24));
+  out.push_back(static_cast<uint8_t>(v >> 16));
+  out.push_back(static_cast<uint8_t>(v >> 8));
+  out.push_back(static_cast<uint8_t>(v));
+}
+
+uint32_t crc32_update(uint32_t crc, const uint8_t* data, size_t size) noexcept {
+  static const std::array<uint32_t, 256> table = [] {
+    std::array<uint32_t, 256> t{};
+    for (uint32_t n = 0; n < 256; ++n) {
+      uint32_t c = n;
+      for (int k = 0; k < 8; ++k) {
+        c = (c & 1u) ? 0xedb88320u ^ (c >> 1) : c >> 1;
+      }
+      t[n] = c;
+    }
+    return t;
+  }();
+  for (size_t i = 0; i < size; ++i) {
+    crc = table[(crc ^ data[i]) & 0xffu] ^ (crc >> 8);
+  }
+  return crc;
+}
+
+uint32_t adler32(const uint8_t* data, size_t size) noexcept {
+  // 5552 is the longest run whose sums cannot overflow 32 bits.
+  uint32_t a = 1;
+  uint32_t b = 0;
+  while (size > 0) {
+    const size_t run = size < 5552 ? size : 5552;
+    for (size_t i = 0; i < run; ++i) {
+      a += data[i];
+      b += a;
+    }
+    a %= 65521u;
+    b %= 65521u;
+    data += run;
+    size -= run;
+  }
+  return (b << 16) | a;
+}
+
+// Completes the chunk begin_chunk() opened at chunk_offset: fills in the
+// length and type placeholder ahead of the data appended since, then appends
+// the CRC.
+void finish_chunk(std::vector<uint8_t>& out, size_t chunk_offset, const char type[4]) {
+  const size_t data_size = out.size() - chunk_offset - 8;
+  const uint32_t length = static_cast<uint32_t>(data_size);
+  out[chunk_offset + 0] = static_cast<uint8_t>(length >> 24);
+  out[chunk_offset + 1] = static_cast<uint8_t>(length >> 16);
+  out[chunk_offset + 2] = static_cast<uint8_t>(length >> 8);
+  out[chunk_offset + 3] = static_cast<uint8_t>(length);
+  std::memcpy(&out[chunk_offset + 4], type, 4);
+  const uint32_t crc =
+      crc32_update(0xffffffffu, &out[chunk_offset + 4], data_size + 4) ^ 0xffffffffu;
+  put_be32(out, crc);
+}
+
+size_t begin_chunk(std::vector<uint8_t>& out) {
+  const size_t offset = out.size();
+  out.resize(offset + 8);
+  return offset;
+}
+
+uint8_t paeth(uint8_t a, uint8_t b, uint8_t c) noexcept {
+  const int p = static_cast<int>(a) + static_cast<int>(b) - static_cast<int>(c);
+  const int pa = std::abs(p - static_cast<int>(a));
+  const int pb = std::abs(p - static_cast<int>(b));
+  const int pc = std::abs(p - static_cast<int>(c));
+  if (pa <= pb && pa <= pc) return a;
+  if (pb <= pc) return b;
+  return c;
+}
+
+// Writes the filter byte and filtered bytes of one row at dst, choosing the
+// type with the smallest sum of residuals read as signed bytes. scratch[0..3]
+// hold the None/Sub/Up/Paeth candidates.
+void filter_row(const uint8_t* row,
+                const uint8_t* prior,
+                size_t row_bytes,
+                uint32_t bpp,
+                std::array<std::vector<uint8_t>, 4>& scratch,
+                uint8_t* dst) {
+  // A null prior (row 0) reads as all-zero, as PNG defines it.
+  const size_t head = bpp < row_bytes ? bpp : row_bytes;
+  uint8_t* none = scratch[0].data();
+  uint8_t* sub = scratch[1].data();
+  uint8_t* up = scratch[2].data();
+  uint8_t* pae = scratch[3].data();
+  std::memcpy(none, row, row_bytes);
+  for (size_t i = 0; i < head; ++i) {
+    const uint8_t b = prior ? prior[i] : 0;
+    sub[i] = row[i];
+    up[i] = static_cast<uint8_t>(row[i] - b);
+    pae[i] = static_cast<uint8_t>(row[i] - b);  // paeth(0, b, 0) == b
+  }
+  for (size_t i = head; i < row_bytes; ++i) {
+    const uint8_t a = row[i - bpp];
+    sub[i] = static_cast<uint8_t>(row[i] - a);
+  }
+  if (prior) {
+    for (size_t i = head; i < row_bytes; ++i) {
+      up[i] = static_cast<uint8_t>(row[i] - prior[i]);
+      pae[i] = static_cast<uint8_t>(row[i] - paeth(row[i - bpp], prior[i], prior[i - bpp]));
+    }
+  } else {
+    for (size_t i = head; i < row_bytes; ++i) {
+      up[i] = row[i];
+      pae[i] = static_cast<uint8_t>(row[i] - row[i - bpp]);  // paeth(a, 0, 0) == a
+    }
+  }
+
+  uint64_t best_cost = std::numeric_limits<uint64_t>::max();
+  uint8_t best = 0;
+  for (uint8_t type = 0; type < 4; ++type) {
+    const uint8_t* f = scratch[type].data();
+    uint64_t cost = 0;
+    for (size_t i = 0; i < row_bytes; ++i) {
+      const uint8_t v = f[i];
+      cost += v < 128 ? v : 256u - v;
+    }
+    if (cost < best_cost) {
+      best_cost = cost;
+      best = type;
+    }
+  }
+  // PNG numbers Paeth 4; type 3 (Average) is never chosen.
+  dst[0] = best == 3 ? 4 : best;
+  std::memcpy(dst + 1, scratch[best].data(), row_bytes);
+}
+
+void deflate_fixed(const uint8_t* data, size_t size, BitWriter& bits) {
+  const FixedTables& t = fixed_tables();
+  bits.put(1, 1);  // BFINAL
+  bits.put(1, 2);  // BTYPE = fixed Huffman
+
+  std::vector<int64_t> head(kHashSize, -1);
+  std::vector<int64_t> prev(kWindowSize, -1);
+  auto hash_at = [data](size_t i) noexcept {
+    return ((static_cast<uint32_t>(data[i]) << 10) ^ (static_cast<uint32_t>(data[i + 1]) << 5) ^
+            static_cast<uint32_t>(data[i + 2])) & (kHashSize - 1);
+  };
+  auto insert = [&](size_t i) noexcept {
+    const uint32_t h = hash_at(i);
+    prev[i & kWindowMask] = head[h];
+    head[h] = static_cast<int64_t>(i);
+  };
+
+  size_t i = 0;
+  while (i < size) {
+    uint32_t best_len = 0;
+    uint32_t best_dist = 0;
+    if (i + kMinMatch <= size) {
+      const size_t max_len = size - i < kMaxMatch ? size - i : kMaxMatch;
+      int64_t candidate = head[hash_at(i)];
+      for (uint32_t chain = 0; candidate >= 0 && chain < kMaxChain; ++chain) {
+        const size_t c = static_cast<size_t>(candidate);
+        if (i - c > kWindowSize) {
+          break;
+        }
+        if (data[c + best_len] == data[i + best_len]) {
+          uint32_t len = 0;
+          while (len < max_len && data[c + len] == data[i + len]) {
+            ++len;
+          }
+          if (len > best_len) {
+            best_len = len;
+            best_dist = static_cast<uint32_t>(i - c);
+            if (len >= kNiceMatch || len == max_len) {
+              break;
+            }
+          }
+        }
+        const int64_t next = prev[c & kWindowMask];
+        if (next >= candidate) {
+          break;
+        }
+        candidate = next;
+      }
+    }
+
+    if (best_len >= kMinMatch) {
+      const uint32_t ls = t.length_symbol[best_len];
+      bits.put(t.lit_code[257 + ls], t.lit_bits[257 + ls]);
+      bits.put(best_len - kLengthBase[ls], kLengthExtra[ls]);
+      const uint32_t ds = t.dist_symbol_for(best_dist);
+      bits.put(t.dist_code[ds], 5);
+      bits.put(best_dist - kDistBase[ds], kDistExtra[ds]);
+      const size_t end = i + best_len;
+      for (; i < end; ++i) {
+        if (i + kMinMatch <= size) {
+          insert(i);
+        }
+      }
+    } else {
+      bits.put(t.lit_code[data[i]], t.lit_bits[data[i]]);
+      if (i + kMinMatch <= size) {
+        insert(i);
+      }
+      ++i;
+    }
+  }
+  bits.put(t.lit_code[256], t.lit_bits[256]);
+  bits.flush();
+}
+
+} // namespace
+
+bool encode_png_rgba8(const uint8_t* rgba,
+                      uint32_t width,
+                      uint32_t height,
+                      std::vector<uint8_t>& out) {
+  out.clear();
+  if (!rgba || width == 0 || height == 0 || width > 0x7fffffffu || height > 0x7fffffffu) {
+    return false;
+  }
+  const size_t pixel_count = static_cast<size_t>(width) * static_cast<size_t>(height);
+  if (pixel_count / width != height || pixel_count > (std::numeric_limits<size_t>::max() / 4u)) {
+    return false;
+  }
+
+  bool opaque = true;
+  for (size_t p = 0; p < pixel_count; ++p) {
+    if (rgba[p * 4u + 3u] != 0xffu) {
+      opaque = false;
+      break;
+    }
+  }
+  const uint32_t bpp = opaque ? 3u : 4u;
+  const size_t row_bytes = static_cast<size_t>(width) * bpp;
+  const size_t filtered_size = (row_bytes + 1u) * height;
+  // Fixed-Huffman literals cost at most 9 bits, so this bounds the IDAT size.
+  if (filtered_size > (0x7fffffffu - 64u) / 9u * 8u) {
+    return false;
+  }
+
+  std::vector<uint8_t> filtered(filtered_size);
+  std::array<std::vector<uint8_t>, 4> scratch;
+  for (auto& s : scratch) {
+    s.resize(row_bytes);
+  }
+  std::vector<uint8_t> row_rgb;
+  std::vector<uint8_t> prior_rgb;
+  if (opaque) {
+    row_rgb.resize(row_bytes);
+    prior_rgb.resize(row_bytes);
+  }
+  for (uint32_t y = 0; y < height; ++y) {
+    const uint8_t* src = rgba + static_cast<size_t>(y) * width * 4u;
+    const uint8_t* row = src;
+    const uint8_t* prior = y > 0 ? src - static_cast<size_t>(width) * 4u : nullptr;
+    if (opaque) {
+      row_rgb.swap(prior_rgb);
+      for (uint32_t x = 0; x < width; ++x) {
+        std::memcpy(&row_rgb[static_cast<size_t>(x) * 3u], src + static_cast<size_t>(x) * 4u, 3);
+      }
+      row = row_rgb.data();
+      prior = y > 0 ? prior_rgb.data() : nullptr;
+    }
+    filter_row(row, prior, row_bytes, bpp, scratch, &filtered[static_cast<size_t>(y) * (row_bytes + 1u)]);
+  }
+
+  out.reserve(filtered_size / 2u + 128u);
+  out.insert(out.end(), kPngSignature, kPngSignature + sizeof(kPngSignature));
+
+  const size_t ihdr = begin_chunk(out);
+  put_be32(out, width);
+  put_be32(out, height);
+  out.push_back(8);                  // bit depth
+  out.push_back(opaque ? 2 : 6);     // colour type: RGB / RGBA
+  out.push_back(0);                  // compression
+  out.push_back(0);                  // filter method
+  out.push_back(0);                  // no interlace
+  finish_chunk(out, ihdr, "IHDR");
+
+  const size_t idat = begin_chunk(out);
+  out.push_back(0x78);  // zlib: deflate, 32 KiB window
+  out.push_back(0x01);  // fastest-compression level hint, FCHECK
+  BitWriter bits(out);
+  deflate_fixed(filtered.data(), filtered.size(), bits);
+  put_be32(out, adler32(filtered.data(), filtered.size()));
+  finish_chunk(out, idat, "IDAT");
+
+  const size_t iend = begin_chunk(out);
+  finish_chunk(out, iend, "IEND");
+  return true;
+}
+
+} // namespace cambang
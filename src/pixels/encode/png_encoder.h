@@ -0,0 +1,25 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace cambang {
+
+// Encodes a tightly packed width*height RGBA8 image as a PNG file into out
+// (replacing its contents). An image whose alpha is 0xFF throughout is written
+// as 8-bit RGB, anything else as 8-bit RGBA.
+//
+// Self-contained: rows are filtered per row (None/Sub/Up/Paeth, whichever has
+// the smallest absolute residual sum) and compressed as one fixed-Huffman
+// deflate block with greedy hash-chain LZ77 matching. That trades some ratio
+// against a dynamic-Huffman encoder for no third-party dependency and a
+// bounded per-call working set (the filtered image plus a 32 KiB-window hash
+// table). Returns false on a null or zero-sized image or one too large for a
+// single IDAT chunk.
+bool encode_png_rgba8(const uint8_t* rgba,
+                      uint32_t width,
+                      uint32_t height,
+                      std::vector<uint8_t>& out);
+
+} // namespace cambang
@@ -0,0 +1,224 @@
+#include "pixels/fusion/exposure_fusion.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "pixels/pixel_simd.h"
+
+namespace cambang {
+
+namespace {
+
+// Mertens' well-exposedness spread around mid-grey.
+constexpr float kExposureSigma = 0.2f;
+// Floors on the contrast and saturation measures, so flat or grey regions
+// are still weighted by how well exposed they are rather than equally.
+constexpr float kContrastFloor = 0.02f;
+constexpr float kSaturationFloor = 0.02f;
+
+// 3x3 box blur of a width x height plane, edges clamped.
+void box_blur(std::vector<float>& plane, std::vector<float>& scratch, uint32_t width, uint32_t height) {
+  scratch.resize(plane.size());
+  for (uint32_t y = 0; y < height; ++y) {
+    const float* row = plane.data() + static_cast<size_t>(y) * width;
+    float* out = scratch.data() + static_cast<size_t>(y) * width;
+    for (uint32_t x = 0; x < width; ++x) {
+      const uint32_t l = x == 0 ? 0 : x - 1;
+      const uint32_t r = std::min(x + 1, width - 1);
+      out[x] = (row[l] + row[x] + row[r]) * (1.0f / 3.0f);
+    }
+  }
+  for (uint32_t y = 0; y < height; ++y) {
+    const uint32_t u = y == 0 ? 0 : y - 1;
+    const uint32_t d = std::min(y + 1, height - 1);
+    const float* up = scratch.data() + static_cast<size_t>(u) * width;
+    const float* mid = scratch.data() + static_cast<size_t>(y) * width;
+    const float* down = scratch.data() + static_cast<size_t>(d) * width;
+    float* out = plane.data() + static_cast<size_t>(y) * width;
+    for (uint32_t x = 0; x < width; ++x) {
+      out[x] = (up[x] + mid[x] + down[x]) * (1.0f / 3.0f);
+    }
+  }
+}
+
+// Coarse sample position of full-resolution pixel p of full_size, for a
+// coarse level of coarse_size: the lower neighbour and the 16-bit fraction
+// towards the upper one (pixel centres aligned, edges clamped).
+void coarse_position(uint32_t p, uint32_t full_size, uint32_t coarse_size, uint32_t& lower, uint32_t& upper,
+                     uint32_t& fraction) noexcept {
+  const int64_t scaled = static_cast<int64_t>((2ull * p + 1) * coarse_size * 65536ull / (2ull * full_size)) - 32768;
+  const int64_t max_pos = static_cast<int64_t>(coarse_size - 1) * 65536;
+  const int64_t pos = std::clamp<int64_t>(scaled, 0, max_pos);
+  lower = static_cast<uint32_t>(pos >> 16);
+  upper = std::min(lower + 1, coarse_size - 1);
+  fraction = static_cast<uint32_t>(pos & 0xFFFF);
+}
+
+} // namespace
+
+bool compute_exposure_fusion_weights(const uint8_t* const* images,
+                                     uint32_t count,
+                                     uint32_t width,
+                                     uint32_t height,
+                                     size_t row_stride,
+                                     ExposureFusionWeights& out) {
+  if (!images || count < 2 || count > kMaxExposureFusionImages || width == 0 || height == 0 ||
+      row_stride < static_cast<size_t>(width) * 4u) {
+    return false;
+  }
+  for (uint32_t k = 0; k < count; ++k) {
+    if (!images[k]) {
+      return false;
+    }
+  }
+  const size_t pixels = static_cast<size_t>(width) * height;
+  constexpr float kInv255 = 1.0f / 255.0f;
+  constexpr float kExposureScale = -1.0f / (2.0f * kExposureSigma * kExposureSigma);
+
+  std::vector<std::vector<float>> raw(count);
+  std::vector<float> gray(pixels);
+  std::vector<float> scratch;
+  for (uint32_t k = 0; k < count; ++k) {
+    std::vector<float>& plane = raw[k];
+    plane.resize(pixels);
+    for (uint32_t y = 0; y < height; ++y) {
+      const uint8_t* row = images[k] + static_cast<size_t>(y) * row_stride;
+      for (uint32_t x = 0; x < width; ++x) {
+        const float r = row[4 * x] * kInv255;
+        const float g = row[4 * x + 1] * kInv255;
+        const float b = row[4 * x + 2] * kInv255;
+        const float mean = (r + g + b) * (1.0f / 3.0f);
+        const float saturation =
+            std::sqrt(((r - mean) * (r - mean) + (g - mean) * (g - mean) + (b - mean) * (b - mean)) * (1.0f / 3.0f));
+        const float exposure = std::exp(
+            ((r - 0.5f) * (r - 0.5f) + (g - 0.5f) * (g - 0.5f) + (b - 0.5f) * (b - 0.5f)) * kExposureScale);
+        const size_t i = static_cast<size_t>(y) * width + x;
+        gray[i] = mean;
+        plane[i] = (saturation + kSaturationFloor) * exposure;
+      }
+    }
+    // Contrast: magnitude of the gray level's Laplacian.
+    for (uint32_t y = 0; y < height; ++y) {
+      const size_t u = static_cast<size_t>(y == 0 ? 0 : y - 1) * width;
+      const size_t m = static_cast<size_t>(y) * width;
+      const size_t d = static_cast<size_t>(std::min(y + 1, height - 1)) * width;
+      for (uint32_t x = 0; x < width; ++x) {
+        const uint32_t l = x == 0 ? 0 : x - 1;
+        const uint32_t r = std::min(x + 1, width - 1);
+        const float laplacian = 4.0f * gray[m + x] - gray[m + l] - gray[m + r] - gray[u + x] - gray[d + x];
+        plane[m + x] *= std::fabs(laplacian) + kContrastFloor;
+      }
+    }
+    box_blur(plane, scratch, width, height);
+    box_blur(plane, scratch, width, height);
+  }
+
+  out.count = count;
+  out.width = width;
+  out.height = height;
+  out.q8.assign(pixels * count, 0);
+  for (size_t i = 0; i < pixels; ++i) {
+    float sum = 0.0f;
+    for (uint32_t k = 0; k < count; ++k) {
+      sum += raw[k][i];
+    }
+    uint32_t assigned = 0;
+    for (uint32_t k = 0; k + 1 < count; ++k) {
+      const float share = sum > 0.0f ? raw[k][i] / sum : 1.0f / static_cast<float>(count);
+      const uint32_t w = std::min(static_cast<uint32_t>(share * 256.0f), 256u - assigned);
+      out.q8[k * pixels + i] = static_cast<uint16_t>(w);
+      assigned += w;
+    }
+    out.q8[(count - 1) * pixels + i] = static_cast<uint16_t>(256u - assigned);
+  }
+  return true;
+}
+
+void expand_exposure_fusion_weight_row(const ExposureFusionWeights& weights,
+                                       uint32_t full_width,
+                                       uint32_t full_height,
+                                       uint32_t y,
+                                       uint16_t* const* out_rows) noexcept {
+  const uint32_t count = weights.count;
+  if (count == 0 || full_width == 0 || full_height == 0) {
+    return;
+  }
+  const size_t plane_size = static_cast<size_t>(weights.width) * weights.height;
+  uint32_t r0 = 0;
+  uint32_t r1 = 0;
+  uint32_t fy = 0;
+  coarse_position(y, full_height, weights.height, r0, r1, fy);
+  for (uint32_t x = 0; x < full_width; ++x) {
+    uint32_t c0 = 0;
+    uint32_t c1 = 0;
+    uint32_t fx = 0;
+    coarse_position(x, full_width, weights.width, c0, c1, fx);
+    // The same bilinear factors for every member, each truncated, so the
+    // members before the last never sum past 256 and the last takes the
+    // remainder.
+    uint32_t assigned = 0;
+    for (uint32_t k = 0; k < count; ++k) {
+      uint32_t w = 0;
+      if (k + 1 < count) {
+        const uint16_t* plane = weights.q8.data() + k * plane_size;
+        const uint16_t* row0 = plane + static_cast<size_t>(r0) * weights.width;
+        const uint16_t* row1 = plane + static_cast<size_t>(r1) * weights.width;
+        const uint64_t v0 = static_cast<uint64_t>(row0[c0]) * (65536u - fy) + static_cast<uint64_t>(row1[c0]) * fy;
+        const uint64_t v1 = static_cast<uint64_t>(row0[c1]) * (65536u - fy) + static_cast<uint64_t>(row1[c1]) * fy;
+        w = static_cast<uint32_t>((v0 * (65536u - fx) + v1 * fx) >> 32);
+        assigned += w;
+      } else {
+        w = 256u - assigned;
+      }
+      uint16_t* out = out_rows[k] + static_cast<size_t>(x) * 4u;
+      out[0] = out[1] = out[2] = out[3] = static_cast<uint16_t>(w);
+    }
+  }
+}
+
+void blend_weighted_rgba8(const uint8_t* const* src,
+                          const uint16_t* const* weights,
+                          uint32_t count,
+                          size_t n,
+                          uint8_t* dst) noexcept {
+  // Every product is at most 255 * 256 and the weights sum to at most 256,
+  // so the 16-bit accumulators cannot overflow.
+  size_t i = 0;
+#if defined(CAMBANG_PIXELS_SSE2)
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i half = _mm_set1_epi16(128);
+  for (; i + 16 <= n; i += 16) {
+    __m128i lo = half;
+    __m128i hi = half;
+    for (uint32_t k = 0; k < count; ++k) {
+      const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src[k] + i));
+      const __m128i w_lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(weights[k] + i));
+      const __m128i w_hi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(weights[k] + i + 8));
+      lo = _mm_add_epi16(lo, _mm_mullo_epi16(_mm_unpacklo_epi8(v, zero), w_lo));
+      hi = _mm_add_epi16(hi, _mm_mullo_epi16(_mm_unpackhi_epi8(v, zero), w_hi));
+    }
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i),
+                     _mm_packus_epi16(_mm_srli_epi16(lo, 8), _mm_srli_epi16(hi, 8)));
+  }
+#elif defined(CAMBANG_PIXELS_NEON)
+  for (; i + 16 <= n; i += 16) {
+    uint16x8_t lo = vdupq_n_u16(0);
+    uint16x8_t hi = vdupq_n_u16(0);
+    for (uint32_t k = 0; k < count; ++k) {
+      const uint8x16_t v = vld1q_u8(src[k] + i);
+      lo = vmlaq_u16(lo, vmovl_u8(vget_low_u8(v)), vld1q_u16(weights[k] + i));
+      hi = vmlaq_u16(hi, vmovl_u8(vget_high_u8(v)), vld1q_u16(weights[k] + i + 8));
+    }
+    vst1q_u8(dst + i, vcombine_u8(vrshrn_n_u16(lo, 8), vrshrn_n_u16(hi, 8)));
+  }
+#endif
+  for (; i < n; ++i) {
+    uint32_t acc = 128;
+    for (uint32_t k = 0; k < count; ++k) {
+      acc += static_cast<uint32_t>(src[k][i]) * weights[k][i];
+    }
+    dst[i] = static_cast<uint8_t>(acc >> 8);
+  }
+}
+
+} // namespace cambang
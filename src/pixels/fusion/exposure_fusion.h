@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace cambang {
+
+// Exposure fusion (Mertens, Kautz and Van Reeth) of an exposure bracket:
+// every output pixel is a weighted mean of the bracket's pixels, favouring
+// the members where that part of the scene is well exposed, saturated and
+// detailed.
+//
+// The weights are computed on a coarse level of the images (a few hundred
+// pixels across), smoothed and normalized there, and bilinearly
+// interpolated back up, so they vary only slowly across the image. That is
+// what the Laplacian-pyramid blend of the original method buys, at the cost
+// of one small image per member instead of a full pyramid per member (tens
+// of bytes per pixel at full resolution). The full-resolution pass is then
+// one weighted sum per byte, which blend_weighted_rgba8() vectorizes.
+
+// Members one fusion takes at most.
+constexpr uint32_t kMaxExposureFusionImages = 8;
+
+// Per-member weights on the coarse level, in 1/256ths: for every pixel the
+// count weights sum to exactly 256.
+struct ExposureFusionWeights {
+  uint32_t count = 0;
+  uint32_t width = 0;
+  uint32_t height = 0;
+  // count planes of width * height, member-major.
+  std::vector<uint16_t> q8;
+};
+
+// Weights of count (2..kMaxExposureFusionImages) RGBA8 images of width x
+// height, rows row_stride bytes apart -- the coarse level of each member.
+// False on inconsistent arguments.
+bool compute_exposure_fusion_weights(const uint8_t* const* images,
+                                     uint32_t count,
+                                     uint32_t width,
+                                     uint32_t height,
+                                     size_t row_stride,
+                                     ExposureFusionWeights& out);
+
+// Each member's weight for every byte of row y of the full_width x
+// full_height image the coarse level was taken from (four equal weights per
+// RGBA pixel): out_rows[k] receives full_width * 4 values for member k, and
+// for every byte they sum to exactly 256.
+void expand_exposure_fusion_weight_row(const ExposureFusionWeights& weights,
+                                       uint32_t full_width,
+                                       uint32_t full_height,
+                                       uint32_t y,
+                                       uint16_t* const* out_rows) noexcept;
+
+// dst[i] = round(sum over k of src[k][i] * weights[k][i] / 256) for n bytes,
+// given weights that sum to at most 256 for every i. Vectorized with SSE2 on
+// x86-64 and NEON on AArch64; other targets use the scalar loop.
+void blend_weighted_rgba8(const uint8_t* const* src,
+                          const uint16_t* const* weights,
+                          uint32_t count,
+                          size_t n,
+                          uint8_t* dst) noexcept;
+
+} // namespace cambang
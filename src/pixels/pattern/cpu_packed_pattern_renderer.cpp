@@ -1,10 +1,17 @@
 #include "pixels/pattern/cpu_packed_pattern_renderer.h"
 
+#include "pixels/pattern/pattern_band_pool.h"
+
 #include <algorithm>
 #include <array>
 #include <chrono>
 #include <cstring>
 #include <cmath>
+#include <memory>
+#include <numeric>
+#include <utility>
+
+#include "pixels/pixel_simd.h"
 
 namespace cambang {
 
@@ -15,6 +22,38 @@ void CpuPackedPatternRenderer::configure(const PatternSpec& spec) {
   }
 }
 
+namespace {
+
+// Upper bound on bands whose timing is recorded per banded render; bands past
+// it still render, they just do not contribute to the band stats.
+constexpr uint32_t kMaxTimedBands = 64;
+
+} // namespace
+
+struct CpuPackedPatternRenderer::BandRenderContext final {
+  CpuPackedPatternRenderer* self = nullptr;
+  RenderBaseFn fn = nullptr;
+  uint8_t* dst = nullptr;
+  uint32_t dst_stride_bytes = 0;
+  const PatternSpec* spec = nullptr;
+  const PatternBaseKey* key = nullptr;
+  const PatternOverlayData* overlay = nullptr;
+  uint32_t band_rows = 0;
+  uint64_t band_ns[kMaxTimedBands]{};
+};
+
+void CpuPackedPatternRenderer::render_base_band(void* raw, uint32_t row_begin, uint32_t row_end) {
+  auto& ctx = *static_cast<BandRenderContext*>(raw);
+  const auto t0 = std::chrono::steady_clock::now();
+  (ctx.self->*ctx.fn)(ctx.dst, ctx.dst_stride_bytes, *ctx.spec, *ctx.key, *ctx.overlay, row_begin, row_end);
+  const auto t1 = std::chrono::steady_clock::now();
+  const uint32_t index = ctx.band_rows != 0 ? row_begin / ctx.band_rows : 0;
+  if (index < kMaxTimedBands) {
+    // Each band index is written by exactly one thread.
+    ctx.band_ns[index] = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count());
+  }
+}
+
 void CpuPackedPatternRenderer::render_base_into(
     uint8_t* dst,
     uint32_t dst_stride_bytes,
@@ -22,47 +61,90 @@ void CpuPackedPatternRenderer::render_base_into(
     const PatternBaseKey& key,
     const PatternOverlayData& overlay) {
   // Table-driven algorithm dispatch (keeps preset registry as the only pattern list).
-  static constexpr RenderBaseFn kAlgoFns[] = {
-      &CpuPackedPatternRenderer::render_base_xy_xor,
-      &CpuPackedPatternRenderer::render_base_solid,
-      &CpuPackedPatternRenderer::render_base_checker,
-      &CpuPackedPatternRenderer::render_base_color_bars,
-      &CpuPackedPatternRenderer::render_base_radial_gradient,
-      &CpuPackedPatternRenderer::render_base_corners_rgba,
-      &CpuPackedPatternRenderer::render_base_noise,
-      &CpuPackedPatternRenderer::render_base_noise_animated,
+  const AlgoEntry* table = (key.format == PatternSpec::PackedFormat::RGBA8)
+      ? algo_table<PatternSpec::PackedFormat::RGBA8>()
+      : algo_table<PatternSpec::PackedFormat::BGRA8>();
+  const size_t idx = static_cast<size_t>(key.algo);
+  const AlgoEntry algo = table[idx < pattern_algo_count() ? idx : 0];
+  if (!band_pool_ || !algo.row_separable) {
+    (this->*algo.fn)(dst, dst_stride_bytes, spec, key, overlay, 0, key.height);
+    return;
+  }
 
-  };
+  BandRenderContext ctx{};
+  ctx.self = this;
+  ctx.fn = algo.fn;
+  ctx.dst = dst;
+  ctx.dst_stride_bytes = dst_stride_bytes;
+  ctx.spec = &spec;
+  ctx.key = &key;
+  ctx.overlay = &overlay;
+  ctx.band_rows = band_pool_->band_rows();
+  const uint64_t pixels = static_cast<uint64_t>(key.width) * static_cast<uint64_t>(key.height);
+  if (!band_pool_->run(key.height, pixels, &CpuPackedPatternRenderer::render_base_band, &ctx)) {
+    return;
+  }
 
-  const size_t idx = static_cast<size_t>(key.algo);
-  RenderBaseFn fn = &CpuPackedPatternRenderer::render_base_xy_xor;
-  if (idx < (sizeof(kAlgoFns) / sizeof(kAlgoFns[0]))) {
-    fn = kAlgoFns[idx];
+  const uint32_t band_count = (key.height + ctx.band_rows - 1) / ctx.band_rows;
+  const uint32_t timed = std::min(band_count, kMaxTimedBands);
+  uint64_t min_ns = UINT64_MAX;
+  uint64_t max_ns = 0;
+  for (uint32_t i = 0; i < timed; ++i) {
+    debug_stats_.base_band_total_ns += ctx.band_ns[i];
+    min_ns = std::min(min_ns, ctx.band_ns[i]);
+    max_ns = std::max(max_ns, ctx.band_ns[i]);
+  }
+  ++debug_stats_.banded_base_render_count;
+  debug_stats_.base_band_count += timed;
+  debug_stats_.base_band_max_ns = std::max(debug_stats_.base_band_max_ns, max_ns);
+  if (timed != 0) {
+    debug_stats_.base_band_skew_max_ns = std::max(debug_stats_.base_band_skew_max_ns, max_ns - min_ns);
   }
-  (this->*fn)(dst, dst_stride_bytes, spec, key, overlay);
 }
 
 void CpuPackedPatternRenderer::ensure_base(const PatternSpec& spec) {
   const PatternBaseKey key = PatternBaseKey::from_spec(spec);
 
-  if (base_valid_ && key == base_key_) {
+  if (base_ && key == base_->key) {
     return;
   }
+  if (base_cache_) {
+    if (std::shared_ptr<const PatternBaseFrame> cached = base_cache_->find(key)) {
+      base_ = std::move(cached);
+      ++debug_stats_.base_shared_cache_hit_count;
+      return;
+    }
+  }
+  // Drop the previous base before allocating the next one.
+  base_.reset();
 
-  base_key_ = key;
-  base_valid_ = true;
-
-  base_stride_bytes_ = key.width * PatternRenderTarget::bytes_per_pixel();
-  base_pixels_.assign(static_cast<size_t>(base_stride_bytes_) * static_cast<size_t>(key.height), 0);
+  auto frame = std::make_shared<PatternBaseFrame>();
+  frame->key = key;
+  frame->stride_bytes = key.width * PatternRenderTarget::bytes_per_pixel();
+  frame->pixels.assign(static_cast<size_t>(frame->stride_bytes) * static_cast<size_t>(key.height), 0);
 
-  // Cacheable-base path: render into tight internal cache buffer.
+  // Cacheable-base path: render into tight cache buffer.
   PatternOverlayData overlay{};
   const auto t0 = std::chrono::steady_clock::now();
-  render_base_into(base_pixels_.data(), base_stride_bytes_, spec, key, overlay);
+  render_base_into(frame->pixels.data(), frame->stride_bytes, spec, key, overlay);
   const auto t1 = std::chrono::steady_clock::now();
   const uint64_t ns = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count());
   debug_stats_.base_render_total_ns += ns;
   debug_stats_.base_render_max_ns = std::max(debug_stats_.base_render_max_ns, ns);
+
+  if (base_cache_) {
+    base_ = base_cache_->insert(std::move(frame));
+  } else {
+    base_ = std::move(frame);
+  }
+}
+
+std::shared_ptr<const PatternBaseFrame> CpuPackedPatternRenderer::base_frame(const PatternSpec& spec) {
+  if (spec.dynamic_base) {
+    return nullptr;
+  }
+  ensure_base(spec);
+  return base_;
 }
 
 void CpuPackedPatternRenderer::render_into(
@@ -86,10 +168,18 @@ void CpuPackedPatternRenderer::render_into(
     return;
   }
 
+  // A cached-base frame is "base exact" when its pixels are the base plus, at
+  // most, the one-column moving bar. Only such frames can be repaired in
+  // place or diffed against each other by column.
+  const bool exposure_adjusted = options.applied_exposure_compensation_milli_ev != 0;
+  const bool output_base_exact =
+      !spec.dynamic_base && !spec.overlay_frame_index_offsets && !exposure_adjusted;
+  const uint32_t bar_x = moving_bar_x(dst.width, overlay.frame_index);
+  const PatternBaseKey key = PatternBaseKey::from_spec(spec);
+
   if (spec.dynamic_base) {
     ++debug_stats_.base_cache_miss_count;
     // Dynamic-base path: bypass base cache and render the base into the destination each frame.
-    const PatternBaseKey key = PatternBaseKey::from_spec(spec);
     const auto t0 = std::chrono::steady_clock::now();
     render_base_into(static_cast<uint8_t*>(dst.data), dst.stride_bytes, spec, key, overlay);
     const auto t1 = std::chrono::steady_clock::now();
@@ -98,15 +188,13 @@ void CpuPackedPatternRenderer::render_into(
     debug_stats_.base_render_max_ns = std::max(debug_stats_.base_render_max_ns, ns);
     rendered_target_valid_ = false;
   } else {
-    const PatternBaseKey key = PatternBaseKey::from_spec(spec);
-    const bool base_cache_hit = (base_valid_ && key == base_key_);
+    const bool base_cache_hit = (base_ && key == base_->key);
     if (base_cache_hit) {
       ++debug_stats_.base_cache_hit_count;
     } else {
       ++debug_stats_.base_cache_miss_count;
     }
     ensure_base(spec);
-    const bool no_meaningful_overlay_update = !spec.overlay_frame_index_offsets && !spec.overlay_moving_bar;
     const bool target_identity_unchanged =
         rendered_target_valid_ &&
         rendered_target_ptr_ == dst.data &&
@@ -117,17 +205,25 @@ void CpuPackedPatternRenderer::render_into(
     const bool rendered_target_has_correct_base =
         rendered_target_valid_ &&
         rendered_target_base_key_ == key;
-    const bool normal_safe_reuse =
+    // The target still holds base (+ bar at rendered_target_bar_x_): at most
+    // the old bar column has to be restored from the cache.
+    const bool can_repair_in_place =
         base_cache_hit &&
-        no_meaningful_overlay_update &&
         target_identity_unchanged &&
-        rendered_target_has_correct_base;
-    const bool can_reuse_frame = normal_safe_reuse;
-    if (can_reuse_frame) {
+        rendered_target_has_correct_base &&
+        rendered_target_base_exact_;
+    const bool stale_bar_column =
+        rendered_target_has_bar_ && !(spec.overlay_moving_bar && rendered_target_bar_x_ == bar_x);
+    if (can_repair_in_place && !stale_bar_column) {
       ++debug_stats_.base_copy_skipped_count;
     } else {
       const auto copy_t0 = std::chrono::steady_clock::now();
-      copy_base_to(dst);
+      if (can_repair_in_place) {
+        copy_base_column_to(dst, rendered_target_bar_x_);
+        ++debug_stats_.base_copy_partial_count;
+      } else {
+        copy_base_to(dst);
+      }
       const auto copy_t1 = std::chrono::steady_clock::now();
       const uint64_t copy_ns = static_cast<uint64_t>(
           std::chrono::duration_cast<std::chrono::nanoseconds>(copy_t1 - copy_t0).count());
@@ -141,16 +237,14 @@ void CpuPackedPatternRenderer::render_into(
     rendered_target_height_ = dst.height;
     rendered_target_stride_bytes_ = dst.stride_bytes;
     rendered_target_format_ = dst.format;
+    rendered_target_base_exact_ = output_base_exact;
+    rendered_target_has_bar_ = spec.overlay_moving_bar;
+    rendered_target_bar_x_ = bar_x;
   }
 
   const auto overlay_t0 = std::chrono::steady_clock::now();
-  if (spec.overlay_frame_index_offsets) {
-    apply_frame_index_offsets(spec, dst, overlay.frame_index);
-  }
-  if (spec.overlay_moving_bar) {
-    apply_moving_bar(spec, dst, overlay.frame_index);
-  }
-  if (options.applied_exposure_compensation_milli_ev != 0) {
+  apply_overlays(spec, dst, overlay.frame_index);
+  if (exposure_adjusted) {
     apply_exposure_compensation(dst, options.applied_exposure_compensation_milli_ev);
   }
   const auto overlay_t1 = std::chrono::steady_clock::now();
@@ -158,6 +252,27 @@ void CpuPackedPatternRenderer::render_into(
       std::chrono::duration_cast<std::chrono::nanoseconds>(overlay_t1 - overlay_t0).count());
   debug_stats_.overlay_total_ns += overlay_ns;
   debug_stats_.overlay_max_ns = std::max(debug_stats_.overlay_max_ns, overlay_ns);
+
+  const bool diffable =
+      has_rendered_frame_ &&
+      output_base_exact &&
+      last_output_base_exact_ &&
+      last_output_base_key_ == key;
+  if (!diffable) {
+    last_dirty_rect_ = PatternDirtyRect::full(dst.width, dst.height);
+  } else {
+    const PatternDirtyRect previous_bar =
+        last_output_has_bar_ ? PatternDirtyRect{last_output_bar_x_, 0, 1, dst.height} : PatternDirtyRect{};
+    const PatternDirtyRect current_bar =
+        spec.overlay_moving_bar ? PatternDirtyRect{bar_x, 0, 1, dst.height} : PatternDirtyRect{};
+    const bool same_bar =
+        last_output_has_bar_ == spec.overlay_moving_bar && (!spec.overlay_moving_bar || last_output_bar_x_ == bar_x);
+    last_dirty_rect_ = same_bar ? PatternDirtyRect{} : previous_bar.united(current_bar);
+  }
+  last_output_base_exact_ = output_base_exact;
+  last_output_base_key_ = key;
+  last_output_has_bar_ = spec.overlay_moving_bar;
+  last_output_bar_x_ = bar_x;
   has_rendered_frame_ = true;
 }
 
@@ -195,63 +310,270 @@ void CpuPackedPatternRenderer::apply_exposure_compensation(
   }
 }
 
+namespace {
+
+constexpr PatternSpec::PackedFormat kRgba8 = PatternSpec::PackedFormat::RGBA8;
+
+// One packed pixel as the little-endian uint32 a row store writes.
+template <PatternSpec::PackedFormat F>
+constexpr uint32_t pack_px(uint8_t r, uint8_t g, uint8_t b, uint8_t a) noexcept {
+  if constexpr (F == kRgba8) {
+    return static_cast<uint32_t>(r) | (static_cast<uint32_t>(g) << 8) | (static_cast<uint32_t>(b) << 16) |
+           (static_cast<uint32_t>(a) << 24);
+  } else {
+    return static_cast<uint32_t>(b) | (static_cast<uint32_t>(g) << 8) | (static_cast<uint32_t>(r) << 16) |
+           (static_cast<uint32_t>(a) << 24);
+  }
+}
+
+inline void store_px(uint8_t* row, uint32_t x, uint32_t px) noexcept {
+  std::memcpy(row + static_cast<size_t>(x) * 4u, &px, sizeof(px));
+}
+
+inline void fill_px(uint8_t* row, uint32_t x_begin, uint32_t x_end, uint32_t px) noexcept {
+  for (uint32_t x = x_begin; x < x_end; ++x) {
+    store_px(row, x, px);
+  }
+}
+
+inline uint8_t* row_at(uint8_t* dst, uint32_t dst_stride_bytes, uint32_t y) noexcept {
+  return dst + static_cast<size_t>(y) * static_cast<size_t>(dst_stride_bytes);
+}
+
+// Copies row src_y over rows [row_begin, row_end) except src_y itself.
+inline void replicate_row(uint8_t* dst,
+                          uint32_t dst_stride_bytes,
+                          uint32_t src_y,
+                          uint32_t row_begin,
+                          uint32_t row_end,
+                          uint32_t width) noexcept {
+  const uint8_t* src = row_at(dst, dst_stride_bytes, src_y);
+  for (uint32_t y = row_begin; y < row_end; ++y) {
+    if (y != src_y) {
+      std::memcpy(row_at(dst, dst_stride_bytes, y), src, static_cast<size_t>(width) * 4u);
+    }
+  }
+}
+
+// Deterministic hash; no state. (Splitmix32-ish.)
+inline uint32_t noise_hash32(uint32_t v) noexcept {
+  v += 0x9E3779B9u;
+  v ^= v >> 16;
+  v *= 0x85EBCA6Bu;
+  v ^= v >> 13;
+  v *= 0xC2B2AE35u;
+  v ^= v >> 16;
+  return v;
+}
+
+constexpr uint32_t kNoiseMulX = 0x1E35A7BDu;
+constexpr uint32_t kNoiseMulY = 0x94D049BBu;
+constexpr uint32_t kNoiseMulPhase = 0xD1B54A35u;
+
+// Noise pixel for hash r: R, G, B are its low three bytes, A is opaque.
+template <PatternSpec::PackedFormat F>
+inline uint32_t noise_px(uint32_t r) noexcept {
+  if constexpr (F == kRgba8) {
+    return r | 0xFF000000u;
+  } else {
+    return (r & 0x0000FF00u) | ((r >> 16) & 0x000000FFu) | ((r & 0x000000FFu) << 16) | 0xFF000000u;
+  }
+}
+
+#if defined(CAMBANG_PIXELS_SSE2)
+
+// Interleaves 16 R, G, B bytes with opaque alpha into 16 packed pixels.
+template <PatternSpec::PackedFormat F>
+inline void store16_rgb(uint8_t* p, __m128i r, __m128i g, __m128i b) noexcept {
+  const __m128i a = _mm_set1_epi8(static_cast<char>(0xFF));
+  __m128i c0 = b;
+  __m128i c2 = r;
+  if constexpr (F == kRgba8) {
+    c0 = r;
+    c2 = b;
+  }
+  const __m128i lo01 = _mm_unpacklo_epi8(c0, g);
+  const __m128i hi01 = _mm_unpackhi_epi8(c0, g);
+  const __m128i lo23 = _mm_unpacklo_epi8(c2, a);
+  const __m128i hi23 = _mm_unpackhi_epi8(c2, a);
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(p + 0), _mm_unpacklo_epi16(lo01, lo23));
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(p + 16), _mm_unpackhi_epi16(lo01, lo23));
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(p + 32), _mm_unpacklo_epi16(hi01, hi23));
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(p + 48), _mm_unpackhi_epi16(hi01, hi23));
+}
+
+// 32-bit lane multiply; pmulld is SSE4.1, so build it from two pmuludq.
+inline __m128i mullo_epu32(__m128i a, __m128i b) noexcept {
+  const __m128i even = _mm_mul_epu32(a, b);
+  const __m128i odd = _mm_mul_epu32(_mm_srli_epi64(a, 32), _mm_srli_epi64(b, 32));
+  return _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)),
+                            _mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0)));
+}
+
+inline __m128i noise_hash32x4(__m128i v) noexcept {
+  v = _mm_add_epi32(v, _mm_set1_epi32(static_cast<int>(0x9E3779B9u)));
+  v = _mm_xor_si128(v, _mm_srli_epi32(v, 16));
+  v = mullo_epu32(v, _mm_set1_epi32(static_cast<int>(0x85EBCA6Bu)));
+  v = _mm_xor_si128(v, _mm_srli_epi32(v, 13));
+  v = mullo_epu32(v, _mm_set1_epi32(static_cast<int>(0xC2B2AE35u)));
+  return _mm_xor_si128(v, _mm_srli_epi32(v, 16));
+}
+
+template <PatternSpec::PackedFormat F>
+inline __m128i noise_px4(__m128i r) noexcept {
+  const __m128i opaque = _mm_set1_epi32(static_cast<int>(0xFF000000u));
+  if constexpr (F == kRgba8) {
+    return _mm_or_si128(r, opaque);
+  } else {
+    const __m128i low_byte = _mm_set1_epi32(0x000000FF);
+    const __m128i g = _mm_and_si128(r, _mm_set1_epi32(0x0000FF00));
+    const __m128i to_b = _mm_and_si128(_mm_srli_epi32(r, 16), low_byte);
+    const __m128i to_r = _mm_slli_epi32(_mm_and_si128(r, low_byte), 16);
+    return _mm_or_si128(_mm_or_si128(g, to_b), _mm_or_si128(to_r, opaque));
+  }
+}
+
+#elif defined(CAMBANG_PIXELS_NEON)
+
+template <PatternSpec::PackedFormat F>
+inline void store16_rgb(uint8_t* p, uint8x16_t r, uint8x16_t g, uint8x16_t b) noexcept {
+  uint8x16x4_t px;
+  if constexpr (F == kRgba8) {
+    px.val[0] = r;
+    px.val[2] = b;
+  } else {
+    px.val[0] = b;
+    px.val[2] = r;
+  }
+  px.val[1] = g;
+  px.val[3] = vdupq_n_u8(0xFF);
+  vst4q_u8(p, px);
+}
+
+inline uint32x4_t noise_hash32x4(uint32x4_t v) noexcept {
+  v = vaddq_u32(v, vdupq_n_u32(0x9E3779B9u));
+  v = veorq_u32(v, vshrq_n_u32(v, 16));
+  v = vmulq_n_u32(v, 0x85EBCA6Bu);
+  v = veorq_u32(v, vshrq_n_u32(v, 13));
+  v = vmulq_n_u32(v, 0xC2B2AE35u);
+  return veorq_u32(v, vshrq_n_u32(v, 16));
+}
+
+template <PatternSpec::PackedFormat F>
+inline uint32x4_t noise_px4(uint32x4_t r) noexcept {
+  const uint32x4_t opaque = vdupq_n_u32(0xFF000000u);
+  if constexpr (F == kRgba8) {
+    return vorrq_u32(r, opaque);
+  } else {
+    // Swap bytes 0 and 2 of each lane: reverse the lane's bytes, then shift
+    // the reversed value down one byte (the opaque OR restores byte 3).
+    const uint32x4_t reversed = vreinterpretq_u32_u8(vrev32q_u8(vreinterpretq_u8_u32(r)));
+    return vorrq_u32(vshrq_n_u32(reversed, 8), opaque);
+  }
+}
+
+#endif
+
+} // namespace
+
+template <PatternSpec::PackedFormat F>
 void CpuPackedPatternRenderer::render_base_xy_xor(
     uint8_t* dst,
     uint32_t dst_stride_bytes,
     const PatternSpec& /*spec*/,
     const PatternBaseKey& key,
-    const PatternOverlayData& /*overlay*/) {
-  // Base: r=x, g=y, b=x^y, a=255.
-  for (uint32_t y = 0; y < key.height; ++y) {
-    uint8_t* row = dst + static_cast<size_t>(y) * static_cast<size_t>(dst_stride_bytes);
-    for (uint32_t x = 0; x < key.width; ++x) {
+    const PatternOverlayData& /*overlay*/,
+    uint32_t row_begin,
+    uint32_t row_end) {
+  // Base: r=x, g=y, b=x^y, a=255. Only the low byte of x and y matters, so
+  // 16 consecutive x fit one byte vector (wrapping exactly like x & 0xFF).
+#if defined(CAMBANG_PIXELS_SSE2)
+  const __m128i iota = _mm_setr_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+#elif defined(CAMBANG_PIXELS_NEON)
+  static const uint8_t kIota[16] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15};
+  const uint8x16_t iota = vld1q_u8(kIota);
+#endif
+  for (uint32_t y = row_begin; y < row_end; ++y) {
+    uint8_t* row = row_at(dst, dst_stride_bytes, y);
+    uint32_t x = 0;
+#if defined(CAMBANG_PIXELS_SSE2)
+    const __m128i g = _mm_set1_epi8(static_cast<char>(y & 0xFFu));
+    for (; x + 16 <= key.width; x += 16) {
+      const __m128i r = _mm_add_epi8(_mm_set1_epi8(static_cast<char>(x & 0xFFu)), iota);
+      store16_rgb<F>(row + static_cast<size_t>(x) * 4u, r, g, _mm_xor_si128(r, g));
+    }
+#elif defined(CAMBANG_PIXELS_NEON)
+    const uint8x16_t g = vdupq_n_u8(static_cast<uint8_t>(y & 0xFFu));
+    for (; x + 16 <= key.width; x += 16) {
+      const uint8x16_t r = vaddq_u8(vdupq_n_u8(static_cast<uint8_t>(x & 0xFFu)), iota);
+      store16_rgb<F>(row + static_cast<size_t>(x) * 4u, r, g, veorq_u8(r, g));
+    }
+#endif
+    for (; x < key.width; ++x) {
       const uint8_t r = static_cast<uint8_t>(x & 0xFF);
       const uint8_t g = static_cast<uint8_t>(y & 0xFF);
       const uint8_t b = static_cast<uint8_t>((x ^ y) & 0xFF);
-      write_px(row + static_cast<size_t>(x) * 4u, key.format, r, g, b, 0xFF);
+      store_px(row, x, pack_px<F>(r, g, b, 0xFF));
     }
   }
 }
 
+template <PatternSpec::PackedFormat F>
 void CpuPackedPatternRenderer::render_base_solid(
     uint8_t* dst,
     uint32_t dst_stride_bytes,
     const PatternSpec& spec,
     const PatternBaseKey& /*key*/,
-    const PatternOverlayData& /*overlay*/) {
-  for (uint32_t y = 0; y < spec.height; ++y) {
-    uint8_t* row = dst + static_cast<size_t>(y) * static_cast<size_t>(dst_stride_bytes);
-    for (uint32_t x = 0; x < spec.width; ++x) {
-      write_px(row + static_cast<size_t>(x) * 4u, spec.format, spec.solid_r, spec.solid_g, spec.solid_b, spec.solid_a);
-    }
+    const PatternOverlayData& /*overlay*/,
+    uint32_t row_begin,
+    uint32_t row_end) {
+  if (row_begin >= row_end) {
+    return;
   }
+  const uint32_t px = pack_px<F>(spec.solid_r, spec.solid_g, spec.solid_b, spec.solid_a);
+  fill_px(row_at(dst, dst_stride_bytes, row_begin), 0, spec.width, px);
+  replicate_row(dst, dst_stride_bytes, row_begin, row_begin, row_end, spec.width);
 }
 
+template <PatternSpec::PackedFormat F>
 void CpuPackedPatternRenderer::render_base_checker(
     uint8_t* dst,
     uint32_t dst_stride_bytes,
     const PatternSpec& spec,
     const PatternBaseKey& /*key*/,
-    const PatternOverlayData& /*overlay*/) {
+    const PatternOverlayData& /*overlay*/,
+    uint32_t row_begin,
+    uint32_t row_end) {
+  // A row depends only on the parity of its cell row, so each band renders
+  // at most two rows as runs of one colour and copies the rest.
   const uint32_t step = (spec.checker_size_px == 0) ? 16u : spec.checker_size_px;
-  for (uint32_t y = 0; y < spec.height; ++y) {
-    uint8_t* row = dst + static_cast<size_t>(y) * static_cast<size_t>(dst_stride_bytes);
-    const uint32_t cy = (y / step);
-    for (uint32_t x = 0; x < spec.width; ++x) {
-      const uint32_t cx = (x / step);
-      const bool on = ((cx + cy) & 1u) != 0u;
-      const uint8_t v = on ? 0xE0 : 0x20;
-      write_px(row + static_cast<size_t>(x) * 4u, spec.format, v, v, v, 0xFF);
+  const uint32_t on_px = pack_px<F>(0xE0, 0xE0, 0xE0, 0xFF);
+  const uint32_t off_px = pack_px<F>(0x20, 0x20, 0x20, 0xFF);
+  uint32_t rendered_y[2] = {UINT32_MAX, UINT32_MAX};
+  for (uint32_t y = row_begin; y < row_end; ++y) {
+    uint8_t* row = row_at(dst, dst_stride_bytes, y);
+    const uint32_t parity = (y / step) & 1u;
+    if (rendered_y[parity] != UINT32_MAX) {
+      std::memcpy(row, row_at(dst, dst_stride_bytes, rendered_y[parity]), static_cast<size_t>(spec.width) * 4u);
+      continue;
+    }
+    for (uint32_t x0 = 0; x0 < spec.width; x0 += step) {
+      const bool on = (((x0 / step) + parity) & 1u) != 0u;
+      fill_px(row, x0, std::min(spec.width, x0 + step), on ? on_px : off_px);
     }
+    rendered_y[parity] = y;
   }
 }
 
+template <PatternSpec::PackedFormat F>
 void CpuPackedPatternRenderer::render_base_color_bars(
     uint8_t* dst,
     uint32_t dst_stride_bytes,
     const PatternSpec& spec,
     const PatternBaseKey& /*key*/,
-    const PatternOverlayData& /*overlay*/) {
+    const PatternOverlayData& /*overlay*/,
+    uint32_t row_begin,
+    uint32_t row_end) {
   // Deterministic 7-bar palette (SMPTE-ish). Intended for visual validation.
   struct RGBA { uint8_t r, g, b, a; };
   static constexpr RGBA bars[7] = {
@@ -263,27 +585,37 @@ void CpuPackedPatternRenderer::render_base_color_bars(
       {0xEB, 0x00, 0x00, 0xFF},
       {0x00, 0x00, 0xEB, 0xFF},
   };
+  if (row_begin >= row_end) {
+    return;
+  }
 
   const uint32_t w = (spec.width == 0) ? 1u : spec.width;
   const uint32_t bar_w = std::max<uint32_t>(1u, w / 7u);
 
-  for (uint32_t y = 0; y < spec.height; ++y) {
-    uint8_t* row = dst + static_cast<size_t>(y) * static_cast<size_t>(dst_stride_bytes);
-    for (uint32_t x = 0; x < spec.width; ++x) {
-      uint32_t idx = x / bar_w;
-      if (idx > 6u) idx = 6u;
-      const RGBA c = bars[idx];
-      write_px(row + static_cast<size_t>(x) * 4u, spec.format, c.r, c.g, c.b, c.a);
+  // Every row is identical: fill one as runs, copy it to the rest.
+  uint8_t* first = row_at(dst, dst_stride_bytes, row_begin);
+  for (uint32_t idx = 0; idx < 7u; ++idx) {
+    const uint32_t x0 = idx * bar_w;
+    if (x0 >= spec.width) {
+      break;
     }
+    // The last bar absorbs the remainder columns.
+    const uint32_t x1 = (idx == 6u) ? spec.width : std::min(spec.width, x0 + bar_w);
+    const RGBA c = bars[idx];
+    fill_px(first, x0, x1, pack_px<F>(c.r, c.g, c.b, c.a));
   }
+  replicate_row(dst, dst_stride_bytes, row_begin, row_begin, row_end, spec.width);
 }
 
+template <PatternSpec::PackedFormat F>
 void CpuPackedPatternRenderer::render_base_radial_gradient(
     uint8_t* dst,
     uint32_t dst_stride_bytes,
     const PatternSpec& spec,
     const PatternBaseKey& /*key*/,
-    const PatternOverlayData& /*overlay*/) {
+    const PatternOverlayData& /*overlay*/,
+    uint32_t row_begin,
+    uint32_t row_end) {
   // Smooth radial gradient: bright center -> darker edges, with blue edge cue.
   const uint32_t w = spec.width;
   const uint32_t h = spec.height;
@@ -298,32 +630,38 @@ void CpuPackedPatternRenderer::render_base_radial_gradient(
   const int64_t ry = static_cast<int64_t>(cy);
   const int64_t max_r2 = std::max<int64_t>(1, rx * rx + ry * ry);
 
-  for (uint32_t y = 0; y < h; ++y) {
-    uint8_t* row = dst + static_cast<size_t>(y) * static_cast<size_t>(dst_stride_bytes);
-    const int32_t dy = static_cast<int32_t>(y) - cy;
+  for (uint32_t y = row_begin; y < row_end; ++y) {
+    uint8_t* row = row_at(dst, dst_stride_bytes, y);
+    const int64_t dy = static_cast<int64_t>(y) - cy;
+    // r2 advances by 2*dx + 1 per column; the division stays exact integer
+    // math so the bytes match the closed form.
+    int64_t dx = -static_cast<int64_t>(cx);
+    int64_t r2 = dx * dx + dy * dy;
     for (uint32_t x = 0; x < w; ++x) {
-      const int32_t dx = static_cast<int32_t>(x) - cx;
-      const int64_t r2 = static_cast<int64_t>(dx) * dx + static_cast<int64_t>(dy) * dy;
-
       uint32_t t = static_cast<uint32_t>((r2 * 255) / max_r2);
       if (t > 255u) t = 255u;
 
       const uint8_t v = static_cast<uint8_t>(255u - t);
-      const uint8_t b = static_cast<uint8_t>(std::min<uint32_t>(255u, t));
+      const uint8_t b = static_cast<uint8_t>(t);
       const uint8_t g = static_cast<uint8_t>((static_cast<uint32_t>(v) * 3u) / 4u);
       const uint8_t r = v;
 
-      write_px(row + static_cast<size_t>(x) * 4u, spec.format, r, g, b, 0xFF);
+      store_px(row, x, pack_px<F>(r, g, b, 0xFF));
+      r2 += 2 * dx + 1;
+      ++dx;
     }
   }
 }
 
+template <PatternSpec::PackedFormat F>
 void CpuPackedPatternRenderer::render_base_corners_rgba(
     uint8_t* dst,
     uint32_t dst_stride_bytes,
     const PatternSpec& spec,
     const PatternBaseKey& key,
-    const PatternOverlayData& /*overlay*/) {
+    const PatternOverlayData& /*overlay*/,
+    uint32_t /*row_begin*/,
+    uint32_t /*row_end*/) {
   const uint32_t w = key.width;
   const uint32_t h = key.height;
   if (w == 0 || h == 0) {
@@ -335,39 +673,29 @@ void CpuPackedPatternRenderer::render_base_corners_rgba(
   const uint32_t ch = std::max<uint32_t>(1u, h / 8u);
 
   // Background colour uses spec.solid_* so callers can exercise --rgba.
-  const uint8_t bg_r = spec.solid_r;
-  const uint8_t bg_g = spec.solid_g;
-  const uint8_t bg_b = spec.solid_b;
-  const uint8_t bg_a = spec.solid_a;
+  const uint32_t bg = pack_px<F>(spec.solid_r, spec.solid_g, spec.solid_b, spec.solid_a);
 
   // Canonical corner swatches (alpha=255):
   // TL red, TR green, BL blue, BR white.
-  constexpr uint8_t TL[4] = {0xFF, 0x00, 0x00, 0xFF};
-  constexpr uint8_t TR[4] = {0x00, 0xFF, 0x00, 0xFF};
-  constexpr uint8_t BL[4] = {0x00, 0x00, 0xFF, 0xFF};
-  constexpr uint8_t BR[4] = {0xFF, 0xFF, 0xFF, 0xFF};
+  constexpr uint32_t TL = pack_px<F>(0xFF, 0x00, 0x00, 0xFF);
+  constexpr uint32_t TR = pack_px<F>(0x00, 0xFF, 0x00, 0xFF);
+  constexpr uint32_t BL = pack_px<F>(0x00, 0x00, 0xFF, 0xFF);
+  constexpr uint32_t BR = pack_px<F>(0xFF, 0xFF, 0xFF, 0xFF);
 
   // Optional border/crosshair colours.
-  constexpr uint8_t BORDER[4] = {0xFF, 0xFF, 0xFF, 0xFF};
-  constexpr uint8_t CROSS[4]  = {0xFF, 0xFF, 0x00, 0xFF}; // yellow
+  constexpr uint32_t BORDER = pack_px<F>(0xFF, 0xFF, 0xFF, 0xFF);
+  constexpr uint32_t CROSS = pack_px<F>(0xFF, 0xFF, 0x00, 0xFF); // yellow
 
   // 1) Fill background.
-  for (uint32_t y = 0; y < h; ++y) {
-    uint8_t* row = dst + static_cast<size_t>(y) * static_cast<size_t>(dst_stride_bytes);
-    for (uint32_t x = 0; x < w; ++x) {
-      write_px(row + static_cast<size_t>(x) * 4u, key.format, bg_r, bg_g, bg_b, bg_a);
-    }
-  }
+  fill_px(dst, 0, w, bg);
+  replicate_row(dst, dst_stride_bytes, 0, 0, h, w);
 
   // Helper lambda for solid rect fill.
-  auto fill_rect = [&](uint32_t x0, uint32_t y0, uint32_t rw, uint32_t rh, const uint8_t c[4]) {
+  auto fill_rect = [&](uint32_t x0, uint32_t y0, uint32_t rw, uint32_t rh, uint32_t c) {
     const uint32_t x1 = std::min<uint32_t>(w, x0 + rw);
     const uint32_t y1 = std::min<uint32_t>(h, y0 + rh);
     for (uint32_t y = y0; y < y1; ++y) {
-      uint8_t* row = dst + static_cast<size_t>(y) * static_cast<size_t>(dst_stride_bytes);
-      for (uint32_t x = x0; x < x1; ++x) {
-        write_px(row + static_cast<size_t>(x) * 4u, key.format, c[0], c[1], c[2], c[3]);
-      }
+      fill_px(row_at(dst, dst_stride_bytes, y), x0, x1, c);
     }
   };
 
@@ -378,18 +706,12 @@ void CpuPackedPatternRenderer::render_base_corners_rgba(
   fill_rect(w - cw, h - ch, cw, ch, BR);
 
   // 3) 1px border.
-  {
-    uint8_t* top = dst;
-    uint8_t* bot = dst + static_cast<size_t>(h - 1u) * static_cast<size_t>(dst_stride_bytes);
-    for (uint32_t x = 0; x < w; ++x) {
-      write_px(top + static_cast<size_t>(x) * 4u, key.format, BORDER[0], BORDER[1], BORDER[2], BORDER[3]);
-      write_px(bot + static_cast<size_t>(x) * 4u, key.format, BORDER[0], BORDER[1], BORDER[2], BORDER[3]);
-    }
-  }
+  fill_px(dst, 0, w, BORDER);
+  fill_px(row_at(dst, dst_stride_bytes, h - 1u), 0, w, BORDER);
   for (uint32_t y = 0; y < h; ++y) {
-    uint8_t* row = dst + static_cast<size_t>(y) * static_cast<size_t>(dst_stride_bytes);
-    write_px(row + 0u, key.format, BORDER[0], BORDER[1], BORDER[2], BORDER[3]);
-    write_px(row + static_cast<size_t>(w - 1u) * 4u, key.format, BORDER[0], BORDER[1], BORDER[2], BORDER[3]);
+    uint8_t* row = row_at(dst, dst_stride_bytes, y);
+    store_px(row, 0, BORDER);
+    store_px(row, w - 1u, BORDER);
   }
 
   // 4) 1px crosshair at center.
@@ -397,141 +719,231 @@ void CpuPackedPatternRenderer::render_base_corners_rgba(
   const uint32_t mid_y = h / 2u;
 
   for (uint32_t y = 0; y < h; ++y) {
-    uint8_t* row = dst + static_cast<size_t>(y) * static_cast<size_t>(dst_stride_bytes);
-    write_px(row + static_cast<size_t>(mid_x) * 4u, key.format, CROSS[0], CROSS[1], CROSS[2], CROSS[3]);
-  }
-  {
-    uint8_t* row = dst + static_cast<size_t>(mid_y) * static_cast<size_t>(dst_stride_bytes);
-    for (uint32_t x = 0; x < w; ++x) {
-      write_px(row + static_cast<size_t>(x) * 4u, key.format, CROSS[0], CROSS[1], CROSS[2], CROSS[3]);
-    }
+    store_px(row_at(dst, dst_stride_bytes, y), mid_x, CROSS);
   }
+  fill_px(row_at(dst, dst_stride_bytes, mid_y), 0, w, CROSS);
 }
 
-
+template <PatternSpec::PackedFormat F>
 void CpuPackedPatternRenderer::render_base_noise_common(
       uint8_t* dst,
       uint32_t dst_stride_bytes,
       const PatternSpec& spec,
       const PatternBaseKey& key,
-      uint32_t phase) {
+      uint32_t phase,
+      uint32_t row_begin,
+      uint32_t row_end) {
   const uint32_t w = key.width;
   const uint32_t h = key.height;
   if (w == 0 || h == 0) {
     return;
   }
 
-  // Deterministic hash; no state. (Splitmix32-ish.)
-  auto hash32 = [](uint32_t v) -> uint32_t {
-    v += 0x9E3779B9u;
-    v ^= v >> 16;
-    v *= 0x85EBCA6Bu;
-    v ^= v >> 13;
-    v *= 0xC2B2AE35u;
-    v ^= v >> 16;
-    return v;
-  };
-
   const uint32_t seed = spec.seed;
 
-  for (uint32_t y = 0; y < h; ++y) {
-    uint8_t* row = dst + static_cast<size_t>(y) * static_cast<size_t>(dst_stride_bytes);
-    for (uint32_t x = 0; x < w; ++x) {
-      const uint32_t v =
-          seed ^
-          (x * 0x1E35A7BDu) ^
-          (y * 0x94D049BBu) ^
-          (phase * 0xD1B54A35u);
-
-      const uint32_t r = hash32(v);
-
-      const uint8_t R = static_cast<uint8_t>(r >> 0);
-      const uint8_t G = static_cast<uint8_t>(r >> 8);
-      const uint8_t B = static_cast<uint8_t>(r >> 16);
-      const uint8_t A = 0xFF;
-
-      write_px(row + static_cast<size_t>(x) * 4u, key.format, R, G, B, A);
+  for (uint32_t y = row_begin; y < row_end; ++y) {
+    uint8_t* row = row_at(dst, dst_stride_bytes, y);
+    // Everything but the x term is constant along the row.
+    const uint32_t row_key = seed ^ (y * kNoiseMulY) ^ (phase * kNoiseMulPhase);
+    uint32_t x = 0;
+#if defined(CAMBANG_PIXELS_SSE2)
+    const __m128i key4 = _mm_set1_epi32(static_cast<int>(row_key));
+    const __m128i step4 = _mm_set1_epi32(static_cast<int>(4u * kNoiseMulX));
+    __m128i xmul = _mm_setr_epi32(0, static_cast<int>(kNoiseMulX), static_cast<int>(2u * kNoiseMulX),
+                                  static_cast<int>(3u * kNoiseMulX));
+    for (; x + 4 <= w; x += 4) {
+      const __m128i r = noise_hash32x4(_mm_xor_si128(xmul, key4));
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(row + static_cast<size_t>(x) * 4u), noise_px4<F>(r));
+      xmul = _mm_add_epi32(xmul, step4);
+    }
+#elif defined(CAMBANG_PIXELS_NEON)
+    static const uint32_t kLaneMul[4] = {0u, kNoiseMulX, 2u * kNoiseMulX, 3u * kNoiseMulX};
+    const uint32x4_t key4 = vdupq_n_u32(row_key);
+    const uint32x4_t step4 = vdupq_n_u32(4u * kNoiseMulX);
+    uint32x4_t xmul = vld1q_u32(kLaneMul);
+    for (; x + 4 <= w; x += 4) {
+      const uint32x4_t r = noise_hash32x4(veorq_u32(xmul, key4));
+      vst1q_u8(row + static_cast<size_t>(x) * 4u, vreinterpretq_u8_u32(noise_px4<F>(r)));
+      xmul = vaddq_u32(xmul, step4);
+    }
+#endif
+    for (; x < w; ++x) {
+      store_px(row, x, noise_px<F>(noise_hash32(row_key ^ (x * kNoiseMulX))));
     }
   }
 }
 
+template <PatternSpec::PackedFormat F>
 void CpuPackedPatternRenderer::render_base_noise(
       uint8_t* dst,
       uint32_t dst_stride_bytes,
       const PatternSpec& spec,
       const PatternBaseKey& key,
-      const PatternOverlayData& /*overlay*/) {
+      const PatternOverlayData& /*overlay*/,
+      uint32_t row_begin,
+      uint32_t row_end) {
   // Static noise is cacheable: phase is constant.
-  render_base_noise_common(dst, dst_stride_bytes, spec, key, /*phase=*/0u);
+  render_base_noise_common<F>(dst, dst_stride_bytes, spec, key, /*phase=*/0u, row_begin, row_end);
 }
 
+template <PatternSpec::PackedFormat F>
 void CpuPackedPatternRenderer::render_base_noise_animated(
       uint8_t* dst,
       uint32_t dst_stride_bytes,
       const PatternSpec& spec,
       const PatternBaseKey& key,
-      const PatternOverlayData& overlay) {
+      const PatternOverlayData& overlay,
+      uint32_t row_begin,
+      uint32_t row_end) {
   // Dynamic noise: phase is per-frame -> dynamic_base preset bypasses base cache.
   const uint32_t phase = static_cast<uint32_t>(overlay.frame_index);
-  render_base_noise_common(dst, dst_stride_bytes, spec, key, phase);
+  render_base_noise_common<F>(dst, dst_stride_bytes, spec, key, phase, row_begin, row_end);
+}
+
+#define CAMBANG_PATTERN_ALGO_KERNEL(algo_id, kernel, row_separable_)                    \
+  template <>                                                                            \
+  struct CpuPackedPatternRenderer::AlgoKernel<PatternAlgoId::algo_id> {                  \
+    static constexpr bool kRowSeparable = row_separable_;                                \
+    template <PatternSpec::PackedFormat F>                                               \
+    static constexpr RenderBaseFn fn = &CpuPackedPatternRenderer::kernel<F>;             \
+  };
+
+// row_separable: corners_rgba paints overlapping rects over the whole frame.
+CAMBANG_PATTERN_ALGO_KERNEL(XyXor, render_base_xy_xor, true)
+CAMBANG_PATTERN_ALGO_KERNEL(Solid, render_base_solid, true)
+CAMBANG_PATTERN_ALGO_KERNEL(Checker, render_base_checker, true)
+CAMBANG_PATTERN_ALGO_KERNEL(ColorBars, render_base_color_bars, true)
+CAMBANG_PATTERN_ALGO_KERNEL(RadialGradient, render_base_radial_gradient, true)
+CAMBANG_PATTERN_ALGO_KERNEL(CornersRgba, render_base_corners_rgba, false)
+CAMBANG_PATTERN_ALGO_KERNEL(Noise, render_base_noise, true)
+CAMBANG_PATTERN_ALGO_KERNEL(NoiseAnimated, render_base_noise_animated, true)
+
+#undef CAMBANG_PATTERN_ALGO_KERNEL
+
+template <PatternSpec::PackedFormat F>
+const CpuPackedPatternRenderer::AlgoEntry* CpuPackedPatternRenderer::algo_table() noexcept {
+  // Indexed by PatternAlgoId; a new algo without an AlgoKernel fails to compile.
+  static constexpr AlgoEntry kAlgos[] = {
+#define X(preset_id, token_name, display_name, caps_bitmask, algo_id, dynamic_base) \
+      {AlgoKernel<PatternAlgoId::algo_id>::template fn<F>, AlgoKernel<PatternAlgoId::algo_id>::kRowSeparable},
+#include "pixels/pattern/pattern_defs.inc"
+#undef X
+  };
+  static_assert(sizeof(kAlgos) / sizeof(kAlgos[0]) == pattern_algo_count());
+  return kAlgos;
 }
 
 void CpuPackedPatternRenderer::copy_base_to(const PatternRenderTarget& dst) const {
   // Row copy (dst stride may differ from tight base stride).
-  const uint32_t row_bytes = base_stride_bytes_;
+  const uint32_t row_bytes = base_->stride_bytes;
   for (uint32_t y = 0; y < dst.height; ++y) {
-    const uint8_t* src_row = base_pixels_.data() + static_cast<size_t>(y) * row_bytes;
+    const uint8_t* src_row = base_->pixels.data() + static_cast<size_t>(y) * row_bytes;
     uint8_t* dst_row = dst.row_ptr(y);
     std::memcpy(dst_row, src_row, row_bytes);
   }
 }
 
-void CpuPackedPatternRenderer::apply_frame_index_offsets(
-    const PatternSpec& spec,
-    const PatternRenderTarget& dst,
-    uint64_t frame_index) const {
+void CpuPackedPatternRenderer::copy_base_column_to(const PatternRenderTarget& dst, uint32_t x) const {
+  if (x >= dst.width) return;
+  const size_t offset = static_cast<size_t>(x) * PatternRenderTarget::bytes_per_pixel();
+  for (uint32_t y = 0; y < dst.height; ++y) {
+    const uint8_t* src_px = base_->pixels.data() + static_cast<size_t>(y) * base_->stride_bytes + offset;
+    std::memcpy(dst.row_ptr(y) + offset, src_px, PatternRenderTarget::bytes_per_pixel());
+  }
+}
+
+uint32_t CpuPackedPatternRenderer::frame_index_offset_px(PatternSpec::PackedFormat format,
+                                                        uint64_t frame_index) noexcept {
   // Historical stub behaviour:
   //   r = (x + fi) & 0xFF
   //   g = (y + (fi>>1)) & 0xFF
   //   b = ((x^y) + (fi>>2)) & 0xFF
   //
   // Base already has r=x, g=y, b=x^y.
-  const uint8_t ro = static_cast<uint8_t>(frame_index & 0xFFu);
-  const uint8_t go = static_cast<uint8_t>((frame_index >> 1) & 0xFFu);
-  const uint8_t bo = static_cast<uint8_t>((frame_index >> 2) & 0xFFu);
-
-  if (spec.format == PatternSpec::PackedFormat::RGBA8) {
-    for (uint32_t y = 0; y < dst.height; ++y) {
-      uint8_t* p = dst.row_ptr(y);
-      for (uint32_t x = 0; x < dst.width; ++x) {
-        p[0] = static_cast<uint8_t>(p[0] + ro);
-        p[1] = static_cast<uint8_t>(p[1] + go);
-        p[2] = static_cast<uint8_t>(p[2] + bo);
-        p += 4u;
-      }
-    }
-    return;
+  const uint32_t ro = static_cast<uint32_t>(frame_index & 0xFFu);
+  const uint32_t go = static_cast<uint32_t>((frame_index >> 1) & 0xFFu);
+  const uint32_t bo = static_cast<uint32_t>((frame_index >> 2) & 0xFFu);
+  return (format == PatternSpec::PackedFormat::RGBA8)
+      ? (ro | (go << 8) | (bo << 16))
+      : (bo | (go << 8) | (ro << 16));
+}
+
+void CpuPackedPatternRenderer::apply_overlays(const PatternSpec& spec,
+                                              const PatternRenderTarget& dst,
+                                              uint64_t frame_index) {
+  if (spec.overlay_frame_index_offsets) {
+    apply_frame_index_offsets(spec, dst, frame_index);
   }
+  if (spec.overlay_moving_bar) {
+    apply_moving_bar(spec, dst, frame_index);
+  }
+}
+
+void CpuPackedPatternRenderer::apply_frame_index_offsets(
+    const PatternSpec& spec,
+    const PatternRenderTarget& dst,
+    uint64_t frame_index) {
+  // Added bytewise so each channel wraps on its own.
+  const uint32_t add = frame_index_offset_px(spec.format, frame_index);
+#if defined(CAMBANG_PIXELS_SSE2)
+  const __m128i add4 = _mm_set1_epi32(static_cast<int>(add));
+#elif defined(CAMBANG_PIXELS_NEON)
+  const uint8x16_t add4 = vreinterpretq_u8_u32(vdupq_n_u32(add));
+#endif
 
   for (uint32_t y = 0; y < dst.height; ++y) {
     uint8_t* row = dst.row_ptr(y);
-    for (uint32_t x = 0; x < dst.width; ++x) {
+    uint32_t x = 0;
+#if defined(CAMBANG_PIXELS_SSE2)
+    for (; x + 4 <= dst.width; x += 4) {
+      __m128i* p = reinterpret_cast<__m128i*>(row + static_cast<size_t>(x) * 4u);
+      _mm_storeu_si128(p, _mm_add_epi8(_mm_loadu_si128(p), add4));
+    }
+#elif defined(CAMBANG_PIXELS_NEON)
+    for (; x + 4 <= dst.width; x += 4) {
+      uint8_t* p = row + static_cast<size_t>(x) * 4u;
+      vst1q_u8(p, vaddq_u8(vld1q_u8(p), add4));
+    }
+#endif
+    for (; x < dst.width; ++x) {
+      // Bytewise add without carries between channels (SWAR).
       uint8_t* p = row + static_cast<size_t>(x) * 4u;
-      // BGRA layout: [b,g,r,a]
-      p[2] = static_cast<uint8_t>(p[2] + ro);
-      p[1] = static_cast<uint8_t>(p[1] + go);
-      p[0] = static_cast<uint8_t>(p[0] + bo);
+      uint32_t v = 0;
+      std::memcpy(&v, p, sizeof(v));
+      v = ((v & 0x7F7F7F7Fu) + (add & 0x7F7F7F7Fu)) ^ ((v ^ add) & 0x80808080u);
+      std::memcpy(p, &v, sizeof(v));
     }
   }
 }
 
+uint64_t CpuPackedPatternRenderer::overlay_period_frames(const PatternSpec& spec) noexcept {
+  if (spec.dynamic_base) {
+    return 0;
+  }
+  uint64_t period = 1;
+  if (spec.overlay_frame_index_offsets) {
+    // The slowest offset is (frame_index >> 2) & 0xFF.
+    period = 1024;
+  }
+  if (spec.overlay_moving_bar && spec.width != 0) {
+    const uint64_t width = spec.width;
+    period = std::lcm(period, width / std::gcd(width, uint64_t{4}));
+  }
+  return period;
+}
+
+uint32_t CpuPackedPatternRenderer::moving_bar_x(uint32_t width, uint64_t frame_index) noexcept {
+  if (width == 0) return 0;
+  return static_cast<uint32_t>((frame_index * 4u) % static_cast<uint64_t>(width));
+}
+
 void CpuPackedPatternRenderer::apply_moving_bar(
     const PatternSpec& spec,
     const PatternRenderTarget& dst,
-    uint64_t frame_index) const {
+    uint64_t frame_index) {
   if (dst.width == 0) return;
 
-  const uint32_t bar_x = static_cast<uint32_t>((frame_index * 4u) % static_cast<uint64_t>(dst.width));
+  const uint32_t bar_x = moving_bar_x(dst.width, frame_index);
 
   for (uint32_t y = 0; y < dst.height; ++y) {
     uint8_t* p = dst.row_ptr(y) + static_cast<size_t>(bar_x) * 4u;
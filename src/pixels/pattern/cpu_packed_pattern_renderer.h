@@ -1,35 +1,65 @@
 #pragma once
 
 #include <cstdint>
-#include <vector>
+#include <memory>
 
 #include "pixels/pattern/ipattern_renderer.h"
+#include "pixels/pattern/pattern_algo.h"
+#include "pixels/pattern/pattern_base_cache.h"
 
 namespace cambang {
 
+class PatternBandPool;
+
 // CPU renderer for packed 32-bit RGBA/BGRA buffers.
 //
 // Design:
-// - Base frame cached per PatternBaseKey.
+// - Base frame cached per PatternBaseKey, optionally in a PatternBaseCache
+//   shared with other renderers.
 // - Per-frame overlays applied without allocations.
+// - With a band pool attached, row-separable bases render in parallel row
+//   bands; output bytes do not depend on the pool or its worker count.
+// - For a cached base whose only overlay is the moving bar, re-rendering into
+//   the previous target restores just the old bar column, and
+//   last_dirty_rect() reports the columns that differ from the previous frame
+//   so consumers can upload only that region.
 class CpuPackedPatternRenderer final : public IPatternRenderer {
 public:
   struct DebugStats final {
     uint64_t base_cache_hit_count = 0;
     uint64_t base_cache_miss_count = 0;
+    // Misses served by the shared base cache without rendering.
+    uint64_t base_shared_cache_hit_count = 0;
     uint64_t base_render_total_ns = 0;
     uint64_t base_render_max_ns = 0;
     uint64_t base_copy_total_ns = 0;
     uint64_t base_copy_max_ns = 0;
     uint64_t base_copy_skipped_count = 0;
+    uint64_t base_copy_partial_count = 0;
     uint64_t overlay_total_ns = 0;
     uint64_t overlay_max_ns = 0;
+    // Base renders split across the band pool, and per-band timing for them
+    // (skew: slowest minus fastest band of one render).
+    uint64_t banded_base_render_count = 0;
+    uint64_t base_band_count = 0;
+    uint64_t base_band_total_ns = 0;
+    uint64_t base_band_max_ns = 0;
+    uint64_t base_band_skew_max_ns = 0;
   };
   CpuPackedPatternRenderer() = default;
   ~CpuPackedPatternRenderer() override = default;
 
   void configure(const PatternSpec& spec) override;
 
+  // Optional shared pool for banded base renders; nullptr renders serially.
+  // The pool must outlive every render_into() that may use it.
+  void set_band_pool(PatternBandPool* pool) noexcept { band_pool_ = pool; }
+
+  // Optional cache the base frame is looked up in and published to before
+  // and after rendering it; nullptr keeps the base private to this renderer.
+  // The cache must outlive every configure()/render_into() that may use it.
+  void set_base_cache(PatternBaseCache* cache) noexcept { base_cache_ = cache; }
+
   void render_into(
       const PatternSpec& spec,
       const PatternRenderTarget& dst,
@@ -44,15 +74,46 @@ public:
       const PatternRenderOptions& options) const;
   const DebugStats& debug_stats() const { return debug_stats_; }
 
+  // Frame-index period after which render_into() output for spec (without
+  // render options) repeats: frames whose indices are congruent modulo it are
+  // byte-identical. 0 for a dynamic base, whose output does not repeat.
+  static uint64_t overlay_period_frames(const PatternSpec& spec) noexcept;
+
+  // The cached base for spec, rendered first if needed; nullptr for a
+  // dynamic base. Frames from render_into() are this base plus the overlays.
+  std::shared_ptr<const PatternBaseFrame> base_frame(const PatternSpec& spec);
+
+  // The per-frame overlays on their own, for consumers that apply them to a
+  // base elsewhere (a GPU generator, or its CPU materialization): the offsets
+  // as one packed pixel added bytewise (alpha offset 0), then an opaque white
+  // column at moving_bar_x().
+  static uint32_t frame_index_offset_px(PatternSpec::PackedFormat format, uint64_t frame_index) noexcept;
+  static uint32_t moving_bar_x(uint32_t width, uint64_t frame_index) noexcept;
+  // Applies spec's overlays for frame_index to a copy of the base in dst.
+  static void apply_overlays(const PatternSpec& spec, const PatternRenderTarget& dst, uint64_t frame_index);
+
+  // Region of the most recent render_into() output that differs from the
+  // output of the render_into() call before it, independent of which target
+  // either was written to. Full-frame whenever the difference is not known
+  // exactly (first frame, base or geometry change, dynamic base, full-frame
+  // overlays or exposure compensation).
+  const PatternDirtyRect& last_dirty_rect() const { return last_dirty_rect_; }
+
 private:
   void ensure_base(const PatternSpec& spec);
 
+  // Kernels write rows [row_begin, row_end) of the full frame at dst.
   using RenderBaseFn = void (CpuPackedPatternRenderer::*)(
       uint8_t* dst,
       uint32_t dst_stride_bytes,
       const PatternSpec& spec,
       const PatternBaseKey& key,
-      const PatternOverlayData& overlay);
+      const PatternOverlayData& overlay,
+      uint32_t row_begin,
+      uint32_t row_end);
+
+  struct BandRenderContext;
+  static void render_base_band(void* ctx, uint32_t row_begin, uint32_t row_end);
 
   void render_base_into(
       uint8_t* dst,
@@ -61,21 +122,43 @@ private:
       const PatternBaseKey& key,
       const PatternOverlayData& overlay);
 
-  void render_base_xy_xor(uint8_t* dst, uint32_t dst_stride_bytes, const PatternSpec& spec, const PatternBaseKey& key, const PatternOverlayData& overlay);
-  void render_base_solid(uint8_t* dst, uint32_t dst_stride_bytes, const PatternSpec& spec, const PatternBaseKey& key, const PatternOverlayData& overlay);
-  void render_base_checker(uint8_t* dst, uint32_t dst_stride_bytes, const PatternSpec& spec, const PatternBaseKey& key, const PatternOverlayData& overlay);
-  void render_base_color_bars(uint8_t* dst, uint32_t dst_stride_bytes, const PatternSpec& spec, const PatternBaseKey& key, const PatternOverlayData& overlay);
-  void render_base_radial_gradient(uint8_t* dst, uint32_t dst_stride_bytes, const PatternSpec& spec, const PatternBaseKey& key, const PatternOverlayData& overlay);
-  void render_base_corners_rgba(uint8_t* dst, uint32_t dst_stride_bytes, const PatternSpec& spec, const PatternBaseKey& key, const PatternOverlayData& overlay);
-  void render_base_noise(uint8_t* dst, uint32_t dst_stride_bytes, const PatternSpec& spec, const PatternBaseKey& key, const PatternOverlayData& overlay);
-  void render_base_noise_animated(uint8_t* dst, uint32_t dst_stride_bytes, const PatternSpec& spec, const PatternBaseKey& key, const PatternOverlayData& overlay);
-
-  void render_base_noise_common(uint8_t* dst, uint32_t dst_stride_bytes, const PatternSpec& spec, const PatternBaseKey& key, uint32_t phase);
+  // Kernels are specialised per packed format so the channel order is fixed
+  // at compile time; AlgoKernel maps each PatternAlgoId to its kernel.
+  template <PatternAlgoId A>
+  struct AlgoKernel;
+  struct AlgoEntry {
+    RenderBaseFn fn;
+    // Every row computed independently of the others; may render in bands.
+    bool row_separable;
+  };
+  template <PatternSpec::PackedFormat F>
+  static const AlgoEntry* algo_table() noexcept;
+
+  template <PatternSpec::PackedFormat F>
+  void render_base_xy_xor(uint8_t* dst, uint32_t dst_stride_bytes, const PatternSpec& spec, const PatternBaseKey& key, const PatternOverlayData& overlay, uint32_t row_begin, uint32_t row_end);
+  template <PatternSpec::PackedFormat F>
+  void render_base_solid(uint8_t* dst, uint32_t dst_stride_bytes, const PatternSpec& spec, const PatternBaseKey& key, const PatternOverlayData& overlay, uint32_t row_begin, uint32_t row_end);
+  template <PatternSpec::PackedFormat F>
+  void render_base_checker(uint8_t* dst, uint32_t dst_stride_bytes, const PatternSpec& spec, const PatternBaseKey& key, const PatternOverlayData& overlay, uint32_t row_begin, uint32_t row_end);
+  template <PatternSpec::PackedFormat F>
+  void render_base_color_bars(uint8_t* dst, uint32_t dst_stride_bytes, const PatternSpec& spec, const PatternBaseKey& key, const PatternOverlayData& overlay, uint32_t row_begin, uint32_t row_end);
+  template <PatternSpec::PackedFormat F>
+  void render_base_radial_gradient(uint8_t* dst, uint32_t dst_stride_bytes, const PatternSpec& spec, const PatternBaseKey& key, const PatternOverlayData& overlay, uint32_t row_begin, uint32_t row_end);
+  template <PatternSpec::PackedFormat F>
+  void render_base_corners_rgba(uint8_t* dst, uint32_t dst_stride_bytes, const PatternSpec& spec, const PatternBaseKey& key, const PatternOverlayData& overlay, uint32_t row_begin, uint32_t row_end);
+  template <PatternSpec::PackedFormat F>
+  void render_base_noise(uint8_t* dst, uint32_t dst_stride_bytes, const PatternSpec& spec, const PatternBaseKey& key, const PatternOverlayData& overlay, uint32_t row_begin, uint32_t row_end);
+  template <PatternSpec::PackedFormat F>
+  void render_base_noise_animated(uint8_t* dst, uint32_t dst_stride_bytes, const PatternSpec& spec, const PatternBaseKey& key, const PatternOverlayData& overlay, uint32_t row_begin, uint32_t row_end);
+
+  template <PatternSpec::PackedFormat F>
+  void render_base_noise_common(uint8_t* dst, uint32_t dst_stride_bytes, const PatternSpec& spec, const PatternBaseKey& key, uint32_t phase, uint32_t row_begin, uint32_t row_end);
 
   void copy_base_to(const PatternRenderTarget& dst) const;
+  void copy_base_column_to(const PatternRenderTarget& dst, uint32_t x) const;
 
-  void apply_frame_index_offsets(const PatternSpec& spec, const PatternRenderTarget& dst, uint64_t frame_index) const;
-  void apply_moving_bar(const PatternSpec& spec, const PatternRenderTarget& dst, uint64_t frame_index) const;
+  static void apply_frame_index_offsets(const PatternSpec& spec, const PatternRenderTarget& dst, uint64_t frame_index);
+  static void apply_moving_bar(const PatternSpec& spec, const PatternRenderTarget& dst, uint64_t frame_index);
   void apply_exposure_compensation(const PatternRenderTarget& dst, int32_t applied_exposure_compensation_milli_ev) const;
 
   static inline void write_px(uint8_t* p, PatternSpec::PackedFormat fmt, uint8_t r, uint8_t g, uint8_t b, uint8_t a) noexcept {
@@ -88,8 +171,7 @@ private:
   }
 
 private:
-  PatternBaseKey base_key_{};
-  bool base_valid_ = false;
+  std::shared_ptr<const PatternBaseFrame> base_;
   bool rendered_target_valid_ = false;
   PatternBaseKey rendered_target_base_key_{};
   const void* rendered_target_ptr_ = nullptr;
@@ -97,10 +179,22 @@ private:
   uint32_t rendered_target_height_ = 0;
   uint32_t rendered_target_stride_bytes_ = 0;
   PatternSpec::PackedFormat rendered_target_format_ = PatternSpec::PackedFormat::RGBA8;
+  // The rendered target holds exactly the base plus, when has_bar, the moving
+  // bar at rendered_target_bar_x_.
+  bool rendered_target_base_exact_ = false;
+  bool rendered_target_has_bar_ = false;
+  uint32_t rendered_target_bar_x_ = 0;
+
+  // Same facts for the previous output, whichever target it went to.
+  bool last_output_base_exact_ = false;
+  bool last_output_has_bar_ = false;
+  PatternBaseKey last_output_base_key_{};
+  uint32_t last_output_bar_x_ = 0;
+  PatternDirtyRect last_dirty_rect_{};
 
-  uint32_t base_stride_bytes_ = 0; // tight
-  std::vector<uint8_t> base_pixels_;
   bool has_rendered_frame_ = false;
+  PatternBandPool* band_pool_ = nullptr;
+  PatternBaseCache* base_cache_ = nullptr;
   DebugStats debug_stats_{};
 };
 
@@ -0,0 +1,131 @@
+#include "pixels/pattern/pattern_band_pool.h"
+
+#include <algorithm>
+
+namespace cambang {
+
+PatternBandPool::~PatternBandPool() { stop(); }
+
+bool PatternBandPool::start(size_t worker_count, uint32_t band_rows, uint64_t min_pixels) noexcept {
+  if (running_.load(std::memory_order_acquire) || worker_count == 0 || band_rows == 0) {
+    return false;
+  }
+  {
+    std::lock_guard<std::mutex> lock(mu_);
+    stop_requested_ = false;
+    split_active_ = false;
+    draining_workers_ = 0;
+    min_pixels_ = min_pixels;
+  }
+  try {
+    workers_.reserve(worker_count);
+    for (size_t i = 0; i < worker_count; ++i) {
+      workers_.emplace_back([this] { worker_main_(); });
+    }
+  } catch (...) {
+    // Fewer workers than asked is still a correct pool; none is not.
+    if (workers_.empty()) {
+      return false;
+    }
+  }
+  band_rows_.store(band_rows, std::memory_order_release);
+  running_.store(true, std::memory_order_release);
+  return true;
+}
+
+void PatternBandPool::stop() noexcept {
+  running_.store(false, std::memory_order_release);
+  {
+    std::lock_guard<std::mutex> lock(mu_);
+    stop_requested_ = true;
+  }
+  work_cv_.notify_all();
+  for (std::thread& w : workers_) {
+    // Workers only run pure CPU bands and never block inside one, so the
+    // join is bounded by a single band.
+    if (w.joinable()) {
+      w.join();
+    }
+  }
+  workers_.clear();
+  band_rows_.store(0, std::memory_order_release);
+}
+
+void PatternBandPool::drain_(Split& split) noexcept {
+  for (;;) {
+    const uint32_t index = split.next.fetch_add(1, std::memory_order_relaxed);
+    if (index >= split.band_count) {
+      break;
+    }
+    const uint32_t begin = index * split.band_rows;
+    const uint32_t end = std::min(split.rows, begin + split.band_rows);
+    split.band(split.ctx, begin, end);
+    split.done.fetch_add(1, std::memory_order_acq_rel);
+  }
+}
+
+bool PatternBandPool::run(uint32_t rows, uint64_t pixels, BandFn band, void* ctx) noexcept {
+  if (rows == 0 || !band) {
+    return false;
+  }
+  bool split = false;
+  if (running_.load(std::memory_order_acquire) && pixels >= min_pixels_) {
+    const uint32_t band_rows = band_rows_.load(std::memory_order_acquire);
+    std::lock_guard<std::mutex> lock(mu_);
+    if (!stop_requested_ && !split_active_ && draining_workers_ == 0 && band_rows != 0 && rows > band_rows) {
+      split_.band = band;
+      split_.ctx = ctx;
+      split_.rows = rows;
+      split_.band_rows = band_rows;
+      split_.band_count = (rows + band_rows - 1) / band_rows;
+      split_.next.store(0, std::memory_order_relaxed);
+      split_.done.store(0, std::memory_order_relaxed);
+      split_active_ = true;
+      ++split_generation_;
+      split = true;
+    }
+  }
+  if (!split) {
+    band(ctx, 0, rows);
+    return false;
+  }
+
+  work_cv_.notify_all();
+  drain_(split_);
+  {
+    std::unique_lock<std::mutex> lock(mu_);
+    done_cv_.wait(lock, [this] {
+      return split_.done.load(std::memory_order_acquire) == split_.band_count && draining_workers_ == 0;
+    });
+    split_active_ = false;
+  }
+  return true;
+}
+
+void PatternBandPool::worker_main_() noexcept {
+  uint64_t seen_generation = 0;
+  for (;;) {
+    {
+      std::unique_lock<std::mutex> lock(mu_);
+      work_cv_.wait(lock, [this, seen_generation] {
+        return stop_requested_ || (split_active_ && split_generation_ != seen_generation);
+      });
+      if (stop_requested_) {
+        break;
+      }
+      seen_generation = split_generation_;
+      ++draining_workers_;
+    }
+    drain_(split_);
+    {
+      // Taking the lock orders this notify after the caller's predicate
+      // check, so neither the final band nor the last worker leaving the
+      // split can be missed.
+      std::lock_guard<std::mutex> lock(mu_);
+      --draining_workers_;
+      done_cv_.notify_all();
+    }
+  }
+}
+
+} // namespace cambang
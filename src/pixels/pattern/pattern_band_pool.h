@@ -0,0 +1,80 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace cambang {
+
+// Small worker pool that splits one base render into row bands. The caller
+// renders bands itself alongside the workers and returns only once every band
+// is done, so a banded render is a drop-in for a serial one: bands cover
+// disjoint rows and kernels are pure per-pixel functions, so the bytes are
+// identical whatever the worker count.
+//
+// One split runs at a time and the pool can be shared by many renderers; a
+// caller that finds the pool busy (another stream's frame), stopped, or below
+// min_pixels renders inline rather than queueing, so a stall here never
+// exceeds the serial render cost.
+//
+// run() does not allocate: the split is pool-owned and reused.
+//
+// Threading: start()/stop() from the owner; run() from any thread.
+class PatternBandPool final {
+public:
+  // band(ctx, row_begin, row_end). Must not throw.
+  using BandFn = void (*)(void* ctx, uint32_t row_begin, uint32_t row_end);
+
+  PatternBandPool() = default;
+  ~PatternBandPool();
+
+  PatternBandPool(const PatternBandPool&) = delete;
+  PatternBandPool& operator=(const PatternBandPool&) = delete;
+
+  bool start(size_t worker_count, uint32_t band_rows, uint64_t min_pixels) noexcept;
+  void stop() noexcept;
+
+  // Rows per band of a split run; 0 while stopped.
+  uint32_t band_rows() const noexcept { return band_rows_.load(std::memory_order_acquire); }
+
+  // Calls band over [0, rows), either once inline or in band_rows() bands
+  // from this thread and any idle worker. Returns true when the render was
+  // split, after every band is done.
+  bool run(uint32_t rows, uint64_t pixels, BandFn band, void* ctx) noexcept;
+
+private:
+  struct Split {
+    BandFn band = nullptr;
+    void* ctx = nullptr;
+    uint32_t rows = 0;
+    uint32_t band_rows = 0;
+    uint32_t band_count = 0;
+    std::atomic<uint32_t> next{0};
+    std::atomic<uint32_t> done{0};
+  };
+
+  void worker_main_() noexcept;
+  // Claims and renders bands until none are left.
+  static void drain_(Split& split) noexcept;
+
+  std::mutex mu_;
+  std::condition_variable work_cv_;
+  std::condition_variable done_cv_;
+  Split split_{};
+  bool split_active_ = false;
+  // Workers inside drain_() for the active split; the split is only reset
+  // for the next caller once this is back to zero.
+  uint32_t draining_workers_ = 0;
+  uint64_t split_generation_ = 0;
+  bool stop_requested_ = false;
+  uint64_t min_pixels_ = 0;
+  std::atomic<uint32_t> band_rows_{0};
+  std::atomic<bool> running_{false};
+  std::vector<std::thread> workers_;
+};
+
+} // namespace cambang
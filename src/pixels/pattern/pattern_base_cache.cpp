@@ -0,0 +1,79 @@
+#include "pixels/pattern/pattern_base_cache.h"
+
+#include <utility>
+
+namespace cambang {
+
+PatternBaseCache& PatternBaseCache::shared() noexcept {
+  static PatternBaseCache cache;
+  return cache;
+}
+
+std::shared_ptr<const PatternBaseFrame> PatternBaseCache::find(const PatternBaseKey& key) {
+  std::lock_guard<std::mutex> lock(mu_);
+  for (auto it = entries_.begin(); it != entries_.end(); ++it) {
+    if ((*it)->key == key) {
+      entries_.splice(entries_.begin(), entries_, it);
+      return entries_.front();
+    }
+  }
+  return nullptr;
+}
+
+std::shared_ptr<const PatternBaseFrame> PatternBaseCache::insert(std::shared_ptr<const PatternBaseFrame> frame) {
+  if (!frame) {
+    return nullptr;
+  }
+  // Dropped frames are released after the unlock; the last reference may
+  // free a large buffer.
+  std::list<std::shared_ptr<const PatternBaseFrame>> dropped;
+  std::lock_guard<std::mutex> lock(mu_);
+  for (auto it = entries_.begin(); it != entries_.end(); ++it) {
+    if ((*it)->key == frame->key) {
+      entries_.splice(entries_.begin(), entries_, it);
+      return entries_.front();
+    }
+  }
+  ++inserts_;
+  bytes_ += frame->pixels.size();
+  entries_.push_front(std::move(frame));
+  while (entries_.size() > 1 && (entries_.size() > capacity_ || bytes_ > byte_budget_)) {
+    bytes_ -= entries_.back()->pixels.size();
+    dropped.splice(dropped.begin(), entries_, std::prev(entries_.end()));
+  }
+  return entries_.front();
+}
+
+uint64_t PatternBaseCache::inserts() const noexcept {
+  std::lock_guard<std::mutex> lock(mu_);
+  return inserts_;
+}
+
+size_t PatternBaseCache::size() const noexcept {
+  std::lock_guard<std::mutex> lock(mu_);
+  return entries_.size();
+}
+
+void PatternBaseCache::clear() noexcept {
+  std::list<std::shared_ptr<const PatternBaseFrame>> dropped;
+  std::lock_guard<std::mutex> lock(mu_);
+  dropped.swap(entries_);
+  bytes_ = 0;
+}
+
+uint64_t PatternBaseCache::trim(size_t keep_entries) noexcept {
+  std::list<std::shared_ptr<const PatternBaseFrame>> dropped;
+  std::lock_guard<std::mutex> lock(mu_);
+  uint64_t released = 0;
+  while (entries_.size() > keep_entries) {
+    const std::shared_ptr<const PatternBaseFrame>& oldest = entries_.back();
+    bytes_ -= oldest->pixels.size();
+    if (oldest.use_count() == 1) {
+      released += oldest->pixels.size();
+    }
+    dropped.splice(dropped.begin(), entries_, std::prev(entries_.end()));
+  }
+  return released;
+}
+
+} // namespace cambang
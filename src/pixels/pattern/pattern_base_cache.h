@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "pixels/pattern/pattern_spec.h"
+
+namespace cambang {
+
+// One rendered base frame: key.width x key.height tightly packed pixels in
+// key.format.
+struct PatternBaseFrame final {
+  PatternBaseKey key{};
+  uint32_t stride_bytes = 0;
+  std::vector<uint8_t> pixels;
+};
+
+// Thread-safe cache of rendered base frames keyed by PatternBaseKey, so
+// renderers drawing the same base (streams of one picture at one size, repeat
+// captures) render it once and share the pixels. Frames are immutable once
+// inserted; the least recently used beyond capacity or the byte budget are
+// dropped, though the most recent always stays. Renderers keep the frames
+// they hold alive.
+//
+// The cache is not locked across a render: concurrent first renders of one
+// key may both render, and insert() hands every caller the frame that won.
+class PatternBaseCache final {
+public:
+  static constexpr size_t kDefaultCapacity = 8;
+  static constexpr uint64_t kDefaultByteBudget = 128ull * 1024ull * 1024ull; // 128 MiB
+
+  explicit PatternBaseCache(size_t capacity = kDefaultCapacity,
+                            uint64_t byte_budget = kDefaultByteBudget) noexcept
+      : capacity_(capacity == 0 ? 1 : capacity), byte_budget_(byte_budget) {}
+
+  PatternBaseCache(const PatternBaseCache&) = delete;
+  PatternBaseCache& operator=(const PatternBaseCache&) = delete;
+
+  // The process-wide instance providers share across their renderers.
+  static PatternBaseCache& shared() noexcept;
+
+  // nullptr on a miss.
+  std::shared_ptr<const PatternBaseFrame> find(const PatternBaseKey& key);
+  // Caches frame unless its key is already cached; returns the cached frame
+  // for that key either way.
+  std::shared_ptr<const PatternBaseFrame> insert(std::shared_ptr<const PatternBaseFrame> frame);
+
+  // Frames inserted since construction; inserts that found the key cached do
+  // not count.
+  uint64_t inserts() const noexcept;
+  size_t size() const noexcept;
+  void clear() noexcept;
+  // Drops the least recently used frames beyond keep_entries (memory
+  // pressure) and returns the bytes of those no renderer still holds.
+  uint64_t trim(size_t keep_entries) noexcept;
+
+private:
+  const size_t capacity_;
+  const uint64_t byte_budget_;
+  mutable std::mutex mu_;
+  // Most recently used first.
+  std::list<std::shared_ptr<const PatternBaseFrame>> entries_;
+  uint64_t bytes_ = 0;
+  uint64_t inserts_ = 0;
+};
+
+} // namespace cambang
@@ -33,4 +33,30 @@ struct PatternRenderTarget final {
   }
 };
 
+// Pixel rectangle, in target coordinates, whose contents changed relative to
+// the previous frame a renderer produced. An empty rect (width or height 0)
+// means the frame is pixel-identical to the previous one.
+struct PatternDirtyRect final {
+  uint32_t x = 0;
+  uint32_t y = 0;
+  uint32_t width = 0;
+  uint32_t height = 0;
+
+  static PatternDirtyRect full(uint32_t w, uint32_t h) noexcept { return PatternDirtyRect{0, 0, w, h}; }
+
+  bool empty() const noexcept { return width == 0 || height == 0; }
+  bool covers(uint32_t w, uint32_t h) const noexcept { return x == 0 && y == 0 && width >= w && height >= h; }
+
+  // Bounding union; an empty operand contributes nothing.
+  PatternDirtyRect united(const PatternDirtyRect& o) const noexcept {
+    if (o.empty()) return *this;
+    if (empty()) return o;
+    const uint32_t x0 = x < o.x ? x : o.x;
+    const uint32_t y0 = y < o.y ? y : o.y;
+    const uint32_t x1 = (x + width) > (o.x + o.width) ? (x + width) : (o.x + o.width);
+    const uint32_t y1 = (y + height) > (o.y + o.height) ? (y + height) : (o.y + o.height);
+    return PatternDirtyRect{x0, y0, x1 - x0, y1 - y0};
+  }
+};
+
 } // namespace cambang
@@ -0,0 +1,35 @@
+#pragma once
+
+// SIMD selection shared by the pixel kernels (src/pixels).
+//
+// SSE2 and AArch64 NEON are the architectural baselines of every shipped x86
+// and ARM target, so kernels select their vector path at compile time from
+// CAMBANG_PIXELS_SSE2 / CAMBANG_PIXELS_NEON and need no runtime CPU-feature
+// dispatch. Each kernel keeps its scalar loop as the reference and the tail
+// of every vector loop. Building with CAMBANG_PIXELS_FORCE_SCALAR=1 (SCons
+// pixels_scalar=yes) leaves both undefined, so verification can run every
+// kernel on its scalar reference and compare.
+#if !(defined(CAMBANG_PIXELS_FORCE_SCALAR) && CAMBANG_PIXELS_FORCE_SCALAR)
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define CAMBANG_PIXELS_SSE2 1
+#include <emmintrin.h>
+#elif (defined(__ARM_NEON) && defined(__aarch64__)) || defined(_M_ARM64)
+#define CAMBANG_PIXELS_NEON 1
+#include <arm_neon.h>
+#endif
+#endif
+
+namespace cambang {
+
+// Kernel variant compiled into this build, for banners and diagnostics.
+constexpr const char* pixel_kernel_isa() noexcept {
+#if defined(CAMBANG_PIXELS_SSE2)
+  return "sse2";
+#elif defined(CAMBANG_PIXELS_NEON)
+  return "neon";
+#else
+  return "scalar";
+#endif
+}
+
+} // namespace cambang
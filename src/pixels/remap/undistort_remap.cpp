@@ -0,0 +1,135 @@
+#include "pixels/remap/undistort_remap.h"
+
+#include <cmath>
+
+namespace cambang {
+
+namespace {
+
+constexpr uint32_t kMaxSide = 1u << 22;
+
+} // namespace
+
+bool build_undistort_remap_lut(const UndistortModel& model,
+                               uint32_t width,
+                               uint32_t height,
+                               UndistortRemapLut& out) {
+  out.width = 0;
+  out.height = 0;
+  out.src_xy.clear();
+  if (width == 0 || height == 0 || width > kMaxSide || height > kMaxSide ||
+      !(model.focal_length_x_px > 0.0) || !(model.focal_length_y_px > 0.0)) {
+    return false;
+  }
+
+  const double fx = model.focal_length_x_px;
+  const double fy = model.focal_length_y_px;
+  const double cx = model.principal_point_x_px;
+  const double cy = model.principal_point_y_px;
+  const double s = model.skew_px;
+  const double scale = static_cast<double>(1u << UndistortRemapLut::kFractionBits);
+  const double max_x = static_cast<double>(width - 1u);
+  const double max_y = static_cast<double>(height - 1u);
+
+  out.src_xy.resize(static_cast<size_t>(width) * height * 2u);
+  int32_t* xy = out.src_xy.data();
+  for (uint32_t v = 0; v < height; ++v) {
+    // Normalized undistorted coordinates of output pixel (u, v).
+    const double y = (static_cast<double>(v) - cy) / fy;
+    const double x_row = (-cx - s * y) / fx;
+    for (uint32_t u = 0; u < width; ++u, xy += 2) {
+      const double x = x_row + static_cast<double>(u) / fx;
+      const double r2 = x * x + y * y;
+      const double radial =
+          1.0 + r2 * (model.radial_k1 + r2 * (model.radial_k2 + r2 * model.radial_k3));
+      const double xd = x * radial + 2.0 * model.tangential_p1 * x * y +
+                        model.tangential_p2 * (r2 + 2.0 * x * x);
+      const double yd = y * radial + model.tangential_p1 * (r2 + 2.0 * y * y) +
+                        2.0 * model.tangential_p2 * x * y;
+      const double src_x = fx * xd + s * yd + cx;
+      const double src_y = fy * yd + cy;
+      // The negated comparisons also send NaN outside.
+      if (!(src_x >= 0.0 && src_x <= max_x && src_y >= 0.0 && src_y <= max_y)) {
+        xy[0] = UndistortRemapLut::kOutside;
+        xy[1] = UndistortRemapLut::kOutside;
+        continue;
+      }
+      xy[0] = static_cast<int32_t>(std::lround(src_x * scale));
+      xy[1] = static_cast<int32_t>(std::lround(src_y * scale));
+    }
+  }
+  out.width = width;
+  out.height = height;
+  return true;
+}
+
+void remap_bilinear_rgba8(const UndistortRemapLut& lut,
+                          const uint8_t* src,
+                          size_t src_stride,
+                          uint8_t* dst) noexcept {
+  constexpr uint32_t kBits = UndistortRemapLut::kFractionBits;
+  constexpr uint32_t kOne = 1u << kBits;
+  constexpr uint32_t kMask = kOne - 1u;
+  const size_t pixel_count = static_cast<size_t>(lut.width) * lut.height;
+  const int32_t* xy = lut.src_xy.data();
+  for (size_t i = 0; i < pixel_count; ++i, xy += 2, dst += 4) {
+    if (xy[0] == UndistortRemapLut::kOutside) {
+      dst[0] = 0;
+      dst[1] = 0;
+      dst[2] = 0;
+      dst[3] = 0xff;
+      continue;
+    }
+    const uint32_t sx = static_cast<uint32_t>(xy[0]);
+    const uint32_t sy = static_cast<uint32_t>(xy[1]);
+    const uint32_t x0 = sx >> kBits;
+    const uint32_t y0 = sy >> kBits;
+    const uint32_t ax = sx & kMask;
+    const uint32_t ay = sy & kMask;
+    const uint32_t x1 = x0 + 1u < lut.width ? x0 + 1u : x0;
+    const uint32_t y1 = y0 + 1u < lut.height ? y0 + 1u : y0;
+    const uint8_t* r0 = src + static_cast<size_t>(y0) * src_stride;
+    const uint8_t* r1 = src + static_cast<size_t>(y1) * src_stride;
+    const uint8_t* p00 = r0 + static_cast<size_t>(x0) * 4u;
+    const uint8_t* p01 = r0 + static_cast<size_t>(x1) * 4u;
+    const uint8_t* p10 = r1 + static_cast<size_t>(x0) * 4u;
+    const uint8_t* p11 = r1 + static_cast<size_t>(x1) * 4u;
+    for (int c = 0; c < 4; ++c) {
+      const uint32_t top = p00[c] * (kOne - ax) + p01[c] * ax;
+      const uint32_t bottom = p10[c] * (kOne - ax) + p11[c] * ax;
+      dst[c] = static_cast<uint8_t>((top * (kOne - ay) + bottom * ay + (1u << (2u * kBits - 1u))) >>
+                                    (2u * kBits));
+    }
+  }
+}
+
+std::shared_ptr<const UndistortRemapLut> UndistortRemapLutCache::get(const UndistortModel& model,
+                                                                     uint32_t width,
+                                                                     uint32_t height) {
+  // Held across a build: a map is rare and expensive enough that building it
+  // twice for two concurrent first callers would cost more than the wait.
+  std::lock_guard<std::mutex> lock(mu_);
+  for (auto it = entries_.begin(); it != entries_.end(); ++it) {
+    if (it->width == width && it->height == height && it->model == model) {
+      entries_.splice(entries_.begin(), entries_, it);
+      return entries_.front().lut;
+    }
+  }
+  auto lut = std::make_shared<UndistortRemapLut>();
+  if (!build_undistort_remap_lut(model, width, height, *lut)) {
+    return nullptr;
+  }
+  ++builds_;
+  entries_.push_front(Entry{model, width, height, lut});
+  while (entries_.size() > capacity_) {
+    entries_.pop_back();
+  }
+  return lut;
+}
+
+uint64_t UndistortRemapLutCache::builds() const noexcept {
+  std::lock_guard<std::mutex> lock(mu_);
+  return builds_;
+}
+
+} // namespace cambang
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace cambang {
+
+// Pinhole + Brown-Conrady (k1, k2, k3, p1, p2) camera model in the pixel
+// units of the image being remapped. The undistorted output keeps the same
+// camera matrix, so output and source share their size and principal point.
+struct UndistortModel {
+  double focal_length_x_px = 0.0;
+  double focal_length_y_px = 0.0;
+  double principal_point_x_px = 0.0;
+  double principal_point_y_px = 0.0;
+  double skew_px = 0.0;
+  double radial_k1 = 0.0;
+  double radial_k2 = 0.0;
+  double radial_k3 = 0.0;
+  double tangential_p1 = 0.0;
+  double tangential_p2 = 0.0;
+
+  bool operator==(const UndistortModel& o) const noexcept {
+    return focal_length_x_px == o.focal_length_x_px && focal_length_y_px == o.focal_length_y_px &&
+           principal_point_x_px == o.principal_point_x_px &&
+           principal_point_y_px == o.principal_point_y_px && skew_px == o.skew_px &&
+           radial_k1 == o.radial_k1 && radial_k2 == o.radial_k2 && radial_k3 == o.radial_k3 &&
+           tangential_p1 == o.tangential_p1 && tangential_p2 == o.tangential_p2;
+  }
+};
+
+// For each output pixel, the source position it samples, as Q24.8 fixed point
+// (x then y, interleaved). The distortion polynomial is evaluated once, here;
+// applying the map is a bilinear gather with integer weights.
+struct UndistortRemapLut {
+  static constexpr uint32_t kFractionBits = 8;
+  // Source position outside the image: the output pixel is opaque black.
+  static constexpr int32_t kOutside = std::numeric_limits<int32_t>::min();
+
+  uint32_t width = 0;
+  uint32_t height = 0;
+  std::vector<int32_t> src_xy;
+};
+
+// Builds the width x height map for model. Returns false on a zero size, a
+// non-positive focal length or a side longer than 2^22 pixels.
+bool build_undistort_remap_lut(const UndistortModel& model,
+                               uint32_t width,
+                               uint32_t height,
+                               UndistortRemapLut& out);
+
+// Writes lut.width x lut.height tightly packed RGBA8 pixels to dst, each
+// sampled bilinearly from src (an RGBA8 image of the same size whose rows are
+// src_stride bytes apart). Pixels whose sample lies outside src are written
+// opaque black; the last row and column clamp rather than read past the edge.
+void remap_bilinear_rgba8(const UndistortRemapLut& lut,
+                          const uint8_t* src,
+                          size_t src_stride,
+                          uint8_t* dst) noexcept;
+
+// Small thread-safe cache of built maps keyed by (model, width, height), so a
+// map is built once per camera model and resolution and then only applied.
+// Because the model is the key, a change to the camera facts behind it (a new
+// camera description or a different per-image fact) simply misses and the
+// superseded map ages out; least recently used maps beyond capacity are
+// dropped. Callers keep the maps they hold alive.
+class UndistortRemapLutCache final {
+public:
+  static constexpr size_t kDefaultCapacity = 4;
+
+  explicit UndistortRemapLutCache(size_t capacity = kDefaultCapacity) noexcept
+      : capacity_(capacity == 0 ? 1 : capacity) {}
+
+  // nullptr when the map cannot be built (see build_undistort_remap_lut).
+  std::shared_ptr<const UndistortRemapLut> get(const UndistortModel& model,
+                                               uint32_t width,
+                                               uint32_t height);
+
+  // Maps built since construction; a cache hit does not count.
+  uint64_t builds() const noexcept;
+
+private:
+  struct Entry {
+    UndistortModel model;
+    uint32_t width = 0;
+    uint32_t height = 0;
+    std::shared_ptr<const UndistortRemapLut> lut;
+  };
+
+  const size_t capacity_;
+  mutable std::mutex mu_;
+  // Most recently used first.
+  std::list<Entry> entries_;
+  uint64_t builds_ = 0;
+};
+
+} // namespace cambang
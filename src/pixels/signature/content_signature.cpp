@@ -0,0 +1,111 @@
+#include "pixels/signature/content_signature.h"
+
+#include "pixels/pixel_simd.h"
+
+namespace cambang {
+
+namespace {
+
+uint64_t sum_bytes(const uint8_t* p, size_t n) noexcept {
+  uint64_t sum = 0;
+  size_t i = 0;
+#if defined(CAMBANG_PIXELS_SSE2)
+  // psadbw against zero sums each 8-byte half into a 64-bit lane.
+  const __m128i zero = _mm_setzero_si128();
+  __m128i acc = zero;
+  for (; i + 16 <= n; i += 16) {
+    const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i));
+    acc = _mm_add_epi64(acc, _mm_sad_epu8(v, zero));
+  }
+  alignas(16) uint64_t halves[2];
+  _mm_store_si128(reinterpret_cast<__m128i*>(halves), acc);
+  sum = halves[0] + halves[1];
+#elif defined(CAMBANG_PIXELS_NEON)
+  uint32x4_t acc = vdupq_n_u32(0);
+  for (; i + 16 <= n; i += 16) {
+    acc = vpadalq_u16(acc, vpaddlq_u8(vld1q_u8(p + i)));
+  }
+  sum = vaddlvq_u32(acc);
+#endif
+  for (; i < n; ++i) {
+    sum += p[i];
+  }
+  return sum;
+}
+
+} // namespace
+
+bool compute_content_signature(const uint8_t* src,
+                               uint32_t width,
+                               uint32_t height,
+                               size_t row_stride,
+                               uint32_t bytes_per_pixel,
+                               ContentSignature& out) noexcept {
+  constexpr uint32_t kGrid = ContentSignature::kGrid;
+  constexpr uint32_t kRows = ContentSignature::kSampledRowsPerCell;
+  out.valid = false;
+  if (!src || width < kGrid || height < kGrid || (bytes_per_pixel != 1 && bytes_per_pixel != 4) ||
+      row_stride < static_cast<size_t>(width) * bytes_per_pixel) {
+    return false;
+  }
+  std::array<uint64_t, ContentSignature::kCellCount> sums{};
+  for (uint32_t cy = 0; cy < kGrid; ++cy) {
+    const uint32_t y0 = static_cast<uint32_t>(static_cast<uint64_t>(cy) * height / kGrid);
+    const uint32_t y1 = static_cast<uint32_t>(static_cast<uint64_t>(cy + 1) * height / kGrid);
+    for (uint32_t k = 0; k < kRows; ++k) {
+      // Rows centred in kRows equal bands of the cell.
+      const uint32_t y = y0 + static_cast<uint32_t>(static_cast<uint64_t>(y1 - y0) * (2 * k + 1) / (2 * kRows));
+      const uint8_t* row = src + static_cast<size_t>(y) * row_stride;
+      for (uint32_t cx = 0; cx < kGrid; ++cx) {
+        const size_t x0 = static_cast<size_t>(static_cast<uint64_t>(cx) * width / kGrid);
+        const size_t x1 = static_cast<size_t>(static_cast<uint64_t>(cx + 1) * width / kGrid);
+        sums[cy * kGrid + cx] += sum_bytes(row + x0 * bytes_per_pixel, (x1 - x0) * bytes_per_pixel);
+      }
+    }
+  }
+  for (uint32_t cy = 0; cy < kGrid; ++cy) {
+    for (uint32_t cx = 0; cx < kGrid; ++cx) {
+      const uint64_t x0 = static_cast<uint64_t>(cx) * width / kGrid;
+      const uint64_t x1 = static_cast<uint64_t>(cx + 1) * width / kGrid;
+      const uint64_t count = (x1 - x0) * bytes_per_pixel * kRows;
+      const size_t cell = cy * kGrid + cx;
+      out.cells[cell] = static_cast<uint8_t>((sums[cell] + count / 2) / count);
+    }
+  }
+  out.valid = true;
+  return true;
+}
+
+uint32_t content_signature_difference(const ContentSignature& a, const ContentSignature& b) noexcept {
+  if (!a.valid || !b.valid) {
+    return 255;
+  }
+  uint32_t i = 0;
+  uint32_t max_diff = 0;
+#if defined(CAMBANG_PIXELS_SSE2)
+  __m128i acc = _mm_setzero_si128();
+  for (; i + 16 <= ContentSignature::kCellCount; i += 16) {
+    const __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a.cells.data() + i));
+    const __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b.cells.data() + i));
+    acc = _mm_max_epu8(acc, _mm_or_si128(_mm_subs_epu8(va, vb), _mm_subs_epu8(vb, va)));
+  }
+  alignas(16) uint8_t lanes[16];
+  _mm_store_si128(reinterpret_cast<__m128i*>(lanes), acc);
+  for (const uint8_t lane : lanes) {
+    max_diff = lane > max_diff ? lane : max_diff;
+  }
+#elif defined(CAMBANG_PIXELS_NEON)
+  uint8x16_t acc = vdupq_n_u8(0);
+  for (; i + 16 <= ContentSignature::kCellCount; i += 16) {
+    acc = vmaxq_u8(acc, vabdq_u8(vld1q_u8(a.cells.data() + i), vld1q_u8(b.cells.data() + i)));
+  }
+  max_diff = vmaxvq_u8(acc);
+#endif
+  for (; i < ContentSignature::kCellCount; ++i) {
+    const uint32_t d = a.cells[i] > b.cells[i] ? a.cells[i] - b.cells[i] : b.cells[i] - a.cells[i];
+    max_diff = d > max_diff ? d : max_diff;
+  }
+  return max_diff;
+}
+
+} // namespace cambang
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace cambang {
+
+// Coarse summary of a frame's content, for deciding cheaply whether a new
+// frame differs enough from an earlier one to be worth processing.
+//
+// The frame is divided into a kGrid x kGrid grid of cells; each cell holds
+// the mean byte value of kSampledRowsPerCell rows spread evenly through it.
+// A packed 32-bit frame averages all four channels (alpha is constant, so it
+// only offsets every cell equally); a planar YUV frame is summarised from
+// its Y plane. Averaging over a cell absorbs sensor noise, while any change
+// to a cell's sampled rows large enough to matter moves its mean.
+struct ContentSignature {
+  static constexpr uint32_t kGrid = 16;
+  static constexpr uint32_t kCellCount = kGrid * kGrid;
+  static constexpr uint32_t kSampledRowsPerCell = 2;
+
+  // Row-major, cell (0, 0) top left.
+  std::array<uint8_t, kCellCount> cells{};
+  // False for frames smaller than the grid, which get no signature.
+  bool valid = false;
+};
+
+// Computes the signature of a width x height image of bytes_per_pixel (1 or
+// 4) bytes per pixel whose rows are row_stride bytes apart. Reads only the
+// sampled rows (kGrid * kSampledRowsPerCell of them). False, leaving out
+// invalid, when the image is smaller than kGrid in either dimension or the
+// arguments are inconsistent. Byte sums are vectorized with SSE2 on x86-64
+// and NEON on AArch64; other targets use the scalar loop.
+bool compute_content_signature(const uint8_t* src,
+                               uint32_t width,
+                               uint32_t height,
+                               size_t row_stride,
+                               uint32_t bytes_per_pixel,
+                               ContentSignature& out) noexcept;
+
+// Largest per-cell difference between a and b, 0..255. 255 when either is
+// invalid, so a missing signature always reads as "changed".
+uint32_t content_signature_difference(const ContentSignature& a, const ContentSignature& b) noexcept;
+
+} // namespace cambang
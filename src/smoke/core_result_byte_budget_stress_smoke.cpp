@@ -3,20 +3,25 @@
 // no existing scenario produces anywhere near a real budget's worth of
 // retained bytes, so the eviction logic itself (as opposed to its plumbing)
 // had never executed under test. This smoke drives it directly, at volume,
-// synthetic-only, mirroring the exact snapshot-then-evict pattern
+// synthetic-only, mirroring the exact drain-then-evict pattern
 // CoreRuntime::on_core_timer_tick() uses (see core_runtime.cpp and
-// CoreCaptureAssemblyRegistry::terminal_capture_device_pairs()'s doc
-// comment): take a terminal-pairs snapshot from CoreCaptureAssemblyRegistry
-// BEFORE touching CoreResultStore's lock, then evict by that snapshot.
+// CoreCaptureAssemblyRegistry::take_newly_terminal_capture_device_pairs()'s
+// doc comment): take the newly terminal pairs from
+// CoreCaptureAssemblyRegistry BEFORE touching CoreResultStore's lock, mark
+// them evictable, then evict.
 #include <cassert>
+#include <chrono>
 #include <cstdint>
+#include <filesystem>
 #include <iostream>
+#include <memory>
 #include <optional>
-#include <set>
+#include <thread>
 #include <utility>
 #include <vector>
 
 #include "core/core_capture_assembly_registry.h"
+#include "core/core_capture_spill_store.h"
 #include "core/core_result_store.h"
 
 using namespace cambang;
@@ -72,21 +77,15 @@ FrameView make_gpu_only_capture_frame(uint64_t capture_id) {
 }
 
 // Mirrors CoreRuntime::on_core_timer_tick()'s production wiring exactly:
-// snapshot terminal pairs from the assembly registry BEFORE ever touching
-// CoreResultStore's lock, then hand evict_over_byte_budget an in-memory
-// predicate that does no locking of its own.
+// drain newly terminal pairs from the assembly registry BEFORE ever touching
+// CoreResultStore's lock, mark them evictable, then evict.
 std::vector<CoreResultStore::EvictedCaptureResult> run_eviction_sweep(
     CoreResultStore& store, CoreCaptureAssemblyRegistry& assembly, uint64_t byte_budget) {
+  store.mark_capture_results_evictable(assembly.take_newly_terminal_capture_device_pairs());
   if (store.total_estimated_capture_bytes() <= byte_budget) {
     return {};
   }
-  const auto terminal_pairs = assembly.terminal_capture_device_pairs();
-  const std::set<std::pair<uint64_t, uint64_t>> terminal_set(terminal_pairs.begin(), terminal_pairs.end());
-  auto evicted = store.evict_over_byte_budget(
-      byte_budget,
-      [&terminal_set](uint64_t capture_id, uint64_t device_instance_id) {
-        return terminal_set.count(std::make_pair(capture_id, device_instance_id)) != 0;
-      });
+  auto evicted = store.evict_over_byte_budget(byte_budget);
   for (const auto& e : evicted) {
     assembly.remove_assembly(e.capture_id, e.device_instance_id);
   }
@@ -216,6 +215,161 @@ int main() {
     assert(store.total_estimated_capture_bytes() == in_flight_floor_bytes);
   }
 
+  // ---- Eviction priority and the spill tier ------------------------------
+  // Evicting a result a caller still holds frees nothing, so unreferenced
+  // results go first. Evicted CPU results spill to CoreCaptureSpillStore and
+  // reload from disk with their bytes; the tier's own LRU budget drops the
+  // least recently used; GPU-only results cannot spill. The tier is off until
+  // a medium is selected, and spill files live owner-only under the caller's
+  // directory, whose stale spill directories are swept on selection.
+  {
+    CoreResultStore store;
+    CoreCaptureAssemblyRegistry assembly;
+    for (uint64_t capture_id = 1; capture_id <= 4; ++capture_id) {
+      std::vector<uint8_t> bytes;
+      FrameView frame = make_cpu_capture_frame(capture_id, bytes);
+      bytes[0] = static_cast<uint8_t>(capture_id);
+      assert(store.retain_frame(frame, std::nullopt, 0, 1, {}, requested_cpu));
+    }
+    store.mark_capture_results_evictable(
+        {{1, kDeviceInstanceId}, {2, kDeviceInstanceId}, {3, kDeviceInstanceId}, {4, kDeviceInstanceId}});
+    const SharedCaptureResultData held = store.get_capture_result(1, kDeviceInstanceId);
+    auto evicted = store.evict_over_byte_budget(2 * kCpuCaptureBytes);
+    assert(evicted.size() == 2);
+    assert(evicted[0].capture_id == 2 && evicted[1].capture_id == 3);
+    assert(store.get_capture_result(1, kDeviceInstanceId) == held);
+
+    CoreCaptureSpillStore off;
+    assert(off.medium() == CoreCaptureSpillStore::Medium::OFF);
+    assert(!off.spill(evicted[0].result) && off.spilled_result_count() == 0);
+    CoreCaptureSpillStore no_directory;
+    no_directory.set_medium(CoreCaptureSpillStore::Medium::TEMP_FILE, 2 * kCpuCaptureBytes);
+    assert(!no_directory.spill(evicted[0].result));
+
+    namespace fs = std::filesystem;
+    const fs::path spill_base = fs::temp_directory_path() / "cambang_byte_budget_smoke_spill";
+    fs::remove_all(spill_base);
+    fs::create_directories(spill_base / "cambang-capture-spill-999999999-1-1");
+    fs::create_directories(spill_base / "cambang-capture-spill-unparsable");
+    assert(CoreCaptureSpillStore::sweep_stale_directories(spill_base) == 1);
+    assert(!fs::exists(spill_base / "cambang-capture-spill-999999999-1-1"));
+    assert(fs::exists(spill_base / "cambang-capture-spill-unparsable"));
+    fs::create_directories(spill_base / "cambang-capture-spill-999999999-2-2");
+
+    CoreCaptureSpillStore spill;
+    spill.set_medium(CoreCaptureSpillStore::Medium::TEMP_FILE, 2 * kCpuCaptureBytes, spill_base);
+    assert(!fs::exists(spill_base / "cambang-capture-spill-999999999-2-2"));
+    // Held only by the tier until its write completes. A raw pointer would
+    // not do: the reloaded copy may be allocated at the same address.
+    const std::weak_ptr<const CoreCaptureResultData> queued = evicted[0].result;
+    for (auto& e : evicted) {
+      assert(spill.spill(std::move(e.result)));
+    }
+    evicted.clear();
+    assert(spill.total_spilled_bytes() == 2 * kCpuCaptureBytes);
+    // Served from memory until written, then reloaded from the file.
+    for (int i = 0; i < 5000 && !queued.expired(); ++i) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    assert(queued.expired());
+    size_t spill_files = 0;
+    for (const fs::directory_entry& dir : fs::directory_iterator(spill_base)) {
+      if (dir.path().filename() == "cambang-capture-spill-unparsable") {
+        continue;
+      }
+#if !defined(_WIN32)
+      assert(fs::status(dir.path()).permissions() == fs::perms::owner_all);
+#endif
+      for (const fs::directory_entry& file : fs::directory_iterator(dir.path())) {
+#if !defined(_WIN32)
+        assert(fs::status(file.path()).permissions() == (fs::perms::owner_read | fs::perms::owner_write));
+#endif
+        (void)file;
+        ++spill_files;
+      }
+    }
+    assert(spill_files == 2);
+    const SharedCaptureResultData reloaded = spill.load(2, kDeviceInstanceId);
+    assert(reloaded);
+    assert(spill.load(2, kDeviceInstanceId) == reloaded);
+    assert(reloaded->capture_id == 2 && reloaded->default_image.payload.size_bytes() == kCpuCaptureBytes);
+    assert(reloaded->default_image.payload.data()[0] == 2 && reloaded->default_image.payload.data()[1] == 0x5A);
+    assert(spill.load_capture_set(2).size() == 1);
+
+    // 2 was used last, so spilling 1 over the tier budget drops 3.
+    auto evict_held = store.evict_over_byte_budget(0);
+    assert(evict_held.size() == 2 && evict_held[0].capture_id == 4 && evict_held[1].capture_id == 1);
+    assert(spill.spill(std::move(evict_held[1].result)));
+    assert(spill.spilled_result_count() == 2);
+    assert(!spill.load(3, kDeviceInstanceId) && spill.load(1, kDeviceInstanceId));
+    spill.remove(2, kDeviceInstanceId);
+    assert(!spill.load(2, kDeviceInstanceId));
+
+    FrameView gpu_frame = make_gpu_only_capture_frame(9);
+    assert(store.retain_frame(gpu_frame, std::nullopt, 0, 1, {}, requested_gpu));
+    store.mark_capture_results_evictable({{9, kDeviceInstanceId}});
+    auto evict_gpu = store.evict_over_byte_budget(0);
+    assert(evict_gpu.size() == 1 && !spill.spill(std::move(evict_gpu[0].result)));
+    spill.clear();
+    assert(spill.spilled_result_count() == 0 && spill.total_spilled_bytes() == 0);
+    fs::remove_all(spill_base);
+  }
+
+  // ---- Compressed in-memory spill tier -----------------------------------
+  // COMPRESSED_MEMORY holds evicted payloads compressed instead of on disk,
+  // counts the compressed bytes, and reloads them byte-exact. A result that
+  // does not compress is dropped.
+  {
+    CoreResultStore store;
+    for (uint64_t capture_id = 1; capture_id <= 3; ++capture_id) {
+      std::vector<uint8_t> bytes;
+      FrameView frame = make_cpu_capture_frame(capture_id, bytes);
+      bytes[0] = static_cast<uint8_t>(capture_id);
+      if (capture_id == 3) {
+        uint32_t noise = 0x12345678u;
+        for (uint8_t& b : bytes) {
+          noise = noise * 1664525u + 1013904223u;
+          b = static_cast<uint8_t>(noise >> 24);
+        }
+      }
+      assert(store.retain_frame(frame, std::nullopt, 0, 1, {}, requested_cpu));
+    }
+    store.mark_capture_results_evictable({{1, kDeviceInstanceId}, {2, kDeviceInstanceId}, {3, kDeviceInstanceId}});
+    auto evicted = store.evict_over_byte_budget(0);
+    assert(evicted.size() == 3);
+
+    CoreCaptureSpillStore spill;
+    spill.set_medium(CoreCaptureSpillStore::Medium::COMPRESSED_MEMORY, 2 * kCpuCaptureBytes);
+    const auto spill_and_wait = [&spill](SharedCaptureResultData result) {
+      const std::weak_ptr<const CoreCaptureResultData> queued = result;
+      assert(spill.spill(std::move(result)));
+      for (int i = 0; i < 5000 && !queued.expired(); ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      }
+      assert(queued.expired());
+    };
+    spill_and_wait(std::move(evicted[0].result));
+    spill_and_wait(std::move(evicted[1].result));
+    const uint64_t compressed_bytes = spill.total_spilled_bytes();
+    assert(compressed_bytes > 0 && compressed_bytes < kCpuCaptureBytes / 8);
+    // Fits the budget only because 1 and 2 are held compressed.
+    spill_and_wait(std::move(evicted[2].result));
+    evicted.clear();
+    assert(!spill.load(3, kDeviceInstanceId));
+    assert(spill.spilled_result_count() == 2 && spill.total_spilled_bytes() == compressed_bytes);
+    assert(spill.load(1, kDeviceInstanceId)->default_image.payload.data()[0] == 1);
+
+    const SharedCaptureResultData reloaded = spill.load(2, kDeviceInstanceId);
+    assert(reloaded && spill.load(2, kDeviceInstanceId) == reloaded);
+    const CoreResultPayloadCpuPacked& payload = reloaded->default_image.payload;
+    assert(payload.size_bytes() == kCpuCaptureBytes && payload.data()[0] == 2);
+    for (size_t i = 1; i < payload.size_bytes(); ++i) {
+      assert(payload.data()[i] == 0x5A);
+    }
+    spill.clear();
+    assert(spill.medium() == CoreCaptureSpillStore::Medium::COMPRESSED_MEMORY);
+  }
+
   // ---- Volume stress ------------------------------------------------------
   // A much larger synthetic multi-camera repeated-capture session: thousands
   // of captures across several devices, swept in batches (as repeated timer
@@ -225,7 +379,7 @@ int main() {
   // in-flight); left alone these would accumulate without bound and make the
   // budget permanently unenforceable (byte-budget eviction only ever touches
   // terminal entries -- see CoreCaptureAssemblyRegistry::
-  // terminal_capture_device_pairs()'s doc comment). The watchdog is what
+  // take_newly_terminal_capture_device_pairs()'s doc comment). The watchdog is what
   // closes that loop in production: any admission left non-terminal past its
   // timeout is forced to FAILED (terminal), which is exactly the composition
   // this stress verifies -- that the two mechanisms together, not byte-budget
@@ -296,6 +450,50 @@ int main() {
     assert(store.total_estimated_capture_bytes() % kCpuCaptureBytes == 0);
   }
 
+  // ---- Eviction cost tracks what is evicted -----------------------------
+  // The evictable list is kept as assemblies turn terminal, so a pass over a
+  // store dominated by in-flight entries costs the entries it evicts, not
+  // the store. GPU-only entries carry estimated bytes without backing
+  // memory, so the store can be large without the smoke being heavy.
+  {
+    CoreResultStore store;
+    CoreCaptureAssemblyRegistry assembly;
+    constexpr uint64_t kInFlight = 20000;
+    constexpr uint64_t kSweeps = 2000;
+    for (uint64_t capture_id = 1; capture_id <= kInFlight; ++capture_id) {
+      FrameView frame = make_gpu_only_capture_frame(capture_id);
+      assert(store.retain_frame(frame, std::nullopt, 0, 1, {}, requested_gpu));
+      assembly.mark_default_image_retained(capture_id, kDeviceInstanceId);
+    }
+    const uint64_t in_flight_bytes = kInFlight * kGpuCaptureBytes;
+    assert(store.total_estimated_capture_bytes() == in_flight_bytes);
+
+    // Each tick one newer capture completes and the sweep evicts exactly it.
+    const auto started = std::chrono::steady_clock::now();
+    for (uint64_t i = 1; i <= kSweeps; ++i) {
+      const uint64_t capture_id = kInFlight + i;
+      FrameView frame = make_gpu_only_capture_frame(capture_id);
+      assert(store.retain_frame(frame, std::nullopt, 0, 1, {}, requested_gpu));
+      assembly.mark_default_image_retained(capture_id, kDeviceInstanceId);
+      assembly.mark_capture_completed(capture_id, kDeviceInstanceId);
+      const auto evicted = run_eviction_sweep(store, assembly, in_flight_bytes);
+      assert(evicted.size() == 1 && evicted[0].capture_id == capture_id);
+    }
+    const auto elapsed = std::chrono::steady_clock::now() - started;
+    assert(store.total_estimated_capture_bytes() == in_flight_bytes);
+    // A full walk of the 20000 pinned entries per sweep would be tens of
+    // millions of visits; bounded per-sweep work finishes far inside this.
+    assert(elapsed < std::chrono::seconds(2));
+
+    // An empty evictable list costs nothing even far over budget.
+    const auto stuck_started = std::chrono::steady_clock::now();
+    for (uint64_t i = 0; i < kSweeps; ++i) {
+      assert(run_eviction_sweep(store, assembly, 0).empty());
+    }
+    assert(std::chrono::steady_clock::now() - stuck_started < std::chrono::seconds(1));
+    assert(store.total_estimated_capture_bytes() == in_flight_bytes);
+  }
+
   std::cout << "PASS core_result_byte_budget_stress_smoke\n";
   return 0;
 }
@@ -1,5 +1,8 @@
+#include <algorithm>
 #include <cassert>
 #include <cstdint>
+#include <cstdlib>
+#include <cstring>
 #include <iostream>
 #include <memory>
 #include <limits>
@@ -8,7 +11,24 @@
 #include <vector>
 
 #include "core/camera_fact_types.h"
+#include "core/core_capture_fusion.h"
+#include "core/core_capture_thumbnails.h"
+#include "core/core_derived_payload.h"
+#include "core/core_encoded_image.h"
+#include "core/core_frame_pacing.h"
+#include "core/core_device_registry.h"
 #include "core/core_result_store.h"
+#include "core/core_rig_registry.h"
+#include "core/core_rig_stream_frame_sets.h"
+#include "core/core_stream_registry.h"
+#include "core/core_undistort.h"
+#include "core/resource_aggregate_telemetry.h"
+#include "pixels/convert/packed_swizzle.h"
+#include "pixels/fusion/exposure_fusion.h"
+#include "pixels/pattern/cpu_packed_pattern_renderer.h"
+#include "pixels/pattern/pattern_band_pool.h"
+#include "pixels/pattern/pattern_base_cache.h"
+#include "pixels/signature/content_signature.h"
 
 using namespace cambang;
 
@@ -65,6 +85,10 @@ void verify_camera_fact_types() {
   static_assert(!std::is_default_constructible_v<FocusAtDistance>);
   static_assert(!std::is_default_constructible_v<GeodeticAltitude>);
   static_assert(!std::is_default_constructible_v<Geolocation>);
+  static_assert(!std::is_default_constructible_v<RawSensorLayout>);
+  assert(RawSensorLayout::create(ColorFilterArrangement::RGGB, {64, 64, 64, 64}, 1023));
+  assert(!RawSensorLayout::create(ColorFilterArrangement::RGGB, {64, 64, 64, 64}, 0));
+  assert(!RawSensorLayout::create(ColorFilterArrangement::BGGR, {64, 1023, 64, 64}, 1023));
 
   CameraStaticFacts description{};
   CaptureAdmissionFacts admission{};
@@ -311,10 +335,1116 @@ void verify_camera_fact_types() {
   assert(FactOrigin::DERIVED != FactOrigin::CORE_DERIVED);
 }
 
+void verify_undistort_remap() {
+  const CoordinateDomain delivered = CoordinateDomainDeliveredImage{};
+  CameraStaticFacts camera{};
+  camera.intrinsics = SourcedFact<Intrinsics>{
+      *Intrinsics::create(40.0, 40.0, 31.5, 23.5, std::nullopt, 64, 48, delivered),
+      FactOrigin::USER_SUPPLIED};
+  const auto barrel = BrownConrady5Distortion::create(
+      -0.2, 0.05, 0.0, 0.001, -0.001, 64, 48, delivered, DistortionImageState::DISTORTED);
+  assert(barrel);
+  camera.distortion = SourcedFact<Distortion>{*barrel, FactOrigin::USER_SUPPLIED};
+
+  // Intrinsics rescale from their reference size; the aspect must match.
+  const auto model = undistort_model_for_image(camera, 32, 24);
+  assert(model);
+  assert(model->focal_length_x_px == 20.0);
+  assert(model->principal_point_x_px == 15.5);
+  assert(!undistort_model_for_image(camera, 32, 32));
+
+  CameraStaticFacts rectified = camera;
+  rectified.distortion = SourcedFact<Distortion>{
+      *BrownConrady5Distortion::create(-0.2, 0.05, 0.0, 0.0, 0.0, 64, 48, delivered,
+                                       DistortionImageState::RECTIFIED),
+      FactOrigin::USER_SUPPLIED};
+  assert(!undistort_model_for_image(rectified, 64, 48));
+  CameraStaticFacts sensor_domain = camera;
+  sensor_domain.intrinsics = SourcedFact<Intrinsics>{
+      *Intrinsics::create(40.0, 40.0, 31.5, 23.5, std::nullopt, 64, 48,
+                          CoordinateDomainAndroidSensorActiveArray{}),
+      FactOrigin::NATIVE_REPORTED};
+  assert(!undistort_model_for_image(sensor_domain, 64, 48));
+
+  // Zero distortion maps every pixel onto itself.
+  UndistortModel identity = *undistort_model_for_image(camera, 64, 48);
+  identity.radial_k1 = identity.radial_k2 = identity.radial_k3 = 0.0;
+  identity.tangential_p1 = identity.tangential_p2 = 0.0;
+  UndistortRemapLut identity_lut;
+  assert(build_undistort_remap_lut(identity, 64, 48, identity_lut));
+  std::vector<uint8_t> src(64u * 48u * 4u);
+  for (size_t i = 0; i < src.size(); ++i) {
+    src[i] = static_cast<uint8_t>(i * 7u + (i >> 8));
+  }
+  std::vector<uint8_t> dst(src.size());
+  remap_bilinear_rgba8(identity_lut, src.data(), 64u * 4u, dst.data());
+  assert(dst == src);
+
+  // Barrel undistortion samples inward and leaves the principal point fixed;
+  // the cache builds one map per (model, size).
+  UndistortRemapLutCache cache(2);
+  const auto lut = cache.get(*undistort_model_for_image(camera, 64, 48), 64, 48);
+  assert(lut && cache.get(*undistort_model_for_image(camera, 64, 48), 64, 48) == lut);
+  assert(cache.builds() == 1);
+  const size_t corner = 0;
+  assert(lut->src_xy[corner] == UndistortRemapLut::kOutside ||
+         lut->src_xy[corner] > 0);
+  const size_t centre = (23u * 64u + 31u) * 2u;
+  assert(std::abs(lut->src_xy[centre] - 31 * 256) <= 1);
+  assert(std::abs(lut->src_xy[centre + 1] - 23 * 256) <= 1);
+  assert(cache.get(identity, 64, 48) != lut);
+  assert(cache.builds() == 2);
+
+  CoreCaptureResultData::ImageMemberData member{};
+  member.payload.format_fourcc = FOURCC_RGBA;
+  member.payload.width = 64;
+  member.payload.height = 48;
+  member.payload.stride_bytes = 64u * 4u;
+  member.payload.bytes.assign(src.begin(), src.end());
+  std::vector<uint8_t> undistorted(src.size());
+  assert(!copy_capture_member_undistorted_rgba(member, undistorted.data(), undistorted.size()));
+  member.resolved_image_facts.camera = std::make_shared<const CameraStaticFacts>(camera);
+  assert(copy_capture_member_undistorted_rgba(member, undistorted.data(), undistorted.size()));
+  assert(undistorted != src);
+  assert(!copy_capture_member_undistorted_rgba(member, undistorted.data(), undistorted.size() - 1));
+}
+
+void verify_packed_transform() {
+  constexpr uint32_t kW = 7;
+  constexpr uint32_t kH = 5;
+  CoreResultPayloadCpuPacked bgra{};
+  bgra.format_fourcc = FOURCC_BGRA;
+  bgra.width = kW;
+  bgra.height = kH;
+  bgra.stride_bytes = kW * 4u;
+  bgra.bytes.resize(static_cast<size_t>(kW) * kH * 4u);
+  for (size_t i = 0; i < bgra.bytes.size(); ++i) {
+    bgra.bytes[i] = static_cast<uint8_t>(i * 37u + 11u);
+  }
+  std::vector<uint8_t> rgba(bgra.bytes.size());
+  assert(copy_retained_cpu_payload_as_rgba(bgra, rgba.data(), rgba.size()));
+
+  // The identity chain is the plain RGBA read.
+  PackedTransform identity{};
+  std::vector<uint8_t> out(rgba.size());
+  assert(retained_cpu_payload_transformed_size(bgra, identity) == rgba.size());
+  assert(copy_retained_cpu_payload_transformed(bgra, identity, out.data(), out.size()));
+  assert(out == rgba);
+  assert(!copy_retained_cpu_payload_transformed(bgra, identity, out.data(), out.size() - 1));
+
+  // Crop, 2x box downscale (the right and bottom blocks are cut short), LUT
+  // and luma in one pass match the steps done one at a time.
+  PackedTransform chain{};
+  chain.crop_x = 1;
+  chain.crop_y = 1;
+  chain.crop_width = 5;
+  chain.crop_height = 3;
+  chain.downscale = 2;
+  chain.output = PackedTransformOutput::LUMA8;
+  chain.use_lut = true;
+  for (uint32_t i = 0; i < 256; ++i) {
+    chain.lut[i] = static_cast<uint8_t>(255u - i);
+  }
+  PackedTransformGeometry geometry{};
+  assert(resolve_packed_transform(chain, kW, kH, geometry));
+  assert(geometry.width == 3 && geometry.height == 2 && geometry.tight_size_bytes() == 6);
+  std::vector<uint8_t> luma(6);
+  assert(copy_retained_cpu_payload_transformed(bgra, chain, luma.data(), luma.size()));
+  for (uint32_t oy = 0; oy < 2; ++oy) {
+    for (uint32_t ox = 0; ox < 3; ++ox) {
+      uint32_t sum[3] = {0, 0, 0};
+      uint32_t count = 0;
+      for (uint32_t y = 1 + oy * 2; y < std::min(1 + oy * 2 + 2, 4u); ++y) {
+        for (uint32_t x = 1 + ox * 2; x < std::min(1 + ox * 2 + 2, 6u); ++x) {
+          for (uint32_t c = 0; c < 3; ++c) {
+            sum[c] += rgba[(static_cast<size_t>(y) * kW + x) * 4u + c];
+          }
+          ++count;
+        }
+      }
+      uint32_t rgb[3];
+      for (uint32_t c = 0; c < 3; ++c) {
+        rgb[c] = chain.lut[(sum[c] + count / 2) / count];
+      }
+      assert(luma[oy * 3 + ox] == ((77u * rgb[0] + 150u * rgb[1] + 29u * rgb[2] + 128u) >> 8));
+    }
+  }
+  PackedTransform outside = chain;
+  outside.crop_width = 7;
+  assert(retained_cpu_payload_transformed_size(bgra, outside) == 0);
+
+  // Planar payloads feed the same pass band by band, odd crop rows included.
+  constexpr uint32_t kYuvW = 8;
+  constexpr uint32_t kYuvH = 6;
+  CoreResultPayloadCpuPacked i420{};
+  i420.format_fourcc = FOURCC_I420;
+  i420.width = kYuvW;
+  i420.height = kYuvH;
+  uint32_t plane_rows[kMaxFramePlanes]{};
+  i420.bytes.resize(planar_yuv420_tight_layout(FOURCC_I420, kYuvW, kYuvH, i420.planes, plane_rows));
+  i420.plane_count = 3;
+  i420.stride_bytes = i420.planes[0].row_stride_bytes;
+  for (size_t i = 0; i < i420.bytes.size(); ++i) {
+    i420.bytes[i] = static_cast<uint8_t>(i * 29u + 3u);
+  }
+  std::vector<uint8_t> i420_rgba(static_cast<size_t>(kYuvW) * kYuvH * 4u);
+  assert(copy_retained_cpu_payload_as_rgba(i420, i420_rgba.data(), i420_rgba.size()));
+  PackedTransform crop{};
+  crop.crop_x = 2;
+  crop.crop_y = 1;
+  crop.crop_width = 5;
+  crop.crop_height = 4;
+  std::vector<uint8_t> cropped(5u * 4u * 4u);
+  assert(copy_retained_cpu_payload_transformed(i420, crop, cropped.data(), cropped.size()));
+  for (uint32_t y = 0; y < 4; ++y) {
+    assert(std::memcmp(cropped.data() + y * 20u,
+                       i420_rgba.data() + ((static_cast<size_t>(y) + 1) * kYuvW + 2) * 4u,
+                       20u) == 0);
+  }
+
+  // Unscaled RGB8 and LUMA8 take the packed kernels (vector body plus tail)
+  // and match the per-pixel definitions, from either channel order.
+  for (const bool from_bgra : {true, false}) {
+    CoreResultPayloadCpuPacked src = bgra;
+    src.format_fourcc = from_bgra ? FOURCC_BGRA : FOURCC_RGBA;
+    const size_t r_at = from_bgra ? 2u : 0u;
+    const size_t b_at = from_bgra ? 0u : 2u;
+    PackedTransform to_rgb{};
+    to_rgb.output = PackedTransformOutput::RGB8;
+    PackedTransform to_luma{};
+    to_luma.output = PackedTransformOutput::LUMA8;
+    assert(retained_cpu_payload_transformed_size(src, to_rgb) == static_cast<size_t>(kW) * kH * 3u);
+    std::vector<uint8_t> rgb(static_cast<size_t>(kW) * kH * 3u);
+    std::vector<uint8_t> grey(static_cast<size_t>(kW) * kH);
+    assert(copy_retained_cpu_payload_transformed(src, to_rgb, rgb.data(), rgb.size()));
+    assert(copy_retained_cpu_payload_transformed(src, to_luma, grey.data(), grey.size()));
+    for (size_t px = 0; px < static_cast<size_t>(kW) * kH; ++px) {
+      const uint8_t* in = src.bytes.data() + px * 4u;
+      assert(rgb[px * 3u + 0u] == in[r_at] && rgb[px * 3u + 1u] == in[1] && rgb[px * 3u + 2u] == in[b_at]);
+      assert(grey[px] == ((77u * in[r_at] + 150u * in[1] + 29u * in[b_at] + 128u) >> 8));
+    }
+    // One long span: the NEON 16-pixel body and the SSE2 spare-pixel bound.
+    constexpr size_t kSpan = 37;
+    std::vector<uint8_t> span_in(kSpan * 4u);
+    for (size_t i = 0; i < span_in.size(); ++i) {
+      span_in[i] = static_cast<uint8_t>(i * 53u + 7u);
+    }
+    std::vector<uint8_t> span_rgb(kSpan * 3u + 1u, 0xAB);
+    std::vector<uint8_t> span_grey(kSpan + 1u, 0xAB);
+    pack_packed32_as_rgb8(span_in.data(), span_rgb.data(), kSpan, from_bgra);
+    pack_packed32_as_luma8(span_in.data(), span_grey.data(), kSpan, from_bgra);
+    assert(span_rgb.back() == 0xAB && span_grey.back() == 0xAB);
+    for (size_t px = 0; px < kSpan; ++px) {
+      const uint8_t* in = span_in.data() + px * 4u;
+      assert(span_rgb[px * 3u] == in[r_at] && span_rgb[px * 3u + 1u] == in[1] && span_rgb[px * 3u + 2u] == in[b_at]);
+      assert(span_grey[px] == ((77u * in[r_at] + 150u * in[1] + 29u * in[b_at] + 128u) >> 8));
+    }
+  }
+
+  // Unscaled planar LUMA8 reads the Y plane alone; with neutral chroma it
+  // equals luma of the RGBA conversion.
+  {
+    CoreResultPayloadCpuPacked grey_yuv = i420;
+    const size_t chroma_at = grey_yuv.planes[1].offset_bytes;
+    std::fill(grey_yuv.bytes.begin() + static_cast<ptrdiff_t>(chroma_at), grey_yuv.bytes.end(), uint8_t{128});
+    PackedTransform to_luma{};
+    to_luma.output = PackedTransformOutput::LUMA8;
+    std::vector<uint8_t> luma_direct(static_cast<size_t>(kYuvW) * kYuvH);
+    assert(copy_retained_cpu_payload_transformed(grey_yuv, to_luma, luma_direct.data(), luma_direct.size()));
+    std::vector<uint8_t> grey_rgba(static_cast<size_t>(kYuvW) * kYuvH * 4u);
+    assert(copy_retained_cpu_payload_as_rgba(grey_yuv, grey_rgba.data(), grey_rgba.size()));
+    for (size_t px = 0; px < luma_direct.size(); ++px) {
+      const uint8_t* p = grey_rgba.data() + px * 4u;
+      assert(luma_direct[px] == ((77u * p[0] + 150u * p[1] + 29u * p[2] + 128u) >> 8));
+    }
+    // Chroma never enters it.
+    CoreResultPayloadCpuPacked tinted = grey_yuv;
+    std::fill(tinted.bytes.begin() + static_cast<ptrdiff_t>(chroma_at), tinted.bytes.end(), uint8_t{200});
+    std::vector<uint8_t> luma_tinted(luma_direct.size());
+    assert(copy_retained_cpu_payload_transformed(tinted, to_luma, luma_tinted.data(), luma_tinted.size()));
+    assert(luma_tinted == luma_direct);
+  }
+
+  // A capture member computes a chain once and shares it.
+  CoreCaptureResultData::ImageMemberData member{};
+  member.payload = bgra;
+  assert(!obtain_capture_member_derived_payload(member, chain));
+  member.derived_payloads = std::make_shared<CoreDerivedPayloadCache>();
+  const auto derived = obtain_capture_member_derived_payload(member, chain);
+  assert(derived && derived->bytes == luma && derived->width == 3 && derived->stride_bytes == 3);
+  CoreCaptureResultData::ImageMemberData copy = member;
+  assert(obtain_capture_member_derived_payload(copy, chain) == derived);
+  assert(!obtain_capture_member_derived_payload(member, outside));
+
+  // Thumbnail boxes (vector sums, the large 1x1 box flushing its 16-bit
+  // lanes) match a plain per-pixel area average, RGBA alpha included.
+  constexpr uint32_t kBigW = 37;
+  constexpr uint32_t kBigH = 23;
+  CoreResultPayloadCpuPacked big{};
+  big.format_fourcc = FOURCC_RGBA;
+  big.width = kBigW;
+  big.height = kBigH;
+  big.stride_bytes = kBigW * 4u;
+  big.bytes.resize(static_cast<size_t>(big.stride_bytes) * kBigH);
+  for (size_t i = 0; i < big.bytes.size(); ++i) {
+    big.bytes[i] = static_cast<uint8_t>((i * 2654435761u) >> 13);
+  }
+  const auto check_area_average = [&](const PackedTransform& t, uint32_t want_w, uint32_t want_h) {
+    PackedTransformGeometry g{};
+    assert(resolve_packed_transform(t, kBigW, kBigH, g));
+    assert(g.width == want_w && g.height == want_h);
+    std::vector<uint8_t> thumb(g.tight_size_bytes());
+    assert(copy_retained_cpu_payload_transformed(big, t, thumb.data(), thumb.size()));
+    for (uint32_t oy = 0; oy < want_h; ++oy) {
+      uint32_t y0 = 0;
+      uint32_t y1 = 0;
+      packed_transform_source_rows(t, g, oy, y0, y1);
+      for (uint32_t ox = 0; ox < want_w; ++ox) {
+        const uint32_t x0 = t.downscale != 1 ? ox * t.downscale : ox * kBigW / want_w;
+        const uint32_t x1 = t.downscale != 1 ? std::min(x0 + t.downscale, kBigW) : (ox + 1) * kBigW / want_w;
+        for (uint32_t c = 0; c < 4; ++c) {
+          uint32_t sum = 0;
+          for (uint32_t y = y0; y < y1; ++y) {
+            for (uint32_t x = x0; x < x1; ++x) {
+              sum += big.bytes[static_cast<size_t>(y) * big.stride_bytes + x * 4u + c];
+            }
+          }
+          const uint32_t count = (y1 - y0) * (x1 - x0);
+          assert(thumb[(static_cast<size_t>(oy) * want_w + ox) * 4u + c] == (sum + count / 2) / count);
+        }
+      }
+    }
+  };
+  for (const uint32_t factor : {2u, 4u, 8u}) {
+    PackedTransform box{};
+    box.downscale = factor;
+    check_area_average(box, (kBigW + factor - 1) / factor, (kBigH + factor - 1) / factor);
+  }
+  PackedTransform fixed{};
+  fixed.target_width = 10;
+  fixed.target_height = 7;
+  check_area_average(fixed, 10, 7);
+  fixed.target_height = 0;
+  check_area_average(fixed, 10, 6);
+  fixed.target_width = 1;
+  fixed.target_height = 1;
+  check_area_average(fixed, 1, 1);
+  PackedTransformGeometry rejected{};
+  fixed.downscale = 2;
+  assert(!resolve_packed_transform(fixed, kBigW, kBigH, rejected));
+  fixed.downscale = 1;
+  fixed.target_width = kBigW + 1;
+  assert(!resolve_packed_transform(fixed, kBigW, kBigH, rejected));
+
+  // A fixed-size thumbnail of a planar payload averages the converted rows.
+  PackedTransform yuv_thumb{};
+  yuv_thumb.target_width = 3;
+  yuv_thumb.target_height = 4;
+  std::vector<uint8_t> yuv_small(3u * 4u * 4u);
+  assert(copy_retained_cpu_payload_transformed(i420, yuv_thumb, yuv_small.data(), yuv_small.size()));
+  for (uint32_t oy = 0; oy < 4; ++oy) {
+    for (uint32_t ox = 0; ox < 3; ++ox) {
+      for (uint32_t c = 0; c < 4; ++c) {
+        uint32_t sum = 0;
+        uint32_t count = 0;
+        for (uint32_t y = oy * kYuvH / 4; y < (oy + 1) * kYuvH / 4; ++y) {
+          for (uint32_t x = ox * kYuvW / 3; x < (ox + 1) * kYuvW / 3; ++x) {
+            sum += i420_rgba[(static_cast<size_t>(y) * kYuvW + x) * 4u + c];
+            ++count;
+          }
+        }
+        assert(yuv_small[(oy * 3u + ox) * 4u + c] == (sum + count / 2) / count);
+      }
+    }
+  }
+
+  // A stream result caches per retained frame like a capture member.
+  CoreStreamResultData frame{};
+  frame.payload = big;
+  PackedTransform quarter{};
+  quarter.downscale = 4;
+  assert(!obtain_stream_result_derived_payload(frame, quarter));
+  frame.derived_payloads = std::make_shared<CoreDerivedPayloadCache>();
+  const auto preview = obtain_stream_result_derived_payload(frame, quarter);
+  assert(preview && preview->width == 10 && preview->height == 6);
+  assert(obtain_stream_result_derived_payload(frame, quarter) == preview);
+}
+
+void verify_pattern_base_cache() {
+  PatternSpec spec{};
+  spec.width = 32;
+  spec.height = 16;
+  spec.algo = PatternAlgoId::Checker;
+  spec.checker_size_px = 4;
+  std::vector<uint8_t> a(32u * 16u * 4u);
+  std::vector<uint8_t> b(a.size());
+  PatternRenderTarget dst{};
+  dst.width = spec.width;
+  dst.height = spec.height;
+  dst.stride_bytes = 32u * 4u;
+  dst.size_bytes = a.size();
+  dst.format = spec.format;
+
+  // The second renderer of the same base takes it from the cache, unrendered,
+  // and draws the same bytes.
+  PatternBaseCache cache(2);
+  CpuPackedPatternRenderer first;
+  CpuPackedPatternRenderer second;
+  first.set_base_cache(&cache);
+  second.set_base_cache(&cache);
+  dst.data = a.data();
+  first.render_into(spec, dst, PatternOverlayData{});
+  dst.data = b.data();
+  second.render_into(spec, dst, PatternOverlayData{});
+  assert(a == b);
+  assert(cache.inserts() == 1);
+  assert(second.debug_stats().base_shared_cache_hit_count == 1);
+  assert(second.debug_stats().base_render_total_ns == 0);
+
+  // Least recently used bases beyond capacity are dropped; a renderer keeps
+  // the base it holds.
+  PatternSpec other = spec;
+  for (uint32_t size_px = 2; size_px <= 3; ++size_px) {
+    other.checker_size_px = size_px;
+    first.configure(other);
+  }
+  assert(cache.size() == 2 && cache.inserts() == 3);
+  assert(!cache.find(PatternBaseKey::from_spec(spec)));
+  second.render_into(spec, dst, PatternOverlayData{});
+  assert(a == b);
+  // A memory-pressure trim counts only the bases no renderer still holds.
+  const size_t base_bytes = static_cast<size_t>(spec.width) * spec.height * 4u;
+  assert(cache.trim(1) == base_bytes && cache.size() == 1);
+  assert(cache.trim(0) == 0 && cache.size() == 0);
+  cache.clear();
+  assert(cache.size() == 0);
+}
+
+uint64_t fnv1a64(const std::vector<uint8_t>& bytes) {
+  uint64_t h = 1469598103934665603ull;
+  for (const uint8_t b : bytes) {
+    h ^= b;
+    h *= 1099511628211ull;
+  }
+  return h;
+}
+
+// Noise is a pure function of (seed, phase, x, y): its bytes are pinned here
+// so a kernel rewrite (wider SIMD, other band splits) cannot change them
+// unnoticed. Changing the generator on purpose means a new algo id rather
+// than new hashes. The odd width exercises the scalar tail, the padded
+// stride the row addressing.
+void verify_pattern_noise_bits() {
+  struct Case {
+    PatternAlgoId algo;
+    PatternSpec::PackedFormat format;
+    uint32_t seed;
+    uint64_t frame_index;
+    uint64_t hash;
+  };
+  constexpr PatternSpec::PackedFormat kRgba = PatternSpec::PackedFormat::RGBA8;
+  constexpr PatternSpec::PackedFormat kBgra = PatternSpec::PackedFormat::BGRA8;
+  const Case cases[] = {
+      {PatternAlgoId::Noise, kRgba, 0u, 0, 0xadf46c97f8e68b2dull},
+      {PatternAlgoId::Noise, kRgba, 0x12345678u, 0, 0x8956049edcce79faull},
+      {PatternAlgoId::Noise, kBgra, 0u, 0, 0xb831a82bfad73d01ull},
+      {PatternAlgoId::Noise, kBgra, 0x12345678u, 0, 0xd817c3c20dba89daull},
+      {PatternAlgoId::NoiseAnimated, kRgba, 0u, 7, 0xaa20f79c64310f10ull},
+      {PatternAlgoId::NoiseAnimated, kRgba, 0x12345678u, 7, 0xcaff27a279755862ull},
+      {PatternAlgoId::NoiseAnimated, kBgra, 0u, 7, 0x1bea9dd68d9f0324ull},
+      {PatternAlgoId::NoiseAnimated, kBgra, 0x12345678u, 7, 0x00d78f51bbc454f6ull},
+      // Phase 0 of animated noise is static noise.
+      {PatternAlgoId::NoiseAnimated, kRgba, 0u, 0, 0xadf46c97f8e68b2dull},
+  };
+  constexpr uint32_t kWidth = 37;
+  constexpr uint32_t kHeight = 11;
+  constexpr uint32_t kStride = kWidth * 4u + 8u;
+
+  PatternBandPool pool;
+  assert(pool.start(2, 2, 0));
+  for (const Case& c : cases) {
+    PatternSpec spec{};
+    spec.width = kWidth;
+    spec.height = kHeight;
+    spec.algo = c.algo;
+    spec.format = c.format;
+    spec.seed = c.seed;
+    spec.dynamic_base = c.algo == PatternAlgoId::NoiseAnimated;
+    spec.overlay_frame_index_offsets = false;
+    spec.overlay_moving_bar = false;
+    PatternOverlayData overlay{};
+    overlay.frame_index = c.frame_index;
+
+    std::vector<uint8_t> whole(static_cast<size_t>(kStride) * kHeight);
+    std::vector<uint8_t> banded(whole.size());
+    PatternRenderTarget dst{};
+    dst.width = kWidth;
+    dst.height = kHeight;
+    dst.stride_bytes = kStride;
+    dst.size_bytes = whole.size();
+    dst.format = c.format;
+
+    CpuPackedPatternRenderer single;
+    dst.data = whole.data();
+    single.render_into(spec, dst, overlay);
+    assert(fnv1a64(whole) == c.hash);
+
+    CpuPackedPatternRenderer split;
+    split.set_band_pool(&pool);
+    dst.data = banded.data();
+    split.render_into(spec, dst, overlay);
+    assert(banded == whole);
+  }
+  pool.stop();
+}
+
+SharedStreamResultData make_rig_stream_result(uint64_t stream_id,
+                                              uint64_t device_instance_id,
+                                              int64_t time_ms,
+                                              ImageAcquisitionComparability comparability =
+                                                  ImageAcquisitionComparability::SAME_PROVIDER) {
+  auto result = std::make_shared<CoreStreamResultData>();
+  result->stream_id = stream_id;
+  result->device_instance_id = device_instance_id;
+  result->image_facts.acquisition_timing = SourcedFact<ImageAcquisitionTiming>{
+      *ImageAcquisitionTiming::create(time_ms * 1000,
+                                      *TickPeriod::create(1000, 1),
+                                      ImageAcquisitionClockDomain::PROVIDER_MONOTONIC,
+                                      ImageAcquisitionReferenceEvent::FRAME_AVAILABLE,
+                                      comparability),
+      FactOrigin::NATIVE_REPORTED};
+  return result;
+}
+
+void verify_rig_stream_frame_sets() {
+  CoreRigRegistry rigs;
+  CoreDeviceRegistry devices;
+  assert(devices.note_device_identity(1, "cam_a"));
+  assert(devices.note_device_identity(2, "cam_b"));
+  assert(devices.note_device_identity(3, "cam_c"));
+  assert(rigs.retain_member_hardware_ids(7, {"cam_a", "cam_b"}));
+  CoreRigStreamFrameSets sets(&rigs, &devices);
+  assert(sets.is_rig_member(1) && sets.is_rig_member(2));
+  assert(!sets.is_rig_member(3));
+
+  // Nothing matches until both members have a frame interval (33 ms here,
+  // so a 16 ms window); then the pending pairs complete in order.
+  sets.on_stream_result(make_rig_stream_result(11, 1, 0));
+  sets.on_stream_result(make_rig_stream_result(12, 2, 1));
+  sets.on_stream_result(make_rig_stream_result(11, 1, 33));
+  assert(!sets.find_latest(7));
+  const SharedStreamResultData b34 = make_rig_stream_result(12, 2, 34);
+  sets.on_stream_result(b34);
+  SharedRigStreamFrameSet latest = sets.find_latest(7);
+  assert(latest && latest->rig_id == 7 && latest->set_sequence == 2);
+  assert(latest->skew_ns == 1000000u);
+  assert(latest->members.size() == 2 && latest->members[1] == b34);
+  assert(sets.stats(7).sets_completed == 2);
+
+  // A frame whose partner never arrives is dropped once a later partner
+  // frame shows it cannot match; non-comparable timing is never matched.
+  sets.on_stream_result(make_rig_stream_result(11, 1, 66));
+  sets.on_stream_result(make_rig_stream_result(11, 1, 99));
+  sets.on_stream_result(
+      make_rig_stream_result(12, 2, 100, ImageAcquisitionComparability::SAME_DEVICE));
+  sets.on_stream_result(make_rig_stream_result(12, 2, 101));
+  latest = sets.find_latest(7);
+  assert(latest && latest->set_sequence == 3 && latest->skew_ns == 2000000u);
+  assert(latest->frames_dropped_unmatched == 1 && latest->frames_unmatchable == 1);
+
+  // A membership change starts the rig over and withdraws its latest set.
+  assert(rigs.retain_member_hardware_ids(7, {"cam_a", "cam_c"}));
+  assert(sets.is_rig_member(3) && !sets.is_rig_member(2));
+  assert(!sets.find_latest(7));
+  assert(sets.stats(7).sets_completed == 0);
+  sets.clear();
+}
+
+uint64_t scoped_cpu_payload_bytes(TelemetryScope scope, uint64_t owner_id) {
+  for (const auto& entry : global_resource_aggregate_telemetry().snapshot()) {
+    const uint64_t entry_owner_id = scope == TelemetryScope::STREAM ? entry.stream_id
+        : scope == TelemetryScope::ACQUISITION_SESSION             ? entry.acquisition_session_id
+                                                                    : entry.device_instance_id;
+    if (entry.telemetry_scope == scope && entry_owner_id == owner_id) {
+      return entry.retained_cpu_payload_bytes_current;
+    }
+  }
+  return 0;
+}
+
+void verify_result_revisions() {
+  CoreResultStore store;
+  CoreRetainedProductionPlan requested_cpu{};
+  requested_cpu.valid = true;
+  requested_cpu.posture = CoreProductionPostureShape::CpuPrimary;
+  std::vector<uint8_t> px(16, 0x3c);
+  uint64_t stream_revision = store.stream_result_revision();
+  uint64_t capture_revision = store.capture_result_revision();
+  assert(stream_revision != 0 && capture_revision != 0);
+
+  // Each kind moves only with its own results, and not on a no-op removal.
+  assert(store.retain_frame(make_cpu_rgba_frame(911, 9111, 0, px), StreamIntent::PREVIEW, 1, 0, requested_cpu));
+  assert(store.stream_result_revision() > stream_revision);
+  assert(store.get_latest_stream_result(9111)->derived_payloads);
+  assert(store.capture_result_revision() == capture_revision);
+  stream_revision = store.stream_result_revision();
+  assert(store.retain_frame(make_cpu_rgba_frame(911, 0, 9112, px), std::nullopt, 0, 1, {}, requested_cpu));
+  assert(store.capture_result_revision() > capture_revision);
+  assert(store.stream_result_revision() == stream_revision);
+  capture_revision = store.capture_result_revision();
+  store.remove_stream_result(9999);
+  assert(store.stream_result_revision() == stream_revision);
+  store.remove_stream_result(9111);
+  assert(store.stream_result_revision() > stream_revision);
+  store.remove_capture_result(9112, 911);
+  assert(store.capture_result_revision() > capture_revision);
+  store.clear();
+  global_resource_aggregate_telemetry().clear();
+}
+
+void verify_retained_result_byte_telemetry() {
+  CoreResultStore store;
+  CoreRetainedProductionPlan requested_cpu{};
+  requested_cpu.valid = true;
+  requested_cpu.posture = CoreProductionPostureShape::CpuPrimary;
+  std::vector<uint8_t> px(16, 0x7f);
+
+  // A replaced stream result hands its bytes to the new one.
+  const FrameView stream_frame = make_cpu_rgba_frame(901, 9001, 0, px);
+  assert(store.retain_frame(stream_frame, StreamIntent::PREVIEW, 1, 0, requested_cpu));
+  assert(store.retain_frame(stream_frame, StreamIntent::PREVIEW, 1, 0, requested_cpu));
+  assert(scoped_cpu_payload_bytes(TelemetryScope::STREAM, 9001) == px.size());
+
+  // Captures count against their session, or their device without one.
+  FrameView session_capture = make_cpu_rgba_frame(901, 0, 9101, px);
+  session_capture.acquisition_session_id = 9201;
+  assert(store.retain_frame(session_capture, std::nullopt, 0, 1, {}, requested_cpu));
+  assert(store.retain_frame(make_cpu_rgba_frame(902, 0, 9102, px), std::nullopt, 0, 1, {}, requested_cpu));
+  assert(scoped_cpu_payload_bytes(TelemetryScope::ACQUISITION_SESSION, 9201) == px.size());
+  assert(scoped_cpu_payload_bytes(TelemetryScope::DEVICE, 902) == px.size());
+  assert(scoped_cpu_payload_bytes(TelemetryScope::DEVICE, 901) == 0);
+
+  store.remove_stream_result(9001);
+  assert(scoped_cpu_payload_bytes(TelemetryScope::STREAM, 9001) == 0);
+  store.remove_capture_result(9102, 902);
+  assert(scoped_cpu_payload_bytes(TelemetryScope::DEVICE, 902) == 0);
+  store.clear();
+  assert(scoped_cpu_payload_bytes(TelemetryScope::ACQUISITION_SESSION, 9201) == 0);
+  global_resource_aggregate_telemetry().clear();
+}
+
+ImageAcquisitionTiming make_ms_timing(int64_t time_ms,
+                                      ImageAcquisitionClockDomain clock_domain =
+                                          ImageAcquisitionClockDomain::PROVIDER_MONOTONIC) {
+  return *ImageAcquisitionTiming::create(time_ms * 1000,
+                                         *TickPeriod::create(1000, 1),
+                                         clock_domain,
+                                         ImageAcquisitionReferenceEvent::FRAME_AVAILABLE,
+                                         ImageAcquisitionComparability::SAME_DEVICE);
+}
+
+void verify_stream_history_ring() {
+  CoreResultStore store;
+  CoreRetainedProductionPlan requested_cpu{};
+  requested_cpu.valid = true;
+  requested_cpu.posture = CoreProductionPostureShape::CpuPrimary;
+  std::vector<std::shared_ptr<const CpuPayloadBytes>> owners;
+  const auto retain_at = [&](int64_t time_ms) {
+    auto owner = std::make_shared<const CpuPayloadBytes>(16, static_cast<uint8_t>(time_ms));
+    owners.push_back(owner);
+    FrameView frame{};
+    frame.device_instance_id = 951;
+    frame.stream_id = 9501;
+    frame.width = 2;
+    frame.height = 2;
+    frame.format_fourcc = FOURCC_RGBA;
+    frame.data = owner->data();
+    frame.size_bytes = owner->size();
+    frame.cpu_payload_owner = owner;
+    frame.acquisition_timing =
+        SourcedFact<ImageAcquisitionTiming>{make_ms_timing(time_ms), FactOrigin::NATIVE_REPORTED};
+    assert(store.retain_frame(frame, StreamIntent::PREVIEW, 1, 0, requested_cpu));
+  };
+
+  // Off by default: only the latest result answers.
+  retain_at(0);
+  retain_at(33);
+  assert(store.stream_history_frame_count(9501) == 0);
+  SharedStreamResultData found = store.find_stream_history_result(9501, make_ms_timing(0));
+  assert(!found);
+
+  // Bounded by count: four kept frames plus the latest.
+  store.set_stream_history_limits(9501, 4, 1024);
+  for (int64_t t = 66; t <= 231; t += 33) {
+    retain_at(t);
+  }
+  assert(store.stream_history_frame_count(9501) == 4);
+  found = store.find_stream_history_result(9501, make_ms_timing(140));
+  assert(found && found->payload.retained_bytes == owners[4]); // 132 ms, sharing its bytes
+  found = store.find_stream_history_result(9501, make_ms_timing(0));
+  assert(found && found->payload.data()[0] == 99); // oldest kept
+  found = store.find_stream_history_result(9501, make_ms_timing(500));
+  assert(found && found == store.get_latest_stream_result(9501));
+  assert(scoped_cpu_payload_bytes(TelemetryScope::STREAM, 9501) == 5 * 16);
+  // Another clock domain never matches.
+  assert(!store.find_stream_history_result(
+      9501, make_ms_timing(140, ImageAcquisitionClockDomain::CORE_MONOTONIC)));
+
+  // Bounded by bytes, and gone with the stream result.
+  store.set_stream_history_limits(9501, 4, 32);
+  assert(store.stream_history_frame_count(9501) == 2);
+  store.remove_stream_result(9501);
+  assert(store.stream_history_frame_count(9501) == 0);
+  assert(scoped_cpu_payload_bytes(TelemetryScope::STREAM, 9501) == 0);
+  retain_at(300);
+  retain_at(333);
+  assert(store.stream_history_frame_count(9501) == 0);
+  // Replaced and trimmed results handed their blocks back for reuse.
+  const CoreRecyclingBlockPool::Stats pool = store.stream_result_pool_stats();
+  assert(pool.reused > 0 && pool.unpooled == 0);
+  store.clear();
+  global_resource_aggregate_telemetry().clear();
+}
+
+void verify_stream_jitter_buffer() {
+  constexpr uint64_t kMs = 1'000'000;
+  CoreResultStore store;
+  CoreRetainedProductionPlan requested_cpu{};
+  requested_cpu.valid = true;
+  requested_cpu.posture = CoreProductionPostureShape::CpuPrimary;
+  const auto retain_at = [&](int64_t time_ms) {
+    auto owner = std::make_shared<const CpuPayloadBytes>(16, static_cast<uint8_t>(time_ms));
+    FrameView frame{};
+    frame.device_instance_id = 952;
+    frame.stream_id = 9502;
+    frame.width = 2;
+    frame.height = 2;
+    frame.format_fourcc = FOURCC_RGBA;
+    frame.data = owner->data();
+    frame.size_bytes = owner->size();
+    frame.cpu_payload_owner = owner;
+    frame.acquisition_timing =
+        SourcedFact<ImageAcquisitionTiming>{make_ms_timing(time_ms), FactOrigin::NATIVE_REPORTED};
+    assert(store.retain_frame(frame, StreamIntent::PREVIEW, 1, 0, requested_cpu));
+  };
+  const auto shown_ms = [&](uint64_t display_steady_ns) {
+    const SharedStreamResultData shown = store.select_stream_result_for_display(9502, display_steady_ns);
+    return shown ? static_cast<int>(shown->payload.data()[0]) : -1;
+  };
+
+  // Off by default: the latest result, whatever the display time.
+  retain_at(0);
+  assert(shown_ms(0) == 0);
+
+  // 100 ms latency; frames every 33 ms retained back to back, so the newest
+  // arrived soonest after acquisition and anchors the mapping.
+  store.set_stream_jitter_buffer_latency(9502, 100 * kMs);
+  assert(store.stream_jitter_buffer_latency_ns(9502) == 100 * kMs);
+  for (int64_t t = 33; t <= 231; t += 33) {
+    retain_at(t);
+  }
+  assert(store.stream_history_frame_count(9502) == CoreResultStore::kJitterBufferFrames);
+  const uint64_t latest_steady_ns = store.get_latest_stream_result(9502)->retained_steady_ns;
+  // Shown 50 ms before the newest frame's slot: the frame from 66 ms earlier.
+  assert(shown_ms(latest_steady_ns + 50 * kMs) == 165);
+  assert(shown_ms(latest_steady_ns + 101 * kMs) == 231);
+  // Everything kept is still in the future: the oldest kept frame.
+  assert(shown_ms(latest_steady_ns - 1000 * kMs) == 33);
+
+  // A smaller history request does not shrink the window; turning the mode
+  // off leaves the history request's ring, then nothing.
+  store.set_stream_history_limits(9502, 2, 1024);
+  assert(store.stream_history_frame_count(9502) == CoreResultStore::kJitterBufferFrames);
+  store.set_stream_jitter_buffer_latency(9502, 0);
+  assert(store.stream_history_frame_count(9502) == 2);
+  assert(shown_ms(0) == 231);
+  store.set_stream_history_limits(9502, 0, 0);
+  assert(store.stream_history_frame_count(9502) == 0);
+  store.clear();
+  global_resource_aggregate_telemetry().clear();
+}
+
+void verify_frame_pacing() {
+  constexpr uint64_t kMs = 1'000'000;
+
+  // Steady 10 ms with one 30 ms hole: one gap, the median untouched.
+  CoreFramePacing pacing;
+  uint64_t t = 0;
+  for (int i = 0; i < 10; ++i) {
+    pacing.record(t, 0);
+    t += 10 * kMs;
+  }
+  t += 20 * kMs;
+  pacing.record(t, 0);
+  CoreFramePacing::Summary s = pacing.summary();
+  assert(s.intervals == 10 && s.gaps == 1);
+  assert(s.interval_p50_ns >= 10 * kMs && s.interval_p50_ns <= 10 * kMs + 10 * kMs / 32);
+  assert(s.interval_p99_ns >= 30 * kMs);
+  assert(s.mean_interval_ns == 12 * kMs);
+  assert(s.jitter_ns == 6 * kMs);
+  // A source change or a time going backwards starts a new chain.
+  pacing.record(5 * kMs, 1);
+  pacing.record(4 * kMs, 1);
+  assert(pacing.summary().intervals == 10);
+  pacing.record(14 * kMs, 1);
+  assert(pacing.summary().intervals == 11);
+  pacing.restart();
+  pacing.record(500 * kMs, 1);
+  assert(pacing.summary().intervals == 11 && pacing.summary().gaps == 1);
+
+  // Arrival: acquisition time where it is comparable across frames, else the
+  // integration time; a stop ends the chain.
+  CoreStreamRegistry streams;
+  StreamRequest req{};
+  req.stream_id = 9601;
+  req.device_instance_id = 961;
+  assert(streams.declare_stream_effective(req));
+  FrameView frame{};
+  frame.stream_id = 9601;
+  frame.acquisition_timing =
+      SourcedFact<ImageAcquisitionTiming>{make_ms_timing(100), FactOrigin::NATIVE_REPORTED};
+  assert(streams.on_frame_received(9601, 7 * kMs, frame));
+  frame.acquisition_timing =
+      SourcedFact<ImageAcquisitionTiming>{make_ms_timing(133), FactOrigin::NATIVE_REPORTED};
+  assert(streams.on_frame_received(9601, 7 * kMs, frame));
+  s = streams.find(9601)->arrival_pacing.summary();
+  assert(s.intervals == 1 && s.mean_interval_ns == 33 * kMs);
+  frame.acquisition_timing.reset();
+  assert(streams.on_frame_received(9601, 8 * kMs, frame));
+  assert(streams.on_frame_received(9601, 28 * kMs, frame));
+  s = streams.find(9601)->arrival_pacing.summary();
+  assert(s.intervals == 2 && s.mean_interval_ns == 26500 * 1000);
+  assert(streams.on_core_stream_stopped(9601, 0));
+  assert(streams.on_frame_received(9601, 900 * kMs, frame));
+  assert(streams.find(9601)->arrival_pacing.summary().intervals == 2);
+
+  // Delivery: each retained frame counts once, and goes with its stream.
+  CoreResultStore store;
+  CoreRetainedProductionPlan requested_cpu{};
+  requested_cpu.valid = true;
+  requested_cpu.posture = CoreProductionPostureShape::CpuPrimary;
+  std::vector<uint8_t> px(16, 0x11);
+  CoreResultStore::StreamDeliveryStats delivery;
+  assert(!store.get_stream_delivery_stats(9602, delivery));
+  for (int i = 0; i < 3; ++i) {
+    assert(store.retain_frame(make_cpu_rgba_frame(962, 9602, 0, px), StreamIntent::PREVIEW, 1, 0, requested_cpu));
+    const SharedStreamResultData result = store.get_latest_stream_result(9602);
+    assert(result && result->retained_steady_ns != 0);
+    store.note_stream_result_displayed(*result);
+    store.note_stream_result_displayed(*result);
+  }
+  assert(store.get_stream_delivery_stats(9602, delivery));
+  assert(delivery.pacing.intervals == 2 && delivery.latency.count == 3);
+  store.remove_stream_result(9602);
+  assert(!store.get_stream_delivery_stats(9602, delivery));
+  store.clear();
+  global_resource_aggregate_telemetry().clear();
+}
+
 } // namespace
 
+void verify_exposure_fusion() {
+  // The blend kernel matches the scalar definition on every byte, through
+  // the vector body and the tail.
+  {
+    constexpr size_t kN = 53;
+    uint8_t a[kN], b[kN], c[kN], out[kN];
+    uint16_t wa[kN], wb[kN], wc[kN];
+    for (size_t i = 0; i < kN; ++i) {
+      a[i] = static_cast<uint8_t>(i * 37u + 11u);
+      b[i] = static_cast<uint8_t>(255u - i * 3u);
+      c[i] = static_cast<uint8_t>(i * i);
+      wa[i] = static_cast<uint16_t>((i * 29u) % 257u);
+      wb[i] = static_cast<uint16_t>((256u - wa[i]) / 2u);
+      wc[i] = static_cast<uint16_t>(256u - wa[i] - wb[i]);
+    }
+    const uint8_t* src[3] = {a, b, c};
+    const uint16_t* weights[3] = {wa, wb, wc};
+    blend_weighted_rgba8(src, weights, 3, kN, out);
+    for (size_t i = 0; i < kN; ++i) {
+      const uint32_t expected = (a[i] * wa[i] + b[i] * wb[i] + c[i] * wc[i] + 128u) >> 8;
+      assert(out[i] == expected);
+    }
+  }
+
+  // A bracket of three exposures of a scene whose left half is dark and
+  // right half bright: the fusion lifts the dark half from the long
+  // exposure and keeps the bright half out of its clipping.
+  constexpr uint32_t kW = 256;
+  constexpr uint32_t kH = 64;
+  auto make_member = [&](uint32_t index, uint32_t gain_num, uint32_t gain_den) {
+    CoreCaptureResultData::ImageMemberData m{};
+    m.image_member_index = index;
+    m.role = index == 0 ? CoreCaptureResultData::ImageMemberRole::DEFAULT_METERED
+                        : CoreCaptureResultData::ImageMemberRole::ADDITIONAL_BRACKET;
+    m.payload.format_fourcc = FOURCC_RGBA;
+    m.payload.width = kW;
+    m.payload.height = kH;
+    m.payload.stride_bytes = kW * 4u;
+    m.payload.bytes.resize(static_cast<size_t>(kW) * kH * 4u);
+    for (uint32_t y = 0; y < kH; ++y) {
+      for (uint32_t x = 0; x < kW; ++x) {
+        const uint32_t scene = (x < kW / 2 ? 20u : 200u) + ((x ^ y) & 3u);
+        uint8_t* p = m.payload.bytes.data() + (static_cast<size_t>(y) * kW + x) * 4u;
+        p[0] = p[1] = p[2] = static_cast<uint8_t>(std::min(255u, scene * gain_num / gain_den));
+        p[3] = 255;
+      }
+    }
+    return m;
+  };
+  CoreCaptureResultData capture{};
+  capture.default_image = make_member(0, 1, 1);
+  capture.additional_images.push_back(make_member(1, 1, 4));
+  capture.additional_images.push_back(make_member(2, 4, 1));
+  assert(can_fuse_capture_exposures(capture));
+  // No slot yet: nothing is built.
+  assert(!obtain_capture_exposure_fusion(capture) && !capture_exposure_fusion_done(capture));
+  capture.exposure_fusion = std::make_shared<CoreCaptureFusionSlot>();
+  const auto fused = obtain_capture_exposure_fusion(capture);
+  assert(fused && capture_exposure_fusion_done(capture));
+  assert(fused->width == kW && fused->height == kH && fused->stride_bytes == kW * 4u);
+  assert(fused->bytes.size() == static_cast<size_t>(kW) * kH * 4u);
+  for (uint32_t y = 0; y < kH; ++y) {
+    const uint8_t* dark = fused->bytes.data() + (static_cast<size_t>(y) * kW + 24u) * 4u;
+    const uint8_t* bright = fused->bytes.data() + (static_cast<size_t>(y) * kW + kW - 24u) * 4u;
+    assert(dark[0] > 50 && dark[3] == 255);
+    assert(bright[0] > 60 && bright[0] < 190 && bright[3] == 255);
+  }
+  // Shared by every copy of the capture.
+  CoreCaptureResultData copy = capture;
+  assert(obtain_capture_exposure_fusion(copy) == fused);
+
+  // The weights of every byte sum to 256 wherever they are interpolated.
+  {
+    const uint8_t* coarse[3] = {capture.default_image.payload.data(), capture.additional_images[0].payload.data(),
+                                capture.additional_images[1].payload.data()};
+    ExposureFusionWeights weights;
+    assert(compute_exposure_fusion_weights(coarse, 3, kW, kH, kW * 4u, weights));
+    assert(!compute_exposure_fusion_weights(coarse, 1, kW, kH, kW * 4u, weights));
+    assert(compute_exposure_fusion_weights(coarse, 3, 7, 5, kW * 4u, weights));
+    std::vector<uint16_t> rows[3];
+    uint16_t* out[3];
+    for (size_t k = 0; k < 3; ++k) {
+      rows[k].resize(61u * 4u);
+      out[k] = rows[k].data();
+    }
+    for (uint32_t y = 0; y < 23; ++y) {
+      expand_exposure_fusion_weight_row(weights, 61, 23, y, out);
+      for (size_t i = 0; i < rows[0].size(); ++i) {
+        assert(rows[0][i] + rows[1][i] + rows[2][i] == 256u);
+      }
+    }
+  }
+
+  // Not fusable: no bracket member, or members of different sizes.
+  CoreCaptureResultData no_bracket = capture;
+  no_bracket.additional_images.resize(1);
+  no_bracket.additional_images[0].role = CoreCaptureResultData::ImageMemberRole::DEFAULT_METERED;
+  assert(!can_fuse_capture_exposures(no_bracket));
+  CoreCaptureResultData mismatched = capture;
+  mismatched.additional_images[1].payload.width = kW / 2;
+  assert(!can_fuse_capture_exposures(mismatched));
+  mismatched.exposure_fusion = std::make_shared<CoreCaptureFusionSlot>();
+  assert(!obtain_capture_exposure_fusion(mismatched) && capture_exposure_fusion_done(mismatched));
+}
+
+void verify_capture_thumbnails() {
+  // Wide BGRA member: three levels, each the area average of the one before,
+  // aspect ratio kept; a flat colour stays flat at every level.
+  constexpr uint32_t kW = 1030;
+  constexpr uint32_t kH = 600;
+  CoreCaptureResultData::ImageMemberData wide{};
+  wide.payload.format_fourcc = FOURCC_BGRA;
+  wide.payload.width = kW;
+  wide.payload.height = kH;
+  wide.payload.stride_bytes = kW * 4u;
+  wide.payload.bytes.resize(static_cast<size_t>(kW) * kH * 4u);
+  for (size_t i = 0; i < wide.payload.bytes.size(); i += 4) {
+    wide.payload.bytes[i] = 30;
+    wide.payload.bytes[i + 1] = 90;
+    wide.payload.bytes[i + 2] = 200;
+    wide.payload.bytes[i + 3] = 7;
+  }
+  // No slot yet: nothing is built.
+  assert(!obtain_capture_member_thumbnails(wide));
+  wide.thumbnails = std::make_shared<CoreCaptureThumbnailSlot>();
+  const auto pyramid = obtain_capture_member_thumbnails(wide);
+  assert(pyramid && pyramid->levels.size() == 3);
+  const uint32_t expected[3][2] = {{512, 298}, {256, 149}, {128, 75}};
+  for (size_t i = 0; i < 3; ++i) {
+    const CoreDerivedPayload& level = *pyramid->levels[i];
+    assert(level.output == PackedTransformOutput::RGBA8);
+    assert(level.width == expected[i][0] && level.height == expected[i][1]);
+    assert(level.stride_bytes == level.width * 4u && level.bytes.size() == level.stride_bytes * level.height);
+    for (size_t b = 0; b < level.bytes.size(); b += 4) {
+      assert(level.bytes[b] == 200 && level.bytes[b + 1] == 90 && level.bytes[b + 2] == 30 &&
+             level.bytes[b + 3] == 255);
+    }
+  }
+  // Shared by every copy of the member.
+  CoreCaptureResultData::ImageMemberData copy = wide;
+  assert(obtain_capture_member_thumbnails(copy) == pyramid);
+  assert(pyramid->level_for(1) == pyramid->levels[2].get());
+  assert(pyramid->level_for(128) == pyramid->levels[2].get());
+  assert(pyramid->level_for(129) == pyramid->levels[1].get());
+  assert(pyramid->level_for(300) == pyramid->levels[0].get());
+  assert(pyramid->level_for(4096) == pyramid->levels[0].get());
+
+  // A tall member under 512 px: its first level is the image itself.
+  CoreCaptureResultData::ImageMemberData tall{};
+  tall.payload.format_fourcc = FOURCC_RGBA;
+  tall.payload.width = 90;
+  tall.payload.height = 300;
+  tall.payload.stride_bytes = 90 * 4u;
+  tall.payload.bytes.resize(90u * 300u * 4u);
+  for (size_t i = 0; i < tall.payload.bytes.size(); ++i) {
+    tall.payload.bytes[i] = static_cast<uint8_t>(i * 13u + 5u);
+  }
+  tall.thumbnails = std::make_shared<CoreCaptureThumbnailSlot>();
+  const auto tall_pyramid = obtain_capture_member_thumbnails(tall);
+  assert(tall_pyramid && tall_pyramid->levels.size() == 3);
+  assert(tall_pyramid->levels[0]->width == 90 && tall_pyramid->levels[0]->height == 300);
+  assert(std::equal(tall_pyramid->levels[0]->bytes.begin(), tall_pyramid->levels[0]->bytes.end(),
+                    tall.payload.bytes.begin(), tall.payload.bytes.end()));
+  assert(tall_pyramid->levels[1]->width == 77 && tall_pyramid->levels[1]->height == 256);
+  assert(tall_pyramid->levels[2]->width == 38 && tall_pyramid->levels[2]->height == 128);
+
+  // An image smaller than every level has just the one.
+  CoreCaptureResultData::ImageMemberData tiny{};
+  tiny.payload = tall.payload;
+  tiny.payload.width = 10;
+  tiny.payload.height = 12;
+  tiny.payload.stride_bytes = 40;
+  tiny.payload.bytes.resize(10u * 12u * 4u);
+  tiny.thumbnails = std::make_shared<CoreCaptureThumbnailSlot>();
+  const auto tiny_pyramid = obtain_capture_member_thumbnails(tiny);
+  assert(tiny_pyramid && tiny_pyramid->levels.size() == 1);
+  assert(tiny_pyramid->level_for(256) == tiny_pyramid->levels[0].get());
+
+  // A payload that cannot be scaled finishes the slot with no pyramid.
+  CoreCaptureResultData::ImageMemberData broken{};
+  broken.payload = tiny.payload;
+  broken.payload.stride_bytes = 8;
+  broken.thumbnails = std::make_shared<CoreCaptureThumbnailSlot>();
+  assert(!obtain_capture_member_thumbnails(broken));
+  assert(broken.thumbnails->state == CoreCaptureThumbnailSlot::State::DONE);
+}
+
+void verify_content_signature() {
+  using Sig = ContentSignature;
+  // Odd sizes, so cell spans are uneven and the byte sums run their tails.
+  constexpr uint32_t kW = 53;
+  constexpr uint32_t kH = 37;
+  std::vector<uint8_t> rgba(kW * kH * 4, 0);
+  for (uint32_t y = 0; y < kH; ++y) {
+    for (uint32_t x = 0; x < kW; ++x) {
+      uint8_t* px = rgba.data() + (y * kW + x) * 4;
+      px[0] = static_cast<uint8_t>(x * 4);
+      px[1] = static_cast<uint8_t>(y * 6);
+      px[2] = 100;
+      px[3] = 255;
+    }
+  }
+  Sig a;
+  assert(compute_content_signature(rgba.data(), kW, kH, kW * 4, 4, a) && a.valid);
+  // Cell (0, 0) is x 0..2, sampled rows 0 and 1: scalar mean of those bytes.
+  uint32_t sum = 0;
+  for (uint32_t y = 0; y < 2; ++y) {
+    for (uint32_t x = 0; x < 3; ++x) {
+      for (uint32_t c = 0; c < 4; ++c) {
+        sum += rgba[(y * kW + x) * 4 + c];
+      }
+    }
+  }
+  assert(a.cells[0] == (sum + 12) / 24);
+  Sig same;
+  assert(compute_content_signature(rgba.data(), kW, kH, kW * 4, 4, same));
+  assert(content_signature_difference(a, same) == 0);
+
+  // A bright square over one cell's sampled rows shows up in that cell only.
+  std::vector<uint8_t> moved = rgba;
+  for (uint32_t y = 16; y < 21; ++y) {
+    for (uint32_t x = 30; x < 36; ++x) {
+      std::memset(moved.data() + (y * kW + x) * 4, 255, 3);
+    }
+  }
+  Sig b;
+  assert(compute_content_signature(moved.data(), kW, kH, kW * 4, 4, b));
+  const uint32_t moved_diff = content_signature_difference(a, b);
+  assert(moved_diff > 40);
+  assert(content_signature_difference(b, a) == moved_diff);
+  uint32_t changed_cells = 0;
+  for (uint32_t i = 0; i < Sig::kCellCount; ++i) {
+    changed_cells += a.cells[i] != b.cells[i] ? 1 : 0;
+  }
+  assert(changed_cells >= 1 && changed_cells <= 6);
+
+  // Single-byte noise barely moves any cell mean.
+  std::vector<uint8_t> noisy = rgba;
+  for (size_t i = 0; i < noisy.size(); i += 7) {
+    noisy[i] = static_cast<uint8_t>(noisy[i] ^ 1);
+  }
+  Sig n;
+  assert(compute_content_signature(noisy.data(), kW, kH, kW * 4, 4, n));
+  assert(content_signature_difference(a, n) <= 1);
+
+  // A one-byte plane with padded rows; rows past width are never read.
+  std::vector<uint8_t> plane(64 * kH, 0xEE);
+  for (uint32_t y = 0; y < kH; ++y) {
+    std::memset(plane.data() + y * 64, 40, kW);
+  }
+  Sig y;
+  assert(compute_content_signature(plane.data(), kW, kH, 64, 1, y));
+  for (const uint8_t cell : y.cells) {
+    assert(cell == 40);
+  }
+
+  // Too small, or inconsistent: no signature, and always "changed".
+  Sig small;
+  assert(!compute_content_signature(rgba.data(), 15, kH, kW * 4, 4, small) && !small.valid);
+  assert(!compute_content_signature(rgba.data(), kW, kH, kW * 4 - 1, 4, small));
+  assert(!compute_content_signature(rgba.data(), kW, kH, kW * 4, 3, small));
+  assert(content_signature_difference(a, small) == 255);
+
+  // retain_frame() signs a stream frame's CPU payload; an identical frame
+  // signs identically, and a frame too small for the grid is unsigned.
+  CoreResultStore store;
+  CoreRetainedProductionPlan requested_cpu{};
+  requested_cpu.valid = true;
+  requested_cpu.posture = CoreProductionPostureShape::CpuPrimary;
+  FrameView frame = make_cpu_rgba_frame(931, 9301, 0, rgba);
+  frame.width = kW;
+  frame.height = kH;
+  assert(store.retain_frame(frame, StreamIntent::VIEWFINDER, 1, 0, requested_cpu));
+  const SharedStreamResultData first = store.get_latest_stream_result(9301);
+  assert(first && first->content_signature.valid);
+  assert(content_signature_difference(first->content_signature, a) == 0);
+  frame.data = moved.data();
+  assert(store.retain_frame(frame, StreamIntent::PREVIEW, 1, 0, requested_cpu));
+  const SharedStreamResultData second = store.get_latest_stream_result(9301);
+  assert(content_signature_difference(first->content_signature, second->content_signature) == moved_diff);
+  std::vector<uint8_t> tiny(16, 0x7f);
+  assert(store.retain_frame(make_cpu_rgba_frame(931, 9302, 0, tiny), StreamIntent::PREVIEW, 1, 0, requested_cpu));
+  assert(!store.get_latest_stream_result(9302)->content_signature.valid);
+  store.clear();
+  global_resource_aggregate_telemetry().clear();
+}
+
 int main() {
   verify_camera_fact_types();
+  verify_undistort_remap();
+  verify_packed_transform();
+  verify_pattern_base_cache();
+  verify_pattern_noise_bits();
+  verify_rig_stream_frame_sets();
+  verify_retained_result_byte_telemetry();
+  verify_result_revisions();
+  verify_stream_history_ring();
+  verify_stream_jitter_buffer();
+  verify_frame_pacing();
+  verify_content_signature();
+  verify_capture_thumbnails();
+  verify_exposure_fusion();
 
   CoreResultStore store;
 
@@ -439,6 +1569,8 @@ int main() {
   assert(repeated_cpu_stream_result);
   assert(repeated_cpu_stream_result->access_posture.posture_id == cpu_stream_posture_id);
   assert(repeated_cpu_stream_result->retained_frame_id != stream_result->retained_frame_id);
+  // One classification record per posture, not per frame.
+  assert(repeated_cpu_stream_result->access_classification == stream_result->access_classification);
   assert(repeated_cpu_stream_result->image_facts.acquisition_timing);
   assert(repeated_cpu_stream_result->image_facts.acquisition_timing->value.acquisition_mark() == 0);
   assert(repeated_cpu_stream_result->image_facts.acquisition_timing->value.tick_period().numerator_ns() ==
@@ -456,6 +1588,7 @@ int main() {
   auto restarted_cpu_stream_result = store.get_latest_stream_result(20);
   assert(restarted_cpu_stream_result);
   assert(restarted_cpu_stream_result->access_posture.posture_id != cpu_stream_posture_id);
+  assert(restarted_cpu_stream_result->access_classification != stream_result->access_classification);
 
   FrameView gpu_only_stream_frame = stream_frame;
   gpu_only_stream_frame.stream_id = 21;
@@ -541,6 +1674,98 @@ int main() {
   assert(gpu_stream_result->retained_access_truth.to_image == ResultCapability::CHEAP);
   assert(gpu_stream_result->retained_access_truth.encoded_bytes == ResultCapability::UNSUPPORTED);
 
+  {
+    // A reduced CPU sidecar (profile cpu_sidecar_downscale) is retained at its
+    // own size next to the full-size GPU primary. It is not the result's
+    // image: to_image() stays on the GPU materializer and the posture, facts
+    // and derived-payload cache see no CPU sidecar.
+    CaptureProfile reduced_profile{};
+    reduced_profile.cpu_sidecar_downscale = 4;
+    const CoreRetainedProductionPlan requested_reduced_sidecar =
+        stream_retained_plan_for_profile(requested_gpu_with_sidecar, reduced_profile);
+    assert(requested_reduced_sidecar.reduced_cpu_sidecar());
+    assert(requested_reduced_sidecar.cpu_sidecar_downscale == 4);
+    assert(!stream_retained_plan_for_profile(requested_gpu_no_sidecar, reduced_profile).reduced_cpu_sidecar());
+    reduced_profile.cpu_sidecar_downscale = 100;
+    assert(stream_retained_plan_for_profile(requested_gpu_with_sidecar, reduced_profile).cpu_sidecar_downscale ==
+           kMaxCpuSidecarDownscale);
+
+    auto sidecar_owner = std::make_shared<CpuPayloadBytes>(2 * 1 * 4, 0x5Au);
+    FrameView reduced_frame{};
+    reduced_frame.stream_id = 25;
+    reduced_frame.device_instance_id = 100;
+    reduced_frame.width = 8;
+    reduced_frame.height = 4;
+    reduced_frame.format_fourcc = FOURCC_RGBA;
+    reduced_frame.primary_backing_kind = ProducerBackingKind::GPU;
+    reduced_frame.primary_backing_artifact = std::make_shared<int>(46);
+    reduced_frame.retained_gpu_backing_descriptor.valid = true;
+    reduced_frame.retained_gpu_backing_descriptor.width = 8;
+    reduced_frame.retained_gpu_backing_descriptor.height = 4;
+    reduced_frame.retained_gpu_backing_descriptor.materialization_available = true;
+    reduced_frame.cpu_sidecar_width = 2;
+    reduced_frame.cpu_sidecar_height = 1;
+    reduced_frame.data = sidecar_owner->data();
+    reduced_frame.size_bytes = sidecar_owner->size();
+    reduced_frame.stride_bytes = 8;
+    reduced_frame.cpu_payload_owner = sidecar_owner;
+    assert(store.retain_frame(reduced_frame, StreamIntent::PREVIEW, kStreamEpochA, 0, requested_reduced_sidecar));
+    const auto reduced_result = store.get_latest_stream_result(25);
+    assert(reduced_result);
+    assert(reduced_result->image_width == 8 && reduced_result->image_height == 4);
+    assert(reduced_result->payload.width == 2 && reduced_result->payload.height == 1);
+    assert(reduced_result->payload.data() == sidecar_owner->data());
+    assert(has_current_cpu_payload(*reduced_result));
+    assert(has_reduced_cpu_sidecar(*reduced_result));
+    assert(!has_reduced_cpu_sidecar(*gpu_stream_result));
+    assert(reduced_result->retained_access_truth.to_image == ResultCapability::EXPENSIVE);
+    assert(!reduced_result->access_posture.has_retained_cpu_payload);
+    assert(!reduced_result->derived_payloads);
+    assert(reduced_result->facts.image_properties.width == 8);
+    assert(reduced_result->facts.image_properties.row_stride_bytes == 0);
+
+    // Sidecar dimensions only mean something on a GPU-primary frame.
+    FrameView reduced_cpu_frame = reduced_frame;
+    reduced_cpu_frame.stream_id = 26;
+    reduced_cpu_frame.primary_backing_kind = ProducerBackingKind::CPU;
+    reduced_cpu_frame.primary_backing_artifact.reset();
+    assert(!store.retain_frame(reduced_cpu_frame, StreamIntent::PREVIEW, kStreamEpochA, 0, requested_cpu));
+    FrameView oversized_sidecar = reduced_frame;
+    oversized_sidecar.cpu_sidecar_width = 9;
+    assert(!store.retain_frame(oversized_sidecar, StreamIntent::PREVIEW, kStreamEpochA, 0, requested_reduced_sidecar));
+  }
+
+  // A display-only stream's result is retained and displayable as usual, but
+  // skips access posture resolution and the derived-payload cache. The mode
+  // is per stream and opt-in; intent alone never selects it.
+  FrameView display_only_frame = stream_frame;
+  display_only_frame.stream_id = 24;
+  assert(!store.stream_display_only(24));
+  store.set_stream_display_only(24, true);
+  assert(store.stream_display_only(24));
+  assert(store.retain_frame(display_only_frame, StreamIntent::VIEWFINDER, kStreamEpochA, 0, requested_cpu));
+  auto display_only_result = store.get_latest_stream_result(24);
+  assert(display_only_result);
+  assert(display_only_result->intent == StreamIntent::VIEWFINDER);
+  assert(display_only_result->retained_frame_id != 0);
+  assert(display_only_result->payload.width == 2);
+  assert(display_only_result->retained_access_truth.display_view == ResultCapability::CHEAP);
+  assert(display_only_result->access_posture.posture_id == 0);
+  assert(display_only_result->access_posture.has_retained_cpu_payload);
+  assert(!display_only_result->access_classification);
+  assert(!display_only_result->derived_payloads);
+  assert(display_only_result->image_facts.acquisition_timing);
+  assert(stream_result->derived_payloads);
+  store.set_stream_display_only(24, false);
+  assert(store.retain_frame(display_only_frame, StreamIntent::VIEWFINDER, kStreamEpochA, 0, requested_cpu));
+  display_only_result = store.get_latest_stream_result(24);
+  assert(display_only_result->access_posture.posture_id != 0);
+  assert(display_only_result->access_classification);
+  assert(display_only_result->derived_payloads);
+  store.set_stream_display_only(24, true);
+  store.remove_stream_result(24);
+  assert(!store.stream_display_only(24));
+
   store.mark_stream_display_demand(20, 1'000'000'000ull);
   assert(store.is_stream_display_demand_active(20, 1'150'000'000ull));
   assert(!store.is_stream_display_demand_active(20, 1'260'000'001ull));
@@ -663,6 +1888,25 @@ int main() {
   assert(capture_result_with_bracket->image_height == height_before);
   assert(capture_result_with_bracket->image_format_fourcc == format_before);
   assert(capture_result_with_bracket->payload_kind == payload_kind_before);
+  // The default result and its copy-on-write revision are both pooled blocks.
+  assert(store.capture_result_pool_stats().allocated + store.capture_result_pool_stats().reused >= 2);
+  assert(store.capture_result_pool_stats().unpooled == 0);
+
+  // Closing a device retires its postures; other devices keep theirs.
+  FrameView closed_device_capture = capture_a;
+  closed_device_capture.capture_id = 81;
+  closed_device_capture.device_instance_id = 102;
+  assert(store.retain_frame(closed_device_capture, std::nullopt, 0, kCaptureEpochA, {}, requested_cpu));
+  const uint64_t closed_device_posture_id =
+      store.get_capture_result(81, 102)->default_image.access_posture.posture_id;
+  store.retire_device_access_postures(102);
+  closed_device_capture.capture_id = 82;
+  assert(store.retain_frame(closed_device_capture, std::nullopt, 0, kCaptureEpochA, {}, requested_cpu));
+  assert(store.get_capture_result(82, 102)->default_image.access_posture.posture_id != closed_device_posture_id);
+  FrameView capture_a_third = capture_a;
+  capture_a_third.capture_id = 83;
+  assert(store.retain_frame(capture_a_third, std::nullopt, 0, kCaptureEpochA, {}, requested_cpu));
+  assert(store.get_capture_result(83, 100)->default_image.access_posture.posture_id == capture_default_posture_id);
 
   CoreCaptureResultData::ImageMemberData bad_role{};
   bad_role.role = CoreCaptureResultData::ImageMemberRole::DEFAULT_METERED;
@@ -689,6 +1933,90 @@ int main() {
   auto capture_set = store.get_capture_result_set(77);
   assert(capture_set.size() == 2);
 
+  {
+    // Finalizing a capture attaches an encoded-bytes cache to each member
+    // that retains a CPU payload; the first encode is shared by every caller
+    // and refines the classification to READY.
+    const auto no_facts = [](uint32_t) { return CoreResolvedCaptureImageFacts{}; };
+    // Facts resolve outside the store lock, so reading the store from the
+    // resolver does not block; the finalized result is a copy that shares
+    // every member's payload bytes and is published in one swap.
+    const auto before_finalize = store.get_capture_result(77, 100);
+    const auto reading_facts = [&](uint32_t) {
+      assert(store.get_capture_result(77, 100) == before_finalize);
+      return CoreResolvedCaptureImageFacts{};
+    };
+    assert(store.finalize_capture_facts(77, 100, std::nullopt, reading_facts));
+    assert(!store.finalize_capture_facts(77, 100, std::nullopt, no_facts));
+    assert(store.finalize_capture_facts(78, 100, std::nullopt, no_facts));
+    const auto finalized = store.get_capture_result(77, 100);
+    assert(finalized && finalized != before_finalize);
+    assert(!before_finalize->capture_image_facts_finalized && finalized->capture_image_facts_finalized);
+    assert(finalized->additional_images[0].payload.uses_retained_bytes());
+    assert(finalized->additional_images[0].payload.data() ==
+           before_finalize->additional_images[0].payload.data());
+    assert(finalized && finalized->default_image.encoded_image);
+    assert(finalized->additional_images.size() == 1 && finalized->additional_images[0].encoded_image);
+    assert(finalized->default_image.encoded_image != finalized->additional_images[0].encoded_image);
+    assert(finalized->default_image.retained_access_truth.encoded_bytes == ResultCapability::EXPENSIVE);
+    assert(resolve_result_access_classification(
+               finalized->default_image.retained_access_truth.encoded_bytes,
+               finalized->default_image.access_classification,
+               CoreResultAccessOperation::ENCODED_BYTES) == ResultCapability::EXPENSIVE);
+
+    CoreEncodedImagePool pool;
+    assert(pool.submit(finalized));
+    const auto png = obtain_capture_member_encoded_bytes(finalized->default_image);
+    assert(png && png->size() > 24);
+    static const uint8_t kSignature[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1a, '\n'};
+    assert(std::memcmp(png->data(), kSignature, sizeof(kSignature)) == 0);
+    assert(std::memcmp(png->data() + 12, "IHDR", 4) == 0);
+    assert((*png)[19] == finalized->default_image.payload.width);
+    assert((*png)[23] == finalized->default_image.payload.height);
+    assert(obtain_capture_member_encoded_bytes(finalized->default_image) == png);
+    assert(resolve_result_access_classification(
+               finalized->default_image.retained_access_truth.encoded_bytes,
+               finalized->default_image.access_classification,
+               CoreResultAccessOperation::ENCODED_BYTES) == ResultCapability::READY);
+    assert(obtain_capture_member_encoded_bytes(finalized->additional_images[0]));
+    pool.stop();
+
+    // Thumbnail pyramids ride along, built by their own pool.
+    assert(finalized->default_image.thumbnails && finalized->additional_images[0].thumbnails);
+    CoreCaptureThumbnailPool thumbnail_pool;
+    assert(thumbnail_pool.submit(finalized));
+    const auto thumbnails = obtain_capture_member_thumbnails(finalized->default_image);
+    assert(thumbnails && thumbnails->levels.size() == 1);
+    assert(thumbnails->levels[0]->width == finalized->default_image.payload.width);
+    thumbnail_pool.stop();
+
+    // So is the exposure fusion: of two identical members, the image itself.
+    assert(finalized->exposure_fusion && can_fuse_capture_exposures(*finalized));
+    CoreCaptureFusionPool fusion_pool;
+    assert(fusion_pool.submit(finalized));
+    const auto fused = obtain_capture_exposure_fusion(*finalized);
+    assert(fused && capture_exposure_fusion_done(*finalized));
+    std::vector<uint8_t> default_rgba(retained_cpu_payload_transformed_size(finalized->default_image.payload, {}));
+    assert(copy_retained_cpu_payload_transformed(finalized->default_image.payload, {}, default_rgba.data(),
+                                                 default_rgba.size()));
+    assert(fused->bytes == default_rgba);
+    fusion_pool.stop();
+
+    const auto gpu_finalized = store.get_capture_result(78, 100);
+    assert(gpu_finalized && !gpu_finalized->default_image.encoded_image);
+    assert(gpu_finalized->default_image.retained_access_truth.encoded_bytes == ResultCapability::UNSUPPORTED);
+    assert(!obtain_capture_member_encoded_bytes(gpu_finalized->default_image));
+    assert(!pool.submit(gpu_finalized));
+    assert(!gpu_finalized->default_image.thumbnails);
+    assert(!obtain_capture_member_thumbnails(gpu_finalized->default_image));
+    assert(!gpu_finalized->exposure_fusion && !obtain_capture_exposure_fusion(*gpu_finalized));
+
+    // Without the pool, the first caller encodes inline.
+    assert(store.finalize_capture_facts(79, 100, std::nullopt, no_facts));
+    const auto unqueued = store.get_capture_result(79, 100);
+    assert(unqueued && obtain_capture_member_encoded_bytes(unqueued->default_image));
+  }
+
   store.clear();
   assert(!store.get_latest_stream_result(20));
   assert(!store.is_stream_display_demand_active(20, 3'010'000'000ull));
@@ -728,6 +2056,360 @@ int main() {
            second->image_facts.acquisition_timing->value.tick_period().denominator());
   }
 
+  {
+    // Planar YUV retains without RGBA conversion: padded provider strides are
+    // packed tightly, and RGBA is produced only on demand.
+    CoreResultStore planar_store;
+    std::vector<uint8_t> y_plane = {
+        235, 235, 16, 16, 0, 0,
+        235, 235, 16, 16, 0, 0};
+    std::vector<uint8_t> uv_plane = {128, 128, 128, 128, 0, 0};
+    FrameView nv12_frame{};
+    nv12_frame.device_instance_id = 4;
+    nv12_frame.stream_id = 901;
+    nv12_frame.width = 4;
+    nv12_frame.height = 2;
+    nv12_frame.format_fourcc = FOURCC_NV12;
+    nv12_frame.plane_count = 2;
+    nv12_frame.planes[0] = FramePlaneView{y_plane.data(), y_plane.size(), 6};
+    nv12_frame.planes[1] = FramePlaneView{uv_plane.data(), uv_plane.size(), 6};
+    nv12_frame.data = y_plane.data();
+    nv12_frame.size_bytes = y_plane.size();
+    nv12_frame.stride_bytes = 6;
+    FrameView missing_plane = nv12_frame;
+    missing_plane.stream_id = 902;
+    missing_plane.plane_count = 1;
+    assert(!planar_store.retain_frame(missing_plane, StreamIntent::VIEWFINDER, 1, 0, requested_cpu));
+    assert(planar_store.retain_frame(nv12_frame, StreamIntent::VIEWFINDER, 1, 0, requested_cpu));
+    const auto planar = planar_store.get_latest_stream_result(901);
+    assert(planar);
+    assert(planar->payload_kind == ResultPayloadKind::CPU_PLANAR);
+    assert(planar->access_posture.payload_kind == ResultPayloadKind::CPU_PLANAR);
+    assert(planar->retained_access_truth.display_view == ResultCapability::CHEAP);
+    assert(planar->retained_access_truth.to_image == ResultCapability::CHEAP);
+    assert(planar->facts.image_properties.bit_depth == 8);
+    assert(planar->payload.is_planar());
+    assert(planar->payload.plane_count == 2);
+    assert(planar->payload.size_bytes() == 4 * 2 + 4);
+    assert(planar->payload.planes[1].offset_bytes == 8);
+    assert(planar->payload.planes[1].row_stride_bytes == 4);
+    assert(planar->payload.data()[2] == 16 && planar->payload.data()[4] == 235);
+    assert(has_valid_retained_cpu_payload_layout(planar->payload));
+    std::vector<uint8_t> rgba(4 * 2 * 4, 1);
+    assert(!copy_retained_cpu_payload_as_rgba(planar->payload, rgba.data(), rgba.size() - 1));
+    assert(copy_retained_cpu_payload_as_rgba(planar->payload, rgba.data(), rgba.size()));
+    assert(rgba[0] == 255 && rgba[1] == 255 && rgba[2] == 255 && rgba[3] == 255);
+    assert(rgba[8] == 0 && rgba[9] == 0 && rgba[10] == 0 && rgba[11] == 255);
+
+    // A tightly packed owner already in Core's layout is adopted, not copied.
+    auto i420_owner = std::make_shared<CpuPayloadBytes>(4 * 2 + 2 + 2, 128);
+    FrameView i420_frame{};
+    i420_frame.device_instance_id = 4;
+    i420_frame.stream_id = 903;
+    i420_frame.width = 4;
+    i420_frame.height = 2;
+    i420_frame.format_fourcc = FOURCC_I420;
+    i420_frame.plane_count = 3;
+    i420_frame.planes[0] = FramePlaneView{i420_owner->data(), 8, 4};
+    i420_frame.planes[1] = FramePlaneView{i420_owner->data() + 8, 2, 2};
+    i420_frame.planes[2] = FramePlaneView{i420_owner->data() + 10, 2, 2};
+    i420_frame.data = i420_owner->data();
+    i420_frame.size_bytes = 8;
+    i420_frame.cpu_payload_owner = i420_owner;
+    assert(planar_store.retain_frame(i420_frame, StreamIntent::VIEWFINDER, 1, 0, requested_cpu));
+    const auto adopted = planar_store.get_latest_stream_result(903);
+    assert(adopted && adopted->payload.uses_retained_bytes());
+    assert(adopted->payload.data() == i420_owner->data());
+    assert(adopted->payload.planes[2].offset_bytes == 10);
+  }
+
+  {
+    // RAW stills retain as one opaque packed plane: a tight owner is adopted
+    // byte for byte, padded rows are packed, and nothing treats the samples
+    // as an image.
+    static_assert(raw_bayer_row_bytes(FOURCC_RAW10, 6) == 0);
+    static_assert(raw_bayer_row_bytes(FOURCC_RAW10, 8) == 10);
+    static_assert(raw_bayer_row_bytes(FOURCC_RAW16, 3) == 6);
+    CoreResultStore raw_store;
+    auto raw10_owner = std::make_shared<CpuPayloadBytes>(10 * 2);
+    for (size_t i = 0; i < raw10_owner->size(); ++i) {
+      (*raw10_owner)[i] = static_cast<uint8_t>(i);
+    }
+    FrameView raw10_frame{};
+    raw10_frame.device_instance_id = 4;
+    raw10_frame.capture_id = 911;
+    raw10_frame.width = 8;
+    raw10_frame.height = 2;
+    raw10_frame.format_fourcc = FOURCC_RAW10;
+    raw10_frame.data = raw10_owner->data();
+    raw10_frame.size_bytes = raw10_owner->size();
+    raw10_frame.stride_bytes = 10;
+    raw10_frame.cpu_payload_owner = raw10_owner;
+    assert(raw_store.retain_frame(raw10_frame, std::nullopt, 0, 1, {}, requested_cpu));
+    const auto raw10 = raw_store.get_capture_result(911, 4);
+    assert(raw10 && raw10->payload_kind == ResultPayloadKind::RAW_IMAGE);
+    assert(raw10->default_image.payload.uses_retained_bytes());
+    assert(raw10->default_image.payload.data() == raw10_owner->data());
+    assert(has_valid_retained_raw_payload_layout(raw10->default_image.payload));
+    assert(!has_valid_retained_cpu_payload_layout(raw10->default_image.payload));
+    assert(raw10->default_image.retained_access_truth.to_image == ResultCapability::UNSUPPORTED);
+    assert(raw10->facts.image_properties.bit_depth == 10);
+    assert(raw10->facts.image_properties.row_stride_bytes == 10);
+
+    std::vector<uint8_t> raw16_padded = {1, 2, 3, 4, 0, 0, 5, 6, 7, 8, 0, 0};
+    FrameView raw16_frame{};
+    raw16_frame.device_instance_id = 4;
+    raw16_frame.capture_id = 912;
+    raw16_frame.width = 2;
+    raw16_frame.height = 2;
+    raw16_frame.format_fourcc = FOURCC_RAW16;
+    raw16_frame.data = raw16_padded.data();
+    raw16_frame.size_bytes = raw16_padded.size();
+    raw16_frame.stride_bytes = 6;
+    FrameView raw16_odd = raw16_frame;
+    raw16_odd.capture_id = 913;
+    raw16_odd.stride_bytes = 3;
+    assert(!raw_store.retain_frame(raw16_odd, std::nullopt, 0, 1, {}, requested_cpu));
+    assert(raw_store.retain_frame(raw16_frame, std::nullopt, 0, 1, {}, requested_cpu));
+    assert(raw_store.finalize_capture_facts(
+        912, 4, std::nullopt, [](uint32_t) { return CoreResolvedCaptureImageFacts{}; }));
+    const auto raw16 = raw_store.get_capture_result(912, 4);
+    assert(raw16 && raw16->default_image.payload.stride_bytes == 4);
+    assert(raw16->default_image.payload.size_bytes() == 8);
+    assert(raw16->default_image.payload.data()[4] == 5 && raw16->default_image.payload.data()[7] == 8);
+    assert(raw16->facts.image_properties.bit_depth == 16);
+    assert(!raw16->default_image.encoded_image && !raw16->default_image.thumbnails);
+    assert(!raw16->exposure_fusion);
+  }
+
+  {
+    // Latest stream results live in a fixed lock-free-read slot table; streams
+    // beyond its capacity spill to a locked overflow map. Both stay readable,
+    // removable, and cleared together.
+    CoreResultStore slot_store;
+    constexpr uint64_t kSlotStreamBase = 5000;
+    const uint64_t stream_count = LatestResultSlotTable<CoreStreamResultData>::kSlots + 4;
+    FrameView slot_frame = stream_frame;
+    for (uint64_t i = 0; i < stream_count; ++i) {
+      slot_frame.stream_id = kSlotStreamBase + i;
+      assert(slot_store.retain_frame(slot_frame, StreamIntent::VIEWFINDER, 1, 0, requested_cpu));
+    }
+    for (uint64_t i = 0; i < stream_count; ++i) {
+      const auto result = slot_store.get_latest_stream_result(kSlotStreamBase + i);
+      assert(result && result->stream_id == kSlotStreamBase + i);
+    }
+    const uint64_t table_stream = kSlotStreamBase;
+    const uint64_t overflow_stream = kSlotStreamBase + stream_count - 1;
+    const auto before_replace = slot_store.get_latest_stream_result(table_stream);
+    slot_frame.stream_id = table_stream;
+    assert(slot_store.retain_frame(slot_frame, StreamIntent::VIEWFINDER, 1, 0, requested_cpu));
+    const auto after_replace = slot_store.get_latest_stream_result(table_stream);
+    assert(after_replace && after_replace != before_replace);
+    assert(after_replace->retained_frame_id > before_replace->retained_frame_id);
+
+    // Display demand: every stream marks and retains, so the last ones live
+    // in the demand overflow maps; both homes answer alike.
+    for (uint64_t i = 0; i < stream_count; ++i) {
+      slot_store.mark_stream_display_demand(kSlotStreamBase + i, 1'000'000'000ull);
+    }
+    slot_store.retain_stream_display_demand(table_stream);
+    slot_store.retain_stream_display_demand(overflow_stream);
+    for (const uint64_t id : {table_stream, overflow_stream}) {
+      assert(slot_store.is_stream_display_demand_active(id, 1'100'000'000ull));
+      const auto state = slot_store.get_stream_display_demand_state(id, 5'000'000'000ull);
+      assert(state.active && state.refcount == 1 &&
+             state.reason == CoreResultStore::DisplayDemandReason::PERSISTENT_REFCOUNT);
+      slot_store.release_stream_display_demand(id);
+      slot_store.release_stream_display_demand(id);
+      assert(!slot_store.is_stream_display_demand_active(id, 5'000'000'000ull));
+      assert(slot_store.is_stream_display_demand_active(id, 1'100'000'000ull));
+    }
+    slot_store.retain_stream_display_demand(table_stream);
+
+    slot_store.remove_stream_result(table_stream);
+    slot_store.remove_stream_result(overflow_stream);
+    assert(!slot_store.is_stream_display_demand_active(table_stream, 1'100'000'000ull));
+    assert(!slot_store.is_stream_display_demand_active(overflow_stream, 1'100'000'000ull));
+    assert(!slot_store.get_latest_stream_result(table_stream));
+    assert(!slot_store.get_latest_stream_result(overflow_stream));
+    // The freed table slot is reusable by a new stream.
+    slot_frame.stream_id = kSlotStreamBase + 1000;
+    assert(slot_store.retain_frame(slot_frame, StreamIntent::VIEWFINDER, 1, 0, requested_cpu));
+    assert(slot_store.get_latest_stream_result(kSlotStreamBase + 1000));
+    assert(!slot_store.get_latest_stream_result(table_stream));
+    // Nor does a freed demand slot carry its old stream's refcount over.
+    assert(!slot_store.is_stream_display_demand_active(kSlotStreamBase + 1000, 5'000'000'000ull));
+    slot_store.mark_stream_display_demand(kSlotStreamBase + 1000, 6'000'000'000ull);
+    assert(slot_store.is_stream_display_demand_active(kSlotStreamBase + 1000, 6'100'000'000ull));
+
+    slot_store.clear();
+    assert(!slot_store.get_latest_stream_result(kSlotStreamBase + 1));
+    assert(!slot_store.get_latest_stream_result(kSlotStreamBase + stream_count - 2));
+    assert(!slot_store.get_latest_stream_result(kSlotStreamBase + 1000));
+    assert(!slot_store.is_stream_display_demand_active(kSlotStreamBase + 1, 1'100'000'000ull));
+    assert(!slot_store.is_stream_display_demand_active(kSlotStreamBase + stream_count - 2, 1'100'000'000ull));
+  }
+
+  {
+    // Pooled payload buffers recycle once every holder has dropped them, and
+    // a store with a pool copies non-adoptable payloads into pooled storage.
+    CpuPayloadBufferPool pool;
+    CpuPayloadBufferKey key{};
+    key.width = 2;
+    key.height = 2;
+    key.stride_bytes = 8;
+    key.format_fourcc = FOURCC_RGBA;
+    key.size_bytes = 16;
+    assert(!pool.acquire(CpuPayloadBufferKey{}));
+    auto first = pool.acquire(key);
+    auto second = pool.acquire(key);
+    assert(first && second && first != second && first->size() == 16);
+    const uint8_t* first_data = first->data();
+    std::shared_ptr<const CpuPayloadBytes> retained_first = first;
+    first.reset();
+    auto third = pool.acquire(key);
+    assert(third && third->data() != first_data);
+    retained_first.reset();
+    auto fourth = pool.acquire(key);
+    assert(fourth && fourth->data() == first_data);
+    std::vector<std::shared_ptr<CpuPayloadBytes>> held;
+    for (size_t i = 0; i < CpuPayloadBufferPool::kMaxBuffersPerClass; ++i) {
+      held.push_back(pool.acquire(key));
+    }
+    CpuPayloadBufferPool::Stats pool_stats = pool.stats_copy();
+    assert(pool_stats.reused == 1);
+    assert(pool_stats.allocated == CpuPayloadBufferPool::kMaxBuffersPerClass);
+    assert(pool_stats.unpooled == 3);
+    assert(pool.pooled_buffer_count() == CpuPayloadBufferPool::kMaxBuffersPerClass);
+    second.reset();
+    third.reset();
+    fourth.reset();
+    held.clear();
+    assert(pool.trim() == CpuPayloadBufferPool::kMaxBuffersPerClass * 16u);
+    assert(pool.pooled_buffer_count() == 0);
+    assert(pool.trim() == 0);
+
+    // Payload storage is cache-line aligned at every size. A frame-sized
+    // buffer takes the large-page path and is counted as granted or fallen
+    // back until it is freed, whichever the host allowed.
+    const CpuPayloadAllocationStats alloc_before = cpu_payload_allocation_stats();
+    CpuPayloadBufferKey large_key = key;
+    large_key.width = 1024;
+    large_key.height = 512;
+    large_key.stride_bytes = 4096;
+    large_key.size_bytes = kCpuPayloadLargePageThreshold;
+    auto large = pool.acquire(large_key);
+    assert(large && large->size() == kCpuPayloadLargePageThreshold);
+    assert(reinterpret_cast<uintptr_t>(large->data()) % kCpuPayloadAlignment == 0);
+    (*large)[large->size() - 1] = 0x7F;
+    const bool large_pages = cpu_payload_storage_has_large_pages(large->data(), large->size());
+    const CpuPayloadAllocationStats alloc_held = cpu_payload_allocation_stats();
+    assert(alloc_held.large_page_bytes_current ==
+           alloc_before.large_page_bytes_current + (large_pages ? kCpuPayloadLargePageThreshold : 0u));
+    assert(alloc_held.fallback_bytes_current ==
+           alloc_before.fallback_bytes_current + (large_pages ? 0u : kCpuPayloadLargePageThreshold));
+    CpuPayloadBytes small(24);
+    assert(reinterpret_cast<uintptr_t>(small.data()) % kCpuPayloadAlignment == 0);
+    large.reset();
+    assert(pool.trim() == kCpuPayloadLargePageThreshold);
+    const CpuPayloadAllocationStats alloc_after = cpu_payload_allocation_stats();
+    assert(alloc_after.large_page_bytes_current == alloc_before.large_page_bytes_current);
+    assert(alloc_after.fallback_bytes_current == alloc_before.fallback_bytes_current);
+
+    CpuPayloadBufferPool store_pool;
+    CoreResultStore pooled_store;
+    pooled_store.set_cpu_payload_buffer_pool(&store_pool);
+    // A padded frame with no owner is packed tight into a pooled buffer.
+    std::vector<uint8_t> padded(12 * 2, 9);
+    FrameView padded_frame = stream_frame;
+    padded_frame.stream_id = 6000;
+    padded_frame.data = padded.data();
+    padded_frame.size_bytes = padded.size();
+    padded_frame.stride_bytes = 12;
+    assert(pooled_store.retain_frame(padded_frame, StreamIntent::VIEWFINDER, 1, 0, requested_cpu));
+    auto pooled_result = pooled_store.get_latest_stream_result(6000);
+    assert(pooled_result && pooled_result->payload.uses_retained_bytes());
+    assert(pooled_result->payload.size_bytes() == 16 && pooled_result->payload.stride_bytes == 8);
+    assert(pooled_result->payload.data()[0] == 9);
+    const uint8_t* pooled_data = pooled_result->payload.data();
+    // The reader still holds the first result, so the next frame cannot reuse it.
+    assert(pooled_store.retain_frame(padded_frame, StreamIntent::VIEWFINDER, 1, 0, requested_cpu));
+    assert(pooled_store.get_latest_stream_result(6000)->payload.data() != pooled_data);
+    pooled_result.reset();
+    assert(pooled_store.retain_frame(padded_frame, StreamIntent::VIEWFINDER, 1, 0, requested_cpu));
+    assert(pooled_store.get_latest_stream_result(6000)->payload.data() == pooled_data);
+    assert(store_pool.stats_copy().reused == 1);
+    assert(store_pool.stats_copy().allocated == 2);
+
+    // A padded owner is adopted with its stride; readers drop the padding.
+    auto padded_owner = std::make_shared<CpuPayloadBytes>(12 + 8, 0xEE);
+    for (size_t i = 0; i < 8; ++i) {
+      (*padded_owner)[i] = static_cast<uint8_t>(i + 1);
+      (*padded_owner)[12 + i] = static_cast<uint8_t>(i + 11);
+    }
+    FrameView padded_owned = padded_frame;
+    padded_owned.stream_id = 6001;
+    padded_owned.format_fourcc = FOURCC_BGRA;
+    padded_owned.data = padded_owner->data();
+    padded_owned.size_bytes = padded_owner->size();
+    padded_owned.cpu_payload_owner = padded_owner;
+    assert(pooled_store.retain_frame(padded_owned, StreamIntent::VIEWFINDER, 1, 0, requested_cpu));
+    const auto adopted_padded = pooled_store.get_latest_stream_result(6001);
+    assert(adopted_padded && adopted_padded->payload.data() == padded_owner->data());
+    assert(adopted_padded->payload.stride_bytes == 12);
+    assert(adopted_padded->facts.image_properties.row_stride_bytes == 12);
+    assert(has_valid_retained_cpu_payload_layout(adopted_padded->payload));
+    std::vector<uint8_t> unpadded(16, 0);
+    assert(copy_retained_cpu_payload_as_rgba(adopted_padded->payload, unpadded.data(), unpadded.size()));
+    const std::vector<uint8_t> expected_unpadded = {3, 2, 1, 255, 7, 6, 5, 255, 13, 12, 11, 255, 17, 16, 15, 255};
+    assert(unpadded == expected_unpadded);
+    assert(store_pool.stats_copy().allocated == 2);
+  }
+
+  {
+    // BGRA -> RGBA materialization: vector body plus scalar tail agree with
+    // the per-pixel definition and force alpha opaque.
+    CoreResultPayloadCpuPacked bgra{};
+    bgra.format_fourcc = FOURCC_BGRA;
+    bgra.width = 7;
+    bgra.height = 3;
+    bgra.stride_bytes = 7 * 4;
+    bgra.bytes.resize(7 * 3 * 4);
+    for (size_t i = 0; i < bgra.bytes.size(); ++i) {
+      bgra.bytes[i] = static_cast<uint8_t>(i * 37u + 11u);
+    }
+    std::vector<uint8_t> rgba(bgra.bytes.size(), 0);
+    assert(copy_retained_cpu_payload_as_rgba(bgra, rgba.data(), rgba.size()));
+    for (size_t px = 0; px < 7 * 3; ++px) {
+      assert(rgba[px * 4 + 0] == bgra.bytes[px * 4 + 2]);
+      assert(rgba[px * 4 + 1] == bgra.bytes[px * 4 + 1]);
+      assert(rgba[px * 4 + 2] == bgra.bytes[px * 4 + 0]);
+      assert(rgba[px * 4 + 3] == 255);
+    }
+    // Pitched rows (provider SoftwareBitmap/AImage shape) into tight output,
+    // both channel orders.
+    constexpr uint32_t kPitchedWidth = 5;
+    constexpr ptrdiff_t kPitch = kPitchedWidth * 4 + 12;
+    std::vector<uint8_t> pitched(static_cast<size_t>(kPitch) * 3, 0);
+    for (size_t i = 0; i < pitched.size(); ++i) {
+      pitched[i] = static_cast<uint8_t>(i * 13u + 5u);
+    }
+    for (const bool to_rgba : {true, false}) {
+      std::vector<uint8_t> packed(kPitchedWidth * 3 * 4, 0);
+      convert_bgra_rows_to_packed_opaque(pitched.data(), kPitch, kPitchedWidth, 3, to_rgba, packed.data());
+      for (uint32_t y = 0; y < 3; ++y) {
+        for (uint32_t x = 0; x < kPitchedWidth; ++x) {
+          const uint8_t* in = pitched.data() + kPitch * y + x * 4;
+          const uint8_t* out = packed.data() + (y * kPitchedWidth + x) * 4;
+          assert(out[0] == (to_rgba ? in[2] : in[0]));
+          assert(out[1] == in[1]);
+          assert(out[2] == (to_rgba ? in[0] : in[2]));
+          assert(out[3] == 255);
+        }
+      }
+    }
+  }
+
   {
     CoreResultStore shared_identity_store;
     std::vector<uint8_t> dual_bytes(2 * 2 * 4, 13);
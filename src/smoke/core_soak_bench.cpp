@@ -0,0 +1,702 @@
+/*
+CamBANG Maintainer Utility
+
+Tool: core_soak_bench
+
+Purpose
+-------
+Runs one CoreRuntime against synthetic devices for a long wall-clock soak
+(an hour by default) under steady stream, capture and rig churn, and watches
+for the slow leaks and drifts a short smoke cannot see: unbounded result
+retention, registries that never shrink, core-thread latency creeping up.
+
+Every --sample_ms it records resident memory, the result store's estimated
+capture bytes and table sizes (captures, access postures), Core's registry
+sizes (native objects, capture assemblies and cohorts, rigs, telemetry
+buckets, ...; CoreRuntime::resource_footprint_for_smoke()), core-thread
+queue wait and execution time over the interval (CoreTaskTimingStats) and
+ingress frame drops. The series goes to --csv and/or --json for plotting.
+
+After the run, samples past --warmup_s are checked:
+- Growth: a least-squares line is fitted to each series; a series whose
+  fitted rise over the window exceeds --growth_pct percent of its mean and
+  a per-series floor is flagged.
+- Drift: the core-thread queue wait and execution of the last quarter of the
+  window are compared with the first quarter; a mean up by more than
+  --drift_pct percent (and at least 20 us), or a p99 up by more than one
+  histogram bucket (2x), is flagged.
+Core's capture and cohort retention windows are five minutes, so the
+default warmup is six: shorter runs see the fill-up as growth.
+
+Category
+--------
+Benchmark (maintainer).
+
+Non-Goals
+---------
+- Not a core invariant smoke test
+- Not deterministic: results depend on the host and its load
+
+Exit status: 0 clean, 3 growth or drift flagged, 1 setup failure, 2 usage.
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if defined(__linux__)
+  #include <unistd.h>
+#endif
+
+#if !defined(CAMBANG_INTERNAL_SMOKE)
+  #error "core_soak_bench: build through the repo SCons maintainer_tools alias so CAMBANG_INTERNAL_SMOKE=1 is defined."
+#endif
+
+#include "core/core_runtime.h"
+#include "core/core_task_timing.h"
+#include "imaging/synthetic/provider.h"
+
+using namespace cambang;
+
+namespace {
+
+struct Options {
+  uint32_t duration_s = 3600;
+  uint32_t warmup_s = 360;
+  uint32_t sample_ms = 1000;
+  uint32_t devices = 4;
+  uint32_t width = 320;
+  uint32_t height = 240;
+  uint32_t fps = 30;
+  // 0 disables that kind of churn.
+  uint32_t stream_churn_ms = 2000;
+  uint32_t capture_ms = 500;
+  uint32_t rig_churn_ms = 5000;
+  uint32_t rig_slots = 4;
+  uint32_t growth_pct = 10;
+  uint32_t drift_pct = 50;
+  std::string csv_path;
+  std::string json_path;
+};
+
+struct Sample {
+  double t_s = 0.0;
+  int64_t rss_bytes = 0;
+  CoreRuntime::ResourceFootprintForSmoke footprint{};
+  CoreLatencyHistogram queue_wait{};
+  CoreLatencyHistogram exec{};
+  uint64_t frames_received = 0;
+  uint64_t ingress_frames_dropped = 0;
+  uint64_t stream_churns = 0;
+  uint64_t captures_triggered = 0;
+  uint64_t captures_refused = 0;
+  uint64_t rig_captures = 0;
+  uint64_t rig_captures_refused = 0;
+};
+
+// One watched series: how to read it from a sample, and the smallest fitted
+// rise worth flagging whatever its relative size.
+struct Series {
+  const char* name;
+  double (*value)(const Sample&);
+  double floor;
+};
+
+constexpr double kMiB = 1024.0 * 1024.0;
+
+const Series kSeries[] = {
+    {"rss_bytes", [](const Sample& s) { return static_cast<double>(s.rss_bytes); }, 16.0 * kMiB},
+    {"estimated_capture_bytes",
+     [](const Sample& s) { return static_cast<double>(s.footprint.estimated_capture_bytes); }, 8.0 * kMiB},
+    {"capture_results",
+     [](const Sample& s) { return static_cast<double>(s.footprint.result_store.capture_results); }, 16.0},
+    {"stream_access_postures",
+     [](const Sample& s) { return static_cast<double>(s.footprint.result_store.stream_access_postures); }, 16.0},
+    {"capture_access_postures",
+     [](const Sample& s) { return static_cast<double>(s.footprint.result_store.capture_access_postures); }, 16.0},
+    {"native_objects", [](const Sample& s) { return static_cast<double>(s.footprint.native_objects); }, 16.0},
+    {"capture_assemblies", [](const Sample& s) { return static_cast<double>(s.footprint.capture_assemblies); }, 16.0},
+    {"capture_cohorts", [](const Sample& s) { return static_cast<double>(s.footprint.capture_cohorts); }, 16.0},
+    {"telemetry_buckets", [](const Sample& s) { return static_cast<double>(s.footprint.telemetry_buckets); }, 16.0},
+    {"streams", [](const Sample& s) { return static_cast<double>(s.footprint.streams); }, 4.0},
+    {"acquisition_sessions",
+     [](const Sample& s) { return static_cast<double>(s.footprint.acquisition_sessions); }, 4.0},
+    {"rigs", [](const Sample& s) { return static_cast<double>(s.footprint.rigs); }, 4.0},
+    {"pending_capture_observations",
+     [](const Sample& s) { return static_cast<double>(s.footprint.pending_capture_observations); }, 16.0},
+};
+
+class DiscardingPublisher final : public IStateSnapshotPublisher {
+public:
+  void publish(std::shared_ptr<const CamBANGStateSnapshot> snapshot) override { (void)snapshot; }
+};
+
+void usage(const char* argv0) {
+  std::cerr << "Usage: " << argv0
+            << " [--duration_s=N] [--warmup_s=N] [--sample_ms=N] [--devices=N] [--w=W] [--h=H] [--fps=N]\n"
+            << "       [--stream_churn_ms=N] [--capture_ms=N] [--rig_churn_ms=N] [--rig_slots=N]\n"
+            << "       [--growth_pct=N] [--drift_pct=N] [--csv=PATH] [--json=PATH]\n\n"
+            << "Soaks --devices (default 4) synthetic devices, one stream each, for --duration_s\n"
+            << "(default 3600). Every --stream_churn_ms one stream is destroyed and recreated, every\n"
+            << "--capture_ms one device captures, and every --rig_churn_ms one of --rig_slots rigs is\n"
+            << "re-formed and captures (0 disables each). Samples every --sample_ms (default 1000) go\n"
+            << "to --csv and/or --json (JSON to stdout when neither is given). Exits 3 when a series\n"
+            << "grows or core-thread latency drifts past --growth_pct (default 10) / --drift_pct\n"
+            << "(default 50) after --warmup_s (default 360).\n";
+}
+
+bool starts_with(const std::string& s, const std::string& prefix) {
+  return s.rfind(prefix, 0) == 0;
+}
+
+bool parse_u32(const std::string& s, uint32_t& out) {
+  try {
+    size_t idx = 0;
+    const unsigned long v = std::stoul(s, &idx, 10);
+    if (idx != s.size()) return false;
+    out = static_cast<uint32_t>(v);
+    return true;
+  } catch (...) {
+    return false;
+  }
+}
+
+// false on a bad option; help sets `help`.
+bool parse_opts(int argc, char** argv, Options& opt, bool& help) {
+  struct U32Option {
+    const char* prefix;
+    uint32_t* target;
+    bool allow_zero;
+  };
+  const U32Option u32_options[] = {
+      {"--duration_s=", &opt.duration_s, false},
+      {"--warmup_s=", &opt.warmup_s, true},
+      {"--sample_ms=", &opt.sample_ms, false},
+      {"--devices=", &opt.devices, false},
+      {"--w=", &opt.width, false},
+      {"--h=", &opt.height, false},
+      {"--fps=", &opt.fps, false},
+      {"--stream_churn_ms=", &opt.stream_churn_ms, true},
+      {"--capture_ms=", &opt.capture_ms, true},
+      {"--rig_churn_ms=", &opt.rig_churn_ms, true},
+      {"--rig_slots=", &opt.rig_slots, false},
+      {"--growth_pct=", &opt.growth_pct, false},
+      {"--drift_pct=", &opt.drift_pct, false},
+  };
+  help = false;
+  for (int i = 1; i < argc; ++i) {
+    const std::string a = argv[i];
+    if (a == "--help" || a == "-h") {
+      help = true;
+      return true;
+    }
+    if (starts_with(a, "--csv=") || starts_with(a, "--json=")) {
+      const bool csv = starts_with(a, "--csv=");
+      std::string& path = csv ? opt.csv_path : opt.json_path;
+      path = a.substr(csv ? 6 : 7);
+      if (path.empty()) {
+        std::cerr << "Invalid " << (csv ? "--csv" : "--json") << "\n";
+        return false;
+      }
+      continue;
+    }
+    bool matched = false;
+    for (const U32Option& o : u32_options) {
+      const std::string prefix = o.prefix;
+      if (!starts_with(a, prefix)) {
+        continue;
+      }
+      matched = true;
+      if (!parse_u32(a.substr(prefix.size()), *o.target) || (!o.allow_zero && *o.target == 0)) {
+        std::cerr << "Invalid " << prefix.substr(0, prefix.size() - 1) << "\n";
+        return false;
+      }
+      break;
+    }
+    if (!matched) {
+      std::cerr << "Unknown option: " << a << "\n";
+      return false;
+    }
+  }
+  return true;
+}
+
+uint64_t steady_ns() {
+  return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                   std::chrono::steady_clock::now().time_since_epoch())
+                                   .count());
+}
+
+// Resident set size; 0 where the platform offers no cheap reading.
+int64_t resident_bytes() {
+#if defined(__linux__)
+  std::ifstream statm("/proc/self/statm");
+  long long pages_total = 0;
+  long long pages_resident = 0;
+  if (statm >> pages_total >> pages_resident) {
+    return static_cast<int64_t>(pages_resident) * static_cast<int64_t>(sysconf(_SC_PAGESIZE));
+  }
+#endif
+  return 0;
+}
+
+void add(CoreLatencyHistogram& into, const CoreLatencyHistogram& h) {
+  into.count += h.count;
+  into.total_ns += h.total_ns;
+  into.max_ns = std::max(into.max_ns, h.max_ns);
+  for (size_t b = 0; b < CoreLatencyHistogram::kBuckets; ++b) {
+    into.buckets[b] += h.buckets[b];
+  }
+}
+
+CoreLatencyHistogram delta(const CoreLatencyHistogram& after, const CoreLatencyHistogram& before) {
+  CoreLatencyHistogram d{};
+  d.count = after.count - before.count;
+  d.total_ns = after.total_ns - before.total_ns;
+  // The window's own maximum is not recoverable; report the running one.
+  d.max_ns = after.max_ns;
+  for (size_t b = 0; b < CoreLatencyHistogram::kBuckets; ++b) {
+    d.buckets[b] = after.buckets[b] - before.buckets[b];
+  }
+  return d;
+}
+
+uint64_t mean_ns(const CoreLatencyHistogram& h) {
+  return h.count ? h.total_ns / h.count : 0;
+}
+
+// Upper bound of the bucket holding the q-quantile sample.
+uint64_t quantile_upper_ns(const CoreLatencyHistogram& h, double q) {
+  if (h.count == 0) {
+    return 0;
+  }
+  const uint64_t rank = static_cast<uint64_t>(q * static_cast<double>(h.count - 1)) + 1;
+  uint64_t seen = 0;
+  for (size_t b = 0; b < CoreLatencyHistogram::kBuckets; ++b) {
+    seen += h.buckets[b];
+    if (seen >= rank) {
+      const uint64_t upper = CoreLatencyHistogram::bucket_upper_ns(b);
+      return upper != 0 ? upper : h.max_ns;
+    }
+  }
+  return h.max_ns;
+}
+
+// Core-thread work that is not nested in another task's timing, and the
+// queue wait of the lanes host and provider work arrive on.
+CoreLatencyHistogram core_exec(const CoreTaskTimingStats& s) {
+  CoreLatencyHistogram h{};
+  for (CoreTaskKind kind :
+       {CoreTaskKind::ESSENTIAL, CoreTaskKind::COMMAND, CoreTaskKind::ORDINARY, CoreTaskKind::TIMER_TICK}) {
+    add(h, s.exec[static_cast<size_t>(kind)]);
+  }
+  return h;
+}
+
+CoreLatencyHistogram core_queue_wait(const CoreTaskTimingStats& s) {
+  CoreLatencyHistogram h{};
+  add(h, s.queue_wait[static_cast<size_t>(CoreTaskKind::COMMAND)]);
+  add(h, s.queue_wait[static_cast<size_t>(CoreTaskKind::ORDINARY)]);
+  return h;
+}
+
+uint64_t frames_dropped(const ProviderCallbackIngress::Stats& s) {
+  return s.frames_dropped_full + s.frames_dropped_closed + s.frames_dropped_allocfail + s.frames_dropped_fair_share;
+}
+
+bool wait_live(CoreRuntime& rt) {
+  for (int i = 0; i < 500; ++i) {
+    if (rt.state_copy() == CoreRuntimeState::LIVE) {
+      return true;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+  }
+  return false;
+}
+
+struct Finding {
+  std::string series;
+  std::string kind;  // "growth" or "drift"
+  double first = 0.0;
+  double last = 0.0;
+  double rise = 0.0;
+};
+
+// Fitted rise of one series over `samples` (least squares against t_s).
+double fitted_rise(const std::vector<const Sample*>& samples, double (*value)(const Sample&), double& mean) {
+  const double n = static_cast<double>(samples.size());
+  double sum_t = 0.0;
+  double sum_v = 0.0;
+  for (const Sample* s : samples) {
+    sum_t += s->t_s;
+    sum_v += value(*s);
+  }
+  const double mean_t = sum_t / n;
+  mean = sum_v / n;
+  double num = 0.0;
+  double den = 0.0;
+  for (const Sample* s : samples) {
+    num += (s->t_s - mean_t) * (value(*s) - mean);
+    den += (s->t_s - mean_t) * (s->t_s - mean_t);
+  }
+  const double span = samples.back()->t_s - samples.front()->t_s;
+  return den > 0.0 ? num / den * span : 0.0;
+}
+
+std::vector<Finding> analyze(const Options& opt, const std::vector<Sample>& samples, double warmup_s) {
+  std::vector<Finding> findings;
+  std::vector<const Sample*> window;
+  for (const Sample& s : samples) {
+    if (s.t_s >= warmup_s) {
+      window.push_back(&s);
+    }
+  }
+  if (window.size() < 8) {
+    return findings;
+  }
+
+  for (const Series& series : kSeries) {
+    double mean = 0.0;
+    const double rise = fitted_rise(window, series.value, mean);
+    if (rise > series.floor && rise > std::max(mean, 1.0) * opt.growth_pct / 100.0) {
+      findings.push_back({series.name, "growth", series.value(*window.front()), series.value(*window.back()), rise});
+    }
+  }
+
+  const size_t quarter = window.size() / 4;
+  CoreLatencyHistogram first_wait{}, last_wait{}, first_exec{}, last_exec{};
+  for (size_t i = 0; i < quarter; ++i) {
+    add(first_wait, window[i]->queue_wait);
+    add(first_exec, window[i]->exec);
+    add(last_wait, window[window.size() - 1 - i]->queue_wait);
+    add(last_exec, window[window.size() - 1 - i]->exec);
+  }
+  constexpr uint64_t kDriftFloorNs = 20'000;
+  const auto check_drift = [&](const char* name, const CoreLatencyHistogram& first, const CoreLatencyHistogram& last) {
+    const uint64_t first_mean = mean_ns(first);
+    const uint64_t last_mean = mean_ns(last);
+    const bool mean_drift = last_mean > first_mean + kDriftFloorNs &&
+                            static_cast<double>(last_mean) >
+                                static_cast<double>(first_mean) * (1.0 + opt.drift_pct / 100.0);
+    const uint64_t first_p99 = quantile_upper_ns(first, 0.99);
+    const uint64_t last_p99 = quantile_upper_ns(last, 0.99);
+    const bool p99_drift = first_p99 != 0 && last_p99 > first_p99 * 2;
+    if (mean_drift) {
+      findings.push_back({std::string(name) + "_mean_ns", "drift", static_cast<double>(first_mean),
+                          static_cast<double>(last_mean), static_cast<double>(last_mean - first_mean)});
+    }
+    if (p99_drift) {
+      findings.push_back({std::string(name) + "_p99_ns", "drift", static_cast<double>(first_p99),
+                          static_cast<double>(last_p99), static_cast<double>(last_p99 - first_p99)});
+    }
+  };
+  check_drift("core_queue_wait", first_wait, last_wait);
+  check_drift("core_exec", first_exec, last_exec);
+  return findings;
+}
+
+const char* const kCsvHeader =
+    "t_s,rss_bytes,estimated_capture_bytes,capture_results,evictable_capture_results,stream_histories,"
+    "stream_access_postures,capture_access_postures,native_objects,capture_assemblies,capture_cohorts,"
+    "telemetry_buckets,devices,streams,acquisition_sessions,rigs,pending_capture_observations,"
+    "capture_stream_preemption_devices,queue_wait_mean_ns,queue_wait_p99_ns,exec_mean_ns,exec_p99_ns,"
+    "frames_received,ingress_frames_dropped,stream_churns,captures_triggered,captures_refused,rig_captures,"
+    "rig_captures_refused";
+
+void write_csv_row(std::ostream& csv, const Sample& s) {
+  const CoreRuntime::ResourceFootprintForSmoke& f = s.footprint;
+  csv << s.t_s << ',' << s.rss_bytes << ',' << f.estimated_capture_bytes << ',' << f.result_store.capture_results
+      << ',' << f.result_store.evictable_capture_results << ',' << f.result_store.stream_histories << ','
+      << f.result_store.stream_access_postures << ',' << f.result_store.capture_access_postures << ','
+      << f.native_objects << ',' << f.capture_assemblies << ',' << f.capture_cohorts << ',' << f.telemetry_buckets
+      << ',' << f.devices << ',' << f.streams << ',' << f.acquisition_sessions << ',' << f.rigs << ','
+      << f.pending_capture_observations << ',' << f.capture_stream_preemption_devices << ','
+      << mean_ns(s.queue_wait) << ',' << quantile_upper_ns(s.queue_wait, 0.99) << ',' << mean_ns(s.exec) << ','
+      << quantile_upper_ns(s.exec, 0.99) << ',' << s.frames_received << ',' << s.ingress_frames_dropped << ','
+      << s.stream_churns << ',' << s.captures_triggered << ',' << s.captures_refused << ',' << s.rig_captures
+      << ',' << s.rig_captures_refused << '\n';
+}
+
+void write_json_sample(std::ostream& json, const Sample& s) {
+  const CoreRuntime::ResourceFootprintForSmoke& f = s.footprint;
+  json << "{\"t_s\":" << s.t_s << ",\"rss_bytes\":" << s.rss_bytes
+       << ",\"estimated_capture_bytes\":" << f.estimated_capture_bytes
+       << ",\"capture_results\":" << f.result_store.capture_results
+       << ",\"evictable_capture_results\":" << f.result_store.evictable_capture_results
+       << ",\"stream_histories\":" << f.result_store.stream_histories
+       << ",\"stream_access_postures\":" << f.result_store.stream_access_postures
+       << ",\"capture_access_postures\":" << f.result_store.capture_access_postures
+       << ",\"native_objects\":" << f.native_objects << ",\"capture_assemblies\":" << f.capture_assemblies
+       << ",\"capture_cohorts\":" << f.capture_cohorts << ",\"telemetry_buckets\":" << f.telemetry_buckets
+       << ",\"devices\":" << f.devices << ",\"streams\":" << f.streams
+       << ",\"acquisition_sessions\":" << f.acquisition_sessions << ",\"rigs\":" << f.rigs
+       << ",\"pending_capture_observations\":" << f.pending_capture_observations
+       << ",\"capture_stream_preemption_devices\":" << f.capture_stream_preemption_devices
+       << ",\"queue_wait_mean_ns\":" << mean_ns(s.queue_wait)
+       << ",\"queue_wait_p99_ns\":" << quantile_upper_ns(s.queue_wait, 0.99)
+       << ",\"exec_mean_ns\":" << mean_ns(s.exec) << ",\"exec_p99_ns\":" << quantile_upper_ns(s.exec, 0.99)
+       << ",\"frames_received\":" << s.frames_received << ",\"ingress_frames_dropped\":" << s.ingress_frames_dropped
+       << ",\"stream_churns\":" << s.stream_churns << ",\"captures_triggered\":" << s.captures_triggered
+       << ",\"captures_refused\":" << s.captures_refused << ",\"rig_captures\":" << s.rig_captures
+       << ",\"rig_captures_refused\":" << s.rig_captures_refused << "}";
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  Options opt;
+  bool help = false;
+  if (!parse_opts(argc, argv, opt, help)) {
+    usage(argv[0]);
+    return 2;
+  }
+  if (help) {
+    usage(argv[0]);
+    return 0;
+  }
+
+  std::ofstream csv_file;
+  if (!opt.csv_path.empty()) {
+    csv_file.open(opt.csv_path);
+    if (!csv_file) {
+      std::cerr << "Cannot write --csv " << opt.csv_path << "\n";
+      return 2;
+    }
+    csv_file << kCsvHeader << '\n';
+  }
+  std::ofstream json_file;
+  if (!opt.json_path.empty()) {
+    json_file.open(opt.json_path);
+    if (!json_file) {
+      std::cerr << "Cannot write --json " << opt.json_path << "\n";
+      return 2;
+    }
+  }
+  const bool json_enabled = !opt.json_path.empty() || opt.csv_path.empty();
+  std::ostream& json = opt.json_path.empty() ? std::cout : json_file;
+
+  double warmup_s = opt.warmup_s;
+  if (warmup_s * 2.0 > opt.duration_s) {
+    warmup_s = opt.duration_s / 2.0;
+    std::cerr << "core_soak_bench: warmup clamped to " << warmup_s
+              << " s; runs shorter than Core's 5-minute retention windows report their fill-up as growth\n";
+  }
+
+  constexpr uint64_t kDeviceBase = 100000;
+  constexpr uint64_t kRootBase = 200000;
+  constexpr uint64_t kStreamBase = 300000;
+  constexpr uint64_t kRigBase = 400000;
+
+  CoreRuntime rt;
+  DiscardingPublisher publisher;
+  rt.set_snapshot_publisher(&publisher);
+  if (!rt.start() || !wait_live(rt)) {
+    std::cerr << "core_soak_bench: core runtime did not reach LIVE\n";
+    rt.stop();
+    return 1;
+  }
+
+  SyntheticProviderConfig cfg{};
+  cfg.endpoint_count = opt.devices;
+  cfg.nominal.width = opt.width;
+  cfg.nominal.height = opt.height;
+  cfg.nominal.format_fourcc = FOURCC_RGBA;
+  cfg.nominal.fps_num = opt.fps;
+  cfg.nominal.fps_den = 1;
+  cfg.frame_content_mode = SyntheticFrameContentMode::Headless;
+  SyntheticProvider provider(cfg);
+  std::vector<CameraEndpoint> endpoints;
+  const auto fail = [&](const char* message) {
+    std::cerr << "core_soak_bench: " << message << "\n";
+    (void)provider.shutdown();
+    rt.stop();
+    rt.attach_provider(nullptr);
+    rt.set_snapshot_publisher(nullptr);
+    return 1;
+  };
+  if (!provider.initialize(rt.provider_callbacks()).ok() || !provider.enumerate_endpoints(endpoints).ok() ||
+      endpoints.size() < opt.devices) {
+    return fail("provider setup failed");
+  }
+  rt.attach_provider(&provider);
+
+  CaptureProfile profile{};
+  profile.width = opt.width;
+  profile.height = opt.height;
+  profile.format_fourcc = FOURCC_RGBA;
+  profile.target_fps_min = opt.fps;
+  profile.target_fps_max = opt.fps;
+  const auto start_stream = [&](uint64_t stream_id, uint64_t device_instance_id) {
+    return rt.try_create_stream(stream_id, device_instance_id, StreamIntent::PREVIEW, &profile, nullptr, 0) ==
+               TryCreateStreamStatus::OK &&
+           rt.try_start_stream(stream_id) == TryStartStreamStatus::OK;
+  };
+  std::vector<uint64_t> stream_ids(opt.devices);
+  for (uint32_t i = 0; i < opt.devices; ++i) {
+    stream_ids[i] = kStreamBase + i;
+    if (rt.try_open_device(endpoints[i].hardware_id, kDeviceBase + i, kRootBase + i) != TryOpenDeviceStatus::OK ||
+        !start_stream(stream_ids[i], kDeviceBase + i)) {
+      return fail("device or stream setup failed");
+    }
+  }
+  uint64_t next_stream_id = kStreamBase + opt.devices;
+  uint64_t next_capture_id = 1;
+
+  if (json_enabled) {
+    json << "{\"tool\":\"core_soak_bench\",\"schema\":1,\"duration_s\":" << opt.duration_s
+         << ",\"warmup_s\":" << warmup_s << ",\"sample_ms\":" << opt.sample_ms << ",\"devices\":" << opt.devices
+         << ",\"width\":" << opt.width << ",\"height\":" << opt.height << ",\"fps\":" << opt.fps
+         << ",\"stream_churn_ms\":" << opt.stream_churn_ms << ",\"capture_ms\":" << opt.capture_ms
+         << ",\"rig_churn_ms\":" << opt.rig_churn_ms << ",\"rig_slots\":" << opt.rig_slots
+         << ",\"growth_pct\":" << opt.growth_pct << ",\"drift_pct\":" << opt.drift_pct << ",\"samples\":[";
+  }
+
+  std::vector<Sample> samples;
+  Sample counters{};
+  CoreRuntime::Stats stats_before = rt.stats_copy();
+  ProviderCallbackIngress::Stats ingress_before = rt.ingress_stats_copy();
+  CoreDispatchStats dispatch_before = rt.dispatcher_stats();
+
+  const auto every = [](uint32_t period_ms) {
+    return period_ms ? static_cast<uint64_t>(period_ms) * 1'000'000ull : UINT64_MAX;
+  };
+  const uint64_t begin_ns = steady_ns();
+  const uint64_t end_ns = begin_ns + static_cast<uint64_t>(opt.duration_s) * 1'000'000'000ull;
+  uint64_t last_ns = begin_ns;
+  uint64_t next_sample_ns = begin_ns + every(opt.sample_ms);
+  uint64_t next_stream_churn_ns = begin_ns + every(opt.stream_churn_ms);
+  uint64_t next_capture_ns = begin_ns + every(opt.capture_ms);
+  uint64_t next_rig_churn_ns = begin_ns + every(opt.rig_churn_ms);
+  uint64_t churn_round = 0;
+  uint64_t capture_round = 0;
+  uint64_t rig_round = 0;
+  bool footprint_failed = false;
+
+  // Tick the provider in real time at about 1 ms, as a free-running host
+  // tick does; churn and sampling run between ticks on their own periods.
+  while (true) {
+    const uint64_t now_ns = steady_ns();
+    if (now_ns >= end_ns) {
+      break;
+    }
+    provider.advance(now_ns - last_ns, false, false);
+    last_ns = now_ns;
+    for (uint64_t stream_id : stream_ids) {
+      (void)rt.get_latest_stream_result(stream_id);
+    }
+
+    if (now_ns >= next_stream_churn_ns) {
+      next_stream_churn_ns += every(opt.stream_churn_ms);
+      const size_t d = churn_round++ % opt.devices;
+      (void)rt.try_stop_stream(stream_ids[d]);
+      (void)rt.try_destroy_stream(stream_ids[d]);
+      stream_ids[d] = next_stream_id++;
+      if (start_stream(stream_ids[d], kDeviceBase + d)) {
+        ++counters.stream_churns;
+      }
+    }
+    if (now_ns >= next_capture_ns) {
+      next_capture_ns += every(opt.capture_ms);
+      const uint64_t device_instance_id = kDeviceBase + capture_round++ % opt.devices;
+      if (rt.try_trigger_device_capture_with_capture_id_for_server(device_instance_id, next_capture_id++) ==
+          TryTriggerDeviceCaptureStatus::OK) {
+        ++counters.captures_triggered;
+      } else {
+        ++counters.captures_refused;
+      }
+    }
+    if (now_ns >= next_rig_churn_ns) {
+      next_rig_churn_ns += every(opt.rig_churn_ms);
+      // Re-form one rig slot over a rotating run of 1..3 devices.
+      const uint64_t rig_id = kRigBase + rig_round % opt.rig_slots;
+      const size_t members = 1 + rig_round % std::min<uint32_t>(opt.devices, 3);
+      std::vector<std::string> hardware_ids;
+      for (size_t m = 0; m < members; ++m) {
+        hardware_ids.push_back(endpoints[(rig_round + m) % opt.devices].hardware_id);
+      }
+      ++rig_round;
+      if (rt.smoke_set_rig_member_hardware_ids(rig_id, std::move(hardware_ids)) &&
+          rt.orchestrate_rig_capture_with_capture_id_for_server(rig_id, next_capture_id++).ok) {
+        ++counters.rig_captures;
+      } else {
+        ++counters.rig_captures_refused;
+      }
+    }
+
+    if (now_ns >= next_sample_ns) {
+      next_sample_ns += every(opt.sample_ms);
+      const std::optional<CoreRuntime::ResourceFootprintForSmoke> footprint = rt.resource_footprint_for_smoke();
+      if (!footprint) {
+        footprint_failed = true;
+        break;
+      }
+      const CoreRuntime::Stats stats_after = rt.stats_copy();
+      const ProviderCallbackIngress::Stats ingress_after = rt.ingress_stats_copy();
+      const CoreDispatchStats dispatch_after = rt.dispatcher_stats();
+      Sample s = counters;
+      s.t_s = static_cast<double>(steady_ns() - begin_ns) / 1e9;
+      s.rss_bytes = resident_bytes();
+      s.footprint = *footprint;
+      s.queue_wait = delta(core_queue_wait(stats_after.task_timing), core_queue_wait(stats_before.task_timing));
+      s.exec = delta(core_exec(stats_after.task_timing), core_exec(stats_before.task_timing));
+      s.frames_received = dispatch_after.frames_received - dispatch_before.frames_received;
+      s.ingress_frames_dropped = frames_dropped(ingress_after) - frames_dropped(ingress_before);
+      stats_before = stats_after;
+      ingress_before = ingress_after;
+      dispatch_before = dispatch_after;
+      counters = Sample{};
+
+      if (csv_file.is_open()) {
+        write_csv_row(csv_file, s);
+        csv_file.flush();
+      }
+      if (json_enabled) {
+        json << (samples.empty() ? "\n" : ",\n");
+        write_json_sample(json, s);
+      }
+      samples.push_back(s);
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+
+  for (uint32_t i = 0; i < opt.devices; ++i) {
+    (void)rt.try_stop_stream(stream_ids[i]);
+    (void)rt.try_destroy_stream(stream_ids[i]);
+    (void)rt.try_close_device(kDeviceBase + i);
+  }
+  (void)provider.shutdown();
+  rt.stop();
+  rt.attach_provider(nullptr);
+  rt.set_snapshot_publisher(nullptr);
+
+  if (footprint_failed) {
+    std::cerr << "core_soak_bench: core thread did not answer a footprint query within 2 s\n";
+    if (json_enabled) {
+      json << "\n]}\n";
+    }
+    return 1;
+  }
+
+  const std::vector<Finding> findings = analyze(opt, samples, warmup_s);
+  if (json_enabled) {
+    json << "\n],\"findings\":[";
+    for (size_t i = 0; i < findings.size(); ++i) {
+      const Finding& f = findings[i];
+      json << (i ? "," : "") << "\n{\"series\":\"" << f.series << "\",\"kind\":\"" << f.kind
+           << "\",\"first\":" << f.first << ",\"last\":" << f.last << ",\"rise\":" << f.rise << "}";
+    }
+    json << (findings.empty() ? "" : "\n") << "]}\n";
+  }
+  for (const Finding& f : findings) {
+    std::cerr << "core_soak_bench: FLAG " << f.kind << " " << f.series << " first=" << f.first
+              << " last=" << f.last << " rise=" << f.rise << "\n";
+  }
+  std::cerr << "core_soak_bench: samples=" << samples.size() << " findings=" << findings.size() << "\n";
+  return findings.empty() ? 0 : 3;
+}
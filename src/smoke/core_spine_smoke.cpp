@@ -26,9 +26,12 @@ Non-Goals
 #include <algorithm>
 #include <atomic>
 #include <cmath>
+#include <coroutine>
 #include <cstring>
 #include <cstdio>
 #include <cstdint>
+#include <filesystem>
+#include <fstream>
 #include <functional>
 #include <future>
 #include <iostream>
@@ -50,11 +53,16 @@ Non-Goals
   #error "core_spine_smoke: build through the repo SCons maintainer_tools alias so CAMBANG_INTERNAL_SMOKE=1 is defined."
 #endif
 #include "core/camera_concurrency_adc.h"
+#include "core/core_string_interner.h"
 #include "core/adc_camera_description.h"
+#include "core/core_hdr_histogram.h"
+#include "core/core_native_object_registry.h"
 #include "core/core_runtime.h"
 #include "core/provider_callback_ingress.h"
 #include "core/resource_aggregate_telemetry.h"
+#include "core/snapshot/snapshot_delta.h"
 #include "core/state_snapshot_buffer.h"
+#include "imaging/api/strict_json.h"
 
 #if defined(CAMBANG_SMOKE_WITH_STUB_PROVIDER)
 #include "imaging/stub/provider.h"
@@ -738,8 +746,42 @@ static int test_core_spec_state_imaging_spec_retention_smoke() {
     return 1;
   }
 
-  spec_state.set_imaging_spec_version(44);
-  if (spec_state.imaging_spec_version() != 44 ||
+  // A patch that leaves the concurrency members alone keeps the derived
+  // truth in place; one that changes them re-derives it.
+  const auto* retained_combinations =
+      spec_state.interpret_imaging_spec().camera_concurrency.allowed_camera_id_combinations.data();
+  std::string facts_patch_json = patch_json;
+  const std::string cam_a_record = "{\"camera_id\":\"camA\"}";
+  facts_patch_json.replace(
+      facts_patch_json.find(cam_a_record),
+      cam_a_record.size(),
+      "{\"camera_id\":\"camA\",\"facing\":\"back\"}");
+  std::vector<uint8_t> facts_patch_bytes = as_bytes(facts_patch_json);
+  if (!spec_state.retain_imaging_spec_patch(43, std::vector<uint8_t>(facts_patch_bytes)) ||
+      spec_state.imaging_spec_version() != 43 ||
+      spec_state.imaging_spec_payload_copy() != facts_patch_bytes ||
+      spec_state.interpret_imaging_spec().camera_concurrency.allowed_camera_id_combinations.data() !=
+          retained_combinations) {
+    std::cerr << "FAIL: imaging spec patch re-derived an unchanged concurrency truth\n";
+    return 1;
+  }
+  const std::vector<uint8_t> combination_patch_bytes = as_bytes(make_adc_camera_concurrency_json(
+      {"camA", "camB", "camC"},
+      true,
+      {{"camB", "camC"}},
+      3));
+  if (!spec_state.retain_imaging_spec_patch(
+          44,
+          SpecPatchView{combination_patch_bytes.data(), combination_patch_bytes.size()}) ||
+      spec_state.interpret_imaging_spec()
+              .camera_concurrency
+              .allowed_camera_id_combinations.size() != 1) {
+    std::cerr << "FAIL: imaging spec patch did not re-derive a changed concurrency truth\n";
+    return 1;
+  }
+
+  spec_state.set_imaging_spec_version(45);
+  if (spec_state.imaging_spec_version() != 45 ||
       spec_state.has_imaging_spec_payload() ||
       spec_state.imaging_spec_retention_kind() != CoreSpecState::ImagingSpecRetentionKind::None ||
       spec_state.interpret_imaging_spec().camera_concurrency.kind !=
@@ -1058,6 +1100,9 @@ static int test_adc_camera_description_parser_and_retention_smoke() {
     rt.stop();
     return 1;
   }
+  // A reader's publication is immutable: later replacements publish a new
+  // set and leave this one as it was.
+  const SharedExternalCameraDescription held = rt.active_external_camera_description();
   const auto allowed = rt.smoke_admit_rig_cohort_from_preflight(
       9100, 9101, make_manual_rig_preflight(9100, {"Cam A ", "cam-b"}));
   if (!allowed.ok || rt.replace_external_camera_description_json_for_internal(populated).status !=
@@ -1092,6 +1137,12 @@ static int test_adc_camera_description_parser_and_retention_smoke() {
     rt.stop();
     return 1;
   }
+  if (!held || held->version != configured.camera_description_version || held->state.entries().size() != 2 ||
+      !held->state.find_exact("cam-b") || rt.active_external_camera_description() == held) {
+    std::cerr << "FAIL: replacing the external camera description changed a held publication\n";
+    rt.stop();
+    return 1;
+  }
   const auto reduced = rt.active_external_camera_description_for_smoke("Cam A ");
   const auto unavailable = rt.smoke_admit_rig_cohort_from_preflight(
       9100, 9102, make_manual_rig_preflight(9100, {"Cam A ", "cam-b"}));
@@ -1183,6 +1234,84 @@ static int test_adc_camera_description_parser_and_retention_smoke() {
   return 0;
 }
 
+static int test_camera_description_file_ingest_smoke() {
+  std::error_code ec;
+  const std::filesystem::path dir =
+      std::filesystem::temp_directory_path(ec) /
+      ("cambang-adc-file-ingest-" +
+       std::to_string(std::chrono::steady_clock::now().time_since_epoch().count()));
+  std::filesystem::create_directories(dir, ec);
+  const auto write_file = [&](const char* name, const std::string& text) {
+    const std::filesystem::path path = dir / name;
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out << text;
+    return path.string();
+  };
+  const std::string description_path = write_file(
+      "description.json",
+      R"JSON({"schema_version":2,"cameras":[{"camera_id":"Cam A "},{"camera_id":"cam-b"}],)JSON"
+      R"JSON("concurrent_camera_support":{"supported":true,"camera_id_combinations":[["Cam A ","cam-b"]]}})JSON");
+  const std::string concurrency_json =
+      make_adc_camera_concurrency_json({"Cam A ", "cam-b"}, true, {{"Cam A ", "cam-b"}}, 2);
+  const std::string concurrency_path = write_file("concurrency.json", concurrency_json);
+  const std::string empty_path = write_file("empty.json", "");
+  const std::string missing_path = (dir / "missing.json").string();
+
+  CoreRuntime rt;
+  const auto fail = [&](const char* msg) {
+    std::cerr << "FAIL: " << msg << "\n";
+    rt.stop();
+    std::filesystem::remove_all(dir, ec);
+    return 1;
+  };
+  if (rt.replace_external_camera_description_json_file_for_internal(missing_path).status !=
+          CoreRuntime::ReplaceExternalCameraDescriptionStatus::IoError ||
+      rt.replace_external_camera_description_json_file_for_internal(empty_path).status !=
+          CoreRuntime::ReplaceExternalCameraDescriptionStatus::IoError ||
+      rt.ingest_camera_concurrency_json_file_for_server(missing_path).status !=
+          CoreRuntime::IngestCameraConcurrencyStatus::IoError) {
+    return fail("unreadable ADC file was not reported as an I/O error");
+  }
+
+  // Parsed off the calling thread; Core only receives the result.
+  CoreRuntime::ReplaceExternalCameraDescriptionResult described{};
+  std::thread([&] {
+    described = rt.replace_external_camera_description_json_file_for_internal(description_path);
+  }).join();
+  if (described.status != CoreRuntime::ReplaceExternalCameraDescriptionStatus::Ok ||
+      described.camera_description_version == 0 || described.imaging_spec_version == 0 || !rt.start() ||
+      !wait_until([&]() { return rt.state_copy() == CoreRuntimeState::LIVE; }, 200, 1) ||
+      rt.active_external_camera_description_count_for_smoke() != 2 ||
+      rt.active_external_camera_description_version_for_smoke() != described.camera_description_version) {
+    return fail("file-ingested camera description did not reach the active generation");
+  }
+  if (rt.replace_external_camera_description_json_file_for_internal(description_path).status !=
+          CoreRuntime::ReplaceExternalCameraDescriptionStatus::Busy ||
+      rt.ingest_camera_concurrency_json_file_for_server(concurrency_path).status !=
+          CoreRuntime::IngestCameraConcurrencyStatus::Busy) {
+    return fail("file ingest while LIVE was not rejected as busy");
+  }
+  rt.stop();
+
+  CoreRuntime::IngestCameraConcurrencyResult ingested{};
+  std::thread([&] { ingested = rt.ingest_camera_concurrency_json_file_for_server(concurrency_path); }).join();
+  if (ingested.status != CoreRuntime::IngestCameraConcurrencyStatus::Ok || ingested.imaging_spec_version == 0 ||
+      !rt.start() || !wait_until([&]() { return rt.state_copy() == CoreRuntimeState::LIVE; }, 200, 1)) {
+    return fail("file-ingested camera concurrency was not accepted");
+  }
+  const auto retained = rt.imaging_spec_retained_state_for_smoke();
+  const auto allowed = rt.smoke_admit_rig_cohort_from_preflight(
+      9200, 9201, make_manual_rig_preflight(9200, {"Cam A ", "cam-b"}));
+  if (!retained || retained->imaging_spec_version != ingested.imaging_spec_version ||
+      retained->payload != std::vector<uint8_t>(concurrency_json.begin(), concurrency_json.end()) ||
+      rt.active_external_camera_description_count_for_smoke() != 0 || !allowed.ok) {
+    return fail("file-ingested camera concurrency did not apply its parsed truth at start");
+  }
+  rt.stop();
+  std::filesystem::remove_all(dir, ec);
+  return 0;
+}
+
 static int test_runtime_camera_concurrency_ingest_lifecycle_smoke() {
   CoreRuntime rt;
   StateSnapshotBuffer buf;
@@ -1532,6 +1661,133 @@ static int test_runtime_camera_concurrency_invalid_input_smoke() {
   return 0;
 }
 
+static int test_camera_concurrency_combination_index_smoke() {
+  // 100 cameras in a ring of 100 pairwise combinations plus one triple, so
+  // the index spans two words per camera row.
+  std::vector<std::string> camera_ids;
+  std::vector<std::vector<std::string>> combinations;
+  for (int i = 0; i < 100; ++i) {
+    camera_ids.push_back("cam" + std::to_string(i));
+  }
+  for (int i = 0; i < 100; ++i) {
+    combinations.push_back({camera_ids[i], camera_ids[(i + 1) % 100]});
+  }
+  combinations.push_back({"cam10", "cam70", "cam90"});
+  const auto loaded = camera_concurrency::load_truth_from_adc_json_text(
+      make_adc_camera_concurrency_json(camera_ids, true, combinations));
+  if (!loaded.ok || loaded.truth.combination_index.camera_keys.size() != 100 ||
+      loaded.truth.combination_index.words_per_row != 2) {
+    std::cerr << "FAIL: camera concurrency combination index not built: " << loaded.error_message << "\n";
+    return 1;
+  }
+
+  struct Case {
+    std::vector<std::string> requested;
+    bool allowed;
+  };
+  const std::vector<Case> cases{
+      {{"cam0", "cam1"}, true},
+      {{"cam99", "cam0"}, true},
+      {{"cam90", "cam10"}, true},
+      {{"cam70", "cam90", "cam10"}, true},
+      {{"cam0", "cam2"}, false},
+      {{"cam0", "cam1", "cam2"}, false},
+      {{"cam0", "cam0"}, false},
+      {{"cam0", "cam_unknown"}, false},
+      {{"cam0"}, false},
+  };
+  for (const auto& c : cases) {
+    if (camera_concurrency::requested_camera_id_set_is_allowed(loaded.truth, c.requested) != c.allowed) {
+      std::cerr << "FAIL: camera concurrency admission mismatch for " << c.requested.front() << "+"
+                << c.requested.back() << " (size " << c.requested.size() << ")\n";
+      return 1;
+    }
+  }
+
+  // The index is keyed by interned ids: interning is stable and round-trips,
+  // and an id set resolves the same as its strings.
+  CoreStringInterner& ids = global_hardware_id_interner();
+  const CoreStringId cam0 = ids.find("cam0");
+  if (cam0 == 0 || ids.intern("cam0") != cam0 || ids.str(cam0) != "cam0" ||
+      ids.find("cam_never_interned") != 0 ||
+      !camera_concurrency::requested_camera_key_set_is_allowed(loaded.truth, {cam0, ids.find("cam1")}) ||
+      camera_concurrency::requested_camera_key_set_is_allowed(loaded.truth, {cam0, 0})) {
+    std::cerr << "FAIL: camera concurrency interned key lookup mismatch\n";
+    return 1;
+  }
+  return 0;
+}
+
+static int test_strict_json_document_views_and_payload_ingest_smoke() {
+  strict_json::Document doc;
+  const std::string text =
+      "{\"plain\":\"camA\",\"esc\\u0061ped\":\"a\\tb\\u00e9\",\"n\":-12.5e3,\"list\":[1,[2],{}]}";
+  std::string error;
+  if (!doc.parse(text, strict_json::ParseOptions{}, &error)) {
+    std::cerr << "FAIL: strict_json rejected valid document: " << error << "\n";
+    return 1;
+  }
+  const strict_json::Value& root = doc.root();
+  const strict_json::Value* plain = root.find("plain");
+  const strict_json::Value* escaped = root.find("escaped");
+  const strict_json::Value* number = root.find("n");
+  const strict_json::Value* list = root.find("list");
+  if (root.type != strict_json::Value::Type::Object || root.items().size() != 4 || !plain || !escaped ||
+      !number || !list) {
+    std::cerr << "FAIL: strict_json object members missing\n";
+    return 1;
+  }
+  if (plain->text != "camA" || plain->text.data() < text.data() ||
+      plain->text.data() >= text.data() + text.size()) {
+    std::cerr << "FAIL: strict_json unescaped string should be a view into the input\n";
+    return 1;
+  }
+  if (escaped->text != "a\tb\xC3\xA9" || number->type != strict_json::Value::Type::Number ||
+      number->text != "-12.5e3") {
+    std::cerr << "FAIL: strict_json escape decoding or number lexeme mismatch\n";
+    return 1;
+  }
+  if (list->items().size() != 3 || list->items()[1].items().size() != 1 ||
+      list->items()[1].items()[0].text != "2" || list->items()[2].type != strict_json::Value::Type::Object ||
+      !list->items()[2].items().empty()) {
+    std::cerr << "FAIL: strict_json nested containers mismatch\n";
+    return 1;
+  }
+
+  // Duplicate detection past the linear-scan member count.
+  std::string wide = "{";
+  for (int i = 0; i < 40; ++i) {
+    wide += "\"k" + std::to_string(i) + "\":" + std::to_string(i) + ",";
+  }
+  wide += "\"k3\":0}";
+  if (doc.parse(wide, strict_json::ParseOptions{}, &error) || error != "duplicate object key: k3") {
+    std::cerr << "FAIL: strict_json accepted duplicate key in wide object\n";
+    return 1;
+  }
+
+  strict_json::ParseOptions v1{};
+  v1.integers_only = true;
+  v1.ascii_unicode_escapes_only = true;
+  if (doc.parse("[1.5]", v1, &error) || doc.parse("[\"\\u00e9\"]", v1, &error) ||
+      !doc.parse("[-7]", v1, &error) || doc.root().items()[0].integer_value != -7) {
+    std::cerr << "FAIL: strict_json v1 integer/ascii dialect mismatch\n";
+    return 1;
+  }
+
+  // Payload views are read in place.
+  const std::string payload_json =
+      "{\"schema_version\":1,\"cameras\":[{\"camera_id\":\"cam\\u0041\"},{\"camera_id\":\"camB\"}],"
+      "\"concurrent_camera_support\":{\"supported\":true,\"camera_id_combinations\":[[\"camB\",\"camA\"]]}}";
+  const auto loaded = camera_concurrency::load_truth_from_adc_json_payload(
+      SpecPatchView{payload_json.data(), payload_json.size()});
+  if (!loaded.ok || loaded.truth.allowed_camera_id_combinations.size() != 1 ||
+      loaded.truth.allowed_camera_id_combinations[0] != std::vector<std::string>{"camA", "camB"}) {
+    std::cerr << "FAIL: camera concurrency payload ingest mismatch: " << loaded.error_message << "\n";
+    return 1;
+  }
+  return 0;
+}
+
 
 class RefusingDeviceProvider final : public ICameraProvider {
 public:
@@ -1664,6 +1920,9 @@ static StreamRequest make_req() {
 }
 
 
+#if !CAMBANG_PROVIDER_BOUND
+// Standalone ingresses take std::function hooks, which a provider-bound
+// build replaces with CoreRuntime (imaging/api/provider_binding.h).
 static int test_provider_callback_ingress_null_core_thread_drop_accounting() {
   ProviderCallbackIngress ingress(
       nullptr,
@@ -1800,151 +2059,1082 @@ static int test_provider_callback_ingress_null_sink_frame_release_balances_telem
   return 0;
 }
 
-static int test_resource_aggregate_clear_preserves_outstanding_backing() {
-  constexpr uint64_t kOutstandingBackingStreamId = 434343;
-  ResourceAggregateTelemetry& telemetry = global_resource_aggregate_telemetry();
-  const ScopedResourceTelemetryKey key =
-      make_stream_scoped_resource_telemetry(kOutstandingBackingStreamId);
-
-  telemetry.clear();
-  telemetry.retained_gpu_backing_created(key);
-  telemetry.clear();
-
-  auto find_bucket = [&telemetry]() -> std::optional<ScopedResourceTelemetryKey> {
-    for (const auto& bucket : telemetry.snapshot()) {
-      if (bucket.telemetry_scope == TelemetryScope::STREAM &&
-          bucket.stream_id == kOutstandingBackingStreamId) {
-        return bucket;
-      }
-    }
-    return std::nullopt;
-  };
+static int test_provider_callback_ingress_latest_wins_supersedes_oldest_frames() {
+  struct TelemetryClearGuard {
+    TelemetryClearGuard() { global_resource_aggregate_telemetry().clear(); }
+    ~TelemetryClearGuard() { global_resource_aggregate_telemetry().clear(); }
+  } telemetry_clear_guard;
 
-  const auto outstanding = find_bucket();
-  if (!outstanding || outstanding->retained_gpu_backing_current != 1 ||
-      outstanding->retained_gpu_backing_total_created != 1 ||
-      outstanding->retained_gpu_backing_total_released != 0) {
-    std::cerr << "Expected telemetry clear to preserve an outstanding retained GPU backing\n";
+  struct NoopHooks final : CoreThread::IHooks {} hooks;
+  CoreThread core;
+  if (!core.start(&hooks)) {
+    std::cerr << "Failed to start CoreThread for latest-wins ProviderCallbackIngress check\n";
     return 1;
   }
 
-  telemetry.retained_gpu_backing_released(key);
-  const auto balanced = find_bucket();
-  if (!balanced || balanced->retained_gpu_backing_current != 0 ||
-      balanced->retained_gpu_backing_total_created != 1 ||
-      balanced->retained_gpu_backing_total_released != 1) {
-    std::cerr << "Expected late retained GPU backing release to balance preserved telemetry\n";
-    return 1;
-  }
+  std::vector<uint32_t> delivered_widths;
+  std::atomic<uint64_t> release_calls{0};
+  ProviderCallbackIngress ingress(
+      &core,
+      [&delivered_widths](ProviderToCoreCommand&& cmd) {
+        auto& p = std::get<CmdProviderFrame>(cmd.payload);
+        delivered_widths.push_back(p.frame.width);
+        p.frame.release_now();
+      },
+      []() -> uint64_t { return 0; },
+      [](uint64_t) { return false; });
+  ingress.set_latest_wins_frames_per_stream(2);
 
-  telemetry.clear();
-  if (find_bucket()) {
-    std::cerr << "Expected telemetry clear to retire the balanced retained GPU backing bucket\n";
+  // Hold the core thread so every frame stays queued behind the gate.
+  auto release_gate = std::make_shared<std::promise<void>>();
+  std::shared_future<void> release_gate_done(release_gate->get_future());
+  std::atomic<bool> gate_started{false};
+  if (core.try_post([release_gate_done, &gate_started]() mutable {
+        gate_started.store(true, std::memory_order_release);
+        release_gate_done.wait();
+      }) != CoreThread::PostResult::Enqueued) {
+    core.stop();
+    std::cerr << "Failed to post latest-wins ingress gate\n";
     return 1;
   }
-  return 0;
-}
+  while (!gate_started.load(std::memory_order_acquire)) {
+    std::this_thread::yield();
+  }
 
+  constexpr uint64_t kLatestWinsStreamId = 525252;
+  uint8_t pixel[4] = {0, 0, 0, 0};
+  for (uint32_t i = 1; i <= 5; ++i) {
+    FrameView frame{};
+    frame.device_instance_id = kDeviceInstanceId;
+    frame.stream_id = kLatestWinsStreamId;
+    frame.acquisition_session_id = 79;
+    frame.width = i;
+    frame.height = 1;
+    frame.format_fourcc = FOURCC_RGBA;
+    frame.data = pixel;
+    frame.size_bytes = sizeof(pixel);
+    frame.stride_bytes = 4;
+    frame.release = [](void* user, const FrameView*) {
+      auto* count = static_cast<std::atomic<uint64_t>*>(user);
+      count->fetch_add(1, std::memory_order_relaxed);
+    };
+    frame.release_user = &release_calls;
+    ingress.on_frame(frame);
+  }
 
-static int test_provider_open_close_refusal_visibility() {
-  CoreRuntime rt;
-  StateSnapshotBuffer buf;
-  RefusingDeviceProvider provider;
-  rt.set_snapshot_publisher(&buf);
+  const auto queued_stats = ingress.stats_copy();
+  const uint32_t queued_depth = ingress.ingress_depth_for_stream(kLatestWinsStreamId);
+  const uint64_t superseded_releases = release_calls.load(std::memory_order_relaxed);
 
-  if (!rt.start()) {
-    std::cerr << "FAIL: failed to start runtime for provider refusal smoke\n";
-    return 1;
-  }
-  if (!wait_until([&]() { return rt.state_copy() == CoreRuntimeState::LIVE; }, 200, 1)) {
-    std::cerr << "FAIL: runtime did not become LIVE for provider refusal smoke\n";
-    rt.stop();
+  release_gate->set_value();
+  auto barrier = std::make_shared<std::promise<void>>();
+  auto barrier_done = barrier->get_future();
+  const auto barrier_post = core.try_post([barrier]() mutable { barrier->set_value(); });
+  if (barrier_post != CoreThread::PostResult::Enqueued ||
+      barrier_done.wait_for(std::chrono::seconds(2)) != std::future_status::ready) {
+    core.stop();
+    std::cerr << "Failed to drain latest-wins ProviderCallbackIngress frame tokens\n";
     return 1;
   }
-  if (!provider.initialize(rt.provider_callbacks()).ok()) {
-    std::cerr << "FAIL: refusing provider initialize failed\n";
-    rt.stop();
+  core.stop();
+
+  const std::vector<uint32_t> expected_widths{4, 5};
+  if (queued_stats.frames_coalesced_latest_wins != 3 ||
+      queued_stats.frames_dropped_full != 0 ||
+      queued_depth != 2 ||
+      superseded_releases != 3 ||
+      delivered_widths != expected_widths ||
+      release_calls.load(std::memory_order_relaxed) != 5 ||
+      ingress.ingress_depth_for_stream(kLatestWinsStreamId) != 0) {
+    std::cerr << "Expected latest-wins ingress to supersede the three oldest frames and deliver the newest two."
+              << " coalesced=" << queued_stats.frames_coalesced_latest_wins
+              << " dropped_full=" << queued_stats.frames_dropped_full
+              << " queued_depth=" << queued_depth
+              << " superseded_releases=" << superseded_releases
+              << " delivered=" << delivered_widths.size()
+              << " release_calls=" << release_calls.load(std::memory_order_relaxed) << "\n";
     return 1;
   }
-  rt.attach_provider(&provider);
 
-  if (!wait_for_snapshot_gen(buf, 0)) {
-    std::cerr << "FAIL: baseline snapshot not published before provider refusal smoke\n";
-    rt.stop();
+  return 0;
+}
+
+// Native-object counter updates coalesce latest-per-object into one command
+// per batch, and an update reported after an object's create is never
+// integrated ahead of it.
+static int test_provider_callback_ingress_coalesces_native_object_counters() {
+  struct NoopHooks final : CoreThread::IHooks {} hooks;
+  CoreThread core;
+  if (!core.start(&hooks)) {
+    std::cerr << "Failed to start CoreThread for native-object counter coalescing check\n";
     return 1;
   }
 
-  const TryOpenDeviceStatus open_status = rt.try_open_device("refusing:0", kDeviceInstanceId, kRootId);
-  if (open_status != TryOpenDeviceStatus::ProviderRejected) {
-    std::cerr << "FAIL: provider-refused open returned status=" << static_cast<int>(open_status)
-              << " expected ProviderRejected\n";
-    rt.stop();
+  CoreNativeObjectRegistry registry;
+  std::vector<std::string> log;
+  ProviderCallbackIngress ingress(
+      &core,
+      [&registry, &log](ProviderToCoreCommand&& cmd) {
+        if (cmd.type == ProviderToCoreCommandType::PROVIDER_NATIVE_OBJECT_CREATED) {
+          const auto& p = std::get<CmdProviderNativeObjectCreated>(cmd.payload);
+          registry.on_native_object_created(p.native_id, p.type, 0, 0, 0, 0, 0, 0,
+                                            p.bytes_allocated, p.buffers_in_use, 1, 0);
+          log.push_back("created:" + std::to_string(p.native_id));
+          return;
+        }
+        if (cmd.type != ProviderToCoreCommandType::PROVIDER_NATIVE_OBJECT_COUNTERS) {
+          log.push_back("unexpected");
+          return;
+        }
+        auto updates = std::get<CmdProviderNativeObjectCounters>(cmd.payload).updates;
+        std::sort(updates.begin(), updates.end(), [](const auto& a, const auto& b) {
+          return a.native_id < b.native_id;
+        });
+        std::string line = "counters";
+        for (const NativeObjectCountersUpdate& u : updates) {
+          line += ":" + std::to_string(u.native_id) + "=" + std::to_string(u.buffers_in_use);
+          (void)registry.on_native_object_counters(u.native_id, u.bytes_allocated, u.buffers_in_use);
+        }
+        log.push_back(line);
+      },
+      []() -> uint64_t { return 0; },
+      [](uint64_t) { return false; });
+
+  auto release_gate = std::make_shared<std::promise<void>>();
+  std::shared_future<void> release_gate_done(release_gate->get_future());
+  std::atomic<bool> gate_started{false};
+  if (core.try_post([release_gate_done, &gate_started]() mutable {
+        gate_started.store(true, std::memory_order_release);
+        release_gate_done.wait();
+      }) != CoreThread::PostResult::Enqueued) {
+    core.stop();
+    std::cerr << "Failed to post native-object counter gate\n";
     return 1;
   }
-  if (provider.open_called() != 1) {
-    std::cerr << "FAIL: provider open call count=" << provider.open_called() << " expected 1\n";
-    rt.stop();
-    return 1;
+  while (!gate_started.load(std::memory_order_acquire)) {
+    std::this_thread::yield();
   }
 
-  const auto retain_spec = rt.retain_imaging_spec_version(7001);
-  if (retain_spec != CoreThread::PostResult::Enqueued) {
-    std::cerr << "FAIL: retain_imaging_spec_version admission failed after refused open; result="
-              << static_cast<int>(retain_spec) << "\n";
-    rt.stop();
-    return 1;
-  }
-  if (!wait_for_snapshot_pred(buf, [](const CamBANGStateSnapshot& s) {
-        return s.version >= 1 && s.devices.empty();
-      })) {
-    auto snap = buf.snapshot_copy();
-    std::cerr << "FAIL: provider-refused open left stale device truth; device_count="
-              << (snap ? snap->devices.size() : 0) << "\n";
-    rt.stop();
+  constexpr uint64_t kPoolA = 901;
+  constexpr uint64_t kPoolB = 902;
+  const auto create = [&ingress](uint64_t native_id, uint32_t buffers) {
+    NativeObjectCreateInfo info{};
+    info.native_id = native_id;
+    info.type = static_cast<uint32_t>(NativeObjectType::FrameBufferLease);
+    info.buffers_in_use = buffers;
+    info.bytes_allocated = uint64_t{buffers} * 1000;
+    ingress.on_native_object_created(info);
+  };
+  const auto resize = [&ingress](uint64_t native_id, uint32_t buffers) {
+    ingress.on_native_object_counters(NativeObjectCountersUpdate{native_id, uint64_t{buffers} * 1000, buffers});
+  };
+  create(kPoolA, 2);
+  resize(kPoolA, 3);
+  resize(kPoolA, 4);
+  resize(kPoolA, 5);
+  create(kPoolB, 1);
+  resize(kPoolB, 2);
+  resize(kPoolA, 6);
+  const uint64_t coalesced = ingress.stats_copy().native_object_counters_coalesced;
+
+  release_gate->set_value();
+  auto barrier = std::make_shared<std::promise<void>>();
+  auto barrier_done = barrier->get_future();
+  const auto barrier_post = core.try_post_essential([barrier]() mutable { barrier->set_value(); });
+  if (barrier_post != CoreThread::PostResult::Enqueued ||
+      barrier_done.wait_for(std::chrono::seconds(2)) != std::future_status::ready) {
+    core.stop();
+    std::cerr << "Failed to drain native-object counter tokens\n";
     return 1;
   }
+  core.stop();
 
-  const TryCloseDeviceStatus close_status = rt.try_close_device(kDeviceInstanceId);
-  if (close_status != TryCloseDeviceStatus::ProviderRejected) {
-    std::cerr << "FAIL: provider-refused close returned status=" << static_cast<int>(close_status)
-              << " expected ProviderRejected\n";
-    rt.stop();
+  // The first batch's only object moved to the second batch (opened after
+  // B's create), so the first token carries nothing.
+  const std::vector<std::string> expected{"created:901", "created:902", "counters:901=6:902=2"};
+  const CoreNativeObjectRegistry::Record* a = registry.find(kPoolA);
+  const CoreNativeObjectRegistry::Record* b = registry.find(kPoolB);
+  if (log != expected || coalesced != 3 || !a || !b ||
+      a->buffers_in_use != 6 || a->bytes_allocated != 6000 ||
+      b->buffers_in_use != 2 || b->bytes_allocated != 2000) {
+    std::cerr << "Expected one coalesced counters batch after both creates. log=";
+    for (const std::string& line : log) {
+      std::cerr << line << " ";
+    }
+    std::cerr << "coalesced=" << coalesced << "\n";
     return 1;
   }
-  if (provider.close_called() != 1) {
-    std::cerr << "FAIL: provider close call count=" << provider.close_called() << " expected 1\n";
-    rt.stop();
+
+  // Counters never resurrect or create records, and an unchanged update is
+  // not a registry change.
+  const uint64_t revision = registry.revision();
+  registry.on_native_object_destroyed(kPoolB, 1, 1);
+  if (registry.on_native_object_counters(kPoolA, 6000, 6) ||
+      registry.on_native_object_counters(kPoolB, 9000, 9) ||
+      registry.on_native_object_counters(903, 1000, 1) ||
+      registry.find(903) != nullptr ||
+      registry.find(kPoolB)->buffers_in_use != 2 ||
+      registry.revision() == revision) {
+    std::cerr << "Expected counters to apply only to live created native objects\n";
     return 1;
   }
-
-  rt.stop();
-  (void)provider.shutdown();
   return 0;
 }
 
-static int test_provider_command_refusal_and_timeout_truth() {
-  CoreRuntime rt;
-  RefusingDeviceProvider provider;
-
-  if (!rt.start() ||
-      !wait_until([&]() { return rt.state_copy() == CoreRuntimeState::LIVE; }, 200, 1) ||
-      !provider.initialize(rt.provider_callbacks()).ok()) {
-    std::cerr << "FAIL: provider command refusal setup failed\n";
-    rt.stop();
+// Depth slots are reclaimed once a destroyed stream's queued frames drain,
+// so more streams than ProviderCallbackIngress::kStreamDepthSlots come and go
+// without losing count.
+static int test_provider_callback_ingress_stream_depth_slots_are_reclaimed() {
+  struct NoopHooks final : CoreThread::IHooks {} hooks;
+  CoreThread core;
+  if (!core.start(&hooks)) {
+    std::cerr << "Failed to start CoreThread for ingress depth slot check\n";
     return 1;
   }
-  rt.attach_provider(&provider);
 
-  const TryCreateStreamStatus create_status = rt.try_create_stream(
-      kStreamId, kDeviceInstanceId, StreamIntent::PREVIEW, nullptr, nullptr, 1);
-  if (create_status != TryCreateStreamStatus::ProviderRejected ||
-      provider.create_stream_called() != 1) {
-    std::cerr << "FAIL: provider-refused create returned status="
-              << static_cast<int>(create_status)
-              << " create_calls=" << provider.create_stream_called()
-              << " expected ProviderRejected/1\n";
-    rt.stop();
-    (void)provider.shutdown();
+  std::atomic<uint64_t> release_calls{0};
+  ProviderCallbackIngress ingress(
+      &core,
+      [](ProviderToCoreCommand&& cmd) {
+        if (cmd.type == ProviderToCoreCommandType::PROVIDER_FRAME) {
+          std::get<CmdProviderFrame>(cmd.payload).frame.release_now();
+        }
+      },
+      []() -> uint64_t { return 0; },
+      [](uint64_t) { return false; });
+
+  constexpr uint64_t kStreamsPerRound = 200;
+  constexpr uint64_t kRounds = 3;
+  static_assert(kStreamsPerRound * kRounds > ProviderCallbackIngress::kStreamDepthSlots);
+  uint8_t pixel[4] = {0, 0, 0, 0};
+  for (uint64_t round = 0; round < kRounds; ++round) {
+    // Hold the core thread so every stream's frame stays queued past its destroy.
+    auto release_gate = std::make_shared<std::promise<void>>();
+    std::shared_future<void> release_gate_done(release_gate->get_future());
+    std::atomic<bool> gate_started{false};
+    if (core.try_post([release_gate_done, &gate_started]() mutable {
+          gate_started.store(true, std::memory_order_release);
+          release_gate_done.wait();
+        }) != CoreThread::PostResult::Enqueued) {
+      core.stop();
+      std::cerr << "Failed to post ingress depth slot gate\n";
+      return 1;
+    }
+    while (!gate_started.load(std::memory_order_acquire)) {
+      std::this_thread::yield();
+    }
+
+    const uint64_t first_stream_id = 600000 + round * kStreamsPerRound;
+    for (uint64_t stream_id = first_stream_id; stream_id < first_stream_id + kStreamsPerRound; ++stream_id) {
+      ingress.on_stream_created(stream_id);
+      FrameView frame{};
+      frame.device_instance_id = kDeviceInstanceId;
+      frame.stream_id = stream_id;
+      frame.width = 1;
+      frame.height = 1;
+      frame.format_fourcc = FOURCC_RGBA;
+      frame.data = pixel;
+      frame.size_bytes = sizeof(pixel);
+      frame.stride_bytes = 4;
+      frame.release = [](void* user, const FrameView*) {
+        static_cast<std::atomic<uint64_t>*>(user)->fetch_add(1, std::memory_order_relaxed);
+      };
+      frame.release_user = &release_calls;
+      ingress.on_frame(frame);
+      ingress.on_stream_destroyed(stream_id);
+    }
+    bool all_counted = true;
+    for (uint64_t stream_id = first_stream_id; stream_id < first_stream_id + kStreamsPerRound; ++stream_id) {
+      all_counted = all_counted && ingress.ingress_depth_for_stream(stream_id) == 1;
+    }
+
+    release_gate->set_value();
+    auto barrier = std::make_shared<std::promise<void>>();
+    auto barrier_done = barrier->get_future();
+    if (core.try_post([barrier]() mutable { barrier->set_value(); }) != CoreThread::PostResult::Enqueued ||
+        barrier_done.wait_for(std::chrono::seconds(2)) != std::future_status::ready) {
+      core.stop();
+      std::cerr << "Failed to drain ingress depth slot frames\n";
+      return 1;
+    }
+    bool all_drained = true;
+    for (uint64_t stream_id = first_stream_id; stream_id < first_stream_id + kStreamsPerRound; ++stream_id) {
+      all_drained = all_drained && ingress.ingress_depth_for_stream(stream_id) == 0;
+    }
+    if (!all_counted || !all_drained) {
+      core.stop();
+      std::cerr << "Expected every stream's queued frame to be counted until dispatched. round=" << round
+                << " counted=" << all_counted << " drained=" << all_drained << "\n";
+      return 1;
+    }
+  }
+  core.stop();
+
+  if (release_calls.load(std::memory_order_relaxed) != kStreamsPerRound * kRounds ||
+      ingress.stats_copy().frames_dropped_fair_share != 0) {
+    std::cerr << "Expected every ingress depth slot frame to be delivered and released once. release_calls="
+              << release_calls.load(std::memory_order_relaxed) << "\n";
+    return 1;
+  }
+  return 0;
+}
+#endif
+
+static int test_core_thread_batched_ordinary_drain_yields_to_command_lane() {
+  struct NoopHooks final : CoreThread::IHooks {} hooks;
+  CoreThread core;
+  core.set_ordinary_tasks_per_turn(8);
+  if (!core.start(&hooks)) {
+    std::cerr << "Failed to start CoreThread for batched ordinary drain check\n";
+    return 1;
+  }
+
+  auto release_gate = std::make_shared<std::promise<void>>();
+  std::shared_future<void> release_gate_done(release_gate->get_future());
+  std::atomic<bool> gate_started{false};
+  if (core.try_post([release_gate_done, &gate_started]() mutable {
+        gate_started.store(true, std::memory_order_release);
+        release_gate_done.wait();
+      }) != CoreThread::PostResult::Enqueued) {
+    core.stop();
+    std::cerr << "Failed to post batched ordinary drain gate\n";
+    return 1;
+  }
+  while (!gate_started.load(std::memory_order_acquire)) {
+    std::this_thread::yield();
+  }
+
+  // Core-thread-only once the gate releases.
+  std::vector<int> order;
+  bool posted_all = core.try_post([&core, &order]() {
+    order.push_back(1);
+    if (core.try_post_command([&order]() { order.push_back(100); }) !=
+        CoreThread::PostResult::Enqueued) {
+      order.push_back(-1);
+    }
+  }) == CoreThread::PostResult::Enqueued;
+  for (int i = 2; i <= 4; ++i) {
+    posted_all = posted_all &&
+        core.try_post([&order, i]() { order.push_back(i); }) == CoreThread::PostResult::Enqueued;
+  }
+
+  release_gate->set_value();
+  auto barrier = std::make_shared<std::promise<void>>();
+  auto barrier_done = barrier->get_future();
+  const auto barrier_post = core.try_post([barrier]() mutable { barrier->set_value(); });
+  const bool drained = barrier_post == CoreThread::PostResult::Enqueued &&
+      barrier_done.wait_for(std::chrono::seconds(2)) == std::future_status::ready;
+  core.stop();
+
+  // The command posted from inside the batch must run before the next
+  // ordinary task, exactly as with single-task ordinary slices.
+  const std::vector<int> expected{1, 100, 2, 3, 4};
+  if (!posted_all || !drained || order != expected) {
+    std::cerr << "Expected batched ordinary drain to yield to command-lane work. posted_all=" << posted_all
+              << " drained=" << drained << " order=";
+    for (int v : order) {
+      std::cerr << v << ",";
+    }
+    std::cerr << "\n";
+    return 1;
+  }
+
+  return 0;
+}
+
+#if !CAMBANG_PROVIDER_BOUND
+// Standalone ingresses take std::function hooks, which a provider-bound
+// build replaces with CoreRuntime (imaging/api/provider_binding.h).
+static int test_core_thread_lane_capacities_and_ingress_congestion() {
+  struct TelemetryClearGuard {
+    TelemetryClearGuard() { global_resource_aggregate_telemetry().clear(); }
+    ~TelemetryClearGuard() { global_resource_aggregate_telemetry().clear(); }
+  } telemetry_clear_guard;
+
+  struct NoopHooks final : CoreThread::IHooks {} hooks;
+  CoreThread core;
+  if (!core.set_lane_capacities(8, 2) || core.ordinary_lane_capacity() != 8 || core.command_lane_capacity() != 2) {
+    std::cerr << "Expected pre-start lane capacities to apply\n";
+    return 1;
+  }
+  if (!core.start(&hooks)) {
+    std::cerr << "Failed to start CoreThread for lane capacity check\n";
+    return 1;
+  }
+  const bool resized_while_running = core.set_lane_capacities(16, 16);
+
+  std::atomic<uint32_t> frames_delivered{0};
+  ProviderCallbackIngress ingress(
+      &core,
+      [&frames_delivered](ProviderToCoreCommand&& cmd) {
+        std::get<CmdProviderFrame>(cmd.payload).frame.release_now();
+        frames_delivered.fetch_add(1, std::memory_order_relaxed);
+      },
+      []() -> uint64_t { return 0; },
+      [](uint64_t) { return false; });
+  ingress.set_latest_wins_frames_per_stream(2);
+
+  auto release_gate = std::make_shared<std::promise<void>>();
+  std::shared_future<void> release_gate_done(release_gate->get_future());
+  std::atomic<bool> gate_started{false};
+  if (core.try_post([release_gate_done, &gate_started]() mutable {
+        gate_started.store(true, std::memory_order_release);
+        release_gate_done.wait();
+      }) != CoreThread::PostResult::Enqueued) {
+    core.stop();
+    std::cerr << "Failed to post lane capacity gate\n";
+    return 1;
+  }
+  while (!gate_started.load(std::memory_order_acquire)) {
+    std::this_thread::yield();
+  }
+
+  // Stream A reaches its latest-wins limit; stream B is unaffected until the
+  // ordinary lane itself fills.
+  constexpr uint64_t kCongestedStreamId = 626262;
+  constexpr uint64_t kOtherStreamId = 626263;
+  uint8_t pixel[4] = {0, 0, 0, 0};
+  for (uint32_t i = 0; i < 2; ++i) {
+    FrameView frame{};
+    frame.device_instance_id = kDeviceInstanceId;
+    frame.stream_id = kCongestedStreamId;
+    frame.width = 1;
+    frame.height = 1;
+    frame.format_fourcc = FOURCC_RGBA;
+    frame.data = pixel;
+    frame.size_bytes = sizeof(pixel);
+    frame.stride_bytes = 4;
+    ingress.on_frame(frame);
+  }
+  const bool a_congested_at_limit = ingress.is_stream_ingress_congested(kCongestedStreamId);
+  const bool b_congested_at_limit = ingress.is_stream_ingress_congested(kOtherStreamId);
+
+  std::atomic<uint32_t> fillers_ran{0};
+  size_t fillers_posted = 0;
+  while (core.try_post([&fillers_ran]() { fillers_ran.fetch_add(1, std::memory_order_relaxed); }) ==
+         CoreThread::PostResult::Enqueued) {
+    ++fillers_posted;
+  }
+  const bool b_congested_when_full = ingress.is_stream_ingress_congested(kOtherStreamId);
+
+  // The command lane has its own bound: a full ordinary lane does not reject it.
+  std::atomic<uint32_t> commands_ran{0};
+  const auto command_task = [&commands_ran]() { commands_ran.fetch_add(1, std::memory_order_relaxed); };
+  const bool commands_admitted = core.try_post_command(command_task) == CoreThread::PostResult::Enqueued &&
+                                 core.try_post_command(command_task) == CoreThread::PostResult::Enqueued;
+  const bool command_lane_full = core.try_post_command(command_task) == CoreThread::PostResult::QueueFull;
+
+  release_gate->set_value();
+  const bool drained = wait_until([&]() {
+    return frames_delivered.load(std::memory_order_relaxed) == 2 &&
+           fillers_ran.load(std::memory_order_relaxed) == fillers_posted &&
+           commands_ran.load(std::memory_order_relaxed) == 2;
+  });
+  const bool a_congested_after_drain = ingress.is_stream_ingress_congested(kCongestedStreamId);
+  const bool b_congested_after_drain = ingress.is_stream_ingress_congested(kOtherStreamId);
+  core.stop();
+
+  if (resized_while_running || !a_congested_at_limit || b_congested_at_limit || fillers_posted != 6 ||
+      !b_congested_when_full || !commands_admitted || !command_lane_full || !drained ||
+      a_congested_after_drain || b_congested_after_drain) {
+    std::cerr << "Expected per-lane capacities and ingress congestion signalling. resized_while_running="
+              << resized_while_running << " a_at_limit=" << a_congested_at_limit
+              << " b_at_limit=" << b_congested_at_limit << " fillers_posted=" << fillers_posted
+              << " b_when_full=" << b_congested_when_full << " commands_admitted=" << commands_admitted
+              << " command_lane_full=" << command_lane_full << " drained=" << drained
+              << " a_after_drain=" << a_congested_after_drain << " b_after_drain=" << b_congested_after_drain
+              << "\n";
+    return 1;
+  }
+
+  return 0;
+}
+
+static int test_ingress_fair_share_frame_admission() {
+  struct TelemetryClearGuard {
+    TelemetryClearGuard() { global_resource_aggregate_telemetry().clear(); }
+    ~TelemetryClearGuard() { global_resource_aggregate_telemetry().clear(); }
+  } telemetry_clear_guard;
+
+  struct NoopHooks final : CoreThread::IHooks {} hooks;
+  CoreThread core;
+  // 16 ordinary slots: fair-share admission engages at 12 pending.
+  if (!core.set_lane_capacities(16, 0) || !core.start(&hooks)) {
+    std::cerr << "Failed to start CoreThread for fair-share admission check\n";
+    return 1;
+  }
+
+  constexpr uint64_t kChattyStreamId = 636363;
+  constexpr uint64_t kQuietStreamId = 636364;
+  std::mutex delivered_mu;
+  std::map<uint64_t, uint32_t> delivered;
+  ProviderCallbackIngress ingress(
+      &core,
+      [&](ProviderToCoreCommand&& cmd) {
+        auto& frame = std::get<CmdProviderFrame>(cmd.payload).frame;
+        frame.release_now();
+        std::lock_guard<std::mutex> lock(delivered_mu);
+        ++delivered[frame.stream_id];
+      },
+      []() -> uint64_t { return 0; },
+      [](uint64_t) { return false; });
+
+  auto release_gate = std::make_shared<std::promise<void>>();
+  std::shared_future<void> release_gate_done(release_gate->get_future());
+  std::atomic<bool> gate_started{false};
+  if (core.try_post([release_gate_done, &gate_started]() mutable {
+        gate_started.store(true, std::memory_order_release);
+        release_gate_done.wait();
+      }) != CoreThread::PostResult::Enqueued) {
+    core.stop();
+    std::cerr << "Failed to post fair-share admission gate\n";
+    return 1;
+  }
+  while (!gate_started.load(std::memory_order_acquire)) {
+    std::this_thread::yield();
+  }
+
+  std::atomic<uint32_t> released{0};
+  uint8_t pixel[4] = {0, 0, 0, 0};
+  const auto send = [&](uint64_t stream_id, uint32_t count) {
+    for (uint32_t i = 0; i < count; ++i) {
+      FrameView frame{};
+      frame.device_instance_id = kDeviceInstanceId;
+      frame.stream_id = stream_id;
+      frame.width = 1;
+      frame.height = 1;
+      frame.format_fourcc = FOURCC_RGBA;
+      frame.data = pixel;
+      frame.size_bytes = sizeof(pixel);
+      frame.stride_bytes = 4;
+      frame.release = [](void* user, const FrameView*) {
+        static_cast<std::atomic<uint32_t>*>(user)->fetch_add(1, std::memory_order_relaxed);
+      };
+      frame.release_user = &released;
+      ingress.on_frame(frame);
+    }
+  };
+  // With a quiet frame queued, the chatty stream is held at its share of 6
+  // once the lane reaches the threshold (11 queued by then); the quiet
+  // stream still gets in, and the chatty one stays shut out.
+  send(kQuietStreamId, 1);
+  send(kChattyStreamId, 20);
+  send(kQuietStreamId, 2);
+  send(kChattyStreamId, 5);
+  const ProviderCallbackIngress::Stats queued = ingress.stats_copy();
+
+  release_gate->set_value();
+  const bool drained = wait_until([&]() { return released.load(std::memory_order_relaxed) == 28; });
+  core.stop();
+  std::lock_guard<std::mutex> lock(delivered_mu);
+  if (!drained || queued.frames_dropped_fair_share != 14 || queued.frames_dropped_full != 0 ||
+      delivered[kChattyStreamId] != 11 || delivered[kQuietStreamId] != 3) {
+    std::cerr << "Expected fair-share ingress admission. drained=" << drained
+              << " fair_share_dropped=" << queued.frames_dropped_fair_share
+              << " dropped_full=" << queued.frames_dropped_full
+              << " chatty_delivered=" << delivered[kChattyStreamId]
+              << " quiet_delivered=" << delivered[kQuietStreamId] << "\n";
+    return 1;
+  }
+  return 0;
+}
+
+static int test_ingress_lone_stream_fills_ordinary_lane() {
+  struct TelemetryClearGuard {
+    TelemetryClearGuard() { global_resource_aggregate_telemetry().clear(); }
+    ~TelemetryClearGuard() { global_resource_aggregate_telemetry().clear(); }
+  } telemetry_clear_guard;
+
+  struct NoopHooks final : CoreThread::IHooks {} hooks;
+  CoreThread core;
+  if (!core.set_lane_capacities(16, 0) || !core.start(&hooks)) {
+    std::cerr << "Failed to start CoreThread for lone-stream admission check\n";
+    return 1;
+  }
+
+  constexpr uint64_t kFloodStreamId = 646464;
+  std::atomic<uint32_t> delivered{0};
+  ProviderCallbackIngress ingress(
+      &core,
+      [&](ProviderToCoreCommand&& cmd) {
+        std::get<CmdProviderFrame>(cmd.payload).frame.release_now();
+        delivered.fetch_add(1, std::memory_order_relaxed);
+      },
+      []() -> uint64_t { return 0; },
+      [](uint64_t) { return false; });
+
+  auto release_gate = std::make_shared<std::promise<void>>();
+  std::shared_future<void> release_gate_done(release_gate->get_future());
+  std::atomic<bool> gate_started{false};
+  if (core.try_post([release_gate_done, &gate_started]() mutable {
+        gate_started.store(true, std::memory_order_release);
+        release_gate_done.wait();
+      }) != CoreThread::PostResult::Enqueued) {
+    core.stop();
+    std::cerr << "Failed to post lone-stream admission gate\n";
+    return 1;
+  }
+  while (!gate_started.load(std::memory_order_acquire)) {
+    std::this_thread::yield();
+  }
+
+  // With no other stream queued there is no share to hold the flooder to:
+  // it fills the whole lane and only QueueFull drops it.
+  std::atomic<uint32_t> released{0};
+  uint8_t pixel[4] = {0, 0, 0, 0};
+  for (uint32_t i = 0; i < 20; ++i) {
+    FrameView frame{};
+    frame.device_instance_id = kDeviceInstanceId;
+    frame.stream_id = kFloodStreamId;
+    frame.width = 1;
+    frame.height = 1;
+    frame.format_fourcc = FOURCC_RGBA;
+    frame.data = pixel;
+    frame.size_bytes = sizeof(pixel);
+    frame.stride_bytes = 4;
+    frame.release = [](void* user, const FrameView*) {
+      static_cast<std::atomic<uint32_t>*>(user)->fetch_add(1, std::memory_order_relaxed);
+    };
+    frame.release_user = &released;
+    ingress.on_frame(frame);
+  }
+  const size_t pending = core.ordinary_lane_pending();
+  const ProviderCallbackIngress::Stats queued = ingress.stats_copy();
+
+  release_gate->set_value();
+  const bool drained = wait_until([&]() { return released.load(std::memory_order_relaxed) == 20; });
+  core.stop();
+  if (!drained || pending != core.ordinary_lane_capacity() || queued.frames_dropped_fair_share != 0 ||
+      queued.frames_dropped_full != 4 || delivered.load(std::memory_order_relaxed) != 16) {
+    std::cerr << "Expected a lone stream to fill the ordinary lane. drained=" << drained
+              << " pending=" << pending
+              << " fair_share_dropped=" << queued.frames_dropped_fair_share
+              << " dropped_full=" << queued.frames_dropped_full
+              << " delivered=" << delivered.load(std::memory_order_relaxed) << "\n";
+    return 1;
+  }
+  return 0;
+}
+
+static int test_ingress_stream_priority_frame_admission() {
+  struct TelemetryClearGuard {
+    TelemetryClearGuard() { global_resource_aggregate_telemetry().clear(); }
+    ~TelemetryClearGuard() { global_resource_aggregate_telemetry().clear(); }
+  } telemetry_clear_guard;
+
+  struct NoopHooks final : CoreThread::IHooks {} hooks;
+  CoreThread core;
+  // 16 ordinary slots: LOW streams are limited from 8 pending, NORMAL from
+  // 12, HIGH only by the lane itself.
+  if (!core.set_lane_capacities(16, 0) || !core.start(&hooks)) {
+    std::cerr << "Failed to start CoreThread for priority admission check\n";
+    return 1;
+  }
+
+  constexpr uint64_t kLowStreamId = 737373;
+  constexpr uint64_t kNormalStreamId = 737374;
+  constexpr uint64_t kHighStreamId = 737375;
+  std::mutex delivered_mu;
+  std::map<uint64_t, uint32_t> delivered;
+  ProviderCallbackIngress ingress(
+      &core,
+      [&](ProviderToCoreCommand&& cmd) {
+        auto& frame = std::get<CmdProviderFrame>(cmd.payload).frame;
+        frame.release_now();
+        std::lock_guard<std::mutex> lock(delivered_mu);
+        ++delivered[frame.stream_id];
+      },
+      []() -> uint64_t { return 0; },
+      [](uint64_t) { return false; });
+  ingress.set_stream_priority(kLowStreamId, StreamPriority::LOW);
+  ingress.set_stream_priority(kHighStreamId, StreamPriority::HIGH);
+
+  auto release_gate = std::make_shared<std::promise<void>>();
+  std::shared_future<void> release_gate_done(release_gate->get_future());
+  std::atomic<bool> gate_started{false};
+  if (core.try_post([release_gate_done, &gate_started]() mutable {
+        gate_started.store(true, std::memory_order_release);
+        release_gate_done.wait();
+      }) != CoreThread::PostResult::Enqueued) {
+    core.stop();
+    std::cerr << "Failed to post priority admission gate\n";
+    return 1;
+  }
+  while (!gate_started.load(std::memory_order_acquire)) {
+    std::this_thread::yield();
+  }
+
+  std::atomic<uint32_t> released{0};
+  uint8_t pixel[4] = {0, 0, 0, 0};
+  const auto send = [&](uint64_t stream_id, uint32_t count) {
+    for (uint32_t i = 0; i < count; ++i) {
+      FrameView frame{};
+      frame.device_instance_id = kDeviceInstanceId;
+      frame.stream_id = stream_id;
+      frame.width = 1;
+      frame.height = 1;
+      frame.format_fourcc = FOURCC_RGBA;
+      frame.data = pixel;
+      frame.size_bytes = sizeof(pixel);
+      frame.stride_bytes = 4;
+      frame.release = [](void* user, const FrameView*) {
+        static_cast<std::atomic<uint32_t>*>(user)->fetch_add(1, std::memory_order_relaxed);
+      };
+      frame.release_user = &released;
+      ingress.on_frame(frame);
+    }
+  };
+  // With NORMAL frames queued, the LOW stream is held at its share once the
+  // lane reaches 8 (6 LOW queued by then); at that fill only LOW reports
+  // congestion. The HIGH stream then fills the lane and loses only what the
+  // lane cannot hold.
+  send(kNormalStreamId, 2);
+  send(kLowStreamId, 12);
+  const bool low_congested = ingress.is_stream_ingress_congested(kLowStreamId);
+  const bool normal_congested = ingress.is_stream_ingress_congested(kNormalStreamId);
+  const bool high_congested = ingress.is_stream_ingress_congested(kHighStreamId);
+  send(kHighStreamId, 10);
+  const bool high_congested_when_full = ingress.is_stream_ingress_congested(kHighStreamId);
+  const ProviderCallbackIngress::Stats queued = ingress.stats_copy();
+  const auto& by_priority = queued.frames_dropped_pressure_by_priority;
+
+  release_gate->set_value();
+  const bool drained = wait_until([&]() { return released.load(std::memory_order_relaxed) == 24; });
+  core.stop();
+  std::lock_guard<std::mutex> lock(delivered_mu);
+  if (!drained || !low_congested || normal_congested || high_congested || !high_congested_when_full ||
+      ingress.stream_priority(kHighStreamId) != StreamPriority::HIGH ||
+      ingress.stream_priority(kNormalStreamId) != StreamPriority::NORMAL ||
+      queued.frames_dropped_fair_share != 6 || queued.frames_dropped_full != 2 ||
+      by_priority[static_cast<size_t>(StreamPriority::LOW)] != 6 ||
+      by_priority[static_cast<size_t>(StreamPriority::NORMAL)] != 0 ||
+      by_priority[static_cast<size_t>(StreamPriority::HIGH)] != 2 ||
+      delivered[kLowStreamId] != 6 || delivered[kNormalStreamId] != 2 || delivered[kHighStreamId] != 8) {
+    std::cerr << "Expected priority-classed ingress admission. drained=" << drained
+              << " low_congested=" << low_congested << " normal_congested=" << normal_congested
+              << " high_congested=" << high_congested << "/" << high_congested_when_full
+              << " fair_share_dropped=" << queued.frames_dropped_fair_share
+              << " dropped_full=" << queued.frames_dropped_full
+              << " low_dropped=" << by_priority[static_cast<size_t>(StreamPriority::LOW)]
+              << " high_dropped=" << by_priority[static_cast<size_t>(StreamPriority::HIGH)]
+              << " low_delivered=" << delivered[kLowStreamId]
+              << " high_delivered=" << delivered[kHighStreamId] << "\n";
+    return 1;
+  }
+  return 0;
+}
+#endif
+
+static int test_core_thread_task_timing_records_wait_and_exec() {
+  struct TickHooks final : CoreThread::IHooks {
+    std::atomic<int> ticks{0};
+    void on_core_timer_tick() override { ticks.fetch_add(1, std::memory_order_relaxed); }
+  } hooks;
+  CoreThread core;
+  if (!core.start(&hooks)) {
+    std::cerr << "Failed to start CoreThread for task timing check\n";
+    return 1;
+  }
+
+  // Hold the core thread so the queued ordinary task accrues measurable wait.
+  auto release_gate = std::make_shared<std::promise<void>>();
+  std::shared_future<void> release_gate_done(release_gate->get_future());
+  std::atomic<bool> gate_started{false};
+  const bool posted = core.try_post([release_gate_done, &gate_started]() mutable {
+    gate_started.store(true, std::memory_order_release);
+    release_gate_done.wait();
+  }) == CoreThread::PostResult::Enqueued;
+  while (posted && !gate_started.load(std::memory_order_acquire)) {
+    std::this_thread::yield();
+  }
+  const bool posted_waiter = core.try_post([]() {}) == CoreThread::PostResult::Enqueued;
+  const bool posted_command = core.try_post_command([]() {}) == CoreThread::PostResult::Enqueued;
+  std::this_thread::sleep_for(std::chrono::milliseconds(5));
+  release_gate->set_value();
+  core.request_timer_tick();
+  const bool ticked = wait_until([&hooks]() { return hooks.ticks.load(std::memory_order_relaxed) > 0; });
+  auto barrier = std::make_shared<std::promise<void>>();
+  auto barrier_done = barrier->get_future();
+  const bool drained = core.try_post([barrier]() mutable { barrier->set_value(); }) ==
+                           CoreThread::PostResult::Enqueued &&
+                       barrier_done.wait_for(std::chrono::seconds(2)) == std::future_status::ready;
+  core.stop();
+  // Joined, so every record is complete; stop() does not reset the histograms.
+  const CoreTaskTimingStats timing = core.task_timing_copy();
+
+  const auto& ordinary_wait = timing.queue_wait[static_cast<size_t>(CoreTaskKind::ORDINARY)];
+  const auto& ordinary_exec = timing.exec[static_cast<size_t>(CoreTaskKind::ORDINARY)];
+  const auto& command_exec = timing.exec[static_cast<size_t>(CoreTaskKind::COMMAND)];
+  const auto& tick_exec = timing.exec[static_cast<size_t>(CoreTaskKind::TIMER_TICK)];
+  uint64_t ordinary_bucketed = 0;
+  for (const uint64_t n : ordinary_exec.buckets) {
+    ordinary_bucketed += n;
+  }
+  // The gate task ran >= 5 ms; the task queued behind it waited about as long.
+  if (!posted || !posted_waiter || !posted_command || !ticked || !drained ||
+      ordinary_exec.count != 3 || ordinary_bucketed != ordinary_exec.count ||
+      ordinary_exec.max_ns < 5'000'000 || ordinary_wait.max_ns < 5'000'000 ||
+      command_exec.count != 1 || tick_exec.count == 0) {
+    std::cerr << "Expected CoreThread task timing to record lane wait/exec and timer ticks. ordinary_exec="
+              << ordinary_exec.count << " max_exec_ns=" << ordinary_exec.max_ns
+              << " max_wait_ns=" << ordinary_wait.max_ns << " command_exec=" << command_exec.count
+              << " tick_exec=" << tick_exec.count << "\n";
+    return 1;
+  }
+  return 0;
+}
+
+static int test_timer_deadline_slack_coalesces_one_shot_wakes() {
+  using Kind = CoreDeadlineTable::Kind;
+  CoreDeadlineTable table;
+  table.set(Kind::WARM_HOLD, 1000, 500);
+  table.set(Kind::NATIVE_OBJECT_RETENTION, 1000, 200);
+  table.set_slack(Kind::NATIVE_OBJECT_RETENTION, 400);
+  // The retention deadline (1200) may be served as late as 1600, so the warm
+  // hold at 1500 is the binding wake and both share it.
+  const auto shared_wake = table.next_delay_ns(1000);
+  table.set_slack(Kind::NATIVE_OBJECT_RETENTION, 100);
+  const auto slack_bound_wake = table.next_delay_ns(1000);
+  const bool table_ok = shared_wake.has_value() && *shared_wake == 500 && slack_bound_wake.has_value() &&
+                        *slack_bound_wake == 300 && !table.due(Kind::NATIVE_OBJECT_RETENTION, 1100, 0) &&
+                        table.due(Kind::NATIVE_OBJECT_RETENTION, 1200, 0);
+
+  // A timed wake fires once, however often other work wakes the thread.
+  struct TickHooks final : CoreThread::IHooks {
+    std::atomic<int> ticks{0};
+    void on_core_timer_tick() override { ticks.fetch_add(1, std::memory_order_relaxed); }
+  } hooks;
+  CoreThread core;
+  if (!core.start(&hooks)) {
+    std::cerr << "Failed to start CoreThread for timed wake check\n";
+    return 1;
+  }
+  core.set_timer_deadline_ns(20'000'000);
+  const auto started = std::chrono::steady_clock::now();
+  while (std::chrono::steady_clock::now() - started < std::chrono::milliseconds(100)) {
+    (void)core.try_post([]() {});
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+  }
+  const int ticks = hooks.ticks.load(std::memory_order_relaxed);
+  core.stop();
+  if (!table_ok || ticks != 1) {
+    std::cerr << "Expected deadline slack to coalesce wakes and the timed wake to fire once. table_ok="
+              << table_ok << " ticks=" << ticks << "\n";
+    return 1;
+  }
+  return 0;
+}
+
+static int test_stream_qos_controller_hysteresis() {
+  using Load = CoreStreamQosController::LoadCounters;
+  constexpr uint64_t kSec = 1'000'000'000ull;
+  CoreStreamQosController qos;
+  Load load{};
+  uint64_t t = 0;
+  auto step = [&](uint64_t busy_ns, uint64_t ingress_drops, uint64_t producer_drops) {
+    t += kSec;
+    load.core_busy_ns += busy_ns;
+    load.ingress_frames_dropped += ingress_drops;
+    load.producer_frames_dropped += producer_drops;
+    return qos.sample(t, load);
+  };
+
+  const bool primed = qos.sample(t, load) == 0;
+  // Two overloaded samples per step up; either drop counter or a saturated
+  // core thread counts.
+  const bool degraded = step(0, 3, 0) == 0 && step(0, 0, 1) == 1 && step(900'000'000ull, 0, 0) == 1 &&
+                        step(900'000'000ull, 0, 0) == 2;
+  // Between the thresholds holds the level and restarts the calm run.
+  bool held = true;
+  for (int i = 0; i < 4; ++i) {
+    held = held && step(0, 0, 0) == 2;
+  }
+  held = held && step(700'000'000ull, 0, 0) == 2;
+  bool restored = true;
+  for (int i = 0; i < 4; ++i) {
+    restored = restored && step(0, 0, 0) == 2;
+  }
+  restored = restored && step(0, 0, 0) == 1;
+  // A counter going backwards (provider swap) only re-primes.
+  load.ingress_frames_dropped = 0;
+  t += kSec;
+  const bool reprimed = qos.sample(t, load) == 1;
+  qos.reset();
+  const bool reset_ok = qos.level() == 0 && qos.level_changes() == 4;
+
+  CaptureProfile base{};
+  base.width = 1280;
+  base.height = 722;
+  base.format_fourcc = FOURCC_RGBA;
+  base.target_fps_min = 30;
+  base.target_fps_max = 30;
+  const CaptureProfile l1 = stream_qos_profile(base, 1);
+  const CaptureProfile l2 = stream_qos_profile(base, 2);
+  const CaptureProfile l3 = stream_qos_profile(base, 7);
+  CaptureProfile unbounded = base;
+  unbounded.target_fps_min = 0;
+  unbounded.target_fps_max = 0;
+  unbounded.width = 2;
+  const CaptureProfile lu = stream_qos_profile(unbounded, 3);
+  const bool profiles_ok = l1.width == 1280 && l1.height == 722 && l1.target_fps_max == 15 &&
+                           l2.width == 640 && l2.height == 360 && l2.target_fps_min == 15 &&
+                           l3.width == 640 && l3.target_fps_max == 7 && l3.format_fourcc == FOURCC_RGBA &&
+                           lu.width == 2 && lu.target_fps_max == 0 && lu.target_fps_min == 0;
+
+  if (!primed || !degraded || !held || !restored || !reprimed || !reset_ok || !profiles_ok) {
+    std::cerr << "Expected stream QoS to step with hysteresis and lower profiles by level. primed=" << primed
+              << " degraded=" << degraded << " held=" << held << " restored=" << restored
+              << " reprimed=" << reprimed << " reset_ok=" << reset_ok << " profiles_ok=" << profiles_ok << "\n";
+    return 1;
+  }
+  return 0;
+}
+
+static int test_resource_aggregate_clear_preserves_outstanding_backing() {
+  constexpr uint64_t kOutstandingBackingStreamId = 434343;
+  ResourceAggregateTelemetry& telemetry = global_resource_aggregate_telemetry();
+  const ScopedResourceTelemetryKey key =
+      make_stream_scoped_resource_telemetry(kOutstandingBackingStreamId);
+
+  telemetry.clear();
+  telemetry.retained_gpu_backing_created(key);
+  telemetry.clear();
+
+  auto find_bucket = [&telemetry]() -> std::optional<ScopedResourceTelemetryKey> {
+    for (const auto& bucket : telemetry.snapshot()) {
+      if (bucket.telemetry_scope == TelemetryScope::STREAM &&
+          bucket.stream_id == kOutstandingBackingStreamId) {
+        return bucket;
+      }
+    }
+    return std::nullopt;
+  };
+
+  const auto outstanding = find_bucket();
+  if (!outstanding || outstanding->retained_gpu_backing_current != 1 ||
+      outstanding->retained_gpu_backing_total_created != 1 ||
+      outstanding->retained_gpu_backing_total_released != 0) {
+    std::cerr << "Expected telemetry clear to preserve an outstanding retained GPU backing\n";
+    return 1;
+  }
+
+  telemetry.retained_gpu_backing_released(key);
+  const auto balanced = find_bucket();
+  if (!balanced || balanced->retained_gpu_backing_current != 0 ||
+      balanced->retained_gpu_backing_total_created != 1 ||
+      balanced->retained_gpu_backing_total_released != 1) {
+    std::cerr << "Expected late retained GPU backing release to balance preserved telemetry\n";
+    return 1;
+  }
+
+  telemetry.clear();
+  if (find_bucket()) {
+    std::cerr << "Expected telemetry clear to retire the balanced retained GPU backing bucket\n";
+    return 1;
+  }
+  return 0;
+}
+
+
+static int test_provider_open_close_refusal_visibility() {
+  CoreRuntime rt;
+  StateSnapshotBuffer buf;
+  RefusingDeviceProvider provider;
+  rt.set_snapshot_publisher(&buf);
+
+  if (!rt.start()) {
+    std::cerr << "FAIL: failed to start runtime for provider refusal smoke\n";
+    return 1;
+  }
+  if (!wait_until([&]() { return rt.state_copy() == CoreRuntimeState::LIVE; }, 200, 1)) {
+    std::cerr << "FAIL: runtime did not become LIVE for provider refusal smoke\n";
+    rt.stop();
+    return 1;
+  }
+  if (!provider.initialize(rt.provider_callbacks()).ok()) {
+    std::cerr << "FAIL: refusing provider initialize failed\n";
+    rt.stop();
+    return 1;
+  }
+  rt.attach_provider(&provider);
+
+  if (!wait_for_snapshot_gen(buf, 0)) {
+    std::cerr << "FAIL: baseline snapshot not published before provider refusal smoke\n";
+    rt.stop();
+    return 1;
+  }
+
+  const TryOpenDeviceStatus open_status = rt.try_open_device("refusing:0", kDeviceInstanceId, kRootId);
+  if (open_status != TryOpenDeviceStatus::ProviderRejected) {
+    std::cerr << "FAIL: provider-refused open returned status=" << static_cast<int>(open_status)
+              << " expected ProviderRejected\n";
+    rt.stop();
+    return 1;
+  }
+  if (provider.open_called() != 1) {
+    std::cerr << "FAIL: provider open call count=" << provider.open_called() << " expected 1\n";
+    rt.stop();
+    return 1;
+  }
+
+  const auto retain_spec = rt.retain_imaging_spec_version(7001);
+  if (retain_spec != CoreThread::PostResult::Enqueued) {
+    std::cerr << "FAIL: retain_imaging_spec_version admission failed after refused open; result="
+              << static_cast<int>(retain_spec) << "\n";
+    rt.stop();
+    return 1;
+  }
+  if (!wait_for_snapshot_pred(buf, [](const CamBANGStateSnapshot& s) {
+        return s.version >= 1 && s.devices.empty();
+      })) {
+    auto snap = buf.snapshot_copy();
+    std::cerr << "FAIL: provider-refused open left stale device truth; device_count="
+              << (snap ? snap->devices.size() : 0) << "\n";
+    rt.stop();
+    return 1;
+  }
+
+  const TryCloseDeviceStatus close_status = rt.try_close_device(kDeviceInstanceId);
+  if (close_status != TryCloseDeviceStatus::ProviderRejected) {
+    std::cerr << "FAIL: provider-refused close returned status=" << static_cast<int>(close_status)
+              << " expected ProviderRejected\n";
+    rt.stop();
+    return 1;
+  }
+  if (provider.close_called() != 1) {
+    std::cerr << "FAIL: provider close call count=" << provider.close_called() << " expected 1\n";
+    rt.stop();
+    return 1;
+  }
+
+  rt.stop();
+  (void)provider.shutdown();
+  return 0;
+}
+
+static int test_provider_command_refusal_and_timeout_truth() {
+  CoreRuntime rt;
+  RefusingDeviceProvider provider;
+
+  if (!rt.start() ||
+      !wait_until([&]() { return rt.state_copy() == CoreRuntimeState::LIVE; }, 200, 1) ||
+      !provider.initialize(rt.provider_callbacks()).ok()) {
+    std::cerr << "FAIL: provider command refusal setup failed\n";
+    rt.stop();
+    return 1;
+  }
+  rt.attach_provider(&provider);
+
+  const TryCreateStreamStatus create_status = rt.try_create_stream(
+      kStreamId, kDeviceInstanceId, StreamIntent::PREVIEW, nullptr, nullptr, 1);
+  if (create_status != TryCreateStreamStatus::ProviderRejected ||
+      provider.create_stream_called() != 1) {
+    std::cerr << "FAIL: provider-refused create returned status="
+              << static_cast<int>(create_status)
+              << " create_calls=" << provider.create_stream_called()
+              << " expected ProviderRejected/1\n";
+    rt.stop();
+    (void)provider.shutdown();
     return 1;
   }
 
@@ -2019,6 +3209,52 @@ static int test_provider_command_refusal_and_timeout_truth() {
 }
 
 
+static int test_stream_registry_tracks_shortest_started_frame_period() {
+  CoreStreamRegistry streams;
+  StreamRequest slow = make_req();
+  slow.profile.target_fps_max = 30;
+  StreamRequest fast = make_req();
+  fast.stream_id = kStreamId + 1;
+  fast.profile.target_fps_max = 60;
+  if (!streams.declare_stream_effective(slow) || !streams.on_stream_created(slow.stream_id) ||
+      !streams.declare_stream_effective(fast) || !streams.on_stream_created(fast.stream_id)) {
+    std::cerr << "Frame period registry setup failed\n";
+    return 1;
+  }
+  if (streams.shortest_started_frame_period_ns() != 0) {
+    std::cerr << "Frame period must be 0 while no stream is started\n";
+    return 1;
+  }
+  (void)streams.on_core_stream_started(slow.stream_id);
+  if (streams.shortest_started_frame_period_ns() != 1'000'000'000ull / 30) {
+    std::cerr << "Frame period must follow the started 30 fps stream\n";
+    return 1;
+  }
+  (void)streams.on_core_stream_started(fast.stream_id);
+  if (streams.shortest_started_frame_period_ns() != 1'000'000'000ull / 60) {
+    std::cerr << "Frame period must follow the fastest started stream\n";
+    return 1;
+  }
+  CaptureProfile slower = fast.profile;
+  slower.target_fps_max = 15;
+  (void)streams.on_stream_reconfigured(fast.stream_id, slower, 2, 1);
+  if (streams.shortest_started_frame_period_ns() != 1'000'000'000ull / 30) {
+    std::cerr << "Frame period must follow a reconfigured frame rate\n";
+    return 1;
+  }
+  (void)streams.on_provider_stream_stopped(slow.stream_id, 0);
+  if (streams.shortest_started_frame_period_ns() != 1'000'000'000ull / 15) {
+    std::cerr << "Frame period must drop a stopped stream\n";
+    return 1;
+  }
+  (void)streams.on_stream_destroyed(fast.stream_id);
+  if (streams.shortest_started_frame_period_ns() != 0) {
+    std::cerr << "Frame period must drop a destroyed stream\n";
+    return 1;
+  }
+  return 0;
+}
+
 static int test_stream_registry_non_ok_stop_ack_does_not_clobber_restart() {
   CoreStreamRegistry streams;
   StreamRequest req = make_req();
@@ -2579,6 +3815,72 @@ static int test_strict_destroy_rejects_started_stream_smoke() {
   return 0;
 }
 
+static int test_stream_pool_depth_hint_follows_retention_smoke() {
+  CoreRuntime rt;
+  if (!rt.start()) {
+    std::cerr << "CoreRuntime failed to start for pool depth hint smoke\n";
+    return 1;
+  }
+
+  StubProvider prov;
+  if (!setup_one_runtime_created_stream(rt, prov)) {
+    rt.stop();
+    return 1;
+  }
+
+  // Sent with the stream's creation: in-flight depth only, latest result.
+  const uint32_t in_flight = prov.last_pool_depth_hint().in_flight_frames;
+  if (prov.pool_depth_hints_received() != 1 || in_flight < 2 ||
+      prov.last_pool_depth_hint().retained_frames != 1) {
+    std::cerr << "Stream creation should send one hint with retained_frames=1; got count="
+              << prov.pool_depth_hints_received() << " in_flight=" << in_flight
+              << " retained=" << prov.last_pool_depth_hint().retained_frames << "\n";
+    rt.stop();
+    return 1;
+  }
+
+  struct Step {
+    const char* what;
+    std::function<void()> apply;
+    uint32_t retained;
+    uint64_t hints;
+  };
+  constexpr uint64_t kBytes = 64ull << 20;
+  const Step steps[] = {
+      {"history ring on", [&] { rt.set_stream_history_limits(kStreamId, 8, kBytes); }, 9, 2},
+      {"same history limits", [&] { rt.set_stream_history_limits(kStreamId, 8, kBytes); }, 9, 2},
+      // The jitter window (kJitterBufferFrames) is inside the ring already.
+      {"jitter buffer on", [&] { rt.set_stream_jitter_buffer_latency(kStreamId, 30'000'000); }, 9, 2},
+      {"history ring off", [&] { rt.set_stream_history_limits(kStreamId, 0, 0); },
+       1 + static_cast<uint32_t>(CoreResultStore::kJitterBufferFrames), 3},
+      {"jitter buffer off", [&] { rt.set_stream_jitter_buffer_latency(kStreamId, 0); }, 1, 4},
+  };
+  for (const Step& step : steps) {
+    step.apply();
+    if (!wait_for_core_barrier(rt)) {
+      std::cerr << "Core barrier timed out after " << step.what << "\n";
+      rt.stop();
+      return 1;
+    }
+    const StreamPoolDepthHint hint = prov.last_pool_depth_hint();
+    if (prov.pool_depth_hints_received() != step.hints || hint.retained_frames != step.retained ||
+        hint.in_flight_frames != in_flight) {
+      std::cerr << "Pool depth hint after " << step.what << ": count=" << prov.pool_depth_hints_received()
+                << " (want " << step.hints << ") retained=" << hint.retained_frames
+                << " (want " << step.retained << ") in_flight=" << hint.in_flight_frames << "\n";
+      rt.stop();
+      return 1;
+    }
+  }
+  if (rt.stats_copy().stream_pool_depth_hints_sent != prov.pool_depth_hints_received()) {
+    std::cerr << "stream_pool_depth_hints_sent disagrees with hints received\n";
+    rt.stop();
+    return 1;
+  }
+
+  rt.stop();
+  return 0;
+}
 
 static int test_stream_start_stop_idempotency_survives_delayed_provider_facts_smoke() {
   CoreRuntime rt;
@@ -3259,6 +4561,149 @@ static int test_rig_preflight_materialization_smoke() {
   return 0;
 }
 
+static int test_warm_pool_prediction_and_rig_prewarm_smoke() {
+  // Pool policy on a synthetic clock.
+  {
+    constexpr uint64_t kSec = 1000000000ull;
+    const std::string hw_a = "warm:a";
+    const std::string hw_b = "warm:b";
+    CoreWarmPool pool;
+    std::vector<CoreWarmPool::IdleDevice> idle;
+    const auto plan_idle = [&](uint64_t now_ns, std::initializer_list<std::pair<uint64_t, const std::string*>> ids) {
+      idle.clear();
+      for (const auto& [id, hw] : ids) {
+        CoreWarmPool::IdleDevice d{};
+        d.device_instance_id = id;
+        d.hardware_id = hw;
+        d.warm_hold_ms = 100;
+        idle.push_back(d);
+      }
+      pool.plan(now_ns, idle);
+    };
+
+    // Two uses of each device, each followed by a 10 s idle gap; a is used
+    // more often.
+    uint64_t t = 0;
+    for (int i = 0; i < 3; ++i) {
+      pool.note_in_use(1, hw_a, t);
+      pool.note_in_use(2, hw_b, t);
+      plan_idle(t, {});
+      t += kSec;
+      plan_idle(t, {{1, &hw_a}, {2, &hw_b}});
+      if (i == 0 && (idle[0].extended || idle[0].deadline_ns != t + 100000000ull)) {
+        std::cerr << "Warm pool extended a device without usage history\n";
+        return 1;
+      }
+      t += 10 * kSec;
+    }
+    pool.note_in_use(1, hw_a, t);
+    plan_idle(t, {});
+    t += kSec;
+    CoreWarmPool::HardwareStats stats{};
+    if (!pool.hardware_stats(hw_a, t, stats) || stats.gap_samples != 3 ||
+        stats.mean_gap_ns != 10 * kSec) {
+      std::cerr << "Warm pool did not learn the idle-to-reuse gap\n";
+      return 1;
+    }
+
+    // Both predict a 15 s gap; the budget of one goes to the more used a.
+    // Device 2's instance was dropped while it sat out a pass, so its idle
+    // time restarts here.
+    pool.set_budget(CoreWarmPool::Budget{1, 120000});
+    const uint64_t idle_a = t;
+    plan_idle(t, {{1, &hw_a}, {2, &hw_b}});
+    if (!idle[0].extended || idle[0].deadline_ns != idle_a + 15 * kSec || idle[1].extended ||
+        idle[1].deadline_ns != t + 100000000ull) {
+      std::cerr << "Warm pool did not extend the highest-scored device within budget\n";
+      return 1;
+    }
+
+    // A prediction past the cap is not held.
+    pool.set_budget(CoreWarmPool::Budget{2, 10000});
+    plan_idle(t, {{1, &hw_a}, {2, &hw_b}});
+    if (idle[0].extended || idle[1].extended) {
+      std::cerr << "Warm pool held a prediction past its cap\n";
+      return 1;
+    }
+
+    // Pre-warm holds regardless of budget.
+    pool.set_budget(CoreWarmPool::Budget{0, 120000});
+    pool.prewarm(2, t + 60 * kSec);
+    plan_idle(t, {{1, &hw_a}, {2, &hw_b}});
+    if (idle[0].extended || idle[0].deadline_ns != idle_a + 100000000ull ||
+        idle[1].deadline_ns != t + 60 * kSec) {
+      std::cerr << "Warm pool pre-warm deadline mismatch\n";
+      return 1;
+    }
+  }
+
+  CoreRuntime rt;
+  if (!rt.start()) {
+    std::cerr << "CoreRuntime failed to start (warm pool smoke)\n";
+    return 1;
+  }
+  StubProvider prov;
+  if (!setup_one_stream(rt, prov)) {
+    std::cerr << "Stub provider setup failed (warm pool smoke)\n";
+    rt.stop();
+    return 1;
+  }
+  std::vector<CameraEndpoint> eps;
+  if (!prov.enumerate_endpoints(eps).ok() || eps.empty()) {
+    std::cerr << "Failed to enumerate endpoints (warm pool smoke)\n";
+    rt.stop();
+    return 1;
+  }
+  if (!rt.smoke_set_rig_member_hardware_ids(7101, {eps[0].hardware_id}) ||
+      !rt.smoke_set_rig_member_hardware_ids(7102, {eps[0].hardware_id, "missing:hw"})) {
+    std::cerr << "Failed to set rig members (warm pool smoke)\n";
+    rt.stop();
+    return 1;
+  }
+  if (rt.try_prewarm_rig(7101, 0) != TryPrewarmRigStatus::InvalidArgument ||
+      rt.try_prewarm_rig(9001, 1000) != TryPrewarmRigStatus::RigNotFound ||
+      rt.try_prewarm_rig(7102, 1000) != TryPrewarmRigStatus::MemberNotOpen) {
+    std::cerr << "Unexpected rig pre-warm rejection status\n";
+    rt.stop();
+    return 1;
+  }
+
+  // A 20 ms hold alone would close the idle device; the pre-warm keeps it.
+  if (rt.try_destroy_stream(kStreamId) != TryDestroyStreamStatus::OK ||
+      !converge_stub_provider_core(rt, prov) ||
+      rt.try_set_device_warm_hold_ms(kDeviceInstanceId, 20) != TrySetWarmHoldStatus::OK ||
+      rt.try_prewarm_rig(7101, 5000) != TryPrewarmRigStatus::OK) {
+    std::cerr << "Rig pre-warm was not accepted\n";
+    rt.stop();
+    return 1;
+  }
+  std::this_thread::sleep_for(std::chrono::milliseconds(200));
+  bool open = false;
+  bool deadline_active = false;
+  const auto read_device = [&]() {
+    prov.flush_callbacks_for_smoke();
+    auto done = std::make_shared<std::promise<void>>();
+    auto ready = done->get_future();
+    if (rt.try_post([&rt, &open, &deadline_active, done]() {
+          const auto* rec = rt.device_record(kDeviceInstanceId);
+          open = rec && rec->open;
+          deadline_active = rec && rec->warm_deadline_active;
+          done->set_value();
+        }) != CoreThread::PostResult::Enqueued) {
+      return false;
+    }
+    return ready.wait_for(std::chrono::seconds(2)) == std::future_status::ready;
+  };
+  if (!read_device() || !open || !deadline_active) {
+    std::cerr << "Pre-warmed rig member did not stay open past its warm hold\n";
+    rt.stop();
+    return 1;
+  }
+
+  rt.stop();
+  return 0;
+}
+
 static int test_device_capture_request_materialization_smoke() {
   CoreRuntime rt;
   const auto ingest_result = rt.ingest_camera_concurrency_json_for_server(
@@ -3868,6 +5313,125 @@ static int test_still_capture_profile_version_idempotency_smoke(StateSnapshotBuf
   return 0;
 }
 
+static int test_setup_batch_smoke() {
+  CoreRuntime rt;
+  StateSnapshotBuffer buf;
+  rt.set_snapshot_publisher(&buf);
+  if (!rt.start()) {
+    std::cerr << "CoreRuntime failed to start (setup batch smoke)\n";
+    return 1;
+  }
+  if (!wait_for_snapshot_gen(buf, 0)) {
+    std::cerr << "Timeout waiting for initial snapshot (setup batch smoke)\n";
+    rt.stop();
+    return 1;
+  }
+  StubProvider prov;
+  if (!prov.initialize(rt.provider_callbacks()).ok()) {
+    std::cerr << "Stub provider initialize failed (setup batch smoke)\n";
+    rt.stop();
+    return 1;
+  }
+  std::vector<CameraEndpoint> eps;
+  if (!prov.enumerate_endpoints(eps).ok() || eps.empty()) {
+    std::cerr << "Stub provider enumerate failed (setup batch smoke)\n";
+    rt.stop();
+    return 1;
+  }
+  rt.attach_provider(&prov);
+
+  // A command failing validation refuses the whole batch up front.
+  std::vector<SetupCommandStatus> statuses;
+  const TryRunSetupBatchStatus refused = rt.try_run_setup_batch(
+      {SetupOpenDevice{eps[0].hardware_id, kDeviceInstanceId, kRootId}, SetupStartStream{0}},
+      statuses);
+  if (refused != TryRunSetupBatchStatus::InvalidArgument || statuses.size() != 2 ||
+      !std::holds_alternative<std::monostate>(statuses[0]) ||
+      statuses[1] != SetupCommandStatus{TryStartStreamStatus::InvalidArgument}) {
+    std::cerr << "Expected an invalid setup batch to be refused before running; status="
+              << static_cast<int>(refused) << "\n";
+    rt.stop();
+    return 1;
+  }
+  CaptureRequest unopened{};
+  if (rt.materialize_capture_request(kDeviceInstanceId, unopened)) {
+    std::cerr << "Refused setup batch must not open its device\n";
+    rt.stop();
+    return 1;
+  }
+
+  const StreamRequest req = make_req();
+  CaptureProfile still{};
+  still.width = 64;
+  still.height = 48;
+  still.format_fourcc = FOURCC_RGBA;
+  SetupCreateStream create{};
+  create.stream_id = kStreamId;
+  create.device_instance_id = kDeviceInstanceId;
+  create.intent = req.intent;
+  create.profile = req.profile;
+  create.picture = req.picture;
+  create.profile_version = req.profile_version;
+  const TryRunSetupBatchStatus ran = rt.try_run_setup_batch(
+      {SetupOpenDevice{eps[0].hardware_id, kDeviceInstanceId, kRootId},
+       SetupSetStillCaptureProfile{kDeviceInstanceId, still, make_default_metered_still_image_bundle()},
+       create,
+       SetupStartStream{kStreamId}},
+      statuses);
+  if (ran != TryRunSetupBatchStatus::OK || statuses.size() != 4 ||
+      statuses[0] != SetupCommandStatus{TryOpenDeviceStatus::OK} ||
+      statuses[1] != SetupCommandStatus{TrySetStillCaptureProfileStatus::OK} ||
+      statuses[2] != SetupCommandStatus{TryCreateStreamStatus::OK} ||
+      statuses[3] != SetupCommandStatus{TryStartStreamStatus::OK}) {
+    std::cerr << "Expected every setup batch command to succeed; status=" << static_cast<int>(ran) << "\n";
+    rt.stop();
+    return 1;
+  }
+  if (!converge_stub_provider_core(rt, prov)) {
+    std::cerr << "Timed out converging setup batch facts\n";
+    rt.stop();
+    return 1;
+  }
+  CoreStreamRegistry::StreamRecord rec{};
+  CaptureRequest capture{};
+  if (!get_stream_record(rt, kStreamId, rec) || !rec.created || !rec.started ||
+      !rt.materialize_capture_request(kDeviceInstanceId, capture) ||
+      capture.width != still.width || capture.height != still.height) {
+    std::cerr << "Setup batch did not leave a started stream and the batch's still profile\n";
+    rt.stop();
+    return 1;
+  }
+
+  // A failed command skips later commands on its stream or device; commands
+  // on other devices still run.
+  constexpr uint64_t kUnknownStreamId = 9001;
+  constexpr uint64_t kRefusedDeviceInstanceId = 9002;
+  constexpr uint64_t kSecondDeviceInstanceId = 9003;
+  const TryRunSetupBatchStatus failed = rt.try_run_setup_batch(
+      {SetupStartStream{kUnknownStreamId},
+       SetupStartStream{kUnknownStreamId},
+       SetupOpenDevice{"missing:hw", kRefusedDeviceInstanceId, kRefusedDeviceInstanceId},
+       SetupSetStillCaptureProfile{kRefusedDeviceInstanceId, still, make_default_metered_still_image_bundle()},
+       SetupOpenDevice{eps[0].hardware_id, kSecondDeviceInstanceId, kSecondDeviceInstanceId}},
+      statuses);
+  CaptureRequest refused_capture{};
+  if (failed != TryRunSetupBatchStatus::CommandFailed || statuses.size() != 5 ||
+      statuses[0] != SetupCommandStatus{TryStartStreamStatus::InvalidArgument} ||
+      !std::holds_alternative<std::monostate>(statuses[1]) ||
+      statuses[2] != SetupCommandStatus{TryOpenDeviceStatus::ProviderRejected} ||
+      !std::holds_alternative<std::monostate>(statuses[3]) ||
+      statuses[4] != SetupCommandStatus{TryOpenDeviceStatus::OK} ||
+      rt.materialize_capture_request(kRefusedDeviceInstanceId, refused_capture)) {
+    std::cerr << "Expected the setup batch to skip only commands on failed targets; status="
+              << static_cast<int>(failed) << "\n";
+    rt.stop();
+    return 1;
+  }
+
+  rt.stop();
+  return 0;
+}
+
 static int test_rig_cohort_admission_from_preflight_smoke() {
   CoreRuntime rt;
   if (!rt.start()) {
@@ -4486,85 +6050,554 @@ static int test_server_facing_rig_orchestration_adapter_smoke() {
     rt.stop();
     return 1;
   }
-  if (!rt.get_capture_result_set(bad_capture_id).empty()) {
+  if (!rt.get_capture_result_set(bad_capture_id).empty()) {
+    rt.stop();
+    return 1;
+  }
+
+  rt.stop();
+  return 0;
+}
+
+static int test_result_store_identity_survives_runtime_restart_smoke() {
+  auto wait_for_stream_result = [](CoreRuntime& rt, StubProvider& prov) -> SharedStreamResultData {
+    SharedStreamResultData retained{};
+    const bool observed = wait_until([&]() {
+      prov.flush_callbacks_for_smoke();
+      if (!wait_for_core_barrier(rt, std::chrono::milliseconds(50))) {
+        return false;
+      }
+      retained = rt.get_latest_stream_result(kStreamId);
+      return static_cast<bool>(retained);
+    }, 200, 1);
+    return observed ? retained : nullptr;
+  };
+
+  CoreRuntime rt;
+  if (!rt.start()) {
+    std::cerr << "Restart identity smoke: first CoreRuntime start failed\n";
+    return 1;
+  }
+
+  StubProvider first_provider;
+  if (!setup_one_runtime_created_stream(rt, first_provider)) {
+    rt.stop();
+    return 1;
+  }
+  if (rt.try_start_stream(kStreamId) != TryStartStreamStatus::OK) {
+    std::cerr << "Restart identity smoke: first stream start failed\n";
+    rt.stop();
+    return 1;
+  }
+  first_provider.emit_test_frames(kStreamId, 1);
+  const auto before_restart = wait_for_stream_result(rt, first_provider);
+  if (!before_restart || before_restart->retained_frame_id == 0) {
+    std::cerr << "Restart identity smoke: no retained stream result before restart\n";
+    rt.stop();
+    return 1;
+  }
+  const uint64_t before_restart_id = before_restart->retained_frame_id;
+  rt.stop();
+
+  if (!rt.start()) {
+    std::cerr << "Restart identity smoke: second CoreRuntime start failed\n";
+    return 1;
+  }
+
+  StubProvider second_provider;
+  if (!setup_one_runtime_created_stream(rt, second_provider)) {
+    rt.stop();
+    return 1;
+  }
+  if (rt.try_start_stream(kStreamId) != TryStartStreamStatus::OK) {
+    std::cerr << "Restart identity smoke: second stream start failed\n";
+    rt.stop();
+    return 1;
+  }
+  second_provider.emit_test_frames(kStreamId, 1);
+  const auto after_restart = wait_for_stream_result(rt, second_provider);
+  if (!after_restart) {
+    std::cerr << "Restart identity smoke: no retained stream result after restart\n";
+    rt.stop();
+    return 1;
+  }
+  if (after_restart->retained_frame_id <= before_restart_id) {
+    std::cerr << "Restart identity smoke: retained_frame_id reset across restart. before="
+              << before_restart_id << " after=" << after_restart->retained_frame_id << "\n";
+    rt.stop();
+    return 1;
+  }
+
+  rt.stop();
+  return 0;
+}
+
+static int test_stream_history_capture_smoke() {
+  CoreRuntime rt;
+  if (!rt.start()) {
+    std::cerr << "Stream history capture smoke: CoreRuntime start failed\n";
+    return 1;
+  }
+  StubProvider prov;
+  if (!setup_one_stream(rt, prov)) {
+    rt.stop();
+    return 1;
+  }
+  // Each 100 ms advance emits about three frames at the stub's 30 fps, so the
+  // ring must hold every frame of the run for marks[1] to still be kept.
+  rt.set_stream_history_limits(kStreamId, 16, 64ull * 1024ull * 1024ull);
+  if (rt.try_start_stream(kStreamId) != TryStartStreamStatus::OK) {
+    std::cerr << "Stream history capture smoke: stream start failed\n";
+    rt.stop();
+    return 1;
+  }
+  // The stub emits one frame at start and one per elapsed frame period.
+  std::vector<int64_t> marks;
+  SharedStreamResultData latest;
+  for (int i = 0; i < 4; ++i) {
+    if (i != 0) {
+      prov.advance(100'000'000ull);
+    }
+    const uint64_t previous_id = latest ? latest->retained_frame_id : 0;
+    if (!wait_until([&]() {
+          prov.flush_callbacks_for_smoke();
+          if (!wait_for_core_barrier(rt, std::chrono::milliseconds(50))) {
+            return false;
+          }
+          latest = rt.get_latest_stream_result(kStreamId);
+          return latest && latest->retained_frame_id != previous_id &&
+                 latest->image_facts.acquisition_timing;
+        }, 200, 1)) {
+      std::cerr << "Stream history capture smoke: stream frame " << i << " did not arrive\n";
+      rt.stop();
+      return 1;
+    }
+    marks.push_back(latest->image_facts.acquisition_timing->value.acquisition_mark());
+  }
+  if (marks[1] == marks.back()) {
+    std::cerr << "Stream history capture smoke: stub frames did not advance in time\n";
+    rt.stop();
+    return 1;
+  }
+
+  // A reference just after an older frame resolves to it, not the latest.
+  const ImageAcquisitionTiming& latest_timing = latest->image_facts.acquisition_timing->value;
+  const auto reference = ImageAcquisitionTiming::create(marks[1] + 1,
+                                                        latest_timing.tick_period(),
+                                                        latest_timing.clock_domain(),
+                                                        latest_timing.reference_event(),
+                                                        latest_timing.comparability());
+  constexpr uint64_t kHistoryCaptureId = 99401;
+  if (!reference ||
+      rt.try_trigger_device_capture_from_stream_history_for_server(
+          kDeviceInstanceId, kHistoryCaptureId, kStreamId, *reference) != TryTriggerDeviceCaptureStatus::OK) {
+    std::cerr << "Stream history capture smoke: history capture was not admitted\n";
+    rt.stop();
+    return 1;
+  }
+  SharedCaptureResultData capture;
+  if (!wait_until([&]() {
+        if (!wait_for_core_barrier(rt, std::chrono::milliseconds(50))) {
+          return false;
+        }
+        capture = rt.get_capture_result(kHistoryCaptureId, kDeviceInstanceId);
+        return static_cast<bool>(capture);
+      }, 200, 1)) {
+    std::cerr << "Stream history capture smoke: history capture produced no result\n";
+    rt.stop();
+    return 1;
+  }
+  const auto& member_timing = capture->default_image.acquisition_timing;
+  if (!member_timing || member_timing->value.acquisition_mark() != marks[1] ||
+      capture->default_image.payload.size_bytes() != latest->payload.size_bytes()) {
+    std::cerr << "Stream history capture smoke: capture did not resolve to the nearest kept frame\n";
+    rt.stop();
+    return 1;
+  }
+
+  // Timing from another clock domain matches no frame.
+  const auto foreign = ImageAcquisitionTiming::create(latest_timing.acquisition_mark(),
+                                                      latest_timing.tick_period(),
+                                                      ImageAcquisitionClockDomain::CORE_MONOTONIC,
+                                                      latest_timing.reference_event(),
+                                                      latest_timing.comparability());
+  if (!foreign ||
+      rt.try_trigger_device_capture_from_stream_history_for_server(
+          kDeviceInstanceId, kHistoryCaptureId + 1, kStreamId, *foreign) !=
+          TryTriggerDeviceCaptureStatus::Unavailable) {
+    std::cerr << "Stream history capture smoke: foreign clock domain was not refused\n";
+    rt.stop();
+    return 1;
+  }
+  rt.stop();
+  return 0;
+}
+
+// Runs one capture through a runtime with `medium` selected for the spill
+// tier, evicts it with a critical trim, and looks it up again.
+static int run_capture_spill_medium_smoke(CoreCaptureSpillStore::Medium medium,
+                                          const std::filesystem::path& directory,
+                                          bool expect_reload) {
+  CoreRuntime rt;
+  if (!rt.set_capture_spill_medium(medium, 64ull * 1024ull * 1024ull, directory) || !rt.start()) {
+    std::cerr << "Capture spill smoke: stopped-time medium selection or start failed\n";
+    return 1;
+  }
+  if (rt.set_capture_spill_medium(CoreCaptureSpillStore::Medium::OFF)) {
+    std::cerr << "Capture spill smoke: medium changed while running\n";
+    rt.stop();
+    return 1;
+  }
+  StubProvider prov;
+  if (!setup_one_stream(rt, prov)) {
+    rt.stop();
+    return 1;
+  }
+  rt.set_stream_history_limits(kStreamId, 4, 64ull * 1024ull * 1024ull);
+  if (rt.try_start_stream(kStreamId) != TryStartStreamStatus::OK) {
+    std::cerr << "Capture spill smoke: stream start failed\n";
+    rt.stop();
+    return 1;
+  }
+  SharedStreamResultData latest;
+  if (!wait_until([&]() {
+        prov.flush_callbacks_for_smoke();
+        if (!wait_for_core_barrier(rt, std::chrono::milliseconds(50))) {
+          return false;
+        }
+        latest = rt.get_latest_stream_result(kStreamId);
+        return latest && latest->image_facts.acquisition_timing;
+      }, 200, 1)) {
+    std::cerr << "Capture spill smoke: no stream frame arrived\n";
+    rt.stop();
+    return 1;
+  }
+  constexpr uint64_t kSpillCaptureId = 99501;
+  if (rt.try_trigger_device_capture_from_stream_history_for_server(
+          kDeviceInstanceId, kSpillCaptureId, kStreamId, latest->image_facts.acquisition_timing->value) !=
+      TryTriggerDeviceCaptureStatus::OK) {
+    std::cerr << "Capture spill smoke: capture was not admitted\n";
+    rt.stop();
+    return 1;
+  }
+  SharedCaptureResultData capture;
+  if (!wait_until([&]() {
+        if (!wait_for_core_barrier(rt, std::chrono::milliseconds(50))) {
+          return false;
+        }
+        capture = rt.get_capture_result(kSpillCaptureId, kDeviceInstanceId);
+        return static_cast<bool>(capture);
+      }, 200, 1)) {
+    std::cerr << "Capture spill smoke: capture produced no result\n";
+    rt.stop();
+    return 1;
+  }
+  const std::vector<uint8_t> bytes(capture->default_image.payload.data(),
+                                   capture->default_image.payload.data() + capture->default_image.payload.size_bytes());
+  capture.reset();
+  latest.reset();
+
+  if (rt.trim_memory(MemoryTrimLevel::Critical) < bytes.size()) {
+    std::cerr << "Capture spill smoke: critical trim did not evict the capture\n";
+    rt.stop();
+    return 1;
+  }
+  // Reload twice: the second lookup is served after the background write.
+  for (int i = 0; i < 2; ++i) {
+    const SharedCaptureResultData reloaded = rt.get_capture_result(kSpillCaptureId, kDeviceInstanceId);
+    if (static_cast<bool>(reloaded) != expect_reload ||
+        (reloaded && (reloaded->capture_id != kSpillCaptureId ||
+                      reloaded->default_image.payload.size_bytes() != bytes.size() ||
+                      !std::equal(bytes.begin(), bytes.end(), reloaded->default_image.payload.data())))) {
+      std::cerr << "Capture spill smoke: evicted capture lookup did not match the selected medium\n";
+      rt.stop();
+      return 1;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  }
+  rt.stop();
+  return 0;
+}
+
+static int test_capture_spill_medium_smoke() {
+  // Off by default: an evicted capture is gone.
+  if (int r = run_capture_spill_medium_smoke(CoreCaptureSpillStore::Medium::OFF, {}, false)) {
+    return r;
+  }
+  // The stub's frames are too small to compress smaller, so the reload goes
+  // through spill files.
+  const std::filesystem::path directory = std::filesystem::temp_directory_path() / "cambang_spine_smoke_spill";
+  std::filesystem::remove_all(directory);
+  const int r = run_capture_spill_medium_smoke(CoreCaptureSpillStore::Medium::TEMP_FILE, directory, true);
+  std::filesystem::remove_all(directory);
+  return r;
+}
+
+static int test_frame_shard_retention_smoke() {
+  CoreRuntime rt;
+  if (rt.set_frame_shard_count(CoreFrameShards::kMaxShards + 1) || !rt.set_frame_shard_count(2)) {
+    std::cerr << "Frame shard smoke: shard count was not validated\n";
+    return 1;
+  }
+  if (!rt.start()) {
+    std::cerr << "Frame shard smoke: CoreRuntime start failed\n";
+    return 1;
+  }
+  if (rt.set_frame_shard_count(1)) {
+    std::cerr << "Frame shard smoke: shard count changed while running\n";
+    rt.stop();
+    return 1;
+  }
+  StubProvider prov;
+  if (!setup_one_stream(rt, prov) || rt.try_start_stream(kStreamId) != TryStartStreamStatus::OK) {
+    std::cerr << "Frame shard smoke: stream setup failed\n";
+    rt.stop();
+    return 1;
+  }
+  // Retained results must keep advancing in order with retention off the
+  // core thread.
+  uint64_t previous_id = 0;
+  for (int i = 0; i < 4; ++i) {
+    if (i != 0) {
+      prov.advance(100'000'000ull);
+    }
+    SharedStreamResultData latest;
+    if (!wait_until([&]() {
+          prov.flush_callbacks_for_smoke();
+          if (!wait_for_core_barrier(rt, std::chrono::milliseconds(50))) {
+            return false;
+          }
+          latest = rt.get_latest_stream_result(kStreamId);
+          return latest && latest->retained_frame_id > previous_id;
+        }, 200, 1)) {
+      std::cerr << "Frame shard smoke: stream frame " << i << " was not retained\n";
+      rt.stop();
+      return 1;
+    }
+    previous_id = latest->retained_frame_id;
+  }
+
+  // Stopping the stream drains the shards, so every posted frame has come
+  // back to the core thread and been released there.
+  if (rt.try_stop_stream(kStreamId) != TryStopStreamStatus::OK) {
+    std::cerr << "Frame shard smoke: stream stop failed\n";
+    rt.stop();
+    return 1;
+  }
+  const CoreRuntime::Stats stats = rt.stats_copy();
+  CoreStreamRegistry::StreamRecord rec{};
+  if (!get_stream_record(rt, kStreamId, rec)) {
+    std::cerr << "Frame shard smoke: stream record unavailable\n";
+    rt.stop();
+    return 1;
+  }
+  if (stats.frame_shard_frames_posted < 4 ||
+      stats.frame_shard_frames_retained + stats.frame_shard_frames_rejected_full < 4 ||
+      rec.frames_received != rec.frames_released + rec.frames_dropped) {
+    std::cerr << "Frame shard smoke: posted=" << stats.frame_shard_frames_posted
+              << " retained=" << stats.frame_shard_frames_retained
+              << " rejected_full=" << stats.frame_shard_frames_rejected_full
+              << " received=" << rec.frames_received << " released=" << rec.frames_released
+              << " dropped=" << rec.frames_dropped << "\n";
     rt.stop();
     return 1;
   }
-
   rt.stop();
   return 0;
 }
 
-static int test_result_store_identity_survives_runtime_restart_smoke() {
-  auto wait_for_stream_result = [](CoreRuntime& rt, StubProvider& prov) -> SharedStreamResultData {
-    SharedStreamResultData retained{};
-    const bool observed = wait_until([&]() {
+// Eagerly started, never-awaited coroutine: enough to co_await a
+// CoreOperation from a test.
+struct SmokeDetachedTask {
+  struct promise_type {
+    SmokeDetachedTask get_return_object() noexcept { return {}; }
+    std::suspend_never initial_suspend() noexcept { return {}; }
+    std::suspend_never final_suspend() noexcept { return {}; }
+    void return_void() noexcept {}
+    void unhandled_exception() noexcept { std::terminate(); }
+  };
+};
+
+static SmokeDetachedTask await_operation_into(CoreOperation op, std::atomic<int>& out) {
+  const CoreOperationOutcome outcome = co_await op;
+  out.store(static_cast<int>(outcome), std::memory_order_release);
+}
+
+static int test_async_command_completion_smoke() {
+  CoreRuntime rt;
+  if (!rt.start() || !wait_until([&]() { return rt.state_copy() == CoreRuntimeState::LIVE; }, 200, 1)) {
+    std::cerr << "Async command smoke: CoreRuntime start failed\n";
+    return 1;
+  }
+  StubProvider prov;
+  std::vector<CameraEndpoint> eps;
+  if (!prov.initialize(rt.provider_callbacks()).ok() || !prov.enumerate_endpoints(eps).ok() || eps.empty()) {
+    std::cerr << "Async command smoke: stub provider setup failed\n";
+    rt.stop();
+    return 1;
+  }
+  rt.attach_provider(&prov);
+  auto settle = [&](const CoreOperation& op) {
+    return wait_until([&]() {
       prov.flush_callbacks_for_smoke();
-      if (!wait_for_core_barrier(rt, std::chrono::milliseconds(50))) {
-        return false;
-      }
-      retained = rt.get_latest_stream_result(kStreamId);
-      return static_cast<bool>(retained);
+      return op.done();
     }, 200, 1);
-    return observed ? retained : nullptr;
   };
 
-  CoreRuntime rt;
-  if (!rt.start()) {
-    std::cerr << "Restart identity smoke: first CoreRuntime start failed\n";
+  // A refused command hands back an operation that has already failed.
+  TryStartStreamStatus refused_status = TryStartStreamStatus::OK;
+  const CoreOperation refused = rt.start_stream_async(kStreamId, &refused_status);
+  if (refused_status != TryStartStreamStatus::InvalidArgument ||
+      refused.outcome() != CoreOperationOutcome::Failed) {
+    std::cerr << "Async command smoke: refused start did not fail its operation\n";
+    rt.stop();
     return 1;
   }
 
-  StubProvider first_provider;
-  if (!setup_one_runtime_created_stream(rt, first_provider)) {
+  TryOpenDeviceStatus open_status = TryOpenDeviceStatus::Busy;
+  const CoreOperation opened = rt.open_device_async(eps[0].hardware_id, kDeviceInstanceId, kRootId, &open_status);
+  if (open_status != TryOpenDeviceStatus::OK || !settle(opened) ||
+      opened.outcome() != CoreOperationOutcome::Succeeded) {
+    std::cerr << "Async command smoke: open did not resolve from the device-opened fact\n";
     rt.stop();
     return 1;
   }
-  if (rt.try_start_stream(kStreamId) != TryStartStreamStatus::OK) {
-    std::cerr << "Restart identity smoke: first stream start failed\n";
+  if (rt.try_create_stream(kStreamId, kDeviceInstanceId, StreamIntent::PREVIEW, nullptr, nullptr, 0) !=
+      TryCreateStreamStatus::OK) {
+    std::cerr << "Async command smoke: stream create failed\n";
     rt.stop();
     return 1;
   }
-  first_provider.emit_test_frames(kStreamId, 1);
-  const auto before_restart = wait_for_stream_result(rt, first_provider);
-  if (!before_restart || before_restart->retained_frame_id == 0) {
-    std::cerr << "Restart identity smoke: no retained stream result before restart\n";
+
+  // The start is pending until the provider's started fact is integrated.
+  const CoreOperation started = rt.start_stream_async(kStreamId);
+  std::atomic<int> awaited{-1};
+  await_operation_into(started, awaited);
+  if (!settle(started) || started.outcome() != CoreOperationOutcome::Succeeded ||
+      awaited.load(std::memory_order_acquire) != static_cast<int>(CoreOperationOutcome::Succeeded)) {
+    std::cerr << "Async command smoke: start did not resolve or resume its awaiter\n";
+    rt.stop();
+    return 1;
+  }
+  // Nothing left to do: already succeeded.
+  if (rt.start_stream_async(kStreamId).outcome() != CoreOperationOutcome::Succeeded) {
+    std::cerr << "Async command smoke: repeated start was left pending\n";
     rt.stop();
     return 1;
   }
-  const uint64_t before_restart_id = before_restart->retained_frame_id;
-  rt.stop();
 
-  if (!rt.start()) {
-    std::cerr << "Restart identity smoke: second CoreRuntime start failed\n";
+  const CoreOperation stopped = rt.stop_stream_async(kStreamId);
+  std::atomic<int> stop_callback{-1};
+  stopped.on_done([&stop_callback](CoreOperationOutcome outcome, uint32_t) {
+    stop_callback.store(static_cast<int>(outcome), std::memory_order_release);
+  });
+  if (!settle(stopped) || stopped.outcome() != CoreOperationOutcome::Succeeded ||
+      stop_callback.load(std::memory_order_acquire) != static_cast<int>(CoreOperationOutcome::Succeeded)) {
+    std::cerr << "Async command smoke: stop did not resolve or run its callback\n";
+    rt.stop();
     return 1;
   }
 
-  StubProvider second_provider;
-  if (!setup_one_runtime_created_stream(rt, second_provider)) {
+  const CoreOperation captured = rt.trigger_device_capture_async_for_server(kDeviceInstanceId, 77001);
+  if (!settle(captured) || captured.outcome() != CoreOperationOutcome::Succeeded) {
+    std::cerr << "Async command smoke: capture did not resolve from the completed fact\n";
     rt.stop();
     return 1;
   }
-  if (rt.try_start_stream(kStreamId) != TryStartStreamStatus::OK) {
-    std::cerr << "Restart identity smoke: second stream start failed\n";
+
+  // Runtime stop leaves nothing pending.
+  const CoreOperation unflushed = rt.trigger_device_capture_async_for_server(kDeviceInstanceId, 77002);
+  rt.stop();
+  if (!unflushed.done()) {
+    std::cerr << "Async command smoke: runtime stop left an operation pending\n";
+    return 1;
+  }
+  return 0;
+}
+
+// Records every published version and replays each delta onto the snapshot
+// before it, so a test can check the stream a publisher actually saw.
+struct OffloadRecordingPublisher final : IStateSnapshotPublisher {
+  std::mutex mu;
+  std::vector<uint64_t> versions;
+  std::shared_ptr<const CamBANGStateSnapshot> previous;
+  std::shared_ptr<const CamBANGStateSnapshot> latest;
+  uint64_t deltas_applied = 0;
+  bool delta_mismatch = false;
+
+  void publish(std::shared_ptr<const CamBANGStateSnapshot> snapshot) override {
+    std::lock_guard<std::mutex> lock(mu);
+    versions.push_back(snapshot->version);
+    previous = std::move(latest);
+    latest = std::move(snapshot);
+  }
+  bool wants_snapshot_delta() const noexcept override { return true; }
+  void publish_delta(const CamBANGStateSnapshotDelta& delta) override {
+    std::lock_guard<std::mutex> lock(mu);
+    CamBANGStateSnapshot applied = previous ? *previous : CamBANGStateSnapshot{};
+    if (!previous || !apply_snapshot_delta(applied, delta) || !(applied == *latest)) {
+      delta_mismatch = true;
+    }
+    ++deltas_applied;
+  }
+};
+
+static int test_snapshot_publish_offload_smoke() {
+  CoreRuntime rt;
+  OffloadRecordingPublisher pub;
+  rt.set_snapshot_publisher(&pub);
+  if (!rt.set_snapshot_publish_offload(true) || !rt.start()) {
+    std::cerr << "Snapshot offload smoke: start failed\n";
+    return 1;
+  }
+  if (rt.set_snapshot_publish_offload(false)) {
+    std::cerr << "Snapshot offload smoke: offload changed while running\n";
     rt.stop();
     return 1;
   }
-  second_provider.emit_test_frames(kStreamId, 1);
-  const auto after_restart = wait_for_stream_result(rt, second_provider);
-  if (!after_restart) {
-    std::cerr << "Restart identity smoke: no retained stream result after restart\n";
+  StubProvider prov;
+  if (!setup_one_stream(rt, prov) || rt.try_start_stream(kStreamId) != TryStartStreamStatus::OK) {
+    std::cerr << "Snapshot offload smoke: stream setup failed\n";
     rt.stop();
     return 1;
   }
-  if (after_restart->retained_frame_id <= before_restart_id) {
-    std::cerr << "Restart identity smoke: retained_frame_id reset across restart. before="
-              << before_restart_id << " after=" << after_restart->retained_frame_id << "\n";
+  for (int i = 0; i < 3; ++i) {
+    prov.advance(100'000'000ull);
+    prov.flush_callbacks_for_smoke();
+  }
+  if (!wait_until([&]() {
+        std::lock_guard<std::mutex> lock(pub.mu);
+        if (!pub.latest) {
+          return false;
+        }
+        for (const StreamState& s : pub.latest->streams) {
+          if (s.stream_id == kStreamId && s.mode == CBStreamMode::FLOWING && s.frames_received != 0) {
+            return true;
+          }
+        }
+        return false;
+      })) {
+    std::cerr << "Snapshot offload smoke: the flowing stream never reached a published snapshot\n";
     rt.stop();
     return 1;
   }
-
   rt.stop();
+
+  // Every version published once, in order, deltas consistent, and the
+  // sequence marker counted each publish.
+  std::lock_guard<std::mutex> lock(pub.mu);
+  for (size_t i = 0; i < pub.versions.size(); ++i) {
+    if (pub.versions[i] != i) {
+      std::cerr << "Snapshot offload smoke: published version " << pub.versions[i] << " at position " << i << "\n";
+      return 1;
+    }
+  }
+  if (pub.delta_mismatch || pub.deltas_applied + 1 != pub.versions.size() ||
+      rt.published_seq() != pub.versions.size()) {
+    std::cerr << "Snapshot offload smoke: deltas=" << pub.deltas_applied << " mismatch=" << pub.delta_mismatch
+              << " published=" << pub.versions.size() << " seq=" << rt.published_seq() << "\n";
+    return 1;
+  }
   return 0;
 }
 
@@ -4657,6 +6690,155 @@ static int test_rig_orchestration_helper_smoke() {
   return 0;
 }
 
+static int test_capture_latency_histograms_smoke() {
+  // Bucketing: percentiles are bucket tops, never below the true value and
+  // within 1/32 above it; min/max/count stay exact.
+  {
+    CoreHdrHistogram h;
+    for (uint64_t v = 1; v <= 1000; ++v) {
+      h.record(v * 1000);
+    }
+    const CoreHdrHistogram::Summary s = h.summary();
+    const auto near = [](uint64_t got, uint64_t want) {
+      return got >= want && got <= want + want / CoreHdrHistogram::kSubBucketCount;
+    };
+    if (s.count != 1000 || s.min_ns != 1000 || s.max_ns != 1000000 || s.mean_ns != 500500 ||
+        !near(s.p50_ns, 500000) || !near(s.p90_ns, 900000) || !near(s.p99_ns, 990000) ||
+        !near(s.p999_ns, 999000) || h.value_at_percentile(99.0) != s.p99_ns) {
+      std::cerr << "Capture latency smoke: histogram summary out of bounds (p50=" << s.p50_ns
+                << " p90=" << s.p90_ns << " p99=" << s.p99_ns << " p999=" << s.p999_ns << ")\n";
+      return 1;
+    }
+    h.record(uint64_t{1} << 50);
+    if (h.max_ns() != (uint64_t{1} << 50) || h.value_at_percentile(100.0) != (uint64_t{1} << 50)) {
+      std::cerr << "Capture latency smoke: out-of-range value lost its exact maximum\n";
+      return 1;
+    }
+  }
+
+  CoreRuntime rt;
+  StateSnapshotBuffer buf;
+  rt.set_snapshot_publisher(&buf);
+  if (!rt.start()) return 1;
+  StubProvider prov;
+  if (!setup_one_stream(rt, prov)) { rt.stop(); return 1; }
+
+  std::vector<CameraEndpoint> eps;
+  if (!prov.enumerate_endpoints(eps).ok() || eps.empty()) { rt.stop(); return 1; }
+
+  const auto device_latency = [&]() -> CaptureLatencyState {
+    const auto snap = get_last_snapshot(buf);
+    if (snap) {
+      for (const DeviceState& d : snap->devices) {
+        if (d.instance_id == kDeviceInstanceId) return d.capture_latency;
+      }
+    }
+    return {};
+  };
+  const auto find_rig = [&](uint64_t rig_id) -> std::optional<RigState> {
+    const auto snap = get_last_snapshot(buf);
+    if (snap) {
+      for (const RigState& r : snap->rigs) {
+        if (r.rig_id == rig_id) return r;
+      }
+    }
+    return std::nullopt;
+  };
+
+  // A triggered capture. The stub provider reports started and completed
+  // without an image, so the image stages stay empty.
+  if (rt.try_trigger_device_capture_with_capture_id_for_server(kDeviceInstanceId, 9601) !=
+      TryTriggerDeviceCaptureStatus::OK) {
+    std::cerr << "Capture latency smoke: device capture trigger failed\n";
+    rt.stop();
+    return 1;
+  }
+  if (!wait_until([&]() {
+        prov.flush_callbacks_for_smoke();
+        return device_latency().capture.count == 1;
+      }, 400, 5)) {
+    std::cerr << "Capture latency smoke: triggered capture never reached the device histograms\n";
+    rt.stop();
+    return 1;
+  }
+  CaptureLatencyState latency = device_latency();
+  if (latency.admission.count != 1 || latency.provider_start.count != 1 ||
+      latency.image_arrival.count != 0 || latency.finalization.count != 0 ||
+      latency.capture.max_ns < latency.admission.max_ns) {
+    std::cerr << "Capture latency smoke: unexpected stage counts for a triggered capture\n";
+    rt.stop();
+    return 1;
+  }
+
+  // A provider-reported capture with an image but no trigger: only the
+  // started -> image -> completed stages are known.
+  static std::vector<uint8_t> bytes(2 * 2 * 4, 7);
+  FrameView frame{};
+  frame.capture_id = 9602;
+  frame.device_instance_id = kDeviceInstanceId;
+  frame.width = 2;
+  frame.height = 2;
+  frame.format_fourcc = FOURCC_RGBA;
+  frame.data = bytes.data();
+  frame.size_bytes = bytes.size();
+  frame.release = [](void*, const FrameView*) {};
+  rt.provider_callbacks()->on_capture_started(9602, kDeviceInstanceId);
+  rt.provider_callbacks()->on_frame(frame);
+  rt.provider_callbacks()->on_capture_completed(9602, kDeviceInstanceId);
+  if (!wait_until([&]() { return device_latency().finalization.count == 1; }, 400, 5)) {
+    std::cerr << "Capture latency smoke: reported capture never reached the image stages\n";
+    rt.stop();
+    return 1;
+  }
+  latency = device_latency();
+  if (latency.image_arrival.count != 1 || latency.capture.count != 1 || latency.admission.count != 1) {
+    std::cerr << "Capture latency smoke: untriggered capture fed stages it has no endpoints for\n";
+    rt.stop();
+    return 1;
+  }
+
+  // A rig capture feeds the rig's histograms, sync skew and last_* fields.
+  if (!rt.smoke_set_rig_member_hardware_ids(8601, {eps[0].hardware_id})) { rt.stop(); return 1; }
+  if (!wait_for_rig_preflight_ok(rt, 8601).ok) { rt.stop(); return 1; }
+  if (!rt.smoke_orchestrate_rig_capture_with_capture_id(8601, 9603).ok) {
+    std::cerr << "Capture latency smoke: rig capture orchestration failed\n";
+    rt.stop();
+    return 1;
+  }
+  if (!wait_until([&]() {
+        prov.flush_callbacks_for_smoke();
+        const auto rig = find_rig(8601);
+        return rig && rig->capture_latency.capture.count == 1;
+      }, 400, 5)) {
+    std::cerr << "Capture latency smoke: rig capture never reached the rig histograms\n";
+    rt.stop();
+    return 1;
+  }
+  const std::optional<RigState> rig = find_rig(8601);
+  if (rig->sync_skew.count != 1 || rig->sync_skew.max_ns != 0 ||
+      rig->capture_latency.admission.count != 1 || rig->last_capture_id != 9603 ||
+      rig->last_capture_latency_ns != rig->capture_latency.capture.max_ns ||
+      device_latency().capture.count != 2) {
+    std::cerr << "Capture latency smoke: rig capture latency mismatch\n";
+    rt.stop();
+    return 1;
+  }
+
+  if (!rt.reset_capture_latency_histograms() ||
+      !wait_until([&]() {
+        const auto reset_rig = find_rig(8601);
+        return device_latency().capture.count == 0 && reset_rig &&
+               reset_rig->capture_latency.capture.count == 0 && reset_rig->sync_skew.count == 0;
+      }, 400, 5)) {
+    std::cerr << "Capture latency smoke: reset did not clear the histograms\n";
+    rt.stop();
+    return 1;
+  }
+
+  rt.stop();
+  return 0;
+}
+
 #endif // CAMBANG_SMOKE_WITH_STUB_PROVIDER
 
 #if defined(CAMBANG_SMOKE_WITH_STUB_PROVIDER)
@@ -4788,6 +6970,14 @@ int main(int argc, char** argv) {
                                r);
       return r;
     }
+    if (int r = reporter.run("test_camera_description_file_ingest_smoke",
+                             [] { return test_camera_description_file_ingest_smoke(); })) {
+      if (reporter.verbose()) reporter.print_summary();
+      reporter.print_fail_line("core_spine_smoke",
+                               "test_camera_description_file_ingest_smoke",
+                               r);
+      return r;
+    }
     if (int r = reporter.run("test_runtime_camera_concurrency_ingest_lifecycle_smoke",
                              [] { return test_runtime_camera_concurrency_ingest_lifecycle_smoke(); })) {
       if (reporter.verbose()) reporter.print_summary();
@@ -4804,12 +6994,29 @@ int main(int argc, char** argv) {
                                r);
       return r;
     }
+    if (int r = reporter.run("test_camera_concurrency_combination_index_smoke",
+                             [] { return test_camera_concurrency_combination_index_smoke(); })) {
+      if (reporter.verbose()) reporter.print_summary();
+      reporter.print_fail_line("core_spine_smoke",
+                               "test_camera_concurrency_combination_index_smoke",
+                               r);
+      return r;
+    }
+    if (int r = reporter.run("test_strict_json_document_views_and_payload_ingest_smoke",
+                             [] { return test_strict_json_document_views_and_payload_ingest_smoke(); })) {
+      if (reporter.verbose()) reporter.print_summary();
+      reporter.print_fail_line("core_spine_smoke",
+                               "test_strict_json_document_views_and_payload_ingest_smoke",
+                               r);
+      return r;
+    }
     if (int r = reporter.run("test_capture_admission_context_smoke",
                              [] { return test_capture_admission_context_smoke(); })) {
       if (reporter.verbose()) reporter.print_summary();
       reporter.print_fail_line("core_spine_smoke", "test_capture_admission_context_smoke", r);
       return r;
     }
+#if !CAMBANG_PROVIDER_BOUND
     if (int r = reporter.run("test_provider_callback_ingress_null_core_thread_drop_accounting",
                              [] { return test_provider_callback_ingress_null_core_thread_drop_accounting(); })) {
       if (reporter.verbose()) reporter.print_summary();
@@ -4826,6 +7033,83 @@ int main(int argc, char** argv) {
                                r);
       return r;
     }
+    if (int r = reporter.run("test_provider_callback_ingress_latest_wins_supersedes_oldest_frames",
+                             [] { return test_provider_callback_ingress_latest_wins_supersedes_oldest_frames(); })) {
+      if (reporter.verbose()) reporter.print_summary();
+      reporter.print_fail_line("core_spine_smoke",
+                               "test_provider_callback_ingress_latest_wins_supersedes_oldest_frames",
+                               r);
+      return r;
+    }
+    if (int r = reporter.run("test_provider_callback_ingress_coalesces_native_object_counters",
+                             [] { return test_provider_callback_ingress_coalesces_native_object_counters(); })) {
+      if (reporter.verbose()) reporter.print_summary();
+      reporter.print_fail_line("core_spine_smoke",
+                               "test_provider_callback_ingress_coalesces_native_object_counters",
+                               r);
+      return r;
+    }
+    if (int r = reporter.run("test_provider_callback_ingress_stream_depth_slots_are_reclaimed",
+                             [] { return test_provider_callback_ingress_stream_depth_slots_are_reclaimed(); })) {
+      if (reporter.verbose()) reporter.print_summary();
+      reporter.print_fail_line("core_spine_smoke",
+                               "test_provider_callback_ingress_stream_depth_slots_are_reclaimed",
+                               r);
+      return r;
+    }
+#endif
+    if (int r = reporter.run("test_core_thread_batched_ordinary_drain_yields_to_command_lane",
+                             [] { return test_core_thread_batched_ordinary_drain_yields_to_command_lane(); })) {
+      if (reporter.verbose()) reporter.print_summary();
+      reporter.print_fail_line("core_spine_smoke",
+                               "test_core_thread_batched_ordinary_drain_yields_to_command_lane",
+                               r);
+      return r;
+    }
+#if !CAMBANG_PROVIDER_BOUND
+    if (int r = reporter.run("test_core_thread_lane_capacities_and_ingress_congestion",
+                             [] { return test_core_thread_lane_capacities_and_ingress_congestion(); })) {
+      if (reporter.verbose()) reporter.print_summary();
+      reporter.print_fail_line("core_spine_smoke", "test_core_thread_lane_capacities_and_ingress_congestion", r);
+      return r;
+    }
+    if (int r = reporter.run("test_ingress_fair_share_frame_admission",
+                             [] { return test_ingress_fair_share_frame_admission(); })) {
+      if (reporter.verbose()) reporter.print_summary();
+      reporter.print_fail_line("core_spine_smoke", "test_ingress_fair_share_frame_admission", r);
+      return r;
+    }
+    if (int r = reporter.run("test_ingress_lone_stream_fills_ordinary_lane",
+                             [] { return test_ingress_lone_stream_fills_ordinary_lane(); })) {
+      if (reporter.verbose()) reporter.print_summary();
+      reporter.print_fail_line("core_spine_smoke", "test_ingress_lone_stream_fills_ordinary_lane", r);
+      return r;
+    }
+    if (int r = reporter.run("test_ingress_stream_priority_frame_admission",
+                             [] { return test_ingress_stream_priority_frame_admission(); })) {
+      if (reporter.verbose()) reporter.print_summary();
+      reporter.print_fail_line("core_spine_smoke", "test_ingress_stream_priority_frame_admission", r);
+      return r;
+    }
+#endif
+    if (int r = reporter.run("test_core_thread_task_timing_records_wait_and_exec",
+                             [] { return test_core_thread_task_timing_records_wait_and_exec(); })) {
+      if (reporter.verbose()) reporter.print_summary();
+      reporter.print_fail_line("core_spine_smoke", "test_core_thread_task_timing_records_wait_and_exec", r);
+      return r;
+    }
+    if (int r = reporter.run("test_timer_deadline_slack_coalesces_one_shot_wakes",
+                             [] { return test_timer_deadline_slack_coalesces_one_shot_wakes(); })) {
+      if (reporter.verbose()) reporter.print_summary();
+      reporter.print_fail_line("core_spine_smoke", "test_timer_deadline_slack_coalesces_one_shot_wakes", r);
+      return r;
+    }
+    if (int r = reporter.run("test_stream_qos_controller_hysteresis",
+                             [] { return test_stream_qos_controller_hysteresis(); })) {
+      if (reporter.verbose()) reporter.print_summary();
+      reporter.print_fail_line("core_spine_smoke", "test_stream_qos_controller_hysteresis", r);
+      return r;
+    }
     if (int r = reporter.run("test_publish_gating_before_start",
                              [] { return test_publish_gating_before_start(); })) {
       if (reporter.verbose()) reporter.print_summary();
@@ -4868,6 +7152,14 @@ int main(int argc, char** argv) {
                                r);
       return r;
     }
+    if (int r = reporter.run("test_stream_registry_tracks_shortest_started_frame_period",
+                             [] { return test_stream_registry_tracks_shortest_started_frame_period(); })) {
+      if (reporter.verbose()) reporter.print_summary();
+      reporter.print_fail_line("core_spine_smoke",
+                               "test_stream_registry_tracks_shortest_started_frame_period",
+                               r);
+      return r;
+    }
 
     CoreRuntime rt;
     StateSnapshotBuffer buf;
@@ -4934,6 +7226,16 @@ int main(int argc, char** argv) {
       reporter.print_fail_line("core_spine_smoke", "test_strict_destroy_rejects_started_stream_smoke", r);
       return r;
     }
+    if (int r = reporter.run("test_stream_pool_depth_hint_follows_retention_smoke",
+                             [&] {
+                               const int rc = test_stream_pool_depth_hint_follows_retention_smoke();
+                               if (rc != 0) rt.stop();
+                               return rc;
+                             })) {
+      if (reporter.verbose()) reporter.print_summary();
+      reporter.print_fail_line("core_spine_smoke", "test_stream_pool_depth_hint_follows_retention_smoke", r);
+      return r;
+    }
     if (int r = reporter.run("test_stream_start_stop_idempotency_survives_delayed_provider_facts_smoke",
                              [&] {
                                const int rc = test_stream_start_stop_idempotency_survives_delayed_provider_facts_smoke();
@@ -4986,12 +7288,24 @@ int main(int argc, char** argv) {
       reporter.print_fail_line("core_spine_smoke", "test_still_capture_profile_version_idempotency_smoke", r);
       return r;
     }
+    if (int r = reporter.run("test_setup_batch_smoke",
+                             [] { return test_setup_batch_smoke(); })) {
+      if (reporter.verbose()) reporter.print_summary();
+      reporter.print_fail_line("core_spine_smoke", "test_setup_batch_smoke", r);
+      return r;
+    }
     if (int r = reporter.run("test_rig_preflight_materialization_smoke",
                              [] { return test_rig_preflight_materialization_smoke(); })) {
       if (reporter.verbose()) reporter.print_summary();
       reporter.print_fail_line("core_spine_smoke", "test_rig_preflight_materialization_smoke", r);
       return r;
     }
+    if (int r = reporter.run("test_warm_pool_prediction_and_rig_prewarm_smoke",
+                             [] { return test_warm_pool_prediction_and_rig_prewarm_smoke(); })) {
+      if (reporter.verbose()) reporter.print_summary();
+      reporter.print_fail_line("core_spine_smoke", "test_warm_pool_prediction_and_rig_prewarm_smoke", r);
+      return r;
+    }
     if (int r = reporter.run("test_rig_cohort_admission_from_preflight_smoke",
                              [] { return test_rig_cohort_admission_from_preflight_smoke(); })) {
       if (reporter.verbose()) reporter.print_summary();
@@ -5034,12 +7348,48 @@ int main(int argc, char** argv) {
                                r);
       return r;
     }
+    if (int r = reporter.run("test_stream_history_capture_smoke",
+                             [] { return test_stream_history_capture_smoke(); })) {
+      if (reporter.verbose()) reporter.print_summary();
+      reporter.print_fail_line("core_spine_smoke", "test_stream_history_capture_smoke", r);
+      return r;
+    }
+    if (int r = reporter.run("test_capture_spill_medium_smoke",
+                             [] { return test_capture_spill_medium_smoke(); })) {
+      if (reporter.verbose()) reporter.print_summary();
+      reporter.print_fail_line("core_spine_smoke", "test_capture_spill_medium_smoke", r);
+      return r;
+    }
+    if (int r = reporter.run("test_frame_shard_retention_smoke",
+                             [] { return test_frame_shard_retention_smoke(); })) {
+      if (reporter.verbose()) reporter.print_summary();
+      reporter.print_fail_line("core_spine_smoke", "test_frame_shard_retention_smoke", r);
+      return r;
+    }
+    if (int r = reporter.run("test_snapshot_publish_offload_smoke",
+                             [] { return test_snapshot_publish_offload_smoke(); })) {
+      if (reporter.verbose()) reporter.print_summary();
+      reporter.print_fail_line("core_spine_smoke", "test_snapshot_publish_offload_smoke", r);
+      return r;
+    }
+    if (int r = reporter.run("test_async_command_completion_smoke",
+                             [] { return test_async_command_completion_smoke(); })) {
+      if (reporter.verbose()) reporter.print_summary();
+      reporter.print_fail_line("core_spine_smoke", "test_async_command_completion_smoke", r);
+      return r;
+    }
     if (int r = reporter.run("test_rig_orchestration_helper_smoke",
                              [] { return test_rig_orchestration_helper_smoke(); })) {
       if (reporter.verbose()) reporter.print_summary();
       reporter.print_fail_line("core_spine_smoke", "test_rig_orchestration_helper_smoke", r);
       return r;
     }
+    if (int r = reporter.run("test_capture_latency_histograms_smoke",
+                             [] { return test_capture_latency_histograms_smoke(); })) {
+      if (reporter.verbose()) reporter.print_summary();
+      reporter.print_fail_line("core_spine_smoke", "test_capture_latency_histograms_smoke", r);
+      return r;
+    }
     if (int r = reporter.run("test_server_facing_rig_orchestration_adapter_smoke",
                              [] { return test_server_facing_rig_orchestration_adapter_smoke(); })) {
       if (reporter.verbose()) reporter.print_summary();
@@ -5061,6 +7411,7 @@ int main(int argc, char** argv) {
   std::mt19937 rng(opt.seed);
 
   // Still do the pre-start gating check once.
+#if !CAMBANG_PROVIDER_BOUND
   if (int r = reporter.run("test_provider_callback_ingress_null_core_thread_drop_accounting",
                            [] { return test_provider_callback_ingress_null_core_thread_drop_accounting(); })) {
     if (reporter.verbose()) reporter.print_summary();
@@ -5077,6 +7428,7 @@ int main(int argc, char** argv) {
                              r);
     return r;
   }
+#endif
   if (int r = reporter.run("test_publish_gating_before_start",
                            [] { return test_publish_gating_before_start(); })) {
     if (reporter.verbose()) reporter.print_summary();
@@ -0,0 +1,412 @@
+/*
+CamBANG Maintainer Utility
+
+Tool: fleet_scale_bench
+
+Purpose
+-------
+Measures how one CoreRuntime scales with the number of live synthetic
+streams, to find where the single core thread saturates on a given host.
+
+Ramps from 1 to --max_streams synthetic devices (one started stream each,
+doubling per step), runs each step for --duration_ms of wall time with the
+provider ticked in real time, and writes one JSON curve. Each point reports
+core-thread utilization (summed CoreTaskTimingStats execution time over wall
+time), ingress frame drops (ProviderCallbackIngress::Stats), snapshot build
+time, host-side latest-result read latency, and resident memory per stream.
+
+Streams default to SyntheticFrameContentMode::Headless so the curve measures
+Core rather than the pattern renderer; --rendered puts rendering back in.
+
+Category
+--------
+Benchmark (maintainer).
+
+Non-Goals
+---------
+- Not a core invariant smoke test
+- Not deterministic: results depend on the host and its load
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if defined(__linux__)
+  #include <unistd.h>
+#endif
+
+#if !defined(CAMBANG_INTERNAL_SMOKE)
+  #error "fleet_scale_bench: build through the repo SCons maintainer_tools alias so CAMBANG_INTERNAL_SMOKE=1 is defined."
+#endif
+
+#include "core/core_runtime.h"
+#include "core/core_task_timing.h"
+#include "imaging/synthetic/provider.h"
+
+using namespace cambang;
+
+namespace {
+
+struct Options {
+  uint32_t max_streams = 64;
+  uint32_t duration_ms = 2000;
+  uint32_t width = 320;
+  uint32_t height = 240;
+  uint32_t fps = 30;
+  bool rendered = false;
+  std::string json_path;
+};
+
+// One ramp step. Counters are deltas over the measured window.
+struct Point {
+  uint32_t streams = 0;
+  uint32_t streams_started = 0;
+  uint64_t wall_ns = 0;
+  uint64_t frames_received = 0;
+  uint64_t core_exec_ns = 0;
+  uint64_t ingress_frames_dropped = 0;
+  uint64_t ingress_frames_coalesced = 0;
+  CoreLatencyHistogram snapshot_build{};
+  CoreLatencyHistogram ordinary_wait{};
+  CoreLatencyHistogram result_read{};
+  int64_t rss_delta_bytes = 0;
+};
+
+// Attached so Core builds and publishes snapshots as it would under a host.
+class DiscardingPublisher final : public IStateSnapshotPublisher {
+public:
+  void publish(std::shared_ptr<const CamBANGStateSnapshot> snapshot) override { (void)snapshot; }
+};
+
+void usage(const char* argv0) {
+  std::cerr << "Usage: " << argv0
+            << " [--max_streams=N] [--duration_ms=N] [--w=W] [--h=H] [--fps=N] [--rendered]"
+            << " [--json=PATH]\n\n"
+            << "Ramps 1, 2, 4, ... --max_streams (default 64) synthetic streams, each step for\n"
+            << "--duration_ms (default 2000) of wall time, and writes a JSON curve to --json or\n"
+            << "stdout. Streams are headless (shared zero payload) unless --rendered.\n";
+}
+
+bool starts_with(const std::string& s, const std::string& prefix) {
+  return s.rfind(prefix, 0) == 0;
+}
+
+bool parse_u32(const std::string& s, uint32_t& out) {
+  try {
+    size_t idx = 0;
+    const unsigned long v = std::stoul(s, &idx, 10);
+    if (idx != s.size()) return false;
+    out = static_cast<uint32_t>(v);
+    return true;
+  } catch (...) {
+    return false;
+  }
+}
+
+// false on a bad option; help sets `help`.
+bool parse_opts(int argc, char** argv, Options& opt, bool& help) {
+  help = false;
+  for (int i = 1; i < argc; ++i) {
+    const std::string a = argv[i];
+    uint32_t* target = nullptr;
+    size_t prefix = 0;
+    if (a == "--help" || a == "-h") {
+      help = true;
+      return true;
+    } else if (a == "--rendered") {
+      opt.rendered = true;
+      continue;
+    } else if (starts_with(a, "--json=")) {
+      opt.json_path = a.substr(7);
+      if (opt.json_path.empty()) {
+        std::cerr << "Invalid --json\n";
+        return false;
+      }
+      continue;
+    } else if (starts_with(a, "--max_streams=")) {
+      target = &opt.max_streams;
+      prefix = 14;
+    } else if (starts_with(a, "--duration_ms=")) {
+      target = &opt.duration_ms;
+      prefix = 14;
+    } else if (starts_with(a, "--w=")) {
+      target = &opt.width;
+      prefix = 4;
+    } else if (starts_with(a, "--h=")) {
+      target = &opt.height;
+      prefix = 4;
+    } else if (starts_with(a, "--fps=")) {
+      target = &opt.fps;
+      prefix = 6;
+    } else {
+      std::cerr << "Unknown option: " << a << "\n";
+      return false;
+    }
+    if (!parse_u32(a.substr(prefix), *target) || *target == 0) {
+      std::cerr << "Invalid " << a.substr(0, prefix - 1) << "\n";
+      return false;
+    }
+  }
+  return true;
+}
+
+uint64_t steady_ns() {
+  return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                   std::chrono::steady_clock::now().time_since_epoch())
+                                   .count());
+}
+
+// Resident set size; 0 where the platform offers no cheap reading.
+int64_t resident_bytes() {
+#if defined(__linux__)
+  std::ifstream statm("/proc/self/statm");
+  long long pages_total = 0;
+  long long pages_resident = 0;
+  if (statm >> pages_total >> pages_resident) {
+    return static_cast<int64_t>(pages_resident) * static_cast<int64_t>(sysconf(_SC_PAGESIZE));
+  }
+#endif
+  return 0;
+}
+
+void record(CoreLatencyHistogram& h, uint64_t ns) {
+  ++h.count;
+  h.total_ns += ns;
+  h.max_ns = std::max(h.max_ns, ns);
+  ++h.buckets[CoreLatencyHistogram::bucket_for(ns)];
+}
+
+CoreLatencyHistogram delta(const CoreLatencyHistogram& after, const CoreLatencyHistogram& before) {
+  CoreLatencyHistogram d{};
+  d.count = after.count - before.count;
+  d.total_ns = after.total_ns - before.total_ns;
+  // The window's own maximum is not recoverable; report the running one.
+  d.max_ns = after.max_ns;
+  for (size_t b = 0; b < CoreLatencyHistogram::kBuckets; ++b) {
+    d.buckets[b] = after.buckets[b] - before.buckets[b];
+  }
+  return d;
+}
+
+// Upper bound of the bucket holding the q-quantile sample.
+uint64_t quantile_upper_ns(const CoreLatencyHistogram& h, double q) {
+  if (h.count == 0) {
+    return 0;
+  }
+  const uint64_t rank = static_cast<uint64_t>(q * static_cast<double>(h.count - 1)) + 1;
+  uint64_t seen = 0;
+  for (size_t b = 0; b < CoreLatencyHistogram::kBuckets; ++b) {
+    seen += h.buckets[b];
+    if (seen >= rank) {
+      const uint64_t upper = CoreLatencyHistogram::bucket_upper_ns(b);
+      return upper != 0 ? upper : h.max_ns;
+    }
+  }
+  return h.max_ns;
+}
+
+uint64_t core_exec_ns(const CoreTaskTimingStats& s) {
+  // FRAME_DISPATCH and SNAPSHOT_BUILD run inside the other kinds' tasks.
+  return s.exec[static_cast<size_t>(CoreTaskKind::ESSENTIAL)].total_ns +
+         s.exec[static_cast<size_t>(CoreTaskKind::COMMAND)].total_ns +
+         s.exec[static_cast<size_t>(CoreTaskKind::ORDINARY)].total_ns +
+         s.exec[static_cast<size_t>(CoreTaskKind::TIMER_TICK)].total_ns;
+}
+
+uint64_t frames_dropped(const ProviderCallbackIngress::Stats& s) {
+  return s.frames_dropped_full + s.frames_dropped_closed + s.frames_dropped_allocfail + s.frames_dropped_fair_share;
+}
+
+bool wait_live(CoreRuntime& rt) {
+  for (int i = 0; i < 500; ++i) {
+    if (rt.state_copy() == CoreRuntimeState::LIVE) {
+      return true;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+  }
+  return false;
+}
+
+bool run_point(const Options& opt, uint32_t streams, Point& out) {
+  constexpr uint64_t kDeviceBase = 100000;
+  constexpr uint64_t kRootBase = 200000;
+  constexpr uint64_t kStreamBase = 300000;
+  out.streams = streams;
+
+  CoreRuntime rt;
+  DiscardingPublisher publisher;
+  rt.set_snapshot_publisher(&publisher);
+  if (!rt.start() || !wait_live(rt)) {
+    std::cerr << "fleet_scale_bench: core runtime did not reach LIVE\n";
+    rt.stop();
+    return false;
+  }
+  const int64_t rss_before = resident_bytes();
+
+  SyntheticProviderConfig cfg{};
+  cfg.endpoint_count = streams;
+  cfg.nominal.width = opt.width;
+  cfg.nominal.height = opt.height;
+  cfg.nominal.format_fourcc = FOURCC_RGBA;
+  cfg.nominal.fps_num = opt.fps;
+  cfg.nominal.fps_den = 1;
+  cfg.frame_content_mode = opt.rendered ? SyntheticFrameContentMode::Rendered : SyntheticFrameContentMode::Headless;
+  SyntheticProvider provider(cfg);
+  std::vector<CameraEndpoint> endpoints;
+  if (!provider.initialize(rt.provider_callbacks()).ok() || !provider.enumerate_endpoints(endpoints).ok() ||
+      endpoints.size() < streams) {
+    std::cerr << "fleet_scale_bench: provider setup failed\n";
+    (void)provider.shutdown();
+    rt.stop();
+    return false;
+  }
+  rt.attach_provider(&provider);
+
+  CaptureProfile profile{};
+  profile.width = opt.width;
+  profile.height = opt.height;
+  profile.format_fourcc = FOURCC_RGBA;
+  profile.target_fps_min = opt.fps;
+  profile.target_fps_max = opt.fps;
+  for (uint32_t i = 0; i < streams; ++i) {
+    if (rt.try_open_device(endpoints[i].hardware_id, kDeviceBase + i, kRootBase + i) == TryOpenDeviceStatus::OK &&
+        rt.try_create_stream(kStreamBase + i, kDeviceBase + i, StreamIntent::PREVIEW, &profile, nullptr, 0) ==
+            TryCreateStreamStatus::OK &&
+        rt.try_start_stream(kStreamBase + i) == TryStartStreamStatus::OK) {
+      ++out.streams_started;
+    }
+  }
+
+  const CoreRuntime::Stats stats_before = rt.stats_copy();
+  const ProviderCallbackIngress::Stats ingress_before = rt.ingress_stats_copy();
+  const CoreDispatchStats dispatch_before = rt.dispatcher_stats();
+
+  // Tick the provider in real time at about 1 ms, as a free-running host
+  // tick does, and poll every stream's latest result once per tick.
+  const uint64_t begin_ns = steady_ns();
+  const uint64_t end_ns = begin_ns + static_cast<uint64_t>(opt.duration_ms) * 1'000'000ull;
+  uint64_t last_ns = begin_ns;
+  while (true) {
+    const uint64_t now_ns = steady_ns();
+    if (now_ns >= end_ns) {
+      break;
+    }
+    provider.advance(now_ns - last_ns, false, false);
+    last_ns = now_ns;
+    for (uint32_t i = 0; i < streams; ++i) {
+      const uint64_t read_t0 = steady_ns();
+      (void)rt.get_latest_stream_result(kStreamBase + i);
+      record(out.result_read, steady_ns() - read_t0);
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  out.wall_ns = steady_ns() - begin_ns;
+
+  const CoreRuntime::Stats stats_after = rt.stats_copy();
+  const ProviderCallbackIngress::Stats ingress_after = rt.ingress_stats_copy();
+  const CoreDispatchStats dispatch_after = rt.dispatcher_stats();
+  out.rss_delta_bytes = resident_bytes() - rss_before;
+  out.frames_received = dispatch_after.frames_received - dispatch_before.frames_received;
+  out.core_exec_ns = core_exec_ns(stats_after.task_timing) - core_exec_ns(stats_before.task_timing);
+  out.ingress_frames_dropped = frames_dropped(ingress_after) - frames_dropped(ingress_before);
+  out.ingress_frames_coalesced = ingress_after.frames_coalesced_latest_wins - ingress_before.frames_coalesced_latest_wins;
+  constexpr size_t kSnapshotBuild = static_cast<size_t>(CoreTaskKind::SNAPSHOT_BUILD);
+  constexpr size_t kOrdinary = static_cast<size_t>(CoreTaskKind::ORDINARY);
+  out.snapshot_build = delta(stats_after.task_timing.exec[kSnapshotBuild], stats_before.task_timing.exec[kSnapshotBuild]);
+  out.ordinary_wait = delta(stats_after.task_timing.queue_wait[kOrdinary], stats_before.task_timing.queue_wait[kOrdinary]);
+
+  for (uint32_t i = 0; i < streams; ++i) {
+    (void)rt.try_stop_stream(kStreamBase + i);
+    (void)rt.try_destroy_stream(kStreamBase + i);
+    (void)rt.try_close_device(kDeviceBase + i);
+  }
+  (void)provider.shutdown();
+  rt.stop();
+  rt.attach_provider(nullptr);
+  rt.set_snapshot_publisher(nullptr);
+  return true;
+}
+
+void write_histogram(std::ostream& json, const char* name, const CoreLatencyHistogram& h) {
+  json << ",\"" << name << "\":{\"count\":" << h.count
+       << ",\"mean_ns\":" << (h.count ? h.total_ns / h.count : 0)
+       << ",\"p50_ns\":" << quantile_upper_ns(h, 0.50)
+       << ",\"p99_ns\":" << quantile_upper_ns(h, 0.99)
+       << ",\"max_ns\":" << h.max_ns << "}";
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  Options opt;
+  bool help = false;
+  if (!parse_opts(argc, argv, opt, help)) {
+    usage(argv[0]);
+    return 2;
+  }
+  if (help) {
+    usage(argv[0]);
+    return 0;
+  }
+
+  std::ofstream json_file;
+  if (!opt.json_path.empty()) {
+    json_file.open(opt.json_path);
+    if (!json_file) {
+      std::cerr << "Cannot write --json " << opt.json_path << "\n";
+      return 2;
+    }
+  }
+  std::ostream& json = opt.json_path.empty() ? std::cout : json_file;
+
+  json << "{\"tool\":\"fleet_scale_bench\",\"schema\":1,\"width\":" << opt.width << ",\"height\":" << opt.height
+       << ",\"fps\":" << opt.fps << ",\"duration_ms\":" << opt.duration_ms
+       << ",\"frame_content\":\"" << (opt.rendered ? "rendered" : "headless") << "\""
+       << ",\"hardware_concurrency\":" << std::thread::hardware_concurrency() << ",\"points\":[";
+
+  // First step whose core thread is >= 90% busy or drops frames at ingress.
+  uint32_t saturation_streams = 0;
+  bool first = true;
+  for (uint32_t streams = 1;; streams = std::min(streams * 2u, opt.max_streams)) {
+    Point p;
+    if (!run_point(opt, streams, p)) {
+      return 1;
+    }
+    const double utilization =
+        p.wall_ns ? static_cast<double>(p.core_exec_ns) / static_cast<double>(p.wall_ns) : 0.0;
+    const double frames_per_sec =
+        p.wall_ns ? static_cast<double>(p.frames_received) * 1e9 / static_cast<double>(p.wall_ns) : 0.0;
+    if (saturation_streams == 0 && (utilization >= 0.9 || p.ingress_frames_dropped > 0)) {
+      saturation_streams = streams;
+    }
+    json << (first ? "\n" : ",\n") << "{\"streams\":" << p.streams << ",\"streams_started\":" << p.streams_started
+         << ",\"wall_ns\":" << p.wall_ns << ",\"frames_received\":" << p.frames_received
+         << ",\"frames_per_sec\":" << frames_per_sec << ",\"core_utilization\":" << utilization
+         << ",\"ingress_frames_dropped\":" << p.ingress_frames_dropped
+         << ",\"ingress_frames_coalesced\":" << p.ingress_frames_coalesced;
+    write_histogram(json, "snapshot_build", p.snapshot_build);
+    write_histogram(json, "ordinary_queue_wait", p.ordinary_wait);
+    write_histogram(json, "result_read", p.result_read);
+    json << ",\"rss_bytes_per_stream\":" << (p.rss_delta_bytes / static_cast<int64_t>(streams)) << "}";
+    first = false;
+    std::cerr << "fleet_scale_bench: streams=" << streams << " core_utilization=" << utilization
+              << " frames_per_sec=" << frames_per_sec << " ingress_dropped=" << p.ingress_frames_dropped << "\n";
+    if (streams >= opt.max_streams) {
+      break;
+    }
+  }
+  json << "\n],\"saturation_streams\":";
+  if (saturation_streams == 0) {
+    json << "null";
+  } else {
+    json << saturation_streams;
+  }
+  json << "}\n";
+  return 0;
+}
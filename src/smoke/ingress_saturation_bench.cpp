@@ -0,0 +1,488 @@
+/*
+CamBANG Maintainer Utility
+
+Tool: ingress_saturation_bench
+
+Purpose
+-------
+Floods one CoreThread with repeating stream frames from several producer
+threads while command-lane work is injected, to quantify the lane-priority
+guarantees in core_thread.h and give the mailbox a regression target.
+
+Each of --producers threads owns --streams_per_producer streams and posts
+frames as fast as it can (or at --fps per stream). The "ingress" phase
+calls ProviderCallbackIngress::on_frame() directly from the producer
+threads; the "strand" phase posts through one CBProviderStrand per producer,
+as real providers do. The ingress sink stands in for frame dispatch: it
+spins --dispatch_us per frame on the core thread and releases the frame, so
+an ordinary-lane backlog builds whenever producers outpace it. A separate
+thread posts a no-op command every 1/--command_hz through
+CoreThread::try_post_command().
+
+Each phase reports enqueue latency (time inside on_frame()/post_frame()),
+end-to-end latency (post to sink), command latency (try_post_command() to
+execution), CoreThread's own ordinary/command queue-wait histograms, and
+every ProviderCallbackIngress::Stats field (frame fields also as a fraction
+of frames posted). Strand-ring drops are the frames neither dispatched nor
+dropped at ingress.
+
+Category
+--------
+Benchmark (maintainer).
+
+Non-Goals
+---------
+- Not a core invariant smoke test
+- Not deterministic: results depend on the host and its load
+- Does not run CoreRuntime; frames are not retained
+*/
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if !defined(CAMBANG_INTERNAL_SMOKE)
+  #error "ingress_saturation_bench: build through the repo SCons maintainer_tools alias so CAMBANG_INTERNAL_SMOKE=1 is defined."
+#endif
+
+#include "core/core_task_timing.h"
+#include "core/core_thread.h"
+#include "core/provider_callback_ingress.h"
+#include "imaging/api/provider_strand.h"
+
+using namespace cambang;
+
+namespace {
+
+struct Options {
+  uint32_t producers = 4;
+  uint32_t streams_per_producer = 2;
+  uint32_t fps = 0; // 0: unpaced flood
+  uint32_t duration_ms = 2000;
+  uint32_t dispatch_us = 20;
+  uint32_t command_hz = 1000;
+  uint32_t latest_wins = 0;
+  std::string path = "both";
+  std::string json_path;
+};
+
+void usage(const char* argv0) {
+  std::cerr << "Usage: " << argv0
+            << " [--producers=N] [--streams_per_producer=N] [--fps=N] [--duration_ms=N] [--dispatch_us=N]"
+            << " [--command_hz=N] [--latest_wins=N] [--path=ingress|strand|both] [--json=PATH]\n\n"
+            << "Floods a CoreThread with frames from --producers (default 4) threads, unpaced unless\n"
+            << "--fps is given, while injecting --command_hz (default 1000) command-lane tasks; the sink\n"
+            << "spends --dispatch_us (default 20) per frame. Each --path phase runs --duration_ms\n"
+            << "(default 2000) and the JSON goes to --json or stdout.\n";
+}
+
+bool starts_with(const std::string& s, const std::string& prefix) {
+  return s.rfind(prefix, 0) == 0;
+}
+
+bool parse_u32(const std::string& s, uint32_t& out) {
+  try {
+    size_t idx = 0;
+    const unsigned long v = std::stoul(s, &idx, 10);
+    if (idx != s.size()) return false;
+    out = static_cast<uint32_t>(v);
+    return true;
+  } catch (...) {
+    return false;
+  }
+}
+
+// false on a bad option; help sets `help`.
+bool parse_opts(int argc, char** argv, Options& opt, bool& help) {
+  help = false;
+  for (int i = 1; i < argc; ++i) {
+    const std::string a = argv[i];
+    uint32_t* target = nullptr;
+    size_t prefix = 0;
+    bool allow_zero = false;
+    if (a == "--help" || a == "-h") {
+      help = true;
+      return true;
+    } else if (starts_with(a, "--json=")) {
+      opt.json_path = a.substr(7);
+      if (opt.json_path.empty()) {
+        std::cerr << "Invalid --json\n";
+        return false;
+      }
+      continue;
+    } else if (starts_with(a, "--path=")) {
+      opt.path = a.substr(7);
+      if (opt.path != "ingress" && opt.path != "strand" && opt.path != "both") {
+        std::cerr << "Invalid --path\n";
+        return false;
+      }
+      continue;
+    } else if (starts_with(a, "--producers=")) {
+      target = &opt.producers;
+      prefix = 12;
+    } else if (starts_with(a, "--streams_per_producer=")) {
+      target = &opt.streams_per_producer;
+      prefix = 23;
+    } else if (starts_with(a, "--fps=")) {
+      target = &opt.fps;
+      prefix = 6;
+      allow_zero = true;
+    } else if (starts_with(a, "--duration_ms=")) {
+      target = &opt.duration_ms;
+      prefix = 14;
+    } else if (starts_with(a, "--dispatch_us=")) {
+      target = &opt.dispatch_us;
+      prefix = 14;
+      allow_zero = true;
+    } else if (starts_with(a, "--command_hz=")) {
+      target = &opt.command_hz;
+      prefix = 13;
+    } else if (starts_with(a, "--latest_wins=")) {
+      target = &opt.latest_wins;
+      prefix = 14;
+      allow_zero = true;
+    } else {
+      std::cerr << "Unknown option: " << a << "\n";
+      return false;
+    }
+    if (!parse_u32(a.substr(prefix), *target) || (*target == 0 && !allow_zero)) {
+      std::cerr << "Invalid " << a.substr(0, prefix - 1) << "\n";
+      return false;
+    }
+  }
+  return true;
+}
+
+uint64_t steady_ns() {
+  return CoreThread::steady_now_ns();
+}
+
+void record(CoreLatencyHistogram& h, uint64_t ns) {
+  ++h.count;
+  h.total_ns += ns;
+  h.max_ns = std::max(h.max_ns, ns);
+  ++h.buckets[CoreLatencyHistogram::bucket_for(ns)];
+}
+
+void merge(CoreLatencyHistogram& into, const CoreLatencyHistogram& from) {
+  into.count += from.count;
+  into.total_ns += from.total_ns;
+  into.max_ns = std::max(into.max_ns, from.max_ns);
+  for (size_t b = 0; b < CoreLatencyHistogram::kBuckets; ++b) {
+    into.buckets[b] += from.buckets[b];
+  }
+}
+
+// Upper bound of the bucket holding the q-quantile sample.
+uint64_t quantile_upper_ns(const CoreLatencyHistogram& h, double q) {
+  if (h.count == 0) {
+    return 0;
+  }
+  const uint64_t rank = static_cast<uint64_t>(q * static_cast<double>(h.count - 1)) + 1;
+  uint64_t seen = 0;
+  for (size_t b = 0; b < CoreLatencyHistogram::kBuckets; ++b) {
+    seen += h.buckets[b];
+    if (seen >= rank) {
+      const uint64_t upper = CoreLatencyHistogram::bucket_upper_ns(b);
+      return upper != 0 ? upper : h.max_ns;
+    }
+  }
+  return h.max_ns;
+}
+
+// Post times by frame sequence. Frames in flight are bounded by the strand
+// ring plus the ordinary lane (well under kPostSlots), so a slot is never
+// reused while its frame is still queued.
+constexpr uint64_t kPostSlots = 1u << 16;
+constexpr unsigned kProducerShift = 48;
+
+struct Producer {
+  uint32_t index = 0;
+  std::unique_ptr<std::array<std::atomic<uint64_t>, kPostSlots>> post_ns =
+      std::make_unique<std::array<std::atomic<uint64_t>, kPostSlots>>();
+  std::atomic<uint64_t> released{0};
+  uint64_t posted = 0;
+  CoreLatencyHistogram enqueue{};
+  std::unique_ptr<CBProviderStrand> strand;
+};
+
+// Core-thread-only state; read after the phase's CoreThread has stopped.
+struct SinkState {
+  std::vector<Producer>* producers = nullptr;
+  uint64_t dispatch_ns = 0;
+  uint64_t frames_dispatched = 0;
+  CoreLatencyHistogram end_to_end{};
+  CoreLatencyHistogram command{};
+  uint64_t commands_executed = 0;
+};
+
+struct PhaseResult {
+  std::string path;
+  uint64_t wall_ns = 0;
+  uint64_t frames_posted = 0;
+  uint64_t frames_dispatched = 0;
+  uint64_t frames_released = 0;
+  uint64_t commands_posted = 0;
+  uint64_t commands_rejected = 0;
+  uint64_t commands_executed = 0;
+  CoreLatencyHistogram enqueue{};
+  CoreLatencyHistogram end_to_end{};
+  CoreLatencyHistogram command{};
+  CoreTaskTimingStats task_timing{};
+  ProviderCallbackIngress::Stats ingress{};
+};
+
+void produce(const Options& opt, Producer& p, ProviderCallbackIngress& ingress, uint64_t end_ns) {
+  uint8_t pixel[4] = {0x10, 0x20, 0x30, 0xff};
+  FrameView frame{};
+  frame.device_instance_id = 1 + p.index;
+  frame.width = 1;
+  frame.height = 1;
+  frame.format_fourcc = FOURCC_RGBA;
+  frame.data = pixel;
+  frame.size_bytes = sizeof(pixel);
+  frame.stride_bytes = 4;
+  frame.release = [](void* user, const FrameView*) {
+    static_cast<Producer*>(user)->released.fetch_add(1, std::memory_order_relaxed);
+  };
+  frame.release_user = &p;
+
+  const uint64_t period_ns = opt.fps ? 1'000'000'000ull / (static_cast<uint64_t>(opt.fps) * opt.streams_per_producer) : 0;
+  uint64_t deadline_ns = steady_ns();
+  uint64_t sequence = 0;
+  while (true) {
+    const uint64_t now_ns = steady_ns();
+    if (now_ns >= end_ns) {
+      break;
+    }
+    if (period_ns != 0 && now_ns < deadline_ns) {
+      std::this_thread::sleep_for(std::chrono::nanoseconds(deadline_ns - now_ns));
+      continue;
+    }
+    deadline_ns += period_ns;
+    frame.stream_id = 1 + static_cast<uint64_t>(p.index) * opt.streams_per_producer +
+                      sequence % opt.streams_per_producer;
+    // The frame's sequence (and producer) ride in trace_id, which the strand
+    // keeps when nonzero; the sink reads its post time back through it.
+    frame.trace_id = (static_cast<uint64_t>(p.index + 1) << kProducerShift) | sequence;
+    const uint64_t t0 = steady_ns();
+    (*p.post_ns)[sequence % kPostSlots].store(t0, std::memory_order_relaxed);
+    if (p.strand) {
+      p.strand->post_frame(frame);
+    } else {
+      ingress.on_frame(frame);
+    }
+    record(p.enqueue, steady_ns() - t0);
+    ++p.posted;
+    ++sequence;
+  }
+}
+
+void sink_frame(SinkState& s, ProviderToCoreCommand&& cmd) {
+  if (cmd.type != ProviderToCoreCommandType::PROVIDER_FRAME) {
+    return;
+  }
+  FrameView& frame = std::get<CmdProviderFrame>(cmd.payload).frame;
+  const uint64_t now_ns = steady_ns();
+  const uint64_t producer = (frame.trace_id >> kProducerShift) - 1;
+  const uint64_t sequence = frame.trace_id & ((uint64_t{1} << kProducerShift) - 1);
+  const uint64_t posted_ns =
+      (*(*s.producers)[producer].post_ns)[sequence % kPostSlots].load(std::memory_order_relaxed);
+  record(s.end_to_end, now_ns - std::min(now_ns, posted_ns));
+  ++s.frames_dispatched;
+  // Stand-in for frame dispatch and retention work.
+  const uint64_t done_ns = now_ns + s.dispatch_ns;
+  while (steady_ns() < done_ns) {
+  }
+  frame.release_now();
+}
+
+bool run_phase(const Options& opt, const std::string& path, PhaseResult& out) {
+  out.path = path;
+  struct NoopHooks final : CoreThread::IHooks {} hooks;
+  CoreThread core;
+  if (!core.start(&hooks)) {
+    std::cerr << "ingress_saturation_bench: CoreThread did not start\n";
+    return false;
+  }
+
+  std::vector<Producer> producers(opt.producers);
+  SinkState sink;
+  sink.producers = &producers;
+  sink.dispatch_ns = static_cast<uint64_t>(opt.dispatch_us) * 1000u;
+  ProviderCallbackIngress ingress(
+      &core,
+      [&sink](ProviderToCoreCommand&& cmd) { sink_frame(sink, std::move(cmd)); },
+      []() -> uint64_t { return steady_ns(); },
+      [](uint64_t) { return false; });
+  ingress.set_latest_wins_frames_per_stream(opt.latest_wins);
+
+  for (uint32_t i = 0; i < opt.producers; ++i) {
+    producers[i].index = i;
+    if (path == "strand") {
+      producers[i].strand = std::make_unique<CBProviderStrand>();
+      if (!producers[i].strand->start(&ingress, "bench_producer")) {
+        std::cerr << "ingress_saturation_bench: strand did not start\n";
+        core.stop();
+        return false;
+      }
+    }
+  }
+
+  const uint64_t begin_ns = steady_ns();
+  const uint64_t end_ns = begin_ns + static_cast<uint64_t>(opt.duration_ms) * 1'000'000ull;
+  std::vector<std::thread> threads;
+  threads.reserve(opt.producers);
+  for (Producer& p : producers) {
+    threads.emplace_back(produce, std::cref(opt), std::ref(p), std::ref(ingress), end_ns);
+  }
+
+  // Command injector, on this thread.
+  const uint64_t command_period_ns = 1'000'000'000ull / opt.command_hz;
+  for (uint64_t next_ns = begin_ns; next_ns < end_ns; next_ns += command_period_ns) {
+    const uint64_t now_ns = steady_ns();
+    if (now_ns < next_ns) {
+      std::this_thread::sleep_for(std::chrono::nanoseconds(next_ns - now_ns));
+    }
+    const uint64_t posted_ns = steady_ns();
+    const CoreThread::PostResult r = core.try_post_command([&sink, posted_ns]() {
+      record(sink.command, steady_ns() - posted_ns);
+      ++sink.commands_executed;
+    });
+    ++out.commands_posted;
+    if (r != CoreThread::PostResult::Enqueued) {
+      ++out.commands_rejected;
+    }
+  }
+
+  for (std::thread& t : threads) {
+    t.join();
+  }
+  for (Producer& p : producers) {
+    if (p.strand) {
+      p.strand->flush();
+      p.strand->stop();
+    }
+  }
+  // Let the backlog drain so every posted frame is dispatched or released.
+  for (int i = 0; i < 5000 && core.ordinary_lane_pending() != 0; ++i) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  out.wall_ns = steady_ns() - begin_ns;
+  out.task_timing = core.task_timing_copy();
+  core.stop();
+
+  out.ingress = ingress.stats_copy();
+  out.frames_dispatched = sink.frames_dispatched;
+  out.commands_executed = sink.commands_executed;
+  out.end_to_end = sink.end_to_end;
+  out.command = sink.command;
+  for (const Producer& p : producers) {
+    out.frames_posted += p.posted;
+    out.frames_released += p.released.load(std::memory_order_relaxed);
+    merge(out.enqueue, p.enqueue);
+  }
+  return true;
+}
+
+void write_histogram(std::ostream& json, const char* name, const CoreLatencyHistogram& h) {
+  json << ",\"" << name << "\":{\"count\":" << h.count
+       << ",\"mean_ns\":" << (h.count ? h.total_ns / h.count : 0)
+       << ",\"p50_ns\":" << quantile_upper_ns(h, 0.50)
+       << ",\"p99_ns\":" << quantile_upper_ns(h, 0.99)
+       << ",\"max_ns\":" << h.max_ns << "}";
+}
+
+void write_drop(std::ostream& json, const char* name, uint64_t count, uint64_t posted) {
+  json << ",\"" << name << "\":{\"count\":" << count
+       << ",\"rate\":" << (posted ? static_cast<double>(count) / static_cast<double>(posted) : 0.0) << "}";
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  Options opt;
+  bool help = false;
+  if (!parse_opts(argc, argv, opt, help)) {
+    usage(argv[0]);
+    return 2;
+  }
+  if (help) {
+    usage(argv[0]);
+    return 0;
+  }
+
+  std::ofstream json_file;
+  if (!opt.json_path.empty()) {
+    json_file.open(opt.json_path);
+    if (!json_file) {
+      std::cerr << "Cannot write --json " << opt.json_path << "\n";
+      return 2;
+    }
+  }
+  std::ostream& json = opt.json_path.empty() ? std::cout : json_file;
+
+  json << "{\"tool\":\"ingress_saturation_bench\",\"schema\":1,\"producers\":" << opt.producers
+       << ",\"streams_per_producer\":" << opt.streams_per_producer << ",\"fps\":" << opt.fps
+       << ",\"dispatch_us\":" << opt.dispatch_us << ",\"command_hz\":" << opt.command_hz
+       << ",\"latest_wins\":" << opt.latest_wins << ",\"duration_ms\":" << opt.duration_ms
+       << ",\"hardware_concurrency\":" << std::thread::hardware_concurrency() << ",\"phases\":[";
+
+  std::vector<std::string> paths;
+  if (opt.path != "strand") paths.push_back("ingress");
+  if (opt.path != "ingress") paths.push_back("strand");
+  bool first = true;
+  for (const std::string& path : paths) {
+    PhaseResult p;
+    if (!run_phase(opt, path, p)) {
+      return 1;
+    }
+    const ProviderCallbackIngress::Stats& s = p.ingress;
+    const uint64_t ingress_dropped = s.frames_dropped_full + s.frames_dropped_closed + s.frames_dropped_allocfail +
+                                     s.frames_dropped_fair_share + s.frames_coalesced_latest_wins;
+    const uint64_t accounted = p.frames_dispatched + ingress_dropped;
+    const uint64_t strand_dropped = p.frames_posted > accounted ? p.frames_posted - accounted : 0;
+    constexpr size_t kOrdinary = static_cast<size_t>(CoreTaskKind::ORDINARY);
+    constexpr size_t kCommand = static_cast<size_t>(CoreTaskKind::COMMAND);
+    json << (first ? "\n" : ",\n") << "{\"path\":\"" << p.path << "\",\"wall_ns\":" << p.wall_ns
+         << ",\"frames_posted\":" << p.frames_posted << ",\"frames_dispatched\":" << p.frames_dispatched
+         << ",\"frames_released\":" << p.frames_released << ",\"commands_posted\":" << p.commands_posted
+         << ",\"commands_rejected\":" << p.commands_rejected << ",\"commands_executed\":" << p.commands_executed;
+    write_histogram(json, "enqueue", p.enqueue);
+    write_histogram(json, "end_to_end", p.end_to_end);
+    write_histogram(json, "command", p.command);
+    write_histogram(json, "ordinary_queue_wait", p.task_timing.queue_wait[kOrdinary]);
+    write_histogram(json, "command_queue_wait", p.task_timing.queue_wait[kCommand]);
+    json << ",\"drops\":{\"posted\":" << p.frames_posted;
+    write_drop(json, "frames_dropped_full", s.frames_dropped_full, p.frames_posted);
+    write_drop(json, "frames_dropped_closed", s.frames_dropped_closed, p.frames_posted);
+    write_drop(json, "frames_dropped_allocfail", s.frames_dropped_allocfail, p.frames_posted);
+    write_drop(json, "frames_dropped_fair_share", s.frames_dropped_fair_share, p.frames_posted);
+    write_drop(json, "frames_coalesced_latest_wins", s.frames_coalesced_latest_wins, p.frames_posted);
+    write_drop(json, "frames_released_on_drop_full", s.frames_released_on_drop_full, p.frames_posted);
+    write_drop(json, "frames_released_on_drop_closed", s.frames_released_on_drop_closed, p.frames_posted);
+    write_drop(json, "frames_released_on_drop_allocfail", s.frames_released_on_drop_allocfail, p.frames_posted);
+    json << ",\"commands_dropped_full\":" << s.commands_dropped_full;
+    json << ",\"commands_dropped_closed\":" << s.commands_dropped_closed;
+    json << ",\"commands_dropped_allocfail\":" << s.commands_dropped_allocfail;
+    json << ",\"non_frame_rejected_closed\":" << s.non_frame_rejected_closed;
+    json << ",\"non_frame_rejected_allocfail\":" << s.non_frame_rejected_allocfail;
+    write_drop(json, "strand_dropped", strand_dropped, p.frames_posted);
+    json << "}}";
+    first = false;
+    std::cerr << "ingress_saturation_bench: path=" << p.path << " posted=" << p.frames_posted
+              << " dispatched=" << p.frames_dispatched << " ingress_dropped=" << ingress_dropped
+              << " strand_dropped=" << strand_dropped << " command_p99_ns=" << quantile_upper_ns(p.command, 0.99)
+              << "\n";
+  }
+  json << "\n]}\n";
+  return 0;
+}
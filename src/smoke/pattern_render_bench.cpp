@@ -10,6 +10,11 @@ Benchmarks the CPU pattern renderer used by SyntheticProvider.
 Measures frame generation throughput and approximate memory bandwidth for
 different patterns and resolutions.
 
+With --suite, one run sweeps every registered preset, both packed formats,
+several resolutions, overlay on/off and band worker counts, and writes one
+machine-readable JSON report. Passing a previous report as --baseline
+flags cases whose p50 frame time regressed beyond --threshold_pct.
+
 Category
 --------
 Benchmark (maintainer).
@@ -20,10 +25,15 @@ Non-Goals
 - Not a user-facing test harness (Godot)
 */
 
+#include <algorithm>
 #include <chrono>
 #include <cstdint>
+#include <cstdio>
 #include <cstring>
+#include <fstream>
 #include <iostream>
+#include <map>
+#include <sstream>
 #include <string>
 #include <vector>
 
@@ -32,6 +42,7 @@ Non-Goals
 #endif
 
 #include "pixels/pattern/cpu_packed_pattern_renderer.h"
+#include "pixels/pattern/pattern_band_pool.h"
 #include "imaging/api/provider_contract_datatypes.h"
 
 using namespace cambang;
@@ -44,6 +55,15 @@ struct Options {
   uint32_t frames = 2000;
   bool overlay = true;
   bool bgra = false;
+  uint32_t band_workers = 0;
+  bool band_workers_set = false;
+
+  bool suite = false;
+  bool frames_set = false;
+  std::string resolutions = "640x480,1280x720,1920x1080";
+  std::string json_path;
+  std::string baseline_path;
+  uint32_t threshold_pct = 10;
 
   std::string pattern_name = "xy_xor";
   uint32_t seed = 0;
@@ -70,7 +90,15 @@ static void usage(const char* argv0) {
   std::cerr
       << "Usage: " << argv0
       << " [--pattern=<name>] [--seed=N] [--checker_size=PX] [--rgba=R,G,B[,A]]"
-      << " [--w=W] [--h=H] [--frames=N] [--no_overlay] [--bgra]\n\n"
+      << " [--w=W] [--h=H] [--frames=N] [--no_overlay] [--bgra] [--band_workers=N]\n"
+      << "       " << argv0
+      << " --suite [--seed=N] [--frames=N] [--resolutions=WxH[,WxH...]] [--band_workers=N]"
+      << " [--json=PATH] [--baseline=PATH] [--threshold_pct=N]\n\n"
+      << "--suite sweeps every pattern, RGBA8/BGRA8, each resolution, overlay on/off and\n"
+      << "band workers {0, 2, 4} (or {0, N} with --band_workers=N), writing JSON to --json\n"
+      << "or stdout. --baseline compares p50 frame time per case against a previous\n"
+      << "report; any case slower by more than --threshold_pct (default 10) and by at\n"
+      << "least 1us exits 3.\n\n"
       << "Available patterns:\n";
   for (size_t i = 0; i < n; ++i) {
     std::cerr << "  - " << presets[i].name << "\n";
@@ -188,6 +216,46 @@ static ParseOptsResult parse_opts(int argc, char** argv, Options& opt) {
         std::cerr << "Invalid --frames\n";
         return ParseOptsResult::Error;
       }
+      opt.frames_set = true;
+      continue;
+    }
+    if (starts_with(a, "--band_workers=")) {
+      if (!parse_u32(a.substr(15), opt.band_workers)) {
+        std::cerr << "Invalid --band_workers\n";
+        return ParseOptsResult::Error;
+      }
+      opt.band_workers_set = true;
+      continue;
+    }
+    if (a == "--suite") {
+      opt.suite = true;
+      continue;
+    }
+    if (starts_with(a, "--resolutions=")) {
+      opt.resolutions = a.substr(14);
+      continue;
+    }
+    if (starts_with(a, "--json=")) {
+      opt.json_path = a.substr(7);
+      if (opt.json_path.empty()) {
+        std::cerr << "Invalid --json\n";
+        return ParseOptsResult::Error;
+      }
+      continue;
+    }
+    if (starts_with(a, "--baseline=")) {
+      opt.baseline_path = a.substr(11);
+      if (opt.baseline_path.empty()) {
+        std::cerr << "Invalid --baseline\n";
+        return ParseOptsResult::Error;
+      }
+      continue;
+    }
+    if (starts_with(a, "--threshold_pct=")) {
+      if (!parse_u32(a.substr(16), opt.threshold_pct)) {
+        std::cerr << "Invalid --threshold_pct\n";
+        return ParseOptsResult::Error;
+      }
       continue;
     }
     if (a == "--no_overlay") {
@@ -206,6 +274,295 @@ static ParseOptsResult parse_opts(int argc, char** argv, Options& opt) {
   return ParseOptsResult::Ok;
 }
 
+struct CaseResult {
+  double secs = 0.0;
+  double fps = 0.0;
+  double ns_per_frame = 0.0;
+  double gbps = 0.0;
+  uint64_t p50_ns = 0;
+  uint64_t p99_ns = 0;
+  size_t bytes_per_frame = 0;
+  // Timed frames only (warm-up excluded).
+  uint64_t base_cache_hits = 0;
+  uint64_t base_cache_misses = 0;
+  // Whole run, warm-up included.
+  CpuPackedPatternRenderer::DebugStats stats{};
+};
+
+static uint64_t percentile_ns(const std::vector<uint64_t>& sorted_ns, uint32_t pct) {
+  if (sorted_ns.empty()) return 0;
+  const size_t idx = std::min(sorted_ns.size() - 1, (sorted_ns.size() * pct) / 100u);
+  return sorted_ns[idx];
+}
+
+// Renders `frames` timed frames of spec (after a verification pass and
+// warm-up) and fills out. frame_ns is caller-owned so a sweep reuses it.
+static bool run_case(
+    const PatternSpec& spec,
+    uint32_t band_workers,
+    uint32_t frames,
+    std::vector<uint64_t>& frame_ns,
+    CaseResult& out) {
+  const uint32_t stride = spec.width * 4u;
+  const size_t buf_bytes = static_cast<size_t>(stride) * static_cast<size_t>(spec.height);
+  std::vector<uint8_t> buf(buf_bytes);
+
+  PatternRenderTarget dst;
+  dst.data = buf.data();
+  dst.size_bytes = buf.size();
+  dst.width = spec.width;
+  dst.height = spec.height;
+  dst.stride_bytes = stride;
+  dst.format = spec.format;
+
+  PatternBandPool band_pool;
+  CpuPackedPatternRenderer r;
+  if (band_workers != 0) {
+    if (!band_pool.start(band_workers, 64, 0)) {
+      std::cerr << "band pool failed to start\n";
+      return false;
+    }
+    r.set_band_pool(&band_pool);
+  }
+  r.configure(spec);
+
+  // Banded output must match a serial render byte for byte.
+  if (band_workers != 0) {
+    std::vector<uint8_t> serial_buf(buf_bytes);
+    PatternRenderTarget serial_dst = dst;
+    serial_dst.data = serial_buf.data();
+    CpuPackedPatternRenderer serial;
+    PatternOverlayData probe{};
+    for (uint32_t i = 0; i < 3; ++i) {
+      probe.frame_index = i * 97u;
+      r.render_into(spec, dst, probe);
+      serial.render_into(spec, serial_dst, probe);
+      if (std::memcmp(buf.data(), serial_buf.data(), buf_bytes) != 0) {
+        std::cerr << "banded render differs from serial render at frame_index " << probe.frame_index << "\n";
+        return false;
+      }
+    }
+  }
+
+  // Warm-up.
+  PatternOverlayData ov{};
+  for (uint32_t i = 0; i < 16; ++i) {
+    ov.frame_index = i;
+    r.render_into(spec, dst, ov);
+  }
+
+  frame_ns.assign(frames, 0);
+  const uint64_t hits0 = r.debug_stats().base_cache_hit_count;
+  const uint64_t misses0 = r.debug_stats().base_cache_miss_count;
+  const auto t0 = std::chrono::steady_clock::now();
+  auto frame_t0 = t0;
+  for (uint32_t i = 0; i < frames; ++i) {
+    ov.frame_index = i;
+    r.render_into(spec, dst, ov);
+    const auto frame_t1 = std::chrono::steady_clock::now();
+    frame_ns[i] = static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(frame_t1 - frame_t0).count());
+    frame_t0 = frame_t1;
+  }
+  const auto t1 = std::chrono::steady_clock::now();
+
+  const std::chrono::duration<double> dt = t1 - t0;
+  out.secs = dt.count();
+  out.fps = (out.secs > 0.0) ? (static_cast<double>(frames) / out.secs) : 0.0;
+  out.ns_per_frame = (out.secs * 1e9) / static_cast<double>(frames);
+  out.bytes_per_frame = buf_bytes;
+  out.gbps = (out.secs > 0.0)
+      ? ((static_cast<double>(buf_bytes) * static_cast<double>(frames)) / out.secs / 1e9)
+      : 0.0;
+  std::sort(frame_ns.begin(), frame_ns.end());
+  out.p50_ns = percentile_ns(frame_ns, 50);
+  out.p99_ns = percentile_ns(frame_ns, 99);
+  out.stats = r.debug_stats();
+  out.base_cache_hits = out.stats.base_cache_hit_count - hits0;
+  out.base_cache_misses = out.stats.base_cache_miss_count - misses0;
+  return true;
+}
+
+static const char* format_name(PatternSpec::PackedFormat f) {
+  return f == PatternSpec::PackedFormat::BGRA8 ? "BGRA8" : "RGBA8";
+}
+
+static bool parse_resolutions(const std::string& s, std::vector<std::pair<uint32_t, uint32_t>>& out) {
+  // Format: WxH[,WxH...]
+  out.clear();
+  std::stringstream ss(s);
+  std::string item;
+  while (std::getline(ss, item, ',')) {
+    const size_t x = item.find('x');
+    uint32_t w = 0;
+    uint32_t h = 0;
+    if (x == std::string::npos || !parse_u32(item.substr(0, x), w) || !parse_u32(item.substr(x + 1), h) ||
+        w == 0 || h == 0) {
+      return false;
+    }
+    out.emplace_back(w, h);
+  }
+  return !out.empty();
+}
+
+// Reads "id" -> "p50_ns" from a report this tool wrote. Each case sits on
+// its own line, so a line scan is enough; anything else in the file is
+// ignored.
+static bool load_baseline(const std::string& path, std::map<std::string, uint64_t>& out) {
+  std::ifstream in(path);
+  if (!in) {
+    return false;
+  }
+  std::string line;
+  while (std::getline(in, line)) {
+    const std::string id_key = "\"id\":\"";
+    const std::string p50_key = "\"p50_ns\":";
+    const size_t id_at = line.find(id_key);
+    const size_t p50_at = line.find(p50_key);
+    if (id_at == std::string::npos || p50_at == std::string::npos) {
+      continue;
+    }
+    const size_t id_begin = id_at + id_key.size();
+    const size_t id_end = line.find('"', id_begin);
+    if (id_end == std::string::npos) {
+      continue;
+    }
+    const size_t num_begin = p50_at + p50_key.size();
+    out[line.substr(id_begin, id_end - id_begin)] = std::strtoull(line.c_str() + num_begin, nullptr, 10);
+  }
+  return true;
+}
+
+// Cases that hit the base cache with no overlay cost a few hundred ns, where
+// scheduler noise alone exceeds any percentage threshold; a regression must
+// also be at least this much slower in absolute terms.
+constexpr uint64_t kRegressionFloorNs = 1000;
+
+static int run_suite(const Options& opt) {
+  std::vector<std::pair<uint32_t, uint32_t>> resolutions;
+  if (!parse_resolutions(opt.resolutions, resolutions)) {
+    std::cerr << "Invalid --resolutions (expected WxH[,WxH...])\n";
+    return 2;
+  }
+  std::vector<uint32_t> worker_counts{0};
+  if (opt.band_workers_set) {
+    if (opt.band_workers != 0) worker_counts.push_back(opt.band_workers);
+  } else {
+    worker_counts.push_back(2);
+    worker_counts.push_back(4);
+  }
+  const uint32_t frames = opt.frames_set ? opt.frames : 120u;
+
+  std::map<std::string, uint64_t> baseline;
+  const bool have_baseline = !opt.baseline_path.empty();
+  if (have_baseline && !load_baseline(opt.baseline_path, baseline)) {
+    std::cerr << "Cannot read --baseline " << opt.baseline_path << "\n";
+    return 2;
+  }
+
+  std::ofstream json_file;
+  if (!opt.json_path.empty()) {
+    json_file.open(opt.json_path);
+    if (!json_file) {
+      std::cerr << "Cannot write --json " << opt.json_path << "\n";
+      return 2;
+    }
+  }
+  std::ostream& json = opt.json_path.empty() ? std::cout : json_file;
+
+  size_t n = 0;
+  const auto* presets = pattern_presets(&n);
+  const PatternSpec::PackedFormat formats[] = {PatternSpec::PackedFormat::RGBA8, PatternSpec::PackedFormat::BGRA8};
+
+  json << "{\"tool\":\"pattern_render_bench\",\"schema\":1,\"frames\":" << frames << ",\"seed\":" << opt.seed
+       << ",\"threshold_pct\":" << opt.threshold_pct << ",\"cases\":[\n";
+
+  std::vector<uint64_t> frame_ns;
+  frame_ns.reserve(frames);
+  size_t case_count = 0;
+  size_t regressions = 0;
+  size_t missing_baseline = 0;
+  for (size_t pi = 0; pi < n; ++pi) {
+    for (const PatternSpec::PackedFormat format : formats) {
+      for (const auto& res : resolutions) {
+        for (const bool overlay : {true, false}) {
+          for (const uint32_t workers : worker_counts) {
+            PictureConfig pcfg{};
+            pcfg.preset = presets[pi].preset;
+            pcfg.seed = opt.seed;
+            pcfg.overlay_frame_index_offsets = overlay;
+            pcfg.overlay_moving_bar = overlay;
+            bool preset_valid = true;
+            const PatternSpec spec = to_pattern_spec(pcfg, res.first, res.second, format, &preset_valid);
+            (void)preset_valid;
+
+            char id[160];
+            std::snprintf(id, sizeof(id), "%s/%s/%ux%u/overlay_%s/bw%u", presets[pi].name, format_name(format),
+                          res.first, res.second, overlay ? "on" : "off", workers);
+
+            CaseResult result{};
+            if (!run_case(spec, workers, frames, frame_ns, result)) {
+              std::cerr << "case failed: " << id << "\n";
+              json << "]}\n";
+              return 1;
+            }
+            const uint64_t lookups = result.base_cache_hits + result.base_cache_misses;
+            const double hit_rate =
+                lookups != 0 ? static_cast<double>(result.base_cache_hits) / static_cast<double>(lookups) : 0.0;
+
+            json << (case_count == 0 ? "" : ",\n")
+                 << "{\"id\":\"" << id << "\",\"pattern\":\"" << presets[pi].name << "\",\"format\":\""
+                 << format_name(format) << "\",\"width\":" << res.first << ",\"height\":" << res.second
+                 << ",\"overlay\":" << (overlay ? "true" : "false") << ",\"band_workers\":" << workers
+                 << ",\"ns_per_frame\":" << static_cast<uint64_t>(result.ns_per_frame)
+                 << ",\"p50_ns\":" << result.p50_ns << ",\"p99_ns\":" << result.p99_ns
+                 << ",\"gb_per_s\":" << result.gbps << ",\"base_cache_hit_rate\":" << hit_rate
+                 << ",\"base_copy_skipped\":" << result.stats.base_copy_skipped_count
+                 << ",\"base_copy_partial\":" << result.stats.base_copy_partial_count
+                 << ",\"banded_base_renders\":" << result.stats.banded_base_render_count;
+            if (have_baseline) {
+              const auto it = baseline.find(id);
+              if (it == baseline.end() || it->second == 0) {
+                ++missing_baseline;
+                json << ",\"baseline_p50_ns\":null";
+              } else {
+                const double delta_pct =
+                    (static_cast<double>(result.p50_ns) - static_cast<double>(it->second)) * 100.0 /
+                    static_cast<double>(it->second);
+                const bool regressed = delta_pct > static_cast<double>(opt.threshold_pct) &&
+                                       result.p50_ns > it->second + kRegressionFloorNs;
+                if (regressed) {
+                  ++regressions;
+                  std::cerr << "REGRESSION " << id << ": p50 " << it->second << "ns -> " << result.p50_ns
+                            << "ns (+" << delta_pct << "%)\n";
+                }
+                json << ",\"baseline_p50_ns\":" << it->second << ",\"delta_pct\":" << delta_pct
+                     << ",\"regressed\":" << (regressed ? "true" : "false");
+              }
+            }
+            json << "}";
+            ++case_count;
+          }
+        }
+      }
+    }
+  }
+
+  json << "\n],\"case_count\":" << case_count;
+  if (have_baseline) {
+    json << ",\"regressions\":" << regressions << ",\"missing_baseline\":" << missing_baseline;
+  }
+  json << "}\n";
+
+  std::cerr << "suite: " << case_count << " cases";
+  if (have_baseline) {
+    std::cerr << ", " << regressions << " regressed beyond " << opt.threshold_pct << "%, " << missing_baseline
+              << " without baseline";
+  }
+  std::cerr << "\n";
+  return regressions != 0 ? 3 : 0;
+}
+
 } // namespace
 
 int main(int argc, char** argv) {
@@ -218,6 +575,10 @@ int main(int argc, char** argv) {
     return 2;
   }
 
+  if (opt.suite) {
+    return run_suite(opt);
+  }
+
   const auto* info = find_preset_info_by_name(opt.pattern_name);
   if (!info) {
     std::cerr << "Unknown --pattern: " << opt.pattern_name << "\n";
@@ -259,41 +620,15 @@ int main(int argc, char** argv) {
       &preset_valid);
   (void)preset_valid;
 
-  const uint32_t stride = spec.width * 4u;
-  const size_t buf_bytes = static_cast<size_t>(stride) * static_cast<size_t>(spec.height);
-  std::vector<uint8_t> buf(buf_bytes);
-
-  PatternRenderTarget dst;
-  dst.data = buf.data();
-  dst.size_bytes = buf.size();
-  dst.width = spec.width;
-  dst.height = spec.height;
-  dst.stride_bytes = stride;
-  dst.format = spec.format;
-
-  CpuPackedPatternRenderer r;
-  r.configure(spec);
-
-  // Warm-up.
-  PatternOverlayData ov{};
-  for (uint32_t i = 0; i < 16; ++i) {
-    ov.frame_index = i;
-    r.render_into(spec, dst, ov);
-  }
-
-  const auto t0 = std::chrono::steady_clock::now();
-  for (uint32_t i = 0; i < opt.frames; ++i) {
-    ov.frame_index = i;
-    r.render_into(spec, dst, ov);
+  std::vector<uint64_t> frame_ns;
+  CaseResult result{};
+  if (!run_case(spec, opt.band_workers, opt.frames, frame_ns, result)) {
+    return 1;
   }
-  const auto t1 = std::chrono::steady_clock::now();
-
-  const std::chrono::duration<double> dt = t1 - t0;
-  const double secs = dt.count();
-  const double fps = (secs > 0.0) ? (static_cast<double>(opt.frames) / secs) : 0.0;
-
-  const double bytes_per_frame = static_cast<double>(buf_bytes);
-  const double gbps = (secs > 0.0) ? ((bytes_per_frame * static_cast<double>(opt.frames)) / secs / 1e9) : 0.0;
+  const double secs = result.secs;
+  const double fps = result.fps;
+  const double gbps = result.gbps;
+  const size_t buf_bytes = result.bytes_per_frame;
 
   std::cout
       << "resolution: " << spec.width << "x" << spec.height << "\n"
@@ -305,7 +640,21 @@ int main(int argc, char** argv) {
       << "fps: " << fps << "\n"
       << "bytes/frame: " << static_cast<uint64_t>(buf_bytes) << "\n"
       << "approx bandwidth: " << gbps << " GB/s\n"
-      << "overlay: " << (opt.overlay ? "on" : "off") << "\n";
+      << "overlay: " << (opt.overlay ? "on" : "off") << "\n"
+      << "frame p50/p99: " << (static_cast<double>(result.p50_ns) / 1000.0) << "us/"
+      << (static_cast<double>(result.p99_ns) / 1000.0) << "us\n"
+      << "base copies partial/skipped: " << result.stats.base_copy_partial_count << "/"
+      << result.stats.base_copy_skipped_count << "\n"
+      << "band workers: " << opt.band_workers << "\n";
+  const CpuPackedPatternRenderer::DebugStats& stats = result.stats;
+  if (stats.base_band_count != 0) {
+    std::cout
+        << "banded base renders: " << stats.banded_base_render_count << "\n"
+        << "band avg/max/skew_max: "
+        << (static_cast<double>(stats.base_band_total_ns) / static_cast<double>(stats.base_band_count) / 1000.0) << "us/"
+        << (static_cast<double>(stats.base_band_max_ns) / 1000.0) << "us/"
+        << (static_cast<double>(stats.base_band_skew_max_ns) / 1000.0) << "us\n";
+  }
 
   return 0;
 }
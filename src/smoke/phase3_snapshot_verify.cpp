@@ -11,11 +11,15 @@ Phase 3 verifier expansion for snapshot/native-object/publication semantics:
 - topology_version structural transitions
 - timestamp preservation/fallback semantics
 - no-sink delivered vs dropped accounting
+- cached snapshot sections and snapshot deltas
+- binary snapshot / delta encoding round trips
+- StateSnapshotBuffer publish_seq change detection
 
 This tool intentionally verifies core-facing truth; Godot-facing NIL-before-baseline
 is covered by dedicated Godot scene checks.
 */
 
+#include <atomic>
 #include <chrono>
 #include <cstdint>
 #include <functional>
@@ -28,15 +32,21 @@ is covered by dedicated Godot scene checks.
   #error "phase3_snapshot_verify: build through the repo SCons maintainer_tools alias so CAMBANG_INTERNAL_SMOKE=1 is defined."
 #endif
 
+#include "core/core_acquisition_session_registry.h"
 #include "core/core_dispatcher.h"
 #include "core/core_capture_cohort_registry.h"
 #include "core/core_device_registry.h"
 #include "core/provider_to_core_commands.h"
 #include "core/core_native_object_registry.h"
+#include "core/core_publish_pacer.h"
+#include "core/core_rig_registry.h"
 #include "core/core_runtime.h"
 #include "core/resource_aggregate_telemetry.h"
 #include "core/core_stream_registry.h"
+#include "core/snapshot/snapshot_binary.h"
 #include "core/snapshot/snapshot_builder.h"
+#include "core/snapshot/snapshot_delta.h"
+#include "core/snapshot/snapshot_summary.h"
 #include "core/snapshot/state_snapshot.h"
 #include "core/state_snapshot_buffer.h"
 
@@ -1286,8 +1296,21 @@ static int test_scoped_resource_telemetry_default_and_projection() {
   telemetry.lease_released(key);
   telemetry.retained_gpu_backing_created(key);
   telemetry.retained_gpu_backing_released(key);
+  telemetry.bytes_retained(key, cambang::ResourceByteGauge::RETAINED_CPU_PAYLOAD, 4096);
+  telemetry.bytes_retained(key, cambang::ResourceByteGauge::RETAINED_GPU_BACKING, 8192);
+  telemetry.bytes_retained(key, cambang::ResourceByteGauge::DISPLAY_VIEW, 1024);
+  // Releases clamp at zero and never create a bucket.
+  telemetry.bytes_released(key, cambang::ResourceByteGauge::DISPLAY_VIEW, 4096);
+  telemetry.bytes_released(key, cambang::ResourceByteGauge::RETAINED_CPU_PAYLOAD, 96);
+  telemetry.bytes_released(cambang::make_stream_scoped_resource_telemetry(30002),
+                           cambang::ResourceByteGauge::RETAINED_CPU_PAYLOAD,
+                           1);
 
   const CamBANGStateSnapshot projected = builder.build(in, 0, 1, 0, 2);
+  if (projected.scoped_resource_telemetry.size() != 1) {
+    std::cerr << "FAIL: releasing bytes of an unknown scope must not create a telemetry entry\n";
+    return 1;
+  }
   const ScopedResourceTelemetry* a1 =
       find_scoped_resource_telemetry_entry(projected.scoped_resource_telemetry, 0u, 30001);
   if (a1 == nullptr) {
@@ -1301,7 +1324,13 @@ static int test_scoped_resource_telemetry_default_and_projection() {
       a1->retained_gpu_backing_total_created != 1 ||
       a1->retained_gpu_backing_total_released != 1 ||
       a1->retained_gpu_backing_current != 0 ||
-      a1->retained_gpu_backing_peak_current != 1) {
+      a1->retained_gpu_backing_peak_current != 1 ||
+      a1->retained_cpu_payload_bytes_current != 4000 ||
+      a1->retained_gpu_backing_bytes_current != 8192 ||
+      a1->display_view_bytes_current != 0 ||
+      a1->pooled_buffer_bytes_current != 0 ||
+      a1->large_page_buffer_bytes_current != 0 ||
+      a1->large_page_fallback_bytes_current != 0) {
     std::cerr << "FAIL: scoped_resource_telemetry projected values mismatch\n";
     (void)verify_scoped_resource_telemetry_invariants(*a1, "scoped_resource_telemetry projected snapshot");
     return 1;
@@ -1310,6 +1339,355 @@ static int test_scoped_resource_telemetry_default_and_projection() {
     return 1;
   }
 
+  // Outstanding bytes keep an otherwise balanced bucket across clear().
+  telemetry.lease_released(key);
+  telemetry.clear();
+  if (telemetry.snapshot().size() != 1) {
+    std::cerr << "FAIL: scoped_resource_telemetry bucket with outstanding bytes cleared\n";
+    return 1;
+  }
+  telemetry.bytes_released(key, cambang::ResourceByteGauge::RETAINED_CPU_PAYLOAD, 4000);
+  telemetry.bytes_released(key, cambang::ResourceByteGauge::RETAINED_GPU_BACKING, 8192);
+  telemetry.clear();
+  if (!telemetry.snapshot().empty()) {
+    std::cerr << "FAIL: balanced scoped_resource_telemetry bucket survived clear()\n";
+    return 1;
+  }
+  return 0;
+}
+
+// Handle-counted leases land in the keyed bucket; a pinned bucket survives
+// clear() and retirement; retirement follows destroy order.
+static int test_scoped_resource_telemetry_handles_and_retirement() {
+  ResourceAggregateTelemetry telemetry;
+  const auto key_a = cambang::make_stream_scoped_resource_telemetry(31001);
+  const auto key_b = cambang::make_stream_scoped_resource_telemetry(31002);
+
+  ResourceAggregateTelemetry::Handle handle = telemetry.acquire_handle(key_a);
+  if (!handle) {
+    std::cerr << "FAIL: acquire_handle returned an empty handle\n";
+    return 1;
+  }
+  telemetry.lease_created(handle);
+  telemetry.lease_created(handle);
+  telemetry.lease_released(key_a);
+  telemetry.lease_released(handle);
+  const auto balanced = telemetry.snapshot();
+  if (balanced.size() != 1 || balanced[0].framebuffer_lease_total_created != 2 ||
+      balanced[0].framebuffer_lease_current != 0 || balanced[0].framebuffer_lease_peak_current != 2) {
+    std::cerr << "FAIL: handle and key lease counts must share one bucket\n";
+    return 1;
+  }
+  telemetry.clear();
+  if (telemetry.snapshot().size() != 1) {
+    std::cerr << "FAIL: clear() dropped a pinned telemetry bucket\n";
+    return 1;
+  }
+
+  // Neither stream is in the (empty) registry, so both buckets turn DESTROYED.
+  CoreStreamRegistry streams;
+  telemetry.lease_created(key_b);
+  telemetry.lease_released(key_b);
+  telemetry.reconcile_lifecycle(100, 1, &streams, nullptr, nullptr, nullptr);
+  if (!telemetry.next_retirement_delay_ns(150, 100).has_value() ||
+      *telemetry.next_retirement_delay_ns(150, 100) != 50) {
+    std::cerr << "FAIL: next_retirement_delay_ns must follow the oldest destroyed bucket\n";
+    return 1;
+  }
+  if (telemetry.retire_destroyed_older_than(250, 100) != 1 || telemetry.snapshot().size() != 1) {
+    std::cerr << "FAIL: only the unpinned destroyed bucket may retire\n";
+    return 1;
+  }
+  telemetry.release_handle(handle);
+  if (handle) {
+    std::cerr << "FAIL: release_handle must empty the handle\n";
+    return 1;
+  }
+  if (telemetry.retire_destroyed_older_than(250, 100) != 1 || !telemetry.snapshot().empty()) {
+    std::cerr << "FAIL: an unpinned destroyed bucket must retire once its window passed\n";
+    return 1;
+  }
+  return 0;
+}
+
+// A builder reusing cached sections must produce exactly what a fresh builder
+// produces, a delta between consecutive snapshots must rebuild the later one
+// from the earlier, and a summary folded from deltas must match one rebuilt
+// from the later snapshot.
+static int test_incremental_snapshot_sections_and_delta() {
+  CoreDeviceRegistry devices;
+  CoreStreamRegistry streams;
+  CoreNativeObjectRegistry native_objects;
+  CoreRigRegistry rigs;
+  CoreAcquisitionSessionRegistry sessions;
+  SnapshotBuilder::Inputs in;
+  in.devices = &devices;
+  in.streams = &streams;
+  in.native_objects = &native_objects;
+  in.rigs = &rigs;
+  in.acquisition_sessions = &sessions;
+
+  SnapshotBuilder cached;
+  uint64_t version = 0;
+  CamBANGStateSnapshot prev = cached.build(in, 1, version, 0, 1);
+  StateSummaryTracker tracker;
+  tracker.reset(prev);
+  auto step = [&](const char* label, bool expect_native_changed) -> bool {
+    ++version;
+    const uint64_t sig = cached.compute_topology_signature(in);
+    const CamBANGStateSnapshot next = cached.build(in, 1, version, 0, version + 1);
+    SnapshotBuilder fresh;
+    if (sig != fresh.compute_topology_signature(in) ||
+        !(next == fresh.build(in, 1, version, 0, version + 1))) {
+      std::cerr << "FAIL: cached snapshot sections diverge from a fresh build after " << label << "\n";
+      return false;
+    }
+    const CamBANGStateSnapshotDelta delta = compute_snapshot_delta(prev, next);
+    const bool native_changed =
+        !delta.native_objects_changed.empty() || !delta.native_objects_removed.empty();
+    if (native_changed != expect_native_changed) {
+      std::cerr << "FAIL: snapshot delta native_objects change=" << native_changed
+                << " expected=" << expect_native_changed << " after " << label << "\n";
+      return false;
+    }
+    CamBANGStateSnapshot applied = prev;
+    if (!apply_snapshot_delta(applied, delta) || !(applied == next)) {
+      std::cerr << "FAIL: applying snapshot delta does not reproduce the snapshot after " << label << "\n";
+      return false;
+    }
+    if (apply_snapshot_delta(applied, delta)) {
+      std::cerr << "FAIL: snapshot delta applied to a base it was not computed from\n";
+      return false;
+    }
+    StateSummaryTracker rebuilt;
+    rebuilt.reset(next);
+    if (!tracker.apply(delta) ||
+        !(tracker.summary() == rebuilt.summary())) {
+      std::cerr << "FAIL: summary folded from the snapshot delta diverges from a rebuild after " << label << "\n";
+      return false;
+    }
+    if (tracker.apply(delta)) {
+      std::cerr << "FAIL: summary tracker folded a delta computed from another base\n";
+      return false;
+    }
+
+    std::vector<uint8_t> bytes;
+    encode_snapshot_binary(next, bytes);
+    CamBANGStateSnapshot decoded;
+    if (snapshot_binary_message_size(bytes.data(), bytes.size()) != bytes.size() ||
+        !decode_snapshot_binary(bytes.data(), bytes.size(), decoded) || !(decoded == next)) {
+      std::cerr << "FAIL: binary snapshot does not round-trip after " << label << "\n";
+      return false;
+    }
+    CamBANGStateSnapshotDelta decoded_delta;
+    if (decode_snapshot_binary(bytes.data(), bytes.size() - 1, decoded) ||
+        decode_snapshot_delta_binary(bytes.data(), bytes.size(), decoded_delta)) {
+      std::cerr << "FAIL: truncated or mistyped binary snapshot accepted after " << label << "\n";
+      return false;
+    }
+    encode_snapshot_delta_binary(delta, bytes);
+    CamBANGStateSnapshot binary_applied = prev;
+    if (!decode_snapshot_delta_binary(bytes.data(), bytes.size(), decoded_delta) ||
+        !apply_snapshot_delta(binary_applied, decoded_delta) || !(binary_applied == next)) {
+      std::cerr << "FAIL: binary snapshot delta does not round-trip after " << label << "\n";
+      return false;
+    }
+    prev = next;
+    return true;
+  };
+
+  // Device-owned root whose owner does not exist yet: detached.
+  native_objects.on_native_object_created(
+      kRootId, static_cast<uint32_t>(NativeObjectType::Device), kRootId, kDeviceId, 0, 0, 0, 0, 0, 0, 1, 10);
+  native_objects.on_native_object_created(
+      kRootId + 1, static_cast<uint32_t>(NativeObjectType::Stream), kRootId, kDeviceId, 0, 0, 0, 0, 0, 0, 1, 11);
+  if (!step("native objects created", true)) return 1;
+  if (!contains_u64(prev.detached_root_ids, kRootId)) {
+    std::cerr << "FAIL: root without a live owner must be detached\n";
+    return 1;
+  }
+
+  // Only the owner set changes: native records are reused, detached roots are not.
+  if (!devices.note_device_identity(kDeviceId, "hw-incremental")) {
+    std::cerr << "FAIL: incremental snapshot device setup failed\n";
+    return 1;
+  }
+  if (!step("owner device appeared", false)) return 1;
+  if (contains_u64(prev.detached_root_ids, kRootId)) {
+    std::cerr << "FAIL: root with a live owner must not stay detached\n";
+    return 1;
+  }
+
+  if (!rigs.retain_capture_profile(7, 64, 48, FOURCC_RGBA, 3)) {
+    std::cerr << "FAIL: incremental snapshot rig setup failed\n";
+    return 1;
+  }
+  if (!step("rig profile retained", false)) return 1;
+
+  (void)sessions.on_native_object_created(
+      kRootId + 2, static_cast<uint32_t>(NativeObjectType::AcquisitionSession), kDeviceId, 12, 64, 48,
+      FOURCC_RGBA, 1, CaptureStillImageBundle{});
+  if (!step("acquisition session created", false)) return 1;
+
+  native_objects.on_native_object_destroyed(kRootId + 1, 20, 20);
+  if (!step("native object destroyed", true)) return 1;
+  if (native_objects.retire_destroyed_older_than(1000, 10) != 1) {
+    std::cerr << "FAIL: incremental snapshot retirement setup failed\n";
+    return 1;
+  }
+  if (!step("native object retired", true)) return 1;
+  if (find_native(prev, kRootId + 1) != nullptr) {
+    std::cerr << "FAIL: retired native object still present in snapshot\n";
+    return 1;
+  }
+  if (!step("nothing changed", false)) return 1;
+
+  // Unchanged cached sections are shared by successive views, not copied,
+  // and a view materializes to exactly what build() returns.
+  const SnapshotBuilder::View first_view = cached.capture(in, 1, version, 0, version + 1);
+  const SnapshotBuilder::View second_view = cached.capture(in, 1, version, 0, version + 1);
+  if (!first_view.native_objects || first_view.native_objects != second_view.native_objects ||
+      first_view.rigs != second_view.rigs ||
+      first_view.acquisition_sessions != second_view.acquisition_sessions ||
+      !(SnapshotBuilder::materialize(first_view) == cached.build(in, 1, version, 0, version + 1))) {
+    std::cerr << "FAIL: snapshot views do not share unchanged sections or materialize to the build\n";
+    return 1;
+  }
+
+  return 0;
+}
+
+// Section sizes follow added and removed records, and a new gen reclassifies
+// retained native objects as previous-gen.
+static int test_state_summary_gen_reclassification() {
+  CamBANGStateSnapshot a;
+  a.gen = 1;
+  a.version = 1;
+  DeviceState dev;
+  dev.instance_id = kDeviceId;
+  a.devices.push_back(dev);
+  StreamState st;
+  st.stream_id = 5;
+  st.device_instance_id = kDeviceId;
+  st.mode = CBStreamMode::FLOWING;
+  a.streams.push_back(st);
+  NativeObjectRecord provider;
+  provider.native_id = kRootId;
+  provider.type = static_cast<uint32_t>(NativeObjectType::Provider);
+  provider.creation_gen = 1;
+  a.native_objects.push_back(provider);
+
+  StateSummaryTracker tracker;
+  tracker.reset(a);
+  CamBANGStateSnapshot b = a;
+  b.version = 2;
+  b.streams[0].frames_dropped = 40;
+  if (!tracker.apply(compute_snapshot_delta(a, b))) {
+    std::cerr << "FAIL: summary tracker rejected a delta from its own base\n";
+    return 1;
+  }
+  const CamBANGStateSummary& s = tracker.summary();
+  if (s.devices != 1 || s.streams != 1 || s.native_all != 1 || s.native_cur != 1 || s.native_prev != 0) {
+    std::cerr << "FAIL: summary counts a changed record twice\n";
+    return 1;
+  }
+
+  CamBANGStateSnapshot c = b;
+  c.gen = 2;
+  c.version = 0;
+  c.streams.clear();
+  if (!tracker.apply(compute_snapshot_delta(b, c)) || tracker.summary().streams != 0 ||
+      tracker.summary().native_cur != 0 || tracker.summary().native_prev != 1) {
+    std::cerr << "FAIL: summary tracker does not reclassify native objects on a new gen\n";
+    return 1;
+  }
+  return 0;
+}
+
+// Sections left out of a build are empty, the topology signature still covers
+// them, and asking for them again yields what a fresh full build yields.
+static int test_snapshot_section_interest() {
+  StateSnapshotBuffer buf;
+  if (buf.wanted_snapshot_sections() != kCBSnapshotSectionsAll) {
+    std::cerr << "FAIL: snapshot buffer without section interest must want every section\n";
+    return 1;
+  }
+  buf.add_section_interest(kCBSnapshotSectionDevices | kCBSnapshotSectionStreams);
+  buf.add_section_interest(kCBSnapshotSectionDevices);
+  buf.remove_section_interest(kCBSnapshotSectionDevices | kCBSnapshotSectionStreams);
+  if (buf.wanted_snapshot_sections() != kCBSnapshotSectionDevices) {
+    std::cerr << "FAIL: snapshot section interest is not reference-counted per section\n";
+    return 1;
+  }
+
+  CoreDeviceRegistry devices;
+  CoreNativeObjectRegistry native_objects;
+  SnapshotBuilder::Inputs in;
+  in.devices = &devices;
+  in.native_objects = &native_objects;
+  if (!devices.note_device_identity(kDeviceId, "hw-sections")) {
+    std::cerr << "FAIL: section interest device setup failed\n";
+    return 1;
+  }
+  native_objects.on_native_object_created(
+      kRootId, static_cast<uint32_t>(NativeObjectType::Device), kRootId, kDeviceId, 0, 0, 0, 0, 0, 0, 1, 10);
+
+  SnapshotBuilder builder;
+  const uint64_t full_sig = SnapshotBuilder{}.compute_topology_signature(in);
+  const CamBANGStateSnapshot partial = builder.build(in, 1, 0, 0, 1, buf.wanted_snapshot_sections());
+  if (partial.devices.size() != 1 || !partial.native_objects.empty() || !partial.detached_root_ids.empty()) {
+    std::cerr << "FAIL: devices-only snapshot build filled the wrong sections\n";
+    return 1;
+  }
+  native_objects.on_native_object_created(
+      kRootId + 1, static_cast<uint32_t>(NativeObjectType::Stream), kRootId + 1, kDeviceId, 0, 0, 0, 0, 0, 0, 1, 11);
+  const uint64_t grown_sig = builder.compute_topology_signature(in);
+  if (grown_sig == full_sig || grown_sig != SnapshotBuilder{}.compute_topology_signature(in)) {
+    std::cerr << "FAIL: topology signature must cover native roots left out of the build\n";
+    return 1;
+  }
+  if (!(builder.build(in, 1, 1, 0, 2) == SnapshotBuilder{}.build(in, 1, 1, 0, 2))) {
+    std::cerr << "FAIL: snapshot sections restored after a partial build diverge from a fresh build\n";
+    return 1;
+  }
+  return 0;
+}
+
+static int test_publish_pacer() {
+  CorePublishPacer pacer;
+  pacer.configure(100);
+  if (pacer.delay_ns(5) != 0 || pacer.interval_ns() != 10000000ull) {
+    std::cerr << "FAIL: publish pacer must let the first publish through at the configured interval\n";
+    return 1;
+  }
+  pacer.note_published(0, 0, false);
+  if (pacer.delay_ns(1000000ull) != 9000000ull || pacer.delay_ns(10000000ull) != 0) {
+    std::cerr << "FAIL: publish pacer does not space counter-only publishes by its interval\n";
+    return 1;
+  }
+  for (int i = 0; i < 5; ++i) {
+    pacer.note_published(0, 0, true);
+  }
+  if (pacer.interval_ns() != (10000000ull << CorePublishPacer::kMaxBackoffShift)) {
+    std::cerr << "FAIL: publish pacer backoff while busy is not bounded\n";
+    return 1;
+  }
+  pacer.note_published(0, 0, false);
+  if (pacer.interval_ns() != 10000000ull) {
+    std::cerr << "FAIL: publish pacer keeps its backoff after an idle publish\n";
+    return 1;
+  }
+  pacer.note_published(0, 5000000ull, false);
+  if (pacer.interval_ns() != 5000000ull * CorePublishPacer::kBuildShareDivisor) {
+    std::cerr << "FAIL: publish pacer does not bound the snapshot build share\n";
+    return 1;
+  }
+  pacer.configure(0);
+  pacer.note_published(0, 5000000ull, true);
+  if (pacer.delay_ns(1) != 0) {
+    std::cerr << "FAIL: unlimited publish pacer held a publish back\n";
+    return 1;
+  }
   return 0;
 }
 
@@ -1403,12 +1781,116 @@ static int test_scoped_resource_telemetry_runtime_framebuffer_lease_integration(
   return 0;
 }
 
+static int test_snapshot_buffer_publish_seq() {
+  StateSnapshotBuffer buf;
+  if (buf.publish_seq() != 0 || buf.snapshot_copy()) {
+    std::cerr << "FAIL: fresh snapshot buffer must be empty at seq 0\n";
+    return 1;
+  }
+
+  // Core-thread writer racing a poller that only copies when the seq moved.
+  constexpr uint64_t kPublishes = 2000;
+  std::atomic<bool> done{false};
+  std::thread writer([&]() {
+    for (uint64_t v = 1; v <= kPublishes; ++v) {
+      auto s = std::make_shared<CamBANGStateSnapshot>();
+      s->version = v;
+      buf.publish(std::move(s));
+    }
+    done.store(true, std::memory_order_release);
+  });
+  uint64_t seen_seq = 0;
+  uint64_t seen_version = 0;
+  bool ok = true;
+  for (;;) {
+    const bool finished = done.load(std::memory_order_acquire);
+    const uint64_t seq = buf.publish_seq();
+    if (seq != seen_seq) {
+      auto s = buf.snapshot_copy();
+      // The copy is at least as new as the seq it was taken after.
+      if (!s || s->version < seq || s->version < seen_version) {
+        ok = false;
+        break;
+      }
+      seen_seq = seq;
+      seen_version = s->version;
+    }
+    if (finished) break;
+  }
+  writer.join();
+  if (!ok || seen_seq != kPublishes || seen_version != kPublishes) {
+    std::cerr << "FAIL: snapshot buffer poller observed an out-of-order or missing publish\n";
+    return 1;
+  }
+
+  buf.clear();
+  if (buf.publish_seq() != kPublishes + 1 || buf.snapshot_copy()) {
+    std::cerr << "FAIL: snapshot buffer clear must drop the snapshot and advance publish_seq\n";
+    return 1;
+  }
+  return 0;
+}
+
+static int test_native_object_registry_retirement_order() {
+  CoreNativeObjectRegistry reg;
+  for (uint64_t id = 1; id <= 4; ++id) {
+    reg.on_native_object_created(id, 1, 1, 0, 0, 0, 0, 0, 0, 0, 1, 100);
+  }
+  // Destroys reported out of integration-time order; id 2 is re-destroyed later.
+  reg.on_native_object_destroyed(3, 0, 300);
+  reg.on_native_object_destroyed(1, 0, 200);
+  reg.on_native_object_destroyed(2, 0, 250);
+  reg.on_native_object_destroyed(2, 0, 400);
+  reg.on_native_object_destroyed(9, 0, 350); // orphan
+
+  const auto delay = reg.next_retirement_delay_ns(250, 100);
+  if (!delay.has_value() || *delay != 50) {
+    std::cerr << "FAIL: next retirement deadline must come from the oldest destroy\n";
+    return 1;
+  }
+  if (reg.retire_destroyed_older_than(450, 100) != 3 || reg.find(1) || reg.find(3) || reg.find(9) ||
+      !reg.find(2) || !reg.find(4) || reg.all().size() != 2) {
+    std::cerr << "FAIL: retirement must drop exactly the expired destroyed records\n";
+    return 1;
+  }
+
+  // Freed slots are reused without resurrecting retired ids.
+  reg.on_native_object_created(10, 1, 1, 0, 0, 0, 0, 0, 0, 0, 1, 500);
+  reg.on_native_object_created(11, 1, 1, 0, 0, 0, 0, 0, 0, 0, 1, 500);
+  uint64_t prev_id = 0;
+  size_t n = 0;
+  for (const auto& [id, rec] : reg.all()) {
+    if (id <= prev_id || rec.native_id != id) {
+      std::cerr << "FAIL: native object records must iterate in ascending id order\n";
+      return 1;
+    }
+    prev_id = id;
+    ++n;
+  }
+  if (n != 4 || reg.find(1) || reg.find(3) || reg.find(10)->created_ns != 500) {
+    std::cerr << "FAIL: reused native object slots must hold only their new record\n";
+    return 1;
+  }
+  if (reg.clear_destroyed() != 1 || reg.find(2) || reg.next_retirement_delay_ns(0, 0).has_value()) {
+    std::cerr << "FAIL: clear_destroyed must drop every destroyed record\n";
+    return 1;
+  }
+  return 0;
+}
+
 } // namespace
 
 int main() {
   if (int r = test_capture_cohort_registry_basics()) return r;
   if (int r = test_scoped_resource_telemetry_default_and_projection()) return r;
+  if (int r = test_scoped_resource_telemetry_handles_and_retirement()) return r;
+  if (int r = test_incremental_snapshot_sections_and_delta()) return r;
+  if (int r = test_state_summary_gen_reclassification()) return r;
+  if (int r = test_snapshot_section_interest()) return r;
+  if (int r = test_publish_pacer()) return r;
   if (int r = test_scoped_resource_telemetry_runtime_framebuffer_lease_integration()) return r;
+  if (int r = test_snapshot_buffer_publish_seq()) return r;
+  if (int r = test_native_object_registry_retirement_order()) return r;
   if (int r = test_topology_detached_and_retirement()) return r;
   if (int r = test_destroyed_retention_does_not_cross_generation_baseline()) return r;
   if (int r = test_live_session_retirement_expiry_publication()) return r;
@@ -0,0 +1,437 @@
+/*
+CamBANG Maintainer Utility
+
+Tool: pixel_convert_bench
+
+Purpose
+-------
+Benchmarks and verifies the platform frame-conversion kernels in
+src/pixels/convert on the host: convert_yuv420_rows_to_packed() (the
+Android Camera2 YUV_420_888 path) and convert_bgra_rows_to_packed_opaque()
+(the Windows Bgra8 SoftwareBitmap path).
+
+Sources are synthetic: planar I420, semiplanar NV12/NV21 and BGRA, each
+tight and with padded row strides, plus a bottom-up BGRA image. Before
+timing, every case's output is compared byte for byte with an independent
+scalar reference of the same integer math, on the requested geometry and on
+an odd one that exercises every vector tail, whole and split into row bands.
+So the variant compiled into this build (pixel_kernel_isa(): SSE2, NEON, or
+scalar with pixels_scalar=yes) is checked against the reference on every run.
+
+Reports ns/frame and GB/s, counting source bytes read plus packed bytes
+written, as text or, with --json, machine-readable JSON.
+
+Category
+--------
+Benchmark (maintainer).
+
+Non-Goals
+---------
+- Not a core invariant smoke test
+- Not a user-facing test harness (Godot)
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#if !defined(CAMBANG_INTERNAL_SMOKE)
+  #error "pixel_convert_bench: build through the repo SCons maintainer_tools alias so CAMBANG_INTERNAL_SMOKE=1 is defined."
+#endif
+
+#include "pixels/convert/packed_swizzle.h"
+#include "pixels/convert/yuv420_to_rgba.h"
+#include "pixels/pixel_simd.h"
+
+using namespace cambang;
+
+namespace {
+
+struct Options {
+  std::string resolutions = "640x480,1920x1080,3840x2160";
+  uint32_t min_ms = 200;
+  std::string json_path;
+  bool verify_only = false;
+};
+
+enum class Layout {
+  I420,
+  NV12,
+  NV21,
+  I420Padded,
+  NV12Padded,
+  BgraTight,
+  BgraPadded,
+  BgraBottomUp,
+};
+
+constexpr Layout kLayouts[] = {
+    Layout::I420,      Layout::NV12,       Layout::NV21,       Layout::I420Padded,
+    Layout::NV12Padded, Layout::BgraTight, Layout::BgraPadded, Layout::BgraBottomUp,
+};
+
+const char* layout_name(Layout layout) {
+  switch (layout) {
+    case Layout::I420: return "i420";
+    case Layout::NV12: return "nv12";
+    case Layout::NV21: return "nv21";
+    case Layout::I420Padded: return "i420_padded";
+    case Layout::NV12Padded: return "nv12_padded";
+    case Layout::BgraTight: return "bgra";
+    case Layout::BgraPadded: return "bgra_padded";
+    case Layout::BgraBottomUp: return "bgra_bottom_up";
+  }
+  return "?";
+}
+
+bool is_yuv(Layout layout) {
+  return layout != Layout::BgraTight && layout != Layout::BgraPadded && layout != Layout::BgraBottomUp;
+}
+
+// Row padding of the padded layouts: odd on purpose, so rows start at every
+// alignment.
+constexpr uint32_t kRowPadBytes = 67;
+
+// One synthetic source image. Planes are sized to exactly what the layout
+// describes, so a kernel that reads past its validated extent reads past the
+// allocation (visible under a sanitizer build).
+struct Source {
+  Layout layout = Layout::I420;
+  uint32_t width = 0;
+  uint32_t height = 0;
+  std::vector<uint8_t> y_plane;
+  std::vector<uint8_t> u_plane;  // also the interleaved chroma plane
+  std::vector<uint8_t> v_plane;
+  std::vector<uint8_t> bgra;
+  Yuv420Source yuv{};
+  const uint8_t* bgra_row0 = nullptr;
+  ptrdiff_t bgra_pitch = 0;
+  size_t bytes = 0;
+};
+
+void fill_random(std::vector<uint8_t>& buf, uint32_t& state) {
+  for (uint8_t& b : buf) {
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    b = static_cast<uint8_t>(state >> 24);
+  }
+}
+
+Source make_source(Layout layout, uint32_t width, uint32_t height, uint32_t seed) {
+  Source s{};
+  s.layout = layout;
+  s.width = width;
+  s.height = height;
+  uint32_t state = seed | 1u;
+  const uint32_t cw = (width + 1u) / 2u;
+  const uint32_t ch = (height + 1u) / 2u;
+  const bool padded = layout == Layout::I420Padded || layout == Layout::NV12Padded || layout == Layout::BgraPadded;
+  const uint32_t pad = padded ? kRowPadBytes : 0u;
+  switch (layout) {
+    case Layout::I420:
+    case Layout::I420Padded: {
+      s.yuv.y_row_stride = width + pad;
+      s.yuv.uv_row_stride = cw + pad;
+      s.yuv.uv_pixel_stride = 1;
+      s.y_plane.resize(static_cast<size_t>(s.yuv.y_row_stride) * (height - 1u) + width);
+      s.u_plane.resize(static_cast<size_t>(s.yuv.uv_row_stride) * (ch - 1u) + cw);
+      s.v_plane.resize(s.u_plane.size());
+      fill_random(s.y_plane, state);
+      fill_random(s.u_plane, state);
+      fill_random(s.v_plane, state);
+      s.yuv.y = s.y_plane.data();
+      s.yuv.u = s.u_plane.data();
+      s.yuv.v = s.v_plane.data();
+      s.bytes = static_cast<size_t>(width) * height + 2u * static_cast<size_t>(cw) * ch;
+      break;
+    }
+    case Layout::NV12:
+    case Layout::NV21:
+    case Layout::NV12Padded: {
+      s.yuv.y_row_stride = width + pad;
+      s.yuv.uv_row_stride = 2u * cw + pad;
+      s.yuv.uv_pixel_stride = 2;
+      s.y_plane.resize(static_cast<size_t>(s.yuv.y_row_stride) * (height - 1u) + width);
+      s.u_plane.resize(static_cast<size_t>(s.yuv.uv_row_stride) * (ch - 1u) + 2u * cw);
+      fill_random(s.y_plane, state);
+      fill_random(s.u_plane, state);
+      s.yuv.y = s.y_plane.data();
+      const bool v_first = (layout == Layout::NV21);
+      s.yuv.u = s.u_plane.data() + (v_first ? 1 : 0);
+      s.yuv.v = s.u_plane.data() + (v_first ? 0 : 1);
+      s.bytes = static_cast<size_t>(width) * height + 2u * static_cast<size_t>(cw) * ch;
+      break;
+    }
+    case Layout::BgraTight:
+    case Layout::BgraPadded:
+    case Layout::BgraBottomUp: {
+      const size_t row_bytes = static_cast<size_t>(width) * 4u;
+      const size_t pitch = row_bytes + pad;
+      s.bgra.resize(pitch * (height - 1u) + row_bytes);
+      fill_random(s.bgra, state);
+      if (layout == Layout::BgraBottomUp) {
+        s.bgra_row0 = s.bgra.data() + pitch * (height - 1u);
+        s.bgra_pitch = -static_cast<ptrdiff_t>(pitch);
+      } else {
+        s.bgra_row0 = s.bgra.data();
+        s.bgra_pitch = static_cast<ptrdiff_t>(pitch);
+      }
+      s.bytes = row_bytes * height;
+      break;
+    }
+  }
+  return s;
+}
+
+// Rows [row_begin, row_end) through the kernel under test.
+void convert(const Source& s, bool to_rgba, uint32_t row_begin, uint32_t row_end, uint8_t* dst) {
+  const size_t dst_stride = static_cast<size_t>(s.width) * 4u;
+  if (is_yuv(s.layout)) {
+    convert_yuv420_rows_to_packed(s.yuv, s.width, row_begin, row_end, to_rgba, dst, dst_stride);
+    return;
+  }
+  convert_bgra_rows_to_packed_opaque(s.bgra_row0 + s.bgra_pitch * static_cast<ptrdiff_t>(row_begin), s.bgra_pitch,
+                                     s.width, row_end - row_begin, to_rgba, dst + dst_stride * row_begin);
+}
+
+uint8_t clamp_u8(int32_t v) {
+  return static_cast<uint8_t>(v < 0 ? 0 : (v > 255 ? 255 : v));
+}
+
+// Independent scalar reference: integer BT.601 limited range for YUV,
+// channel swap plus forced alpha for BGRA.
+void convert_reference(const Source& s, bool to_rgba, uint8_t* dst) {
+  for (uint32_t row = 0; row < s.height; ++row) {
+    uint8_t* out = dst + static_cast<size_t>(row) * s.width * 4u;
+    for (uint32_t col = 0; col < s.width; ++col) {
+      uint8_t r = 0;
+      uint8_t g = 0;
+      uint8_t b = 0;
+      if (is_yuv(s.layout)) {
+        const size_t uv = static_cast<size_t>(row / 2u) * s.yuv.uv_row_stride +
+                          static_cast<size_t>(col / 2u) * s.yuv.uv_pixel_stride;
+        const int32_t c = static_cast<int32_t>(s.yuv.y[static_cast<size_t>(row) * s.yuv.y_row_stride + col]) - 16;
+        const int32_t d = static_cast<int32_t>(s.yuv.u[uv]) - 128;
+        const int32_t e = static_cast<int32_t>(s.yuv.v[uv]) - 128;
+        r = clamp_u8((298 * c + 409 * e + 128) >> 8);
+        g = clamp_u8((298 * c - 100 * d - 208 * e + 128) >> 8);
+        b = clamp_u8((298 * c + 516 * d + 128) >> 8);
+      } else {
+        const uint8_t* px = s.bgra_row0 + s.bgra_pitch * static_cast<ptrdiff_t>(row) + 4u * col;
+        b = px[0];
+        g = px[1];
+        r = px[2];
+      }
+      out[4u * col + 0] = to_rgba ? r : b;
+      out[4u * col + 1] = g;
+      out[4u * col + 2] = to_rgba ? b : r;
+      out[4u * col + 3] = 0xFF;
+    }
+  }
+}
+
+// Whole-image and banded conversion must both equal the reference.
+bool verify(Layout layout, bool to_rgba, uint32_t width, uint32_t height) {
+  const Source s = make_source(layout, width, height, width * 31u + height);
+  const size_t dst_bytes = static_cast<size_t>(width) * height * 4u;
+  std::vector<uint8_t> expected(dst_bytes);
+  std::vector<uint8_t> actual(dst_bytes, 0);
+  convert_reference(s, to_rgba, expected.data());
+  convert(s, to_rgba, 0, height, actual.data());
+  bool ok = actual == expected;
+  if (ok && height > 1) {
+    std::fill(actual.begin(), actual.end(), 0);
+    const uint32_t split = height / 2u + 1u;
+    convert(s, to_rgba, split, height, actual.data());
+    convert(s, to_rgba, 0, split, actual.data());
+    ok = actual == expected;
+  }
+  if (!ok) {
+    size_t at = 0;
+    while (at < dst_bytes && actual[at] == expected[at]) {
+      ++at;
+    }
+    std::cerr << "MISMATCH " << layout_name(layout) << (to_rgba ? "->rgba " : "->bgra ") << width << "x" << height
+              << " at byte " << at << " (pixel " << (at / 4u) % width << "," << (at / 4u) / width << ")\n";
+  }
+  return ok;
+}
+
+struct CaseResult {
+  uint64_t frames = 0;
+  double ns_per_frame = 0.0;
+  uint64_t p50_ns = 0;
+  double gbps = 0.0;
+  size_t bytes_per_frame = 0;
+};
+
+CaseResult run_case(Layout layout, bool to_rgba, uint32_t width, uint32_t height, uint32_t min_ms) {
+  const Source s = make_source(layout, width, height, 0x9E3779B9u);
+  std::vector<uint8_t> dst(static_cast<size_t>(width) * height * 4u);
+  for (int i = 0; i < 3; ++i) {
+    convert(s, to_rgba, 0, height, dst.data());
+  }
+  std::vector<uint64_t> frame_ns;
+  const auto budget = std::chrono::milliseconds(min_ms);
+  const auto t0 = std::chrono::steady_clock::now();
+  auto frame_t0 = t0;
+  do {
+    convert(s, to_rgba, 0, height, dst.data());
+    const auto frame_t1 = std::chrono::steady_clock::now();
+    frame_ns.push_back(static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(frame_t1 - frame_t0).count()));
+    frame_t0 = frame_t1;
+  } while (frame_t0 - t0 < budget || frame_ns.size() < 8);
+  const double secs = std::chrono::duration<double>(frame_t0 - t0).count();
+
+  CaseResult out{};
+  out.frames = frame_ns.size();
+  out.ns_per_frame = secs * 1e9 / static_cast<double>(out.frames);
+  out.bytes_per_frame = s.bytes + dst.size();
+  out.gbps = secs > 0.0 ? static_cast<double>(out.bytes_per_frame) * static_cast<double>(out.frames) / secs / 1e9
+                        : 0.0;
+  std::sort(frame_ns.begin(), frame_ns.end());
+  out.p50_ns = frame_ns[frame_ns.size() / 2u];
+  return out;
+}
+
+bool parse_u32(const std::string& s, uint32_t& out) {
+  try {
+    size_t idx = 0;
+    const unsigned long v = std::stoul(s, &idx, 10);
+    if (idx != s.size()) return false;
+    out = static_cast<uint32_t>(v);
+    return true;
+  } catch (...) {
+    return false;
+  }
+}
+
+bool parse_resolutions(const std::string& s, std::vector<std::pair<uint32_t, uint32_t>>& out) {
+  // Format: WxH[,WxH...]
+  out.clear();
+  std::stringstream ss(s);
+  std::string item;
+  while (std::getline(ss, item, ',')) {
+    const size_t x = item.find('x');
+    uint32_t w = 0;
+    uint32_t h = 0;
+    if (x == std::string::npos || !parse_u32(item.substr(0, x), w) || !parse_u32(item.substr(x + 1), h) ||
+        w == 0 || h == 0) {
+      return false;
+    }
+    out.emplace_back(w, h);
+  }
+  return !out.empty();
+}
+
+void usage(const char* argv0) {
+  std::cerr << "Usage: " << argv0
+            << " [--resolutions=WxH[,WxH...]] [--min_ms=N] [--json=PATH] [--verify_only]\n\n"
+            << "Runs every layout (i420, nv12, nv21, i420_padded, nv12_padded, bgra, bgra_padded,\n"
+            << "bgra_bottom_up) to RGBA and BGRA at each resolution for at least --min_ms\n"
+            << "(default 200) each. Every case is first verified against the scalar reference;\n"
+            << "any mismatch exits 1 before timing.\n";
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  Options opt;
+  for (int i = 1; i < argc; ++i) {
+    const std::string a = argv[i];
+    if (a == "--help" || a == "-h") {
+      usage(argv[0]);
+      return 0;
+    }
+    if (a.rfind("--resolutions=", 0) == 0) {
+      opt.resolutions = a.substr(14);
+    } else if (a.rfind("--min_ms=", 0) == 0) {
+      if (!parse_u32(a.substr(9), opt.min_ms)) {
+        std::cerr << "Invalid --min_ms\n";
+        return 2;
+      }
+    } else if (a.rfind("--json=", 0) == 0) {
+      opt.json_path = a.substr(7);
+    } else if (a == "--verify_only") {
+      opt.verify_only = true;
+    } else {
+      std::cerr << "Unknown argument: " << a << "\n";
+      usage(argv[0]);
+      return 2;
+    }
+  }
+  std::vector<std::pair<uint32_t, uint32_t>> resolutions;
+  if (!parse_resolutions(opt.resolutions, resolutions)) {
+    std::cerr << "Invalid --resolutions (expected WxH[,WxH...])\n";
+    return 2;
+  }
+
+  // Odd sizes leave a tail after every vector block and an odd final chroma
+  // row and column.
+  std::vector<std::pair<uint32_t, uint32_t>> verify_sizes{{1, 1}, {17, 3}, {37, 9}, {53, 7}};
+  verify_sizes.insert(verify_sizes.end(), resolutions.begin(), resolutions.end());
+  size_t verified = 0;
+  for (const Layout layout : kLayouts) {
+    for (const bool to_rgba : {true, false}) {
+      for (const auto& size : verify_sizes) {
+        if (!verify(layout, to_rgba, size.first, size.second)) {
+          std::cerr << "FAIL pixel_convert_bench isa=" << pixel_kernel_isa() << "\n";
+          return 1;
+        }
+        ++verified;
+      }
+    }
+  }
+  std::cerr << "verified " << verified << " cases bit-exact against the scalar reference (isa="
+            << pixel_kernel_isa() << ")\n";
+  if (opt.verify_only) {
+    return 0;
+  }
+
+  std::ofstream json_file;
+  if (!opt.json_path.empty()) {
+    json_file.open(opt.json_path);
+    if (!json_file) {
+      std::cerr << "Cannot write --json " << opt.json_path << "\n";
+      return 2;
+    }
+    json_file << "{\"tool\":\"pixel_convert_bench\",\"schema\":1,\"isa\":\"" << pixel_kernel_isa()
+              << "\",\"min_ms\":" << opt.min_ms << ",\"cases\":[\n";
+  }
+
+  size_t case_count = 0;
+  for (const auto& res : resolutions) {
+    for (const Layout layout : kLayouts) {
+      for (const bool to_rgba : {true, false}) {
+        const CaseResult r = run_case(layout, to_rgba, res.first, res.second, opt.min_ms);
+        char id[96];
+        std::snprintf(id, sizeof(id), "%s/%s/%ux%u", layout_name(layout), to_rgba ? "RGBA8" : "BGRA8", res.first,
+                      res.second);
+        std::printf("%-32s %10.1f us/frame  p50 %10.1f us  %7.2f GB/s\n", id, r.ns_per_frame / 1000.0,
+                    static_cast<double>(r.p50_ns) / 1000.0, r.gbps);
+        if (json_file) {
+          json_file << (case_count == 0 ? "" : ",\n") << "{\"id\":\"" << id << "\",\"layout\":\""
+                    << layout_name(layout) << "\",\"format\":\"" << (to_rgba ? "RGBA8" : "BGRA8")
+                    << "\",\"width\":" << res.first << ",\"height\":" << res.second << ",\"frames\":" << r.frames
+                    << ",\"ns_per_frame\":" << static_cast<uint64_t>(r.ns_per_frame) << ",\"p50_ns\":" << r.p50_ns
+                    << ",\"bytes_per_frame\":" << r.bytes_per_frame << ",\"gb_per_s\":" << r.gbps << "}";
+        }
+        ++case_count;
+      }
+    }
+  }
+  if (json_file) {
+    json_file << "\n],\"case_count\":" << case_count << "}\n";
+  }
+  return 0;
+}
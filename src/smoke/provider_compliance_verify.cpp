@@ -3,10 +3,14 @@
 // and deterministic timeline dispatch observations as PASS/FAIL evidence.
 #include <cstdio>
 #include <cstdint>
+#include <cstring>
 #include <array>
 #include <algorithm>
 #include <atomic>
+#include <chrono>
 #include <condition_variable>
+#include <filesystem>
+#include <fstream>
 #include <functional>
 #include <iostream>
 #include <limits>
@@ -22,10 +26,16 @@
 
 #if defined(_WIN32)
 #include <io.h>
+#elif defined(__linux__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
 #endif
 
 #include "core/core_runtime.h"
+#include "core/state_snapshot_buffer.h"
 #include "imaging/broker/provider_broker.h"
+#include "imaging/replay/provider.h"
 #include "imaging/stub/provider.h"
 #include "imaging/synthetic/builtin_scenario_library.h"
 #include "imaging/synthetic/gpu_backing_runtime.h"
@@ -91,7 +101,9 @@ bool synthetic_gpu_truth_probe_update(
     const uint8_t* src,
     uint32_t width,
     uint32_t height,
-    uint32_t stride_bytes) noexcept {
+    uint32_t stride_bytes,
+    const cambang::SyntheticGpuBackingDirtyRegion& /*dirty*/,
+    uint64_t /*frame_trace_id*/) noexcept {
   const uint64_t call =
       g_synthetic_gpu_backing_truth_probe.update_calls.fetch_add(
           1, std::memory_order_relaxed) + 1;
@@ -124,6 +136,66 @@ const SyntheticGpuBackingRuntimeOps kSyntheticGpuBackingTruthProbeOps{
     nullptr,
 };
 
+// Generated-pattern probe: the truth probe's backings, plus a generate op
+// that records what each generated frame asked for.
+struct SyntheticGpuPatternProbeState final {
+  std::mutex mutex;
+  std::vector<uint64_t> base_revisions;
+  std::vector<uint64_t> frame_indices;
+  uint64_t update_calls = 0;
+  uint64_t whole_frame_updates = 0;
+  bool fail_generate = false;
+};
+
+SyntheticGpuPatternProbeState g_synthetic_gpu_pattern_probe;
+
+bool synthetic_gpu_pattern_probe_update(
+    const std::shared_ptr<void>& backing,
+    const uint8_t* src,
+    uint32_t width,
+    uint32_t,
+    uint32_t,
+    const cambang::SyntheticGpuBackingDirtyRegion& dirty,
+    uint64_t) noexcept {
+  std::lock_guard<std::mutex> lock(g_synthetic_gpu_pattern_probe.mutex);
+  ++g_synthetic_gpu_pattern_probe.update_calls;
+  if (dirty.x == 0 && dirty.y == 0 && dirty.width >= width) {
+    ++g_synthetic_gpu_pattern_probe.whole_frame_updates;
+  }
+  return backing && src;
+}
+
+bool synthetic_gpu_pattern_probe_can_generate() noexcept { return true; }
+
+bool synthetic_gpu_pattern_probe_generate(
+    const std::shared_ptr<void>& backing,
+    uint32_t width,
+    uint32_t height,
+    const cambang::SyntheticGpuPatternFrame& frame,
+    uint64_t) noexcept {
+  std::lock_guard<std::mutex> lock(g_synthetic_gpu_pattern_probe.mutex);
+  if (g_synthetic_gpu_pattern_probe.fail_generate || !backing || !frame.base || width == 0 || height == 0) {
+    return false;
+  }
+  g_synthetic_gpu_pattern_probe.base_revisions.push_back(frame.base_revision);
+  g_synthetic_gpu_pattern_probe.frame_indices.push_back(frame.frame_index);
+  return true;
+}
+
+const SyntheticGpuBackingRuntimeOps kSyntheticGpuPatternProbeOps{
+    &synthetic_gpu_truth_probe_available,
+    nullptr,
+    &synthetic_gpu_truth_probe_retain,
+    &synthetic_gpu_truth_probe_create,
+    &synthetic_gpu_pattern_probe_update,
+    &synthetic_gpu_truth_probe_release,
+    &synthetic_gpu_truth_probe_can_materialize,
+    nullptr,
+    nullptr,
+    &synthetic_gpu_pattern_probe_can_generate,
+    &synthetic_gpu_pattern_probe_generate,
+};
+
 class SyntheticGpuBackingTruthProbeScope final {
 public:
   SyntheticGpuBackingTruthProbeScope() {
@@ -513,6 +585,8 @@ struct RecorderCallbacks final : IProviderCallbacks {
   std::vector<EventRec> events;
   std::unordered_map<uint64_t, uint32_t> native_type_by_id;
   std::unordered_map<uint64_t, uint64_t> native_owner_stream_by_id;
+  // Steady time each device's latest capture_started was delivered.
+  std::unordered_map<uint64_t, uint64_t> capture_started_steady_ns_by_device;
   std::atomic<bool> display_demand_active{false};
   mutable std::mutex mu;
 
@@ -533,7 +607,14 @@ struct RecorderCallbacks final : IProviderCallbacks {
   void on_stream_destroyed(uint64_t id) override { std::lock_guard<std::mutex> lk(mu); events.push_back({"stream_destroyed", id}); }
   void on_stream_started(uint64_t id) override { std::lock_guard<std::mutex> lk(mu); events.push_back({"stream_started", id}); }
   void on_stream_stopped(uint64_t id, ProviderError) override { std::lock_guard<std::mutex> lk(mu); events.push_back({"stream_stopped", id}); }
-  void on_capture_started(uint64_t id, uint64_t) override { std::lock_guard<std::mutex> lk(mu); events.push_back({"capture_started", id}); }
+  void on_capture_started(uint64_t id, uint64_t device_instance_id) override {
+    const uint64_t now_ns = static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+    std::lock_guard<std::mutex> lk(mu);
+    events.push_back({"capture_started", id});
+    capture_started_steady_ns_by_device[device_instance_id] = now_ns;
+  }
   void on_capture_completed(uint64_t id, uint64_t) override { std::lock_guard<std::mutex> lk(mu); events.push_back({"capture_completed", id}); }
   void on_capture_failed(uint64_t id, uint64_t, ProviderError) override { std::lock_guard<std::mutex> lk(mu); events.push_back({"capture_failed", id}); }
 
@@ -1144,8 +1225,8 @@ private:
     uint64_t plan_updates = 0;
   };
 
-  static std::shared_ptr<std::vector<uint8_t>> make_bytes_() {
-    return std::make_shared<std::vector<uint8_t>>(16u * 16u * 4u, 7u);
+  static std::shared_ptr<CpuPayloadBytes> make_bytes_() {
+    return std::make_shared<CpuPayloadBytes>(16u * 16u * 4u, 7u);
   }
 
   static FrameView build_frame_from_plan_(
@@ -1375,6 +1456,14 @@ public:
   uint64_t capture_admission_watchdog_timeout_ns() const noexcept override {
     return 1'234'567;
   }
+  uint32_t max_active_streams_per_device() const noexcept override { return 3; }
+  bool supports_capture_alongside_streams(
+      uint64_t device_instance_id) const noexcept override {
+    return device_instance_id == 7;
+  }
+  ProviderResult reconfigure_stream(uint64_t, const CaptureProfile &) override {
+    return ProviderResult::failure(ProviderError::ERR_PLATFORM_CONSTRAINT);
+  }
 
   ProviderResult initialize(IProviderCallbacks *) override {
     ++initialize_calls;
@@ -1904,6 +1993,305 @@ bool run_synthetic_builtin_scenario_library_build_check() {
   return true;
 }
 
+bool run_synthetic_skip_ahead_stepping_check() {
+  // Ten simulated seconds of a 30 fps stream. Fixed 1 ms ticks are the
+  // reference; advance_to_next_due() must land on the same due points, emit
+  // the same frames, and take no idle steps in between.
+  constexpr uint64_t kDeviceId = 8301;
+  constexpr uint64_t kRootId = 8302;
+  constexpr uint64_t kStreamId = 8303;
+  constexpr uint64_t kEndNs = 10'000'000'000ull;
+
+  struct Run {
+    std::vector<uint64_t> frame_hashes;
+    uint64_t steps = 0;
+  };
+  auto run = [&](bool skip_ahead, Run& out) -> bool {
+    RecorderCallbacks cb;
+    SyntheticProviderConfig cfg{};
+    cfg.endpoint_count = 1;
+    cfg.nominal.width = 32;
+    cfg.nominal.height = 16;
+    cfg.nominal.format_fourcc = FOURCC_RGBA;
+    cfg.nominal.fps_num = 30;
+    cfg.nominal.fps_den = 1;
+    cfg.nominal.start_stream_warmup_ns = 0;
+
+    StreamRequest req{};
+    req.stream_id = kStreamId;
+    req.device_instance_id = kDeviceId;
+    req.intent = StreamIntent::PREVIEW;
+    req.profile.width = cfg.nominal.width;
+    req.profile.height = cfg.nominal.height;
+    req.profile.format_fourcc = cfg.nominal.format_fourcc;
+    req.profile.target_fps_min = cfg.nominal.fps_num;
+    req.profile.target_fps_max = cfg.nominal.fps_num;
+
+    SyntheticProvider synthetic(cfg);
+    if (!synthetic.initialize(&cb).ok() ||
+        !synthetic.open_device("synthetic:0", kDeviceId, kRootId).ok() ||
+        !synthetic.create_stream(req).ok() ||
+        !synthetic.start_stream(kStreamId, req.profile, req.picture).ok()) {
+      std::cerr << "FAIL skip-ahead stepping setup failed\n";
+      (void)synthetic.shutdown();
+      return false;
+    }
+    constexpr uint64_t kTickNs = 1'000'000ull;
+    uint64_t now = 0;
+    while (now < kEndNs) {
+      if (skip_ahead) {
+        now += synthetic.advance_to_next_due(kEndNs - now);
+      } else {
+        const uint64_t dt_ns = std::min(kTickNs, kEndNs - now);
+        synthetic.advance(dt_ns);
+        now += dt_ns;
+      }
+      ++out.steps;
+    }
+    for (const EventRec& ev : cb.snapshot_events()) {
+      if (ev.tag == "frame" && ev.id == kStreamId) out.frame_hashes.push_back(ev.payload_hash);
+    }
+    return synthetic.shutdown().ok();
+  };
+
+  Run ticked;
+  Run skipped;
+  if (!run(false, ticked) || !run(true, skipped)) {
+    return false;
+  }
+  if (ticked.frame_hashes.size() < 300 || skipped.frame_hashes != ticked.frame_hashes) {
+    std::cerr << "FAIL skip-ahead stepping frames diverged from fixed ticking (ticked="
+              << ticked.frame_hashes.size() << " skipped=" << skipped.frame_hashes.size() << ")\n";
+    return false;
+  }
+  // One step per emitted frame plus the final step to the end of the window.
+  if (skipped.steps > skipped.frame_hashes.size() + 1) {
+    std::cerr << "FAIL skip-ahead stepping took idle steps: steps=" << skipped.steps
+              << " frames=" << skipped.frame_hashes.size() << "\n";
+    return false;
+  }
+  return true;
+}
+
+bool run_synthetic_headless_frame_content_check() {
+  // Headless streams keep the frame cadence and metadata of rendered ones but
+  // publish one shared all-zero payload per size instead of pattern pixels.
+  constexpr uint32_t kStreams = 4;
+  constexpr uint32_t kWidth = 64;
+  constexpr uint32_t kHeight = 32;
+  RecorderCallbacks cb;
+  SyntheticProviderConfig cfg{};
+  cfg.endpoint_count = kStreams;
+  cfg.nominal.width = kWidth;
+  cfg.nominal.height = kHeight;
+  cfg.nominal.format_fourcc = FOURCC_RGBA;
+  cfg.nominal.fps_num = 30;
+  cfg.nominal.fps_den = 1;
+  cfg.nominal.start_stream_warmup_ns = 0;
+  cfg.frame_content_mode = SyntheticFrameContentMode::Headless;
+
+  SyntheticProvider synthetic(cfg);
+  if (!synthetic.initialize(&cb).ok()) {
+    std::cerr << "FAIL headless frame content initialize failed\n";
+    return false;
+  }
+  for (uint32_t i = 0; i < kStreams; ++i) {
+    StreamRequest req{};
+    req.stream_id = 8401 + i;
+    req.device_instance_id = 8411 + i;
+    req.intent = StreamIntent::PREVIEW;
+    req.profile.width = kWidth;
+    req.profile.height = kHeight;
+    req.profile.format_fourcc = FOURCC_RGBA;
+    req.profile.target_fps_min = 30;
+    req.profile.target_fps_max = 30;
+    const std::string hardware_id = "synthetic:" + std::to_string(i);
+    if (!synthetic.open_device(hardware_id, req.device_instance_id, 8421 + i).ok() ||
+        !synthetic.create_stream(req).ok() ||
+        !synthetic.start_stream(req.stream_id, req.profile, req.picture).ok()) {
+      std::cerr << "FAIL headless frame content stream setup failed\n";
+      (void)synthetic.shutdown();
+      return false;
+    }
+  }
+  uint64_t now = 0;
+  while (now < 1'000'000'000ull) {
+    now += synthetic.advance_to_next_due(1'000'000'000ull - now);
+  }
+  if (!synthetic.shutdown().ok()) {
+    std::cerr << "FAIL headless frame content shutdown failed\n";
+    return false;
+  }
+
+  const std::vector<uint8_t> zeros(static_cast<size_t>(kWidth) * kHeight * 4u, 0);
+  const uint64_t zero_hash = fnv1a64_hash_bytes(zeros.data(), zeros.size());
+  std::map<uint64_t, uint32_t> frames_by_stream;
+  for (const EventRec& ev : cb.snapshot_events()) {
+    if (ev.tag != "frame") {
+      continue;
+    }
+    if (ev.payload_size_bytes != zeros.size() || ev.payload_hash != zero_hash ||
+        ev.format_fourcc != FOURCC_RGBA || ev.primary_backing_kind != ProducerBackingKind::CPU ||
+        !ev.acquisition_timing.has_value()) {
+      std::cerr << "FAIL headless frame content frame metadata or payload mismatch stream_id=" << ev.id << "\n";
+      return false;
+    }
+    ++frames_by_stream[ev.id];
+  }
+  if (frames_by_stream.size() != kStreams) {
+    std::cerr << "FAIL headless frame content expected frames on every stream\n";
+    return false;
+  }
+  for (const auto& [stream_id, frames] : frames_by_stream) {
+    if (frames < 30) {
+      std::cerr << "FAIL headless frame content stream_id=" << stream_id << " frames=" << frames << "\n";
+      return false;
+    }
+  }
+  return true;
+}
+
+bool run_synthetic_looped_frame_content_check() {
+  // Looped streams publish the same pixels as rendered ones, frame by frame,
+  // across several overlay periods (moving bar only: 64 / 4 = 16 frames).
+  constexpr uint32_t kStreams = 2;
+  constexpr uint32_t kWidth = 64;
+  constexpr uint32_t kHeight = 32;
+  const auto run = [&](SyntheticFrameContentMode mode, std::map<uint64_t, std::vector<uint64_t>>& hashes) {
+    RecorderCallbacks cb;
+    SyntheticProviderConfig cfg{};
+    cfg.endpoint_count = kStreams;
+    cfg.nominal.width = kWidth;
+    cfg.nominal.height = kHeight;
+    cfg.nominal.format_fourcc = FOURCC_RGBA;
+    cfg.nominal.fps_num = 30;
+    cfg.nominal.fps_den = 1;
+    cfg.nominal.start_stream_warmup_ns = 0;
+    cfg.producer_output_form_mode = SyntheticProducerOutputFormMode::CpuOnly;
+    cfg.frame_content_mode = mode;
+
+    SyntheticProvider synthetic(cfg);
+    if (!synthetic.initialize(&cb).ok()) {
+      return false;
+    }
+    for (uint32_t i = 0; i < kStreams; ++i) {
+      StreamRequest req{};
+      req.stream_id = 8431 + i;
+      req.device_instance_id = 8441 + i;
+      req.intent = StreamIntent::PREVIEW;
+      req.profile.width = kWidth;
+      req.profile.height = kHeight;
+      req.profile.format_fourcc = FOURCC_RGBA;
+      req.profile.target_fps_min = 30;
+      req.profile.target_fps_max = 30;
+      req.picture.overlay_frame_index_offsets = false;
+      const std::string hardware_id = "synthetic:" + std::to_string(i);
+      if (!synthetic.open_device(hardware_id, req.device_instance_id, 8451 + i).ok() ||
+          !synthetic.create_stream(req).ok() ||
+          !synthetic.start_stream(req.stream_id, req.profile, req.picture).ok()) {
+        (void)synthetic.shutdown();
+        return false;
+      }
+    }
+    uint64_t now = 0;
+    while (now < 2'000'000'000ull) {
+      now += synthetic.advance_to_next_due(2'000'000'000ull - now);
+    }
+    if (!synthetic.shutdown().ok()) {
+      return false;
+    }
+    for (const EventRec& ev : cb.snapshot_events()) {
+      if (ev.tag == "frame") {
+        hashes[ev.id].push_back(ev.payload_hash);
+      }
+    }
+    return true;
+  };
+
+  std::map<uint64_t, std::vector<uint64_t>> rendered;
+  std::map<uint64_t, std::vector<uint64_t>> looped;
+  if (!run(SyntheticFrameContentMode::Rendered, rendered) || !run(SyntheticFrameContentMode::Looped, looped)) {
+    std::cerr << "FAIL looped frame content run failed\n";
+    return false;
+  }
+  if (rendered.size() != kStreams || looped != rendered) {
+    std::cerr << "FAIL looped frame content differs from rendered frame content\n";
+    return false;
+  }
+  for (const auto& [stream_id, hashes] : looped) {
+    if (hashes.size() < 48) {
+      std::cerr << "FAIL looped frame content stream_id=" << stream_id << " frames=" << hashes.size() << "\n";
+      return false;
+    }
+  }
+  return true;
+}
+
+bool run_synthetic_display_demand_governor_check() {
+  // 30 fps; after 10 consecutive undemanded frames only every 4th due frame
+  // is emitted, and demand restores the full rate at the next due point.
+  constexpr uint64_t kDeviceId = 8501;
+  constexpr uint64_t kRootId = 8502;
+  constexpr uint64_t kStreamId = 8503;
+  RecorderCallbacks cb;
+  cb.display_demand_active.store(true, std::memory_order_release);
+  SyntheticProviderConfig cfg{};
+  cfg.endpoint_count = 1;
+  cfg.nominal.width = 16;
+  cfg.nominal.height = 16;
+  cfg.nominal.format_fourcc = FOURCC_RGBA;
+  cfg.nominal.fps_num = 30;
+  cfg.nominal.fps_den = 1;
+  cfg.nominal.idle_demand_frames_before_throttle = 10;
+  cfg.nominal.idle_demand_frame_divisor = 4;
+  cfg.frame_content_mode = SyntheticFrameContentMode::Headless;
+
+  StreamRequest req{};
+  req.stream_id = kStreamId;
+  req.device_instance_id = kDeviceId;
+  req.intent = StreamIntent::PREVIEW;
+  req.profile.width = cfg.nominal.width;
+  req.profile.height = cfg.nominal.height;
+  req.profile.format_fourcc = cfg.nominal.format_fourcc;
+  req.profile.target_fps_min = 30;
+  req.profile.target_fps_max = 30;
+
+  SyntheticProvider synthetic(cfg);
+  if (!synthetic.initialize(&cb).ok() ||
+      !synthetic.open_device("synthetic:0", kDeviceId, kRootId).ok() ||
+      !synthetic.create_stream(req).ok() ||
+      !synthetic.start_stream(kStreamId, req.profile, req.picture).ok()) {
+    std::cerr << "FAIL display demand governor setup failed\n";
+    (void)synthetic.shutdown();
+    return false;
+  }
+  uint64_t now = 0;
+  const auto frames_until = [&](uint64_t end_ns) {
+    while (now < end_ns) {
+      now += synthetic.advance_to_next_due(end_ns - now);
+    }
+    uint32_t frames = 0;
+    for (const EventRec& ev : cb.snapshot_events()) {
+      if (ev.tag == "frame" && ev.id == kStreamId) ++frames;
+    }
+    return frames;
+  };
+  // Due points 0..30 demanded, 31..90 undemanded, 91..120 demanded again.
+  const uint32_t demanded = frames_until(1'000'000'000ull);
+  cb.display_demand_active.store(false, std::memory_order_release);
+  const uint32_t idle = frames_until(3'000'000'000ull) - demanded;
+  cb.display_demand_active.store(true, std::memory_order_release);
+  const uint32_t restored = frames_until(4'000'000'000ull) - demanded - idle;
+  const SyntheticMetricsSnapshot metrics = synthetic.get_metrics_snapshot_for_host();
+  (void)synthetic.shutdown();
+  if (demanded != 31 || idle != 10 + 12 || restored != 30 || metrics.demand_governed_frames_skipped != 38) {
+    std::cerr << "FAIL display demand governor frame counts demanded=" << demanded << " idle=" << idle
+              << " restored=" << restored << " skipped=" << metrics.demand_governed_frames_skipped << "\n";
+    return false;
+  }
+  return true;
+}
+
 bool run_synthetic_external_scenario_loader_check() {
   const std::string json = R"JSON(
 {
@@ -1983,11 +2371,19 @@ bool run_synthetic_external_scenario_loader_check() {
     dispatched.push_back(ev.type);
   });
 
+  const SyntheticScenarioCacheStats cache_before = synthetic_scenario_cache_stats();
   if (!synthetic.load_timeline_canonical_scenario_from_json_text_for_host(json, &error).ok()) {
     std::cerr << "FAIL external loader provider-facing load failed: " << error << "\n";
     (void)synthetic.shutdown();
     return false;
   }
+  // Same text as the pre-load above: served from the compiled-scenario cache.
+  const SyntheticScenarioCacheStats cache_after = synthetic_scenario_cache_stats();
+  if (cache_after.hits != cache_before.hits + 1 || cache_after.misses != cache_before.misses) {
+    std::cerr << "FAIL external loader repeat load missed the compiled scenario cache\n";
+    (void)synthetic.shutdown();
+    return false;
+  }
   if (!synthetic.start_timeline_scenario_for_host().ok()) {
     (void)synthetic.shutdown();
     return false;
@@ -3232,6 +3628,118 @@ bool run_synthetic_live_gpu_backing_truth_check() {
       cb.snapshot_events(), "synthetic_live_gpu_backing_truth");
 }
 
+// A GPU-only stream with a static pattern base has its frames generated by
+// the live backing: the base goes up once per revision, only the overlays
+// change per frame, and a refused generate falls back to a whole-frame CPU
+// update.
+bool run_synthetic_gpu_generated_pattern_check() {
+  {
+    std::lock_guard<std::mutex> lock(g_synthetic_gpu_pattern_probe.mutex);
+    g_synthetic_gpu_pattern_probe.base_revisions.clear();
+    g_synthetic_gpu_pattern_probe.frame_indices.clear();
+    g_synthetic_gpu_pattern_probe.update_calls = 0;
+    g_synthetic_gpu_pattern_probe.whole_frame_updates = 0;
+    g_synthetic_gpu_pattern_probe.fail_generate = false;
+  }
+  set_synthetic_gpu_backing_runtime_ops(&kSyntheticGpuPatternProbeOps);
+  struct OpsClear final {
+    ~OpsClear() { clear_synthetic_gpu_backing_runtime_ops(); }
+  } ops_clear;
+
+  RecorderCallbacks cb;
+  SyntheticProviderConfig cfg{};
+  cfg.endpoint_count = 1;
+  cfg.nominal.width = 16;
+  cfg.nominal.height = 16;
+  cfg.nominal.format_fourcc = FOURCC_RGBA;
+  cfg.nominal.fps_num = 30;
+  cfg.nominal.fps_den = 1;
+  cfg.nominal.start_stream_warmup_ns = 0;
+  cfg.producer_output_form_mode = SyntheticProducerOutputFormMode::GpuOnly;
+
+  constexpr uint64_t kDeviceId = 8211;
+  constexpr uint64_t kRootId = 8212;
+  constexpr uint64_t kStreamId = 8213;
+  StreamRequest req{};
+  req.stream_id = kStreamId;
+  req.device_instance_id = kDeviceId;
+  req.intent = StreamIntent::PREVIEW;
+  req.profile.width = cfg.nominal.width;
+  req.profile.height = cfg.nominal.height;
+  req.profile.format_fourcc = cfg.nominal.format_fourcc;
+  req.profile.target_fps_min = cfg.nominal.fps_num;
+  req.profile.target_fps_max = cfg.nominal.fps_num;
+  req.picture.overlay_frame_index_offsets = true;
+  req.picture.overlay_moving_bar = true;
+
+  SyntheticProvider provider(cfg);
+  if (!provider.initialize(&cb).ok() ||
+      !provider.open_device("synthetic:0", kDeviceId, kRootId).ok() ||
+      !provider.create_stream(req).ok() ||
+      !provider.start_stream(kStreamId, req.profile, req.picture).ok()) {
+    std::cerr << "FAIL synthetic gpu generated pattern setup failed\n";
+    (void)provider.shutdown();
+    return false;
+  }
+
+  auto stream_frame_count = [&cb]() {
+    size_t count = 0;
+    for (const auto& event : cb.snapshot_events()) {
+      if (event.tag == "frame" && event.id == kStreamId && event.capture_id == 0 &&
+          event.primary_backing_kind == ProducerBackingKind::GPU) {
+        ++count;
+      }
+    }
+    return count;
+  };
+
+  constexpr uint64_t kFramePeriodNs = 33'333'334ull;
+  provider.advance(0);
+  for (int i = 0; i < 3; ++i) {
+    provider.advance(kFramePeriodNs);
+  }
+  std::vector<uint64_t> revisions;
+  std::vector<uint64_t> frame_indices;
+  uint64_t update_calls = 0;
+  {
+    std::lock_guard<std::mutex> lock(g_synthetic_gpu_pattern_probe.mutex);
+    revisions = g_synthetic_gpu_pattern_probe.base_revisions;
+    frame_indices = g_synthetic_gpu_pattern_probe.frame_indices;
+    update_calls = g_synthetic_gpu_pattern_probe.update_calls;
+    g_synthetic_gpu_pattern_probe.fail_generate = true;
+  }
+  bool ordered = frame_indices.size() == 4 && frame_indices.back() > frame_indices.front();
+  for (size_t i = 1; ordered && i < frame_indices.size(); ++i) {
+    ordered = frame_indices[i] >= frame_indices[i - 1] && revisions[i] == revisions[0];
+  }
+  if (!ordered || revisions[0] == 0 || update_calls != 0 || stream_frame_count() != 4) {
+    std::cerr << "FAIL synthetic gpu generated pattern frames were not generated from one base revision\n";    (void)provider.shutdown();
+    return false;
+  }
+
+  provider.advance(kFramePeriodNs);
+  uint64_t whole_frame_updates = 0;
+  {
+    std::lock_guard<std::mutex> lock(g_synthetic_gpu_pattern_probe.mutex);
+    update_calls = g_synthetic_gpu_pattern_probe.update_calls;
+    whole_frame_updates = g_synthetic_gpu_pattern_probe.whole_frame_updates;
+  }
+  if (update_calls != 1 || whole_frame_updates != 1 || stream_frame_count() != 5) {
+    std::cerr << "FAIL synthetic gpu generated pattern refused generate did not fall back to a whole-frame update\n";
+    (void)provider.shutdown();
+    return false;
+  }
+
+  if (!provider.stop_stream(kStreamId).ok() ||
+      !provider.destroy_stream(kStreamId).ok() ||
+      !provider.close_device(kDeviceId).ok() ||
+      !provider.shutdown().ok()) {
+    std::cerr << "FAIL synthetic gpu generated pattern teardown failed\n";
+    return false;
+  }
+  return assert_native_balance(cb.snapshot_events(), "synthetic_gpu_generated_pattern");
+}
+
 // ===== Family E: Synthetic frame/picture integration compliance =====
 
 bool run_synthetic_timeline_picture_appearance_check() {
@@ -3335,39 +3843,132 @@ bool run_synthetic_timeline_picture_appearance_check() {
   return assert_native_balance(cb_events_after_teardown, "synthetic_picture_appearance");
 }
 
-bool run_stub_provider_sanity_check() {
-  RecorderCallbacks cb;
-  StubProvider provider;
-
-  StreamRequest req{};
-  req.stream_id = 11;
-  req.device_instance_id = 1;
-  req.intent = StreamIntent::PREVIEW;
-  req.profile.width = 64;
-  req.profile.height = 64;
-  req.profile.format_fourcc = FOURCC_RGBA;
-  req.profile.target_fps_min = 30;
-  req.profile.target_fps_max = 30;
-
-  if (!provider.initialize(&cb).ok()) return false;
-  if (!provider.open_device("stub0", 1, 1001).ok()) return false;
-  if (!provider.create_stream(req).ok()) return false;
-  if (!provider.start_stream(req.stream_id, req.profile, req.picture).ok()) return false;
-  if (!provider.stop_stream(req.stream_id).ok()) return false;
-  if (!provider.destroy_stream(req.stream_id).ok()) return false;
-  if (!provider.close_device(req.device_instance_id).ok()) return false;
-  if (!provider.shutdown().ok()) return false;
-
-  const auto cb_events = cb.snapshot_events();
-  const bool ok = assert_native_balance(cb_events, "stub");
-  return ok;
-}
-
-bool run_synthetic_provider_direct_sanity_check() {
+bool run_synthetic_timeline_periodic_events_check() {
   RecorderCallbacks cb;
   SyntheticProviderConfig cfg{};
+  cfg.synthetic_role = SyntheticRole::Timeline;
+  cfg.timing_driver = TimingDriver::VirtualTime;
   cfg.endpoint_count = 1;
-  cfg.nominal.width = 64;
+  cfg.nominal.fps_num = 30;
+  cfg.nominal.fps_den = 1;
+
+  SyntheticProvider synthetic(cfg);
+  if (!synthetic.initialize(&cb).ok()) {
+    return false;
+  }
+
+  struct Dispatched {
+    uint64_t at_ns = 0;
+    uint64_t stream_id = 0;
+    uint32_t seed = 0;
+  };
+  std::vector<Dispatched> dispatched;
+  synthetic.set_timeline_request_dispatch_hook_for_host([&dispatched](const SyntheticScheduledEvent& ev) {
+    dispatched.push_back({ev.at_ns, ev.stream_id, ev.picture.seed});
+  });
+  auto fail = [&synthetic](const char* what) {
+    std::cerr << "FAIL synthetic timeline periodic events: " << what << "\n";
+    synthetic.set_timeline_request_dispatch_hook_for_host({});
+    (void)synthetic.shutdown();
+    return false;
+  };
+
+  SyntheticTimelineScenario scenario{};
+  SyntheticScheduledEvent authored{};
+  authored.at_ns = 1000;
+  authored.type = SyntheticEventType::UpdateStreamPicture;
+  authored.stream_id = 1;
+  authored.has_picture = true;
+  authored.picture.seed = 1;
+  scenario.events.push_back(authored);
+
+  // A run long enough that materializing it would be noticeable; only one
+  // occurrence is ever queued.
+  SyntheticPeriodicEvents endless{};
+  endless.start_ns = 0;
+  endless.period_ns = 1000;
+  endless.count = 100'000'000ull;
+  endless.event.type = SyntheticEventType::UpdateStreamPicture;
+  endless.event.stream_id = 2;
+  endless.event.has_picture = true;
+  endless.event.picture.seed = 2;
+  scenario.periodic.push_back(endless);
+
+  SyntheticPeriodicEvents short_run = endless;
+  short_run.start_ns = 500;
+  short_run.count = 2;
+  short_run.event.stream_id = 3;
+  short_run.event.picture.seed = 3;
+  scenario.periodic.push_back(short_run);
+
+  if (!synthetic.set_timeline_scenario_for_host(scenario).ok() ||
+      !synthetic.start_timeline_scenario_for_host().ok()) {
+    return fail("scenario start rejected");
+  }
+  synthetic.advance(3000);
+
+  const std::vector<std::pair<uint64_t, uint64_t>> expected = {
+      {0, 2}, {500, 3}, {1000, 1}, {1000, 2}, {1500, 3}, {2000, 2}, {3000, 2},
+  };
+  if (dispatched.size() != expected.size()) {
+    return fail("dispatch count mismatch");
+  }
+  for (size_t i = 0; i < expected.size(); ++i) {
+    if (dispatched[i].at_ns != expected[i].first || dispatched[i].stream_id != expected[i].second) {
+      return fail("dispatch order mismatch");
+    }
+    if (dispatched[i].seed != static_cast<uint32_t>(dispatched[i].stream_id)) {
+      return fail("picture payload mismatch");
+    }
+  }
+
+  // Stopping drops the generators with the rest of the queue.
+  if (!synthetic.stop_timeline_scenario_for_host().ok()) {
+    return fail("scenario stop rejected");
+  }
+  dispatched.clear();
+  synthetic.advance(10'000);
+  if (!dispatched.empty()) {
+    return fail("dispatch after stop");
+  }
+
+  synthetic.set_timeline_request_dispatch_hook_for_host({});
+  return synthetic.shutdown().ok();
+}
+
+bool run_stub_provider_sanity_check() {
+  RecorderCallbacks cb;
+  StubProvider provider;
+
+  StreamRequest req{};
+  req.stream_id = 11;
+  req.device_instance_id = 1;
+  req.intent = StreamIntent::PREVIEW;
+  req.profile.width = 64;
+  req.profile.height = 64;
+  req.profile.format_fourcc = FOURCC_RGBA;
+  req.profile.target_fps_min = 30;
+  req.profile.target_fps_max = 30;
+
+  if (!provider.initialize(&cb).ok()) return false;
+  if (!provider.open_device("stub0", 1, 1001).ok()) return false;
+  if (!provider.create_stream(req).ok()) return false;
+  if (!provider.start_stream(req.stream_id, req.profile, req.picture).ok()) return false;
+  if (!provider.stop_stream(req.stream_id).ok()) return false;
+  if (!provider.destroy_stream(req.stream_id).ok()) return false;
+  if (!provider.close_device(req.device_instance_id).ok()) return false;
+  if (!provider.shutdown().ok()) return false;
+
+  const auto cb_events = cb.snapshot_events();
+  const bool ok = assert_native_balance(cb_events, "stub");
+  return ok;
+}
+
+bool run_synthetic_provider_direct_sanity_check() {
+  RecorderCallbacks cb;
+  SyntheticProviderConfig cfg{};
+  cfg.endpoint_count = 1;
+  cfg.nominal.width = 64;
   cfg.nominal.height = 64;
   cfg.nominal.format_fourcc = FOURCC_RGBA;
   SyntheticProvider provider(cfg);
@@ -3447,6 +4048,70 @@ bool run_synthetic_provider_direct_sanity_check() {
   return assert_native_balance(cb_events, "synthetic_direct");
 }
 
+bool run_synthetic_realtime_pacing_check() {
+  RecorderCallbacks cb;
+  SyntheticProviderConfig cfg{};
+  cfg.timing_driver = TimingDriver::RealTime;
+  cfg.endpoint_count = 1;
+  cfg.nominal.width = 64;
+  cfg.nominal.height = 64;
+  cfg.nominal.format_fourcc = FOURCC_RGBA;
+  SyntheticProvider provider(cfg);
+
+  StreamRequest req{};
+  req.stream_id = 13;
+  req.device_instance_id = 3;
+  req.intent = StreamIntent::PREVIEW;
+  req.profile.width = 64;
+  req.profile.height = 64;
+  req.profile.format_fourcc = FOURCC_RGBA;
+  req.profile.target_fps_min = 30;
+  req.profile.target_fps_max = 30;
+
+  if (!provider.initialize(&cb).ok() ||
+      !provider.open_device("synthetic:0", req.device_instance_id, 2003).ok() ||
+      !provider.create_stream(req).ok() ||
+      !provider.start_stream(req.stream_id, req.profile, req.picture).ok()) {
+    std::cerr << "FAIL synthetic real-time pacing setup failed\n";
+    (void)provider.shutdown();
+    return false;
+  }
+
+  // Nothing advances the provider here: the pacer alone has to keep frames
+  // coming at the stream's cadence.
+  constexpr size_t kWantFrames = 6;
+  const auto count_frames = [&]() {
+    size_t frames = 0;
+    for (const EventRec& event : cb.snapshot_events()) {
+      if (event.tag == "frame" && event.id == req.stream_id) {
+        ++frames;
+      }
+    }
+    return frames;
+  };
+  bool paced = false;
+  for (int i = 0; i < kMaxIters && !paced; ++i) {
+    paced = count_frames() >= kWantFrames;
+    if (!paced) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(kSleepMs));
+    }
+  }
+  if (!paced) {
+    std::cerr << "FAIL synthetic real-time pacing produced no cadence without host ticks\n";
+    (void)provider.shutdown();
+    return false;
+  }
+
+  if (!provider.stop_stream(req.stream_id).ok() ||
+      !provider.destroy_stream(req.stream_id).ok() ||
+      !provider.close_device(req.device_instance_id).ok() ||
+      !provider.shutdown().ok()) {
+    std::cerr << "FAIL synthetic real-time pacing teardown failed\n";
+    return false;
+  }
+  return assert_native_balance(cb.snapshot_events(), "synthetic_realtime_pacing");
+}
+
 bool run_synthetic_capture_executor_correctness_check() {
   RecorderCallbacks cb;
   SyntheticProviderConfig cfg{};
@@ -3784,6 +4449,100 @@ bool run_synthetic_capture_executor_correctness_check() {
       cb.snapshot_events(), "synthetic_capture_executor_correctness");
 }
 
+bool run_synthetic_capture_in_flight_depth_check() {
+  RecorderCallbacks cb;
+  SyntheticProviderConfig cfg{};
+  cfg.endpoint_count = 2;
+  cfg.nominal.width = 8;
+  cfg.nominal.height = 8;
+  cfg.nominal.format_fourcc = FOURCC_RGBA;
+  cfg.max_in_flight_captures_per_device = 2;
+  SyntheticProvider provider(cfg);
+
+  constexpr uint64_t kDeviceA = 711;
+  constexpr uint64_t kDeviceB = 712;
+  constexpr uint64_t kFirstCapture = 72000;
+  constexpr uint64_t kSecondCapture = 72001;
+  constexpr uint64_t kRejectedCapture = 72002;
+  constexpr uint64_t kSiblingCapture = 72003;
+  constexpr uint64_t kFreedCapture = 72004;
+  const auto make_request = [](uint64_t capture_id, uint64_t device_id) {
+    return make_direct_provider_default_still_capture_request(
+        capture_id, device_id, 8, 8, FOURCC_RGBA);
+  };
+  const auto fail = [&](const char* what) {
+    std::cerr << "FAIL synthetic capture in-flight depth " << what << "\n";
+    (void)provider.shutdown();
+    return false;
+  };
+
+  if (!provider.initialize(&cb).ok() ||
+      !provider.open_device("synthetic:0", kDeviceA, 71101).ok() ||
+      !provider.open_device("synthetic:1", kDeviceB, 71201).ok()) {
+    return fail("setup failed");
+  }
+
+  // Held in the queue, both admitted captures count against device A's depth;
+  // the third is refused while device B keeps its own depth.
+  provider.set_capture_workers_paused_for_test(true);
+  if (!provider.trigger_capture(make_request(kFirstCapture, kDeviceA)).ok() ||
+      !provider.trigger_capture(make_request(kSecondCapture, kDeviceA)).ok()) {
+    return fail("did not admit up to the configured depth");
+  }
+  const ProviderResult rejected =
+      provider.trigger_capture(make_request(kRejectedCapture, kDeviceA));
+  if (rejected.ok() || rejected.code != ProviderError::ERR_BUSY) {
+    return fail("did not refuse a capture past the configured depth");
+  }
+  if (!provider.trigger_capture(make_request(kSiblingCapture, kDeviceB)).ok()) {
+    return fail("refused a capture on a sibling device");
+  }
+  provider.set_capture_workers_paused_for_test(false);
+
+  if (!wait_for_capture_completed_with_frames(cb, kFirstCapture, 1) ||
+      !wait_for_capture_completed_with_frames(cb, kSecondCapture, 1) ||
+      !wait_for_capture_completed_with_frames(cb, kSiblingCapture, 1)) {
+    return fail("admitted captures did not complete");
+  }
+  if (!provider.trigger_capture(make_request(kFreedCapture, kDeviceA)).ok() ||
+      !wait_for_capture_completed_with_frames(cb, kFreedCapture, 1)) {
+    return fail("depth was not returned on completion");
+  }
+
+  // Device A's terminals land in admission order, and the refused capture
+  // left no trace.
+  size_t first_completed = 0;
+  size_t second_completed = 0;
+  size_t rejected_events = 0;
+  const auto cb_events = cb.snapshot_events();
+  for (size_t i = 0; i < cb_events.size(); ++i) {
+    const EventRec& event = cb_events[i];
+    if (event.tag == "capture_completed" && event.id == kFirstCapture) {
+      first_completed = i + 1;
+    } else if (event.tag == "capture_completed" && event.id == kSecondCapture) {
+      second_completed = i + 1;
+    }
+    if (event.id == kRejectedCapture || event.capture_id == kRejectedCapture) {
+      ++rejected_events;
+    }
+  }
+  if (first_completed == 0 || second_completed <= first_completed) {
+    return fail("terminals were not posted in admission order");
+  }
+  if (rejected_events != 0) {
+    return fail("refused capture produced facts");
+  }
+
+  (void)provider.close_device(kDeviceA);
+  (void)provider.close_device(kDeviceB);
+  if (!provider.shutdown().ok()) {
+    std::cerr << "FAIL synthetic capture in-flight depth teardown failed\n";
+    return false;
+  }
+  return assert_native_balance(
+      cb.snapshot_events(), "synthetic_capture_in_flight_depth");
+}
+
 bool run_synthetic_still_only_acquisition_session_truth_check() {
   RecorderCallbacks cb;
   SyntheticProviderConfig cfg{};
@@ -3933,6 +4692,186 @@ bool run_synthetic_multi_member_still_sequence_check() {
   return assert_native_balance(cb_events, "synthetic_multi_member_still_sequence");
 }
 
+bool run_synthetic_concurrent_bracket_capture_ordering_check() {
+  RecorderCallbacks cb;
+  SyntheticProviderConfig cfg{};
+  cfg.endpoint_count = 8;
+  cfg.nominal.width = 64;
+  cfg.nominal.height = 64;
+  cfg.nominal.format_fourcc = FOURCC_RGBA;
+  SyntheticProvider provider(cfg);
+
+  constexpr size_t kDeviceCount = 8;
+  constexpr uint64_t kDeviceBase = 801;
+  constexpr uint64_t kCaptureBase = 8100;
+  const std::vector<int32_t> additional_evs{-2000, -1000, 1000, 2000};
+  if (!provider.initialize(&cb).ok()) {
+    std::cerr << "FAIL synthetic concurrent bracket setup failed\n";
+    return false;
+  }
+  for (size_t d = 0; d < kDeviceCount; ++d) {
+    const std::string hardware_id = "synthetic:" + std::to_string(d);
+    if (!provider.open_device(hardware_id, kDeviceBase + d, (kDeviceBase + d) * 100 + 1).ok()) {
+      std::cerr << "FAIL synthetic concurrent bracket open_device failed\n";
+      (void)provider.shutdown();
+      return false;
+    }
+  }
+
+  // Every device job is queued at once, so device jobs and their bracket
+  // members spread over the capture workers.
+  for (size_t d = 0; d < kDeviceCount; ++d) {
+    const CaptureRequest req = make_direct_provider_multi_member_still_capture_request(
+        kCaptureBase + d, kDeviceBase + d, 64, 64, FOURCC_RGBA, additional_evs);
+    if (!provider.trigger_capture(req).ok()) {
+      std::cerr << "FAIL synthetic concurrent bracket trigger_capture failed\n";
+      (void)provider.shutdown();
+      return false;
+    }
+  }
+  const size_t member_count = additional_evs.size() + 1;
+  for (size_t d = 0; d < kDeviceCount; ++d) {
+    if (!wait_for_capture_completed_with_frames(cb, kCaptureBase + d, member_count)) {
+      std::cerr << "FAIL synthetic concurrent bracket capture did not complete\n";
+      (void)provider.shutdown();
+      return false;
+    }
+  }
+  for (size_t d = 0; d < kDeviceCount; ++d) {
+    (void)provider.close_device(kDeviceBase + d);
+  }
+  if (!provider.shutdown().ok()) {
+    std::cerr << "FAIL synthetic concurrent bracket teardown failed\n";
+    return false;
+  }
+
+  // Per capture: started, then every member in bundle order with its own
+  // pixels, then completed -- whichever worker prepared each member.
+  const auto cb_events = cb.snapshot_events();
+  for (size_t d = 0; d < kDeviceCount; ++d) {
+    const uint64_t capture_id = kCaptureBase + d;
+    std::vector<std::string> lifecycle;
+    std::vector<EventRec> frames;
+    for (const EventRec& ev : cb_events) {
+      if (ev.tag == "frame" && ev.capture_id == capture_id) {
+        lifecycle.push_back("frame");
+        frames.push_back(ev);
+      } else if ((ev.tag == "capture_started" || ev.tag == "capture_completed" ||
+                  ev.tag == "capture_failed") &&
+                 ev.id == capture_id) {
+        lifecycle.push_back(ev.tag);
+      }
+    }
+    if (lifecycle.size() != member_count + 2 || lifecycle.front() != "capture_started" ||
+        lifecycle.back() != "capture_completed" || frames.size() != member_count) {
+      std::cerr << "FAIL synthetic concurrent bracket lifecycle ordering mismatch capture_id=" << capture_id << "\n";
+      return false;
+    }
+    for (size_t i = 0; i < frames.size(); ++i) {
+      const int32_t want_ev = i == 0 ? 0 : additional_evs[i - 1];
+      if (frames[i].capture_image_member_index != i ||
+          frames[i].capture_image_applied_exposure_compensation_milli_ev != want_ev ||
+          frames[i].payload_size_bytes == 0 ||
+          (i > 0 && frames[i].payload_hash == frames[i - 1].payload_hash)) {
+        std::cerr << "FAIL synthetic concurrent bracket member order/payload mismatch capture_id=" << capture_id
+                  << " member=" << i << "\n";
+        return false;
+      }
+    }
+  }
+  return assert_native_balance(cb_events, "synthetic_concurrent_bracket_capture");
+}
+
+bool run_synthetic_rig_capture_start_barrier_check() {
+  RecorderCallbacks cb;
+  SyntheticProviderConfig cfg{};
+  cfg.endpoint_count = 3;
+  SyntheticProvider provider(cfg);
+
+  constexpr uint64_t kRigId = 91;
+  constexpr uint64_t kCaptureId = 9100;
+  constexpr uint64_t kDeviceBase = 911;
+  // Very different render costs: without the start barrier the small members
+  // post capture_started long before the large one finishes rendering.
+  const uint32_t sizes[3] = {16, 16, 2048};
+  if (!provider.initialize(&cb).ok()) {
+    std::cerr << "FAIL synthetic rig start barrier setup failed\n";
+    return false;
+  }
+  CaptureSubmission submission{};
+  submission.capture_id = kCaptureId;
+  submission.origin = CaptureSubmissionOrigin::RIG_CAPTURE;
+  submission.rig_id = kRigId;
+  for (uint64_t d = 0; d < 3; ++d) {
+    if (!provider.open_device("synthetic:" + std::to_string(d), kDeviceBase + d,
+                              (kDeviceBase + d) * 100 + 1).ok()) {
+      std::cerr << "FAIL synthetic rig start barrier open_device failed\n";
+      (void)provider.shutdown();
+      return false;
+    }
+    CaptureRequest req = make_direct_provider_default_still_capture_request(
+        kCaptureId, kDeviceBase + d, sizes[d], sizes[d], FOURCC_RGBA);
+    req.rig_id = kRigId;
+    submission.device_requests.push_back(req);
+  }
+
+  if (!provider.trigger_capture_submission(submission).ok()) {
+    std::cerr << "FAIL synthetic rig start barrier submission rejected\n";
+    (void)provider.shutdown();
+    return false;
+  }
+  size_t completed = 0;
+  for (int i = 0; i < kMaxIters && completed < 3; ++i) {
+    completed = 0;
+    for (const EventRec& ev : cb.snapshot_events()) {
+      if (ev.tag == "capture_completed" && ev.id == kCaptureId) {
+        ++completed;
+      }
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(kSleepMs));
+  }
+  for (uint64_t d = 0; d < 3; ++d) {
+    (void)provider.close_device(kDeviceBase + d);
+  }
+  (void)provider.shutdown();
+  if (completed != 3) {
+    std::cerr << "FAIL synthetic rig start barrier capture did not complete\n";
+    return false;
+  }
+
+  uint64_t first_ns = UINT64_MAX;
+  uint64_t last_ns = 0;
+  {
+    std::lock_guard<std::mutex> lk(cb.mu);
+    for (uint64_t d = 0; d < 3; ++d) {
+      const auto it = cb.capture_started_steady_ns_by_device.find(kDeviceBase + d);
+      if (it == cb.capture_started_steady_ns_by_device.end()) {
+        std::cerr << "FAIL synthetic rig start barrier member never started\n";
+        return false;
+      }
+      first_ns = std::min(first_ns, it->second);
+      last_ns = std::max(last_ns, it->second);
+    }
+  }
+  std::cout << "synthetic rig start barrier skew_ns=" << (last_ns - first_ns) << "\n";
+  // Released members start together only if they can run at once; with
+  // fewer cores than members the scheduler adds to the skew, so only the
+  // sequential skew the barrier removed (about 35 ms here) is ruled out.
+  const unsigned cores = std::thread::hardware_concurrency();
+  uint64_t max_skew_ns = 2'000'000;
+  if (cores < 3) {
+    max_skew_ns = 20'000'000;
+    std::cout << "SKIP synthetic rig start barrier 2 ms skew bound: " << cores
+              << " cores for 3 members, checking 20 ms instead\n";
+  }
+  if (last_ns - first_ns > max_skew_ns) {
+    std::cerr << "FAIL synthetic rig start barrier members did not start together skew_ns="
+              << (last_ns - first_ns) << "\n";
+    return false;
+  }
+  return assert_native_balance(cb.snapshot_events(), "synthetic_rig_capture_start_barrier");
+}
+
 bool run_synthetic_dynamic_still_bundle_shape_check() {
   RecorderCallbacks cb;
   SyntheticProviderConfig cfg{};
@@ -5260,11 +6199,13 @@ bool run_core_capture_result_fact_resolution_check() {
       bracket_result->admission_context.geolocation->longitude_degrees() != -0.12 ||
       bracket_result->admission_context.geolocation->altitude_meters() != 35.0 ||
       !has_synthetic_image_facts(*bracket_member_0) ||
-      !has_synthetic_image_facts(*bracket_member_1)) {
+      !has_synthetic_image_facts(*bracket_member_1) ||
+      !bracket_member_0->resolved_image_facts.camera ||
+      !bracket_member_1->resolved_image_facts.camera) {
     return fail_with_cleanup("FAIL core result fact resolution admission context was not retained");
   }
-  const CameraStaticFacts& a0 = bracket_member_0->resolved_image_facts.camera;
-  const CameraStaticFacts& a1 = bracket_member_1->resolved_image_facts.camera;
+  const CameraStaticFacts& a0 = *bracket_member_0->resolved_image_facts.camera;
+  const CameraStaticFacts& a1 = *bracket_member_1->resolved_image_facts.camera;
   if (!a0.facing || !a0.nature || !a0.sensor_orientation || !a0.intrinsics ||
       !a0.distortion || !a0.pose ||
       a0.facing->value != CameraFacing::FRONT ||
@@ -5297,15 +6238,15 @@ bool run_core_capture_result_fact_resolution_check() {
   if (!absent_result || !absent_member || !absent_result->has_admission_context ||
       absent_result->admission_context.capture_date_time.unix_epoch_nanoseconds() != 200 ||
       !has_synthetic_image_facts(*absent_member) ||
-      absent_member->resolved_image_facts.camera.facing ||
-      absent_member->resolved_image_facts.camera.nature ||
-      absent_member->resolved_image_facts.camera.sensor_orientation ||
-      absent_member->resolved_image_facts.camera.pose ||
-      !absent_member->resolved_image_facts.camera.intrinsics ||
-      absent_member->resolved_image_facts.camera.intrinsics->origin !=
+      absent_member->resolved_image_facts.camera->facing ||
+      absent_member->resolved_image_facts.camera->nature ||
+      absent_member->resolved_image_facts.camera->sensor_orientation ||
+      absent_member->resolved_image_facts.camera->pose ||
+      !absent_member->resolved_image_facts.camera->intrinsics ||
+      absent_member->resolved_image_facts.camera->intrinsics->origin !=
           FactOrigin::VIRTUAL_CAMERA_AUTHORED ||
-      !absent_member->resolved_image_facts.camera.distortion ||
-      absent_member->resolved_image_facts.camera.distortion->origin !=
+      !absent_member->resolved_image_facts.camera->distortion ||
+      absent_member->resolved_image_facts.camera->distortion->origin !=
           FactOrigin::VIRTUAL_CAMERA_AUTHORED) {
     return fail_with_cleanup("FAIL core result fact resolution absence was not preserved");
   }
@@ -5355,16 +6296,16 @@ bool run_core_capture_result_fact_resolution_check() {
       !has_synthetic_image_facts(*rig_a_member_1) ||
       !has_synthetic_image_facts(*rig_b_member) ||
       !has_synthetic_image_facts(*rig_b_member_1) ||
-      !rig_b_member->resolved_image_facts.camera.nature ||
-      rig_b_member->resolved_image_facts.camera.nature->value != CameraNature::HYBRID ||
-      rig_b_member->resolved_image_facts.camera.nature->origin != FactOrigin::USER_SUPPLIED ||
-      !rig_b_member->resolved_image_facts.camera.intrinsics ||
-      rig_b_member->resolved_image_facts.camera.intrinsics->origin !=
+      !rig_b_member->resolved_image_facts.camera->nature ||
+      rig_b_member->resolved_image_facts.camera->nature->value != CameraNature::HYBRID ||
+      rig_b_member->resolved_image_facts.camera->nature->origin != FactOrigin::USER_SUPPLIED ||
+      !rig_b_member->resolved_image_facts.camera->intrinsics ||
+      rig_b_member->resolved_image_facts.camera->intrinsics->origin !=
           FactOrigin::VIRTUAL_CAMERA_AUTHORED ||
-      !rig_b_member->resolved_image_facts.camera.pose ||
-      rig_b_member->resolved_image_facts.camera.pose->value.translation_m().x != 1.0 ||
-      !rig_a_member->resolved_image_facts.camera.pose ||
-      rig_a_member->resolved_image_facts.camera.pose->value.translation_m().x != 10.0) {
+      !rig_b_member->resolved_image_facts.camera->pose ||
+      rig_b_member->resolved_image_facts.camera->pose->value.translation_m().x != 1.0 ||
+      !rig_a_member->resolved_image_facts.camera->pose ||
+      rig_a_member->resolved_image_facts.camera->pose->value.translation_m().x != 10.0) {
     return fail_with_cleanup("FAIL core result fact resolution rig isolation/context failed");
   }
 
@@ -5377,8 +6318,8 @@ bool run_core_capture_result_fact_resolution_check() {
         return facts && facts->static_facts.nature &&
                facts->static_facts.nature->value == CameraNature::PHYSICAL;
       }) ||
-      !bracket_member_0->resolved_image_facts.camera.nature ||
-      bracket_member_0->resolved_image_facts.camera.nature->value != CameraNature::VIRTUAL ||
+      !bracket_member_0->resolved_image_facts.camera->nature ||
+      bracket_member_0->resolved_image_facts.camera->nature->value != CameraNature::VIRTUAL ||
       !bracket_result->capture_image_facts_finalized) {
     return fail_with_cleanup("FAIL core result fact resolution completed result was mutable");
   }
@@ -5435,43 +6376,1067 @@ bool run_core_synthetic_three_member_realized_unknown_propagation_check() {
     return fail_with_cleanup("FAIL core synthetic realized-unknown materialize request failed");
   }
 
-  req.capture_id = 9702;
-  req.still_image_bundle = make_default_metered_still_image_bundle();
-  req.still_image_bundle.members.push_back(
-      CaptureStillImageMember{1u, CaptureStillImageMemberRole::ADDITIONAL_BRACKET, -1000});
-  req.still_image_bundle.members.push_back(
-      CaptureStillImageMember{2u, CaptureStillImageMemberRole::ADDITIONAL_BRACKET, +1000});
-  if (!provider.trigger_capture(req).ok()) {
-    return fail_with_cleanup("FAIL core synthetic realized-unknown trigger_capture failed");
+  req.capture_id = 9702;
+  req.still_image_bundle = make_default_metered_still_image_bundle();
+  req.still_image_bundle.members.push_back(
+      CaptureStillImageMember{1u, CaptureStillImageMemberRole::ADDITIONAL_BRACKET, -1000});
+  req.still_image_bundle.members.push_back(
+      CaptureStillImageMember{2u, CaptureStillImageMemberRole::ADDITIONAL_BRACKET, +1000});
+  if (!provider.trigger_capture(req).ok()) {
+    return fail_with_cleanup("FAIL core synthetic realized-unknown trigger_capture failed");
+  }
+
+  SharedCaptureResultData result;
+  for (int i = 0; i < 50; ++i) {
+    result = rt.get_capture_result(req.capture_id, device_id);
+    if (result) break;
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+  }
+  if (!result || result->image_member_count() != 3 || !result->has_additional_images()) {
+    return fail_with_cleanup("FAIL core synthetic realized-unknown retained result missing/shape mismatch");
+  }
+  const auto* m0 = result->image_member_at(0);
+  const auto* m1 = result->image_member_at(1);
+  const auto* m2 = result->image_member_at(2);
+  if (!m0 || !m1 || !m2) {
+    return fail_with_cleanup("FAIL core synthetic realized-unknown retained members missing");
+  }
+  if (!m0->has_realized_exposure_compensation_milli_ev ||
+      !m1->has_realized_exposure_compensation_milli_ev ||
+      m0->realized_exposure_compensation_milli_ev != m0->applied_exposure_compensation_milli_ev ||
+      m1->realized_exposure_compensation_milli_ev != m1->applied_exposure_compensation_milli_ev) {
+    return fail_with_cleanup("FAIL core synthetic realized-unknown expected realized-known for members 0/1");
+  }
+  if (m2->has_realized_exposure_compensation_milli_ev) {
+    return fail_with_cleanup("FAIL core synthetic realized-unknown expected has_realized=false for member 2");
+  }
+
+  rt.stop();
+  rt.attach_provider(nullptr);
+  return true;
+}
+
+bool run_core_synthetic_live_stream_reconfigure_check() {
+  CoreRuntime rt;
+  if (!rt.start()) {
+    std::cerr << "FAIL core synthetic stream reconfigure runtime start failed\n";
+    return false;
+  }
+  if (!wait_for_core_runtime_live(rt)) {
+    std::cerr << "FAIL core synthetic stream reconfigure runtime did not reach LIVE\n";
+    rt.stop();
+    return false;
+  }
+
+  SyntheticProviderConfig cfg{};
+  cfg.endpoint_count = 1;
+  cfg.nominal.width = 64;
+  cfg.nominal.height = 64;
+  cfg.nominal.format_fourcc = FOURCC_RGBA;
+  SyntheticProvider provider(cfg);
+  const auto fail_with_cleanup = [&](const char* msg) -> bool {
+    std::cerr << msg << "\n";
+    (void)provider.shutdown();
+    rt.stop();
+    rt.attach_provider(nullptr);
+    return false;
+  };
+  if (!provider.initialize(rt.provider_callbacks()).ok()) {
+    return fail_with_cleanup("FAIL core synthetic stream reconfigure provider init failed");
+  }
+  rt.attach_provider(&provider);
+  std::vector<CameraEndpoint> eps;
+  if (!provider.enumerate_endpoints(eps).ok() || eps.empty()) {
+    return fail_with_cleanup("FAIL core synthetic stream reconfigure enumerate failed");
+  }
+
+  constexpr uint64_t kDeviceId = 66;
+  constexpr uint64_t kStreamId = 6602;
+  if (rt.try_open_device(eps[0].hardware_id, kDeviceId, 6601) != TryOpenDeviceStatus::OK ||
+      rt.try_create_stream(kStreamId, kDeviceId, StreamIntent::PREVIEW, nullptr, nullptr, 0) !=
+          TryCreateStreamStatus::OK ||
+      rt.try_start_stream(kStreamId) != TryStartStreamStatus::OK) {
+    return fail_with_cleanup("FAIL core synthetic stream reconfigure stream setup failed");
+  }
+  const auto wait_for_result_at = [&](uint32_t w, uint32_t h) -> SharedStreamResultData {
+    for (int i = 0; i < 200; ++i) {
+      provider.advance(33'333'333);
+      const SharedStreamResultData result = rt.get_latest_stream_result(kStreamId);
+      if (result && result->image_width == w && result->image_height == h) {
+        return result;
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+    return nullptr;
+  };
+  const SharedStreamResultData before = wait_for_result_at(64, 64);
+  const CoreStreamRegistry::StreamRecord* rec = rt.stream_record(kStreamId);
+  if (!before || !rec) {
+    return fail_with_cleanup("FAIL core synthetic stream reconfigure first result missing");
+  }
+  const uint64_t version_before = rec->profile_version;
+
+  CaptureProfile profile = rec->profile;
+  profile.width = 32;
+  profile.height = 24;
+  if (rt.try_reconfigure_stream(kStreamId, CaptureProfile{}) !=
+      TryReconfigureStreamStatus::InvalidArgument) {
+    return fail_with_cleanup("FAIL core synthetic stream reconfigure accepted an empty profile");
+  }
+  if (rt.try_reconfigure_stream(kStreamId, profile) != TryReconfigureStreamStatus::OK) {
+    return fail_with_cleanup("FAIL core synthetic stream reconfigure was not accepted");
+  }
+  rec = rt.stream_record(kStreamId);
+  if (!rec || !rec->started || rec->profile.width != 32 || rec->profile.height != 24 ||
+      rec->profile_version == version_before || rec->reconfigurations != 1) {
+    return fail_with_cleanup("FAIL core synthetic stream reconfigure record mismatch");
+  }
+  // The old result stays readable until a frame at the new profile lands.
+  const SharedStreamResultData held = rt.get_latest_stream_result(kStreamId);
+  if (!held || (held->image_width != 64 && held->image_width != 32)) {
+    return fail_with_cleanup("FAIL core synthetic stream reconfigure dropped the retained result");
+  }
+
+  if (!wait_for_result_at(32, 24)) {
+    return fail_with_cleanup("FAIL core synthetic stream reconfigure new-profile frame missing");
+  }
+  rec = rt.stream_record(kStreamId);
+  if (!rec || rec->reconfigure_pending_since_ns != 0 || rec->last_reconfigure_latency_ns == 0) {
+    return fail_with_cleanup("FAIL core synthetic stream reconfigure latency not reported");
+  }
+
+  if (rt.try_stop_stream(kStreamId) != TryStopStreamStatus::OK ||
+      rt.try_destroy_stream(kStreamId) != TryDestroyStreamStatus::OK ||
+      rt.try_close_device(kDeviceId) != TryCloseDeviceStatus::OK) {
+    return fail_with_cleanup("FAIL core synthetic stream reconfigure teardown failed");
+  }
+  (void)provider.shutdown();
+  rt.stop();
+  rt.attach_provider(nullptr);
+  return true;
+}
+
+bool run_core_stream_recording_check() {
+  CoreRuntime rt;
+  if (!rt.start()) {
+    std::cerr << "FAIL core stream recording runtime start failed\n";
+    return false;
+  }
+  if (!wait_for_core_runtime_live(rt)) {
+    std::cerr << "FAIL core stream recording runtime did not reach LIVE\n";
+    rt.stop();
+    return false;
+  }
+
+  std::error_code ec;
+  const std::filesystem::path dir =
+      std::filesystem::temp_directory_path(ec) /
+      ("cambang-stream-recording-verify-" +
+       std::to_string(std::chrono::steady_clock::now().time_since_epoch().count()));
+  std::filesystem::create_directories(dir, ec);
+  const std::filesystem::path path = dir / "stream.cbrec";
+  const auto remove_dir = [&]() { std::filesystem::remove_all(dir, ec); };
+
+  SyntheticProviderConfig cfg{};
+  cfg.endpoint_count = 1;
+  cfg.nominal.width = 64;
+  cfg.nominal.height = 64;
+  cfg.nominal.format_fourcc = FOURCC_RGBA;
+  SyntheticProvider provider(cfg);
+  const auto fail_with_cleanup = [&](const char* msg) -> bool {
+    std::cerr << msg << "\n";
+    (void)provider.shutdown();
+    rt.stop();
+    rt.attach_provider(nullptr);
+    remove_dir();
+    return false;
+  };
+  if (!provider.initialize(rt.provider_callbacks()).ok()) {
+    return fail_with_cleanup("FAIL core stream recording provider init failed");
+  }
+  rt.attach_provider(&provider);
+  std::vector<CameraEndpoint> eps;
+  if (!provider.enumerate_endpoints(eps).ok() || eps.empty()) {
+    return fail_with_cleanup("FAIL core stream recording enumerate failed");
+  }
+
+  constexpr uint64_t kDeviceId = 69;
+  constexpr uint64_t kStreamId = 6902;
+  if (rt.try_open_device(eps[0].hardware_id, kDeviceId, 6901) != TryOpenDeviceStatus::OK ||
+      rt.try_create_stream(kStreamId, kDeviceId, StreamIntent::PREVIEW, nullptr, nullptr, 0) !=
+          TryCreateStreamStatus::OK) {
+    return fail_with_cleanup("FAIL core stream recording stream setup failed");
+  }
+  if (rt.try_start_stream_recording(kStreamId + 1, path) != TryStreamRecordingStatus::InvalidArgument ||
+      rt.try_stop_stream_recording(kStreamId) != TryStreamRecordingStatus::InvalidArgument ||
+      rt.try_start_stream_recording(kStreamId, path) != TryStreamRecordingStatus::OK ||
+      rt.try_start_stream_recording(kStreamId, path) != TryStreamRecordingStatus::InvalidArgument) {
+    return fail_with_cleanup("FAIL core stream recording start/stop validation mismatch");
+  }
+  if (rt.try_start_stream(kStreamId) != TryStartStreamStatus::OK) {
+    return fail_with_cleanup("FAIL core stream recording stream start failed");
+  }
+
+  // More than one chunk of frames, so the index chains.
+  const uint64_t kWantFrames = CoreStreamRecorder::kFramesPerChunk + 6;
+  SharedStreamResultData sample;
+  CoreStreamRecorder::Stats live{};
+  for (int i = 0; i < 2000; ++i) {
+    provider.advance(33'333'333);
+    if (!sample) {
+      sample = rt.get_latest_stream_result(kStreamId);
+    }
+    if (rt.stream_recording_stats(kStreamId, live) && live.frames_written >= kWantFrames) {
+      break;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  if (!sample || live.frames_written < kWantFrames) {
+    return fail_with_cleanup("FAIL core stream recording did not write enough frames");
+  }
+
+  CoreStreamRecorder::Stats final_stats{};
+  if (rt.try_stop_stream_recording(kStreamId, &final_stats) != TryStreamRecordingStatus::OK ||
+      !final_stats.finished || final_stats.io_error || rt.stream_recording_stats(kStreamId, live)) {
+    return fail_with_cleanup("FAIL core stream recording stop did not complete the file");
+  }
+
+  StreamRecordingIndex index{};
+  if (!read_stream_recording_index(path, index) || !index.complete ||
+      index.stream_id != kStreamId || index.device_instance_id != kDeviceId ||
+      index.frames.size() != final_stats.frames_written ||
+      index.frames_dropped != final_stats.frames_dropped_queue_full + final_stats.frames_dropped_io_error) {
+    return fail_with_cleanup("FAIL core stream recording index mismatch");
+  }
+  const StreamRecordingIndexEntry* sample_entry = nullptr;
+  for (size_t i = 0; i < index.frames.size(); ++i) {
+    const StreamRecordingIndexEntry& e = index.frames[i];
+    if (e.frame_index != i || e.width != 64 || e.height != 64 || e.format_fourcc != FOURCC_RGBA ||
+        e.payload_bytes != 64u * 64u * 4u || e.payload_offset % CoreStreamRecorder::kAlignment != 0 ||
+        !e.has_acquisition_time ||
+        (i > 0 && e.acquisition_time_ns < index.frames[i - 1].acquisition_time_ns)) {
+      return fail_with_cleanup("FAIL core stream recording frame record mismatch");
+    }
+    if (e.retained_frame_id == sample->retained_frame_id) {
+      sample_entry = &e;
+    }
+  }
+  if (!sample_entry) {
+    return fail_with_cleanup("FAIL core stream recording sampled frame not recorded");
+  }
+  {
+    std::ifstream in(path, std::ios::binary);
+    std::vector<uint8_t> bytes(sample_entry->payload_bytes);
+    in.seekg(static_cast<std::streamoff>(sample_entry->payload_offset));
+    if (!in.read(reinterpret_cast<char*>(bytes.data()), static_cast<std::streamsize>(bytes.size())) ||
+        bytes.size() != sample->payload.size_bytes() ||
+        std::memcmp(bytes.data(), sample->payload.data(), bytes.size()) != 0) {
+      return fail_with_cleanup("FAIL core stream recording payload bytes differ from the retained result");
+    }
+  }
+
+  // Without its trailer the file is read by scanning the frame records.
+  {
+    const std::filesystem::path cut = dir / "cut.cbrec";
+    std::filesystem::copy_file(path, cut, ec);
+    std::filesystem::resize_file(cut, std::filesystem::file_size(path) - CoreStreamRecorder::kTrailerBytes, ec);
+    StreamRecordingIndex scanned{};
+    if (ec || !read_stream_recording_index(cut, scanned) || scanned.complete ||
+        scanned.frames.size() != index.frames.size() ||
+        scanned.frames.back().retained_frame_id != index.frames.back().retained_frame_id) {
+      return fail_with_cleanup("FAIL core stream recording scan of a cut file mismatch");
+    }
+  }
+
+  if (rt.try_stop_stream(kStreamId) != TryStopStreamStatus::OK ||
+      rt.try_destroy_stream(kStreamId) != TryDestroyStreamStatus::OK ||
+      rt.try_close_device(kDeviceId) != TryCloseDeviceStatus::OK) {
+    return fail_with_cleanup("FAIL core stream recording teardown failed");
+  }
+  (void)provider.shutdown();
+  rt.stop();
+  rt.attach_provider(nullptr);
+  remove_dir();
+  return true;
+}
+
+bool run_core_stream_export_check() {
+  CoreRuntime rt;
+  if (!rt.start()) {
+    std::cerr << "FAIL core stream export runtime start failed\n";
+    return false;
+  }
+  if (!wait_for_core_runtime_live(rt)) {
+    std::cerr << "FAIL core stream export runtime did not reach LIVE\n";
+    rt.stop();
+    return false;
+  }
+
+  SyntheticProviderConfig cfg{};
+  cfg.endpoint_count = 1;
+  cfg.nominal.width = 64;
+  cfg.nominal.height = 64;
+  cfg.nominal.format_fourcc = FOURCC_RGBA;
+  SyntheticProvider provider(cfg);
+  const auto fail_with_cleanup = [&](const char* msg) -> bool {
+    std::cerr << msg << "\n";
+    (void)provider.shutdown();
+    rt.stop();
+    rt.attach_provider(nullptr);
+    return false;
+  };
+  if (!provider.initialize(rt.provider_callbacks()).ok()) {
+    return fail_with_cleanup("FAIL core stream export provider init failed");
+  }
+  rt.attach_provider(&provider);
+  std::vector<CameraEndpoint> eps;
+  if (!provider.enumerate_endpoints(eps).ok() || eps.empty()) {
+    return fail_with_cleanup("FAIL core stream export enumerate failed");
+  }
+
+  constexpr uint64_t kDeviceId = 71;
+  constexpr uint64_t kStreamId = 7102;
+  constexpr size_t kFrameBytes = 64u * 64u * 4u;
+  const std::string name =
+      "cambang-export-verify-" + std::to_string(std::chrono::steady_clock::now().time_since_epoch().count());
+  if (rt.try_open_device(eps[0].hardware_id, kDeviceId, 7101) != TryOpenDeviceStatus::OK ||
+      rt.try_create_stream(kStreamId, kDeviceId, StreamIntent::PREVIEW, nullptr, nullptr, 0) !=
+          TryCreateStreamStatus::OK) {
+    return fail_with_cleanup("FAIL core stream export stream setup failed");
+  }
+  if (rt.try_start_stream_export(kStreamId + 1, name, kFrameBytes) != TryStreamExportStatus::InvalidArgument ||
+      rt.try_start_stream_export(kStreamId, name, 0) != TryStreamExportStatus::InvalidArgument ||
+      rt.try_stop_stream_export(kStreamId) != TryStreamExportStatus::InvalidArgument) {
+    return fail_with_cleanup("FAIL core stream export start/stop validation mismatch");
+  }
+  const TryStreamExportStatus started = rt.try_start_stream_export(kStreamId, name, kFrameBytes);
+#if !defined(_WIN32) && !defined(__linux__)
+  // No shared memory on this platform.
+  if (started != TryStreamExportStatus::Unavailable) {
+    return fail_with_cleanup("FAIL core stream export expected Unavailable");
+  }
+  (void)provider.shutdown();
+  rt.stop();
+  rt.attach_provider(nullptr);
+  return true;
+#else
+  if (started != TryStreamExportStatus::OK ||
+      rt.try_start_stream_export(kStreamId, name, kFrameBytes) != TryStreamExportStatus::InvalidArgument) {
+    return fail_with_cleanup("FAIL core stream export start mismatch");
+  }
+  CoreStreamExporter::Handles handles{};
+  if (!rt.stream_export_handles(kStreamId, handles) || handles.name != name ||
+      handles.region_bytes < CoreStreamExporter::kRingHeaderBytes +
+                                 CoreStreamExporter::kSlotCount * (CoreStreamExporter::kSlotHeaderBytes + kFrameBytes)) {
+    return fail_with_cleanup("FAIL core stream export handles mismatch");
+  }
+  if (rt.try_start_stream(kStreamId) != TryStartStreamStatus::OK) {
+    return fail_with_cleanup("FAIL core stream export stream start failed");
+  }
+
+  // Enough frames to wrap the ring, then stop advancing so the latest
+  // retained result and the latest slot settle on the same frame.
+  const uint64_t kWantFrames = CoreStreamExporter::kSlotCount * 3;
+  CoreStreamExporter::Stats live{};
+  for (int i = 0; i < 2000; ++i) {
+    provider.advance(33'333'333);
+    if (rt.stream_export_stats(kStreamId, live) && live.frames_exported >= kWantFrames) {
+      break;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  if (live.frames_exported < kWantFrames || live.bytes_exported != live.frames_exported * kFrameBytes) {
+    return fail_with_cleanup("FAIL core stream export did not export enough frames");
+  }
+  uint64_t settled = 0;
+  for (int unchanged = 0, i = 0; unchanged < 20 && i < 2000; ++i) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    (void)rt.stream_export_stats(kStreamId, live);
+    unchanged = live.frames_exported == settled ? unchanged + 1 : 0;
+    settled = live.frames_exported;
+  }
+  const SharedStreamResultData latest = rt.get_latest_stream_result(kStreamId);
+  if (!latest || latest->payload.size_bytes() != kFrameBytes) {
+    return fail_with_cleanup("FAIL core stream export latest result missing");
+  }
+
+#if defined(__linux__)
+  // Read the region the way another process does: reopen the memfd through
+  // /proc and map it read-only.
+  {
+    const int fd = ::open(("/proc/self/fd/" + std::to_string(handles.memory_fd)).c_str(), O_RDONLY | O_CLOEXEC);
+    void* view = fd >= 0 ? mmap(nullptr, handles.region_bytes, PROT_READ, MAP_SHARED, fd, 0) : MAP_FAILED;
+    if (fd >= 0) {
+      ::close(fd);
+    }
+    if (view == MAP_FAILED) {
+      return fail_with_cleanup("FAIL core stream export consumer mapping failed");
+    }
+    const uint8_t* base = static_cast<const uint8_t*>(view);
+    const auto u32 = [](const uint8_t* p) { uint32_t v; std::memcpy(&v, p, sizeof(v)); return v; };
+    const auto u64 = [](const uint8_t* p) { uint64_t v; std::memcpy(&v, p, sizeof(v)); return v; };
+    const auto seq = [](const uint8_t* p) {
+      return reinterpret_cast<const std::atomic<uint64_t>*>(p)->load(std::memory_order_acquire);
+    };
+    const uint64_t published = seq(base + 56);
+    const uint64_t stride = u64(base + 40);
+    const uint8_t* slot = base + CoreStreamExporter::kRingHeaderBytes +
+                          stride * ((published - 1) % CoreStreamExporter::kSlotCount);
+    uint64_t wake = 0;
+    const bool ok = std::memcmp(base, "CBSHMFR", 8) == 0 && u32(base + 8) == CoreStreamExporter::kFormatVersion &&
+                    u64(base + 16) == kStreamId && u64(base + 24) == kDeviceId &&
+                    u32(base + 32) == CoreStreamExporter::kSlotCount && u64(base + 48) >= kFrameBytes &&
+                    published == settled && seq(slot) == 2 * published &&
+                    u64(slot + 8) == latest->retained_frame_id && u64(slot + 16) == kFrameBytes &&
+                    u32(slot + 24) == 64 && u32(slot + 28) == 64 && u32(slot + 32) == FOURCC_RGBA &&
+                    (u32(slot + 44) & 1u) != 0 &&
+                    std::memcmp(slot + CoreStreamExporter::kSlotHeaderBytes, latest->payload.data(), kFrameBytes) == 0 &&
+                    ::read(handles.event_fd, &wake, sizeof(wake)) == static_cast<ssize_t>(sizeof(wake)) && wake > 0;
+    munmap(view, handles.region_bytes);
+    if (!ok) {
+      return fail_with_cleanup("FAIL core stream export region contents mismatch");
+    }
+  }
+#endif
+
+  CoreStreamExporter::Stats final_stats{};
+  if (rt.try_stop_stream_export(kStreamId, &final_stats) != TryStreamExportStatus::OK ||
+      final_stats.frames_exported != settled || rt.stream_export_stats(kStreamId, live)) {
+    return fail_with_cleanup("FAIL core stream export stop mismatch");
+  }
+
+  // Slots too small for the frame: nothing exported, every frame counted.
+  if (rt.try_start_stream_export(kStreamId, name + "-small", 64) != TryStreamExportStatus::OK) {
+    return fail_with_cleanup("FAIL core stream export small restart failed");
+  }
+  for (int i = 0; i < 2000; ++i) {
+    provider.advance(33'333'333);
+    if (rt.stream_export_stats(kStreamId, live) && live.frames_skipped_too_large >= 2) {
+      break;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  if (live.frames_skipped_too_large < 2 || live.frames_exported != 0) {
+    return fail_with_cleanup("FAIL core stream export oversized frames not skipped");
+  }
+
+  // Runtime stop closes the export still attached.
+  if (rt.try_stop_stream(kStreamId) != TryStopStreamStatus::OK ||
+      rt.try_destroy_stream(kStreamId) != TryDestroyStreamStatus::OK ||
+      rt.try_close_device(kDeviceId) != TryCloseDeviceStatus::OK) {
+    return fail_with_cleanup("FAIL core stream export teardown failed");
+  }
+  (void)provider.shutdown();
+  rt.stop();
+  rt.attach_provider(nullptr);
+  if (rt.stream_export_stats(kStreamId, live)) {
+    std::cerr << "FAIL core stream export survived runtime stop\n";
+    return false;
+  }
+  return true;
+#endif
+}
+
+// Records frame_count frames of a 64x64 RGBA synthetic stream to path.
+bool record_synthetic_stream_for_replay(const std::filesystem::path& path, uint64_t frame_count) {
+  CoreRuntime rt;
+  if (!rt.start() || !wait_for_core_runtime_live(rt)) {
+    rt.stop();
+    return false;
+  }
+  SyntheticProviderConfig cfg{};
+  cfg.endpoint_count = 1;
+  cfg.nominal.width = 64;
+  cfg.nominal.height = 64;
+  cfg.nominal.format_fourcc = FOURCC_RGBA;
+  SyntheticProvider provider(cfg);
+  std::vector<CameraEndpoint> eps;
+  bool ok = provider.initialize(rt.provider_callbacks()).ok();
+  rt.attach_provider(&provider);
+  ok = ok && provider.enumerate_endpoints(eps).ok() && !eps.empty() &&
+       rt.try_open_device(eps[0].hardware_id, 70, 7001) == TryOpenDeviceStatus::OK &&
+       rt.try_create_stream(7002, 70, StreamIntent::PREVIEW, nullptr, nullptr, 0) == TryCreateStreamStatus::OK &&
+       rt.try_start_stream_recording(7002, path) == TryStreamRecordingStatus::OK &&
+       rt.try_start_stream(7002) == TryStartStreamStatus::OK;
+  CoreStreamRecorder::Stats stats{};
+  for (int i = 0; ok && i < 2000; ++i) {
+    provider.advance(33'333'333);
+    if (rt.stream_recording_stats(7002, stats) && stats.frames_written >= frame_count) {
+      break;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  ok = ok && rt.try_stop_stream_recording(7002, &stats) == TryStreamRecordingStatus::OK &&
+       stats.finished && !stats.io_error && stats.frames_written >= frame_count;
+  (void)rt.try_stop_stream(7002);
+  (void)rt.try_destroy_stream(7002);
+  (void)rt.try_close_device(70);
+  (void)provider.shutdown();
+  rt.stop();
+  rt.attach_provider(nullptr);
+  return ok;
+}
+
+bool run_replay_provider_check() {
+  std::error_code ec;
+  const std::filesystem::path dir =
+      std::filesystem::temp_directory_path(ec) /
+      ("cambang-replay-verify-" +
+       std::to_string(std::chrono::steady_clock::now().time_since_epoch().count()));
+  std::filesystem::create_directories(dir, ec);
+  const std::filesystem::path path = dir / "stream.cbrec";
+  const auto fail = [&](const char* msg) -> bool {
+    std::cerr << msg << "\n";
+    std::filesystem::remove_all(dir, ec);
+    return false;
+  };
+
+  constexpr uint64_t kRecordedFrames = 12;
+  StreamRecordingIndex index{};
+  if (!record_synthetic_stream_for_replay(path, kRecordedFrames) ||
+      !read_stream_recording_index(path, index) || index.frames.size() < kRecordedFrames) {
+    return fail("FAIL replay provider could not record its input");
+  }
+  const size_t n = index.frames.size();
+  const uint64_t period_ns = static_cast<uint64_t>(
+      (index.frames.back().acquisition_time_ns - index.frames.front().acquisition_time_ns) /
+      static_cast<int64_t>(n - 1));
+  std::vector<uint64_t> recorded_hashes;
+  {
+    std::ifstream in(path, std::ios::binary);
+    for (const StreamRecordingIndexEntry& e : index.frames) {
+      std::vector<uint8_t> bytes(e.payload_bytes);
+      in.seekg(static_cast<std::streamoff>(e.payload_offset));
+      in.read(reinterpret_cast<char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+      recorded_hashes.push_back(fnv1a64_hash_bytes(bytes.data(), bytes.size()));
+    }
+  }
+  if (period_ns == 0) {
+    return fail("FAIL replay provider recording has no frame interval");
+  }
+
+  {
+    RecorderCallbacks cb;
+    ReplayProvider missing(ReplayProviderConfig{(dir / "missing.cbrec").string()});
+    if (missing.initialize(&cb).ok()) {
+      return fail("FAIL replay provider initialized without a recording");
+    }
+  }
+
+  const auto replayed_hashes = [](const RecorderCallbacks& cb) {
+    std::vector<uint64_t> out;
+    for (const EventRec& ev : cb.snapshot_events()) {
+      if (ev.tag == "frame") {
+        out.push_back(ev.payload_hash);
+      }
+    }
+    return out;
+  };
+
+  // Original timing: frames follow the recorded intervals on the provider clock.
+  {
+    RecorderCallbacks cb;
+    ReplayProviderConfig cfg{};
+    cfg.recording_path = path.string();
+    cfg.pacing = ReplayPacing::OriginalTiming;
+    cfg.loop = false;
+    ReplayProvider provider(cfg);
+    StreamRequest req{};
+    req.stream_id = 7012;
+    req.device_instance_id = 7011;
+    if (!provider.initialize(&cb).ok() || provider.recorded_frame_count() != n) {
+      return fail("FAIL replay provider initialize/index mismatch");
+    }
+    const StreamTemplate tpl = provider.stream_template();
+    req.profile = tpl.profile;
+    CaptureProfile wrong = tpl.profile;
+    wrong.width += 2;
+    if (tpl.profile.width != 64 || tpl.profile.height != 64 || tpl.profile.format_fourcc != FOURCC_RGBA ||
+        !provider.open_device(ReplayProvider::kReplayHardwareId, req.device_instance_id, 7010).ok() ||
+        !provider.create_stream(req).ok() ||
+        provider.start_stream(req.stream_id, wrong, req.picture).code != ProviderError::ERR_NOT_SUPPORTED ||
+        !provider.start_stream(req.stream_id, req.profile, req.picture).ok()) {
+      (void)provider.shutdown();
+      return fail("FAIL replay provider stream setup mismatch");
+    }
+    const uint64_t second_offset_ns =
+        static_cast<uint64_t>(index.frames[1].acquisition_time_ns - index.frames[0].acquisition_time_ns);
+    provider.advance(second_offset_ns - 1);
+    provider.flush_callbacks_for_smoke();
+    const size_t before_second = replayed_hashes(cb).size();
+    provider.advance(1);
+    provider.flush_callbacks_for_smoke();
+    const size_t at_second = replayed_hashes(cb).size();
+    // A stall emits a bounded catch-up, then playback re-anchors.
+    provider.advance(static_cast<uint64_t>(index.frames.back().acquisition_time_ns -
+                                           index.frames.front().acquisition_time_ns));
+    provider.flush_callbacks_for_smoke();
+    const size_t after_stall = replayed_hashes(cb).size();
+    for (size_t i = 0; i < 4 * n; ++i) {
+      provider.advance(period_ns);
+      provider.flush_callbacks_for_smoke();
+    }
+    const std::vector<uint64_t> hashes = replayed_hashes(cb);
+    const bool frames_match = hashes.size() == n && hashes == recorded_hashes;
+    const bool released = provider.frames_released() == provider.frames_emitted();
+    (void)provider.stop_stream(req.stream_id);
+    (void)provider.destroy_stream(req.stream_id);
+    (void)provider.close_device(req.device_instance_id);
+    (void)provider.shutdown();
+    if (before_second != 1 || at_second != 2 || after_stall != 6) {
+      return fail("FAIL replay provider original-timing pacing mismatch");
+    }
+    if (!frames_match || !released) {
+      return fail("FAIL replay provider replayed frames differ from the recording");
+    }
+  }
+
+  // As fast as possible, looping, bounded by the frames Core holds.
+  {
+    RecorderCallbacks cb;
+    ReplayProviderConfig cfg{};
+    cfg.recording_path = path.string();
+    cfg.pacing = ReplayPacing::AsFastAsPossible;
+    cfg.max_frames_in_flight = 3;
+    ReplayProvider provider(cfg);
+    StreamRequest req{};
+    req.stream_id = 7022;
+    req.device_instance_id = 7021;
+    if (!provider.initialize(&cb).ok()) {
+      return fail("FAIL replay provider fast initialize failed");
+    }
+    req.profile = provider.stream_template().profile;
+    if (!provider.open_device(ReplayProvider::kReplayHardwareId, req.device_instance_id, 7020).ok() ||
+        !provider.create_stream(req).ok() ||
+        !provider.start_stream(req.stream_id, req.profile, req.picture).ok()) {
+      (void)provider.shutdown();
+      return fail("FAIL replay provider fast stream setup failed");
+    }
+    bool bounded = true;
+    for (int i = 0; i < 1000 && provider.frames_emitted() < 2 * n + 1; ++i) {
+      provider.advance(0);
+      bounded = bounded && provider.frames_emitted() - provider.frames_released() <= 3;
+      provider.flush_callbacks_for_smoke();
+    }
+    const std::vector<uint64_t> hashes = replayed_hashes(cb);
+    (void)provider.stop_stream(req.stream_id);
+    (void)provider.destroy_stream(req.stream_id);
+    (void)provider.close_device(req.device_instance_id);
+    (void)provider.shutdown();
+    if (!bounded || hashes.size() < 2 * n + 1) {
+      return fail("FAIL replay provider fast playback was not bounded or stalled");
+    }
+    for (size_t i = 0; i < hashes.size(); ++i) {
+      if (hashes[i] != recorded_hashes[i % n]) {
+        return fail("FAIL replay provider fast playback did not loop the recording in order");
+      }
+    }
+  }
+
+  // Selected by the broker in synthetic mode, feeding Core. The request is
+  // built the way CamBANGServer builds it from its replay maintainer settings.
+  {
+    ReplayProviderConfig rejected{};
+    if (parse_replay_provider_selection(path.string(), "realtime", rejected)) {
+      return fail("FAIL replay selection accepted an unknown pacing");
+    }
+  }
+  {
+    CoreRuntime rt;
+    ProviderBroker broker;
+    ReplayProviderConfig cfg{};
+    if (!parse_replay_provider_selection(
+            path.string(),
+            replay_pacing_setting_value(ReplayPacing::AsFastAsPossible),
+            cfg) ||
+        cfg.pacing != ReplayPacing::AsFastAsPossible) {
+      return fail("FAIL replay selection did not parse its maintainer settings");
+    }
+    const auto fail_runtime = [&](const char* msg) {
+      (void)broker.shutdown();
+      rt.stop();
+      rt.attach_provider(nullptr);
+      return fail(msg);
+    };
+    if (!rt.start() || !wait_for_core_runtime_live(rt) ||
+        !broker.set_runtime_mode_requested(RuntimeMode::synthetic).ok() ||
+        !broker.set_replay_requested(cfg).ok() ||
+        !broker.initialize(rt.provider_callbacks()).ok()) {
+      return fail_runtime("FAIL replay provider broker initialize failed");
+    }
+    rt.attach_provider(&broker);
+    if (broker.set_replay_requested(cfg).code != ProviderError::ERR_BUSY ||
+        std::string(broker.provider_name()) != "ReplayProvider") {
+      return fail_runtime("FAIL replay provider broker did not select the replay backend");
+    }
+    constexpr uint64_t kStreamId = 7032;
+    if (rt.try_open_device(ReplayProvider::kReplayHardwareId, 7031, 7030) != TryOpenDeviceStatus::OK ||
+        rt.try_create_stream(kStreamId, 7031, StreamIntent::PREVIEW, nullptr, nullptr, 0) != TryCreateStreamStatus::OK ||
+        rt.try_start_stream(kStreamId) != TryStartStreamStatus::OK) {
+      return fail_runtime("FAIL replay provider runtime stream setup failed");
+    }
+    bool matched = false;
+    for (int i = 0; i < 2000 && !matched; ++i) {
+      (void)broker.try_tick_virtual_time(period_ns);
+      const SharedStreamResultData latest = rt.get_latest_stream_result(kStreamId);
+      if (latest && !latest->payload.empty()) {
+        const uint64_t h = fnv1a64_hash_bytes(latest->payload.data(), latest->payload.size_bytes());
+        matched = latest->payload.width == 64 &&
+                  std::find(recorded_hashes.begin(), recorded_hashes.end(), h) != recorded_hashes.end();
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    if (!matched) {
+      return fail_runtime("FAIL replay provider runtime result does not carry recorded bytes");
+    }
+    if (rt.try_stop_stream(kStreamId) != TryStopStreamStatus::OK ||
+        rt.try_destroy_stream(kStreamId) != TryDestroyStreamStatus::OK ||
+        rt.try_close_device(7031) != TryCloseDeviceStatus::OK) {
+      return fail_runtime("FAIL replay provider runtime teardown failed");
+    }
+    (void)broker.shutdown();
+    rt.stop();
+    rt.attach_provider(nullptr);
+  }
+
+  std::filesystem::remove_all(dir, ec);
+  return true;
+}
+
+// Records strand deliveries as (tag, id, seq); frames carry their seq in
+// width. Delivery of device_opened(kGateId) blocks until the gate opens.
+struct StrandLaneProbe final : IProviderCallbacks {
+  static constexpr uint64_t kGateId = 999;
+
+  struct Delivered {
+    std::string tag;
+    uint64_t id = 0;
+    uint64_t seq = 0;
+  };
+
+  std::mutex mu;
+  std::condition_variable cv;
+  std::vector<Delivered> delivered;
+  bool gate_open = true;
+  bool gate_reached = false;
+  std::atomic<uint64_t> releases{0};
+  uint64_t low_priority_stream_id = 0;
+  uint64_t high_priority_stream_id = 0;
+
+  static void release_frame(void* user, const FrameView*) {
+    static_cast<StrandLaneProbe*>(user)->releases.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  FrameView frame(uint64_t stream_id, uint64_t seq, uint64_t capture_id = 0) {
+    FrameView f{};
+    f.stream_id = stream_id;
+    f.capture_id = capture_id;
+    f.width = static_cast<uint32_t>(seq);
+    f.release = &StrandLaneProbe::release_frame;
+    f.release_user = this;
+    return f;
+  }
+
+  void record(const char* tag, uint64_t id, uint64_t seq = 0) {
+    std::lock_guard<std::mutex> lk(mu);
+    delivered.push_back({tag, id, seq});
+  }
+
+  uint64_t allocate_native_id(NativeObjectType) override { return 1; }
+  uint64_t core_monotonic_now_ns() override { return 0; }
+  bool is_stream_display_demand_active(uint64_t) override { return false; }
+  StreamPriority stream_priority(uint64_t stream_id) override {
+    if (stream_id == low_priority_stream_id) {
+      return StreamPriority::LOW;
+    }
+    return stream_id == high_priority_stream_id ? StreamPriority::HIGH : StreamPriority::NORMAL;
+  }
+
+  void on_device_opened(uint64_t id) override {
+    record("device_opened", id);
+    if (id == kGateId) {
+      std::unique_lock<std::mutex> lk(mu);
+      gate_reached = true;
+      cv.notify_all();
+      cv.wait(lk, [&]() { return gate_open; });
+    }
+  }
+  void on_device_closed(uint64_t id) override { record("device_closed", id); }
+  void on_stream_created(uint64_t id) override { record("stream_created", id); }
+  void on_stream_destroyed(uint64_t id) override { record("stream_destroyed", id); }
+  void on_stream_started(uint64_t id) override { record("stream_started", id); }
+  void on_stream_stopped(uint64_t id, ProviderError) override { record("stream_stopped", id); }
+  void on_capture_started(uint64_t id, uint64_t) override { record("capture_started", id); }
+  void on_capture_completed(uint64_t id, uint64_t) override { record("capture_completed", id); }
+  void on_capture_failed(uint64_t id, uint64_t, ProviderError) override { record("capture_failed", id); }
+  void on_camera_static_facts(uint64_t device_instance_id, ProviderCameraFacts) override {
+    record("camera_static_facts", device_instance_id);
+  }
+  void on_frame(const FrameView& f) override {
+    record("frame", f.stream_id, f.width);
+    f.release_now();
+  }
+  void on_device_error(uint64_t id, ProviderError) override { record("device_error", id); }
+  void on_stream_error(uint64_t id, ProviderError) override { record("stream_error", id); }
+  void on_native_object_created(const NativeObjectCreateInfo& info) override { record("native_created", info.native_id); }
+  void on_native_object_destroyed(const NativeObjectDestroyInfo& info) override { record("native_destroyed", info.native_id); }
+};
+
+// CBProviderStrand keeps repeating frames in a lock-free ring and other
+// events in a boxed control lane; delivery must still follow post order.
+bool run_provider_strand_lanes_check() {
+  // One producer on an unbounded strand (more frames than ring slots):
+  // interleaved lanes come out in post order.
+  {
+    StrandLaneProbe probe;
+    CBProviderStrand strand;
+    if (!strand.start(&probe, "strand_lanes", 0)) {
+      std::cerr << "FAIL: strand lanes: start failed\n";
+      return false;
+    }
+    std::vector<StrandLaneProbe::Delivered> expected;
+    for (uint64_t i = 0; i < 600; ++i) {
+      switch (i % 6) {
+        case 0: strand.post_device_opened(i); expected.push_back({"device_opened", i, 0}); break;
+        case 3: strand.post_camera_static_facts(i, ProviderCameraFacts{}); expected.push_back({"camera_static_facts", i, 0}); break;
+        case 4: strand.post_frame(probe.frame(0, i, 100 + i)); expected.push_back({"frame", 0, i}); break;
+        default: strand.post_frame(probe.frame(7, i)); expected.push_back({"frame", 7, i}); break;
+      }
+    }
+    strand.flush();
+    strand.stop();
+    bool same = probe.delivered.size() == expected.size();
+    for (size_t i = 0; same && i < expected.size(); ++i) {
+      same = probe.delivered[i].tag == expected[i].tag && probe.delivered[i].id == expected[i].id &&
+             probe.delivered[i].seq == expected[i].seq;
+    }
+    if (!same || probe.releases.load() != 400) {
+      std::cerr << "FAIL: strand lanes: single-producer order lost across lanes"
+                << " delivered=" << probe.delivered.size() << " releases=" << probe.releases.load() << "\n";
+      return false;
+    }
+  }
+
+  // Backpressure: with the worker held, repeating frames past the ring are
+  // dropped (released) at post; non-lossy events are all kept, queued after
+  // the frames posted before them, and counted once past capacity.
+  {
+    constexpr size_t kCapacity = 8;
+    StrandLaneProbe probe;
+    CBProviderStrand strand;
+    if (!strand.start(&probe, "strand_lanes", kCapacity)) {
+      std::cerr << "FAIL: strand lanes: start failed\n";
+      return false;
+    }
+    {
+      std::lock_guard<std::mutex> lk(probe.mu);
+      probe.gate_open = false;
+    }
+    strand.post_device_opened(StrandLaneProbe::kGateId);
+    {
+      std::unique_lock<std::mutex> lk(probe.mu);
+      probe.cv.wait(lk, [&]() { return probe.gate_reached; });
+    }
+    for (uint64_t i = 0; i < kCapacity + 5; ++i) {
+      strand.post_frame(probe.frame(7, i));
+    }
+    const uint64_t dropped_at_post = probe.releases.load();
+    strand.post_stream_error(7, ProviderError::ERR_PROVIDER_FAILED);
+    for (uint64_t i = 0; i < kCapacity; ++i) {
+      strand.post_device_closed(i);
+    }
+    const uint64_t over_capacity = strand.non_lossy_over_capacity_count();
+    {
+      std::lock_guard<std::mutex> lk(probe.mu);
+      probe.gate_open = true;
+      probe.cv.notify_all();
+    }
+    strand.flush();
+    strand.stop();
+    bool ok = dropped_at_post == 5 && over_capacity == 1 && probe.releases.load() == kCapacity + 5 &&
+              probe.delivered.size() == 1 + kCapacity + 1 + kCapacity;
+    for (size_t i = 0; ok && i < kCapacity; ++i) {
+      ok = probe.delivered[1 + i].tag == "frame" && probe.delivered[1 + i].seq == i;
+    }
+    ok = ok && probe.delivered[1 + kCapacity].tag == "stream_error";
+    if (!ok) {
+      std::cerr << "FAIL: strand lanes: backpressure dropped_at_post=" << dropped_at_post
+                << " over_capacity=" << over_capacity << " delivered=" << probe.delivered.size() << "\n";
+      return false;
+    }
+  }
+
+  // Stream priority: with the worker held, LOW frames stop at half the ring,
+  // HIGH frames past a full ring wait in the control lane, and a NORMAL frame
+  // meeting the full ring is dropped.
+  {
+    constexpr size_t kCapacity = 8;
+    StrandLaneProbe probe;
+    probe.low_priority_stream_id = 5;
+    probe.high_priority_stream_id = 6;
+    CBProviderStrand strand;
+    if (!strand.start(&probe, "strand_lanes", kCapacity)) {
+      std::cerr << "FAIL: strand lanes: start failed\n";
+      return false;
+    }
+    {
+      std::lock_guard<std::mutex> lk(probe.mu);
+      probe.gate_open = false;
+    }
+    strand.post_device_opened(StrandLaneProbe::kGateId);
+    {
+      std::unique_lock<std::mutex> lk(probe.mu);
+      probe.cv.wait(lk, [&]() { return probe.gate_reached; });
+    }
+    for (uint64_t i = 0; i < 6; ++i) {
+      strand.post_frame(probe.frame(5, i));
+    }
+    for (uint64_t i = 0; i < 6; ++i) {
+      strand.post_frame(probe.frame(6, i));
+    }
+    strand.post_frame(probe.frame(7, 0));
+    const uint64_t dropped_at_post = probe.releases.load();
+    {
+      std::lock_guard<std::mutex> lk(probe.mu);
+      probe.gate_open = true;
+      probe.cv.notify_all();
+    }
+    strand.flush();
+    strand.stop();
+    uint64_t high_next = 0;
+    uint64_t low_delivered = 0;
+    bool ok = dropped_at_post == 3 && strand.frames_dropped(StreamPriority::LOW) == 2 &&
+              strand.frames_dropped(StreamPriority::NORMAL) == 1 &&
+              strand.frames_dropped(StreamPriority::HIGH) == 0 && probe.delivered.size() == 1 + 4 + 6;
+    for (size_t i = 1; ok && i < probe.delivered.size(); ++i) {
+      const auto& d = probe.delivered[i];
+      if (d.id == 6) {
+        ok = d.seq == high_next++;
+      } else {
+        ok = d.id == 5 && d.seq == low_delivered++;
+      }
+    }
+    if (!ok || high_next != 6 || low_delivered != 4) {
+      std::cerr << "FAIL: strand lanes: priority dropped_at_post=" << dropped_at_post
+                << " low_dropped=" << strand.frames_dropped(StreamPriority::LOW)
+                << " normal_dropped=" << strand.frames_dropped(StreamPriority::NORMAL)
+                << " delivered=" << probe.delivered.size() << "\n";
+      return false;
+    }
   }
 
-  SharedCaptureResultData result;
-  for (int i = 0; i < 50; ++i) {
-    result = rt.get_capture_result(req.capture_id, device_id);
-    if (result) break;
-    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+  // Several producers on an unbounded strand: nothing is dropped and each
+  // producer's posts keep their order across both lanes.
+  {
+    constexpr uint64_t kProducers = 4;
+    constexpr uint64_t kPerProducer = 2000;
+    StrandLaneProbe probe;
+    CBProviderStrand strand;
+    if (!strand.start(&probe, "strand_lanes", 0)) {
+      std::cerr << "FAIL: strand lanes: start failed\n";
+      return false;
+    }
+    std::vector<std::thread> producers;
+    for (uint64_t p = 1; p <= kProducers; ++p) {
+      producers.emplace_back([&, p]() {
+        for (uint64_t i = 0; i < kPerProducer; ++i) {
+          if (i % 16 == 0) {
+            strand.post_stream_created(p * 1000000 + i);
+          } else {
+            strand.post_frame(probe.frame(p, i));
+          }
+        }
+      });
+    }
+    for (auto& t : producers) {
+      t.join();
+    }
+    strand.flush();
+    strand.stop();
+    std::vector<uint64_t> next(kProducers + 1, 0);
+    bool ok = probe.delivered.size() == kProducers * kPerProducer;
+    for (const auto& d : probe.delivered) {
+      if (!ok) {
+        break;
+      }
+      const uint64_t p = d.tag == "frame" ? d.id : d.id / 1000000;
+      const uint64_t i = d.tag == "frame" ? d.seq : d.id % 1000000;
+      ok = p >= 1 && p <= kProducers && i == next[p];
+      next[p] = i + 1;
+    }
+    if (!ok || probe.releases.load() != kProducers * (kPerProducer - kPerProducer / 16)) {
+      std::cerr << "FAIL: strand lanes: multi-producer order delivered=" << probe.delivered.size()
+                << " releases=" << probe.releases.load() << "\n";
+      return false;
+    }
   }
-  if (!result || result->image_member_count() != 3 || !result->has_additional_images()) {
-    return fail_with_cleanup("FAIL core synthetic realized-unknown retained result missing/shape mismatch");
+  return true;
+}
+
+// Inline strands deliver on the posting thread: nothing waits for flush(),
+// concurrent posters stay serialized, and posts after stop() are refused.
+bool run_provider_strand_inline_check() {
+  StrandLaneProbe probe;
+  CBProviderStrand strand;
+  if (!strand.start_inline(&probe, "strand_inline") || !strand.inline_delivery() ||
+      strand.start_inline(&probe, "strand_inline")) {
+    std::cerr << "FAIL: strand inline: start_inline\n";
+    return false;
+  }
+  strand.post_device_opened(1);
+  strand.post_frame(probe.frame(7, 1));
+  strand.post_frame(probe.frame(0, 2, 55));
+  const bool synchronous = probe.delivered.size() == 3 && probe.delivered[1].tag == "frame" &&
+                           probe.delivered[2].seq == 2 && probe.releases.load() == 2;
+  if (!synchronous) {
+    std::cerr << "FAIL: strand inline: posts not delivered before returning delivered="
+              << probe.delivered.size() << "\n";
+    return false;
+  }
+
+  constexpr uint64_t kProducers = 4;
+  constexpr uint64_t kPerProducer = 1000;
+  std::vector<std::thread> producers;
+  for (uint64_t p = 1; p <= kProducers; ++p) {
+    producers.emplace_back([&, p]() {
+      for (uint64_t i = 0; i < kPerProducer; ++i) {
+        if (i % 8 == 0) {
+          strand.post_stream_created(p * 1000000 + i);
+        } else {
+          strand.post_frame(probe.frame(p, i));
+        }
+      }
+    });
   }
-  const auto* m0 = result->image_member_at(0);
-  const auto* m1 = result->image_member_at(1);
-  const auto* m2 = result->image_member_at(2);
-  if (!m0 || !m1 || !m2) {
-    return fail_with_cleanup("FAIL core synthetic realized-unknown retained members missing");
+  for (auto& t : producers) {
+    t.join();
   }
-  if (!m0->has_realized_exposure_compensation_milli_ev ||
-      !m1->has_realized_exposure_compensation_milli_ev ||
-      m0->realized_exposure_compensation_milli_ev != m0->applied_exposure_compensation_milli_ev ||
-      m1->realized_exposure_compensation_milli_ev != m1->applied_exposure_compensation_milli_ev) {
-    return fail_with_cleanup("FAIL core synthetic realized-unknown expected realized-known for members 0/1");
+  strand.flush();
+  std::vector<uint64_t> next(kProducers + 1, 0);
+  bool ok = probe.delivered.size() == 3 + kProducers * kPerProducer;
+  for (size_t k = 3; ok && k < probe.delivered.size(); ++k) {
+    const auto& d = probe.delivered[k];
+    const uint64_t p = d.tag == "frame" ? d.id : d.id / 1000000;
+    const uint64_t i = d.tag == "frame" ? d.seq : d.id % 1000000;
+    ok = p >= 1 && p <= kProducers && i == next[p];
+    next[p] = i + 1;
   }
-  if (m2->has_realized_exposure_compensation_milli_ev) {
-    return fail_with_cleanup("FAIL core synthetic realized-unknown expected has_realized=false for member 2");
+  if (!ok) {
+    std::cerr << "FAIL: strand inline: concurrent posters delivered=" << probe.delivered.size() << "\n";
+    return false;
   }
 
-  rt.stop();
-  rt.attach_provider(nullptr);
+  strand.stop();
+  const size_t delivered_at_stop = probe.delivered.size();
+  const uint64_t releases_at_stop = probe.releases.load();
+  strand.post_stream_started(7);
+  strand.post_frame(probe.frame(7, 3));
+  strand.flush();
+  if (strand.running() || probe.delivered.size() != delivered_at_stop ||
+      probe.releases.load() != releases_at_stop + 1) {
+    std::cerr << "FAIL: strand inline: post after stop was delivered or leaked\n";
+    return false;
+  }
   return true;
 }
 
@@ -6543,6 +8508,183 @@ bool run_core_measured_backing_plan_evaluation_check() {
   return true;
 }
 
+bool run_core_persisted_retained_plan_prior_check() {
+  auto plan_equals = [](CoreRetainedProductionPlan plan,
+                        CoreProductionPostureShape posture) {
+    return plan.valid && plan.posture == posture;
+  };
+  auto find_stream_report = [](const CoreRuntime& rt,
+                               uint64_t stream_id,
+                               CoreBackingPlanEvaluationReport& out) {
+    for (const auto& report : rt.backing_plan_evaluation_reports()) {
+      if (report.target_kind ==
+              CoreBackingPlanEvaluationReport::TargetKind::Stream &&
+          report.target_id == stream_id) {
+        out = report;
+        return true;
+      }
+    }
+    return false;
+  };
+  auto wait_until = [](const std::function<bool()>& predicate) {
+    for (int i = 0; i < kMaxIters; ++i) {
+      if (predicate()) {
+        return true;
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds(kSleepMs));
+    }
+    return false;
+  };
+
+  std::error_code ec;
+  const std::filesystem::path dir =
+      std::filesystem::temp_directory_path(ec) /
+      ("cambang-plan-prior-verify-" +
+       std::to_string(std::chrono::steady_clock::now().time_since_epoch().count()));
+  const std::filesystem::path prior_path = dir / "priors.txt";
+  const auto remove_dir = [&]() { std::filesystem::remove_all(dir, ec); };
+
+  constexpr uint64_t kDeviceId = 91;
+  constexpr uint64_t kRootId = 9101;
+  constexpr uint64_t kStreamId = 9102;
+
+  // Generation 1: a full evaluation settles on CpuPrimary (not the default
+  // first candidate) and the stop writes it out.
+  {
+    CoreRuntime rt;
+    BackingPlanEvaluationTestProvider provider;
+    const auto fail_with_cleanup = [&](const char* msg) -> bool {
+      std::cerr << msg << "\n";
+      (void)provider.shutdown();
+      rt.stop();
+      rt.attach_provider(nullptr);
+      remove_dir();
+      return false;
+    };
+    if (!rt.set_retained_plan_prior_path(prior_path) || !rt.start() ||
+        !wait_for_core_runtime_live(rt)) {
+      return fail_with_cleanup("FAIL persisted plan prior first runtime start failed");
+    }
+    if (rt.set_retained_plan_prior_path(prior_path)) {
+      return fail_with_cleanup("FAIL persisted plan prior path accepted while running");
+    }
+    if (!provider.initialize(rt.provider_callbacks()).ok()) {
+      return fail_with_cleanup("FAIL persisted plan prior provider init failed");
+    }
+    rt.attach_provider(&provider);
+    if (rt.try_open_device("backing_plan_eval:0", kDeviceId, kRootId) !=
+            TryOpenDeviceStatus::OK ||
+        rt.try_create_stream(
+            kStreamId, kDeviceId, StreamIntent::PREVIEW, nullptr, nullptr, 0) !=
+            TryCreateStreamStatus::OK ||
+        rt.try_start_stream(kStreamId) != TryStartStreamStatus::OK) {
+      return fail_with_cleanup("FAIL persisted plan prior first stream setup failed");
+    }
+    const CoreProductionPostureShape sequence[3] = {
+        CoreProductionPostureShape::GpuPrimaryNoCpuSidecar,
+        CoreProductionPostureShape::GpuPrimaryWithCpuSidecar,
+        CoreProductionPostureShape::CpuPrimary,
+    };
+    const uint64_t display_view_elapsed_ns[3] = {80, 90, 20};
+    for (size_t i = 0; i < 3; ++i) {
+      if (!wait_until([&]() {
+            const auto* rec = rt.stream_record(kStreamId);
+            return rec && plan_equals(rec->requested_retained_plan, sequence[i]) &&
+                   plan_equals(provider.stream_requested_plan(kStreamId), sequence[i]);
+          }) ||
+          !provider.emit_stream_frame(kStreamId, true)) {
+        return fail_with_cleanup("FAIL persisted plan prior evaluation did not reach candidate");
+      }
+      SharedStreamResultData result;
+      if (!wait_until([&]() {
+            result = rt.get_latest_stream_result(kStreamId);
+            CoreProductionPostureShape observed{};
+            const bool cpu = result && result->payload_kind == ResultPayloadKind::CPU_PACKED;
+            observed = cpu ? CoreProductionPostureShape::CpuPrimary
+                           : (result && result->access_posture.has_retained_cpu_payload
+                                  ? CoreProductionPostureShape::GpuPrimaryWithCpuSidecar
+                                  : CoreProductionPostureShape::GpuPrimaryNoCpuSidecar);
+            return result && observed == sequence[i];
+          })) {
+        return fail_with_cleanup("FAIL persisted plan prior candidate result missing");
+      }
+      rt.report_stream_retained_display_view_observation(
+          kStreamId,
+          result->access_posture.posture_id,
+          result->retained_access_truth.display_view,
+          true,
+          display_view_elapsed_ns[i]);
+    }
+    if (!wait_until([&]() {
+          CoreBackingPlanEvaluationReport report{};
+          return find_stream_report(rt, kStreamId, report) &&
+                 plan_equals(report.steady, CoreProductionPostureShape::CpuPrimary) &&
+                 report.completion_reason ==
+                     BackingPlanEvaluationCompletionReason::AllViableCandidatesEvaluated;
+        })) {
+      return fail_with_cleanup("FAIL persisted plan prior first evaluation did not settle on cpu");
+    }
+    (void)provider.shutdown();
+    rt.stop();
+    rt.attach_provider(nullptr);
+    if (!std::filesystem::exists(prior_path, ec)) {
+      remove_dir();
+      std::cerr << "FAIL persisted plan prior file not written at stop\n";
+      return false;
+    }
+  }
+
+  // Generation 2: the same provider, hardware, profile and capabilities
+  // settle on the prior at create, with no evaluation.
+  {
+    CoreRuntime rt;
+    BackingPlanEvaluationTestProvider provider;
+    const auto fail_with_cleanup = [&](const char* msg) -> bool {
+      std::cerr << msg << "\n";
+      (void)provider.shutdown();
+      rt.stop();
+      rt.attach_provider(nullptr);
+      remove_dir();
+      return false;
+    };
+    if (!rt.set_retained_plan_prior_path(prior_path) || !rt.start() ||
+        !wait_for_core_runtime_live(rt)) {
+      return fail_with_cleanup("FAIL persisted plan prior second runtime start failed");
+    }
+    if (!provider.initialize(rt.provider_callbacks()).ok()) {
+      return fail_with_cleanup("FAIL persisted plan prior second provider init failed");
+    }
+    rt.attach_provider(&provider);
+    if (rt.try_open_device("backing_plan_eval:0", kDeviceId, kRootId) !=
+            TryOpenDeviceStatus::OK ||
+        rt.try_create_stream(
+            kStreamId, kDeviceId, StreamIntent::PREVIEW, nullptr, nullptr, 0) !=
+            TryCreateStreamStatus::OK) {
+      return fail_with_cleanup("FAIL persisted plan prior second stream setup failed");
+    }
+    const auto* rec = rt.stream_record(kStreamId);
+    if (!rec ||
+        !plan_equals(rec->requested_retained_plan, CoreProductionPostureShape::CpuPrimary) ||
+        !plan_equals(rec->steady_retained_plan, CoreProductionPostureShape::CpuPrimary) ||
+        !plan_equals(provider.stream_requested_plan(kStreamId),
+                     CoreProductionPostureShape::CpuPrimary)) {
+      return fail_with_cleanup("FAIL persisted plan prior not applied at stream create");
+    }
+    CoreBackingPlanEvaluationReport report{};
+    if (!find_stream_report(rt, kStreamId, report) || report.evaluator_active ||
+        report.decision_from_evaluation ||
+        report.completion_reason != BackingPlanEvaluationCompletionReason::PersistedPrior) {
+      return fail_with_cleanup("FAIL persisted plan prior report provenance mismatch");
+    }
+    (void)provider.shutdown();
+    rt.stop();
+    rt.attach_provider(nullptr);
+  }
+
+  remove_dir();
+  return true;
+}
+
 bool run_core_capture_observation_regression_check() {
   auto plan_equals = [](CoreRetainedProductionPlan plan,
                         CoreProductionPostureShape posture) {
@@ -8012,6 +10154,26 @@ bool run_broker_provider_call_lock_isolation_check() {
     (void)broker.shutdown();
     return false;
   }
+  if (broker.max_active_streams_per_device() != 3) {
+    std::cerr << "FAIL broker provider call did not forward the provider "
+                 "active stream limit\n";
+    (void)broker.shutdown();
+    return false;
+  }
+  if (!broker.supports_capture_alongside_streams(7) ||
+      broker.supports_capture_alongside_streams(8)) {
+    std::cerr << "FAIL broker provider call did not forward the provider "
+                 "per-device capture-alongside-streams answer\n";
+    (void)broker.shutdown();
+    return false;
+  }
+  if (broker.reconfigure_stream(1, CaptureProfile{}).code !=
+      ProviderError::ERR_PLATFORM_CONSTRAINT) {
+    std::cerr << "FAIL broker provider call did not forward stream "
+                 "reconfiguration\n";
+    (void)broker.shutdown();
+    return false;
+  }
 
   probe->probe_concurrent_query.store(true, std::memory_order_release);
   const ProviderResult create_result = broker.create_stream(StreamRequest{});
@@ -8183,6 +10345,225 @@ bool run_broker_failed_initialization_is_not_published_check() {
 #endif
 }
 
+bool run_core_broker_provider_hot_swap_check() {
+  if (!ProviderBroker::check_mode_supported_in_build(RuntimeMode::synthetic).ok()) {
+    std::cout << "SKIP core broker provider hot swap: synthetic mode not built\n";
+    return true;
+  }
+
+  CoreRuntime rt;
+  ProviderBroker broker;
+  const auto fail_with_cleanup = [&](const char* msg) -> bool {
+    std::cerr << msg << "\n";
+    rt.stop();
+    rt.attach_provider(nullptr);
+    (void)broker.shutdown();
+    return false;
+  };
+  if (!rt.start() || !wait_for_core_runtime_live(rt) ||
+      !broker.set_runtime_mode_requested(RuntimeMode::synthetic).ok() ||
+      !broker.set_synthetic_timing_driver_requested(TimingDriver::VirtualTime).ok() ||
+      !broker.initialize(rt.provider_callbacks()).ok()) {
+    return fail_with_cleanup("FAIL core broker provider hot swap setup failed");
+  }
+  rt.attach_provider(&broker);
+
+  const auto start_stream = [&](uint64_t device_id, uint64_t stream_id) -> bool {
+    std::vector<CameraEndpoint> eps;
+    if (!broker.enumerate_endpoints(eps).ok() || eps.empty() ||
+        rt.try_open_device(eps[0].hardware_id, device_id, device_id + 1) != TryOpenDeviceStatus::OK ||
+        rt.try_create_stream(stream_id, device_id, StreamIntent::PREVIEW, nullptr, nullptr, 0) !=
+            TryCreateStreamStatus::OK ||
+        rt.try_start_stream(stream_id) != TryStartStreamStatus::OK) {
+      return false;
+    }
+    for (int i = 0; i < 500; ++i) {
+      (void)broker.try_tick_virtual_time(33'333'333);
+      if (rt.get_latest_stream_result(stream_id)) {
+        return true;
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+    return false;
+  };
+
+  constexpr uint64_t kOldDeviceId = 9770;
+  constexpr uint64_t kOldStreamId = 9772;
+  if (!start_stream(kOldDeviceId, kOldStreamId)) {
+    return fail_with_cleanup("FAIL core broker provider hot swap first stream produced no result");
+  }
+
+  if (rt.try_swap_provider({}) != TrySwapProviderStatus::InvalidArgument) {
+    return fail_with_cleanup("FAIL core broker provider hot swap accepted an empty swap");
+  }
+  const auto reselect = [](ProviderBroker& b) {
+    return b.set_synthetic_timing_driver_requested(TimingDriver::RealTime);
+  };
+  if (rt.try_swap_provider([&] { return broker.swap_provider(reselect); }) !=
+      TrySwapProviderStatus::OK) {
+    return fail_with_cleanup("FAIL core broker provider hot swap was not accepted");
+  }
+  const CoreDeviceRegistry::DeviceRecord* old_device = rt.device_record(kOldDeviceId);
+  if (rt.stream_record(kOldStreamId) != nullptr || (old_device && old_device->open) ||
+      broker.synthetic_timing_driver_latched() != TimingDriver::RealTime ||
+      !wait_for_core_runtime_live(rt)) {
+    return fail_with_cleanup("FAIL core broker provider hot swap left old provider objects or lost LIVE");
+  }
+
+  constexpr uint64_t kNewDeviceId = 9780;
+  constexpr uint64_t kNewStreamId = 9782;
+  if (!start_stream(kNewDeviceId, kNewStreamId)) {
+    return fail_with_cleanup("FAIL core broker provider hot swap replacement stream produced no result");
+  }
+  if (rt.try_stop_stream(kNewStreamId) != TryStopStreamStatus::OK ||
+      rt.try_destroy_stream(kNewStreamId) != TryDestroyStreamStatus::OK ||
+      rt.try_close_device(kNewDeviceId) != TryCloseDeviceStatus::OK) {
+    return fail_with_cleanup("FAIL core broker provider hot swap replacement teardown failed");
+  }
+  rt.stop();
+  rt.attach_provider(nullptr);
+  (void)broker.shutdown();
+  return true;
+}
+
+bool run_core_rig_capture_from_stream_frame_set_check() {
+  constexpr uint64_t kRigId = 9790;
+  constexpr uint64_t kCaptureId = 97901;
+  constexpr uint64_t kDeviceA = 9791;
+  constexpr uint64_t kDeviceB = 9792;
+  constexpr uint64_t kStreamA = 97911;
+  constexpr uint64_t kStreamB = 97921;
+  const auto wait_until = [](const std::function<bool()>& predicate) {
+    for (int i = 0; i < kMaxIters; ++i) {
+      if (predicate()) {
+        return true;
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds(kSleepMs));
+    }
+    return false;
+  };
+
+  CoreRuntime rt;
+  StateSnapshotBuffer buf;
+  rt.set_snapshot_publisher(&buf);
+  if (rt.ingest_camera_concurrency_json_for_server(
+          "{\"schema_version\":1,\"cameras\":[{\"camera_id\":\"synthetic:0\"},{\"camera_id\":\"synthetic:1\"}],\"concurrent_camera_support\":{\"supported\":true,\"camera_id_combinations\":[[\"synthetic:0\",\"synthetic:1\"]]}}").status !=
+          CoreRuntime::IngestCameraConcurrencyStatus::Ok ||
+      !rt.start() || !wait_for_core_runtime_live(rt)) {
+    std::cerr << "FAIL core rig frame-set capture runtime setup failed\n";
+    return false;
+  }
+
+  SyntheticProviderConfig config{};
+  config.endpoint_count = 2;
+  config.nominal.width = 64;
+  config.nominal.height = 64;
+  config.nominal.format_fourcc = FOURCC_RGBA;
+  SyntheticProvider provider(config);
+  const auto fail_with_cleanup = [&](const char* message) {
+    std::cerr << message << "\n";
+    (void)provider.shutdown();
+    rt.stop();
+    rt.attach_provider(nullptr);
+    return false;
+  };
+  if (!provider.initialize(rt.provider_callbacks()).ok()) {
+    return fail_with_cleanup("FAIL core rig frame-set capture provider init failed");
+  }
+  rt.attach_provider(&provider);
+  if (rt.try_open_device("synthetic:0", kDeviceA, 97931) != TryOpenDeviceStatus::OK ||
+      rt.try_open_device("synthetic:1", kDeviceB, 97932) != TryOpenDeviceStatus::OK ||
+      !rt.retain_rig_member_hardware_ids(kRigId, {"synthetic:0", "synthetic:1"})) {
+    return fail_with_cleanup("FAIL core rig frame-set capture device/rig setup failed");
+  }
+
+  // No stream has delivered yet: nothing to capture from, and no cohort.
+  const auto early = rt.orchestrate_rig_capture_from_stream_frame_set_for_server(kRigId, kCaptureId);
+  if (early.ok || early.failure != CoreRuntime::RigOrchestrationFailure::SubmissionFailed ||
+      early.submission_failure != CoreRuntime::RigSubmissionFailure::FrameSetUnavailable) {
+    return fail_with_cleanup("FAIL core rig frame-set capture accepted a rig with no frame set");
+  }
+
+  if (rt.try_create_stream(kStreamA, kDeviceA, StreamIntent::PREVIEW, nullptr, nullptr, 0) !=
+          TryCreateStreamStatus::OK ||
+      rt.try_create_stream(kStreamB, kDeviceB, StreamIntent::PREVIEW, nullptr, nullptr, 0) !=
+          TryCreateStreamStatus::OK ||
+      rt.try_start_stream(kStreamA) != TryStartStreamStatus::OK ||
+      rt.try_start_stream(kStreamB) != TryStartStreamStatus::OK) {
+    return fail_with_cleanup("FAIL core rig frame-set capture stream setup failed");
+  }
+  SharedRigStreamFrameSet set;
+  for (int i = 0; i < 2000 && !set; ++i) {
+    provider.advance(33'333'333);
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    set = rt.get_latest_rig_stream_frame_set(kRigId);
+  }
+  if (!set || set->members.size() != 2) {
+    return fail_with_cleanup("FAIL core rig frame-set capture no frame set assembled");
+  }
+  // Virtual time stands still from here; once frames already in flight have
+  // landed, this stays the latest set.
+  int unchanged_polls = 0;
+  if (!wait_until([&] {
+        const SharedRigStreamFrameSet latest = rt.get_latest_rig_stream_frame_set(kRigId);
+        if (latest && latest->set_sequence != set->set_sequence) {
+          set = latest;
+          unchanged_polls = 0;
+        }
+        return ++unchanged_polls >= 20;
+      })) {
+    return fail_with_cleanup("FAIL core rig frame-set capture frame sets did not settle");
+  }
+
+  const auto captured = rt.orchestrate_rig_capture_from_stream_frame_set_for_server(kRigId, kCaptureId);
+  if (!captured.ok || captured.submitted_count != 2) {
+    return fail_with_cleanup("FAIL core rig frame-set capture was not admitted");
+  }
+  std::vector<SharedCaptureResultData> results;
+  if (!wait_until([&] {
+        results = rt.get_capture_result_set(kCaptureId);
+        return results.size() == 2;
+      })) {
+    return fail_with_cleanup("FAIL core rig frame-set capture produced no result set");
+  }
+  const uint64_t set_devices[2] = {kDeviceA, kDeviceB};
+  for (size_t i = 0; i < 2; ++i) {
+    const SharedCaptureResultData result = rt.get_capture_result(kCaptureId, set_devices[i]);
+    const auto& member_timing = set->members[i]->image_facts.acquisition_timing;
+    if (!result || !member_timing || !result->default_image.acquisition_timing ||
+        result->default_image.acquisition_timing->value.acquisition_mark() !=
+            member_timing->value.acquisition_mark()) {
+      return fail_with_cleanup("FAIL core rig frame-set capture result is not the set's frame");
+    }
+  }
+  // The rig's sync skew is the set's sensor-clock skew.
+  if (!wait_until([&] {
+        const auto snap = buf.snapshot_copy();
+        if (!snap) {
+          return false;
+        }
+        for (const RigState& rig : snap->rigs) {
+          if (rig.rig_id == kRigId) {
+            return rig.last_capture_id == kCaptureId && rig.last_sync_skew_ns == set->skew_ns;
+          }
+        }
+        return false;
+      })) {
+    return fail_with_cleanup("FAIL core rig frame-set capture sync skew is not the set skew");
+  }
+
+  (void)rt.try_stop_stream(kStreamA);
+  (void)rt.try_stop_stream(kStreamB);
+  (void)rt.try_destroy_stream(kStreamA);
+  (void)rt.try_destroy_stream(kStreamB);
+  (void)rt.try_close_device(kDeviceA);
+  (void)rt.try_close_device(kDeviceB);
+  (void)provider.shutdown();
+  rt.stop();
+  rt.attach_provider(nullptr);
+  return true;
+}
+
 bool run_core_synthetic_capture_plan_flip_with_live_stream_regression_check() {
   auto plan_equals = [](CoreRetainedProductionPlan plan,
                         CoreProductionPostureShape posture) {
@@ -9453,6 +11834,10 @@ int main(int argc, char** argv) {
       {"run_synthetic_scenario_materialization_check", [] { return run_synthetic_scenario_materialization_check(); }},
       {"run_synthetic_builtin_scenario_library_build_check", [] { return run_synthetic_builtin_scenario_library_build_check(); }},
       {"run_synthetic_external_scenario_loader_check", [] { return run_synthetic_external_scenario_loader_check(); }},
+      {"run_synthetic_skip_ahead_stepping_check", [] { return run_synthetic_skip_ahead_stepping_check(); }},
+      {"run_synthetic_headless_frame_content_check", [] { return run_synthetic_headless_frame_content_check(); }},
+      {"run_synthetic_looped_frame_content_check", [] { return run_synthetic_looped_frame_content_check(); }},
+      {"run_synthetic_display_demand_governor_check", [] { return run_synthetic_display_demand_governor_check(); }},
       {"run_synthetic_external_scenario_loader_negative_check", [] { return run_synthetic_external_scenario_loader_negative_check(); }},
       {"run_synthetic_primitive_lifecycle_foundation_check", [] { return run_synthetic_primitive_lifecycle_foundation_check(); }},
       {"run_clustered_strict_branch_check", [] { return run_clustered_strict_branch_check(); }},
@@ -9462,12 +11847,18 @@ int main(int argc, char** argv) {
       {"run_synthetic_parent_context_capability_downgrade_matrix_check", [] { return run_synthetic_parent_context_capability_downgrade_matrix_check(); }},
       {"run_synthetic_producer_output_form_mode_production_check", [] { return run_synthetic_producer_output_form_mode_production_check(); }},
       {"run_synthetic_live_gpu_backing_truth_check", [] { return run_synthetic_live_gpu_backing_truth_check(); }},
+      {"run_synthetic_gpu_generated_pattern_check", [] { return run_synthetic_gpu_generated_pattern_check(); }},
       {"run_synthetic_timeline_picture_appearance_check", [] { return run_synthetic_timeline_picture_appearance_check(); }},
+      {"run_synthetic_timeline_periodic_events_check", [] { return run_synthetic_timeline_periodic_events_check(); }},
       {"run_stub_provider_sanity_check", [] { return run_stub_provider_sanity_check(); }},
       {"run_synthetic_provider_direct_sanity_check", [] { return run_synthetic_provider_direct_sanity_check(); }},
+      {"run_synthetic_realtime_pacing_check", [] { return run_synthetic_realtime_pacing_check(); }},
       {"run_synthetic_capture_executor_correctness_check", [] { return run_synthetic_capture_executor_correctness_check(); }},
+      {"run_synthetic_capture_in_flight_depth_check", [] { return run_synthetic_capture_in_flight_depth_check(); }},
       {"run_synthetic_still_only_acquisition_session_truth_check", [] { return run_synthetic_still_only_acquisition_session_truth_check(); }},
       {"run_synthetic_multi_member_still_sequence_check", [] { return run_synthetic_multi_member_still_sequence_check(); }},
+      {"run_synthetic_concurrent_bracket_capture_ordering_check", [] { return run_synthetic_concurrent_bracket_capture_ordering_check(); }},
+      {"run_synthetic_rig_capture_start_barrier_check", [] { return run_synthetic_rig_capture_start_barrier_check(); }},
       {"run_synthetic_dynamic_still_bundle_shape_check", [] { return run_synthetic_dynamic_still_bundle_shape_check(); }},
       {"run_core_synthetic_three_member_capture_result_check", [] { return run_core_synthetic_three_member_capture_result_check(); }},
       {"run_core_synthetic_three_member_capture_result_realized_ev_mismatch_check", [] { return run_core_synthetic_three_member_capture_result_realized_ev_mismatch_check(); }},
@@ -9478,7 +11869,14 @@ int main(int argc, char** argv) {
       {"run_core_capture_result_fact_resolution_check", [] { return run_core_capture_result_fact_resolution_check(); }},
       {"run_core_synthetic_three_member_realized_unknown_propagation_check", [] { return run_core_synthetic_three_member_realized_unknown_propagation_check(); }},
       {"run_synthetic_stream_plus_still_single_session_truth_check", [] { return run_synthetic_stream_plus_still_single_session_truth_check(); }},
+      {"run_core_synthetic_live_stream_reconfigure_check", [] { return run_core_synthetic_live_stream_reconfigure_check(); }},
+      {"run_core_stream_recording_check", [] { return run_core_stream_recording_check(); }},
+      {"run_core_stream_export_check", [] { return run_core_stream_export_check(); }},
+      {"run_replay_provider_check", [] { return run_replay_provider_check(); }},
+      {"run_provider_strand_lanes_check", [] { return run_provider_strand_lanes_check(); }},
+      {"run_provider_strand_inline_check", [] { return run_provider_strand_inline_check(); }},
       {"run_core_measured_backing_plan_evaluation_check", [] { return run_core_measured_backing_plan_evaluation_check(); }},
+      {"run_core_persisted_retained_plan_prior_check", [] { return run_core_persisted_retained_plan_prior_check(); }},
       {"run_core_capture_observation_regression_check", [] { return run_core_capture_observation_regression_check(); }},
       {"run_core_capture_bracket_whole_result_scoring_check", [] { return run_core_capture_bracket_whole_result_scoring_check(); }},
       {"run_core_capture_in_place_plan_flip_result_retrieval_check", [] { return run_core_capture_in_place_plan_flip_result_retrieval_check(); }},
@@ -9487,6 +11885,8 @@ int main(int argc, char** argv) {
       {"run_broker_provider_call_lock_isolation_check", [] { return run_broker_provider_call_lock_isolation_check(); }},
       {"run_broker_shutdown_call_drain_check", [] { return run_broker_shutdown_call_drain_check(); }},
       {"run_broker_failed_initialization_is_not_published_check", [] { return run_broker_failed_initialization_is_not_published_check(); }},
+      {"run_core_broker_provider_hot_swap_check", [] { return run_core_broker_provider_hot_swap_check(); }},
+      {"run_core_rig_capture_from_stream_frame_set_check", [] { return run_core_rig_capture_from_stream_frame_set_check(); }},
       {"run_core_capture_parent_replacement_regression_check", [] { return run_core_capture_parent_replacement_regression_check(); }},
       {"run_core_stream_partial_reporting_check", [] { return run_core_stream_partial_reporting_check(); }},
       {"run_core_capture_observation_after_device_close_check", [] { return run_core_capture_observation_after_device_close_check(); }},
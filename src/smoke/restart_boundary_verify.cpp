@@ -6,6 +6,8 @@
 
 #include "smoke/verify_case/verify_case_harness.h"
 
+#include <chrono>
+
 namespace cambang {
 namespace {
 
@@ -163,6 +165,63 @@ int main() {
   }
   cli::line("step 4 OK");
 
+  // Rapid restart cycles (scenario switching): every cycle must keep the
+  // generation boundary strict -- the prior generation's last observation
+  // surfaces before NIL, and the new baseline carries nothing it created --
+  // and a restart must stay a matter of milliseconds.
+  constexpr int kRestartCycles = 25;
+  constexpr double kMaxAverageRestartMs = 100.0;
+  double restart_ms_total = 0.0;
+  for (int cycle = 0; cycle < kRestartCycles; ++cycle) {
+    const uint64_t gen = h.observed().gen;
+    if (!h.open_device(error) ||
+        !h.wait_for_core_snapshot([](const CamBANGStateSnapshot& s) {
+          return VerifyCaseHarness::has_device(s, VerifyCaseHarness::kDeviceId);
+        }, error)) {
+      cli::error("FAIL: ", error);
+      return 1;
+    }
+    h.tick();
+
+    const auto restart_begin = std::chrono::steady_clock::now();
+    h.stop_runtime();
+    if (!check(h.last_snapshot_before_stop_clear().gen == gen &&
+                   h.last_snapshot_before_stop_clear().device_count == 0 && h.observed().is_nil,
+               "expected each stop to surface its own generation's teardown, then NIL")) {
+      return 1;
+    }
+    if (!h.start_runtime(error) ||
+        !h.wait_for_core_snapshot([&](const CamBANGStateSnapshot& s) { return s.gen == gen + 1; }, error)) {
+      cli::error("FAIL: ", error);
+      return 1;
+    }
+    restart_ms_total +=
+        std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - restart_begin).count();
+    if (!check(h.observed().is_nil, "expected NIL before each post-restart publish")) {
+      return 1;
+    }
+
+    h.tick();
+    const ObservedSnapshot& baseline = h.observed();
+    if (!check(!baseline.is_nil && baseline.gen == gen + 1 && baseline.version == 0 &&
+                   baseline.topology_version == 0 && baseline.device_count == 0 &&
+                   baseline.stream_count == 0 && baseline.raw != nullptr,
+               "expected an empty version-0 baseline for each new generation")) {
+      return 1;
+    }
+    for (const NativeObjectRecord& n : baseline.raw->native_objects) {
+      if (!check(n.creation_gen == gen + 1, "expected no native record carried across a restart")) {
+        return 1;
+      }
+    }
+  }
+  const double average_restart_ms = restart_ms_total / kRestartCycles;
+  if (!check(average_restart_ms < kMaxAverageRestartMs, "expected restart to average well under 100 ms")) {
+    cli::error("average restart ms: ", average_restart_ms);
+    return 1;
+  }
+  cli::line("step 5 OK (", kRestartCycles, " restarts, average ", average_restart_ms, " ms)");
+
   cli::line("PASS restart_boundary_verify");
   return 0;
 }
@@ -0,0 +1,487 @@
+/*
+CamBANG Maintainer Utility
+
+Tool: result_store_contention_bench
+
+Purpose
+-------
+Measures CoreResultStore throughput under the contention it sees in a host:
+one core thread retaining stream (and periodic capture) frames while other
+threads read results and mark display demand.
+
+A writer thread stands in for the core thread. It retains one CPU RGBA
+frame per stream each pacing period (--streams at --fps, copied through a
+CpuPayloadBufferPool as CoreRuntime does) and a capture every
+--capture_every rounds, dropping the previous capture so the store stays
+bounded. --readers threads loop over every stream calling
+get_latest_stream_result() and mark_stream_display_demand(), and over the
+newest capture calling get_capture_result_set().
+
+Three phases run on a fresh store each: writer alone, readers alone (over
+one retained round), and both together. Each reports retain and read latency
+histograms and allocations per retained frame (counted on the writer thread
+by this tool's global operator new). The store exposes no lock timing, so
+lock wait is estimated as the contended phase's mean latency minus the same
+operation's mean in its uncontended phase.
+
+Category
+--------
+Benchmark (maintainer).
+
+Non-Goals
+---------
+- Not a core invariant smoke test
+- Not deterministic: results depend on the host and its load
+- Does not run CoreRuntime; dispatch, ingress and snapshots are excluded
+*/
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <new>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if !defined(CAMBANG_INTERNAL_SMOKE)
+  #error "result_store_contention_bench: build through the repo SCons maintainer_tools alias so CAMBANG_INTERNAL_SMOKE=1 is defined."
+#endif
+
+#include "core/core_result_store.h"
+#include "core/core_task_timing.h"
+#include "imaging/api/cpu_payload_buffer_pool.h"
+
+using namespace cambang;
+
+// Allocations made by the calling thread; the writer samples it around
+// retain_frame().
+namespace {
+thread_local uint64_t t_allocations = 0;
+} // namespace
+
+void* operator new(std::size_t size) {
+  ++t_allocations;
+  if (void* p = std::malloc(size != 0 ? size : 1)) {
+    return p;
+  }
+  throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+namespace {
+
+struct Options {
+  uint32_t streams = 4;
+  uint32_t fps = 60;
+  uint32_t readers = 4;
+  uint32_t duration_ms = 2000;
+  uint32_t width = 640;
+  uint32_t height = 480;
+  uint32_t capture_every = 30;
+  std::string json_path;
+};
+
+enum class Phase { WRITER_ONLY, READERS_ONLY, CONTENDED };
+
+const char* phase_name(Phase p) {
+  switch (p) {
+    case Phase::WRITER_ONLY: return "writer_only";
+    case Phase::READERS_ONLY: return "readers_only";
+    case Phase::CONTENDED: return "contended";
+  }
+  return "unknown";
+}
+
+struct ReaderTimings {
+  CoreLatencyHistogram stream_read{};
+  CoreLatencyHistogram capture_read{};
+  CoreLatencyHistogram demand_mark{};
+};
+
+struct PhaseResult {
+  Phase phase = Phase::WRITER_ONLY;
+  uint64_t wall_ns = 0;
+  uint64_t frames_retained = 0;
+  uint64_t captures_retained = 0;
+  uint64_t retain_failures = 0;
+  uint64_t writer_allocations = 0;
+  uint64_t rounds_late = 0;
+  CoreLatencyHistogram stream_retain{};
+  CoreLatencyHistogram capture_retain{};
+  ReaderTimings reads{};
+};
+
+void usage(const char* argv0) {
+  std::cerr << "Usage: " << argv0
+            << " [--streams=N] [--fps=N] [--readers=N] [--duration_ms=N] [--w=W] [--h=H]"
+            << " [--capture_every=N] [--json=PATH]\n\n"
+            << "Retains --streams (default 4) CPU RGBA streams at --fps (default 60) from one\n"
+            << "writer thread while --readers (default 4) threads read results and mark display\n"
+            << "demand, for --duration_ms (default 2000) per phase, and writes JSON to --json or\n"
+            << "stdout.\n";
+}
+
+bool starts_with(const std::string& s, const std::string& prefix) {
+  return s.rfind(prefix, 0) == 0;
+}
+
+bool parse_u32(const std::string& s, uint32_t& out) {
+  try {
+    size_t idx = 0;
+    const unsigned long v = std::stoul(s, &idx, 10);
+    if (idx != s.size()) return false;
+    out = static_cast<uint32_t>(v);
+    return true;
+  } catch (...) {
+    return false;
+  }
+}
+
+// false on a bad option; help sets `help`.
+bool parse_opts(int argc, char** argv, Options& opt, bool& help) {
+  help = false;
+  for (int i = 1; i < argc; ++i) {
+    const std::string a = argv[i];
+    uint32_t* target = nullptr;
+    size_t prefix = 0;
+    if (a == "--help" || a == "-h") {
+      help = true;
+      return true;
+    } else if (starts_with(a, "--json=")) {
+      opt.json_path = a.substr(7);
+      if (opt.json_path.empty()) {
+        std::cerr << "Invalid --json\n";
+        return false;
+      }
+      continue;
+    } else if (starts_with(a, "--streams=")) {
+      target = &opt.streams;
+      prefix = 10;
+    } else if (starts_with(a, "--fps=")) {
+      target = &opt.fps;
+      prefix = 6;
+    } else if (starts_with(a, "--readers=")) {
+      target = &opt.readers;
+      prefix = 10;
+    } else if (starts_with(a, "--duration_ms=")) {
+      target = &opt.duration_ms;
+      prefix = 14;
+    } else if (starts_with(a, "--w=")) {
+      target = &opt.width;
+      prefix = 4;
+    } else if (starts_with(a, "--h=")) {
+      target = &opt.height;
+      prefix = 4;
+    } else if (starts_with(a, "--capture_every=")) {
+      target = &opt.capture_every;
+      prefix = 16;
+    } else {
+      std::cerr << "Unknown option: " << a << "\n";
+      return false;
+    }
+    if (!parse_u32(a.substr(prefix), *target) || *target == 0) {
+      std::cerr << "Invalid " << a.substr(0, prefix - 1) << "\n";
+      return false;
+    }
+  }
+  return true;
+}
+
+uint64_t steady_ns() {
+  return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                   std::chrono::steady_clock::now().time_since_epoch())
+                                   .count());
+}
+
+void record(CoreLatencyHistogram& h, uint64_t ns) {
+  ++h.count;
+  h.total_ns += ns;
+  h.max_ns = std::max(h.max_ns, ns);
+  ++h.buckets[CoreLatencyHistogram::bucket_for(ns)];
+}
+
+void merge(CoreLatencyHistogram& into, const CoreLatencyHistogram& from) {
+  into.count += from.count;
+  into.total_ns += from.total_ns;
+  into.max_ns = std::max(into.max_ns, from.max_ns);
+  for (size_t b = 0; b < CoreLatencyHistogram::kBuckets; ++b) {
+    into.buckets[b] += from.buckets[b];
+  }
+}
+
+uint64_t mean_ns(const CoreLatencyHistogram& h) {
+  return h.count ? h.total_ns / h.count : 0;
+}
+
+// Upper bound of the bucket holding the q-quantile sample.
+uint64_t quantile_upper_ns(const CoreLatencyHistogram& h, double q) {
+  if (h.count == 0) {
+    return 0;
+  }
+  const uint64_t rank = static_cast<uint64_t>(q * static_cast<double>(h.count - 1)) + 1;
+  uint64_t seen = 0;
+  for (size_t b = 0; b < CoreLatencyHistogram::kBuckets; ++b) {
+    seen += h.buckets[b];
+    if (seen >= rank) {
+      const uint64_t upper = CoreLatencyHistogram::bucket_upper_ns(b);
+      return upper != 0 ? upper : h.max_ns;
+    }
+  }
+  return h.max_ns;
+}
+
+constexpr uint64_t kDeviceInstanceId = 1;
+constexpr uint64_t kStreamBase = 1000;
+constexpr uint64_t kCaptureBase = 1;
+
+class Writer {
+public:
+  Writer(const Options& opt, CoreResultStore& store, std::atomic<uint64_t>& latest_capture)
+      : opt_(opt), store_(store), latest_capture_(latest_capture) {
+    // Non-uniform bytes, so the payload copy and signature do real work.
+    payload_.resize(static_cast<size_t>(opt.width) * opt.height * 4u);
+    for (size_t i = 0; i < payload_.size(); ++i) {
+      payload_[i] = static_cast<uint8_t>((i * 2654435761u) >> 24);
+    }
+    plan_.valid = true;
+    plan_.posture = CoreProductionPostureShape::CpuPrimary;
+  }
+
+  // One frame per stream, plus a capture every capture_every rounds.
+  void retain_round(PhaseResult& out) {
+    for (uint32_t s = 0; s < opt_.streams; ++s) {
+      retain_(make_frame_(kStreamBase + s, 0), StreamIntent::PREVIEW, out.stream_retain, out);
+    }
+    if (round_++ % opt_.capture_every != 0) {
+      return;
+    }
+    const uint64_t capture_id = next_capture_id_++;
+    if (retain_(make_frame_(0, capture_id), std::nullopt, out.capture_retain, out)) {
+      ++out.captures_retained;
+      latest_capture_.store(capture_id, std::memory_order_release);
+      if (capture_id > kCaptureBase) {
+        store_.remove_capture_result(capture_id - 1, kDeviceInstanceId);
+      }
+    }
+  }
+
+  void run(uint64_t end_ns, PhaseResult& out) {
+    const uint64_t period_ns = 1'000'000'000ull / opt_.fps;
+    uint64_t deadline_ns = steady_ns();
+    while (deadline_ns < end_ns) {
+      retain_round(out);
+      deadline_ns += period_ns;
+      const uint64_t now_ns = steady_ns();
+      if (now_ns > deadline_ns) {
+        // Overran the period: count it and do not try to catch up.
+        ++out.rounds_late;
+        deadline_ns = now_ns;
+        continue;
+      }
+      std::this_thread::sleep_for(std::chrono::nanoseconds(deadline_ns - now_ns));
+    }
+  }
+
+private:
+  FrameView make_frame_(uint64_t stream_id, uint64_t capture_id) {
+    FrameView frame{};
+    frame.device_instance_id = kDeviceInstanceId;
+    frame.stream_id = stream_id;
+    frame.capture_id = capture_id;
+    frame.width = opt_.width;
+    frame.height = opt_.height;
+    frame.format_fourcc = FOURCC_RGBA;
+    frame.data = payload_.data();
+    frame.size_bytes = payload_.size();
+    frame.stride_bytes = opt_.width * 4u;
+    return frame;
+  }
+
+  bool retain_(const FrameView& frame,
+               std::optional<StreamIntent> intent,
+               CoreLatencyHistogram& timing,
+               PhaseResult& out) {
+    const uint64_t allocations_before = t_allocations;
+    const uint64_t t0 = steady_ns();
+    const bool ok = intent ? store_.retain_frame(frame, intent, 1, 0, plan_)
+                           : store_.retain_frame(frame, std::nullopt, 0, 1, {}, plan_);
+    record(timing, steady_ns() - t0);
+    out.writer_allocations += t_allocations - allocations_before;
+    if (ok) {
+      ++out.frames_retained;
+    } else {
+      ++out.retain_failures;
+    }
+    return ok;
+  }
+
+  const Options& opt_;
+  CoreResultStore& store_;
+  std::atomic<uint64_t>& latest_capture_;
+  std::vector<uint8_t> payload_;
+  CoreRetainedProductionPlan plan_{};
+  uint64_t round_ = 0;
+  uint64_t next_capture_id_ = kCaptureBase;
+};
+
+void run_reader(const Options& opt,
+                const CoreResultStore& store,
+                CoreResultStore& mutable_store,
+                const std::atomic<uint64_t>& latest_capture,
+                const std::atomic<bool>& stop,
+                ReaderTimings& out) {
+  while (!stop.load(std::memory_order_acquire)) {
+    for (uint32_t s = 0; s < opt.streams; ++s) {
+      const uint64_t stream_id = kStreamBase + s;
+      uint64_t t0 = steady_ns();
+      (void)store.get_latest_stream_result(stream_id);
+      record(out.stream_read, steady_ns() - t0);
+      t0 = steady_ns();
+      mutable_store.mark_stream_display_demand(stream_id, t0);
+      record(out.demand_mark, steady_ns() - t0);
+    }
+    const uint64_t capture_id = latest_capture.load(std::memory_order_acquire);
+    if (capture_id != 0) {
+      const uint64_t t0 = steady_ns();
+      (void)store.get_capture_result_set(capture_id);
+      record(out.capture_read, steady_ns() - t0);
+    }
+  }
+}
+
+PhaseResult run_phase(const Options& opt, Phase phase) {
+  PhaseResult out;
+  out.phase = phase;
+
+  CpuPayloadBufferPool pool;
+  CoreResultStore store;
+  store.set_cpu_payload_buffer_pool(&pool);
+  std::atomic<uint64_t> latest_capture{0};
+  std::atomic<bool> stop{false};
+  Writer writer(opt, store, latest_capture);
+
+  if (phase == Phase::READERS_ONLY) {
+    // Something to read; not part of the measurement.
+    PhaseResult setup;
+    writer.retain_round(setup);
+  }
+
+  const uint32_t reader_count = phase == Phase::WRITER_ONLY ? 0u : opt.readers;
+  std::vector<ReaderTimings> reader_timings(reader_count);
+  std::vector<std::thread> readers;
+  readers.reserve(reader_count);
+  const uint64_t begin_ns = steady_ns();
+  const uint64_t end_ns = begin_ns + static_cast<uint64_t>(opt.duration_ms) * 1'000'000ull;
+  for (uint32_t r = 0; r < reader_count; ++r) {
+    readers.emplace_back(run_reader, std::cref(opt), std::cref(store), std::ref(store), std::cref(latest_capture),
+                         std::cref(stop), std::ref(reader_timings[r]));
+  }
+
+  if (phase == Phase::READERS_ONLY) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(opt.duration_ms));
+  } else {
+    writer.run(end_ns, out);
+  }
+  stop.store(true, std::memory_order_release);
+  for (std::thread& t : readers) {
+    t.join();
+  }
+  out.wall_ns = steady_ns() - begin_ns;
+
+  for (const ReaderTimings& t : reader_timings) {
+    merge(out.reads.stream_read, t.stream_read);
+    merge(out.reads.capture_read, t.capture_read);
+    merge(out.reads.demand_mark, t.demand_mark);
+  }
+  return out;
+}
+
+void write_histogram(std::ostream& json, const char* name, const CoreLatencyHistogram& h) {
+  json << ",\"" << name << "\":{\"count\":" << h.count
+       << ",\"mean_ns\":" << mean_ns(h)
+       << ",\"p50_ns\":" << quantile_upper_ns(h, 0.50)
+       << ",\"p99_ns\":" << quantile_upper_ns(h, 0.99)
+       << ",\"max_ns\":" << h.max_ns << "}";
+}
+
+// Contended mean minus uncontended mean, floored at zero.
+int64_t lock_wait_estimate_ns(const CoreLatencyHistogram& contended, const CoreLatencyHistogram& alone) {
+  if (contended.count == 0 || alone.count == 0) {
+    return 0;
+  }
+  return std::max<int64_t>(0, static_cast<int64_t>(mean_ns(contended)) - static_cast<int64_t>(mean_ns(alone)));
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  Options opt;
+  bool help = false;
+  if (!parse_opts(argc, argv, opt, help)) {
+    usage(argv[0]);
+    return 2;
+  }
+  if (help) {
+    usage(argv[0]);
+    return 0;
+  }
+
+  std::ofstream json_file;
+  if (!opt.json_path.empty()) {
+    json_file.open(opt.json_path);
+    if (!json_file) {
+      std::cerr << "Cannot write --json " << opt.json_path << "\n";
+      return 2;
+    }
+  }
+  std::ostream& json = opt.json_path.empty() ? std::cout : json_file;
+
+  json << "{\"tool\":\"result_store_contention_bench\",\"schema\":1,\"streams\":" << opt.streams
+       << ",\"fps\":" << opt.fps << ",\"readers\":" << opt.readers << ",\"width\":" << opt.width
+       << ",\"height\":" << opt.height << ",\"capture_every\":" << opt.capture_every
+       << ",\"duration_ms\":" << opt.duration_ms
+       << ",\"hardware_concurrency\":" << std::thread::hardware_concurrency() << ",\"phases\":[";
+
+  std::vector<PhaseResult> results;
+  for (Phase phase : {Phase::WRITER_ONLY, Phase::READERS_ONLY, Phase::CONTENDED}) {
+    const PhaseResult p = run_phase(opt, phase);
+    const double allocations_per_frame =
+        p.frames_retained ? static_cast<double>(p.writer_allocations) / static_cast<double>(p.frames_retained) : 0.0;
+    const double frames_per_sec =
+        p.wall_ns ? static_cast<double>(p.frames_retained) * 1e9 / static_cast<double>(p.wall_ns) : 0.0;
+    json << (results.empty() ? "\n" : ",\n") << "{\"phase\":\"" << phase_name(p.phase) << "\""
+         << ",\"wall_ns\":" << p.wall_ns << ",\"frames_retained\":" << p.frames_retained
+         << ",\"captures_retained\":" << p.captures_retained << ",\"retain_failures\":" << p.retain_failures
+         << ",\"rounds_late\":" << p.rounds_late << ",\"frames_per_sec\":" << frames_per_sec
+         << ",\"allocations_per_frame\":" << allocations_per_frame;
+    write_histogram(json, "stream_retain", p.stream_retain);
+    write_histogram(json, "capture_retain", p.capture_retain);
+    write_histogram(json, "stream_read", p.reads.stream_read);
+    write_histogram(json, "capture_read", p.reads.capture_read);
+    write_histogram(json, "demand_mark", p.reads.demand_mark);
+    json << "}";
+    std::cerr << "result_store_contention_bench: phase=" << phase_name(p.phase)
+              << " frames_retained=" << p.frames_retained << " stream_retain_mean_ns=" << mean_ns(p.stream_retain)
+              << " stream_read_mean_ns=" << mean_ns(p.reads.stream_read)
+              << " allocations_per_frame=" << allocations_per_frame << "\n";
+    results.push_back(p);
+  }
+
+  const PhaseResult& writer_only = results[0];
+  const PhaseResult& readers_only = results[1];
+  const PhaseResult& contended = results[2];
+  json << "\n],\"lock_wait_estimate_ns\":{"
+       << "\"stream_retain\":" << lock_wait_estimate_ns(contended.stream_retain, writer_only.stream_retain)
+       << ",\"capture_retain\":" << lock_wait_estimate_ns(contended.capture_retain, writer_only.capture_retain)
+       << ",\"stream_read\":" << lock_wait_estimate_ns(contended.reads.stream_read, readers_only.reads.stream_read)
+       << ",\"capture_read\":" << lock_wait_estimate_ns(contended.reads.capture_read, readers_only.reads.capture_read)
+       << ",\"demand_mark\":" << lock_wait_estimate_ns(contended.reads.demand_mark, readers_only.reads.demand_mark)
+       << "}}\n";
+  return 0;
+}
@@ -2272,6 +2272,9 @@ int canonical_timeline_realization(VerifyCaseProviderKind provider_kind) {
   CoreRuntime runtime;
   StateSnapshotBuffer snapshot_buffer;
   runtime.set_snapshot_publisher(&snapshot_buffer);
+  const VerifyCaseRuntimeOptions& runtime_options = VerifyCaseHarness::runtime_options();
+  (void)runtime.set_frame_shard_count(runtime_options.frame_shard_count);
+  (void)runtime.set_snapshot_publish_offload(runtime_options.snapshot_publish_offload);
 
   std::string error;
   if (!runtime.start()) {
@@ -35,6 +35,14 @@ enum class VerifyCaseProviderKind {
 
 inline constexpr int kVerifyCaseSkipped = 3;
 
+// Opt-in CoreRuntime modes every harness applies before starting its runtime,
+// so the whole catalog can run with them (verify_case_runner
+// --frame-shards=N / --snapshot-publish-offload).
+struct VerifyCaseRuntimeOptions {
+  size_t frame_shard_count = 0;
+  bool snapshot_publish_offload = false;
+};
+
 inline const char* verify_case_provider_name(VerifyCaseProviderKind kind) noexcept {
   switch (kind) {
     case VerifyCaseProviderKind::Synthetic: return "synthetic";
@@ -657,9 +665,21 @@ public:
 
   void set_realization_profiler(RealizationProfiler* profiler) noexcept { realization_profiler_ = profiler; }
 
+  // Process-wide; set once by the runner before any case runs.
+  static VerifyCaseRuntimeOptions& runtime_options() noexcept {
+    static VerifyCaseRuntimeOptions options;
+    return options;
+  }
+
   bool start_runtime(std::string& error) {
     stop_runtime();
 
+    const VerifyCaseRuntimeOptions& options = runtime_options();
+    if (!runtime_.set_frame_shard_count(options.frame_shard_count) ||
+        !runtime_.set_snapshot_publish_offload(options.snapshot_publish_offload)) {
+      error = "runtime options rejected";
+      return false;
+    }
     if (!runtime_.start()) {
       error = "runtime start failed";
       return false;
@@ -1,7 +1,35 @@
+#include <algorithm>
+#include <atomic>
 #include <charconv>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
 #include <iostream>
+#include <mutex>
+#include <optional>
 #include <string>
 #include <string_view>
+#include <thread>
+#include <vector>
+
+#if defined(_WIN32)
+  #ifndef NOMINMAX
+    #define NOMINMAX
+  #endif
+  #include <windows.h>
+  // windows.h exposes ERROR as a macro; CamBANG snapshot enums use the
+  // ordinary scoped enumerator name and must not be macro-substituted.
+  #ifdef ERROR
+    #undef ERROR
+  #endif
+#else
+  #include <cerrno>
+  #include <fcntl.h>
+  #include <sys/types.h>
+  #include <sys/wait.h>
+  #include <unistd.h>
+#endif
 
 #include "dev/cli_log.h"
 
@@ -18,11 +46,14 @@ bool starts_with(const std::string& s, const std::string& prefix) {
 }
 
 void usage(const char* argv0, const std::vector<cambang::VerifyCaseDefinition>& verify_cases) {
-  std::cerr << "usage: " << argv0 << " <verification_case_name> [--provider=synthetic|stub] [--repeat=N] [--trace-realization[=block|csv|both]]\n";
-  std::cerr << "   or: " << argv0 << " --run-all [--provider=synthetic|stub] [--repeat=N] [--trace-realization[=block|csv|both]] [--verbose]\n";
+  std::cerr << "usage: " << argv0 << " <verification_case_name> [--provider=synthetic|stub] [--repeat=N] [--trace-realization[=block|csv|both]] [--frame-shards=N] [--snapshot-publish-offload]\n";
+  std::cerr << "   or: " << argv0 << " --run-all [--provider=synthetic|stub] [--repeat=N] [--trace-realization[=block|csv|both]] [--frame-shards=N] [--snapshot-publish-offload] [--verbose] [--jobs=N]\n";
   std::cerr << "default provider: synthetic\n";
+  std::cerr << "default frame shards: 0 (off)\n";
+  std::cerr << "default snapshot publish offload: off\n";
   std::cerr << "default repeat: 1\n";
   std::cerr << "default run-all: concise (pass details suppressed unless --verbose)\n";
+  std::cerr << "default jobs: one worker process per hardware thread; --jobs=1 runs every case in this process\n";
   std::cerr << "available verification cases:\n";
   for (const auto& verify_case : verify_cases) {
     std::cerr << "  " << verify_case.name << "\n";
@@ -39,6 +70,26 @@ bool parse_repeat_count(const std::string& value, uint64_t& repeat_count) {
   return result.ec == std::errc{} && result.ptr == end && repeat_count > 0;
 }
 
+bool parse_frame_shard_count(const std::string& value, size_t& shard_count) {
+  if (value.empty()) {
+    return false;
+  }
+  const char* begin = value.data();
+  const char* end = value.data() + value.size();
+  const auto result = std::from_chars(begin, end, shard_count);
+  return result.ec == std::errc{} && result.ptr == end && shard_count <= cambang::CoreFrameShards::kMaxShards;
+}
+
+bool parse_job_count(const std::string& value, uint32_t& job_count) {
+  if (value.empty()) {
+    return false;
+  }
+  const char* begin = value.data();
+  const char* end = value.data() + value.size();
+  const auto result = std::from_chars(begin, end, job_count);
+  return result.ec == std::errc{} && result.ptr == end && job_count > 0;
+}
+
 
 bool parse_trace_realization(const std::string& value, cambang::RealizationProfilerOptions& options) {
   options.enabled = true;
@@ -124,62 +175,415 @@ int run_single_verify_case(const cambang::VerifyCaseDefinition& verify_case,
   return 0;
 }
 
-int run_all_verify_cases(const std::vector<cambang::VerifyCaseDefinition>& verify_cases,
+// --run-all hands each case to a worker: this executable again, in
+// kWorkerArgument mode, so cases share no process-global state (the GPU ops
+// seam, resource telemetry, the CLI line sink). The worker runs the case's
+// iterations with its log captured, writes the log, then one result line.
+constexpr const char* kWorkerArgument = "--verify-case-worker=";
+constexpr std::string_view kWorkerResultPrefix = "verify_case_worker_result ";
+
+enum class CaseStatus : uint8_t {
+  Passed = 0,
+  Skipped = 1,
+  Failed = 2,
+};
+
+struct CaseOutcome {
+  CaseStatus status = CaseStatus::Passed;
+  uint64_t completed = 0;
+  uint64_t failed_iteration = 0;
+  uint64_t wall_ms = 0;
+  std::string log;
+  // Set when a worker process failed outside the case itself.
+  std::string worker_error;
+};
+
+uint64_t elapsed_ms(std::chrono::steady_clock::time_point since) {
+  return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+                                   std::chrono::steady_clock::now() - since)
+                                   .count());
+}
+
+CaseOutcome run_verify_case_captured(const cambang::VerifyCaseDefinition& verify_case, uint64_t repeat_count) {
+  CaseOutcome outcome;
+  const auto started = std::chrono::steady_clock::now();
+  {
+    cli::scoped_line_sink capture(&append_line_to_buffer, &outcome.log);
+    for (uint64_t iteration = 1; iteration <= repeat_count; ++iteration) {
+      const int rc = verify_case.run();
+      if (rc == cambang::kVerifyCaseSkipped) {
+        outcome.status = CaseStatus::Skipped;
+        break;
+      }
+      if (rc != 0) {
+        outcome.status = CaseStatus::Failed;
+        outcome.failed_iteration = iteration;
+        break;
+      }
+      outcome.completed = iteration;
+    }
+  }
+  outcome.wall_ms = elapsed_ms(started);
+  return outcome;
+}
+
+int run_verify_case_worker(const cambang::VerifyCaseDefinition& verify_case, uint64_t repeat_count) {
+  const CaseOutcome outcome = run_verify_case_captured(verify_case, repeat_count);
+  std::fwrite(outcome.log.data(), 1, outcome.log.size(), stdout);
+  std::printf("%.*scompleted=%llu failed_iteration=%llu\n",
+              static_cast<int>(kWorkerResultPrefix.size()), kWorkerResultPrefix.data(),
+              static_cast<unsigned long long>(outcome.completed),
+              static_cast<unsigned long long>(outcome.failed_iteration));
+  std::fflush(stdout);
+  switch (outcome.status) {
+    case CaseStatus::Passed: return 0;
+    case CaseStatus::Skipped: return cambang::kVerifyCaseSkipped;
+    case CaseStatus::Failed: break;
+  }
+  return 1;
+}
+
+struct WorkerProcessResult {
+  bool launched = false;
+  bool terminated_by_signal = false;
+  int signal_number = 0;
+  uint64_t exit_code = 0;
+  std::string output;
+  std::string launch_error;
+};
+
+// Pipe creation and process launch are serialized so a worker never
+// inherits another worker's pipe, which would hold that pipe open (and its
+// reader blocked) until both exit.
+std::mutex& worker_launch_mutex() {
+  static std::mutex m;
+  return m;
+}
+
+#if defined(_WIN32)
+
+std::string windows_error_message(DWORD error) {
+  char* message = nullptr;
+  const DWORD length = FormatMessageA(
+      FORMAT_MESSAGE_ALLOCATE_BUFFER | FORMAT_MESSAGE_FROM_SYSTEM |
+          FORMAT_MESSAGE_IGNORE_INSERTS,
+      nullptr,
+      error,
+      0,
+      reinterpret_cast<char*>(&message),
+      0,
+      nullptr);
+  std::string result = length != 0 && message ? std::string(message, length)
+                                               : "Windows error " + std::to_string(error);
+  if (message) {
+    LocalFree(message);
+  }
+  return result;
+}
+
+std::string current_executable_path() {
+  std::vector<char> buffer(1024);
+  for (;;) {
+    const DWORD length = GetModuleFileNameA(
+        nullptr, buffer.data(), static_cast<DWORD>(buffer.size()));
+    if (length == 0) {
+      return {};
+    }
+    if (length < buffer.size() - 1) {
+      return std::string(buffer.data(), length);
+    }
+    buffer.resize(buffer.size() * 2);
+  }
+}
+
+WorkerProcessResult run_worker_process(const char*, const std::vector<std::string>& args) {
+  WorkerProcessResult result;
+  const std::string executable = current_executable_path();
+  if (executable.empty()) {
+    result.launch_error = "GetModuleFileNameA failed";
+    return result;
+  }
+  std::string command_line = "\"" + executable + "\"";
+  for (const std::string& arg : args) {
+    command_line += " \"" + arg + "\"";
+  }
+
+  HANDLE read_pipe = nullptr;
+  PROCESS_INFORMATION process{};
+  {
+    std::lock_guard<std::mutex> lock(worker_launch_mutex());
+    SECURITY_ATTRIBUTES security{};
+    security.nLength = sizeof(security);
+    security.bInheritHandle = TRUE;
+    HANDLE write_pipe = nullptr;
+    if (!CreatePipe(&read_pipe, &write_pipe, &security, 0)) {
+      result.launch_error = windows_error_message(GetLastError());
+      return result;
+    }
+    if (!SetHandleInformation(read_pipe, HANDLE_FLAG_INHERIT, 0)) {
+      result.launch_error = windows_error_message(GetLastError());
+      CloseHandle(read_pipe);
+      CloseHandle(write_pipe);
+      return result;
+    }
+
+    STARTUPINFOA startup{};
+    startup.cb = sizeof(startup);
+    startup.dwFlags = STARTF_USESTDHANDLES;
+    startup.hStdInput = GetStdHandle(STD_INPUT_HANDLE);
+    startup.hStdOutput = write_pipe;
+    startup.hStdError = write_pipe;
+    const BOOL created = CreateProcessA(
+        executable.c_str(),
+        command_line.data(),
+        nullptr,
+        nullptr,
+        TRUE,
+        CREATE_NO_WINDOW,
+        nullptr,
+        nullptr,
+        &startup,
+        &process);
+    CloseHandle(write_pipe);
+    if (!created) {
+      result.launch_error = windows_error_message(GetLastError());
+      CloseHandle(read_pipe);
+      return result;
+    }
+  }
+  result.launched = true;
+
+  // Drain before waiting: a worker blocked on a full pipe never exits.
+  char chunk[4096];
+  for (;;) {
+    DWORD read = 0;
+    if (!ReadFile(read_pipe, chunk, sizeof(chunk), &read, nullptr) || read == 0) {
+      break;
+    }
+    result.output.append(chunk, read);
+  }
+  (void)WaitForSingleObject(process.hProcess, INFINITE);
+  DWORD exit_code = 0;
+  if (GetExitCodeProcess(process.hProcess, &exit_code)) {
+    result.exit_code = static_cast<uint64_t>(exit_code);
+  }
+
+  CloseHandle(read_pipe);
+  CloseHandle(process.hThread);
+  CloseHandle(process.hProcess);
+  return result;
+}
+
+#else
+
+WorkerProcessResult run_worker_process(const char* argv0, const std::vector<std::string>& args) {
+  WorkerProcessResult result;
+  std::vector<char*> child_argv;
+  child_argv.push_back(const_cast<char*>(argv0));
+  for (const std::string& arg : args) {
+    child_argv.push_back(const_cast<char*>(arg.c_str()));
+  }
+  child_argv.push_back(nullptr);
+
+  int output_pipe[2]{};
+  pid_t child = -1;
+  {
+    std::lock_guard<std::mutex> lock(worker_launch_mutex());
+    if (pipe(output_pipe) != 0) {
+      result.launch_error = std::strerror(errno);
+      return result;
+    }
+    (void)fcntl(output_pipe[0], F_SETFD, FD_CLOEXEC);
+    (void)fcntl(output_pipe[1], F_SETFD, FD_CLOEXEC);
+    child = fork();
+    if (child < 0) {
+      result.launch_error = std::strerror(errno);
+      close(output_pipe[0]);
+      close(output_pipe[1]);
+      return result;
+    }
+    if (child == 0) {
+      // dup2() clears FD_CLOEXEC on the copies the worker keeps.
+      (void)dup2(output_pipe[1], STDOUT_FILENO);
+      (void)dup2(output_pipe[1], STDERR_FILENO);
+      execvp(argv0, child_argv.data());
+      _exit(127);
+    }
+    close(output_pipe[1]);
+  }
+  result.launched = true;
+
+  // Drain before waiting: a worker blocked on a full pipe never exits.
+  char chunk[4096];
+  for (;;) {
+    const ssize_t read_count = read(output_pipe[0], chunk, sizeof(chunk));
+    if (read_count > 0) {
+      result.output.append(chunk, static_cast<size_t>(read_count));
+      continue;
+    }
+    if (read_count < 0 && errno == EINTR) {
+      continue;
+    }
+    break;
+  }
+  close(output_pipe[0]);
+
+  int status = 0;
+  while (waitpid(child, &status, 0) < 0 && errno == EINTR) {
+  }
+  if (WIFSIGNALED(status)) {
+    result.terminated_by_signal = true;
+    result.signal_number = WTERMSIG(status);
+    result.exit_code = static_cast<uint64_t>(128 + result.signal_number);
+  } else if (WIFEXITED(status)) {
+    result.exit_code = static_cast<uint64_t>(WEXITSTATUS(status));
+  }
+  return result;
+}
+
+#endif
+
+uint64_t parse_worker_field(std::string_view line, std::string_view key) {
+  const size_t at = line.find(key);
+  uint64_t value = 0;
+  if (at != std::string_view::npos) {
+    const char* begin = line.data() + at + key.size();
+    (void)std::from_chars(begin, line.data() + line.size(), value);
+  }
+  return value;
+}
+
+CaseOutcome run_verify_case_in_worker(const char* argv0,
+                                      const cambang::VerifyCaseDefinition& verify_case,
+                                      const std::vector<std::string>& forwarded_args,
+                                      uint64_t repeat_count) {
+  std::vector<std::string> args;
+  args.push_back(std::string(kWorkerArgument) + verify_case.name);
+  args.insert(args.end(), forwarded_args.begin(), forwarded_args.end());
+
+  CaseOutcome outcome;
+  const auto started = std::chrono::steady_clock::now();
+  WorkerProcessResult worker = run_worker_process(argv0, args);
+  outcome.wall_ms = elapsed_ms(started);
+  if (!worker.launched) {
+    outcome.status = CaseStatus::Failed;
+    outcome.failed_iteration = 1;
+    outcome.worker_error = "worker launch failed: " + worker.launch_error;
+    return outcome;
+  }
+
+  // The result line is the worker's last; everything before it is the log.
+  std::optional<std::string_view> result_line;
+  const size_t result_at = worker.output.rfind(kWorkerResultPrefix);
+  if (result_at != std::string::npos && (result_at == 0 || worker.output[result_at - 1] == '\n')) {
+    std::string_view rest(worker.output);
+    rest.remove_prefix(result_at);
+    result_line = rest.substr(0, rest.find('\n'));
+  }
+  if (result_line) {
+    outcome.completed = parse_worker_field(*result_line, "completed=");
+    outcome.failed_iteration = parse_worker_field(*result_line, "failed_iteration=");
+    worker.output.resize(result_at);
+  }
+  outcome.log = std::move(worker.output);
+
+  if (worker.exit_code == 0 && result_line) {
+    outcome.status = CaseStatus::Passed;
+  } else if (worker.exit_code == static_cast<uint64_t>(cambang::kVerifyCaseSkipped) && result_line) {
+    outcome.status = CaseStatus::Skipped;
+  } else {
+    outcome.status = CaseStatus::Failed;
+    if (outcome.failed_iteration == 0) {
+      outcome.failed_iteration = std::min(outcome.completed + 1, repeat_count);
+    }
+    if (!result_line || worker.terminated_by_signal) {
+      outcome.worker_error = worker.terminated_by_signal
+                                 ? "worker terminated by signal " + std::to_string(worker.signal_number)
+                                 : "worker exited with code " + std::to_string(worker.exit_code) +
+                                       " before reporting a result";
+    }
+  }
+  return outcome;
+}
+
+int run_all_verify_cases(const char* argv0,
+                         const std::vector<cambang::VerifyCaseDefinition>& verify_cases,
+                         const std::vector<std::string>& forwarded_args,
                          uint64_t repeat_count,
+                         uint32_t job_count,
                          bool verbose) {
   size_t passed = 0;
   size_t skipped = 0;
   size_t failed = 0;
+  const auto started = std::chrono::steady_clock::now();
 
-  for (const auto& verify_case : verify_cases) {
-    bool verify_case_failed = false;
-    bool verify_case_skipped = false;
-    uint64_t completed = 0;
-    uint64_t failed_iteration = 0;
-    std::string case_log;
-
-    {
-      cli::scoped_line_sink capture(&append_line_to_buffer, &case_log);
-      for (uint64_t iteration = 1; iteration <= repeat_count; ++iteration) {
-        const int rc = verify_case.run();
-        if (rc == cambang::kVerifyCaseSkipped) {
-          verify_case_skipped = true;
-          ++skipped;
-          break;
+  std::vector<std::optional<CaseOutcome>> outcomes(verify_cases.size());
+  std::mutex outcomes_mutex;
+  std::condition_variable outcome_ready;
+  std::atomic<size_t> next_case{0};
+  std::vector<std::thread> workers;
+  if (job_count > 1) {
+    const size_t worker_count = std::min<size_t>(job_count, verify_cases.size());
+    for (size_t w = 0; w < worker_count; ++w) {
+      workers.emplace_back([&]() {
+        for (size_t i = next_case.fetch_add(1); i < verify_cases.size(); i = next_case.fetch_add(1)) {
+          CaseOutcome outcome = run_verify_case_in_worker(argv0, verify_cases[i], forwarded_args, repeat_count);
+          {
+            std::lock_guard<std::mutex> lock(outcomes_mutex);
+            outcomes[i] = std::move(outcome);
+          }
+          outcome_ready.notify_all();
         }
-        if (rc != 0) {
-          verify_case_failed = true;
-          failed_iteration = iteration;
-          ++failed;
-          break;
-        }
-        completed = iteration;
-      }
+      });
+    }
+  }
+
+  // Reported in catalog order whatever order the workers finish in.
+  for (size_t i = 0; i < verify_cases.size(); ++i) {
+    const auto& verify_case = verify_cases[i];
+    CaseOutcome outcome;
+    if (workers.empty()) {
+      outcome = run_verify_case_captured(verify_case, repeat_count);
+    } else {
+      std::unique_lock<std::mutex> lock(outcomes_mutex);
+      outcome_ready.wait(lock, [&]() { return outcomes[i].has_value(); });
+      outcome = std::move(*outcomes[i]);
+      outcomes[i].reset();
     }
 
-    if (verify_case_failed) {
-      print_case_log_dump(verify_case.name, case_log);
-      cli::line("[FAIL] ", verify_case.name, " (iteration ", failed_iteration, "/", repeat_count, ")");
+    if (outcome.status == CaseStatus::Failed) {
+      ++failed;
+      print_case_log_dump(verify_case.name, outcome.log);
+      if (!outcome.worker_error.empty()) {
+        cli::error(verify_case.name, ": ", outcome.worker_error);
+      }
+      cli::line("[FAIL] ", verify_case.name, " (iteration ", outcome.failed_iteration, "/", repeat_count, ", ",
+                outcome.wall_ms, " ms)");
       continue;
     }
 
-    if (verify_case_skipped) {
+    if (outcome.status == CaseStatus::Skipped) {
+      ++skipped;
       if (verbose) {
-        print_case_log_dump(verify_case.name, case_log);
+        print_case_log_dump(verify_case.name, outcome.log);
       }
-      cli::line("[SKIP] ", verify_case.name);
+      cli::line("[SKIP] ", verify_case.name, " (", outcome.wall_ms, " ms)");
       continue;
     }
 
     ++passed;
     if (verbose) {
-      print_case_log_dump(verify_case.name, case_log);
+      print_case_log_dump(verify_case.name, outcome.log);
     }
-    cli::line("[PASS] ", verify_case.name, " (", completed, "/", repeat_count, ")");
+    cli::line("[PASS] ", verify_case.name, " (", outcome.completed, "/", repeat_count, ", ", outcome.wall_ms, " ms)");
+  }
+  for (std::thread& worker : workers) {
+    worker.join();
   }
 
   cli::line(failed == 0 ? "PASS" : "FAIL", " verify_case_runner passed=", passed,
-            " skipped=", skipped, " failed=", failed);
+            " skipped=", skipped, " failed=", failed, " jobs=", workers.empty() ? 1 : workers.size(),
+            " wall_ms=", elapsed_ms(started));
   return failed == 0 ? 0 : 1;
 }
 
@@ -192,7 +596,11 @@ int main(int argc, char** argv) {
   bool repeat_specified = false;
   bool run_all = false;
   bool run_all_verbose = false;
+  uint32_t job_count = std::max(1u, std::thread::hardware_concurrency());
   std::string requested;
+  std::string worker_case;
+  // Passed on to --run-all worker processes.
+  std::vector<std::string> forwarded_args;
   cambang::RealizationProfilerOptions profiler_options{};
   profiler_options.target_device_id = cambang::VerifyCaseHarness::kDeviceId;
   profiler_options.target_stream_id = cambang::VerifyCaseHarness::kStreamId;
@@ -204,7 +612,12 @@ int main(int argc, char** argv) {
       usage(argv[0], verify_cases);
       return 0;
     }
+    if (starts_with(arg, kWorkerArgument)) {
+      worker_case = arg.substr(std::strlen(kWorkerArgument));
+      continue;
+    }
     if (arg == "--trace-realization") {
+      forwarded_args.push_back(arg);
       if (!parse_trace_realization("block", profiler_options)) {
         const auto verify_cases = cambang::verify_case_catalog(provider_kind, profiler_options);
         std::cerr << "invalid trace-realization option\n";
@@ -214,6 +627,7 @@ int main(int argc, char** argv) {
       continue;
     }
     if (starts_with(arg, "--trace-realization=")) {
+      forwarded_args.push_back(arg);
       const std::string value = arg.substr(std::string("--trace-realization=").size());
       if (!parse_trace_realization(value, profiler_options)) {
         const auto verify_cases = cambang::verify_case_catalog(provider_kind, profiler_options);
@@ -224,6 +638,7 @@ int main(int argc, char** argv) {
       continue;
     }
     if (starts_with(arg, "--provider=")) {
+      forwarded_args.push_back(arg);
       const std::string value = arg.substr(std::string("--provider=").size());
       if (value == "synthetic") {
         provider_kind = cambang::VerifyCaseProviderKind::Synthetic;
@@ -246,6 +661,33 @@ int main(int argc, char** argv) {
         return 2;
       }
       repeat_specified = true;
+      forwarded_args.push_back(arg);
+      continue;
+    }
+    if (starts_with(arg, "--frame-shards=")) {
+      forwarded_args.push_back(arg);
+      const std::string value = arg.substr(std::string("--frame-shards=").size());
+      if (!parse_frame_shard_count(value, cambang::VerifyCaseHarness::runtime_options().frame_shard_count)) {
+        const auto verify_cases = cambang::verify_case_catalog(provider_kind, profiler_options);
+        std::cerr << "invalid frame shard count: " << value << "\n";
+        usage(argv[0], verify_cases);
+        return 2;
+      }
+      continue;
+    }
+    if (arg == "--snapshot-publish-offload") {
+      forwarded_args.push_back(arg);
+      cambang::VerifyCaseHarness::runtime_options().snapshot_publish_offload = true;
+      continue;
+    }
+    if (starts_with(arg, "--jobs=")) {
+      const std::string value = arg.substr(std::string("--jobs=").size());
+      if (!parse_job_count(value, job_count)) {
+        const auto verify_cases = cambang::verify_case_catalog(provider_kind, profiler_options);
+        std::cerr << "invalid job count: " << value << "\n";
+        usage(argv[0], verify_cases);
+        return 2;
+      }
       continue;
     }
     if (arg == "--run-all") {
@@ -266,13 +708,22 @@ int main(int argc, char** argv) {
   }
 
   const auto verify_cases = cambang::verify_case_catalog(provider_kind, profiler_options);
+  if (!worker_case.empty()) {
+    for (const auto& verify_case : verify_cases) {
+      if (verify_case.name == worker_case) {
+        return run_verify_case_worker(verify_case, repeat_count);
+      }
+    }
+    std::cerr << "unknown verification case: " << worker_case << "\n";
+    return 2;
+  }
   if (run_all) {
     if (!requested.empty()) {
       std::cerr << "cannot combine verification case name with --run-all\n";
       usage(argv[0], verify_cases);
       return 2;
     }
-    return run_all_verify_cases(verify_cases, repeat_count, run_all_verbose);
+    return run_all_verify_cases(argv[0], verify_cases, forwarded_args, repeat_count, job_count, run_all_verbose);
   }
 
   if (requested.empty()) {
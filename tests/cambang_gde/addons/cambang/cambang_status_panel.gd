@@ -139,6 +139,9 @@ var _dev_parent_by_id: Dictionary = {}
 var _row_nodes_by_id: Dictionary = {}
 var _server: Object = null
 var _last_snapshot_meta: Dictionary = {}
+# CamBANGServer.get_state_summary() for the snapshot being projected; empty
+# when the server predates it or it describes another publish.
+var _snapshot_summary: Dictionary = {}
 var _last_panel_model: PanelModel = null
 var _last_active_panel_model: PanelModel = null
 var _last_active_panel_is_authoritative: bool = false
@@ -227,6 +230,7 @@ func _reconcile_post_stop_nil_boundary() -> bool:
 		return false
 
 	_last_snapshot_meta.clear()
+	_snapshot_summary = {}
 	_apply_snapshot_read(_read_snapshot(null))
 	var nil_panel := _build_nil_panel_model("No published snapshot yet.")
 	_set_last_active_panel_state(nil_panel, false, {})
@@ -495,6 +499,7 @@ func _refresh_from_server() -> void:
 						provider_mode += "/strict"
 
 	var snapshot := _fetch_snapshot()
+	_snapshot_summary = _fetch_summary_for(snapshot)
 	var reading := _read_snapshot(snapshot)
 	_apply_snapshot_read(reading)
 
@@ -3602,6 +3607,29 @@ func _fetch_snapshot() -> Variant:
 	return _server.get_state_snapshot()
 
 
+# Aggregate counters come from the native summary when it describes the same
+# publish as `snapshot`; otherwise the panel reduces over the records.
+func _fetch_summary_for(snapshot: Variant) -> Dictionary:
+	if typeof(snapshot) != TYPE_DICTIONARY or _server == null:
+		return {}
+	if not _server.has_method("get_state_summary"):
+		return {}
+	var summary: Variant = _server.get_state_summary()
+	if typeof(summary) != TYPE_DICTIONARY:
+		return {}
+	var s: Dictionary = summary
+	var d: Dictionary = snapshot
+	if int(s.get("gen", -1)) != int(d.get("gen", -2)) or int(s.get("version", -1)) != int(d.get("version", -2)):
+		return {}
+	return s
+
+
+func _summary_count_or(key: String, fallback: int) -> int:
+	if _snapshot_summary.is_empty() or not _snapshot_summary.has(key):
+		return fallback
+	return int(_snapshot_summary.get(key))
+
+
 func _categorize_snapshot_update(snapshot: Dictionary) -> String:
 	var gen := int(snapshot.get("gen", -1))
 	var version := int(snapshot.get("version", -1))
@@ -3664,6 +3692,8 @@ func _read_snapshot(snapshot: Variant) -> Dictionary:
 	var streams := _array_size_or_negative(d.get("streams", null))
 	var native_objects := _array_size_or_negative(d.get("native_objects", null))
 	var detached_roots := _array_size_or_negative(d.get("detached_root_ids", null))
+	if detached_roots >= 0:
+		detached_roots = _summary_count_or("detached_roots", detached_roots)
 	var counts_text := "rigs=%s  devices=%s  streams=%s  native_objects=%s  detached_roots=%s" % [
 		_count_text_or_type_gap(rigs),
 		_count_text_or_type_gap(devices),
@@ -4050,7 +4080,9 @@ func _project_snapshot_to_panel_model(snapshot: Dictionary, provider_mode: Strin
 	var native_partition := _partition_native_objects_by_generation(snapshot_gen, native_objects, issues)
 	var current_native_objects: Array = native_partition.get("current", [])
 	var prior_native_objects: Array = native_partition.get("prior", [])
-	var native_dead_count := _count_native_destroyed(native_objects)
+	var native_dead_count := _summary_count_or("native_dead", -1)
+	if native_dead_count < 0:
+		native_dead_count = _count_native_destroyed(native_objects)
 	var current_provider_native_objects: Array = []
 	for i in range(current_native_objects.size()):
 		var current_rec := _safe_dict(current_native_objects[i], issues, "native_objects[current][%d]" % i)
@@ -4116,13 +4148,13 @@ func _project_snapshot_to_panel_model(snapshot: Dictionary, provider_mode: Strin
 	var provider_id := "provider/%d" % provider_native_id
 
 	var provider_counters: Array[CounterModel] = [
-		_counter("rigs", rigs.size(), 1),
-		_counter("devices", devices.size(), 1),
-		_counter("acquisition_sessions", acquisition_sessions.size(), 1),
-		_counter("streams", streams.size(), 1),
-		_counter("native_all", native_objects.size(), 1),
-		_counter("native_cur", current_native_objects.size(), 1),
-		_counter("native_prev", prior_native_objects.size(), 1),
+		_counter("rigs", _summary_count_or("rigs", rigs.size()), 1),
+		_counter("devices", _summary_count_or("devices", devices.size()), 1),
+		_counter("acquisition_sessions", _summary_count_or("acquisition_sessions", acquisition_sessions.size()), 1),
+		_counter("streams", _summary_count_or("streams", streams.size()), 1),
+		_counter("native_all", _summary_count_or("native_all", native_objects.size()), 1),
+		_counter("native_cur", _summary_count_or("native_cur", current_native_objects.size()), 1),
+		_counter("native_prev", _summary_count_or("native_prev", prior_native_objects.size()), 1),
 		_counter("native_dead", native_dead_count, 1),
 	]
 	var provider_phase: Variant = provider_native_rec.get("phase", -1)
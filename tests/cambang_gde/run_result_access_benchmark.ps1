@@ -0,0 +1,62 @@
+param(
+    [string]$GodotExe = "C:\Program Files\Godot4.5\Godot_v4.5.1-stable_win64_console.exe",
+    [string]$ProjectPath = $PSScriptRoot,
+    [ValidateSet("windows", "android")][string]$RunPlatform = "windows",
+    [string[]]$OutputForms = @("cpu_only", "cpu_gpu", "gpu_only"),
+    [int]$Frames = 240,
+    [int]$ToImageEvery = 4,
+    [int]$TimeoutSec = 300,
+    [string]$LogRoot = ""
+)
+
+Set-StrictMode -Version Latest
+$ErrorActionPreference = "Stop"
+
+$projectFullPath = (Resolve-Path $ProjectPath).Path
+$launcher = Join-Path $projectFullPath "run_godot.ps1"
+$logRootResolved = if ([string]::IsNullOrWhiteSpace($LogRoot)) {
+    Join-Path $projectFullPath "run-logs\result_access_benchmark"
+} else {
+    $LogRoot
+}
+New-Item -ItemType Directory -Force -Path $logRootResolved | Out-Null
+
+# One process per Synthetic producer output form: the form decides which
+# to_image()/display-view route every case exercises.
+$failed = New-Object System.Collections.Generic.List[object]
+foreach ($form in $OutputForms) {
+    $label = "scene871_{0}_{1}" -f $RunPlatform, $form
+    $launchArgs = @{
+        GodotExe = $GodotExe
+        ProjectPath = $projectFullPath
+        RunPlatform = $RunPlatform
+        Scene = "res://scenes/871_result_access_benchmark.tscn"
+        CaptureLogs = $true
+        LogRoot = $logRootResolved
+        RunLabel = $label
+        TimeoutSec = $TimeoutSec
+        ExtraArgs = @("--rendering-method=mobile", "--cambang-synth-producer-output-form=$form")
+    }
+    # Android has no user args to carry the bench sizing, so the scene's
+    # defaults apply there.
+    if ($RunPlatform -eq "windows") {
+        $launchArgs["Windowed"] = $true
+        $launchArgs["ExtraArgs"] += @("--cambang-bench-frames=$Frames", "--cambang-bench-to-image-every=$ToImageEvery")
+    }
+    & $launcher @launchArgs
+    $exitCode = $LASTEXITCODE
+    if ($exitCode -ne 0) {
+        $failed.Add([PSCustomObject]@{ OutputForm = $form; ExitCode = $exitCode; RunLabel = $label })
+        Write-Host ("  {0}: FAIL exit={1}" -f $form, $exitCode) -ForegroundColor Red
+    } else {
+        Write-Host ("  {0}: done" -f $form)
+    }
+}
+
+Write-Host ("Result access benchmark: forms={0} failed={1} records={2} (records/scene871_result_access_summary*.json per run)" -f `
+    $OutputForms.Count, $failed.Count, $logRootResolved)
+if ($failed.Count -ne 0) {
+    $failed | Format-Table -AutoSize
+    exit 1
+}
+exit 0
@@ -0,0 +1,245 @@
+extends Node
+
+# Provider hot-swap through CamBANGServer.swap_provider(): the generation
+# survives, the old provider's device and stream close, existing handles go
+# non-live without breaking, and the same endpoint handle engages the
+# replacement provider.
+
+const MAX_FRAMES := 180
+const SCENE_LABEL := "69_provider_swap_verify"
+
+var _done := false
+var _quit_requested := false
+var _terminal_verdict_emitted := false
+var _handle = null
+var _stream = null
+var _replacement_stream = null
+
+
+func _ready() -> void:
+	CamBANGServer.stop()
+
+	if not CamBANGServer.has_method("swap_provider"):
+		_fail("FAIL: CamBANGServer.swap_provider() missing")
+		return
+	if CamBANGServer.swap_provider(CamBANGServer.PROVIDER_KIND_SYNTHETIC) != ERR_BUSY:
+		_fail("FAIL: swap_provider() while stopped must return ERR_BUSY")
+		return
+
+	var start_err := CamBANGServer.start(CamBANGServer.PROVIDER_KIND_SYNTHETIC)
+	if start_err != OK:
+		_error("ERROR: start(SYNTHETIC) rejected", "runtime_start_rejected")
+		return
+	if not await _wait_for_baseline():
+		return
+	var gen := int(CamBANGServer.get_state_snapshot().get("gen", -1))
+
+	var endpoints = CamBANGServer.enumerate_devices()
+	if typeof(endpoints) != TYPE_ARRAY or endpoints.size() < 1:
+		_fail("FAIL: synthetic enumerate_devices() must return at least one endpoint")
+		return
+	var hardware_id := str(endpoints[0].get("hardware_id", ""))
+	_handle = CamBANGServer.get_device_for_hardware_id(hardware_id)
+	if _handle == null:
+		_fail("FAIL: get_device_for_hardware_id() must return a handle for a known hardware_id")
+		return
+
+	var first_instance_id := await _engage_handle()
+	if first_instance_id == 0:
+		return
+	_stream = await _create_flowing_stream()
+	if _stream == null:
+		return
+	var first_stream_id := int(_stream.get_stream_id())
+
+	if CamBANGServer.swap_provider(99) != ERR_INVALID_PARAMETER:
+		_fail("FAIL: swap_provider() with an unknown provider_kind must return ERR_INVALID_PARAMETER")
+		return
+	var swap_err := CamBANGServer.swap_provider(CamBANGServer.PROVIDER_KIND_SYNTHETIC)
+	if swap_err != OK:
+		_fail("FAIL: swap_provider(SYNTHETIC) must return OK while running (err=%d)" % swap_err)
+		return
+	if not CamBANGServer.is_running():
+		_fail("FAIL: runtime must stay running across swap_provider()")
+		return
+
+	# The old provider's stream and device close within the same generation.
+	var retired := false
+	for _i in range(MAX_FRAMES):
+		var snap = CamBANGServer.get_state_snapshot()
+		if typeof(snap) == TYPE_DICTIONARY:
+			if int(snap.get("gen", -1)) != gen:
+				_fail("FAIL: swap_provider() must keep the runtime generation (was %d, now %d)" % [gen, int(snap.get("gen", -1))])
+				return
+			if not _snapshot_has(snap, "streams", "stream_id", first_stream_id) and not _snapshot_has(snap, "devices", "instance_id", first_instance_id):
+				retired = true
+				break
+		await get_tree().process_frame
+	if not retired:
+		_fail("FAIL: old provider's stream and device must leave the snapshot after swap_provider()")
+		return
+
+	# Existing handles behave as after their own close.
+	if _stream.start() == OK:
+		_fail("FAIL: a stream handle from before the swap must not start")
+		return
+	if _stream.destroy() != OK:
+		_fail("FAIL: destroy() on a stream handle retired by the swap must return OK")
+		return
+	if bool(_stream.is_valid_stream_handle()):
+		_fail("FAIL: a destroyed stream handle must not stay valid")
+		return
+	var closed := false
+	for _i in range(MAX_FRAMES):
+		if int(_handle.get_instance_id()) == 0:
+			closed = true
+			break
+		await get_tree().process_frame
+	if not closed:
+		_fail("FAIL: endpoint handle must resolve get_instance_id() == 0 after the swap closed its device")
+		return
+
+	# The same endpoint handle engages the replacement provider.
+	var second_instance_id := await _engage_handle()
+	if second_instance_id == 0:
+		return
+	if second_instance_id == first_instance_id:
+		_fail("FAIL: re-engaging after swap_provider() must resolve a new device instance")
+		return
+	_replacement_stream = await _create_flowing_stream()
+	if _replacement_stream == null:
+		return
+	if int(_replacement_stream.get_stream_id()) == first_stream_id:
+		_fail("FAIL: a stream created after swap_provider() must have a new stream_id")
+		return
+	if int(CamBANGServer.get_state_snapshot().get("gen", -1)) != gen:
+		_fail("FAIL: replacement provider activity must stay in the original generation")
+		return
+
+	_ok("OK: godot provider swap verify PASS")
+
+
+func _engage_handle() -> int:
+	var engage_err := ERR_BUSY
+	for _i in range(MAX_FRAMES):
+		engage_err = _handle.engage()
+		if engage_err == OK:
+			break
+		if engage_err != ERR_BUSY and engage_err != ERR_UNAVAILABLE:
+			break
+		await get_tree().process_frame
+	if engage_err != OK:
+		_fail("FAIL: endpoint handle engage() must return OK (err=%d)" % engage_err)
+		return 0
+	var instance_id := int(_handle.get_instance_id())
+	if instance_id == 0:
+		_fail("FAIL: endpoint handle get_instance_id() must become nonzero after engage()")
+		return 0
+	for _i in range(MAX_FRAMES):
+		var snap = CamBANGServer.get_state_snapshot()
+		if typeof(snap) == TYPE_DICTIONARY and _snapshot_has(snap, "devices", "instance_id", instance_id):
+			return instance_id
+		await get_tree().process_frame
+	_fail("FAIL: snapshot must report the engaged device instance %d" % instance_id)
+	return 0
+
+
+func _create_flowing_stream():
+	var stream = _handle.create_stream({
+		"intent": CamBANGStream.INTENT_VIEWFINDER,
+		"profile": {
+			"width": 320,
+			"height": 180,
+			"format_fourcc": CamBANGServer.PIXEL_FORMAT_RGBA,
+			"target_fps": 15,
+		},
+	})
+	if stream == null:
+		_fail("FAIL: create_stream() must return a handle for the engaged endpoint")
+		return null
+	var start_err := ERR_BUSY
+	for _i in range(MAX_FRAMES):
+		start_err = stream.start()
+		if start_err == OK:
+			break
+		await get_tree().process_frame
+	if start_err != OK:
+		_fail("FAIL: CamBANGStream.start() must return OK (err=%d)" % start_err)
+		return null
+	for _i in range(MAX_FRAMES):
+		if stream.get_result() != null:
+			return stream
+		await get_tree().process_frame
+	_fail("FAIL: started stream %d produced no result" % int(stream.get_stream_id()))
+	return null
+
+
+func _snapshot_has(snap: Dictionary, key: String, id_key: String, id: int) -> bool:
+	var rows = snap.get(key, [])
+	if typeof(rows) != TYPE_ARRAY:
+		return false
+	for row in rows:
+		if typeof(row) == TYPE_DICTIONARY and int(row.get(id_key, -1)) == id:
+			return true
+	return false
+
+
+func _wait_for_baseline() -> bool:
+	for _i in range(MAX_FRAMES):
+		var snap = CamBANGServer.get_state_snapshot()
+		if typeof(snap) == TYPE_DICTIONARY and int(snap.get("version", -1)) == 0 and int(snap.get("topology_version", -1)) == 0:
+			return true
+		await get_tree().process_frame
+	_fail("FAIL: timed out waiting for initial baseline", "timeout")
+	return false
+
+
+func _ok(msg: String) -> void:
+	if _done:
+		return
+	_done = true
+	_emit_harness_verdict("ok", 0, "pass")
+	print(msg)
+	_cleanup_and_quit(0)
+
+
+func _fail(msg: String, reason: String = "assertion_failed") -> void:
+	if _done:
+		return
+	_done = true
+	_emit_harness_verdict("fail", 1, reason)
+	push_error(msg)
+	print(msg)
+	_cleanup_and_quit(1)
+
+
+func _error(msg: String, reason: String) -> void:
+	if _done:
+		return
+	_done = true
+	_emit_harness_verdict("error", 1, reason)
+	push_error(msg)
+	print(msg)
+	_cleanup_and_quit(1)
+
+
+func _emit_harness_verdict(status: String, exit_code: int, reason: String) -> void:
+	if _terminal_verdict_emitted:
+		return
+	_terminal_verdict_emitted = true
+	print("[CamBANG][HarnessVerdict] scene=%s status=%s exit_code=%d reason=%s" % [
+		SCENE_LABEL,
+		status,
+		exit_code,
+		reason,
+	])
+
+
+func _cleanup_and_quit(code: int) -> void:
+	set_process(false)
+	_stream = null
+	_replacement_stream = null
+	_handle = null
+	if not _quit_requested:
+		_quit_requested = true
+		CamBANGServer.stop_and_quit(code)
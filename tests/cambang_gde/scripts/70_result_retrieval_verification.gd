@@ -77,6 +77,7 @@ var _capture_baseline_progress: Dictionary = {}
 var _capture_completion_progress: Dictionary = {}
 var _capture_completion_seen := false
 var _expected_capture_id := 0
+var _capture_result_revision_before_trigger := 0
 var _inspection_capture_baseline_progress: Dictionary = {}
 var _inspection_capture_completion_progress: Dictionary = {}
 var _inspection_capture_completion_seen := false
@@ -681,6 +682,18 @@ func _try_verify_stream_result() -> void:
 		_require(not stream_result.has_method("get_capture_timestamp"), "step %d FAIL: stream legacy get_capture_timestamp() accessor must be absent" % _step)
 		_step_ok("stream direct properties verified")
 
+		_require(CamBANGServer.get_stream_result_revision() > 0, "step %d FAIL: stream result revision must be positive once a result exists" % _step)
+		# The batched lookup reports only results newer than the last one
+		# handed out for the stream.
+		var repeated = CamBANGServer.get_stream_result_by_stream_id(_stream_id)
+		var batch: Dictionary = CamBANGServer.get_stream_results_by_stream_ids(PackedInt64Array([_stream_id, _stream_id]))
+		_require(batch.size() <= 1, "step %d FAIL: batched stream lookup must report a stream once" % _step)
+		if batch.has(_stream_id):
+			var batched = batch[_stream_id]
+			_require(batched.get_class() == "CamBANGStreamResult" and batched.get_stream_id() == _stream_id, "step %d FAIL: batched stream result mismatch" % _step)
+			_require(batched != repeated, "step %d FAIL: batched lookup reported an unchanged stream result" % _step)
+		_step_ok("batched stream result lookup verified")
+
 		var stream_camera_facts: Dictionary = stream_result.get_camera_facts()
 		_require(_scene70_has_only_acquisition_timing(stream_camera_facts), "step %d FAIL: stream camera_facts must contain acquisition_timing only" % _step)
 		_require(_scene70_has_canonical_acquisition_timing(stream_camera_facts.get("acquisition_timing", {})), "step %d FAIL: stream acquisition_timing shape invalid" % _step)
@@ -806,6 +819,7 @@ func _try_verify_stream_result() -> void:
 			bool(_capture_baseline_progress.get("available", false)),
 			"step %d FAIL: capture progress snapshot unavailable before trigger" % _step
 		)
+		_capture_result_revision_before_trigger = int(CamBANGServer.get_capture_result_revision())
 		var perf_initial_trigger_start_us := _perf_us()
 		var capture_err := int(device.trigger_capture())
 		var perf_initial_trigger_end_us := _perf_us()
@@ -919,6 +933,11 @@ func _try_verify_capture_result() -> void:
 
 	_require(capture_result.get_class() == "CamBANGCaptureResult", "step %d FAIL: capture result must be CamBANGCaptureResult" % _step)
 	_step_ok("capture result object branding verified")
+	_require(
+		int(CamBANGServer.get_capture_result_revision()) > _capture_result_revision_before_trigger,
+		"step %d FAIL: capture result revision must advance once the capture result is retained" % _step
+	)
+	_step_ok("capture result revision advanced")
 
 	_require(capture_result.get_width() > 0, "step %d FAIL: capture width invalid" % _step)
 	_require(capture_result.get_height() > 0, "step %d FAIL: capture height invalid" % _step)
@@ -0,0 +1,322 @@
+extends Control
+
+## Scene 871: per-frame cost of the Godot-facing stream result APIs.
+##
+## For each resolution x stream-count case the scene creates Synthetic
+## preview streams, warms them up, then for a fixed number of process frames
+## calls get_result(), get_display_view() (bound to an on-screen TextureRect
+## so live display refresh runs as it would in an app) and, every
+## --cambang-bench-to-image-every frames, to_image() on every stream.
+## GDScript-side call times are reported as percentiles next to the
+## engine-side evidence for the same window: per-route deltas of
+## result_access_timing_evidence (the result_access_cost_evidence route labels)
+## and of the live CPU display refresh counters.
+##
+## The to_image()/display route is picked by the Maintainer Synthetic producer
+## output form (--cambang-synth-producer-output-form=cpu_only|cpu_gpu|gpu_only);
+## run_result_access_benchmark.ps1 runs one process per form. Stream counts are
+## bounded by the Synthetic endpoint count (two).
+##
+## Self-terminating: emits [CamBANG][HarnessVerdict] and then the framed JSON
+## record scene871_result_access_summary. Compatibility renderer + gpu_only
+## exits as expected_unsupported (compatibility_gpu_only).
+
+const SCENE_LABEL := "871_result_access_benchmark"
+const RECORD_ID := "scene871_result_access_summary"
+const HW_IDS := ["synthetic:0", "synthetic:1"]
+const RESOLUTIONS := [[640, 360], [1280, 720], [1920, 1080]]
+const STREAM_COUNTS := [1, 2]
+const SETUP_TIMEOUT_MS := 5000
+const FIRST_RESULT_TIMEOUT_MS := 5000
+const WARMUP_FRAMES := 30
+const MEASURE_FRAMES_DEFAULT := 240
+const TO_IMAGE_EVERY_DEFAULT := 4
+const CPU_DISPLAY_REFRESH_KEYS := [
+	"cpu_display_refresh_live_attempts",
+	"cpu_display_refresh_live_updated",
+	"cpu_display_refresh_live_total_ms",
+	"cpu_display_refresh_skipped_unchanged",
+]
+
+var _measure_frames := MEASURE_FRAMES_DEFAULT
+var _to_image_every := TO_IMAGE_EVERY_DEFAULT
+var _output_form := "runtime_default"
+var _views: Array[TextureRect] = []
+var _devices := []
+var _cases := []
+var _verdict_emitted := false
+
+
+func _ready() -> void:
+	_parse_args()
+	_output_form = _producer_output_form()
+	print("RUN: %s output_form=%s frames=%d to_image_every=%d" % [SCENE_LABEL, _output_form, _measure_frames, _to_image_every])
+	if _output_form == "gpu_only" and _is_compatibility_renderer():
+		_finish("expected_unsupported", 0, "compatibility_gpu_only")
+		return
+	_build_ui()
+	await _run()
+
+
+func _exit_tree() -> void:
+	CamBANGServer.stop()
+
+
+func _parse_args() -> void:
+	for raw_arg in OS.get_cmdline_user_args():
+		var text := str(raw_arg)
+		if text.begins_with("--cambang-bench-frames="):
+			_measure_frames = maxi(1, int(text.substr("--cambang-bench-frames=".length())))
+		elif text.begins_with("--cambang-bench-to-image-every="):
+			_to_image_every = maxi(1, int(text.substr("--cambang-bench-to-image-every=".length())))
+
+
+func _producer_output_form() -> String:
+	const PREFIX := "--cambang-synth-producer-output-form="
+	for raw_arg in OS.get_cmdline_user_args():
+		var text := str(raw_arg)
+		if text.begins_with(PREFIX):
+			return text.substr(PREFIX.length()).strip_edges().to_lower()
+	return str(ProjectSettings.get_setting("cambang/maintainer/synthetic_producer_output_form", "runtime_default")).strip_edges().to_lower()
+
+
+func _is_compatibility_renderer() -> bool:
+	var method := str(RenderingServer.get_current_rendering_method()).strip_edges().to_lower()
+	return method == "gl_compatibility" or method == "compatibility"
+
+
+func _build_ui() -> void:
+	var row := HBoxContainer.new()
+	row.set_anchors_preset(Control.PRESET_FULL_RECT)
+	add_child(row)
+	for _i in range(HW_IDS.size()):
+		var view := TextureRect.new()
+		view.expand_mode = TextureRect.EXPAND_IGNORE_SIZE
+		view.stretch_mode = TextureRect.STRETCH_KEEP_ASPECT_CENTERED
+		view.size_flags_horizontal = Control.SIZE_EXPAND_FILL
+		view.size_flags_vertical = Control.SIZE_EXPAND_FILL
+		row.add_child(view)
+		_views.append(view)
+
+
+func _run() -> void:
+	CamBANGServer.stop()
+	if int(CamBANGServer.start(CamBANGServer.PROVIDER_KIND_SYNTHETIC)) != OK:
+		_finish("fail", 1, "server_start")
+		return
+	for hw in HW_IDS:
+		var dev = await _engage_live(hw, SETUP_TIMEOUT_MS)
+		if dev == null:
+			_finish("fail", 1, "device_not_live")
+			return
+		_devices.append(dev)
+
+	for resolution in RESOLUTIONS:
+		for stream_count in STREAM_COUNTS:
+			var case_record = await _run_case(int(resolution[0]), int(resolution[1]), int(stream_count))
+			if case_record == null:
+				return
+			_cases.append(case_record)
+			print("[CamBANG][Scene871] case=%dx%d streams=%d display_view_p50_us=%d to_image_p50_us=%d frame_p99_us=%d" % [
+				int(resolution[0]), int(resolution[1]), int(stream_count),
+				int(case_record["display_view_us"]["p50"]),
+				int(case_record["to_image_us"]["p50"]),
+				int(case_record["frame_us"]["p99"]),
+			])
+	_finish("ok", 0, "complete")
+
+
+func _engage_live(hw: String, timeout_ms: int):
+	var dev = CamBANGServer.get_device_for_hardware_id(hw)
+	if dev == null or int(dev.engage()) != OK:
+		return null
+	var deadline := Time.get_ticks_msec() + timeout_ms
+	while Time.get_ticks_msec() < deadline:
+		await get_tree().process_frame
+		if bool(dev.is_live()):
+			return dev
+	return null
+
+
+func _run_case(width: int, height: int, stream_count: int):
+	var streams := []
+	for i in range(stream_count):
+		var stream = _devices[i].create_stream({
+			"intent": CamBANGStream.INTENT_PREVIEW,
+			"profile": {"width": width, "height": height, "format_fourcc": CamBANGServer.PIXEL_FORMAT_RGBA},
+		})
+		if stream == null or int(stream.start()) != OK:
+			_finish("fail", 1, "stream_start_%dx%d" % [width, height])
+			return null
+		streams.append(stream)
+
+	var deadline := Time.get_ticks_msec() + FIRST_RESULT_TIMEOUT_MS
+	while not _all_results_present(streams):
+		if Time.get_ticks_msec() >= deadline:
+			_finish("fail", 1, "no_result_%dx%d" % [width, height])
+			return null
+		await get_tree().process_frame
+	for _i in range(WARMUP_FRAMES):
+		_touch_streams(streams, false, [], [], [])
+		await get_tree().process_frame
+
+	var metrics_before := _metrics()
+	var get_result_us := []
+	var display_view_us := []
+	var to_image_us := []
+	var frame_us := []
+	var last_frame_us := Time.get_ticks_usec()
+	var started_us := last_frame_us
+	for frame in range(_measure_frames):
+		var do_to_image := frame % _to_image_every == 0
+		_touch_streams(streams, do_to_image, get_result_us, display_view_us, to_image_us)
+		await get_tree().process_frame
+		var now_us := Time.get_ticks_usec()
+		frame_us.append(now_us - last_frame_us)
+		last_frame_us = now_us
+	var wall_us := Time.get_ticks_usec() - started_us
+	var metrics_after := _metrics()
+
+	for view in _views:
+		view.texture = null
+	var first_result = streams[0].get_result()
+	var record := {
+		"width": width,
+		"height": height,
+		"streams": stream_count,
+		"frames": _measure_frames,
+		"wall_us": wall_us,
+		"payload_kind": int(first_result.get_payload_kind()) if first_result != null else -1,
+		"display_view_path_kind": int(first_result.get_display_view_path_kind()) if first_result != null else -1,
+		"get_result_us": _summarize(get_result_us),
+		"display_view_us": _summarize(display_view_us),
+		"to_image_us": _summarize(to_image_us),
+		"frame_us": _summarize(frame_us),
+		"routes": _route_deltas(metrics_before, metrics_after),
+		"cpu_display_refresh": _refresh_deltas(metrics_before, metrics_after),
+	}
+	first_result = null
+	for stream in streams:
+		stream.stop()
+		stream.destroy()
+	streams.clear()
+	await get_tree().process_frame
+	return record
+
+
+func _all_results_present(streams: Array) -> bool:
+	for stream in streams:
+		if stream.get_result() == null:
+			return false
+	return true
+
+
+func _touch_streams(streams: Array, do_to_image: bool, get_result_us: Array, display_view_us: Array, to_image_us: Array) -> void:
+	for i in range(streams.size()):
+		var t0 := Time.get_ticks_usec()
+		var result = streams[i].get_result()
+		var t1 := Time.get_ticks_usec()
+		get_result_us.append(t1 - t0)
+		if result == null:
+			continue
+		var view = result.get_display_view()
+		display_view_us.append(Time.get_ticks_usec() - t1)
+		if view is Texture2D and _views[i].texture != view:
+			_views[i].texture = view
+		if do_to_image:
+			var t2 := Time.get_ticks_usec()
+			var image: Image = result.to_image()
+			if image != null:
+				to_image_us.append(Time.get_ticks_usec() - t2)
+
+
+func _metrics() -> Dictionary:
+	var metrics = CamBANGServer.get_synthetic_metrics_snapshot()
+	return metrics if typeof(metrics) == TYPE_DICTIONARY else {}
+
+
+func _route_deltas(before: Dictionary, after: Dictionary) -> Dictionary:
+	var before_routes: Dictionary = before.get("result_access_timing_evidence", {})
+	var after_routes: Dictionary = after.get("result_access_timing_evidence", {})
+	var out := {}
+	for route in after_routes.keys():
+		var a: Dictionary = after_routes[route]
+		var b: Dictionary = before_routes.get(route, {})
+		var calls := int(a.get("calls", 0)) - int(b.get("calls", 0))
+		if calls <= 0:
+			continue
+		var total_ns := int(a.get("total_ns", 0)) - int(b.get("total_ns", 0))
+		out[str(route)] = {
+			"calls": calls,
+			"failures": int(a.get("failures", 0)) - int(b.get("failures", 0)),
+			"mean_us": float(total_ns) / float(calls) / 1000.0,
+			"max_ns": int(a.get("max_ns", 0)),
+		}
+	return out
+
+
+func _refresh_deltas(before: Dictionary, after: Dictionary) -> Dictionary:
+	var out := {}
+	for key in CPU_DISPLAY_REFRESH_KEYS:
+		out[key] = float(after.get(key, 0)) - float(before.get(key, 0))
+	return out
+
+
+func _summarize(samples: Array) -> Dictionary:
+	if samples.is_empty():
+		return {"count": 0, "mean": 0, "p50": 0, "p95": 0, "p99": 0, "max": 0}
+	var sorted := samples.duplicate()
+	sorted.sort()
+	var total := 0
+	for v in sorted:
+		total += int(v)
+	return {
+		"count": sorted.size(),
+		"mean": float(total) / float(sorted.size()),
+		"p50": sorted[int(0.50 * (sorted.size() - 1))],
+		"p95": sorted[int(0.95 * (sorted.size() - 1))],
+		"p99": sorted[int(0.99 * (sorted.size() - 1))],
+		"max": sorted[sorted.size() - 1],
+	}
+
+
+func _finish(status: String, exit_code: int, reason: String) -> void:
+	if _verdict_emitted:
+		return
+	_verdict_emitted = true
+	print("[CamBANG][HarnessVerdict] scene=%s status=%s exit_code=%d reason=%s" % [SCENE_LABEL, status, exit_code, reason])
+	var summary := {
+		"scene": SCENE_LABEL,
+		"status": status,
+		"reason": reason,
+		"output_form": _output_form,
+		"rendering_method": str(RenderingServer.get_current_rendering_method()),
+		"os": OS.get_name(),
+		"model": OS.get_model_name(),
+		"measure_frames": _measure_frames,
+		"to_image_every": _to_image_every,
+		"cases": _cases,
+	}
+	_emit_framed_record(RECORD_ID, "json", JSON.stringify(summary))
+	for view in _views:
+		view.texture = null
+	_devices.clear()
+	# Let TextureRect releases land before stop() tears down display views.
+	await get_tree().process_frame
+	await get_tree().process_frame
+	CamBANGServer.stop()
+	get_tree().quit(exit_code)
+
+
+func _emit_framed_record(record_name: String, kind: String, payload_text: String) -> void:
+	var payload_base64 := Marshalls.utf8_to_base64(payload_text)
+	const CHUNK_SIZE := 768
+	var chunk_count := int(ceil(float(payload_base64.length()) / float(CHUNK_SIZE))) if payload_base64.length() > 0 else 0
+	print("[CamBANG][RecordStart] id=%s name=%s kind=%s chunks=%d encoding=base64" % [RECORD_ID, record_name, kind, chunk_count])
+	var chunk_index := 0
+	var offset := 0
+	while offset < payload_base64.length():
+		print("[CamBANG][RecordChunk] id=%s index=%d data=%s" % [RECORD_ID, chunk_index, payload_base64.substr(offset, CHUNK_SIZE)])
+		offset += CHUNK_SIZE
+		chunk_index += 1
+	print("[CamBANG][RecordEnd] id=%s" % RECORD_ID)